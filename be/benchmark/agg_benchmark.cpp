@@ -0,0 +1,66 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "bench_util.h"
+#include "exec/vectorized/aggregate/agg_hash_map.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks::vectorized::bench {
+
+// The state of an aggregate function, e.g. of a count or a sum of a bigint.
+static constexpr size_t kAggStateSize = sizeof(int64_t);
+
+// The hash maps of the group by keys, which the AggregateBaseNode and the aggregator of the pipeline look up once
+// per row to compute the aggregate states, with the states allocated from the MemPool of the aggregator.
+// Args: rows, cardinality of the keys, skew percent.
+template <typename HashMapWithKey, PrimitiveType KeyType>
+static void BM_agg_compute_states(benchmark::State& state) {
+    using Slot = typename decltype(HashMapWithKey::hash_map)::value_type;
+    std::vector<int32_t> keys = create_keys(state.range(0), state.range(1), state.range(2));
+    std::vector<Columns> key_columns;
+    for (size_t from = 0; from < keys.size(); from += kNumRows) {
+        size_t size = std::min(kNumRows, keys.size() - from);
+        key_columns.emplace_back(Columns{create_key_column<KeyType>(keys, from, size)});
+    }
+    MemTracker mem_tracker;
+    Buffer<AggDataPtr> agg_states(kNumRows);
+    size_t num_groups = 0;
+    int64_t mem_bytes = 0;
+    for (auto _ : state) {
+        MemPool pool(&mem_tracker);
+        HashMapWithKey hash_map_with_key;
+        auto allocate_func = [&pool]() { return pool.allocate_aligned(kAggStateSize, kAggStateSize); };
+        for (const auto& columns : key_columns) {
+            hash_map_with_key.compute_agg_states(columns[0]->size(), columns, &pool, allocate_func, &agg_states);
+        }
+        num_groups = hash_map_with_key.hash_map.size();
+        mem_bytes = pool.total_reserved_bytes() + hash_map_with_key.hash_map.capacity() * sizeof(Slot);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["groups"] = num_groups;
+    state.counters["peak_mem_bytes"] = mem_bytes;
+}
+
+static void agg_args(benchmark::internal::Benchmark* b) {
+    for (int64_t cardinality : {1 << 4, 1 << 12, 1 << 20}) {
+        for (int64_t skew_percent : {0, 50, 90}) {
+            b->Args({1 << 20, cardinality, skew_percent});
+        }
+    }
+}
+
+using Int32KeyMap = AggHashMapWithOneNumberKey<int32_t, Int32AggHashMap<PhmapSeed1>>;
+using Int32TwoLevelKeyMap = AggHashMapWithOneNumberKey<int32_t, Int32AggTwoLevelHashMap<PhmapSeed1>>;
+using Int64KeyMap = AggHashMapWithOneNumberKey<int64_t, Int64AggHashMap<PhmapSeed1>>;
+using StringKeyMap = AggHashMapWithOneStringKey<SliceAggHashMap<PhmapSeed1>>;
+using StringTwoLevelKeyMap = AggHashMapWithOneStringKey<SliceAggTwoLevelHashMap<PhmapSeed1>>;
+
+BENCHMARK_TEMPLATE(BM_agg_compute_states, Int32KeyMap, TYPE_INT)->Apply(agg_args);
+BENCHMARK_TEMPLATE(BM_agg_compute_states, Int32TwoLevelKeyMap, TYPE_INT)->Apply(agg_args);
+BENCHMARK_TEMPLATE(BM_agg_compute_states, Int64KeyMap, TYPE_BIGINT)->Apply(agg_args);
+BENCHMARK_TEMPLATE(BM_agg_compute_states, StringKeyMap, TYPE_VARCHAR)->Apply(agg_args);
+BENCHMARK_TEMPLATE(BM_agg_compute_states, StringTwoLevelKeyMap, TYPE_VARCHAR)->Apply(agg_args);
+
+} // namespace starrocks::vectorized::bench
@@ -0,0 +1,98 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "column/column_builder.h"
+#include "column/column_helper.h"
+#include "column/type_traits.h"
+
+namespace starrocks::vectorized::bench {
+
+// The benchmarks are parameterized by the percents of the null rows and of the selected rows, as the range(0) and
+// range(1) of the benchmark::State, e.g. ->Args({10, 50}) for 10% null and 50% selected.
+constexpr size_t kNumRows = 4096;
+
+inline const std::vector<std::vector<int64_t>>& null_and_selectivity_args() {
+    static const std::vector<std::vector<int64_t>> args = {{0, 100}, {0, 50}, {0, 5}, {20, 50}, {80, 50}};
+    return args;
+}
+
+inline std::string random_string(std::mt19937* rng, size_t min_length, size_t max_length) {
+    size_t length = min_length + (*rng)() % (max_length - min_length + 1);
+    std::string s(length, ' ');
+    for (auto& c : s) {
+        c = static_cast<char>('a' + (*rng)() % 26);
+    }
+    return s;
+}
+
+// The column is nullable iff any row is null.
+template <PrimitiveType Type>
+ColumnPtr create_column(size_t num_rows, int null_percent, uint32_t seed = 0) {
+    std::mt19937 rng(seed);
+    ColumnBuilder<Type> builder;
+    builder.reserve(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        if (static_cast<int>(rng() % 100) < null_percent) {
+            builder.append_null();
+        } else if constexpr (isSlicePT<Type>) {
+            std::string value = random_string(&rng, 4, 32);
+            builder.append(Slice(value));
+        } else {
+            builder.append(static_cast<RunTimeCppType<Type>>(rng()));
+        }
+    }
+    return builder.build(false);
+}
+
+inline Column::Filter create_filter(size_t num_rows, int selectivity_percent, uint32_t seed = 0) {
+    std::mt19937 rng(seed);
+    Column::Filter filter(num_rows);
+    for (auto& v : filter) {
+        v = static_cast<int>(rng() % 100) < selectivity_percent;
+    }
+    return filter;
+}
+
+inline std::vector<uint32_t> create_selection(size_t num_rows, int selectivity_percent, uint32_t seed = 0) {
+    Column::Filter filter = create_filter(num_rows, selectivity_percent, seed);
+    std::vector<uint32_t> indexes;
+    for (uint32_t i = 0; i < num_rows; i++) {
+        if (filter[i]) {
+            indexes.push_back(i);
+        }
+    }
+    return indexes;
+}
+
+// The keys in [0, cardinality), of which |skew_percent| percent of the rows are on the hot key 0 and the others are
+// uniform, for the benchmarks of the joins and the aggregations.
+inline std::vector<int32_t> create_keys(size_t num_rows, int64_t cardinality, int skew_percent, uint32_t seed = 0) {
+    std::mt19937 rng(seed);
+    std::vector<int32_t> keys(num_rows);
+    for (auto& key : keys) {
+        key = static_cast<int>(rng() % 100) < skew_percent ? 0 : static_cast<int32_t>(rng() % cardinality);
+    }
+    return keys;
+}
+
+template <PrimitiveType Type>
+ColumnPtr create_key_column(const std::vector<int32_t>& keys, size_t from, size_t size) {
+    ColumnBuilder<Type> builder;
+    builder.reserve(size);
+    for (size_t i = from; i < from + size; i++) {
+        if constexpr (isSlicePT<Type>) {
+            std::string value = "key_" + std::to_string(keys[i]);
+            builder.append(Slice(value));
+        } else {
+            builder.append(static_cast<RunTimeCppType<Type>>(keys[i]));
+        }
+    }
+    return builder.build(false);
+}
+
+} // namespace starrocks::vectorized::bench
@@ -0,0 +1,104 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "bench_util.h"
+#include "column/column.h"
+#include "util/hash_util.hpp"
+
+namespace starrocks::vectorized::bench {
+
+// Args: null percent, selectivity percent.
+template <PrimitiveType Type>
+static void BM_filter_range(benchmark::State& state) {
+    ColumnPtr src = create_column<Type>(kNumRows, state.range(0));
+    Column::Filter filter = create_filter(kNumRows, state.range(1));
+    for (auto _ : state) {
+        state.PauseTiming();
+        ColumnPtr column = src->clone_shared();
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(column->filter_range(filter, 0, kNumRows));
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+// Args: null percent, selectivity percent.
+template <PrimitiveType Type>
+static void BM_append_selective(benchmark::State& state) {
+    ColumnPtr src = create_column<Type>(kNumRows, state.range(0));
+    std::vector<uint32_t> indexes = create_selection(kNumRows, state.range(1));
+    ColumnPtr dst = src->clone_empty();
+    for (auto _ : state) {
+        dst->reset_column();
+        dst->append_selective(*src, indexes.data(), 0, indexes.size());
+        benchmark::DoNotOptimize(dst->size());
+    }
+    state.SetItemsProcessed(state.iterations() * indexes.size());
+}
+
+// Args: null percent.
+template <PrimitiveType Type>
+static void BM_serialize_batch(benchmark::State& state) {
+    ColumnPtr src = create_column<Type>(kNumRows, state.range(0));
+    uint32_t max_one_row_size = src->max_one_element_serialize_size();
+    std::vector<uint8_t> buffer(kNumRows * max_one_row_size);
+    Buffer<uint32_t> slice_sizes(kNumRows);
+    for (auto _ : state) {
+        std::fill(slice_sizes.begin(), slice_sizes.end(), 0);
+        src->serialize_batch(buffer.data(), slice_sizes, kNumRows, max_one_row_size);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+// Args: null percent.
+template <PrimitiveType Type>
+static void BM_crc32_hash(benchmark::State& state) {
+    ColumnPtr src = create_column<Type>(kNumRows, state.range(0));
+    std::vector<uint32_t> hashes(kNumRows);
+    for (auto _ : state) {
+        std::fill(hashes.begin(), hashes.end(), 0);
+        src->crc32_hash(hashes.data(), 0, kNumRows);
+        benchmark::DoNotOptimize(hashes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+// Args: null percent.
+template <PrimitiveType Type>
+static void BM_fvn_hash(benchmark::State& state) {
+    ColumnPtr src = create_column<Type>(kNumRows, state.range(0));
+    std::vector<uint32_t> hashes(kNumRows);
+    for (auto _ : state) {
+        std::fill(hashes.begin(), hashes.end(), HashUtil::FNV_SEED);
+        src->fvn_hash(hashes.data(), 0, kNumRows);
+        benchmark::DoNotOptimize(hashes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+static void null_and_selectivity(benchmark::internal::Benchmark* b) {
+    for (const auto& args : null_and_selectivity_args()) {
+        b->Args(args);
+    }
+}
+
+static void null_percents(benchmark::internal::Benchmark* b) {
+    for (int64_t null_percent : {0, 20, 80}) {
+        b->Arg(null_percent);
+    }
+}
+
+#define COLUMN_BENCHMARKS(TYPE)                                                      \
+    BENCHMARK_TEMPLATE(BM_filter_range, TYPE)->Apply(null_and_selectivity);          \
+    BENCHMARK_TEMPLATE(BM_append_selective, TYPE)->Apply(null_and_selectivity);      \
+    BENCHMARK_TEMPLATE(BM_serialize_batch, TYPE)->Apply(null_percents);              \
+    BENCHMARK_TEMPLATE(BM_crc32_hash, TYPE)->Apply(null_percents);                   \
+    BENCHMARK_TEMPLATE(BM_fvn_hash, TYPE)->Apply(null_percents);
+
+COLUMN_BENCHMARKS(TYPE_INT)
+COLUMN_BENCHMARKS(TYPE_BIGINT)
+COLUMN_BENCHMARKS(TYPE_DOUBLE)
+COLUMN_BENCHMARKS(TYPE_VARCHAR)
+
+} // namespace starrocks::vectorized::bench
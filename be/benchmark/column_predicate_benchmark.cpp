@@ -0,0 +1,92 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <limits>
+#include <memory>
+
+#include "bench_util.h"
+#include "storage/types.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::vectorized::bench {
+
+// The operand of `c < operand` which selects about |selectivity_percent| of the uniform int32 values.
+static std::string lt_operand(int selectivity_percent) {
+    int64_t range = int64_t(std::numeric_limits<uint32_t>::max()) + 1;
+    return std::to_string(std::numeric_limits<int32_t>::min() + range * selectivity_percent / 100);
+}
+
+// Args: null percent, selectivity percent.
+static void BM_lt_predicate(benchmark::State& state) {
+    ColumnPtr column = create_column<TYPE_INT>(kNumRows, state.range(0));
+    std::string operand = lt_operand(state.range(1));
+    std::unique_ptr<ColumnPredicate> predicate(
+            new_column_lt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, Slice(operand)));
+    std::vector<uint8_t> selection(kNumRows);
+    for (auto _ : state) {
+        predicate->evaluate(column.get(), selection.data());
+        benchmark::DoNotOptimize(selection.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+// Args: null percent, selectivity percent, which the and-ed selection is built by.
+static void BM_lt_predicate_and(benchmark::State& state) {
+    ColumnPtr column = create_column<TYPE_INT>(kNumRows, state.range(0));
+    std::string operand = lt_operand(50);
+    std::unique_ptr<ColumnPredicate> predicate(
+            new_column_lt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, Slice(operand)));
+    Column::Filter filter = create_filter(kNumRows, state.range(1));
+    std::vector<uint8_t> selection(kNumRows);
+    for (auto _ : state) {
+        std::copy(filter.begin(), filter.end(), selection.begin());
+        predicate->evaluate_and(column.get(), selection.data());
+        benchmark::DoNotOptimize(selection.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+// Args: null percent, the number of the values in the list.
+static void BM_in_predicate(benchmark::State& state) {
+    ColumnPtr column = create_column<TYPE_INT>(kNumRows, state.range(0));
+    std::vector<std::string> operands;
+    for (int64_t i = 0; i < state.range(1); i++) {
+        operands.emplace_back(std::to_string(ColumnHelper::get_data_column(column.get())->get(i).get_int32()));
+    }
+    std::unique_ptr<ColumnPredicate> predicate(
+            new_column_in_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, operands));
+    std::vector<uint8_t> selection(kNumRows);
+    for (auto _ : state) {
+        predicate->evaluate(column.get(), selection.data());
+        benchmark::DoNotOptimize(selection.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+// Args: null percent.
+static void BM_varchar_eq_predicate(benchmark::State& state) {
+    ColumnPtr column = create_column<TYPE_VARCHAR>(kNumRows, state.range(0));
+    std::string operand = "abcd";
+    std::unique_ptr<ColumnPredicate> predicate(
+            new_column_eq_predicate(get_type_info(OLAP_FIELD_TYPE_VARCHAR), 0, Slice(operand)));
+    std::vector<uint8_t> selection(kNumRows);
+    for (auto _ : state) {
+        predicate->evaluate(column.get(), selection.data());
+        benchmark::DoNotOptimize(selection.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+static void null_and_selectivity(benchmark::internal::Benchmark* b) {
+    for (const auto& args : null_and_selectivity_args()) {
+        b->Args(args);
+    }
+}
+
+BENCHMARK(BM_lt_predicate)->Apply(null_and_selectivity);
+BENCHMARK(BM_lt_predicate_and)->Apply(null_and_selectivity);
+BENCHMARK(BM_in_predicate)->Args({0, 3})->Args({0, 16})->Args({0, 64})->Args({20, 16});
+BENCHMARK(BM_varchar_eq_predicate)->Arg(0)->Arg(20);
+
+} // namespace starrocks::vectorized::bench
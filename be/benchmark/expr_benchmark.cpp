@@ -0,0 +1,116 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "bench_util.h"
+#include "column/const_column.h"
+#include "exprs/expr.h"
+#include "exprs/vectorized/cast_expr.h"
+#include "exprs/vectorized/string_functions.h"
+#include "gen_cpp/Exprs_types.h"
+#include "runtime/primitive_type.h"
+#include "udf/udf.h"
+
+namespace starrocks::vectorized::bench {
+
+// The child of the benchmarked exprs, which evaluates to a prepared column.
+class ColumnExpr final : public Expr {
+public:
+    ColumnExpr(const TExprNode& node, ColumnPtr column) : Expr(node), _column(std::move(column)) {}
+
+    ColumnPtr evaluate(ExprContext*, Chunk*) override { return _column; }
+
+    Expr* clone(ObjectPool* pool) const override { return pool->add(new ColumnExpr(*this)); }
+
+private:
+    ColumnPtr _column;
+};
+
+static TExprNode create_expr_node(TPrimitiveType::type type) {
+    TExprNode node;
+    node.node_type = TExprNodeType::SLOT_REF;
+    node.type = gen_type_desc(type);
+    node.num_children = 0;
+    return node;
+}
+
+// The strings of the integers, to be cast to the integers.
+static ColumnPtr create_int_string_column(size_t num_rows, int null_percent) {
+    ColumnPtr ints = create_column<TYPE_INT>(num_rows, null_percent);
+    ColumnBuilder<TYPE_VARCHAR> builder;
+    builder.reserve(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        if (ints->is_null(i)) {
+            builder.append_null();
+        } else {
+            std::string value = std::to_string(ColumnHelper::get_data_column(ints.get())->get(i).get_int32());
+            builder.append(Slice(value));
+        }
+    }
+    return builder.build(false);
+}
+
+// Args: null percent.
+template <PrimitiveType FromType, TPrimitiveType::type From, TPrimitiveType::type To>
+static void BM_cast(benchmark::State& state) {
+    ColumnPtr column = FromType == TYPE_VARCHAR ? create_int_string_column(kNumRows, state.range(0))
+                                                : create_column<FromType>(kNumRows, state.range(0));
+    ColumnExpr child(create_expr_node(From), column);
+    TExprNode cast_node = create_expr_node(To);
+    cast_node.node_type = TExprNodeType::CAST_EXPR;
+    cast_node.child_type = From;
+    cast_node.__isset.child_type = true;
+    cast_node.num_children = 1;
+    std::unique_ptr<Expr> cast(VectorizedCastExprFactory::from_thrift(cast_node));
+    cast->add_child(&child);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cast->evaluate(nullptr, nullptr));
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+using StringFunction = ColumnPtr (*)(FunctionContext*, const Columns&);
+
+// Args: null percent.
+template <StringFunction Function>
+static void BM_string_function(benchmark::State& state) {
+    std::unique_ptr<FunctionContext> context(FunctionContext::create_test_context());
+    Columns columns{create_column<TYPE_VARCHAR>(kNumRows, state.range(0))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Function(context.get(), columns));
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+// Args: null percent.
+static void BM_substring(benchmark::State& state) {
+    std::unique_ptr<FunctionContext> context(FunctionContext::create_test_context());
+    Columns columns{create_column<TYPE_VARCHAR>(kNumRows, state.range(0)),
+                    ColumnHelper::create_const_column<TYPE_INT>(2, kNumRows),
+                    ColumnHelper::create_const_column<TYPE_INT>(8, kNumRows)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(StringFunctions::substring(context.get(), columns));
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+static void null_percents(benchmark::internal::Benchmark* b) {
+    for (int64_t null_percent : {0, 20, 80}) {
+        b->Arg(null_percent);
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_cast, TYPE_INT, TPrimitiveType::INT, TPrimitiveType::BIGINT)->Apply(null_percents);
+BENCHMARK_TEMPLATE(BM_cast, TYPE_BIGINT, TPrimitiveType::BIGINT, TPrimitiveType::DOUBLE)->Apply(null_percents);
+BENCHMARK_TEMPLATE(BM_cast, TYPE_INT, TPrimitiveType::INT, TPrimitiveType::VARCHAR)->Apply(null_percents);
+BENCHMARK_TEMPLATE(BM_cast, TYPE_VARCHAR, TPrimitiveType::VARCHAR, TPrimitiveType::INT)->Apply(null_percents);
+
+BENCHMARK_TEMPLATE(BM_string_function, StringFunctions::upper)->Apply(null_percents);
+BENCHMARK_TEMPLATE(BM_string_function, StringFunctions::lower)->Apply(null_percents);
+BENCHMARK_TEMPLATE(BM_string_function, StringFunctions::length)->Apply(null_percents);
+BENCHMARK_TEMPLATE(BM_string_function, StringFunctions::reverse)->Apply(null_percents);
+BENCHMARK(BM_substring)->Apply(null_percents);
+
+} // namespace starrocks::vectorized::bench
@@ -0,0 +1,195 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "bench_util.h"
+#include "column/chunk.h"
+#include "common/object_pool.h"
+#include "exec/vectorized/join_hash_map.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::vectorized::bench {
+
+// The probe tuple has the slots 0 (key) and 1 (payload), and the build tuple the slots 2 (key) and 3 (payload).
+static constexpr SlotId kProbeKeySlot = 0;
+static constexpr SlotId kBuildKeySlot = 2;
+
+// The hash table of the HashJoinNode and the HashJoiner of the pipeline, over an inner join of one key.
+template <PrimitiveType KeyType>
+class JoinFixture {
+public:
+    JoinFixture() {
+        TQueryOptions query_options;
+        TQueryGlobals query_globals;
+        _state = std::make_unique<RuntimeState>(TUniqueId(), query_options, query_globals, nullptr);
+        _state->init_instance_mem_tracker();
+        _profile = std::make_unique<RuntimeProfile>("join_benchmark");
+        _mem_tracker = std::make_unique<MemTracker>(_profile.get(), -1, "join_benchmark", nullptr);
+
+        TDescriptorTableBuilder table_builder;
+        for (int i = 0; i < 2; i++) {
+            TTupleDescriptorBuilder tuple_builder;
+            TSlotDescriptorBuilder key_builder;
+            if constexpr (isSlicePT<KeyType>) {
+                key_builder.string_type(255);
+            } else {
+                key_builder.type(KeyType);
+            }
+            tuple_builder.add_slot(key_builder.column_name("key").column_pos(0).nullable(false).build());
+            TSlotDescriptorBuilder payload_builder;
+            payload_builder.type(TYPE_INT).column_name("payload").column_pos(1).nullable(false);
+            tuple_builder.add_slot(payload_builder.build());
+            tuple_builder.build(&table_builder);
+        }
+        DescriptorTbl* tbl = nullptr;
+        DescriptorTbl::create(&_pool, table_builder.desc_tbl(), &tbl);
+        _row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{0, 1}, std::vector<bool>{false, false});
+        _probe_row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{0}, std::vector<bool>{false});
+        _build_row_desc = std::make_unique<RowDescriptor>(*tbl, std::vector<TTupleId>{1}, std::vector<bool>{false});
+
+        _param.join_type = TJoinOp::INNER_JOIN;
+        _param.row_desc = _row_desc.get();
+        _param.mem_tracker = _mem_tracker.get();
+        _param.join_keys.emplace_back(JoinKeyDesc{KeyType, false});
+        _param.probe_row_desc = _probe_row_desc.get();
+        _param.build_row_desc = _build_row_desc.get();
+        _param.search_ht_timer = ADD_TIMER(_profile, "SearchHashTableTimer");
+        _param.output_build_column_timer = ADD_TIMER(_profile, "OutputBuildColumnTimer");
+        _param.output_probe_column_timer = ADD_TIMER(_profile, "OutputProbeColumnTimer");
+        _param.output_tuple_column_timer = ADD_TIMER(_profile, "OutputTupleColumnTimer");
+    }
+
+    // The build keys are unique, and |skew_percent| percent of the probe rows are on the hot key 0.
+    void create_chunks(size_t build_rows, size_t probe_rows, int skew_percent) {
+        std::vector<int32_t> build_keys(build_rows);
+        for (size_t i = 0; i < build_rows; i++) {
+            build_keys[i] = i;
+        }
+        _build_chunks = create_chunks(build_keys, kBuildKeySlot);
+        // Half of the probe keys have no match.
+        _probe_chunks = create_chunks(create_keys(probe_rows, build_rows * 2, skew_percent), kProbeKeySlot);
+    }
+
+    void build(JoinHashTable* hash_table) {
+        hash_table->create(_param);
+        for (const auto& chunk : _build_chunks) {
+            (void)hash_table->append_chunk(_state.get(), chunk);
+        }
+        hash_table->get_key_columns().emplace_back(hash_table->get_build_chunk()->get_column_by_slot_id(kBuildKeySlot));
+        (void)hash_table->build(_state.get());
+    }
+
+    // Returns the number of the output rows.
+    size_t probe(JoinHashTable* hash_table, benchmark::State& state) {
+        size_t num_output_rows = 0;
+        for (const auto& chunk : _probe_chunks) {
+            // The probe may move the columns of the probe chunk into the output.
+            state.PauseTiming();
+            ChunkPtr probe_chunk = copy_chunk(chunk, kProbeKeySlot);
+            state.ResumeTiming();
+            Columns key_columns{probe_chunk->get_column_by_slot_id(kProbeKeySlot)};
+            bool has_remain = true;
+            while (has_remain) {
+                ChunkPtr result_chunk = std::make_shared<Chunk>();
+                (void)hash_table->probe(key_columns, &probe_chunk, &result_chunk, &has_remain);
+                num_output_rows += result_chunk->num_rows();
+            }
+        }
+        return num_output_rows;
+    }
+
+    MemTracker* mem_tracker() { return _mem_tracker.get(); }
+
+private:
+    static std::vector<ChunkPtr> create_chunks(const std::vector<int32_t>& keys, SlotId key_slot) {
+        std::vector<ChunkPtr> chunks;
+        for (size_t from = 0; from < keys.size(); from += kNumRows) {
+            size_t size = std::min(kNumRows, keys.size() - from);
+            auto chunk = std::make_shared<Chunk>();
+            chunk->append_column(create_key_column<KeyType>(keys, from, size), key_slot);
+            chunk->append_column(create_key_column<TYPE_INT>(keys, from, size), key_slot + 1);
+            chunks.emplace_back(std::move(chunk));
+        }
+        return chunks;
+    }
+
+    static ChunkPtr copy_chunk(const ChunkPtr& chunk, SlotId key_slot) {
+        auto copy = std::make_shared<Chunk>();
+        copy->append_column(chunk->get_column_by_slot_id(key_slot)->clone_shared(), key_slot);
+        copy->append_column(chunk->get_column_by_slot_id(key_slot + 1)->clone_shared(), key_slot + 1);
+        return copy;
+    }
+
+    ObjectPool _pool;
+    std::unique_ptr<RuntimeState> _state;
+    std::unique_ptr<RuntimeProfile> _profile;
+    std::unique_ptr<MemTracker> _mem_tracker;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    std::unique_ptr<RowDescriptor> _probe_row_desc;
+    std::unique_ptr<RowDescriptor> _build_row_desc;
+    HashTableParam _param;
+    std::vector<ChunkPtr> _build_chunks;
+    std::vector<ChunkPtr> _probe_chunks;
+};
+
+// Args: build rows.
+template <PrimitiveType KeyType>
+static void BM_hash_join_build(benchmark::State& state) {
+    JoinFixture<KeyType> fixture;
+    fixture.create_chunks(state.range(0), 0, 0);
+    for (auto _ : state) {
+        JoinHashTable hash_table;
+        fixture.build(&hash_table);
+        state.PauseTiming();
+        state.counters["peak_mem_bytes"] = fixture.mem_tracker()->peak_consumption();
+        hash_table.close();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Args: build rows, probe rows, skew percent.
+template <PrimitiveType KeyType>
+static void BM_hash_join_probe(benchmark::State& state) {
+    JoinFixture<KeyType> fixture;
+    fixture.create_chunks(state.range(0), state.range(1), state.range(2));
+    JoinHashTable hash_table;
+    fixture.build(&hash_table);
+    size_t num_output_rows = 0;
+    for (auto _ : state) {
+        num_output_rows = fixture.probe(&hash_table, state);
+    }
+    hash_table.close();
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    state.counters["output_rows"] = num_output_rows;
+    state.counters["peak_mem_bytes"] = fixture.mem_tracker()->peak_consumption();
+}
+
+static void build_args(benchmark::internal::Benchmark* b) {
+    for (int64_t build_rows : {1 << 10, 1 << 16, 1 << 20}) {
+        b->Arg(build_rows);
+    }
+}
+
+static void probe_args(benchmark::internal::Benchmark* b) {
+    for (int64_t build_rows : {1 << 10, 1 << 16, 1 << 20}) {
+        for (int64_t skew_percent : {0, 50, 90}) {
+            b->Args({build_rows, 1 << 20, skew_percent});
+        }
+    }
+}
+
+#define JOIN_BENCHMARKS(TYPE)                                        \
+    BENCHMARK_TEMPLATE(BM_hash_join_build, TYPE)->Apply(build_args); \
+    BENCHMARK_TEMPLATE(BM_hash_join_probe, TYPE)->Apply(probe_args);
+
+JOIN_BENCHMARKS(TYPE_INT)
+JOIN_BENCHMARKS(TYPE_BIGINT)
+JOIN_BENCHMARKS(TYPE_VARCHAR)
+
+} // namespace starrocks::vectorized::bench
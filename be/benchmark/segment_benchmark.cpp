@@ -0,0 +1,280 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <random>
+
+#include "bench_util.h"
+#include "column/chunk.h"
+#include "column/datum.h"
+#include "common/config.h"
+#include "env/env.h"
+#include "gen_cpp/olap_file.pb.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/mem_tracker.h"
+#include "storage/fs/file_block_manager.h"
+#include "storage/olap_common.h"
+#include "storage/page_cache.h"
+#include "storage/rowset/segment_v2/segment.h"
+#include "storage/rowset/segment_v2/segment_writer.h"
+#include "storage/rowset/vectorized/segment_options.h"
+#include "storage/tablet_schema.h"
+#include "storage/types.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/column_predicate.h"
+#include "util/file_utils.h"
+#include "util/stopwatch.hpp"
+
+namespace starrocks::vectorized::bench {
+
+// A segment of the duplicate keys table
+//   c0 INT (sorted key), c1 BIGINT, c2 VARCHAR (bloom filter), c3 VARCHAR (bitmap index, 100 values),
+// written with the encoding of c1 and the compression of the benchmark.
+static constexpr size_t kSegmentRows = 1 << 20;
+static constexpr size_t kPageCacheCapacity = 4L * 1024 * 1024 * 1024;
+static const char* const kSegmentDir = "./segment_benchmark_data";
+
+enum class PredicateKind {
+    kNone = 0,
+    // c0 < 1% of the rows, pruned by the zone maps.
+    kZoneMap = 1,
+    // c2 = a value of one row, pruned by the bloom filters.
+    kBloomFilter = 2,
+    // c3 = one of the 100 values, filtered by the bitmap index.
+    kBitmapIndex = 3,
+    // c1 < 10% of the values, evaluated on the rows read.
+    kVectorized = 4,
+};
+
+static TabletSchema create_tablet_schema() {
+    TabletSchemaPB schema_pb;
+    schema_pb.set_keys_type(DUP_KEYS);
+    schema_pb.set_num_short_key_columns(1);
+    schema_pb.set_num_rows_per_row_block(1024);
+    schema_pb.set_bf_fpp(0.05);
+    schema_pb.set_next_column_unique_id(4);
+    auto add_column = [&](const std::string& name, const std::string& type, int32_t length, bool is_key) {
+        ColumnPB* column = schema_pb.add_column();
+        column->set_unique_id(schema_pb.column_size() - 1);
+        column->set_name(name);
+        column->set_type(type);
+        column->set_is_key(is_key);
+        column->set_aggregation("NONE");
+        column->set_is_nullable(false);
+        column->set_length(length);
+        column->set_index_length(length);
+        return column;
+    };
+    add_column("c0", "INT", 4, true);
+    add_column("c1", "BIGINT", 8, false);
+    add_column("c2", "VARCHAR", 64, false)->set_is_bf_column(true);
+    add_column("c3", "VARCHAR", 16, false)->set_has_bitmap_index(true);
+    TabletSchema schema;
+    schema.init_from_pb(schema_pb);
+    return schema;
+}
+
+class SegmentFixture {
+public:
+    SegmentFixture() : _block_mgr(Env::Default(), fs::BlockManagerOptions()), _tablet_schema(create_tablet_schema()) {
+        CHECK(FileUtils::create_dir(kSegmentDir).ok());
+        StoragePageCache::create_global_cache(&_page_cache_mem_tracker, kPageCacheCapacity);
+    }
+
+    ~SegmentFixture() {
+        StoragePageCache::release_global_cache();
+        (void)FileUtils::remove_all(kSegmentDir);
+    }
+
+    // The segments are written once by the encoding and the compression, and shared by the benchmarks.
+    static SegmentFixture* instance() {
+        static SegmentFixture fixture;
+        return &fixture;
+    }
+
+    const std::string& segment_file(EncodingTypePB encoding, CompressionTypePB compression) {
+        auto key = std::make_pair(encoding, compression);
+        auto iter = _segment_files.find(key);
+        if (iter == _segment_files.end()) {
+            std::string file = strings::Substitute("$0/$1_$2.dat", kSegmentDir, encoding, compression);
+            Status st = write_segment(file, encoding, compression);
+            CHECK(st.ok()) << st.to_string();
+            iter = _segment_files.emplace(key, std::move(file)).first;
+        }
+        return iter->second;
+    }
+
+    std::shared_ptr<segment_v2::Segment> open_segment(const std::string& file) {
+        std::shared_ptr<segment_v2::Segment> segment;
+        Status st = segment_v2::Segment::open(&_mem_tracker, &_block_mgr, file, 0, &_tablet_schema, &segment);
+        CHECK(st.ok()) << st.to_string();
+        return segment;
+    }
+
+    // Drop the pages cached, for a cold scan. The pages cached by the OS are not dropped.
+    void clear_page_cache() {
+        StoragePageCache::release_global_cache();
+        StoragePageCache::create_global_cache(&_page_cache_mem_tracker, kPageCacheCapacity);
+    }
+
+    fs::BlockManager* block_mgr() { return &_block_mgr; }
+
+    const TabletSchema& tablet_schema() const { return _tablet_schema; }
+
+private:
+    Status write_segment(const std::string& file, EncodingTypePB encoding, CompressionTypePB compression) {
+        segment_v2::SegmentWriterOptions opts;
+        opts.mem_tracker = &_mem_tracker;
+        opts.storage_format_version = 2;
+        opts.encodings[1] = encoding;
+        opts.compression = compression;
+        std::unique_ptr<fs::WritableBlock> wblock;
+        RETURN_IF_ERROR(_block_mgr.create_block(fs::CreateBlockOptions({file}), &wblock));
+        segment_v2::SegmentWriter writer(std::move(wblock), 0, &_tablet_schema, opts);
+        RETURN_IF_ERROR(writer.init(0));
+
+        Schema schema = ChunkHelper::convert_schema_to_format_v2(_tablet_schema);
+        std::mt19937 rng(0);
+        for (size_t from = 0; from < kSegmentRows; from += kNumRows) {
+            auto chunk = ChunkHelper::new_chunk(schema, kNumRows);
+            auto& columns = chunk->columns();
+            for (size_t i = from; i < from + kNumRows; i++) {
+                std::string c2 = "value_" + std::to_string(i);
+                std::string c3 = "tag_" + std::to_string(rng() % 100);
+                columns[0]->append_datum(Datum(static_cast<int32_t>(i)));
+                columns[1]->append_datum(Datum(static_cast<int64_t>(rng() % 1000000)));
+                columns[2]->append_datum(Datum(Slice(c2)));
+                columns[3]->append_datum(Datum(Slice(c3)));
+            }
+            RETURN_IF_ERROR(writer.append_chunk(*chunk));
+        }
+        uint64_t file_size = 0;
+        uint64_t index_size = 0;
+        return writer.finalize(&file_size, &index_size);
+    }
+
+    MemTracker _mem_tracker;
+    MemTracker _page_cache_mem_tracker;
+    fs::FileBlockManager _block_mgr;
+    TabletSchema _tablet_schema;
+    std::map<std::pair<EncodingTypePB, CompressionTypePB>, std::string> _segment_files;
+};
+
+static ColumnPredicate* create_predicate(PredicateKind kind, const TabletSchema& tablet_schema) {
+    auto type_info = [&](ColumnId cid) { return get_type_info(tablet_schema.column(cid).type()); };
+    switch (kind) {
+    case PredicateKind::kNone:
+        return nullptr;
+    case PredicateKind::kZoneMap:
+        return new_column_lt_predicate(type_info(0), 0, std::to_string(kSegmentRows / 100));
+    case PredicateKind::kBloomFilter:
+        return new_column_eq_predicate(type_info(2), 2, "value_12345");
+    case PredicateKind::kBitmapIndex:
+        return new_column_eq_predicate(type_info(3), 3, "tag_42");
+    case PredicateKind::kVectorized:
+        return new_column_lt_predicate(type_info(1), 1, "100000");
+    }
+    return nullptr;
+}
+
+// Returns the number of the rows output.
+static int64_t scan_segment(segment_v2::Segment* segment, const Schema& schema, const ColumnPredicate* predicate,
+                            fs::BlockManager* block_mgr, OlapReaderStatistics* stats) {
+    SegmentReadOptions opts;
+    opts.block_mgr = block_mgr;
+    opts.stats = stats;
+    opts.use_page_cache = true;
+    opts.chunk_size = kNumRows;
+    if (predicate != nullptr) {
+        opts.predicates[predicate->column_id()].emplace_back(predicate);
+    }
+    auto iter = segment->new_iterator(schema, opts);
+    if (!iter.ok()) {
+        // All the rows are pruned.
+        CHECK(iter.status().is_end_of_file()) << iter.status().to_string();
+        return 0;
+    }
+    int64_t num_rows = 0;
+    auto chunk = ChunkHelper::new_chunk(iter.value()->schema(), kNumRows);
+    Status st;
+    while ((st = iter.value()->get_next(chunk.get())).ok()) {
+        num_rows += chunk->num_rows();
+        chunk->reset();
+    }
+    CHECK(st.is_end_of_file()) << st.to_string();
+    iter.value()->close();
+    return num_rows;
+}
+
+// Args: encoding of c1, compression, predicate kind, late materialization, warm page cache.
+static void BM_segment_scan(benchmark::State& state) {
+    SegmentFixture* fixture = SegmentFixture::instance();
+    const std::string& file = fixture->segment_file(static_cast<EncodingTypePB>(state.range(0)),
+                                                    static_cast<CompressionTypePB>(state.range(1)));
+    std::unique_ptr<ColumnPredicate> predicate(
+            create_predicate(static_cast<PredicateKind>(state.range(2)), fixture->tablet_schema()));
+    const int32_t late_materialization_ratio = config::late_materialization_ratio;
+    // Always late materialize the columns without predicates, or never.
+    config::late_materialization_ratio = state.range(3) ? 1000 : 0;
+    const bool warm = state.range(4);
+
+    Schema schema = ChunkHelper::convert_schema_to_format_v2(fixture->tablet_schema());
+    std::shared_ptr<segment_v2::Segment> segment = fixture->open_segment(file);
+    if (warm) {
+        OlapReaderStatistics stats;
+        scan_segment(segment.get(), schema, predicate.get(), fixture->block_mgr(), &stats);
+    }
+    OlapReaderStatistics stats;
+    int64_t num_rows = 0;
+    int64_t scan_ns = 0;
+    for (auto _ : state) {
+        if (!warm) {
+            state.PauseTiming();
+            fixture->clear_page_cache();
+            // The indexes loaded by the segment are dropped as well.
+            segment = fixture->open_segment(file);
+            state.ResumeTiming();
+        }
+        MonotonicStopWatch watch;
+        watch.start();
+        num_rows += scan_segment(segment.get(), schema, predicate.get(), fixture->block_mgr(), &stats);
+        scan_ns += watch.elapsed_time();
+    }
+    config::late_materialization_ratio = late_materialization_ratio;
+
+    const auto iterations = static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations() * kSegmentRows);
+    state.counters["rows_output"] = num_rows / iterations;
+    state.counters["bytes_read"] = stats.bytes_read / iterations;
+    state.counters["compressed_bytes_read"] = stats.compressed_bytes_read / iterations;
+    state.counters["pages_decoded"] = (stats.total_pages_num - stats.cached_pages_num) / iterations;
+    state.counters["pages_cached"] = stats.cached_pages_num / iterations;
+    state.counters["ns_per_row"] = scan_ns / iterations / kSegmentRows;
+}
+
+static void scan_args(benchmark::internal::Benchmark* b) {
+    // The encodings and the compressions, by a full scan and a vectorized predicate.
+    for (int64_t encoding : {DEFAULT_ENCODING, BIT_SHUFFLE, FOR_ENCODING, PLAIN_ENCODING}) {
+        for (int64_t compression : {LZ4_FRAME, ZSTD, NO_COMPRESSION}) {
+            for (int64_t warm : {0, 1}) {
+                b->Args({encoding, compression, static_cast<int64_t>(PredicateKind::kNone), 0, warm});
+                b->Args({encoding, compression, static_cast<int64_t>(PredicateKind::kVectorized), 1, warm});
+            }
+        }
+    }
+    // The indexes and the late materialization.
+    for (auto kind : {PredicateKind::kZoneMap, PredicateKind::kBloomFilter, PredicateKind::kBitmapIndex,
+                      PredicateKind::kVectorized}) {
+        for (int64_t late_materialization : {0, 1}) {
+            for (int64_t warm : {0, 1}) {
+                b->Args({DEFAULT_ENCODING, LZ4_FRAME, static_cast<int64_t>(kind), late_materialization, warm});
+            }
+        }
+    }
+}
+
+BENCHMARK(BM_segment_scan)->Apply(scan_args)->Unit(benchmark::kMillisecond);
+
+} // namespace starrocks::vectorized::bench
@@ -0,0 +1,31 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "bench_util.h"
+#include "simd/simd.h"
+
+namespace starrocks::vectorized::bench {
+
+// Args: selectivity percent, i.e. the percent of the nonzero bytes.
+static void BM_count_zero(benchmark::State& state) {
+    Column::Filter filter = create_filter(kNumRows, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SIMD::count_zero(filter.data(), filter.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * kNumRows);
+}
+
+// Args: selectivity percent, i.e. the percent of the nonzero bytes.
+static void BM_count_nonzero(benchmark::State& state) {
+    Column::Filter filter = create_filter(kNumRows, state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SIMD::count_nonzero(filter.data(), filter.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * kNumRows);
+}
+
+BENCHMARK(BM_count_zero)->Arg(0)->Arg(5)->Arg(50)->Arg(100);
+BENCHMARK(BM_count_nonzero)->Arg(0)->Arg(5)->Arg(50)->Arg(100);
+
+} // namespace starrocks::vectorized::bench
@@ -0,0 +1,88 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include "bench_util.h"
+#include "column/chunk.h"
+#include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exec/vectorized/chunks_sorter_topn.h"
+#include "exprs/expr_context.h"
+#include "exprs/slot_ref.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::vectorized::bench {
+
+// The chunks of the TYPE slot 0 to sort by and of an int payload of the slot 1.
+template <PrimitiveType Type>
+static std::vector<ChunkPtr> create_sort_chunks(size_t num_rows, int null_percent) {
+    std::vector<ChunkPtr> chunks;
+    for (size_t from = 0; from < num_rows; from += kNumRows) {
+        size_t size = std::min(kNumRows, num_rows - from);
+        auto chunk = std::make_shared<Chunk>();
+        chunk->append_column(create_column<Type>(size, null_percent, from), 0);
+        chunk->append_column(create_column<TYPE_INT>(size, 0, from + 1), 1);
+        chunks.emplace_back(std::move(chunk));
+    }
+    return chunks;
+}
+
+// The sorters of the SortNode and of the sort operators of the pipeline, the top-n one for a positive limit.
+// Args: rows, limit (0 for the full sort), null percent.
+template <PrimitiveType Type>
+static void BM_chunks_sort(benchmark::State& state) {
+    std::vector<ChunkPtr> chunks = create_sort_chunks<Type>(state.range(0), state.range(2));
+    SlotRef slot_ref(TypeDescriptor(Type), 0, 0);
+    ExprContext sort_expr(&slot_ref);
+    std::vector<ExprContext*> sort_exprs{&sort_expr};
+    std::vector<bool> is_asc{true};
+    std::vector<bool> is_null_first{true};
+    const size_t limit = state.range(1);
+    TQueryOptions query_options;
+    TQueryGlobals query_globals;
+    RuntimeState runtime_state(TUniqueId(), query_options, query_globals, nullptr);
+    runtime_state.init_instance_mem_tracker();
+    RuntimeProfile profile("sort_benchmark");
+    ADD_TIMER(&profile, "SortTimer");
+    MemTracker mem_tracker(&profile, -1, "sort_benchmark", nullptr);
+    for (auto _ : state) {
+        std::unique_ptr<ChunksSorter> sorter;
+        if (limit > 0) {
+            sorter = std::make_unique<ChunksSorterTopn>(&sort_exprs, &is_asc, &is_null_first, 0, limit);
+        } else {
+            sorter = std::make_unique<ChunksSorterFullSort>(&sort_exprs, &is_asc, &is_null_first, 1000);
+        }
+        sorter->setup_runtime(&mem_tracker, &profile, "SortTimer");
+        for (const auto& chunk : chunks) {
+            (void)sorter->update(&runtime_state, chunk);
+        }
+        (void)sorter->done(&runtime_state);
+        bool eos = false;
+        while (!eos) {
+            ChunkPtr chunk;
+            (void)sorter->get_next(&chunk, &eos);
+            benchmark::DoNotOptimize(chunk);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["peak_mem_bytes"] = mem_tracker.peak_consumption();
+}
+
+static void sort_args(benchmark::internal::Benchmark* b) {
+    for (int64_t num_rows : {1 << 16, 1 << 20}) {
+        for (int64_t limit : {0, 10, 1000}) {
+            for (int64_t null_percent : {0, 20}) {
+                b->Args({num_rows, limit, null_percent});
+            }
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_chunks_sort, TYPE_INT)->Apply(sort_args);
+BENCHMARK_TEMPLATE(BM_chunks_sort, TYPE_BIGINT)->Apply(sort_args);
+BENCHMARK_TEMPLATE(BM_chunks_sort, TYPE_VARCHAR)->Apply(sort_args);
+
+} // namespace starrocks::vectorized::bench
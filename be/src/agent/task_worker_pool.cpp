@@ -47,6 +47,7 @@
 #include "storage/snapshot_manager.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet.h"
+#include "storage/tablet_schema_map.h"
 #include "storage/task/engine_alter_tablet_task.h"
 #include "storage/task/engine_batch_load_task.h"
 #include "storage/task/engine_checksum_task.h"
@@ -833,10 +834,15 @@ void* TaskWorkerPool::_update_tablet_meta_worker_thread_callback(void* arg_this)
                 case TTabletMetaType::PARTITIONID:
                     tablet->set_partition_id(tablet_meta_info.partition_id);
                     break;
-                case TTabletMetaType::INMEMORY:
-                    tablet->tablet_meta()->mutable_tablet_schema()->set_is_in_memory(tablet_meta_info.is_in_memory);
+                case TTabletMetaType::INMEMORY: {
+                    // The schema may be shared by other tablets, so it is replaced rather than modified.
+                    TabletSchemaPB schema_pb;
+                    tablet->tablet_schema().to_schema_pb(&schema_pb);
+                    schema_pb.set_is_in_memory(tablet_meta_info.is_in_memory);
+                    tablet->tablet_meta()->set_tablet_schema(TabletSchemaMap::instance()->emplace(schema_pb));
                     break;
                 }
+                }
             }
             tablet->save_meta();
         }
@@ -0,0 +1,64 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "common/logging.h"
+
+namespace starrocks::vectorized {
+
+// The IN lists of more values than this are put in the hash sets instead.
+constexpr size_t kMaxArraySetSize = 16;
+
+// ArraySet is a set of at most N values of fixed length type, for the small IN lists, e.g. `a in (1, 2, 3)`.
+// The unused slots are padded with the first value, so contains() compares |v| with all the N slots without a
+// branch, which the compiler vectorizes into a broadcast and a few SIMD compares, and is much cheaper than probing a
+// hash set for N up to 16.
+//
+// The values are added by push_back(), at most N of them. The duplicates make no difference to contains().
+template <typename T, size_t N>
+class ArraySet {
+public:
+    static_assert(N >= 1 && N <= kMaxArraySetSize);
+
+    using value_type = T;
+    using const_iterator = const T*;
+
+    void push_back(const T& v) {
+        DCHECK_LT(_size, N);
+        if (_size == 0) {
+            _values.fill(v);
+        } else {
+            _values[_size] = v;
+        }
+        _size++;
+    }
+
+    // Must not be empty().
+    bool contains(const T& v) const noexcept {
+        DCHECK_GT(_size, 0);
+        bool found = false;
+        for (size_t i = 0; i < N; i++) {
+            found |= (v == _values[i]);
+        }
+        return found;
+    }
+
+    size_t size() const { return _size; }
+
+    bool empty() const { return _size == 0; }
+
+    void clear() { _size = 0; }
+
+    const_iterator begin() const { return _values.data(); }
+
+    const_iterator end() const { return _values.data() + _size; }
+
+private:
+    std::array<T, N> _values{};
+    size_t _size = 0;
+};
+
+} // namespace starrocks::vectorized
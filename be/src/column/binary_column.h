@@ -155,6 +155,24 @@ public:
 
     bool append_continuous_strings(const std::vector<Slice>& strs) override;
 
+    // Append the |num| strings stored back to back from |data|, the i-th of which ends at |end_offset(i)| bytes
+    // from |data|, by one copy of their bytes and without building their slices.
+    template <typename EndOffset>
+    void append_continuous_strings(const uint8_t* data, size_t num, EndOffset&& end_offset) {
+        if (num == 0) {
+            return;
+        }
+        const Offset base = _bytes.size();
+        const size_t old_num = _offsets.size();
+        _offsets.resize(old_num + num);
+        Offset* offsets = _offsets.data() + old_num;
+        for (size_t i = 0; i < num; i++) {
+            offsets[i] = base + end_offset(i);
+        }
+        _bytes.insert(_bytes.end(), data, data + (offsets[num - 1] - base));
+        _slices_cache = false;
+    }
+
     size_t append_numbers(const void* buff, size_t length) override { return -1; }
 
     void append_value_multiple_times(const void* value, size_t count) override;
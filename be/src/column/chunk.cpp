@@ -2,12 +2,14 @@
 
 #include "column/chunk.h"
 
+#include "column/column_encoder.h"
 #include "column/column_helper.h"
 #include "column/datum_tuple.h"
 #include "column/fixed_length_column.h"
 #include "gen_cpp/data.pb.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/descriptors.h"
+#include "simd/simd.h"
 #include "util/coding.h"
 
 namespace starrocks::vectorized {
@@ -151,7 +153,38 @@ void Chunk::serialize(uint8_t* dst) const {
     }
 }
 
+size_t Chunk::max_serialize_encoded_size() const {
+    size_t size = sizeof(uint32_t) + sizeof(uint32_t); // version + num rows
+    for (const auto& column : _columns) {
+        size += ColumnEncoder::max_encoded_size(*column);
+    }
+    return size;
+}
+
+size_t Chunk::serialize_encoded(uint8_t* dst) const {
+    uint8_t* begin = dst;
+    uint32_t version = 2;
+    encode_fixed32_le(dst, version);
+    dst += sizeof(uint32_t);
+
+    encode_fixed32_le(dst, num_rows());
+    dst += sizeof(uint32_t);
+
+    for (const auto& column : _columns) {
+        dst = ColumnEncoder::encode(column.get(), dst);
+    }
+    return dst - begin;
+}
+
 size_t Chunk::serialize_with_meta(starrocks::ChunkPB* chunk) const {
+    serialize_meta(chunk);
+    size_t size = serialize_size();
+    chunk->mutable_data()->resize(size);
+    serialize((uint8_t*)chunk->mutable_data()->data());
+    return size;
+}
+
+void Chunk::serialize_meta(starrocks::ChunkPB* chunk) const {
     chunk->clear_slot_id_map();
     chunk->mutable_slot_id_map()->Reserve(static_cast<int>(_slot_id_to_index.size()) * 2);
     for (const auto& kv : _slot_id_to_index) {
@@ -179,11 +212,6 @@ size_t Chunk::serialize_with_meta(starrocks::ChunkPB* chunk) const {
     }
 
     DCHECK_EQ(_columns.size(), _tuple_id_to_index.size() + _slot_id_to_index.size());
-
-    size_t size = serialize_size();
-    chunk->mutable_data()->resize(size);
-    serialize((uint8_t*)chunk->mutable_data()->data());
-    return size;
 }
 
 Status Chunk::deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta& meta) {
@@ -191,22 +219,32 @@ Status Chunk::deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta
     _tuple_id_to_index = meta.tuple_id_to_index;
     _columns.resize(_slot_id_to_index.size() + _tuple_id_to_index.size());
 
+    const uint8_t* begin = src;
     uint32_t version = decode_fixed32_le(src);
-    DCHECK_EQ(version, 1);
+    if (UNLIKELY(version != 1 && version != 2)) {
+        return Status::InternalError(
+                strings::Substitute("deserialize chunk data failed. unknown version: $0", version));
+    }
     src += sizeof(uint32_t);
 
     size_t rows = decode_fixed32_le(src);
     src += sizeof(uint32_t);
 
+    // The chunks are deserialized by the exchange for every batch, so the columns are taken from the pool.
     for (size_t i = 0; i < meta.is_nulls.size(); ++i) {
-        _columns[i] = ColumnHelper::create_column(meta.types[i], meta.is_nulls[i], meta.is_consts[i], rows);
+        if (meta.is_consts[i]) {
+            _columns[i] = ColumnHelper::create_column(meta.types[i], meta.is_nulls[i], true, rows);
+        } else {
+            _columns[i] = ColumnHelper::create_column_pooled(meta.types[i], meta.is_nulls[i]);
+        }
     }
 
     for (const auto& column : _columns) {
-        src = column->deserialize_column(src);
+        src = version == 1 ? column->deserialize_column(src) : ColumnEncoder::decode(src, column.get());
     }
 
-    size_t except = serialize_size();
+    // The encoded columns have no size known upfront, but must take up the data exactly.
+    size_t except = version == 1 ? serialize_size() : src - begin;
     if (UNLIKELY(len != except)) {
         return Status::InternalError(
                 strings::Substitute("deserialize chunk data failed. len: $0, except: $1", len, except));
@@ -276,13 +314,19 @@ void Chunk::append_selective(const Chunk& src, const uint32_t* indexes, uint32_t
 }
 
 size_t Chunk::filter(const Buffer<uint8_t>& selection) {
-    for (auto& column : _columns) {
-        column->filter(selection);
-    }
-    return num_rows();
+    return filter_range(selection, 0, selection.size());
 }
 
+// The selection is counted once for all the columns, so that the columns needn't be scanned by a selection of all
+// or none of the rows, which are common after a predicate or a join.
 size_t Chunk::filter_range(const Buffer<uint8_t>& selection, size_t from, size_t to) {
+    const size_t num_selected = SIMD::count_nonzero(selection.data() + from, to - from);
+    if (num_selected == to - from || num_selected == 0) {
+        for (auto& column : _columns) {
+            column->resize(num_selected == 0 ? from : to);
+        }
+        return num_rows();
+    }
     for (auto& column : _columns) {
         column->filter_range(selection, from, to);
     }
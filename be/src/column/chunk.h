@@ -110,6 +110,9 @@ public:
     // The result value is the chunk data serialize size
     size_t serialize_with_meta(starrocks::ChunkPB* chunk) const;
 
+    // Only serialize chunk meta to ChunkPB, the data is serialized by serialize() separately
+    void serialize_meta(starrocks::ChunkPB* chunk) const;
+
     // Only serialize chunk data to dst
     // The serialize format:
     //     version(4 byte)
@@ -121,7 +124,15 @@ public:
     // Note: You should ensure the dst buffer size is enough
     void serialize(uint8_t* dst) const;
 
-    // Deserialize chunk by |src| (chunk data) and |meta| (chunk meta)
+    // The max bytes of serialize_encoded
+    size_t max_serialize_encoded_size() const;
+
+    // Serialize chunk data to dst in the format of version 2, whose columns are encoded by ColumnEncoder rather than
+    // copied, and return the bytes written
+    // Note: You should ensure the dst buffer size is at least max_serialize_encoded_size()
+    size_t serialize_encoded(uint8_t* dst) const;
+
+    // Deserialize chunk by |src| (chunk data of either serialize or serialize_encoded) and |meta| (chunk meta)
     Status deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta& meta);
 
     // Create an empty chunk with the same meta and reserve it of size chunk _num_rows
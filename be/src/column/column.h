@@ -69,6 +69,9 @@ public:
 
     virtual bool is_array() const { return false; }
 
+    // Whether the values are codes of a dictionary shared by the column and the other columns of the
+    // same slot. The dictionaries of the segments are only used inside the segment iterators, which
+    // decode the codes before outputting a chunk, so none of the columns is yet.
     virtual bool low_cardinality() const { return false; }
 
     virtual const uint8_t* raw_data() const = 0;
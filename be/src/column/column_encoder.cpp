@@ -0,0 +1,296 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/column_encoder.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "column/binary_column.h"
+#include "column/column_hash.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/logging.h"
+#include "gutil/casts.h"
+#include "util/bit_packing.inline.h"
+#include "util/coding.h"
+#include "util/phmap/phmap.h"
+#include "util/raw_container.h"
+
+namespace starrocks::vectorized {
+
+enum Encoding : uint8_t { RAW = 0, NULLABLE = 1, FOR = 2, RLE = 3, DICT = 4 };
+
+// The widths of the bit packed values fit in a 64 bits buffer with the bits left of the previous value.
+static constexpr int kMaxPackedBitWidth = 32;
+
+static int bit_width(uint64_t value) {
+    return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+static size_t packed_bytes(size_t num_values, int width) {
+    return (num_values * width + 7) / 8;
+}
+
+// Bit pack the |num_values| values of |value_at| in the layout of BitPacking.
+template <typename F>
+static uint8_t* pack_bits(size_t num_values, int width, F&& value_at, uint8_t* dst) {
+    uint64_t buffer = 0;
+    int bits = 0;
+    for (size_t i = 0; i < num_values; i++) {
+        buffer |= static_cast<uint64_t>(value_at(i)) << bits;
+        bits += width;
+        while (bits >= 8) {
+            *dst++ = static_cast<uint8_t>(buffer);
+            buffer >>= 8;
+            bits -= 8;
+        }
+    }
+    if (bits > 0) {
+        *dst++ = static_cast<uint8_t>(buffer);
+    }
+    return dst;
+}
+
+static const uint8_t* unpack_bits(const uint8_t* src, size_t num_values, int width, uint32_t* values) {
+    if (width == 0) {
+        std::fill(values, values + num_values, 0);
+        return src;
+    }
+    size_t bytes = packed_bytes(num_values, width);
+    BitPacking::UnpackValues(width, src, bytes, num_values, values);
+    return src + bytes;
+}
+
+template <typename F>
+static bool visit_integer_column(Column* column, F&& f) {
+    if (auto* c = dynamic_cast<Int8Column*>(column)) {
+        f(c);
+    } else if (auto* c = dynamic_cast<UInt8Column*>(column)) {
+        f(c);
+    } else if (auto* c = dynamic_cast<Int16Column*>(column)) {
+        f(c);
+    } else if (auto* c = dynamic_cast<Int32Column*>(column)) {
+        f(c);
+    } else if (auto* c = dynamic_cast<Int64Column*>(column)) {
+        f(c);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static uint8_t* encode_raw(Column* column, uint8_t* dst) {
+    *dst++ = RAW;
+    return column->serialize_column(dst);
+}
+
+template <typename T>
+static uint8_t* encode_integers(FixedLengthColumn<T>* column, uint8_t* dst) {
+    using UT = std::make_unsigned_t<T>;
+    const auto& data = column->get_data();
+    const size_t num_rows = data.size();
+    if (num_rows == 0) {
+        return encode_raw(column, dst);
+    }
+    T min = data[0];
+    T max = data[0];
+    size_t num_runs = 1;
+    for (size_t i = 1; i < num_rows; i++) {
+        min = std::min(min, data[i]);
+        max = std::max(max, data[i]);
+        num_runs += data[i] != data[i - 1];
+    }
+    const int width = bit_width(static_cast<UT>(static_cast<UT>(max) - static_cast<UT>(min)));
+
+    const size_t raw_size = 1 + column->serialize_size();
+    const size_t for_size = width <= kMaxPackedBitWidth
+                                    ? 1 + sizeof(uint32_t) + sizeof(T) + 1 + packed_bytes(num_rows, width)
+                                    : raw_size;
+    const size_t rle_size = 1 + 2 * sizeof(uint32_t) + num_runs * (sizeof(T) + sizeof(uint32_t));
+    if (for_size < raw_size && for_size <= rle_size) {
+        *dst++ = FOR;
+        encode_fixed32_le(dst, num_rows);
+        dst += sizeof(uint32_t);
+        memcpy(dst, &min, sizeof(T));
+        dst += sizeof(T);
+        *dst++ = width;
+        const UT base = static_cast<UT>(min);
+        return pack_bits(
+                num_rows, width, [&](size_t i) { return static_cast<UT>(static_cast<UT>(data[i]) - base); }, dst);
+    }
+    if (rle_size < raw_size) {
+        *dst++ = RLE;
+        encode_fixed32_le(dst, num_rows);
+        dst += sizeof(uint32_t);
+        encode_fixed32_le(dst, num_runs);
+        dst += sizeof(uint32_t);
+        uint8_t* lengths = dst + num_runs * sizeof(T);
+        size_t begin = 0;
+        for (size_t i = 1; i <= num_rows; i++) {
+            if (i == num_rows || data[i] != data[begin]) {
+                memcpy(dst, &data[begin], sizeof(T));
+                dst += sizeof(T);
+                encode_fixed32_le(lengths, i - begin);
+                lengths += sizeof(uint32_t);
+                begin = i;
+            }
+        }
+        return lengths;
+    }
+    return encode_raw(column, dst);
+}
+
+template <typename T>
+static const uint8_t* decode_integers(Encoding encoding, const uint8_t* src, FixedLengthColumn<T>* column) {
+    using UT = std::make_unsigned_t<T>;
+    auto& data = column->get_data();
+    const size_t num_rows = decode_fixed32_le(src);
+    src += sizeof(uint32_t);
+    raw::make_room(&data, num_rows);
+    if (encoding == FOR) {
+        T min;
+        memcpy(&min, src, sizeof(T));
+        src += sizeof(T);
+        const int width = *src++;
+        raw::RawVector<uint32_t> offsets;
+        offsets.resize(num_rows);
+        src = unpack_bits(src, num_rows, width, offsets.data());
+        const UT base = static_cast<UT>(min);
+        T* values = data.data();
+        for (size_t i = 0; i < num_rows; i++) {
+            values[i] = static_cast<T>(static_cast<UT>(base + offsets[i]));
+        }
+        return src;
+    }
+    DCHECK_EQ(RLE, encoding);
+    const size_t num_runs = decode_fixed32_le(src);
+    src += sizeof(uint32_t);
+    const uint8_t* lengths = src + num_runs * sizeof(T);
+    T* values = data.data();
+    for (size_t i = 0; i < num_runs; i++) {
+        T value;
+        memcpy(&value, src, sizeof(T));
+        src += sizeof(T);
+        uint32_t length = decode_fixed32_le(lengths);
+        lengths += sizeof(uint32_t);
+        std::fill(values, values + length, value);
+        values += length;
+    }
+    return lengths;
+}
+
+static uint8_t* encode_strings(BinaryColumn* column, uint8_t* dst) {
+    const size_t num_rows = column->size();
+    if (num_rows == 0) {
+        return encode_raw(column, dst);
+    }
+    // A dictionary of more than half of the rows hardly pays for itself, so give up early.
+    const size_t max_dict_size = num_rows / 2;
+    phmap::flat_hash_map<Slice, uint32_t, SliceHash> codes_of;
+    BinaryColumn dict;
+    raw::RawVector<uint32_t> codes;
+    codes.resize(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+        Slice value = column->get_slice(i);
+        auto [iter, inserted] = codes_of.try_emplace(value, codes_of.size());
+        if (inserted) {
+            if (codes_of.size() > max_dict_size) {
+                return encode_raw(column, dst);
+            }
+            dict.append(value);
+        }
+        codes[i] = iter->second;
+    }
+    const int width = bit_width(dict.size() - 1);
+
+    const size_t raw_size = 1 + column->serialize_size();
+    const size_t dict_size = 1 + sizeof(uint32_t) + dict.serialize_size() + 1 + packed_bytes(num_rows, width);
+    if (width > kMaxPackedBitWidth || dict_size >= raw_size) {
+        return encode_raw(column, dst);
+    }
+    *dst++ = DICT;
+    encode_fixed32_le(dst, num_rows);
+    dst += sizeof(uint32_t);
+    dst = dict.serialize_column(dst);
+    *dst++ = width;
+    return pack_bits(
+            num_rows, width, [&](size_t i) { return codes[i]; }, dst);
+}
+
+static const uint8_t* decode_strings(const uint8_t* src, BinaryColumn* column) {
+    const size_t num_rows = decode_fixed32_le(src);
+    src += sizeof(uint32_t);
+    BinaryColumn dict;
+    src = dict.deserialize_column(src);
+    const int width = *src++;
+    raw::RawVector<uint32_t> codes;
+    codes.resize(num_rows);
+    src = unpack_bits(src, num_rows, width, codes.data());
+
+    size_t num_bytes = 0;
+    for (size_t i = 0; i < num_rows; i++) {
+        num_bytes += dict.get_slice(codes[i]).size;
+    }
+    column->reserve(num_rows, num_bytes);
+    for (size_t i = 0; i < num_rows; i++) {
+        column->append(dict.get_slice(codes[i]));
+    }
+    return src;
+}
+
+size_t ColumnEncoder::max_encoded_size(const Column& column) {
+    if (!column.is_constant() && column.is_nullable()) {
+        const auto& nullable_column = down_cast<const NullableColumn&>(column);
+        return 1 + max_encoded_size(*nullable_column.null_column()) + max_encoded_size(*nullable_column.data_column());
+    }
+    return 1 + column.serialize_size();
+}
+
+uint8_t* ColumnEncoder::encode(Column* column, uint8_t* dst) {
+    if (column->is_constant()) {
+        return encode_raw(column, dst);
+    }
+    if (column->is_nullable()) {
+        auto* nullable_column = down_cast<NullableColumn*>(column);
+        *dst++ = NULLABLE;
+        dst = encode(nullable_column->mutable_null_column(), dst);
+        return encode(nullable_column->mutable_data_column(), dst);
+    }
+    uint8_t* end = nullptr;
+    if (visit_integer_column(column, [&](auto* c) { end = encode_integers(c, dst); })) {
+        return end;
+    }
+    if (auto* binary_column = dynamic_cast<BinaryColumn*>(column)) {
+        return encode_strings(binary_column, dst);
+    }
+    return encode_raw(column, dst);
+}
+
+const uint8_t* ColumnEncoder::decode(const uint8_t* src, Column* column) {
+    const auto encoding = static_cast<Encoding>(*src++);
+    switch (encoding) {
+    case RAW:
+        return column->deserialize_column(src);
+    case NULLABLE: {
+        auto* nullable_column = down_cast<NullableColumn*>(column);
+        src = decode(src, nullable_column->mutable_null_column());
+        src = decode(src, nullable_column->mutable_data_column());
+        nullable_column->update_has_null();
+        return src;
+    }
+    case FOR:
+    case RLE: {
+        const uint8_t* end = src;
+        bool is_integer_column =
+                visit_integer_column(column, [&](auto* c) { end = decode_integers(encoding, src, c); });
+        DCHECK(is_integer_column) << "the encoding " << static_cast<int>(encoding) << " of a non-integer column";
+        return end;
+    }
+    case DICT:
+        return decode_strings(src, down_cast<BinaryColumn*>(column));
+    }
+    DCHECK(false) << "unknown column encoding " << static_cast<int>(encoding);
+    return src;
+}
+
+} // namespace starrocks::vectorized
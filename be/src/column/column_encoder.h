@@ -0,0 +1,35 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace starrocks::vectorized {
+
+class Column;
+
+// ColumnEncoder serializes a column in a lightweight encoding chosen by its data, for the exchange of the chunks
+// between the BEs, see Chunk::serialize_encoded, where it takes less bytes and CPU than LZ4 of the raw column bytes
+// for the typical payloads. Each column is written as a one byte encoding followed by:
+//   RAW:      the bytes of Column::serialize_column, for the types and data of no better encoding
+//   NULLABLE: the encoded null column and the encoded data column
+//   FOR:      the 8, 16, 32 and 64 bits integers in a small range, as the min value and the bit packed offsets from it,
+//             of 0 bits if all the values are the same
+//   RLE:      the integers of few runs, e.g. the null columns, as the values and the lengths of the runs
+//   DICT:     the strings of a low cardinality, as the distinct strings and the bit packed codes of the rows
+// The encoding of the least bytes is taken, RAW unless another is smaller.
+class ColumnEncoder {
+public:
+    // The max bytes of the encoded |column|.
+    static size_t max_encoded_size(const Column& column);
+
+    // Encode |column| into |dst| and return the end of the encoded bytes.
+    static uint8_t* encode(Column* column, uint8_t* dst);
+
+    // Decode the column encoded in |src| by encode into the empty |column| of the same type and return the end of the
+    // encoded bytes.
+    static const uint8_t* decode(const uint8_t* src, Column* column);
+};
+
+} // namespace starrocks::vectorized
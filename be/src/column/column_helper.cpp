@@ -5,6 +5,7 @@
 #include <runtime/types.h>
 
 #include "column/array_column.h"
+#include "column/column_pool.h"
 #include "common/config.h"
 #include "gutil/casts.h"
 #include "runtime/types.h"
@@ -286,6 +287,72 @@ ColumnPtr ColumnHelper::create_column(const TypeDescriptor& type_desc, bool null
     return p;
 }
 
+template <typename T>
+static inline std::shared_ptr<T> get_decimal_column_ptr(const TypeDescriptor& type_desc) {
+    auto column = get_column_ptr<T>();
+    column->set_precision(type_desc.precision);
+    column->set_scale(type_desc.scale);
+    return column;
+}
+
+ColumnPtr ColumnHelper::create_column_pooled(const TypeDescriptor& type_desc, bool nullable) {
+    ColumnPtr p;
+    switch (type_desc.type) {
+    case TYPE_BOOLEAN:
+        p = get_column_ptr<BooleanColumn>();
+        break;
+    case TYPE_TINYINT:
+        p = get_column_ptr<Int8Column>();
+        break;
+    case TYPE_SMALLINT:
+        p = get_column_ptr<Int16Column>();
+        break;
+    case TYPE_INT:
+        p = get_column_ptr<Int32Column>();
+        break;
+    case TYPE_BIGINT:
+        p = get_column_ptr<Int64Column>();
+        break;
+    case TYPE_LARGEINT:
+        p = get_column_ptr<Int128Column>();
+        break;
+    case TYPE_FLOAT:
+        p = get_column_ptr<FloatColumn>();
+        break;
+    case TYPE_DOUBLE:
+        p = get_column_ptr<DoubleColumn>();
+        break;
+    case TYPE_DECIMALV2:
+        p = get_column_ptr<DecimalColumn>();
+        break;
+    case TYPE_DATE:
+        p = get_column_ptr<DateColumn>();
+        break;
+    case TYPE_DATETIME:
+        p = get_column_ptr<TimestampColumn>();
+        break;
+    case TYPE_VARCHAR:
+    case TYPE_CHAR:
+        p = get_column_ptr<BinaryColumn>();
+        break;
+    case TYPE_DECIMAL32:
+        p = get_decimal_column_ptr<Decimal32Column>(type_desc);
+        break;
+    case TYPE_DECIMAL64:
+        p = get_decimal_column_ptr<Decimal64Column>(type_desc);
+        break;
+    case TYPE_DECIMAL128:
+        p = get_decimal_column_ptr<Decimal128Column>(type_desc);
+        break;
+    default:
+        return create_column(type_desc, nullable);
+    }
+    if (nullable) {
+        return NullableColumn::create(std::move(p), get_column_ptr<NullColumn>());
+    }
+    return p;
+}
+
 bool ColumnHelper::is_all_const(const Columns& columns) {
     return std::all_of(std::begin(columns), std::end(columns), [](const ColumnPtr& col) { return col->is_constant(); });
 }
@@ -96,6 +96,11 @@ public:
     // If is_const is true, you must pass the size arg
     static ColumnPtr create_column(const TypeDescriptor& type_desc, bool nullable, bool is_const, size_t size);
 
+    // Like create_column(), but the columns of the fixed length and binary types, and their null columns, are taken
+    // from the ColumnPool of the current thread, and given back to it with their capacity once released, so that the
+    // operators creating a new output column for every chunk don't allocate and fault in its memory again.
+    static ColumnPtr create_column_pooled(const TypeDescriptor& type_desc, bool nullable);
+
     /**
      * Cast columnPtr to special type ColumnPtr
      * Plz sure actual column type by yourself
@@ -174,6 +179,54 @@ public:
         auto start_offset = from;
         auto result_offset = from;
 
+#ifdef __AVX512F__
+        // Compress the selected values of a register in one instruction instead of moving them one by one. The whole
+        // register is stored, whose values past the selected ones are either overwritten by the next registers or
+        // past the result, and never past the values already loaded.
+        if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {
+            constexpr size_t kBatchNums = 64 / sizeof(T);
+            const uint8_t* f_data = filter.data();
+            while (start_offset + kBatchNums < to) {
+                __mmask16 mask;
+                if constexpr (kBatchNums == 16) {
+                    __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f_data + start_offset));
+                    mask = _mm512_test_epi32_mask(_mm512_cvtepu8_epi32(f), _mm512_set1_epi32(0xff));
+                } else {
+                    __m128i f = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(f_data + start_offset));
+                    mask = _mm512_test_epi64_mask(_mm512_cvtepu8_epi64(f), _mm512_set1_epi64(0xff));
+                }
+                if (mask != 0) {
+                    __m512i values = _mm512_loadu_si512(data + start_offset);
+                    if constexpr (kBatchNums == 16) {
+                        values = _mm512_maskz_compress_epi32(mask, values);
+                    } else {
+                        values = _mm512_maskz_compress_epi64(static_cast<__mmask8>(mask), values);
+                    }
+                    _mm512_storeu_si512(data + result_offset, values);
+                    result_offset += __builtin_popcount(mask);
+                }
+                start_offset += kBatchNums;
+            }
+        }
+#endif
+#ifdef __AVX512VBMI2__
+        // The null maps and the other byte columns, compressed 64 bytes at a time.
+        if constexpr (sizeof(T) == 1) {
+            constexpr size_t kBatchNums = 64;
+            const uint8_t* f_data = filter.data();
+            while (start_offset + kBatchNums < to) {
+                __m512i f = _mm512_loadu_si512(f_data + start_offset);
+                __mmask64 mask = _mm512_test_epi8_mask(f, f);
+                if (mask != 0) {
+                    __m512i values = _mm512_loadu_si512(data + start_offset);
+                    _mm512_storeu_si512(data + result_offset, _mm512_maskz_compress_epi8(mask, values));
+                    result_offset += __builtin_popcountll(mask);
+                }
+                start_offset += kBatchNums;
+            }
+        }
+#endif
+
 #ifdef __AVX2__
         const uint8_t* f_data = filter.data();
         size_t data_type_size = sizeof(T);
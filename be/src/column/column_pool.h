@@ -432,6 +432,28 @@ inline void clear_columns() {
 template <typename T>
 struct HasColumnPool : public std::bool_constant<InList<ColumnPool<T>, ColumnPoolList>::value> {};
 
+template <typename T>
+struct ColumnPoolDeleter {
+    void operator()(T* ptr) const { return_column<T>(ptr); }
+};
+
+// Get a column from the pool of the current thread, which is given back to the pool, with its capacity kept, once
+// the last reference to it is dropped, e.g. along with the chunk holding it. A new column is created instead if T
+// has no pool, or if the pool is empty and !AllocateOnEmpty.
+template <typename T, bool AllocateOnEmpty = true>
+inline std::shared_ptr<T> get_column_ptr() {
+    if constexpr (std::negation_v<HasColumnPool<T>>) {
+        return std::make_shared<T>();
+    } else {
+        T* ptr = get_column<T, AllocateOnEmpty>();
+        if (LIKELY(ptr != nullptr)) {
+            return std::shared_ptr<T>(ptr, ColumnPoolDeleter<T>());
+        } else {
+            return std::make_shared<T>();
+        }
+    }
+}
+
 namespace detail {
 struct ClearColumnPool {
     template <typename Pool>
@@ -153,25 +153,37 @@ const uint8_t* FixedLengthColumnBase<T>::deserialize_column(const uint8_t* src)
 
 template <typename T>
 void FixedLengthColumnBase<T>::fvn_hash(uint32_t* hash, uint16_t from, uint16_t to) const {
+    const ValueType* data = _data.data();
     for (uint16_t i = from; i < to; ++i) {
-        hash[i] = HashUtil::fnv_hash(&_data[i], sizeof(ValueType), hash[i]);
+        hash[i] = HashUtil::fnv_hash(&data[i], sizeof(ValueType), hash[i]);
     }
 }
 
 // Must same with RawValue::zlib_crc32
 template <typename T>
 void FixedLengthColumnBase<T>::crc32_hash(uint32_t* hash, uint16_t from, uint16_t to) const {
+    const ValueType* data = _data.data();
     for (uint16_t i = from; i < to; ++i) {
-        if constexpr (IsDate<T> || IsTimestamp<T>) {
-            std::string str = _data[i].to_string();
-            hash[i] = HashUtil::zlib_crc_hash(str.data(), str.size(), hash[i]);
+        // The dates and datetimes are hashed by their strings, formatted on the stack rather than allocated.
+        if constexpr (IsDate<T>) {
+            int year, month, day;
+            data[i].to_date(&year, &month, &day);
+            char s[10];
+            date::to_string(year, month, day, s);
+            hash[i] = HashUtil::zlib_crc_hash(s, sizeof(s), hash[i]);
+        } else if constexpr (IsTimestamp<T>) {
+            char s[TimestampValue::max_string_length()];
+            int len = data[i].to_string(s, sizeof(s));
+            hash[i] = HashUtil::zlib_crc_hash(s, len, hash[i]);
         } else if constexpr (IsDecimal<T>) {
-            int64_t int_val = _data[i].int_value();
-            int32_t frac_val = _data[i].frac_value();
-            uint32_t seed = HashUtil::zlib_crc_hash(&int_val, sizeof(int_val), hash[i]);
-            hash[i] = HashUtil::zlib_crc_hash(&frac_val, sizeof(frac_val), seed);
+            int64_t int_val = data[i].int_value();
+            int32_t frac_val = data[i].frac_value();
+            uint32_t seed = HashUtil::zlib_crc_hash_fixed<sizeof(int_val)>(&int_val, hash[i]);
+            hash[i] = HashUtil::zlib_crc_hash_fixed<sizeof(frac_val)>(&frac_val, seed);
+        } else if constexpr (sizeof(ValueType) <= 16) {
+            hash[i] = HashUtil::zlib_crc_hash_fixed<sizeof(ValueType)>(&data[i], hash[i]);
         } else {
-            hash[i] = HashUtil::zlib_crc_hash(&_data[i], sizeof(ValueType), hash[i]);
+            hash[i] = HashUtil::zlib_crc_hash(&data[i], sizeof(ValueType), hash[i]);
         }
     }
 }
@@ -154,6 +154,11 @@ void NullableColumn::append_value_multiple_times(const void* value, size_t count
 
 size_t NullableColumn::filter_range(const Column::Filter& filter, size_t from, size_t to) {
     auto s1 = _data_column->filter_range(filter, from, to);
+    if (!_has_null) {
+        // The null map is all zeros, and so is any selection of it.
+        _null_column->resize(s1);
+        return s1;
+    }
     auto s2 = _null_column->filter_range(filter, from, to);
     update_has_null();
     DCHECK_EQ(s1, s2);
@@ -259,7 +264,7 @@ void NullableColumn::fvn_hash(uint32_t* hash, uint16_t from, uint16_t to) const
         return;
     }
 
-    auto null_data = _null_column->get_data();
+    const auto& null_data = _null_column->get_data();
     uint32_t value = 0x9e3779b9;
     while (from < to) {
         uint16_t new_from = from + 1;
@@ -284,7 +289,7 @@ void NullableColumn::crc32_hash(uint32_t* hash, uint16_t from, uint16_t to) cons
         return;
     }
 
-    auto null_data = _null_column->get_data();
+    const auto& null_data = _null_column->get_data();
     // NULL is treat as 0 when crc32 hash for data loading
     static const int INT_VALUE = 0;
     while (from < to) {
@@ -294,7 +299,7 @@ void NullableColumn::crc32_hash(uint32_t* hash, uint16_t from, uint16_t to) cons
         }
         if (null_data[from]) {
             for (uint16_t i = from; i < new_from; ++i) {
-                hash[i] = HashUtil::zlib_crc_hash(&INT_VALUE, 4, hash[i]);
+                hash[i] = HashUtil::zlib_crc_hash_fixed<sizeof(INT_VALUE)>(&INT_VALUE, hash[i]);
             }
         } else {
             _data_column->crc32_hash(hash, from, new_from);
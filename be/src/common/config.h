@@ -619,6 +619,411 @@ CONF_Int64(pipeline_yield_max_chunks_moved, "100");
 // yield PipelineDriver when maximum time in nano-seconds has spent
 // in current execution round.
 CONF_Int64(pipeline_yield_max_time_spent, "100000000");
+// Use per-thread local driver queues with work stealing instead of a single
+// global driver queue, which reduces the lock contention among the dispatcher threads.
+CONF_Bool(pipeline_enable_work_stealing_driver_queue, "false");
+// Park the PipelineDriver blocked on exchange source, exchange sink or async scan io,
+// and wake it up when the chunk arrives or the rpc/io completes, instead of polling it.
+CONF_Bool(pipeline_enable_driver_wakeup, "true");
+// interval(milli-seconds) for PipelineDriverPoller to check the parked drivers of
+// cancelled fragments.
+CONF_Int64(pipeline_poller_parked_check_interval_ms, "10");
+// Split a tablet into the morsels of about this number of rows by segments and rowid ranges,
+// so that the scan of a skewed tablet is balanced across the drivers. 0 disables the split.
+CONF_Int64(pipeline_olap_morsel_split_rows, "1048576");
+// Start every scan pipeline with pipeline_adaptive_dop_initial_drivers drivers, and dispatch the
+// reserved drivers one by one when the running drivers are CPU-bound and there are enough morsels left.
+CONF_Bool(pipeline_enable_adaptive_dop, "false");
+CONF_Int32(pipeline_adaptive_dop_initial_drivers, "1");
+// A reserved driver is dispatched only if every dispatched driver still has more than
+// this number of morsels to scan.
+CONF_Int32(pipeline_adaptive_dop_min_morsels_per_driver, "2");
+// Schedule the pipeline drivers by the CPU weights of the resource groups of their queries.
+CONF_Bool(pipeline_enable_resource_group, "false");
+// The resource groups separated by ';', each of which is "name:cpu_weight:concurrency_limit",
+// where concurrency_limit is the max number of running queries of the group in one BE and 0 means
+// unlimited. The queries of no or unknown resource group belong to the group "default", whose
+// cpu_weight is 1 and concurrency_limit is 0 unless it's redefined here.
+CONF_String(pipeline_resource_groups, "");
+// Radix partition the one-key hash table of hash join whose bucket heads, chains and keys exceed
+// join_radix_partition_min_bytes, so that each partition is at most join_radix_partition_bytes
+// to fit in the L2 cache, and the probe rows are looked up partition by partition. 0 disables it.
+CONF_Int64(join_radix_partition_min_bytes, "8388608");
+CONF_Int64(join_radix_partition_bytes, "262144");
+// With the query option enable_spilling, the vectorized hash join spills its rows to the tmp dirs
+// once its memory tracker has less than (100 - join_spill_mem_limit_percent)% spare. The rows are
+// partitioned into 2^join_spill_partition_bits partitions, and a partition too large is partitioned
+// again until join_spill_max_levels levels.
+CONF_mInt32(join_spill_mem_limit_percent, "80");
+CONF_Int32(join_spill_partition_bits, "4");
+CONF_Int32(join_spill_max_levels, "3");
+// The build keys of the bucket heads are prefetched while probing a hash join hash table with at
+// least join_probe_prefetch_min_rows build rows, smaller ones are likely to be in the cache anyway.
+CONF_mInt64(join_probe_prefetch_min_rows, "65536");
+// The one-key hash table of hash join on INT or BIGINT keys maps the build keys to the buckets
+// directly, i.e. without hashing, if the range of the build keys is at most
+// join_direct_mapping_max_range_ratio times the build rows. 0 disables it.
+CONF_mInt64(join_direct_mapping_max_range_ratio, "4");
+// The merge node of a global runtime filter drops the bloom filters and only merges the min/max
+// values once the partitioned runtime filters it receives exceed runtime_filter_merge_max_bytes.
+CONF_mInt64(runtime_filter_merge_max_bytes, "67108864");
+// With the query option enable_spilling, the vectorized blocking aggregation spills its groups to the
+// tmp dirs once its memory tracker has less than (100 - agg_spill_mem_limit_percent)% spare. The groups
+// are partitioned into 2^agg_spill_partition_bits partitions, and a partition too large is partitioned
+// again until agg_spill_max_levels levels.
+CONF_mInt32(agg_spill_mem_limit_percent, "80");
+CONF_Int32(agg_spill_partition_bits, "4");
+CONF_Int32(agg_spill_max_levels, "3");
+// In the ADAPTIVE streaming pre-aggregation mode, the first streaming_agg_adaptive_sample_rows rows of every
+// streaming_agg_adaptive_window_rows input rows are aggregated, and the rest rows of the window are
+// streamed if the sampled rows are at most streaming_agg_adaptive_min_reduction times their distinct keys.
+CONF_mInt64(streaming_agg_adaptive_window_rows, "1048576");
+CONF_mInt64(streaming_agg_adaptive_sample_rows, "65536");
+CONF_mDouble(streaming_agg_adaptive_min_reduction, "2.0");
+// The submaps of the two-level hash map of a non-pipeline blocking aggregation with at least
+// agg_parallel_output_min_groups groups are converted to the result chunks by up to
+// agg_parallel_output_max_tasks tasks in parallel. 1 disables it.
+CONF_mInt64(agg_parallel_output_min_groups, "1000000");
+CONF_mInt32(agg_parallel_output_max_tasks, "4");
+// With the query option enable_spilling, the vectorized full sort writes its sorted rows as a run to the
+// tmp dirs once its memory tracker has less than (100 - sort_spill_mem_limit_percent)% spare, and merges
+// all the runs at last.
+CONF_mInt32(sort_spill_mem_limit_percent, "80");
+// The full sort of at least full_sort_normalized_key_min_rows rows is sorted by radix sort on the normalized
+// key of its first order-by column if possible. A negative value disables it.
+CONF_mInt64(full_sort_normalized_key_min_rows, "1024");
+// Whether the top-n ordered by a column of the olap scan below firstly publishes the boundary of its rows to
+// the scan, whose segment iterators skip the data pages out of the boundary by the zone maps.
+CONF_mBool(enable_topn_runtime_predicate, "true");
+// The segment iterators of queries hint the OS to read up to segment_read_ahead_bytes of the data pages of
+// the rows to be read ahead of time, with the adjacent pages coalesced into one range. 0 disables it.
+CONF_mInt64(segment_read_ahead_bytes, "8388608");
+// The conjunctive predicates evaluated on the rows left by each other, i.e. the branchless predicates of the
+// segment iterators and the conjuncts of the olap scans, are measured on adaptive_predicate_order_sample_chunks
+// chunks, and evaluated in the order of their cost per eliminated row after that. They are measured again after
+// every adaptive_predicate_order_resample_chunks chunks. 0 sample chunks disables the reordering.
+CONF_mInt32(adaptive_predicate_order_sample_chunks, "8");
+CONF_mInt32(adaptive_predicate_order_resample_chunks, "512");
+// The char/varchar columns with bloom filter index also have an n-gram bloom filter of every data page in the new
+// segments, which has the n-grams of ngram_bloom_filter_gram_size bytes of the values, so that the pages could be
+// filtered out by `LIKE '%substring%'`. 0 disables it.
+CONF_mInt32(ngram_bloom_filter_gram_size, "0");
+// The parsed footers of the recently opened segments, which have the zone maps of the segments and the index metas
+// of their columns, are kept in an LRU cache of up to segment_footer_cache_limit bytes, e.g. "512M" or "1%" of
+// the physical memory. 0 disables it.
+CONF_String(segment_footer_cache_limit, "512M");
+// The integer, date and bool data pages of the new segments are also encoded by the other encodings of
+// BIT_SHUFFLE, FOR_ENCODING and RLE supported by their types, and written in the smallest one if it is at least
+// 10% smaller. The segments with such pages could not be read by the BEs of a version without it.
+CONF_Bool(enable_adaptive_page_encoding, "false");
+// The scanners of the olap scan nodes of all the queries share doris_scanner_thread_pool_thread_num slots of the
+// scanner thread pool fairly, and up to scan_scheduler_max_scanners_per_disk of the slots are granted to the
+// scanners reading the tablets of one data dir.
+CONF_mInt32(scan_scheduler_max_scanners_per_disk, "16");
+// The delete predicates applied to a segment of a duplicate, aggregate or unique keys tablet by at least
+// delete_bitmap_min_predicates DELETE statements are evaluated by a background thread into a bitmap of the deleted
+// rows of the segment, by which the later queries filter the rows instead. The bitmaps are kept in an LRU cache of
+// up to delete_bitmap_cache_limit bytes, e.g. "256M" or "1%" of the physical memory. 0 disables it.
+CONF_mInt32(delete_bitmap_min_predicates, "2");
+CONF_String(delete_bitmap_cache_limit, "256M");
+// The decoded values of the recently read data pages are kept in an LRU cache of up to decoded_page_cache_limit
+// bytes, e.g. "1G" or "5%" of the physical memory, so that the hot pages are read again without being decompressed
+// and decoded. The pages of the columns of the in-memory tables are evicted after the others. 0 disables it.
+CONF_String(decoded_page_cache_limit, "0");
+// The conjunctions of the delete predicates of a segment whose columns all have bitmap index are evaluated by the
+// bitmap indexes before reading the segment, if they are estimated to delete at least bitmap_index_delete_min_ratio
+// per mille of its rows. Valid range: [0-1000].
+CONF_mInt16(bitmap_index_delete_min_ratio, "10");
+// The queries of the primary keys tablets whose key ranges are the equalities of all the key columns, e.g. the
+// IN lists of the keys, read the rows by the primary index instead of scanning the tablet, if they're at the latest
+// applied version and looking up at most primary_key_point_lookup_max_keys keys. 0 disables it.
+CONF_mInt32(primary_key_point_lookup_max_keys, "1024");
+// Split a tablet that the non-pipeline OlapScanNode would read by a single scanner into the scanners of about this
+// number of rows by segments and rowid ranges, which run concurrently, so that the scan of a few large tablets uses
+// more than one core per tablet. 0 disables the split.
+CONF_mInt64(olap_scan_tablet_split_rows, "1048576");
+// Evaluate the predicates of the segments read by late materialization by stages, in the order of the selectivities
+// of the columns estimated by the bitmap indexes and zone maps: only the column of the most selective predicates is
+// read along with the rowids, and each of the others is fetched by the rowids of the rows left by the previous ones.
+CONF_mBool(enable_segment_predicate_stages, "true");
+// The compactions of the primary keys tablets with more than vertical_compaction_max_columns_per_group value columns
+// merge the key columns first, and then read and write the value columns in the order of the merged rows by the
+// groups of up to this number of columns, so that their memory doesn't grow with the width of the tables.
+// 0 merges all the columns at once.
+CONF_mInt32(vertical_compaction_max_columns_per_group, "5");
+// The MB per second rewritten by the base and cumulative compactions of every disk, beyond which only the tablets
+// whose versions are close to tablet_max_versions are compacted on the disk. 0 means unlimited.
+CONF_mInt64(compaction_io_budget_mb_per_sec_per_disk, "0");
+// The threads encoding and compressing the columns of the memtables flushed concurrently, shared by all the tablets,
+// so that the flushes of a tablet, which are serialized, use more than one core. 0 means the flush threads encode
+// the memtables themselves.
+CONF_Int32(memtable_flush_encode_thread_num, "4");
+// The memtables of more rows than this are flushed into the segments of this many rows, which are encoded and written
+// concurrently by the encode threads. 0 means a memtable is always flushed into one segment.
+CONF_mInt64(memtable_flush_segment_split_rows, "0");
+// The memtables are flushed at write_buffer_size, or at the memory limit of the loads shared by the memtables of all
+// the tablets loaded concurrently once it is less, but not below this size.
+CONF_mInt64(min_write_buffer_size, "16777216");
+// Keep the primary indexes of the primary keys tablets loaded in the tablet directories, as a file of the sorted keys
+// read by pages on demand and an in-memory map of the keys changed since it was written, logged at every apply, so
+// that an index is neither rebuilt from all the segments of the tablet at every load nor held wholly in memory.
+CONF_mBool(enable_persistent_index, "false");
+// The memory of the changed keys of a persistent index beyond which they are merged into the file of the sorted keys.
+CONF_mInt64(persistent_index_l0_max_mem_usage, "67108864");
+// The threads upserting the keys of the large rowsets applied into the primary indexes by the shards of the indexes
+// concurrently, shared by all the tablets. 0 means the apply threads upsert the keys themselves.
+CONF_Int32(update_apply_index_thread_num, "8");
+// The memory bound of the cache of the latest delete vectors of the segments of the primary keys tablets, beyond which
+// the least recently used ones are evicted, and read from the meta again once they are used.
+CONF_mInt64(update_del_vector_cache_capacity, "1073741824");
+// The bytes of the rows buffered by a channel of OlapTableSink to a backend, beyond which they are sent as a chunk even
+// if the chunk has fewer than vector_chunk_size rows, so that the wide rows do not make a request too large.
+CONF_mInt64(tablet_sink_max_chunk_bytes, "67108864");
+// The threads parsing the body of a CSV stream load concurrently, each of which parses the splits of about
+// stream_load_split_size bytes cut at the record delimiters of the body. 1 means the body is parsed by one thread.
+CONF_mInt32(stream_load_parse_threads, "4");
+CONF_mInt64(stream_load_split_size, "8388608");
+
+// The max number of messages a kafka consumer of a routine load task takes at a time, only the first of which is waited
+// for, and all of which are appended to the load pipe at once.
+CONF_mInt32(routine_load_kafka_consume_batch_rows, "64");
+
+// Whether a load into the tables of multiple replicas is written by a single replica: only the first replica of a
+// tablet is sent the data, and sends the segment files it writes to the others, which commit them as they are.
+CONF_mBool(enable_single_replica_load, "false");
+// The timeout of a secondary replica of a single replica load waiting for the segments of the primary replica, and
+// the size of the parts the segments are sent in.
+CONF_mInt32(single_replica_load_wait_timeout_s, "600");
+CONF_mInt64(single_replica_load_rpc_bytes, "4194304");
+
+// The max number of threads a schema change converts the rowsets of a tablet by, each of which converts one rowset at
+// a time, and sorts it with up to memory_limitation_per_thread_for_schema_change of memory if the change sorts.
+CONF_mInt32(schema_change_convert_threads, "4");
+
+// The number of threads the tablet metas and rowset metas of a data dir are parsed and loaded by at BE startup, in
+// addition to the thread of each data dir traversing its meta.
+CONF_Int32(load_tablet_meta_threads, "4");
+
+// The max number of files a clone downloads from the source backend at a time, and whether it verifies the md5sum of
+// every downloaded file against the one of the source file, which requires the source backend to support it.
+CONF_mInt32(clone_download_threads, "4");
+CONF_mBool(clone_verify_checksum, "false");
+
+// The number of 1MB buffers a load decompresses a compressed file into ahead of its parsing, on a separate thread.
+// 0 decompresses it on the scanner thread between the parses.
+CONF_mInt32(compressed_file_read_ahead_buffers, "4");
+
+// The column chunks a row group of a parquet file reads are read by up to parquet_coalesce_read_threads threads in
+// parallel before their decoding, in ranges merged from the ones at most parquet_coalesce_read_max_gap bytes apart,
+// of at most parquet_coalesce_read_max_size bytes. 0 threads reads every column chunk on its decoding.
+CONF_mInt32(parquet_coalesce_read_threads, "4");
+CONF_mInt64(parquet_coalesce_read_max_gap, "1048576");
+CONF_mInt64(parquet_coalesce_read_max_size, "16777216");
+
+// Whether a parquet file skips the pages of the rows its min/max conjuncts filter out by its page indexes.
+CONF_mBool(parquet_page_index_enable, "true");
+
+// Whether the row groups of a parquet file decode the columns without conjuncts after evaluating the conjuncts on
+// the other columns, for the rows left only.
+CONF_mBool(parquet_lazy_decode_enable, "true");
+
+// The parsed footers of the recently opened parquet files and the tails of the orc files of the hdfs scans are kept
+// in an LRU cache of up to hdfs_file_meta_cache_limit bytes, e.g. "256M" or "1%" of the physical memory, keyed by
+// the path, length and modification time of the files. 0 disables it.
+CONF_String(hdfs_file_meta_cache_limit, "256M");
+
+// The blocks of block_cache_block_size bytes of the remote files read by the hdfs scans are cached in
+// block_cache_disk_path on the local disk, of up to block_cache_disk_capacity bytes, and written by
+// block_cache_write_threads background threads. The directory is cleared at start. An empty path or 0 capacity
+// disables it.
+CONF_String(block_cache_disk_path, "");
+CONF_Int64(block_cache_disk_capacity, "0");
+CONF_Int64(block_cache_block_size, "1048576");
+CONF_Int32(block_cache_write_threads, "2");
+
+// Whether the orc scans of the hdfs files read the columns without conjuncts after evaluating the conjuncts on the
+// other columns, skipping the long runs of the rows filtered out.
+CONF_mBool(orc_lazy_load_enable, "true");
+
+// The scan ranges of the parquet and orc files of over twice hdfs_scan_split_size bytes are split into the pieces of
+// about hdfs_scan_split_size bytes on the BE, each read by a scanner of its own, so that the large files are read in
+// parallel. 0 disables it.
+CONF_mInt64(hdfs_scan_split_size, "268435456");
+
+// The handles of the recently opened hdfs files of known modification times are kept open in an LRU cache of up to
+// hdfs_file_handle_cache_capacity handles, shared by the scans of the files. 0 disables it.
+CONF_Int32(hdfs_file_handle_cache_capacity, "1024");
+
+// The reads of the hdfs blocks not done in hdfs_hedged_read_threshold_ms are hedged by the reads of other replicas,
+// issued by hdfs_hedged_read_threads threads of each hdfs filesystem. 0 threads disables it.
+CONF_Int32(hdfs_hedged_read_threads, "0");
+CONF_Int32(hdfs_hedged_read_threshold_ms, "500");
+
+// The query results exported into the parquet files are written in the row groups of about
+// export_parquet_row_group_bytes bytes, unless the export sets it, of which the column chunks are encoded by up to
+// export_parquet_encode_threads threads in parallel.
+CONF_Int64(export_parquet_row_group_bytes, "134217728");
+CONF_Int32(export_parquet_encode_threads, "8");
+
+// Whether each exchange channel chooses to compress the chunks by LZ4, ZSTD or not at all, by the sampled compression
+// ratios and time and the network time of its rpcs, instead of by LZ4 only, if compress_rowbatches is true and the
+// query doesn't set the transmission compression type. The chunks sent to the same host are not compressed then.
+CONF_mBool(exchange_adaptive_compression, "true");
+
+// Whether the chunks sent to the exchange receivers on the same backend are passed in process, instead of being
+// serialized and sent by the rpcs.
+CONF_mBool(exchange_local_passthrough, "true");
+
+// Whether the exchange senders send the chunks only if the receivers grant them the credit, instead of the receivers
+// withholding the responses of the rpcs once their buffers are full.
+CONF_mBool(exchange_credit_flow_control, "true");
+
+// The chunks batched by an exchange channel are sent in one request, once they are more than
+// max_transmit_batched_bytes, or the first of them has waited this many milliseconds, checked as the chunks come.
+// 0 to batch them by the bytes only.
+CONF_mInt32(max_transmit_batched_wait_ms, "20");
+
+// Whether the requests of the exchange senders of the non-pipeline engine, which the receivers have no credit for, are
+// spilled into the temporary files and sent in order once the receivers take more, instead of blocking the fragment,
+// so that its scans can finish and release their resources. Only with exchange_credit_flow_control.
+CONF_mBool(exchange_spill_to_disk, "false");
+
+// The max number of the subtrees shared by the output exprs of a project node, besides the common sub exprs of FE,
+// which are extracted to be evaluated once per chunk. 0 not to extract any.
+CONF_mInt32(project_max_extracted_common_sub_exprs, "16");
+
+// The years of the dates whose calendar fields, e.g. year, month, day and week of year, are looked up in the table
+// built at startup, instead of being computed from the julian days. It takes 8 bytes per day.
+CONF_Int32(date_cache_min_year, "1900");
+CONF_Int32(date_cache_max_year, "2199");
+
+// Whether all the allocations of the query threads are charged to the memory trackers of their fragment instances by
+// the hooks of tcmalloc, instead of the explicit consumption of the nodes only. The memory of the nodes tracked
+// explicitly as well is counted twice by the instances with it.
+CONF_Bool(enable_mem_hook, "false");
+
+// Whether the pipeline dispatcher threads are pinned to the NUMA nodes round robin, and steal the drivers from the
+// threads of the same node first with pipeline_enable_work_stealing_driver_queue, so that a driver keeps running on
+// the node whose memory its data were allocated from.
+CONF_Bool(pipeline_numa_aware, "false");
+
+// Whether the large hash tables of the joins and aggregations, of at least huge_page_min_bytes, are advised to be
+// backed by the transparent huge pages, which takes fewer TLB misses to probe at random. Only takes effect if the
+// transparent huge pages of the kernel are enabled in the "madvise" or "always" mode.
+CONF_mBool(enable_huge_pages, "false");
+CONF_mInt64(huge_page_min_bytes, "8388608");
+
+// The percent of the mem_limit of a fragment instance which must be spare in the query pool before it starts to
+// execute. The instances without enough memory are queued until the running ones release theirs, or until
+// fragment_admission_timeout_ms passes, after which they execute anyway. 0 to admit all the instances at once.
+CONF_mInt32(fragment_admission_mem_percent, "0");
+CONF_mInt32(fragment_admission_timeout_ms, "10000");
+
+// Whether the scanners of the olap scan nodes and the io tasks of the pipeline scan operators run on a pool of
+// doris_scanner_thread_pool_thread_num workers which steal the tasks from each other and take the tasks of the
+// queries round robin, instead of the priority queues of the scanner and pipeline io thread pools.
+CONF_Bool(enable_work_stealing_scan_thread_pool, "false");
+
+// The threads of the pipeline io thread pool, which read the chunks of the pipeline scan operators. The data pages
+// of a local segment are read ahead by segment_read_ahead_bytes as well, so a thread waits less on the cold reads.
+CONF_Int32(pipeline_io_thread_pool_thread_num, "4");
+
+// Whether the cycles, instructions, LLC misses and branch misses of the pull_chunk and push_chunk of the pipeline
+// operators are counted by the perf_event hardware counters of the dispatcher threads, and reported in the profiles
+// of the operators and of their drivers. Reading the counters costs a syscall per call of the operators.
+CONF_mBool(enable_pipeline_perf_counters, "false");
+
+// Whether the timelines of the queries are traced, i.e. the process() and the blocked states of the pipeline drivers,
+// the calls of the operators, the io tasks of the scan operators and the rpcs of the exchange sinks. They are fetched
+// in the Chrome trace event format by /api/query_trace?query_id=<query_id>. A trace keeps up to
+// query_trace_max_events events, and the traces of the last query_trace_retained_num queries are retained.
+CONF_mBool(enable_query_trace, "false");
+CONF_mInt64(query_trace_max_events, "1000000");
+CONF_mInt32(query_trace_retained_num, "16");
+
+// Whether the cpu stacks are sampled sampling_profiler_frequency times per second of the cpu time all the time, tagged
+// with the queries and the resource groups, into a ring buffer of sampling_profiler_max_samples samples. They are
+// fetched as the folded stacks of the flame graph by /api/sampling_profile?seconds=&query_id=&resource_group=.
+// Off by default, as the signals may interrupt the blocking calls without SA_RESTART of the third party libraries.
+CONF_Bool(enable_sampling_profiler, "false");
+CONF_Int32(sampling_profiler_frequency, "99");
+CONF_Int32(sampling_profiler_max_samples, "32768");
+
+// One of every lock_contention_sample_period contended acquisitions of a thread of the profiled locks, see LockSite,
+// is timed to estimate their wait time. The contentions are still counted if it's not positive.
+CONF_mInt64(lock_contention_sample_period, "16");
+
+// The capacity in bytes of the cache of the partial aggregations of the fragment instances which pre-aggregate an olap
+// scan, see FragmentResultCache, 0 to disable it. The results of more than fragment_result_cache_max_entry_bytes bytes
+// are not cached.
+CONF_Int64(fragment_result_cache_capacity, "0");
+CONF_mInt64(fragment_result_cache_max_entry_bytes, "16777216");
+
+// Whether the page cache, the decoded page cache and the segment footer cache evict by the segmented LRU instead of
+// the plain LRU, so that the pages read once by a large scan don't evict those read again and again.
+CONF_Bool(storage_cache_scan_resistant, "true");
+
+// Whether to migrate the tablets read or loaded in the last storage_tiering_hot_seconds to the SSD data dirs, as long
+// as they are less than storage_tiering_ssd_max_usage full, and those neither read nor loaded in the last
+// storage_tiering_cold_seconds to the HDD data dirs, up to storage_tiering_max_migrations_per_round tablets every
+// storage_tiering_interval_seconds. See StorageTiering.
+CONF_mBool(enable_storage_tiering, "false");
+CONF_mInt32(storage_tiering_interval_seconds, "600");
+CONF_mInt64(storage_tiering_hot_seconds, "86400");
+CONF_mInt64(storage_tiering_cold_seconds, "2592000");
+CONF_mDouble(storage_tiering_ssd_max_usage, "0.8");
+CONF_mInt32(storage_tiering_max_migrations_per_round, "4");
+
+// The threads building the infos of the tablets of a report of all the tablets, one for every 1024 tablets at most.
+CONF_mInt32(report_tablet_threads, "4");
+
+// Whether to compute the checksums of the tablets through the vectorized reader, by up to checksum_threads threads
+// reading the rowid ranges of no more than checksum_split_rows rows of the duplicate keys tablets. It must be the same
+// on all the BEs, as the checksums differ from those computed through the row reader. See EngineChecksumTask.
+CONF_mBool(enable_vectorized_checksum, "false");
+CONF_mInt32(checksum_threads, "4");
+CONF_mInt64(checksum_split_rows, "1048576");
+
+// The threads linking the files of the rowsets of a snapshot.
+CONF_mInt32(snapshot_link_threads, "4");
+
+// In the ADAPTIVE streaming distinct, the windows whose sampled rows are more than
+// streaming_agg_adaptive_min_reduction but at most streaming_distinct_prefilter_max_reduction times their
+// distinct keys output the rows of the keys first seen by a bloom filter of streaming_distinct_prefilter_bytes
+// bytes, and only insert the repeated keys into the hash set.
+CONF_mDouble(streaming_distinct_prefilter_max_reduction, "4.0");
+CONF_mInt64(streaming_distinct_prefilter_bytes, "1048576");
+
+// The size tiers of the cumulative compaction of the tablets of the size tiered policy, see
+// CumulativeCompaction::size_tier. Each byte is rewritten by the cumulative compaction at most
+// size_tiered_compaction_max_write_amplification times before left to the base compaction.
+CONF_mInt64(size_tiered_compaction_min_tier_bytes, "1048576");
+CONF_mInt64(size_tiered_compaction_tier_multiple, "5");
+CONF_mInt32(size_tiered_compaction_max_write_amplification, "5");
+
+// The threads publishing the versions of the tablets of a partition of a transaction, each taking a data dir, whose
+// rowset metas are written in one batch, or a primary key tablet.
+CONF_mInt32(publish_version_threads, "8");
+
+// The slices of the sliced scroll of each es shard, each scrolled by a scanner of its own. 1 to scroll a shard with a
+// single cursor.
+CONF_mInt32(es_scroll_slices_per_shard, "1");
+
+// Whether the exchange sends the chunks with the columns encoded by ColumnEncoder, e.g. dictionary or bit packed,
+// rather than the raw column bytes, before the optional compression. Only turn it on once all the BEs can decode it.
+CONF_mBool(exchange_encode_chunk, "false");
+
+// The senders of a merging exchange are merged in groups of up to this many, each on a thread of its own, and then
+// the groups by a final merge, if there are more senders. 0 to merge all the senders on one thread.
+CONF_mInt32(exchange_merge_senders_per_group, "32");
+
+// The max threads of the pool merging the groups of the senders of the merging exchanges, one thread per group. A
+// merging exchange fails once the pool has no thread left for its groups, as the final merge waits on all of them.
+CONF_Int32(exchange_merge_thread_pool_thread_num, "256");
+
+// The io tasks of a pipeline scan operator in flight at once, each reading a morsel of its own, so that the cold reads
+// of an operator overlap on the io threads. The driver is notified once any of them completes.
+CONF_Int32(pipeline_scan_io_tasks_per_operator, "4");
 } // namespace config
 
 } // namespace starrocks
@@ -0,0 +1,251 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "env/block_cache.h"
+
+#include "common/logging.h"
+#include "gutil/strings/substitute.h"
+#include "util/coding.h"
+#include "util/file_utils.h"
+#include "util/metrics.h"
+#include "util/raw_container.h"
+#include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
+
+namespace starrocks {
+
+UIntGauge g_block_cache_disk_usage(MetricUnit::BYTES);        // NOLINT
+IntCounter g_block_cache_hit_count(MetricUnit::OPERATIONS);  // NOLINT
+IntCounter g_block_cache_miss_count(MetricUnit::OPERATIONS); // NOLINT
+
+[[maybe_unused]] static void update_block_cache_disk_usage() {
+    g_block_cache_disk_usage.set_value(BlockCache::instance()->disk_usage());
+}
+
+BlockCache* BlockCache::_s_instance = nullptr;
+
+Status BlockCache::create_global_cache(const std::string& dir, size_t capacity, size_t block_size, int num_threads) {
+    if (_s_instance != nullptr || dir.empty() || capacity == 0) {
+        return Status::OK();
+    }
+    if (block_size == 0) {
+        return Status::InvalidArgument("block size of block cache must be positive");
+    }
+    auto cache = std::make_unique<BlockCache>(dir, capacity, block_size);
+    RETURN_IF_ERROR(cache->init(num_threads));
+    _s_instance = cache.release();
+#ifndef BE_TEST
+    MetricRegistry* reg = StarRocksMetrics::instance()->metrics();
+    reg->register_hook("block_cache_disk_usage_hook", update_block_cache_disk_usage);
+    reg->register_metric("block_cache_disk_bytes", &g_block_cache_disk_usage);
+    reg->register_metric("block_cache_hit_count", &g_block_cache_hit_count);
+    reg->register_metric("block_cache_miss_count", &g_block_cache_miss_count);
+#endif
+    return Status::OK();
+}
+
+void BlockCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+BlockCache::BlockCache(std::string dir, size_t capacity, size_t block_size)
+        : _dir(std::move(dir)), _block_size(block_size), _cache(new_lru_cache(capacity)) {}
+
+BlockCache::~BlockCache() {
+    if (_write_pool != nullptr) {
+        _write_pool->shutdown();
+    }
+    // the blocks are removed by the deleters
+    _cache.reset();
+    FileUtils::remove_all(_dir);
+}
+
+Status BlockCache::init(int num_threads) {
+    // the blocks of the last run are not known to the cache
+    RETURN_IF_ERROR(FileUtils::remove_all(_dir));
+    RETURN_IF_ERROR(FileUtils::create_dir(_dir));
+    return ThreadPoolBuilder("block_cache_writer")
+            .set_min_threads(0)
+            .set_max_threads(std::max(num_threads, 1))
+            .set_max_queue_size(kMaxPendingBlocks)
+            .build(&_write_pool);
+}
+
+std::string BlockCache::_encode_key(const std::string& path, int64_t modification_time, int64_t index) {
+    std::string key = path;
+    put_fixed64_le(&key, modification_time);
+    put_fixed64_le(&key, index);
+    return key;
+}
+
+bool BlockCache::read(const std::string& path, int64_t modification_time, int64_t index, size_t offset,
+                      const Slice& buf) {
+    std::string key = _encode_key(path, modification_time, index);
+    auto* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        g_block_cache_miss_count.increment(1);
+        return false;
+    }
+    // the block file is not removed till the handle is released
+    const auto* block = reinterpret_cast<const Block*>(_cache->value(handle));
+    Status st;
+    if (offset + buf.size > block->size) {
+        st = Status::InternalError(strings::Substitute("read $0 bytes from $1 of block of $2 bytes", buf.size, offset,
+                                                       block->size));
+    } else {
+        std::unique_ptr<RandomAccessFile> file;
+        st = Env::Default()->new_random_access_file(block->path, &file);
+        if (st.ok()) {
+            st = file->read_at(offset, buf);
+        }
+    }
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to read cached block " << block->path << ": " << st;
+    }
+    _cache->release(handle);
+    if (!st.ok()) {
+        _cache->erase(CacheKey(key));
+        g_block_cache_miss_count.increment(1);
+        return false;
+    }
+    g_block_cache_hit_count.increment(1);
+    return true;
+}
+
+void BlockCache::populate(const std::string& path, int64_t modification_time, int64_t index, std::string block) {
+    std::string key = _encode_key(path, modification_time, index);
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (!_pending_keys.insert(key).second) {
+            return;
+        }
+    }
+    auto data = std::make_shared<std::string>(std::move(block));
+    Status st = _write_pool->submit_func([this, key, data]() {
+        _write_block(key, *data);
+        std::lock_guard<std::mutex> l(_mutex);
+        _pending_keys.erase(key);
+    });
+    if (!st.ok()) {
+        std::lock_guard<std::mutex> l(_mutex);
+        _pending_keys.erase(key);
+    }
+}
+
+void BlockCache::_write_block(const std::string& key, const std::string& block) {
+    std::string path = strings::Substitute("$0/$1", _dir, _next_block_id.fetch_add(1));
+    std::unique_ptr<WritableFile> file;
+    Status st = Env::Default()->new_writable_file(path, &file);
+    if (st.ok()) {
+        st = file->append(Slice(block));
+    }
+    if (st.ok()) {
+        st = file->close();
+    }
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to write cached block " << path << ": " << st;
+        Env::Default()->delete_file(path);
+        return;
+    }
+    auto deleter = [](const CacheKey& key, void* value) {
+        auto* block = reinterpret_cast<Block*>(value);
+        Env::Default()->delete_file(block->path);
+        delete block;
+    };
+    auto* handle = _cache->insert(CacheKey(key), new Block{path, block.size()}, block.size(), deleter);
+    _cache->release(handle);
+}
+
+int64_t BlockCache::hit_count() {
+    return g_block_cache_hit_count.value();
+}
+
+int64_t BlockCache::miss_count() {
+    return g_block_cache_miss_count.value();
+}
+
+BlockCachedRandomAccessFile::BlockCachedRandomAccessFile(BlockCache* cache, std::shared_ptr<RandomAccessFile> file,
+                                                         uint64_t file_size, int64_t modification_time)
+        : _cache(cache), _file(std::move(file)), _file_size(file_size), _modification_time(modification_time) {}
+
+Status BlockCachedRandomAccessFile::read(uint64_t offset, Slice* res) const {
+    res->size = offset < _file_size ? std::min<uint64_t>(res->size, _file_size - offset) : 0;
+    return read_at(offset, *res);
+}
+
+Status BlockCachedRandomAccessFile::read_at(uint64_t offset, const Slice& res) const {
+    if (offset + res.size > _file_size) {
+        return Status::InternalError(strings::Substitute("fail to read enough data, file=$0, offset=$1, size=$2, "
+                                                         "file size=$3",
+                                                         file_name(), offset, res.size, _file_size));
+    }
+    const uint64_t block_size = _cache->block_size();
+    const uint64_t end = offset + res.size;
+    const auto first_index = static_cast<int64_t>(offset / block_size);
+    const auto end_index = static_cast<int64_t>((end + block_size - 1) / block_size);
+    // the first block of the run of the blocks not in the cache, read from the remote file at once
+    int64_t miss_index = -1;
+    for (int64_t index = first_index; index <= end_index; index++) {
+        if (index < end_index) {
+            uint64_t from = std::max<uint64_t>(offset, index * block_size);
+            uint64_t to = std::min<uint64_t>(end, (index + 1) * block_size);
+            Slice buf(res.data + (from - offset), to - from);
+            if (!_cache->read(file_name(), _modification_time, index, from - index * block_size, buf)) {
+                if (miss_index < 0) {
+                    miss_index = index;
+                }
+                continue;
+            }
+            _stats.bytes_read_from_cache += buf.size;
+        }
+        if (miss_index >= 0) {
+            uint64_t from = std::max<uint64_t>(offset, miss_index * block_size);
+            uint64_t to = std::min<uint64_t>(end, index * block_size);
+            Slice buf(res.data + (from - offset), to - from);
+            RETURN_IF_ERROR(_read_remote_blocks(miss_index, index - miss_index, from, buf));
+            miss_index = -1;
+        }
+    }
+    return Status::OK();
+}
+
+Status BlockCachedRandomAccessFile::_read_remote_blocks(int64_t index, int64_t num_blocks, uint64_t offset,
+                                                        const Slice& buf) const {
+    const uint64_t block_size = _cache->block_size();
+    const uint64_t begin = index * block_size;
+    const uint64_t end = std::min<uint64_t>(_file_size, (index + num_blocks) * block_size);
+    std::string data;
+    raw::stl_string_resize_uninitialized(&data, end - begin);
+    RETURN_IF_ERROR(_file->read_at(begin, Slice(data)));
+    memcpy(buf.data, data.data() + (offset - begin), buf.size);
+    _stats.bytes_read_into_cache += data.size();
+    for (int64_t i = 0; i < num_blocks; i++) {
+        uint64_t from = i * block_size;
+        _cache->populate(file_name(), _modification_time, index + i,
+                         data.substr(from, std::min<uint64_t>(block_size, data.size() - from)));
+    }
+    return Status::OK();
+}
+
+Status BlockCachedRandomAccessFile::readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const {
+    for (size_t i = 0; i < res_cnt; i++) {
+        RETURN_IF_ERROR(read_at(offset, res[i]));
+        offset += res[i].size;
+    }
+    return Status::OK();
+}
+
+Status BlockCachedRandomAccessFile::size(uint64_t* size) const {
+    *size = _file_size;
+    return Status::OK();
+}
+
+BlockCachedRandomAccessFile::Stats BlockCachedRandomAccessFile::take_stats() const {
+    Stats stats = _stats;
+    _stats = Stats();
+    return stats;
+}
+
+} // namespace starrocks
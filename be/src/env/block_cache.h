@@ -0,0 +1,126 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+#include "common/status.h"
+#include "env/env.h"
+#include "gutil/macros.h"
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+class ThreadPool;
+
+// BlockCache keeps the recently read blocks of the remote files on the local disk, so that the hot remote files are
+// read again without going to the remote filesystem. A file is split into blocks of |block_size| bytes, each cached
+// in a file of its own in |dir|, and keyed by the path and modification time of the file, which tell a file rewritten
+// from its old version, and its index in the file. The blocks are written to the disk by background threads after
+// they are read from the remote files, and evicted in LRU order once they are more than |capacity| bytes. The cache
+// is not persistent, |dir| is cleared when it is created.
+class BlockCache {
+public:
+    // Create global instance of this class
+    static Status create_global_cache(const std::string& dir, size_t capacity, size_t block_size, int num_threads);
+
+    static void release_global_cache();
+
+    // Return global instance, nullptr if the cache has not been created or is disabled.
+    static BlockCache* instance() { return _s_instance; }
+
+    BlockCache(std::string dir, size_t capacity, size_t block_size);
+    ~BlockCache();
+
+    // Clear |dir| and start |num_threads| threads writing the blocks.
+    Status init(int num_threads);
+
+    size_t block_size() const { return _block_size; }
+
+    // Read the bytes from |offset| of the |index|th block of the file into |buf|, false if the block is not in the
+    // cache. The block must have the bytes.
+    bool read(const std::string& path, int64_t modification_time, int64_t index, size_t offset, const Slice& buf);
+
+    // Write the |index|th block of the file into the cache in background, which is dropped if there are too many
+    // blocks to write.
+    void populate(const std::string& path, int64_t modification_time, int64_t index, std::string block);
+
+    size_t disk_usage() const { return _cache->get_memory_usage(); }
+
+    // The number of the blocks read from the cache, or not found, of the process.
+    static int64_t hit_count();
+    static int64_t miss_count();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(BlockCache);
+
+    // The blocks written by at most this many writes are held in memory.
+    static constexpr int kMaxPendingBlocks = 64;
+
+    struct Block {
+        std::string path;
+        size_t size = 0;
+    };
+
+    static std::string _encode_key(const std::string& path, int64_t modification_time, int64_t index);
+
+    void _write_block(const std::string& key, const std::string& block);
+
+    static BlockCache* _s_instance;
+
+    const std::string _dir;
+    const size_t _block_size;
+    std::unique_ptr<Cache> _cache;
+    std::atomic<uint64_t> _next_block_id{0};
+
+    // the keys of the blocks being written
+    std::mutex _mutex;
+    std::unordered_set<std::string> _pending_keys;
+    std::unique_ptr<ThreadPool> _write_pool;
+};
+
+// BlockCachedRandomAccessFile reads |file| of |file_size| bytes through |cache|, by reading the missing blocks from
+// |file| into the cache.
+//
+// [not thread-safe], like the remote files.
+class BlockCachedRandomAccessFile final : public RandomAccessFile {
+public:
+    struct Stats {
+        int64_t bytes_read_from_cache = 0;
+        int64_t bytes_read_into_cache = 0;
+    };
+
+    BlockCachedRandomAccessFile(BlockCache* cache, std::shared_ptr<RandomAccessFile> file, uint64_t file_size,
+                                int64_t modification_time);
+    ~BlockCachedRandomAccessFile() override = default;
+
+    Status read(uint64_t offset, Slice* res) const override;
+    Status read_at(uint64_t offset, const Slice& res) const override;
+    Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override;
+
+    Status size(uint64_t* size) const override;
+    const std::string& file_name() const override { return _file->file_name(); }
+
+    const RandomAccessFile* remote_file() const { return _file.get(); }
+
+    // The stats of the reads since the last call.
+    Stats take_stats() const;
+
+private:
+    // Read the |num_blocks| blocks from the |index|th one from the remote file, copy the bytes of the file in
+    // [offset, offset + buf.size) into |buf| and write the blocks into the cache.
+    Status _read_remote_blocks(int64_t index, int64_t num_blocks, uint64_t offset, const Slice& buf) const;
+
+    BlockCache* _cache;
+    std::shared_ptr<RandomAccessFile> _file;
+    const uint64_t _file_size;
+    const int64_t _modification_time;
+    mutable Stats _stats;
+};
+
+} // namespace starrocks
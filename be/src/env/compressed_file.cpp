@@ -2,6 +2,8 @@
 
 #include "env/compressed_file.h"
 
+#include <thread>
+
 #include "exec/decompressor.h"
 
 namespace starrocks {
@@ -58,4 +60,72 @@ Status CompressedSequentialFile::skip(uint64_t n) {
     return Status::OK();
 }
 
+ReadAheadSequentialFile::ReadAheadSequentialFile(std::shared_ptr<SequentialFile> input_file, size_t num_buffers,
+                                                 size_t buffer_size)
+        : _filename(input_file->filename()),
+          _state(std::make_shared<State>(std::move(input_file), std::max<size_t>(num_buffers, 1), buffer_size)) {}
+
+ReadAheadSequentialFile::~ReadAheadSequentialFile() {
+    // Wakes up the read-ahead thread if it waits for a free buffer, it exits after its current read otherwise.
+    _state->buffers.shutdown();
+}
+
+Status ReadAheadSequentialFile::_next_buffer() {
+    if (!_started) {
+        _started = true;
+        std::thread([state = _state]() {
+            while (true) {
+                Buffer buffer;
+                buffer.data.resize(state->buffer_size);
+                Slice slice(buffer.data.data(), buffer.data.size());
+                buffer.status = state->input_file->read(&slice);
+                buffer.data.resize(buffer.status.ok() ? slice.size : 0);
+                // An empty buffer or an error ends the file.
+                bool last = buffer.data.empty();
+                if (!state->buffers.blocking_put(std::move(buffer)) || last) {
+                    break;
+                }
+            }
+        }).detach();
+    }
+    if (!_state->buffers.blocking_get(&_current)) {
+        return Status::Cancelled("read ahead of " + _filename + " stopped");
+    }
+    _offset = 0;
+    _eof = _current.data.empty();
+    return _current.status;
+}
+
+Status ReadAheadSequentialFile::read(Slice* result) {
+    while (_offset >= _current.data.size()) {
+        if (_eof) {
+            result->size = 0;
+            // The error of the input file is kept for the later reads, since nothing is read after it.
+            return _current.status;
+        }
+        RETURN_IF_ERROR(_next_buffer());
+    }
+    size_t n = std::min(result->size, _current.data.size() - _offset);
+    memcpy(result->data, _current.data.data() + _offset, n);
+    _offset += n;
+    result->size = n;
+    return Status::OK();
+}
+
+Status ReadAheadSequentialFile::skip(uint64_t n) {
+    while (n > 0) {
+        if (_offset >= _current.data.size()) {
+            if (_eof) {
+                return _current.status;
+            }
+            RETURN_IF_ERROR(_next_buffer());
+            continue;
+        }
+        size_t skipped = std::min<uint64_t>(n, _current.data.size() - _offset);
+        _offset += skipped;
+        n -= skipped;
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks
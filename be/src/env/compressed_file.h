@@ -4,6 +4,7 @@
 
 #include "env/env.h"
 #include "util/bit_util.h"
+#include "util/blocking_queue.hpp"
 #include "util/raw_container.h"
 
 namespace starrocks {
@@ -76,4 +77,47 @@ private:
     bool _stream_end = false;
 };
 
+// ReadAheadSequentialFile reads |input_file| ahead of its reader on a separate thread, by buffers of |buffer_size|
+// bytes of which up to |num_buffers| are queued, so that the decompression of a compressed file runs in parallel
+// with the parsing of the data decompressed so far instead of between its parses.
+class ReadAheadSequentialFile final : public SequentialFile {
+public:
+    ReadAheadSequentialFile(std::shared_ptr<SequentialFile> input_file, size_t num_buffers,
+                            size_t buffer_size = 1024 * 1024LU);
+
+    ~ReadAheadSequentialFile() override;
+
+    Status read(Slice* result) override;
+
+    Status skip(uint64_t n) override;
+
+    const std::string& filename() const override { return _filename; }
+
+private:
+    struct Buffer {
+        Status status;
+        raw::RawVector<uint8_t> data;
+    };
+
+    // Shared with the read-ahead thread, which is detached and may outlive this file while blocked in a read of
+    // |input_file|, e.g. of a stream load pipe.
+    struct State {
+        State(std::shared_ptr<SequentialFile> file, size_t num_buffers, size_t size)
+                : input_file(std::move(file)), buffer_size(size), buffers(num_buffers) {}
+
+        std::shared_ptr<SequentialFile> input_file;
+        const size_t buffer_size;
+        BlockingQueue<Buffer> buffers;
+    };
+
+    Status _next_buffer();
+
+    std::string _filename;
+    std::shared_ptr<State> _state;
+    bool _started = false;
+    Buffer _current;
+    size_t _offset = 0;
+    bool _eof = false;
+};
+
 } // namespace starrocks
@@ -248,6 +248,10 @@ public:
     // Safe for concurrent use by multiple threads.
     virtual Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const = 0;
 
+    // Hint that "length" bytes starting from "offset" will be read soon, so that they
+    // could be read asynchronously before. Does nothing by default.
+    virtual Status prefetch(uint64_t offset, size_t length) const { return Status::OK(); }
+
     // Return the size of this file
     virtual Status size(uint64_t* size) const = 0;
 
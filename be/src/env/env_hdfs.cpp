@@ -11,22 +11,13 @@ namespace starrocks {
 HdfsRandomAccessFile::HdfsRandomAccessFile(hdfsFS fs, hdfsFile file, std::string filename)
         : _fs(fs), _file(file), _filename(std::move(filename)) {}
 
+// The positional reads leave the offset of the file unchanged, so that a file is read by several threads at once, and
+// are hedged by the client if the hedged reads of |fs| are enabled.
 static Status read_at_internal(hdfsFS fs, hdfsFile file, const std::string& file_name, int64_t offset, Slice* res) {
-    auto cur_offset = hdfsTell(fs, file);
-    if (cur_offset == -1) {
-        return Status::IOError(
-                strings::Substitute("fail to get offset, file=$0, error=$1", file_name, get_hdfs_err_msg()));
-    }
-    if (cur_offset != offset) {
-        if (hdfsSeek(fs, file, offset)) {
-            return Status::IOError(strings::Substitute("fail to seek offset, file=$0, offset=$1, error=$1", file_name,
-                                                       offset, get_hdfs_err_msg()));
-        }
-    }
     size_t bytes_read = 0;
     while (bytes_read < res->size) {
         size_t to_read = res->size - bytes_read;
-        auto hdfs_res = hdfsRead(fs, file, res->data + bytes_read, to_read);
+        auto hdfs_res = hdfsPread(fs, file, offset + bytes_read, res->data + bytes_read, to_read);
         if (hdfs_res < 0) {
             return Status::IOError(
                     strings::Substitute("fail to read file, file=$0, error=$1", file_name, get_hdfs_err_msg()));
@@ -9,7 +9,7 @@
 namespace starrocks {
 
 // class for remote read hdfs file
-// Now this is not thread-safe.
+// This is thread-safe, the reads are positional.
 class HdfsRandomAccessFile : public RandomAccessFile {
 public:
     HdfsRandomAccessFile(hdfsFS fs, hdfsFile file, std::string filename);
@@ -22,6 +22,7 @@ public:
     Status size(uint64_t* size) const override;
     const std::string& file_name() const override { return _filename; }
 
+    hdfsFS hdfs_fs() const { return _fs; }
     hdfsFile hdfs_file() const { return _file; }
 
 private:
@@ -276,6 +276,16 @@ public:
     Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override {
         return do_readv_at(_fd, _filename, offset, res, res_cnt, nullptr);
     }
+
+    // The kernel starts reading the range into the page cache without waiting for it.
+    Status prefetch(uint64_t offset, size_t length) const override {
+        int res = posix_fadvise(_fd, offset, length, POSIX_FADV_WILLNEED);
+        if (res != 0) {
+            return io_error(_filename, res);
+        }
+        return Status::OK();
+    }
+
     Status size(uint64_t* size) const override {
         struct stat st;
         auto res = fstat(_fd, &st);
@@ -37,6 +37,7 @@ public:
     static std::string build_clear_scroll_body(const std::string& scroll_id);
     // @note: predicates should processed before pass it to this method,
     // tie breaker for predicate wheather can push down es can reference the push-down filters
+    // the query scrolls the slice KEY_SLICE_ID of KEY_SLICE_MAX slices of the shard if given, unless `limit` is set
     static std::string build(const std::map<std::string, std::string>& properties,
                              const std::vector<std::string>& fields, std::vector<EsPredicate*>& predicates,
                              const std::map<std::string, std::string>& docvalue_context, bool* doc_value_mode);
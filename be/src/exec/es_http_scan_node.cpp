@@ -21,9 +21,11 @@
 
 #include "exec/es_http_scan_node.h"
 
+#include <algorithm>
 #include <chrono>
 #include <sstream>
 
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "exec/es/es_predicate.h"
 #include "exec/es/es_query_builder.h"
@@ -47,6 +49,7 @@ EsHttpScanNode::EsHttpScanNode(ObjectPool* pool, const TPlanNode& tnode, const D
           _scan_finished(false),
           _eos(false),
           _max_buffered_batches(1024),
+          _slices_per_range(1),
           _wait_scanner_timer(nullptr) {}
 
 EsHttpScanNode::~EsHttpScanNode() {}
@@ -157,14 +160,17 @@ Status EsHttpScanNode::open(RuntimeState* state) {
 }
 
 Status EsHttpScanNode::start_scanners() {
+    // One scanner per slice of the sliced scroll of each shard, but a single search of the limit pushed down.
+    _slices_per_range = _limit_pushed_down() ? 1 : std::max(config::es_scroll_slices_per_shard, 1);
+    const int num_scanners = _scan_ranges.size() * _slices_per_range;
     {
         std::unique_lock<std::mutex> l(_batch_queue_lock);
-        _num_running_scanners = _scan_ranges.size();
+        _num_running_scanners = num_scanners;
     }
 
-    _scanners_status.resize(_scan_ranges.size());
-    for (int i = 0; i < _scan_ranges.size(); i++) {
-        _scanner_threads.emplace_back(&EsHttpScanNode::scanner_worker, this, i, _scan_ranges.size(),
+    _scanners_status.resize(num_scanners);
+    for (int i = 0; i < num_scanners; i++) {
+        _scanner_threads.emplace_back(&EsHttpScanNode::scanner_worker, this, i, num_scanners,
                                       std::ref(_scanners_status[i]));
     }
     return Status::OK();
@@ -414,7 +420,7 @@ void EsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Stat
     }
 
     EsScanCounter counter;
-    const TEsScanRange& es_scan_range = _scan_ranges[start_idx].scan_range.es_scan_range;
+    const TEsScanRange& es_scan_range = _scan_ranges[start_idx / _slices_per_range].scan_range.es_scan_range;
 
     // Collect the informations from scan range to perperties
     std::map<std::string, std::string> properties(_properties);
@@ -426,8 +432,11 @@ void EsHttpScanNode::scanner_worker(int start_idx, int length, std::promise<Stat
     properties[ESScanReader::KEY_BATCH_SIZE] = std::to_string(_runtime_state->batch_size());
     properties[ESScanReader::KEY_HOST_PORT] = get_host_port(es_scan_range.es_hosts);
     // push down limit to Elasticsearch
-    if (limit() != -1 && limit() <= _runtime_state->batch_size()) {
+    if (_limit_pushed_down()) {
         properties[ESScanReader::KEY_TERMINATE_AFTER] = std::to_string(limit());
+    } else if (_slices_per_range > 1) {
+        properties[ESScanReader::KEY_SLICE_ID] = std::to_string(start_idx % _slices_per_range);
+        properties[ESScanReader::KEY_SLICE_MAX] = std::to_string(_slices_per_range);
     }
 
     bool doc_value_mode = false;
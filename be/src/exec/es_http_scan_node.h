@@ -77,9 +77,13 @@ private:
     // Collect all scanners 's status
     Status collect_scanners_status();
 
-    // One scanner worker, This scanner will hanle 'length' ranges start from start_idx
+    // One scanner worker of 'length' ones, which scans the slice start_idx % _slices_per_range of the range
+    // start_idx / _slices_per_range
     void scanner_worker(int start_idx, int length, std::promise<Status>& p_status);
 
+    // Whether the limit is pushed down to Elasticsearch as the terminate_after of a single search
+    bool _limit_pushed_down() const { return limit() != -1 && limit() <= _runtime_state->batch_size(); }
+
     // Scan one range
     Status scanner_scan(std::unique_ptr<EsHttpScanner> scanner, const std::vector<ExprContext*>& conjunct_ctxs,
                         EsScanCounter* counter);
@@ -94,6 +98,8 @@ private:
     std::atomic<bool> _scan_finished;
     bool _eos;
     int _max_buffered_batches;
+    // The slices of the sliced scroll of each range, i.e. shard
+    int _slices_per_range;
     RuntimeProfile::Counter* _wait_scanner_timer;
 
     Status _process_status;
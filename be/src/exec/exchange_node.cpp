@@ -112,12 +112,13 @@ Status ExchangeNode::close(RuntimeState* state) {
     if (is_closed()) {
         return Status::OK();
     }
-    if (_is_merging) {
-        _sort_exec_exprs.close(state);
-    }
+    // The receiver is closed first, which stops the mergers of the groups of the senders evaluating the sort exprs.
     if (_stream_recvr != NULL) {
         _stream_recvr->close();
     }
+    if (_is_merging) {
+        _sort_exec_exprs.close(state);
+    }
     // _stream_recvr.reset();
     return ExecNode::close(state);
 }
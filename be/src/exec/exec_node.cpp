@@ -65,6 +65,7 @@
 #include "exec/vectorized/hash_join_node.h"
 #include "exec/vectorized/hdfs_scan_node.h"
 #include "exec/vectorized/intersect_node.h"
+#include "exec/vectorized/merge_join_node.h"
 #include "exec/vectorized/mysql_scan_node.h"
 #include "exec/vectorized/olap_scan_node.h"
 #include "exec/vectorized/project_node.h"
@@ -83,8 +84,10 @@
 #include "runtime/runtime_filter_worker.h"
 #include "runtime/runtime_state.h"
 #include "simd/simd.h"
+#include "util/adaptive_predicate_order.h"
 #include "util/debug_util.h"
 #include "util/runtime_profile.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -506,6 +509,9 @@ Status ExecNode::create_vectorized_node(starrocks::RuntimeState* state, starrock
     case TPlanNodeType::CROSS_JOIN_NODE:
         *node = pool->add(new vectorized::CrossJoinNode(pool, tnode, descs));
         return Status::OK();
+    case TPlanNodeType::MERGE_JOIN_NODE:
+        *node = pool->add(new vectorized::MergeJoinNode(pool, tnode, descs));
+        return Status::OK();
     case TPlanNodeType::UNION_NODE:
         *node = pool->add(new vectorized::UnionNode(pool, tnode, descs));
         return Status::OK();
@@ -723,7 +729,22 @@ bool ExecNode::eval_conjuncts(ExprContext* const* ctxs, int num_ctxs, TupleRow*
     return true;
 }
 
-static void eager_prune_eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk) {
+// Evaluate the |i|-th conjunct of |ctxs| in the order of |order| if any, and measure it if |order| is sampling.
+static ColumnPtr eval_conjunct(const std::vector<ExprContext*>& ctxs, size_t i, vectorized::Chunk* chunk,
+                               AdaptivePredicateOrder* order, size_t* true_count) {
+    size_t index = order != nullptr ? (*order)[i] : i;
+    bool sampling = order != nullptr && order->sampling();
+    int64_t start = sampling ? MonotonicNanos() : 0;
+    ColumnPtr column = ctxs[index]->evaluate(chunk);
+    *true_count = vectorized::ColumnHelper::count_true_with_notnull(column);
+    if (sampling) {
+        order->add_sample(index, column->size(), *true_count, MonotonicNanos() - start);
+    }
+    return column;
+}
+
+static void eager_prune_eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk,
+                                       AdaptivePredicateOrder* order) {
     vectorized::Column::Filter filter(chunk->num_rows(), 1);
     vectorized::Column::Filter* raw_filter = &filter;
 
@@ -741,9 +762,9 @@ static void eager_prune_eval_conjuncts(const std::vector<ExprContext*>& ctxs, ve
     int prune_threshold = std::max(int(chunk->num_rows() * prune_ratio), prune_min_size);
     int zero_count = 0;
 
-    for (auto* ctx : ctxs) {
-        ColumnPtr column = ctx->evaluate(chunk);
-        size_t true_count = vectorized::ColumnHelper::count_true_with_notnull(column);
+    for (size_t i = 0; i < ctxs.size(); ++i) {
+        size_t true_count = 0;
+        ColumnPtr column = eval_conjunct(ctxs, i, chunk, order, &true_count);
 
         if (true_count == column->size()) {
             // all hit, skip
@@ -773,35 +794,17 @@ static void eager_prune_eval_conjuncts(const std::vector<ExprContext*>& ctxs, ve
     chunk->filter(*raw_filter);
 }
 
-void ExecNode::eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk,
-                              vectorized::FilterPtr* filter_ptr) {
-    // No need to do expression if none rows
-    if (chunk->num_rows() == 0) {
-        return;
-    }
-
-    // if we don't need filter, then we can prune chunk during eval conjuncts.
-    // when doing prune, we expect all columns are in conjuncts, otherwise
-    // there will be extra memcpy of columns/slots which are not children of any conjunct.
-    // ideally, we can collects slots in conjuncts, and check the overlap with chunk->columns
-    // if overlap ratio is high enough, it's good to do prune.
-    // but here for simplicity, we just check columns numbers absolute value.
-    // TO BE NOTED, that there is no storng evidence that this has better performance.
-    // It's just by intuition.
-    const int eager_prune_max_column_number = 5;
-    if (filter_ptr == nullptr && chunk->num_columns() <= eager_prune_max_column_number) {
-        return eager_prune_eval_conjuncts(ctxs, chunk);
-    }
-
+static void eval_conjuncts_with_filter(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk,
+                                       vectorized::FilterPtr* filter_ptr, AdaptivePredicateOrder* order) {
     vectorized::FilterPtr filter(new vectorized::Column::Filter(chunk->num_rows(), 1));
     if (filter_ptr != nullptr) {
         *filter_ptr = filter;
     }
     vectorized::Column::Filter* raw_filter = filter.get();
 
-    for (auto* ctx : ctxs) {
-        ColumnPtr column = ctx->evaluate(chunk);
-        size_t true_count = vectorized::ColumnHelper::count_true_with_notnull(column);
+    for (size_t i = 0; i < ctxs.size(); ++i) {
+        size_t true_count = 0;
+        ColumnPtr column = eval_conjunct(ctxs, i, chunk, order, &true_count);
 
         if (true_count == column->size()) {
             // all hit, skip
@@ -827,6 +830,35 @@ void ExecNode::eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized:
     chunk->filter(*raw_filter);
 }
 
+void ExecNode::eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk,
+                              vectorized::FilterPtr* filter_ptr, AdaptivePredicateOrder* order) {
+    // No need to do expression if none rows
+    if (chunk->num_rows() == 0) {
+        return;
+    }
+    if (order != nullptr) {
+        order->init(ctxs.size());
+    }
+
+    // if we don't need filter, then we can prune chunk during eval conjuncts.
+    // when doing prune, we expect all columns are in conjuncts, otherwise
+    // there will be extra memcpy of columns/slots which are not children of any conjunct.
+    // ideally, we can collects slots in conjuncts, and check the overlap with chunk->columns
+    // if overlap ratio is high enough, it's good to do prune.
+    // but here for simplicity, we just check columns numbers absolute value.
+    // TO BE NOTED, that there is no storng evidence that this has better performance.
+    // It's just by intuition.
+    const int eager_prune_max_column_number = 5;
+    if (filter_ptr == nullptr && chunk->num_columns() <= eager_prune_max_column_number) {
+        eager_prune_eval_conjuncts(ctxs, chunk, order);
+    } else {
+        eval_conjuncts_with_filter(ctxs, chunk, filter_ptr, order);
+    }
+    if (order != nullptr) {
+        order->next_chunk();
+    }
+}
+
 void ExecNode::eval_join_runtime_filters(vectorized::Chunk* chunk) {
     if (chunk == nullptr) return;
     _runtime_filter_collector.evaluate(chunk);
@@ -42,6 +42,7 @@
 
 namespace starrocks {
 
+class AdaptivePredicateOrder;
 class Expr;
 class ExprContext;
 class ObjectPool;
@@ -181,8 +182,10 @@ public:
     // evaluate exprs over chunk to get a filter
     // if filter_ptr is not null, save filter to filter_ptr.
     // then running filter on chunk.
+    // if order is not null, exprs are evaluated in the order adapted to their cost and selectivity,
+    // and the same order must be passed with the same exprs for every chunk.
     static void eval_conjuncts(const std::vector<ExprContext*>& ctxs, vectorized::Chunk* chunk,
-                               vectorized::FilterPtr* filter_ptr = nullptr);
+                               vectorized::FilterPtr* filter_ptr = nullptr, AdaptivePredicateOrder* order = nullptr);
 
     Status init_join_runtime_filters(const TPlanNode& tnode, RuntimeState* state);
     void register_runtime_filter_descriptor(RuntimeState* state, vectorized::RuntimeFilterProbeDescriptor* rf_desc);
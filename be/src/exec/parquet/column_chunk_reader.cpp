@@ -12,6 +12,7 @@
 #include "exec/parquet/types.h"
 #include "exec/parquet/utils.h"
 #include "gutil/strings/substitute.h"
+#include "util/raw_container.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks::parquet {
@@ -25,7 +26,7 @@ public:
     Status read(uint64_t offset, Slice* res) const override {
         Status st;
         {
-            SCOPED_RAW_TIMER(&_stats->io_ns);
+            ScopedIOTimer io_timer(&_stats->io_ns, &_stats->io_latency);
             _stats->io_count += 1;
             st = _file->read(offset, res);
             _stats->bytes_read_from_disk += res->size;
@@ -36,7 +37,7 @@ public:
     Status read_at(uint64_t offset, const Slice& result) const override {
         Status st;
         {
-            SCOPED_RAW_TIMER(&_stats->io_ns);
+            ScopedIOTimer io_timer(&_stats->io_ns, &_stats->io_latency);
             _stats->io_count += 1;
             st = _file->read_at(offset, result);
             _stats->bytes_read_from_disk += result.size;
@@ -47,7 +48,7 @@ public:
     Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override {
         Status st;
         {
-            SCOPED_RAW_TIMER(&_stats->io_ns);
+            ScopedIOTimer io_timer(&_stats->io_ns, &_stats->io_latency);
             _stats->io_count += 1;
             st = _file->readv_at(offset, res, res_cnt);
             for (int i = 0; i < res_cnt; ++i) {
@@ -107,6 +108,23 @@ Status ColumnChunkReader::next_page() {
     return Status::OK();
 }
 
+Status ColumnChunkReader::next_header(size_t* num_values) {
+    RETURN_IF_ERROR(_parse_page_header());
+    const auto& header = *_page_reader->current_header();
+    *num_values = header.type == tparquet::PageType::DATA_PAGE ? header.data_page_header.num_values : 0;
+    return Status::OK();
+}
+
+Status ColumnChunkReader::skip_page() {
+    if (_page_parse_state != PAGE_HEADER_PARSED ||
+        _page_reader->current_header()->type != tparquet::PageType::DATA_PAGE) {
+        return Status::InternalError("Error state");
+    }
+    _page_reader->skip_page();
+    _page_parse_state = PAGE_DATA_PARSED;
+    return Status::OK();
+}
+
 Status ColumnChunkReader::_parse_page_header() {
     DCHECK(_page_parse_state == INITIALIZED || _page_parse_state == PAGE_DATA_PARSED);
     RETURN_IF_ERROR(_page_reader->next_header());
@@ -216,6 +234,15 @@ Status ColumnChunkReader::_parse_dict_page() {
     return Status::OK();
 }
 
+Status ColumnChunkReader::_decode_dict_codes_of_plain_values(size_t n, vectorized::Column* dst) {
+    if (_dict_decoder == nullptr) {
+        return Status::NotSupported("column chunk without dictionary could not be read as dict codes");
+    }
+    raw::stl_vector_resize_uninitialized(&_plain_values, n);
+    RETURN_IF_ERROR(_cur_decoder->next_batch(n, reinterpret_cast<uint8_t*>(_plain_values.data())));
+    return _dict_decoder->append_dict_codes(_plain_values, dst);
+}
+
 Status ColumnChunkReader::_try_load_dictionary() {
     RETURN_IF_ERROR(_parse_page_header());
     const auto& header = *_page_reader->current_header();
@@ -246,6 +273,7 @@ Status ColumnChunkReader::_try_load_dictionary() {
     RETURN_IF_ERROR(EncodingInfo::get(metadata().type, tparquet::Encoding::RLE_DICTIONARY, &code_info));
     RETURN_IF_ERROR(code_info->create_decoder(&decoder));
     RETURN_IF_ERROR(decoder->set_dict(header.dictionary_page_header.num_values, dict_decoder.get()));
+    _dict_decoder = decoder.get();
     _decoders[static_cast<int>(tparquet::Encoding::RLE_DICTIONARY)] = std::move(decoder);
 
     RETURN_IF_ERROR(_parse_page_header());
@@ -40,6 +40,13 @@ public:
 
     Status next_page();
 
+    // next_page() in two steps: parse the header of the next page, and set |*num_values| to its number of
+    // values if it is a data page, 0 otherwise, then either load the page by load_page() or skip it by skip_page(),
+    // which neither decompresses nor decodes it.
+    Status next_header(size_t* num_values);
+    Status load_page() { return _parse_page_data(); }
+    Status skip_page();
+
     uint32_t num_values() const { return _num_values; }
 
     // Try to decode n definition levels into 'levels'
@@ -72,26 +79,33 @@ public:
             if (is_null) {
                 dst->append_nulls(run);
             } else {
-                RETURN_IF_ERROR(_cur_decoder->next_batch(run, content_type, dst));
+                RETURN_IF_ERROR(decode_values(run, content_type, dst));
             }
         }
         return Status::OK();
     }
 
     Status decode_values(size_t n, ColumnContentType content_type, vectorized::Column* dst) {
+        if (content_type == ColumnContentType::DICT_CODE && _cur_decoder != _dict_decoder) {
+            return _decode_dict_codes_of_plain_values(n, dst);
+        }
         return _cur_decoder->next_batch(n, content_type, dst);
     }
 
+    Status skip_values(size_t n) { return _cur_decoder->skip(n); }
+
     const tparquet::ColumnMetaData& metadata() const { return _chunk_metadata->meta_data; }
 
-    Status get_dict_values(vectorized::Column* column) { return _cur_decoder->get_dict_values(column); }
+    // The dictionary is the one of the column chunk, even if the current page falls back from the dictionary
+    // encoding. The values of such pages read as dict codes are added to it.
+    Status get_dict_values(vectorized::Column* column) { return _get_dict_decoder()->get_dict_values(column); }
 
     Status get_dict_values(const std::vector<int32_t>& dict_codes, vectorized::Column* column) {
-        return _cur_decoder->get_dict_values(dict_codes, column);
+        return _get_dict_decoder()->get_dict_values(dict_codes, column);
     }
 
     Status get_dict_codes(const std::vector<Slice>& dict_values, std::vector<int32_t>* dict_codes) {
-        return _cur_decoder->get_dict_codes(dict_values, dict_codes);
+        return _get_dict_decoder()->get_dict_codes(dict_values, dict_codes);
     }
 
 private:
@@ -99,6 +113,9 @@ private:
     Status _parse_page_data();
 
     Status _try_load_dictionary();
+    Decoder* _get_dict_decoder() const { return _dict_decoder != nullptr ? _dict_decoder : _cur_decoder; }
+    // Decode the |n| values of the current page, which is not dictionary encoded, into their dict codes.
+    Status _decode_dict_codes_of_plain_values(size_t n, vectorized::Column* dst);
     Status _read_and_decompress_page_data();
     Status _parse_data_page();
     Status _parse_dict_page();
@@ -137,7 +154,10 @@ private:
     Slice _data;
 
     Decoder* _cur_decoder = nullptr;
+    // the decoder of the dictionary encoded pages, nullptr if the column chunk has no dictionary
+    Decoder* _dict_decoder = nullptr;
     std::unordered_map<int, std::unique_ptr<Decoder>> _decoders;
+    std::vector<Slice> _plain_values;
 };
 
 } // namespace starrocks::parquet
@@ -359,6 +359,10 @@ public:
         _reader->get_levels(def_levels, rep_levels, num_levels);
     }
 
+    void set_row_ranges(const std::vector<RowRange>* row_ranges) override { _reader->set_row_ranges(row_ranges); }
+
+    Status skip_rows(size_t num_rows) override { return _reader->skip_rows(num_rows); }
+
     Status get_dict_values(vectorized::Column* column) override { return _reader->get_dict_values(column); }
 
     Status get_dict_values(const std::vector<int32_t>& dict_codes, vectorized::Column* column) override {
@@ -47,6 +47,13 @@ public:
 
     virtual void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) = 0;
 
+    // Skip decoding the pages out of |row_ranges| of the row group if supported, whose rows are read as default
+    // values, see StoredColumnReader::set_row_ranges.
+    virtual void set_row_ranges(const std::vector<RowRange>* row_ranges) {}
+
+    // Skip the next |num_rows| rows without decoding them, NotSupported by the readers of nested columns.
+    virtual Status skip_rows(size_t num_rows) { return Status::NotSupported("skip_rows is not supported"); }
+
     virtual Status get_dict_values(vectorized::Column* column) {
         return Status::NotSupported("get_dict_values is not supported");
     }
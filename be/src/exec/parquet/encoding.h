@@ -56,6 +56,12 @@ public:
         return Status::NotSupported("get_dict_codes is not supported");
     }
 
+    // Append the dict codes of |values| to |dst|, adding the values not in the dictionary to it, so that the plain
+    // pages of a column chunk falling back from the dictionary encoding could be read as dict codes too.
+    virtual Status append_dict_codes(const std::vector<Slice>& values, vectorized::Column* dst) {
+        return Status::NotSupported("append_dict_codes is not supported");
+    }
+
     // used to set fixed length
     virtual void set_type_legth(int32_t type_length) {}
 
@@ -71,6 +77,9 @@ public:
     virtual Status next_batch(size_t count, uint8_t* dst) {
         return Status::NotSupported("next_batch is not supportted");
     }
+
+    // Skip the next |count| values without decoding them into a column.
+    virtual Status skip(size_t count) { return Status::NotSupported("skip is not supported"); }
 };
 
 class EncodingInfo {
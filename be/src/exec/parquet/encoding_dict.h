@@ -2,7 +2,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <deque>
 #include <map>
+#include <string>
 
 #include "column/column.h"
 #include "column/column_helper.h"
@@ -125,6 +128,15 @@ public:
         return Status::OK();
     }
 
+    Status skip(size_t count) override {
+        while (count > 0) {
+            size_t n = std::min(count, _indexes.size());
+            _index_batch_decoder.GetBatch(&_indexes[0], n);
+            count -= n;
+        }
+        return Status::OK();
+    }
+
 private:
     enum { SIZE_OF_TYPE = sizeof(T) };
 
@@ -194,6 +206,27 @@ public:
         return Status::OK();
     }
 
+    Status append_dict_codes(const std::vector<Slice>& values, vectorized::Column* dst) override {
+        raw::stl_vector_resize_uninitialized(&_fallback_codes, values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            auto iter = _dict_code_by_value.find(values[i]);
+            if (iter != _dict_code_by_value.end()) {
+                _fallback_codes[i] = iter->second;
+                continue;
+            }
+            // the value is kept with enough memory after it to use append_strings_overflow
+            std::string& value = _fallback_values.emplace_back(values[i].data, values[i].size);
+            value.resize(values[i].size + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE);
+            Slice slice(value.data(), values[i].size);
+            _fallback_codes[i] = _dict.size();
+            _dict.emplace_back(slice);
+            _dict_code_by_value[slice] = _fallback_codes[i];
+            _max_value_length = std::max(_max_value_length, slice.size);
+        }
+        dst->append_numbers(_fallback_codes.data(), values.size() * SIZE_OF_DICT_CODE_TYPE);
+        return Status::OK();
+    }
+
     Status set_data(const Slice& data) override {
         if (data.size > 0) {
             uint8_t bit_width = *data.data;
@@ -228,12 +261,24 @@ public:
         return Status::OK();
     }
 
+    Status skip(size_t count) override {
+        while (count > 0) {
+            size_t n = std::min(count, _indexes.size());
+            _index_batch_decoder.GetBatch(&_indexes[0], n);
+            count -= n;
+        }
+        return Status::OK();
+    }
+
 private:
     enum { SIZE_OF_DICT_CODE_TYPE = sizeof(int32_t) };
     std::unordered_map<Slice, int32_t, SliceHasher> _dict_code_by_value;
 
     RleBatchDecoder<uint32_t> _index_batch_decoder;
     std::vector<uint8_t> _dict_data;
+    // the values added by append_dict_codes
+    std::deque<std::string> _fallback_values;
+    std::vector<uint32_t> _fallback_codes;
     std::vector<Slice> _dict;
     std::vector<uint32_t> _indexes;
     std::vector<Slice> _slices;
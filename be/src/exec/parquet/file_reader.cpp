@@ -4,11 +4,15 @@
 
 #include <thrift/protocol/TDebugProtocol.h>
 
+#include <algorithm>
+
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "env/env.h"
 #include "exec/exec_node.h"
 #include "exec/parquet/encoding_plain.h"
 #include "exec/parquet/metadata.h"
+#include "exec/vectorized/hdfs_file_meta_cache.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 #include "gen_cpp/parquet_types.h"
@@ -58,6 +62,16 @@ Status FileReader::get_next(vectorized::ChunkPtr* chunk) {
 }
 
 Status FileReader::_parse_footer() {
+    // the files of unknown modification times are not cached, which could be rewritten in the same length
+    vectorized::HdfsFileMetaCache* cache =
+            _param.modification_time > 0 ? vectorized::HdfsFileMetaCache::instance() : nullptr;
+    if (cache != nullptr) {
+        _file_metadata = cache->lookup_parquet(_file->file_name(), _file_size, _param.modification_time);
+        if (_file_metadata != nullptr) {
+            return Status::OK();
+        }
+    }
+
     // try
     constexpr uint64_t footer_buf_size = 16 * 1024;
 
@@ -82,6 +96,9 @@ Status FileReader::_parse_footer() {
     RETURN_IF_ERROR(deserialize_thrift_msg(footer_buf + to_read - 8 - footer_size, &footer_size, true, &t_metadata));
     _file_metadata.reset(new FileMetaData());
     RETURN_IF_ERROR(_file_metadata->init(t_metadata));
+    if (cache != nullptr) {
+        cache->insert_parquet(_file->file_name(), _file_size, _param.modification_time, _file_metadata, footer_size);
+    }
 
     return Status::OK();
 }
@@ -198,6 +215,192 @@ Status FileReader::_filter_group(const tparquet::RowGroup& row_group, bool* is_f
     return Status::OK();
 }
 
+bool FileReader::_filter_group_by_runtime_filters(const tparquet::RowGroup& row_group) const {
+    if (_param.runtime_filter_collector == nullptr) {
+        return false;
+    }
+    for (const auto& column : _param.materialized_columns) {
+        // The statistics are decoded by their physical types, so as to be compared with the runtime filters of the
+        // same types only.
+        PrimitiveType type = column.col_type.type;
+        if (type != TYPE_INT && type != TYPE_BIGINT) {
+            continue;
+        }
+        const auto* column_meta = _get_column_meta(row_group, column.col_name);
+        if (column_meta == nullptr || !column_meta->__isset.statistics ||
+            column_meta->type != (type == TYPE_INT ? tparquet::Type::INT32 : tparquet::Type::INT64)) {
+            continue;
+        }
+        const ParquetField* field = _file_metadata->schema().resolve_by_name(column.col_name);
+        const tparquet::ColumnOrder* column_order = nullptr;
+        if (field != nullptr && _file_metadata->t_metadata().__isset.column_orders) {
+            const auto& column_orders = _file_metadata->t_metadata().column_orders;
+            int column_idx = field->physical_column_index;
+            column_order = column_idx < column_orders.size() ? &column_orders[column_idx] : nullptr;
+        }
+        vectorized::ColumnPtr min_column = vectorized::ColumnHelper::create_column(column.col_type, false);
+        vectorized::ColumnPtr max_column = vectorized::ColumnHelper::create_column(column.col_type, false);
+        if (!_decode_min_max_column(*column_meta, column_order, &min_column, &max_column).ok()) {
+            continue;
+        }
+        if (_param.should_skip_by_runtime_filters(column.slot_id, *min_column, *max_column)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Status FileReader::_filter_pages(const tparquet::RowGroup& row_group, std::vector<RowRange>* row_ranges,
+                                 bool* is_filter) {
+    *is_filter = false;
+    row_ranges->clear();
+    if (_param.min_max_conjunct_ctxs.empty() || !config::parquet_page_index_enable) {
+        return Status::OK();
+    }
+
+    // The pages of the columns with page indexes split the row group into segments, starting at the first rows of
+    // all the pages, whose min/max values are the ones of the pages holding them.
+    const auto& slots = _param.min_max_tuple_desc->slots();
+    std::vector<std::unique_ptr<tparquet::ColumnIndex>> column_indexes(slots.size());
+    std::vector<std::unique_ptr<tparquet::OffsetIndex>> offset_indexes(slots.size());
+    std::vector<int64_t> segment_rows{0};
+    for (size_t i = 0; i < slots.size(); i++) {
+        const auto* column_chunk = _get_column_chunk(row_group, slots[i]->col_name());
+        if (column_chunk == nullptr || !column_chunk->__isset.column_index_offset ||
+            !column_chunk->__isset.column_index_length || !column_chunk->__isset.offset_index_offset ||
+            !column_chunk->__isset.offset_index_length) {
+            continue;
+        }
+        const ParquetField* field = _file_metadata->schema().resolve_by_name(slots[i]->col_name());
+        const tparquet::ColumnOrder* column_order = nullptr;
+        if (_file_metadata->t_metadata().__isset.column_orders) {
+            const auto& column_orders = _file_metadata->t_metadata().column_orders;
+            int column_idx = field->physical_column_index;
+            column_order = column_idx < column_orders.size() ? &column_orders[column_idx] : nullptr;
+        }
+        if (!_can_use_stats(column_chunk->meta_data.type, column_order)) {
+            continue;
+        }
+        auto column_index = std::make_unique<tparquet::ColumnIndex>();
+        auto offset_index = std::make_unique<tparquet::OffsetIndex>();
+        RETURN_IF_ERROR(_read_page_index(*column_chunk, column_index.get(), offset_index.get()));
+        size_t num_pages = offset_index->page_locations.size();
+        if (num_pages == 0 || column_index->null_pages.size() != num_pages ||
+            column_index->min_values.size() != num_pages || column_index->max_values.size() != num_pages) {
+            continue;
+        }
+        for (const auto& location : offset_index->page_locations) {
+            segment_rows.emplace_back(location.first_row_index);
+        }
+        column_indexes[i] = std::move(column_index);
+        offset_indexes[i] = std::move(offset_index);
+    }
+    std::sort(segment_rows.begin(), segment_rows.end());
+    segment_rows.erase(std::unique(segment_rows.begin(), segment_rows.end()), segment_rows.end());
+    while (!segment_rows.empty() && segment_rows.back() >= row_group.num_rows) {
+        segment_rows.pop_back();
+    }
+    size_t num_segments = segment_rows.size();
+    if (num_segments <= 1) {
+        return Status::OK();
+    }
+
+    // the min/max values of the row group, for the columns without page indexes
+    auto min_group_chunk = vectorized::ChunkHelper::new_chunk(*_param.min_max_tuple_desc, 1);
+    auto max_group_chunk = vectorized::ChunkHelper::new_chunk(*_param.min_max_tuple_desc, 1);
+    if (std::any_of(column_indexes.begin(), column_indexes.end(), [](const auto& index) { return index == nullptr; })) {
+        bool exist = false;
+        RETURN_IF_ERROR(_read_min_max_chunk(row_group, &min_group_chunk, &max_group_chunk, &exist));
+        if (!exist) {
+            return Status::OK();
+        }
+    }
+
+    auto min_chunk = vectorized::ChunkHelper::new_chunk(*_param.min_max_tuple_desc, num_segments);
+    auto max_chunk = vectorized::ChunkHelper::new_chunk(*_param.min_max_tuple_desc, num_segments);
+    // the segments having pages of nulls only, which the conjuncts cannot filter by min/max values
+    std::vector<uint8_t> unknown(num_segments, 0);
+    for (size_t i = 0; i < slots.size(); i++) {
+        auto& min_column = min_chunk->columns()[i];
+        auto& max_column = max_chunk->columns()[i];
+        if (column_indexes[i] == nullptr) {
+            min_column->append(*min_group_chunk->columns()[i], 0, 1);
+            min_column->assign(num_segments, 0);
+            max_column->append(*max_group_chunk->columns()[i], 0, 1);
+            max_column->assign(num_segments, 0);
+            continue;
+        }
+        const auto& column_index = *column_indexes[i];
+        const auto& locations = offset_indexes[i]->page_locations;
+        tparquet::Type::type type = _get_column_chunk(row_group, slots[i]->col_name())->meta_data.type;
+        size_t page = 0;
+        for (size_t s = 0; s < num_segments; s++) {
+            while (page + 1 < locations.size() && locations[page + 1].first_row_index <= segment_rows[s]) {
+                page++;
+            }
+            if (column_index.null_pages[page]) {
+                unknown[s] = 1;
+                min_column->append_default();
+                max_column->append_default();
+                continue;
+            }
+            if (!_decode_min_max_value(type, column_index.min_values[page], column_index.max_values[page],
+                                       &min_column, &max_column)
+                         .ok()) {
+                return Status::OK();
+            }
+        }
+    }
+
+    std::vector<uint8_t> filtered(num_segments, 0);
+    for (auto& min_max_conjunct_ctx : _param.min_max_conjunct_ctxs) {
+        auto min_column = min_max_conjunct_ctx->evaluate(min_chunk.get());
+        auto max_column = min_max_conjunct_ctx->evaluate(max_chunk.get());
+        for (size_t s = 0; s < num_segments; s++) {
+            vectorized::Datum min = min_column->get(s);
+            vectorized::Datum max = max_column->get(s);
+            if (!unknown[s] && !min.is_null() && !max.is_null() && min.get_int8() == 0 && max.get_int8() == 0) {
+                filtered[s] = 1;
+            }
+        }
+    }
+
+    for (size_t s = 0; s < num_segments; s++) {
+        if (filtered[s]) {
+            continue;
+        }
+        uint64_t begin = segment_rows[s];
+        uint64_t end = s + 1 < num_segments ? segment_rows[s + 1] : row_group.num_rows;
+        if (!row_ranges->empty() && row_ranges->back().end == begin) {
+            row_ranges->back().end = end;
+        } else {
+            row_ranges->emplace_back(RowRange{begin, end});
+        }
+    }
+    if (row_ranges->empty()) {
+        *is_filter = true;
+    } else if (row_ranges->size() == 1 && row_ranges->front().begin == 0 &&
+               row_ranges->front().end == row_group.num_rows) {
+        // no page is filtered
+        row_ranges->clear();
+    }
+    return Status::OK();
+}
+
+Status FileReader::_read_page_index(const tparquet::ColumnChunk& column_chunk, tparquet::ColumnIndex* column_index,
+                                    tparquet::OffsetIndex* offset_index) const {
+    std::string buf(column_chunk.column_index_length, '\0');
+    RETURN_IF_ERROR(_file->read_at(column_chunk.column_index_offset, Slice(buf)));
+    uint32_t length = buf.size();
+    RETURN_IF_ERROR(deserialize_thrift_msg(reinterpret_cast<const uint8_t*>(buf.data()), &length, true, column_index));
+
+    buf.assign(column_chunk.offset_index_length, '\0');
+    RETURN_IF_ERROR(_file->read_at(column_chunk.offset_index_offset, Slice(buf)));
+    length = buf.size();
+    RETURN_IF_ERROR(deserialize_thrift_msg(reinterpret_cast<const uint8_t*>(buf.data()), &length, true, offset_index));
+    return Status::OK();
+}
+
 Status FileReader::_read_min_max_chunk(const tparquet::RowGroup& row_group, vectorized::ChunkPtr* min_chunk,
                                        vectorized::ChunkPtr* max_chunk, bool* exist) const {
     for (size_t i = 0; i < _param.min_max_tuple_desc->slots().size(); i++) {
@@ -259,17 +462,22 @@ Status FileReader::_decode_min_max_column(const tparquet::ColumnMetaData& column
         return Status::NotSupported("min max statistics not supported");
     }
 
-    switch (column_meta.type) {
+    const tparquet::Statistics& stats = column_meta.statistics;
+    if (stats.__isset.min_value) {
+        return _decode_min_max_value(column_meta.type, stats.min_value, stats.max_value, min_column, max_column);
+    }
+    return _decode_min_max_value(column_meta.type, stats.min, stats.max, min_column, max_column);
+}
+
+Status FileReader::_decode_min_max_value(tparquet::Type::type type, const std::string& encoded_min,
+                                         const std::string& encoded_max, vectorized::ColumnPtr* min_column,
+                                         vectorized::ColumnPtr* max_column) {
+    switch (type) {
     case tparquet::Type::type::INT32: {
         int32_t min_value = 0;
         int32_t max_value = 0;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.min_value, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.max_value, &max_value));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.min, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.max, &max_value));
-        }
+        RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(encoded_min, &min_value));
+        RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(encoded_max, &max_value));
         (*min_column)->append_numbers(&min_value, sizeof(int32_t));
         (*max_column)->append_numbers(&max_value, sizeof(int32_t));
         return Status::OK();
@@ -277,13 +485,8 @@ Status FileReader::_decode_min_max_column(const tparquet::ColumnMetaData& column
     case tparquet::Type::type::INT64: {
         int64_t min_value = 0;
         int64_t max_value = 0;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.min_value, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.max_value, &max_value));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.max, &max_value));
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.min, &min_value));
-        }
+        RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(encoded_min, &min_value));
+        RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(encoded_max, &max_value));
         (*min_column)->append_numbers(&min_value, sizeof(int64_t));
         (*max_column)->append_numbers(&max_value, sizeof(int64_t));
         return Status::OK();
@@ -291,13 +494,8 @@ Status FileReader::_decode_min_max_column(const tparquet::ColumnMetaData& column
     case tparquet::Type::type::BYTE_ARRAY: {
         Slice min_slice;
         Slice max_slice;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.min_value, &min_slice));
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.max_value, &max_slice));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.min, &min_slice));
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.max, &max_slice));
-        }
+        RETURN_IF_ERROR(PlainDecoder<Slice>::decode(encoded_min, &min_slice));
+        RETURN_IF_ERROR(PlainDecoder<Slice>::decode(encoded_max, &max_slice));
         (*min_column)->append_strings(std::vector<Slice>{min_slice});
         (*max_column)->append_strings(std::vector<Slice>{max_slice});
         return Status::OK();
@@ -343,7 +541,7 @@ bool FileReader::_is_integer_type(const tparquet::Type::type& type) {
            type == tparquet::Type::type::INT96;
 }
 
-Status FileReader::_create_and_init_group_reader(int row_group_number) {
+Status FileReader::_create_and_init_group_reader(int row_group_number, std::vector<RowRange> row_ranges) {
     auto row_group_reader = _row_group(row_group_number);
 
     GroupReaderParam param;
@@ -351,6 +549,7 @@ Status FileReader::_create_and_init_group_reader(int row_group_number) {
     param.conjunct_ctxs_by_slot = _param.conjunct_ctxs_by_slot;
     param.read_cols = _read_cols;
     param.timezone = _param.timezone;
+    param.row_ranges = std::move(row_ranges);
     param.stats = _param.stats;
 
     RETURN_IF_ERROR(row_group_reader->init(param));
@@ -384,8 +583,20 @@ Status FileReader::_init_group_reader() {
                 LOG(INFO) << "row group " << i << " of file has been filtered by min/max conjunct";
                 continue;
             }
+            if (_filter_group_by_runtime_filters(_file_metadata->t_metadata().row_groups[i])) {
+                VLOG_FILE << "row group " << i << " of file has been filtered by the runtime filters";
+                _param.stats->runtime_filter_skipped_row_groups++;
+                continue;
+            }
 
-            RETURN_IF_ERROR(_create_and_init_group_reader(i));
+            std::vector<RowRange> row_ranges;
+            RETURN_IF_ERROR(_filter_pages(_file_metadata->t_metadata().row_groups[i], &row_ranges, &is_filter));
+            if (is_filter) {
+                LOG(INFO) << "row group " << i << " of file has been filtered by the page indexes";
+                continue;
+            }
+
+            RETURN_IF_ERROR(_create_and_init_group_reader(i, std::move(row_ranges)));
 
             _total_row_count += _file_metadata->t_metadata().row_groups[i].num_rows;
         } else {
@@ -474,4 +685,14 @@ const tparquet::ColumnMetaData* FileReader::_get_column_meta(const tparquet::Row
     return nullptr;
 }
 
+const tparquet::ColumnChunk* FileReader::_get_column_chunk(const tparquet::RowGroup& row_group,
+                                                           const std::string& col_name) {
+    for (const auto& column : row_group.columns) {
+        if (column.meta_data.path_in_schema[0] == col_name) {
+            return &column;
+        }
+    }
+    return nullptr;
+}
+
 } // namespace starrocks::parquet
@@ -50,8 +50,8 @@ private:
     // filter file using not exist column conjuncts
     void _filter_file();
 
-    // create and inti group reader
-    Status _create_and_init_group_reader(int row_group_number);
+    // create and inti group reader, which reads the |row_ranges| of the row group, all if empty
+    Status _create_and_init_group_reader(int row_group_number, std::vector<RowRange> row_ranges);
 
     // create row group reader
     std::shared_ptr<GroupReader> _row_group(int i);
@@ -61,6 +61,14 @@ private:
 
     // filter row group by min/max conjuncts
     Status _filter_group(const tparquet::RowGroup& group, bool* is_filter);
+    // filter row group by the min/max values of the ready runtime filters on the materialized columns
+    bool _filter_group_by_runtime_filters(const tparquet::RowGroup& row_group) const;
+
+    // filter the pages of row group by min/max conjuncts on the page indexes (ColumnIndex and OffsetIndex) of the
+    // columns, into the ranges of rows to read, which are left empty to read all the rows
+    Status _filter_pages(const tparquet::RowGroup& row_group, std::vector<RowRange>* row_ranges, bool* is_filter);
+    Status _read_page_index(const tparquet::ColumnChunk& column_chunk, tparquet::ColumnIndex* column_index,
+                            tparquet::OffsetIndex* offset_index) const;
 
     // get row group to read
     // if scan range conatain the first byte in the row group, will be read
@@ -94,6 +102,10 @@ private:
     static Status _decode_min_max_column(const tparquet::ColumnMetaData& column_meta,
                                          const tparquet::ColumnOrder* column_order, vectorized::ColumnPtr* min_column,
                                          vectorized::ColumnPtr* max_column);
+    // decode the encoded min/max value of a column chunk or of a page
+    static Status _decode_min_max_value(tparquet::Type::type type, const std::string& encoded_min,
+                                        const std::string& encoded_max, vectorized::ColumnPtr* min_column,
+                                        vectorized::ColumnPtr* max_column);
     static bool _can_use_min_max_stats(const tparquet::ColumnMetaData& column_meta,
                                        const tparquet::ColumnOrder* column_order);
     // statistics.min_value max_value
@@ -105,6 +117,8 @@ private:
     // find column meta according column name
     static const tparquet::ColumnMetaData* _get_column_meta(const tparquet::RowGroup& row_group,
                                                             const std::string& col_name);
+    static const tparquet::ColumnChunk* _get_column_chunk(const tparquet::RowGroup& row_group,
+                                                          const std::string& col_name);
 
     // get the data page start offset in parquet file
     static int64_t _get_row_group_start_offset(const tparquet::RowGroup& row_group);
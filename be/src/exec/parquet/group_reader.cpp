@@ -3,9 +3,13 @@
 
 #include "exec/parquet/group_reader.h"
 
+#include <numeric>
+
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "exec/exec_node.h"
 #include "exprs/expr.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/types.h"
 #include "simd/simd.h"
 #include "storage/vectorized/chunk_helper.h"
@@ -13,7 +17,8 @@
 namespace starrocks::parquet {
 
 constexpr static const PrimitiveType kDictCodePrimitiveType = TYPE_INT;
-constexpr static const FieldType kDictCodeFieldType = OLAP_FIELD_TYPE_INT;
+// The shorter runs of rows filtered out of the lazy columns are decoded and filtered instead of skipped.
+constexpr static const size_t kMinLazySkipRows = 32;
 
 GroupReader::GroupReader(RandomAccessFile* file, FileMetaData* file_metadata, int row_group_number)
         : _file(file), _file_metadata(file_metadata), _row_group_number(row_group_number) {
@@ -24,6 +29,7 @@ GroupReader::GroupReader(RandomAccessFile* file, FileMetaData* file_metadata, in
 Status GroupReader::init(const GroupReaderParam& param) {
     _param = param;
     // the calling order matters, do not change unless you know why.
+    _init_shared_file();
     RETURN_IF_ERROR(_init_column_readers());
     _pre_process_columns_and_conjunct_ctxs();
     RETURN_IF_ERROR(_rewrite_dict_column_predicates());
@@ -38,9 +44,13 @@ Status GroupReader::get_next(vectorized::ChunkPtr* chunk, size_t* row_count) {
     }
 
     _read_chunk->reset();
+    if (_lazy_chunk != nullptr) {
+        _lazy_chunk->reset();
+    }
     size_t count = *row_count;
-    bool has_dict_filter = !_dict_filter_preds.empty();
+    bool has_dict_filter = !_dict_filter_columns.empty();
     bool has_more_filter = !_left_conjunct_ctxs.empty();
+    bool has_lazy_columns = !_lazy_read_columns.empty();
     Status status;
 
     {
@@ -51,23 +61,52 @@ Status GroupReader::get_next(vectorized::ChunkPtr* chunk, size_t* row_count) {
         if (!status.ok() && !status.is_end_of_file()) {
             return status;
         }
+        if (has_lazy_columns) {
+            raw::stl_vector_resize_uninitialized(&_row_selection, count);
+            memset(_row_selection.data(), 1, count);
+        }
+        if (!_param.row_ranges.empty()) {
+            _filter_row_ranges();
+            if (has_lazy_columns) {
+                _merge_row_selection(count, _selection.data());
+            }
+        }
+        _next_row += count;
     }
 
     // dict filter
     if (has_dict_filter) {
         SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
         SCOPED_RAW_TIMER(&_param.stats->group_dict_filter_ns);
-        _dict_filter();
+        RETURN_IF_ERROR(_dict_filter());
+        if (has_lazy_columns) {
+            _merge_row_selection(count, _selection.data());
+        }
         _read_chunk->check_or_die();
     }
 
     // other filter that not dict
     if (has_more_filter) {
         SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
-        ExecNode::eval_conjuncts(_left_conjunct_ctxs, _read_chunk.get());
+        vectorized::FilterPtr filter;
+        ExecNode::eval_conjuncts(_left_conjunct_ctxs, _read_chunk.get(), has_lazy_columns ? &filter : nullptr);
+        if (has_lazy_columns) {
+            if (_read_chunk->num_rows() == 0) {
+                memset(_row_selection.data(), 0, count);
+            } else if (filter != nullptr) {
+                _merge_row_selection(count, filter->data());
+            }
+        }
         _read_chunk->check_or_die();
     }
 
+    // the columns without conjuncts, for the rows left only
+    if (has_lazy_columns) {
+        SCOPED_RAW_TIMER(&_param.stats->group_chunk_read_ns);
+        RETURN_IF_ERROR(_read_lazy_columns(count));
+        DCHECK_EQ(_read_chunk->num_rows(), _lazy_chunk->num_rows());
+    }
+
     *row_count = _read_chunk->num_rows();
 
     SCOPED_RAW_TIMER(&_param.stats->group_dict_decode_ns);
@@ -77,6 +116,29 @@ Status GroupReader::get_next(vectorized::ChunkPtr* chunk, size_t* row_count) {
     return status;
 }
 
+void GroupReader::_init_shared_file() {
+    _shared_file = std::make_unique<SharedBufferedFile>(_file);
+    if (config::parquet_coalesce_read_threads <= 0) {
+        return;
+    }
+    std::vector<SharedBufferedFile::Range> ranges;
+    for (const auto& column : _param.read_cols) {
+        const tparquet::ColumnMetaData& column_metadata =
+                _row_group_metadata->columns[column.col_idx_in_parquet].meta_data;
+        // the same range as ColumnChunkReader reads
+        SharedBufferedFile::Range range;
+        if (column_metadata.__isset.dictionary_page_offset) {
+            range.offset = column_metadata.dictionary_page_offset;
+        } else {
+            range.offset = column_metadata.data_page_offset;
+        }
+        range.size = column_metadata.total_compressed_size;
+        ranges.emplace_back(range);
+    }
+    _shared_file->read_ahead(std::move(ranges), config::parquet_coalesce_read_max_gap,
+                             config::parquet_coalesce_read_max_size, config::parquet_coalesce_read_threads);
+}
+
 Status GroupReader::_init_column_readers() {
     for (const auto& column : _param.read_cols) {
         RETURN_IF_ERROR(_create_column_reader(column));
@@ -93,8 +155,11 @@ Status GroupReader::_create_column_reader(const GroupReaderParam::Column& column
     opts.timezone = _param.timezone;
     {
         SCOPED_RAW_TIMER(&_param.stats->column_reader_init_ns);
-        RETURN_IF_ERROR(ColumnReader::create(_file, schema_node, *_row_group_metadata, column.col_type_in_chunk, opts,
-                                             &column_reader));
+        RETURN_IF_ERROR(ColumnReader::create(_shared_file.get(), schema_node, *_row_group_metadata,
+                                             column.col_type_in_chunk, opts, &column_reader));
+    }
+    if (!_param.row_ranges.empty()) {
+        column_reader->set_row_ranges(&_param.row_ranges);
     }
     _column_readers[column.slot_id] = std::move(column_reader);
     return Status::OK();
@@ -120,6 +185,20 @@ void GroupReader::_pre_process_columns_and_conjunct_ctxs() {
             }
         }
     }
+
+    // read the columns without conjuncts after the conjuncts filter the rows
+    if (!config::parquet_lazy_decode_enable || (_dict_filter_columns.empty() && _left_conjunct_ctxs.empty())) {
+        return;
+    }
+    std::vector<GroupReaderParam::Column> active_columns;
+    for (const auto& column : _direct_read_columns) {
+        if (conjunct_ctxs_by_slot.find(column.slot_id) != conjunct_ctxs_by_slot.end()) {
+            active_columns.emplace_back(column);
+        } else {
+            _lazy_read_columns.emplace_back(column);
+        }
+    }
+    _direct_read_columns.swap(active_columns);
 }
 
 bool GroupReader::_can_using_dict_filter(const SlotDescriptor* slot, const SlotIdExprContextsMap& conjunct_ctxs_by_slot,
@@ -147,12 +226,20 @@ bool GroupReader::_can_using_dict_filter(const SlotDescriptor* slot, const SlotI
         }
     }
 
-    // check all data pages dict encoded
-    if (!_column_all_pages_dict_encoded(column_metadata)) {
-        return false;
-    }
+    // the pages falling back from the dictionary encoding add their values to the dictionary
+    return _column_has_dict(column_metadata);
+}
 
-    return true;
+bool GroupReader::_column_has_dict(const tparquet::ColumnMetaData& column_metadata) {
+    if (column_metadata.__isset.dictionary_page_offset) {
+        return true;
+    }
+    for (const tparquet::Encoding::type& encoding : column_metadata.encodings) {
+        if (encoding == tparquet::Encoding::PLAIN_DICTIONARY || encoding == tparquet::Encoding::RLE_DICTIONARY) {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool GroupReader::_column_all_pages_dict_encoded(const tparquet::ColumnMetaData& column_metadata) {
@@ -214,56 +301,84 @@ bool GroupReader::_column_all_pages_dict_encoded(const tparquet::ColumnMetaData&
 }
 
 Status GroupReader::_rewrite_dict_column_predicates() {
+    std::vector<GroupReaderParam::Column> dict_filter_columns;
     for (const auto& column : _dict_filter_columns) {
         SlotId slot_id = column.slot_id;
-        vectorized::ChunkPtr dict_value_chunk = std::make_shared<vectorized::Chunk>();
         std::shared_ptr<vectorized::BinaryColumn> dict_value_column = vectorized::BinaryColumn::create();
-        dict_value_chunk->append_column(dict_value_column, slot_id);
-
-        RETURN_IF_ERROR(_column_readers[slot_id]->get_dict_values(dict_value_column.get()));
-        ExecNode::eval_conjuncts(_dict_filter_conjunct_ctxs[slot_id], dict_value_chunk.get());
-        dict_value_chunk->check_or_die();
+        Status st = _column_readers[slot_id]->get_dict_values(dict_value_column.get());
+        if (st.is_not_supported()) {
+            // the column chunk has no dictionary page though its metadata tells so, read it directly
+            _direct_read_columns.emplace_back(column);
+            for (ExprContext* ctx : _dict_filter_conjunct_ctxs[slot_id]) {
+                _left_conjunct_ctxs.emplace_back(ctx);
+            }
+            _dict_filter_conjunct_ctxs.erase(slot_id);
+            continue;
+        }
+        RETURN_IF_ERROR(st);
+        dict_filter_columns.emplace_back(column);
+        _append_dict_code_selection(slot_id, dict_value_column);
 
-        // dict column is empty after conjunct eval, file group can be skipped
-        if (dict_value_chunk->num_rows() == 0) {
+        // no dict value is selected, the row group can be skipped if no data page falls back to other encodings
+        const tparquet::ColumnMetaData& column_metadata =
+                _row_group_metadata->columns[column.col_idx_in_parquet].meta_data;
+        if (_dict_code_selections[slot_id].num_selected == 0 && _column_all_pages_dict_encoded(column_metadata)) {
             _is_group_filtered = true;
             return Status::OK();
         }
+    }
+    _dict_filter_columns.swap(dict_filter_columns);
+    return Status::OK();
+}
 
-        // get dict codes
-        std::vector<int32_t> dict_codes;
-        RETURN_IF_ERROR(_column_readers[slot_id]->get_dict_codes(dict_value_column->get_data(), &dict_codes));
-
-        // eq predicate is faster than in predicate
-        // TODO: improve not eq and not in
-        if (dict_codes.size() == 1) {
-            _dict_filter_preds[slot_id] = vectorized::new_column_eq_predicate(get_type_info(kDictCodeFieldType),
-                                                                              slot_id, std::to_string(dict_codes[0]));
-        } else {
-            std::vector<std::string> str_codes;
-            str_codes.reserve(dict_codes.size());
-            for (int code : dict_codes) {
-                str_codes.emplace_back(std::to_string(code));
-            }
-            _dict_filter_preds[slot_id] =
-                    vectorized::new_column_in_predicate(get_type_info(kDictCodeFieldType), slot_id, str_codes);
-        }
-        _obj_pool.add(_dict_filter_preds[slot_id]);
+void GroupReader::_append_dict_code_selection(SlotId slot_id, const vectorized::ColumnPtr& dict_values) {
+    DictCodeSelection& selection = _dict_code_selections[slot_id];
+    size_t num_values = dict_values->size();
+    if (num_values == 0) {
+        return;
     }
+    vectorized::ChunkPtr dict_value_chunk = std::make_shared<vectorized::Chunk>();
+    dict_value_chunk->append_column(dict_values, slot_id);
+    vectorized::FilterPtr filter;
+    ExecNode::eval_conjuncts(_dict_filter_conjunct_ctxs[slot_id], dict_value_chunk.get(), &filter);
+    if (dict_value_chunk->num_rows() == 0) {
+        selection.selected.resize(selection.selected.size() + num_values, 0);
+        return;
+    }
+    DCHECK(filter != nullptr && filter->size() == num_values);
+    selection.selected.insert(selection.selected.end(), filter->begin(), filter->end());
+    selection.num_selected += dict_value_chunk->num_rows();
+}
 
+Status GroupReader::_extend_dict_code_selection(SlotId slot_id, size_t num_codes) {
+    DictCodeSelection& selection = _dict_code_selections[slot_id];
+    std::vector<int32_t> codes(num_codes - selection.selected.size());
+    std::iota(codes.begin(), codes.end(), static_cast<int32_t>(selection.selected.size()));
+    std::shared_ptr<vectorized::BinaryColumn> dict_value_column = vectorized::BinaryColumn::create();
+    RETURN_IF_ERROR(_column_readers[slot_id]->get_dict_values(codes, dict_value_column.get()));
+    _append_dict_code_selection(slot_id, dict_value_column);
     return Status::OK();
 }
 
 void GroupReader::_init_read_chunk() {
     const auto& slots = _param.tuple_desc->slots();
     std::vector<SlotDescriptor*> read_slots;
-    for (const auto& column : _param.read_cols) {
-        int chunk_index = column.col_idx_in_chunk;
-        read_slots.emplace_back(slots[chunk_index]);
+    for (const auto& column : _dict_filter_columns) {
+        read_slots.emplace_back(slots[column.col_idx_in_chunk]);
+    }
+    for (const auto& column : _direct_read_columns) {
+        read_slots.emplace_back(slots[column.col_idx_in_chunk]);
     }
 
     size_t chunk_size = config::vector_chunk_size;
     _read_chunk = vectorized::ChunkHelper::new_chunk(read_slots, chunk_size);
+    if (!_lazy_read_columns.empty()) {
+        std::vector<SlotDescriptor*> lazy_slots;
+        for (const auto& column : _lazy_read_columns) {
+            lazy_slots.emplace_back(slots[column.col_idx_in_chunk]);
+        }
+        _lazy_chunk = vectorized::ChunkHelper::new_chunk(lazy_slots, chunk_size);
+    }
     raw::stl_vector_resize_uninitialized(&_selection, chunk_size);
 
     // replace dict filter column
@@ -308,18 +423,146 @@ Status GroupReader::_read(size_t* row_count) {
     return Status::OK();
 }
 
-void GroupReader::_dict_filter() {
-    DCHECK(!_dict_filter_preds.empty());
+void GroupReader::_filter_row_ranges() {
+    size_t count = _read_chunk->num_rows();
+    uint64_t begin = _next_row;
+    uint64_t end = _next_row + count;
+    memset(_selection.data(), 0, count);
+    for (const RowRange& range : _param.row_ranges) {
+        if (range.end <= begin) {
+            continue;
+        }
+        if (range.begin >= end) {
+            break;
+        }
+        uint64_t from = std::max(range.begin, begin);
+        uint64_t to = std::min(range.end, end);
+        memset(_selection.data() + (from - begin), 1, to - from);
+    }
+    auto hit_count = SIMD::count_nonzero(_selection.data(), count);
+    if (hit_count == 0) {
+        _read_chunk->set_num_rows(0);
+    } else if (hit_count != count) {
+        _read_chunk->filter_range(_selection, 0, count);
+    }
+}
+
+void GroupReader::_merge_row_selection(size_t count, const uint8_t* filter) {
+    for (size_t i = 0, j = 0; i < count; i++) {
+        if (_row_selection[i]) {
+            _row_selection[i] = filter[j++];
+        }
+    }
+}
+
+Status GroupReader::_read_lazy_columns(size_t count) {
+    const uint8_t* selection = _row_selection.data();
+    for (const auto& column : _lazy_read_columns) {
+        SlotId slot_id = column.slot_id;
+        ColumnReader* reader = _column_readers[slot_id].get();
+        vectorized::Column* dst = _lazy_chunk->get_column_by_slot_id(slot_id).get();
+        _lazy_selection.clear();
+
+        auto read = [&](size_t from, size_t to) -> Status {
+            if (from == to) {
+                return Status::OK();
+            }
+            size_t num_rows = to - from;
+            Status status = reader->next_batch(&num_rows, ColumnContentType::VALUE, dst);
+            if (!status.ok() && !status.is_end_of_file()) {
+                return status;
+            }
+            if (num_rows != to - from) {
+                return Status::InternalError(strings::Substitute("Read $0 rows of column $1, expect $2", num_rows,
+                                                                 slot_id, to - from));
+            }
+            _lazy_selection.insert(_lazy_selection.end(), selection + from, selection + to);
+            return Status::OK();
+        };
+
+        // read the rows from |read_from| on till a run of rows to skip
+        size_t read_from = 0;
+        size_t i = 0;
+        while (i < count) {
+            if (selection[i]) {
+                i++;
+                continue;
+            }
+            size_t j = i + 1;
+            while (j < count && !selection[j]) {
+                j++;
+            }
+            if (j - i >= kMinLazySkipRows) {
+                RETURN_IF_ERROR(read(read_from, i));
+                Status status = reader->skip_rows(j - i);
+                if (status.is_not_supported()) {
+                    RETURN_IF_ERROR(read(i, j));
+                } else if (!status.ok()) {
+                    return status;
+                }
+                read_from = j;
+            }
+            i = j;
+        }
+        RETURN_IF_ERROR(read(read_from, count));
+
+        if (SIMD::count_zero(_lazy_selection.data(), _lazy_selection.size()) > 0) {
+            dst->filter(_lazy_selection);
+        }
+    }
+    return Status::OK();
+}
+
+Status GroupReader::_dict_filter() {
+    DCHECK(!_dict_filter_columns.empty());
 
     size_t count = _read_chunk->num_rows();
-    auto iter = _dict_filter_preds.begin();
-    SlotId slot_id = iter->first;
-    auto pred = iter->second;
-    pred->evaluate(_read_chunk->get_column_by_slot_id(slot_id).get(), _selection.data());
-    while (++iter != _dict_filter_preds.end()) {
-        slot_id = iter->first;
-        pred = iter->second;
-        pred->evaluate_and(_read_chunk->get_column_by_slot_id(slot_id).get(), _selection.data());
+    uint8_t* selection = _selection.data();
+    memset(selection, 1, count);
+    for (const auto& column : _dict_filter_columns) {
+        SlotId slot_id = column.slot_id;
+        auto* codes_column =
+                down_cast<vectorized::NullableColumn*>(_read_chunk->get_column_by_slot_id(slot_id).get());
+        auto* codes_data_column = down_cast<vectorized::FixedLengthColumn<int32_t>*>(codes_column->data_column().get());
+        const int32_t* codes = codes_data_column->get_data().data();
+        const uint8_t* nulls = codes_column->null_column()->get_data().data();
+        const bool has_null = codes_column->has_null();
+
+        // the codes out of the selection are the ones of the values added by the pages falling back from the
+        // dictionary encoding
+        int32_t max_code = -1;
+        if (has_null) {
+            for (size_t i = 0; i < count; i++) {
+                max_code = std::max(max_code, nulls[i] ? -1 : codes[i]);
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                max_code = std::max(max_code, codes[i]);
+            }
+        }
+        DictCodeSelection& code_selection = _dict_code_selections[slot_id];
+        if (max_code >= static_cast<int32_t>(code_selection.selected.size())) {
+            RETURN_IF_ERROR(_extend_dict_code_selection(slot_id, max_code + 1));
+        }
+        if (code_selection.selected.empty()) {
+            // the values are all null
+            memset(selection, 0, count);
+            continue;
+        }
+        if (code_selection.num_selected == code_selection.selected.size() && !has_null) {
+            continue;
+        }
+        // a lookup of the dict codes without branches, instead of a predicate on them, the codes of nulls are 0
+        const uint8_t* selected = code_selection.selected.data();
+        if (has_null) {
+            for (size_t i = 0; i < count; i++) {
+                selection[i] &= selected[codes[i]] & !nulls[i];
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                selection[i] &= selected[codes[i]];
+            }
+        }
     }
 
     auto hit_count = SIMD::count_nonzero(_selection.data(), count);
@@ -328,6 +571,7 @@ void GroupReader::_dict_filter() {
     } else if (hit_count != count) {
         _read_chunk->filter_range(_selection, 0, count);
     }
+    return Status::OK();
 }
 
 Status GroupReader::_dict_decode(vectorized::ChunkPtr* chunk) {
@@ -359,6 +603,10 @@ Status GroupReader::_dict_decode(vectorized::ChunkPtr* chunk) {
         SlotId slot_id = column.slot_id;
         (*chunk)->get_column_by_slot_id(slot_id)->swap_column(*(_read_chunk->get_column_by_slot_id(slot_id)));
     }
+    for (const auto& column : _lazy_read_columns) {
+        SlotId slot_id = column.slot_id;
+        (*chunk)->get_column_by_slot_id(slot_id)->swap_column(*(_lazy_chunk->get_column_by_slot_id(slot_id)));
+    }
     return Status::OK();
 }
 } // namespace starrocks::parquet
\ No newline at end of file
@@ -6,10 +6,10 @@
 #include "column/vectorized_fwd.h"
 #include "exec/parquet/column_reader.h"
 #include "exec/parquet/metadata.h"
+#include "exec/parquet/shared_buffered_file.h"
 #include "exec/vectorized/hdfs_scanner.h"
 #include "gen_cpp/parquet_types.h"
 #include "runtime/descriptors.h"
-#include "storage/vectorized/column_predicate.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks {
@@ -48,6 +48,9 @@ struct GroupReaderParam {
 
     std::string timezone;
 
+    // The rows of the row group to read, sorted and disjoint, as the page indexes of the file select. Empty reads all.
+    std::vector<RowRange> row_ranges;
+
     vectorized::HdfsScanStats* stats = nullptr;
 };
 
@@ -62,6 +65,8 @@ public:
 private:
     using SlotIdExprContextsMap = std::unordered_map<int, std::vector<ExprContext*>>;
 
+    // Read the column chunks to read ahead into |_shared_file|, by fewer and larger ranges.
+    void _init_shared_file();
     Status _init_column_readers();
     Status _create_column_reader(const GroupReaderParam::Column& column);
     // Extract dict filter columns and conjuncts
@@ -70,11 +75,24 @@ private:
                                 const tparquet::ColumnMetaData& column_metadata);
     // Returns true if all of the data pages in the column chunk are dict encoded
     bool _column_all_pages_dict_encoded(const tparquet::ColumnMetaData& column_metadata);
+    // Returns true if the column chunk has a dictionary, even if some data pages fall back to other encodings
+    bool _column_has_dict(const tparquet::ColumnMetaData& column_metadata);
     Status _rewrite_dict_column_predicates();
+    // Evaluate the conjuncts of the dict filter column on the dictionary values of the next codes, in order
+    void _append_dict_code_selection(SlotId slot_id, const vectorized::ColumnPtr& dict_values);
+    // Evaluate the conjuncts on the values of the codes added to the dictionary by the pages falling back from the
+    // dictionary encoding, up to |num_codes| codes.
+    Status _extend_dict_code_selection(SlotId slot_id, size_t num_codes);
     void _init_read_chunk();
 
     Status _read(size_t* row_count);
-    void _dict_filter();
+    // Filter out the rows of |_read_chunk| out of |_param.row_ranges|.
+    void _filter_row_ranges();
+    // Apply the |filter| of the rows of |_read_chunk| to |_row_selection| of the |count| rows read.
+    void _merge_row_selection(size_t count, const uint8_t* filter);
+    // Read the |count| rows of the lazy columns, of which the rows not in |_row_selection| are skipped.
+    Status _read_lazy_columns(size_t count);
+    Status _dict_filter();
     Status _dict_decode(vectorized::ChunkPtr* chunk);
 
     RandomAccessFile* _file;
@@ -88,12 +106,20 @@ private:
     // row group meta
     std::shared_ptr<tparquet::RowGroup> _row_group_metadata;
 
+    // |_file| with the column chunks of the row group read ahead, read by the column readers, so it is declared
+    // before them.
+    std::unique_ptr<SharedBufferedFile> _shared_file;
+
     // column readers for column chunk in row group
     std::unordered_map<SlotId, std::unique_ptr<ColumnReader>> _column_readers;
     // conjunct ctxs for each dict filter column
     std::unordered_map<SlotId, std::vector<ExprContext*>> _dict_filter_conjunct_ctxs;
-    // preds transformed from conjunct ctxs for each dict filter column
-    std::unordered_map<SlotId, vectorized::ColumnPredicate*> _dict_filter_preds;
+    // whether each dict code of each dict filter column is selected by its conjuncts, indexed by the code
+    struct DictCodeSelection {
+        std::vector<uint8_t> selected;
+        size_t num_selected = 0;
+    };
+    std::unordered_map<SlotId, DictCodeSelection> _dict_code_selections;
     // conjunct ctxs that eval after chunk is dict decoded
     std::vector<ExprContext*> _left_conjunct_ctxs;
 
@@ -101,17 +127,27 @@ private:
     std::vector<GroupReaderParam::Column> _dict_filter_columns;
     // direct read conlumns
     std::vector<GroupReaderParam::Column> _direct_read_columns;
+    // direct read columns without conjuncts, which are read after the conjuncts are evaluated on the other columns,
+    // for the rows selected only
+    std::vector<GroupReaderParam::Column> _lazy_read_columns;
 
     // dict value is empty after conjunct eval, file group can be skipped
     bool _is_group_filtered = false;
 
     vectorized::ChunkPtr _read_chunk;
     vectorized::Buffer<uint8_t> _selection;
+    // the index of the first row in the row group of the next read
+    uint64_t _next_row = 0;
+
+    // the lazy columns
+    vectorized::ChunkPtr _lazy_chunk;
+    // the rows selected of the ones read into |_read_chunk|
+    vectorized::Buffer<uint8_t> _row_selection;
+    // the rows selected of the ones read into a lazy column
+    vectorized::Buffer<uint8_t> _lazy_selection;
 
     // param for read row group
     GroupReaderParam _param;
-
-    ObjectPool _obj_pool;
 };
 
 } // namespace starrocks::parquet
@@ -0,0 +1,116 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/parquet/shared_buffered_file.h"
+
+#include <algorithm>
+
+namespace starrocks::parquet {
+
+SharedBufferedFile::~SharedBufferedFile() {
+    _stopped.store(true);
+    for (auto& t : _threads) {
+        t.join();
+    }
+}
+
+void SharedBufferedFile::read_ahead(std::vector<Range> ranges, uint64_t max_gap, uint64_t max_size,
+                                    int num_threads) {
+    DCHECK(_buffers.empty());
+    std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) { return a.offset < b.offset; });
+    for (const Range& range : ranges) {
+        if (range.size == 0 || range.size > max_size) {
+            continue;
+        }
+        if (!_buffers.empty()) {
+            Buffer* last = _buffers.back().get();
+            uint64_t last_end = last->offset + last->size;
+            uint64_t end = std::max(last_end, range.offset + range.size);
+            if (range.offset <= last_end + max_gap && end - last->offset <= max_size) {
+                last->size = end - last->offset;
+                continue;
+            }
+        }
+        auto buffer = std::make_unique<Buffer>();
+        buffer->offset = range.offset;
+        buffer->size = range.size;
+        _buffers.emplace_back(std::move(buffer));
+    }
+    if (_buffers.empty()) {
+        return;
+    }
+
+    auto worker = [this]() {
+        while (!_stopped.load()) {
+            size_t i = _next_buffer.fetch_add(1);
+            if (i >= _buffers.size()) {
+                break;
+            }
+            Buffer* buffer = _buffers[i].get();
+            raw::stl_vector_resize_uninitialized(&buffer->data, buffer->size);
+            Status st = _file->read_at(buffer->offset, Slice(buffer->data.data(), buffer->size));
+            std::lock_guard l(_mutex);
+            buffer->status = std::move(st);
+            buffer->done = true;
+            _cv.notify_all();
+        }
+    };
+    num_threads = std::max(1, std::min<int>(num_threads, _buffers.size()));
+    for (int i = 0; i < num_threads; i++) {
+        _threads.emplace_back(worker);
+    }
+}
+
+const SharedBufferedFile::Buffer* SharedBufferedFile::_find_buffer(uint64_t offset, uint64_t size) const {
+    auto iter = std::upper_bound(_buffers.begin(), _buffers.end(), offset,
+                                 [](uint64_t off, const auto& buffer) { return off < buffer->offset; });
+    if (iter == _buffers.begin()) {
+        return nullptr;
+    }
+    const Buffer* buffer = (--iter)->get();
+    if (offset + size > buffer->offset + buffer->size) {
+        return nullptr;
+    }
+    std::unique_lock l(_mutex);
+    _cv.wait(l, [buffer]() { return buffer->done; });
+    return buffer;
+}
+
+Status SharedBufferedFile::read(uint64_t offset, Slice* res) const {
+    const Buffer* buffer = _find_buffer(offset, res->size);
+    if (buffer == nullptr) {
+        return _file->read(offset, res);
+    }
+    RETURN_IF_ERROR(buffer->status);
+    memcpy(res->data, buffer->data.data() + (offset - buffer->offset), res->size);
+    return Status::OK();
+}
+
+Status SharedBufferedFile::read_at(uint64_t offset, const Slice& result) const {
+    const Buffer* buffer = _find_buffer(offset, result.size);
+    if (buffer == nullptr) {
+        return _file->read_at(offset, result);
+    }
+    RETURN_IF_ERROR(buffer->status);
+    memcpy(result.data, buffer->data.data() + (offset - buffer->offset), result.size);
+    return Status::OK();
+}
+
+Status SharedBufferedFile::readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const {
+    uint64_t size = 0;
+    for (size_t i = 0; i < res_cnt; i++) {
+        size += res[i].size;
+    }
+    const Buffer* buffer = _find_buffer(offset, size);
+    if (buffer == nullptr) {
+        return _file->readv_at(offset, res, res_cnt);
+    }
+    RETURN_IF_ERROR(buffer->status);
+    const uint8_t* data = buffer->data.data() + (offset - buffer->offset);
+    for (size_t i = 0; i < res_cnt; i++) {
+        memcpy(res[i].data, data, res[i].size);
+        data += res[i].size;
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::parquet
@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "env/env.h"
+#include "util/raw_container.h"
+
+namespace starrocks::parquet {
+
+// SharedBufferedFile reads the byte ranges of the column chunks a row group reads ahead of their decoding, merged
+// into fewer and larger requests read in parallel, since the latency of every request dominates the reads from
+// remote storage like HDFS or S3. The reads within a buffered range are served from its buffer, once read, and the
+// other reads go to the underlying file.
+class SharedBufferedFile final : public RandomAccessFile {
+public:
+    struct Range {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    explicit SharedBufferedFile(RandomAccessFile* file) : _file(file) {}
+
+    // Waits for the reads in progress.
+    ~SharedBufferedFile() override;
+
+    // Merge the |ranges| whose gap is at most |max_gap| bytes into ranges of at most |max_size| bytes, and start
+    // to read them by |num_threads| threads. The ranges larger than |max_size| are not buffered. Called once.
+    void read_ahead(std::vector<Range> ranges, uint64_t max_gap, uint64_t max_size, int num_threads);
+
+    Status read(uint64_t offset, Slice* res) const override;
+
+    Status read_at(uint64_t offset, const Slice& result) const override;
+
+    Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override;
+
+    Status size(uint64_t* size) const override { return _file->size(size); }
+
+    const std::string& file_name() const override { return _file->file_name(); }
+
+    // The number of merged ranges, for test.
+    size_t num_buffers() const { return _buffers.size(); }
+
+private:
+    struct Buffer {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        raw::RawVector<uint8_t> data;
+        Status status;
+        bool done = false;
+    };
+
+    // The buffer holding [offset, offset + size), waiting for it to be read, or nullptr.
+    const Buffer* _find_buffer(uint64_t offset, uint64_t size) const;
+
+    RandomAccessFile* _file;
+    // sorted by offset
+    std::vector<std::unique_ptr<Buffer>> _buffers;
+    std::atomic<size_t> _next_buffer{0};
+    std::atomic<bool> _stopped{false};
+    std::vector<std::thread> _threads;
+    mutable std::mutex _mutex;
+    mutable std::condition_variable _cv;
+};
+
+} // namespace starrocks::parquet
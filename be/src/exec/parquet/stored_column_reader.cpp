@@ -79,6 +79,7 @@ public:
                                             chunk_metadata, file, opts));
         RETURN_IF_ERROR(_reader->init());
         _num_values_left_in_cur_page = _reader->num_values();
+        _next_page_first_row = _num_values_left_in_cur_page;
         return Status::OK();
     }
 
@@ -93,7 +94,19 @@ public:
         }
     }
 
-    void set_needs_levels(bool needs_levels) { _needs_levels = needs_levels; }
+    void set_needs_levels(bool needs_levels) {
+        _needs_levels = needs_levels;
+        if (_needs_levels) {
+            _row_ranges = nullptr;
+        }
+    }
+
+    // The levels of the skipped pages are not read.
+    void set_row_ranges(const std::vector<RowRange>* row_ranges) override {
+        _row_ranges = _needs_levels ? nullptr : row_ranges;
+    }
+
+    Status skip_rows(size_t num_rows) override;
 
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) override {
         // _needs_levels must be true
@@ -143,11 +156,18 @@ public:
         _reader.reset(new ColumnChunkReader(_field->max_def_level(), _field->max_rep_level(), _field->type_length,
                                             chunk_metadata, file, opts));
         RETURN_IF_ERROR(_reader->init());
+        // the first page is parsed by init
+        _num_values_left_in_cur_page = _reader->num_values();
+        _next_page_first_row = _num_values_left_in_cur_page;
         return Status::OK();
     }
 
     void reset() override {}
 
+    void set_row_ranges(const std::vector<RowRange>* row_ranges) override { _row_ranges = row_ranges; }
+
+    Status skip_rows(size_t num_rows) override;
+
     Status read_records(size_t* num_rows, ColumnContentType content_type, vectorized::Column* dst) override;
 
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) {
@@ -328,6 +348,7 @@ Status OptionalStoredColumnReader::_read_records_and_levels(size_t* num_records,
                 }
             }
         }
+        DCHECK(!_page_skipped);
 
         size_t records_to_read = std::min(*num_records - records_read, _num_values_left_in_cur_page);
         {
@@ -377,6 +398,12 @@ Status OptionalStoredColumnReader::_read_records_only(size_t* num_records, Colum
         }
 
         size_t records_to_read = std::min(*num_records - records_read, _num_values_left_in_cur_page);
+        if (_page_skipped) {
+            dst->append_default(records_to_read);
+            _num_values_left_in_cur_page -= records_to_read;
+            records_read += records_to_read;
+            continue;
+        }
         size_t repeated_count = _reader->def_level_decoder().next_repeated_count();
         if (repeated_count > 0) {
             records_to_read = std::min(records_to_read, repeated_count);
@@ -431,10 +458,41 @@ Status OptionalStoredColumnReader::_read_records_only(size_t* num_records, Colum
 }
 
 Status OptionalStoredColumnReader::_next_page() {
-    do {
-        RETURN_IF_ERROR(_reader->next_page());
-        _num_values_left_in_cur_page = _reader->num_values();
-    } while (_num_values_left_in_cur_page == 0);
+    return _next_flat_page(&_num_values_left_in_cur_page);
+}
+
+Status OptionalStoredColumnReader::skip_rows(size_t num_rows) {
+    if (_needs_levels) {
+        return Status::NotSupported("skip_rows is not supported with levels");
+    }
+    while (num_rows > 0) {
+        if (_num_values_left_in_cur_page == 0) {
+            RETURN_IF_ERROR(_next_flat_page(&_num_values_left_in_cur_page, num_rows));
+        }
+        size_t rows_to_skip = std::min(num_rows, _num_values_left_in_cur_page);
+        if (!_page_skipped) {
+            // skip the values of the rows not null only
+            size_t values_to_skip = 0;
+            size_t repeated_count = _reader->def_level_decoder().next_repeated_count();
+            if (repeated_count > 0) {
+                rows_to_skip = std::min(rows_to_skip, repeated_count);
+                level_t def_level = _reader->def_level_decoder().get_repeated_value(rows_to_skip);
+                values_to_skip = def_level >= _field->max_def_level() ? rows_to_skip : 0;
+            } else {
+                if (rows_to_skip > _levels_capacity) {
+                    _levels_capacity = BitUtil::next_power_of_two(rows_to_skip);
+                    _def_levels.resize(_levels_capacity);
+                }
+                _reader->decode_def_levels(rows_to_skip, &_def_levels[0]);
+                for (size_t i = 0; i < rows_to_skip; i++) {
+                    values_to_skip += _def_levels[i] >= _field->max_def_level();
+                }
+            }
+            RETURN_IF_ERROR(_reader->skip_values(values_to_skip));
+        }
+        _num_values_left_in_cur_page -= rows_to_skip;
+        num_rows -= rows_to_skip;
+    }
     return Status::OK();
 }
 
@@ -475,7 +533,11 @@ Status RequiredStoredColumnReader::read_records(size_t* num_records, ColumnConte
             }
         }
         size_t records_to_read = std::min(*num_records - records_read, _num_values_left_in_cur_page);
-        RETURN_IF_ERROR(_reader->decode_values(records_to_read, content_type, dst));
+        if (_page_skipped) {
+            dst->append_default(records_to_read);
+        } else {
+            RETURN_IF_ERROR(_reader->decode_values(records_to_read, content_type, dst));
+        }
         records_read += records_to_read;
         _num_values_left_in_cur_page -= records_to_read;
     }
@@ -483,11 +545,40 @@ Status RequiredStoredColumnReader::read_records(size_t* num_records, ColumnConte
     return Status::OK();
 }
 
+Status RequiredStoredColumnReader::skip_rows(size_t num_rows) {
+    while (num_rows > 0) {
+        if (_num_values_left_in_cur_page == 0) {
+            RETURN_IF_ERROR(_next_flat_page(&_num_values_left_in_cur_page, num_rows));
+        }
+        size_t rows_to_skip = std::min(num_rows, _num_values_left_in_cur_page);
+        if (!_page_skipped) {
+            RETURN_IF_ERROR(_reader->skip_values(rows_to_skip));
+        }
+        _num_values_left_in_cur_page -= rows_to_skip;
+        num_rows -= rows_to_skip;
+    }
+    return Status::OK();
+}
+
 Status RequiredStoredColumnReader::_next_page() {
+    return _next_flat_page(&_num_values_left_in_cur_page);
+}
+
+Status StoredColumnReader::_next_flat_page(size_t* num_values, size_t rows_to_skip) {
     do {
-        RETURN_IF_ERROR(_reader->next_page());
-        _num_values_left_in_cur_page = _reader->num_values();
-    } while (_num_values_left_in_cur_page == 0);
+        RETURN_IF_ERROR(_reader->next_header(num_values));
+        uint64_t first_row = _next_page_first_row;
+        _next_page_first_row += *num_values;
+        bool out_of_ranges =
+                _row_ranges != nullptr && !row_ranges_overlap(*_row_ranges, first_row, _next_page_first_row);
+        _page_skipped = *num_values > 0 && (*num_values <= rows_to_skip || out_of_ranges);
+        if (_page_skipped) {
+            RETURN_IF_ERROR(_reader->skip_page());
+        } else {
+            RETURN_IF_ERROR(_reader->load_page());
+            *num_values = _reader->num_values();
+        }
+    } while (*num_values == 0);
     return Status::OK();
 }
 
@@ -10,6 +10,7 @@
 #include "exec/parquet/column_chunk_reader.h"
 #include "exec/parquet/schema.h"
 #include "exec/parquet/types.h"
+#include "exec/parquet/utils.h"
 #include "gen_cpp/parquet_types.h"
 
 namespace starrocks {
@@ -45,6 +46,15 @@ public:
     // TODO(zc): to recosiderate to move this flag to StoredColumnReaderOptions
     virtual void set_needs_levels(bool need_levels) {}
 
+    // Read only the pages with any of the |row_ranges| of the row group, the other pages are neither decompressed
+    // nor decoded, and their rows are read as default values, to be filtered out by the caller. nullptr reads all
+    // the pages. Ignored by the readers of repeated columns, whose pages do not start at the rows.
+    virtual void set_row_ranges(const std::vector<RowRange>* row_ranges) {}
+
+    // Skip the next |num_rows| rows without decoding their values, and the pages of the skipped rows only as a
+    // whole. Not supported by the readers of repeated columns.
+    virtual Status skip_rows(size_t num_rows) { return Status::NotSupported("skip_rows is not supported"); }
+
     // Try to read values that can assemble up to num_rows rows. For example if we want to read
     // an array type, and stored value is [1, 2, 3], [4], [5, 6], when the input num_rows is 3,
     // this function will fill (1, 2, 3, 4, 5, 6) into 'dst'.
@@ -65,7 +75,18 @@ public:
     }
 
 protected:
+    // Move to the next page with values, whose data is skipped if it has none of |_row_ranges| or if all its rows
+    // are in the next |rows_to_skip| ones, and set |*num_values| to its number of values. Only for the readers of
+    // flat columns, whose values are the rows.
+    Status _next_flat_page(size_t* num_values, size_t rows_to_skip = 0);
+
     std::unique_ptr<ColumnChunkReader> _reader;
+
+    const std::vector<RowRange>* _row_ranges = nullptr;
+    // the first row of the next page
+    uint64_t _next_page_first_row = 0;
+    // whether the data of the current page is skipped
+    bool _page_skipped = false;
 };
 
 } // namespace starrocks::parquet
@@ -2,6 +2,8 @@
 
 #include "exec/parquet/utils.h"
 
+#include <algorithm>
+
 namespace starrocks::parquet {
 
 CompressionTypePB convert_compression_codec(tparquet::CompressionCodec::type codec) {
@@ -20,4 +22,11 @@ CompressionTypePB convert_compression_codec(tparquet::CompressionCodec::type cod
     return UNKNOWN_COMPRESSION;
 }
 
+bool row_ranges_overlap(const std::vector<RowRange>& ranges, uint64_t begin, uint64_t end) {
+    // the first range ending after |begin|
+    auto iter = std::upper_bound(ranges.begin(), ranges.end(), begin,
+                                 [](uint64_t row, const RowRange& range) { return row < range.end; });
+    return iter != ranges.end() && iter->begin < end;
+}
+
 } // namespace starrocks::parquet
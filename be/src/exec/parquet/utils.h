@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "gen_cpp/parquet_types.h"
 #include "gen_cpp/types.pb.h"
 
@@ -11,4 +14,13 @@ CompressionTypePB convert_compression_codec(tparquet::CompressionCodec::type par
 
 enum ColumnContentType { VALUE, DICT_CODE };
 
+// The rows [begin, end) of a row group.
+struct RowRange {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+};
+
+// Whether the sorted and disjoint |ranges| have any of the rows [begin, end).
+bool row_ranges_overlap(const std::vector<RowRange>& ranges, uint64_t begin, uint64_t end);
+
 } // namespace starrocks::parquet
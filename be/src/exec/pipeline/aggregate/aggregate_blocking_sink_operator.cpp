@@ -0,0 +1,65 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status AggregateBlockingSinkOperator::prepare(RuntimeState* state) {
+    _aggregator->ref();
+    RETURN_IF_ERROR(Operator::prepare(state));
+    RETURN_IF_ERROR(_aggregator->prepare(state, state->obj_pool(), _runtime_profile.get(), _mem_tracker.get()));
+    return _aggregator->open(state);
+}
+
+Status AggregateBlockingSinkOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_aggregator->unref(state));
+    return Operator::close(state);
+}
+
+void AggregateBlockingSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+
+    if (!_aggregator->is_none_group_by_exprs()) {
+        COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+        // If hash map is empty, we don't need to return value
+        if (_aggregator->hash_map_variant().size() == 0) {
+            _aggregator->set_finished();
+        }
+        _aggregator->init_hash_map_iterator();
+    } else {
+        // for aggregate no group by, if _num_input_rows is 0,
+        // In update phase, we directly return empty chunk.
+        // In merge phase, we will handle it.
+        if (_aggregator->num_input_rows() == 0 && !_aggregator->needs_finalize()) {
+            _aggregator->set_finished();
+        }
+    }
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
+    _aggregator->set_sink_complete();
+}
+
+StatusOr<vectorized::ChunkPtr> AggregateBlockingSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from aggregate blocking sink.");
+}
+
+Status AggregateBlockingSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    DCHECK_LE(chunk->num_rows(), config::vector_chunk_size);
+    _aggregator->evaluate_exprs(chunk.get());
+
+    SCOPED_TIMER(_aggregator->agg_compute_timer());
+    if (!_aggregator->is_none_group_by_exprs()) {
+        _aggregator->build_hash_map(chunk->num_rows());
+        RETURN_IF_ERROR(_aggregator->check_hash_map_memory_usage(state));
+        _aggregator->try_convert_to_two_level_map();
+    }
+    _aggregator->compute_agg_states(chunk->num_rows());
+    _aggregator->update_num_input_rows(chunk->num_rows());
+    return Status::OK();
+}
+} // namespace starrocks::pipeline
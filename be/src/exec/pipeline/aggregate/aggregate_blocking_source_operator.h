@@ -0,0 +1,48 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/source_operator.h"
+#include "exec/vectorized/aggregator.h"
+
+namespace starrocks::pipeline {
+// AggregateBlockingSourceOperator outputs the hash table of the Aggregator
+// once the paired AggregateBlockingSinkOperator has consumed all the input.
+class AggregateBlockingSourceOperator final : public SourceOperator {
+public:
+    AggregateBlockingSourceOperator(int32_t id, int32_t plan_node_id, vectorized::AggregatorPtr aggregator)
+            : SourceOperator(id, "aggregate_blocking_source", plan_node_id), _aggregator(std::move(aggregator)) {}
+    ~AggregateBlockingSourceOperator() override = default;
+
+    bool has_output() override;
+    bool is_finished() const override;
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    // It is used to perform aggregation algorithms
+    // shared by AggregateBlockingSinkOperator
+    vectorized::AggregatorPtr _aggregator = nullptr;
+};
+
+class AggregateBlockingSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    AggregateBlockingSourceOperatorFactory(int32_t id, int32_t plan_node_id,
+                                           vectorized::AggregatorFactoryPtr aggregator_factory)
+            : SourceOperatorFactory(id, plan_node_id), _aggregator_factory(std::move(aggregator_factory)) {}
+
+    ~AggregateBlockingSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<AggregateBlockingSourceOperator>(_id, _plan_node_id,
+                                                                 _aggregator_factory->get_or_create(driver_sequence));
+    }
+
+private:
+    vectorized::AggregatorFactoryPtr _aggregator_factory = nullptr;
+};
+} // namespace starrocks::pipeline
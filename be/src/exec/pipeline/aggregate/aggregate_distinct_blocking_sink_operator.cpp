@@ -0,0 +1,64 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/aggregate/aggregate_distinct_blocking_sink_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status AggregateDistinctBlockingSinkOperator::prepare(RuntimeState* state) {
+    _aggregator->ref();
+    RETURN_IF_ERROR(Operator::prepare(state));
+    RETURN_IF_ERROR(_aggregator->prepare(state, state->obj_pool(), _runtime_profile.get(), _mem_tracker.get()));
+    return _aggregator->open(state);
+}
+
+Status AggregateDistinctBlockingSinkOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_aggregator->unref(state));
+    return Operator::close(state);
+}
+
+void AggregateDistinctBlockingSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+
+    COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_set_variant().size());
+    // If hash set is empty, we don't need to return value
+    if (_aggregator->hash_set_variant().size() == 0) {
+        _aggregator->set_finished();
+    }
+    _aggregator->init_hash_set_iterator();
+
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
+    _aggregator->set_sink_complete();
+}
+
+StatusOr<vectorized::ChunkPtr> AggregateDistinctBlockingSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from aggregate distinct blocking sink.");
+}
+
+Status AggregateDistinctBlockingSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    DCHECK_LE(chunk->num_rows(), config::vector_chunk_size);
+    _aggregator->evaluate_exprs(chunk.get());
+
+    {
+        SCOPED_TIMER(_aggregator->agg_compute_timer());
+        bool limit_with_no_agg = _aggregator->limit() != -1;
+        _aggregator->build_hash_set(chunk->num_rows());
+        _aggregator->update_num_input_rows(chunk->num_rows());
+        if (limit_with_no_agg) {
+            auto size = _aggregator->hash_set_variant().size();
+            if (size >= _aggregator->limit()) {
+                // Enough distinct keys have been collected, the rest of the input is unnecessary
+                finish(state);
+                return Status::OK();
+            }
+        }
+        RETURN_IF_ERROR(_aggregator->check_hash_set_memory_usage(state));
+    }
+    return Status::OK();
+}
+} // namespace starrocks::pipeline
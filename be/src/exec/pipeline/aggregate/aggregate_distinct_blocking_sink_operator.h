@@ -0,0 +1,56 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/aggregator.h"
+
+namespace starrocks::pipeline {
+// AggregateDistinctBlockingSinkOperator consumes all the input into the hash set of the Aggregator,
+// after that the paired AggregateDistinctBlockingSourceOperator outputs the distinct keys.
+class AggregateDistinctBlockingSinkOperator final : public Operator {
+public:
+    AggregateDistinctBlockingSinkOperator(int32_t id, int32_t plan_node_id, vectorized::AggregatorPtr aggregator)
+            : Operator(id, "aggregate_distinct_blocking_sink", plan_node_id), _aggregator(std::move(aggregator)) {}
+    ~AggregateDistinctBlockingSinkOperator() override = default;
+
+    bool has_output() override { return false; }
+    bool need_input() override { return !is_finished(); }
+    bool is_finished() const override { return _is_finished; }
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    // It is used to perform aggregation algorithms
+    // shared by AggregateDistinctBlockingSourceOperator
+    vectorized::AggregatorPtr _aggregator = nullptr;
+    // Whether prev operator has no output
+    bool _is_finished = false;
+};
+
+class AggregateDistinctBlockingSinkOperatorFactory final : public OperatorFactory {
+public:
+    AggregateDistinctBlockingSinkOperatorFactory(int32_t id, int32_t plan_node_id, vectorized::AggrPhase aggr_phase,
+                                                 vectorized::AggregatorFactoryPtr aggregator_factory)
+            : OperatorFactory(id, plan_node_id),
+              _aggr_phase(aggr_phase),
+              _aggregator_factory(std::move(aggregator_factory)) {}
+
+    ~AggregateDistinctBlockingSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        auto aggregator = _aggregator_factory->get_or_create(driver_sequence);
+        aggregator->set_aggr_phase(_aggr_phase);
+        return std::make_shared<AggregateDistinctBlockingSinkOperator>(_id, _plan_node_id, std::move(aggregator));
+    }
+
+private:
+    const vectorized::AggrPhase _aggr_phase;
+    vectorized::AggregatorFactoryPtr _aggregator_factory = nullptr;
+};
+} // namespace starrocks::pipeline
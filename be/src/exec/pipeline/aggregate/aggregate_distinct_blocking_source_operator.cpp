@@ -0,0 +1,50 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/aggregate/aggregate_distinct_blocking_source_operator.h"
+
+#include "column/chunk.h"
+#include "exec/exec_node.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status AggregateDistinctBlockingSourceOperator::prepare(RuntimeState* state) {
+    _aggregator->ref();
+    return SourceOperator::prepare(state);
+}
+
+Status AggregateDistinctBlockingSourceOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_aggregator->unref(state));
+    return SourceOperator::close(state);
+}
+
+bool AggregateDistinctBlockingSourceOperator::has_output() {
+    return _aggregator->is_sink_complete() && !_aggregator->is_finished();
+}
+
+bool AggregateDistinctBlockingSourceOperator::is_finished() const {
+    return _aggregator->is_sink_complete() && _aggregator->is_finished();
+}
+
+void AggregateDistinctBlockingSourceOperator::finish(RuntimeState* state) {
+    _aggregator->set_finished();
+}
+
+StatusOr<vectorized::ChunkPtr> AggregateDistinctBlockingSourceOperator::pull_chunk(RuntimeState* state) {
+    RETURN_IF_CANCELLED(state);
+
+    int32_t chunk_size = config::vector_chunk_size;
+    vectorized::ChunkPtr chunk = std::make_shared<vectorized::Chunk>();
+    _aggregator->convert_hash_set_to_chunk(chunk_size, &chunk);
+
+    // For having
+    size_t old_size = chunk->num_rows();
+    ExecNode::eval_conjuncts(_aggregator->conjunct_ctxs(), chunk.get());
+    _aggregator->update_num_rows_returned(-(old_size - chunk->num_rows()));
+
+    _aggregator->process_limit(&chunk);
+
+    DCHECK_CHUNK(chunk);
+    return std::move(chunk);
+}
+} // namespace starrocks::pipeline
@@ -0,0 +1,49 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/source_operator.h"
+#include "exec/vectorized/aggregator.h"
+
+namespace starrocks::pipeline {
+// AggregateDistinctBlockingSourceOperator outputs the hash set of the Aggregator
+// once the paired AggregateDistinctBlockingSinkOperator has consumed all the input.
+class AggregateDistinctBlockingSourceOperator final : public SourceOperator {
+public:
+    AggregateDistinctBlockingSourceOperator(int32_t id, int32_t plan_node_id, vectorized::AggregatorPtr aggregator)
+            : SourceOperator(id, "aggregate_distinct_blocking_source", plan_node_id),
+              _aggregator(std::move(aggregator)) {}
+    ~AggregateDistinctBlockingSourceOperator() override = default;
+
+    bool has_output() override;
+    bool is_finished() const override;
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    // It is used to perform aggregation algorithms
+    // shared by AggregateDistinctBlockingSinkOperator
+    vectorized::AggregatorPtr _aggregator = nullptr;
+};
+
+class AggregateDistinctBlockingSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    AggregateDistinctBlockingSourceOperatorFactory(int32_t id, int32_t plan_node_id,
+                                                   vectorized::AggregatorFactoryPtr aggregator_factory)
+            : SourceOperatorFactory(id, plan_node_id), _aggregator_factory(std::move(aggregator_factory)) {}
+
+    ~AggregateDistinctBlockingSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<AggregateDistinctBlockingSourceOperator>(
+                _id, _plan_node_id, _aggregator_factory->get_or_create(driver_sequence));
+    }
+
+private:
+    vectorized::AggregatorFactoryPtr _aggregator_factory = nullptr;
+};
+} // namespace starrocks::pipeline
@@ -0,0 +1,58 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/aggregate/aggregate_distinct_streaming_source_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status AggregateDistinctStreamingSourceOperator::prepare(RuntimeState* state) {
+    _aggregator->ref();
+    return SourceOperator::prepare(state);
+}
+
+Status AggregateDistinctStreamingSourceOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_aggregator->unref(state));
+    return SourceOperator::close(state);
+}
+
+bool AggregateDistinctStreamingSourceOperator::has_output() {
+    if (!_aggregator->is_chunk_buffer_empty()) {
+        // There are some partial aggregated chunks in the buffer
+        return true;
+    }
+    // The hash set is output only after the sink operator has consumed all the input
+    return _aggregator->is_sink_complete() && !_aggregator->is_ht_eos();
+}
+
+bool AggregateDistinctStreamingSourceOperator::is_finished() const {
+    // The sink operator never offers chunks after it is complete,
+    // so the buffer is checked after the sink state.
+    return _aggregator->is_sink_complete() && _aggregator->is_chunk_buffer_empty() && _aggregator->is_ht_eos();
+}
+
+void AggregateDistinctStreamingSourceOperator::finish(RuntimeState* state) {
+    _aggregator->set_ht_eos();
+}
+
+StatusOr<vectorized::ChunkPtr> AggregateDistinctStreamingSourceOperator::pull_chunk(RuntimeState* state) {
+    // It is no need to distinguish whether the sink is complete here,
+    // the chunks in the buffer are always output firstly.
+    if (!_aggregator->is_chunk_buffer_empty()) {
+        return _aggregator->poll_chunk_buffer();
+    }
+
+    vectorized::ChunkPtr chunk = std::make_shared<vectorized::Chunk>();
+    _output_chunk_from_hash_set(&chunk);
+    // The limit is applied by the LimitOperator following this operator, because the number of
+    // rows returned is also updated by the sink operator when the input is passed through.
+    DCHECK_CHUNK(chunk);
+    return std::move(chunk);
+}
+
+void AggregateDistinctStreamingSourceOperator::_output_chunk_from_hash_set(vectorized::ChunkPtr* chunk) {
+    DCHECK(_aggregator->it_hash().has_value());
+    _aggregator->convert_hash_set_to_chunk(config::vector_chunk_size, chunk);
+}
+} // namespace starrocks::pipeline
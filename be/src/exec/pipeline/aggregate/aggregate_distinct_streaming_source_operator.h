@@ -0,0 +1,51 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/source_operator.h"
+#include "exec/vectorized/aggregator.h"
+
+namespace starrocks::pipeline {
+// AggregateDistinctStreamingSourceOperator outputs the chunks passed through by the paired
+// AggregateDistinctStreamingSinkOperator, and the hash set after the sink operator has consumed all the input.
+class AggregateDistinctStreamingSourceOperator final : public SourceOperator {
+public:
+    AggregateDistinctStreamingSourceOperator(int32_t id, int32_t plan_node_id, vectorized::AggregatorPtr aggregator)
+            : SourceOperator(id, "aggregate_distinct_streaming_source", plan_node_id),
+              _aggregator(std::move(aggregator)) {}
+    ~AggregateDistinctStreamingSourceOperator() override = default;
+
+    bool has_output() override;
+    bool is_finished() const override;
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    void _output_chunk_from_hash_set(vectorized::ChunkPtr* chunk);
+
+    // It is used to perform aggregation algorithms
+    // shared by AggregateDistinctStreamingSinkOperator
+    vectorized::AggregatorPtr _aggregator = nullptr;
+};
+
+class AggregateDistinctStreamingSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    AggregateDistinctStreamingSourceOperatorFactory(int32_t id, int32_t plan_node_id,
+                                                    vectorized::AggregatorFactoryPtr aggregator_factory)
+            : SourceOperatorFactory(id, plan_node_id), _aggregator_factory(std::move(aggregator_factory)) {}
+
+    ~AggregateDistinctStreamingSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<AggregateDistinctStreamingSourceOperator>(
+                _id, _plan_node_id, _aggregator_factory->get_or_create(driver_sequence));
+    }
+
+private:
+    vectorized::AggregatorFactoryPtr _aggregator_factory = nullptr;
+};
+} // namespace starrocks::pipeline
@@ -0,0 +1,65 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/aggregator.h"
+
+namespace starrocks::pipeline {
+// AggregateStreamingSinkOperator performs the streaming pre-aggregation, the chunks that are
+// passed through are buffered in the Aggregator and pulled by the paired AggregateStreamingSourceOperator,
+// which also outputs the hash table after all the input has been consumed.
+class AggregateStreamingSinkOperator final : public Operator {
+public:
+    AggregateStreamingSinkOperator(int32_t id, int32_t plan_node_id, vectorized::AggregatorPtr aggregator)
+            : Operator(id, "aggregate_streaming_sink", plan_node_id), _aggregator(std::move(aggregator)) {}
+    ~AggregateStreamingSinkOperator() override = default;
+
+    bool has_output() override { return false; }
+    bool need_input() override { return !is_finished() && !_aggregator->is_chunk_buffer_full(); }
+    bool is_finished() const override { return _is_finished; }
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    // Invoked by push_chunk according to the streaming preaggregation mode
+    Status _push_chunk_by_force_streaming();
+    Status _push_chunk_by_force_preaggregation(size_t chunk_size);
+    Status _push_chunk_by_auto(size_t chunk_size);
+    Status _push_chunk_by_adaptive(size_t chunk_size);
+    // The input of every driver is sorted, see Aggregator::build_sorted_agg_states.
+    Status _push_chunk_by_sorted_groups(size_t chunk_size);
+
+    // It is used to perform aggregation algorithms
+    // shared by AggregateStreamingSourceOperator
+    vectorized::AggregatorPtr _aggregator = nullptr;
+    // Whether prev operator has no output
+    bool _is_finished = false;
+};
+
+class AggregateStreamingSinkOperatorFactory final : public OperatorFactory {
+public:
+    AggregateStreamingSinkOperatorFactory(int32_t id, int32_t plan_node_id, vectorized::AggrPhase aggr_phase,
+                                          vectorized::AggregatorFactoryPtr aggregator_factory)
+            : OperatorFactory(id, plan_node_id),
+              _aggr_phase(aggr_phase),
+              _aggregator_factory(std::move(aggregator_factory)) {}
+
+    ~AggregateStreamingSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        auto aggregator = _aggregator_factory->get_or_create(driver_sequence);
+        aggregator->set_aggr_phase(_aggr_phase);
+        return std::make_shared<AggregateStreamingSinkOperator>(_id, _plan_node_id, std::move(aggregator));
+    }
+
+private:
+    const vectorized::AggrPhase _aggr_phase;
+    vectorized::AggregatorFactoryPtr _aggregator_factory = nullptr;
+};
+} // namespace starrocks::pipeline
@@ -0,0 +1,57 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/analysis/analytic_sink_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status AnalyticSinkOperator::prepare(RuntimeState* state) {
+    _analytor->ref();
+    RETURN_IF_ERROR(Operator::prepare(state));
+    RETURN_IF_ERROR(_analytor->prepare(state, state->obj_pool(), _runtime_profile.get(), _mem_tracker.get()));
+    return _analytor->open(state);
+}
+
+Status AnalyticSinkOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_analytor->unref(state));
+    return Operator::close(state);
+}
+
+void AnalyticSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+
+    // The last partition can't be computed by the sink operator without the input eos,
+    // it's computed by the source operator so that the errors are returned from pull_chunk.
+    _analytor->set_input_eos();
+    _analytor->set_sink_complete();
+}
+
+StatusOr<vectorized::ChunkPtr> AnalyticSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from analytic sink.");
+}
+
+Status AnalyticSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    if (chunk->is_empty()) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_analytor->add_chunk(chunk));
+
+    // Compute the partitions whose ends have been found, so that the source operator
+    // could output them without waiting for all the input.
+    while (true) {
+        vectorized::ChunkPtr output_chunk;
+        bool eos = false;
+        RETURN_IF_ERROR(_analytor->get_next(state, &output_chunk, &eos));
+        if (eos || output_chunk == nullptr) {
+            break;
+        }
+        _analytor->offer_chunk_to_buffer(output_chunk);
+    }
+    return Status::OK();
+}
+} // namespace starrocks::pipeline
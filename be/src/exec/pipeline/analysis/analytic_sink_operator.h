@@ -0,0 +1,53 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/analytor.h"
+
+namespace starrocks::pipeline {
+// AnalyticSinkOperator adds the input to the Analytor and offers the chunks whose window function
+// results can be computed to the buffer of the Analytor, which are pulled by the paired
+// AnalyticSourceOperator. The rest results are computed by the source operator after all the
+// input has been added.
+class AnalyticSinkOperator final : public Operator {
+public:
+    AnalyticSinkOperator(int32_t id, int32_t plan_node_id, vectorized::AnalytorPtr analytor)
+            : Operator(id, "analytic_sink", plan_node_id), _analytor(std::move(analytor)) {}
+    ~AnalyticSinkOperator() override = default;
+
+    bool has_output() override { return false; }
+    bool need_input() override { return !is_finished() && !_analytor->is_chunk_buffer_full(); }
+    bool is_finished() const override { return _is_finished; }
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    // It is used to perform analytic algorithms
+    // shared by AnalyticSourceOperator
+    vectorized::AnalytorPtr _analytor = nullptr;
+    // Whether prev operator has no output
+    bool _is_finished = false;
+};
+
+class AnalyticSinkOperatorFactory final : public OperatorFactory {
+public:
+    AnalyticSinkOperatorFactory(int32_t id, int32_t plan_node_id, vectorized::AnalytorFactoryPtr analytor_factory)
+            : OperatorFactory(id, plan_node_id), _analytor_factory(std::move(analytor_factory)) {}
+
+    ~AnalyticSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<AnalyticSinkOperator>(_id, _plan_node_id,
+                                                      _analytor_factory->get_or_create(driver_sequence));
+    }
+
+private:
+    vectorized::AnalytorFactoryPtr _analytor_factory = nullptr;
+};
+} // namespace starrocks::pipeline
@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/analysis/analytic_source_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status AnalyticSourceOperator::prepare(RuntimeState* state) {
+    _analytor->ref();
+    return SourceOperator::prepare(state);
+}
+
+Status AnalyticSourceOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_analytor->unref(state));
+    return SourceOperator::close(state);
+}
+
+bool AnalyticSourceOperator::has_output() {
+    if (!_analytor->is_chunk_buffer_empty()) {
+        return true;
+    }
+    // The rest results are computed only after the sink operator has added all the input
+    return _analytor->is_sink_complete() && !_analytor->is_output_eos();
+}
+
+bool AnalyticSourceOperator::is_finished() const {
+    // The sink operator never offers chunks after it is complete,
+    // so the buffer is checked after the sink state.
+    return _analytor->is_sink_complete() && _analytor->is_chunk_buffer_empty() && _analytor->is_output_eos();
+}
+
+void AnalyticSourceOperator::finish(RuntimeState* state) {
+    _analytor->set_output_eos();
+}
+
+StatusOr<vectorized::ChunkPtr> AnalyticSourceOperator::pull_chunk(RuntimeState* state) {
+    if (!_analytor->is_chunk_buffer_empty()) {
+        return _analytor->poll_chunk_buffer();
+    }
+
+    vectorized::ChunkPtr chunk;
+    bool eos = false;
+    RETURN_IF_ERROR(_analytor->get_next(state, &chunk, &eos));
+    // All the input has been added, so no more input is needed to compute the results.
+    DCHECK(eos || chunk != nullptr);
+    if (eos || chunk == nullptr) {
+        _analytor->set_output_eos();
+        return std::make_shared<vectorized::Chunk>();
+    }
+    return std::move(chunk);
+}
+} // namespace starrocks::pipeline
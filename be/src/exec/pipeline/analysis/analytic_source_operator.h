@@ -0,0 +1,47 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/source_operator.h"
+#include "exec/vectorized/analytor.h"
+
+namespace starrocks::pipeline {
+// AnalyticSourceOperator outputs the chunks computed by the paired AnalyticSinkOperator,
+// and computes the rest results after the sink operator has added all the input.
+class AnalyticSourceOperator final : public SourceOperator {
+public:
+    AnalyticSourceOperator(int32_t id, int32_t plan_node_id, vectorized::AnalytorPtr analytor)
+            : SourceOperator(id, "analytic_source", plan_node_id), _analytor(std::move(analytor)) {}
+    ~AnalyticSourceOperator() override = default;
+
+    bool has_output() override;
+    bool is_finished() const override;
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    // It is used to perform analytic algorithms
+    // shared by AnalyticSinkOperator
+    vectorized::AnalytorPtr _analytor = nullptr;
+};
+
+class AnalyticSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    AnalyticSourceOperatorFactory(int32_t id, int32_t plan_node_id, vectorized::AnalytorFactoryPtr analytor_factory)
+            : SourceOperatorFactory(id, plan_node_id), _analytor_factory(std::move(analytor_factory)) {}
+
+    ~AnalyticSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<AnalyticSourceOperator>(_id, _plan_node_id,
+                                                        _analytor_factory->get_or_create(driver_sequence));
+    }
+
+private:
+    vectorized::AnalytorFactoryPtr _analytor_factory = nullptr;
+};
+} // namespace starrocks::pipeline
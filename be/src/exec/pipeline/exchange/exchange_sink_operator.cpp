@@ -23,11 +23,13 @@
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "runtime/tuple_row.h"
+#include "service/backend_options.h"
 #include "service/brpc.h"
 #include "util/block_compression.h"
 #include "util/compression_utils.h"
 #include "util/debug_util.h"
 #include "util/network_util.h"
+#include "util/time.h"
 #include "util/thrift_client.h"
 #include "util/thrift_util.h"
 
@@ -77,9 +79,15 @@ public:
 
     TUniqueId get_fragment_instance_id() { return _fragment_instance_id; }
 
+    // Whether the chunks are passed to the receiver on this backend in process, instead of by the rpcs.
+    bool use_local_passthrough() const { return _use_local_passthrough; }
+
 private:
     Status _close_internal();
 
+    // Pass |chunk| to the receiver on this backend through the SinkBuffer, without serializing it.
+    Status _send_local_chunk(vectorized::ChunkUniquePtr chunk, bool eos);
+
     ExchangeSinkOperator* _parent;
 
     TUniqueId _fragment_instance_id;
@@ -93,8 +101,14 @@ private:
     PUniqueId _finst_id;
 
     PBackendService_Stub* _brpc_stub = nullptr;
+    bool _use_local_passthrough = false;
 
+    // The chunks batched to be sent in one request, and their data
+    PTransmitChunkParams _chunk_request;
+    butil::IOBuf _chunk_attachment;
     size_t _current_request_bytes = 0;
+    // When the first of the batched chunks was batched, 0 if none is batched
+    int64_t _batch_start_ms = 0;
 
     bool _is_inited = false;
 };
@@ -113,6 +127,9 @@ Status ExchangeSinkOperator::Channel::init(RuntimeState* state) {
     // initialize brpc request
     _finst_id.set_hi(_fragment_instance_id.hi);
     _finst_id.set_lo(_fragment_instance_id.lo);
+    _use_local_passthrough = config::exchange_local_passthrough && _fragment_instance_id.lo != -1 &&
+                             _brpc_dest_addr.hostname == BackendOptions::get_localhost() &&
+                             _brpc_dest_addr.port == config::brpc_port;
 
     // _brpc_timeout_ms = std::min(3600, state->query_options().query_timeout) * 1000;
     // For bucket shuffle, the dest is unreachable, there is no need to establish a connection
@@ -133,9 +150,15 @@ Status ExchangeSinkOperator::Channel::add_rows_selective(vectorized::Chunk* chun
     }
 
     if (_chunk->num_rows() + size > config::vector_chunk_size) {
-        RETURN_IF_ERROR(send_one_chunk(_chunk.get(), false));
-        // we only clear column data, because we need to reuse column schema
-        _chunk->set_num_rows(0);
+        if (_use_local_passthrough) {
+            // The receiver takes the chunk as is.
+            RETURN_IF_ERROR(_send_local_chunk(std::move(_chunk), false));
+            _chunk = chunk->clone_empty_with_tuple();
+        } else {
+            RETURN_IF_ERROR(send_one_chunk(_chunk.get(), false));
+            // we only clear column data, because we need to reuse column schema
+            _chunk->set_num_rows(0);
+        }
     }
 
     _chunk->append_selective(*chunk, indexes, from, size);
@@ -143,33 +166,53 @@ Status ExchangeSinkOperator::Channel::add_rows_selective(vectorized::Chunk* chun
 }
 
 Status ExchangeSinkOperator::Channel::send_one_chunk(const vectorized::Chunk* chunk, bool eos) {
-    PTransmitChunkParams request;
-    request.set_allocated_finst_id(&_finst_id);
-    request.set_node_id(_dest_node_id);
-    request.set_sender_id(_parent->_sender_id);
-    request.set_be_number(_parent->_be_number);
-
+    if (_use_local_passthrough) {
+        vectorized::ChunkUniquePtr copy;
+        if (chunk != nullptr) {
+            copy = chunk->clone_empty_with_tuple(chunk->num_rows());
+            copy->append(*chunk);
+        }
+        return _send_local_chunk(std::move(copy), eos);
+    }
     // If chunk is not null, append it to request
     if (chunk != nullptr) {
-        auto pchunk = request.add_chunks();
-        RETURN_IF_ERROR(_parent->serialize_chunk(chunk, pchunk, &_is_first_chunk));
-        _current_request_bytes += pchunk->data().size();
+        auto pchunk = _chunk_request.add_chunks();
+        RETURN_IF_ERROR(_parent->serialize_chunk(chunk, pchunk, &_is_first_chunk, &_chunk_attachment));
+        _current_request_bytes += pchunk->data_size();
     }
 
-    // Try to accumulate enough bytes before sending a RPC. When eos is true we should send
+    // Try to accumulate enough bytes, or wait long enough, before sending a RPC. When eos is true we should send
     // last packet
-    if (_current_request_bytes > _parent->_request_bytes_threshold || eos) {
-        request.set_eos(eos);
-        TransmitChunkInfo info = {std::move(request), _brpc_stub};
-        _parent->_buffer->add_request(info);
+    if (_parent->_is_batch_full(_current_request_bytes, &_batch_start_ms) || eos) {
+        *_chunk_request.mutable_finst_id() = _finst_id;
+        _chunk_request.set_node_id(_dest_node_id);
+        _chunk_request.set_sender_id(_parent->_sender_id);
+        _chunk_request.set_be_number(_parent->_be_number);
+        _chunk_request.set_eos(eos);
+        TransmitChunkInfo info = {std::move(_chunk_request), _brpc_stub, std::move(_chunk_attachment)};
+        _parent->_buffer->add_request(std::move(info));
+        _chunk_request.Clear();
+        _chunk_attachment.clear();
         _current_request_bytes = 0;
-        // The original design is bad, we must release_finst_id here!
-        info.params.release_finst_id();
+        _batch_start_ms = 0;
     }
 
     return Status::OK();
 }
 
+Status ExchangeSinkOperator::Channel::_send_local_chunk(vectorized::ChunkUniquePtr chunk, bool eos) {
+    TransmitChunkInfo info;
+    *info.params.mutable_finst_id() = _finst_id;
+    info.params.set_node_id(_dest_node_id);
+    info.params.set_sender_id(_parent->_sender_id);
+    info.params.set_be_number(_parent->_be_number);
+    info.params.set_eos(eos);
+    info.is_local = true;
+    info.local_chunk = std::move(chunk);
+    _parent->_buffer->add_request(std::move(info));
+    return Status::OK();
+}
+
 Status ExchangeSinkOperator::Channel::send_chunk_request(PTransmitChunkParams* params, const butil::IOBuf& attachment) {
     params->set_allocated_finst_id(&_finst_id);
     params->set_node_id(_dest_node_id);
@@ -177,16 +220,24 @@ Status ExchangeSinkOperator::Channel::send_chunk_request(PTransmitChunkParams* p
     params->set_be_number(_parent->_be_number);
 
     params->set_eos(false);
-    TransmitChunkInfo info = {std::move(*params), _brpc_stub};
-    _parent->_buffer->add_request(info);
-
-    // The original design is bad, we must release_finst_id here!
-    info.params.release_finst_id();
+    // The request is sent to all the channels, each of which has its own copy of the chunk metas and shares the
+    // blocks of the attachment.
+    TransmitChunkInfo info = {*params, _brpc_stub, attachment};
+    params->release_finst_id();
+    _parent->_buffer->add_request(std::move(info));
 
     return Status::OK();
 }
 
 Status ExchangeSinkOperator::Channel::_close_internal() {
+    if (_chunk != nullptr && _chunk->num_rows() > 0) {
+        if (_use_local_passthrough) {
+            return _send_local_chunk(std::move(_chunk), true);
+        }
+        RETURN_IF_ERROR(send_one_chunk(_chunk.get(), true));
+        _chunk->set_num_rows(0);
+        return Status::OK();
+    }
     RETURN_IF_ERROR(send_one_chunk(nullptr, true));
     return Status::OK();
 }
@@ -213,6 +264,7 @@ ExchangeSinkOperator::ExchangeSinkOperator(int32_t id, int32_t plan_node_id, con
         if (fragment_id_to_channel_index.find(fragment_instance_id.lo) == fragment_id_to_channel_index.end()) {
             _channels.emplace_back(new Channel(this, destinations[i].brpc_server, fragment_instance_id, dest_node_id));
             fragment_id_to_channel_index.insert({fragment_instance_id.lo, _channels.size() - 1});
+            _buffer->add_sinker(fragment_instance_id);
         } else {
             _channels.emplace_back(_channels[fragment_id_to_channel_index[fragment_instance_id.lo]]);
         }
@@ -221,6 +273,7 @@ ExchangeSinkOperator::ExchangeSinkOperator(int32_t id, int32_t plan_node_id, con
 
 Status ExchangeSinkOperator::prepare(RuntimeState* state) {
     _be_number = state->be_number();
+    _request_bytes_threshold = config::max_transmit_batched_bytes;
 
     // Set compression type according to query options
     if (state->query_options().__isset.transmission_compression_type) {
@@ -275,11 +328,14 @@ Status ExchangeSinkOperator::prepare(RuntimeState* state) {
     for (int i = 0; i < _channels.size(); ++i) {
         RETURN_IF_ERROR(_channels[i]->init(state));
     }
+    _num_remote_channels = std::count_if(_channels.begin(), _channels.end(),
+                                         [](const auto& channel) { return !channel->use_local_passthrough(); });
 
     // set eos for all channels.
     // It will be set to true when closing.
     _chunk_request.set_eos(false);
     _row_indexes.resize(config::vector_chunk_size);
+    _buffer->add_driver_notifier(_driver_notifier);
 
     return Status::OK();
 }
@@ -362,21 +418,33 @@ Status ExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::C
             RETURN_IF_ERROR(_channels[i]->add_rows_selective(chunk.get(), _row_indexes.data(), from, size));
         }
     } else if (_part_type == TPartitionType::UNPARTITIONED || _channels.size() == 1) {
+        // The channels on this backend take their copies of the chunk in process.
+        for (auto& channel : _channels) {
+            if (channel->use_local_passthrough()) {
+                RETURN_IF_ERROR(channel->send_one_chunk(chunk.get(), false));
+            }
+        }
+        if (_num_remote_channels == 0) {
+            return Status::OK();
+        }
         // We use sender request to avoid serialize chunk many times.
         // 1. create a new chunk PB to serialize
         ChunkPB* pchunk = _chunk_request.add_chunks();
         // 2. serialize input chunk to pchunk
-        RETURN_IF_ERROR(serialize_chunk(chunk.get(), pchunk, &_is_first_chunk, _channels.size()));
-        _current_request_bytes += pchunk->data().size();
-        // 3. if request bytes exceede the threshold, send current request
-        if (_current_request_bytes > _request_bytes_threshold) {
-            butil::IOBuf attachment;
-            // construct_brpc_attachment(&_chunk_request, &attachment);
+        RETURN_IF_ERROR(serialize_chunk(chunk.get(), pchunk, &_is_first_chunk, &_chunk_request_attachment,
+                                        _num_remote_channels));
+        _current_request_bytes += pchunk->data_size();
+        // 3. if request bytes exceede the threshold or the chunks have waited too long, send current request
+        if (_is_batch_full(_current_request_bytes, &_batch_start_ms)) {
             for (auto channel : _channels) {
-                RETURN_IF_ERROR(channel->send_chunk_request(&_chunk_request, attachment));
+                if (!channel->use_local_passthrough()) {
+                    RETURN_IF_ERROR(channel->send_chunk_request(&_chunk_request, _chunk_request_attachment));
+                }
             }
             _current_request_bytes = 0;
+            _batch_start_ms = 0;
             _chunk_request.clear_chunks();
+            _chunk_request_attachment.clear();
         }
     }
     return Status::OK();
@@ -388,11 +456,37 @@ void ExchangeSinkOperator::finish(RuntimeState* state) {
     }
 
     _is_finished = true;
+    // If broadcast is used, _chunk_request may contain some chunks which should be sent before the eos.
+    if (_current_request_bytes > 0) {
+        for (auto channel : _channels) {
+            if (!channel->use_local_passthrough()) {
+                state->log_error(
+                        channel->send_chunk_request(&_chunk_request, _chunk_request_attachment).get_error_msg());
+            }
+        }
+        _current_request_bytes = 0;
+        _chunk_request.clear_chunks();
+        _chunk_request_attachment.clear();
+    }
     for (int i = 0; i < _channels.size(); ++i) {
         _channels[i]->close(state);
     }
 }
 
+bool ExchangeSinkOperator::_is_batch_full(size_t request_bytes, int64_t* batch_start_ms) const {
+    if (request_bytes > _request_bytes_threshold) {
+        return true;
+    }
+    if (request_bytes == 0 || config::max_transmit_batched_wait_ms <= 0) {
+        return false;
+    }
+    int64_t now = MonotonicMillis();
+    if (*batch_start_ms == 0) {
+        *batch_start_ms = now;
+    }
+    return now - *batch_start_ms >= config::max_transmit_batched_wait_ms;
+}
+
 Status ExchangeSinkOperator::close(RuntimeState* state) {
     ScopedTimer<MonotonicStopWatch> close_timer(_profile != nullptr ? _profile->total_time_counter() : nullptr);
     Expr::close(_partition_expr_ctxs, state);
@@ -401,24 +495,33 @@ Status ExchangeSinkOperator::close(RuntimeState* state) {
 }
 
 Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, ChunkPB* dst, bool* is_first_chunk,
-                                             int num_receivers) {
+                                             butil::IOBuf* attachment, int num_receivers) {
     VLOG_ROW << "serializing " << src->num_rows() << " rows";
+
+    // The chunk data is serialized into a buffer of its own, which is handed over to |attachment|,
+    // instead of being serialized into ChunkPB and then copied into the attachment.
     size_t uncompressed_size = 0;
+    std::unique_ptr<uint8_t[]> data;
     {
         SCOPED_TIMER(_serialize_batch_timer);
         dst->set_compress_type(CompressionTypePB::NO_COMPRESSION);
+        dst->clear_data();
         // We only serialize chunk meta for first chunk
         if (*is_first_chunk) {
-            uncompressed_size = src->serialize_with_meta(dst);
+            src->serialize_meta(dst);
             *is_first_chunk = false;
         } else {
             dst->clear_is_nulls();
             dst->clear_is_consts();
             dst->clear_slot_id_map();
+        }
+        if (config::exchange_encode_chunk) {
+            data.reset(new uint8_t[src->max_serialize_encoded_size()]);
+            uncompressed_size = src->serialize_encoded(data.get());
+        } else {
             uncompressed_size = src->serialize_size();
-            // TODO(kks): resize without initializing the new bytes
-            dst->mutable_data()->resize(uncompressed_size);
-            src->serialize((uint8_t*)dst->mutable_data()->data());
+            data.reset(new uint8_t[uncompressed_size]);
+            src->serialize(data.get());
         }
     }
 
@@ -428,47 +531,38 @@ Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, Chunk
     }
 
     dst->set_uncompressed_size(uncompressed_size);
-    // try compress the ChunkPB data
+    size_t data_size = uncompressed_size;
+    // try compress the chunk data
     if (_compress_codec != nullptr && uncompressed_size > 0) {
         SCOPED_TIMER(_compress_timer);
 
-        // Try compressing data to _compression_scratch, swap if compressed data is smaller
-        int max_compressed_size = _compress_codec->max_compressed_len(uncompressed_size);
-
-        if (_compression_scratch.size() < max_compressed_size) {
-            _compression_scratch.resize(max_compressed_size);
-        }
-
-        Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
-        _compress_codec->compress(dst->data(), &compressed_slice);
+        // Try compressing data into another buffer, which is sent if the compressed data is small enough
+        size_t max_compressed_size = _compress_codec->max_compressed_len(uncompressed_size);
+        std::unique_ptr<uint8_t[]> compressed_data(new uint8_t[max_compressed_size]);
+        Slice compressed_slice{compressed_data.get(), max_compressed_size};
+        RETURN_IF_ERROR(_compress_codec->compress(Slice(data.get(), uncompressed_size), &compressed_slice));
         double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
         if (LIKELY(compress_ratio > config::rpc_compress_ratio_threshold)) {
-            _compression_scratch.resize(compressed_slice.size);
-            dst->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
+            data = std::move(compressed_data);
+            data_size = compressed_slice.size;
             dst->set_compress_type(_compress_type);
         }
 
         VLOG_ROW << "uncompressed size: " << uncompressed_size << ", compressed size: " << compressed_slice.size;
     }
-    size_t chunk_size = dst->data().size();
-    VLOG_ROW << "chunk data size " << chunk_size;
+    dst->set_data_size(data_size);
+    if (data_size > 0) {
+        attachment->append_user_data(data.release(), data_size,
+                                     [](void* buf) { delete[] static_cast<uint8_t*>(buf); });
+    }
+    VLOG_ROW << "chunk data size " << data_size;
 
-    COUNTER_UPDATE(_bytes_sent_counter, chunk_size * num_receivers);
+    COUNTER_UPDATE(_bytes_sent_counter, data_size * num_receivers);
     COUNTER_UPDATE(_uncompressed_bytes_counter, uncompressed_size * num_receivers);
     return Status::OK();
 }
 
-void ExchangeSinkOperator::construct_brpc_attachment(PTransmitChunkParams* params, butil::IOBuf* attachment) {
-    for (int i = 0; i < params->chunks().size(); ++i) {
-        auto chunk = params->mutable_chunks(i);
-        chunk->set_data_size(chunk->data().size());
-        attachment->append(chunk->data());
-        chunk->clear_data();
-    }
-}
-
 OperatorPtr ExchangeSinkOperatorFactory::create(int32_t driver_instance_count, int32_t driver_sequence) {
-    _buffer->set_sinker_number(driver_instance_count);
     if (_part_type == TPartitionType::UNPARTITIONED || _destinations.size() == 1) {
         return std::make_shared<ExchangeSinkOperator>(_id, _plan_node_id, _buffer, _part_type, _destinations,
                                                       _sender_id, _dest_node_id, _partition_expr_ctxs);
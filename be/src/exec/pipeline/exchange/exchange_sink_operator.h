@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <butil/iobuf.h>
+
 #include "column/column.h"
 #include "common/global_types.h"
 #include "common/object_pool.h"
@@ -10,13 +12,8 @@
 #include "exec/pipeline/operator.h"
 #include "gen_cpp/data.pb.h"
 #include "gen_cpp/internal_service.pb.h"
-#include "util/raw_container.h"
 #include "util/runtime_profile.h"
 
-namespace butil {
-class IOBuf;
-}
-
 namespace starrocks {
 
 class BlockCompressionCodec;
@@ -42,23 +39,30 @@ public:
 
     bool is_finished() const override;
 
+    // The completion of the rpcs in SinkBuffer notifies the driver.
+    bool has_driver_notifier() const override { return true; }
+
     void finish(RuntimeState* state) override;
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
 
     Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
 
-    // For the first chunk , serialize the chunk data and meta to ChunkPB both.
-    // For other chunk, only serialize the chunk data to ChunkPB.
-    Status serialize_chunk(const vectorized::Chunk* chunk, ChunkPB* dst, bool* is_first_chunk, int num_receivers = 1);
-
-    void construct_brpc_attachment(PTransmitChunkParams* _chunk_request, butil::IOBuf* attachment);
+    // For the first chunk , serialize the chunk meta to ChunkPB.
+    // The chunk data is serialized into a buffer which is appended to |attachment| without being copied, and
+    // ChunkPB only records its size.
+    Status serialize_chunk(const vectorized::Chunk* chunk, ChunkPB* dst, bool* is_first_chunk, butil::IOBuf* attachment,
+                           int num_receivers = 1);
 
     RuntimeProfile* profile() { return _profile; }
 
 private:
     class Channel;
 
+    // Whether the batched chunks of |request_bytes| bytes, the first of which was batched at |*batch_start_ms|, or
+    // now if it is 0, should be sent in one request.
+    bool _is_batch_full(size_t request_bytes, int64_t* batch_start_ms) const;
+
     const std::shared_ptr<SinkBuffer>& _buffer;
 
     TPartitionType::type _part_type;
@@ -78,17 +82,16 @@ private:
 
     // Only used when broadcast
     PTransmitChunkParams _chunk_request;
+    // The data of the chunks of _chunk_request
+    butil::IOBuf _chunk_request_attachment;
     size_t _current_request_bytes = 0;
     size_t _request_bytes_threshold = 0;
+    int64_t _batch_start_ms = 0;
+    // The channels the broadcast request is sent to, other than the ones passing the chunks in process
+    size_t _num_remote_channels = 0;
 
     bool _is_first_chunk = true;
 
-    // String to write compressed chunk data in serialize().
-    // This is a string so we can swap() with the string in the ChunkPB we're serializing
-    // to (we don't compress directly into the ChunkPB in case the compressed data is
-    // longer than the uncompressed data).
-    raw::RawString _compression_scratch;
-
     CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
     const BlockCompressionCodec* _compress_codec = nullptr;
 
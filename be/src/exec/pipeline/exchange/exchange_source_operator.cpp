@@ -14,6 +14,7 @@ Status ExchangeSourceOperator::prepare(RuntimeState* state) {
     _stream_recvr = state->exec_env()->stream_mgr()->create_recvr(
             state, _row_desc, state->fragment_instance_id(), _plan_node_id, _num_sender,
             config::exchg_node_buffer_size_bytes, _runtime_profile, false, nullptr);
+    _stream_recvr->set_data_arrival_notifier(_driver_notifier);
     return Status::OK();
 }
 
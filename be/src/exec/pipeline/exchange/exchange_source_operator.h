@@ -29,6 +29,9 @@ public:
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
 
+    // The arrival of chunks notifies the driver.
+    bool has_driver_notifier() const override { return true; }
+
 private:
     int32_t _num_sender;
     const RowDescriptor& _row_desc;
@@ -36,10 +39,10 @@ private:
     std::atomic<bool> _is_finishing{false};
 };
 
-class ExchangeSourceOperatorFactory final : public OperatorFactory {
+class ExchangeSourceOperatorFactory final : public SourceOperatorFactory {
 public:
     ExchangeSourceOperatorFactory(int32_t id, int32_t plan_node_id, int32_t num_sender, const RowDescriptor& row_desc)
-            : OperatorFactory(id, plan_node_id), _num_sender(num_sender), _row_desc(row_desc) {}
+            : SourceOperatorFactory(id, plan_node_id), _num_sender(num_sender), _row_desc(row_desc) {}
 
     ~ExchangeSourceOperatorFactory() override = default;
 
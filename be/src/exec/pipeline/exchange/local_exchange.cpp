@@ -3,27 +3,16 @@
 #include "exec/pipeline/exchange/local_exchange.h"
 
 #include "column/chunk.h"
+#include "common/config.h"
+#include "exprs/expr.h"
 #include "exprs/expr_context.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
 
 namespace starrocks::pipeline {
 
-PartitionExchanger::PartitionExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
-                                       LocalExchangeSourceOperatorFactory* source, bool is_shuffle,
-                                       const std::vector<ExprContext*>& partition_expr_ctxs)
-        : LocalExchanger(memory_manager),
-          _source(source),
-          _is_shuffle(is_shuffle),
-          _partition_expr_ctxs(partition_expr_ctxs) {
-    _partitions_columns.resize(partition_expr_ctxs.size());
-}
-
-Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk) {
+Status PartitionExchanger::Partitioner::partition_chunk(const vectorized::ChunkPtr& chunk) {
     uint16_t num_rows = chunk->num_rows();
-    if (num_rows == 0) {
-        return Status::OK();
-    }
-
-    _memory_manager->update_row_count(chunk->num_rows());
 
     // hash-partition batch's rows across channels
     int num_channels = _source->get_sources().size();
@@ -61,6 +50,7 @@ Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk) {
             _channel_row_idx_start_points[i] += _channel_row_idx_start_points[i - 1];
         }
 
+        _row_indexes.resize(num_rows);
         for (int i = num_rows - 1; i >= 0; --i) {
             _row_indexes[_channel_row_idx_start_points[_hash_values[i]] - 1] = i;
             _channel_row_idx_start_points[_hash_values[i]]--;
@@ -79,26 +69,106 @@ Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk) {
         //     // dest bucket is no used, continue
         //     continue;
         // }
-        RETURN_IF_ERROR(_source->get_sources()[i]->add_chunk(chunk.get(), _row_indexes.data(), from, size));
+        RETURN_IF_ERROR(_append_rows(i, chunk.get(), from, size));
     }
     return Status::OK();
 }
 
-Status BroadcastExchanger::accept(const vectorized::ChunkPtr& chunk) {
-    _memory_manager->update_row_count(chunk->num_rows());
+Status PartitionExchanger::Partitioner::_append_rows(int channel, vectorized::Chunk* chunk, uint32_t from,
+                                                     uint32_t size) {
+    if (_partial_chunks.empty()) {
+        _partial_chunks.resize(_source->get_sources().size());
+    }
+    auto& partial_chunk = _partial_chunks[channel];
+    if (partial_chunk == nullptr) {
+        partial_chunk = chunk->clone_empty_with_slot();
+    } else if (partial_chunk->num_rows() + size > config::vector_chunk_size) {
+        RETURN_IF_ERROR(_flush_partial_chunk(channel));
+        partial_chunk = chunk->clone_empty_with_slot();
+    }
+    partial_chunk->append_selective(*chunk, _row_indexes.data(), from, size);
+    if (partial_chunk->num_rows() >= config::vector_chunk_size) {
+        RETURN_IF_ERROR(_flush_partial_chunk(channel));
+    }
+    return Status::OK();
+}
+
+Status PartitionExchanger::Partitioner::_flush_partial_chunk(int channel) {
+    auto& partial_chunk = _partial_chunks[channel];
+    if (partial_chunk == nullptr || partial_chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    // The source operator releases the rows once it pulls the chunk.
+    _memory_manager->update_row_count(partial_chunk->num_rows());
+    vectorized::ChunkPtr full_chunk = std::move(partial_chunk);
+    return _source->get_sources()[channel]->add_chunk(std::move(full_chunk));
+}
+
+Status PartitionExchanger::Partitioner::flush() {
+    for (int i = 0; i < _partial_chunks.size(); ++i) {
+        RETURN_IF_ERROR(_flush_partial_chunk(i));
+    }
+    return Status::OK();
+}
+
+PartitionExchanger::PartitionExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
+                                       LocalExchangeSourceOperatorFactory* source, bool is_shuffle,
+                                       const std::vector<ExprContext*>& partition_expr_ctxs, size_t num_sinks)
+        : LocalExchanger(memory_manager, source), _partition_expr_ctxs(partition_expr_ctxs) {
+    _partitioners.reserve(num_sinks);
+    for (size_t i = 0; i < num_sinks; ++i) {
+        _partitioners.emplace_back(memory_manager.get(), source, is_shuffle, _partition_expr_ctxs);
+    }
+}
+
+Status PartitionExchanger::prepare(RuntimeState* state) {
+    // The partition exprs are shared by all the sink operators, only the first one prepares them.
+    if (increment_sink_number() == 0) {
+        RowDescriptor row_desc;
+        RETURN_IF_ERROR(Expr::prepare(_partition_expr_ctxs, state, row_desc, state->instance_mem_tracker()));
+        RETURN_IF_ERROR(Expr::open(_partition_expr_ctxs, state));
+    }
+    return Status::OK();
+}
+
+void PartitionExchanger::close(RuntimeState* state) {
+    Expr::close(_partition_expr_ctxs, state);
+}
+
+Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) {
+    if (chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    DCHECK_LT(sink_driver_sequence, _partitioners.size());
+    return _partitioners[sink_driver_sequence].partition_chunk(chunk);
+}
+
+void PartitionExchanger::finish(RuntimeState* state, int32_t sink_driver_sequence) {
+    DCHECK_LT(sink_driver_sequence, _partitioners.size());
+    // The partial chunks must be moved to the source operators before the last sink finishes them.
+    state->log_error(_partitioners[sink_driver_sequence].flush().get_error_msg());
+    LocalExchanger::finish(state, sink_driver_sequence);
+}
+
+Status BroadcastExchanger::accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) {
+    // Every source operator releases the rows of the chunk once it pulls the chunk.
+    _memory_manager->update_row_count(chunk->num_rows() * _source->get_sources().size());
     for (auto* buffer : _source->get_sources()) {
-        buffer->add_chunk(chunk);
+        RETURN_IF_ERROR(buffer->add_chunk(chunk));
     }
     return Status::OK();
 }
 
-Status PassthroughExchanger::accept(const vectorized::ChunkPtr& chunk) {
+Status PassthroughExchanger::accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) {
     _memory_manager->update_row_count(chunk->num_rows());
-    _source->get_sources()[0]->add_chunk(chunk);
-    return Status::OK();
+    // The chunks are spread over the source operators in turn, there is only one source operator
+    // unless several pipelines are gathered into this exchanger.
+    auto& sources = _source->get_sources();
+    size_t index = _next_source_index.fetch_add(1, std::memory_order_relaxed) % sources.size();
+    return sources[index]->add_chunk(chunk);
 }
 
 bool LocalExchanger::need_input() const {
     return !_memory_manager->is_full();
 }
-} // namespace starrocks::pipeline
\ No newline at end of file
+} // namespace starrocks::pipeline
@@ -14,58 +14,111 @@ namespace pipeline {
 // Exchange the local data from local sink operator to local source operator
 class LocalExchanger {
 public:
-    LocalExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager)
-            : _memory_manager(memory_manager) {}
+    LocalExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
+                   LocalExchangeSourceOperatorFactory* source)
+            : _memory_manager(memory_manager), _source(source) {}
 
-    virtual Status accept(const vectorized::ChunkPtr& chunk) = 0;
+    virtual ~LocalExchanger() = default;
 
-    virtual void finish(RuntimeState* state) = 0;
+    // Called by every sink operator in its prepare to register itself.
+    virtual Status prepare(RuntimeState* state) {
+        increment_sink_number();
+        return Status::OK();
+    }
+
+    // Called by the last finished sink operator.
+    virtual void close(RuntimeState* state) {}
+
+    virtual Status accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) = 0;
+
+    // Called by every sink operator once it finishes, the last one finishes all the source operators.
+    virtual void finish(RuntimeState* state, int32_t sink_driver_sequence) {
+        if (decrement_sink_number() == 1) {
+            for (auto* source : _source->get_sources()) {
+                source->finish(state);
+            }
+            close(state);
+        }
+    }
 
     bool need_input() const;
 
-    void increment_sink_number() { _sink_number++; }
+    int32_t increment_sink_number() { return _sink_number++; }
 
     int32_t decrement_sink_number() { return _sink_number--; }
 
 protected:
     std::shared_ptr<LocalExchangeMemoryManager> _memory_manager;
+    LocalExchangeSourceOperatorFactory* _source;
     std::atomic<int32_t> _sink_number{0};
 };
 
 // Exchange the local data for shuffle
 class PartitionExchanger final : public LocalExchanger {
+    // Every sink operator has its own Partitioner, so that the sink operators of
+    // different drivers could shuffle their chunks concurrently.
+    class Partitioner {
+    public:
+        Partitioner(LocalExchangeMemoryManager* memory_manager, LocalExchangeSourceOperatorFactory* source,
+                    bool is_shuffle, const std::vector<ExprContext*>& partition_expr_ctxs)
+                : _memory_manager(memory_manager),
+                  _source(source),
+                  _is_shuffle(is_shuffle),
+                  _partition_expr_ctxs(partition_expr_ctxs) {
+            _partitions_columns.resize(partition_expr_ctxs.size());
+        }
+
+        Status partition_chunk(const vectorized::ChunkPtr& chunk);
+
+        // Move all the partial chunks to the source operators.
+        Status flush();
+
+    private:
+        // Append the rows of |chunk| selected by _row_indexes[from, from + size) to the partial chunk of
+        // the |channel|-th source operator, and move the partial chunk to the source operator once it's full.
+        Status _append_rows(int channel, vectorized::Chunk* chunk, uint32_t from, uint32_t size);
+        Status _flush_partial_chunk(int channel);
+
+        LocalExchangeMemoryManager* _memory_manager;
+        LocalExchangeSourceOperatorFactory* _source;
+        const bool _is_shuffle;
+        const std::vector<ExprContext*>& _partition_expr_ctxs; // compute per-row partition values
+
+        vectorized::Columns _partitions_columns;
+        std::vector<uint32_t> _hash_values;
+        // This array record the channel start point in _row_indexes
+        // And the last item is the number of rows of the current shuffle chunk.
+        // It will easy to get number of rows belong to one channel by doing
+        // _channel_row_idx_start_points[i + 1] - _channel_row_idx_start_points[i]
+        std::vector<uint16_t> _channel_row_idx_start_points;
+        // Record the row indexes for the current shuffle index. Sender will arrange the row indexes
+        // according to channels. For example, if there are 3 channels, this _row_indexes will put
+        // channel 0's row first, then channel 1's row indexes, then put channel 2's row indexes in
+        // the last.
+        std::vector<uint32_t> _row_indexes;
+        // The rows shuffled to each source operator are accumulated here without any lock, so that
+        // the source operators receive chunks of about config::vector_chunk_size rows rather than
+        // a tiny slice of every input chunk. The buffered rows aren't counted by the memory manager
+        // until they are moved to the source operator, they are bounded by one chunk per source.
+        std::vector<vectorized::ChunkUniquePtr> _partial_chunks;
+    };
+
 public:
     PartitionExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
                        LocalExchangeSourceOperatorFactory* source, bool is_shuffle,
-                       const std::vector<ExprContext*>& _partition_expr_ctxs);
+                       const std::vector<ExprContext*>& partition_expr_ctxs, size_t num_sinks);
 
-    Status accept(const vectorized::ChunkPtr& chunk) override;
+    Status prepare(RuntimeState* state) override;
 
-    void finish(RuntimeState* state) override {
-        if (decrement_sink_number() == 1) {
-            for (auto* source : _source->get_sources()) {
-                source->finish(state);
-            }
-        }
-    }
+    void close(RuntimeState* state) override;
+
+    Status accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) override;
+
+    void finish(RuntimeState* state, int32_t sink_driver_sequence) override;
 
 private:
-    LocalExchangeSourceOperatorFactory* _source;
-    bool _is_shuffle = true;
-    std::vector<ExprContext*> _partition_expr_ctxs; // compute per-row partition values
-
-    vectorized::Columns _partitions_columns;
-    std::vector<uint32_t> _hash_values;
-    // This array record the channel start point in _row_indexes
-    // And the last item is the number of rows of the current shuffle chunk.
-    // It will easy to get number of rows belong to one channel by doing
-    // _channel_row_idx_start_points[i + 1] - _channel_row_idx_start_points[i]
-    std::vector<uint16_t> _channel_row_idx_start_points;
-    // Record the row indexes for the current shuffle index. Sender will arrange the row indexes
-    // according to channels. For example, if there are 3 channels, this _row_indexes will put
-    // channel 0's row first, then channel 1's row indexes, then put channel 2's row indexes in
-    // the last.
-    std::vector<uint32_t> _row_indexes;
+    std::vector<ExprContext*> _partition_expr_ctxs;
+    std::vector<Partitioner> _partitioners;
 };
 
 // Exchange the local data for broadcast
@@ -73,38 +126,22 @@ class BroadcastExchanger final : public LocalExchanger {
 public:
     BroadcastExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
                        LocalExchangeSourceOperatorFactory* source)
-            : LocalExchanger(memory_manager), _source(source) {}
-
-    Status accept(const vectorized::ChunkPtr& chunk) override;
-
-    void finish(RuntimeState* state) override {
-        if (decrement_sink_number() == 1) {
-            for (auto* source : _source->get_sources()) {
-                source->finish(state);
-            }
-        }
-    }
+            : LocalExchanger(memory_manager, source) {}
 
-private:
-    LocalExchangeSourceOperatorFactory* _source;
+    Status accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) override;
 };
 
-// Exchange the local data for one local source operation
+// Exchange the local data without shuffle, each chunk is passed to one of the local source operators
 class PassthroughExchanger final : public LocalExchanger {
 public:
     PassthroughExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
                          LocalExchangeSourceOperatorFactory* source)
-            : LocalExchanger(memory_manager), _source(source) {}
-    Status accept(const vectorized::ChunkPtr& chunk) override;
+            : LocalExchanger(memory_manager, source) {}
 
-    void finish(RuntimeState* state) override {
-        if (decrement_sink_number() == 1) {
-            _source->get_sources()[0]->finish(state);
-        }
-    }
+    Status accept(const vectorized::ChunkPtr& chunk, int32_t sink_driver_sequence) override;
 
 private:
-    LocalExchangeSourceOperatorFactory* _source;
+    std::atomic<size_t> _next_source_index{0};
 };
 } // namespace pipeline
 } // namespace starrocks
@@ -7,9 +7,8 @@
 
 namespace starrocks::pipeline {
 Status LocalExchangeSinkOperator::prepare(RuntimeState* state) {
-    _exchanger->increment_sink_number();
     Operator::prepare(state);
-    return Status::OK();
+    return _exchanger->prepare(state);
 }
 
 bool LocalExchangeSinkOperator::need_input() {
@@ -21,13 +20,14 @@ StatusOr<vectorized::ChunkPtr> LocalExchangeSinkOperator::pull_chunk(RuntimeStat
 }
 
 void LocalExchangeSinkOperator::finish(RuntimeState* state) {
-    _is_finished = true;
-    _exchanger->finish(state);
+    if (!_is_finished) {
+        _is_finished = true;
+        _exchanger->finish(state, _driver_sequence);
+    }
 }
 
 Status LocalExchangeSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
-    _exchanger->accept(std::move(chunk));
-    return Status::OK();
+    return _exchanger->accept(chunk, _driver_sequence);
 }
 
 } // namespace starrocks::pipeline
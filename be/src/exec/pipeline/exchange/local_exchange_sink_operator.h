@@ -8,8 +8,8 @@
 namespace starrocks::pipeline {
 class LocalExchangeSinkOperator final : public Operator {
 public:
-    LocalExchangeSinkOperator(int32_t id, const std::shared_ptr<LocalExchanger>& exchanger)
-            : Operator(id, "local_exchange_sink", -1), _exchanger(exchanger) {}
+    LocalExchangeSinkOperator(int32_t id, int32_t driver_sequence, const std::shared_ptr<LocalExchanger>& exchanger)
+            : Operator(id, "local_exchange_sink", -1), _driver_sequence(driver_sequence), _exchanger(exchanger) {}
 
     ~LocalExchangeSinkOperator() override = default;
 
@@ -29,6 +29,7 @@ public:
 
 private:
     bool _is_finished = false;
+    const int32_t _driver_sequence;
     const std::shared_ptr<LocalExchanger>& _exchanger;
 };
 
@@ -40,7 +41,7 @@ public:
     ~LocalExchangeSinkOperatorFactory() override = default;
 
     OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
-        return std::make_shared<LocalExchangeSinkOperator>(_id, _exchanger);
+        return std::make_shared<LocalExchangeSinkOperator>(_id, driver_sequence, _exchanger);
     }
 
 private:
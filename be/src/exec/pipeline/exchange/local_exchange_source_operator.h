@@ -3,6 +3,7 @@
 #pragma once
 
 #include <mutex>
+#include <queue>
 
 #include "exec/pipeline/exchange/local_exchange_memory_manager.h"
 #include "exec/pipeline/source_operator.h"
@@ -15,29 +16,26 @@ public:
 
     Status add_chunk(vectorized::ChunkPtr chunk);
 
-    Status add_chunk(vectorized::Chunk* chunk, const uint32_t* indexes, uint32_t from, uint32_t size);
-
     bool has_output() override;
 
     bool is_finished() const override;
 
-    void finish(RuntimeState* state) override { _is_finished = true; }
+    void finish(RuntimeState* state) override;
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
 
 private:
-    std::atomic<bool> _is_finished{false};
-    vectorized::ChunkPtr _full_chunk = nullptr;
-    vectorized::ChunkUniquePtr _partial_chunk = nullptr;
+    bool _is_finished = false;
+    std::queue<vectorized::ChunkPtr> _full_chunk_queue;
     // TODO(KKS): make it lock free
     mutable std::mutex _chunk_lock;
     const std::shared_ptr<LocalExchangeMemoryManager>& _memory_manager;
 };
 
-class LocalExchangeSourceOperatorFactory final : public OperatorFactory {
+class LocalExchangeSourceOperatorFactory final : public SourceOperatorFactory {
 public:
     LocalExchangeSourceOperatorFactory(int32_t id, const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager)
-            : OperatorFactory(id, -1), _memory_manager(memory_manager) {}
+            : SourceOperatorFactory(id, -1), _memory_manager(memory_manager) {}
 
     ~LocalExchangeSourceOperatorFactory() override = default;
 
@@ -0,0 +1,212 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/exchange/sink_buffer.h"
+
+#include "common/config.h"
+#include "runtime/data_stream_mgr.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "util/time.h"
+
+namespace starrocks::pipeline {
+
+// The closure run by the receiver on this backend once it takes a chunk passed in process.
+class LocalRequestClosure final : public google::protobuf::Closure {
+public:
+    explicit LocalRequestClosure(std::function<void()> callback) : _callback(std::move(callback)) {}
+
+    void Run() override {
+        _callback();
+        delete this;
+    }
+
+private:
+    std::function<void()> _callback;
+};
+
+SinkBuffer::SinkBuffer(RuntimeState* state, const std::vector<TPlanFragmentDestination>& destinations)
+        : _brpc_timeout_ms(std::min(3600, state->query_options().query_timeout) * 1000),
+          _max_uncompleted_requests(destinations.size()) {
+    for (const auto& destination : destinations) {
+        auto instance_id = destination.fragment_instance_id.lo;
+        // The unused destination of bucket shuffle.
+        if (instance_id == -1) {
+            continue;
+        }
+        if (_destinations.count(instance_id) == 0) {
+            _destinations.emplace(instance_id, std::make_unique<Destination>());
+        }
+    }
+    _query_trace = QueryTraceManager::instance()->get(state->query_id());
+    if (_query_trace != nullptr) {
+        _trace_rpc_name_id = _query_trace->name_id("transmit_chunk");
+        _trace_local_rpc_name_id = _query_trace->name_id("transmit_chunk_local");
+        _trace_credit_rpc_name_id = _query_trace->name_id("transmit_chunk_ask_credit");
+    }
+}
+
+void SinkBuffer::add_sinker(const TUniqueId& fragment_instance_id) {
+    auto it = _destinations.find(fragment_instance_id.lo);
+    if (it != _destinations.end()) {
+        it->second->num_remaining_eos++;
+    }
+}
+
+void SinkBuffer::add_request(TransmitChunkInfo request) {
+    auto it = _destinations.find(request.params.finst_id().lo());
+    if (it == _destinations.end()) {
+        return;
+    }
+    if (_is_cancelled) {
+        return;
+    }
+    auto* dest = it->second.get();
+    _num_uncompleted_requests++;
+    {
+        std::lock_guard<std::mutex> l(dest->lock);
+        // Only send eos for the last sinker of the destination, because eos could be sent only once.
+        if (request.params.eos() && --dest->num_remaining_eos > 0) {
+            if (request.params.chunks_size() == 0 && request.local_chunk == nullptr) {
+                _complete_requests(1);
+                return;
+            }
+            request.params.set_eos(false);
+        }
+        dest->pending_requests.emplace(std::move(request));
+    }
+    _try_send_rpc(dest);
+}
+
+void SinkBuffer::_try_send_rpc(Destination* dest) {
+    CallBackClosure<PTransmitChunkResult>* closure = nullptr;
+    bool is_local = false;
+    {
+        std::lock_guard<std::mutex> l(dest->lock);
+        if (dest->has_in_flight_rpc || dest->pending_requests.empty()) {
+            return;
+        }
+        if (_is_cancelled) {
+            auto num_requests = dest->pending_requests.size();
+            dest->pending_requests = {};
+            _complete_requests(num_requests);
+            return;
+        }
+        if (dest->credit_bytes == 0) {
+            // Ask the receiver for the credit by a request of the same destination without any chunk, which the
+            // receiver responds to once it has room.
+            const auto& pending_params = dest->pending_requests.front().params;
+            dest->in_flight_request = TransmitChunkInfo();
+            auto& params = dest->in_flight_request.params;
+            *params.mutable_finst_id() = pending_params.finst_id();
+            params.set_node_id(pending_params.node_id());
+            params.set_sender_id(pending_params.sender_id());
+            params.set_be_number(pending_params.be_number());
+            params.set_eos(false);
+            dest->in_flight_request.brpc_stub = dest->pending_requests.front().brpc_stub;
+            dest->is_asking_credit = true;
+        } else {
+            dest->in_flight_request = std::move(dest->pending_requests.front());
+            dest->pending_requests.pop();
+            dest->is_asking_credit = false;
+        }
+        dest->in_flight_request.params.set_sequence(dest->sequence++);
+        dest->in_flight_request.params.set_use_credit(config::exchange_credit_flow_control);
+        dest->has_in_flight_rpc = true;
+        if (_query_trace != nullptr) {
+            dest->rpc_begin_ns = MonotonicNanos();
+            dest->rpc_bytes = dest->in_flight_request.attachment.size();
+        }
+        if (dest->in_flight_request.is_local) {
+            is_local = true;
+        } else {
+            closure = new CallBackClosure<PTransmitChunkResult>();
+            // The closure holds the SinkBuffer, because the rpc may complete after the fragment is destroyed.
+            auto buffer = shared_from_this();
+            closure->addFailedHandler([buffer, dest]() {
+                LOG(WARNING) << " transmit chunk rpc failed, ";
+                buffer->_on_rpc_finished(dest, true, -1);
+            });
+            closure->addSuccessHandler([buffer, dest](const PTransmitChunkResult& result) {
+                Status status(result.status());
+                if (!status.ok()) {
+                    LOG(WARNING) << " transmit chunk rpc failed, " << status.to_string();
+                }
+                buffer->_on_rpc_finished(dest, !status.ok(), result.has_credit_bytes() ? result.credit_bytes() : -1);
+            });
+            closure->ref();
+            closure->cntl.set_timeout_ms(_brpc_timeout_ms);
+            closure->cntl.request_attachment().swap(dest->in_flight_request.attachment);
+        }
+    }
+    if (is_local) {
+        _send_local_request(dest);
+        return;
+    }
+    // Send out of the lock, because the closure may be run in place if the rpc fails immediately.
+    auto& request = dest->in_flight_request;
+    request.brpc_stub->transmit_chunk(&closure->cntl, &request.params, &closure->result, closure);
+}
+
+void SinkBuffer::_send_local_request(Destination* dest) {
+    auto& request = dest->in_flight_request;
+    const auto& params = request.params;
+    TUniqueId fragment_instance_id;
+    fragment_instance_id.__set_hi(params.finst_id().hi());
+    fragment_instance_id.__set_lo(params.finst_id().lo());
+    auto buffer = shared_from_this();
+    google::protobuf::Closure* done =
+            new LocalRequestClosure([buffer, dest]() { buffer->_on_rpc_finished(dest, false, -1); });
+    auto st = ExecEnv::GetInstance()->stream_mgr()->transmit_chunk_local(
+            fragment_instance_id, params.node_id(), params.sender_id(), params.be_number(),
+            std::move(request.local_chunk), params.eos(), nullptr, &done);
+    if (!st.ok()) {
+        LOG(WARNING) << " transmit local chunk failed, " << st.to_string();
+        _is_cancelled = true;
+    }
+    // The receiver keeps the closure while its buffer is full, otherwise the request completes at once.
+    if (done != nullptr) {
+        done->Run();
+    }
+}
+
+void SinkBuffer::_on_rpc_finished(Destination* dest, bool is_failed, int64_t credit_bytes) {
+    if (is_failed) {
+        _is_cancelled = true;
+    }
+    bool is_asking_credit = false;
+    {
+        std::lock_guard<std::mutex> l(dest->lock);
+        dest->has_in_flight_rpc = false;
+        is_asking_credit = dest->is_asking_credit;
+        dest->credit_bytes = credit_bytes;
+        if (_query_trace != nullptr) {
+            int32_t name_id = _trace_rpc_name_id;
+            if (is_asking_credit) {
+                name_id = _trace_credit_rpc_name_id;
+            } else if (dest->in_flight_request.is_local) {
+                name_id = _trace_local_rpc_name_id;
+            }
+            _query_trace->add_complete_event(QueryTrace::RPC, name_id, dest->rpc_begin_ns, MonotonicNanos(),
+                                             dest->rpc_bytes);
+        }
+    }
+    // The rpc asking for the credit is not a request of the sinkers.
+    if (!is_asking_credit) {
+        _complete_requests(1);
+    }
+    _try_send_rpc(dest);
+}
+
+void SinkBuffer::_complete_requests(int32_t num_requests) {
+    _num_uncompleted_requests -= num_requests;
+    _notify_drivers();
+}
+
+void SinkBuffer::_notify_drivers() {
+    std::lock_guard<std::mutex> l(_notifiers_lock);
+    for (auto& notifier : _driver_notifiers) {
+        notifier();
+    }
+}
+
+} // namespace starrocks::pipeline
@@ -2,118 +2,114 @@
 
 #pragma once
 
+#include <butil/iobuf.h>
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+
 #include "column/chunk.h"
+#include "exec/pipeline/query_trace.h"
 #include "gen_cpp/BackendService.h"
-#include "util/blocking_queue.hpp"
+#include "gen_cpp/InternalService_types.h"
 #include "util/brpc_stub_cache.h"
 #include "util/callback_closure.h"
 
-namespace starrocks::pipeline {
+namespace starrocks {
+class RuntimeState;
+namespace pipeline {
 
 struct TransmitChunkInfo {
     PTransmitChunkParams params;
     PBackendService_Stub* brpc_stub;
+    // The data of the chunks of params, sent as the attachment of the rpc
+    butil::IOBuf attachment;
+    // Whether the request is passed in process to the receiver on this backend, with |local_chunk| in place of the
+    // chunks of params.
+    bool is_local = false;
+    vectorized::ChunkUniquePtr local_chunk;
 };
 
-class SinkBuffer {
+// SinkBuffer sends the transmit chunk requests of all the ExchangeSinkOperators of a fragment instance.
+// Each destination fragment instance has its own queue of pending requests and at most one in-flight rpc,
+// because the receiver discards the request whose sequence isn't larger than the one it has received.
+// There is no sending thread, the request is sent by add_request if the destination is idle, otherwise
+// the completion callback of the in-flight rpc sends the next pending request of the same destination.
+class SinkBuffer : public std::enable_shared_from_this<SinkBuffer> {
 public:
-    SinkBuffer(size_t channel_number) : _closure_size(channel_number) {
-        for (size_t i = 0; i < channel_number; ++i) {
-            auto _chunk_closure = new CallBackClosure<PTransmitChunkResult>();
-            _chunk_closure->ref();
-            _chunk_closure->addFailedHandler([this]() {
-                _in_flight_rpc_num--;
-                _is_cancelled = true;
-                LOG(WARNING) << " transmit chunk rpc failed, ";
-            });
-
-            _chunk_closure->addSuccessHandler([this](const PTransmitChunkResult& result) {
-                _in_flight_rpc_num--;
-                Status status(result.status());
-                if (!status.ok()) {
-                    _is_cancelled = true;
-                    LOG(WARNING) << " transmit chunk rpc failed, ";
-                }
-            });
-            _closures.push_back(_chunk_closure);
-        }
+    SinkBuffer(RuntimeState* state, const std::vector<TPlanFragmentDestination>& destinations);
 
-        _thread = std::thread{&SinkBuffer::process, this};
-    }
+    ~SinkBuffer() = default;
 
-    ~SinkBuffer() {
-        _pending_chunks.shutdown();
-        _thread.join();
-        for (auto* closure : _closures) {
-            if (closure->unref()) {
-                delete closure;
-            }
-        }
-    }
+    // Called by each ExchangeSinkOperator for each destination it sends to before any request is added,
+    // the eos of a destination is only sent after all of its sinkers have sent the eos.
+    void add_sinker(const TUniqueId& fragment_instance_id);
 
-    void add_request(TransmitChunkInfo request) {
-        _in_flight_rpc_num++;
-        _pending_chunks.put(request);
-    }
+    void add_request(TransmitChunkInfo request);
 
-    void process() {
-        while (true) {
-            // If the head closure has flight rpc, means all closures are busy
-            if (_closures.front()->has_in_flight_rpc()) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                continue;
-            }
-
-            TransmitChunkInfo info;
-            if (!_pending_chunks.blocking_get(&info)) {
-                break;
-            }
-            _send_rpc(info);
-
-            // The original design is bad, we must release_finst_id here!
-            info.params.release_finst_id();
-        }
-    }
-
-    bool is_full() const { return _in_flight_rpc_num >= _closure_size; }
+    bool is_full() const { return _num_uncompleted_requests >= _max_uncompleted_requests; }
 
-    bool is_finished() const { return _in_flight_rpc_num == 0 || _is_cancelled; }
+    bool is_finished() const { return _num_uncompleted_requests == 0 || _is_cancelled; }
 
     bool is_cancelled() const { return _is_cancelled; }
 
-    void set_sinker_number(int64_t sinker_number) { _sinker_number = sinker_number; }
-
-private:
-    void _send_rpc(TransmitChunkInfo& request) {
-        if (request.params.eos()) {
-            // Only send eos for last sinker, because we could only send eos once
-            if (--_sinker_number > 0) {
-                _in_flight_rpc_num--;
-                return;
-            }
+    // Each ExchangeSinkOperator sharing this buffer adds its driver notifier, all of which are
+    // invoked once an rpc completes, because any of the sinkers may be blocked on is_full().
+    void add_driver_notifier(std::function<void()> notifier) {
+        if (!notifier) {
+            return;
         }
-        request.params.set_sequence(_request_seq);
-        auto* closure = _closures.front();
-        DCHECK(!closure->has_in_flight_rpc());
-        // Move the closure has flight rpc to tail
-        _closures.pop_front();
-        _closures.push_back(closure);
-        closure->ref();
-        closure->cntl.Reset();
-        closure->cntl.set_timeout_ms(500);
-        request.brpc_stub->transmit_chunk(&closure->cntl, &request.params, &closure->result, closure);
-        _request_seq++;
+        std::lock_guard<std::mutex> l(_notifiers_lock);
+        _driver_notifiers.emplace_back(std::move(notifier));
     }
 
-    // To avoid lock
-    const int32_t _closure_size;
-    int64_t _request_seq = 0;
-    int64_t _sinker_number = 0;
-    std::atomic<int32_t> _in_flight_rpc_num = 0;
+private:
+    struct Destination {
+        std::mutex lock;
+        std::queue<TransmitChunkInfo, std::list<TransmitChunkInfo>> pending_requests;
+        // The request of the in-flight rpc, which must live until the rpc completes.
+        TransmitChunkInfo in_flight_request;
+        bool has_in_flight_rpc = false;
+        // Whether the in-flight rpc asks for the credit, without any chunk, instead of sending a pending request.
+        bool is_asking_credit = false;
+        // The credit granted by the receiver of the last rpc, -1 if it is not known, with which the next pending
+        // request is sent only if it is not 0.
+        int64_t credit_bytes = -1;
+        int64_t sequence = 0;
+        int32_t num_remaining_eos = 0;
+        // When the in-flight rpc was sent and the bytes of its attachment, if the query is traced.
+        int64_t rpc_begin_ns = 0;
+        int64_t rpc_bytes = 0;
+    };
+
+    // Pop and send the next pending request of |dest| if it has no in-flight rpc.
+    void _try_send_rpc(Destination* dest);
+    // Pass the in-flight request of |dest| to the receiver on this backend, which completes it once it takes the
+    // chunk, like the response of an rpc.
+    void _send_local_request(Destination* dest);
+    void _on_rpc_finished(Destination* dest, bool is_failed, int64_t credit_bytes);
+    void _complete_requests(int32_t num_requests);
+    void _notify_drivers();
+
+    const int32_t _brpc_timeout_ms;
+    const int32_t _max_uncompleted_requests;
+    // Keyed by the lo of fragment instance id of the destination.
+    std::unordered_map<int64_t, std::unique_ptr<Destination>> _destinations;
+    // The requests which are pending or in flight.
+    std::atomic<int32_t> _num_uncompleted_requests = 0;
     std::atomic<bool> _is_cancelled{false};
-    std::deque<CallBackClosure<PTransmitChunkResult>*> _closures;
-    std::thread _thread;
-    UnboundedBlockingQueue<TransmitChunkInfo> _pending_chunks;
+    std::mutex _notifiers_lock;
+    std::vector<std::function<void()>> _driver_notifiers;
+    // nullptr unless the query is traced.
+    QueryTracePtr _query_trace;
+    int32_t _trace_rpc_name_id = 0;
+    int32_t _trace_local_rpc_name_id = 0;
+    int32_t _trace_credit_rpc_name_id = 0;
 };
 
-} // namespace starrocks::pipeline
\ No newline at end of file
+} // namespace pipeline
+} // namespace starrocks
@@ -1,9 +1,65 @@
 // This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
 
 #include "exec/pipeline/fragment_context.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+
 namespace starrocks {
 namespace pipeline {
 
+void FragmentContext::reserve_drivers(const MorselQueue* morsel_queue, Drivers&& drivers,
+                                      size_t num_dispatched_drivers) {
+    std::lock_guard<std::mutex> lock(_elastic_pipelines_lock);
+    auto& pipeline = _elastic_pipelines[morsel_queue];
+    _num_reserved_drivers.fetch_add(drivers.size());
+    pipeline.reserved_drivers = std::move(drivers);
+    pipeline.num_dispatched_drivers = num_dispatched_drivers;
+}
+
+bool FragmentContext::is_reserved_driver(const PipelineDriver* driver) {
+    std::lock_guard<std::mutex> lock(_elastic_pipelines_lock);
+    auto it = _elastic_pipelines.find(driver->morsel_queue());
+    if (it == _elastic_pipelines.end()) {
+        return false;
+    }
+    const auto& reserved_drivers = it->second.reserved_drivers;
+    return std::any_of(reserved_drivers.begin(), reserved_drivers.end(),
+                       [driver](const DriverPtr& reserved) { return reserved.get() == driver; });
+}
+
+Drivers FragmentContext::take_reserved_drivers(const PipelineDriver* driver, DriverState state) {
+    if (_num_reserved_drivers.load() == 0 || driver->morsel_queue() == nullptr) {
+        return {};
+    }
+    std::lock_guard<std::mutex> lock(_elastic_pipelines_lock);
+    auto it = _elastic_pipelines.find(driver->morsel_queue());
+    if (it == _elastic_pipelines.end() || it->second.reserved_drivers.empty()) {
+        return {};
+    }
+    auto& pipeline = it->second;
+    auto* morsel_queue = driver->morsel_queue();
+
+    bool is_driver_ended = state == DriverState::FINISH || state == DriverState::CANCELED ||
+                           state == DriverState::INTERNAL_ERROR || state == DriverState::PENDING_FINISH;
+    Drivers drivers;
+    if (is_driver_ended || is_canceled() || morsel_queue->num_remaining_morsels() == 0) {
+        drivers = std::move(pipeline.reserved_drivers);
+        pipeline.reserved_drivers.clear();
+    } else if (state == DriverState::READY &&
+               morsel_queue->num_remaining_morsels() >
+                       pipeline.num_dispatched_drivers * config::pipeline_adaptive_dop_min_morsels_per_driver) {
+        // The driver yields because it has used up its time slice rather than being blocked,
+        // so the pipeline is CPU-bound, and another driver could share the rest morsels.
+        drivers.emplace_back(std::move(pipeline.reserved_drivers.back()));
+        pipeline.reserved_drivers.pop_back();
+    }
+    pipeline.num_dispatched_drivers += drivers.size();
+    _num_reserved_drivers.fetch_sub(drivers.size());
+    return drivers;
+}
+
 FragmentContextManager::FragmentContextManager() {}
 FragmentContextManager::~FragmentContextManager() {}
 FragmentContext* FragmentContextManager::get_or_register(const TUniqueId& fragment_id) {
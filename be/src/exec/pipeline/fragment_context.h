@@ -84,6 +84,18 @@ public:
 
     MorselQueueMap& morsel_queues() { return _morsel_queues; }
 
+    // In the adaptive dop mode, only a part of the drivers of a scan pipeline are dispatched at first,
+    // the others are reserved here, and dispatched when the dispatched ones turn out to be CPU-bound.
+    // The reserved drivers have been prepared like the others, so the operators shared across the
+    // drivers and pipelines, such as local exchangers, count them in.
+    void reserve_drivers(const MorselQueue* morsel_queue, Drivers&& drivers, size_t num_dispatched_drivers);
+    bool is_reserved_driver(const PipelineDriver* driver);
+    // Called after |driver| has been processed and turned to |state|. Return the reserved drivers of
+    // the same pipeline that should be dispatched: one of them when |driver| yields with a plenty of
+    // morsels left, and all of them once the morsels run out or |driver| ends, because every driver
+    // must run to the end to finish the operators paired with it.
+    Drivers take_reserved_drivers(const PipelineDriver* driver, DriverState state);
+
 private:
     // Id of this query
     TUniqueId _query_id;
@@ -100,6 +112,14 @@ private:
     // MorselQueue that is shared among drivers created from the same pipeline,
     // drivers contend for Morsels from MorselQueue.
     MorselQueueMap _morsel_queues;
+    struct ElasticPipeline {
+        Drivers reserved_drivers;
+        size_t num_dispatched_drivers = 0;
+    };
+    // The scan pipelines that have reserved drivers, keyed by their MorselQueues.
+    std::mutex _elastic_pipelines_lock;
+    std::unordered_map<const MorselQueue*, ElasticPipeline> _elastic_pipelines;
+    std::atomic<size_t> _num_reserved_drivers{0};
     // when _num_root_drivers counts down to zero, means that all the root drivers are finished,
     // the fragment instance produces the entire result required, all the outstanding drivers
     // should finish computation.
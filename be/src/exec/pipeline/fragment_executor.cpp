@@ -13,6 +13,7 @@
 #include "exec/pipeline/result_sink_operator.h"
 #include "exec/pipeline/scan_operator.h"
 #include "exec/scan_node.h"
+#include "exec/vectorized/olap_scan_node.h"
 #include "gen_cpp/starrocks_internal_service.pb.h"
 #include "gutil/casts.h"
 #include "gutil/map_util.h"
@@ -33,6 +34,20 @@ Morsels convert_scan_range_to_morsel(const std::vector<TScanRangeParams>& scan_r
     return morsels;
 }
 
+// Split the tablets into fine-grained morsels, so that a skewed tablet is scanned by multiple drivers.
+Morsels convert_scan_range_to_split_morsel(const std::vector<TScanRangeParams>& scan_ranges, int node_id,
+                                           bool skip_aggregation) {
+    Morsels morsels;
+    for (const auto& scan_range : scan_ranges) {
+        auto tablet_morsels =
+                split_olap_morsel(node_id, scan_range, skip_aggregation, config::pipeline_olap_morsel_split_rows);
+        for (auto& morsel : tablet_morsels) {
+            morsels.emplace_back(std::move(morsel));
+        }
+    }
+    return morsels;
+}
+
 Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParams& request) {
     const TPlanFragmentExecParams& params = request.params;
     auto& query_id = params.query_id;
@@ -41,6 +56,11 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
     if (params.__isset.instances_number) {
         _query_ctx->set_num_fragments(params.instances_number);
     }
+    if (config::pipeline_enable_resource_group) {
+        const auto& query_options = request.query_options;
+        RETURN_IF_ERROR(_query_ctx->init_resource_group(
+                query_options.__isset.resource_group ? query_options.resource_group : std::string()));
+    }
     _fragment_ctx = FragmentContextManager::instance()->get_or_register(fragment_id);
     _fragment_ctx->set_query_id(query_id);
     _fragment_ctx->set_fragment_instance_id(fragment_id);
@@ -63,6 +83,8 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
     runtime_state->set_batch_size(config::vector_chunk_size);
     RETURN_IF_ERROR(runtime_state->init_mem_trackers(query_id));
     runtime_state->set_be_number(request.backend_num);
+    runtime_state->set_per_fragment_instance_idx(params.sender_id);
+    runtime_state->set_num_per_fragment_instances(params.num_senders);
     runtime_state->set_fragment_mem_tracker(mem_tracker);
 
     LOG(INFO) << "Using query memory limit: " << PrettyPrinter::print(bytes_limit, TUnit::BYTES);
@@ -100,7 +122,36 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
         pipeline_scan_mode = request.query_options.pipeline_scan_mode;
     }
 
-    PipelineBuilderContext context(*_fragment_ctx, driver_instance_count);
+    // set scan ranges before pipeline build, because the degree of parallelism of
+    // the scan pipeline depends on the number of morsels
+    std::vector<ExecNode*> scan_nodes;
+    std::vector<TScanRangeParams> no_scan_ranges;
+    plan->collect_scan_nodes(&scan_nodes);
+
+    MorselQueueMap& morsel_queues = _fragment_ctx->morsel_queues();
+    for (int i = 0; i < scan_nodes.size(); ++i) {
+        ScanNode* scan_node = down_cast<ScanNode*>(scan_nodes[i]);
+        const std::vector<TScanRangeParams>& scan_ranges =
+                FindWithDefault(params.per_node_scan_ranges, scan_node->id(), no_scan_ranges);
+        Morsels morsels;
+        const TOlapScanNode* olap_scan_node = nullptr;
+        if (typeid(*scan_node) == typeid(vectorized::OlapScanNode)) {
+            olap_scan_node = &down_cast<vectorized::OlapScanNode*>(scan_node)->thrift_olap_scan_node();
+        }
+        // The rows of the metadata scan are generated from whole segments, which are cheap to scan anyway.
+        bool metadata_scan =
+                olap_scan_node != nullptr && olap_scan_node->__isset.metadata_scan && olap_scan_node->metadata_scan;
+        if (driver_instance_count > 1 && config::pipeline_olap_morsel_split_rows > 0 && olap_scan_node != nullptr &&
+            !metadata_scan) {
+            morsels = convert_scan_range_to_split_morsel(scan_ranges, scan_node->id(),
+                                                         olap_scan_node->is_preaggregation);
+        } else {
+            morsels = convert_scan_range_to_morsel(scan_ranges, scan_node->id());
+        }
+        morsel_queues.emplace(scan_node->id(), std::make_unique<MorselQueue>(std::move(morsels)));
+    }
+
+    PipelineBuilderContext context(_fragment_ctx, driver_instance_count);
     PipelineBuilder builder(context);
     _fragment_ctx->set_pipelines(builder.build(*_fragment_ctx, plan));
     // Set up sink, if required
@@ -116,20 +167,6 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
         _convert_data_sink_to_operator(params, &context, sink.get());
     }
 
-    // set scan ranges
-    std::vector<ExecNode*> scan_nodes;
-    std::vector<TScanRangeParams> no_scan_ranges;
-    plan->collect_scan_nodes(&scan_nodes);
-
-    MorselQueueMap& morsel_queues = _fragment_ctx->morsel_queues();
-    for (int i = 0; i < scan_nodes.size(); ++i) {
-        ScanNode* scan_node = down_cast<ScanNode*>(scan_nodes[i]);
-        const std::vector<TScanRangeParams>& scan_ranges =
-                FindWithDefault(params.per_node_scan_ranges, scan_node->id(), no_scan_ranges);
-        Morsels morsels = convert_scan_range_to_morsel(scan_ranges, scan_node->id());
-        morsel_queues.emplace(scan_node->id(), std::make_unique<MorselQueue>(std::move(morsels)));
-    }
-
     Drivers drivers;
     const auto& pipelines = _fragment_ctx->pipelines();
     const size_t num_pipelines = pipelines.size();
@@ -142,32 +179,42 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
         const bool is_root = (n == num_pipelines - 1);
         const auto driver_instance_count = pipeline->get_driver_instance_count();
 
-        if (pipeline->get_op_factories()[0]->is_source()) {
-            auto source_id = pipeline->get_op_factories()[0]->plan_node_id();
+        if (is_root) {
+            _fragment_ctx->set_num_root_drivers(driver_instance_count);
+        }
+        auto source_id = pipeline->get_op_factories()[0]->plan_node_id();
+        if (morsel_queues.count(source_id)) {
             auto& morsel_queue = morsel_queues[source_id];
-            const auto instance_count = std::min<size_t>(morsel_queue->num_morsels(), driver_instance_count);
-            if (is_root) {
-                _fragment_ctx->set_num_root_drivers(instance_count);
+            // In the adaptive dop mode, the drivers beyond the initial ones are reserved.
+            size_t num_initial_drivers = driver_instance_count;
+            if (config::pipeline_enable_adaptive_dop) {
+                num_initial_drivers = std::min<size_t>(
+                        driver_instance_count, std::max(1, config::pipeline_adaptive_dop_initial_drivers));
             }
-            for (auto i = 0; i < instance_count; ++i) {
+            Drivers reserved_drivers;
+            for (auto i = 0; i < driver_instance_count; ++i) {
                 Operators operators;
                 for (const auto& factory : pipeline->get_op_factories()) {
-                    operators.emplace_back(factory->create(instance_count, i));
+                    operators.emplace_back(factory->create(driver_instance_count, i));
                 }
-                DriverPtr driver = std::make_shared<PipelineDriver>(operators, _query_ctx, _fragment_ctx, 0, is_root);
+                DriverPtr driver = std::make_shared<PipelineDriver>(operators, _query_ctx, _fragment_ctx, i, is_root);
                 driver->set_morsel_queue(morsel_queue.get());
                 auto* scan_operator = down_cast<ScanOperator*>(driver->source_operator());
                 if (pipeline_scan_mode == 1) {
                     scan_operator->set_io_threads(exec_env->pipeline_io_thread_pool());
+                    scan_operator->set_scan_threads(exec_env->scan_thread_pool());
                 } else {
                     scan_operator->set_io_threads(nullptr);
                 }
+                if (i >= num_initial_drivers) {
+                    reserved_drivers.emplace_back(driver);
+                }
                 drivers.emplace_back(std::move(driver));
             }
-        } else {
-            if (is_root) {
-                _fragment_ctx->set_num_root_drivers(driver_instance_count);
+            if (!reserved_drivers.empty()) {
+                _fragment_ctx->reserve_drivers(morsel_queue.get(), std::move(reserved_drivers), num_initial_drivers);
             }
+        } else {
             for (auto i = 0; i < driver_instance_count; ++i) {
                 Operators operators;
                 for (const auto& factory : pipeline->get_op_factories()) {
@@ -185,7 +232,15 @@ Status FragmentExecutor::execute(ExecEnv* exec_env) {
     for (auto driver : _fragment_ctx->drivers()) {
         RETURN_IF_ERROR(driver->prepare(_fragment_ctx->runtime_state()));
     }
-    for (auto driver : _fragment_ctx->drivers()) {
+    // The reserved drivers are picked out before any driver is dispatched,
+    // because the dispatched drivers may take and dispatch them.
+    Drivers dispatched_drivers;
+    for (const auto& driver : _fragment_ctx->drivers()) {
+        if (!_fragment_ctx->is_reserved_driver(driver.get())) {
+            dispatched_drivers.emplace_back(driver);
+        }
+    }
+    for (const auto& driver : dispatched_drivers) {
         exec_env->driver_dispatcher()->dispatch(driver);
     }
     return Status::OK();
@@ -202,7 +257,8 @@ void FragmentExecutor::_convert_data_sink_to_operator(const TPlanFragmentExecPar
         _fragment_ctx->pipelines().back()->add_op_factory(op);
     } else if (typeid(*datasink) == typeid(starrocks::DataStreamSender)) {
         starrocks::DataStreamSender* sender = down_cast<starrocks::DataStreamSender*>(datasink);
-        std::shared_ptr<SinkBuffer> sink_buffer = std::make_shared<SinkBuffer>(sender->get_destinations_size());
+        std::shared_ptr<SinkBuffer> sink_buffer =
+                std::make_shared<SinkBuffer>(_fragment_ctx->runtime_state(), params.destinations);
 
         OpFactoryPtr exchange_sink = std::make_shared<ExchangeSinkOperatorFactory>(
                 context->next_operator_id(), -1, sink_buffer, sender->get_partition_type(), params.destinations,
@@ -0,0 +1,37 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/hash_join/hash_join_build_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status HashJoinBuildOperator::prepare(RuntimeState* state) {
+    _hash_joiner->ref();
+    RETURN_IF_ERROR(Operator::prepare(state));
+    return _hash_joiner->prepare(state, state->obj_pool(), _runtime_profile.get(), _mem_tracker.get());
+}
+
+Status HashJoinBuildOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_hash_joiner->unref(state));
+    return Operator::close(state);
+}
+
+void HashJoinBuildOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+    // The failure of building is reported by the probe operators.
+    _hash_joiner->build_ht(state);
+}
+
+StatusOr<vectorized::ChunkPtr> HashJoinBuildOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from hash join build.");
+}
+
+Status HashJoinBuildOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    return _hash_joiner->append_chunk_to_ht(state, chunk);
+}
+} // namespace starrocks::pipeline
@@ -0,0 +1,51 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/hash_joiner.h"
+
+namespace starrocks::pipeline {
+// HashJoinBuildOperator appends all the build side input to the hash table of the builder HashJoiner,
+// and builds the hash table when the input is finished, after that the HashJoinProbeOperators of the
+// probe pipeline share the hash table.
+class HashJoinBuildOperator final : public Operator {
+public:
+    HashJoinBuildOperator(int32_t id, int32_t plan_node_id, vectorized::HashJoinerPtr hash_joiner)
+            : Operator(id, "hash_join_build", plan_node_id), _hash_joiner(std::move(hash_joiner)) {}
+    ~HashJoinBuildOperator() override = default;
+
+    bool has_output() override { return false; }
+    bool need_input() override { return !is_finished(); }
+    bool is_finished() const override { return _is_finished; }
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    vectorized::HashJoinerPtr _hash_joiner = nullptr;
+    bool _is_finished = false;
+};
+
+class HashJoinBuildOperatorFactory final : public OperatorFactory {
+public:
+    HashJoinBuildOperatorFactory(int32_t id, int32_t plan_node_id, vectorized::HashJoinerFactoryPtr hash_joiner_factory)
+            : OperatorFactory(id, plan_node_id), _hash_joiner_factory(std::move(hash_joiner_factory)) {}
+
+    ~HashJoinBuildOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        // The build pipeline has only one driver, see HashJoinNode::decompose_to_pipeline.
+        DCHECK_EQ(driver_instance_count, 1);
+        return std::make_shared<HashJoinBuildOperator>(_id, _plan_node_id,
+                                                       _hash_joiner_factory->get_or_create_builder());
+    }
+
+private:
+    vectorized::HashJoinerFactoryPtr _hash_joiner_factory = nullptr;
+};
+} // namespace starrocks::pipeline
@@ -0,0 +1,83 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/hash_join/hash_join_probe_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status HashJoinProbeOperator::prepare(RuntimeState* state) {
+    _builder->ref();
+    _prober->ref();
+    RETURN_IF_ERROR(Operator::prepare(state));
+    return _prober->prepare(state, state->obj_pool(), _runtime_profile.get(), _mem_tracker.get());
+}
+
+Status HashJoinProbeOperator::close(RuntimeState* state) {
+    // The prober must be closed before the builder, because it shares the hash table of the builder.
+    RETURN_IF_ERROR(_prober->unref(state));
+    RETURN_IF_ERROR(_builder->unref(state));
+    return Operator::close(state);
+}
+
+bool HashJoinProbeOperator::_try_reference_hash_table() {
+    if (!_is_ht_referenced && _builder->is_build_done()) {
+        if (_builder->build_status().ok()) {
+            _prober->reference_hash_table(_builder.get());
+        }
+        _is_ht_referenced = true;
+    }
+    return _is_ht_referenced;
+}
+
+bool HashJoinProbeOperator::has_output() {
+    if (!_try_reference_hash_table()) {
+        return false;
+    }
+    if (!_builder->build_status().ok()) {
+        // Let pull_chunk report the failure of building.
+        return true;
+    }
+    if (_prober->is_empty_output()) {
+        return false;
+    }
+    if (_prober->has_probing_chunk()) {
+        return true;
+    }
+    return _is_input_finished && _prober->need_probe_remain() && !_prober->is_probe_remain_done();
+}
+
+bool HashJoinProbeOperator::need_input() {
+    if (!_try_reference_hash_table() || !_builder->build_status().ok()) {
+        return false;
+    }
+    return !_is_input_finished && !_prober->is_empty_output() && !_prober->has_probing_chunk();
+}
+
+bool HashJoinProbeOperator::is_finished() const {
+    // Not finished until the hash table is built, so that the failure of building could be reported.
+    if (!_is_ht_referenced || !_builder->build_status().ok()) {
+        return false;
+    }
+    if (_prober->is_empty_output()) {
+        return true;
+    }
+    if (!_is_input_finished || _prober->has_probing_chunk()) {
+        return false;
+    }
+    return !_prober->need_probe_remain() || _prober->is_probe_remain_done();
+}
+
+StatusOr<vectorized::ChunkPtr> HashJoinProbeOperator::pull_chunk(RuntimeState* state) {
+    RETURN_IF_ERROR(_builder->build_status());
+    if (_prober->has_probing_chunk()) {
+        return _prober->pull_probe_chunk(state);
+    }
+    return _prober->pull_probe_remain_chunk(state);
+}
+
+Status HashJoinProbeOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    return _prober->push_probe_chunk(state, chunk);
+}
+} // namespace starrocks::pipeline
@@ -0,0 +1,58 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/hash_joiner.h"
+
+namespace starrocks::pipeline {
+// HashJoinProbeOperator probes the hash table built by the HashJoinBuildOperator.
+// Every driver of the probe pipeline has its own prober HashJoiner, which references the only
+// hash table of the builder read-only, so it waits for the builder before consuming any input.
+class HashJoinProbeOperator final : public Operator {
+public:
+    HashJoinProbeOperator(int32_t id, int32_t plan_node_id, vectorized::HashJoinerPtr builder,
+                          vectorized::HashJoinerPtr prober)
+            : Operator(id, "hash_join_probe", plan_node_id),
+              _builder(std::move(builder)),
+              _prober(std::move(prober)) {}
+    ~HashJoinProbeOperator() override = default;
+
+    bool has_output() override;
+    bool need_input() override;
+    bool is_finished() const override;
+    void finish(RuntimeState* state) override { _is_input_finished = true; }
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    // Reference the hash table of the builder once it has been built, return whether it's referenced.
+    bool _try_reference_hash_table();
+
+    vectorized::HashJoinerPtr _builder = nullptr;
+    vectorized::HashJoinerPtr _prober = nullptr;
+    bool _is_ht_referenced = false;
+    bool _is_input_finished = false;
+};
+
+class HashJoinProbeOperatorFactory final : public OperatorFactory {
+public:
+    HashJoinProbeOperatorFactory(int32_t id, int32_t plan_node_id, vectorized::HashJoinerFactoryPtr hash_joiner_factory)
+            : OperatorFactory(id, plan_node_id), _hash_joiner_factory(std::move(hash_joiner_factory)) {}
+
+    ~HashJoinProbeOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<HashJoinProbeOperator>(_id, _plan_node_id,
+                                                       _hash_joiner_factory->get_or_create_builder(),
+                                                       _hash_joiner_factory->create_prober());
+    }
+
+private:
+    vectorized::HashJoinerFactoryPtr _hash_joiner_factory = nullptr;
+};
+} // namespace starrocks::pipeline
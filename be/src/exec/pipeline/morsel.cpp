@@ -0,0 +1,42 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/morsel.h"
+
+#include "storage/storage_engine.h"
+#include "storage/tablet.h"
+#include "storage/tablet_manager.h"
+
+namespace starrocks::pipeline {
+
+static Status split_tablet(int32_t plan_node_id, const TScanRangeParams& scan_range, bool skip_aggregation,
+                           int64_t split_rows, Morsels* morsels) {
+    const auto& internal_scan_range = scan_range.scan_range.internal_scan_range;
+    SchemaHash schema_hash = strtoul(internal_scan_range.schema_hash.c_str(), nullptr, 10);
+    int64_t version = strtoul(internal_scan_range.version.c_str(), nullptr, 10);
+    std::string err;
+    auto tablet = StorageEngine::instance()->tablet_manager()->get_tablet(internal_scan_range.tablet_id,
+                                                                          schema_hash, true, &err);
+    if (tablet == nullptr) {
+        return Status::InternalError(err);
+    }
+    std::vector<vectorized::RowidRangeOptionPtr> ranges;
+    RETURN_IF_ERROR(vectorized::split_tablet_by_rowid_ranges(tablet, version, skip_aggregation, split_rows, &ranges));
+    for (auto& rowid_range_option : ranges) {
+        morsels->emplace_back(std::make_unique<OlapMorsel>(plan_node_id, scan_range, std::move(rowid_range_option)));
+    }
+    return Status::OK();
+}
+
+Morsels split_olap_morsel(int32_t plan_node_id, const TScanRangeParams& scan_range, bool skip_aggregation,
+                          int64_t split_rows) {
+    Morsels morsels;
+    auto status = split_tablet(plan_node_id, scan_range, skip_aggregation, split_rows, &morsels);
+    if (!status.ok() || morsels.empty()) {
+        // Scan the whole tablet, any error of the tablet is reported by the OlapChunkSource.
+        morsels.clear();
+        morsels.emplace_back(std::make_unique<OlapMorsel>(plan_node_id, scan_range));
+    }
+    return morsels;
+}
+
+} // namespace starrocks::pipeline
@@ -6,6 +6,7 @@
 
 #include "gen_cpp/InternalService_types.h"
 #include "storage/olap_common.h"
+#include "storage/vectorized/rowid_range_option.h"
 
 namespace starrocks {
 namespace pipeline {
@@ -32,17 +33,39 @@ public:
         _scan_range = std::make_unique<TInternalScanRange>(scan_range.scan_range.internal_scan_range);
     }
 
+    // The morsel only scans the rowid range of one segment in the tablet of |scan_range|.
+    OlapMorsel(int32_t plan_node_id, const TScanRangeParams& scan_range,
+               vectorized::RowidRangeOptionPtr rowid_range_option)
+            : OlapMorsel(plan_node_id, scan_range) {
+        _rowid_range_option = std::move(rowid_range_option);
+    }
+
     TInternalScanRange* get_scan_range() { return _scan_range.get(); }
 
+    // nullptr means the whole tablet is scanned.
+    const vectorized::RowidRangeOptionPtr& get_rowid_range_option() const { return _rowid_range_option; }
+
 private:
     std::unique_ptr<TInternalScanRange> _scan_range;
+    vectorized::RowidRangeOptionPtr _rowid_range_option = nullptr;
 };
 
+// Split the tablet of |scan_range| into the OlapMorsels each of which scans a rowid range of no more
+// than |split_rows| rows in one segment, the boundaries of the rowid ranges are aligned to the blocks of
+// the short key index. A tablet that has less than |split_rows| rows, or whose rows must be merged
+// across segments (AGG_KEYS and UNIQUE_KEYS without |skip_aggregation|) isn't split.
+Morsels split_olap_morsel(int32_t plan_node_id, const TScanRangeParams& scan_range, bool skip_aggregation,
+                          int64_t split_rows);
+
 class MorselQueue {
 public:
     MorselQueue(Morsels&& morsels) : _morsels(std::move(morsels)), _num_morsels(_morsels.size()), _pop_index(0) {}
 
     size_t num_morsels() const { return _num_morsels; }
+    size_t num_remaining_morsels() const {
+        auto idx = _pop_index.load();
+        return idx >= _num_morsels ? 0 : _num_morsels - idx;
+    }
     std::optional<MorselPtr> try_get() {
         auto idx = _pop_index.load();
         // prevent _num_morsels from superfluous addition
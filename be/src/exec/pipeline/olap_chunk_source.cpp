@@ -42,6 +42,7 @@ Status OlapChunkSource::prepare(RuntimeState* state) {
 
     // 2. Using ColumnValueRange to Build StorageEngine filters
     RETURN_IF_ERROR(details::build_olap_filters(_column_value_ranges, _olap_filter));
+    RETURN_IF_ERROR(details::build_contains_filters(*_slots, _conjunct_ctxs, _olap_filter));
 
     const TQueryOptions& query_options = state->query_options();
     int32_t max_scan_key_num;
@@ -116,6 +117,8 @@ Status OlapChunkSource::_init_reader_params(const std::vector<OlapScanRange*>& k
     params->reader_type = READER_QUERY;
     params->skip_aggregation = _skip_aggregation;
     params->version = Version(0, _version);
+    params->rowid_range_option = _rowid_range_option;
+    params->runtime_predicate = _runtime_predicate;
     params->profile = _scan_profile;
     params->runtime_state = _runtime_state;
     params->use_page_cache = !config::disable_storage_page_cache;
@@ -144,6 +147,18 @@ Status OlapChunkSource::_init_reader_params(const std::vector<OlapScanRange*>& k
         }
     }
 
+    // The rows of the metadata scan are only valid for count(*), min and max without any predicate.
+    if (_metadata_scan && _un_push_down_conjuncts.empty() && _un_push_down_predicates.empty() &&
+        params->predicates.empty() && _runtime_filters.descriptors().empty()) {
+        params->metadata_scan = true;
+        for (const auto& name : _metadata_min_max_columns) {
+            int32_t index = _tablet->field_index(name);
+            if (index >= 0) {
+                params->metadata_min_max_columns.push_back(index);
+            }
+        }
+    }
+
     // Range
     for (auto key_range : key_ranges) {
         if (key_range->begin_scan_range.size() == 1 && key_range->begin_scan_range.get_value(0) == NEGATIVE_INFINITY) {
@@ -288,7 +303,7 @@ Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, vectorized
         if (!_un_push_down_conjuncts.empty()) {
             int64_t old_mem_usage = chunk->memory_usage();
             SCOPED_TIMER(_expr_filter_timer);
-            ExecNode::eval_conjuncts(_un_push_down_conjuncts, chunk);
+            ExecNode::eval_conjuncts(_un_push_down_conjuncts, chunk, nullptr, &_un_push_down_conjunct_order);
             CurrentMemTracker::consume((int64_t)chunk->memory_usage() - old_mem_usage);
             DCHECK_CHUNK(chunk);
         }
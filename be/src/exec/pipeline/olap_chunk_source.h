@@ -12,6 +12,8 @@
 #include "storage/vectorized/conjunctive_predicates.h"
 #include "storage/vectorized/reader.h"
 #include "storage/vectorized/reader_params.h"
+#include "storage/vectorized/runtime_predicate.h"
+#include "util/adaptive_predicate_order.h"
 
 namespace starrocks {
 class SlotDescriptor;
@@ -33,10 +35,23 @@ public:
               _skip_aggregation(skip_aggregation) {
         OlapMorsel* olap_morsel = (OlapMorsel*)_morsel.get();
         _scan_range = olap_morsel->get_scan_range();
+        _rowid_range_option = olap_morsel->get_rowid_range_option();
     }
 
     ~OlapChunkSource() override = default;
 
+    // Must be called before prepare.
+    void set_runtime_predicate(vectorized::RuntimePredicatePtr runtime_predicate) {
+        _runtime_predicate = std::move(runtime_predicate);
+    }
+
+    // Must be called before prepare.
+    // Generate the rows from the segment metadata for count(*), and min and max of |min_max_columns| if possible.
+    void set_metadata_scan(std::vector<std::string> min_max_columns) {
+        _metadata_scan = true;
+        _metadata_min_max_columns = std::move(min_max_columns);
+    }
+
     Status prepare(RuntimeState* state) override;
 
     Status close(RuntimeState* state) override;
@@ -64,6 +79,10 @@ private:
     std::vector<std::string> _key_column_names;
     bool _skip_aggregation;
     TInternalScanRange* _scan_range;
+    vectorized::RowidRangeOptionPtr _rowid_range_option;
+    vectorized::RuntimePredicatePtr _runtime_predicate;
+    bool _metadata_scan = false;
+    std::vector<std::string> _metadata_min_max_columns;
 
     Status _status = Status::OK();
     StatusOr<vectorized::ChunkUniquePtr> _chunk;
@@ -71,6 +90,7 @@ private:
     std::vector<bool> _normalized_conjuncts;
     // The conjuncts couldn't push down to storage engine
     std::vector<ExprContext*> _un_push_down_conjuncts;
+    AdaptivePredicateOrder _un_push_down_conjunct_order;
     vectorized::ConjunctivePredicates _un_push_down_predicates;
     std::vector<uint8_t> _selection;
 
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "column/vectorized_fwd.h"
 #include "common/statusor.h"
 
@@ -47,12 +49,22 @@ public:
     // Push chunk to this operator
     virtual Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) = 0;
 
+    // Whether this operator is unblocked by an external event (chunk arrival, io or rpc completion)
+    // that invokes the driver notifier, so that its driver blocked on this operator need not be polled.
+    virtual bool has_driver_notifier() const { return false; }
+
+    // Set by the driver before prepare, the operator that has driver notifier must invoke it
+    // after has_output, need_input or is_finished turns to true due to the external event.
+    void set_driver_notifier(std::function<void()> notifier) { _driver_notifier = std::move(notifier); }
+
     int32_t get_id() const { return _id; }
 
     int32_t get_plan_node_id() const { return _plan_node_id; }
 
     MemTracker* get_memtracker() const { return _mem_tracker.get(); }
 
+    RuntimeProfile* runtime_profile() const { return _runtime_profile.get(); }
+
     std::string get_name() const { return _name + "_" + std::to_string(_id); }
 
 protected:
@@ -62,6 +74,7 @@ protected:
     int32_t _plan_node_id = -1;
     std::shared_ptr<RuntimeProfile> _runtime_profile;
     std::shared_ptr<MemTracker> _mem_tracker;
+    std::function<void()> _driver_notifier;
 };
 
 class OperatorFactory {
@@ -2,12 +2,92 @@
 
 #include "exec/pipeline/pipeline_builder.h"
 
+#include "common/config.h"
 #include "exec/exec_node.h"
+#include "exec/pipeline/exchange/local_exchange.h"
+#include "exec/pipeline/exchange/local_exchange_sink_operator.h"
+#include "exec/pipeline/exchange/local_exchange_source_operator.h"
 
 namespace starrocks::pipeline {
+
+OpFactories PipelineBuilderContext::maybe_interpolate_local_passthrough_exchange(OpFactories& pred_operators) {
+    auto* source_operator = this->source_operator(pred_operators);
+    if (source_operator->degree_of_parallelism() == 1) {
+        return pred_operators;
+    }
+
+    auto mem_mgr = std::make_shared<LocalExchangeMemoryManager>(config::vector_chunk_size);
+    auto local_exchange_source = std::make_shared<LocalExchangeSourceOperatorFactory>(next_operator_id(), mem_mgr);
+    auto local_exchange = std::make_shared<PassthroughExchanger>(mem_mgr, local_exchange_source.get());
+    auto local_exchange_sink = std::make_shared<LocalExchangeSinkOperatorFactory>(next_operator_id(), local_exchange);
+    // Add LocalExchangeSinkOperator to predecessor pipeline.
+    pred_operators.emplace_back(std::move(local_exchange_sink));
+    // predecessor pipeline comes to end.
+    add_pipeline(pred_operators);
+
+    OpFactories operators_source_with_local_exchange;
+    // Multiple LocalExchangeSinkOperators pipe into one LocalExchangeSourceOperator.
+    local_exchange_source->set_degree_of_parallelism(1);
+    // A new pipeline is created, LocalExchangeSourceOperator is added as the head of the pipeline.
+    operators_source_with_local_exchange.emplace_back(std::move(local_exchange_source));
+    return operators_source_with_local_exchange;
+}
+
+OpFactories PipelineBuilderContext::maybe_interpolate_local_shuffle_exchange(
+        OpFactories& pred_operators, const std::vector<ExprContext*>& partition_expr_ctxs) {
+    auto* source_operator = this->source_operator(pred_operators);
+    const size_t num_sinks = source_operator->degree_of_parallelism();
+    const size_t num_sources = _driver_instance_count;
+    if (num_sources == 1) {
+        return maybe_interpolate_local_passthrough_exchange(pred_operators);
+    }
+
+    // Every LocalExchangeSinkOperator moves the shuffled rows to a LocalExchangeSourceOperator in chunks of
+    // config::vector_chunk_size rows, so the memory limit must be able to hold at least one chunk for each of them.
+    auto mem_mgr = std::make_shared<LocalExchangeMemoryManager>(std::max(num_sinks, num_sources) *
+                                                                config::vector_chunk_size);
+    auto local_exchange_source = std::make_shared<LocalExchangeSourceOperatorFactory>(next_operator_id(), mem_mgr);
+    auto local_exchange = std::make_shared<PartitionExchanger>(mem_mgr, local_exchange_source.get(), true,
+                                                               partition_expr_ctxs, num_sinks);
+    auto local_exchange_sink = std::make_shared<LocalExchangeSinkOperatorFactory>(next_operator_id(), local_exchange);
+    // Add LocalExchangeSinkOperator to predecessor pipeline.
+    pred_operators.emplace_back(std::move(local_exchange_sink));
+    // predecessor pipeline comes to end.
+    add_pipeline(pred_operators);
+
+    OpFactories operators_source_with_local_exchange;
+    // Each LocalExchangeSinkOperator shuffles its chunks into all the LocalExchangeSourceOperators.
+    local_exchange_source->set_degree_of_parallelism(num_sources);
+    // A new pipeline is created, LocalExchangeSourceOperator is added as the head of the pipeline.
+    operators_source_with_local_exchange.emplace_back(std::move(local_exchange_source));
+    return operators_source_with_local_exchange;
+}
+
+OpFactories PipelineBuilderContext::gather_pipelines_to_local_exchange(std::vector<OpFactories>& pred_operators_list) {
+    DCHECK(!pred_operators_list.empty());
+    const size_t num_sources = _driver_instance_count;
+    // Every LocalExchangeSinkOperator moves whole chunks, so the memory limit must be able to
+    // hold at least one chunk for each of the source operators.
+    auto mem_mgr = std::make_shared<LocalExchangeMemoryManager>(num_sources * config::vector_chunk_size);
+    auto local_exchange_source = std::make_shared<LocalExchangeSourceOperatorFactory>(next_operator_id(), mem_mgr);
+    auto local_exchange = std::make_shared<PassthroughExchanger>(mem_mgr, local_exchange_source.get());
+    // The sink operators of all the predecessor pipelines share the same exchanger, the last finished one
+    // of them finishes the source operators.
+    for (auto& pred_operators : pred_operators_list) {
+        pred_operators.emplace_back(
+                std::make_shared<LocalExchangeSinkOperatorFactory>(next_operator_id(), local_exchange));
+        add_pipeline(pred_operators);
+    }
+
+    OpFactories operators_source_with_local_exchange;
+    local_exchange_source->set_degree_of_parallelism(num_sources);
+    operators_source_with_local_exchange.emplace_back(std::move(local_exchange_source));
+    return operators_source_with_local_exchange;
+}
+
 Pipelines PipelineBuilder::build(const FragmentContext& fragment, ExecNode* exec_node) {
     pipeline::OpFactories operators = exec_node->decompose_to_pipeline(&_context);
     _context.add_pipeline(operators);
     return _context.get_pipelines();
 }
-} // namespace starrocks::pipeline
\ No newline at end of file
+} // namespace starrocks::pipeline
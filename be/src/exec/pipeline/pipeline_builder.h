@@ -4,21 +4,50 @@
 
 #include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/pipeline.h"
+#include "exec/pipeline/source_operator.h"
+#include "gutil/casts.h"
 
 namespace starrocks {
 class ExecNode;
+class ExprContext;
 class MemTracker;
 namespace pipeline {
 
 class PipelineBuilderContext {
 public:
-    PipelineBuilderContext(const FragmentContext& fragment_context, uint32_t driver_instance_count)
+    PipelineBuilderContext(FragmentContext* fragment_context, uint32_t driver_instance_count)
             : _fragment_context(fragment_context), _driver_instance_count(driver_instance_count) {}
 
+    // The number of drivers of the pipeline is decided by the degree of parallelism of its source operator.
     void add_pipeline(const OpFactories& operators) {
-        _pipelines.emplace_back(std::make_unique<Pipeline>(next_pipe_id(), _driver_instance_count, operators));
+        _pipelines.emplace_back(std::make_unique<Pipeline>(
+                next_pipe_id(), source_operator(operators)->degree_of_parallelism(), operators));
     }
 
+    // Append a LocalExchangeSinkOperator to pred_operators to gather its output into one driver,
+    // and return the operators starting with the paired LocalExchangeSourceOperator.
+    // pred_operators is returned unchanged if its degree of parallelism is already 1.
+    OpFactories maybe_interpolate_local_passthrough_exchange(OpFactories& pred_operators);
+
+    // Append a LocalExchangeSinkOperator to pred_operators to shuffle its output into
+    // driver_instance_count drivers by partition_expr_ctxs, and return the operators starting
+    // with the paired LocalExchangeSourceOperator.
+    // pred_operators is returned unchanged if only one driver is needed at both sides.
+    OpFactories maybe_interpolate_local_shuffle_exchange(OpFactories& pred_operators,
+                                                         const std::vector<ExprContext*>& partition_expr_ctxs);
+
+    // Append a LocalExchangeSinkOperator to each of pred_operators_list to fan the output of all
+    // the pipelines into one local exchange, and return the operators starting with the paired
+    // LocalExchangeSourceOperator, which has driver_instance_count drivers.
+    OpFactories gather_pipelines_to_local_exchange(std::vector<OpFactories>& pred_operators_list);
+
+    SourceOperatorFactory* source_operator(const OpFactories& operators) {
+        DCHECK(!operators.empty() && operators[0]->is_source());
+        return down_cast<SourceOperatorFactory*>(operators[0].get());
+    }
+
+    FragmentContext* fragment_context() { return _fragment_context; }
+
     uint32_t next_pipe_id() { return _next_pipeline_id++; }
 
     uint32_t next_operator_id() { return _next_operator_id++; }
@@ -30,7 +59,7 @@ public:
     Pipelines get_pipelines() const { return _pipelines; }
 
 private:
-    const FragmentContext& _fragment_context;
+    FragmentContext* _fragment_context;
     Pipelines _pipelines;
     uint32_t _next_pipeline_id = 0;
     uint32_t _next_operator_id = 0;
@@ -4,25 +4,116 @@
 #include "exec/pipeline/pipeline_driver.h"
 
 #include "column/chunk.h"
+#include "exec/pipeline/pipeline_driver_dispatcher.h"
 #include "exec/pipeline/source_operator.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
+#include "util/time.h"
 namespace starrocks {
 namespace pipeline {
 Status PipelineDriver::prepare(RuntimeState* runtime_state) {
     if (_state == DriverState::NOT_READY) {
         source_operator()->add_morsel_queue(_morsel_queue);
+        if (config::pipeline_enable_driver_wakeup) {
+            auto* dispatcher = runtime_state->exec_env()->driver_dispatcher();
+            std::weak_ptr<PipelineDriver> weak_driver = weak_from_this();
+            for (auto& op : _operators) {
+                // Capture weak_ptr, because the notifier may be invoked by io threads or brpc threads
+                // after the driver has finished.
+                op->set_driver_notifier([weak_driver, dispatcher]() {
+                    if (auto driver = weak_driver.lock()) {
+                        dispatcher->wakeup(driver);
+                    }
+                });
+            }
+        }
         for (auto& op : _operators) {
             RETURN_IF_ERROR(op->prepare(runtime_state));
         }
+        if (config::enable_pipeline_perf_counters) {
+            _init_perf_counters(runtime_state);
+        }
+        _init_query_trace();
         _state = DriverState::READY;
     }
     return Status::OK();
 }
+
+void PipelineDriver::_init_perf_counters(RuntimeState* runtime_state) {
+    _runtime_profile = std::make_shared<RuntimeProfile>(strings::Substitute("PipelineDriver (id=$0)", _driver_id));
+    auto add_counters = [](RuntimeProfile* profile, PerfCounters* counters) {
+        for (int i = 0; i < ThreadPerfCounters::NUM_EVENTS; i++) {
+            (*counters)[i] = ADD_COUNTER(profile, ThreadPerfCounters::name(static_cast<ThreadPerfCounters::Event>(i)),
+                                         TUnit::UNIT);
+        }
+    };
+    add_counters(_runtime_profile.get(), &_driver_perf_counters);
+    _operator_perf_counters.resize(_operators.size());
+    for (size_t i = 0; i < _operators.size(); i++) {
+        RuntimeProfile* profile = _operators[i]->runtime_profile();
+        add_counters(profile, &_operator_perf_counters[i]);
+        _runtime_profile->add_child(profile, true, nullptr);
+    }
+    runtime_state->runtime_profile()->add_child(_runtime_profile.get(), true, nullptr);
+}
+
+void PipelineDriver::_init_query_trace() {
+    _query_trace = _query_ctx->query_trace();
+    if (_query_trace == nullptr) {
+        return;
+    }
+    _trace_pull_name_ids.resize(_operators.size());
+    _trace_push_name_ids.resize(_operators.size());
+    for (size_t i = 0; i < _operators.size(); i++) {
+        _trace_pull_name_ids[i] = _query_trace->name_id(_operators[i]->get_name() + ".pull_chunk");
+        _trace_push_name_ids[i] = _query_trace->name_id(_operators[i]->get_name() + ".push_chunk");
+    }
+    _trace_process_name_id = _query_trace->name_id("process");
+    for (uint32_t state = 0; state < _trace_state_name_ids.size(); state++) {
+        _trace_state_name_ids[state] = _query_trace->name_id(ds_to_string(static_cast<DriverState>(state)));
+    }
+    _trace_state_begin_ns = MonotonicNanos();
+}
+
+void PipelineDriver::trace_process(int64_t begin_ns, DriverState state) {
+    if (_query_trace == nullptr) {
+        return;
+    }
+    int64_t end_ns = MonotonicNanos();
+    _query_trace->add_complete_event(QueryTrace::DRIVER_STATE, _trace_state_name_ids[_trace_state],
+                                     _trace_state_begin_ns, begin_ns, _driver_id);
+    _query_trace->add_complete_event(QueryTrace::DRIVER, _trace_process_name_id, begin_ns, end_ns, _driver_id);
+    if (state == DriverState::FINISH || state == DriverState::CANCELED || state == DriverState::INTERNAL_ERROR) {
+        _query_trace->add_instant_event(QueryTrace::DRIVER_STATE, _trace_state_name_ids[state], end_ns, _driver_id);
+    }
+    _trace_state_begin_ns = end_ns;
+    _trace_state = state;
+}
+
+void PipelineDriver::_update_perf_counters(ThreadPerfCounters* counters, size_t index,
+                                           ThreadPerfCounters::Values* begin) {
+    ThreadPerfCounters::Values end;
+    if (!counters->read(&end)) {
+        return;
+    }
+    for (int i = 0; i < ThreadPerfCounters::NUM_EVENTS; i++) {
+        int64_t delta = end[i] - (*begin)[i];
+        COUNTER_UPDATE(_operator_perf_counters[index][i], delta);
+        COUNTER_UPDATE(_driver_perf_counters[i], delta);
+    }
+    *begin = end;
+}
+
 StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
     _state = DriverState::RUNNING;
+    // The notifications arrive after here turn the wakeup state into NOTIFIED.
+    _wakeup_state.store(WakeupState::AWAKE);
     size_t total_chunks_moved = 0;
     int64_t time_spent = 0;
+    // The dispatcher thread running this driver now.
+    ThreadPerfCounters* perf_counters = _operator_perf_counters.empty() ? nullptr : ThreadPerfCounters::get();
+    ThreadPerfCounters::Values perf_values;
     while (true) {
         size_t num_chunk_moved = 0;
         bool should_yield = false;
@@ -57,7 +148,18 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
 
                 // pull chunk from current operator and push the chunk onto next
                 // operator
+                if (perf_counters != nullptr && !perf_counters->read(&perf_values)) {
+                    perf_counters = nullptr;
+                }
+                int64_t trace_begin_ns = _trace_now();
                 auto pulled_chunk = curr_op->pull_chunk(runtime_state);
+                if (perf_counters != nullptr) {
+                    _update_perf_counters(perf_counters, i, &perf_values);
+                }
+                if (_query_trace != nullptr) {
+                    _query_trace->add_complete_event(QueryTrace::OPERATOR, _trace_pull_name_ids[i], trace_begin_ns,
+                                                     MonotonicNanos(), _driver_id);
+                }
                 auto status = pulled_chunk.status();
                 if (!status.ok() && !status.is_end_of_file()) {
                     LOG(WARNING) << " status " << status.to_string();
@@ -72,7 +174,16 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
                 if (status.ok()) {
                     DCHECK(pulled_chunk.value());
                     if (pulled_chunk.value() && pulled_chunk.value()->num_rows() > 0) {
+                        // The events since the pull_chunk, i.e. of the driver itself, are counted into it.
+                        trace_begin_ns = _trace_now();
                         next_op->push_chunk(runtime_state, std::move(pulled_chunk.value()));
+                        if (perf_counters != nullptr) {
+                            _update_perf_counters(perf_counters, i + 1, &perf_values);
+                        }
+                        if (_query_trace != nullptr) {
+                            _query_trace->add_complete_event(QueryTrace::OPERATOR, _trace_push_name_ids[i + 1],
+                                                             trace_begin_ns, MonotonicNanos(), _driver_id);
+                        }
                     }
                     num_chunk_moved += 1;
                     total_chunks_moved += 1;
@@ -4,6 +4,7 @@
 
 #include <gutil/bits.h>
 
+#include <array>
 #include <atomic>
 
 #include "common/statusor.h"
@@ -14,6 +15,9 @@
 #include "exec/pipeline/query_context.h"
 #include "exec/pipeline/source_operator.h"
 #include "runtime/mem_tracker.h"
+#include "util/runtime_profile.h"
+#include "util/thread_perf_counters.h"
+#include "util/time.h"
 
 namespace starrocks {
 class MemTracker;
@@ -100,7 +104,7 @@ private:
     int64_t accumulated_chunk_moved;
 };
 
-class PipelineDriver {
+class PipelineDriver : public std::enable_shared_from_this<PipelineDriver> {
 public:
     PipelineDriver(const Operators& operators, QueryContext* query_ctx, FragmentContext* fragment_ctx,
                    int32_t driver_id, bool is_root)
@@ -125,10 +129,19 @@ public:
     int32_t driver_id() const { return _driver_id; }
     DriverPtr clone() { return std::make_shared<PipelineDriver>(*this); }
     void set_morsel_queue(MorselQueue* morsel_queue) { _morsel_queue = morsel_queue; }
+    MorselQueue* morsel_queue() const { return _morsel_queue; }
     Status prepare(RuntimeState* runtime_state);
     StatusOr<DriverState> process(RuntimeState* runtime_state);
     void finalize(RuntimeState* runtime_state, DriverState state);
+    // Traces a process() from |begin_ns| till now which turned this driver into |state|, and the state it was in
+    // since the last process(), including the time blocked and the time waiting in the driver queue.
+    // A no-op unless the query is traced.
+    void trace_process(int64_t begin_ns, DriverState state);
+    QueryTrace* query_trace() const { return _query_trace; }
     DriverAcct& driver_acct() { return _driver_acct; }
+    // When this driver was put back into the driver queue, for the wait time of the dispatcher.
+    void set_ready_time_ns(int64_t ready_time_ns) { _ready_time_ns = ready_time_ns; }
+    int64_t ready_time_ns() const { return _ready_time_ns; }
     DriverState driver_state() { return _state; }
     void set_driver_state(DriverState state) { _state = state; }
     SourceOperator* source_operator() { return down_cast<SourceOperator*>(_operators.front().get()); }
@@ -150,7 +163,57 @@ public:
 
     bool is_root() const { return _is_root; }
 
+    // A driver blocked on an operator that has driver notifier is parked by PipelineDriverPoller
+    // instead of being polled, and the notifier puts it back to the ready queue. The wakeup state
+    // is reset to AWAKE before each round of process(), a notification that arrives before the
+    // driver is parked turns it into NOTIFIED and fails the parking, so no notification is lost.
+    bool is_wakeup_by_notifier() {
+        if (_state == DriverState::OUTPUT_FULL) {
+            return sink_operator()->has_driver_notifier();
+        } else if (_state == DriverState::INPUT_EMPTY) {
+            return source_operator()->has_driver_notifier();
+        }
+        return false;
+    }
+    bool try_park() {
+        auto expected = WakeupState::AWAKE;
+        return _wakeup_state.compare_exchange_strong(expected, WakeupState::PARKED);
+    }
+    bool try_unpark() {
+        auto expected = WakeupState::PARKED;
+        return _wakeup_state.compare_exchange_strong(expected, WakeupState::AWAKE);
+    }
+    bool is_parked() const { return _wakeup_state.load() == WakeupState::PARKED; }
+    // Return true if the notification unparks the driver, which must be put back by the caller.
+    bool notify() {
+        auto state = _wakeup_state.load();
+        while (true) {
+            if (state == WakeupState::NOTIFIED) {
+                return false;
+            }
+            auto target = state == WakeupState::PARKED ? WakeupState::AWAKE : WakeupState::NOTIFIED;
+            if (_wakeup_state.compare_exchange_weak(state, target)) {
+                return target == WakeupState::AWAKE;
+            }
+        }
+    }
+    // Guarded by the mutex of PipelineDriverPoller.
+    bool is_in_parked_list() const { return _is_in_parked_list; }
+    void set_in_parked_list(bool value) { _is_in_parked_list = value; }
+
 private:
+    enum class WakeupState : uint8_t { AWAKE, NOTIFIED, PARKED };
+
+    using PerfCounters = std::array<RuntimeProfile::Counter*, ThreadPerfCounters::NUM_EVENTS>;
+
+    void _init_perf_counters(RuntimeState* runtime_state);
+    // Add the events since |begin| to the counters of the operator |index| and of this driver, and reset |begin|.
+    void _update_perf_counters(ThreadPerfCounters* counters, size_t index, ThreadPerfCounters::Values* begin);
+
+    void _init_query_trace();
+    // MonotonicNanos() if the query is traced, otherwise 0.
+    int64_t _trace_now() const { return _query_trace != nullptr ? MonotonicNanos() : 0; }
+
     Operators _operators;
     size_t _first_unfinished;
     QueryContext* _query_ctx;
@@ -160,6 +223,7 @@ private:
     int32_t _driver_id;
     const bool _is_root;
     DriverAcct _driver_acct;
+    int64_t _ready_time_ns = 0;
     // The first one is source operator
     MorselQueue* _morsel_queue = nullptr;
     DriverState _state;
@@ -167,6 +231,20 @@ private:
     std::shared_ptr<MemTracker> _mem_tracker = nullptr;
     const size_t _yield_max_chunks_moved;
     const int64_t _yield_max_time_spent;
+    std::atomic<WakeupState> _wakeup_state{WakeupState::AWAKE};
+    bool _is_in_parked_list = false;
+    // The hardware counters of the operators and of this driver, empty unless enable_pipeline_perf_counters.
+    std::vector<PerfCounters> _operator_perf_counters;
+    PerfCounters _driver_perf_counters{};
+    // The trace of the query, nullptr unless enable_query_trace, and the ids of the names of the events.
+    QueryTrace* _query_trace = nullptr;
+    std::vector<int32_t> _trace_pull_name_ids;
+    std::vector<int32_t> _trace_push_name_ids;
+    int32_t _trace_process_name_id = 0;
+    std::array<int32_t, DriverState::PENDING_FINISH + 1> _trace_state_name_ids{};
+    // Since when this driver has been in _trace_state.
+    int64_t _trace_state_begin_ns = 0;
+    DriverState _trace_state = DriverState::READY;
 };
 
 } // namespace pipeline
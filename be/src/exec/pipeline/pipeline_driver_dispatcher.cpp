@@ -2,14 +2,44 @@
 
 #include "exec/pipeline/pipeline_driver_dispatcher.h"
 
+#include <pthread.h>
+
+#include <thread>
+
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/current_thread.h"
+#include "util/cpu_info.h"
+#include "util/starrocks_metrics.h"
+#include "util/time.h"
+
 namespace starrocks {
 namespace pipeline {
+static DriverQueue* create_driver_queue() {
+    if (config::pipeline_enable_resource_group) {
+        return new ResourceGroupDriverQueue();
+    }
+    if (config::pipeline_enable_work_stealing_driver_queue) {
+        return new WorkStealingDriverQueue(std::thread::hardware_concurrency());
+    }
+    return new QuerySharedDriverQueue();
+}
+
 GlobalDriverDispatcher::GlobalDriverDispatcher(std::unique_ptr<ThreadPool> thread_pool)
-        : _driver_queue(new QuerySharedDriverQueue()),
+        : _driver_queue(create_driver_queue()),
           _thread_pool(std::move(thread_pool)),
           _blocked_driver_poller(new PipelineDriverPoller(_driver_queue.get())),
-          _exec_state_reporter(new ExecStateReporter()) {}
+          _exec_state_reporter(new ExecStateReporter()),
+          _metrics(ThreadPoolMetrics::get("pipeline_driver_dispatcher")) {
+    // The queue depth is only needed by the metrics, instead of being counted by every put_back() and take().
+    StarRocksMetrics::instance()->metrics()->register_hook(
+            "pipeline_driver_dispatcher_queue_depth",
+            [this]() { _metrics->queue_depth()->set_value(_driver_queue->size()); });
+}
+
+GlobalDriverDispatcher::~GlobalDriverDispatcher() {
+    StarRocksMetrics::instance()->metrics()->deregister_hook("pipeline_driver_dispatcher_queue_depth");
+}
 
 void GlobalDriverDispatcher::initialize(int num_threads) {
     _blocked_driver_poller->start();
@@ -29,7 +59,23 @@ void GlobalDriverDispatcher::change_num_threads(int32_t num_threads) {
     }
 }
 
+// Pin the current thread to the cores of the NUMA node, so the drivers it takes from its local queue keep running on
+// the node whose memory their chunks and hash tables were allocated from.
+static void bind_to_numa_node(int node) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (int core : CpuInfo::get_cores_of_numa_node(node)) {
+        CPU_SET(core, &cpus);
+    }
+    int res = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    LOG_IF(WARNING, res != 0) << "Failed to bind the pipeline dispatcher thread to NUMA node " << node
+                              << ", res=" << res;
+}
+
 void GlobalDriverDispatcher::run() {
+    if (config::pipeline_numa_aware && CpuInfo::get_max_num_numa_nodes() > 1) {
+        bind_to_numa_node(_next_thread_index.fetch_add(1) % CpuInfo::get_max_num_numa_nodes());
+    }
     while (true) {
         if (_num_threads_setter.should_shrink()) {
             break;
@@ -38,11 +84,13 @@ void GlobalDriverDispatcher::run() {
         size_t queue_index;
         auto driver = this->_driver_queue->take(&queue_index);
         DCHECK(driver != nullptr);
+        _metrics->task_waited(MonotonicNanos() - driver->ready_time_ns());
         auto* fragment_ctx = driver->fragment_ctx();
         auto* runtime_state = fragment_ctx->runtime_state();
 
         if (fragment_ctx->is_canceled()) {
             VLOG_ROW << "[Driver] Canceled: error=" << fragment_ctx->final_status().to_string();
+            _dispatch_reserved_drivers(driver, DriverState::CANCELED);
             if (driver->source_operator()->pending_finish()) {
                 driver->set_driver_state(DriverState::PENDING_FINISH);
                 _blocked_driver_poller->add_blocked_driver(driver);
@@ -52,12 +100,28 @@ void GlobalDriverDispatcher::run() {
             continue;
         }
 
-        auto status = driver->process(runtime_state);
+        StatusOr<DriverState> status;
+        auto* resource_group = driver->query_ctx()->resource_group();
+        {
+            ScopedThreadLocalMemTracker mem_tracker_setter(runtime_state->instance_mem_tracker());
+            CurrentThread::set_sampling_tags(fragment_ctx->query_id(),
+                                             resource_group != nullptr ? resource_group->id() : -1);
+            _metrics->task_started();
+            int64_t process_begin_ns = MonotonicNanos();
+            status = driver->process(runtime_state);
+            _metrics->task_finished(MonotonicNanos() - process_begin_ns);
+            driver->trace_process(process_begin_ns, status.ok() ? status.value() : DriverState::INTERNAL_ERROR);
+            CurrentThread::clear_sampling_tags();
+        }
         this->_driver_queue->get_sub_queue(queue_index)->update_accu_time(driver);
+        if (resource_group != nullptr) {
+            resource_group->incr_cpu_time(driver->driver_acct().get_last_time_spent());
+        }
 
         if (!status.ok()) {
             VLOG_ROW << "[Driver] Process error: error=" << status.status().to_string();
             fragment_ctx->cancel(status.status());
+            _dispatch_reserved_drivers(driver, DriverState::INTERNAL_ERROR);
             if (driver->source_operator()->pending_finish()) {
                 driver->set_driver_state(DriverState::PENDING_FINISH);
                 _blocked_driver_poller->add_blocked_driver(driver);
@@ -67,6 +131,7 @@ void GlobalDriverDispatcher::run() {
             continue;
         }
         auto driver_state = status.value();
+        _dispatch_reserved_drivers(driver, driver_state);
         switch (driver_state) {
         case READY:
         case RUNNING: {
@@ -98,10 +163,24 @@ void GlobalDriverDispatcher::run() {
     }
 }
 
+void GlobalDriverDispatcher::_dispatch_reserved_drivers(const DriverPtr& driver, DriverState state) {
+    for (auto& reserved_driver : driver->fragment_ctx()->take_reserved_drivers(driver.get(), state)) {
+        VLOG_ROW << strings::Substitute("[Driver] Dispatch reserved driver, source=$0, driver_id=$1",
+                                        reserved_driver->source_operator()->get_name(), reserved_driver->driver_id());
+        this->_driver_queue->put_back(reserved_driver);
+    }
+}
+
 void GlobalDriverDispatcher::dispatch(DriverPtr driver) {
     this->_driver_queue->put_back(driver);
 }
 
+void GlobalDriverDispatcher::wakeup(const DriverPtr& driver) {
+    if (driver->notify()) {
+        this->_driver_queue->put_back(driver);
+    }
+}
+
 void GlobalDriverDispatcher::report_exec_state(FragmentContext* fragment_ctx, const Status& status, bool done,
                                                bool clean) {
     this->_exec_state_reporter->submit(fragment_ctx, status, done, clean);
@@ -14,6 +14,7 @@
 #include "runtime/runtime_state.h"
 #include "util/factory_method.h"
 #include "util/limit_setter.h"
+#include "util/thread_pool_metrics.h"
 #include "util/threadpool.h"
 
 namespace starrocks {
@@ -28,6 +29,8 @@ public:
     virtual void initialize(int32_t num_threads) {}
     virtual void change_num_threads(int32_t num_threads) {}
     virtual void dispatch(DriverPtr driver){};
+    // Invoked by the driver notifiers of operators to put back the parked driver.
+    virtual void wakeup(const DriverPtr& driver) {}
 
     // When all the root drivers (the drivers have no successors in the same fragment) have finished,
     // just notify FE timely the completeness of fragment via invocation of report_exec_state, but
@@ -45,21 +48,28 @@ public:
 class GlobalDriverDispatcher final : public FactoryMethod<DriverDispatcher, GlobalDriverDispatcher> {
 public:
     explicit GlobalDriverDispatcher(std::unique_ptr<ThreadPool> thread_pool);
-    ~GlobalDriverDispatcher() override {}
+    ~GlobalDriverDispatcher() override;
     void initialize(int32_t num_threads) override;
     void change_num_threads(int32_t num_threads) override;
     void dispatch(DriverPtr driver) override;
+    void wakeup(const DriverPtr& driver) override;
     void report_exec_state(FragmentContext* fragment_ctx, const Status& status, bool done, bool clean) override;
 
 private:
     void run();
+    // Dispatch the reserved drivers of the adaptive scan pipeline according to the state of |driver|.
+    void _dispatch_reserved_drivers(const DriverPtr& driver, DriverState state);
 
 private:
     LimitSetter _num_threads_setter;
+    // Used to spread the threads over the NUMA nodes, see config::pipeline_numa_aware.
+    std::atomic<size_t> _next_thread_index = 0;
     std::unique_ptr<DriverQueue> _driver_queue;
     std::unique_ptr<ThreadPool> _thread_pool;
     PipelineDriverPollerPtr _blocked_driver_poller;
     std::unique_ptr<ExecStateReporter> _exec_state_reporter;
+    // The ready drivers waiting for and being processed by the dispatcher threads, as the tasks of a thread pool.
+    ThreadPoolMetrics* _metrics;
 };
 
 } // namespace pipeline
@@ -5,6 +5,10 @@
 #include <emmintrin.h>
 
 #include <chrono>
+
+#include "common/config.h"
+#include "util/time.h"
+
 namespace starrocks {
 namespace pipeline {
 
@@ -34,15 +38,19 @@ void PipelineDriverPoller::run_internal() {
             std::unique_lock<std::mutex> lock(this->_mutex);
             local_blocked_drivers.splice(local_blocked_drivers.end(), _blocked_drivers);
             if (local_blocked_drivers.empty() && _blocked_drivers.empty()) {
-                _cond.wait(lock, [this]() {
-                    return !this->_is_shutdown.load(std::memory_order_acquire) && !this->_blocked_drivers.empty();
-                });
+                // parked drivers need not polling, so just wait timed for checking them periodically.
+                _cond.wait_for(lock, std::chrono::milliseconds(config::pipeline_poller_parked_check_interval_ms),
+                               [this]() {
+                                   return this->_is_shutdown.load(std::memory_order_acquire) ||
+                                          !this->_blocked_drivers.empty();
+                               });
                 if (_is_shutdown.load(std::memory_order_acquire)) {
                     break;
                 }
                 local_blocked_drivers.splice(local_blocked_drivers.end(), _blocked_drivers);
             }
         }
+        _check_parked_drivers();
         size_t previous_num_blocked_drivers = local_blocked_drivers.size();
         auto driver_it = local_blocked_drivers.begin();
         while (driver_it != local_blocked_drivers.end()) {
@@ -83,10 +91,58 @@ void PipelineDriverPoller::run_internal() {
 }
 
 void PipelineDriverPoller::add_blocked_driver(DriverPtr driver) {
+    if (config::pipeline_enable_driver_wakeup && driver->is_wakeup_by_notifier()) {
+        _park_driver(driver);
+        return;
+    }
     std::unique_lock<std::mutex> lock(this->_mutex);
     this->_blocked_drivers.push_back(driver);
     this->_cond.notify_one();
 }
 
+void PipelineDriverPoller::_park_driver(const DriverPtr& driver) {
+    {
+        std::lock_guard<std::mutex> lock(this->_mutex);
+        // parking and the bookkeeping of _parked_drivers are both guarded by _mutex, so a driver that
+        // is still in _parked_drivers after it has been unparked and parked again is not added twice.
+        if (driver->try_park()) {
+            if (!driver->is_in_parked_list()) {
+                driver->set_in_parked_list(true);
+                _parked_drivers.push_back(driver);
+            }
+            return;
+        }
+    }
+    // the driver has been notified since its last process(), so it may be unblocked already.
+    _dispatch_queue->put_back(driver);
+}
+
+void PipelineDriverPoller::_check_parked_drivers() {
+    auto now_ms = MonotonicMillis();
+    if (now_ms - _last_check_parked_time_ms < config::pipeline_poller_parked_check_interval_ms) {
+        return;
+    }
+    _last_check_parked_time_ms = now_ms;
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    auto driver_it = _parked_drivers.begin();
+    while (driver_it != _parked_drivers.end()) {
+        auto& driver = *driver_it;
+        if (!driver->is_parked()) {
+            // already woken up by the notifier.
+            driver->set_in_parked_list(false);
+            _parked_drivers.erase(driver_it++);
+        } else if (driver->fragment_ctx()->is_canceled()) {
+            if (driver->try_unpark()) {
+                _dispatch_queue->put_back(driver);
+            }
+            driver->set_in_parked_list(false);
+            _parked_drivers.erase(driver_it++);
+        } else {
+            ++driver_it;
+        }
+    }
+}
+
 } // namespace pipeline
 } // namespace starrocks
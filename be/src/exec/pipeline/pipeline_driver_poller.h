@@ -34,6 +34,10 @@ public:
 
 private:
     void run_internal();
+    // park the driver that is woken up by the driver notifier of its blocking operator.
+    void _park_driver(const DriverPtr& driver);
+    // put back the parked drivers of cancelled fragments, which will never be notified.
+    void _check_parked_drivers();
     PipelineDriverPoller(const PipelineDriverPoller&) = delete;
     PipelineDriverPoller& operator=(const PipelineDriverPoller&) = delete;
 
@@ -41,6 +45,9 @@ private:
     std::mutex _mutex;
     std::condition_variable _cond;
     DriverList _blocked_drivers;
+    // guarded by _mutex, only accessed by the polling thread and _park_driver.
+    DriverList _parked_drivers;
+    int64_t _last_check_parked_time_ms = 0;
     DriverQueue* _dispatch_queue;
     Thread* _polling_thread;
     std::atomic<bool> _is_polling_thread_initialized;
@@ -2,13 +2,20 @@
 
 #include "exec/pipeline/pipeline_driver_queue.h"
 
+#include <algorithm>
+#include <chrono>
+
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
+#include "util/cpu_info.h"
+#include "util/time.h"
 namespace starrocks {
 namespace pipeline {
 void QuerySharedDriverQueue::put_back(const DriverPtr& driver) {
+    driver->set_ready_time_ns(MonotonicNanos());
     int level = driver->driver_acct().get_level();
     {
-        std::unique_lock<std::mutex> lock(_global_mutex);
+        std::unique_lock<ProfiledMutex> lock(_global_mutex);
         _queues[level % QUEUE_SIZE].queue.emplace(driver);
         if (_is_empty) {
             _is_empty = false;
@@ -24,7 +31,7 @@ DriverPtr QuerySharedDriverQueue::take(size_t* queue_index) {
     DriverPtr driver_ptr;
 
     {
-        std::unique_lock<std::mutex> lock(_global_mutex);
+        std::unique_lock<ProfiledMutex> lock(_global_mutex);
         while (true) {
             for (int i = 0; i < QUEUE_SIZE; ++i) {
                 // we just search for queue has element
@@ -60,5 +67,243 @@ SubQuerySharedDriverQueue* QuerySharedDriverQueue::get_sub_queue(size_t index) {
     return _queues + index;
 }
 
+size_t QuerySharedDriverQueue::size() {
+    std::lock_guard<ProfiledMutex> lock(_global_mutex);
+    size_t num_drivers = 0;
+    for (const auto& sub_queue : _queues) {
+        num_drivers += sub_queue.queue.size();
+    }
+    return num_drivers;
+}
+
+// The local queue of the current dispatcher thread, which is assigned when the thread takes
+// from a WorkStealingDriverQueue for the first time.
+static thread_local const WorkStealingDriverQueue* tls_driver_queue = nullptr;
+static thread_local size_t tls_local_queue_index = 0;
+static thread_local int tls_numa_node = -1;
+
+WorkStealingDriverQueue::WorkStealingDriverQueue(size_t num_local_queues) {
+    double factor = 1;
+    for (int i = QUEUE_SIZE - 1; i >= 0; --i) {
+        _levels[i].factor_for_normal = factor;
+        factor *= RATIO_OF_ADJACENT_QUEUE;
+    }
+    num_local_queues = std::max<size_t>(1, num_local_queues);
+    _local_queues.reserve(num_local_queues);
+    for (size_t i = 0; i < num_local_queues; ++i) {
+        _local_queues.emplace_back(std::make_unique<LocalQueue>());
+    }
+}
+
+int WorkStealingDriverQueue::_local_queue_index() const {
+    return tls_driver_queue == this ? static_cast<int>(tls_local_queue_index) : -1;
+}
+
+void WorkStealingDriverQueue::put_back(const DriverPtr& driver) {
+    driver->set_ready_time_ns(MonotonicNanos());
+    int index = _local_queue_index();
+    if (index < 0) {
+        index = _next_put_back_index.fetch_add(1) % _local_queues.size();
+    }
+    int level = driver->driver_acct().get_level();
+    auto* local_queue = _local_queues[index].get();
+    {
+        std::lock_guard<std::mutex> lock(local_queue->mutex);
+        local_queue->levels[level % QUEUE_SIZE].emplace_back(driver);
+        local_queue->num_drivers.fetch_add(1);
+        local_queue->cv.notify_one();
+    }
+
+    // _num_drivers must be increased before _num_waiters is read, and a waiter increases _num_waiters
+    // before checking _num_drivers, so either the waiter sees the driver or it's notified here.
+    _num_drivers.fetch_add(1);
+    if (_num_waiters.load() > 0) {
+        std::lock_guard<std::mutex> lock(_wait_mutex);
+        _cv.notify_one();
+    }
+}
+
+DriverPtr WorkStealingDriverQueue::take(size_t* queue_index) {
+    if (tls_driver_queue != this) {
+        tls_driver_queue = this;
+        tls_local_queue_index = _next_local_queue_index.fetch_add(1) % _local_queues.size();
+        // The dispatcher threads are pinned to a NUMA node before taking any driver.
+        tls_numa_node = config::pipeline_numa_aware ? CpuInfo::get_numa_node_of_core(CpuInfo::get_current_core()) : -1;
+        _local_queues[tls_local_queue_index]->numa_node = tls_numa_node;
+    }
+
+    const size_t num_local_queues = _local_queues.size();
+    while (true) {
+        // Take from the local queue of the current thread first, then steal from the others, those of the threads
+        // in the same NUMA node in the first pass, whose drivers have their memory local to this thread.
+        for (int pass = 0; pass < 2; ++pass) {
+            for (size_t i = 0; i < num_local_queues; ++i) {
+                auto* local_queue = _local_queues[(tls_local_queue_index + i) % num_local_queues].get();
+                if (local_queue->num_drivers.load() == 0 || (local_queue->numa_node == tls_numa_node) != (pass == 0)) {
+                    continue;
+                }
+                DriverPtr driver = _take_from(local_queue, i != 0, queue_index);
+                if (driver != nullptr) {
+                    _num_drivers.fetch_sub(1);
+                    return driver;
+                }
+            }
+        }
+
+        if (_num_drivers.load() > 0) {
+            // The drivers are in the local queues locked by their owners or the other thieves, so wait for a
+            // while on the local queue of the current thread instead of spinning on the locks.
+            auto* local_queue = _local_queues[tls_local_queue_index].get();
+            std::unique_lock<std::mutex> lock(local_queue->mutex);
+            local_queue->cv.wait_for(lock, std::chrono::microseconds(STEAL_RETRY_INTERVAL_US),
+                                     [local_queue] { return local_queue->num_drivers.load() > 0; });
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_wait_mutex);
+        _num_waiters.fetch_add(1);
+        _cv.wait(lock, [this] { return _num_drivers.load() > 0; });
+        _num_waiters.fetch_sub(1);
+    }
+}
+
+DriverPtr WorkStealingDriverQueue::_take_from(LocalQueue* local_queue, bool is_steal, size_t* queue_index) {
+    std::unique_lock<std::mutex> lock(local_queue->mutex, std::defer_lock);
+    if (is_steal) {
+        // don't wait for the owner or the other thieves, just try the next local queue.
+        if (!lock.try_lock()) {
+            return nullptr;
+        }
+    } else {
+        lock.lock();
+    }
+
+    // -1 means no candidates; else has candidate.
+    int queue_idx = -1;
+    double target_accu_time = 0;
+    for (int i = 0; i < QUEUE_SIZE; ++i) {
+        if (!local_queue->levels[i].empty()) {
+            double local_target_time = _levels[i].accu_time_after_divisor();
+            if (queue_idx < 0 || local_target_time < target_accu_time) {
+                target_accu_time = local_target_time;
+                queue_idx = i;
+            }
+        }
+    }
+    if (queue_idx < 0) {
+        return nullptr;
+    }
+
+    *queue_index = queue_idx;
+    auto& level = local_queue->levels[queue_idx];
+    DriverPtr driver_ptr;
+    if (is_steal) {
+        driver_ptr = std::move(level.back());
+        level.pop_back();
+    } else {
+        driver_ptr = std::move(level.front());
+        level.pop_front();
+    }
+    local_queue->num_drivers.fetch_sub(1);
+    return driver_ptr;
+}
+
+SubQuerySharedDriverQueue* WorkStealingDriverQueue::get_sub_queue(size_t index) {
+    return _levels + index;
+}
+
+ResourceGroupDriverQueue::ResourceGroupDriverQueue() {
+    for (const auto& group : ResourceGroupManager::instance()->groups()) {
+        auto group_queue = std::make_unique<GroupQueue>();
+        group_queue->group = group.get();
+        double factor = 1;
+        for (int i = QUEUE_SIZE - 1; i >= 0; --i) {
+            group_queue->levels[i].factor_for_normal = factor;
+            factor *= RATIO_OF_ADJACENT_QUEUE;
+        }
+        _groups.emplace_back(std::move(group_queue));
+    }
+}
+
+void ResourceGroupDriverQueue::put_back(const DriverPtr& driver) {
+    driver->set_ready_time_ns(MonotonicNanos());
+    auto* group = driver->query_ctx()->resource_group();
+    if (group == nullptr) {
+        group = ResourceGroupManager::instance()->default_group();
+    }
+    DCHECK_LT(group->id(), _groups.size());
+    auto* group_queue = _groups[group->id()].get();
+    int level = driver->driver_acct().get_level();
+
+    std::lock_guard<ProfiledMutex> lock(_global_mutex);
+    if (group_queue->num_drivers == 0) {
+        double min_weighted_cpu_time = 0;
+        bool has_busy_group = false;
+        for (const auto& other : _groups) {
+            if (other->num_drivers > 0 && (!has_busy_group || other->weighted_cpu_time() < min_weighted_cpu_time)) {
+                min_weighted_cpu_time = other->weighted_cpu_time();
+                has_busy_group = true;
+            }
+        }
+        if (has_busy_group && group_queue->weighted_cpu_time() < min_weighted_cpu_time) {
+            group_queue->weighted_cpu_time_offset = group->weighted_cpu_time() - min_weighted_cpu_time;
+        }
+    }
+    group_queue->levels[level % QUEUE_SIZE].queue.emplace(driver);
+    group_queue->num_drivers++;
+    if (_num_drivers++ == 0) {
+        _cv.notify_one();
+    }
+}
+
+DriverPtr ResourceGroupDriverQueue::take(size_t* queue_index) {
+    std::unique_lock<ProfiledMutex> lock(_global_mutex);
+    _cv.wait(lock, [this] { return _num_drivers > 0; });
+
+    GroupQueue* target_group = nullptr;
+    for (const auto& group_queue : _groups) {
+        if (group_queue->num_drivers > 0 &&
+            (target_group == nullptr || group_queue->weighted_cpu_time() < target_group->weighted_cpu_time())) {
+            target_group = group_queue.get();
+        }
+    }
+    DCHECK(target_group != nullptr);
+
+    // -1 means no candidates; else has candidate.
+    int queue_idx = -1;
+    double target_accu_time = 0;
+    for (int i = 0; i < QUEUE_SIZE; ++i) {
+        if (!target_group->levels[i].queue.empty()) {
+            double local_target_time = target_group->levels[i].accu_time_after_divisor();
+            if (queue_idx < 0 || local_target_time < target_accu_time) {
+                target_accu_time = local_target_time;
+                queue_idx = i;
+            }
+        }
+    }
+    DCHECK_GE(queue_idx, 0);
+
+    *queue_index = target_group->group->id() * QUEUE_SIZE + queue_idx;
+    auto& queue = target_group->levels[queue_idx].queue;
+    DriverPtr driver_ptr = std::move(queue.front());
+    queue.pop();
+    target_group->num_drivers--;
+    // Wake up another waiter if there are drivers left, because put_back only notifies one waiter
+    // when the queue turns non-empty.
+    if (--_num_drivers > 0) {
+        _cv.notify_one();
+    }
+    return driver_ptr;
+}
+
+SubQuerySharedDriverQueue* ResourceGroupDriverQueue::get_sub_queue(size_t index) {
+    return _groups[index / QUEUE_SIZE]->levels + index % QUEUE_SIZE;
+}
+
+size_t ResourceGroupDriverQueue::size() {
+    std::lock_guard<ProfiledMutex> lock(_global_mutex);
+    return _num_drivers;
+}
+
 } // namespace pipeline
 } // namespace starrocks
\ No newline at end of file
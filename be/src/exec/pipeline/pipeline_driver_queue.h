@@ -2,10 +2,14 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <queue>
 
 #include "exec/pipeline/pipeline_driver.h"
+#include "exec/pipeline/resource_group.h"
 #include "util/factory_method.h"
+#include "util/lock_profiler.h"
 namespace starrocks {
 namespace pipeline {
 class DriverQueue;
@@ -33,6 +37,8 @@ public:
     virtual DriverPtr take(size_t* queue_index) = 0;
     virtual ~DriverQueue(){};
     virtual SubQuerySharedDriverQueue* get_sub_queue(size_t) = 0;
+    // The number of the ready drivers in the queue.
+    virtual size_t size() = 0;
 };
 
 class QuerySharedDriverQueue : public FactoryMethod<DriverQueue, QuerySharedDriverQueue> {
@@ -54,16 +60,108 @@ public:
     static const size_t QUEUE_SIZE = 8;
     // maybe other value for ratio.
     static constexpr double RATIO_OF_ADJACENT_QUEUE = 1.7;
-    void put_back(const DriverPtr& driver);
+    void put_back(const DriverPtr& driver) override;
     DriverPtr take(size_t* queue_index) override;
     SubQuerySharedDriverQueue* get_sub_queue(size_t) override;
+    size_t size() override;
 
 private:
     SubQuerySharedDriverQueue _queues[QUEUE_SIZE];
-    std::mutex _global_mutex;
-    std::condition_variable _cv;
+    ProfiledMutex _global_mutex{LockSite::get("query_shared_driver_queue")};
+    std::condition_variable_any _cv;
     std::atomic<bool> _is_empty;
 };
 
+// WorkStealingDriverQueue has the same multilevel feedback priority as QuerySharedDriverQueue, but the
+// ready drivers are kept in per-thread local queues instead of behind a single global lock. A dispatcher
+// thread puts back the drivers it has just executed into its own local queue and takes from it, and steals
+// from the other local queues only when its own is empty. The drivers put back by other threads, e.g. the
+// dispatched and the unblocked ones, are spread over the local queues in a round-robin way.
+class WorkStealingDriverQueue : public FactoryMethod<DriverQueue, WorkStealingDriverQueue> {
+    friend class FactoryMethod<DriverQueue, WorkStealingDriverQueue>;
+
+public:
+    explicit WorkStealingDriverQueue(size_t num_local_queues);
+    ~WorkStealingDriverQueue() override {}
+
+    static const size_t QUEUE_SIZE = QuerySharedDriverQueue::QUEUE_SIZE;
+    static constexpr double RATIO_OF_ADJACENT_QUEUE = QuerySharedDriverQueue::RATIO_OF_ADJACENT_QUEUE;
+    // How long a thread waits on its local queue after failing to steal any driver before trying again.
+    static constexpr int64_t STEAL_RETRY_INTERVAL_US = 100;
+    void put_back(const DriverPtr& driver) override;
+    DriverPtr take(size_t* queue_index) override;
+    SubQuerySharedDriverQueue* get_sub_queue(size_t) override;
+    size_t size() override { return _num_drivers.load(); }
+
+private:
+    struct LocalQueue {
+        std::mutex mutex;
+        std::deque<DriverPtr> levels[QUEUE_SIZE];
+        // notified when a driver is put back, so that the owner waits for it rather than spinning on the
+        // local queues locked by the others.
+        std::condition_variable cv;
+        // number of drivers in all the levels, it could be read without the mutex.
+        std::atomic<size_t> num_drivers = 0;
+        // NUMA node of the owner thread, or -1 if unknown, see config::pipeline_numa_aware.
+        std::atomic<int> numa_node = -1;
+    };
+
+    // Return the index of the local queue of the current thread, or -1 if the current thread
+    // has never taken from this queue, i.e. it's not a dispatcher thread.
+    int _local_queue_index() const;
+    // Take a driver from the level of the least normalized accumulated time.
+    // The owner takes from the front of the level in FIFO order, while the thieves steal from the back.
+    DriverPtr _take_from(LocalQueue* local_queue, bool is_steal, size_t* queue_index);
+
+    // Only used for the accumulated execution time of each level, the drivers are in _local_queues.
+    SubQuerySharedDriverQueue _levels[QUEUE_SIZE];
+    std::vector<std::unique_ptr<LocalQueue>> _local_queues;
+    std::atomic<size_t> _next_local_queue_index = 0;
+    std::atomic<size_t> _next_put_back_index = 0;
+
+    // Used to park the dispatcher threads when all the local queues are empty.
+    std::atomic<size_t> _num_drivers = 0;
+    std::atomic<size_t> _num_waiters = 0;
+    std::mutex _wait_mutex;
+    std::condition_variable _cv;
+};
+
+// ResourceGroupDriverQueue picks the resource group of the least accumulated CPU time normalized by its
+// weight first, and then picks the driver of the group by the same multilevel feedback priority as
+// QuerySharedDriverQueue, so the groups share the CPU in proportion to their weights.
+// The queue index is group_id * QUEUE_SIZE + level.
+class ResourceGroupDriverQueue : public FactoryMethod<DriverQueue, ResourceGroupDriverQueue> {
+    friend class FactoryMethod<DriverQueue, ResourceGroupDriverQueue>;
+
+public:
+    ResourceGroupDriverQueue();
+    ~ResourceGroupDriverQueue() override {}
+
+    static const size_t QUEUE_SIZE = QuerySharedDriverQueue::QUEUE_SIZE;
+    static constexpr double RATIO_OF_ADJACENT_QUEUE = QuerySharedDriverQueue::RATIO_OF_ADJACENT_QUEUE;
+    void put_back(const DriverPtr& driver) override;
+    DriverPtr take(size_t* queue_index) override;
+    SubQuerySharedDriverQueue* get_sub_queue(size_t) override;
+    size_t size() override;
+
+private:
+    struct GroupQueue {
+        ResourceGroup* group = nullptr;
+        SubQuerySharedDriverQueue levels[QUEUE_SIZE];
+        size_t num_drivers = 0;
+        // A group doesn't catch up the CPU time it hasn't used while it's idle, otherwise it would
+        // monopolize the CPU for a while after it becomes busy again, so the CPU time is offset
+        // to that of the busy groups when it becomes busy.
+        double weighted_cpu_time_offset = 0;
+
+        double weighted_cpu_time() const { return group->weighted_cpu_time() - weighted_cpu_time_offset; }
+    };
+
+    std::vector<std::unique_ptr<GroupQueue>> _groups;
+    ProfiledMutex _global_mutex{LockSite::get("resource_group_driver_queue")};
+    std::condition_variable_any _cv;
+    size_t _num_drivers = 0;
+};
+
 } // namespace pipeline
 } // namespace starrocks
\ No newline at end of file
@@ -1,7 +1,25 @@
 // This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
 #include "exec/pipeline/query_context.h"
+
+#include "gutil/strings/substitute.h"
+
 namespace starrocks {
 namespace pipeline {
+Status QueryContext::init_resource_group(const std::string& group_name) {
+    std::lock_guard lock(_resource_group_lock);
+    if (_resource_group.load() != nullptr) {
+        return Status::OK();
+    }
+    auto* group = ResourceGroupManager::instance()->get(group_name);
+    if (!group->try_incr_num_running_queries()) {
+        return Status::TooManyTasks(
+                strings::Substitute("the number of running queries of resource group $0 reaches its limit($1)",
+                                    group->name(), group->concurrency_limit()));
+    }
+    _resource_group.store(group);
+    return Status::OK();
+}
+
 QueryContextManager::QueryContextManager() {}
 QueryContextManager::~QueryContextManager() {}
 QueryContext* QueryContextManager::get_or_register(const TUniqueId& query_id) {
@@ -13,6 +31,7 @@ QueryContext* QueryContextManager::get_or_register(const TUniqueId& query_id) {
 
     auto&& ctx = std::make_unique<QueryContext>();
     auto* ctx_raw_ptr = ctx.get();
+    ctx->set_query_trace(QueryTraceManager::instance()->register_query(query_id));
     _contexts.emplace(query_id, std::move(ctx));
     return ctx_raw_ptr;
 }
@@ -7,6 +7,8 @@
 #include <unordered_map>
 
 #include "exec/pipeline/pipeline_fwd.h"
+#include "exec/pipeline/query_trace.h"
+#include "exec/pipeline/resource_group.h"
 #include "gen_cpp/InternalService_types.h" // for TQueryOptions
 #include "gen_cpp/Types_types.h"           // for TUniqueId
 #include "runtime/mem_tracker.h"
@@ -21,6 +23,11 @@ namespace pipeline {
 class QueryContext {
 public:
     QueryContext() : _num_fragments_initialized(false), _num_fragments(0) {}
+    ~QueryContext() {
+        if (auto* group = _resource_group.load(); group != nullptr) {
+            group->decr_num_running_queries();
+        }
+    }
     RuntimeState* get_runtime_state() { return _runtime_state.get(); }
     void set_num_fragments(size_t num_fragments) {
         bool old_value = false;
@@ -30,6 +37,16 @@ public:
     }
     bool count_down_fragment() { return _num_fragments.fetch_sub(1) == 1; }
 
+    // Admit the query into the resource group named |group_name|, or the default group if there isn't
+    // such a group. Only the first fragment of the query in this BE is counted by the concurrency limit.
+    Status init_resource_group(const std::string& group_name);
+    // nullptr if the query hasn't been admitted into any resource group.
+    ResourceGroup* resource_group() const { return _resource_group.load(); }
+
+    // nullptr if the query isn't traced, see config::enable_query_trace.
+    QueryTrace* query_trace() const { return _query_trace.get(); }
+    void set_query_trace(QueryTracePtr query_trace) { _query_trace = std::move(query_trace); }
+
 private:
     std::unique_ptr<RuntimeState> _runtime_state;
     std::shared_ptr<RuntimeProfile> _runtime_profile;
@@ -38,6 +55,9 @@ private:
     TUniqueId _query_id;
     std::atomic<bool> _num_fragments_initialized;
     std::atomic<size_t> _num_fragments;
+    std::mutex _resource_group_lock;
+    std::atomic<ResourceGroup*> _resource_group{nullptr};
+    QueryTracePtr _query_trace;
 };
 
 class QueryContextManager {
@@ -0,0 +1,135 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/query_trace.h"
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "util/thread.h"
+#include "util/uid_util.h"
+
+namespace starrocks::pipeline {
+
+static const char* const CATEGORY_NAMES[QueryTrace::NUM_CATEGORIES] = {"driver", "driver_state", "operator", "io",
+                                                                       "rpc"};
+// The meaning of the arg of the events of each category.
+static const char* const ARG_NAMES[QueryTrace::NUM_CATEGORIES] = {"driver_id", "driver_id", "driver_id",
+                                                                  "queue_wait_ns", "bytes"};
+
+static int64_t cached_thread_id() {
+    static thread_local int64_t tls_thread_id = Thread::current_thread_id();
+    return tls_thread_id;
+}
+
+QueryTrace::QueryTrace(const TUniqueId& query_id, size_t max_events)
+        : _query_id(query_id), _max_events(max_events), _start_ns(MonotonicNanos()) {}
+
+int32_t QueryTrace::name_id(const std::string& name) {
+    std::lock_guard<std::mutex> l(_names_lock);
+    auto [it, inserted] = _name_ids.emplace(name, _names.size());
+    if (inserted) {
+        _names.emplace_back(name);
+    }
+    return it->second;
+}
+
+void QueryTrace::_add_event(Category category, int32_t name_id, int64_t begin_ns, int64_t duration_ns, int64_t arg) {
+    if (_num_events.fetch_add(1, std::memory_order_relaxed) >= _max_events) {
+        _num_events.fetch_sub(1, std::memory_order_relaxed);
+        _num_dropped_events.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    int64_t thread_id = cached_thread_id();
+    auto& shard = _shards[thread_id % NUM_SHARDS];
+    std::lock_guard<std::mutex> l(shard.lock);
+    shard.events.push_back({begin_ns, duration_ns, thread_id, arg, name_id, category});
+}
+
+std::string QueryTrace::to_chrome_json() const {
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> l(_names_lock);
+        names = _names;
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("traceEvents");
+    writer.StartArray();
+    for (const auto& shard : _shards) {
+        std::lock_guard<std::mutex> l(shard.lock);
+        for (const auto& event : shard.events) {
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(names[event.name_id].c_str(), names[event.name_id].size());
+            writer.Key("cat");
+            writer.String(CATEGORY_NAMES[event.category]);
+            writer.Key("ph");
+            writer.String(event.duration_ns < 0 ? "i" : "X");
+            // The timestamps are in microseconds, relative to the creation of the trace.
+            writer.Key("ts");
+            writer.Double((event.begin_ns - _start_ns) / 1000.0);
+            if (event.duration_ns < 0) {
+                // Scoped to the thread.
+                writer.Key("s");
+                writer.String("t");
+            } else {
+                writer.Key("dur");
+                writer.Double(event.duration_ns / 1000.0);
+            }
+            writer.Key("pid");
+            writer.Int(0);
+            writer.Key("tid");
+            writer.Int64(event.thread_id);
+            writer.Key("args");
+            writer.StartObject();
+            writer.Key(ARG_NAMES[event.category]);
+            writer.Int64(event.arg);
+            writer.EndObject();
+            writer.EndObject();
+        }
+    }
+    writer.EndArray();
+    writer.Key("query_id");
+    std::string query_id = print_id(_query_id);
+    writer.String(query_id.c_str(), query_id.size());
+    writer.Key("num_dropped_events");
+    writer.Uint64(num_dropped_events());
+    writer.EndObject();
+    return buffer.GetString();
+}
+
+QueryTraceManager::QueryTraceManager() {}
+QueryTraceManager::~QueryTraceManager() {}
+
+QueryTracePtr QueryTraceManager::register_query(const TUniqueId& query_id) {
+    if (!config::enable_query_trace) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _traces.find(query_id);
+    if (it != _traces.end()) {
+        return it->second;
+    }
+    auto trace = std::make_shared<QueryTrace>(query_id, std::max<int64_t>(config::query_trace_max_events, 0));
+    _traces.emplace(query_id, trace);
+    _query_ids.push_back(query_id);
+    while (_query_ids.size() > static_cast<size_t>(std::max<int32_t>(config::query_trace_retained_num, 1))) {
+        // The running queries keep their traces by themselves.
+        _traces.erase(_query_ids.front());
+        _query_ids.pop_front();
+    }
+    return trace;
+}
+
+QueryTracePtr QueryTraceManager::get(const TUniqueId& query_id) {
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _traces.find(query_id);
+    return it != _traces.end() ? it->second : nullptr;
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,114 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gen_cpp/Types_types.h" // for TUniqueId
+#include "storage/olap_define.h"
+#include "util/hash_util.hpp"
+#include "util/time.h"
+
+namespace starrocks::pipeline {
+
+// The timeline of one query in this BE: when each driver ran, which state it was blocked in afterwards, and the
+// operator calls, io tasks and rpcs in between, each with the thread it happened on. It is exported in the Chrome
+// trace event format, to be opened by chrome://tracing or Perfetto.
+//
+// The events are appended to the buffer of the shard of the calling thread, so the threads hardly contend with each
+// other. Once the trace is full, the events are dropped and counted instead.
+class QueryTrace {
+public:
+    enum Category : uint8_t {
+        DRIVER = 0,
+        DRIVER_STATE,
+        OPERATOR,
+        IO,
+        RPC,
+        NUM_CATEGORIES,
+    };
+
+    QueryTrace(const TUniqueId& query_id, size_t max_events);
+
+    QueryTrace(const QueryTrace&) = delete;
+    void operator=(const QueryTrace&) = delete;
+
+    const TUniqueId& query_id() const { return _query_id; }
+
+    // The id of the event name |name|, to add the events without copying the name each time.
+    int32_t name_id(const std::string& name);
+
+    // An event from |begin_ns| to |end_ns| of MonotonicNanos(), e.g. a process() of the driver |arg|.
+    void add_complete_event(Category category, int32_t name_id, int64_t begin_ns, int64_t end_ns, int64_t arg) {
+        _add_event(category, name_id, begin_ns, end_ns - begin_ns, arg);
+    }
+    // An event at |ts_ns| of MonotonicNanos().
+    void add_instant_event(Category category, int32_t name_id, int64_t ts_ns, int64_t arg) {
+        _add_event(category, name_id, ts_ns, -1, arg);
+    }
+
+    size_t num_events() const { return _num_events.load(std::memory_order_relaxed); }
+    size_t num_dropped_events() const { return _num_dropped_events.load(std::memory_order_relaxed); }
+
+    // {"traceEvents": [...]} of the Chrome trace event format.
+    std::string to_chrome_json() const;
+
+private:
+    struct Event {
+        int64_t begin_ns;
+        // -1 for an instant event.
+        int64_t duration_ns;
+        int64_t thread_id;
+        int64_t arg;
+        int32_t name_id;
+        Category category;
+    };
+
+    struct alignas(64) Shard {
+        std::mutex lock;
+        std::vector<Event> events;
+    };
+
+    static constexpr size_t NUM_SHARDS = 32;
+
+    void _add_event(Category category, int32_t name_id, int64_t begin_ns, int64_t duration_ns, int64_t arg);
+
+    const TUniqueId _query_id;
+    const size_t _max_events;
+    const int64_t _start_ns;
+    std::atomic<size_t> _num_events{0};
+    std::atomic<size_t> _num_dropped_events{0};
+    mutable Shard _shards[NUM_SHARDS];
+
+    mutable std::mutex _names_lock;
+    std::vector<std::string> _names;
+    std::unordered_map<std::string, int32_t> _name_ids;
+};
+
+using QueryTracePtr = std::shared_ptr<QueryTrace>;
+
+// The traces of the running queries and of the last config::query_trace_retained_num finished ones, so that a trace
+// can still be fetched by the http action after its query is finished.
+class QueryTraceManager {
+    DECLARE_SINGLETON(QueryTraceManager);
+
+public:
+    // Creates the trace of the query if config::enable_query_trace, otherwise returns nullptr.
+    QueryTracePtr register_query(const TUniqueId& query_id);
+    // nullptr if the query isn't traced.
+    QueryTracePtr get(const TUniqueId& query_id);
+
+private:
+    std::mutex _lock;
+    std::unordered_map<TUniqueId, QueryTracePtr> _traces;
+    // The ids of the traces in the order they were registered, to evict the oldest ones.
+    std::deque<TUniqueId> _query_ids;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,67 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/resource_group.h"
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gutil/strings/numbers.h"
+#include "gutil/strings/split.h"
+
+namespace starrocks {
+namespace pipeline {
+
+bool ResourceGroup::try_incr_num_running_queries() {
+    if (_concurrency_limit <= 0) {
+        _num_running_queries.fetch_add(1);
+        return true;
+    }
+    auto num_running_queries = _num_running_queries.load();
+    while (num_running_queries < _concurrency_limit) {
+        if (_num_running_queries.compare_exchange_weak(num_running_queries, num_running_queries + 1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ResourceGroupManager::ResourceGroupManager() {
+    _groups.emplace_back(std::make_unique<ResourceGroup>(DEFAULT_GROUP_ID, DEFAULT_GROUP_NAME, 1, 0));
+    _parse_groups(config::pipeline_resource_groups);
+    for (auto& group : _groups) {
+        _groups_by_name[group->name()] = group.get();
+    }
+}
+
+ResourceGroupManager::~ResourceGroupManager() {}
+
+// The format is "name:cpu_weight:concurrency_limit;...", the invalid groups are ignored.
+void ResourceGroupManager::_parse_groups(const std::string& groups) {
+    for (const auto& group : strings::Split(groups, ";", strings::SkipWhitespace())) {
+        std::vector<std::string> fields = strings::Split(group, ":");
+        int64_t cpu_weight = 0;
+        int32_t concurrency_limit = 0;
+        if (fields.size() != 3 || fields[0].empty() || !safe_strto64(fields[1], &cpu_weight) || cpu_weight <= 0 ||
+            !safe_strto32(fields[2], &concurrency_limit) || concurrency_limit < 0) {
+            LOG(WARNING) << "Ignore the invalid resource group: " << group;
+            continue;
+        }
+        if (fields[0] == DEFAULT_GROUP_NAME) {
+            // The default group could be redefined.
+            _groups[DEFAULT_GROUP_ID] =
+                    std::make_unique<ResourceGroup>(DEFAULT_GROUP_ID, fields[0], cpu_weight, concurrency_limit);
+            continue;
+        }
+        _groups.emplace_back(std::make_unique<ResourceGroup>(_groups.size(), fields[0], cpu_weight, concurrency_limit));
+    }
+}
+
+ResourceGroup* ResourceGroupManager::get(const std::string& name) const {
+    auto it = _groups_by_name.find(name);
+    if (it == _groups_by_name.end()) {
+        return default_group();
+    }
+    return it->second;
+}
+
+} // namespace pipeline
+} // namespace starrocks
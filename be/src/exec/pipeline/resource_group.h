@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/olap_define.h"
+
+namespace starrocks {
+namespace pipeline {
+
+class ResourceGroup;
+using ResourceGroupPtr = std::unique_ptr<ResourceGroup>;
+
+// ResourceGroup divides the CPU among the queries of different kinds in one BE. The drivers of the
+// queries in the same group share the CPU time of the group, which is proportional to its cpu_weight
+// when the groups compete for the CPU, and the number of running queries of the group is limited by
+// its concurrency_limit.
+class ResourceGroup {
+public:
+    ResourceGroup(size_t id, std::string name, int64_t cpu_weight, int32_t concurrency_limit)
+            : _id(id), _name(std::move(name)), _cpu_weight(cpu_weight), _concurrency_limit(concurrency_limit) {}
+
+    size_t id() const { return _id; }
+    const std::string& name() const { return _name; }
+    int64_t cpu_weight() const { return _cpu_weight; }
+    int32_t concurrency_limit() const { return _concurrency_limit; }
+
+    // Charge the time in nano-seconds spent on core by a driver of the group.
+    void incr_cpu_time(int64_t time_spent) { _accu_cpu_time.fetch_add(time_spent, std::memory_order_relaxed); }
+    int64_t accu_cpu_time() const { return _accu_cpu_time.load(std::memory_order_relaxed); }
+    // The accumulated CPU time normalized by the weight, the group of the least one is owed the most CPU.
+    double weighted_cpu_time() const { return static_cast<double>(accu_cpu_time()) / _cpu_weight; }
+
+    // Return false if the concurrency limit has been reached, otherwise count in a new running query.
+    bool try_incr_num_running_queries();
+    void decr_num_running_queries() { _num_running_queries.fetch_sub(1); }
+    int32_t num_running_queries() const { return _num_running_queries.load(); }
+
+private:
+    const size_t _id;
+    const std::string _name;
+    const int64_t _cpu_weight;
+    // 0 means unlimited.
+    const int32_t _concurrency_limit;
+    std::atomic<int64_t> _accu_cpu_time{0};
+    std::atomic<int32_t> _num_running_queries{0};
+};
+
+// ResourceGroupManager holds the resource groups defined by config::pipeline_resource_groups and the
+// default group, the ids of the groups are their indexes in groups().
+class ResourceGroupManager {
+    DECLARE_SINGLETON(ResourceGroupManager);
+
+public:
+    // Return the group named |name|, or the default group if there isn't such a group.
+    ResourceGroup* get(const std::string& name) const;
+    ResourceGroup* default_group() const { return _groups[DEFAULT_GROUP_ID].get(); }
+    const std::vector<ResourceGroupPtr>& groups() const { return _groups; }
+
+    static constexpr size_t DEFAULT_GROUP_ID = 0;
+    static constexpr const char* DEFAULT_GROUP_NAME = "default";
+
+private:
+    void _parse_groups(const std::string& groups);
+
+    std::vector<ResourceGroupPtr> _groups;
+    std::unordered_map<std::string, ResourceGroup*> _groups_by_name;
+};
+
+} // namespace pipeline
+} // namespace starrocks
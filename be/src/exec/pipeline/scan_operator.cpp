@@ -2,70 +2,143 @@
 
 #include "exec/pipeline/scan_operator.h"
 
+#include <algorithm>
+
 #include "column/chunk.h"
+#include "common/config.h"
 #include "exec/pipeline/olap_chunk_source.h"
+#include "gutil/casts.h"
+#include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
+#include "util/time.h"
 
 namespace starrocks::pipeline {
-void ScanOperator::_pickup_morsel(RuntimeState* state) {
+bool ScanOperator::_pickup_morsel(RuntimeState* state, ChunkSourcePtr* chunk_source) {
     DCHECK(_morsel_queue != nullptr);
-    if (_chunk_source) {
-        _chunk_source->close(state);
+    if (*chunk_source) {
+        (*chunk_source)->close(state);
     }
     auto maybe_morsel = _morsel_queue->try_get();
     if (!maybe_morsel.has_value()) {
-        // release _chunk_source before _curr_morsel, because _chunk_source depends on _curr_morsel.
-        _chunk_source = nullptr;
-        _is_finished = true;
-    } else {
-        auto morsel = std::move(maybe_morsel.value());
-        DCHECK(morsel);
-        _chunk_source = starrocks::make_exclusive<OlapChunkSource>(
-                std::move(morsel), _olap_scan_node.tuple_id, _conjunct_ctxs, _runtime_filters,
-                _olap_scan_node.key_column_name, _olap_scan_node.is_preaggregation);
-        _chunk_source->prepare(state);
-        _trigger_read_chunk();
+        // release the chunk source before _curr_morsel, because the chunk source depends on _curr_morsel.
+        *chunk_source = nullptr;
+        return false;
+    }
+    auto morsel = std::move(maybe_morsel.value());
+    DCHECK(morsel);
+    *chunk_source = starrocks::make_exclusive<OlapChunkSource>(
+            std::move(morsel), _olap_scan_node.tuple_id, _conjunct_ctxs, _runtime_filters,
+            _olap_scan_node.key_column_name, _olap_scan_node.is_preaggregation);
+    auto* olap_chunk_source = down_cast<OlapChunkSource*>(chunk_source->get());
+    olap_chunk_source->set_runtime_predicate(_runtime_predicate);
+    if (_olap_scan_node.__isset.metadata_scan && _olap_scan_node.metadata_scan) {
+        olap_chunk_source->set_metadata_scan(_olap_scan_node.metadata_min_max_columns);
     }
+    (*chunk_source)->prepare(state);
+    return true;
 }
-void ScanOperator::_trigger_read_chunk() {
-    if (_io_threads == nullptr) {
+
+// Start the i-th io task on the next morsel, the operator is finished once no morsel is left for any io task.
+void ScanOperator::_pickup_morsel_nonblocking(RuntimeState* state, size_t i) {
+    DCHECK(!_chunk_source_futures[i].has_value());
+    if (_pickup_morsel(state, &_chunk_sources[i])) {
+        _trigger_read_chunk(i);
         return;
     }
-    DCHECK(!_pending_chunk_source_future.has_value());
-    // no io task is pending, so create a pending io task.
-    DCHECK(_chunk_source);
-    auto chunk_source = _chunk_source;
+    bool all_drained = true;
+    for (size_t j = 0; j < _chunk_sources.size() && all_drained; ++j) {
+        all_drained = !_chunk_sources[j] && !_chunk_source_futures[j].has_value();
+    }
+    _is_finished = all_drained;
+}
+
+bool ScanOperator::_is_io_task_completed(size_t i) const {
+    const auto& future = _chunk_source_futures[i];
+    return future.has_value() && future.value().wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+}
+
+bool ScanOperator::_has_pending_io_tasks() const {
+    for (const auto& future : _chunk_source_futures) {
+        if (future.has_value()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ScanOperator::_trigger_read_chunk(size_t i) {
+    DCHECK(_io_threads != nullptr);
+    DCHECK(!_chunk_source_futures[i].has_value());
+    // no io task is pending on the i-th chunk source, so create a pending io task.
+    DCHECK(_chunk_sources[i]);
+    auto chunk_source = _chunk_sources[i];
     auto chunk_source_promise = starrocks::make_exclusive<ChunkSourcePromise>();
-    _pending_chunk_source_future = chunk_source_promise->get_future();
+    _chunk_source_futures[i] = chunk_source_promise->get_future();
+    // The io task blocks its thread till the chunk is read, the reads of the segment iterators are synchronous all
+    // the way down to the block files. So the reads of the operator are kept in flight by up to
+    // pipeline_scan_io_tasks_per_operator io tasks, each on a morsel of its own, and the completion of any of them
+    // notifies the driver.
     PriorityThreadPool::Task task;
 
-    task.work_function = [chunk_source, chunk_source_promise]() {
+    int64_t offer_ns = _query_trace != nullptr ? MonotonicNanos() : 0;
+    task.work_function = [chunk_source, chunk_source_promise, notifier = _driver_notifier, query_trace = _query_trace,
+                          name_id = _trace_io_task_name_id, offer_ns, query_id = _query_id]() {
+        int64_t begin_ns = query_trace != nullptr ? MonotonicNanos() : 0;
+        CurrentThread::set_sampling_tags(query_id, -1);
         chunk_source->cache_next_chunk_blocking();
+        CurrentThread::clear_sampling_tags();
+        if (query_trace != nullptr) {
+            query_trace->add_complete_event(QueryTrace::IO, name_id, begin_ns, MonotonicNanos(), begin_ns - offer_ns);
+        }
         chunk_source_promise->set_value(chunk_source);
+        if (notifier) {
+            notifier();
+        }
     };
     // TODO(by satanson): set a proper priority
     task.priority = 20;
+    task.group_id = _io_task_group_id;
     // try to submit io task, always return true except that _io_threads is shutdown.
-    _io_threads->try_offer(task);
+    if (_scan_threads != nullptr) {
+        _scan_threads->try_offer(task);
+    } else {
+        _io_threads->try_offer(task);
+    }
     // io task is pending
-    DCHECK(_pending_chunk_source_future.has_value());
+    DCHECK(_chunk_source_futures[i].has_value());
 }
 Status ScanOperator::prepare(RuntimeState* state) {
     Operator::prepare(state);
     RowDescriptor row_desc;
     RETURN_IF_ERROR(Expr::prepare(_conjunct_ctxs, state, row_desc, get_memtracker()));
     RETURN_IF_ERROR(Expr::open(_conjunct_ctxs, state));
-    if (_io_threads != nullptr) {
-        auto num_scan_operators = 1 + state->exec_env()->increment_num_scan_operators(1);
-        if (num_scan_operators > _io_threads->get_queue_capacity()) {
-            state->exec_env()->decrement_num_scan_operators(1);
-            return Status::TooManyTasks(
-                    strings::Substitute("num_scan_operators exceeds queue capacity($0) of pipeline_pool_thread",
-                                        _io_threads->get_queue_capacity()));
-        }
+    _io_task_group_id = state->query_id().lo;
+    _query_id = state->query_id();
+    _query_trace = QueryTraceManager::instance()->get(state->query_id());
+    if (_query_trace != nullptr) {
+        _trace_io_task_name_id = _query_trace->name_id(get_name() + ".io_task");
+    }
+    if (_io_threads == nullptr) {
+        _is_finished = !_pickup_morsel(state, &_chunk_source);
+        return Status::OK();
+    }
+    auto num_scan_operators = 1 + state->exec_env()->increment_num_scan_operators(1);
+    if (num_scan_operators > _io_threads->get_queue_capacity()) {
+        state->exec_env()->decrement_num_scan_operators(1);
+        return Status::TooManyTasks(
+                strings::Substitute("num_scan_operators exceeds queue capacity($0) of pipeline_pool_thread",
+                                    _io_threads->get_queue_capacity()));
+    }
+    // The io tasks of all the scan operators share the queue of the io threads, so an operator takes no more io
+    // tasks than its share of the queue, but at least one.
+    size_t num_io_tasks = std::max(config::pipeline_scan_io_tasks_per_operator, 1);
+    num_io_tasks = std::min(num_io_tasks, std::max<size_t>(_io_threads->get_queue_capacity() / num_scan_operators, 1));
+    _chunk_sources.resize(num_io_tasks);
+    _chunk_source_futures.resize(num_io_tasks);
+    for (size_t i = 0; i < num_io_tasks && !_is_finished; ++i) {
+        _pickup_morsel_nonblocking(state, i);
     }
-    _pickup_morsel(state);
     return Status::OK();
 }
 
@@ -77,6 +150,11 @@ Status ScanOperator::close(RuntimeState* state) {
     if (_chunk_source) {
         _chunk_source->close(state);
     }
+    for (auto& chunk_source : _chunk_sources) {
+        if (chunk_source) {
+            chunk_source->close(state);
+        }
+    }
     Operator::close(state);
     return Status::OK();
 }
@@ -92,13 +170,14 @@ bool ScanOperator::_has_output_nonblocking() {
     if (_is_finished) {
         return false;
     }
-    DCHECK(_pending_chunk_source_future.has_value());
-    // submitted io task has not completed yet
-    if (_pending_chunk_source_future.value().wait_for(std::chrono::seconds::zero()) != std::future_status::ready) {
-        return false;
+    DCHECK(_has_pending_io_tasks());
+    // any submitted io task has already completed
+    for (size_t i = 0; i < _chunk_source_futures.size(); ++i) {
+        if (_is_io_task_completed(i)) {
+            return true;
+        }
     }
-    // submitted io task has already completed
-    return true;
+    return false;
 }
 
 bool ScanOperator::has_output() {
@@ -114,19 +193,14 @@ bool ScanOperator::pending_finish() {
     if (_io_threads == nullptr) {
         return false;
     }
-    // pending io task has been submitted, but not complete yet.
-    if (_pending_chunk_source_future.has_value()) {
-        if (_pending_chunk_source_future.value().wait_for(std::chrono::seconds::zero()) == std::future_status::ready) {
-            _chunk_source = _pending_chunk_source_future.value().get();
-            _pending_chunk_source_future = {};
-            return false;
-        } else {
-            return true;
+    // take back the chunk sources of the io tasks completed, pending until all the submitted io tasks complete.
+    for (size_t i = 0; i < _chunk_source_futures.size(); ++i) {
+        if (_is_io_task_completed(i)) {
+            _chunk_sources[i] = _chunk_source_futures[i].value().get();
+            _chunk_source_futures[i] = {};
         }
     }
-    // no pending io task
-    DCHECK(!_pending_chunk_source_future.has_value());
-    return false;
+    return _has_pending_io_tasks();
 }
 
 bool ScanOperator::is_finished() const {
@@ -138,6 +212,12 @@ void ScanOperator::finish(RuntimeState* state) {
     if (_chunk_source) {
         _chunk_source->close(state);
     }
+    // the chunk sources of the pending io tasks are closed by close(), once taken back by pending_finish().
+    for (auto& chunk_source : _chunk_sources) {
+        if (chunk_source) {
+            chunk_source->close(state);
+        }
+    }
 }
 
 StatusOr<vectorized::ChunkPtr> ScanOperator::_pull_chunk_blocking(RuntimeState* state) {
@@ -150,7 +230,7 @@ StatusOr<vectorized::ChunkPtr> ScanOperator::_pull_chunk_blocking(RuntimeState*
     if (chunk.ok() || !chunk.status().is_end_of_file()) {
         return chunk;
     }
-    _pickup_morsel(state);
+    _is_finished = !_pickup_morsel(state, &_chunk_source);
     return nullptr;
 }
 
@@ -160,11 +240,23 @@ StatusOr<vectorized::ChunkPtr> ScanOperator::_pull_chunk_nonblocking(RuntimeStat
         return Status::EndOfFile("End-Of-Stream");
     }
 
-    _chunk_source = _pending_chunk_source_future.value().get();
-    _pending_chunk_source_future = {};
-    auto chunk = _chunk_source->get_next_chunk_nonblocking();
+    // pull the chunk of the first completed io task, from the one after the io task pulled last time.
+    const size_t num_io_tasks = _chunk_source_futures.size();
+    size_t i = _next_io_task;
+    while (!_is_io_task_completed(i)) {
+        i = (i + 1) % num_io_tasks;
+        if (i == _next_io_task) {
+            // no io task has completed yet
+            return nullptr;
+        }
+    }
+    _next_io_task = (i + 1) % num_io_tasks;
+
+    _chunk_sources[i] = _chunk_source_futures[i].value().get();
+    _chunk_source_futures[i] = {};
+    auto chunk = _chunk_sources[i]->get_next_chunk_nonblocking();
     if (chunk.ok()) {
-        _trigger_read_chunk();
+        _trigger_read_chunk(i);
         return chunk;
     }
     if (!chunk.status().is_end_of_file()) {
@@ -174,7 +266,7 @@ StatusOr<vectorized::ChunkPtr> ScanOperator::_pull_chunk_nonblocking(RuntimeStat
     // processed and the EndOfFile is encountered, then ScanOperator has no chunk
     // to output and should pick up next morsel. so here return nullptr instead of
     // empty chunk.
-    _pickup_morsel(state);
+    _pickup_morsel_nonblocking(state, i);
     return nullptr;
 }
 
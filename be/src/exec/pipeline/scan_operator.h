@@ -3,10 +3,14 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
+#include "exec/pipeline/query_trace.h"
 #include "exec/pipeline/source_operator.h"
 #include "exprs/vectorized/runtime_filter_bank.h"
+#include "storage/vectorized/runtime_predicate.h"
 #include "util/priority_thread_pool.hpp"
+#include "util/work_stealing_thread_pool.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -38,11 +42,27 @@ public:
     void finish(RuntimeState* state) override;
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    // The completion of each async io task notifies the driver.
+    bool has_driver_notifier() const override { return _io_threads != nullptr; }
+
     void set_io_threads(PriorityThreadPool* io_threads) { _io_threads = io_threads; }
 
+    // The io tasks are offered to |scan_threads| instead of the io threads if it's not null, while the operator
+    // still needs the io threads to read chunks asynchronously.
+    void set_scan_threads(WorkStealingThreadPool* scan_threads) { _scan_threads = scan_threads; }
+
+    void set_runtime_predicate(vectorized::RuntimePredicatePtr runtime_predicate) {
+        _runtime_predicate = std::move(runtime_predicate);
+    }
+
 private:
-    void _pickup_morsel(RuntimeState* state);
-    void _trigger_read_chunk();
+    // Replace |chunk_source| by the chunk source of the next morsel, false if there is no morsel left.
+    bool _pickup_morsel(RuntimeState* state, ChunkSourcePtr* chunk_source);
+    void _pickup_morsel_nonblocking(RuntimeState* state, size_t i);
+    void _trigger_read_chunk(size_t i);
+    bool _is_io_task_completed(size_t i) const;
+    bool _has_pending_io_tasks() const;
     bool _has_output_blocking();
     bool _has_output_nonblocking();
     StatusOr<vectorized::ChunkPtr> _pull_chunk_blocking(RuntimeState* state);
@@ -54,15 +74,28 @@ private:
     const std::vector<ExprContext*>& _conjunct_ctxs;
     const vectorized::RuntimeFilterProbeCollector& _runtime_filters;
     PriorityThreadPool* _io_threads = nullptr;
-    OptionalChunkSourceFuture _pending_chunk_source_future;
+    WorkStealingThreadPool* _scan_threads = nullptr;
+    uint64_t _io_task_group_id = 0;
+    // Tags the samples of the io tasks.
+    TUniqueId _query_id;
+    // The chunk sources read by the io tasks, up to pipeline_scan_io_tasks_per_operator. The source of the i-th io
+    // task is owned by the task while _chunk_source_futures[i] is pending, and handed back by the future.
+    std::vector<ChunkSourcePtr> _chunk_sources;
+    std::vector<OptionalChunkSourceFuture> _chunk_source_futures;
+    // The io task whose chunk is pulled first once ready, so that no task starves the others.
+    size_t _next_io_task = 0;
+    vectorized::RuntimePredicatePtr _runtime_predicate;
+    // Shared with the io tasks, nullptr unless the query is traced.
+    QueryTracePtr _query_trace;
+    int32_t _trace_io_task_name_id = 0;
 };
 
-class ScanOperatorFactory final : public OperatorFactory {
+class ScanOperatorFactory final : public SourceOperatorFactory {
 public:
     ScanOperatorFactory(int32_t id, int32_t plan_node_id, const TOlapScanNode& olap_scan_node,
                         std::vector<ExprContext*>&& conjunct_ctxs,
                         vectorized::RuntimeFilterProbeCollector&& runtime_filters)
-            : OperatorFactory(id, plan_node_id),
+            : SourceOperatorFactory(id, plan_node_id),
               _olap_scan_node(olap_scan_node),
               _conjunct_ctxs(std::move(conjunct_ctxs)),
               _runtime_filters(std::move(runtime_filters)) {}
@@ -70,15 +103,21 @@ public:
     ~ScanOperatorFactory() override = default;
 
     OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
-        return std::make_shared<ScanOperator>(_id, _plan_node_id, _olap_scan_node, _conjunct_ctxs, _runtime_filters);
+        auto scan_operator =
+                std::make_shared<ScanOperator>(_id, _plan_node_id, _olap_scan_node, _conjunct_ctxs, _runtime_filters);
+        scan_operator->set_runtime_predicate(_runtime_predicate);
+        return scan_operator;
     }
 
-    bool is_source() const override { return true; }
+    void set_runtime_predicate(vectorized::RuntimePredicatePtr runtime_predicate) {
+        _runtime_predicate = std::move(runtime_predicate);
+    }
 
 private:
     TOlapScanNode _olap_scan_node;
     std::vector<ExprContext*> _conjunct_ctxs;
     vectorized::RuntimeFilterProbeCollector _runtime_filters;
+    vectorized::RuntimePredicatePtr _runtime_predicate;
 };
 
 } // namespace pipeline
@@ -0,0 +1,47 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/except_build_sink_operator.h"
+
+#include "exprs/expr.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status ExceptBuildSinkOperator::prepare(RuntimeState* state) {
+    _except_ctx->ref();
+    RETURN_IF_ERROR(Operator::prepare(state));
+
+    // Every driver has its own exprs, which are only evaluated by itself.
+    RowDescriptor row_desc;
+    RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), _dst_texprs, &_dst_exprs));
+    RETURN_IF_ERROR(Expr::prepare(_dst_exprs, state, row_desc, get_memtracker()));
+    RETURN_IF_ERROR(Expr::open(_dst_exprs, state));
+
+    _build_set_timer = ADD_TIMER(_runtime_profile, "BuildSetTime");
+    return _except_ctx->prepare(state, _dst_exprs);
+}
+
+Status ExceptBuildSinkOperator::close(RuntimeState* state) {
+    Expr::close(_dst_exprs, state);
+    RETURN_IF_ERROR(_except_ctx->unref(state));
+    return Operator::close(state);
+}
+
+void ExceptBuildSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+    _except_ctx->finish_dependency(0);
+}
+
+StatusOr<vectorized::ChunkPtr> ExceptBuildSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from except build sink.");
+}
+
+Status ExceptBuildSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    SCOPED_TIMER(_build_set_timer);
+    return _except_ctx->build_set(state, chunk, _dst_exprs);
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,92 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/except_context.h"
+
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status ExceptContext::prepare(RuntimeState* state, const std::vector<ExprContext*>& build_exprs) {
+    _dst_tuple_desc = state->desc_tbl().get_tuple_descriptor(_dst_tuple_id);
+    DCHECK(_dst_tuple_desc != nullptr);
+    DCHECK_EQ(build_exprs.size(), _dst_tuple_desc->slots().size());
+
+    _build_pool = std::make_unique<MemPool>(state->instance_mem_tracker());
+    _hash_set = std::make_unique<vectorized::ExceptHashSerializeSet>();
+
+    size_t size_column_type = _dst_tuple_desc->slots().size();
+    _types.resize(size_column_type);
+    for (int i = 0; i < size_column_type; ++i) {
+        _types[i].result_type = _dst_tuple_desc->slots()[i]->type();
+        _types[i].is_constant = build_exprs[i]->root()->is_constant();
+    }
+    return Status::OK();
+}
+
+Status ExceptContext::close(RuntimeState* state) {
+    _hash_set.reset();
+    if (_build_pool != nullptr) {
+        _build_pool->free_all();
+    }
+    return Status::OK();
+}
+
+void ExceptContext::finish_dependency(size_t dependency_index) {
+    DCHECK(dependency_index == 0 || is_dependency_finished(dependency_index - 1));
+    if (dependency_index == _erase_times) {
+        _next_processed_iter = _hash_set->begin();
+    }
+    _finished_dependency_index.store(dependency_index, std::memory_order_release);
+}
+
+Status ExceptContext::build_set(RuntimeState* state, const vectorized::ChunkPtr& chunk,
+                                const std::vector<ExprContext*>& exprs) {
+    if (!_types_initialized) {
+        _types_initialized = true;
+        return _hash_set->build_set(state, chunk, exprs, _build_pool.get(),
+                                    [this](const vectorized::ColumnPtr& column, int i) -> void {
+                                        _types[i].is_nullable = column->is_nullable();
+                                    });
+    }
+    return _hash_set->build_set(state, chunk, exprs, _build_pool.get(),
+                                [](const vectorized::ColumnPtr& column, int i) -> void {});
+}
+
+Status ExceptContext::erase_duplicate_row(RuntimeState* state, const vectorized::ChunkPtr& chunk,
+                                          const std::vector<ExprContext*>& exprs) {
+    return _hash_set->erase_duplicate_row(state, chunk->num_rows(), chunk, exprs);
+}
+
+StatusOr<vectorized::ChunkPtr> ExceptContext::pull_chunk(RuntimeState* state) {
+    using namespace vectorized;
+    int32_t read_index = 0;
+    _hash_set->_results.resize(config::vector_chunk_size);
+    while (_next_processed_iter != _hash_set->end() && read_index < config::vector_chunk_size) {
+        if (!_next_processed_iter->deleted) {
+            _hash_set->_results[read_index] = _next_processed_iter->slice;
+            ++read_index;
+        }
+        ++_next_processed_iter;
+    }
+
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    if (read_index > 0) {
+        Columns result_columns(_types.size());
+        for (size_t i = 0; i < _types.size(); ++i) {
+            result_columns[i] = // default NullableColumn
+                    ColumnHelper::create_column(_types[i].result_type, _types[i].is_nullable);
+            result_columns[i]->reserve(read_index);
+        }
+        _hash_set->insert_keys_to_columns(_hash_set->_results, result_columns, read_index);
+
+        for (size_t i = 0; i < result_columns.size(); i++) {
+            result_chunk->append_column(std::move(result_columns[i]), _dst_tuple_desc->slots()[i]->id());
+        }
+    }
+
+    DCHECK_CHUNK(result_chunk);
+    return std::move(result_chunk);
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,111 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <unordered_map>
+
+#include "exec/vectorized/except_hash_set.h"
+
+namespace starrocks {
+class TupleDescriptor;
+namespace pipeline {
+class ExceptContext;
+using ExceptContextPtr = std::shared_ptr<ExceptContext>;
+
+// ExceptContext holds the hash set of one partition of EXCEPT. The rows of all the children
+// are shuffled by the same partition exprs, so the children could be subtracted partition by
+// partition, and each partition is built, probed and output by the operators of the same driver
+// sequence, which share the same ExceptContext.
+//
+// The hash set is built by ExceptBuildSinkOperator of the first child, and then probed by
+// ExceptProbeSinkOperator of the i-th child after the (i-1)-th child has been probed, so that the
+// keys are marked deleted by only one child at a time. The keys not deleted by any of the other
+// children are output by ExceptOutputSourceOperator after all the probes finish.
+class ExceptContext {
+public:
+    ExceptContext(int dst_tuple_id, size_t erase_times) : _dst_tuple_id(dst_tuple_id), _erase_times(erase_times) {}
+
+    // An ExceptContext is referenced by all the operators of the same driver sequence,
+    // the last one which calls unref releases the hash set.
+    void ref() { _num_refs.fetch_add(1, std::memory_order_relaxed); }
+    Status unref(RuntimeState* state) {
+        if (_num_refs.fetch_sub(1) == 1) {
+            return close(state);
+        }
+        return Status::OK();
+    }
+
+    // Called by ExceptBuildSinkOperator in its prepare.
+    Status prepare(RuntimeState* state, const std::vector<ExprContext*>& build_exprs);
+
+    // The 0-th dependency is the build of the first child, and the i-th one is the probe of the i-th child.
+    bool is_dependency_finished(size_t dependency_index) const {
+        return _finished_dependency_index.load(std::memory_order_acquire) >= static_cast<int64_t>(dependency_index);
+    }
+    void finish_dependency(size_t dependency_index);
+
+    bool is_probe_finished() const { return is_dependency_finished(_erase_times); }
+    // Can only be used after is_probe_finished() returns true.
+    bool is_output_finished() const { return _next_processed_iter == _hash_set->end(); }
+
+    Status build_set(RuntimeState* state, const vectorized::ChunkPtr& chunk, const std::vector<ExprContext*>& exprs);
+
+    Status erase_duplicate_row(RuntimeState* state, const vectorized::ChunkPtr& chunk,
+                               const std::vector<ExprContext*>& exprs);
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state);
+
+private:
+    Status close(RuntimeState* state);
+
+    struct ExceptColumnTypes {
+        TypeDescriptor result_type;
+        bool is_nullable = false;
+        bool is_constant = false;
+    };
+
+    const int _dst_tuple_id;
+    const size_t _erase_times;
+    const TupleDescriptor* _dst_tuple_desc = nullptr;
+    std::vector<ExceptColumnTypes> _types;
+    bool _types_initialized = false;
+
+    std::unique_ptr<vectorized::ExceptHashSerializeSet> _hash_set;
+    vectorized::ExceptHashSerializeSet::Iterator _next_processed_iter;
+    // pool for allocate key.
+    std::unique_ptr<MemPool> _build_pool;
+
+    // The index of the last finished dependency, -1 means that the build hasn't finished.
+    std::atomic<int64_t> _finished_dependency_index{-1};
+    std::atomic<int32_t> _num_refs{0};
+};
+
+// ExceptPartitionContextFactory creates one ExceptContext for each driver sequence,
+// i.e. each partition of the rows.
+class ExceptPartitionContextFactory;
+using ExceptPartitionContextFactoryPtr = std::shared_ptr<ExceptPartitionContextFactory>;
+
+class ExceptPartitionContextFactory {
+public:
+    ExceptPartitionContextFactory(int dst_tuple_id, size_t erase_times)
+            : _dst_tuple_id(dst_tuple_id), _erase_times(erase_times) {}
+
+    ExceptContextPtr get_or_create(int32_t driver_sequence) {
+        auto it = _partition_contexts.find(driver_sequence);
+        if (it != _partition_contexts.end()) {
+            return it->second;
+        }
+        auto context = std::make_shared<ExceptContext>(_dst_tuple_id, _erase_times);
+        _partition_contexts.emplace(driver_sequence, context);
+        return context;
+    }
+
+private:
+    const int _dst_tuple_id;
+    const size_t _erase_times;
+    std::unordered_map<int32_t, ExceptContextPtr> _partition_contexts;
+};
+
+} // namespace pipeline
+} // namespace starrocks
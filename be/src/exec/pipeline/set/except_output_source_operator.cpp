@@ -0,0 +1,21 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/except_output_source_operator.h"
+
+namespace starrocks::pipeline {
+
+Status ExceptOutputSourceOperator::prepare(RuntimeState* state) {
+    _except_ctx->ref();
+    return Operator::prepare(state);
+}
+
+Status ExceptOutputSourceOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_except_ctx->unref(state));
+    return Operator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> ExceptOutputSourceOperator::pull_chunk(RuntimeState* state) {
+    return _except_ctx->pull_chunk(state);
+}
+
+} // namespace starrocks::pipeline
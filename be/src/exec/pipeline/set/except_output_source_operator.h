@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/set/except_context.h"
+#include "exec/pipeline/source_operator.h"
+
+namespace starrocks::pipeline {
+// ExceptOutputSourceOperator outputs the keys of its partition not found in any of the other children
+// of EXCEPT, after all the children have probed the hash set.
+class ExceptOutputSourceOperator final : public SourceOperator {
+public:
+    ExceptOutputSourceOperator(int32_t id, int32_t plan_node_id, ExceptContextPtr except_ctx)
+            : SourceOperator(id, "except_output_source", plan_node_id), _except_ctx(std::move(except_ctx)) {}
+
+    ~ExceptOutputSourceOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return _except_ctx->is_probe_finished() && !_except_ctx->is_output_finished(); }
+
+    bool is_finished() const override {
+        return _except_ctx->is_probe_finished() && _except_ctx->is_output_finished();
+    }
+
+    void finish(RuntimeState* state) override {}
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    ExceptContextPtr _except_ctx;
+};
+
+class ExceptOutputSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    ExceptOutputSourceOperatorFactory(int32_t id, int32_t plan_node_id,
+                                      ExceptPartitionContextFactoryPtr except_partition_ctx_factory)
+            : SourceOperatorFactory(id, plan_node_id),
+              _except_partition_ctx_factory(std::move(except_partition_ctx_factory)) {}
+
+    ~ExceptOutputSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<ExceptOutputSourceOperator>(
+                _id, _plan_node_id, _except_partition_ctx_factory->get_or_create(driver_sequence));
+    }
+
+private:
+    ExceptPartitionContextFactoryPtr _except_partition_ctx_factory;
+};
+
+} // namespace starrocks::pipeline
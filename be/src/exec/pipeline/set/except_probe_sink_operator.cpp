@@ -0,0 +1,49 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/except_probe_sink_operator.h"
+
+#include "exprs/expr.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status ExceptProbeSinkOperator::prepare(RuntimeState* state) {
+    _except_ctx->ref();
+    RETURN_IF_ERROR(Operator::prepare(state));
+
+    // Every driver has its own exprs, which are only evaluated by itself.
+    RowDescriptor row_desc;
+    RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), _dst_texprs, &_dst_exprs));
+    RETURN_IF_ERROR(Expr::prepare(_dst_exprs, state, row_desc, get_memtracker()));
+    RETURN_IF_ERROR(Expr::open(_dst_exprs, state));
+
+    _erase_duplicate_row_timer = ADD_TIMER(_runtime_profile, "EraseDuplicateRowTime");
+    return Status::OK();
+}
+
+Status ExceptProbeSinkOperator::close(RuntimeState* state) {
+    Expr::close(_dst_exprs, state);
+    RETURN_IF_ERROR(_except_ctx->unref(state));
+    return Operator::close(state);
+}
+
+void ExceptProbeSinkOperator::finish(RuntimeState* state) {
+    _is_finished = true;
+    // The driver finishes this operator again once is_finished() returns true, so the probe of
+    // this child is always finished after the one of the previous child.
+    if (!_is_probe_finished && _except_ctx->is_dependency_finished(_dependency_index - 1)) {
+        _is_probe_finished = true;
+        _except_ctx->finish_dependency(_dependency_index);
+    }
+}
+
+StatusOr<vectorized::ChunkPtr> ExceptProbeSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from except probe sink.");
+}
+
+Status ExceptProbeSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    SCOPED_TIMER(_erase_duplicate_row_timer);
+    return _except_ctx->erase_duplicate_row(state, chunk, _dst_exprs);
+}
+
+} // namespace starrocks::pipeline
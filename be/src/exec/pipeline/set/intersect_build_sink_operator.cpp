@@ -0,0 +1,47 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/intersect_build_sink_operator.h"
+
+#include "exprs/expr.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status IntersectBuildSinkOperator::prepare(RuntimeState* state) {
+    _intersect_ctx->ref();
+    RETURN_IF_ERROR(Operator::prepare(state));
+
+    // Every driver has its own exprs, which are only evaluated by itself.
+    RowDescriptor row_desc;
+    RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), _dst_texprs, &_dst_exprs));
+    RETURN_IF_ERROR(Expr::prepare(_dst_exprs, state, row_desc, get_memtracker()));
+    RETURN_IF_ERROR(Expr::open(_dst_exprs, state));
+
+    _build_set_timer = ADD_TIMER(_runtime_profile, "BuildSetTime");
+    return _intersect_ctx->prepare(state, _dst_exprs);
+}
+
+Status IntersectBuildSinkOperator::close(RuntimeState* state) {
+    Expr::close(_dst_exprs, state);
+    RETURN_IF_ERROR(_intersect_ctx->unref(state));
+    return Operator::close(state);
+}
+
+void IntersectBuildSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+    _intersect_ctx->finish_dependency(0);
+}
+
+StatusOr<vectorized::ChunkPtr> IntersectBuildSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from intersect build sink.");
+}
+
+Status IntersectBuildSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    SCOPED_TIMER(_build_set_timer);
+    return _intersect_ctx->build_set(state, chunk, _dst_exprs);
+}
+
+} // namespace starrocks::pipeline
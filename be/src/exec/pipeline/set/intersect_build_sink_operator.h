@@ -0,0 +1,69 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/set/intersect_context.h"
+#include "gen_cpp/Exprs_types.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::pipeline {
+// IntersectBuildSinkOperator builds the hash set of its partition from the first child of INTERSECT.
+class IntersectBuildSinkOperator final : public Operator {
+public:
+    IntersectBuildSinkOperator(int32_t id, int32_t plan_node_id, IntersectContextPtr intersect_ctx,
+                               const std::vector<TExpr>& dst_texprs)
+            : Operator(id, "intersect_build_sink", plan_node_id),
+              _intersect_ctx(std::move(intersect_ctx)),
+              _dst_texprs(dst_texprs) {}
+
+    ~IntersectBuildSinkOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return false; }
+
+    bool need_input() override { return !is_finished(); }
+
+    bool is_finished() const override { return _is_finished; }
+
+    void finish(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    IntersectContextPtr _intersect_ctx;
+    const std::vector<TExpr>& _dst_texprs;
+    std::vector<ExprContext*> _dst_exprs;
+
+    bool _is_finished = false;
+
+    RuntimeProfile::Counter* _build_set_timer = nullptr; // time to build hash set
+};
+
+class IntersectBuildSinkOperatorFactory final : public OperatorFactory {
+public:
+    IntersectBuildSinkOperatorFactory(int32_t id, int32_t plan_node_id,
+                                      IntersectPartitionContextFactoryPtr intersect_partition_ctx_factory,
+                                      const std::vector<TExpr>& dst_texprs)
+            : OperatorFactory(id, plan_node_id),
+              _intersect_partition_ctx_factory(std::move(intersect_partition_ctx_factory)),
+              _dst_texprs(dst_texprs) {}
+
+    ~IntersectBuildSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<IntersectBuildSinkOperator>(
+                _id, _plan_node_id, _intersect_partition_ctx_factory->get_or_create(driver_sequence), _dst_texprs);
+    }
+
+private:
+    IntersectPartitionContextFactoryPtr _intersect_partition_ctx_factory;
+    const std::vector<TExpr> _dst_texprs;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,21 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/intersect_output_source_operator.h"
+
+namespace starrocks::pipeline {
+
+Status IntersectOutputSourceOperator::prepare(RuntimeState* state) {
+    _intersect_ctx->ref();
+    return Operator::prepare(state);
+}
+
+Status IntersectOutputSourceOperator::close(RuntimeState* state) {
+    RETURN_IF_ERROR(_intersect_ctx->unref(state));
+    return Operator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> IntersectOutputSourceOperator::pull_chunk(RuntimeState* state) {
+    return _intersect_ctx->pull_chunk(state);
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/set/intersect_context.h"
+#include "exec/pipeline/source_operator.h"
+
+namespace starrocks::pipeline {
+// IntersectOutputSourceOperator outputs the keys of its partition hit by all the children of INTERSECT,
+// after all the children have probed the hash set.
+class IntersectOutputSourceOperator final : public SourceOperator {
+public:
+    IntersectOutputSourceOperator(int32_t id, int32_t plan_node_id, IntersectContextPtr intersect_ctx)
+            : SourceOperator(id, "intersect_output_source", plan_node_id), _intersect_ctx(std::move(intersect_ctx)) {}
+
+    ~IntersectOutputSourceOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return _intersect_ctx->is_probe_finished() && !_intersect_ctx->is_output_finished(); }
+
+    bool is_finished() const override {
+        return _intersect_ctx->is_probe_finished() && _intersect_ctx->is_output_finished();
+    }
+
+    void finish(RuntimeState* state) override {}
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    IntersectContextPtr _intersect_ctx;
+};
+
+class IntersectOutputSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    IntersectOutputSourceOperatorFactory(int32_t id, int32_t plan_node_id,
+                                         IntersectPartitionContextFactoryPtr intersect_partition_ctx_factory)
+            : SourceOperatorFactory(id, plan_node_id),
+              _intersect_partition_ctx_factory(std::move(intersect_partition_ctx_factory)) {}
+
+    ~IntersectOutputSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<IntersectOutputSourceOperator>(
+                _id, _plan_node_id, _intersect_partition_ctx_factory->get_or_create(driver_sequence));
+    }
+
+private:
+    IntersectPartitionContextFactoryPtr _intersect_partition_ctx_factory;
+};
+
+} // namespace starrocks::pipeline
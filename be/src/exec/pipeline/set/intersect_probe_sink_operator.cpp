@@ -0,0 +1,49 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/intersect_probe_sink_operator.h"
+
+#include "exprs/expr.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status IntersectProbeSinkOperator::prepare(RuntimeState* state) {
+    _intersect_ctx->ref();
+    RETURN_IF_ERROR(Operator::prepare(state));
+
+    // Every driver has its own exprs, which are only evaluated by itself.
+    RowDescriptor row_desc;
+    RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), _dst_texprs, &_dst_exprs));
+    RETURN_IF_ERROR(Expr::prepare(_dst_exprs, state, row_desc, get_memtracker()));
+    RETURN_IF_ERROR(Expr::open(_dst_exprs, state));
+
+    _refine_intersect_row_timer = ADD_TIMER(_runtime_profile, "RefineIntersectRowTime");
+    return Status::OK();
+}
+
+Status IntersectProbeSinkOperator::close(RuntimeState* state) {
+    Expr::close(_dst_exprs, state);
+    RETURN_IF_ERROR(_intersect_ctx->unref(state));
+    return Operator::close(state);
+}
+
+void IntersectProbeSinkOperator::finish(RuntimeState* state) {
+    _is_finished = true;
+    // The driver finishes this operator again once is_finished() returns true, so the probe of
+    // this child is always finished after the one of the previous child.
+    if (!_is_probe_finished && _intersect_ctx->is_dependency_finished(_dependency_index - 1)) {
+        _is_probe_finished = true;
+        _intersect_ctx->finish_dependency(_dependency_index);
+    }
+}
+
+StatusOr<vectorized::ChunkPtr> IntersectProbeSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from intersect probe sink.");
+}
+
+Status IntersectProbeSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    SCOPED_TIMER(_refine_intersect_row_timer);
+    return _intersect_ctx->refine_intersect_row(state, chunk, _dst_exprs, _dependency_index);
+}
+
+} // namespace starrocks::pipeline
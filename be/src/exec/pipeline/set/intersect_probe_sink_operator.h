@@ -0,0 +1,82 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/set/intersect_context.h"
+#include "gen_cpp/Exprs_types.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::pipeline {
+// IntersectProbeSinkOperator probes the hash set of its partition by the |dependency_index|-th child
+// of INTERSECT, it doesn't need input until the previous child has probed the hash set.
+class IntersectProbeSinkOperator final : public Operator {
+public:
+    IntersectProbeSinkOperator(int32_t id, int32_t plan_node_id, IntersectContextPtr intersect_ctx,
+                               const std::vector<TExpr>& dst_texprs, size_t dependency_index)
+            : Operator(id, "intersect_probe_sink", plan_node_id),
+              _intersect_ctx(std::move(intersect_ctx)),
+              _dst_texprs(dst_texprs),
+              _dependency_index(dependency_index) {}
+
+    ~IntersectProbeSinkOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return false; }
+
+    bool need_input() override {
+        return !_is_finished && _intersect_ctx->is_dependency_finished(_dependency_index - 1);
+    }
+
+    // The input may finish before the previous child has probed the hash set,
+    // then this operator is finished after that.
+    bool is_finished() const override {
+        return _is_finished && _intersect_ctx->is_dependency_finished(_dependency_index - 1);
+    }
+
+    void finish(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    IntersectContextPtr _intersect_ctx;
+    const std::vector<TExpr>& _dst_texprs;
+    std::vector<ExprContext*> _dst_exprs;
+    const size_t _dependency_index;
+
+    bool _is_finished = false;
+    bool _is_probe_finished = false;
+
+    RuntimeProfile::Counter* _refine_intersect_row_timer = nullptr;
+};
+
+class IntersectProbeSinkOperatorFactory final : public OperatorFactory {
+public:
+    IntersectProbeSinkOperatorFactory(int32_t id, int32_t plan_node_id,
+                                      IntersectPartitionContextFactoryPtr intersect_partition_ctx_factory,
+                                      const std::vector<TExpr>& dst_texprs, size_t dependency_index)
+            : OperatorFactory(id, plan_node_id),
+              _intersect_partition_ctx_factory(std::move(intersect_partition_ctx_factory)),
+              _dst_texprs(dst_texprs),
+              _dependency_index(dependency_index) {}
+
+    ~IntersectProbeSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<IntersectProbeSinkOperator>(
+                _id, _plan_node_id, _intersect_partition_ctx_factory->get_or_create(driver_sequence), _dst_texprs,
+                _dependency_index);
+    }
+
+private:
+    IntersectPartitionContextFactoryPtr _intersect_partition_ctx_factory;
+    const std::vector<TExpr> _dst_texprs;
+    const size_t _dependency_index;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/union_const_source_operator.h"
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status UnionConstSourceOperator::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Operator::prepare(state));
+    RowDescriptor row_desc;
+    for (const auto& exprs : _const_expr_lists) {
+        RETURN_IF_ERROR(Expr::prepare(exprs, state, row_desc, get_memtracker()));
+        RETURN_IF_ERROR(Expr::open(exprs, state));
+    }
+    // The constant rows are output only by the first fragment instance.
+    _is_finished = state->per_fragment_instance_idx() != 0 || _const_expr_lists.empty();
+    return Status::OK();
+}
+
+Status UnionConstSourceOperator::close(RuntimeState* state) {
+    for (const auto& exprs : _const_expr_lists) {
+        Expr::close(exprs, state);
+    }
+    return Operator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> UnionConstSourceOperator::pull_chunk(RuntimeState* state) {
+    using namespace vectorized;
+    const size_t num_rows = _const_expr_lists.size();
+    auto chunk = std::make_shared<Chunk>();
+    for (size_t i = 0; i < _dst_slots.size(); ++i) {
+        auto* dst_slot = _dst_slots[i];
+        ColumnPtr dst_column = ColumnHelper::create_column(dst_slot->type(), dst_slot->is_nullable());
+        dst_column->reserve(num_rows);
+        for (const auto& exprs : _const_expr_lists) {
+            DCHECK_EQ(exprs.size(), _dst_slots.size());
+            ColumnPtr src_column = exprs[i]->evaluate(nullptr);
+            if (src_column->only_null()) {
+                DCHECK(dst_slot->is_nullable());
+                dst_column->append_nulls(1);
+            } else if (src_column->is_constant()) {
+                auto* const_column = ColumnHelper::as_raw_column<ConstColumn>(src_column);
+                dst_column->append(*const_column->data_column(), 0, 1);
+            } else {
+                dst_column->append(*src_column, 0, 1);
+            }
+        }
+        chunk->append_column(std::move(dst_column), dst_slot->id());
+    }
+    _is_finished = true;
+    DCHECK_CHUNK(chunk);
+    return std::move(chunk);
+}
+
+} // namespace starrocks::pipeline
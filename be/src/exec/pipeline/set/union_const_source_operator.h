@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/source_operator.h"
+#include "runtime/descriptors.h"
+
+namespace starrocks::pipeline {
+// UnionConstSourceOperator outputs the constant rows of UNION ALL, such as `SELECT 1 UNION ALL SELECT 2`.
+// All the constant rows are output in one chunk by the first fragment instance, as UnionNode does.
+class UnionConstSourceOperator final : public SourceOperator {
+public:
+    UnionConstSourceOperator(int32_t id, int32_t plan_node_id, const std::vector<SlotDescriptor*>& dst_slots,
+                             const std::vector<std::vector<ExprContext*>>& const_expr_lists)
+            : SourceOperator(id, "union_const_source", plan_node_id),
+              _dst_slots(dst_slots),
+              _const_expr_lists(const_expr_lists) {}
+
+    ~UnionConstSourceOperator() override = default;
+
+    Status prepare(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() override { return !_is_finished; }
+
+    bool is_finished() const override { return _is_finished; }
+
+    void finish(RuntimeState* state) override { _is_finished = true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    const std::vector<SlotDescriptor*>& _dst_slots;
+    // The i-th const expr list is the i-th constant row.
+    const std::vector<std::vector<ExprContext*>>& _const_expr_lists;
+
+    bool _is_finished = false;
+};
+
+class UnionConstSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    UnionConstSourceOperatorFactory(int32_t id, int32_t plan_node_id, const std::vector<SlotDescriptor*>& dst_slots,
+                                    const std::vector<std::vector<ExprContext*>>& const_expr_lists)
+            : SourceOperatorFactory(id, plan_node_id), _dst_slots(dst_slots), _const_expr_lists(const_expr_lists) {}
+
+    ~UnionConstSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        // The constant rows are output only once.
+        DCHECK_EQ(driver_instance_count, 1);
+        return std::make_shared<UnionConstSourceOperator>(_id, _plan_node_id, _dst_slots, _const_expr_lists);
+    }
+
+private:
+    const std::vector<SlotDescriptor*>& _dst_slots;
+    const std::vector<std::vector<ExprContext*>>& _const_expr_lists;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,35 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/set/union_passthrough_operator.h"
+
+#include "column/chunk.h"
+#include "column/nullable_column.h"
+
+namespace starrocks::pipeline {
+
+StatusOr<vectorized::ChunkPtr> UnionPassthroughOperator::pull_chunk(RuntimeState* state) {
+    return std::move(_dst_chunk);
+}
+
+Status UnionPassthroughOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& src_chunk) {
+    using namespace vectorized;
+    const size_t num_rows = src_chunk->num_rows();
+    _dst_chunk = std::make_shared<Chunk>();
+    for (auto* dst_slot : _dst_slots) {
+        auto it = _dst2src_slot_map.find(dst_slot->id());
+        DCHECK(it != _dst2src_slot_map.end());
+        const auto& slot_item = it->second;
+        ColumnPtr& src_column = src_chunk->get_column_by_slot_id(slot_item.slot_id);
+        // There may be multiple destination slots mapped to the same source slot,
+        // the column can only be moved if it's referenced once.
+        ColumnPtr dst_column = slot_item.ref_count <= 1 ? src_column : src_column->clone_shared();
+        if (dst_slot->is_nullable() && !dst_column->is_nullable()) {
+            dst_column = NullableColumn::create(std::move(dst_column), NullColumn::create(num_rows, 0));
+        }
+        _dst_chunk->append_column(std::move(dst_column), dst_slot->id());
+    }
+    DCHECK_CHUNK(_dst_chunk);
+    return Status::OK();
+}
+
+} // namespace starrocks::pipeline
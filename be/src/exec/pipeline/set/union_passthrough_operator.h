@@ -0,0 +1,71 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <map>
+
+#include "exec/pipeline/operator.h"
+#include "runtime/descriptors.h"
+
+namespace starrocks::pipeline {
+// UnionPassthroughOperator moves the columns of a pass-through child of UNION ALL to the slots
+// of the union tuple without evaluating any expression, the materialized children are handled
+// by ProjectOperator instead.
+class UnionPassthroughOperator final : public Operator {
+public:
+    struct SlotItem {
+        SlotId slot_id;
+        size_t ref_count;
+    };
+    // The map from the slot id of the union tuple to the slot id of the child chunk.
+    using Dst2SrcSlotMap = std::map<SlotId, SlotItem>;
+
+    UnionPassthroughOperator(int32_t id, int32_t plan_node_id, const Dst2SrcSlotMap& dst2src_slot_map,
+                             const std::vector<SlotDescriptor*>& dst_slots)
+            : Operator(id, "union_passthrough", plan_node_id),
+              _dst2src_slot_map(dst2src_slot_map),
+              _dst_slots(dst_slots) {}
+
+    ~UnionPassthroughOperator() override = default;
+
+    bool has_output() override { return _dst_chunk != nullptr; }
+
+    bool need_input() override { return _dst_chunk == nullptr; }
+
+    bool is_finished() const override { return _is_finished && _dst_chunk == nullptr; }
+
+    void finish(RuntimeState* state) override { _is_finished = true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& src_chunk) override;
+
+private:
+    const Dst2SrcSlotMap& _dst2src_slot_map;
+    const std::vector<SlotDescriptor*>& _dst_slots;
+
+    bool _is_finished = false;
+    vectorized::ChunkPtr _dst_chunk = nullptr;
+};
+
+class UnionPassthroughOperatorFactory final : public OperatorFactory {
+public:
+    UnionPassthroughOperatorFactory(int32_t id, int32_t plan_node_id,
+                                    UnionPassthroughOperator::Dst2SrcSlotMap&& dst2src_slot_map,
+                                    const std::vector<SlotDescriptor*>& dst_slots)
+            : OperatorFactory(id, plan_node_id),
+              _dst2src_slot_map(std::move(dst2src_slot_map)),
+              _dst_slots(dst_slots) {}
+
+    ~UnionPassthroughOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        return std::make_shared<UnionPassthroughOperator>(_id, _plan_node_id, _dst2src_slot_map, _dst_slots);
+    }
+
+private:
+    UnionPassthroughOperator::Dst2SrcSlotMap _dst2src_slot_map;
+    const std::vector<SlotDescriptor*>& _dst_slots;
+};
+
+} // namespace starrocks::pipeline
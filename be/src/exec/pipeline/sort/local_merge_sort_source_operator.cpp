@@ -0,0 +1,98 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/sort/local_merge_sort_source_operator.h"
+
+#include "column/chunk.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status LocalMergeSortSourceOperator::prepare(RuntimeState* state) {
+    _sort_context->ref();
+    RETURN_IF_ERROR(SourceOperator::prepare(state));
+
+    RETURN_IF_ERROR(_sort_exec_exprs.init(_sort_info, state->obj_pool()));
+    RETURN_IF_ERROR(_sort_exec_exprs.prepare(state, _child_row_desc, _row_desc, get_memtracker()));
+    return _sort_exec_exprs.open(state);
+}
+
+Status LocalMergeSortSourceOperator::close(RuntimeState* state) {
+    _merger = nullptr;
+    _sort_exec_exprs.close(state);
+    _sort_context->unref(state);
+    return SourceOperator::close(state);
+}
+
+bool LocalMergeSortSourceOperator::has_output() {
+    return _sort_context->is_partition_sort_finished() && !_is_finished;
+}
+
+bool LocalMergeSortSourceOperator::is_finished() const {
+    return _sort_context->is_partition_sort_finished() && _is_finished;
+}
+
+void LocalMergeSortSourceOperator::finish(RuntimeState* state) {
+    _is_finished = true;
+}
+
+Status LocalMergeSortSourceOperator::_init_merger() {
+    RETURN_IF_ERROR(_sort_context->partition_sort_status());
+    vectorized::ChunkSuppliers chunk_suppliers;
+    for (const auto& chunks_sorter : _sort_context->chunks_sorters()) {
+        vectorized::ChunksSorter* sorter = chunks_sorter.get();
+        chunk_suppliers.emplace_back([sorter](vectorized::Chunk** chunk) -> Status {
+            vectorized::ChunkPtr sorted_chunk;
+            bool eos = false;
+            RETURN_IF_ERROR(sorter->get_next(&sorted_chunk, &eos));
+            // The chunk output by the sorter isn't shared with anyone else, so it could be moved out.
+            *chunk = eos ? nullptr : new vectorized::Chunk(std::move(*sorted_chunk));
+            return Status::OK();
+        });
+    }
+    _merger = std::make_unique<vectorized::SortedChunksMerger>();
+    RETURN_IF_ERROR(_merger->init(chunk_suppliers, &(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order,
+                                  &_is_null_first));
+    _merger->set_profile(_runtime_profile.get());
+    return Status::OK();
+}
+
+StatusOr<vectorized::ChunkPtr> LocalMergeSortSourceOperator::pull_chunk(RuntimeState* state) {
+    RETURN_IF_CANCELLED(state);
+    if (_merger == nullptr) {
+        RETURN_IF_ERROR(_init_merger());
+    }
+
+    const int64_t offset = _sort_context->offset();
+    const int64_t limit = _sort_context->limit();
+    vectorized::ChunkPtr chunk;
+    bool eos = false;
+    while (true) {
+        RETURN_IF_ERROR(_merger->get_next(&chunk, &eos));
+        if (eos) {
+            _is_finished = true;
+            return std::make_shared<vectorized::Chunk>();
+        }
+        if (_num_rows_skipped + chunk->num_rows() > offset) {
+            break;
+        }
+        _num_rows_skipped += chunk->num_rows();
+    }
+
+    // Skip the rest offset rows at the head of the chunk, and the rows beyond the limit at its tail.
+    size_t from = offset - _num_rows_skipped;
+    _num_rows_skipped = offset;
+    size_t count = chunk->num_rows() - from;
+    if (limit > 0 && _num_rows_returned + count >= limit) {
+        count = limit - _num_rows_returned;
+        _is_finished = true;
+    }
+    if (from > 0 || count < chunk->num_rows()) {
+        vectorized::ChunkPtr result = chunk->clone_empty_with_slot(count);
+        result->append(*chunk, from, count);
+        chunk = std::move(result);
+    }
+    _num_rows_returned += count;
+    return std::move(chunk);
+}
+
+} // namespace starrocks::pipeline
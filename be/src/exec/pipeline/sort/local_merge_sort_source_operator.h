@@ -0,0 +1,93 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/sort/sort_context.h"
+#include "exec/pipeline/source_operator.h"
+#include "exec/sort_exec_exprs.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/vectorized/sorted_chunks_merger.h"
+
+namespace starrocks {
+class RowDescriptor;
+namespace pipeline {
+// LocalMergeSortSourceOperator does a k-way merge of the sorted runs of all the
+// PartitionSortSinkOperators once they have finished, and outputs the rows in order
+// after skipping the offset rows and up to the limit rows.
+class LocalMergeSortSourceOperator final : public SourceOperator {
+public:
+    LocalMergeSortSourceOperator(int32_t id, int32_t plan_node_id, SortContextPtr sort_context,
+                                 const TSortInfo& sort_info, const std::vector<bool>& is_asc_order,
+                                 const std::vector<bool>& is_null_first, const RowDescriptor& child_row_desc,
+                                 const RowDescriptor& row_desc)
+            : SourceOperator(id, "local_merge_sort_source", plan_node_id),
+              _sort_context(std::move(sort_context)),
+              _sort_info(sort_info),
+              _is_asc_order(is_asc_order),
+              _is_null_first(is_null_first),
+              _child_row_desc(child_row_desc),
+              _row_desc(row_desc) {}
+
+    ~LocalMergeSortSourceOperator() override = default;
+
+    bool has_output() override;
+    bool is_finished() const override;
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+private:
+    Status _init_merger();
+
+    SortContextPtr _sort_context;
+    const TSortInfo& _sort_info;
+    const std::vector<bool>& _is_asc_order;
+    const std::vector<bool>& _is_null_first;
+    const RowDescriptor& _child_row_desc;
+    const RowDescriptor& _row_desc;
+
+    // The ordering exprs used to compare the rows of the sorted runs.
+    SortExecExprs _sort_exec_exprs;
+    std::unique_ptr<vectorized::SortedChunksMerger> _merger;
+    int64_t _num_rows_skipped = 0;
+    int64_t _num_rows_returned = 0;
+    bool _is_finished = false;
+};
+
+class LocalMergeSortSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    LocalMergeSortSourceOperatorFactory(int32_t id, int32_t plan_node_id, SortContextPtr sort_context,
+                                        const TSortInfo& sort_info, const std::vector<bool>& is_asc_order,
+                                        const std::vector<bool>& is_null_first, const RowDescriptor& child_row_desc,
+                                        const RowDescriptor& row_desc)
+            : SourceOperatorFactory(id, plan_node_id),
+              _sort_context(std::move(sort_context)),
+              _sort_info(sort_info),
+              _is_asc_order(is_asc_order),
+              _is_null_first(is_null_first),
+              _child_row_desc(child_row_desc),
+              _row_desc(row_desc) {}
+
+    ~LocalMergeSortSourceOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        DCHECK_EQ(driver_instance_count, 1);
+        return std::make_shared<LocalMergeSortSourceOperator>(_id, _plan_node_id, _sort_context, _sort_info,
+                                                              _is_asc_order, _is_null_first, _child_row_desc,
+                                                              _row_desc);
+    }
+
+private:
+    SortContextPtr _sort_context;
+    const TSortInfo _sort_info;
+    const std::vector<bool> _is_asc_order;
+    const std::vector<bool> _is_null_first;
+    const RowDescriptor& _child_row_desc;
+    const RowDescriptor& _row_desc;
+};
+
+} // namespace pipeline
+} // namespace starrocks
@@ -0,0 +1,80 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/sort/partition_sort_sink_operator.h"
+
+#include "column/chunk.h"
+#include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exec/vectorized/chunks_sorter_partition_topn.h"
+#include "exec/vectorized/chunks_sorter_topn.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+Status PartitionSortSinkOperator::prepare(RuntimeState* state) {
+    _sort_context->ref();
+    RETURN_IF_ERROR(Operator::prepare(state));
+
+    RETURN_IF_ERROR(_sort_exec_exprs.init(_sort_info, state->obj_pool()));
+    RETURN_IF_ERROR(_sort_exec_exprs.prepare(state, _child_row_desc, _row_desc, get_memtracker()));
+    RETURN_IF_ERROR(_sort_exec_exprs.open(state));
+    if (_partition_exprs != nullptr) {
+        RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), *_partition_exprs, &_partition_expr_ctxs));
+        RETURN_IF_ERROR(Expr::prepare(_partition_expr_ctxs, state, _row_desc, get_memtracker()));
+        RETURN_IF_ERROR(Expr::open(_partition_expr_ctxs, state));
+    }
+
+    // Every driver keeps its top offset + limit rows, the offset is skipped after merging.
+    const int64_t limit = _sort_context->limit();
+    if (!_partition_expr_ctxs.empty()) {
+        _chunks_sorter = std::make_shared<vectorized::ChunksSorterPartitionTopn>(
+                &(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order, &_is_null_first, &_partition_expr_ctxs,
+                _partition_limit);
+    } else if (limit > 0) {
+        auto topn_sorter = std::make_shared<vectorized::ChunksSorterTopn>(
+                &(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order, &_is_null_first, 0,
+                _sort_context->offset() + limit, vectorized::ChunksSorter::SIZE_OF_CHUNK_FOR_TOPN);
+        if (_runtime_predicate != nullptr) {
+            topn_sorter->set_runtime_predicate(_runtime_predicate, _driver_sequence);
+        }
+        _chunks_sorter = std::move(topn_sorter);
+    } else {
+        _chunks_sorter = std::make_shared<vectorized::ChunksSorterFullSort>(
+                &(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order, &_is_null_first,
+                vectorized::ChunksSorter::SIZE_OF_CHUNK_FOR_FULL_SORT);
+    }
+    _sort_timer = ADD_TIMER(_runtime_profile, "ChunksSorter");
+    _chunks_sorter->setup_runtime(get_memtracker(), _runtime_profile.get(), "ChunksSorter");
+    _sort_context->set_partition_chunks_sorter(_driver_sequence, _chunks_sorter);
+    return Status::OK();
+}
+
+Status PartitionSortSinkOperator::close(RuntimeState* state) {
+    _chunks_sorter = nullptr;
+    _sort_exec_exprs.close(state);
+    Expr::close(_partition_expr_ctxs, state);
+    _sort_context->unref(state);
+    return Operator::close(state);
+}
+
+void PartitionSortSinkOperator::finish(RuntimeState* state) {
+    if (_is_finished) {
+        return;
+    }
+    _is_finished = true;
+    // The failure of sorting is reported by the source operator.
+    SCOPED_TIMER(_sort_timer);
+    _sort_context->finish_partition(_chunks_sorter->done(state));
+}
+
+StatusOr<vectorized::ChunkPtr> PartitionSortSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't call pull_chunk from partition sort sink.");
+}
+
+Status PartitionSortSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    SCOPED_TIMER(_sort_timer);
+    vectorized::ChunkPtr materialize_chunk = vectorized::ChunksSorter::materialize_chunk_before_sort(
+            chunk.get(), _materialized_tuple_desc, _sort_exec_exprs, _order_by_types);
+    return _chunks_sorter->update(state, materialize_chunk);
+}
+
+} // namespace starrocks::pipeline
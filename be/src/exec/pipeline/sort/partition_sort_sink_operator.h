@@ -0,0 +1,139 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/sort/sort_context.h"
+#include "exec/sort_exec_exprs.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "storage/vectorized/runtime_predicate.h"
+
+namespace starrocks {
+class RowDescriptor;
+class TupleDescriptor;
+namespace pipeline {
+// PartitionSortSinkOperator sorts the chunks of its own driver by a ChunksSorter, which keeps
+// only the top offset + limit rows when there is a limit. The sorted runs of all the drivers
+// are merged by the paired LocalMergeSortSourceOperator.
+class PartitionSortSinkOperator final : public Operator {
+public:
+    PartitionSortSinkOperator(int32_t id, int32_t plan_node_id, int32_t driver_sequence, SortContextPtr sort_context,
+                              const TSortInfo& sort_info, const std::vector<bool>& is_asc_order,
+                              const std::vector<bool>& is_null_first,
+                              const std::vector<vectorized::OrderByType>& order_by_types,
+                              TupleDescriptor* materialized_tuple_desc, const RowDescriptor& child_row_desc,
+                              const RowDescriptor& row_desc)
+            : Operator(id, "partition_sort_sink", plan_node_id),
+              _driver_sequence(driver_sequence),
+              _sort_context(std::move(sort_context)),
+              _sort_info(sort_info),
+              _is_asc_order(is_asc_order),
+              _is_null_first(is_null_first),
+              _order_by_types(order_by_types),
+              _materialized_tuple_desc(materialized_tuple_desc),
+              _child_row_desc(child_row_desc),
+              _row_desc(row_desc) {}
+
+    ~PartitionSortSinkOperator() override = default;
+
+    bool has_output() override { return false; }
+    bool need_input() override { return !is_finished(); }
+    bool is_finished() const override { return _is_finished; }
+    void finish(RuntimeState* state) override;
+
+    Status prepare(RuntimeState* state) override;
+    Status close(RuntimeState* state) override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+    // The top-n of every driver publishes its boundary to |runtime_predicate| as its own condition.
+    void set_runtime_predicate(vectorized::RuntimePredicatePtr runtime_predicate) {
+        _runtime_predicate = std::move(runtime_predicate);
+    }
+
+    // Every driver keeps the first |partition_limit| rows of every partition of its own chunks.
+    void set_partition_topn(const std::vector<TExpr>* partition_exprs, int64_t partition_limit) {
+        _partition_exprs = partition_exprs;
+        _partition_limit = partition_limit;
+    }
+
+private:
+    const int32_t _driver_sequence;
+    SortContextPtr _sort_context;
+    const TSortInfo& _sort_info;
+    const std::vector<bool>& _is_asc_order;
+    const std::vector<bool>& _is_null_first;
+    const std::vector<vectorized::OrderByType>& _order_by_types;
+    TupleDescriptor* _materialized_tuple_desc;
+    const RowDescriptor& _child_row_desc;
+    const RowDescriptor& _row_desc;
+    vectorized::RuntimePredicatePtr _runtime_predicate;
+    const std::vector<TExpr>* _partition_exprs = nullptr;
+    int64_t _partition_limit = -1;
+
+    // The exprs of each driver are owned by itself, because evaluating them isn't thread-safe.
+    SortExecExprs _sort_exec_exprs;
+    std::vector<ExprContext*> _partition_expr_ctxs;
+    std::shared_ptr<vectorized::ChunksSorter> _chunks_sorter;
+    RuntimeProfile::Counter* _sort_timer = nullptr;
+    bool _is_finished = false;
+};
+
+class PartitionSortSinkOperatorFactory final : public OperatorFactory {
+public:
+    PartitionSortSinkOperatorFactory(int32_t id, int32_t plan_node_id, SortContextPtr sort_context,
+                                     const TSortInfo& sort_info, const std::vector<bool>& is_asc_order,
+                                     const std::vector<bool>& is_null_first,
+                                     const std::vector<vectorized::OrderByType>& order_by_types,
+                                     TupleDescriptor* materialized_tuple_desc, const RowDescriptor& child_row_desc,
+                                     const RowDescriptor& row_desc)
+            : OperatorFactory(id, plan_node_id),
+              _sort_context(std::move(sort_context)),
+              _sort_info(sort_info),
+              _is_asc_order(is_asc_order),
+              _is_null_first(is_null_first),
+              _order_by_types(order_by_types),
+              _materialized_tuple_desc(materialized_tuple_desc),
+              _child_row_desc(child_row_desc),
+              _row_desc(row_desc) {}
+
+    ~PartitionSortSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t driver_instance_count, int32_t driver_sequence) override {
+        _sort_context->set_num_partitions(driver_instance_count);
+        auto sink_operator = std::make_shared<PartitionSortSinkOperator>(
+                _id, _plan_node_id, driver_sequence, _sort_context, _sort_info, _is_asc_order, _is_null_first,
+                _order_by_types, _materialized_tuple_desc, _child_row_desc, _row_desc);
+        sink_operator->set_runtime_predicate(_runtime_predicate);
+        if (!_partition_exprs.empty()) {
+            sink_operator->set_partition_topn(&_partition_exprs, _partition_limit);
+        }
+        return sink_operator;
+    }
+
+    void set_runtime_predicate(vectorized::RuntimePredicatePtr runtime_predicate) {
+        _runtime_predicate = std::move(runtime_predicate);
+    }
+
+    void set_partition_topn(const std::vector<TExpr>& partition_exprs, int64_t partition_limit) {
+        _partition_exprs = partition_exprs;
+        _partition_limit = partition_limit;
+    }
+
+private:
+    SortContextPtr _sort_context;
+    const TSortInfo _sort_info;
+    const std::vector<bool> _is_asc_order;
+    const std::vector<bool> _is_null_first;
+    const std::vector<vectorized::OrderByType> _order_by_types;
+    TupleDescriptor* _materialized_tuple_desc;
+    const RowDescriptor& _child_row_desc;
+    const RowDescriptor& _row_desc;
+    vectorized::RuntimePredicatePtr _runtime_predicate;
+    std::vector<TExpr> _partition_exprs;
+    int64_t _partition_limit = -1;
+};
+
+} // namespace pipeline
+} // namespace starrocks
@@ -0,0 +1,86 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "exec/vectorized/chunks_sorter.h"
+
+namespace starrocks {
+class RuntimeState;
+namespace pipeline {
+class SortContext;
+using SortContextPtr = std::shared_ptr<SortContext>;
+
+// SortContext is shared by all the PartitionSortSinkOperators of a sort node and the paired
+// LocalMergeSortSourceOperator. Each sink operator sorts the chunks of its own driver by its own
+// ChunksSorter, and the source operator merges the sorted runs of all the ChunksSorters once
+// all the sink operators have finished.
+class SortContext {
+public:
+    SortContext(int64_t offset, int64_t limit) : _offset(offset), _limit(limit) {}
+
+    // Called by the factory of sink operators with the number of drivers.
+    void set_num_partitions(int32_t num_partitions) {
+        if (_num_partitions == 0) {
+            _num_partitions = num_partitions;
+            _chunks_sorters.resize(num_partitions);
+        }
+        DCHECK_EQ(_num_partitions, num_partitions);
+    }
+
+    // Called by every sink operator in its prepare, before any driver runs.
+    void set_partition_chunks_sorter(int32_t driver_sequence, std::shared_ptr<vectorized::ChunksSorter> sorter) {
+        DCHECK_LT(driver_sequence, _chunks_sorters.size());
+        _chunks_sorters[driver_sequence] = std::move(sorter);
+    }
+
+    // Called by every sink operator once its ChunksSorter is done.
+    void finish_partition(const Status& status) {
+        if (!status.ok()) {
+            std::lock_guard<std::mutex> l(_status_lock);
+            if (_partition_sort_status.ok()) {
+                _partition_sort_status = status;
+            }
+        }
+        _num_partitions_finished.fetch_add(1, std::memory_order_release);
+    }
+
+    bool is_partition_sort_finished() const {
+        return _num_partitions_finished.load(std::memory_order_acquire) == _num_partitions;
+    }
+
+    // Can only be used after is_partition_sort_finished() returns true.
+    Status partition_sort_status() {
+        std::lock_guard<std::mutex> l(_status_lock);
+        return _partition_sort_status;
+    }
+
+    const std::vector<std::shared_ptr<vectorized::ChunksSorter>>& chunks_sorters() const { return _chunks_sorters; }
+
+    int64_t offset() const { return _offset; }
+    int64_t limit() const { return _limit; }
+
+    // A SortContext is referenced by all the sink operators and the source operator,
+    // the last one which calls unref releases the sorted data.
+    void ref() { _num_refs.fetch_add(1, std::memory_order_relaxed); }
+    void unref(RuntimeState* state) {
+        if (_num_refs.fetch_sub(1) == 1) {
+            _chunks_sorters.clear();
+        }
+    }
+
+private:
+    const int64_t _offset;
+    const int64_t _limit;
+    size_t _num_partitions = 0;
+    std::vector<std::shared_ptr<vectorized::ChunksSorter>> _chunks_sorters;
+    std::atomic<size_t> _num_partitions_finished{0};
+    std::mutex _status_lock;
+    Status _partition_sort_status;
+    std::atomic<int32_t> _num_refs{0};
+};
+
+} // namespace pipeline
+} // namespace starrocks
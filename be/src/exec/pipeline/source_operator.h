@@ -10,6 +10,19 @@ namespace pipeline {
 class SourceOperator;
 using SourceOperatorPtr = std::shared_ptr<SourceOperator>;
 
+class SourceOperatorFactory : public OperatorFactory {
+public:
+    SourceOperatorFactory(int32_t id, int32_t plan_node_id) : OperatorFactory(id, plan_node_id) {}
+    bool is_source() const override { return true; }
+    // The degree of parallelism of the pipeline that this source operator belongs to,
+    // i.e. the number of drivers created for the pipeline.
+    size_t degree_of_parallelism() const { return _degree_of_parallelism; }
+    void set_degree_of_parallelism(size_t degree_of_parallelism) { _degree_of_parallelism = degree_of_parallelism; }
+
+protected:
+    size_t _degree_of_parallelism = 1;
+};
+
 class SourceOperator : public Operator {
 public:
     SourceOperator(int32_t id, std::string name, int32_t plan_node_id) : Operator(id, name, plan_node_id) {}
@@ -112,7 +112,7 @@ Status SelectNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
     }
     {
         SCOPED_TIMER(_conjunct_evaluate_timer);
-        ExecNode::eval_conjuncts(_conjunct_ctxs, (*chunk).get());
+        ExecNode::eval_conjuncts(_conjunct_ctxs, (*chunk).get(), nullptr, &_conjunct_order);
     }
     _num_rows_returned += (*chunk)->num_rows();
 
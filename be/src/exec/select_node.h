@@ -24,6 +24,7 @@
 
 #include "exec/exec_node.h"
 #include "runtime/mem_pool.h"
+#include "util/adaptive_predicate_order.h"
 
 namespace starrocks {
 
@@ -58,6 +59,8 @@ private:
     bool copy_rows(RowBatch* output_batch);
 
     RuntimeProfile::Counter* _conjunct_evaluate_timer = nullptr;
+
+    AdaptivePredicateOrder _conjunct_order;
 };
 
 } // namespace starrocks
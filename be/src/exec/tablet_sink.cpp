@@ -38,7 +38,10 @@
 #include "service/brpc.h"
 #include "simd/simd.h"
 #include "storage/hll.h"
+#include "util/block_compression.h"
 #include "util/brpc_stub_cache.h"
+#include "util/compression_utils.h"
+#include "util/load_stage_metrics.h"
 #include "util/monotime.h"
 #include "util/uid_util.h"
 
@@ -101,6 +104,13 @@ Status NodeChannel::init(RuntimeState* state) {
         _cur_add_chunk_request.set_sender_id(_parent->_sender_id);
         _cur_add_chunk_request.set_eos(false);
         _cur_chunk = std::make_unique<vectorized::Chunk>();
+
+        if (state->query_options().__isset.transmission_compression_type) {
+            _compress_type = CompressionUtils::to_compression_pb(state->query_options().transmission_compression_type);
+        } else if (config::compress_rowbatches) {
+            _compress_type = CompressionTypePB::LZ4;
+        }
+        RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
     } else {
         _row_desc = std::make_unique<RowDescriptor>(_tuple_desc, false);
         _batch_size = state->batch_size();
@@ -130,6 +140,20 @@ void NodeChannel::open() {
         auto ptablet = request.add_tablets();
         ptablet->set_partition_id(tablet.partition_id);
         ptablet->set_tablet_id(tablet.tablet_id);
+        if (_parent->_write_single_replica) {
+            const auto& node_ids = _parent->_location->find_tablet(tablet.tablet_id)->node_ids;
+            if (node_ids[0] != _node_id) {
+                ptablet->set_is_secondary_replica(true);
+                continue;
+            }
+            for (size_t i = 1; i < node_ids.size(); ++i) {
+                // all the nodes are known, by NodeChannel::init() of their channels
+                const NodeInfo* node = _parent->_nodes_info->find_node(node_ids[i]);
+                auto* replica = ptablet->add_secondary_replicas();
+                replica->set_host(node->host);
+                replica->set_port(node->brpc_port);
+            }
+        }
     }
     request.set_num_senders(_parent->_num_senders);
     request.set_need_gen_rollup(_parent->_need_gen_rollup);
@@ -202,6 +226,12 @@ Status NodeChannel::open_wait() {
             _add_batch_counter.add_batch_wait_lock_time_us += result.wait_lock_time_us();
             _add_batch_counter.add_batch_num++;
         }
+        _add_batch_counter.add_batch_rpc_time_us += _add_batch_closure->cntl.latency_us();
+        if (result.has_memtable_insert_time_us()) {
+            _add_batch_counter.memtable_insert_time_us += result.memtable_insert_time_us();
+            _add_batch_counter.memtable_sort_time_us += result.memtable_sort_time_us();
+            _add_batch_counter.flush_time_us += result.flush_time_us();
+        }
     });
 
     return status;
@@ -271,7 +301,8 @@ Status NodeChannel::add_chunk(vectorized::Chunk* chunk, const int64_t* tablet_id
         _mem_tracker->consume(_cur_chunk->memory_usage());
     }
 
-    if (_cur_chunk->num_rows() >= config::vector_chunk_size) {
+    if (_cur_chunk->num_rows() >= config::vector_chunk_size ||
+        (_cur_chunk->num_rows() > 0 && _cur_chunk->memory_usage() >= config::tablet_sink_max_chunk_bytes)) {
         {
             SCOPED_RAW_TIMER(&_queue_push_lock_ns);
             std::lock_guard<std::mutex> l(_pending_batches_lock);
@@ -423,6 +454,35 @@ int NodeChannel::try_send_and_fetch_status() {
     return _send_finished ? 0 : 1;
 }
 
+Status NodeChannel::_serialize_chunk(const vectorized::Chunk* src, ChunkPB* dst) {
+    dst->set_compress_type(CompressionTypePB::NO_COMPRESSION);
+    size_t uncompressed_size = src->serialize_with_meta(dst);
+    if (_compress_codec != nullptr && _compress_codec->exceed_max_input_size(uncompressed_size)) {
+        return Status::InternalError("The input size for compression should be less than " +
+                                     std::to_string(_compress_codec->max_input_size()));
+    }
+
+    dst->set_uncompressed_size(uncompressed_size);
+    // Try compressing the rows of all the tablets at once, and keep the compressed data only if it pays off.
+    if (_compress_codec != nullptr && uncompressed_size > 0) {
+        size_t max_compressed_size = _compress_codec->max_compressed_len(uncompressed_size);
+        if (_compression_scratch.size() < max_compressed_size) {
+            _compression_scratch.resize(max_compressed_size);
+        }
+
+        Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
+        RETURN_IF_ERROR(_compress_codec->compress(dst->data(), &compressed_slice));
+        double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
+        if (LIKELY(compress_ratio > config::rpc_compress_ratio_threshold)) {
+            _compression_scratch.resize(compressed_slice.size);
+            dst->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
+            dst->set_compress_type(_compress_type);
+        }
+        VLOG_ROW << "uncompressed size: " << uncompressed_size << ", compressed size: " << compressed_slice.size;
+    }
+    return Status::OK();
+}
+
 int NodeChannel::try_send_chunk_and_fetch_status() {
     if (_cancelled | _send_finished) {
         return 0;
@@ -447,7 +507,14 @@ int NodeChannel::try_send_chunk_and_fetch_status() {
         request.set_packet_seq(_next_packet_seq);
         if (chunk->num_rows() > 0) {
             SCOPED_RAW_TIMER(&_serialize_batch_ns);
-            chunk->serialize_with_meta(request.mutable_chunk());
+            auto st = _serialize_chunk(chunk.get(), request.mutable_chunk());
+            if (!st.ok()) {
+                _cancelled = true;
+                LOG(WARNING) << name() << " serialize chunk failed, " << print_load_info()
+                             << ", errmsg=" << st.get_error_msg();
+                _mem_tracker->release(chunk->memory_usage());
+                return 0;
+            }
         }
 
         _add_batch_closure->reset();
@@ -520,6 +587,8 @@ Status IndexChannel::init(RuntimeState* state, const std::vector<TTabletWithPart
         std::vector<NodeChannel*> channels;
         std::vector<int64_t> bes;
         for (auto& node_id : location->node_ids) {
+            // the channels of the secondary replicas of a single replica load are opened and closed with the tablet,
+            // but sent no data
             NodeChannel* channel = nullptr;
             auto it = _node_channels.find(node_id);
             if (it == std::end(_node_channels)) {
@@ -531,7 +600,9 @@ Status IndexChannel::init(RuntimeState* state, const std::vector<TTabletWithPart
             }
             channel->add_tablet(tablet);
             channels.push_back(channel);
-            bes.emplace_back(node_id);
+            if (!_parent->_write_single_replica || bes.empty()) {
+                bes.emplace_back(node_id);
+            }
         }
         _channels_by_tablet.emplace(tablet.tablet_id, std::move(channels));
         _tablet_to_be.emplace(tablet.tablet_id, std::move(bes));
@@ -561,6 +632,10 @@ Status IndexChannel::add_row(Tuple* tuple, int64_t tablet_id) {
 }
 
 bool IndexChannel::has_intolerable_failure() {
+    if (_parent->_write_single_replica) {
+        // the tablets of a failed primary replica have no replica written
+        return !_failed_channels.empty();
+    }
     return _failed_channels.size() >= ((_parent->_num_repicas + 1) / 2);
 }
 
@@ -599,6 +674,7 @@ Status OlapTableSink::init(const TDataSink& t_sink) {
     RETURN_IF_ERROR(_vectorized_partition->init());
     _location = _pool->add(new OlapTableLocationParam(table_sink.location));
     _nodes_info = _pool->add(new StarRocksNodesInfo(table_sink.nodes_info));
+    _write_single_replica = _is_vectorized && _num_repicas > 1 && config::enable_single_replica_load;
 
     if (table_sink.__isset.load_channel_timeout_s) {
         _load_channel_timeout_s = table_sink.load_channel_timeout_s;
@@ -1032,6 +1108,20 @@ Status OlapTableSink::close(RuntimeState* state, Status close_status) {
                << (pair.second.add_batch_wait_lock_time_us / 1000) << ")(" << pair.second.add_batch_num << ")} ";
         }
         LOG(INFO) << ss.str();
+
+        AddBatchCounter total_add_batch_counter;
+        for (auto const& pair : node_add_batch_counter_map) {
+            total_add_batch_counter += pair.second;
+        }
+        state->update_load_stage_ns(LoadStageMetrics::SINK_RPC, total_add_batch_counter.add_batch_rpc_time_us * 1000);
+        state->update_load_stage_ns(LoadStageMetrics::TABLETS_CHANNEL,
+                                    total_add_batch_counter.add_batch_execution_time_us * 1000);
+        state->update_load_stage_ns(LoadStageMetrics::MEMTABLE_INSERT,
+                                    total_add_batch_counter.memtable_insert_time_us * 1000);
+        state->update_load_stage_ns(LoadStageMetrics::MEMTABLE_SORT,
+                                    total_add_batch_counter.memtable_sort_time_us * 1000);
+        state->update_load_stage_ns(LoadStageMetrics::FLUSH, total_add_batch_counter.flush_time_us * 1000);
+        LoadStageMetrics::add(LoadStageMetrics::SINK_RPC, total_add_batch_counter.add_batch_rpc_time_us * 1000);
     } else {
         for (auto& channel : _channels) {
             channel->for_each_node_channel([](NodeChannel* ch) { ch->cancel(); });
@@ -37,12 +37,14 @@
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "util/bitmap.h"
+#include "util/raw_container.h"
 #include "util/ref_count_closure.h"
 #include "util/thrift_util.h"
 
 namespace starrocks {
 
 class Bitmap;
+class BlockCompressionCodec;
 class MemTracker;
 class RuntimeProfile;
 class RowDescriptor;
@@ -63,10 +65,20 @@ struct AddBatchCounter {
     int64_t add_batch_wait_lock_time_us = 0;
     // number of add_batch call
     int64_t add_batch_num = 0;
+    // total time of the add_batch rpcs from being sent to being responded
+    int64_t add_batch_rpc_time_us = 0;
+    // time of the stages of the delta writers of the receiver
+    int64_t memtable_insert_time_us = 0;
+    int64_t memtable_sort_time_us = 0;
+    int64_t flush_time_us = 0;
     AddBatchCounter& operator+=(const AddBatchCounter& rhs) {
         add_batch_execution_time_us += rhs.add_batch_execution_time_us;
         add_batch_wait_lock_time_us += rhs.add_batch_wait_lock_time_us;
         add_batch_num += rhs.add_batch_num;
+        add_batch_rpc_time_us += rhs.add_batch_rpc_time_us;
+        memtable_insert_time_us += rhs.memtable_insert_time_us;
+        memtable_sort_time_us += rhs.memtable_sort_time_us;
+        flush_time_us += rhs.flush_time_us;
         return *this;
     }
     friend AddBatchCounter operator+(const AddBatchCounter& lhs, const AddBatchCounter& rhs) {
@@ -197,6 +209,9 @@ public:
     void clear_all_batches();
 
 private:
+    // Serialize |src| into |dst|, compressed with _compress_codec if it is set.
+    Status _serialize_chunk(const vectorized::Chunk* src, ChunkPB* dst);
+
     std::unique_ptr<MemTracker> _mem_tracker = nullptr;
 
     OlapTableSink* _parent = nullptr;
@@ -251,6 +266,10 @@ private:
     using AddChunkReq = std::pair<std::unique_ptr<vectorized::Chunk>, PTabletWriterAddChunkRequest>;
     std::queue<AddChunkReq> _pending_chunks;
     PTabletWriterAddChunkRequest _cur_add_chunk_request;
+    // The chunks to a backend carry the rows of all its tablets of the index, compressed as the exchange does.
+    CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
+    const BlockCompressionCodec* _compress_codec = nullptr;
+    raw::RawString _compression_scratch;
 
     int64_t _mem_exceeded_block_ns = 0;
     int64_t _queue_push_lock_ns = 0;
@@ -410,6 +429,9 @@ private:
 
     // vectorized:
     bool _is_vectorized = false;
+    // only the first replica of a tablet is sent the data, and sends the segments it writes to the other replicas,
+    // see PTabletWithPartition. By config::enable_single_replica_load.
+    bool _write_single_replica = false;
     std::vector<vectorized::OlapTablePartition*> _partitions;
     std::vector<uint32_t> _tablet_indexes;
     // one chunk selection index for partition validation and data validation
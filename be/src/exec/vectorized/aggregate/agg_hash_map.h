@@ -11,29 +11,167 @@
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "util/hash_util.hpp"
+#include "util/huge_page.h"
 #include "util/phmap/phmap.h"
 #include "util/phmap/phmap_dump.h"
 
 namespace starrocks::vectorized {
 
 using AggDataPtr = uint8_t*;
+
+// The large agg hash maps have their slots backed by the huge pages, see madvise_huge_pages(), since the groups are
+// looked up at random. The maps of int8 and int16 keys are too small to need it.
+template <typename Key>
+using AggHashMapAllocator = HugePageAllocator<phmap::priv::Pair<const Key, AggDataPtr>>;
+template <typename Key, typename Hash, typename Eq = phmap::priv::hash_default_eq<Key>>
+using AggFlatHashMap = phmap::flat_hash_map<Key, AggDataPtr, Hash, Eq, AggHashMapAllocator<Key>>;
+
 template <PhmapSeed seed>
 using Int8AggHashMap = phmap::flat_hash_map<int8_t, AggDataPtr, StdHashWithSeed<int8_t, seed>>;
 template <PhmapSeed seed>
 using Int16AggHashMap = phmap::flat_hash_map<int16_t, AggDataPtr, StdHashWithSeed<int16_t, seed>>;
 template <PhmapSeed seed>
-using Int32AggHashMap = phmap::flat_hash_map<int32_t, AggDataPtr, StdHashWithSeed<int32_t, seed>>;
+using Int32AggHashMap = AggFlatHashMap<int32_t, StdHashWithSeed<int32_t, seed>>;
 template <PhmapSeed seed>
-using Int64AggHashMap = phmap::flat_hash_map<int64_t, AggDataPtr, StdHashWithSeed<int64_t, seed>>;
+using Int64AggHashMap = AggFlatHashMap<int64_t, StdHashWithSeed<int64_t, seed>>;
 template <PhmapSeed seed>
-using DateAggHashMap = phmap::flat_hash_map<DateValue, AggDataPtr, StdHashWithSeed<DateValue, seed>>;
+using DateAggHashMap = AggFlatHashMap<DateValue, StdHashWithSeed<DateValue, seed>>;
 template <PhmapSeed seed>
-using TimeStampAggHashMap = phmap::flat_hash_map<TimestampValue, AggDataPtr, StdHashWithSeed<TimestampValue, seed>>;
+using TimeStampAggHashMap = AggFlatHashMap<TimestampValue, StdHashWithSeed<TimestampValue, seed>>;
 template <PhmapSeed seed>
-using SliceAggHashMap = phmap::flat_hash_map<Slice, AggDataPtr, SliceHashWithSeed<seed>, SliceEqual>;
+using SliceAggHashMap = AggFlatHashMap<Slice, SliceHashWithSeed<seed>, SliceEqual>;
+
+// The key of the group by columns of fixed width packed in N bytes, see FixedSizeKeyLayout.
+template <size_t N>
+struct FixedSizeSliceKey {
+    static_assert(N % 8 == 0);
+    uint64_t u64x[N / 8];
+
+    uint8_t* data() { return reinterpret_cast<uint8_t*>(u64x); }
+    const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(u64x); }
+    bool operator==(const FixedSizeSliceKey& other) const { return memcmp(u64x, other.u64x, N) == 0; }
+};
+
+template <size_t N, PhmapSeed seed>
+class FixedSizeSliceKeyHash {
+public:
+    std::size_t operator()(const FixedSizeSliceKey<N>& key) const {
+        return crc_hash_64(key.u64x, N, SliceHashWithSeed<seed>::CRC_SEED);
+    }
+};
+
+template <size_t N, PhmapSeed seed>
+using FixedSizeSliceAggHashMap = AggFlatHashMap<FixedSizeSliceKey<N>, FixedSizeSliceKeyHash<N, seed>>;
+
+// The place of a group by column in a FixedSizeSliceKey. The value of a nullable column follows
+// its null flag byte, and is zero for null, so that the equal keys have the same bytes.
+struct FixedSizeKeyColumn {
+    uint32_t offset;
+    uint32_t value_size;
+    bool nullable;
+};
+using FixedSizeKeyLayout = std::vector<FixedSizeKeyColumn>;
+
+// The size of the values of the fixed width types which could be packed into FixedSizeSliceKey, otherwise 0.
+inline size_t fixed_size_key_value_size(PrimitiveType type) {
+    switch (type) {
+    case TYPE_BOOLEAN:
+    case TYPE_TINYINT:
+        return 1;
+    case TYPE_SMALLINT:
+        return 2;
+    case TYPE_INT:
+    case TYPE_DATE:
+        return 4;
+    case TYPE_BIGINT:
+    case TYPE_DATETIME:
+        return 8;
+    case TYPE_LARGEINT:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+// Pack the group by columns of every row into a FixedSizeSliceKey by column, rather than serializing
+// them into a slice by row.
+template <size_t N>
+void pack_fixed_size_keys(const FixedSizeKeyLayout& layout, const Columns& key_columns, size_t chunk_size,
+                          std::vector<FixedSizeSliceKey<N>>* keys) {
+    keys->resize(chunk_size);
+    auto* base = reinterpret_cast<uint8_t*>(keys->data());
+    memset(base, 0, chunk_size * N);
+    for (size_t c = 0; c < key_columns.size(); c++) {
+        const FixedSizeKeyColumn& key_column = layout[c];
+        const Column* column = key_columns[c].get();
+        if (column->only_null()) {
+            for (size_t i = 0; i < chunk_size; i++) {
+                base[i * N + key_column.offset] = 1;
+            }
+            continue;
+        }
+
+        const uint8_t* nulls = nullptr;
+        if (column->is_nullable()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(column);
+            if (nullable_column->has_null()) {
+                nulls = nullable_column->immutable_null_column_data().data();
+            }
+            column = nullable_column->data_column().get();
+        }
+        const uint8_t* values = column->raw_data();
+        const uint32_t value_offset = key_column.offset + key_column.nullable;
+        const uint32_t value_size = key_column.value_size;
+        for (size_t i = 0; i < chunk_size; i++) {
+            strings::memcpy_inlined(base + i * N + value_offset, values + i * value_size, value_size);
+        }
+        if (nulls != nullptr) {
+            for (size_t i = 0; i < chunk_size; i++) {
+                if (nulls[i]) {
+                    base[i * N + key_column.offset] = 1;
+                    memset(base + i * N + value_offset, 0, value_size);
+                }
+            }
+        }
+    }
+}
+
+template <size_t N>
+void unpack_fixed_size_keys(const FixedSizeKeyLayout& layout, const std::vector<FixedSizeSliceKey<N>>& keys,
+                            const Columns& key_columns, size_t batch_size) {
+    const auto* base = reinterpret_cast<const uint8_t*>(keys.data());
+    for (size_t c = 0; c < key_columns.size(); c++) {
+        const FixedSizeKeyColumn& key_column = layout[c];
+        Column* column = key_columns[c].get();
+        NullableColumn* nullable_column = nullptr;
+        if (key_column.nullable) {
+            nullable_column = down_cast<NullableColumn*>(column);
+            column = nullable_column->mutable_data_column();
+        }
+
+        const size_t old_size = column->size();
+        const uint32_t value_offset = key_column.offset + key_column.nullable;
+        const uint32_t value_size = key_column.value_size;
+        column->resize_uninitialized(old_size + batch_size);
+        uint8_t* values = column->mutable_raw_data() + old_size * value_size;
+        for (size_t i = 0; i < batch_size; i++) {
+            strings::memcpy_inlined(values + i * value_size, base + i * N + value_offset, value_size);
+        }
+        if (nullable_column != nullptr) {
+            auto& nulls = nullable_column->null_column_data();
+            nulls.resize(old_size + batch_size);
+            for (size_t i = 0; i < batch_size; i++) {
+                nulls[old_size + i] = base[i * N + key_column.offset];
+            }
+            nullable_column->update_has_null();
+        }
+    }
+}
 
 template <PhmapSeed seed>
-using Int32AggTwoLevelHashMap = phmap::parallel_flat_hash_map<int32_t, AggDataPtr, StdHashWithSeed<int32_t, seed>>;
+using Int32AggTwoLevelHashMap =
+        phmap::parallel_flat_hash_map<int32_t, AggDataPtr, StdHashWithSeed<int32_t, seed>,
+                                      phmap::priv::hash_default_eq<int32_t>, AggHashMapAllocator<int32_t>>;
 
 // The SliceAggTwoLevelHashMap will have 2 ^ 4 = 16 sub map,
 // The 16 is same as PartitionedAggregationNode::PARTITION_FANOUT
@@ -41,7 +179,7 @@ static constexpr uint8_t PHMAPN = 4;
 template <PhmapSeed seed>
 using SliceAggTwoLevelHashMap =
         phmap::parallel_flat_hash_map<Slice, AggDataPtr, SliceHashWithSeed<seed>, SliceEqual,
-                                      phmap::priv::Allocator<phmap::priv::Pair<const Slice, AggDataPtr>>, PHMAPN>;
+                                      AggHashMapAllocator<Slice>, PHMAPN>;
 
 // TODO(kks): Remove redundant code for compute_agg_states method
 // handle one number hash key
@@ -502,4 +640,53 @@ struct AggHashMapWithSerializedKey {
     uint8_t* buffer;
     ResultVector results;
 };
+
+// For the group by columns of fixed width whose total size with the null flags is at most N bytes,
+// the keys are packed into FixedSizeSliceKey<N> instead of being serialized into slices.
+template <typename HashMap>
+struct AggHashMapWithSerializedKeyFixedSize {
+    using KeyType = typename HashMap::key_type;
+    using Iterator = typename HashMap::iterator;
+    using ResultVector = typename std::vector<KeyType>;
+    HashMap hash_map;
+
+    template <typename Func>
+    void compute_agg_states(size_t chunk_size, const Columns& key_columns, MemPool* pool, Func&& allocate_func,
+                            Buffer<AggDataPtr>* agg_states) {
+        pack_fixed_size_keys(layout, key_columns, chunk_size, &packed_keys);
+        for (size_t i = 0; i < chunk_size; ++i) {
+            const KeyType& key = packed_keys[i];
+            auto iter = hash_map.lazy_emplace(key, [&](const auto& ctor) { ctor(key, allocate_func()); });
+            (*agg_states)[i] = iter->second;
+        }
+    }
+
+    // Elements queried in HashMap will be added to HashMap,
+    // elements that cannot be queried are not processed,
+    // and are mainly used in the first stage of two-stage aggregation when aggr reduction is low
+    template <typename Func>
+    void compute_agg_states(size_t chunk_size, const Columns& key_columns, Func&& allocate_func,
+                            Buffer<AggDataPtr>* agg_states, std::vector<uint8_t>* not_founds) {
+        pack_fixed_size_keys(layout, key_columns, chunk_size, &packed_keys);
+        not_founds->assign(chunk_size, 0);
+        for (size_t i = 0; i < chunk_size; ++i) {
+            if (auto iter = hash_map.find(packed_keys[i]); iter != hash_map.end()) {
+                (*agg_states)[i] = iter->second;
+            } else {
+                (*not_founds)[i] = 1;
+            }
+        }
+    }
+
+    void insert_keys_to_columns(ResultVector& keys, const Columns& key_columns, int32_t batch_size) {
+        unpack_fixed_size_keys(layout, keys, key_columns, batch_size);
+    }
+
+    static constexpr bool has_single_null_key = false;
+
+    // Set by the Aggregator after the hash map is created.
+    FixedSizeKeyLayout layout;
+    ResultVector packed_keys;
+    ResultVector results;
+};
 } // namespace starrocks::vectorized
@@ -4,6 +4,7 @@
 
 #include "column/column_hash.h"
 #include "column/type_traits.h"
+#include "exec/vectorized/aggregate/agg_hash_map.h"
 #include "gutil/casts.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
@@ -25,6 +26,9 @@ using DateAggHashSet = phmap::flat_hash_set<DateValue, StdHashWithSeed<DateValue
 template <PhmapSeed seed>
 using TimeStampAggHashSet = phmap::flat_hash_set<TimestampValue, StdHashWithSeed<TimestampValue, seed>>;
 
+template <size_t N, PhmapSeed seed>
+using FixedSizeSliceAggHashSet = phmap::flat_hash_set<FixedSizeSliceKey<N>, FixedSizeSliceKeyHash<N, seed>>;
+
 // By storing hash value in slice, we can save the cost of
 // 1. re-calculate hash value of the slice
 // 2. touch slice memory area which may cause high latency of memory access.
@@ -430,4 +434,42 @@ struct AggHashSetOfSerializedKey {
     ResultVector results;
 };
 
+// Like AggHashMapWithSerializedKeyFixedSize, the keys are packed into FixedSizeSliceKey<N>.
+template <typename HashSet>
+struct AggHashSetOfSerializedKeyFixedSize {
+    using Iterator = typename HashSet::iterator;
+    using KeyType = typename HashSet::key_type;
+    using ResultVector = typename std::vector<KeyType>;
+    HashSet hash_set;
+
+    void build_set(size_t chunk_size, const Columns& key_columns, MemPool* pool) {
+        pack_fixed_size_keys(layout, key_columns, chunk_size, &packed_keys);
+        for (size_t i = 0; i < chunk_size; ++i) {
+            hash_set.emplace(packed_keys[i]);
+        }
+    }
+
+    // Elements queried in HashSet will be added to HashSet
+    // elements that cannot be queried are not processed,
+    // and are mainly used in the first stage of two-stage aggregation when aggr reduction is low
+    void build_set(size_t chunk_size, const Columns& key_columns, std::vector<uint8_t>* not_founds) {
+        pack_fixed_size_keys(layout, key_columns, chunk_size, &packed_keys);
+        not_founds->assign(chunk_size, 0);
+        for (size_t i = 0; i < chunk_size; ++i) {
+            (*not_founds)[i] = !hash_set.contains(packed_keys[i]);
+        }
+    }
+
+    void insert_keys_to_columns(ResultVector& keys, const Columns& key_columns, int32_t batch_size) {
+        unpack_fixed_size_keys(layout, keys, key_columns, batch_size);
+    }
+
+    static constexpr bool has_single_null_key = false;
+
+    // Set by the Aggregator after the hash set is created.
+    FixedSizeKeyLayout layout;
+    ResultVector packed_keys;
+    ResultVector results;
+};
+
 } // namespace starrocks::vectorized
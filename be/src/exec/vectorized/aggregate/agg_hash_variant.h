@@ -21,6 +21,9 @@ namespace starrocks::vectorized {
     M(phase1_slice)                   \
     M(phase1_slice_two_level)         \
     M(phase1_int32_two_level)         \
+    M(phase1_slice_fx8)               \
+    M(phase1_slice_fx16)              \
+    M(phase1_slice_fx32)              \
     M(phase2_int8)                    \
     M(phase2_int16)                   \
     M(phase2_int32)                   \
@@ -30,7 +33,10 @@ namespace starrocks::vectorized {
     M(phase2_string)                  \
     M(phase2_slice)                   \
     M(phase2_slice_two_level)         \
-    M(phase2_int32_two_level)
+    M(phase2_int32_two_level)         \
+    M(phase2_slice_fx8)               \
+    M(phase2_slice_fx16)              \
+    M(phase2_slice_fx32)
 
 #define APPLY_FOR_VARIANT_NULL(M) \
     M(phase1_null_int8)           \
@@ -66,6 +72,9 @@ namespace starrocks::vectorized {
     M(phase1_null_string)        \
     M(phase1_slice_two_level)    \
     M(phase1_int32_two_level)    \
+    M(phase1_slice_fx8)          \
+    M(phase1_slice_fx16)         \
+    M(phase1_slice_fx32)         \
     M(phase2_int8)               \
     M(phase2_int16)              \
     M(phase2_int32)              \
@@ -82,6 +91,24 @@ namespace starrocks::vectorized {
     M(phase2_null_timestamp)     \
     M(phase2_null_string)        \
     M(phase2_slice_two_level)    \
+    M(phase2_int32_two_level)    \
+    M(phase2_slice_fx8)          \
+    M(phase2_slice_fx16)         \
+    M(phase2_slice_fx32)
+
+#define APPLY_FOR_VARIANT_FIXED_SIZE_KEY(M) \
+    M(phase1_slice_fx8)                     \
+    M(phase1_slice_fx16)                    \
+    M(phase1_slice_fx32)                    \
+    M(phase2_slice_fx8)                     \
+    M(phase2_slice_fx16)                    \
+    M(phase2_slice_fx32)
+
+// The variants of parallel_flat_hash_map, whose submaps could be iterated separately.
+#define APPLY_FOR_VARIANT_TWO_LEVEL(M) \
+    M(phase1_slice_two_level)          \
+    M(phase1_int32_two_level)          \
+    M(phase2_slice_two_level)          \
     M(phase2_int32_two_level)
 
 // Hash maps for phase1
@@ -121,6 +148,12 @@ template <PhmapSeed seed>
 using SerializedKeyTwoLevelAggHashMap = AggHashMapWithSerializedKey<SliceAggTwoLevelHashMap<seed>>;
 template <PhmapSeed seed>
 using Int32TwoLevelAggHashMapWithOneNumberKey = AggHashMapWithOneNumberKey<int32_t, Int32AggTwoLevelHashMap<seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize8AggHashMap = AggHashMapWithSerializedKeyFixedSize<FixedSizeSliceAggHashMap<8, seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize16AggHashMap = AggHashMapWithSerializedKeyFixedSize<FixedSizeSliceAggHashMap<16, seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize32AggHashMap = AggHashMapWithSerializedKeyFixedSize<FixedSizeSliceAggHashMap<32, seed>>;
 
 // 1) For different group by columns type, size, cardinality, volume, we should choose different
 // hash functions and different hashmaps.
@@ -153,6 +186,9 @@ struct HashMapVariant {
         phase1_slice,
         phase1_slice_two_level,
         phase1_int32_two_level,
+        phase1_slice_fx8,
+        phase1_slice_fx16,
+        phase1_slice_fx32,
         phase2_int8,
         phase2_int16,
         phase2_int32,
@@ -169,7 +205,10 @@ struct HashMapVariant {
         phase2_null_string,
         phase2_slice,
         phase2_slice_two_level,
-        phase2_int32_two_level
+        phase2_int32_two_level,
+        phase2_slice_fx8,
+        phase2_slice_fx16,
+        phase2_slice_fx32
     };
     Type type = Type::phase1_slice;
 
@@ -190,6 +229,9 @@ struct HashMapVariant {
     std::unique_ptr<SerializedKeyAggHashMap<PhmapSeed1>> phase1_slice;
     std::unique_ptr<SerializedKeyTwoLevelAggHashMap<PhmapSeed1>> phase1_slice_two_level;
     std::unique_ptr<Int32TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1>> phase1_int32_two_level;
+    std::unique_ptr<SerializedKeyFixedSize8AggHashMap<PhmapSeed1>> phase1_slice_fx8;
+    std::unique_ptr<SerializedKeyFixedSize16AggHashMap<PhmapSeed1>> phase1_slice_fx16;
+    std::unique_ptr<SerializedKeyFixedSize32AggHashMap<PhmapSeed1>> phase1_slice_fx32;
 
     std::unique_ptr<Int8AggHashMapWithOneNumberKey<PhmapSeed2>> phase2_int8;
     std::unique_ptr<Int16AggHashMapWithOneNumberKey<PhmapSeed2>> phase2_int16;
@@ -208,6 +250,9 @@ struct HashMapVariant {
     std::unique_ptr<SerializedKeyAggHashMap<PhmapSeed2>> phase2_slice;
     std::unique_ptr<SerializedKeyTwoLevelAggHashMap<PhmapSeed2>> phase2_slice_two_level;
     std::unique_ptr<Int32TwoLevelAggHashMapWithOneNumberKey<PhmapSeed2>> phase2_int32_two_level;
+    std::unique_ptr<SerializedKeyFixedSize8AggHashMap<PhmapSeed2>> phase2_slice_fx8;
+    std::unique_ptr<SerializedKeyFixedSize16AggHashMap<PhmapSeed2>> phase2_slice_fx16;
+    std::unique_ptr<SerializedKeyFixedSize32AggHashMap<PhmapSeed2>> phase2_slice_fx32;
 
     void init(Type type_) {
         type = type_;
@@ -221,6 +266,20 @@ struct HashMapVariant {
         }
     }
 
+    // For the variants of the keys packed into FixedSizeSliceKey.
+    void set_fixed_size_key_layout(const FixedSizeKeyLayout& layout) {
+        switch (type) {
+#define M(NAME)                \
+    case Type::NAME:           \
+        NAME->layout = layout; \
+        break;
+            APPLY_FOR_VARIANT_FIXED_SIZE_KEY(M)
+#undef M
+        default:
+            break;
+        }
+    }
+
     size_t capacity() const {
         switch (type) {
 #define M(NAME)      \
@@ -298,6 +357,12 @@ template <PhmapSeed seed>
 using SerializedTwoLevelKeyAggHashSet = AggHashSetOfSerializedKey<SliceAggTwoLevelHashSet<seed>>;
 template <PhmapSeed seed>
 using Int32TwoLevelAggHashSetOfOneNumberKey = AggHashSetOfOneNumberKey<int32_t, Int32AggTwoLevelHashSet<seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize8AggHashSet = AggHashSetOfSerializedKeyFixedSize<FixedSizeSliceAggHashSet<8, seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize16AggHashSet = AggHashSetOfSerializedKeyFixedSize<FixedSizeSliceAggHashSet<16, seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize32AggHashSet = AggHashSetOfSerializedKeyFixedSize<FixedSizeSliceAggHashSet<32, seed>>;
 
 // 1) HashSetVariant is alike HashMapVariant, while a set only holds keys, no associated value.
 //
@@ -326,6 +391,9 @@ struct HashSetVariant {
         phase1_slice,
         phase1_slice_two_level,
         phase1_int32_two_level,
+        phase1_slice_fx8,
+        phase1_slice_fx16,
+        phase1_slice_fx32,
         phase2_int8,
         phase2_int16,
         phase2_int32,
@@ -342,7 +410,10 @@ struct HashSetVariant {
         phase2_null_string,
         phase2_slice,
         phase2_slice_two_level,
-        phase2_int32_two_level
+        phase2_int32_two_level,
+        phase2_slice_fx8,
+        phase2_slice_fx16,
+        phase2_slice_fx32
     };
     Type type = Type::phase1_slice;
 
@@ -363,6 +434,9 @@ struct HashSetVariant {
     std::unique_ptr<SerializedKeyAggHashSet<PhmapSeed1>> phase1_slice;
     std::unique_ptr<SerializedTwoLevelKeyAggHashSet<PhmapSeed1>> phase1_slice_two_level;
     std::unique_ptr<Int32TwoLevelAggHashSetOfOneNumberKey<PhmapSeed1>> phase1_int32_two_level;
+    std::unique_ptr<SerializedKeyFixedSize8AggHashSet<PhmapSeed1>> phase1_slice_fx8;
+    std::unique_ptr<SerializedKeyFixedSize16AggHashSet<PhmapSeed1>> phase1_slice_fx16;
+    std::unique_ptr<SerializedKeyFixedSize32AggHashSet<PhmapSeed1>> phase1_slice_fx32;
 
     std::unique_ptr<Int8AggHashSetOfOneNumberKey<PhmapSeed2>> phase2_int8;
     std::unique_ptr<Int16AggHashSetOfOneNumberKey<PhmapSeed2>> phase2_int16;
@@ -381,6 +455,9 @@ struct HashSetVariant {
     std::unique_ptr<SerializedKeyAggHashSet<PhmapSeed2>> phase2_slice;
     std::unique_ptr<SerializedTwoLevelKeyAggHashSet<PhmapSeed2>> phase2_slice_two_level;
     std::unique_ptr<Int32TwoLevelAggHashSetOfOneNumberKey<PhmapSeed2>> phase2_int32_two_level;
+    std::unique_ptr<SerializedKeyFixedSize8AggHashSet<PhmapSeed2>> phase2_slice_fx8;
+    std::unique_ptr<SerializedKeyFixedSize16AggHashSet<PhmapSeed2>> phase2_slice_fx16;
+    std::unique_ptr<SerializedKeyFixedSize32AggHashSet<PhmapSeed2>> phase2_slice_fx32;
 
     void init(Type type_) {
         type = type_;
@@ -394,6 +471,20 @@ struct HashSetVariant {
         }
     }
 
+    // For the variants of the keys packed into FixedSizeSliceKey.
+    void set_fixed_size_key_layout(const FixedSizeKeyLayout& layout) {
+        switch (type) {
+#define M(NAME)                \
+    case Type::NAME:           \
+        NAME->layout = layout; \
+        break;
+            APPLY_FOR_VARIANT_FIXED_SIZE_KEY(M)
+#undef M
+        default:
+            break;
+        }
+    }
+
     size_t capacity() const {
         switch (type) {
 #define M(NAME)      \
@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "exprs/agg/aggregate.h"
+#include "runtime/mem_pool.h"
+
+namespace starrocks::vectorized {
+
+// AggStateArena allocates the agg states of the groups from blocks of the aggregator's MemPool. Every
+// block holds the states of many groups, so that the states of the new groups of a chunk are allocated
+// by bumping a pointer rather than an aligned MemPool allocation per group. The states are |state_size|
+// bytes apart in a block, and aligned to |state_align|, the max alignment of all the agg functions.
+class AggStateArena {
+public:
+    AggStateArena(MemPool* mem_pool, size_t state_size, size_t state_align)
+            : _mem_pool(mem_pool),
+              _state_size(std::max((state_size + state_align - 1) / state_align * state_align, state_align)),
+              _state_align(state_align) {}
+
+    AggDataPtr allocate() {
+        if (UNLIKELY(_pos == _end)) {
+            _allocate_block();
+        }
+        AggDataPtr state = _pos;
+        _pos += _state_size;
+        return state;
+    }
+
+    // Must be called once the MemPool is cleared.
+    void reset() {
+        _pos = nullptr;
+        _end = nullptr;
+        _block_rows = kMinBlockRows;
+    }
+
+private:
+    // The blocks grow from kMinBlockRows to config::vector_chunk_size states, so that an aggregation of
+    // a few groups doesn't waste the space of a whole chunk.
+    static constexpr size_t kMinBlockRows = 16;
+
+    void _allocate_block() {
+        _pos = _mem_pool->allocate_aligned(_block_rows * _state_size, _state_align);
+        _end = _pos + _block_rows * _state_size;
+        _block_rows = std::max(std::min<size_t>(_block_rows * 2, config::vector_chunk_size), kMinBlockRows);
+    }
+
+    MemPool* _mem_pool;
+    const size_t _state_size;
+    const size_t _state_align;
+
+    AggDataPtr _pos = nullptr;
+    AggDataPtr _end = nullptr;
+    size_t _block_rows = kMinBlockRows;
+};
+
+} // namespace starrocks::vectorized
@@ -2,28 +2,43 @@
 
 #include "exec/vectorized/aggregate/aggregate_blocking_node.h"
 
+#include "common/config.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "runtime/current_thread.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "util/countdown_latch.h"
+#include "util/priority_thread_pool.hpp"
+
 namespace starrocks::vectorized {
 
+Status AggregateBlockingNode::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(AggregateBaseNode::prepare(state));
+    _spill_timer = ADD_TIMER(runtime_profile(), "SpillTime");
+    _spilled_partitions_counter = ADD_COUNTER(runtime_profile(), "SpilledPartitions", TUnit::UNIT);
+    _parallel_output_timer = ADD_TIMER(runtime_profile(), "ParallelOutputTime");
+    return Status::OK();
+}
+
 Status AggregateBlockingNode::open(RuntimeState* state) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(ExecNode::open(state));
-    RETURN_IF_ERROR(Expr::open(_group_by_expr_ctxs, state));
-    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
-        RETURN_IF_ERROR(Expr::open(_agg_expr_ctxs[i], state));
-    }
-
-    // Initial for FunctionContext of every aggregate functions
-    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
-        // initial const columns for i'th FunctionContext.
-        _evaluate_const_columns(i);
-    }
-
+    RETURN_IF_ERROR(_aggregator->open(state));
     RETURN_IF_ERROR(_children[0]->open(state));
+    if (_sorted_by_group_keys) {
+        return Status::OK();
+    }
 
     ChunkPtr chunk;
 
-    VLOG_ROW << "_group_by_expr_ctxs size " << _group_by_expr_ctxs.size() << " _needs_finalize " << _needs_finalize;
+    VLOG_ROW << "group_by_expr_ctxs size " << _aggregator->group_by_expr_ctxs().size() << " _needs_finalize "
+             << _aggregator->needs_finalize();
     while (true) {
         bool eos = false;
         RETURN_IF_CANCELLED(state);
@@ -39,51 +54,46 @@ Status AggregateBlockingNode::open(RuntimeState* state) {
 
         DCHECK_LE(chunk->num_rows(), config::vector_chunk_size);
 
-        _evaluate_exprs(chunk.get());
+        _aggregator->evaluate_exprs(chunk.get());
 
         {
-            SCOPED_TIMER(_agg_compute_timer);
-            if (!_group_by_expr_ctxs.empty()) {
-                if (false) {
-                }
-#define HASH_MAP_METHOD(NAME)                                                                        \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                                   \
-            _build_hash_map<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, \
-                                                                            chunk->num_rows());
-                APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-
-                RETURN_IF_ERROR(_check_hash_map_memory_usage(state));
-                _try_convert_to_two_level_map();
+            SCOPED_TIMER(_aggregator->agg_compute_timer());
+            if (!_aggregator->is_none_group_by_exprs()) {
+                _aggregator->build_hash_map(chunk->num_rows());
+                RETURN_IF_ERROR(_aggregator->check_hash_map_memory_usage(state));
+                _aggregator->try_convert_to_two_level_map();
             }
-            (this->*_compute_agg_states)(chunk->num_rows());
+            _aggregator->compute_agg_states(chunk->num_rows());
 
-            _num_input_rows += chunk->num_rows();
+            _aggregator->update_num_input_rows(chunk->num_rows());
         }
-    }
 
-    if (!_group_by_expr_ctxs.empty()) {
-        COUNTER_SET(_hash_table_size, (int64_t)_hash_map_variant.size());
-        // If hash map is empty, we don't need to return value
-        if (_hash_map_variant.size() == 0) {
-            _is_finished = true;
+        if (_need_spill(state)) {
+            RETURN_IF_ERROR(_spill_hash_map(state, 0));
         }
+    }
+    state->spill_coordinator()->finish(_mem_tracker.get());
 
-        if (false) {
+    if (_spiller != nullptr) {
+        // The remaining groups are spilled too, so that every group is in only one partition.
+        RETURN_IF_ERROR(_spill_hash_map(state, 0));
+        RETURN_IF_ERROR(_finish_spilling(false));
+        RETURN_IF_ERROR(_open_next_spilled_partition(state));
+    } else if (!_aggregator->is_none_group_by_exprs()) {
+        _init_hash_map_output();
+        if (_can_output_in_parallel()) {
+            _parallel_output = true;
+            _fill_parallel_output_chunks(state);
         }
-#define HASH_MAP_METHOD(NAME) \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME) _it_hash = _hash_map_variant.NAME->hash_map.begin();
-        APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
-    } else if (_group_by_expr_ctxs.empty()) {
+    } else {
         // for aggregate no group by, if _num_input_rows is 0,
         // In update phase, we directly return empty chunk.
         // In merge phase, we will handle it.
-        if (_num_input_rows == 0 && !_needs_finalize) {
-            _is_finished = true;
+        if (_aggregator->num_input_rows() == 0 && !_aggregator->needs_finalize()) {
+            _aggregator->set_finished();
         }
     }
-    COUNTER_SET(_input_row_count, _num_input_rows);
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
     return Status::OK();
 }
 
@@ -91,27 +101,28 @@ Status AggregateBlockingNode::get_next(RuntimeState* state, ChunkPtr* chunk, boo
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::GETNEXT));
     RETURN_IF_CANCELLED(state);
+    if (_sorted_by_group_keys) {
+        return _get_next_sorted(state, chunk, eos);
+    }
     *eos = false;
 
-    if (_is_finished) {
-        COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    bool reached_limit = _aggregator->limit() != -1 && _aggregator->num_rows_returned() >= _aggregator->limit();
+    if (_aggregator->is_finished() && !_spilled_partitions.empty() && !reached_limit) {
+        RETURN_IF_ERROR(_open_next_spilled_partition(state));
+    }
+    if (_aggregator->is_finished()) {
+        COUNTER_SET(_aggregator->rows_returned_counter(), _aggregator->num_rows_returned());
         *eos = true;
         return Status::OK();
     }
     int32_t chunk_size = config::vector_chunk_size;
 
-    if (_group_by_expr_ctxs.empty()) {
-        SCOPED_TIMER(_get_results_timer);
-        _convert_to_chunk_no_groupby(chunk);
+    if (_aggregator->is_none_group_by_exprs()) {
+        _aggregator->convert_to_chunk_no_groupby(chunk);
+    } else if (_parallel_output) {
+        _next_parallel_output_chunk(state, chunk);
     } else {
-        if (false) {
-        }
-#define HASH_MAP_METHOD(NAME)                                                                                   \
-    else if (_hash_map_variant.type == HashMapVariant::Type::NAME)                                              \
-            _convert_hash_map_to_chunk<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, \
-                                                                                       chunk_size, chunk);
-        APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
-#undef HASH_MAP_METHOD
+        _aggregator->convert_hash_map_to_chunk(chunk_size, chunk);
     }
 
     eval_join_runtime_filters(chunk->get());
@@ -119,12 +130,246 @@ Status AggregateBlockingNode::get_next(RuntimeState* state, ChunkPtr* chunk, boo
     // For having
     size_t old_size = (*chunk)->num_rows();
     ExecNode::eval_conjuncts(_conjunct_ctxs, (*chunk).get());
-    _num_rows_returned -= (old_size - (*chunk)->num_rows());
+    _aggregator->update_num_rows_returned(-(old_size - (*chunk)->num_rows()));
 
-    _process_limit(chunk);
+    _aggregator->process_limit(chunk);
 
     DCHECK_CHUNK(*chunk);
     return Status::OK();
 }
 
-} // namespace starrocks::vectorized
\ No newline at end of file
+Status AggregateBlockingNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    state->spill_coordinator()->finish(_mem_tracker.get());
+    // remove the spilled files.
+    _spiller.reset();
+    _spilled_partitions.clear();
+    return AggregateBaseNode::close(state);
+}
+
+void AggregateBlockingNode::_init_hash_map_output() {
+    COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_map_variant().size());
+    // If hash map is empty, we don't need to return value
+    if (_aggregator->hash_map_variant().size() == 0) {
+        _aggregator->set_finished();
+    }
+    _aggregator->init_hash_map_iterator();
+}
+
+bool AggregateBlockingNode::_can_output_in_parallel() const {
+    // With limit, the most of the converted groups would be dropped.
+    return config::agg_parallel_output_max_tasks > 1 && _aggregator->limit() == -1 &&
+           _aggregator->num_hash_map_submaps() > 0 &&
+           _aggregator->hash_map_variant().size() >= config::agg_parallel_output_min_groups;
+}
+
+namespace {
+// The submaps converted by a round of _convert_submaps_in_parallel. A task offered to the thread pool
+// may be run by the node thread if it isn't started yet, so that the node never waits for a busy pool,
+// and the state outlives the round for the tasks run later by the pool.
+struct ParallelOutputRound {
+    ParallelOutputRound(size_t first_submap, size_t num_tasks)
+            : first_submap(first_submap), chunks(num_tasks), claimed(num_tasks), latch(num_tasks) {}
+
+    void run(Aggregator* aggregator, size_t task) {
+        if (claimed[task].exchange(true)) {
+            return;
+        }
+        aggregator->convert_hash_map_submap_to_chunks(first_submap + task, &chunks[task]);
+        latch.count_down();
+    }
+
+    const size_t first_submap;
+    std::vector<std::vector<ChunkPtr>> chunks;
+    std::vector<std::atomic<bool>> claimed;
+    CountDownLatch latch;
+};
+} // namespace
+
+void AggregateBlockingNode::_convert_submaps_in_parallel(RuntimeState* state) {
+    SCOPED_TIMER(_parallel_output_timer);
+    const size_t num_submaps = _aggregator->num_hash_map_submaps();
+    const size_t num_tasks = std::min<size_t>(config::agg_parallel_output_max_tasks, num_submaps - _next_submap);
+    auto round = std::make_shared<ParallelOutputRound>(_next_submap, num_tasks);
+    Aggregator* aggregator = _aggregator.get();
+    MemTracker* mem_tracker = CurrentThread::mem_tracker();
+    for (size_t task = 1; task < num_tasks; task++) {
+        PriorityThreadPool::Task pool_task;
+        pool_task.work_function = [round, aggregator, mem_tracker, task]() {
+            MemTracker* prev_tracker = CurrentThread::set_mem_tracker(mem_tracker);
+            round->run(aggregator, task);
+            CurrentThread::set_mem_tracker(prev_tracker);
+        };
+        state->exec_env()->thread_pool()->try_offer(pool_task);
+    }
+    for (size_t task = 0; task < num_tasks; task++) {
+        round->run(aggregator, task);
+    }
+    round->latch.wait();
+
+    _next_submap += num_tasks;
+    for (auto& chunks : round->chunks) {
+        for (auto& chunk : chunks) {
+            _parallel_output_chunks.emplace_back(std::move(chunk));
+        }
+    }
+}
+
+void AggregateBlockingNode::_next_parallel_output_chunk(RuntimeState* state, ChunkPtr* chunk) {
+    if (_parallel_output_chunks.empty()) {
+        *chunk = std::make_shared<Chunk>();
+    } else {
+        *chunk = std::move(_parallel_output_chunks.front());
+        _parallel_output_chunks.pop_front();
+        _aggregator->update_num_rows_returned((*chunk)->num_rows());
+    }
+    // Convert the next round here, so that the aggregator is finished along with the last chunk.
+    _fill_parallel_output_chunks(state);
+}
+
+void AggregateBlockingNode::_fill_parallel_output_chunks(RuntimeState* state) {
+    const size_t num_submaps = _aggregator->num_hash_map_submaps();
+    while (_parallel_output_chunks.empty() && _next_submap < num_submaps) {
+        _convert_submaps_in_parallel(state);
+    }
+    if (_parallel_output_chunks.empty()) {
+        _aggregator->set_finished();
+    }
+}
+
+bool AggregateBlockingNode::_need_spill(RuntimeState* state) const {
+    if (!state->enable_spill() || _aggregator->is_none_group_by_exprs()) {
+        return false;
+    }
+    int64_t limit = _mem_tracker->lowest_limit();
+    if (limit <= 0) {
+        return false;
+    }
+    return _mem_tracker->spare_capacity() < limit / 100 * (100 - config::agg_spill_mem_limit_percent) &&
+           state->spill_coordinator()->should_spill(_mem_tracker.get());
+}
+
+Status AggregateBlockingNode::_spill_hash_map(RuntimeState* state, int level) {
+    SCOPED_TIMER(_spill_timer);
+    if (_spiller == nullptr) {
+        if (_spill_row_desc == nullptr) {
+            _spill_row_desc = std::make_unique<RowDescriptor>(_aggregator->intermediate_tuple_desc(), false);
+        }
+        _spiller = std::make_unique<AggregateSpiller>(state, *_spill_row_desc,
+                                                      _aggregator->group_by_expr_ctxs().size(), level);
+        RETURN_IF_ERROR(_spiller->init());
+    }
+
+    _aggregator->init_hash_map_iterator();
+    while (!_aggregator->is_ht_eos()) {
+        RETURN_IF_CANCELLED(state);
+        ChunkPtr chunk;
+        _aggregator->convert_hash_map_to_intermediate_chunk(config::vector_chunk_size, &chunk);
+        RETURN_IF_ERROR(_spiller->spill_chunk(chunk));
+    }
+    _aggregator->reset_hash_map();
+    return Status::OK();
+}
+
+Status AggregateBlockingNode::_finish_spilling(bool to_front) {
+    std::vector<SpilledAggPartition> partitions;
+    RETURN_IF_ERROR(_spiller->finish(&partitions));
+    _spiller.reset();
+    COUNTER_UPDATE(_spilled_partitions_counter, static_cast<int64_t>(partitions.size()));
+    if (to_front) {
+        // The partitions of a partition too large are merged before the others.
+        for (auto it = partitions.rbegin(); it != partitions.rend(); ++it) {
+            _spilled_partitions.emplace_front(std::move(*it));
+        }
+    } else {
+        for (auto& partition : partitions) {
+            _spilled_partitions.emplace_back(std::move(partition));
+        }
+    }
+    return Status::OK();
+}
+
+Status AggregateBlockingNode::_open_next_spilled_partition(RuntimeState* state) {
+    while (!_spilled_partitions.empty()) {
+        SpilledAggPartition partition = std::move(_spilled_partitions.front());
+        _spilled_partitions.pop_front();
+        _aggregator->reset_hash_map();
+        if (partition.file->num_rows() == 0) {
+            continue;
+        }
+
+        while (true) {
+            RETURN_IF_CANCELLED(state);
+            ChunkPtr chunk = nullptr;
+            bool eos = false;
+            RETURN_IF_ERROR(partition.file->read(&chunk, &eos));
+            if (eos) {
+                break;
+            }
+            if (_spiller != nullptr) {
+                SCOPED_TIMER(_spill_timer);
+                RETURN_IF_ERROR(_spiller->spill_chunk(chunk));
+                continue;
+            }
+            {
+                SCOPED_TIMER(_aggregator->agg_compute_timer());
+                _aggregator->merge_intermediate_chunk(chunk.get());
+                RETURN_IF_ERROR(_aggregator->update_hash_map_memory_usage(state));
+                _aggregator->try_convert_to_two_level_map();
+            }
+            if (_need_spill(state) && AggregateSpiller::can_partition_next_level(partition.level)) {
+                RETURN_IF_ERROR(_spill_hash_map(state, partition.level + 1));
+            }
+        }
+
+        if (_spiller != nullptr) {
+            RETURN_IF_ERROR(_spill_hash_map(state, partition.level + 1));
+            RETURN_IF_ERROR(_finish_spilling(true));
+            continue;
+        }
+        _init_hash_map_output();
+        return Status::OK();
+    }
+    _aggregator->set_finished();
+    return Status::OK();
+}
+
+pipeline::OpFactories AggregateBlockingNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    OpFactories operators_with_sink = _children[0]->decompose_to_pipeline(context);
+    // Rows of the same group must be consumed by the same Aggregator, so the input is
+    // shuffled by the group by exprs when there are multiple aggregators, and gathered
+    // into one aggregator when there is no group by at all. The shuffled input isn't sorted
+    // any more, so the hash table is built even with sorted_by_group_keys.
+    if (_group_by_expr_ctxs.empty()) {
+        operators_with_sink = context->maybe_interpolate_local_passthrough_exchange(operators_with_sink);
+    } else {
+        operators_with_sink =
+                context->maybe_interpolate_local_shuffle_exchange(operators_with_sink, _group_by_expr_ctxs);
+    }
+    auto degree_of_parallelism = context->source_operator(operators_with_sink)->degree_of_parallelism();
+
+    // shared by sink operator and source operator
+    AggregatorFactoryPtr aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+    auto sink_operator = std::make_shared<AggregateBlockingSinkOperatorFactory>(context->next_operator_id(), id(),
+                                                                                _aggr_phase, aggregator_factory);
+    operators_with_sink.push_back(std::move(sink_operator));
+    context->add_pipeline(operators_with_sink);
+
+    OpFactories operators_with_source;
+    auto source_operator = std::make_shared<AggregateBlockingSourceOperatorFactory>(context->next_operator_id(), id(),
+                                                                                    aggregator_factory);
+    // Aggregator must be used by a pair of sink and source operators,
+    // so operators_with_source's degree of parallelism must be equal with operators_with_sink's
+    source_operator->set_degree_of_parallelism(degree_of_parallelism);
+    operators_with_source.push_back(std::move(source_operator));
+    if (limit() != -1) {
+        operators_with_source.emplace_back(
+                std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return operators_with_source;
+}
+
+} // namespace starrocks::vectorized
@@ -2,7 +2,10 @@
 
 #pragma once
 
+#include <deque>
+
 #include "exec/vectorized/aggregate/aggregate_base_node.h"
+#include "exec/vectorized/aggregate/aggregate_spiller.h"
 
 // Aggregate means this node handle query with aggregate functions.
 // Blocking means this node will consume all input and build hash map in open phase.
@@ -13,7 +16,45 @@ public:
             : AggregateBaseNode(pool, tnode, descs) {
         _aggr_phase = AggrPhase2;
     };
+    Status prepare(RuntimeState* state) override;
     Status open(RuntimeState* state) override;
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
+private:
+    // With the query option enable_spilling, the groups are spilled as the intermediate chunks into
+    // the partitions of AggregateSpiller once the memory is short, and then the partitions are merged
+    // and output one by one. Only the aggregation with group by spills.
+    bool _need_spill(RuntimeState* state) const;
+    // Move the groups in the hash map to the partitions of the AggregateSpiller of |level|.
+    Status _spill_hash_map(RuntimeState* state, int level);
+    Status _finish_spilling(bool to_front);
+    // Merge the groups of the next spilled partition into the hash map, the aggregator is finished
+    // if all the partitions are output.
+    Status _open_next_spilled_partition(RuntimeState* state);
+    void _init_hash_map_output();
+    // The submaps of a large two-level hash map are converted to chunks in parallel, by rounds of up to
+    // config::agg_parallel_output_max_tasks submaps, and the chunks are output from _parallel_output_chunks.
+    bool _can_output_in_parallel() const;
+    void _convert_submaps_in_parallel(RuntimeState* state);
+    void _fill_parallel_output_chunks(RuntimeState* state);
+    void _next_parallel_output_chunk(RuntimeState* state, ChunkPtr* chunk);
+
+    // The intermediate tuple of the spilled chunks.
+    std::unique_ptr<RowDescriptor> _spill_row_desc;
+    // Not null while the groups are being spilled.
+    std::unique_ptr<AggregateSpiller> _spiller;
+    std::deque<SpilledAggPartition> _spilled_partitions;
+
+    bool _parallel_output = false;
+    size_t _next_submap = 0;
+    std::deque<ChunkPtr> _parallel_output_chunks;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spilled_partitions_counter = nullptr;
+    RuntimeProfile::Counter* _parallel_output_timer = nullptr;
 };
 } // namespace starrocks::vectorized
@@ -0,0 +1,111 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/aggregate/aggregate_spiller.h"
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "runtime/tmp_file_mgr.h"
+#include "util/hash_util.hpp"
+
+namespace starrocks::vectorized {
+
+AggregateSpiller::AggregateSpiller(RuntimeState* state, const RowDescriptor& row_desc, size_t num_group_by_columns,
+                                   int level)
+        : _state(state),
+          _row_desc(row_desc),
+          _num_group_by_columns(num_group_by_columns),
+          _level(level),
+          _num_partitions(1ul << config::agg_spill_partition_bits) {}
+
+bool AggregateSpiller::can_partition_next_level(int level) {
+    return level + 1 < config::agg_spill_max_levels && (level + 2) * config::agg_spill_partition_bits <= 32;
+}
+
+Status AggregateSpiller::init() {
+    TmpFileMgr* tmp_file_mgr = _state->exec_env()->tmp_file_mgr();
+    std::vector<TmpFileMgr::DeviceId> devices = tmp_file_mgr->active_tmp_devices();
+    if (devices.empty()) {
+        return Status::InternalError("no temporary directory to spill the aggregation");
+    }
+
+    _partitions.resize(_num_partitions);
+    for (size_t i = 0; i < _num_partitions; i++) {
+        // spread the partitions over the devices.
+        TmpFileMgr::File* file = nullptr;
+        RETURN_IF_ERROR(tmp_file_mgr->get_file(devices[i % devices.size()], _state->query_id(), &file));
+        _partitions[i].file = std::make_unique<SpilledChunkFile>(file, _row_desc);
+        _partitions[i].level = _level;
+    }
+    _partial_chunks.resize(_num_partitions);
+    return Status::OK();
+}
+
+Status AggregateSpiller::spill_chunk(const ChunkPtr& chunk) {
+    uint16_t num_rows = chunk->num_rows();
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+
+    _hash_values.assign(num_rows, HashUtil::FNV_SEED);
+    for (size_t i = 0; i < _num_group_by_columns; i++) {
+        chunk->get_column_by_index(i)->fvn_hash(_hash_values.data(), 0, num_rows);
+    }
+
+    // compute the row indexes of each partition, like PartitionExchanger.
+    uint32_t shift = _level * config::agg_spill_partition_bits;
+    uint32_t mask = _num_partitions - 1;
+    _partition_row_start_points.assign(_num_partitions + 1, 0);
+    for (uint16_t i = 0; i < num_rows; i++) {
+        _hash_values[i] = (_hash_values[i] >> shift) & mask;
+        _partition_row_start_points[_hash_values[i]]++;
+    }
+    for (size_t i = 1; i <= _num_partitions; i++) {
+        _partition_row_start_points[i] += _partition_row_start_points[i - 1];
+    }
+    _row_indexes.resize(num_rows);
+    for (int i = num_rows - 1; i >= 0; i--) {
+        _row_indexes[--_partition_row_start_points[_hash_values[i]]] = i;
+    }
+
+    for (size_t i = 0; i < _num_partitions; i++) {
+        uint32_t from = _partition_row_start_points[i];
+        uint32_t size = _partition_row_start_points[i + 1] - from;
+        if (size == 0) {
+            continue;
+        }
+        auto& partial_chunk = _partial_chunks[i];
+        if (partial_chunk != nullptr && partial_chunk->num_rows() + size > config::vector_chunk_size) {
+            RETURN_IF_ERROR(_flush_partial_chunk(i));
+        }
+        if (partial_chunk == nullptr) {
+            partial_chunk = JoinSpiller::clone_empty(*chunk, config::vector_chunk_size);
+        }
+        partial_chunk->append_selective(*chunk, _row_indexes.data(), from, size);
+        if (partial_chunk->num_rows() >= config::vector_chunk_size) {
+            RETURN_IF_ERROR(_flush_partial_chunk(i));
+        }
+    }
+    return Status::OK();
+}
+
+Status AggregateSpiller::_flush_partial_chunk(size_t partition) {
+    auto& partial_chunk = _partial_chunks[partition];
+    if (partial_chunk == nullptr) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_partitions[partition].file->write(*partial_chunk));
+    partial_chunk.reset();
+    return Status::OK();
+}
+
+Status AggregateSpiller::finish(std::vector<SpilledAggPartition>* partitions) {
+    for (size_t i = 0; i < _num_partitions; i++) {
+        RETURN_IF_ERROR(_flush_partial_chunk(i));
+    }
+    *partitions = std::move(_partitions);
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,68 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "exec/vectorized/join_spiller.h"
+
+namespace starrocks {
+class RowDescriptor;
+class RuntimeState;
+
+namespace vectorized {
+
+// A partition of the groups spilled by AggregateSpiller, which could be merged separately.
+struct SpilledAggPartition {
+    std::unique_ptr<SpilledChunkFile> file;
+    // The partitions of level n + 1 are partitioned from a partition of level n.
+    int level = 0;
+};
+
+// AggregateSpiller partitions the intermediate chunks of an aggregation, i.e. the group by columns
+// followed by the serialized aggregate states, by the hash of their group by columns, and spills each
+// partition into its own temporary file. Like JoinSpiller, the partition of a group at level n is the
+// n-th group of config::agg_spill_partition_bits bits of its hash, so that a partition too large to
+// be merged in memory could be partitioned again by the next level.
+class AggregateSpiller {
+public:
+    AggregateSpiller(RuntimeState* state, const RowDescriptor& row_desc, size_t num_group_by_columns, int level);
+
+    // Create the temporary files of the partitions.
+    Status init();
+
+    // The first num_group_by_columns columns of |chunk| are the group by columns.
+    Status spill_chunk(const ChunkPtr& chunk);
+
+    // Write the buffered rows of all the partitions to the files, and move the partitions to
+    // |partitions|. The spiller can't be used any more.
+    Status finish(std::vector<SpilledAggPartition>* partitions);
+
+    // Whether the partitions of |level| could be partitioned again.
+    static bool can_partition_next_level(int level);
+
+private:
+    Status _flush_partial_chunk(size_t partition);
+
+    RuntimeState* _state;
+    const RowDescriptor& _row_desc;
+    const size_t _num_group_by_columns;
+    const int _level;
+    const size_t _num_partitions;
+
+    std::vector<SpilledAggPartition> _partitions;
+    // The rows of every partition are accumulated here until there are config::vector_chunk_size
+    // rows, the spilled chunks never exceed config::vector_chunk_size rows, since they are merged
+    // into the hash map chunk by chunk.
+    std::vector<ChunkUniquePtr> _partial_chunks;
+
+    std::vector<uint32_t> _hash_values;
+    std::vector<uint32_t> _partition_row_start_points;
+    std::vector<uint32_t> _row_indexes;
+};
+
+} // namespace vectorized
+} // namespace starrocks
@@ -2,18 +2,25 @@
 
 #include "exec/vectorized/aggregate/distinct_blocking_node.h"
 
+#include "exec/pipeline/aggregate/aggregate_distinct_blocking_sink_operator.h"
+#include "exec/pipeline/aggregate/aggregate_distinct_blocking_source_operator.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+
 namespace starrocks::vectorized {
 
 Status DistinctBlockingNode::open(RuntimeState* state) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::OPEN));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(ExecNode::open(state));
-    RETURN_IF_ERROR(Expr::open(_group_by_expr_ctxs, state));
+    RETURN_IF_ERROR(_aggregator->open(state));
     RETURN_IF_ERROR(_children[0]->open(state));
 
     ChunkPtr chunk;
     bool limit_with_no_agg = limit() != -1;
-    VLOG_ROW << "_group_by_expr_ctxs size " << _group_by_expr_ctxs.size() << " _needs_finalize " << _needs_finalize;
+    VLOG_ROW << "group_by_expr_ctxs size " << _aggregator->group_by_expr_ctxs().size() << " _needs_finalize "
+             << _aggregator->needs_finalize();
 
     while (true) {
         bool eos = false;
@@ -28,46 +35,34 @@ Status DistinctBlockingNode::open(RuntimeState* state) {
         }
         DCHECK_LE(chunk->num_rows(), config::vector_chunk_size);
 
-        _evaluate_exprs(chunk.get());
+        _aggregator->evaluate_exprs(chunk.get());
 
         {
-            SCOPED_TIMER(_agg_compute_timer);
-            if (false) {
-            }
-#define HASH_SET_METHOD(NAME)                                                                        \
-    else if (_hash_set_variant.type == HashSetVariant::Type::NAME)                                   \
-            _build_hash_set<decltype(_hash_set_variant.NAME)::element_type>(*_hash_set_variant.NAME, \
-                                                                            chunk->num_rows());
-            APPLY_FOR_VARIANT_ALL(HASH_SET_METHOD)
-#undef HASH_SET_METHOD
-
-            _num_input_rows += chunk->num_rows();
+            SCOPED_TIMER(_aggregator->agg_compute_timer());
+            _aggregator->build_hash_set(chunk->num_rows());
+
+            _aggregator->update_num_input_rows(chunk->num_rows());
             if (limit_with_no_agg) {
-                auto size = _hash_set_variant.size();
+                auto size = _aggregator->hash_set_variant().size();
                 if (size >= limit()) {
                     break;
                 }
             }
 
-            RETURN_IF_ERROR(_check_hash_set_memory_usage(state));
+            RETURN_IF_ERROR(_aggregator->check_hash_set_memory_usage(state));
         }
     }
 
-    COUNTER_SET(_hash_table_size, (int64_t)_hash_set_variant.size());
+    COUNTER_SET(_aggregator->hash_table_size(), (int64_t)_aggregator->hash_set_variant().size());
 
     // If hash set is empty, we don't need to return value
-    if (_hash_set_variant.size() == 0) {
-        _is_finished = true;
+    if (_aggregator->hash_set_variant().size() == 0) {
+        _aggregator->set_finished();
     }
 
-    if (false) {
-    }
-#define HASH_SET_METHOD(NAME) \
-    else if (_hash_set_variant.type == HashSetVariant::Type::NAME) _it_hash = _hash_set_variant.NAME->hash_set.begin();
-    APPLY_FOR_VARIANT_ALL(HASH_SET_METHOD)
-#undef HASH_SET_METHOD
+    _aggregator->init_hash_set_iterator();
 
-    COUNTER_SET(_input_row_count, _num_input_rows);
+    COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
     return Status::OK();
 }
 
@@ -77,33 +72,55 @@ Status DistinctBlockingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool
     RETURN_IF_CANCELLED(state);
     *eos = false;
 
-    if (_is_finished) {
-        COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    if (_aggregator->is_finished()) {
+        COUNTER_SET(_aggregator->rows_returned_counter(), _aggregator->num_rows_returned());
         *eos = true;
         return Status::OK();
     }
     int32_t chunk_size = config::vector_chunk_size;
 
-    if (false) {
-    }
-#define HASH_SET_METHOD(NAME)                                                                                   \
-    else if (_hash_set_variant.type == HashSetVariant::Type::NAME)                                              \
-            _convert_hash_set_to_chunk<decltype(_hash_set_variant.NAME)::element_type>(*_hash_set_variant.NAME, \
-                                                                                       chunk_size, chunk);
-    APPLY_FOR_VARIANT_ALL(HASH_SET_METHOD)
-#undef HASH_SET_METHOD
+    _aggregator->convert_hash_set_to_chunk(chunk_size, chunk);
 
     eval_join_runtime_filters(chunk->get());
 
     // For having
     size_t old_size = (*chunk)->num_rows();
     ExecNode::eval_conjuncts(_conjunct_ctxs, (*chunk).get());
-    _num_rows_returned -= (old_size - (*chunk)->num_rows());
+    _aggregator->update_num_rows_returned(-(old_size - (*chunk)->num_rows()));
 
-    _process_limit(chunk);
+    _aggregator->process_limit(chunk);
 
     DCHECK_CHUNK(*chunk);
     return Status::OK();
 }
 
-} // namespace starrocks::vectorized
\ No newline at end of file
+pipeline::OpFactories DistinctBlockingNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    OpFactories operators_with_sink = _children[0]->decompose_to_pipeline(context);
+    // Rows with the same keys must be consumed by the same Aggregator,
+    // so the input is shuffled by the group by exprs when there are multiple aggregators.
+    operators_with_sink = context->maybe_interpolate_local_shuffle_exchange(operators_with_sink, _group_by_expr_ctxs);
+    auto degree_of_parallelism = context->source_operator(operators_with_sink)->degree_of_parallelism();
+
+    // shared by sink operator and source operator
+    AggregatorFactoryPtr aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
+    auto sink_operator = std::make_shared<AggregateDistinctBlockingSinkOperatorFactory>(
+            context->next_operator_id(), id(), _aggr_phase, aggregator_factory);
+    operators_with_sink.push_back(std::move(sink_operator));
+    context->add_pipeline(operators_with_sink);
+
+    OpFactories operators_with_source;
+    auto source_operator = std::make_shared<AggregateDistinctBlockingSourceOperatorFactory>(
+            context->next_operator_id(), id(), aggregator_factory);
+    // Aggregator must be used by a pair of sink and source operators,
+    // so operators_with_source's degree of parallelism must be equal with operators_with_sink's
+    source_operator->set_degree_of_parallelism(degree_of_parallelism);
+    operators_with_source.push_back(std::move(source_operator));
+    if (limit() != -1) {
+        operators_with_source.emplace_back(
+                std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return operators_with_source;
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,638 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <any>
+#include <atomic>
+#include <mutex>
+#include <queue>
+
+#include "column/column_helper.h"
+#include "column/type_traits.h"
+#include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "exec/vectorized/aggregate/agg_state_arena.h"
+#include "exprs/agg/aggregate_factory.h"
+#include "exprs/expr.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_pool.h"
+#include "runtime/runtime_state.h"
+#include "storage/hll.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+class MemTracker;
+class ObjectPool;
+namespace vectorized {
+
+struct AggFunctionTypes {
+    TypeDescriptor result_type;
+    TypeDescriptor serde_type; // for serialize
+    std::vector<FunctionContext::TypeDesc> arg_typedescs;
+    bool has_nullable_child;
+    bool is_nullable; // agg function result whether is nullable
+};
+
+struct GroupByColumnTypes {
+    TypeDescriptor result_type;
+    bool is_nullable;
+};
+
+enum AggrPhase { AggrPhase1, AggrPhase2 };
+
+struct StreamingHtMinReductionEntry {
+    int min_ht_mem;
+    double streaming_ht_min_reduction;
+};
+
+static const StreamingHtMinReductionEntry STREAMING_HT_MIN_REDUCTION[] = {
+        {0, 0.0},
+        {256 * 1024, 1.1},
+        {2 * 1024 * 1024, 2.0},
+};
+
+static const int STREAMING_HT_MIN_REDUCTION_SIZE =
+        sizeof(STREAMING_HT_MIN_REDUCTION) / sizeof(STREAMING_HT_MIN_REDUCTION[0]);
+
+class Aggregator;
+using AggregatorPtr = std::shared_ptr<Aggregator>;
+
+// Aggregator holds the hash table, the aggregate states and the expressions of one aggregation.
+// It is shared by the vectorized aggregate nodes and by the pipeline aggregate operators:
+// for the pipeline engine, the sink operator builds the hash table and the source operator
+// of the next pipeline outputs the result, and both of them reference the same Aggregator.
+class Aggregator {
+public:
+    Aggregator(const TPlanNode& tnode);
+
+    ~Aggregator() = default;
+
+    Status prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile* runtime_profile, MemTracker* mem_tracker);
+
+    Status open(RuntimeState* state);
+
+    Status close(RuntimeState* state);
+
+    // An Aggregator shared by a pair of sink and source operators is referenced by both of them,
+    // the last one which calls unref closes the Aggregator.
+    void ref() { _num_refs.fetch_add(1, std::memory_order_relaxed); }
+    Status unref(RuntimeState* state) {
+        if (_num_refs.fetch_sub(1) == 1) {
+            return close(state);
+        }
+        return Status::OK();
+    }
+
+    const MemPool* mem_pool() const { return _mem_pool.get(); }
+    bool is_none_group_by_exprs() const { return _group_by_expr_ctxs.empty(); }
+    const std::vector<ExprContext*>& conjunct_ctxs() const { return _conjunct_ctxs; }
+    const std::vector<ExprContext*>& group_by_expr_ctxs() const { return _group_by_expr_ctxs; }
+    const std::vector<starrocks_udf::FunctionContext*>& agg_fn_ctxs() const { return _agg_fn_ctxs; }
+    const std::vector<std::vector<ExprContext*>>& agg_expr_ctxs() const { return _agg_expr_ctxs; }
+    int64_t limit() const { return _limit; }
+    bool needs_finalize() const { return _needs_finalize; }
+    bool is_only_group_by_columns() const { return _is_only_group_by_columns; }
+    bool sorted_by_group_keys() const { return _sorted_by_group_keys; }
+    bool is_ht_eos() const { return _is_ht_eos; }
+    void set_ht_eos() { _is_ht_eos = true; }
+    bool is_finished() const { return _is_finished; }
+    void set_finished() { _is_finished = true; }
+    int64_t num_input_rows() const { return _num_input_rows; }
+    void update_num_input_rows(int64_t increment) { _num_input_rows += increment; }
+    int64_t num_rows_returned() const { return _num_rows_returned; }
+    void update_num_rows_returned(int64_t increment) { _num_rows_returned += increment; }
+    int64_t num_pass_through_rows() const { return _num_pass_through_rows; }
+    void set_aggr_phase(AggrPhase aggr_phase) { _aggr_phase = aggr_phase; }
+    AggrPhase get_aggr_phase() const { return _aggr_phase; }
+    TStreamingPreaggregationMode::type streaming_preaggregation_mode() const {
+        return _streaming_preaggregation_mode;
+    }
+    HashMapVariant& hash_map_variant() { return _hash_map_variant; }
+    HashSetVariant& hash_set_variant() { return _hash_set_variant; }
+    std::any& it_hash() { return _it_hash; }
+    const std::vector<uint8_t>& streaming_selection() const { return _streaming_selection; }
+
+    RuntimeProfile::Counter* rows_returned_counter() { return _rows_returned_counter; }
+    RuntimeProfile::Counter* get_results_timer() { return _get_results_timer; }
+    RuntimeProfile::Counter* agg_compute_timer() { return _agg_compute_timer; }
+    RuntimeProfile::Counter* streaming_timer() { return _streaming_timer; }
+    RuntimeProfile::Counter* input_row_count() { return _input_row_count; }
+    RuntimeProfile::Counter* hash_table_size() { return _hash_table_size; }
+    RuntimeProfile::Counter* pass_through_row_count() { return _pass_through_row_count; }
+
+    // The pipeline sink operator calls set_sink_complete when all the input has been consumed,
+    // after which the paired source operator can output the content of the hash table.
+    bool is_sink_complete() const { return _is_sink_complete.load(std::memory_order_acquire); }
+    void set_sink_complete() { _is_sink_complete.store(true, std::memory_order_release); }
+
+    // Chunks produced by streaming pre-aggregation are handed over from the sink operator
+    // to the source operator through this buffer.
+    bool is_chunk_buffer_empty() const;
+    bool is_chunk_buffer_full() const;
+    vectorized::ChunkPtr poll_chunk_buffer();
+    void offer_chunk_to_buffer(const vectorized::ChunkPtr& chunk);
+
+    bool should_expand_preagg_hash_tables(size_t input_chunk_size, int64_t ht_mem, int64_t ht_rows) const;
+
+    // For TStreamingPreaggregationMode::ADAPTIVE, whether the evaluated chunk of |chunk_size| rows should be
+    // streamed rather than aggregated. The distinct group by keys of the sampled rows at the beginning of every
+    // window are estimated by a HyperLogLog over their hashes, the sampled rows are always aggregated, and the
+    // rest rows of the window are streamed if the keys are hardly reduced.
+    bool should_stream_adaptively(size_t chunk_size);
+    // For the ADAPTIVE streaming distinct, whether the rest rows of the current window, not streamed, should be
+    // prefiltered by build_hash_set_with_prefilter: the sampled keys are reduced, but at most
+    // streaming_distinct_prefilter_max_reduction times.
+    bool should_prefilter_adaptively() const;
+    // The rows of the keys not seen by a bloom filter yet are output to |chunk| rather than inserted into the hash
+    // set, so that the hash set only holds the repeated keys. The bloom filter is cleared at every window.
+    void build_hash_set_with_prefilter(size_t chunk_size, vectorized::ChunkPtr* chunk);
+
+    // For aggregate without group by
+    void compute_single_agg_state(size_t chunk_size);
+    // For aggregate with group by
+    void compute_batch_agg_states(size_t chunk_size);
+    void compute_batch_agg_states(size_t chunk_size, const std::vector<uint8_t>& selection);
+    // Dispatch to compute_single_agg_state or compute_batch_agg_states
+    void compute_agg_states(size_t chunk_size) { (this->*_compute_agg_states)(chunk_size); }
+
+    // Convert one row agg states to chunk
+    void convert_to_chunk_no_groupby(vectorized::ChunkPtr* chunk);
+
+    void process_limit(vectorized::ChunkPtr* chunk);
+
+    void evaluate_exprs(vectorized::Chunk* chunk);
+
+    void output_chunk_by_streaming(vectorized::ChunkPtr* chunk);
+
+    // Elements queried in HashTable will be added to HashTable,
+    // elements that cannot be queried are not processed,
+    // and are mainly used in the first stage of two-stage aggregation when aggr reduction is low
+    // selection[i] = 0: found in hash table
+    // selection[1] = 1: not found in hash table
+    void output_chunk_by_streaming(vectorized::ChunkPtr* chunk, const std::vector<uint8_t>& filter);
+
+    Status check_hash_map_memory_usage(RuntimeState* state);
+    // Like check_hash_map_memory_usage, but the memory usage is always updated.
+    Status update_hash_map_memory_usage(RuntimeState* state);
+
+    Status check_hash_set_memory_usage(RuntimeState* state);
+
+    // At first, we use single hash map, if hash map is too big,
+    // we convert the single hash map to two level hash map.
+    // two level hash map is better in large data set.
+    void try_convert_to_two_level_map();
+
+    // Dispatch to the concrete hash map/set of the variant
+    void build_hash_map(size_t chunk_size);
+    void build_hash_map_with_selection(size_t chunk_size);
+    void build_hash_set(size_t chunk_size);
+    void build_hash_set_with_selection(size_t chunk_size);
+    void init_hash_map_iterator();
+    void init_hash_set_iterator();
+    void convert_hash_map_to_chunk(int32_t chunk_size, vectorized::ChunkPtr* chunk);
+    void convert_hash_set_to_chunk(int32_t chunk_size, vectorized::ChunkPtr* chunk);
+
+    // For spilling the hash map: the groups are converted to the intermediate chunks of the serialized
+    // agg states regardless of needs_finalize, and the rows returned aren't counted. The intermediate
+    // chunks are merged into the hash map by merge_intermediate_chunk, and reset_hash_map destroys
+    // all the groups.
+    TupleDescriptor* intermediate_tuple_desc() const { return _intermediate_tuple_desc; }
+    void convert_hash_map_to_intermediate_chunk(int32_t chunk_size, vectorized::ChunkPtr* chunk);
+    void merge_intermediate_chunk(vectorized::Chunk* chunk);
+
+    // The number of the submaps of the two-level hash map, or 0 if the hash map isn't two-level. All the
+    // groups of a submap are converted to |chunks| by convert_hash_map_submap_to_chunks, which could be called
+    // concurrently for different submaps, and the rows aren't counted in num_rows_returned.
+    size_t num_hash_map_submaps() const;
+    void convert_hash_map_submap_to_chunks(size_t submap_index, std::vector<vectorized::ChunkPtr>* chunks);
+    void reset_hash_map();
+
+    // For the input sorted by the group by exprs, the groups are aggregated one after another without a hash
+    // table. build_sorted_agg_states finds the groups of the evaluated chunk by comparing the adjacent keys, and
+    // the groups before the last one, which may go on in the next chunk, are complete. The complete groups are
+    // output by convert_sorted_groups_to_chunk, and their states are reused by the next groups, so the memory
+    // used is bounded by the groups of a chunk whatever the number of the groups.
+    void build_sorted_agg_states(size_t chunk_size);
+    // Complete the last group once all the input is consumed.
+    void finish_sorted_groups() { _has_open_sorted_group = false; }
+    void convert_sorted_groups_to_chunk(vectorized::ChunkPtr* chunk);
+
+#ifdef NDEBUG
+    static constexpr size_t two_level_memory_threshold = 33554432; // 32M, L3 Cache
+#else
+    static constexpr size_t two_level_memory_threshold = 64;
+#endif
+
+#ifdef NDEBUG
+    static constexpr size_t streaming_hash_table_size_threshold = 10000000;
+#else
+    static constexpr size_t streaming_hash_table_size_threshold = 4;
+#endif
+
+#ifdef NDEBUG
+    static constexpr size_t memory_check_batch_size = 65535;
+#else
+    static constexpr size_t memory_check_batch_size = 1;
+#endif
+
+    // The max number of chunks buffered between streaming sink and source operators
+    static constexpr size_t max_buffered_chunks = 8;
+
+private:
+    // initial const columns for i'th FunctionContext.
+    void _evaluate_const_columns(int i);
+
+    // Choose different agg hash map/set by different group by column's count, type, nullable
+    template <typename HashVariantType>
+    void _init_agg_hash_variant(HashVariantType& hash_variant);
+    // Return the size of the FixedSizeSliceKey of the group by columns, or 0 if any of them isn't of fixed width.
+    size_t _build_fixed_size_key_layout(FixedSizeKeyLayout* layout) const;
+
+    // The states of the new groups are only allocated while building the hash map, and created
+    // by _create_new_agg_states in batch once the whole chunk is inserted.
+    AggDataPtr _allocate_agg_state() {
+        AggDataPtr agg_state = _agg_state_arena->allocate();
+        _new_agg_states.push_back(agg_state);
+        return agg_state;
+    }
+    void _create_new_agg_states();
+    // Whether the group by keys at |row| of the evaluated group by columns equal those at |key_row| of |keys|.
+    bool _group_by_keys_equal(size_t row, const vectorized::Columns& keys, size_t key_row) const;
+
+    template <typename HashMapWithKey>
+    void _build_hash_map(HashMapWithKey& hash_map_with_key, size_t chunk_size) {
+        hash_map_with_key.compute_agg_states(
+                chunk_size, _group_by_columns, _mem_pool.get(), [this]() { return _allocate_agg_state(); },
+                &_tmp_agg_states);
+        _create_new_agg_states();
+    }
+
+    template <typename HashMapWithKey>
+    void _build_hash_map(HashMapWithKey& hash_map_with_key, size_t chunk_size, std::vector<uint8_t>* selection) {
+        hash_map_with_key.compute_agg_states(
+                chunk_size, _group_by_columns, [this]() { return _allocate_agg_state(); }, &_tmp_agg_states,
+                selection);
+        _create_new_agg_states();
+    }
+
+    template <typename HashMapWithKey>
+    void _release_agg_memory(HashMapWithKey& hash_map_with_key) {
+        if (_is_trivial_agg_state) {
+            return;
+        }
+        Buffer<AggDataPtr> agg_states;
+        agg_states.reserve(config::vector_chunk_size);
+        auto it = hash_map_with_key.hash_map.begin();
+        auto end = hash_map_with_key.hash_map.end();
+        while (it != end) {
+            agg_states.clear();
+            for (; it != end && agg_states.size() < config::vector_chunk_size; ++it) {
+                agg_states.push_back(it->second);
+            }
+            for (int i = 0; i < _agg_functions.size(); i++) {
+                _agg_functions[i]->batch_destroy(agg_states.size(), agg_states.data(), _agg_states_offsets[i]);
+            }
+        }
+    }
+
+    template <typename HashSetWithKey>
+    void _build_hash_set(HashSetWithKey& hash_set, size_t chunk_size) {
+        hash_set.build_set(chunk_size, _group_by_columns, _mem_pool.get());
+    }
+
+    template <typename HashSetWithKey>
+    void _build_hash_set(HashSetWithKey& hash_set, size_t chunk_size, std::vector<uint8_t>* selection) {
+        hash_set.build_set(chunk_size, _group_by_columns, selection);
+    }
+
+    // Create new aggregate function result column by type
+    vectorized::Columns _create_agg_result_columns();
+    vectorized::Columns _create_group_by_columns();
+
+    template <typename HashMapWithKey>
+    void _convert_hash_map_to_chunk(HashMapWithKey& hash_map_with_key, int32_t chunk_size,
+                                    vectorized::ChunkPtr* chunk) {
+        SCOPED_TIMER(_get_results_timer);
+        using Iterator = typename HashMapWithKey::Iterator;
+        auto it = std::any_cast<Iterator>(_it_hash);
+        auto end = hash_map_with_key.hash_map.end();
+
+        vectorized::Columns group_by_columns = _create_group_by_columns();
+        vectorized::Columns agg_result_column = _create_agg_result_columns();
+
+        int32_t read_index = 0;
+        {
+            SCOPED_TIMER(_iter_timer);
+            hash_map_with_key.results.resize(chunk_size);
+            while ((it != end) & (read_index < chunk_size)) {
+                hash_map_with_key.results[read_index] = it->first;
+                _tmp_agg_states[read_index] = it->second;
+                ++read_index;
+                ++it;
+            }
+        }
+
+        {
+            SCOPED_TIMER(_group_by_append_timer);
+            hash_map_with_key.insert_keys_to_columns(hash_map_with_key.results, group_by_columns, read_index);
+        }
+
+        {
+            SCOPED_TIMER(_agg_append_timer);
+            _append_agg_results(read_index, _tmp_agg_states, agg_result_column);
+        }
+
+        _is_finished = (it == end);
+        _is_ht_eos = _is_finished;
+
+        // If there is null key, output it last
+        if constexpr (HashMapWithKey::has_single_null_key) {
+            if (_is_finished && hash_map_with_key.null_key_data != nullptr) {
+                // The output chunk size couldn't larger than config::vector_chunk_size
+                if (read_index < config::vector_chunk_size) {
+                    // For multi group by key, we don't need to special handle null key
+                    DCHECK(group_by_columns.size() == 1);
+                    DCHECK(group_by_columns[0]->is_nullable());
+                    group_by_columns[0]->append_default();
+                    (this->*_serialize_or_finalize)(hash_map_with_key.null_key_data, agg_result_column);
+                    ++read_index;
+                } else {
+                    // Output null key in next round
+                    _is_ht_eos = false;
+                    _is_finished = false;
+                }
+            }
+        }
+
+        _it_hash = it;
+
+        _num_rows_returned += read_index;
+        *chunk = _build_hash_map_result_chunk(group_by_columns, agg_result_column);
+    }
+
+    // Unlike _convert_hash_map_to_chunk, only the local state is used, so different submaps could
+    // be converted concurrently.
+    template <typename HashMapWithKey>
+    void _convert_hash_map_submap_to_chunks(HashMapWithKey& hash_map_with_key, size_t submap_index,
+                                            std::vector<vectorized::ChunkPtr>* chunks) {
+        auto& submap = hash_map_with_key.hash_map.get_submap(submap_index);
+        const int32_t chunk_size = config::vector_chunk_size;
+        typename HashMapWithKey::ResultVector keys(chunk_size);
+        vectorized::Buffer<AggDataPtr> agg_states(chunk_size);
+
+        auto it = submap.begin();
+        auto end = submap.end();
+        while (it != end) {
+            int32_t read_index = 0;
+            while ((it != end) & (read_index < chunk_size)) {
+                keys[read_index] = it->first;
+                agg_states[read_index] = it->second;
+                ++read_index;
+                ++it;
+            }
+
+            vectorized::Columns group_by_columns = _create_group_by_columns();
+            vectorized::Columns agg_result_columns = _create_agg_result_columns();
+            hash_map_with_key.insert_keys_to_columns(keys, group_by_columns, read_index);
+            _append_agg_results(read_index, agg_states, agg_result_columns);
+            chunks->emplace_back(_build_hash_map_result_chunk(group_by_columns, agg_result_columns));
+        }
+    }
+
+    // Finalize or serialize the |num_rows| aggregate states to |agg_result_columns|.
+    void _append_agg_results(size_t num_rows, const vectorized::Buffer<AggDataPtr>& agg_states,
+                             const vectorized::Columns& agg_result_columns);
+    // For different agg phase, we should use different TupleDescriptor
+    vectorized::ChunkPtr _build_hash_map_result_chunk(const vectorized::Columns& group_by_columns,
+                                                      const vectorized::Columns& agg_result_columns) const;
+
+    template <typename HashSetWithKey>
+    void _convert_hash_set_to_chunk(HashSetWithKey& hash_set, int32_t chunk_size, vectorized::ChunkPtr* chunk) {
+        SCOPED_TIMER(_get_results_timer);
+        using Iterator = typename HashSetWithKey::Iterator;
+        auto it = std::any_cast<Iterator>(_it_hash);
+        auto end = hash_set.hash_set.end();
+
+        vectorized::Columns group_by_columns = _create_group_by_columns();
+
+        // Computer group by columns and aggregate result column
+        int32_t read_index = 0;
+        hash_set.results.resize(chunk_size);
+        while (it != end && read_index < chunk_size) {
+            hash_set.results[read_index] = *it;
+            ++read_index;
+            ++it;
+        }
+
+        {
+            SCOPED_TIMER(_group_by_append_timer);
+            hash_set.insert_keys_to_columns(hash_set.results, group_by_columns, read_index);
+        }
+
+        _is_finished = (it == end);
+        _is_ht_eos = _is_finished;
+
+        // IF there is null key, output it last
+        if constexpr (HashSetWithKey::has_single_null_key) {
+            if (_is_finished && hash_set.has_null_key) {
+                // The output chunk size couldn't larger than config::vector_chunk_size
+                if (read_index < config::vector_chunk_size) {
+                    // For multi group by key, we don't need to special handle null key
+                    DCHECK(group_by_columns.size() == 1);
+                    DCHECK(group_by_columns[0]->is_nullable());
+                    group_by_columns[0]->append_default();
+                    ++read_index;
+                } else {
+                    // Output null key in next round
+                    _is_ht_eos = false;
+                    _is_finished = false;
+                }
+            }
+        }
+
+        _it_hash = it;
+
+        vectorized::ChunkPtr result_chunk = std::make_shared<vectorized::Chunk>();
+        // For different agg phase, we should use different TupleDescriptor
+        if (_needs_finalize) {
+            for (size_t i = 0; i < group_by_columns.size(); i++) {
+                result_chunk->append_column(group_by_columns[i], _output_tuple_desc->slots()[i]->id());
+            }
+        } else {
+            for (size_t i = 0; i < group_by_columns.size(); i++) {
+                result_chunk->append_column(group_by_columns[i], _intermediate_tuple_desc->slots()[i]->id());
+            }
+        }
+        _num_rows_returned += read_index;
+        *chunk = std::move(result_chunk);
+    }
+
+    // When convert to chunk, we serialize the aggregate state
+    void _serialize_to_chunk(ConstAggDataPtr state, const vectorized::Columns& agg_result_columns);
+
+    // When convert to chunk, we finalize the aggregate state
+    void _finalize_to_chunk(ConstAggDataPtr state, const vectorized::Columns& agg_result_columns);
+
+    void (Aggregator::*_serialize_or_finalize)(ConstAggDataPtr state,
+                                               const vectorized::Columns& agg_result_columns) = nullptr;
+
+    void (Aggregator::*_compute_agg_states)(size_t chunk_size) = nullptr;
+
+private:
+    const TPlanNode _tnode;
+
+    ObjectPool* _pool = nullptr;
+    RuntimeProfile* _runtime_profile = nullptr;
+    MemTracker* _mem_tracker = nullptr;
+    std::unique_ptr<MemPool> _mem_pool;
+
+    std::atomic<int32_t> _num_refs{0};
+    bool _is_closed = false;
+
+    int64_t _limit = -1;
+    int64_t _num_rows_returned = 0;
+
+    // Certain aggregates require a finalize step, which is the final step of the
+    // aggregate after consuming all input rows. The finalize step converts the aggregate
+    // value into its final form. This is true if this node contains aggregate that requires
+    // a finalize step.
+    bool _needs_finalize;
+
+    bool _is_finished = false;
+
+    bool _is_only_group_by_columns = false;
+
+    // The input is sorted by the group by exprs, see build_sorted_agg_states.
+    bool _sorted_by_group_keys;
+
+    // At least one group by column is nullable
+    bool _has_nullable_key = false;
+
+    int64_t _num_input_rows = 0;
+
+    // memory used for hashmap or hashset
+    int64_t _last_ht_memory_usage = 0;
+
+    // memory used for agg function
+    int64_t _last_agg_func_memory_usage = 0;
+
+    int64_t _num_pass_through_rows = 0;
+    bool _is_ht_eos = false;
+
+    std::atomic<bool> _is_sink_complete{false};
+    mutable std::mutex _buffer_mutex;
+    std::queue<vectorized::ChunkPtr> _buffer;
+
+    TStreamingPreaggregationMode::type _streaming_preaggregation_mode;
+    // The state of the current window of the ADAPTIVE mode.
+    std::unique_ptr<HyperLogLog> _adaptive_hll;
+    int64_t _adaptive_window_rows = 0;
+    int64_t _adaptive_sampled_rows = 0;
+    bool _adaptive_streaming = false;
+    double _adaptive_reduction = 0;
+    std::vector<uint32_t> _adaptive_hash_values;
+    std::vector<uint64_t> _prefilter_bloom_filter;
+    // The key is all group by column, the value is all agg function column
+    HashMapVariant _hash_map_variant;
+    HashSetVariant _hash_set_variant;
+    // The Iterator for hash table
+    std::any _it_hash;
+
+    // The offset of the n-th aggregate function in a row of aggregate functions.
+    std::vector<size_t> _agg_states_offsets;
+    // The total size of the row for the aggregate function state.
+    size_t _agg_states_total_size = 0;
+    // The max align size for all aggregate state
+    size_t _max_agg_state_align_size = 1;
+    // Whether the states of all the aggregate functions are trivial, then the states of the new groups
+    // are copied from the first one, and never destroyed.
+    bool _is_trivial_agg_state = false;
+    std::unique_ptr<AggStateArena> _agg_state_arena;
+    // The states allocated by _allocate_agg_state but not created yet.
+    vectorized::Buffer<AggDataPtr> _new_agg_states;
+    // The keys and the states of the sorted groups not output yet, see build_sorted_agg_states. The last group
+    // is not complete if _has_open_sorted_group. The states of the groups output are destroyed and kept in
+    // _free_sorted_agg_states for the next groups.
+    vectorized::Columns _sorted_group_keys;
+    vectorized::Buffer<AggDataPtr> _sorted_agg_states;
+    vectorized::Buffer<AggDataPtr> _free_sorted_agg_states;
+    bool _has_open_sorted_group = false;
+    // The followings are aggregate function information:
+    std::vector<starrocks_udf::FunctionContext*> _agg_fn_ctxs;
+    std::vector<const AggregateFunction*> _agg_functions;
+    // agg state when no group by columns
+    AggDataPtr _single_agg_state = nullptr;
+    // The expr used to evaluate agg input columns
+    // one agg function could have multi input exprs
+    std::vector<std::vector<ExprContext*>> _agg_expr_ctxs;
+    std::vector<std::vector<vectorized::ColumnPtr>> _agg_intput_columns;
+    //raw pointers in order to get multi-column values
+    std::vector<std::vector<const vectorized::Column*>> _agg_input_raw_columns;
+    // Indicates we should use update or merge method to process aggregate column data
+    std::vector<bool> _is_merge_funcs;
+    // In order batch update agg states
+    vectorized::Buffer<AggDataPtr> _tmp_agg_states;
+    std::vector<AggFunctionTypes> _agg_fn_types;
+
+    // Exprs used to evaluate conjunct
+    std::vector<ExprContext*> _conjunct_ctxs;
+
+    // Exprs used to evaluate group by column
+    std::vector<ExprContext*> _group_by_expr_ctxs;
+    vectorized::Columns _group_by_columns;
+    std::vector<GroupByColumnTypes> _group_by_types;
+
+    RuntimeProfile::Counter* _rows_returned_counter{};
+    RuntimeProfile::Counter* _get_results_timer{};
+    RuntimeProfile::Counter* _iter_timer{};
+    RuntimeProfile::Counter* _agg_append_timer{};
+    RuntimeProfile::Counter* _group_by_append_timer{};
+    RuntimeProfile::Counter* _agg_compute_timer{};
+    RuntimeProfile::Counter* _streaming_timer{};
+    RuntimeProfile::Counter* _input_row_count{};
+    RuntimeProfile::Counter* _hash_table_size{};
+    RuntimeProfile::Counter* _pass_through_row_count{};
+    RuntimeProfile::Counter* _adaptive_streaming_windows{};
+    RuntimeProfile::Counter* _adaptive_preaggregation_windows{};
+    RuntimeProfile::Counter* _expr_compute_timer{};
+    RuntimeProfile::Counter* _expr_release_timer{};
+
+    // Tuple into which Update()/Merge()/Serialize() results are stored.
+    TupleId _intermediate_tuple_id;
+    TupleDescriptor* _intermediate_tuple_desc = nullptr;
+
+    // Tuple into which Finalize() results are stored. Possibly the same as
+    // the intermediate tuple.
+    TupleId _output_tuple_id;
+    TupleDescriptor* _output_tuple_desc = nullptr;
+
+    AggrPhase _aggr_phase = AggrPhase1;
+    std::vector<uint8_t> _streaming_selection;
+};
+
+// AggregatorFactory creates one Aggregator for each driver sequence, so that the pair of
+// sink and source operators created for the same driver sequence share the same Aggregator.
+class AggregatorFactory;
+using AggregatorFactoryPtr = std::shared_ptr<AggregatorFactory>;
+
+class AggregatorFactory {
+public:
+    AggregatorFactory(const TPlanNode& tnode) : _tnode(tnode) {}
+
+    AggregatorPtr get_or_create(size_t driver_sequence) {
+        auto it = _aggregators.find(driver_sequence);
+        if (it != _aggregators.end()) {
+            return it->second;
+        }
+        auto aggregator = std::make_shared<Aggregator>(_tnode);
+        _aggregators.emplace(driver_sequence, aggregator);
+        return aggregator;
+    }
+
+private:
+    const TPlanNode _tnode;
+    std::unordered_map<size_t, AggregatorPtr> _aggregators;
+};
+
+} // namespace vectorized
+} // namespace starrocks
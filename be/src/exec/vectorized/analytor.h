@@ -0,0 +1,314 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <queue>
+
+#include "column/vectorized_fwd.h"
+#include "exprs/agg/aggregate_factory.h"
+#include "exprs/expr.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/mem_pool.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+class MemTracker;
+class ObjectPool;
+namespace vectorized {
+
+class ManagedFunctionStates;
+using ManagedFunctionStatesPtr = std::unique_ptr<ManagedFunctionStates>;
+
+struct FunctionTypes {
+    TypeDescriptor result_type;
+    bool has_nullable_child;
+    bool is_nullable; // window function result whether is nullable
+};
+
+struct FrameRange {
+    int64_t start;
+    int64_t end;
+};
+
+class Analytor;
+using AnalytorPtr = std::shared_ptr<Analytor>;
+
+// Analytor holds the buffered input and the window function states of one analytic evaluation.
+// The input ordered by the partition and order exprs is pushed by add_chunk, and get_next outputs
+// the chunks whose window function results are all computed. It's shared by the vectorized analytic
+// node and by the pipeline analytic operators, the sink operator pushes the input and the source
+// operator of the next pipeline outputs the result.
+class Analytor {
+public:
+    Analytor(const TPlanNode& tnode, const RowDescriptor& child_row_desc, const TupleDescriptor* result_tuple_desc);
+
+    ~Analytor() = default;
+
+    Status prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile* runtime_profile, MemTracker* mem_tracker);
+
+    Status open(RuntimeState* state);
+
+    Status close(RuntimeState* state);
+
+    // An Analytor shared by a pair of sink and source operators is referenced by both of them,
+    // the last one which calls unref closes the Analytor.
+    void ref() { _num_refs.fetch_add(1, std::memory_order_relaxed); }
+    Status unref(RuntimeState* state) {
+        if (_num_refs.fetch_sub(1) == 1) {
+            return close(state);
+        }
+        return Status::OK();
+    }
+
+    // Buffer a non-empty input chunk.
+    Status add_chunk(const ChunkPtr& chunk);
+    // No more input chunk will be added.
+    void set_input_eos() { _input_eos = true; }
+    bool is_input_eos() const { return _input_eos; }
+
+    // Output the next chunk whose window function results are all computed.
+    // |*chunk| is set to nullptr without |*eos| if more input is needed to compute the results.
+    Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos);
+
+    const std::vector<ExprContext*>& partition_ctxs() const { return _partition_ctxs; }
+    int64_t limit() const { return _limit; }
+    bool reached_limit() const { return _limit != -1 && _num_rows_returned >= _limit; }
+    int64_t num_rows_returned() const { return _num_rows_returned; }
+
+    // The pipeline sink operator calls set_sink_complete when all the input has been added,
+    // after which the paired source operator computes and outputs the rest results.
+    bool is_sink_complete() const { return _is_sink_complete.load(std::memory_order_acquire); }
+    void set_sink_complete() { _is_sink_complete.store(true, std::memory_order_release); }
+    bool is_output_eos() const { return _is_output_eos.load(std::memory_order_acquire); }
+    void set_output_eos() { _is_output_eos.store(true, std::memory_order_release); }
+
+    // Chunks computed by the sink operator while adding input are handed over to the source
+    // operator through this buffer.
+    bool is_chunk_buffer_empty() const;
+    bool is_chunk_buffer_full() const;
+    ChunkPtr poll_chunk_buffer();
+    void offer_chunk_to_buffer(const ChunkPtr& chunk);
+
+private:
+    friend class ManagedFunctionStates;
+
+    enum FrameType {
+        Unbounded,               // BETWEEN UNBOUNDED PRECEDING AND UNBOUNDED FOLLOWING
+        UnboundedPrecedingRange, // RANGE BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW
+        UnboundedPrecedingRows,  // ROWS BETWEEN UNBOUNDED PRECEDING AND CURRENT ROW
+        Sliding                  // ROWS BETWEEN 1 PRECEDING AND 1 FOLLOWING
+    };
+
+    Status _get_next_for_unbounded_frame(RuntimeState* state, ChunkPtr* chunk, bool* eos);
+
+    Status _get_next_for_unbounded_preceding_range_frame(RuntimeState* state, ChunkPtr* chunk, bool* eos);
+
+    Status _get_next_for_unbounded_preceding_rows_frame(RuntimeState* state, ChunkPtr* chunk, bool* eos);
+
+    Status _get_next_for_sliding_frame(RuntimeState* state, ChunkPtr* chunk, bool* eos);
+
+    Status (Analytor::*_get_next)(RuntimeState* state, ChunkPtr* chunk, bool* eos) = nullptr;
+
+    void _update_window_batch_normal(int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
+                                     int64_t frame_end);
+
+    // lead and lag function is special, the frame_start and frame_end
+    // maybe less than zero.
+    void _update_window_batch_lead_lag(int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
+                                       int64_t frame_end);
+
+    void (Analytor::*_update_window_batch)(int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
+                                           int64_t frame_end) = nullptr;
+
+    // Slide the states from the frame |prev| of the previous row to the frame |frame| of the current row, by
+    // removing the rows leaving the frame and adding the rows entering it, the states which couldn't remove rows
+    // are computed from scratch.
+    void _slide_window_state(FrameRange prev, FrameRange frame);
+
+    void _reset_window_state();
+
+    bool _need_fetch_next_chunk(int64_t found_partition_end);
+
+    // Find the current partition end position from the buffered input.
+    // Return false if more input is needed to find it.
+    bool _try_find_partition_end(int64_t* partition_end);
+
+    void _get_window_function_result(int32_t start, int32_t end);
+
+    Status _output_result_chunk(ChunkPtr* chunk);
+
+    int64_t _get_total_position(int64_t local_position);
+
+    bool _is_new_partition(int64_t found_partition_end);
+
+    void _reset_state_for_new_partition(int64_t found_partition_end);
+
+    int64_t _find_partition_end();
+
+    void _find_peer_group_end();
+
+    FrameRange _get_sliding_frame_range_no_start(int64_t row_position);
+
+    FrameRange _get_sliding_frame_range_with_start(int64_t row_position);
+
+    FrameRange (Analytor::*_get_sliding_frame_range)(int64_t row_position) = nullptr;
+
+    void _remove_unused_buffer_values();
+
+    // Create new aggregate function result column by type
+    void _create_agg_result_columns(int64_t chunk_size);
+
+    int64_t _find_first_not_equal(Column* column, int64_t start, int64_t end);
+
+    size_t _compute_memory_usage();
+
+    void _append_column(size_t chunk_size, Column* dst_column, ColumnPtr& src_column);
+
+    const TPlanNode _tnode;
+    const RowDescriptor& _child_row_desc;
+
+    ObjectPool* _pool = nullptr;
+    RuntimeProfile* _runtime_profile = nullptr;
+    MemTracker* _mem_tracker = nullptr;
+
+    std::atomic<int32_t> _num_refs{0};
+    bool _is_closed = false;
+
+    int64_t _limit = -1;
+    int64_t _num_rows_returned = 0;
+
+    Columns _result_window_columns;
+    std::vector<ChunkPtr> _input_chunks;
+    std::vector<int64_t> input_chunk_first_row_positions;
+    int64_t _input_rows = 0;
+    int64_t _removed_from_buffer_rows = 0;
+    int64_t _removed_chunk_index = 0;
+    int64_t _output_chunk_index = 0;
+    int64_t _window_result_position = 0;
+    bool _input_eos = false;
+
+#ifdef NDEBUG
+    static constexpr int32_t BUFFER_CHUNK_NUMBER = 1000;
+#else
+    static constexpr int32_t BUFFER_CHUNK_NUMBER = 1;
+#endif
+
+#ifdef NDEBUG
+    static constexpr size_t memory_check_batch_size = 65535;
+#else
+    static constexpr size_t memory_check_batch_size = 1;
+#endif
+
+    // The max number of chunks buffered between sink and source operators
+    static constexpr size_t max_buffered_chunks = 8;
+
+    int64_t _current_row_position = 0;
+    int64_t _partition_start = 0;
+    int64_t _partition_end = 0;
+    // A peer group is all of the rows that are peers within the specified ordering.
+    // Rows are peers if they compare equal to each other using the specified ordering expression.
+    int64_t _peer_group_start = 0;
+    int64_t _peer_group_end = 0;
+
+    // Offset from the current row for ROWS windows with start or end bounds specified
+    // with offsets. Is positive if the offset is FOLLOWING, negative if PRECEDING, and 0
+    // if type is CURRENT ROW or UNBOUNDED PRECEDING/FOLLOWING.
+    int64_t _rows_start_offset = 0;
+    int64_t _rows_end_offset = 0;
+
+    int64_t _last_memory_usage = 0;
+
+    std::unique_ptr<MemPool> _mem_pool;
+
+    // The offset of the n-th window function in a row of window functions.
+    std::vector<size_t> _agg_states_offsets;
+    // The total size of the row for the window function state.
+    size_t _agg_states_total_size = 0;
+    // The max align size for all window aggregate state
+    size_t _max_agg_state_align_size = 1;
+    std::vector<starrocks_udf::FunctionContext*> _agg_fn_ctxs;
+    std::vector<const AggregateFunction*> _agg_functions;
+    std::vector<ManagedFunctionStatesPtr> _managed_fn_states;
+    std::vector<std::vector<ExprContext*>> _agg_expr_ctxs;
+    std::vector<std::vector<ColumnPtr>> _agg_intput_columns;
+    std::vector<FunctionTypes> _agg_fn_types;
+
+    std::vector<ExprContext*> _partition_ctxs;
+    Columns _partition_columns;
+
+    std::vector<ExprContext*> _order_ctxs;
+    Columns _order_columns;
+
+    // Tuple descriptor for storing results of analytic fn evaluation.
+    const TupleDescriptor* _result_tuple_desc;
+    // Tuple id of the buffered tuple (identical to the input child tuple, which is
+    // assumed to come from a single SortNode). NULL if both partition_exprs and
+    // order_by_exprs are empty.
+    TTupleId _buffered_tuple_id = 0;
+
+    std::atomic<bool> _is_sink_complete{false};
+    std::atomic<bool> _is_output_eos{false};
+    mutable std::mutex _buffer_mutex;
+    std::queue<ChunkPtr> _buffer;
+
+    // Time spent processing the child rows.
+    RuntimeProfile::Counter* _compute_timer{};
+};
+
+// Helper class that properly invokes destructor when state goes out of scope.
+class ManagedFunctionStates {
+public:
+    ManagedFunctionStates(AggDataPtr agg_states, Analytor* analytor) : _agg_states(agg_states), _analytor(analytor) {
+        for (int i = 0; i < _analytor->_agg_functions.size(); i++) {
+            _analytor->_agg_functions[i]->create(_agg_states + _analytor->_agg_states_offsets[i]);
+        }
+    }
+
+    ~ManagedFunctionStates() {
+        for (int i = 0; i < _analytor->_agg_functions.size(); i++) {
+            _analytor->_agg_functions[i]->destroy(_agg_states + _analytor->_agg_states_offsets[i]);
+        }
+    }
+
+    uint8_t* mutable_data() { return _agg_states; }
+    const uint8_t* data() const { return _agg_states; }
+
+private:
+    AggDataPtr _agg_states;
+    Analytor* _analytor;
+};
+
+// AnalytorFactory creates one Analytor for each driver sequence, so that the pair of
+// sink and source operators created for the same driver sequence share the same Analytor.
+class AnalytorFactory;
+using AnalytorFactoryPtr = std::shared_ptr<AnalytorFactory>;
+
+class AnalytorFactory {
+public:
+    AnalytorFactory(const TPlanNode& tnode, const RowDescriptor& child_row_desc,
+                    const TupleDescriptor* result_tuple_desc)
+            : _tnode(tnode), _child_row_desc(child_row_desc), _result_tuple_desc(result_tuple_desc) {}
+
+    AnalytorPtr get_or_create(size_t driver_sequence) {
+        auto it = _analytors.find(driver_sequence);
+        if (it != _analytors.end()) {
+            return it->second;
+        }
+        auto analytor = std::make_shared<Analytor>(_tnode, _child_row_desc, _result_tuple_desc);
+        _analytors.emplace(driver_sequence, analytor);
+        return analytor;
+    }
+
+private:
+    const TPlanNode _tnode;
+    const RowDescriptor& _child_row_desc;
+    const TupleDescriptor* _result_tuple_desc;
+    std::unordered_map<size_t, AnalytorPtr> _analytors;
+};
+
+} // namespace vectorized
+} // namespace starrocks
@@ -117,6 +117,10 @@ IS_ASSIGNABLE(ArrowTypeId::FLOAT, TYPE_DOUBLE)
 size_t fill_null_column(const arrow::Array* array, size_t array_start_idx, size_t num_elements, NullColumn* null_column,
                         size_t column_start_idx) {
     null_column->resize(null_column->size() + num_elements);
+    // The null column has been resized with zeros, which are all its values for an array without nulls.
+    if (array->null_count() == 0) {
+        return 0;
+    }
     auto* null_data = (&null_column->get_data().front()) + column_start_idx;
     size_t null_count = 0;
     for (size_t i = 0; i < num_elements; ++i) {
@@ -130,15 +134,19 @@ size_t fill_null_column(const arrow::Array* array, size_t array_start_idx, size_
 void fill_filter(const arrow::Array* array, size_t array_start_idx, size_t num_elements, Column::Filter* filter,
                  size_t column_start_idx) {
     DCHECK_EQ(filter->size(), column_start_idx + num_elements);
+    if (array->null_count() == 0) {
+        return;
+    }
+    // The rows filtered out by the other columns stay filtered out.
     auto* filter_data = (&filter->front()) + column_start_idx;
     for (size_t i = 0; i < num_elements; ++i) {
-        filter_data[i] = array->IsValid(array_start_idx + i);
+        filter_data[i] &= array->IsValid(array_start_idx + i);
     }
 }
 // A general arrow converter for fixed length type
 //
 // case#1: is_directly_copy(AT, PT>==true
-// if underlying types are identical, the copy the whole memory by calling memcpy
+// if underlying types are identical, the copy the whole memory of the values buffer by appending it to the column
 // e.g.
 // UINT8 or INT8 in arrow convert to TYPE_TINYINT in StarRocks
 // FLOAT in arrow convert to TYPE_FLOAT
@@ -166,13 +174,15 @@ struct ArrowConverter {
                         [[maybe_unused]] uint8_t* filter_data, ArrowConvertContext* ctx) {
         auto concrete_array = down_cast<const ArrowArrayType*>(array);
         auto concrete_column = down_cast<ColumnType*>(column);
-        concrete_column->resize(column->size() + num_elements);
-        CppType* data = &concrete_column->get_data().front() + column_start_idx;
         if constexpr (is_directly_copyable<AT, PT>) {
+            // Append the values buffer of the array as it is, without zero-filling the column first.
             static_assert(sizeof(CppType) == sizeof(ArrowCppType));
+            DCHECK_EQ(column->size(), column_start_idx);
             const ArrowCppType* array_data = concrete_array->raw_values() + array_start_idx;
-            strings::memcpy_inlined(data, array_data, num_elements * sizeof(CppType));
+            concrete_column->append_numbers(array_data, num_elements * sizeof(CppType));
         } else if constexpr (is_assignable<AT, PT>) {
+            concrete_column->resize(column->size() + num_elements);
+            CppType* data = &concrete_column->get_data().front() + column_start_idx;
             for (size_t i = 0; i < num_elements; ++i) {
                 data[i] = static_cast<CppType>(concrete_array->Value(array_start_idx + i));
             }
@@ -4,8 +4,14 @@
 
 #include "column/vectorized_fwd.h"
 #include "exprs/expr_context.h"
+#include "runtime/types.h"
 #include "util/runtime_profile.h"
 
+namespace starrocks {
+class SortExecExprs;
+class TupleDescriptor;
+} // namespace starrocks
+
 namespace starrocks::vectorized {
 struct PermutationItem {
     uint32_t chunk_index;
@@ -259,6 +265,12 @@ struct DataSegment {
 };
 using DataSegments = std::vector<DataSegment>;
 
+// The type of a slot of the materialized sort tuple.
+struct OrderByType {
+    TypeDescriptor type_desc;
+    bool is_nullable;
+};
+
 // Sort Chunks in memory with specified order by rules.
 class ChunksSorter {
 public:
@@ -273,14 +285,23 @@ public:
                  const std::vector<bool>* is_null_first, size_t size_of_chunk_batch = 1000);
     virtual ~ChunksSorter();
 
-    void setup_runtime(MemTracker* mem_tracker, RuntimeProfile* profile, const std::string& parent_timer);
+    static constexpr size_t SIZE_OF_CHUNK_FOR_TOPN = 3000;
+    static constexpr size_t SIZE_OF_CHUNK_FOR_FULL_SORT = 5000;
+
+    virtual void setup_runtime(MemTracker* mem_tracker, RuntimeProfile* profile, const std::string& parent_timer);
 
     // Append a Chunk for sort.
     virtual Status update(RuntimeState* state, const ChunkPtr& chunk) = 0;
     // Finish seeding Chunk, and get sorted data with top OFFSET rows have been skipped.
     virtual Status done(RuntimeState* state) = 0;
     // get_next only works after done().
-    virtual void get_next(ChunkPtr* chunk, bool* eos) = 0;
+    virtual Status get_next(ChunkPtr* chunk, bool* eos) = 0;
+
+    // Evaluate the sort tuple slot exprs of |sort_exec_exprs| on |chunk|, and return a chunk
+    // whose columns are the slots of |materialized_tuple_desc|.
+    static ChunkPtr materialize_chunk_before_sort(Chunk* chunk, TupleDescriptor* materialized_tuple_desc,
+                                                  const SortExecExprs& sort_exec_exprs,
+                                                  const std::vector<OrderByType>& order_by_types);
 
 protected:
     inline size_t _get_number_of_order_by_columns() const { return _sort_exprs->size(); }
@@ -0,0 +1,162 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/chunks_sorter_external_sort.h"
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "runtime/tmp_file_mgr.h"
+
+namespace starrocks::vectorized {
+
+ChunksSorterExternalSort::ChunksSorterExternalSort(const std::vector<ExprContext*>* sort_exprs,
+                                                   const std::vector<bool>* is_asc,
+                                                   const std::vector<bool>* is_null_first,
+                                                   const RowDescriptor& row_desc)
+        : ChunksSorter(sort_exprs, is_asc, is_null_first, SIZE_OF_CHUNK_FOR_FULL_SORT),
+          _is_asc(is_asc),
+          _is_null_first(is_null_first),
+          _row_desc(row_desc) {}
+
+ChunksSorterExternalSort::~ChunksSorterExternalSort() = default;
+
+void ChunksSorterExternalSort::setup_runtime(MemTracker* mem_tracker, RuntimeProfile* profile,
+                                             const std::string& parent_timer) {
+    ChunksSorter::setup_runtime(mem_tracker, profile, parent_timer);
+    _profile = profile;
+    _parent_timer = parent_timer;
+    _spill_timer = ADD_CHILD_TIMER(profile, "SpillTime", parent_timer);
+    _spilled_runs_counter = ADD_COUNTER(profile, "SpilledRuns", TUnit::UNIT);
+    _spilled_rows_counter = ADD_COUNTER(profile, "SpilledRows", TUnit::UNIT);
+}
+
+void ChunksSorterExternalSort::_new_run() {
+    _run_sorter = std::make_unique<ChunksSorterFullSort>(_sort_exprs, _is_asc, _is_null_first, _size_of_chunk_batch);
+    // every run sorter consumes and releases its own memory, and shares the timers.
+    _run_sorter->setup_runtime(_mem_tracker, _profile, _parent_timer);
+    _run_rows = 0;
+}
+
+bool ChunksSorterExternalSort::_need_spill(RuntimeState* state) const {
+    if (_run_rows == 0 || _mem_tracker == nullptr) {
+        return false;
+    }
+    int64_t limit = _mem_tracker->lowest_limit();
+    if (limit <= 0) {
+        return false;
+    }
+    return _mem_tracker->spare_capacity() < limit / 100 * (100 - config::sort_spill_mem_limit_percent) &&
+           state->spill_coordinator()->should_spill(_mem_tracker);
+}
+
+Status ChunksSorterExternalSort::update(RuntimeState* state, const ChunkPtr& chunk) {
+    if (_need_spill(state)) {
+        RETURN_IF_ERROR(_spill_run(state));
+    }
+    if (_run_sorter == nullptr) {
+        _new_run();
+    }
+    RETURN_IF_ERROR(_run_sorter->update(state, chunk));
+    _run_rows += chunk->num_rows();
+    return Status::OK();
+}
+
+Status ChunksSorterExternalSort::_spill_run(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    TmpFileMgr* tmp_file_mgr = state->exec_env()->tmp_file_mgr();
+    std::vector<TmpFileMgr::DeviceId> devices = tmp_file_mgr->active_tmp_devices();
+    if (devices.empty()) {
+        return Status::InternalError("no temporary directory to spill the sort");
+    }
+
+    RETURN_IF_ERROR(_run_sorter->done(state));
+    // spread the runs over the devices.
+    TmpFileMgr::File* file = nullptr;
+    RETURN_IF_ERROR(tmp_file_mgr->get_file(devices[_spilled_runs.size() % devices.size()], state->query_id(), &file));
+    auto run = std::make_unique<SpilledChunkFile>(file, _row_desc);
+    bool eos = false;
+    while (true) {
+        RETURN_IF_CANCELLED(state);
+        ChunkPtr chunk;
+        RETURN_IF_ERROR(_run_sorter->get_next(&chunk, &eos));
+        if (eos) {
+            break;
+        }
+        RETURN_IF_ERROR(run->write(*chunk));
+    }
+    COUNTER_UPDATE(_spilled_runs_counter, 1);
+    COUNTER_UPDATE(_spilled_rows_counter, run->num_rows());
+    _spilled_runs.emplace_back(std::move(run));
+    // release the memory of the run.
+    _run_sorter.reset();
+    _run_rows = 0;
+    return Status::OK();
+}
+
+Status ChunksSorterExternalSort::done(RuntimeState* state) {
+    if (_mem_tracker != nullptr) {
+        state->spill_coordinator()->finish(_mem_tracker);
+    }
+    if (_run_sorter != nullptr) {
+        RETURN_IF_ERROR(_run_sorter->done(state));
+    }
+    if (!_spilled_runs.empty()) {
+        RETURN_IF_ERROR(_init_merger(state));
+    }
+    return Status::OK();
+}
+
+Status ChunksSorterExternalSort::_init_merger(RuntimeState* state) {
+    ChunkSuppliers chunk_suppliers;
+    for (auto& run : _spilled_runs) {
+        SpilledChunkFile* file = run.get();
+        chunk_suppliers.emplace_back([this, file](Chunk** chunk) -> Status {
+            ChunkPtr spilled_chunk;
+            bool eos = false;
+            Status status = file->read(&spilled_chunk, &eos);
+            if (!status.ok()) {
+                _merge_status = status;
+                *chunk = nullptr;
+                return status;
+            }
+            *chunk = eos ? nullptr : new Chunk(std::move(*spilled_chunk));
+            return Status::OK();
+        });
+    }
+    // the rows in memory are the last run, which is merged without being spilled.
+    if (_run_sorter != nullptr) {
+        ChunksSorterFullSort* sorter = _run_sorter.get();
+        chunk_suppliers.emplace_back([sorter](Chunk** chunk) -> Status {
+            ChunkPtr sorted_chunk;
+            bool eos = false;
+            RETURN_IF_ERROR(sorter->get_next(&sorted_chunk, &eos));
+            // The chunk output by the sorter isn't shared with anyone else, so it could be moved out.
+            *chunk = eos ? nullptr : new Chunk(std::move(*sorted_chunk));
+            return Status::OK();
+        });
+    }
+
+    _merger = std::make_unique<SortedChunksMerger>();
+    RETURN_IF_ERROR(_merger->init(chunk_suppliers, _sort_exprs, _is_asc, _is_null_first));
+    _merger->set_profile(_profile);
+    return _merge_status;
+}
+
+Status ChunksSorterExternalSort::get_next(ChunkPtr* chunk, bool* eos) {
+    if (_merger == nullptr) {
+        if (_run_sorter == nullptr) {
+            *chunk = nullptr;
+            *eos = true;
+            return Status::OK();
+        }
+        return _run_sorter->get_next(chunk, eos);
+    }
+
+    SCOPED_TIMER(_merge_timer);
+    RETURN_IF_ERROR(_merger->get_next(chunk, eos));
+    return _merge_status;
+}
+
+} // namespace starrocks::vectorized
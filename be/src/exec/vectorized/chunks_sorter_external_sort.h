@@ -0,0 +1,63 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "exec/vectorized/chunks_sorter.h"
+#include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exec/vectorized/join_spiller.h"
+#include "runtime/vectorized/sorted_chunks_merger.h"
+
+namespace starrocks {
+class RowDescriptor;
+}
+
+namespace starrocks::vectorized {
+
+// ChunksSorterExternalSort sorts the chunks like ChunksSorterFullSort, but once the memory tracker has less
+// than (100 - sort_spill_mem_limit_percent)% spare, the rows sorted in memory are written as a sorted run to
+// a temporary file of TmpFileMgr. At last the spilled runs and the run in memory are merged by
+// SortedChunksMerger. The chunks are the materialized sort tuples described by |row_desc|.
+class ChunksSorterExternalSort final : public ChunksSorter {
+public:
+    ChunksSorterExternalSort(const std::vector<ExprContext*>* sort_exprs, const std::vector<bool>* is_asc,
+                             const std::vector<bool>* is_null_first, const RowDescriptor& row_desc);
+    ~ChunksSorterExternalSort() override;
+
+    void setup_runtime(MemTracker* mem_tracker, RuntimeProfile* profile, const std::string& parent_timer) override;
+
+    Status update(RuntimeState* state, const ChunkPtr& chunk) override;
+    Status done(RuntimeState* state) override;
+    Status get_next(ChunkPtr* chunk, bool* eos) override;
+
+private:
+    bool _need_spill(RuntimeState* state) const;
+    void _new_run();
+    // Sort the current run and write it to a temporary file.
+    Status _spill_run(RuntimeState* state);
+    Status _init_merger(RuntimeState* state);
+
+    const std::vector<bool>* _is_asc;
+    const std::vector<bool>* _is_null_first;
+    const RowDescriptor& _row_desc;
+
+    RuntimeProfile* _profile = nullptr;
+    std::string _parent_timer;
+
+    // The rows in memory, which are sorted by a ChunksSorterFullSort.
+    std::unique_ptr<ChunksSorterFullSort> _run_sorter;
+    size_t _run_rows = 0;
+    std::vector<std::unique_ptr<SpilledChunkFile>> _spilled_runs;
+
+    std::unique_ptr<SortedChunksMerger> _merger;
+    // ChunkCursor ignores the status of its supplier, so the failure of reading a run is kept here.
+    Status _merge_status;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spilled_runs_counter = nullptr;
+    RuntimeProfile::Counter* _spilled_rows_counter = nullptr;
+};
+
+} // namespace starrocks::vectorized
@@ -5,9 +5,11 @@
 #include "column/type_traits.h"
 #include "exprs/expr.h"
 #include "gutil/casts.h"
+#include "gutil/endian.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
 #include "util/orlp/pdqsort.h"
+#include "util/radix_sort.h"
 #include "util/stopwatch.hpp"
 
 namespace starrocks::vectorized {
@@ -71,7 +73,117 @@ public:
         pdqsort(perm.begin(), perm.end(), cmp_fn);
     }
 
+    // Sort on the normalized key of the first order-by column, whose values are stored as T, or Slice
+    // for binary column. Like storage/key_coder.h, the key is a memcomparable encoding of the value,
+    // or of the first 8 bytes of a string, and its bits are flipped for the descending order. The keys
+    // are sorted by radix sort, and the ranges of the rows with the same key are put to |tie_ranges|.
+    template <typename T>
+    static void sort_by_normalized_key(const Column* column, bool is_asc_order, bool is_null_first, Permutation& perm,
+                                       std::vector<std::pair<uint32_t, uint32_t>>* tie_ranges) {
+        using KeyType = std::conditional_t<IsSlice<T> || (sizeof(T) > sizeof(uint32_t)), uint64_t, uint32_t>;
+
+        const Column* data_column = column;
+        const uint8_t* nulls = nullptr;
+        if (column->is_nullable()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(column);
+            data_column = nullable_column->data_column().get();
+            if (nullable_column->has_null()) {
+                nulls = nullable_column->null_column()->get_data().data();
+            }
+        }
+
+        const auto num_rows = static_cast<uint32_t>(perm.size());
+        std::vector<NormalizedKeyItem<KeyType>> items;
+        items.reserve(num_rows);
+        std::vector<uint32_t> null_rows;
+        for (uint32_t i = 0; i < num_rows; ++i) {
+            if (nulls != nullptr && nulls[i]) {
+                null_rows.push_back(i);
+                continue;
+            }
+            KeyType key;
+            if constexpr (IsSlice<T>) {
+                key = encode_binary_key_prefix(down_cast<const BinaryColumn*>(data_column)->get_slice(i));
+            } else {
+                key = encode_fixed_length_key<T, KeyType>(reinterpret_cast<const T*>(data_column->raw_data())[i]);
+            }
+            items.push_back({is_asc_order ? key : static_cast<KeyType>(~key), i});
+        }
+        // LSD radix sort is stable, so the rows of the same key keep their input order.
+        RadixSort<NormalizedKeyRadixSortTraits<KeyType>>::executeLSD(items.data(), items.size());
+
+        uint32_t pos = 0;
+        auto append_null_rows = [&]() {
+            if (null_rows.size() > 1) {
+                tie_ranges->emplace_back(pos, pos + null_rows.size());
+            }
+            for (uint32_t row : null_rows) {
+                perm[pos++].index_in_chunk = row;
+            }
+        };
+        if (is_null_first) {
+            append_null_rows();
+        }
+        for (size_t i = 0; i < items.size();) {
+            size_t end = i + 1;
+            while (end < items.size() && items[end].key == items[i].key) {
+                ++end;
+            }
+            if (end - i > 1) {
+                tie_ranges->emplace_back(pos, pos + (end - i));
+            }
+            for (; i < end; ++i) {
+                perm[pos++].index_in_chunk = items[i].index_in_chunk;
+            }
+        }
+        if (!is_null_first) {
+            append_null_rows();
+        }
+    }
+
 private:
+    template <typename KeyType>
+    struct NormalizedKeyItem {
+        KeyType key;
+        uint32_t index_in_chunk;
+    };
+
+    template <typename KeyType>
+    struct NormalizedKeyRadixSortTraits {
+        using Element = NormalizedKeyItem<KeyType>;
+        using Key = KeyType;
+        using CountType = uint32_t;
+        using KeyBits = KeyType;
+
+        static constexpr size_t PART_SIZE_BITS = 8;
+
+        using Transform = RadixSortIdentityTransform<KeyBits>;
+        using Allocator = RadixSortMallocAllocator;
+
+        static Key& extractKey(Element& elem) { return elem.key; }
+
+        static bool less(Key x, Key y) { return x < y; }
+    };
+
+    // The order of the values of the fixed-length types, like date and decimal, is the order of their
+    // storage integers, which is the order of the unsigned integers with the sign bit flipped.
+    template <typename T, typename KeyType>
+    static KeyType encode_fixed_length_key(T value) {
+        using UnsignedType = std::make_unsigned_t<T>;
+        auto bits = static_cast<UnsignedType>(value);
+        if constexpr (std::is_signed_v<T>) {
+            bits ^= UnsignedType(1) << (sizeof(T) * 8 - 1);
+        }
+        return static_cast<KeyType>(bits);
+    }
+
+    // The first 8 bytes of the string in big endian, padded by 0, are ordered like memcmp.
+    static uint64_t encode_binary_key_prefix(const Slice& value) {
+        uint64_t key = 0;
+        memcpy(&key, value.data, std::min<size_t>(value.size, sizeof(key)));
+        return BigEndian::FromHost64(key);
+    }
+
     // Sort on type-known column, and the column has no NULL value in sorting range.
     template <PrimitiveType PT, bool stable>
     static void sort_on_not_null_column_within_range(Column* column, bool is_asc_order, Permutation& perm,
@@ -268,31 +380,34 @@ Status ChunksSorterFullSort::done(RuntimeState* state) {
     return Status::OK();
 }
 
-void ChunksSorterFullSort::get_next(ChunkPtr* chunk, bool* eos) {
+Status ChunksSorterFullSort::get_next(ChunkPtr* chunk, bool* eos) {
     SCOPED_TIMER(_output_timer);
     if (_next_output_row >= _sorted_permutation.size()) {
         *chunk = nullptr;
         *eos = true;
-        return;
+        return Status::OK();
     }
     *eos = false;
     size_t count = std::min(size_t(config::vector_chunk_size), _sorted_permutation.size() - _next_output_row);
     chunk->reset(_sorted_segment->chunk->clone_empty(count).release());
     _append_rows_to_chunk(chunk->get(), _sorted_segment->chunk.get(), _sorted_permutation, _next_output_row, count);
     _next_output_row += count;
+    return Status::OK();
 }
 
 Status ChunksSorterFullSort::_sort_chunks(RuntimeState* state) {
     // Step1: construct permutation
     RETURN_IF_ERROR(_build_sorting_data(state));
 
-    // Step2: sort by columns or row
+    // Step2: sort by normalized key, columns or row
     // For no more than three order-by columns, sorting by columns can benefit from reducing
     // the cost of calling virtual functions of Column::compare_at.
-    if (_get_number_of_order_by_columns() <= 3) {
-        _sort_by_columns();
-    } else {
-        _sort_by_row_cmp();
+    if (!_sort_by_normalized_key()) {
+        if (_get_number_of_order_by_columns() <= 3) {
+            _sort_by_columns();
+        } else {
+            _sort_by_row_cmp();
+        }
     }
     return Status::OK();
 }
@@ -353,6 +468,88 @@ void ChunksSorterFullSort::_sort_by_row_cmp() {
     }
 }
 
+// Sort by the normalized key of the first order-by column if it's an integer, date, decimal or string column,
+// only the rows of the same key are sorted by the comparators.
+bool ChunksSorterFullSort::_sort_by_normalized_key() {
+    if (config::full_sort_normalized_key_min_rows < 0 ||
+        _sorted_permutation.size() < config::full_sort_normalized_key_min_rows ||
+        _get_number_of_order_by_columns() < 1) {
+        return false;
+    }
+    const Column* column = _sorted_segment->order_by_columns[0].get();
+    if (column->is_constant()) {
+        return false;
+    }
+
+    SCOPED_TIMER(_sort_timer);
+    bool is_asc_order = (_sort_order_flag[0] == 1);
+    bool is_null_first = is_asc_order ? (_null_first_flag[0] == -1) : (_null_first_flag[0] == 1);
+    // Whether the key is the whole value, otherwise the rows of the same key are compared by the first column too.
+    bool is_exact_key = true;
+    std::vector<std::pair<uint32_t, uint32_t>> tie_ranges;
+    switch ((*_sort_exprs)[0]->root()->type().type) {
+    case TYPE_BOOLEAN:
+        SortHelper::sort_by_normalized_key<uint8_t>(column, is_asc_order, is_null_first, _sorted_permutation,
+                                                    &tie_ranges);
+        break;
+    case TYPE_TINYINT:
+        SortHelper::sort_by_normalized_key<int8_t>(column, is_asc_order, is_null_first, _sorted_permutation,
+                                                   &tie_ranges);
+        break;
+    case TYPE_SMALLINT:
+        SortHelper::sort_by_normalized_key<int16_t>(column, is_asc_order, is_null_first, _sorted_permutation,
+                                                    &tie_ranges);
+        break;
+    case TYPE_INT:
+    case TYPE_DATE:
+    case TYPE_DECIMAL32:
+        SortHelper::sort_by_normalized_key<int32_t>(column, is_asc_order, is_null_first, _sorted_permutation,
+                                                    &tie_ranges);
+        break;
+    case TYPE_BIGINT:
+    case TYPE_DATETIME:
+    case TYPE_DECIMAL64:
+        SortHelper::sort_by_normalized_key<int64_t>(column, is_asc_order, is_null_first, _sorted_permutation,
+                                                    &tie_ranges);
+        break;
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        SortHelper::sort_by_normalized_key<Slice>(column, is_asc_order, is_null_first, _sorted_permutation,
+                                                  &tie_ranges);
+        is_exact_key = false;
+        break;
+    default:
+        return false;
+    }
+
+    const size_t first_column = is_exact_key ? 1 : 0;
+    if (first_column < _get_number_of_order_by_columns()) {
+        const DataSegment& data_segment = *_sorted_segment;
+        const std::vector<int>& sort_order_flag = _sort_order_flag;
+        const std::vector<int>& null_first_flag = _null_first_flag;
+        auto cmp_fn = [&data_segment, &sort_order_flag, &null_first_flag, first_column](const PermutationItem& l,
+                                                                                         const PermutationItem& r) {
+            for (size_t col_index = first_column; col_index < sort_order_flag.size(); ++col_index) {
+                const auto& column = data_segment.order_by_columns[col_index];
+                int c = column->compare_at(l.index_in_chunk, r.index_in_chunk, *column, null_first_flag[col_index]);
+                if (c != 0) {
+                    return c * sort_order_flag[col_index] < 0;
+                }
+            }
+            return l.index_in_chunk < r.index_in_chunk;
+        };
+        for (auto [from, to] : tie_ranges) {
+            pdqsort(_sorted_permutation.begin() + from, _sorted_permutation.begin() + to, cmp_fn);
+        }
+    }
+
+    const size_t size = _sorted_permutation.size();
+    for (size_t i = 0; i < size; ++i) {
+        _sorted_permutation[i].permutation_index = i;
+    }
+    return true;
+}
+
 #define CASE_FOR_NULLABLE_COLUMN_SORT(PrimitiveTypeName)                                                       \
     case PrimitiveTypeName: {                                                                                  \
         if (stable) {                                                                                          \
@@ -24,7 +24,7 @@ public:
     // Append a Chunk for sort.
     Status update(RuntimeState* state, const ChunkPtr& chunk) override;
     Status done(RuntimeState* state) override;
-    void get_next(ChunkPtr* chunk, bool* eos) override;
+    Status get_next(ChunkPtr* chunk, bool* eos) override;
 
     friend class SortHelper;
 
@@ -32,6 +32,7 @@ private:
     Status _sort_chunks(RuntimeState* state);
     Status _build_sorting_data(RuntimeState* state);
 
+    bool _sort_by_normalized_key();
     void _sort_by_row_cmp();
     void _sort_by_columns();
 
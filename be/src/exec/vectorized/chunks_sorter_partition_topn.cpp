@@ -0,0 +1,223 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/chunks_sorter_partition_topn.h"
+
+#include <algorithm>
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "exprs/expr.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+ChunksSorterPartitionTopn::ChunksSorterPartitionTopn(const std::vector<ExprContext*>* sort_exprs,
+                                                     const std::vector<bool>* is_asc,
+                                                     const std::vector<bool>* is_null_first,
+                                                     const std::vector<ExprContext*>* partition_exprs,
+                                                     size_t partition_limit)
+        : ChunksSorter(sort_exprs, is_asc, is_null_first, SIZE_OF_CHUNK_FOR_FULL_SORT),
+          _is_asc(is_asc),
+          _is_null_first(is_null_first),
+          _partition_exprs(partition_exprs),
+          _partition_limit(partition_limit),
+          _mem_pool_tracker(std::make_unique<MemTracker>()),
+          _mem_pool(std::make_unique<MemPool>(_mem_pool_tracker.get())) {
+    DCHECK(!_partition_exprs->empty());
+    DCHECK_GT(_partition_limit, 0);
+}
+
+ChunksSorterPartitionTopn::~ChunksSorterPartitionTopn() = default;
+
+void ChunksSorterPartitionTopn::setup_runtime(MemTracker* mem_tracker, RuntimeProfile* profile,
+                                              const std::string& parent_timer) {
+    ChunksSorter::setup_runtime(mem_tracker, profile, parent_timer);
+    _profile = profile;
+    _parent_timer = parent_timer;
+}
+
+// The partition columns of fixed width are packed into a FixedSizeSliceKey if they fit in 32 bytes, otherwise
+// they are serialized into a slice. Every column is packed with a null flag, because the materialized partition
+// columns may be nullable.
+void ChunksSorterPartitionTopn::_init_hash_map_variant() {
+    FixedSizeKeyLayout layout;
+    uint32_t offset = 0;
+    for (ExprContext* expr_ctx : *_partition_exprs) {
+        size_t value_size = fixed_size_key_value_size(expr_ctx->root()->type().type);
+        if (value_size == 0) {
+            layout.clear();
+            break;
+        }
+        layout.push_back({offset, static_cast<uint32_t>(value_size), true});
+        offset += 1 + value_size;
+    }
+
+    auto type = AggHashMapVariant::Type::phase1_slice;
+    if (!layout.empty() && offset <= 8) {
+        type = AggHashMapVariant::Type::phase1_slice_fx8;
+    } else if (!layout.empty() && offset <= 16) {
+        type = AggHashMapVariant::Type::phase1_slice_fx16;
+    } else if (!layout.empty() && offset <= 32) {
+        type = AggHashMapVariant::Type::phase1_slice_fx32;
+    } else {
+        layout.clear();
+    }
+    _hash_map_variant.init(type);
+    if (!layout.empty()) {
+        _hash_map_variant.set_fixed_size_key_layout(layout);
+    }
+    _hash_map_initialized = true;
+}
+
+void ChunksSorterPartitionTopn::_find_partitions(const Columns& partition_columns, size_t num_rows) {
+    auto allocate_heap = [this]() {
+        _partitions.emplace_back();
+        return reinterpret_cast<AggDataPtr>(&_partitions.back());
+    };
+    _partition_heaps.resize(num_rows);
+    switch (_hash_map_variant.type) {
+#define M(NAME)                                                                                                 \
+    case AggHashMapVariant::Type::NAME:                                                                         \
+        _hash_map_variant.NAME->compute_agg_states(num_rows, partition_columns, _mem_pool.get(), allocate_heap, \
+                                                   &_partition_heaps);                                          \
+        break;
+        M(phase1_slice)
+        M(phase1_slice_fx8)
+        M(phase1_slice_fx16)
+        M(phase1_slice_fx32)
+#undef M
+    default:
+        DCHECK(false) << "unexpected hash map variant of partition top-n";
+        break;
+    }
+}
+
+Status ChunksSorterPartitionTopn::update(RuntimeState* state, const ChunkPtr& chunk) {
+    const size_t num_rows = chunk->num_rows();
+    {
+        SCOPED_TIMER(_build_timer);
+        Columns partition_columns;
+        partition_columns.reserve(_partition_exprs->size());
+        for (ExprContext* expr_ctx : *_partition_exprs) {
+            partition_columns.emplace_back(expr_ctx->evaluate(chunk.get()));
+        }
+        if (!_hash_map_initialized) {
+            _init_hash_map_variant();
+        }
+        _find_partitions(partition_columns, num_rows);
+
+        _segments.emplace_back(_sort_exprs, chunk);
+        _num_segment_rows += num_rows;
+        _segments_memory_usage += chunk->memory_usage();
+    }
+
+    {
+        SCOPED_TIMER(_sort_timer);
+        const auto segment_index = static_cast<uint32_t>(_segments.size() - 1);
+        auto less = [this](const RowRef& lhs, const RowRef& rhs) { return _compare(lhs, rhs) < 0; };
+        for (uint32_t i = 0; i < num_rows; ++i) {
+            auto* heap = reinterpret_cast<PartitionHeap*>(_partition_heaps[i]);
+            RowRef row{segment_index, i};
+            if (heap->size() < _partition_limit) {
+                heap->push_back(row);
+                std::push_heap(heap->begin(), heap->end(), less);
+                ++_num_kept_rows;
+            } else if (_compare(row, heap->front()) < 0) {
+                // replace the worst kept row.
+                std::pop_heap(heap->begin(), heap->end(), less);
+                heap->back() = row;
+                std::push_heap(heap->begin(), heap->end(), less);
+            }
+        }
+    }
+
+    // The replaced rows are released once they are as many as the kept rows.
+    if (_num_segment_rows - _num_kept_rows > std::max<size_t>(_num_kept_rows, config::vector_chunk_size)) {
+        SCOPED_TIMER(_merge_timer);
+        _compact_segments();
+    }
+    return _update_memory_usage(state);
+}
+
+void ChunksSorterPartitionTopn::_compact_segments() {
+    std::vector<std::vector<uint32_t>> selected_rows(_segments.size());
+    for (const auto& heap : _partitions) {
+        for (const auto& row : heap) {
+            selected_rows[row.segment_index].push_back(row.index_in_segment);
+        }
+    }
+
+    ChunkPtr chunk = _segments[0].chunk->clone_empty(_num_kept_rows);
+    std::vector<uint32_t> offsets(_segments.size());
+    for (size_t i = 0; i < _segments.size(); ++i) {
+        auto& rows = selected_rows[i];
+        std::sort(rows.begin(), rows.end());
+        offsets[i] = chunk->num_rows();
+        chunk->append_selective(*_segments[i].chunk, rows.data(), 0, rows.size());
+    }
+
+    // The kept rows are compared as before, so the heaps are still valid.
+    for (auto& heap : _partitions) {
+        for (auto& row : heap) {
+            const auto& rows = selected_rows[row.segment_index];
+            auto pos = std::lower_bound(rows.begin(), rows.end(), row.index_in_segment) - rows.begin();
+            row.index_in_segment = offsets[row.segment_index] + pos;
+            row.segment_index = 0;
+        }
+    }
+
+    _segments.clear();
+    _segments.emplace_back(_sort_exprs, chunk);
+    _num_segment_rows = chunk->num_rows();
+    _segments_memory_usage = chunk->memory_usage();
+}
+
+Status ChunksSorterPartitionTopn::_update_memory_usage(RuntimeState* state) {
+    int64_t memory_usage = _segments_memory_usage + _mem_pool->total_reserved_bytes() +
+                           _num_kept_rows * sizeof(RowRef) + _partitions.size() * sizeof(PartitionHeap);
+    if (_hash_map_initialized) {
+        memory_usage += _hash_map_variant.memory_usage();
+    }
+    return _consume_and_check_memory_limit(state, memory_usage - _last_memory_usage);
+}
+
+Status ChunksSorterPartitionTopn::done(RuntimeState* state) {
+    _output_sorter = std::make_unique<ChunksSorterFullSort>(_sort_exprs, _is_asc, _is_null_first,
+                                                            SIZE_OF_CHUNK_FOR_FULL_SORT);
+    if (_profile != nullptr) {
+        _output_sorter->setup_runtime(_mem_tracker, _profile, _parent_timer);
+    }
+
+    ChunkPtr chunk;
+    if (_num_kept_rows > 0) {
+        SCOPED_TIMER(_merge_timer);
+        if (_segments.size() > 1 || _num_segment_rows > _num_kept_rows) {
+            _compact_segments();
+        }
+        chunk = _segments[0].chunk;
+    }
+    // The kept rows are sorted by the output sorter, which accounts for their memory.
+    _segments.clear();
+    _partitions.clear();
+    _mem_pool->free_all();
+    _segments_memory_usage = 0;
+    _num_segment_rows = 0;
+    _num_kept_rows = 0;
+    RETURN_IF_ERROR(_update_memory_usage(state));
+
+    if (chunk != nullptr) {
+        RETURN_IF_ERROR(_output_sorter->update(state, chunk));
+    }
+    return _output_sorter->done(state);
+}
+
+Status ChunksSorterPartitionTopn::get_next(ChunkPtr* chunk, bool* eos) {
+    if (_output_sorter == nullptr) {
+        *chunk = nullptr;
+        *eos = true;
+        return Status::OK();
+    }
+    return _output_sorter->get_next(chunk, eos);
+}
+
+} // namespace starrocks::vectorized
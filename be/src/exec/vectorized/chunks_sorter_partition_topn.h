@@ -0,0 +1,79 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "exec/vectorized/chunks_sorter.h"
+#include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "runtime/mem_pool.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks::vectorized {
+
+// ChunksSorterPartitionTopn keeps the first |partition_limit| rows of every partition of |partition_exprs| in the
+// order of |sort_exprs|, e.g. the rows of row_number() <= partition_limit below the window. The partitions of the
+// rows are found in an AggHashMapVariant like the group by keys of an aggregation, and every partition has a
+// bounded max-heap of its kept rows compared by DataSegment::compare_at, whose top is the worst one that a better
+// row replaces. Once the input chunks hold too many replaced rows, the kept rows are copied into a new chunk.
+// The kept rows of all the partitions are output in the order of |sort_exprs| by a ChunksSorterFullSort, so that
+// the output of every driver could be merged as a sorted run.
+class ChunksSorterPartitionTopn final : public ChunksSorter {
+public:
+    ChunksSorterPartitionTopn(const std::vector<ExprContext*>* sort_exprs, const std::vector<bool>* is_asc,
+                              const std::vector<bool>* is_null_first,
+                              const std::vector<ExprContext*>* partition_exprs, size_t partition_limit);
+    ~ChunksSorterPartitionTopn() override;
+
+    void setup_runtime(MemTracker* mem_tracker, RuntimeProfile* profile, const std::string& parent_timer) override;
+
+    Status update(RuntimeState* state, const ChunkPtr& chunk) override;
+    Status done(RuntimeState* state) override;
+    Status get_next(ChunkPtr* chunk, bool* eos) override;
+
+private:
+    // A kept row of a partition.
+    struct RowRef {
+        uint32_t segment_index;
+        uint32_t index_in_segment;
+    };
+    using PartitionHeap = std::vector<RowRef>;
+
+    void _init_hash_map_variant();
+    void _find_partitions(const Columns& partition_columns, size_t num_rows);
+    // Copy the kept rows of all the partitions into one segment.
+    void _compact_segments();
+    Status _update_memory_usage(RuntimeState* state);
+    int _compare(const RowRef& lhs, const RowRef& rhs) const {
+        return _segments[lhs.segment_index].compare_at(lhs.index_in_segment, _segments[rhs.segment_index],
+                                                       rhs.index_in_segment, _sort_order_flag, _null_first_flag);
+    }
+
+    const std::vector<bool>* _is_asc;
+    const std::vector<bool>* _is_null_first;
+    const std::vector<ExprContext*>* _partition_exprs;
+    const size_t _partition_limit;
+
+    AggHashMapVariant _hash_map_variant;
+    bool _hash_map_initialized = false;
+    // The serialized partition keys are copied into |_mem_pool|.
+    std::unique_ptr<MemTracker> _mem_pool_tracker;
+    std::unique_ptr<MemPool> _mem_pool;
+    // The values of the hash map point to the heaps, whose addresses are stable.
+    std::deque<PartitionHeap> _partitions;
+    Buffer<AggDataPtr> _partition_heaps;
+
+    DataSegments _segments;
+    size_t _num_segment_rows = 0;
+    size_t _num_kept_rows = 0;
+    int64_t _segments_memory_usage = 0;
+
+    std::unique_ptr<ChunksSorterFullSort> _output_sorter;
+    RuntimeProfile* _profile = nullptr;
+    std::string _parent_timer;
+};
+
+} // namespace starrocks::vectorized
@@ -2,7 +2,9 @@
 
 #include "chunks_sorter_topn.h"
 
+#include "column/column_helper.h"
 #include "column/type_traits.h"
+#include "exec/olap_common.h"
 #include "exprs/expr.h"
 #include "gutil/casts.h"
 #include "runtime/mem_tracker.h"
@@ -83,18 +85,19 @@ Status ChunksSorterTopn::done(RuntimeState* state) {
     return Status::OK();
 }
 
-void ChunksSorterTopn::get_next(ChunkPtr* chunk, bool* eos) {
+Status ChunksSorterTopn::get_next(ChunkPtr* chunk, bool* eos) {
     ScopedTimer<MonotonicStopWatch> timer(_output_timer);
     if (_next_output_row >= _merged_segment.chunk->num_rows()) {
         *chunk = nullptr;
         *eos = true;
-        return;
+        return Status::OK();
     }
     *eos = false;
     size_t count = std::min(size_t(config::vector_chunk_size), _merged_segment.chunk->num_rows() - _next_output_row);
     chunk->reset(_merged_segment.chunk->clone_empty(count).release());
     (*chunk)->append_safe(*_merged_segment.chunk, _next_output_row, count);
     _next_output_row += count;
+    return Status::OK();
 }
 
 Status ChunksSorterTopn::_sort_chunks(RuntimeState* state) {
@@ -130,9 +133,91 @@ Status ChunksSorterTopn::_sort_chunks(RuntimeState* state) {
     size_t memory_in_use = sizeof(DataSegment) + _merged_segment.chunk->memory_usage();
     RETURN_IF_ERROR(_consume_and_check_memory_limit(state, memory_in_use - _last_memory_usage));
 
+    if (_runtime_predicate != nullptr) {
+        _update_runtime_predicate();
+    }
     return Status::OK();
 }
 
+bool ChunksSorterTopn::support_runtime_predicate(PrimitiveType type) {
+    switch (type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+    case TYPE_DECIMAL32:
+    case TYPE_DECIMAL64:
+    case TYPE_DECIMAL128:
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+template <PrimitiveType PT>
+static std::string value_to_condition_string(const Column* data_column, size_t row, const TypeDescriptor& type) {
+    const auto& value = down_cast<const RunTimeColumnType<PT>*>(data_column)->get_data()[row];
+    if constexpr (PT == TYPE_TINYINT) {
+        // int8_t is printed as a char.
+        return cast_to_string(static_cast<int32_t>(value));
+    } else if constexpr (PT == TYPE_CHAR || PT == TYPE_VARCHAR) {
+        return value.to_string();
+    } else {
+        return cast_to_string(value, PT, type.precision, type.scale);
+    }
+}
+
+void ChunksSorterTopn::_update_runtime_predicate() {
+    const size_t num_rows = _merged_segment.chunk->num_rows();
+    if (num_rows < _get_number_of_rows_to_sort()) {
+        return;
+    }
+    // The nulls are removed by the condition, so they must be ordered after the boundary.
+    if (_null_first_flag[0] != _sort_order_flag[0]) {
+        return;
+    }
+    const Column* column = _merged_segment.order_by_columns[0].get();
+    if (column->is_constant() || column->is_null(num_rows - 1)) {
+        return;
+    }
+
+    const Column* data_column = ColumnHelper::get_data_column(column);
+    const TypeDescriptor& type = (*_sort_exprs)[0]->root()->type();
+    TCondition condition;
+    condition.__set_column_name(_runtime_predicate->column_name());
+    // The rows equal to the boundary are kept, which might be ordered before it by the other order-by columns.
+    condition.__set_condition_op(_sort_order_flag[0] == 1 ? "<=" : ">=");
+    std::string value;
+    switch (type.type) {
+#define VALUE_TO_CONDITION_STRING(PT)                                           \
+    case PT:                                                                    \
+        value = value_to_condition_string<PT>(data_column, num_rows - 1, type); \
+        break;
+        VALUE_TO_CONDITION_STRING(TYPE_TINYINT)
+        VALUE_TO_CONDITION_STRING(TYPE_SMALLINT)
+        VALUE_TO_CONDITION_STRING(TYPE_INT)
+        VALUE_TO_CONDITION_STRING(TYPE_BIGINT)
+        VALUE_TO_CONDITION_STRING(TYPE_LARGEINT)
+        VALUE_TO_CONDITION_STRING(TYPE_DATE)
+        VALUE_TO_CONDITION_STRING(TYPE_DATETIME)
+        VALUE_TO_CONDITION_STRING(TYPE_DECIMAL32)
+        VALUE_TO_CONDITION_STRING(TYPE_DECIMAL64)
+        VALUE_TO_CONDITION_STRING(TYPE_DECIMAL128)
+        VALUE_TO_CONDITION_STRING(TYPE_CHAR)
+        VALUE_TO_CONDITION_STRING(TYPE_VARCHAR)
+#undef VALUE_TO_CONDITION_STRING
+    default:
+        return;
+    }
+    condition.condition_values.emplace_back(std::move(value));
+    _runtime_predicate->update(_runtime_predicate_producer, std::move(condition));
+}
+
 Status ChunksSorterTopn::_build_sorting_data(RuntimeState* state, Permutation& permutation_second,
                                              DataSegments& segments) {
     ScopedTimer<MonotonicStopWatch> timer(_build_timer);
@@ -5,6 +5,7 @@
 #include "column/vectorized_fwd.h"
 #include "exec/vectorized/chunks_sorter.h"
 #include "exprs/expr_context.h"
+#include "storage/vectorized/runtime_predicate.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks::vectorized {
@@ -30,7 +31,17 @@ public:
     // Finish seeding Chunk, and get sorted data with top OFFSET rows have been skipped.
     Status done(RuntimeState* state) override;
     // get_next only works after done().
-    void get_next(ChunkPtr* chunk, bool* eos) override;
+    Status get_next(ChunkPtr* chunk, bool* eos) override;
+
+    // Once offset + limit rows are kept, publish the value of the first order-by column of the last one as the
+    // condition of |producer| to |runtime_predicate| after every sort, no row worse than which could be output.
+    void set_runtime_predicate(RuntimePredicatePtr runtime_predicate, size_t producer) {
+        _runtime_predicate = std::move(runtime_predicate);
+        _runtime_predicate_producer = producer;
+    }
+
+    // Whether the first order-by column of |type| could be published to a RuntimePredicate.
+    static bool support_runtime_predicate(PrimitiveType type);
 
 private:
     inline size_t _get_number_of_rows_to_sort() const { return _offset + _limit; }
@@ -63,6 +74,8 @@ private:
     Status _merge_sort_data_as_merged_segment(RuntimeState* state, std::pair<Permutation, Permutation>& new_permutation,
                                               DataSegments& segments);
 
+    void _update_runtime_predicate();
+
     // buffer
 
     struct RawChunks {
@@ -82,6 +95,9 @@ private:
 
     bool _init_merged_segment;
     DataSegment _merged_segment;
+
+    RuntimePredicatePtr _runtime_predicate;
+    size_t _runtime_predicate_producer = 0;
 };
 
 } // namespace starrocks::vectorized
@@ -25,6 +25,7 @@ Status CrossJoinNode::prepare(RuntimeState* state) {
     _probe_rows_counter = ADD_COUNTER(runtime_profile(), "ProbeRows", TUnit::UNIT);
 
     _init_row_desc();
+    _init_block_nested_loop();
     return Status::OK();
 }
 
@@ -273,6 +274,17 @@ Status CrossJoinNode::get_next_internal(RuntimeState* state, ChunkPtr* chunk, bo
         return Status::OK();
     }
 
+    if (_block_nested_loop) {
+        RETURN_IF_ERROR(_get_next_matched_rows(state, chunk, probe_timer));
+        if (*chunk == nullptr) {
+            *eos = true;
+            return Status::OK();
+        }
+        _update_rows_returned(chunk);
+        *eos = false;
+        return Status::OK();
+    }
+
     for (;;) {
         // need to get probe_chunk
         if (_probe_chunk == nullptr || _probe_chunk->num_rows() == 0) {
@@ -391,6 +403,12 @@ Status CrossJoinNode::get_next_internal(RuntimeState* state, ChunkPtr* chunk, bo
         break;
     }
 
+    _update_rows_returned(chunk);
+    *eos = false;
+    return Status::OK();
+}
+
+void CrossJoinNode::_update_rows_returned(ChunkPtr* chunk) {
     _num_rows_returned += (*chunk)->num_rows();
     if (reached_limit()) {
         (*chunk)->set_num_rows((*chunk)->num_rows() - (_num_rows_returned - _limit));
@@ -402,8 +420,145 @@ Status CrossJoinNode::get_next_internal(RuntimeState* state, ChunkPtr* chunk, bo
 
     DCHECK(!(*chunk)->has_const_column());
     DCHECK_CHUNK(*chunk);
-    *eos = false;
-    return Status::OK();
+}
+
+/*
+Block nested loop join, used when there are conjuncts.
+
+The build rows are divided into blocks of vector_chunk_size rows, every block is joined with all the rows
+of probe_chunk before the next block. The joined rows are divided into tiles of at most vector_chunk_size
+rows, a tile only contains the columns referenced by the conjuncts, and the rows of a tile are recorded by
+the indexes of their probe and build rows.
+
+The conjuncts are evaluated on every tile, and the indexes of the matched rows are saved, which are copied
+into the output chunks with all the columns. So the unmatched joined rows are never materialized.
+*/
+Status CrossJoinNode::_get_next_matched_rows(RuntimeState* state, ChunkPtr* chunk,
+                                             ScopedTimer<MonotonicStopWatch>& probe_timer) {
+    for (;;) {
+        RETURN_IF_CANCELLED(state);
+
+        size_t num_matched_rows = _matched_probe_indexes.size() - _matched_index;
+        bool probe_chunk_done = _probe_chunk == nullptr || _block_start >= _number_of_build_rows;
+        if (num_matched_rows >= config::vector_chunk_size || (num_matched_rows > 0 && probe_chunk_done)) {
+            _copy_matched_rows(chunk);
+            return Status::OK();
+        }
+
+        if (probe_chunk_done) {
+            probe_timer.stop();
+            RETURN_IF_ERROR(_get_next_probe_chunk(state));
+            probe_timer.start();
+            if (_eos) {
+                return Status::OK();
+            }
+            // the matched rows are copied by indexes.
+            for (auto& column : _probe_chunk->columns()) {
+                column = ColumnHelper::unpack_and_duplicate_const_column(_probe_chunk->num_rows(), column);
+            }
+            _block_start = 0;
+            _block_probe_index = 0;
+            continue;
+        }
+
+        _probe_tile();
+    }
+}
+
+void CrossJoinNode::_probe_tile() {
+    const size_t probe_rows = _probe_chunk->num_rows();
+    const size_t block_end = std::min(_block_start + config::vector_chunk_size, _number_of_build_rows);
+    const size_t block_rows = block_end - _block_start;
+
+    // a tile contains the whole block for one or more probe rows.
+    _tile_probe_indexes.clear();
+    _tile_build_indexes.clear();
+    while (_block_probe_index < probe_rows && _tile_probe_indexes.size() + block_rows <= config::vector_chunk_size) {
+        _tile_probe_indexes.insert(_tile_probe_indexes.end(), block_rows, _block_probe_index);
+        for (size_t i = _block_start; i < block_end; i++) {
+            _tile_build_indexes.emplace_back(i);
+        }
+        ++_block_probe_index;
+    }
+    if (_block_probe_index == probe_rows) {
+        _block_start = block_end;
+        _block_probe_index = 0;
+    }
+
+    const size_t tile_rows = _tile_probe_indexes.size();
+    ChunkPtr tile = std::make_shared<Chunk>();
+    for (auto [slot_id, is_probe] : _conjunct_slots) {
+        const auto& indexes = is_probe ? _tile_probe_indexes : _tile_build_indexes;
+        ColumnPtr& src_col = (is_probe ? _probe_chunk : _build_chunk)->get_column_by_slot_id(slot_id);
+        ColumnPtr dest_col = src_col->clone_empty();
+        dest_col->append_selective(*src_col, indexes.data(), 0, tile_rows);
+        tile->append_column(std::move(dest_col), slot_id);
+    }
+    // the tuple columns are used by TupleIsNullPredicate.
+    for (int tuple_id : _output_probe_tuple_ids) {
+        if (_probe_chunk->is_tuple_exist(tuple_id)) {
+            ColumnPtr& src_col = _probe_chunk->get_tuple_column_by_id(tuple_id);
+            ColumnPtr dest_col = src_col->clone_empty();
+            dest_col->append_selective(*src_col, _tile_probe_indexes.data(), 0, tile_rows);
+            tile->append_tuple_column(dest_col, tuple_id);
+        }
+    }
+    for (int tuple_id : _output_build_tuple_ids) {
+        if (_build_chunk->is_tuple_exist(tuple_id)) {
+            ColumnPtr& src_col = _build_chunk->get_tuple_column_by_id(tuple_id);
+            ColumnPtr dest_col = src_col->clone_empty();
+            dest_col->append_selective(*src_col, _tile_build_indexes.data(), 0, tile_rows);
+            tile->append_tuple_column(dest_col, tuple_id);
+        }
+    }
+
+    FilterPtr filter;
+    ExecNode::eval_conjuncts(_conjunct_ctxs, tile.get(), &filter);
+    if (tile->num_rows() == 0) {
+        return;
+    }
+    for (size_t i = 0; i < tile_rows; i++) {
+        if ((*filter)[i]) {
+            _matched_probe_indexes.emplace_back(_tile_probe_indexes[i]);
+            _matched_build_indexes.emplace_back(_tile_build_indexes[i]);
+        }
+    }
+}
+
+void CrossJoinNode::_copy_matched_rows(ChunkPtr* chunk) {
+    const size_t row_count =
+            std::min<size_t>(config::vector_chunk_size, _matched_probe_indexes.size() - _matched_index);
+    _init_chunk(chunk);
+
+    for (size_t i = 0; i < _probe_column_count + _build_column_count; i++) {
+        SlotDescriptor* slot = _col_types[i];
+        bool is_probe = i < _probe_column_count;
+        const auto& indexes = is_probe ? _matched_probe_indexes : _matched_build_indexes;
+        ColumnPtr& dest_col = (*chunk)->get_column_by_slot_id(slot->id());
+        ColumnPtr& src_col = (is_probe ? _probe_chunk : _build_chunk)->get_column_by_slot_id(slot->id());
+        dest_col->append_selective(*src_col, indexes.data(), _matched_index, row_count);
+    }
+    for (int tuple_id : _output_probe_tuple_ids) {
+        if (_probe_chunk->is_tuple_exist(tuple_id)) {
+            ColumnPtr& src_col = _probe_chunk->get_tuple_column_by_id(tuple_id);
+            ColumnPtr& dest_col = (*chunk)->get_tuple_column_by_id(tuple_id);
+            dest_col->append_selective(*src_col, _matched_probe_indexes.data(), _matched_index, row_count);
+        }
+    }
+    for (int tuple_id : _output_build_tuple_ids) {
+        if (_build_chunk->is_tuple_exist(tuple_id)) {
+            ColumnPtr& src_col = _build_chunk->get_tuple_column_by_id(tuple_id);
+            ColumnPtr& dest_col = (*chunk)->get_tuple_column_by_id(tuple_id);
+            dest_col->append_selective(*src_col, _matched_build_indexes.data(), _matched_index, row_count);
+        }
+    }
+
+    _matched_index += row_count;
+    if (_matched_index == _matched_probe_indexes.size()) {
+        _matched_probe_indexes.clear();
+        _matched_build_indexes.clear();
+        _matched_index = 0;
+    }
 }
 
 Status CrossJoinNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
@@ -484,12 +639,42 @@ Status CrossJoinNode::_build(RuntimeState* state) {
     if (_build_chunk != nullptr) {
         _number_of_build_rows = _build_chunk->num_rows();
         _build_chunks_size = (_number_of_build_rows / config::vector_chunk_size) * config::vector_chunk_size;
+        if (_block_nested_loop) {
+            // the matched rows are copied by indexes.
+            for (auto& column : _build_chunk->columns()) {
+                column = ColumnHelper::unpack_and_duplicate_const_column(_number_of_build_rows, column);
+            }
+        }
     }
 
     RETURN_IF_ERROR(child(1)->close(state));
     return Status::OK();
 }
 
+void CrossJoinNode::_init_block_nested_loop() {
+    if (_conjunct_ctxs.empty()) {
+        return;
+    }
+    std::vector<SlotId> slot_ids;
+    for (auto* ctx : _conjunct_ctxs) {
+        ctx->root()->get_slot_ids(&slot_ids);
+    }
+    std::sort(slot_ids.begin(), slot_ids.end());
+    slot_ids.erase(std::unique(slot_ids.begin(), slot_ids.end()), slot_ids.end());
+
+    for (SlotId slot_id : slot_ids) {
+        auto iter = std::find_if(_col_types.begin(), _col_types.end(),
+                                 [slot_id](const SlotDescriptor* slot) { return slot->id() == slot_id; });
+        if (iter == _col_types.end()) {
+            // the conjuncts are evaluated on the joined rows then.
+            _conjunct_slots.clear();
+            return;
+        }
+        _conjunct_slots.emplace_back(slot_id, iter - _col_types.begin() < _probe_column_count);
+    }
+    _block_nested_loop = true;
+}
+
 void CrossJoinNode::_init_chunk(ChunkPtr* chunk) {
     ChunkPtr new_chunk = std::make_shared<Chunk>();
 
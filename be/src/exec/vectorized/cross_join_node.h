@@ -44,6 +44,13 @@ private:
 
     void _init_row_desc();
     void _init_chunk(ChunkPtr* chunk);
+    void _update_rows_returned(ChunkPtr* chunk);
+
+    // block nested loop join, see _get_next_matched_rows.
+    void _init_block_nested_loop();
+    Status _get_next_matched_rows(RuntimeState* state, ChunkPtr* chunk, ScopedTimer<MonotonicStopWatch>& probe_timer);
+    void _probe_tile();
+    void _copy_matched_rows(ChunkPtr* chunk);
 
     // previsou saved chunk.
     ChunkPtr _pre_output_chunk = nullptr;
@@ -84,5 +91,24 @@ private:
     RuntimeProfile::Counter* _probe_rows_counter = nullptr;
 
     std::vector<uint32_t> _buf_selective;
+
+    // With conjuncts, the conjuncts are evaluated on tiles of the joined rows which only contain the
+    // columns referenced by the conjuncts, and only the matched rows are copied into the output chunks,
+    // rather than materializing the whole cartesian product before filtering it.
+    bool _block_nested_loop = false;
+    // the slots referenced by the conjuncts, and whether each of them is from the probe side.
+    std::vector<std::pair<SlotId, bool>> _conjunct_slots;
+    // the build block [_block_start, _block_start + vector_chunk_size) is joined with the rows of
+    // _probe_chunk from _block_probe_index, and then the next build block, so that the build columns
+    // of a block are kept in the cache. _probe_chunk is done once _block_start reaches the build rows.
+    size_t _block_start = 0;
+    size_t _block_probe_index = 0;
+    // the probe and build rows of the current tile.
+    std::vector<uint32_t> _tile_probe_indexes;
+    std::vector<uint32_t> _tile_build_indexes;
+    // the matched rows of _probe_chunk not output yet, from _matched_index.
+    std::vector<uint32_t> _matched_probe_indexes;
+    std::vector<uint32_t> _matched_build_indexes;
+    size_t _matched_index = 0;
 };
 } // namespace starrocks::vectorized
@@ -2,6 +2,10 @@
 
 #include "exec/vectorized/csv_scanner.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "column/column_helper.h"
 #include "column/hash_set.h"
 #include "env/env.h"
@@ -12,26 +16,82 @@
 namespace starrocks::vectorized {
 
 /// CSVScanner::CSVReader
-Status CSVScanner::CSVReader::next_record(Record* record) {
+Status CSVScanner::CSVReader::next_record(Record* record, Fields* fields) {
     if (_limit > 0 && _parsed_bytes > _limit) {
         return Status::EndOfFile("Reached limit");
     }
-    char* d;
-    size_t pos = 0;
-    while ((d = _buff.find(_record_delimiter, pos)) == nullptr) {
-        pos = _buff.available();
+    const char* d;
+    while ((d = _find_delimiters(fields)) == nullptr) {
+        // The partial record is scanned again from its beginning once the buffer is refilled.
         _buff.compact();
         if (_buff.free_space() == 0) {
             RETURN_IF_ERROR(_expand_buffer());
         }
         RETURN_IF_ERROR(_fill_buffer());
     }
-    size_t l = d - _buff.position();
+    _consume_record(d, record);
+    return Status::OK();
+}
+
+bool CSVScanner::CSVReader::next_buffered_record(Record* record, Fields* fields) {
+    if (_limit > 0 && _parsed_bytes > _limit) {
+        return false;
+    }
+    const char* d = _find_delimiters(fields);
+    if (d == nullptr) {
+        return false;
+    }
+    _consume_record(d, record);
+    return true;
+}
+
+const char* CSVScanner::CSVReader::_find_delimiters(Fields* fields) {
+    fields->clear();
+    const char* p = _buff.position();
+    const char* end = _buff.limit();
+    const char* field = p;
+#ifdef __SSE2__
+    const __m128i field_delimiter = _mm_set1_epi8(_field_delimiter);
+    const __m128i record_delimiter = _mm_set1_epi8(_record_delimiter);
+    for (; p + 16 <= end; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        auto field_mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, field_delimiter)));
+        auto record_mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, record_delimiter)));
+        if (record_mask != 0) {
+            // Only the field delimiters before the record delimiter belong to this record.
+            field_mask &= (record_mask & -record_mask) - 1;
+        }
+        while (field_mask != 0) {
+            const char* d = p + __builtin_ctz(field_mask);
+            fields->emplace_back(field, d - field);
+            field = d + 1;
+            field_mask &= field_mask - 1;
+        }
+        if (record_mask != 0) {
+            const char* d = p + __builtin_ctz(record_mask);
+            fields->emplace_back(field, d - field);
+            return d;
+        }
+    }
+#endif
+    for (; p < end; ++p) {
+        if (*p == _record_delimiter) {
+            fields->emplace_back(field, p - field);
+            return p;
+        } else if (*p == _field_delimiter) {
+            fields->emplace_back(field, p - field);
+            field = p + 1;
+        }
+    }
+    return nullptr;
+}
+
+void CSVScanner::CSVReader::_consume_record(const char* record_delimiter, Record* record) {
+    size_t l = record_delimiter - _buff.position();
     *record = Record(_buff.position(), l);
     _buff.skip(l + 1);
     //               ^^ skip record delimiter.
     _parsed_bytes += l + 1;
-    return Status::OK();
 }
 
 Status CSVScanner::CSVReader::_fill_buffer() {
@@ -76,19 +136,6 @@ Status CSVScanner::CSVReader::_expand_buffer() {
     return Status::OK();
 }
 
-void CSVScanner::CSVReader::split_record(const Record& record, Fields* fields) const {
-    const char* value = record.data;
-    const char* ptr = record.data;
-    const size_t size = record.size;
-    for (size_t i = 0; i < size; ++i, ++ptr) {
-        if (*ptr == _field_delimiter) {
-            fields->emplace_back(value, ptr - value);
-            value = ptr + 1;
-        }
-    }
-    fields->emplace_back(value, ptr - value);
-}
-
 CSVScanner::CSVScanner(RuntimeState* state, RuntimeProfile* profile, const TBrokerScanRange& scan_range,
                        ScannerCounter* counter)
         : FileScanner(state, profile, scan_range.params, counter),
@@ -148,6 +195,7 @@ Status CSVScanner::open() {
         }
         _converters.emplace_back(std::move(conv));
     }
+    _column_fields.resize(_converters.size());
 
     return Status::OK();
 }
@@ -181,7 +229,8 @@ StatusOr<ChunkPtr> CSVScanner::get_next() {
                 // Skip the first record started from |start_offset|.
                 file->skip(_scan_range.ranges[_curr_file_index].start_offset);
                 CSVReader::Record dummy;
-                RETURN_IF_ERROR(_curr_reader->next_record(&dummy));
+                CSVReader::Fields dummy_fields;
+                RETURN_IF_ERROR(_curr_reader->next_record(&dummy, &dummy_fields));
             }
         } else if (_curr_reader == nullptr) {
             return Status::EndOfFile("CSVScanner");
@@ -216,22 +265,25 @@ Status CSVScanner::_parse_csv(Chunk* chunk) {
         _column_raw_ptrs[i] = chunk->get_column_by_index(i).get();
     }
 
-    csv::Converter::Options options{.invalid_field_as_null = !_strict_mode};
-
-    for (size_t num_rows = chunk->num_rows(); num_rows < capacity; /**/) {
-        status = _curr_reader->next_record(&record);
-        if (status.is_end_of_file()) {
-            break;
-        } else if (!status.ok()) {
-            return status;
-        } else if (record.empty()) {
+    // The records are split into fields first, and converted column by column once the chunk is full, or before the
+    // buffer of the reader is refilled, which the records point into.
+    while (chunk->num_rows() + _records.size() < capacity) {
+        if (_records.empty()) {
+            status = _curr_reader->next_record(&record, &fields);
+            if (status.is_end_of_file()) {
+                break;
+            } else if (!status.ok()) {
+                return status;
+            }
+        } else if (!_curr_reader->next_buffered_record(&record, &fields)) {
+            _convert_records(chunk);
+            continue;
+        }
+        if (record.empty()) {
             // always skip blank lines.
             continue;
         }
 
-        fields.clear();
-        _curr_reader->split_record(record, &fields);
-
         if (fields.size() != _num_fields_in_csv) {
             std::stringstream error_msg;
             error_msg << "column count mismatch, expect=" << _num_fields_in_csv << " real=" << fields.size();
@@ -247,27 +299,60 @@ Status CSVScanner::_parse_csv(Chunk* chunk) {
             continue;
         }
 
-        SCOPED_RAW_TIMER(&_counter->fill_ns);
-        bool has_error = false;
         for (int j = 0, k = 0; j < _num_fields_in_csv; j++) {
             if (_src_slot_descriptors[j] == nullptr) {
                 continue;
             }
-            const Slice& field = fields[j];
-            options.type_desc = &(_src_slot_descriptors[j]->type());
-            if (!_converters[k]->read_string(_column_raw_ptrs[k], field, options)) {
-                chunk->set_num_rows(num_rows);
+            _column_fields[k++].emplace_back(fields[j]);
+        }
+        _records.emplace_back(record);
+    }
+    _convert_records(chunk);
+    return chunk->num_rows() > 0 ? Status::OK() : Status::EndOfFile("");
+}
+
+void CSVScanner::_convert_records(Chunk* chunk) {
+    if (_records.empty()) {
+        return;
+    }
+    SCOPED_RAW_TIMER(&_counter->fill_ns);
+    const size_t num_rows = chunk->num_rows();
+    const size_t num_records = _records.size();
+    csv::Converter::Options options{.invalid_field_as_null = !_strict_mode};
+    _selection.assign(num_rows + num_records, 1);
+    bool has_error = false;
+    for (int j = 0, k = 0; j < _num_fields_in_csv; j++) {
+        if (_src_slot_descriptors[j] == nullptr) {
+            continue;
+        }
+        options.type_desc = &(_src_slot_descriptors[j]->type());
+        const csv::Converter* converter = _converters[k].get();
+        Column* column = _column_raw_ptrs[k];
+        const CSVReader::Fields& column_fields = _column_fields[k];
+        for (size_t i = 0; i < num_records; i++) {
+            if (LIKELY(converter->read_string(column, column_fields[i], options))) {
+                continue;
+            }
+            // Keep the column aligned with the others, the record is filtered out of all the columns at last.
+            column->resize(num_rows + i);
+            column->append_nulls(1);
+            if (_selection[num_rows + i] != 0) {
+                _selection[num_rows + i] = 0;
+                has_error = true;
                 if (_counter->num_rows_filtered++ < 50) {
-                    _report_error(record.to_string(), "invalid value '" + field.to_string() + "'");
+                    _report_error(_records[i].to_string(), "invalid value '" + column_fields[i].to_string() + "'");
                 }
-                has_error = true;
-                break;
             }
-            k++;
         }
-        num_rows += !has_error;
+        k++;
+    }
+    if (has_error) {
+        chunk->filter_range(_selection, num_rows, num_rows + num_records);
+    }
+    _records.clear();
+    for (auto& column_fields : _column_fields) {
+        column_fields.clear();
     }
-    return chunk->num_rows() > 0 ? Status::OK() : Status::EndOfFile("");
 }
 
 ChunkPtr CSVScanner::_create_chunk(const std::vector<SlotDescriptor*>& slots) {
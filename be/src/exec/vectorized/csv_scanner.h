@@ -97,15 +97,23 @@ private:
                   _storage(kMinBufferSize),
                   _buff(_storage.data(), _storage.size()) {}
 
-        Status next_record(Record* record);
+        // Reads the next record and the fields of it, refilling the buffer if it has no whole record left.
+        Status next_record(Record* record, Fields* fields);
 
-        void set_limit(size_t limit) { _limit = limit; }
+        // Like next_record(), but returns false instead of refilling the buffer, or if the limit is reached, so that
+        // the records read before, which point into the buffer, stay valid.
+        bool next_buffered_record(Record* record, Fields* fields);
 
-        void split_record(const Record& record, Fields* fields) const;
+        void set_limit(size_t limit) { _limit = limit; }
 
         void set_counter(ScannerCounter* counter) { _counter = counter; }
 
     private:
+        // Finds the field delimiters and the record delimiter of the record at the position of the buffer in one
+        // pass, and returns the record delimiter, or nullptr if the buffer ends before it.
+        const char* _find_delimiters(Fields* fields);
+        void _consume_record(const char* record_delimiter, Record* record);
+
         Status _expand_buffer();
         Status _fill_buffer();
 
@@ -122,6 +130,8 @@ private:
     ChunkPtr _create_chunk(const std::vector<SlotDescriptor*>& slots);
 
     Status _parse_csv(Chunk* chunk);
+    // Converts the fields of the records read into |chunk| column by column.
+    void _convert_records(Chunk* chunk);
     ChunkPtr _materialize(ChunkPtr& src_chunk);
     void _report_error(const std::string& line, const std::string& err_msg);
 
@@ -136,6 +146,11 @@ private:
     int _curr_file_index = -1;
     CSVReaderPtr _curr_reader;
     std::vector<ConverterPtr> _converters;
+
+    // The records read but not converted yet, and their fields by column, of the columns not ignored.
+    std::vector<CSVReader::Record> _records;
+    std::vector<CSVReader::Fields> _column_fields;
+    Column::Filter _selection;
 };
 
 } // namespace starrocks::vectorized
@@ -3,6 +3,11 @@
 #include "exec/vectorized/except_node.h"
 
 #include "column/column_helper.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/set/except_build_sink_operator.h"
+#include "exec/pipeline/set/except_output_source_operator.h"
+#include "exec/pipeline/set/except_probe_sink_operator.h"
 #include "exprs/expr.h"
 #include "runtime/runtime_state.h"
 
@@ -23,6 +28,7 @@ Status ExceptNode::init(const TPlanNode& tnode, RuntimeState* state) {
         RETURN_IF_ERROR(Expr::create_expr_trees(_pool, texprs, &ctxs));
         _child_expr_lists.push_back(ctxs);
     }
+    _child_texpr_lists = result_texpr_lists;
     return Status::OK();
 }
 
@@ -208,4 +214,44 @@ Status ExceptNode::close(RuntimeState* state) {
     return ExecNode::close(state);
 }
 
+pipeline::OpFactories ExceptNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    // The rows of every child are shuffled by its result exprs, so each driver sequence owns one partition
+    // of the keys, and the partitions are built, probed and output by multiple drivers in parallel.
+    ExceptPartitionContextFactoryPtr except_partition_ctx_factory =
+            std::make_shared<ExceptPartitionContextFactory>(_tuple_id, _children.size() - 1);
+
+    OpFactories operators_with_build_sink = child(0)->decompose_to_pipeline(context);
+    operators_with_build_sink =
+            context->maybe_interpolate_local_shuffle_exchange(operators_with_build_sink, _child_expr_lists[0]);
+    const size_t degree_of_parallelism = context->source_operator(operators_with_build_sink)->degree_of_parallelism();
+    operators_with_build_sink.emplace_back(std::make_shared<ExceptBuildSinkOperatorFactory>(
+            context->next_operator_id(), id(), except_partition_ctx_factory, _child_texpr_lists[0]));
+    context->add_pipeline(operators_with_build_sink);
+
+    for (size_t i = 1; i < _children.size(); ++i) {
+        OpFactories operators_with_probe_sink = child(i)->decompose_to_pipeline(context);
+        operators_with_probe_sink =
+                context->maybe_interpolate_local_shuffle_exchange(operators_with_probe_sink, _child_expr_lists[i]);
+        // The probe sink operator must share the ExceptContext with the build sink operator of the same partition.
+        DCHECK_EQ(degree_of_parallelism, context->source_operator(operators_with_probe_sink)->degree_of_parallelism());
+        operators_with_probe_sink.emplace_back(std::make_shared<ExceptProbeSinkOperatorFactory>(
+                context->next_operator_id(), id(), except_partition_ctx_factory, _child_texpr_lists[i], i));
+        context->add_pipeline(operators_with_probe_sink);
+    }
+
+    OpFactories operators_with_output_source;
+    auto output_source = std::make_shared<ExceptOutputSourceOperatorFactory>(context->next_operator_id(), id(),
+                                                                             except_partition_ctx_factory);
+    output_source->set_degree_of_parallelism(degree_of_parallelism);
+    operators_with_output_source.emplace_back(std::move(output_source));
+    if (limit() != -1) {
+        operators_with_output_source =
+                context->maybe_interpolate_local_passthrough_exchange(operators_with_output_source);
+        operators_with_output_source.emplace_back(
+                std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return operators_with_output_source;
+}
+
 } // namespace starrocks::vectorized
@@ -6,6 +6,7 @@
 #include <sstream>
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "env/compressed_file.h"
 #include "env/env.h"
@@ -20,7 +21,10 @@
 #include "runtime/exec_env.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "util/load_stage_metrics.h"
 #include "util/runtime_profile.h"
+#include "util/uid_util.h"
 
 namespace starrocks::vectorized {
 
@@ -81,6 +85,9 @@ Status FileScanNode::open(RuntimeState* state) {
 }
 
 Status FileScanNode::start_scanners() {
+    if (can_split_scan_ranges()) {
+        return start_split_scanners();
+    }
     {
         std::unique_lock<std::mutex> l(_chunk_queue_lock);
 
@@ -135,6 +142,9 @@ Status FileScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
             mem_tracker()->release(temp_chunk->memory_usage());
         }
     }
+    if (_split_source != nullptr) {
+        _split_cond.notify_all();
+    }
 
     // All scanner has been finished, and all cached batch has been read
     if (temp_chunk == nullptr) {
@@ -176,6 +186,11 @@ Status FileScanNode::close(RuntimeState* state) {
     _scan_finished.store(true);
     _queue_writer_cond.notify_all();
     _queue_reader_cond.notify_all();
+    if (_split_source != nullptr) {
+        // Wake up the split worker if it is waiting for the body.
+        _split_source->cancel();
+        _split_cond.notify_all();
+    }
     for (int i = 0; i < _scanner_threads.size(); ++i) {
         _scanner_threads[i].join();
     }
@@ -184,6 +199,9 @@ Status FileScanNode::close(RuntimeState* state) {
         mem_tracker()->release(_chunk_queue.front()->memory_usage());
         _chunk_queue.pop_front();
     }
+    if (_scanner_total_timer != nullptr) {
+        LoadStageMetrics::add(LoadStageMetrics::PARSE, _scanner_total_timer->value());
+    }
 
     return ExecNode::close(state);
 }
@@ -307,18 +325,7 @@ void FileScanNode::scanner_worker(int start_idx, int length) {
             }
         }
 
-        // Update stats
-        _runtime_state->update_num_rows_load_filtered(counter.num_rows_filtered);
-        _runtime_state->update_num_rows_load_unselected(counter.num_rows_unselected);
-
-        COUNTER_UPDATE(_scanner_total_timer, counter.total_ns);
-        COUNTER_UPDATE(_scanner_fill_timer, counter.fill_ns);
-        COUNTER_UPDATE(_scanner_read_timer, counter.read_batch_ns);
-        COUNTER_UPDATE(_scanner_cast_chunk_timer, counter.cast_chunk_ns);
-        COUNTER_UPDATE(_scanner_materialize_timer, counter.materialize_ns);
-        COUNTER_UPDATE(_scanner_init_chunk_timer, counter.init_chunk_ns);
-
-        COUNTER_UPDATE(_scanner_file_reader_timer, counter.file_read_ns);
+        update_scanner_counters(counter);
     }
 
     // scanner is going to finish
@@ -338,4 +345,234 @@ void FileScanNode::scanner_worker(int start_idx, int length) {
     Expr::close(scanner_expr_ctxs, _runtime_state);
 }
 
+void FileScanNode::update_scanner_counters(const ScannerCounter& counter) {
+    // Update stats
+    _runtime_state->update_num_rows_load_filtered(counter.num_rows_filtered);
+    _runtime_state->update_num_rows_load_unselected(counter.num_rows_unselected);
+    _runtime_state->update_load_stage_ns(LoadStageMetrics::PARSE, counter.total_ns);
+
+    COUNTER_UPDATE(_scanner_total_timer, counter.total_ns);
+    COUNTER_UPDATE(_scanner_fill_timer, counter.fill_ns);
+    COUNTER_UPDATE(_scanner_read_timer, counter.read_batch_ns);
+    COUNTER_UPDATE(_scanner_cast_chunk_timer, counter.cast_chunk_ns);
+    COUNTER_UPDATE(_scanner_materialize_timer, counter.materialize_ns);
+    COUNTER_UPDATE(_scanner_init_chunk_timer, counter.init_chunk_ns);
+
+    COUNTER_UPDATE(_scanner_file_reader_timer, counter.file_read_ns);
+}
+
+bool FileScanNode::can_split_scan_ranges() const {
+    if (config::stream_load_parse_threads <= 1 || _scan_ranges.size() != 1) {
+        return false;
+    }
+    const TBrokerScanRange& scan_range = _scan_ranges[0].scan_range.broker_scan_range;
+    if (scan_range.ranges.size() != 1) {
+        return false;
+    }
+    const TBrokerRangeDesc& range_desc = scan_range.ranges[0];
+    return range_desc.file_type == TFileType::FILE_STREAM &&
+           range_desc.format_type == TFileFormatType::FORMAT_CSV_PLAIN;
+}
+
+Status FileScanNode::start_split_scanners() {
+    const TBrokerRangeDesc& range_desc = _scan_ranges[0].scan_range.broker_scan_range.ranges[0];
+    _split_source = _runtime_state->exec_env()->load_stream_mgr()->get(range_desc.load_id);
+    if (_split_source == nullptr) {
+        std::stringstream ss;
+        ss << "Invalid or outdated load id ";
+        range_desc.load_id.printTo(ss);
+        return Status::InternalError(std::string(ss.str()));
+    }
+
+    int num_threads = config::stream_load_parse_threads;
+    std::unique_lock<std::mutex> l(_chunk_queue_lock);
+    _max_pending_splits = 2 * num_threads;
+    _num_running_scanners = num_threads;
+    _scanner_threads.emplace_back(&FileScanNode::split_worker, this);
+    for (int i = 0; i < num_threads; i++) {
+        _scanner_threads.emplace_back(&FileScanNode::split_scanner_worker, this);
+    }
+    return Status::OK();
+}
+
+void FileScanNode::split_worker() {
+    const char record_delimiter = _scan_ranges[0].scan_range.broker_scan_range.params.row_delimiter;
+    const size_t split_size = std::max<int64_t>(config::stream_load_split_size, 1);
+    Status status;
+    ByteBufferPtr tail;
+    bool eof = false;
+    while (!eof) {
+        // A split grows until it holds a whole record if the record is longer than it.
+        size_t carried = tail == nullptr ? 0 : tail->remaining();
+        ByteBufferPtr split = ByteBuffer::allocate(std::max(split_size, carried * 2));
+        if (carried > 0) {
+            split->put_bytes(tail->ptr + tail->pos, carried);
+            tail.reset();
+        }
+        size_t n = split->capacity - split->pos;
+        status = _split_source->read(reinterpret_cast<uint8_t*>(split->ptr + split->pos), &n, &eof);
+        if (!status.ok()) {
+            break;
+        }
+        split->pos += n;
+        split->flip();
+        if (!eof) {
+            // The split ends at its last record delimiter, the bytes after which begin the next split.
+            auto last = static_cast<const char*>(memrchr(split->ptr, record_delimiter, split->limit));
+            size_t split_end = last == nullptr ? 0 : last - split->ptr + 1;
+            if (split_end < split->limit) {
+                tail = ByteBuffer::allocate(split->limit - split_end);
+                tail->put_bytes(split->ptr + split_end, split->limit - split_end);
+                tail->flip();
+                split->limit = split_end;
+            }
+        }
+        if (split->limit == 0) {
+            continue;
+        }
+
+        {
+            std::unique_lock<std::mutex> l(_chunk_queue_lock);
+            while (_process_status.ok() && !_scan_finished.load() && !_runtime_state->is_cancelled() &&
+                   _pending_splits.size() >= _max_pending_splits) {
+                _split_cond.wait_for(l, std::chrono::seconds(1));
+            }
+            if (!_process_status.ok() || _scan_finished.load()) {
+                break;
+            }
+            if (_runtime_state->is_cancelled()) {
+                status = Status::Cancelled("Cancelled FileScanNode::split_worker");
+                break;
+            }
+            _pending_splits.emplace_back(_num_splits++, std::move(split));
+        }
+        _split_cond.notify_all();
+    }
+    // Like StreamPipeSequentialFile, the consumer closes the pipe once it is done.
+    _split_source->close();
+
+    {
+        std::lock_guard<std::mutex> l(_chunk_queue_lock);
+        if (!status.ok()) {
+            LOG(WARNING) << "FileScanNode split stream load body failed. status=" << status.get_error_msg();
+            update_status(status);
+        }
+        _splits_finished = true;
+    }
+    _split_cond.notify_all();
+    _queue_reader_cond.notify_all();
+}
+
+void FileScanNode::split_scanner_worker() {
+    // Clone expr context
+    std::vector<ExprContext*> scanner_expr_ctxs;
+    auto status = Expr::clone_if_not_exists(_conjunct_ctxs, _runtime_state, &scanner_expr_ctxs);
+    if (!status.ok()) {
+        LOG(WARNING) << "Clone conjuncts failed.";
+    } else {
+        ScannerCounter counter;
+        while (status.ok()) {
+            int64_t seq = 0;
+            ByteBufferPtr split;
+            {
+                std::unique_lock<std::mutex> l(_chunk_queue_lock);
+                while (_process_status.ok() && !_scan_finished.load() && !_runtime_state->is_cancelled() &&
+                       ((_pending_splits.empty() && !_splits_finished) || _chunk_queue.size() >= _max_queue_size)) {
+                    _split_cond.wait_for(l, std::chrono::seconds(1));
+                }
+                if (!_process_status.ok() || _scan_finished.load() || _pending_splits.empty()) {
+                    break;
+                }
+                if (_runtime_state->is_cancelled()) {
+                    status = Status::Cancelled("Cancelled FileScanNode::split_scanner_worker");
+                    break;
+                }
+                seq = _pending_splits.front().first;
+                split = std::move(_pending_splits.front().second);
+                _pending_splits.pop_front();
+            }
+            _split_cond.notify_all();
+            status = split_scan(seq, split, scanner_expr_ctxs, &counter);
+            if (!status.ok()) {
+                LOG(WARNING) << "FileScanner of split " << seq << " process failed. status=" << status.get_error_msg();
+            }
+        }
+        update_scanner_counters(counter);
+    }
+
+    // scanner is going to finish
+    {
+        std::lock_guard<std::mutex> l(_chunk_queue_lock);
+        if (!status.ok()) {
+            update_status(status);
+        }
+        // This scanner will finish
+        _num_running_scanners--;
+    }
+    _queue_reader_cond.notify_all();
+    // If one scanner failed, others don't need scan any more
+    if (!status.ok()) {
+        _queue_writer_cond.notify_all();
+        _split_cond.notify_all();
+    }
+    Expr::close(scanner_expr_ctxs, _runtime_state);
+}
+
+Status FileScanNode::split_scan(int64_t seq, const ByteBufferPtr& split,
+                                const std::vector<ExprContext*>& conjunct_ctxs, ScannerCounter* counter) {
+    // The split is read by a scanner of its own through a pipe of its own.
+    auto pipe = std::make_shared<StreamLoadPipe>();
+    RETURN_IF_ERROR(pipe->append(split));
+    RETURN_IF_ERROR(pipe->finish());
+    UniqueId load_id = UniqueId::gen_uid();
+    LoadStreamMgr* load_stream_mgr = _runtime_state->exec_env()->load_stream_mgr();
+    RETURN_IF_ERROR(load_stream_mgr->put(load_id, pipe));
+
+    TBrokerScanRange scan_range(_scan_ranges[0].scan_range.broker_scan_range);
+    scan_range.ranges[0].__set_load_id(load_id.to_thrift());
+    scan_range.ranges[0].__set_start_offset(0);
+    scan_range.ranges[0].__set_size(-1);
+
+    std::vector<ChunkPtr> chunks;
+    std::unique_ptr<FileScanner> scanner = create_scanner(scan_range, counter);
+    Status status = scanner->open();
+    while (status.ok() && !_scan_finished.load()) {
+        auto res = scanner->get_next();
+        if (!res.ok()) {
+            status = res.status();
+            break;
+        }
+        ChunkPtr temp_chunk = std::move(res.value());
+
+        // eval conjuncts
+        size_t before = temp_chunk->num_rows();
+        eval_conjuncts(conjunct_ctxs, temp_chunk.get());
+        counter->num_rows_unselected += (before - temp_chunk->num_rows());
+        if (temp_chunk->num_rows() > 0) {
+            chunks.emplace_back(std::move(temp_chunk));
+        }
+    }
+    // The pipe is left in the manager if the scanner failed before opening it.
+    load_stream_mgr->remove(load_id);
+    if (!status.ok() && !status.is_end_of_file()) {
+        return status;
+    }
+
+    // Queue the chunks of all the splits parsed up to the first one still being parsed.
+    {
+        std::lock_guard<std::mutex> l(_chunk_queue_lock);
+        _parsed_splits.emplace(seq, std::move(chunks));
+        for (auto it = _parsed_splits.begin(); it != _parsed_splits.end() && it->first == _next_queued_split;
+             it = _parsed_splits.erase(it)) {
+            for (auto& chunk : it->second) {
+                mem_tracker()->consume(chunk->memory_usage());
+                _chunk_queue.push_back(std::move(chunk));
+            }
+            _next_queued_split++;
+        }
+    }
+    _queue_reader_cond.notify_all();
+    return Status::OK();
+}
+
 } // namespace starrocks::vectorized
@@ -14,6 +14,7 @@
 #include "common/status.h"
 #include "exec/decompressor.h"
 #include "exec/scan_node.h"
+#include "util/byte_buffer.h"
 #include "exec/vectorized/file_scanner.h"
 #include "gen_cpp/InternalService_types.h"
 
@@ -26,6 +27,7 @@ class RandomAccessFile;
 struct ScannerCounter;
 class SequentialFile;
 class RandomAccessFile;
+class StreamLoadPipe;
 
 namespace vectorized {
 
@@ -81,6 +83,18 @@ private:
 
     std::unique_ptr<FileScanner> create_scanner(const TBrokerScanRange& scan_range, ScannerCounter* counter);
 
+    void update_scanner_counters(const ScannerCounter& counter);
+
+    // The body of a CSV stream load, which is the only scan range, is cut at the record delimiters into splits by
+    // split_worker, and the splits are parsed by several split_scanner_workers, while their chunks are queued in the
+    // order of the splits, so that the order of the rows is kept as if it was parsed by one thread.
+    bool can_split_scan_ranges() const;
+    Status start_split_scanners();
+    void split_worker();
+    void split_scanner_worker();
+    Status split_scan(int64_t seq, const ByteBufferPtr& split, const std::vector<ExprContext*>& conjunct_ctxs,
+                      ScannerCounter* counter);
+
 private:
     TupleId _tuple_id;
     RuntimeState* _runtime_state;
@@ -103,6 +117,17 @@ private:
 
     std::vector<std::thread> _scanner_threads;
 
+    // The splits of the stream load body waiting to be parsed, and the chunks of the ones parsed before the splits
+    // ahead of them, indexed by the sequence of the splits. Guarded by _chunk_queue_lock.
+    std::shared_ptr<StreamLoadPipe> _split_source;
+    std::condition_variable _split_cond;
+    std::deque<std::pair<int64_t, ByteBufferPtr>> _pending_splits;
+    size_t _max_pending_splits = 0;
+    int64_t _num_splits = 0;
+    bool _splits_finished = false;
+    std::map<int64_t, std::vector<ChunkPtr>> _parsed_splits;
+    int64_t _next_queued_split = 0;
+
     // Profile information
     RuntimeProfile::Counter* _wait_scanner_timer = nullptr;
     RuntimeProfile::Counter* _scanner_total_timer = nullptr;
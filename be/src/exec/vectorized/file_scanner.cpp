@@ -4,6 +4,7 @@
 
 #include "column/column_helper.h"
 #include "column/hash_set.h"
+#include "common/config.h"
 #include "env/compressed_file.h"
 #include "env/env.h"
 #include "env/env_broker.h"
@@ -279,7 +280,13 @@ Status FileScanner::create_sequential_file(const TBrokerRangeDesc& range_desc, c
     using DecompressorPtr = std::shared_ptr<Decompressor>;
     Decompressor* dec = nullptr;
     RETURN_IF_ERROR(Decompressor::create_decompressor(compression, &dec));
-    *file = std::make_shared<CompressedSequentialFile>(std::move(src_file), DecompressorPtr(dec));
+    auto compressed_file = std::make_shared<CompressedSequentialFile>(std::move(src_file), DecompressorPtr(dec));
+    if (config::compressed_file_read_ahead_buffers > 0) {
+        *file = std::make_shared<ReadAheadSequentialFile>(std::move(compressed_file),
+                                                          config::compressed_file_read_ahead_buffers);
+    } else {
+        *file = std::move(compressed_file);
+    }
     return Status::OK();
 }
 
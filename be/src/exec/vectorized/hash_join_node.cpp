@@ -9,6 +9,10 @@
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
 #include "column/vectorized_fwd.h"
+#include "exec/pipeline/hash_join/hash_join_build_operator.h"
+#include "exec/pipeline/hash_join/hash_join_probe_operator.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
 #include "exprs/expr.h"
 #include "exprs/in_predicate.h"
 #include "exprs/vectorized/column_ref.h"
@@ -21,7 +25,7 @@
 namespace starrocks::vectorized {
 
 HashJoinNode::HashJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
-        : ExecNode(pool, tnode, descs), _join_type(tnode.hash_join_node.join_op) {
+        : ExecNode(pool, tnode, descs), _tnode(tnode), _join_type(tnode.hash_join_node.join_op) {
     _is_push_down = tnode.hash_join_node.is_push_down;
     if (_join_type == TJoinOp::LEFT_ANTI_JOIN && tnode.hash_join_node.is_rewritten_from_not_in) {
         _join_type = TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN;
@@ -96,6 +100,8 @@ Status HashJoinNode::prepare(RuntimeState* state) {
     _push_down_expr_num = ADD_COUNTER(_runtime_profile, "PushDownExprNum", TUnit::UNIT);
     _avg_input_probe_chunk_size = ADD_COUNTER(_runtime_profile, "AvgInputProbeChunkSize", TUnit::UNIT);
     _avg_output_chunk_size = ADD_COUNTER(_runtime_profile, "AvgOutputChunkSize", TUnit::UNIT);
+    _spill_timer = ADD_TIMER(_runtime_profile, "SpillTime");
+    _spilled_partitions_counter = ADD_COUNTER(_runtime_profile, "SpilledPartitions", TUnit::UNIT);
     _runtime_profile->add_info_string("JoinType", _get_join_type_str(_join_type));
 
     RETURN_IF_ERROR(Expr::prepare(_build_expr_ctxs, state, child(1)->row_desc(), expr_mem_tracker()));
@@ -127,6 +133,9 @@ void HashJoinNode::_init_hash_table_param(HashTableParam* param) {
     for (auto i = 0; i < _probe_expr_ctxs.size(); i++) {
         param->join_keys.emplace_back(JoinKeyDesc{_probe_expr_ctxs[i]->root()->type().type, _is_null_safes[i]});
     }
+    for (auto* build_expr_ctx : _build_expr_ctxs) {
+        build_expr_ctx->root()->get_slot_ids(&param->build_key_slot_ids);
+    }
 }
 
 Status HashJoinNode::open(RuntimeState* state) {
@@ -167,11 +176,29 @@ Status HashJoinNode::open(RuntimeState* state) {
             return Status::NotSupported(strings::Substitute("row count of right table in hash join > $0", UINT32_MAX));
         }
 
+        if (_spiller != nullptr) {
+            SCOPED_TIMER(_spill_timer);
+            RETURN_IF_ERROR(_spiller->spill_build_chunk(chunk));
+            continue;
+        }
+
         {
             // copy chunk of right table
             SCOPED_TIMER(_copy_right_table_chunk_timer);
             RETURN_IF_ERROR(_ht.append_chunk(state, chunk));
         }
+        if (_need_spill(state)) {
+            RETURN_IF_ERROR(_spill_hash_table(state, 0));
+        }
+    }
+    state->spill_coordinator()->finish(_mem_tracker.get());
+
+    if (_spiller != nullptr) {
+        // The runtime filters aren't built, because the build rows are spilled rather than in the
+        // hash table. The probe rows are spilled by the first get_next.
+        build_timer.stop();
+        RETURN_IF_ERROR(child(0)->open(state));
+        return Status::OK();
     }
 
     {
@@ -256,53 +283,38 @@ Status HashJoinNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
         return Status::OK();
     }
 
+    if (_spiller != nullptr) {
+        // all the build rows have been spilled, spill the probe rows and join the first partition.
+        RETURN_IF_ERROR(_spill_probe_side(state));
+        bool has_next = false;
+        RETURN_IF_ERROR(_open_next_spilled_partition(state, &has_next));
+        if (!has_next) {
+            _eos = true;
+            *eos = true;
+            _final_update_profile();
+            return Status::OK();
+        }
+    }
+
     *chunk = std::make_shared<Chunk>();
 
-    bool tmp_eos = false;
-    if (!_probe_eos || _ht_has_remain) {
-        RETURN_IF_ERROR(_probe(state, probe_timer, chunk, tmp_eos));
-        if (tmp_eos) {
-            if (_join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
-                _join_type == TJoinOp::FULL_OUTER_JOIN) {
-                // fetch the remain data of hash table
-                RETURN_IF_ERROR(_probe_remain(chunk, tmp_eos));
-                if (tmp_eos) {
-                    _eos = true;
-                    *eos = true;
-                    _final_update_profile();
-                    return Status::OK();
-                }
-            } else {
-                _eos = true;
-                *eos = true;
-                _final_update_profile();
-                return Status::OK();
-            }
+    while (true) {
+        bool ht_eos = false;
+        RETURN_IF_ERROR(_get_next_from_ht(state, probe_timer, chunk, &ht_eos));
+        if (!ht_eos) {
+            break;
         }
-    } else {
-        if (!_build_eos) {
-            if (_join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
-                _join_type == TJoinOp::FULL_OUTER_JOIN) {
-                // fetch the remain data of hash table
-                RETURN_IF_ERROR(_probe_remain(chunk, tmp_eos));
-                if (tmp_eos) {
-                    _eos = true;
-                    *eos = true;
-                    _final_update_profile();
-                    return Status::OK();
-                }
-            } else {
-                _eos = true;
-                *eos = true;
-                _final_update_profile();
-                return Status::OK();
-            }
-        } else {
+        bool has_next = false;
+        if (_is_spilled) {
+            RETURN_IF_ERROR(_open_next_spilled_partition(state, &has_next));
+        }
+        if (!has_next) {
             _eos = true;
             *eos = true;
             _final_update_profile();
             return Status::OK();
         }
+        *chunk = std::make_shared<Chunk>();
     }
 
     DCHECK_LE((*chunk)->num_rows(), config::vector_chunk_size);
@@ -324,6 +336,33 @@ Status HashJoinNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
     return Status::OK();
 }
 
+Status HashJoinNode::_get_next_from_ht(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& probe_timer,
+                                       ChunkPtr* chunk, bool* ht_eos) {
+    *ht_eos = false;
+    bool tmp_eos = false;
+    bool is_right_join = _join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
+                         _join_type == TJoinOp::FULL_OUTER_JOIN;
+    if (!_probe_eos || _ht_has_remain) {
+        RETURN_IF_ERROR(_probe(state, probe_timer, chunk, tmp_eos));
+        if (tmp_eos) {
+            if (is_right_join) {
+                // fetch the remain data of hash table
+                RETURN_IF_ERROR(_probe_remain(chunk, tmp_eos));
+                *ht_eos = tmp_eos;
+            } else {
+                *ht_eos = true;
+            }
+        }
+    } else if (!_build_eos && is_right_join) {
+        // fetch the remain data of hash table
+        RETURN_IF_ERROR(_probe_remain(chunk, tmp_eos));
+        *ht_eos = tmp_eos;
+    } else {
+        *ht_eos = true;
+    }
+    return Status::OK();
+}
+
 Status HashJoinNode::close(RuntimeState* state) {
     if (is_closed()) {
         return Status::OK();
@@ -334,10 +373,44 @@ Status HashJoinNode::close(RuntimeState* state) {
     Expr::close(_other_join_conjunct_ctxs, state);
 
     _ht.close();
+    state->spill_coordinator()->finish(_mem_tracker.get());
+    _spiller.reset();
+    _spilled_partitions.clear();
+    _probing_partition = SpilledJoinPartition();
 
     return ExecNode::close(state);
 }
 
+pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    // The hash table is built only once by a single driver for the fragment instance,
+    // and then shared read-only by all the drivers of the probe pipeline.
+    OpFactories build_operators = _children[1]->decompose_to_pipeline(context);
+    build_operators = context->maybe_interpolate_local_passthrough_exchange(build_operators);
+    OpFactories probe_operators = _children[0]->decompose_to_pipeline(context);
+    // Right joins record which build rows are matched in the state of the prober,
+    // so they must be probed by a single driver.
+    if (_join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_SEMI_JOIN ||
+        _join_type == TJoinOp::RIGHT_ANTI_JOIN || _join_type == TJoinOp::FULL_OUTER_JOIN) {
+        probe_operators = context->maybe_interpolate_local_passthrough_exchange(probe_operators);
+    }
+
+    // shared by build operator and probe operators
+    HashJoinerFactoryPtr hash_joiner_factory = std::make_shared<HashJoinerFactory>(
+            _tnode, _row_descriptor, child(1)->row_desc(), child(0)->row_desc());
+    build_operators.emplace_back(
+            std::make_shared<HashJoinBuildOperatorFactory>(context->next_operator_id(), id(), hash_joiner_factory));
+    context->add_pipeline(build_operators);
+
+    probe_operators.emplace_back(
+            std::make_shared<HashJoinProbeOperatorFactory>(context->next_operator_id(), id(), hash_joiner_factory));
+    if (limit() != -1) {
+        probe_operators.emplace_back(
+                std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return probe_operators;
+}
+
 bool HashJoinNode::_has_null(const ColumnPtr& column) {
     if (column->is_nullable()) {
         const auto& null_column = ColumnHelper::as_raw_column<NullableColumn>(column)->null_column();
@@ -375,6 +448,156 @@ Status HashJoinNode::_build(RuntimeState* state) {
     return Status::OK();
 }
 
+bool HashJoinNode::_need_spill(RuntimeState* state) const {
+    // The null aware anti join is decided by whether there is any null in all the build rows.
+    if (!state->enable_spill() || _join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN) {
+        return false;
+    }
+    int64_t limit = _mem_tracker->lowest_limit();
+    if (limit <= 0) {
+        return false;
+    }
+    return _mem_tracker->spare_capacity() < limit / 100 * (100 - config::join_spill_mem_limit_percent) &&
+           state->spill_coordinator()->should_spill(_mem_tracker.get());
+}
+
+Status HashJoinNode::_spill_hash_table(RuntimeState* state, int level) {
+    SCOPED_TIMER(_spill_timer);
+    _spiller = std::make_unique<JoinSpiller>(state, _build_expr_ctxs, _probe_expr_ctxs, child(1)->row_desc(),
+                                             child(0)->row_desc(), level);
+    RETURN_IF_ERROR(_spiller->init());
+
+    // The first row of the build chunk isn't a build row, see JoinHashTableItems.
+    const ChunkPtr& build_chunk = _ht.get_build_chunk();
+    size_t num_rows = _ht.get_row_count();
+    for (size_t offset = 1; offset <= num_rows; offset += config::vector_chunk_size) {
+        size_t count = std::min<size_t>(config::vector_chunk_size, num_rows + 1 - offset);
+        ChunkPtr chunk = JoinSpiller::clone_empty(*build_chunk, count);
+        chunk->append(*build_chunk, offset, count);
+        RETURN_IF_ERROR(_spiller->spill_build_chunk(chunk));
+    }
+    _reset_hash_table();
+    return Status::OK();
+}
+
+Status HashJoinNode::_spill_probe_side(RuntimeState* state) {
+    while (true) {
+        RETURN_IF_CANCELLED(state);
+        ChunkPtr chunk = nullptr;
+        bool eos = false;
+        RETURN_IF_ERROR(child(0)->get_next(state, &chunk, &eos));
+        if (eos) {
+            break;
+        }
+        SCOPED_TIMER(_spill_timer);
+        RETURN_IF_ERROR(_spiller->spill_probe_chunk(chunk));
+    }
+
+    std::vector<SpilledJoinPartition> partitions;
+    RETURN_IF_ERROR(_spiller->finish(&partitions));
+    _spiller.reset();
+    for (auto& partition : partitions) {
+        _spilled_partitions.emplace_back(std::move(partition));
+    }
+    COUNTER_UPDATE(_spilled_partitions_counter, static_cast<int64_t>(partitions.size()));
+    _is_spilled = true;
+    return Status::OK();
+}
+
+Status HashJoinNode::_open_next_spilled_partition(RuntimeState* state, bool* has_next) {
+    bool is_right_join = _join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_SEMI_JOIN ||
+                         _join_type == TJoinOp::RIGHT_ANTI_JOIN || _join_type == TJoinOp::FULL_OUTER_JOIN;
+    while (!_spilled_partitions.empty()) {
+        SpilledJoinPartition partition = std::move(_spilled_partitions.front());
+        _spilled_partitions.pop_front();
+        _reset_hash_table();
+        if (partition.probe_file->num_rows() == 0 && !is_right_join) {
+            continue;
+        }
+
+        while (true) {
+            RETURN_IF_CANCELLED(state);
+            ChunkPtr chunk = nullptr;
+            bool eos = false;
+            RETURN_IF_ERROR(partition.build_file->read(&chunk, &eos));
+            if (eos) {
+                break;
+            }
+            if (_spiller != nullptr) {
+                SCOPED_TIMER(_spill_timer);
+                RETURN_IF_ERROR(_spiller->spill_build_chunk(chunk));
+                continue;
+            }
+            {
+                SCOPED_TIMER(_copy_right_table_chunk_timer);
+                RETURN_IF_ERROR(_ht.append_chunk(state, chunk));
+            }
+            if (_need_spill(state) && JoinSpiller::can_partition_next_level(partition.level)) {
+                RETURN_IF_ERROR(_spill_hash_table(state, partition.level + 1));
+            }
+        }
+
+        if (_spiller != nullptr) {
+            // The partition is too large, partition its probe rows too by the next level, and
+            // join the new partitions before the others.
+            while (true) {
+                RETURN_IF_CANCELLED(state);
+                ChunkPtr chunk = nullptr;
+                bool eos = false;
+                RETURN_IF_ERROR(partition.probe_file->read(&chunk, &eos));
+                if (eos) {
+                    break;
+                }
+                SCOPED_TIMER(_spill_timer);
+                RETURN_IF_ERROR(_spiller->spill_probe_chunk(chunk));
+            }
+            std::vector<SpilledJoinPartition> partitions;
+            RETURN_IF_ERROR(_spiller->finish(&partitions));
+            _spiller.reset();
+            for (auto it = partitions.rbegin(); it != partitions.rend(); ++it) {
+                _spilled_partitions.emplace_front(std::move(*it));
+            }
+            COUNTER_UPDATE(_spilled_partitions_counter, static_cast<int64_t>(partitions.size()));
+            continue;
+        }
+
+        {
+            SCOPED_TIMER(_build_ht_timer);
+            RETURN_IF_ERROR(_build(state));
+        }
+        if (_ht.get_row_count() == 0 && (_join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_SEMI_JOIN)) {
+            continue;
+        }
+        _probing_partition = std::move(partition);
+        *has_next = true;
+        return Status::OK();
+    }
+    *has_next = false;
+    return Status::OK();
+}
+
+void HashJoinNode::_reset_hash_table() {
+    _ht.close();
+    HashTableParam param;
+    _init_hash_table_param(&param);
+    _ht.create(param);
+
+    _cur_left_input_chunk = nullptr;
+    _pre_left_input_chunk = nullptr;
+    _probing_chunk = nullptr;
+    _ht_has_remain = false;
+    _right_table_has_remain = false;
+    _build_eos = false;
+    _probe_eos = false;
+}
+
+Status HashJoinNode::_fetch_probe_chunk(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    if (_is_spilled) {
+        return _probing_partition.probe_file->read(chunk, eos);
+    }
+    return child(0)->get_next(state, chunk, eos);
+}
+
 Status HashJoinNode::_probe(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& probe_timer, ChunkPtr* chunk,
                             bool& eos) {
     while (true) {
@@ -385,7 +608,7 @@ Status HashJoinNode::_probe(RuntimeState* state, ScopedTimer<MonotonicStopWatch>
                     // if current chunk size < vector_chunk_size and pre chunk size + cur chunk size <= 1024, merge the two chunk
                     // if current chunk size < vector_chunk_size and pre chunk size + cur chunk size > 1024, return pre chunk
                     probe_timer.stop();
-                    RETURN_IF_ERROR(child(0)->get_next(state, &_cur_left_input_chunk, &_probe_eos));
+                    RETURN_IF_ERROR(_fetch_probe_chunk(state, &_cur_left_input_chunk, &_probe_eos));
                     probe_timer.start();
                     {
                         SCOPED_TIMER(_merge_input_chunk_timer);
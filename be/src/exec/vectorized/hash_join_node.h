@@ -2,10 +2,13 @@
 
 #pragma once
 
+#include <deque>
+
 #include "column/chunk.h"
 #include "column/fixed_length_column.h"
 #include "exec/exec_node.h"
 #include "exec/vectorized/join_hash_map.h"
+#include "exec/vectorized/join_spiller.h"
 #include "util/phmap/phmap.h"
 
 namespace starrocks {
@@ -32,6 +35,9 @@ public:
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
     Status close(RuntimeState* state) override;
 
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
 private:
     static bool _has_null(const ColumnPtr& column);
 
@@ -51,9 +57,24 @@ private:
         }
     }
     Status _build(RuntimeState* state);
+    // Output the next chunk joined with the current hash table, |*ht_eos| is set if there is no more.
+    Status _get_next_from_ht(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& probe_timer, ChunkPtr* chunk,
+                             bool* ht_eos);
+    Status _fetch_probe_chunk(RuntimeState* state, ChunkPtr* chunk, bool* eos);
     Status _probe(RuntimeState* state, ScopedTimer<MonotonicStopWatch>& probe_timer, ChunkPtr* chunk, bool& eos);
     Status _probe_remain(ChunkPtr* chunk, bool& eos);
 
+    // The grace hash join: once the build rows don't fit in memory, the build and probe rows are
+    // partitioned into the temporary files by JoinSpiller, and then the partitions are joined one
+    // by one, a partition still too large is partitioned again.
+    bool _need_spill(RuntimeState* state) const;
+    // Move the build rows in the hash table to the partitions of a new JoinSpiller of |level|.
+    Status _spill_hash_table(RuntimeState* state, int level);
+    Status _spill_probe_side(RuntimeState* state);
+    // Build the hash table of the next spilled partition, |*has_next| is unset if all are joined.
+    Status _open_next_spilled_partition(RuntimeState* state, bool* has_next);
+    void _reset_hash_table();
+
     void _calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all, bool& hit_all);
     static void _process_row_for_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count,
                                                 bool filter_all, bool hit_all, const Column::Filter& filter);
@@ -70,6 +91,8 @@ private:
 
     friend ExecNode;
 
+    const TPlanNode _tnode;
+
     std::vector<ExprContext*> _probe_expr_ctxs;
     std::vector<ExprContext*> _build_expr_ctxs;
     std::vector<ExprContext*> _other_join_conjunct_ctxs;
@@ -85,6 +108,13 @@ private:
 
     JoinHashTable _ht;
 
+    // Not null while the build or probe rows are being spilled.
+    std::unique_ptr<JoinSpiller> _spiller;
+    bool _is_spilled = false;
+    // The spilled partitions to be joined, and the partition being joined.
+    std::deque<SpilledJoinPartition> _spilled_partitions;
+    SpilledJoinPartition _probing_partition;
+
     ChunkPtr _cur_left_input_chunk = nullptr;
     ChunkPtr _pre_left_input_chunk = nullptr;
     ChunkPtr _probing_chunk = nullptr;
@@ -123,6 +153,8 @@ private:
     RuntimeProfile::Counter* _probe_conjunct_evaluate_timer = nullptr;
     RuntimeProfile::Counter* _other_join_conjunct_evaluate_timer = nullptr;
     RuntimeProfile::Counter* _where_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spilled_partitions_counter = nullptr;
 };
 
 } // namespace vectorized
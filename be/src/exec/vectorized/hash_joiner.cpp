@@ -0,0 +1,412 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/hash_joiner.h"
+
+#include "column/column_helper.h"
+#include "exec/exec_node.h"
+#include "exprs/vectorized/runtime_filter_bank.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/runtime_filter_worker.h"
+#include "simd/simd.h"
+
+namespace starrocks::vectorized {
+
+HashJoiner::HashJoiner(const TPlanNode& tnode, const RowDescriptor& row_descriptor,
+                       const RowDescriptor& build_row_descriptor, const RowDescriptor& probe_row_descriptor)
+        : _tnode(tnode),
+          _row_descriptor(row_descriptor),
+          _build_row_descriptor(build_row_descriptor),
+          _probe_row_descriptor(probe_row_descriptor),
+          _join_type(tnode.hash_join_node.join_op) {
+    if (_join_type == TJoinOp::LEFT_ANTI_JOIN && tnode.hash_join_node.is_rewritten_from_not_in) {
+        _join_type = TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN;
+    }
+}
+
+Status HashJoiner::prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile* runtime_profile,
+                           MemTracker* mem_tracker) {
+    _pool = pool;
+    _runtime_profile = runtime_profile;
+    _mem_tracker = mem_tracker;
+
+    for (const auto& eq_join_conjunct : _tnode.hash_join_node.eq_join_conjuncts) {
+        ExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, eq_join_conjunct.left, &ctx));
+        _probe_expr_ctxs.push_back(ctx);
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, eq_join_conjunct.right, &ctx));
+        _build_expr_ctxs.push_back(ctx);
+        _is_null_safes.emplace_back(eq_join_conjunct.__isset.opcode &&
+                                    eq_join_conjunct.opcode == TExprOpcode::EQ_FOR_NULL);
+    }
+    RETURN_IF_ERROR(
+            Expr::create_expr_trees(_pool, _tnode.hash_join_node.other_join_conjuncts, &_other_join_conjunct_ctxs));
+    RETURN_IF_ERROR(Expr::create_expr_trees(_pool, _tnode.conjuncts, &_conjunct_ctxs));
+    for (const auto& desc : _tnode.hash_join_node.build_runtime_filters) {
+        auto* rf_desc = _pool->add(new RuntimeFilterBuildDescriptor());
+        RETURN_IF_ERROR(rf_desc->init(_pool, desc));
+        _build_runtime_filters.emplace_back(rf_desc);
+    }
+
+    _build_timer = ADD_TIMER(_runtime_profile, "BuildTime");
+    _copy_right_table_chunk_timer = ADD_CHILD_TIMER(_runtime_profile, "1-CopyRightTableChunkTime", "BuildTime");
+    _build_ht_timer = ADD_CHILD_TIMER(_runtime_profile, "2-BuildHashTableTime", "BuildTime");
+    _build_push_down_expr_timer = ADD_CHILD_TIMER(_runtime_profile, "3-BuildPushDownExprTime", "BuildTime");
+    _build_conjunct_evaluate_timer = ADD_CHILD_TIMER(_runtime_profile, "4-BuildConjunctEvaluateTime", "BuildTime");
+
+    _probe_timer = ADD_TIMER(_runtime_profile, "ProbeTime");
+    _search_ht_timer = ADD_CHILD_TIMER(_runtime_profile, "1-SearchHashTableTimer", "ProbeTime");
+    _output_build_column_timer = ADD_CHILD_TIMER(_runtime_profile, "2-OutputBuildColumnTimer", "ProbeTime");
+    _output_probe_column_timer = ADD_CHILD_TIMER(_runtime_profile, "3-OutputProbeColumnTimer", "ProbeTime");
+    _output_tuple_column_timer = ADD_CHILD_TIMER(_runtime_profile, "4-OutputTupleColumnTimer", "ProbeTime");
+    _probe_conjunct_evaluate_timer = ADD_CHILD_TIMER(_runtime_profile, "5-ProbeConjunctEvaluateTime", "ProbeTime");
+    _other_join_conjunct_evaluate_timer =
+            ADD_CHILD_TIMER(_runtime_profile, "6-OtherJoinConjunctEvaluateTime", "ProbeTime");
+    _where_conjunct_evaluate_timer = ADD_CHILD_TIMER(_runtime_profile, "7-WhereConjunctEvaluateTime", "ProbeTime");
+
+    _probe_rows_counter = ADD_COUNTER(_runtime_profile, "ProbeRows", TUnit::UNIT);
+    _build_rows_counter = ADD_COUNTER(_runtime_profile, "BuildRows", TUnit::UNIT);
+    _build_buckets_counter = ADD_COUNTER(_runtime_profile, "BuildBuckets", TUnit::UNIT);
+    _push_down_expr_num = ADD_COUNTER(_runtime_profile, "PushDownExprNum", TUnit::UNIT);
+
+    RETURN_IF_ERROR(Expr::prepare(_build_expr_ctxs, state, _build_row_descriptor, _mem_tracker));
+    RETURN_IF_ERROR(Expr::prepare(_probe_expr_ctxs, state, _probe_row_descriptor, _mem_tracker));
+    RETURN_IF_ERROR(Expr::prepare(_other_join_conjunct_ctxs, state, _row_descriptor, _mem_tracker));
+    RETURN_IF_ERROR(Expr::prepare(_conjunct_ctxs, state, _row_descriptor, _mem_tracker));
+    RETURN_IF_ERROR(Expr::open(_build_expr_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_probe_expr_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_other_join_conjunct_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_conjunct_ctxs, state));
+
+    HashTableParam param;
+    _init_hash_table_param(&param);
+    _ht.create(param);
+
+    _probe_column_count = _ht.get_probe_column_count();
+    _build_column_count = _ht.get_build_column_count();
+    return Status::OK();
+}
+
+Status HashJoiner::close(RuntimeState* state) {
+    if (_is_closed) {
+        return Status::OK();
+    }
+    _is_closed = true;
+
+    Expr::close(_build_expr_ctxs, state);
+    Expr::close(_probe_expr_ctxs, state);
+    Expr::close(_other_join_conjunct_ctxs, state);
+    Expr::close(_conjunct_ctxs, state);
+    _ht.close();
+    return Status::OK();
+}
+
+void HashJoiner::_init_hash_table_param(HashTableParam* param) {
+    param->with_other_conjunct = !_other_join_conjunct_ctxs.empty();
+    param->join_type = _join_type;
+    param->row_desc = &_row_descriptor;
+    param->mem_tracker = _mem_tracker;
+    param->build_row_desc = &_build_row_descriptor;
+    param->probe_row_desc = &_probe_row_descriptor;
+    param->search_ht_timer = _search_ht_timer;
+    param->output_build_column_timer = _output_build_column_timer;
+    param->output_probe_column_timer = _output_probe_column_timer;
+    param->output_tuple_column_timer = _output_tuple_column_timer;
+
+    for (auto i = 0; i < _probe_expr_ctxs.size(); i++) {
+        param->join_keys.emplace_back(JoinKeyDesc{_probe_expr_ctxs[i]->root()->type().type, _is_null_safes[i]});
+    }
+    for (auto* build_expr_ctx : _build_expr_ctxs) {
+        build_expr_ctx->root()->get_slot_ids(&param->build_key_slot_ids);
+    }
+}
+
+Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk) {
+    SCOPED_TIMER(_build_timer);
+    if (_ht.get_row_count() + chunk->num_rows() >= UINT32_MAX) {
+        return Status::NotSupported(strings::Substitute("row count of right table in hash join > $0", UINT32_MAX));
+    }
+
+    SCOPED_TIMER(_copy_right_table_chunk_timer);
+    return _ht.append_chunk(state, chunk);
+}
+
+void HashJoiner::build_ht(RuntimeState* state) {
+    _build_status = _build(state);
+    _is_build_done.store(true, std::memory_order_release);
+}
+
+Status HashJoiner::_build(RuntimeState* state) {
+    SCOPED_TIMER(_build_timer);
+    {
+        SCOPED_TIMER(_build_conjunct_evaluate_timer);
+        for (auto& build_expr_ctx : _build_expr_ctxs) {
+            const TypeDescriptor& data_type = build_expr_ctx->root()->type();
+            ColumnPtr column_ptr = build_expr_ctx->evaluate(_ht.get_build_chunk().get());
+            if (column_ptr->is_nullable() && column_ptr->is_constant()) {
+                ColumnPtr column = ColumnHelper::create_column(data_type, true);
+                column->append_nulls(_ht.get_build_chunk()->num_rows());
+                _ht.get_key_columns().emplace_back(column);
+            } else if (column_ptr->is_constant()) {
+                auto* const_column = ColumnHelper::as_raw_column<ConstColumn>(column_ptr);
+                const_column->data_column()->assign(_ht.get_build_chunk()->num_rows(), 0);
+                _ht.get_key_columns().emplace_back(const_column->data_column());
+            } else {
+                _ht.get_key_columns().emplace_back(column_ptr);
+            }
+        }
+    }
+
+    {
+        SCOPED_TIMER(_build_ht_timer);
+        RETURN_IF_ERROR(_ht.build(state));
+    }
+    COUNTER_SET(_build_rows_counter, static_cast<int64_t>(_ht.get_row_count()));
+    COUNTER_SET(_build_buckets_counter, static_cast<int64_t>(_ht.get_bucket_size()));
+
+    uint64_t runtime_join_filter_pushdown_limit = 1024000;
+    if (state->query_options().__isset.runtime_join_filter_pushdown_limit) {
+        runtime_join_filter_pushdown_limit = state->query_options().runtime_join_filter_pushdown_limit;
+    }
+    // publish runtime filters even if the hash table is empty,
+    // because the merge node of global runtime filters is waiting for all the partitioned filters.
+    RETURN_IF_ERROR(_do_publish_runtime_filters(state, runtime_join_filter_pushdown_limit));
+
+    // special cases of short-circuit break.
+    if (_ht.get_row_count() == 0 && (_join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_SEMI_JOIN)) {
+        _is_empty_output = true;
+    } else if (_ht.get_row_count() > 0 && _join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN &&
+               _ht.get_key_columns().size() == 1 && _has_null(_ht.get_key_columns()[0])) {
+        // See HashJoinNode::open, the reserved row of the hash table may be null,
+        // so Column::has_null() cannot be used here.
+        _is_empty_output = true;
+    }
+    return Status::OK();
+}
+
+bool HashJoiner::_has_null(const ColumnPtr& column) {
+    if (column->is_nullable()) {
+        const auto& null_column = ColumnHelper::as_raw_column<NullableColumn>(column)->null_column();
+        DCHECK_GT(null_column->size(), 0);
+        return null_column->contain_value(1, null_column->size(), 1);
+    }
+    return false;
+}
+
+Status HashJoiner::_do_publish_runtime_filters(RuntimeState* state, int64_t limit) {
+    SCOPED_TIMER(_build_push_down_expr_timer);
+
+    for (auto* rf_desc : _build_runtime_filters) {
+        // skip if it does not have consumer.
+        if (!rf_desc->has_consumer()) continue;
+        // skip if ht.size() > limit and it's only for local.
+        if (!rf_desc->has_remote_targets() && _ht.get_row_count() > limit) continue;
+        PrimitiveType build_type = rf_desc->build_expr_type();
+        JoinRuntimeFilter* filter = RuntimeFilterHelper::create_runtime_bloom_filter(_pool, build_type);
+        if (filter == nullptr) continue;
+        filter->set_join_mode(rf_desc->join_mode());
+        filter->init(_ht.get_row_count());
+        ColumnPtr column = _ht.get_key_columns()[rf_desc->build_expr_order()];
+        RETURN_IF_ERROR(RuntimeFilterHelper::fill_runtime_bloom_filter(column, build_type, filter));
+        rf_desc->set_runtime_filter(filter);
+    }
+
+    state->runtime_filter_port()->publish_runtime_filters(_build_runtime_filters);
+    COUNTER_UPDATE(_push_down_expr_num, static_cast<int64_t>(_build_runtime_filters.size()));
+    return Status::OK();
+}
+
+void HashJoiner::reference_hash_table(HashJoiner* builder) {
+    DCHECK(builder->is_build_done());
+    // The prober's own table is empty, it's replaced by the clone of the builder's one.
+    _ht.close();
+    _ht = builder->_ht.clone_readable_table();
+    _is_empty_output = builder->_is_empty_output;
+}
+
+Status HashJoiner::push_probe_chunk(RuntimeState* state, const ChunkPtr& chunk) {
+    DCHECK(_probing_chunk == nullptr);
+    SCOPED_TIMER(_probe_timer);
+    COUNTER_UPDATE(_probe_rows_counter, chunk->num_rows());
+
+    SCOPED_TIMER(_probe_conjunct_evaluate_timer);
+    _key_columns.resize(0);
+    for (auto& probe_expr_ctx : _probe_expr_ctxs) {
+        ColumnPtr column_ptr = probe_expr_ctx->evaluate(chunk.get());
+        if (column_ptr->is_nullable() && column_ptr->is_constant()) {
+            ColumnPtr column = ColumnHelper::create_column(probe_expr_ctx->root()->type(), true);
+            column->append_nulls(chunk->num_rows());
+            _key_columns.emplace_back(column);
+        } else if (column_ptr->is_constant()) {
+            auto* const_column = ColumnHelper::as_raw_column<ConstColumn>(column_ptr);
+            const_column->data_column()->assign(chunk->num_rows(), 0);
+            _key_columns.emplace_back(const_column->data_column());
+        } else {
+            _key_columns.emplace_back(column_ptr);
+        }
+    }
+    DCHECK_GT(_key_columns.size(), 0);
+    DCHECK_NOTNULL(_key_columns[0].get());
+    _probing_chunk = chunk;
+    return Status::OK();
+}
+
+StatusOr<ChunkPtr> HashJoiner::pull_probe_chunk(RuntimeState* state) {
+    DCHECK(_probing_chunk != nullptr);
+    SCOPED_TIMER(_probe_timer);
+
+    auto chunk = std::make_shared<Chunk>();
+    RETURN_IF_ERROR(_ht.probe(_key_columns, &_probing_chunk, &chunk, &_ht_has_remain));
+    if (!_ht_has_remain) {
+        _probing_chunk = nullptr;
+    }
+
+    if (chunk->num_rows() > 0 && !_other_join_conjunct_ctxs.empty()) {
+        SCOPED_TIMER(_other_join_conjunct_evaluate_timer);
+        _process_other_conjunct(&chunk);
+    }
+
+    if (chunk->num_rows() > 0 && !_conjunct_ctxs.empty()) {
+        SCOPED_TIMER(_where_conjunct_evaluate_timer);
+        ExecNode::eval_conjuncts(_conjunct_ctxs, chunk.get());
+    }
+    return chunk;
+}
+
+StatusOr<ChunkPtr> HashJoiner::pull_probe_remain_chunk(RuntimeState* state) {
+    DCHECK(!_is_probe_remain_done);
+    SCOPED_TIMER(_probe_timer);
+
+    auto chunk = std::make_shared<Chunk>();
+    RETURN_IF_ERROR(_ht.probe_remain(&chunk, &_right_table_has_remain));
+    _is_probe_remain_done = chunk->num_rows() <= 0 || !_right_table_has_remain;
+
+    if (chunk->num_rows() > 0 && !_conjunct_ctxs.empty()) {
+        SCOPED_TIMER(_where_conjunct_evaluate_timer);
+        ExecNode::eval_conjuncts(_conjunct_ctxs, chunk.get());
+    }
+    return chunk;
+}
+
+void HashJoiner::_calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all,
+                                                 bool& hit_all) {
+    filter_all = false;
+    hit_all = false;
+    filter.assign((*chunk)->num_rows(), 1);
+
+    for (auto* ctx : _other_join_conjunct_ctxs) {
+        ColumnPtr column = ctx->evaluate((*chunk).get());
+        size_t true_count = ColumnHelper::count_true_with_notnull(column);
+
+        if (true_count == column->size()) {
+            // all hit, skip
+            continue;
+        } else if (0 == true_count) {
+            // all not hit, return
+            filter_all = true;
+            filter.assign((*chunk)->num_rows(), 0);
+            break;
+        } else {
+            bool all_zero = false;
+            ColumnHelper::merge_two_filters(column, &filter, &all_zero);
+            if (all_zero) {
+                filter_all = true;
+                break;
+            }
+        }
+    }
+
+    if (!filter_all) {
+        int zero_count = SIMD::count_zero(filter.data(), filter.size());
+        if (zero_count == 0) {
+            hit_all = true;
+        }
+    }
+}
+
+void HashJoiner::_process_row_for_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count,
+                                                 bool filter_all, bool hit_all, const Column::Filter& filter) {
+    if (filter_all) {
+        for (size_t i = start_column; i < start_column + column_count; i++) {
+            auto* null_column = ColumnHelper::as_raw_column<NullableColumn>((*chunk)->columns()[i]);
+            auto& null_data = null_column->mutable_null_column()->get_data();
+            for (size_t j = 0; j < (*chunk)->num_rows(); j++) {
+                null_data[j] = 1;
+                null_column->set_has_null(true);
+            }
+        }
+    } else {
+        if (hit_all) {
+            return;
+        }
+
+        for (size_t i = start_column; i < start_column + column_count; i++) {
+            auto* null_column = ColumnHelper::as_raw_column<NullableColumn>((*chunk)->columns()[i]);
+            auto& null_data = null_column->mutable_null_column()->get_data();
+            for (size_t j = 0; j < filter.size(); j++) {
+                if (filter[j] == 0) {
+                    null_data[j] = 1;
+                    null_column->set_has_null(true);
+                }
+            }
+        }
+    }
+}
+
+void HashJoiner::_process_outer_join_with_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count) {
+    bool filter_all = false;
+    bool hit_all = false;
+    Column::Filter filter;
+
+    _calc_filter_for_other_conjunct(chunk, filter, filter_all, hit_all);
+    _process_row_for_other_conjunct(chunk, start_column, column_count, filter_all, hit_all, filter);
+
+    _ht.remove_duplicate_index(&filter);
+    (*chunk)->filter(filter);
+}
+
+void HashJoiner::_process_semi_join_with_other_conjunct(ChunkPtr* chunk) {
+    bool filter_all = false;
+    bool hit_all = false;
+    Column::Filter filter;
+
+    _calc_filter_for_other_conjunct(chunk, filter, filter_all, hit_all);
+
+    _ht.remove_duplicate_index(&filter);
+    (*chunk)->filter(filter);
+}
+
+void HashJoiner::_process_right_anti_join_with_other_conjunct(ChunkPtr* chunk) {
+    bool filter_all = false;
+    bool hit_all = false;
+    Column::Filter filter;
+
+    _calc_filter_for_other_conjunct(chunk, filter, filter_all, hit_all);
+
+    _ht.remove_duplicate_index(&filter);
+    (*chunk)->set_num_rows(0);
+}
+
+void HashJoiner::_process_other_conjunct(ChunkPtr* chunk) {
+    switch (_join_type) {
+    case TJoinOp::LEFT_OUTER_JOIN:
+    case TJoinOp::FULL_OUTER_JOIN:
+        _process_outer_join_with_other_conjunct(chunk, _probe_column_count, _build_column_count);
+        break;
+    case TJoinOp::RIGHT_OUTER_JOIN:
+    case TJoinOp::LEFT_SEMI_JOIN:
+    case TJoinOp::LEFT_ANTI_JOIN:
+    case TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN:
+    case TJoinOp::RIGHT_SEMI_JOIN:
+        _process_semi_join_with_other_conjunct(chunk);
+        break;
+    case TJoinOp::RIGHT_ANTI_JOIN:
+        _process_right_anti_join_with_other_conjunct(chunk);
+        break;
+    default:
+        // the other join conjunct for inner join will be convert to other predicate
+        // so can't reach here
+        ExecNode::eval_conjuncts(_other_join_conjunct_ctxs, (*chunk).get());
+    }
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,181 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <list>
+
+#include "column/vectorized_fwd.h"
+#include "exec/vectorized/join_hash_map.h"
+#include "exprs/expr.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+class MemTracker;
+class ObjectPool;
+namespace vectorized {
+class RuntimeFilterBuildDescriptor;
+
+class HashJoiner;
+using HashJoinerPtr = std::shared_ptr<HashJoiner>;
+
+// HashJoiner holds the hash table and the expressions of one hash join for the pipeline engine.
+// The HashJoinBuildOperator builds the hash table of the only builder HashJoiner of a fragment
+// instance, and each driver of the probe pipeline probes with its own HashJoiner, which references
+// the hash table of the builder read-only once it has been built, so that the build side is
+// neither copied nor built again for each probe driver.
+class HashJoiner {
+public:
+    HashJoiner(const TPlanNode& tnode, const RowDescriptor& row_descriptor, const RowDescriptor& build_row_descriptor,
+               const RowDescriptor& probe_row_descriptor);
+
+    ~HashJoiner() = default;
+
+    Status prepare(RuntimeState* state, ObjectPool* pool, RuntimeProfile* runtime_profile, MemTracker* mem_tracker);
+
+    Status close(RuntimeState* state);
+
+    // The builder HashJoiner is referenced by the build operator and all the probe operators,
+    // the last one which calls unref closes the HashJoiner.
+    void ref() { _num_refs.fetch_add(1, std::memory_order_relaxed); }
+    Status unref(RuntimeState* state) {
+        if (_num_refs.fetch_sub(1) == 1) {
+            return close(state);
+        }
+        return Status::OK();
+    }
+
+    // Used by the builder.
+    Status append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk);
+    // Build the hash table with the appended chunks and publish the runtime filters,
+    // after which the probers could reference the hash table.
+    void build_ht(RuntimeState* state);
+    bool is_build_done() const { return _is_build_done.load(std::memory_order_acquire); }
+    const Status& build_status() const { return _build_status; }
+
+    // Used by the probers, |builder| must have been built.
+    void reference_hash_table(HashJoiner* builder);
+    // Whether the join outputs nothing no matter what the probe side is,
+    // e.g. inner join with an empty build side.
+    bool is_empty_output() const { return _is_empty_output; }
+    bool has_probing_chunk() const { return _probing_chunk != nullptr; }
+    // Right outer, right anti and full outer join output the unmatched build rows after probing.
+    bool need_probe_remain() const {
+        return _join_type == TJoinOp::RIGHT_OUTER_JOIN || _join_type == TJoinOp::RIGHT_ANTI_JOIN ||
+               _join_type == TJoinOp::FULL_OUTER_JOIN;
+    }
+    bool is_probe_remain_done() const { return _is_probe_remain_done; }
+
+    Status push_probe_chunk(RuntimeState* state, const ChunkPtr& chunk);
+    // Output the joined rows of the probing chunk, the returned chunk may be empty.
+    StatusOr<ChunkPtr> pull_probe_chunk(RuntimeState* state);
+    // Output the unmatched build rows, after all the probe input has been probed.
+    StatusOr<ChunkPtr> pull_probe_remain_chunk(RuntimeState* state);
+
+private:
+    static bool _has_null(const ColumnPtr& column);
+
+    void _init_hash_table_param(HashTableParam* param);
+    Status _build(RuntimeState* state);
+    Status _do_publish_runtime_filters(RuntimeState* state, int64_t limit);
+
+    void _calc_filter_for_other_conjunct(ChunkPtr* chunk, Column::Filter& filter, bool& filter_all, bool& hit_all);
+    static void _process_row_for_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count,
+                                                bool filter_all, bool hit_all, const Column::Filter& filter);
+
+    void _process_outer_join_with_other_conjunct(ChunkPtr* chunk, size_t start_column, size_t column_count);
+    void _process_semi_join_with_other_conjunct(ChunkPtr* chunk);
+    void _process_right_anti_join_with_other_conjunct(ChunkPtr* chunk);
+    void _process_other_conjunct(ChunkPtr* chunk);
+
+    const TPlanNode _tnode;
+    const RowDescriptor& _row_descriptor;
+    const RowDescriptor& _build_row_descriptor;
+    const RowDescriptor& _probe_row_descriptor;
+    TJoinOp::type _join_type = TJoinOp::INNER_JOIN;
+
+    ObjectPool* _pool = nullptr;
+    RuntimeProfile* _runtime_profile = nullptr;
+    MemTracker* _mem_tracker = nullptr;
+
+    std::vector<ExprContext*> _probe_expr_ctxs;
+    std::vector<ExprContext*> _build_expr_ctxs;
+    std::vector<ExprContext*> _other_join_conjunct_ctxs;
+    std::vector<ExprContext*> _conjunct_ctxs;
+    std::vector<bool> _is_null_safes;
+    std::list<RuntimeFilterBuildDescriptor*> _build_runtime_filters;
+
+    JoinHashTable _ht;
+
+    ChunkPtr _probing_chunk = nullptr;
+    Columns _key_columns;
+    size_t _probe_column_count = 0;
+    size_t _build_column_count = 0;
+
+    std::atomic<int> _num_refs = 0;
+    std::atomic<bool> _is_build_done = false;
+    Status _build_status;
+    bool _is_closed = false;
+    bool _is_empty_output = false;
+    bool _ht_has_remain = false;
+    bool _right_table_has_remain = true;
+    bool _is_probe_remain_done = false;
+
+    RuntimeProfile::Counter* _build_timer = nullptr;
+    RuntimeProfile::Counter* _build_ht_timer = nullptr;
+    RuntimeProfile::Counter* _copy_right_table_chunk_timer = nullptr;
+    RuntimeProfile::Counter* _build_push_down_expr_timer = nullptr;
+    RuntimeProfile::Counter* _build_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _probe_timer = nullptr;
+    RuntimeProfile::Counter* _search_ht_timer = nullptr;
+    RuntimeProfile::Counter* _output_build_column_timer = nullptr;
+    RuntimeProfile::Counter* _output_probe_column_timer = nullptr;
+    RuntimeProfile::Counter* _output_tuple_column_timer = nullptr;
+    RuntimeProfile::Counter* _probe_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _other_join_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _where_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _probe_rows_counter = nullptr;
+    RuntimeProfile::Counter* _build_rows_counter = nullptr;
+    RuntimeProfile::Counter* _build_buckets_counter = nullptr;
+    RuntimeProfile::Counter* _push_down_expr_num = nullptr;
+};
+
+// HashJoinerFactory creates the only builder and one prober for each driver sequence of the probe pipeline.
+class HashJoinerFactory;
+using HashJoinerFactoryPtr = std::shared_ptr<HashJoinerFactory>;
+
+class HashJoinerFactory {
+public:
+    HashJoinerFactory(const TPlanNode& tnode, const RowDescriptor& row_descriptor,
+                      const RowDescriptor& build_row_descriptor, const RowDescriptor& probe_row_descriptor)
+            : _tnode(tnode),
+              _row_descriptor(row_descriptor),
+              _build_row_descriptor(build_row_descriptor),
+              _probe_row_descriptor(probe_row_descriptor) {}
+
+    HashJoinerPtr get_or_create_builder() {
+        if (_builder == nullptr) {
+            _builder = _create();
+        }
+        return _builder;
+    }
+
+    HashJoinerPtr create_prober() { return _create(); }
+
+private:
+    HashJoinerPtr _create() {
+        return std::make_shared<HashJoiner>(_tnode, _row_descriptor, _build_row_descriptor, _probe_row_descriptor);
+    }
+
+    const TPlanNode _tnode;
+    const RowDescriptor& _row_descriptor;
+    const RowDescriptor& _build_row_descriptor;
+    const RowDescriptor& _probe_row_descriptor;
+    HashJoinerPtr _builder = nullptr;
+};
+
+} // namespace vectorized
+} // namespace starrocks
@@ -0,0 +1,120 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/hdfs_file_meta_cache.h"
+
+#include "exec/parquet/metadata.h"
+#include "runtime/mem_tracker.h"
+#include "util/coding.h"
+#include "util/metrics.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks::vectorized {
+
+UIntGauge g_hdfs_file_meta_cache_size(MetricUnit::BYTES);             // NOLINT
+IntCounter g_hdfs_file_meta_cache_hit_count(MetricUnit::OPERATIONS);  // NOLINT
+IntCounter g_hdfs_file_meta_cache_miss_count(MetricUnit::OPERATIONS); // NOLINT
+
+[[maybe_unused]] static void update_hdfs_file_meta_cache_size() {
+    g_hdfs_file_meta_cache_size.set_value(HdfsFileMetaCache::instance()->memory_usage());
+}
+
+HdfsFileMetaCache* HdfsFileMetaCache::_s_instance = nullptr;
+
+void HdfsFileMetaCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+    if (_s_instance == nullptr && capacity > 0) {
+        _s_instance = new HdfsFileMetaCache(mem_tracker, capacity);
+#ifndef BE_TEST
+        MetricRegistry* reg = StarRocksMetrics::instance()->metrics();
+        reg->register_hook("hdfs_file_meta_cache_size_hook", update_hdfs_file_meta_cache_size);
+        reg->register_metric("hdfs_file_meta_cache_bytes", &g_hdfs_file_meta_cache_size);
+        reg->register_metric("hdfs_file_meta_cache_hit_count", &g_hdfs_file_meta_cache_hit_count);
+        reg->register_metric("hdfs_file_meta_cache_miss_count", &g_hdfs_file_meta_cache_miss_count);
+#endif
+    }
+}
+
+void HdfsFileMetaCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+HdfsFileMetaCache::HdfsFileMetaCache(MemTracker* mem_tracker, size_t capacity)
+        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {}
+
+HdfsFileMetaCache::~HdfsFileMetaCache() {
+    _cache.reset();
+    _mem_tracker->release(_mem_tracker->consumption());
+}
+
+std::string HdfsFileMetaCache::_encode_key(const std::string& path, int64_t length, int64_t modification_time) {
+    std::string key = path;
+    put_fixed64_le(&key, length);
+    put_fixed64_le(&key, modification_time);
+    return key;
+}
+
+bool HdfsFileMetaCache::_lookup(const std::string& key, Entry* entry) {
+    auto* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        g_hdfs_file_meta_cache_miss_count.increment(1);
+        return false;
+    }
+    g_hdfs_file_meta_cache_hit_count.increment(1);
+    *entry = *reinterpret_cast<Entry*>(_cache->value(handle));
+    _cache->release(handle);
+    return true;
+}
+
+void HdfsFileMetaCache::_insert(const std::string& key, Entry entry, size_t charge) {
+    auto deleter = [](const CacheKey& key, void* value) { delete reinterpret_cast<Entry*>(value); };
+    auto* handle = _cache->insert(CacheKey(key), new Entry(std::move(entry)), key.size() + sizeof(Entry) + charge,
+                                  deleter);
+    _cache->release(handle);
+    _mem_tracker->consume(static_cast<int64_t>(memory_usage()) - _mem_tracker->consumption());
+}
+
+HdfsFileMetaCache::ParquetMetaPtr HdfsFileMetaCache::lookup_parquet(const std::string& path, int64_t length,
+                                                                    int64_t modification_time) {
+    Entry entry;
+    if (!_lookup(_encode_key(path, length, modification_time), &entry)) {
+        return nullptr;
+    }
+    return entry.parquet_meta;
+}
+
+void HdfsFileMetaCache::insert_parquet(const std::string& path, int64_t length, int64_t modification_time,
+                                       const ParquetMetaPtr& meta, size_t footer_size) {
+    // The parsed metadata is charged by its serialized footer, which its size is about proportional to.
+    Entry entry;
+    entry.parquet_meta = meta;
+    _insert(_encode_key(path, length, modification_time), std::move(entry), sizeof(parquet::FileMetaData) + footer_size);
+}
+
+bool HdfsFileMetaCache::lookup_orc_tail(const std::string& path, int64_t length, int64_t modification_time,
+                                        std::string* tail) {
+    Entry entry;
+    if (!_lookup(_encode_key(path, length, modification_time), &entry) || entry.orc_tail.empty()) {
+        return false;
+    }
+    *tail = std::move(entry.orc_tail);
+    return true;
+}
+
+void HdfsFileMetaCache::insert_orc_tail(const std::string& path, int64_t length, int64_t modification_time,
+                                        const std::string& tail) {
+    Entry entry;
+    entry.orc_tail = tail;
+    _insert(_encode_key(path, length, modification_time), std::move(entry), tail.size());
+}
+
+int64_t HdfsFileMetaCache::hit_count() {
+    return g_hdfs_file_meta_cache_hit_count.value();
+}
+
+int64_t HdfsFileMetaCache::miss_count() {
+    return g_hdfs_file_meta_cache_miss_count.value();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,81 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "gutil/macros.h"
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+class MemTracker;
+
+namespace parquet {
+class FileMetaData;
+}
+
+namespace vectorized {
+
+// HdfsFileMetaCache keeps the metadata of the recently opened files of the hdfs scans, the parsed footers of the
+// parquet files and the serialized tails of the orc files, so that the hot files are opened without reading and
+// parsing their footers again. A file is keyed by its path, length and modification time, which tell a file
+// rewritten from its old version. The metadata is evicted in LRU order once it is more than the capacity, and
+// accounted in |mem_tracker|.
+class HdfsFileMetaCache {
+public:
+    using ParquetMetaPtr = std::shared_ptr<parquet::FileMetaData>;
+
+    // Create global instance of this class
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+
+    static void release_global_cache();
+
+    // Return global instance, nullptr if the cache has not been created or is disabled.
+    static HdfsFileMetaCache* instance() { return _s_instance; }
+
+    HdfsFileMetaCache(MemTracker* mem_tracker, size_t capacity);
+    ~HdfsFileMetaCache();
+
+    // Return the metadata of the parquet file, nullptr if it is not in the cache.
+    ParquetMetaPtr lookup_parquet(const std::string& path, int64_t length, int64_t modification_time);
+
+    // Insert the metadata of the parquet file parsed from a footer of |footer_size| bytes, by which it is charged.
+    void insert_parquet(const std::string& path, int64_t length, int64_t modification_time, const ParquetMetaPtr& meta,
+                        size_t footer_size);
+
+    // Return the serialized tail of the orc file into |tail|, false if it is not in the cache.
+    bool lookup_orc_tail(const std::string& path, int64_t length, int64_t modification_time, std::string* tail);
+
+    void insert_orc_tail(const std::string& path, int64_t length, int64_t modification_time, const std::string& tail);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+    // The number of the lookups found or not found in the cache of the process.
+    static int64_t hit_count();
+    static int64_t miss_count();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(HdfsFileMetaCache);
+
+    struct Entry {
+        ParquetMetaPtr parquet_meta;
+        std::string orc_tail;
+    };
+
+    static std::string _encode_key(const std::string& path, int64_t length, int64_t modification_time);
+
+    // Return a copy of the entry of the file, false if it is not in the cache.
+    bool _lookup(const std::string& key, Entry* entry);
+    void _insert(const std::string& key, Entry entry, size_t charge);
+
+    static HdfsFileMetaCache* _s_instance;
+
+    MemTracker* _mem_tracker = nullptr;
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace vectorized
+} // namespace starrocks
@@ -4,6 +4,7 @@
 
 #include <memory>
 
+#include "env/block_cache.h"
 #include "env/env_hdfs.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
@@ -442,12 +443,33 @@ Status HdfsScanNode::close(RuntimeState* state) {
 
 Status HdfsScanNode::set_scan_ranges(const std::vector<TScanRangeParams>& scan_ranges) {
     for (const auto& scan_range : scan_ranges) {
-        _scan_ranges.emplace_back(scan_range.scan_range.hdfs_scan_range);
+        _split_scan_range(scan_range.scan_range.hdfs_scan_range);
     }
 
     return Status::OK();
 }
 
+void HdfsScanNode::_split_scan_range(const THdfsScanRange& scan_range) {
+    // A row group or stripe is read by the piece its start offset falls in, so the pieces of a range read each of
+    // its row groups or stripes once, and a range is split without reading the footer of the file here.
+    const int64_t split_size = config::hdfs_scan_split_size;
+    bool splittable = scan_range.file_format == THdfsFileFormat::PARQUET ||
+                      scan_range.file_format == THdfsFileFormat::ORC;
+    if (!splittable || split_size <= 0 || scan_range.length < 2 * split_size) {
+        _scan_ranges.emplace_back(scan_range);
+        return;
+    }
+
+    // the last piece takes the remainder, which is less than |split_size|
+    const int64_t num_pieces = scan_range.length / split_size;
+    const int64_t end = scan_range.offset + scan_range.length;
+    for (int64_t i = 0; i < num_pieces; i++) {
+        THdfsScanRange& piece = _scan_ranges.emplace_back(scan_range);
+        piece.__set_offset(scan_range.offset + i * split_size);
+        piece.__set_length(i + 1 < num_pieces ? split_size : end - piece.offset);
+    }
+}
+
 void HdfsScanNode::_init_partition_expr_map() {
     if (_scan_ranges.empty()) {
         return;
@@ -507,11 +529,15 @@ Status HdfsScanNode::_find_and_insert_hdfs_file(const THdfsScanRange& scan_range
     }
 
     // search file in hdfs file array
-    // if found, add file splits to hdfs file desc
+    // if found, add file splits to hdfs file desc, unless the splits are more than a split size, which are read by
+    // another scanner from another hdfs file desc of the file
     // if not found, create
+    const int64_t split_size = config::hdfs_scan_split_size;
     for (auto& item : _hdfs_files) {
-        if (item->partition_id == scan_range.partition_id && item->path == scan_range.relative_path) {
+        if (item->partition_id == scan_range.partition_id && item->path == scan_range.relative_path &&
+            (split_size <= 0 || item->splits_length + scan_range.length <= split_size)) {
             item->splits.emplace_back(&scan_range);
+            item->splits_length += scan_range.length;
             return Status::OK();
         }
     }
@@ -540,24 +566,40 @@ Status HdfsScanNode::_find_and_insert_hdfs_file(const THdfsScanRange& scan_range
         hdfs_file_desc->path = scan_range.relative_path;
         hdfs_file_desc->file_length = scan_range.file_length;
         hdfs_file_desc->splits.emplace_back(&scan_range);
+        hdfs_file_desc->splits_length = scan_range.length;
         hdfs_file_desc->hdfs_file_format = scan_range.file_format;
         _hdfs_files.emplace_back(hdfs_file_desc);
     } else {
         hdfsFS hdfs;
-        RETURN_IF_ERROR(HdfsFsCache::instance()->get_connection(namenode, &hdfs));
-        auto* file = hdfsOpenFile(hdfs, native_file_path.c_str(), O_RDONLY, 0, 0, 0);
-        if (file == nullptr) {
-            return Status::InternalError(strings::Substitute("open file failed, file=$0", native_file_path));
-        }
+        auto* fs_cache = HdfsFsCache::instance();
+        RETURN_IF_ERROR(fs_cache->get_connection(namenode, &hdfs));
 
         auto* hdfs_file_desc = _pool->add(new HdfsFileDesc());
-        hdfs_file_desc->hdfs_fs = hdfs;
-        hdfs_file_desc->hdfs_file = file;
-        hdfs_file_desc->fs = std::make_shared<HdfsRandomAccessFile>(hdfs, file, native_file_path);
+        if (fs_cache->file_handle_cache_enabled() && scan_range.__isset.modification_time) {
+            // the handle is closed by the cache
+            hdfs_file_desc->hdfs_fs = nullptr;
+            hdfs_file_desc->hdfs_file = nullptr;
+            RETURN_IF_ERROR(fs_cache->open_file(hdfs, native_file_path, scan_range.modification_time,
+                                                &hdfs_file_desc->fs));
+        } else {
+            auto* file = hdfsOpenFile(hdfs, native_file_path.c_str(), O_RDONLY, 0, 0, 0);
+            if (file == nullptr) {
+                return Status::InternalError(strings::Substitute("open file failed, file=$0", native_file_path));
+            }
+            hdfs_file_desc->hdfs_fs = hdfs;
+            hdfs_file_desc->hdfs_file = file;
+            hdfs_file_desc->fs = std::make_shared<HdfsRandomAccessFile>(hdfs, file, native_file_path);
+        }
+        // the files of unknown modification times are not cached, which could be rewritten
+        if (BlockCache::instance() != nullptr && scan_range.__isset.modification_time) {
+            hdfs_file_desc->fs = std::make_shared<BlockCachedRandomAccessFile>(
+                    BlockCache::instance(), hdfs_file_desc->fs, scan_range.file_length, scan_range.modification_time);
+        }
         hdfs_file_desc->partition_id = scan_range.partition_id;
         hdfs_file_desc->path = scan_range.relative_path;
         hdfs_file_desc->file_length = scan_range.file_length;
         hdfs_file_desc->splits.emplace_back(&scan_range);
+        hdfs_file_desc->splits_length = scan_range.length;
         hdfs_file_desc->hdfs_file_format = scan_range.file_format;
         _hdfs_files.emplace_back(hdfs_file_desc);
     }
@@ -599,6 +641,18 @@ void HdfsScanNode::_update_status(const Status& status) {
     }
 }
 
+Status HdfsScanNode::collect_query_statistics(QueryStatistics* statistics) {
+    RETURN_IF_ERROR(ExecNode::collect_query_statistics(statistics));
+    QueryStatisticsItemPB stats_item;
+    stats_item.set_scan_bytes(_bytes_read_from_disk_counter->value());
+    stats_item.set_scan_rows(_raw_rows_counter->value());
+    stats_item.set_table_id(_tuple_desc->table_desc()->table_id());
+    // The bytes read through the hdfs client, i.e. not found in the block cache.
+    stats_item.set_remote_bytes(_bytes_total_read->value());
+    statistics->add_stats_item(stats_item);
+    return Status::OK();
+}
+
 void HdfsScanNode::_init_counter(RuntimeState* state) {
     _scan_timer = ADD_TIMER(_runtime_profile, "ScanTime");
     _reader_init_timer = ADD_TIMER(_runtime_profile, "ReaderInit");
@@ -620,6 +674,8 @@ void HdfsScanNode::_init_counter(RuntimeState* state) {
     _bytes_read_short_circuit = ADD_COUNTER(_runtime_profile, "BytesReadShortCircuit", TUnit::BYTES);
     _bytes_read_dn_cache = ADD_COUNTER(_runtime_profile, "BytesReadDataNodeCache", TUnit::BYTES);
     _bytes_read_remote = ADD_COUNTER(_runtime_profile, "BytesReadRemote", TUnit::BYTES);
+    _bytes_read_from_block_cache = ADD_COUNTER(_runtime_profile, "BytesReadFromBlockCache", TUnit::BYTES);
+    _bytes_read_into_block_cache = ADD_COUNTER(_runtime_profile, "BytesReadIntoBlockCache", TUnit::BYTES);
 
     // reader init
     _footer_read_timer = ADD_TIMER(_runtime_profile, "ReaderInitFooterRead");
@@ -629,6 +685,9 @@ void HdfsScanNode::_init_counter(RuntimeState* state) {
     _group_chunk_read_timer = ADD_TIMER(_runtime_profile, "GroupChunkRead");
     _group_dict_filter_timer = ADD_TIMER(_runtime_profile, "GroupDictFilter");
     _group_dict_decode_timer = ADD_TIMER(_runtime_profile, "GroupDictDecode");
+
+    _runtime_filter_skipped_files = ADD_COUNTER(_runtime_profile, "RuntimeFilterSkippedFiles", TUnit::UNIT);
+    _runtime_filter_skipped_row_groups = ADD_COUNTER(_runtime_profile, "RuntimeFilterSkippedRowGroups", TUnit::UNIT);
 }
 
 } // namespace starrocks::vectorized
@@ -23,6 +23,8 @@ struct HdfsFileDesc {
     std::string path;
     int64_t file_length = 0;
     std::vector<const THdfsScanRange*> splits;
+    // the total length of |splits|
+    int64_t splits_length = 0;
 };
 
 class HdfsScanNode final : public starrocks::ScanNode {
@@ -37,6 +39,8 @@ public:
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
     Status close(RuntimeState* state) override;
 
+    Status collect_query_statistics(QueryStatistics* statistics) override;
+
     Status set_scan_ranges(const std::vector<TScanRangeParams>& scan_ranges) override;
 
 private:
@@ -80,6 +84,10 @@ private:
     Status _find_and_insert_hdfs_file(const THdfsScanRange& scan_range);
     Status _create_and_init_scanner(RuntimeState* state, const HdfsFileDesc& hdfs_file_desc);
 
+    // Add |scan_range| to |_scan_ranges|, split into the pieces of hdfs_scan_split_size bytes if it is a large range
+    // of a parquet or orc file, which are read by the scanners of their own in parallel.
+    void _split_scan_range(const THdfsScanRange& scan_range);
+
     bool _submit_scanner(HdfsScanner* scanner, bool blockable);
     void _scanner_thread(HdfsScanner* scanner);
     void _update_status(const Status& status);
@@ -171,6 +179,8 @@ private:
     RuntimeProfile::Counter* _bytes_read_short_circuit = nullptr;
     RuntimeProfile::Counter* _bytes_read_dn_cache = nullptr;
     RuntimeProfile::Counter* _bytes_read_remote = nullptr;
+    RuntimeProfile::Counter* _bytes_read_from_block_cache = nullptr;
+    RuntimeProfile::Counter* _bytes_read_into_block_cache = nullptr;
 
     // reader init
     RuntimeProfile::Counter* _footer_read_timer = nullptr;
@@ -180,5 +190,8 @@ private:
     RuntimeProfile::Counter* _group_chunk_read_timer = nullptr;
     RuntimeProfile::Counter* _group_dict_filter_timer = nullptr;
     RuntimeProfile::Counter* _group_dict_decode_timer = nullptr;
+
+    RuntimeProfile::Counter* _runtime_filter_skipped_files = nullptr;
+    RuntimeProfile::Counter* _runtime_filter_skipped_row_groups = nullptr;
 };
 } // namespace starrocks::vectorized
@@ -6,14 +6,17 @@
 
 #include <memory>
 
+#include "env/block_cache.h"
 #include "env/env_hdfs.h"
 #include "exec/exec_node.h"
 #include "exec/parquet/file_reader.h"
 #include "exec/vectorized/hdfs_scan_node.h"
 #include "exprs/expr.h"
+#include "exprs/vectorized/runtime_filter_bank.h"
 #include "runtime/runtime_state.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "util/runtime_profile.h"
+#include "util/starrocks_metrics.h"
 
 namespace starrocks::vectorized {
 
@@ -90,14 +93,21 @@ void HdfsScanner::_build_file_read_param() {
     param.scan_ranges = _scanner_params.scan_ranges;
     param.min_max_conjunct_ctxs = _min_max_conjunct_ctxs;
     param.min_max_tuple_desc = _scanner_params.min_max_tuple_desc;
+    param.runtime_filter_collector = _scanner_params.runtime_filter_collector;
     param.timezone = _runtime_state->timezone();
     param.stats = &_stats;
+    if (_scanner_params.scan_ranges[0]->__isset.modification_time) {
+        param.modification_time = _scanner_params.scan_ranges[0]->modification_time;
+    }
 }
 
 Status HdfsScanner::get_next(RuntimeState* runtime_state, ChunkPtr* chunk) {
 #ifndef BE_TEST
     SCOPED_TIMER(_scanner_params.parent->_scan_timer);
 #endif
+    if (_skipped_by_runtime_filters) {
+        return Status::EndOfFile("");
+    }
     Status status = do_get_next(runtime_state, chunk);
     if (status.ok()) {
         if (!_conjunct_ctxs.empty()) {
@@ -117,6 +127,15 @@ Status HdfsScanner::open(RuntimeState* runtime_state) {
         return Status::OK();
     }
     _build_file_read_param();
+    // The partition values are known before the file is opened, so are the runtime filters ready at the time.
+    if (_file_read_param.should_skip_by_evaluating_partition_runtime_filters()) {
+        _skipped_by_runtime_filters = true;
+        _is_open = true;
+#ifndef BE_TEST
+        COUNTER_UPDATE(_scanner_params.parent->_runtime_filter_skipped_files, 1);
+#endif
+        return Status::OK();
+    }
     auto status = do_open(runtime_state);
     if (status.ok()) {
         _is_open = true;
@@ -169,7 +188,14 @@ static void get_hdfs_statistics(hdfsFile file, HdfsReadStats* stats) {
 void HdfsScanner::update_counter() {
 #ifndef BE_TEST
     HdfsReadStats hdfs_stats;
-    auto hdfs_file = down_cast<HdfsRandomAccessFile*>(_scanner_params.fs.get())->hdfs_file();
+    const RandomAccessFile* file = _scanner_params.fs.get();
+    if (const auto* cached_file = dynamic_cast<const BlockCachedRandomAccessFile*>(file)) {
+        auto cache_stats = cached_file->take_stats();
+        COUNTER_UPDATE(_scanner_params.parent->_bytes_read_from_block_cache, cache_stats.bytes_read_from_cache);
+        COUNTER_UPDATE(_scanner_params.parent->_bytes_read_into_block_cache, cache_stats.bytes_read_into_cache);
+        file = cached_file->remote_file();
+    }
+    auto hdfs_file = down_cast<const HdfsRandomAccessFile*>(file)->hdfs_file();
     get_hdfs_statistics(hdfs_file, &hdfs_stats);
 
     COUNTER_UPDATE(_scanner_params.parent->_bytes_total_read, hdfs_stats.bytes_total_read);
@@ -177,6 +203,11 @@ void HdfsScanner::update_counter() {
     COUNTER_UPDATE(_scanner_params.parent->_bytes_read_short_circuit, hdfs_stats.bytes_read_short_circuit);
     COUNTER_UPDATE(_scanner_params.parent->_bytes_read_dn_cache, hdfs_stats.bytes_read_dn_cache);
     COUNTER_UPDATE(_scanner_params.parent->_bytes_read_remote, hdfs_stats.bytes_read_remote);
+    StarRocksMetrics::instance()->query_scan_remote_bytes.increment(hdfs_stats.bytes_total_read);
+
+    _stats.io_latency.update_profile(_scanner_params.parent->_runtime_profile, "IoTime");
+    COUNTER_UPDATE(_scanner_params.parent->_runtime_filter_skipped_row_groups,
+                   _stats.runtime_filter_skipped_row_groups);
 #endif
 }
 
@@ -293,6 +324,55 @@ void HdfsFileReaderParam::append_partition_column_to_chunk(vectorized::ChunkPtr*
     }
 }
 
+bool HdfsFileReaderParam::should_skip_by_evaluating_partition_runtime_filters() const {
+    if (runtime_filter_collector == nullptr || partition_columns.empty()) return false;
+
+    for (const auto& it : runtime_filter_collector->descriptors()) {
+        RuntimeFilterProbeDescriptor* rf_desc = it.second;
+        const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
+        SlotId slot_id;
+        if (filter == nullptr || !rf_desc->is_probe_slot_ref(&slot_id)) {
+            continue;
+        }
+        for (size_t i = 0; i < partition_columns.size(); i++) {
+            if (partition_columns[i].slot_id != slot_id) {
+                continue;
+            }
+            SlotDescriptor* slot_desc = partition_columns[i].slot_desc;
+            auto* const_column = vectorized::ColumnHelper::as_raw_column<vectorized::ConstColumn>(partition_values[i]);
+            ColumnPtr data_column = const_column->data_column();
+            ColumnPtr column = ColumnHelper::create_column(slot_desc->type(), slot_desc->is_nullable());
+            if (data_column->is_nullable()) {
+                column->append_nulls(1);
+            } else {
+                column->append(*data_column, 0, 1);
+            }
+            // The running context of the filter is shared by the scan node, so a local one is used by the scanners.
+            JoinRuntimeFilter::RunningContext ctx;
+            if (column->size() == 1 && filter->evaluate(column.get(), &ctx)[0] == 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool HdfsFileReaderParam::should_skip_by_runtime_filters(SlotId slot_id, const Column& min_column,
+                                                         const Column& max_column) const {
+    if (runtime_filter_collector == nullptr) return false;
+
+    for (const auto& it : runtime_filter_collector->descriptors()) {
+        RuntimeFilterProbeDescriptor* rf_desc = it.second;
+        const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
+        SlotId probe_slot_id;
+        if (filter != nullptr && rf_desc->is_probe_slot_ref(&probe_slot_id) && probe_slot_id == slot_id &&
+            !filter->test_range(min_column, max_column)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool HdfsFileReaderParam::can_use_dict_filter_on_slot(SlotDescriptor* slot) const {
     if (!slot->type().is_string_type()) {
         return false;
@@ -8,6 +8,7 @@
 #include "env/env.h"
 #include "exprs/expr_context.h"
 #include "runtime/descriptors.h"
+#include "util/io_latency_histogram.h"
 #include "util/runtime_profile.h"
 namespace starrocks::parquet {
 class FileReader;
@@ -23,6 +24,7 @@ struct HdfsScanStats {
     int64_t io_ns = 0;
     int64_t io_count = 0;
     int64_t bytes_read_from_disk = 0;
+    IOLatencyHistogram io_latency;
     int64_t column_read_ns = 0;
     int64_t level_decode_ns = 0;
     int64_t value_decode_ns = 0;
@@ -35,6 +37,8 @@ struct HdfsScanStats {
     int64_t group_chunk_read_ns = 0;
     int64_t group_dict_filter_ns = 0;
     int64_t group_dict_decode_ns = 0;
+    // the row groups skipped by the min/max values of the runtime filters
+    int64_t runtime_filter_skipped_row_groups = 0;
 };
 
 struct HdfsScannerParams {
@@ -109,8 +113,15 @@ struct HdfsFileReaderParam {
     // min max conjunct
     std::vector<ExprContext*> min_max_conjunct_ctxs;
 
+    // the runtime filters, by which the files of the partitions and the row groups are skipped before read, once
+    // they are ready.
+    RuntimeFilterProbeCollector* runtime_filter_collector = nullptr;
+
     std::string timezone;
 
+    // the modification time of the file, by which the footer of the file is cached, 0 if unknown and not cached
+    int64_t modification_time = 0;
+
     vectorized::HdfsScanStats* stats = nullptr;
 
     // set column names from file.
@@ -127,6 +138,12 @@ struct HdfsFileReaderParam {
     bool should_skip_by_evaluating_not_existed_slots();
     std::vector<SlotDescriptor*> not_existed_slots;
     std::vector<ExprContext*> conjunct_ctxs_of_non_existed_slots;
+    // if we can skip this file by evaluating the ready runtime filters on the partition columns with the partition
+    // values.
+    bool should_skip_by_evaluating_partition_runtime_filters() const;
+    // if the ready runtime filters on the slot |slot_id| reject all the values of [min, max], the single values of
+    // |min_column| and |max_column|, see JoinRuntimeFilter::test_range.
+    bool should_skip_by_runtime_filters(SlotId slot_id, const Column& min_column, const Column& max_column) const;
 
     // other helper functions.
     void append_partition_column_to_chunk(vectorized::ChunkPtr* chunk, size_t row_count);
@@ -157,6 +174,8 @@ private:
     bool _is_open = false;
     bool _is_closed = false;
     bool _keep_priority = false;
+    // whether the file is skipped by the runtime filters on the partition columns.
+    bool _skipped_by_runtime_filters = false;
     void _build_file_read_param();
 
 protected:
@@ -3,6 +3,7 @@
 #include "exec/vectorized/hdfs_scanner_orc.h"
 
 #include "env/env.h"
+#include "exec/vectorized/hdfs_file_meta_cache.h"
 #include "exec/vectorized/hdfs_scan_node.h"
 #include "gen_cpp/orc_proto.pb.h"
 #include "storage/vectorized/chunk_helper.h"
@@ -21,7 +22,7 @@ public:
     uint64_t getNaturalReadSize() const override { return 8 * 1024 * 1024; }
 
     void read(void* buf, uint64_t length, uint64_t offset) override {
-        SCOPED_RAW_TIMER(&_stats->io_ns);
+        ScopedIOTimer io_timer(&_stats->io_ns, &_stats->io_latency);
         _stats->io_count += 1;
         if (buf == nullptr) {
             throw orc::ParseError("Buffer is null");
@@ -52,6 +53,9 @@ public:
                               const std::map<uint32_t, orc::BloomFilterIndex>& bloomFilters) override;
     bool filterMinMax(size_t rowGroupIdx, const std::unordered_map<uint64_t, orc::proto::RowIndex>& rowIndexes,
                       const std::map<uint32_t, orc::BloomFilterIndex>& bloomFilter);
+    // filter the row group by the min/max values of the ready runtime filters on the materialized columns.
+    bool filterByRuntimeFilters(size_t rowGroupIdx,
+                                const std::unordered_map<uint64_t, orc::proto::RowIndex>& rowIndexes);
     bool filterOnPickStringDictionary(const std::unordered_map<uint64_t, orc::StringDictionary*>& sdicts);
 
     bool is_slot_evaluated(SlotId id) { return _dict_filter_eval_cache.find(id) != _dict_filter_eval_cache.end(); }
@@ -187,6 +191,37 @@ bool OrcRowReaderFilter::filterOnPickRowGroup(size_t rowGroupIdx,
             return true;
         }
     }
+    if (_reader_params.runtime_filter_collector != nullptr && filterByRuntimeFilters(rowGroupIdx, rowIndexes)) {
+        VLOG_FILE << "OrcRowReaderFilter: skip row group " << rowGroupIdx << " by runtime filters, stripe "
+                  << _current_stripe_index;
+        _reader_params.stats->runtime_filter_skipped_row_groups++;
+        return true;
+    }
+    return false;
+}
+
+bool OrcRowReaderFilter::filterByRuntimeFilters(size_t rowGroupIdx,
+                                                const std::unordered_map<uint64_t, orc::proto::RowIndex>& rowIndexes) {
+    for (const auto& col : _reader_params.materialized_columns) {
+        SlotDescriptor* slot = col.slot_desc;
+        if (slot->type().is_complex_type()) {
+            continue;
+        }
+        int32_t column_index = _adapter->get_column_id_by_name(slot->col_name());
+        auto row_idx_iter = column_index >= 0 ? rowIndexes.find(column_index) : rowIndexes.end();
+        if (row_idx_iter == rowIndexes.end()) {
+            continue;
+        }
+        const orc::proto::ColumnStatistics& stats = row_idx_iter->second.entry(rowGroupIdx).statistics();
+        ColumnPtr min_col = ColumnHelper::create_column(slot->type(), slot->is_nullable());
+        ColumnPtr max_col = ColumnHelper::create_column(slot->type(), slot->is_nullable());
+        if (!OrcScannerAdapter::decode_min_max_value(slot, stats, min_col, max_col).ok()) {
+            continue;
+        }
+        if (_reader_params.should_skip_by_runtime_filters(col.slot_id, *min_col, *max_col)) {
+            return true;
+        }
+    }
     return false;
 }
 
@@ -308,9 +343,23 @@ Status HdfsOrcScanner::do_open(RuntimeState* runtime_state) {
     auto input_stream = std::make_unique<ORCHdfsFileStream>(_scanner_params.fs,
                                                             _scanner_params.scan_ranges[0]->file_length, &_stats);
     std::unique_ptr<orc::Reader> reader;
+    // the files of unknown modification times are not cached, which could be rewritten in the same length
+    HdfsFileMetaCache* cache = _file_read_param.modification_time > 0 ? HdfsFileMetaCache::instance() : nullptr;
+    const std::string& file_name = _scanner_params.fs->file_name();
+    int64_t file_length = _scanner_params.scan_ranges[0]->file_length;
     try {
         orc::ReaderOptions options;
+        std::string file_tail;
+        bool cached = cache != nullptr &&
+                      cache->lookup_orc_tail(file_name, file_length, _file_read_param.modification_time, &file_tail);
+        if (cached) {
+            options.setSerializedFileTail(file_tail);
+        }
         reader = orc::createReader(std::move(input_stream), options);
+        if (cache != nullptr && !cached) {
+            cache->insert_orc_tail(file_name, file_length, _file_read_param.modification_time,
+                                   reader->getSerializedFileTail());
+        }
     } catch (std::exception& e) {
         auto s = strings::Substitute("HdfsOrcScanner::do_open failed. reason = $0", e.what());
         LOG(WARNING) << s;
@@ -353,6 +402,16 @@ Status HdfsOrcScanner::do_open(RuntimeState* runtime_state) {
         _orc_adapter->set_conjuncts_and_runtime_filters(conjuncts, _scanner_params.runtime_filter_collector);
     }
     _orc_adapter->set_hive_column_names(_scanner_params.hive_column_names);
+    if (config::orc_lazy_load_enable && !_file_read_param.conjunct_ctxs_by_slot.empty()) {
+        // the columns without conjuncts are read for the rows left by the conjuncts on the other columns.
+        std::unordered_set<SlotId> lazy_load_slot_ids;
+        for (const auto* slot : _src_slot_descriptors) {
+            if (!slot->type().is_complex_type() && _file_read_param.conjunct_ctxs_by_slot.count(slot->id()) == 0) {
+                lazy_load_slot_ids.insert(slot->id());
+            }
+        }
+        _orc_adapter->set_lazy_load_slot_ids(lazy_load_slot_ids);
+    }
     RETURN_IF_ERROR(_orc_adapter->init(std::move(reader)));
     return Status::OK();
 }
@@ -400,16 +459,29 @@ Status HdfsOrcScanner::do_get_next(RuntimeState* runtime_state, ChunkPtr* chunk)
     _file_read_param.append_partition_column_to_chunk(chunk, ck->num_rows());
     // do stats before we filter rows which does not match.
     _stats.raw_rows_read += ck->num_rows();
+    const bool lazy_load = _orc_adapter->has_lazy_load_columns();
     for (auto& it : _file_read_param.conjunct_ctxs_by_slot) {
         // do evaluation.
         SCOPED_RAW_TIMER(&_stats.expr_filter_ns);
         if (_orc_row_reader_filter->is_slot_evaluated(it.first)) {
             continue;
         }
-        ExecNode::eval_conjuncts(it.second, ck.get());
+        FilterPtr filter;
+        ExecNode::eval_conjuncts(it.second, ck.get(), lazy_load ? &filter : nullptr);
         if (ck->num_rows() == 0) {
-            return Status::OK();
+            if (!lazy_load) {
+                return Status::OK();
+            }
+            _orc_adapter->select_lazy_load_rows(nullptr);
+            break;
         }
+        if (lazy_load && filter != nullptr) {
+            _orc_adapter->select_lazy_load_rows(filter.get());
+        }
+    }
+    if (lazy_load) {
+        SCOPED_RAW_TIMER(&_stats.column_read_ns);
+        RETURN_IF_ERROR(_orc_adapter->lazy_load_chunk(chunk));
     }
     return Status::OK();
 }
@@ -8,6 +8,7 @@
 
 #include "exec/vectorized/hash_join_node.h"
 #include "simd/simd.h"
+#include "util/huge_page.h"
 
 namespace starrocks::vectorized {
 
@@ -149,7 +150,7 @@ Status SerializedJoinProbeFunc::lookup_init(const JoinHashTableItems& table_item
     for (const auto& data_column : data_columns) {
         serialize_size += data_column->serialize_size();
     }
-    uint8_t* ptr = table_items.probe_pool->allocate(serialize_size);
+    uint8_t* ptr = probe_state->probe_pool->allocate(serialize_size);
     if (UNLIKELY(ptr == nullptr)) {
         return Status::InternalError("Mem usage has exceed the limit of BE");
     }
@@ -174,9 +175,8 @@ void SerializedJoinProbeFunc::_probe_column(const JoinHashTableItems& table_item
         ptr += probe_state->probe_slice[i].size;
     }
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_bucket_heads<Slice>(table_items, SerializedJoinBuildFunc::get_key_data(table_items),
+                                                  probe_state, nullptr);
 }
 
 void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& table_items,
@@ -204,64 +204,84 @@ void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& t
         if (probe_state->is_nulls[i] == 0) {
             probe_state->buckets[i] =
                     JoinHashMapHelper::calc_bucket_num<Slice>(probe_state->probe_slice[i], table_items.bucket_size);
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
         } else {
-            probe_state->next[i] = 0;
+            probe_state->buckets[i] = 0;
         }
     }
-}
 
-JoinHashTable::~JoinHashTable() {
-    _table_items.mem_tracker->release(_table_items.last_memory_usage);
+    JoinHashMapHelper::lookup_bucket_heads<Slice>(table_items, SerializedJoinBuildFunc::get_key_data(table_items),
+                                                  probe_state, probe_state->is_nulls.data());
 }
 
 void JoinHashTable::close() {
-    _table_items.build_pool.reset();
-    _table_items.probe_pool.reset();
+    if (_table_items == nullptr) {
+        return;
+    }
+    if (!_is_readable_clone) {
+        _table_items->mem_tracker->release(_table_items->last_memory_usage);
+        _table_items->last_memory_usage = 0;
+        _table_items->build_pool.reset();
+    }
+    _table_items.reset();
+    _probe_state.reset();
 }
 
 void JoinHashTable::create(const HashTableParam& param) {
-    _table_items.row_count = 0;
-    _table_items.bucket_size = 0;
-    _table_items.build_chunk = std::make_shared<Chunk>();
-    _table_items.mem_tracker = param.mem_tracker;
-    _table_items.build_pool = std::make_unique<MemPool>(_table_items.mem_tracker);
-    _table_items.probe_pool = std::make_unique<MemPool>(_table_items.mem_tracker);
-    _table_items.with_other_conjunct = param.with_other_conjunct;
-    _table_items.join_type = param.join_type;
-    _table_items.row_desc = param.row_desc;
-    if (_table_items.join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items.join_type == TJoinOp::RIGHT_ANTI_JOIN ||
-        _table_items.join_type == TJoinOp::RIGHT_OUTER_JOIN) {
-        _table_items.left_to_nullable = true;
-    } else if (_table_items.join_type == TJoinOp::LEFT_SEMI_JOIN || _table_items.join_type == TJoinOp::LEFT_ANTI_JOIN ||
-               _table_items.join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN ||
-               _table_items.join_type == TJoinOp::LEFT_OUTER_JOIN) {
-        _table_items.right_to_nullable = true;
-    } else if (_table_items.join_type == TJoinOp::FULL_OUTER_JOIN) {
-        _table_items.left_to_nullable = true;
-        _table_items.right_to_nullable = true;
-    }
-    _table_items.search_ht_timer = param.search_ht_timer;
-    _table_items.output_build_column_timer = param.output_build_column_timer;
-    _table_items.output_probe_column_timer = param.output_probe_column_timer;
-    _table_items.output_tuple_column_timer = param.output_tuple_column_timer;
-    _table_items.join_keys = param.join_keys;
+    _table_items = std::make_shared<JoinHashTableItems>();
+    _probe_state = std::make_unique<HashTableProbeState>();
+    _table_items->row_count = 0;
+    _table_items->bucket_size = 0;
+    _table_items->build_chunk = std::make_shared<Chunk>();
+    _table_items->mem_tracker = param.mem_tracker;
+    _table_items->build_pool = std::make_unique<MemPool>(_table_items->mem_tracker);
+    _probe_state->probe_pool = std::make_unique<MemPool>(_table_items->mem_tracker);
+    _table_items->with_other_conjunct = param.with_other_conjunct;
+    _table_items->join_type = param.join_type;
+    _table_items->build_keys_only =
+            !param.with_other_conjunct && !param.build_key_slot_ids.empty() &&
+            (param.join_type == TJoinOp::LEFT_SEMI_JOIN || param.join_type == TJoinOp::LEFT_ANTI_JOIN ||
+             param.join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN);
+    _table_items->row_desc = param.row_desc;
+    if (_table_items->join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items->join_type == TJoinOp::RIGHT_ANTI_JOIN ||
+        _table_items->join_type == TJoinOp::RIGHT_OUTER_JOIN) {
+        _table_items->left_to_nullable = true;
+    } else if (_table_items->join_type == TJoinOp::LEFT_SEMI_JOIN ||
+               _table_items->join_type == TJoinOp::LEFT_ANTI_JOIN ||
+               _table_items->join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN ||
+               _table_items->join_type == TJoinOp::LEFT_OUTER_JOIN) {
+        _table_items->right_to_nullable = true;
+    } else if (_table_items->join_type == TJoinOp::FULL_OUTER_JOIN) {
+        _table_items->left_to_nullable = true;
+        _table_items->right_to_nullable = true;
+    }
+    _table_items->search_ht_timer = param.search_ht_timer;
+    _table_items->output_build_column_timer = param.output_build_column_timer;
+    _table_items->output_probe_column_timer = param.output_probe_column_timer;
+    _table_items->output_tuple_column_timer = param.output_tuple_column_timer;
+    _table_items->join_keys = param.join_keys;
 
     const auto& probe_desc = *param.probe_row_desc;
     for (const auto& tuple_desc : probe_desc.tuple_descriptors()) {
         for (const auto& slot : tuple_desc->slots()) {
-            _table_items.probe_slots.emplace_back(slot);
-            _table_items.probe_column_count++;
+            _table_items->probe_slots.emplace_back(slot);
+            _table_items->probe_column_count++;
         }
-        if (_table_items.row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
-            _table_items.output_probe_tuple_ids.emplace_back(tuple_desc->id());
+        if (_table_items->row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+            _table_items->output_probe_tuple_ids.emplace_back(tuple_desc->id());
         }
     }
 
     const auto& build_desc = *param.build_row_desc;
     for (const auto& tuple_desc : build_desc.tuple_descriptors()) {
         for (const auto& slot : tuple_desc->slots()) {
-            _table_items.build_slots.emplace_back(slot);
+            _table_items->build_slots.emplace_back(slot);
+            _table_items->build_column_count++;
+            if (_table_items->build_keys_only &&
+                std::find(param.build_key_slot_ids.begin(), param.build_key_slot_ids.end(), slot->id()) ==
+                        param.build_key_slot_ids.end()) {
+                continue;
+            }
+            _table_items->build_chunk_slots.emplace_back(slot);
             ColumnPtr column = ColumnHelper::create_column(slot->type(), slot->is_nullable());
             if (slot->is_nullable()) {
                 auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(column);
@@ -269,39 +289,41 @@ void JoinHashTable::create(const HashTableParam& param) {
             } else {
                 column->append_default();
             }
-            _table_items.build_chunk->append_column(std::move(column), slot->id());
-            _table_items.build_column_count++;
+            _table_items->build_chunk->append_column(std::move(column), slot->id());
         }
-        if (_table_items.row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
-            _table_items.output_build_tuple_ids.emplace_back(tuple_desc->id());
+        if (_table_items->row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+            _table_items->output_build_tuple_ids.emplace_back(tuple_desc->id());
         }
     }
 }
 
 Status JoinHashTable::build(RuntimeState* state) {
     _hash_map_type = _choose_join_hash_map();
-    _table_items.bucket_size = JoinHashMapHelper::calc_bucket_size(_table_items.row_count + 1);
-    _table_items.first.resize(_table_items.bucket_size, 0);
-    _table_items.next.resize(_table_items.row_count + 1, 0);
-    if (_table_items.join_type == TJoinOp::RIGHT_OUTER_JOIN || _table_items.join_type == TJoinOp::FULL_OUTER_JOIN ||
-        _table_items.join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items.join_type == TJoinOp::RIGHT_ANTI_JOIN) {
-        _probe_state.build_match_index.resize(_table_items.row_count + 1, 0);
-        _probe_state.build_match_index[0] = 1;
-    }
-
-    JoinHashMapHelper::prepare_map_index(&_probe_state);
+    // the bucket size of the direct mapping is the range of the build keys, set by _choose_join_hash_map.
+    if (_hash_map_type != JoinHashMapType::direct_key32 && _hash_map_type != JoinHashMapType::direct_key64) {
+        _table_items->bucket_size = JoinHashMapHelper::calc_bucket_size(_table_items->row_count + 1);
+    }
+    // The buckets are probed at random, so they are allocated and advised to be backed by the huge pages before
+    // being filled.
+    _table_items->first.reserve(_table_items->bucket_size);
+    madvise_huge_pages(_table_items->first.data(), _table_items->first.capacity() * sizeof(uint32_t));
+    _table_items->first.resize(_table_items->bucket_size, 0);
+    _table_items->next.reserve(_table_items->row_count + 1);
+    madvise_huge_pages(_table_items->next.data(), _table_items->next.capacity() * sizeof(uint32_t));
+    _table_items->next.resize(_table_items->row_count + 1, 0);
+    _init_probe_state();
 
     // size of hashtable index
     RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(
-            state, &_table_items, (_table_items.first.size() + _table_items.row_count + 1) * sizeof(uint32_t)));
+            state, _table_items.get(), (_table_items->first.size() + _table_items->row_count + 1) * sizeof(uint32_t)));
 
+    RETURN_IF_ERROR(_create_join_hash_map());
     switch (_hash_map_type) {
     case JoinHashMapType::empty:
         break;
-#define M(NAME)                                                                                             \
-    case JoinHashMapType::NAME:                                                                             \
-        _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(&_table_items, &_probe_state); \
-        RETURN_IF_ERROR(_##NAME->build(state));                                                             \
+#define M(NAME)                                  \
+    case JoinHashMapType::NAME:                  \
+        RETURN_IF_ERROR(_##NAME->build(state)); \
         break;
         APPLY_FOR_JOIN_VARIANTS(M)
 #undef M
@@ -312,6 +334,50 @@ Status JoinHashTable::build(RuntimeState* state) {
     return Status::OK();
 }
 
+JoinHashTable JoinHashTable::clone_readable_table() const {
+    DCHECK(!_is_readable_clone);
+    JoinHashTable ht;
+    ht._hash_map_type = _hash_map_type;
+    ht._table_items = _table_items;
+    ht._is_readable_clone = true;
+    ht._probe_state = std::make_unique<HashTableProbeState>();
+    ht._probe_state->probe_pool = std::make_unique<MemPool>(_table_items->mem_tracker);
+    ht._init_probe_state();
+    // the join hash map only keeps the pointers of the table items and the probe state.
+    Status st = ht._create_join_hash_map();
+    DCHECK(st.ok());
+    return ht;
+}
+
+void JoinHashTable::_init_probe_state() {
+    if (_table_items->join_type == TJoinOp::RIGHT_OUTER_JOIN || _table_items->join_type == TJoinOp::FULL_OUTER_JOIN ||
+        _table_items->join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items->join_type == TJoinOp::RIGHT_ANTI_JOIN) {
+        _probe_state->build_match_index.resize(_table_items->row_count + 1, 0);
+        _probe_state->build_match_index[0] = 1;
+    }
+
+    JoinHashMapHelper::prepare_map_index(_probe_state.get());
+    // they're resized by the build funcs for building, and reused when probing.
+    _probe_state->buckets.resize(config::vector_chunk_size);
+    _probe_state->is_nulls.resize(config::vector_chunk_size);
+}
+
+Status JoinHashTable::_create_join_hash_map() {
+    switch (_hash_map_type) {
+    case JoinHashMapType::empty:
+        break;
+#define M(NAME)                                                                                                       \
+    case JoinHashMapType::NAME:                                                                                       \
+        _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(_table_items.get(), _probe_state.get()); \
+        break;
+        APPLY_FOR_JOIN_VARIANTS(M)
+#undef M
+    default:
+        return Status::InternalError("not supported");
+    }
+    return Status::OK();
+}
+
 Status JoinHashTable::probe(const Columns& key_columns, ChunkPtr* probe_chunk, ChunkPtr* chunk, bool* eos) {
     switch (_hash_map_type) {
     case JoinHashMapType::empty:
@@ -345,11 +411,11 @@ Status JoinHashTable::probe_remain(ChunkPtr* chunk, bool* eos) {
 }
 
 Status JoinHashTable::append_chunk(RuntimeState* state, const ChunkPtr& chunk) {
-    Columns& columns = _table_items.build_chunk->columns();
+    Columns& columns = _table_items->build_chunk->columns();
     size_t chunk_memory_size = 0;
 
-    for (size_t i = 0; i < _table_items.build_column_count; i++) {
-        SlotDescriptor* slot = _table_items.build_slots[i];
+    for (size_t i = 0; i < _table_items->build_chunk_slots.size(); i++) {
+        SlotDescriptor* slot = _table_items->build_chunk_slots[i];
         ColumnPtr& column = chunk->get_column_by_slot_id(slot->id());
         chunk_memory_size += column->memory_usage();
 
@@ -364,32 +430,33 @@ Status JoinHashTable::append_chunk(RuntimeState* state, const ChunkPtr& chunk) {
         }
     }
 
+    // the build tuple columns are only output by the joins which output the build rows.
     const auto& tuple_id_map = chunk->get_tuple_id_to_index_map();
-    for (auto iter = tuple_id_map.begin(); iter != tuple_id_map.end(); iter++) {
-        if (_table_items.row_desc->get_tuple_idx(iter->first) != RowDescriptor::INVALID_IDX) {
-            if (_table_items.build_chunk->is_tuple_exist(iter->first)) {
+    for (auto iter = tuple_id_map.begin(); iter != tuple_id_map.end() && !_table_items->build_keys_only; iter++) {
+        if (_table_items->row_desc->get_tuple_idx(iter->first) != RowDescriptor::INVALID_IDX) {
+            if (_table_items->build_chunk->is_tuple_exist(iter->first)) {
                 ColumnPtr& src_column = chunk->get_tuple_column_by_id(iter->first);
-                ColumnPtr& dest_column = _table_items.build_chunk->get_tuple_column_by_id(iter->first);
+                ColumnPtr& dest_column = _table_items->build_chunk->get_tuple_column_by_id(iter->first);
                 dest_column->append(*src_column, 0, src_column->size());
                 chunk_memory_size += src_column->memory_usage();
             } else {
                 ColumnPtr& src_column = chunk->get_tuple_column_by_id(iter->first);
-                ColumnPtr dest_column = BooleanColumn::create(_table_items.row_count + 1, 1);
+                ColumnPtr dest_column = BooleanColumn::create(_table_items->row_count + 1, 1);
                 dest_column->append(*src_column, 0, src_column->size());
-                _table_items.build_chunk->append_tuple_column(dest_column, iter->first);
+                _table_items->build_chunk->append_tuple_column(dest_column, iter->first);
                 chunk_memory_size += src_column->memory_usage();
             }
         }
     }
 
-    RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(state, &_table_items, chunk_memory_size));
+    RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(state, _table_items.get(), chunk_memory_size));
 
-    _table_items.row_count += chunk->num_rows();
+    _table_items->row_count += chunk->num_rows();
     return Status::OK();
 }
 
 void JoinHashTable::remove_duplicate_index(Column::Filter* filter) {
-    switch (_table_items.join_type) {
+    switch (_table_items->join_type) {
     case TJoinOp::LEFT_OUTER_JOIN:
         _remove_duplicate_index_for_left_outer_join(filter);
         break;
@@ -418,17 +485,17 @@ void JoinHashTable::remove_duplicate_index(Column::Filter* filter) {
 }
 
 JoinHashMapType JoinHashTable::_choose_join_hash_map() {
-    size_t size = _table_items.join_keys.size();
+    size_t size = _table_items->join_keys.size();
     DCHECK_GT(size, 0);
 
-    for (size_t i = 0; i < _table_items.join_keys.size(); i++) {
-        if (!_table_items.key_columns[i]->has_null()) {
-            _table_items.join_keys[i].is_null_safe_equal = false;
+    for (size_t i = 0; i < _table_items->join_keys.size(); i++) {
+        if (!_table_items->key_columns[i]->has_null()) {
+            _table_items->join_keys[i].is_null_safe_equal = false;
         }
     }
 
-    if (size == 1 && !_table_items.join_keys[0].is_null_safe_equal) {
-        switch (_table_items.join_keys[0].type) {
+    if (size == 1 && !_table_items->join_keys[0].is_null_safe_equal) {
+        switch (_table_items->join_keys[0].type) {
         case PrimitiveType::TYPE_BOOLEAN:
             return JoinHashMapType::keyboolean;
         case PrimitiveType::TYPE_TINYINT:
@@ -436,9 +503,15 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
         case PrimitiveType::TYPE_SMALLINT:
             return JoinHashMapType::key16;
         case PrimitiveType::TYPE_INT:
-            return JoinHashMapType::key32;
+            if (_need_direct_mapping<TYPE_INT>()) {
+                return JoinHashMapType::direct_key32;
+            }
+            return _need_radix_partition(sizeof(int32_t)) ? JoinHashMapType::radix_key32 : JoinHashMapType::key32;
         case PrimitiveType::TYPE_BIGINT:
-            return JoinHashMapType::key64;
+            if (_need_direct_mapping<TYPE_BIGINT>()) {
+                return JoinHashMapType::direct_key64;
+            }
+            return _need_radix_partition(sizeof(int64_t)) ? JoinHashMapType::radix_key64 : JoinHashMapType::key64;
         case PrimitiveType::TYPE_LARGEINT:
             return JoinHashMapType::key128;
         case PrimitiveType::TYPE_FLOAT:
@@ -469,7 +542,7 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
 
     size_t total_size_in_byte = 0;
 
-    for (auto& join_key : _table_items.join_keys) {
+    for (auto& join_key : _table_items->join_keys) {
         if (join_key.is_null_safe_equal) {
             total_size_in_byte += 1;
         }
@@ -494,6 +567,59 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
     return JoinHashMapType::slice;
 }
 
+bool JoinHashTable::_need_radix_partition(size_t key_size) const {
+    if (config::join_radix_partition_min_bytes <= 0) {
+        return false;
+    }
+    // the bucket heads, the chains and the keys.
+    size_t table_bytes = (sizeof(uint32_t) * 2 + key_size) * (_table_items->row_count + 1);
+    return static_cast<int64_t>(table_bytes) >= config::join_radix_partition_min_bytes;
+}
+
+template <PrimitiveType PT>
+bool JoinHashTable::_need_direct_mapping() {
+    using CppType = typename RunTimeTypeTraits<PT>::CppType;
+    if (config::join_direct_mapping_max_range_ratio <= 0 || _table_items->row_count == 0) {
+        return false;
+    }
+
+    // The first row of the build chunk isn't a build row.
+    const auto& data = JoinBuildFunc<PT>::get_key_data(*_table_items);
+    const uint8_t* null_data = nullptr;
+    if (_table_items->key_columns[0]->is_nullable()) {
+        null_data = ColumnHelper::as_raw_column<NullableColumn>(_table_items->key_columns[0])
+                            ->null_column()
+                            ->get_data()
+                            .data();
+    }
+    CppType min_key = std::numeric_limits<CppType>::max();
+    CppType max_key = std::numeric_limits<CppType>::lowest();
+    bool has_key = false;
+    for (size_t i = 1; i < _table_items->row_count + 1; i++) {
+        if (null_data != nullptr && null_data[i] != 0) {
+            continue;
+        }
+        min_key = std::min(min_key, data[i]);
+        max_key = std::max(max_key, data[i]);
+        has_key = true;
+    }
+    if (!has_key) {
+        return false;
+    }
+
+    // The buckets are at most join_direct_mapping_max_range_ratio times the build rows.
+    uint64_t max_range = std::min<uint64_t>(
+            static_cast<uint64_t>(_table_items->row_count + 1) * config::join_direct_mapping_max_range_ratio,
+            UINT32_MAX);
+    uint64_t last_offset = DirectMappingJoinBuildFunc<PT>::calc_offset(max_key, min_key);
+    if (last_offset >= max_range) {
+        return false;
+    }
+    _table_items->direct_mapping_min = min_key;
+    _table_items->bucket_size = last_offset + 1;
+    return true;
+}
+
 size_t JoinHashTable::_get_size_of_fixed_and_contiguous_type(PrimitiveType data_type) {
     switch (data_type) {
     case PrimitiveType::TYPE_BOOLEAN:
@@ -525,12 +651,12 @@ void JoinHashTable::_remove_duplicate_index_for_left_outer_join(Column::Filter*
     size_t row_count = filter->size();
 
     for (size_t i = 0; i < row_count; i++) {
-        if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 0) {
+        if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 0) {
             (*filter)[i] = 1;
             continue;
         }
 
-        if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 1) {
+        if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 1) {
             if ((*filter)[i] == 0) {
                 (*filter)[i] = 1;
             }
@@ -538,7 +664,7 @@ void JoinHashTable::_remove_duplicate_index_for_left_outer_join(Column::Filter*
         }
 
         if ((*filter)[i] == 0) {
-            _probe_state.probe_match_index[_probe_state.probe_index[i]]--;
+            _probe_state->probe_match_index[_probe_state->probe_index[i]]--;
         }
     }
 }
@@ -547,8 +673,8 @@ void JoinHashTable::_remove_duplicate_index_for_left_semi_join(Column::Filter* f
     size_t row_count = filter->size();
     for (size_t i = 0; i < row_count; i++) {
         if ((*filter)[i] == 1) {
-            if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 0) {
-                _probe_state.probe_match_index[_probe_state.probe_index[i]] = 1;
+            if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 0) {
+                _probe_state->probe_match_index[_probe_state->probe_index[i]] = 1;
             } else {
                 (*filter)[i] = 0;
             }
@@ -559,13 +685,13 @@ void JoinHashTable::_remove_duplicate_index_for_left_semi_join(Column::Filter* f
 void JoinHashTable::_remove_duplicate_index_for_left_anti_join(Column::Filter* filter) {
     size_t row_count = filter->size();
     for (size_t i = 0; i < row_count; i++) {
-        if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 0) {
+        if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 0) {
             (*filter)[i] = 1;
-        } else if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 1) {
-            _probe_state.probe_match_index[_probe_state.probe_index[i]]--;
+        } else if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 1) {
+            _probe_state->probe_match_index[_probe_state->probe_index[i]]--;
             (*filter)[i] = !(*filter)[i];
         } else if ((*filter)[i] == 0) {
-            _probe_state.probe_match_index[_probe_state.probe_index[i]]--;
+            _probe_state->probe_match_index[_probe_state->probe_index[i]]--;
         } else {
             (*filter)[i] = 0;
         }
@@ -576,7 +702,7 @@ void JoinHashTable::_remove_duplicate_index_for_right_outer_join(Column::Filter*
     size_t row_count = filter->size();
     for (size_t i = 0; i < row_count; i++) {
         if ((*filter)[i] == 1) {
-            _probe_state.build_match_index[_probe_state.build_index[i]] = 1;
+            _probe_state->build_match_index[_probe_state->build_index[i]] = 1;
         }
     }
 }
@@ -585,8 +711,8 @@ void JoinHashTable::_remove_duplicate_index_for_right_semi_join(Column::Filter*
     size_t row_count = filter->size();
     for (size_t i = 0; i < row_count; i++) {
         if ((*filter)[i] == 1) {
-            if (_probe_state.build_match_index[_probe_state.build_index[i]] == 0) {
-                _probe_state.build_match_index[_probe_state.build_index[i]] = 1;
+            if (_probe_state->build_match_index[_probe_state->build_index[i]] == 0) {
+                _probe_state->build_match_index[_probe_state->build_index[i]] = 1;
             } else {
                 (*filter)[i] = 0;
             }
@@ -598,7 +724,7 @@ void JoinHashTable::_remove_duplicate_index_for_right_anti_join(Column::Filter*
     size_t row_count = filter->size();
     for (size_t i = 0; i < row_count; i++) {
         if ((*filter)[i] == 1) {
-            _probe_state.build_match_index[_probe_state.build_index[i]] = 1;
+            _probe_state->build_match_index[_probe_state->build_index[i]] = 1;
         }
     }
 }
@@ -606,24 +732,24 @@ void JoinHashTable::_remove_duplicate_index_for_right_anti_join(Column::Filter*
 void JoinHashTable::_remove_duplicate_index_for_full_outer_join(Column::Filter* filter) {
     size_t row_count = filter->size();
     for (size_t i = 0; i < row_count; i++) {
-        if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 0) {
+        if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 0) {
             (*filter)[i] = 1;
             continue;
         }
 
-        if (_probe_state.probe_match_index[_probe_state.probe_index[i]] == 1) {
+        if (_probe_state->probe_match_index[_probe_state->probe_index[i]] == 1) {
             if ((*filter)[i] == 0) {
                 (*filter)[i] = 1;
             } else {
-                _probe_state.build_match_index[_probe_state.build_index[i]] = 1;
+                _probe_state->build_match_index[_probe_state->build_index[i]] = 1;
             }
             continue;
         }
 
         if ((*filter)[i] == 0) {
-            _probe_state.probe_match_index[_probe_state.probe_index[i]]--;
+            _probe_state->probe_match_index[_probe_state->probe_index[i]]--;
         } else {
-            _probe_state.build_match_index[_probe_state.build_index[i]] = 1;
+            _probe_state->build_match_index[_probe_state->build_index[i]] = 1;
         }
     }
 }
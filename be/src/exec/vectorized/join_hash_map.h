@@ -33,7 +33,11 @@ namespace starrocks::vectorized {
     M(slice)                       \
     M(fixed32)                     \
     M(fixed64)                     \
-    M(fixed128)
+    M(fixed128)                    \
+    M(radix_key32)                 \
+    M(radix_key64)                 \
+    M(direct_key32)                \
+    M(direct_key64)
 
 enum class JoinHashMapType {
     empty,
@@ -55,7 +59,11 @@ enum class JoinHashMapType {
     slice,
     fixed32, // 4 bytes
     fixed64, // 8 bytes
-    fixed128 // 16 bytes
+    fixed128, // 16 bytes
+    radix_key32,
+    radix_key64,
+    direct_key32,
+    direct_key64
 };
 
 enum class JoinMatchFlag { NORMAL, ALL_NOT_MATCH, ALL_MATCH_ONE, MOST_MATCH_ONE };
@@ -70,6 +78,8 @@ struct JoinHashTableItems {
     ChunkPtr build_chunk = nullptr;
     Columns key_columns;
     Buffer<SlotDescriptor*> build_slots;
+    // the slots of the columns in build_chunk, which are build_slots unless build_keys_only.
+    Buffer<SlotDescriptor*> build_chunk_slots;
     Buffer<SlotDescriptor*> probe_slots;
     Buffer<TupleId> output_build_tuple_ids;
     Buffer<TupleId> output_probe_tuple_ids;
@@ -87,9 +97,20 @@ struct JoinHashTableItems {
     ColumnPtr build_key_column;
     uint32_t bucket_size = 0;
     uint32_t row_count = 0; // real row count
+    // The buckets are radix partitioned by the high radix_bits bits of the bucket numbers when the
+    // build rows are clustered by RadixJoinBuildFunc, i.e. the partition of bucket b is b >> radix_shift.
+    uint32_t radix_bits = 0;
+    uint32_t radix_shift = 0;
+    // The bucket of key k is k - direct_mapping_min when the build keys are mapped to the buckets
+    // directly by DirectMappingJoinBuildFunc, and bucket_size is the range of the build keys then.
+    int64_t direct_mapping_min = 0;
     size_t build_column_count = 0;
     size_t probe_column_count = 0;
     bool with_other_conjunct = false;
+    // A left semi/anti join without other conjuncts only tests whether the probe keys exist, so the
+    // build chunk only keeps the columns referenced by the build keys, and the duplicated build keys
+    // are removed from the chains, see JoinHashMap::_remove_duplicate_build_keys.
+    bool build_keys_only = false;
     bool left_to_nullable = false;
     bool right_to_nullable = false;
 
@@ -97,7 +118,6 @@ struct JoinHashTableItems {
 
     MemTracker* mem_tracker = nullptr;
     std::unique_ptr<MemPool> build_pool = nullptr;
-    std::unique_ptr<MemPool> probe_pool = nullptr;
     uint64_t last_memory_usage = 0;
     std::vector<JoinKeyDesc> join_keys;
 
@@ -115,6 +135,10 @@ struct HashTableProbeState {
     Buffer<uint32_t> probe_index;
     Buffer<uint32_t> next;
     Buffer<Slice> probe_slice;
+    // the radix partition offsets and the partition ordered rows of the current probe chunk,
+    // used by RadixJoinProbeFunc.
+    Buffer<uint32_t> radix_offsets;
+    Buffer<uint32_t> radix_order;
     Buffer<uint8_t>* null_array = nullptr;
     ColumnPtr probe_key_column;
     const Columns* key_columns = nullptr;
@@ -143,6 +167,9 @@ struct HashTableProbeState {
     // cur_probe_index records the position of the last probe
     uint32_t cur_probe_index = 0;
     uint32_t cur_row_match_count = 0;
+
+    // holds the serialized probe keys of the current probe chunk
+    std::unique_ptr<MemPool> probe_pool = nullptr;
 };
 
 struct HashTableParam {
@@ -153,6 +180,8 @@ struct HashTableParam {
     const RowDescriptor* build_row_desc = nullptr;
     const RowDescriptor* probe_row_desc = nullptr;
     std::vector<JoinKeyDesc> join_keys;
+    // the slots referenced by the build key exprs.
+    std::vector<SlotId> build_key_slot_ids;
 
     RuntimeProfile::Counter* search_ht_timer = nullptr;
     RuntimeProfile::Counter* output_build_column_timer = nullptr;
@@ -222,6 +251,43 @@ public:
         }
     }
 
+    // Look up the bucket heads of all the probe rows whose buckets are computed. The bucket of the row
+    // PREFETCH_DISTANCE rows ahead is prefetched, so that the cache misses of the random accesses of
+    // "first" overlap rather than stall one by one. For a hash table too large for the cache, the
+    // build keys of the bucket heads are prefetched too, before the probe loops walk the chains.
+    // The rows whose |is_nulls| is set (if it isn't nullptr) don't match any build row.
+    static constexpr uint32_t PREFETCH_DISTANCE = 16;
+
+    template <typename CppType>
+    static void lookup_bucket_heads(const JoinHashTableItems& table_items, const Buffer<CppType>& build_data,
+                                    HashTableProbeState* probe_state, const uint8_t* is_nulls) {
+        const uint32_t* first = table_items.first.data();
+        const uint32_t* buckets = probe_state->buckets.data();
+        uint32_t* next = probe_state->next.data();
+        uint32_t row_count = probe_state->probe_row_count;
+
+        uint32_t prefetch_end = row_count > PREFETCH_DISTANCE ? row_count - PREFETCH_DISTANCE : 0;
+        uint32_t i = 0;
+        for (; i < prefetch_end; i++) {
+            __builtin_prefetch(first + buckets[i + PREFETCH_DISTANCE]);
+            next[i] = first[buckets[i]];
+        }
+        for (; i < row_count; i++) {
+            next[i] = first[buckets[i]];
+        }
+        if (is_nulls != nullptr) {
+            for (i = 0; i < row_count; i++) {
+                next[i] = is_nulls[i] == 0 ? next[i] : 0;
+            }
+        }
+
+        if (static_cast<int64_t>(table_items.row_count) >= config::join_probe_prefetch_min_rows) {
+            for (i = 0; i < row_count; i++) {
+                __builtin_prefetch(&build_data[next[i]]);
+            }
+        }
+    }
+
     static void prepare_map_index(HashTableProbeState* probe_state) {
         probe_state->build_index.resize(config::vector_chunk_size + 8);
         probe_state->probe_index.resize(config::vector_chunk_size + 8);
@@ -302,6 +368,58 @@ private:
                                         uint32_t count);
 };
 
+// RadixJoinBuildFunc clusters the build rows by their bucket numbers before linking them, so that the
+// hash table is radix partitioned by the high bits of the bucket numbers: the bucket heads, the chains
+// and the keys of one partition are contiguous, and the rows of one bucket are adjacent. It's used
+// instead of JoinBuildFunc when the hash table doesn't fit in the CPU cache.
+template <PrimitiveType PT>
+class RadixJoinBuildFunc {
+public:
+    using CppType = typename RunTimeTypeTraits<PT>::CppType;
+    using ColumnType = typename RunTimeTypeTraits<PT>::ColumnType;
+
+    // The max number of the radix partitions is 1 << MAX_RADIX_BITS.
+    static constexpr uint32_t MAX_RADIX_BITS = 10;
+
+    static Status prepare(RuntimeState* state, JoinHashTableItems* table_items, HashTableProbeState* probe_state);
+
+    static const Buffer<CppType>& get_key_data(const JoinHashTableItems& table_items) {
+        return JoinBuildFunc<PT>::get_key_data(table_items);
+    }
+    static Status construct_hash_table(JoinHashTableItems* table_items, HashTableProbeState* probe_state);
+
+private:
+    // Reorder the rows of the build chunk and the key columns, the |new_row|-th row is the
+    // |indexes[new_row]|-th row before.
+    static void _reorder_build_rows(JoinHashTableItems* table_items, const Buffer<uint32_t>& indexes);
+};
+
+// DirectMappingJoinBuildFunc maps the build keys of an integer type with a small range to the buckets
+// directly, i.e. the bucket of key k is k - direct_mapping_min, so it needs no hash and the buckets of
+// different keys never collide. The rows of one key are still chained by "next".
+template <PrimitiveType PT>
+class DirectMappingJoinBuildFunc {
+public:
+    using CppType = typename RunTimeTypeTraits<PT>::CppType;
+    using ColumnType = typename RunTimeTypeTraits<PT>::ColumnType;
+
+    static Status prepare([[maybe_unused]] RuntimeState* runtime, [[maybe_unused]] JoinHashTableItems* table_items,
+                          [[maybe_unused]] HashTableProbeState* probe_state) {
+        return Status::OK();
+    }
+
+    static const Buffer<CppType>& get_key_data(const JoinHashTableItems& table_items) {
+        return JoinBuildFunc<PT>::get_key_data(table_items);
+    }
+    static Status construct_hash_table(JoinHashTableItems* table_items, HashTableProbeState* probe_state);
+
+    // The offset of |value| from |min| in the modular arithmetic, which is less than the bucket size
+    // iff |value| is in the range of the build keys.
+    static uint64_t calc_offset(const CppType& value, int64_t min) {
+        return static_cast<uint64_t>(value) - static_cast<uint64_t>(min);
+    }
+};
+
 class SerializedJoinBuildFunc {
 public:
     static Status prepare(RuntimeState* state, JoinHashTableItems* table_items, HashTableProbeState* probe_state);
@@ -356,12 +474,50 @@ private:
                                        const Columns& data_columns, const NullColumns& null_columns);
 };
 
+// RadixJoinProbeFunc looks up the bucket heads of the probe rows partition by partition with the
+// radix partitions of RadixJoinBuildFunc, so that the lookups of one partition stay in a part of the
+// hash table which fits in the L2 cache.
+template <PrimitiveType PT>
+class RadixJoinProbeFunc {
+public:
+    using CppType = typename RunTimeTypeTraits<PT>::CppType;
+    using ColumnType = typename RunTimeTypeTraits<PT>::ColumnType;
+
+    static void prepare(JoinHashTableItems* table_items, HashTableProbeState* probe_state) {
+        probe_state->radix_offsets.resize((1u << table_items->radix_bits) + 1);
+        probe_state->radix_order.resize(config::vector_chunk_size);
+    }
+
+    static Status lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
+
+    static const Buffer<CppType>& get_key_data(const HashTableProbeState& probe_state) {
+        return JoinProbeFunc<PT>::get_key_data(probe_state);
+    }
+};
+
+// DirectMappingJoinProbeFunc looks up the bucket heads of the buckets built by DirectMappingJoinBuildFunc,
+// one load per probe row after checking that the key is in the range of the build keys.
+template <PrimitiveType PT>
+class DirectMappingJoinProbeFunc {
+public:
+    using CppType = typename RunTimeTypeTraits<PT>::CppType;
+    using ColumnType = typename RunTimeTypeTraits<PT>::ColumnType;
+
+    static void prepare(JoinHashTableItems* table_items, HashTableProbeState* probe_state) {}
+
+    static Status lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
+
+    static const Buffer<CppType>& get_key_data(const HashTableProbeState& probe_state) {
+        return JoinProbeFunc<PT>::get_key_data(probe_state);
+    }
+};
+
 class SerializedJoinProbeFunc {
 public:
     static const Buffer<Slice>& get_key_data(const HashTableProbeState& probe_state) { return probe_state.probe_slice; }
 
     static void prepare(JoinHashTableItems* table_items, HashTableProbeState* probe_state) {
-        table_items->probe_pool->clear();
+        probe_state->probe_pool->clear();
         probe_state->probe_slice.resize(probe_state->probe_row_count);
         probe_state->is_nulls.resize(config::vector_chunk_size);
     }
@@ -392,6 +548,9 @@ private:
     void _probe_tuple_output(ChunkPtr* probe_chunk, ChunkPtr* chunk);
     Status _probe_null_output(ChunkPtr* chunk, size_t count);
 
+    // Unlink the rows whose keys are equal to the keys of the previous rows in the same chain.
+    void _remove_duplicate_build_keys();
+
     Status _build_output(ChunkPtr* chunk);
     void _build_tuple_output(ChunkPtr* chunk);
     Status _build_default_output(ChunkPtr* chunk, size_t count);
@@ -484,10 +643,23 @@ private:
 #define JoinHashMapForOneKey(PT) JoinHashMap<PT, JoinBuildFunc<PT>, JoinProbeFunc<PT>>
 #define JoinHashMapForFixedSizeKey(PT) JoinHashMap<PT, FixedSizeJoinBuildFunc<PT>, FixedSizeJoinProbeFunc<PT>>
 #define JoinHashMapForSerializedKey(PT) JoinHashMap<PT, SerializedJoinBuildFunc, SerializedJoinProbeFunc>
-
+#define JoinHashMapForRadixKey(PT) JoinHashMap<PT, RadixJoinBuildFunc<PT>, RadixJoinProbeFunc<PT>>
+#define JoinHashMapForDirectMappingKey(PT) \
+    JoinHashMap<PT, DirectMappingJoinBuildFunc<PT>, DirectMappingJoinProbeFunc<PT>>
+
+// JoinHashTable holds the build side rows, the hash table built on them and the state of probing.
+// The build side part is kept by JoinHashTableItems and never changes once build() returns, so a
+// table may be cloned by clone_readable_table() to share it with other probers, e.g. the drivers
+// of a pipeline joining against one broadcast table, while each clone probes with its own state.
 class JoinHashTable {
 public:
-    ~JoinHashTable();
+    JoinHashTable() = default;
+    JoinHashTable(JoinHashTable&&) = default;
+    JoinHashTable& operator=(JoinHashTable&&) = default;
+
+    // Disable copy ctor and assignment.
+    JoinHashTable(const JoinHashTable&) = delete;
+    JoinHashTable& operator=(const JoinHashTable&) = delete;
 
     void create(const HashTableParam& param);
     void close();
@@ -498,17 +670,28 @@ public:
 
     Status append_chunk(RuntimeState* state, const ChunkPtr& chunk);
 
-    const ChunkPtr& get_build_chunk() const { return _table_items.build_chunk; }
-    Columns& get_key_columns() { return _table_items.key_columns; }
-    uint32_t get_row_count() const { return _table_items.row_count; }
-    size_t get_probe_column_count() const { return _table_items.probe_column_count; }
-    size_t get_build_column_count() const { return _table_items.build_column_count; }
-    size_t get_bucket_size() const { return _table_items.bucket_size; }
+    // Create a table sharing the built rows and hash table of this one, which must have been built.
+    // The cloned table only probes, and doesn't support the right joins, because the matched build
+    // rows recorded by one clone are invisible to the others.
+    JoinHashTable clone_readable_table() const;
+
+    const ChunkPtr& get_build_chunk() const { return _table_items->build_chunk; }
+    Columns& get_key_columns() { return _table_items->key_columns; }
+    uint32_t get_row_count() const { return _table_items->row_count; }
+    size_t get_probe_column_count() const { return _table_items->probe_column_count; }
+    size_t get_build_column_count() const { return _table_items->build_column_count; }
+    size_t get_bucket_size() const { return _table_items->bucket_size; }
 
     void remove_duplicate_index(Column::Filter* filter);
 
 private:
     JoinHashMapType _choose_join_hash_map();
+    // Whether the one-key hash table with keys of |key_size| bytes should be radix partitioned.
+    bool _need_radix_partition(size_t key_size) const;
+    // Whether the one-key hash table of an integer type should map the build keys to the buckets
+    // directly, the bucket size and direct_mapping_min of the table items are set if it should.
+    template <PrimitiveType PT>
+    bool _need_direct_mapping();
     static size_t _get_size_of_fixed_and_contiguous_type(PrimitiveType data_type);
 
     void _remove_duplicate_index_for_left_outer_join(Column::Filter* filter);
@@ -538,11 +721,21 @@ private:
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_INT)> _fixed32 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_BIGINT)> _fixed64 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_LARGEINT)> _fixed128 = nullptr;
+    std::unique_ptr<JoinHashMapForRadixKey(TYPE_INT)> _radix_key32 = nullptr;
+    std::unique_ptr<JoinHashMapForRadixKey(TYPE_BIGINT)> _radix_key64 = nullptr;
+    std::unique_ptr<JoinHashMapForDirectMappingKey(TYPE_INT)> _direct_key32 = nullptr;
+    std::unique_ptr<JoinHashMapForDirectMappingKey(TYPE_BIGINT)> _direct_key64 = nullptr;
+
+    void _init_probe_state();
+    Status _create_join_hash_map();
 
     JoinHashMapType _hash_map_type = JoinHashMapType::empty;
 
-    JoinHashTableItems _table_items;
-    HashTableProbeState _probe_state;
+    std::shared_ptr<JoinHashTableItems> _table_items = nullptr;
+    std::unique_ptr<HashTableProbeState> _probe_state = nullptr;
+    // A readable clone shares _table_items with the table it's cloned from, which consumes
+    // and releases the memory of the build side.
+    bool _is_readable_clone = false;
 };
 } // namespace starrocks::vectorized
 
@@ -1,6 +1,9 @@
 // This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
 
+#include <unordered_set>
+
 #include "simd/simd.h"
+#include "util/defer_op.h"
 
 namespace starrocks::vectorized {
 template <PrimitiveType PT>
@@ -150,41 +153,153 @@ void FixedSizeJoinBuildFunc<PT>::_build_nullable_columns(JoinHashTableItems* tab
     }
 }
 
+template <PrimitiveType PT>
+Status RadixJoinBuildFunc<PT>::prepare(RuntimeState* state, JoinHashTableItems* table_items,
+                                       HashTableProbeState* probe_state) {
+    // the bucket size is a power of 2, partition the hash table until one partition fits in L2.
+    uint32_t bucket_bits = __builtin_ctz(table_items->bucket_size);
+    size_t table_bytes = sizeof(uint32_t) * table_items->bucket_size +
+                         (sizeof(uint32_t) + sizeof(CppType)) * (table_items->row_count + 1);
+    uint32_t radix_bits = 0;
+    while (radix_bits < bucket_bits && radix_bits < MAX_RADIX_BITS &&
+           static_cast<int64_t>(table_bytes >> radix_bits) > config::join_radix_partition_bytes) {
+        radix_bits++;
+    }
+    table_items->radix_bits = radix_bits;
+    table_items->radix_shift = bucket_bits - radix_bits;
+    return Status::OK();
+}
+
+template <PrimitiveType PT>
+Status RadixJoinBuildFunc<PT>::construct_hash_table(JoinHashTableItems* table_items,
+                                                    HashTableProbeState* probe_state) {
+    uint32_t row_count = table_items->row_count;
+    uint32_t bucket_size = table_items->bucket_size;
+    const uint8_t* null_data = nullptr;
+    if (table_items->key_columns[0]->is_nullable()) {
+        auto* nullable_column =
+                ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[0]);
+        null_data = nullable_column->null_column()->get_data().data();
+    }
+
+    // The rows with null keys are put in the pseudo bucket |bucket_size| behind all the buckets.
+    size_t temp_mem_usage = sizeof(uint32_t) * (2 * (row_count + 1) + bucket_size + 2);
+    table_items->mem_tracker->consume(temp_mem_usage);
+    DeferOp release_temp_mem([&]() { table_items->mem_tracker->release(temp_mem_usage); });
+
+    Buffer<uint32_t> buckets(row_count + 1);
+    const auto& data = get_key_data(*table_items);
+    for (uint32_t i = 1; i < row_count + 1; i++) {
+        if (null_data != nullptr && null_data[i] != 0) {
+            buckets[i] = bucket_size;
+        } else {
+            buckets[i] = JoinHashMapHelper::calc_bucket_num<CppType>(data[i], bucket_size);
+        }
+    }
+
+    // Counting sort the rows by their buckets, |offsets[b]| is the start of bucket b in the new
+    // order at first, and it's the end of bucket b after the rows are scattered.
+    Buffer<uint32_t> offsets(bucket_size + 2, 0);
+    offsets[0] = 1;
+    for (uint32_t i = 1; i < row_count + 1; i++) {
+        offsets[buckets[i] + 1]++;
+    }
+    for (uint32_t b = 1; b < bucket_size + 2; b++) {
+        offsets[b] += offsets[b - 1];
+    }
+    Buffer<uint32_t> indexes(row_count + 1);
+    indexes[0] = 0;
+    for (uint32_t i = 1; i < row_count + 1; i++) {
+        indexes[offsets[buckets[i]]++] = i;
+    }
+    _reorder_build_rows(table_items, indexes);
+
+    // The chain of a bucket is its adjacent rows now.
+    uint32_t start = 1;
+    for (uint32_t b = 0; b < bucket_size; b++) {
+        uint32_t end = offsets[b];
+        if (start < end) {
+            table_items->first[b] = start;
+            for (uint32_t i = start; i + 1 < end; i++) {
+                table_items->next[i] = i + 1;
+            }
+            table_items->next[end - 1] = 0;
+        }
+        start = end;
+    }
+    for (uint32_t i = start; i < row_count + 1; i++) {
+        table_items->next[i] = 0;
+    }
+    return Status::OK();
+}
+
+template <PrimitiveType PT>
+void RadixJoinBuildFunc<PT>::_reorder_build_rows(JoinHashTableItems* table_items,
+                                                 const Buffer<uint32_t>& indexes) {
+    // A key column may be a column of the build chunk, e.g. the key expr is a slot ref,
+    // so every column is reordered only once.
+    std::unordered_set<Column*> reordered;
+    auto reorder = [&](const ColumnPtr& column) {
+        if (!reordered.insert(column.get()).second) {
+            return;
+        }
+        auto new_column = column->clone_empty();
+        new_column->append_selective(*column, indexes.data(), 0, indexes.size());
+        column->swap_column(*new_column);
+    };
+    for (const auto& column : table_items->build_chunk->columns()) {
+        reorder(column);
+    }
+    for (const auto& column : table_items->key_columns) {
+        reorder(column);
+    }
+}
+
+template <PrimitiveType PT>
+Status DirectMappingJoinBuildFunc<PT>::construct_hash_table(JoinHashTableItems* table_items,
+                                                            HashTableProbeState* probe_state) {
+    auto& data = get_key_data(*table_items);
+    int64_t min = table_items->direct_mapping_min;
+    const uint8_t* null_data = nullptr;
+    if (table_items->key_columns[0]->is_nullable()) {
+        auto* nullable_column =
+                ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[0]);
+        null_data = nullable_column->null_column()->get_data().data();
+    }
+    for (size_t i = 1; i < table_items->row_count + 1; i++) {
+        if (null_data != nullptr && null_data[i] != 0) {
+            continue;
+        }
+        auto bucket_num = static_cast<uint32_t>(calc_offset(data[i], min));
+        DCHECK_LT(bucket_num, table_items->bucket_size);
+        table_items->next[i] = table_items->first[bucket_num];
+        table_items->first[bucket_num] = i;
+    }
+    return Status::OK();
+}
+
 template <PrimitiveType PT>
 Status JoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items,
                                       HashTableProbeState* probe_state) {
     size_t probe_row_count = probe_state->probe_row_count;
     auto& data = get_key_data(*probe_state);
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size,
-                                                 &probe_state->buckets, 0, data.size());
+                                                 &probe_state->buckets, 0, probe_row_count);
 
+    const uint8_t* null_data = nullptr;
+    probe_state->null_array = nullptr;
     if ((*probe_state->key_columns)[0]->is_nullable()) {
         auto* nullable_column =
                 ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[0]);
-
         if (nullable_column->has_null()) {
-            auto& null_array = nullable_column->null_column()->get_data();
-            for (size_t i = 0; i < probe_row_count; i++) {
-                if (null_array[i] == 0) {
-                    probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-                } else {
-                    probe_state->next[i] = 0;
-                }
-            }
+            null_data = nullable_column->null_column()->get_data().data();
             probe_state->null_array = &nullable_column->null_column()->get_data();
-        } else {
-            for (size_t i = 0; i < probe_row_count; i++) {
-                probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-            }
-            probe_state->null_array = nullptr;
         }
-        return Status::OK();
     }
 
-    for (size_t i = 0; i < probe_row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
-    probe_state->null_array = nullptr;
+    const auto& build_data = JoinBuildFunc<PT>::get_key_data(table_items);
+    JoinHashMapHelper::lookup_bucket_heads<CppType>(table_items, build_data, probe_state,
+                                                    null_data);
     return Status::OK();
 }
 
@@ -250,9 +365,8 @@ void FixedSizeJoinProbeFunc<PT>::_probe_column(const JoinHashTableItems& table_i
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size,
                                                  &probe_state->buckets, 0, row_count);
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    const auto& build_data = FixedSizeJoinBuildFunc<PT>::get_key_data(table_items);
+    JoinHashMapHelper::lookup_bucket_heads<CppType>(table_items, build_data, probe_state, nullptr);
 }
 
 template <PrimitiveType PT>
@@ -277,13 +391,94 @@ void FixedSizeJoinProbeFunc<PT>::_probe_nullable_column(const JoinHashTableItems
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size,
                                                  &probe_state->buckets, 0, row_count);
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        if (probe_state->is_nulls[i] == 0) {
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-        } else {
+    const auto& build_data = FixedSizeJoinBuildFunc<PT>::get_key_data(table_items);
+    JoinHashMapHelper::lookup_bucket_heads<CppType>(table_items, build_data, probe_state,
+                                                    probe_state->is_nulls.data());
+}
+
+template <PrimitiveType PT>
+Status RadixJoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items,
+                                           HashTableProbeState* probe_state) {
+    uint32_t probe_row_count = probe_state->probe_row_count;
+    auto& data = get_key_data(*probe_state);
+    JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size,
+                                                 &probe_state->buckets, 0, probe_row_count);
+
+    const uint8_t* null_data = nullptr;
+    probe_state->null_array = nullptr;
+    if ((*probe_state->key_columns)[0]->is_nullable()) {
+        auto* nullable_column =
+                ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[0]);
+        if (nullable_column->has_null()) {
+            null_data = nullable_column->null_column()->get_data().data();
+            probe_state->null_array = &nullable_column->null_column()->get_data();
+        }
+    }
+
+    // Counting sort the probe rows by the radix partitions of their buckets.
+    const auto& buckets = probe_state->buckets;
+    auto& offsets = probe_state->radix_offsets;
+    auto& order = probe_state->radix_order;
+    uint32_t radix_shift = table_items.radix_shift;
+    std::fill(offsets.begin(), offsets.end(), 0);
+    for (uint32_t i = 0; i < probe_row_count; i++) {
+        offsets[(buckets[i] >> radix_shift) + 1]++;
+    }
+    for (size_t p = 1; p < offsets.size(); p++) {
+        offsets[p] += offsets[p - 1];
+    }
+    for (uint32_t i = 0; i < probe_row_count; i++) {
+        order[offsets[buckets[i] >> radix_shift]++] = i;
+    }
+
+    // The probe loops compare the keys of the bucket heads in the order of the probe rows,
+    // fetch them partition by partition here.
+    const auto& build_data = JoinBuildFunc<PT>::get_key_data(table_items);
+    for (uint32_t k = 0; k < probe_row_count; k++) {
+        uint32_t i = order[k];
+        if (null_data != nullptr && null_data[i] != 0) {
             probe_state->next[i] = 0;
+            continue;
+        }
+        uint32_t head = table_items.first[buckets[i]];
+        probe_state->next[i] = head;
+        __builtin_prefetch(&build_data[head]);
+    }
+    return Status::OK();
+}
+
+template <PrimitiveType PT>
+Status DirectMappingJoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items,
+                                                   HashTableProbeState* probe_state) {
+    uint32_t probe_row_count = probe_state->probe_row_count;
+    const auto& data = get_key_data(*probe_state);
+
+    const uint8_t* null_data = nullptr;
+    probe_state->null_array = nullptr;
+    if ((*probe_state->key_columns)[0]->is_nullable()) {
+        auto* nullable_column =
+                ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[0]);
+        if (nullable_column->has_null()) {
+            null_data = nullable_column->null_column()->get_data().data();
+            probe_state->null_array = &nullable_column->null_column()->get_data();
         }
     }
+
+    // The keys out of the range of the build keys have no bucket.
+    int64_t min = table_items.direct_mapping_min;
+    uint64_t bucket_size = table_items.bucket_size;
+    const uint32_t* first = table_items.first.data();
+    uint32_t* next = probe_state->next.data();
+    for (uint32_t i = 0; i < probe_row_count; i++) {
+        uint64_t offset = DirectMappingJoinBuildFunc<PT>::calc_offset(data[i], min);
+        next[i] = offset < bucket_size ? first[offset] : 0;
+    }
+    if (null_data != nullptr) {
+        for (uint32_t i = 0; i < probe_row_count; i++) {
+            next[i] = null_data[i] == 0 ? next[i] : 0;
+        }
+    }
+    return Status::OK();
 }
 
 template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
@@ -294,9 +489,44 @@ Status JoinHashMap<PT, BuildFunc, ProbeFunc>::build(RuntimeState* state) {
     // construct hash table
     RETURN_IF_ERROR(BuildFunc().construct_hash_table(_table_items, _probe_state));
 
+    if (_table_items->build_keys_only) {
+        _remove_duplicate_build_keys();
+    }
+
     return Status::OK();
 }
 
+template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
+void JoinHashMap<PT, BuildFunc, ProbeFunc>::_remove_duplicate_build_keys() {
+    const auto& build_data = BuildFunc::get_key_data(*_table_items);
+    auto& first = _table_items->first;
+    auto& next = _table_items->next;
+    // the rows of the distinct keys in the current chain, there are only a few of them since the
+    // chains of different keys are short.
+    std::vector<uint32_t> distinct_rows;
+    for (uint32_t bucket = 0; bucket < _table_items->bucket_size; bucket++) {
+        distinct_rows.clear();
+        uint32_t prev = 0;
+        for (uint32_t index = first[bucket]; index != 0; index = next[index]) {
+            bool duplicated = false;
+            for (uint32_t row : distinct_rows) {
+                if (JoinKeyEqual<CppType>()(build_data[row], build_data[index])) {
+                    duplicated = true;
+                    break;
+                }
+            }
+            if (!duplicated) {
+                distinct_rows.emplace_back(index);
+                prev = index;
+            } else if (prev == 0) {
+                first[bucket] = next[index];
+            } else {
+                next[prev] = next[index];
+            }
+        }
+    }
+}
+
 template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
 Status JoinHashMap<PT, BuildFunc, ProbeFunc>::probe(const Columns& key_columns,
                                                     ChunkPtr* probe_chunk, ChunkPtr* chunk,
@@ -575,7 +805,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_copy_probe_column(ColumnPtr* src_co
             (*chunk)->append_column(*src_column, slot->id());
         }
     } else {
-        ColumnPtr dest_column = ColumnHelper::create_column(slot->type(), to_nullable);
+        ColumnPtr dest_column = ColumnHelper::create_column_pooled(slot->type(), to_nullable);
         dest_column->append_selective(**src_column, _probe_state->probe_index.data(), 0,
                                       _probe_state->count);
         (*chunk)->append_column(std::move(dest_column), slot->id());
@@ -591,7 +821,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_copy_probe_nullable_column(
         (*src_column)->filter(_probe_state->probe_match_filter, _probe_state->probe_row_count);
         (*chunk)->append_column(*src_column, slot->id());
     } else {
-        ColumnPtr dest_column = ColumnHelper::create_column(slot->type(), true);
+        ColumnPtr dest_column = ColumnHelper::create_column_pooled(slot->type(), true);
         dest_column->append_selective(**src_column, _probe_state->probe_index.data(), 0,
                                       _probe_state->count);
         (*chunk)->append_column(std::move(dest_column), slot->id());
@@ -603,7 +833,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_copy_build_column(const ColumnPtr&
                                                                ChunkPtr* chunk,
                                                                const SlotDescriptor* slot,
                                                                bool to_nullable) {
-    ColumnPtr dest_column = ColumnHelper::create_column(slot->type(), to_nullable);
+    ColumnPtr dest_column = ColumnHelper::create_column_pooled(slot->type(), to_nullable);
 
     if (to_nullable) {
         dest_column->append_selective(*src_column, _probe_state->build_index.data(), 0,
@@ -631,7 +861,7 @@ void JoinHashMap<PT, BuildFunc, ProbeFunc>::_copy_build_column(const ColumnPtr&
 template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
 void JoinHashMap<PT, BuildFunc, ProbeFunc>::_copy_build_nullable_column(
         const ColumnPtr& src_column, ChunkPtr* chunk, const SlotDescriptor* slot) {
-    ColumnPtr dest_column = ColumnHelper::create_column(slot->type(), true);
+    ColumnPtr dest_column = ColumnHelper::create_column_pooled(slot->type(), true);
 
     dest_column->append_selective(*src_column, _probe_state->build_index.data(), 0,
                                   _probe_state->count);
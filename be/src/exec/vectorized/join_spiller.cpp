@@ -0,0 +1,249 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/join_spiller.h"
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "common/config.h"
+#include "env/env.h"
+#include "exprs/expr_context.h"
+#include "gen_cpp/data.pb.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "util/hash_util.hpp"
+
+namespace starrocks::vectorized {
+
+static const SlotDescriptor* find_slot(const RowDescriptor& row_desc, SlotId slot_id) {
+    for (const auto* tuple_desc : row_desc.tuple_descriptors()) {
+        for (const auto* slot : tuple_desc->slots()) {
+            if (slot->id() == slot_id) {
+                return slot;
+            }
+        }
+    }
+    return nullptr;
+}
+
+// The partial chunk of a partition could only be appended by the chunks of the same columns.
+static bool has_same_columns(const Chunk& lhs, const Chunk& rhs) {
+    if (lhs.num_columns() != rhs.num_columns()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.num_columns(); i++) {
+        if (lhs.columns()[i]->is_nullable() != rhs.columns()[i]->is_nullable()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SpilledChunkFile::~SpilledChunkFile() {
+    if (_rw_file != nullptr) {
+        _rw_file->close();
+    }
+    _file->remove();
+}
+
+Status SpilledChunkFile::write(const Chunk& chunk) {
+    ChunkPB pb_chunk;
+    chunk.serialize_with_meta(&pb_chunk);
+    _buffer.clear();
+    if (!pb_chunk.SerializeToString(&_buffer)) {
+        return Status::InternalError("serialize spilled chunk failed");
+    }
+
+    int64_t offset = 0;
+    RETURN_IF_ERROR(_file->allocate_space(_buffer.size(), &offset));
+    if (_rw_file == nullptr) {
+        // the file is created by the first allocate_space.
+        RandomRWFileOptions opts;
+        opts.mode = Env::MUST_EXIST;
+        RETURN_IF_ERROR(Env::Default()->new_random_rw_file(opts, _file->path(), &_rw_file));
+    }
+    RETURN_IF_ERROR(_rw_file->write_at(offset, Slice(_buffer)));
+    _blocks.emplace_back(offset, _buffer.size());
+    _num_rows += chunk.num_rows();
+    return Status::OK();
+}
+
+Status SpilledChunkFile::read(ChunkPtr* chunk, bool* eos) {
+    if (_next_block >= _blocks.size()) {
+        *eos = true;
+        return Status::OK();
+    }
+    auto [offset, size] = _blocks[_next_block++];
+    _buffer.resize(size);
+    RETURN_IF_ERROR(_rw_file->read_at(offset, Slice(_buffer.data(), size)));
+    *eos = false;
+    return _deserialize(_buffer, chunk);
+}
+
+Status SpilledChunkFile::_deserialize(const std::string& data, ChunkPtr* chunk) const {
+    ChunkPB pb_chunk;
+    if (!pb_chunk.ParseFromString(data)) {
+        return Status::InternalError("parse spilled chunk failed");
+    }
+
+    RuntimeChunkMeta meta;
+    meta.slot_id_to_index.init(pb_chunk.slot_id_map().size());
+    for (int i = 0; i < pb_chunk.slot_id_map().size(); i += 2) {
+        meta.slot_id_to_index.insert(pb_chunk.slot_id_map()[i], pb_chunk.slot_id_map()[i + 1]);
+    }
+    meta.tuple_id_to_index.init(pb_chunk.tuple_id_map().size());
+    for (int i = 0; i < pb_chunk.tuple_id_map().size(); i += 2) {
+        meta.tuple_id_to_index.insert(pb_chunk.tuple_id_map()[i], pb_chunk.tuple_id_map()[i + 1]);
+    }
+    meta.is_nulls.assign(pb_chunk.is_nulls().begin(), pb_chunk.is_nulls().end());
+    meta.is_consts.assign(pb_chunk.is_consts().begin(), pb_chunk.is_consts().end());
+
+    meta.types.resize(pb_chunk.is_nulls().size());
+    for (const auto& kv : meta.slot_id_to_index) {
+        const SlotDescriptor* slot = find_slot(_row_desc, kv.first);
+        if (slot == nullptr) {
+            return Status::InternalError(strings::Substitute("unknown slot $0 of spilled chunk", kv.first));
+        }
+        meta.types[kv.second] = slot->type();
+    }
+    for (const auto& kv : meta.tuple_id_to_index) {
+        meta.types[kv.second] = TypeDescriptor(PrimitiveType::TYPE_BOOLEAN);
+    }
+
+    *chunk = std::make_shared<Chunk>();
+    return (*chunk)->deserialize(reinterpret_cast<const uint8_t*>(pb_chunk.data().data()), pb_chunk.data().size(),
+                                 meta);
+}
+
+JoinSpiller::JoinSpiller(RuntimeState* state, const std::vector<ExprContext*>& build_expr_ctxs,
+                         const std::vector<ExprContext*>& probe_expr_ctxs, const RowDescriptor& build_row_desc,
+                         const RowDescriptor& probe_row_desc, int level)
+        : _state(state),
+          _build_expr_ctxs(build_expr_ctxs),
+          _probe_expr_ctxs(probe_expr_ctxs),
+          _build_row_desc(build_row_desc),
+          _probe_row_desc(probe_row_desc),
+          _level(level),
+          _num_partitions(1ul << config::join_spill_partition_bits) {}
+
+bool JoinSpiller::can_partition_next_level(int level) {
+    return level + 1 < config::join_spill_max_levels && (level + 2) * config::join_spill_partition_bits <= 32;
+}
+
+ChunkUniquePtr JoinSpiller::clone_empty(const Chunk& chunk, size_t reserved_size) {
+    Columns columns(chunk.num_columns());
+    for (size_t i = 0; i < chunk.num_columns(); i++) {
+        columns[i] = chunk.columns()[i]->clone_empty();
+        columns[i]->reserve(reserved_size);
+    }
+    return std::make_unique<Chunk>(columns, chunk.get_slot_id_to_index_map(), chunk.get_tuple_id_to_index_map());
+}
+
+Status JoinSpiller::init() {
+    TmpFileMgr* tmp_file_mgr = _state->exec_env()->tmp_file_mgr();
+    std::vector<TmpFileMgr::DeviceId> devices = tmp_file_mgr->active_tmp_devices();
+    if (devices.empty()) {
+        return Status::InternalError("no temporary directory to spill the hash join");
+    }
+
+    _partitions.resize(_num_partitions);
+    for (size_t i = 0; i < _num_partitions; i++) {
+        // spread the partitions over the devices.
+        TmpFileMgr::DeviceId device = devices[i % devices.size()];
+        TmpFileMgr::File* build_file = nullptr;
+        RETURN_IF_ERROR(tmp_file_mgr->get_file(device, _state->query_id(), &build_file));
+        _partitions[i].build_file = std::make_unique<SpilledChunkFile>(build_file, _build_row_desc);
+        TmpFileMgr::File* probe_file = nullptr;
+        RETURN_IF_ERROR(tmp_file_mgr->get_file(device, _state->query_id(), &probe_file));
+        _partitions[i].probe_file = std::make_unique<SpilledChunkFile>(probe_file, _probe_row_desc);
+        _partitions[i].level = _level;
+    }
+    _build_partial_chunks.resize(_num_partitions);
+    _probe_partial_chunks.resize(_num_partitions);
+    return Status::OK();
+}
+
+Status JoinSpiller::spill_build_chunk(const ChunkPtr& chunk) {
+    return _spill_chunk(chunk, _build_expr_ctxs, true);
+}
+
+Status JoinSpiller::spill_probe_chunk(const ChunkPtr& chunk) {
+    return _spill_chunk(chunk, _probe_expr_ctxs, false);
+}
+
+Status JoinSpiller::_spill_chunk(const ChunkPtr& chunk, const std::vector<ExprContext*>& expr_ctxs, bool is_build) {
+    uint16_t num_rows = chunk->num_rows();
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    // The const columns can't be appended by the rows of other chunks.
+    for (auto& column : chunk->columns()) {
+        column = ColumnHelper::unpack_and_duplicate_const_column(num_rows, column);
+    }
+
+    _hash_values.assign(num_rows, HashUtil::FNV_SEED);
+    for (auto* expr_ctx : expr_ctxs) {
+        ColumnPtr column = expr_ctx->evaluate(chunk.get());
+        column->fvn_hash(_hash_values.data(), 0, num_rows);
+    }
+
+    // compute the row indexes of each partition, like PartitionExchanger.
+    uint32_t shift = _level * config::join_spill_partition_bits;
+    uint32_t mask = _num_partitions - 1;
+    _partition_row_start_points.assign(_num_partitions + 1, 0);
+    for (uint16_t i = 0; i < num_rows; i++) {
+        _hash_values[i] = (_hash_values[i] >> shift) & mask;
+        _partition_row_start_points[_hash_values[i]]++;
+    }
+    for (size_t i = 1; i <= _num_partitions; i++) {
+        _partition_row_start_points[i] += _partition_row_start_points[i - 1];
+    }
+    _row_indexes.resize(num_rows);
+    for (int i = num_rows - 1; i >= 0; i--) {
+        _row_indexes[--_partition_row_start_points[_hash_values[i]]] = i;
+    }
+
+    auto& partial_chunks = is_build ? _build_partial_chunks : _probe_partial_chunks;
+    for (size_t i = 0; i < _num_partitions; i++) {
+        uint32_t from = _partition_row_start_points[i];
+        uint32_t size = _partition_row_start_points[i + 1] - from;
+        if (size == 0) {
+            continue;
+        }
+        auto& partial_chunk = partial_chunks[i];
+        if (partial_chunk != nullptr && !has_same_columns(*partial_chunk, *chunk)) {
+            RETURN_IF_ERROR(_flush_partial_chunk(i, is_build));
+        }
+        if (partial_chunk == nullptr) {
+            partial_chunk = clone_empty(*chunk, config::vector_chunk_size);
+        }
+        partial_chunk->append_selective(*chunk, _row_indexes.data(), from, size);
+        if (partial_chunk->num_rows() >= config::vector_chunk_size) {
+            RETURN_IF_ERROR(_flush_partial_chunk(i, is_build));
+        }
+    }
+    return Status::OK();
+}
+
+Status JoinSpiller::_flush_partial_chunk(size_t partition, bool is_build) {
+    auto& partial_chunk = is_build ? _build_partial_chunks[partition] : _probe_partial_chunks[partition];
+    if (partial_chunk == nullptr) {
+        return Status::OK();
+    }
+    auto& file = is_build ? _partitions[partition].build_file : _partitions[partition].probe_file;
+    RETURN_IF_ERROR(file->write(*partial_chunk));
+    partial_chunk.reset();
+    return Status::OK();
+}
+
+Status JoinSpiller::finish(std::vector<SpilledJoinPartition>* partitions) {
+    for (size_t i = 0; i < _num_partitions; i++) {
+        RETURN_IF_ERROR(_flush_partial_chunk(i, true));
+        RETURN_IF_ERROR(_flush_partial_chunk(i, false));
+    }
+    *partitions = std::move(_partitions);
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
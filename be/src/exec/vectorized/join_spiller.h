@@ -0,0 +1,107 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "runtime/tmp_file_mgr.h"
+
+namespace starrocks {
+class ExprContext;
+class RandomRWFile;
+class RowDescriptor;
+class RuntimeState;
+
+namespace vectorized {
+
+// SpilledChunkFile writes chunks to a temporary file of TmpFileMgr, and reads them back in the
+// written order. Every chunk is serialized with its own meta, so the chunks of one file needn't
+// have the same nullable or const columns, the types of the columns are got from |row_desc|.
+class SpilledChunkFile {
+public:
+    SpilledChunkFile(TmpFileMgr::File* file, const RowDescriptor& row_desc) : _file(file), _row_desc(row_desc) {}
+    ~SpilledChunkFile();
+
+    Status write(const Chunk& chunk);
+
+    // Read the next chunk, |*eos| is set if all the chunks are read.
+    Status read(ChunkPtr* chunk, bool* eos);
+
+    size_t num_rows() const { return _num_rows; }
+
+private:
+    Status _deserialize(const std::string& data, ChunkPtr* chunk) const;
+
+    std::unique_ptr<TmpFileMgr::File> _file;
+    const RowDescriptor& _row_desc;
+    std::unique_ptr<RandomRWFile> _rw_file;
+    // The offset and the size of every written chunk.
+    std::vector<std::pair<int64_t, size_t>> _blocks;
+    size_t _next_block = 0;
+    size_t _num_rows = 0;
+    std::string _buffer;
+};
+
+// A pair of build and probe partitions spilled by JoinSpiller, which could be joined separately.
+struct SpilledJoinPartition {
+    std::unique_ptr<SpilledChunkFile> build_file;
+    std::unique_ptr<SpilledChunkFile> probe_file;
+    // The partitions of level n + 1 are partitioned from a partition of level n.
+    int level = 0;
+};
+
+// JoinSpiller partitions the build and probe rows of a hash join by the hash of their join keys,
+// and spills each partition into its own temporary files. The partition of a row at level n is
+// the n-th group of config::join_spill_partition_bits bits of its hash, so that a partition too
+// large to be joined in memory could be partitioned again by the next level.
+class JoinSpiller {
+public:
+    JoinSpiller(RuntimeState* state, const std::vector<ExprContext*>& build_expr_ctxs,
+                const std::vector<ExprContext*>& probe_expr_ctxs, const RowDescriptor& build_row_desc,
+                const RowDescriptor& probe_row_desc, int level);
+
+    // Create the temporary files of the partitions.
+    Status init();
+
+    Status spill_build_chunk(const ChunkPtr& chunk);
+    Status spill_probe_chunk(const ChunkPtr& chunk);
+
+    // Write the buffered rows of all the partitions to the files, and move the partitions to
+    // |partitions|. The spiller can't be used any more.
+    Status finish(std::vector<SpilledJoinPartition>* partitions);
+
+    // Whether the partitions of |level| could be partitioned again.
+    static bool can_partition_next_level(int level);
+
+    // Like Chunk::clone_empty_with_slot, but the tuple columns are cloned too.
+    static ChunkUniquePtr clone_empty(const Chunk& chunk, size_t reserved_size);
+
+private:
+    Status _spill_chunk(const ChunkPtr& chunk, const std::vector<ExprContext*>& expr_ctxs, bool is_build);
+    Status _flush_partial_chunk(size_t partition, bool is_build);
+
+    RuntimeState* _state;
+    const std::vector<ExprContext*>& _build_expr_ctxs;
+    const std::vector<ExprContext*>& _probe_expr_ctxs;
+    const RowDescriptor& _build_row_desc;
+    const RowDescriptor& _probe_row_desc;
+    const int _level;
+    const size_t _num_partitions;
+
+    std::vector<SpilledJoinPartition> _partitions;
+    // The rows of every partition are accumulated here until there are config::vector_chunk_size
+    // rows, so that a spilled chunk isn't a tiny slice of the input chunk.
+    std::vector<ChunkUniquePtr> _build_partial_chunks;
+    std::vector<ChunkUniquePtr> _probe_partial_chunks;
+
+    std::vector<uint32_t> _hash_values;
+    std::vector<uint32_t> _partition_row_start_points;
+    std::vector<uint32_t> _row_indexes;
+};
+
+} // namespace vectorized
+} // namespace starrocks
@@ -290,11 +290,15 @@ Status JsonReader::read_chunk(Chunk* chunk, int32_t rows_to_read, const std::vec
                         continue;
                     }
                     ColumnPtr& column = chunk->get_column_by_slot_id(slot_desc->id());
-                    const char* column_name = slot_desc->col_name().c_str();
-                    if (!objectValue->IsObject() || !objectValue->HasMember(column_name)) {
+                    if (!objectValue->IsObject()) {
+                        column->append_nulls(1);
+                        continue;
+                    }
+                    auto member = objectValue->FindMember(slot_desc->col_name().c_str());
+                    if (member == objectValue->MemberEnd()) {
                         column->append_nulls(1);
                     } else {
-                        _construct_column((*objectValue)[column_name], column.get(), slot_desc->type());
+                        _construct_column(member->value, column.get(), slot_desc->type());
                     }
                 }
             } else {
@@ -325,26 +329,47 @@ Status JsonReader::read_chunk(Chunk* chunk, int32_t rows_to_read, const std::vec
     return Status::OK();
 }
 
-// read one json string from file read and parse it to json doc.
-Status JsonReader::_read_and_parse_json() {
+// read one message from file.
+Status JsonReader::_read_message() {
 #ifdef BE_TEST
-    [[maybe_unused]] size_t message_size = 0;
     Slice result(_buf.data(), _buf_size);
     RETURN_IF_ERROR(_file->read(&result));
     if (result.size == 0) {
         return Status::EndOfFile("EOF of reading file");
     }
-    _origin_json_doc.Parse(result.data, result.size);
+    _message = result.data;
+    _message_size = result.size;
 #else
-    std::unique_ptr<uint8_t[]> json_binary = nullptr;
     size_t length = 0;
     StreamPipeSequentialFile* stream_file = reinterpret_cast<StreamPipeSequentialFile*>(_file.get());
-    RETURN_IF_ERROR(stream_file->read_one_message(&json_binary, &length));
+    RETURN_IF_ERROR(stream_file->read_one_message(&_message_binary, &length));
     if (length == 0) {
         return Status::EndOfFile("EOF of reading file");
     }
-    _origin_json_doc.Parse((char*)json_binary.get(), length);
+    _message = reinterpret_cast<const char*>(_message_binary.get());
+    _message_size = length;
 #endif
+    _message_offset = 0;
+    return Status::OK();
+}
+
+// parse the next json document of the message read to json doc.
+Status JsonReader::_read_and_parse_json() {
+    if (_message_offset >= _message_size) {
+        RETURN_IF_ERROR(_read_message());
+    }
+
+    rapidjson::MemoryStream stream(_message + _message_offset, _message_size - _message_offset);
+    _origin_json_doc.ParseStream<rapidjson::kParseStopWhenDoneFlag>(stream);
+    if (_origin_json_doc.HasParseError()) {
+        // The rest of the message is dropped.
+        _message_offset = _message_size;
+    } else {
+        _message_offset += stream.Tell();
+        while (_message_offset < _message_size && isspace(static_cast<unsigned char>(_message[_message_offset]))) {
+            _message_offset++;
+        }
+    }
 
     if (_origin_json_doc.HasParseError()) {
         std::string err_msg = strings::Substitute("Failed to parse string to json. code=$0, error=$1",
@@ -398,35 +423,35 @@ void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column*
         break;
     }
     case rapidjson::Type::kFalseType: {
-        column->append_strings(std::vector<Slice>{Slice("0")});
+        column->append_datum(Datum(Slice("0")));
         break;
     }
     case rapidjson::Type::kTrueType: {
-        column->append_strings(std::vector<Slice>{Slice("1")});
+        column->append_datum(Datum(Slice("1")));
         break;
     }
     case rapidjson::Type::kNumberType: {
         if (objectValue.IsUint()) {
             auto f = fmt::format_int(objectValue.GetUint());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            column->append_datum(Datum(Slice(f.data(), f.size())));
         } else if (objectValue.IsInt()) {
             auto f = fmt::format_int(objectValue.GetInt());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            column->append_datum(Datum(Slice(f.data(), f.size())));
         } else if (objectValue.IsUint64()) {
             auto f = fmt::format_int(objectValue.GetUint64());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            column->append_datum(Datum(Slice(f.data(), f.size())));
         } else if (objectValue.IsInt64()) {
             auto f = fmt::format_int(objectValue.GetInt64());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            column->append_datum(Datum(Slice(f.data(), f.size())));
         } else {
             int len = d2s_buffered_n(objectValue.GetDouble(), buf);
-            column->append_strings(std::vector<Slice>{Slice(buf, len)});
+            column->append_datum(Datum(Slice(buf, len)));
         }
         break;
     }
     case rapidjson::Type::kStringType: {
         const char* str_value = objectValue.GetString();
-        column->append_strings(std::vector<Slice>{Slice(str_value, objectValue.GetStringLength())});
+        column->append_datum(Datum(Slice(str_value, objectValue.GetStringLength())));
         break;
     }
     case rapidjson::Type::kArrayType: {
@@ -445,13 +470,13 @@ void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column*
             offsets->append_numbers(&size, 4);
         } else {
             std::string json_str = JsonFunctions::get_raw_json_string(objectValue);
-            column->append_strings(std::vector<Slice>{Slice(json_str.c_str(), json_str.length())});
+            column->append_datum(Datum(Slice(json_str.c_str(), json_str.length())));
         }
         break;
     }
     case rapidjson::Type::kObjectType: {
         std::string json_str = JsonFunctions::get_raw_json_string(objectValue);
-        column->append_strings(std::vector<Slice>{Slice(json_str.c_str(), json_str.length())});
+        column->append_datum(Datum(Slice(json_str.c_str(), json_str.length())));
         break;
     }
     }
@@ -9,6 +9,7 @@ DIAGNOSTIC_IGNORE("-Wclass-memaccess")
 DIAGNOSTIC_POP
 
 #include <rapidjson/error/en.h>
+#include <rapidjson/memorystream.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
@@ -83,6 +84,7 @@ public:
 
 private:
     Status _read_and_parse_json();
+    Status _read_message();
     void _construct_column(const rapidjson::Value& objectValue, Column* column, const TypeDescriptor& type_desc);
 
 private:
@@ -102,6 +104,13 @@ private:
     rapidjson::Document _origin_json_doc;  // origin json document object from parsed json string
     rapidjson::Value* _json_doc = nullptr; // _json_doc equals _final_json_doc iff not set `json_root`
 
+    // The message read, which may hold several documents separated by whitespaces, e.g. the newline-delimited JSON,
+    // and the offset of the next document in it.
+    std::unique_ptr<uint8_t[]> _message_binary;
+    const char* _message = nullptr;
+    size_t _message_size = 0;
+    size_t _message_offset = 0;
+
     // only used in unit test.
     // TODO: The semantics of Streaming Load And Routine Load is non-consistent.
     //       Import a json library supporting streaming parse.
@@ -0,0 +1,430 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/merge_join_node.h"
+
+#include <algorithm>
+
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+static bool has_null_key(const Columns& keys, size_t row) {
+    for (const auto& key : keys) {
+        if (key->is_null(row)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns <0, 0 or >0 as the key at |lhs_row| of |lhs| is less than, equal to or greater than the key at |rhs_row|
+// of |rhs|, neither of which has a null.
+static int compare_keys(const Columns& lhs, size_t lhs_row, const Columns& rhs, size_t rhs_row) {
+    for (size_t i = 0; i < lhs.size(); i++) {
+        const Column* lhs_data = ColumnHelper::get_data_column(lhs[i].get());
+        const Column* rhs_data = ColumnHelper::get_data_column(rhs[i].get());
+        int res = lhs_data->compare_at(lhs_row, rhs_row, *rhs_data, 1);
+        if (res != 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+// The children may return nullable columns for the slots not nullable, upgrade |*dest| then.
+static void upgrade_to_nullable(ColumnPtr* dest, const Column& src) {
+    if (src.is_nullable() && !(*dest)->is_nullable()) {
+        size_t size = (*dest)->size();
+        *dest = NullableColumn::create(*dest, NullColumn::create(size, 0));
+    }
+}
+
+static void append_tuple_rows(ColumnPtr* dest, const Chunk& src, TupleId tuple_id, size_t offset, size_t count) {
+    if (src.is_tuple_exist(tuple_id)) {
+        (*dest)->append(*src.get_tuple_column_by_id(tuple_id), offset, count);
+    } else {
+        uint8_t matched = 1;
+        (*dest)->append_value_multiple_times(&matched, count);
+    }
+}
+
+MergeJoinNode::MergeJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs) {}
+
+Status MergeJoinNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::init(tnode, state));
+
+    const TMergeJoinNode& merge_join_node = tnode.merge_join_node;
+    if (merge_join_node.__isset.join_op) {
+        _join_type = merge_join_node.join_op;
+    }
+    switch (_join_type) {
+    case TJoinOp::INNER_JOIN:
+    case TJoinOp::LEFT_OUTER_JOIN:
+    case TJoinOp::LEFT_SEMI_JOIN:
+    case TJoinOp::LEFT_ANTI_JOIN:
+        break;
+    default:
+        return Status::NotSupported("merge join only supports inner, left outer, left semi and left anti joins");
+    }
+
+    if (merge_join_node.cmp_conjuncts.empty()) {
+        return Status::InternalError("merge join without join keys");
+    }
+    for (const auto& cmp_conjunct : merge_join_node.cmp_conjuncts) {
+        if (cmp_conjunct.__isset.opcode && cmp_conjunct.opcode == TExprOpcode::EQ_FOR_NULL) {
+            return Status::NotSupported("merge join doesn't support the null safe equal join keys");
+        }
+        ExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, cmp_conjunct.left, &ctx));
+        _left_expr_ctxs.push_back(ctx);
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, cmp_conjunct.right, &ctx));
+        _right_expr_ctxs.push_back(ctx);
+    }
+
+    RETURN_IF_ERROR(Expr::create_expr_trees(_pool, merge_join_node.other_join_conjuncts, &_other_join_conjunct_ctxs));
+    if (!_other_join_conjunct_ctxs.empty() && _join_type != TJoinOp::INNER_JOIN) {
+        return Status::NotSupported("merge join only supports the other join conjuncts of the inner joins");
+    }
+    return Status::OK();
+}
+
+Status MergeJoinNode::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+
+    _left_rows_counter = ADD_COUNTER(runtime_profile(), "LeftRows", TUnit::UNIT);
+    _right_rows_counter = ADD_COUNTER(runtime_profile(), "RightRows", TUnit::UNIT);
+    _max_run_rows_counter = ADD_COUNTER(runtime_profile(), "MaxRunRows", TUnit::UNIT);
+
+    RETURN_IF_ERROR(Expr::prepare(_left_expr_ctxs, state, child(0)->row_desc(), expr_mem_tracker()));
+    RETURN_IF_ERROR(Expr::prepare(_right_expr_ctxs, state, child(1)->row_desc(), expr_mem_tracker()));
+    RETURN_IF_ERROR(Expr::prepare(_other_join_conjunct_ctxs, state, _row_descriptor, expr_mem_tracker()));
+    // The keys are compared by the columns, which must be of the same type on both sides.
+    for (size_t i = 0; i < _left_expr_ctxs.size(); i++) {
+        if (!(_left_expr_ctxs[i]->root()->type() == _right_expr_ctxs[i]->root()->type())) {
+            return Status::NotSupported("merge join keys must be of the same type on both sides");
+        }
+    }
+
+    _init_row_desc();
+    return Status::OK();
+}
+
+Status MergeJoinNode::open(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::open(state));
+    RETURN_IF_CANCELLED(state);
+
+    RETURN_IF_ERROR(Expr::open(_left_expr_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_right_expr_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_other_join_conjunct_ctxs, state));
+
+    RETURN_IF_ERROR(child(0)->open(state));
+    RETURN_IF_ERROR(child(1)->open(state));
+    return Status::OK();
+}
+
+Status MergeJoinNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
+    return Status::NotSupported("get_next for row_batch is not supported");
+}
+
+Status MergeJoinNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    if (reached_limit()) {
+        *eos = true;
+        return Status::OK();
+    }
+    do {
+        RETURN_IF_ERROR(_get_next_internal(state, chunk, eos));
+    } while (!*eos && (*chunk)->num_rows() == 0);
+    if (!*eos) {
+        _update_rows_returned(chunk);
+    }
+    return Status::OK();
+}
+
+Status MergeJoinNode::_get_next_internal(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    *chunk = _create_chunk(true, _output_right());
+    const size_t batch_size = state->batch_size();
+    size_t num_rows = 0;
+    while (num_rows < batch_size) {
+        RETURN_IF_ERROR(_next_row(state, 0, _left_expr_ctxs, &_left_chunk, &_left_keys, &_left_index, &_left_eos));
+        if (_left_eos) {
+            break;
+        }
+        if (has_null_key(_left_keys, _left_index)) {
+            if (_output_unmatched()) {
+                _append_unmatched_row(chunk);
+                num_rows++;
+            }
+            _left_index++;
+            continue;
+        }
+
+        if (_run_chunk == nullptr ? !_right_eos : compare_keys(_left_keys, _left_index, _run_keys, 0) > 0) {
+            RETURN_IF_ERROR(_seek_run(state));
+        }
+        if (_run_chunk == nullptr && _right_eos && !_output_unmatched()) {
+            // None of the left rows left matches.
+            _left_chunk.reset();
+            _left_eos = true;
+            break;
+        }
+
+        if (_run_chunk != nullptr && compare_keys(_left_keys, _left_index, _run_keys, 0) == 0) {
+            if (_join_type == TJoinOp::LEFT_SEMI_JOIN) {
+                _append_left_rows(chunk, 1);
+                num_rows++;
+                _left_index++;
+            } else if (_join_type == TJoinOp::LEFT_ANTI_JOIN) {
+                _left_index++;
+            } else {
+                // A large run may take several chunks to join with a single left row.
+                size_t count = std::min(_run_rows - _run_offset, batch_size - num_rows);
+                _append_matched_rows(chunk, _run_offset, count);
+                num_rows += count;
+                _run_offset += count;
+                if (_run_offset == _run_rows) {
+                    _run_offset = 0;
+                    _left_index++;
+                }
+            }
+            continue;
+        }
+
+        if (_output_unmatched()) {
+            _append_unmatched_row(chunk);
+            num_rows++;
+        }
+        _left_index++;
+    }
+
+    if (num_rows == 0) {
+        *eos = true;
+        return Status::OK();
+    }
+    eval_conjuncts(_other_join_conjunct_ctxs, chunk->get());
+    eval_conjuncts(_conjunct_ctxs, chunk->get());
+    *eos = false;
+    return Status::OK();
+}
+
+Status MergeJoinNode::_next_row(RuntimeState* state, int child_idx, const std::vector<ExprContext*>& expr_ctxs,
+                                ChunkPtr* chunk, Columns* keys, size_t* index, bool* eos) {
+    while (*chunk == nullptr || *index >= (*chunk)->num_rows()) {
+        if (*eos) {
+            return Status::OK();
+        }
+        RETURN_IF_CANCELLED(state);
+        ChunkPtr next_chunk = nullptr;
+        RETURN_IF_ERROR(child(child_idx)->get_next(state, &next_chunk, eos));
+        if (*eos) {
+            chunk->reset();
+            keys->clear();
+            return Status::OK();
+        }
+        if (next_chunk == nullptr || next_chunk->num_rows() == 0) {
+            continue;
+        }
+        COUNTER_UPDATE(child_idx == 0 ? _left_rows_counter : _right_rows_counter, next_chunk->num_rows());
+
+        keys->clear();
+        for (ExprContext* ctx : expr_ctxs) {
+            ColumnPtr key = ctx->evaluate(next_chunk.get());
+            keys->emplace_back(ColumnHelper::unpack_and_duplicate_const_column(next_chunk->num_rows(), key));
+        }
+        *chunk = std::move(next_chunk);
+        *index = 0;
+    }
+    return Status::OK();
+}
+
+Status MergeJoinNode::_seek_run(RuntimeState* state) {
+    _run_chunk.reset();
+    _run_keys.clear();
+    _run_rows = 0;
+    _run_offset = 0;
+
+    // Skip the right rows less than the left key, a chunk at a time if its last row is.
+    while (true) {
+        RETURN_IF_ERROR(
+                _next_row(state, 1, _right_expr_ctxs, &_right_chunk, &_right_keys, &_right_index, &_right_eos));
+        if (_right_eos) {
+            return Status::OK();
+        }
+        size_t last = _right_chunk->num_rows() - 1;
+        if (_right_index < last && !has_null_key(_right_keys, last) &&
+            compare_keys(_right_keys, last, _left_keys, _left_index) < 0) {
+            _right_index = last + 1;
+            continue;
+        }
+        if (!has_null_key(_right_keys, _right_index) &&
+            compare_keys(_right_keys, _right_index, _left_keys, _left_index) >= 0) {
+            break;
+        }
+        _right_index++;
+    }
+
+    for (const auto& key : _right_keys) {
+        ColumnPtr run_key = key->clone_empty();
+        run_key->append(*key, _right_index, 1);
+        _run_keys.emplace_back(std::move(run_key));
+    }
+    _run_chunk = _create_chunk(false, true);
+    // Copy the rows of the run key, which may go on in the next right chunks.
+    while (true) {
+        size_t num_rows = _right_chunk->num_rows();
+        size_t end = _right_index;
+        while (end < num_rows && !has_null_key(_right_keys, end) && compare_keys(_right_keys, end, _run_keys, 0) == 0) {
+            end++;
+        }
+        size_t count = end - _right_index;
+        for (SlotDescriptor* slot : _right_slots) {
+            const ColumnPtr& src = _right_chunk->get_column_by_slot_id(slot->id());
+            ColumnPtr& dest = _run_chunk->get_column_by_slot_id(slot->id());
+            upgrade_to_nullable(&dest, *src);
+            dest->append(*src, _right_index, count);
+        }
+        for (TupleId tuple_id : _output_right_tuple_ids) {
+            append_tuple_rows(&_run_chunk->get_tuple_column_by_id(tuple_id), *_right_chunk, tuple_id, _right_index,
+                              count);
+        }
+        _run_rows += count;
+        _right_index = end;
+        if (end < num_rows) {
+            break;
+        }
+        RETURN_IF_ERROR(
+                _next_row(state, 1, _right_expr_ctxs, &_right_chunk, &_right_keys, &_right_index, &_right_eos));
+        if (_right_eos) {
+            break;
+        }
+    }
+    COUNTER_SET(_max_run_rows_counter, std::max(_max_run_rows_counter->value(), static_cast<int64_t>(_run_rows)));
+    return Status::OK();
+}
+
+void MergeJoinNode::_init_row_desc() {
+    for (const auto& tuple_desc : child(0)->row_desc().tuple_descriptors()) {
+        for (const auto& slot : tuple_desc->slots()) {
+            _left_slots.emplace_back(slot);
+        }
+        if (_row_descriptor.get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+            _output_left_tuple_ids.emplace_back(tuple_desc->id());
+        }
+    }
+    if (!_output_right()) {
+        return;
+    }
+    for (const auto& tuple_desc : child(1)->row_desc().tuple_descriptors()) {
+        for (const auto& slot : tuple_desc->slots()) {
+            _right_slots.emplace_back(slot);
+        }
+        if (_row_descriptor.get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+            _output_right_tuple_ids.emplace_back(tuple_desc->id());
+        }
+    }
+}
+
+ChunkPtr MergeJoinNode::_create_chunk(bool left, bool right) const {
+    ChunkPtr chunk = std::make_shared<Chunk>();
+    if (left) {
+        for (SlotDescriptor* slot : _left_slots) {
+            chunk->append_column(ColumnHelper::create_column(slot->type(), slot->is_nullable()), slot->id());
+        }
+        for (TupleId tuple_id : _output_left_tuple_ids) {
+            chunk->append_tuple_column(BooleanColumn::create(), tuple_id);
+        }
+    }
+    if (right) {
+        // The right rows of the left outer joins may be nulls.
+        bool nullable = _join_type == TJoinOp::LEFT_OUTER_JOIN;
+        for (SlotDescriptor* slot : _right_slots) {
+            chunk->append_column(ColumnHelper::create_column(slot->type(), nullable || slot->is_nullable()),
+                                 slot->id());
+        }
+        for (TupleId tuple_id : _output_right_tuple_ids) {
+            chunk->append_tuple_column(BooleanColumn::create(), tuple_id);
+        }
+    }
+    return chunk;
+}
+
+void MergeJoinNode::_append_left_rows(ChunkPtr* chunk, size_t count) {
+    for (SlotDescriptor* slot : _left_slots) {
+        const ColumnPtr& src = _left_chunk->get_column_by_slot_id(slot->id());
+        ColumnPtr& dest = (*chunk)->get_column_by_slot_id(slot->id());
+        upgrade_to_nullable(&dest, *src);
+        dest->append_value_multiple_times(*src, _left_index, count);
+    }
+    for (TupleId tuple_id : _output_left_tuple_ids) {
+        ColumnPtr& dest = (*chunk)->get_tuple_column_by_id(tuple_id);
+        if (_left_chunk->is_tuple_exist(tuple_id)) {
+            dest->append_value_multiple_times(*_left_chunk->get_tuple_column_by_id(tuple_id), _left_index, count);
+        } else {
+            uint8_t matched = 1;
+            dest->append_value_multiple_times(&matched, count);
+        }
+    }
+}
+
+void MergeJoinNode::_append_matched_rows(ChunkPtr* chunk, size_t run_offset, size_t count) {
+    _append_left_rows(chunk, count);
+    for (SlotDescriptor* slot : _right_slots) {
+        const ColumnPtr& src = _run_chunk->get_column_by_slot_id(slot->id());
+        ColumnPtr& dest = (*chunk)->get_column_by_slot_id(slot->id());
+        upgrade_to_nullable(&dest, *src);
+        dest->append(*src, run_offset, count);
+    }
+    for (TupleId tuple_id : _output_right_tuple_ids) {
+        (*chunk)->get_tuple_column_by_id(tuple_id)->append(*_run_chunk->get_tuple_column_by_id(tuple_id), run_offset,
+                                                           count);
+    }
+}
+
+void MergeJoinNode::_append_unmatched_row(ChunkPtr* chunk) {
+    _append_left_rows(chunk, 1);
+    if (!_output_right()) {
+        return;
+    }
+    for (SlotDescriptor* slot : _right_slots) {
+        [[maybe_unused]] bool ok = (*chunk)->get_column_by_slot_id(slot->id())->append_nulls(1);
+        DCHECK(ok);
+    }
+    for (TupleId tuple_id : _output_right_tuple_ids) {
+        uint8_t matched = 0;
+        (*chunk)->get_tuple_column_by_id(tuple_id)->append_value_multiple_times(&matched, 1);
+    }
+}
+
+void MergeJoinNode::_update_rows_returned(ChunkPtr* chunk) {
+    _num_rows_returned += (*chunk)->num_rows();
+    if (reached_limit()) {
+        (*chunk)->set_num_rows((*chunk)->num_rows() - (_num_rows_returned - _limit));
+        _num_rows_returned = _limit;
+        COUNTER_SET(_rows_returned_counter, _limit);
+    } else {
+        COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    }
+}
+
+Status MergeJoinNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+
+    Expr::close(_left_expr_ctxs, state);
+    Expr::close(_right_expr_ctxs, state);
+    Expr::close(_other_join_conjunct_ctxs, state);
+
+    _left_chunk.reset();
+    _right_chunk.reset();
+    _run_chunk.reset();
+    return ExecNode::close(state);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,94 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "column/chunk.h"
+#include "exec/exec_node.h"
+
+namespace starrocks {
+
+class ExprContext;
+
+namespace vectorized {
+
+// MergeJoinNode joins two children sorted in ascending order on the join keys, child(0) on the left exprs of
+// cmp_conjuncts and child(1) on the right ones, by merging their chunk streams, so that only one run of the right
+// rows of equal keys is kept in memory rather than a hash table of the whole right child.
+//
+// The right rows of the key of the current left row are copied into _run_chunk, which may span several right chunks,
+// and the following left rows of the same key are joined with the same run. The rows of null keys match nothing,
+// wherever the children put them. Inner, left outer, left semi and left anti joins are supported, the other join
+// conjuncts of the inner joins only.
+class MergeJoinNode : public ExecNode {
+public:
+    MergeJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    ~MergeJoinNode() override = default;
+
+    Status init(const TPlanNode& tnode, RuntimeState* state) override;
+    Status prepare(RuntimeState* state) override;
+    Status open(RuntimeState* state) override;
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override;
+    Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+private:
+    Status _get_next_internal(RuntimeState* state, ChunkPtr* chunk, bool* eos);
+
+    // Make |*index| a row of |*chunk| unless the child is done, fetching its next chunk and evaluating its keys
+    // into |*keys| if needed.
+    Status _next_row(RuntimeState* state, int child_idx, const std::vector<ExprContext*>& expr_ctxs, ChunkPtr* chunk,
+                     Columns* keys, size_t* index, bool* eos);
+    // Load the run of the first right rows not less than the key of the current left row, none if the right child is
+    // done.
+    Status _seek_run(RuntimeState* state);
+
+    void _init_row_desc();
+    ChunkPtr _create_chunk(bool left, bool right) const;
+    // Append |count| copies of the current left row joined with the rows of _run_chunk from |run_offset|.
+    void _append_matched_rows(ChunkPtr* chunk, size_t run_offset, size_t count);
+    void _append_left_rows(ChunkPtr* chunk, size_t count);
+    void _append_unmatched_row(ChunkPtr* chunk);
+    void _update_rows_returned(ChunkPtr* chunk);
+
+    bool _output_right() const {
+        return _join_type == TJoinOp::INNER_JOIN || _join_type == TJoinOp::LEFT_OUTER_JOIN;
+    }
+    bool _output_unmatched() const {
+        return _join_type == TJoinOp::LEFT_OUTER_JOIN || _join_type == TJoinOp::LEFT_ANTI_JOIN;
+    }
+
+    TJoinOp::type _join_type = TJoinOp::INNER_JOIN;
+    std::vector<ExprContext*> _left_expr_ctxs;
+    std::vector<ExprContext*> _right_expr_ctxs;
+    std::vector<ExprContext*> _other_join_conjunct_ctxs;
+
+    ChunkPtr _left_chunk = nullptr;
+    Columns _left_keys;
+    size_t _left_index = 0;
+    bool _left_eos = false;
+
+    ChunkPtr _right_chunk = nullptr;
+    Columns _right_keys;
+    size_t _right_index = 0;
+    bool _right_eos = false;
+
+    // The right rows of the key _run_keys, null if there is no run.
+    ChunkPtr _run_chunk = nullptr;
+    // A single row each.
+    Columns _run_keys;
+    size_t _run_rows = 0;
+    // The rows of _run_chunk already joined with the current left row.
+    size_t _run_offset = 0;
+
+    std::vector<SlotDescriptor*> _left_slots;
+    std::vector<SlotDescriptor*> _right_slots;
+    std::vector<TupleId> _output_left_tuple_ids;
+    std::vector<TupleId> _output_right_tuple_ids;
+
+    RuntimeProfile::Counter* _left_rows_counter = nullptr;
+    RuntimeProfile::Counter* _right_rows_counter = nullptr;
+    RuntimeProfile::Counter* _max_run_rows_counter = nullptr;
+};
+
+} // namespace vectorized
+} // namespace starrocks
@@ -23,8 +23,13 @@
 #include "runtime/current_thread.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
+#include "runtime/scan_scheduler.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet_manager.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/rowid_range_option.h"
 #include "util/priority_thread_pool.hpp"
+#include "util/work_stealing_thread_pool.h"
 
 namespace starrocks::vectorized {
 
@@ -121,13 +126,14 @@ Status OlapScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
         const int32_t num_closed = _closed_scanners.load(std::memory_order_acquire);
         const int32_t num_pending = _pending_scanners.size();
         const int32_t num_running = _num_scanners - num_pending - num_closed;
-        if ((num_pending > 0) && (num_running < kMaxConcurrency)) {
-            // before we submit a new scanner to run, check whether it can fetch
-            // at least _chunks_per_scanner chunks from _chunk_pool.
-            if (_chunk_pool.size() >= (num_running + 1) * _chunks_per_scanner) {
-                OlapScanner* scanner = _pending_scanners.pop();
-                l.unlock();
-                (void)_submit_scanner(scanner, true);
+        // before we submit a new scanner to run, check whether it can fetch
+        // at least _chunks_per_scanner chunks from _chunk_pool.
+        if ((num_pending > 0) && _chunk_pool.size() >= (num_running + 1) * _chunks_per_scanner) {
+            OlapScanner* scanner = _pending_scanners.pop();
+            l.unlock();
+            if (!_submit_scanner(scanner, true)) {
+                l.lock();
+                _pending_scanners.push(scanner);
             }
         }
     }
@@ -183,6 +189,10 @@ Status OlapScanNode::close(RuntimeState* state) {
     }
 
     _close_pending_scanners();
+    if (_scan_registered) {
+        _runtime_state->exec_env()->scan_scheduler()->unregister_scan(_runtime_state->query_id());
+        _scan_registered = false;
+    }
 
     // free chunks in _chunk_pool.
     while (!_chunk_pool.empty()) {
@@ -222,6 +232,7 @@ void OlapScanNode::_fill_chunk_pool(int count, bool force_column_pool) {
 void OlapScanNode::_scanner_thread(OlapScanner* scanner) {
     CurrentThread::set_query_id(scanner->runtime_state()->query_id());
     CurrentThread::set_mem_tracker(mem_tracker());
+    const DataDir* data_dir = scanner->data_dir();
 
     Status status = scanner->open(_runtime_state);
     if (!status.ok()) {
@@ -260,7 +271,7 @@ void OlapScanNode::_scanner_thread(OlapScanner* scanner) {
         }
         DCHECK_CHUNK(chunk);
         // _result_chunks will be shutdown if error happened or has reached limit.
-        if (!_result_chunks.put(chunk)) {
+        if (!_result_chunks.blocking_put(chunk)) {
             mem_tracker()->release(chunk->memory_usage());
             status = Status::Aborted("_result_chunks has been shutdown");
             delete chunk;
@@ -271,6 +282,9 @@ void OlapScanNode::_scanner_thread(OlapScanner* scanner) {
             break;
         }
     }
+    // The slot is released before the next scanner is submitted, which is always granted a slot if this was
+    // the last one.
+    _release_scanner_slot(data_dir);
     Status global_status = _get_status();
     if (global_status.ok()) {
         if (status.ok() && resubmit) {
@@ -332,6 +346,9 @@ Status OlapScanNode::collect_query_statistics(QueryStatistics* statistics) {
     stats_item.set_scan_bytes(_read_compressed_counter->value());
     stats_item.set_scan_rows(_raw_rows_counter->value());
     stats_item.set_table_id(_tuple_desc->table_desc()->table_id());
+    stats_item.set_page_cache_bytes(_page_cache_bytes_counter->value());
+    stats_item.set_local_disk_bytes(_read_compressed_counter->value());
+    stats_item.set_index_filtered_bytes(_index_filtered_bytes_counter->value());
     statistics->add_stats_item(stats_item);
     return Status::OK();
 }
@@ -340,6 +357,13 @@ Status OlapScanNode::_start_scan(RuntimeState* state) {
     RETURN_IF_CANCELLED(state);
 
     // 1. Convert conjuncts to ColumnValueRange in each column
+    // The runtime filters arriving after this are converted by every scanner when it's opened, a filter
+    // arriving during the normalization may be converted twice, which is harmless.
+    for (const auto& [filter_id, desc] : _runtime_filter_collector.descriptors()) {
+        if (desc->runtime_filter() != nullptr) {
+            _normalized_runtime_filters.insert(filter_id);
+        }
+    }
     Status status;
     RETURN_IF_ERROR(details::normalize_conjuncts(_tuple_desc->slots(), _obj_pool, _conjunct_ctxs, _normalized_conjuncts,
                                                  _runtime_filter_collector, _is_null_vector, _column_value_ranges,
@@ -350,6 +374,7 @@ Status OlapScanNode::_start_scan(RuntimeState* state) {
 
     // 2. Using ColumnValueRange to Build StorageEngine filters
     RETURN_IF_ERROR(details::build_olap_filters(_column_value_ranges, _olap_filter));
+    RETURN_IF_ERROR(details::build_contains_filters(_tuple_desc->slots(), _conjunct_ctxs, _olap_filter));
 
     // 4. Using `Key Column`'s ColumnValueRange to split ScanRange to sererval `Sub ScanRange`
     RETURN_IF_ERROR(details::build_scan_key(_olap_scan_node.key_column_name, _column_value_ranges, _scan_keys,
@@ -374,6 +399,9 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
     _raw_rows_counter = ADD_COUNTER(_scan_profile, "RawRowsRead", TUnit::UNIT);
     _total_pages_num_counter = ADD_COUNTER(_scan_profile, "TotalPagesNum", TUnit::UNIT);
     _cached_pages_num_counter = ADD_COUNTER(_scan_profile, "CachedPagesNum", TUnit::UNIT);
+    _cache_missed_pages_num_counter = ADD_COUNTER(_scan_profile, "CacheMissedPagesNum", TUnit::UNIT);
+    _read_ahead_bytes_counter = ADD_COUNTER(_scan_profile, "ReadAheadBytes", TUnit::BYTES);
+    _page_cache_bytes_counter = ADD_COUNTER(_scan_profile, "PageCacheBytesRead", TUnit::BYTES);
     _pushdown_predicates_counter = ADD_COUNTER(_scan_profile, "PushdownPredicates", TUnit::UNIT);
 
     /// SegmentInit
@@ -383,6 +411,7 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
     _bf_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BloomFilterFilterRows", TUnit::UNIT, "SegmentInit");
     _zm_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ZoneMapIndexFilterRows", TUnit::UNIT, "SegmentInit");
     _sk_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ShortKeyFilterRows", TUnit::UNIT, "SegmentInit");
+    _index_filtered_bytes_counter = ADD_CHILD_COUNTER(_scan_profile, "IndexFilterBytes", TUnit::BYTES, "SegmentInit");
 
     /// SegmentRead
     _block_load_timer = ADD_TIMER(_scan_profile, "SegmentRead");
@@ -397,8 +426,9 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
     _decompress_timer = ADD_CHILD_TIMER(_scan_profile, "DecompressT", "SegmentRead");
     _index_load_timer = ADD_CHILD_TIMER(_scan_profile, "IndexLoad", "SegmentRead");
 
-    /// IOTime
+    /// IOTime, and the IOLatency* counters of the reads by their latencies added by the scanners.
     _io_timer = ADD_TIMER(_scan_profile, "IOTime");
+    _io_counter = ADD_CHILD_COUNTER(_scan_profile, "IOCount", TUnit::UNIT, "IOTime");
 }
 
 // The more tasks you submit, the less priority you get.
@@ -431,27 +461,96 @@ int OlapScanNode::_compute_priority(int32_t num_submitted_tasks) {
     return 0;
 }
 
+template <typename Pool>
+static bool offer_scan_task(Pool* pool, const PriorityThreadPool::Task& task, bool blockable) {
+    if (LIKELY(pool->try_offer(task))) {
+        return true;
+    } else if (blockable) {
+        CHECK(pool->offer(task));
+        return true;
+    }
+    return false;
+}
+
 bool OlapScanNode::_submit_scanner(OlapScanner* scanner, bool blockable) {
-    PriorityThreadPool* thread_pool = _runtime_state->exec_env()->thread_pool();
+    ScanScheduler* scheduler = _runtime_state->exec_env()->scan_scheduler();
+    // A scan node without any submitted scanner is always granted a slot, otherwise it would never be woken up.
+    bool force = _scheduled_scanners.load(std::memory_order_acquire) == 0;
+    if (!scheduler->try_acquire(_runtime_state->query_id(), scanner->data_dir(), force)) {
+        return false;
+    }
+    _scheduled_scanners.fetch_add(1, std::memory_order_release);
+
+    ExecEnv* exec_env = _runtime_state->exec_env();
     int delta = !scanner->keep_priority();
     int32_t num_submit = _scanner_submit_count.fetch_add(delta, std::memory_order_relaxed);
     PriorityThreadPool::Task task;
     task.work_function = [this, scanner] { _scanner_thread(scanner); };
     task.priority = _compute_priority(num_submit);
+    task.group_id = _runtime_state->query_id().lo;
     _running_threads.fetch_add(1, std::memory_order_release);
-    if (LIKELY(thread_pool->try_offer(task))) {
-        return true;
-    } else if (blockable) {
-        CHECK(thread_pool->offer(task));
+    bool offered = exec_env->scan_thread_pool() != nullptr
+                           ? offer_scan_task(exec_env->scan_thread_pool(), task, blockable)
+                           : offer_scan_task(exec_env->thread_pool(), task, blockable);
+    if (LIKELY(offered)) {
         return true;
     } else {
         LOG(WARNING) << "thread pool busy";
         _running_threads.fetch_sub(1, std::memory_order_release);
         _scanner_submit_count.fetch_sub(delta, std::memory_order_relaxed);
+        _release_scanner_slot(scanner->data_dir());
         return false;
     }
 }
 
+void OlapScanNode::_release_scanner_slot(const DataDir* data_dir) {
+    _runtime_state->exec_env()->scan_scheduler()->release(_runtime_state->query_id(), data_dir);
+    _scheduled_scanners.fetch_sub(1, std::memory_order_release);
+}
+
+Status OlapScanNode::_get_late_runtime_filters(std::vector<TCondition>* filters) const {
+    RuntimeFilterProbeCollector late_runtime_filters;
+    for (const auto& [filter_id, desc] : _runtime_filter_collector.descriptors()) {
+        if (desc->runtime_filter() != nullptr && _normalized_runtime_filters.count(filter_id) == 0) {
+            late_runtime_filters.add_descriptor(desc);
+        }
+    }
+    if (late_runtime_filters.empty()) {
+        return Status::OK();
+    }
+
+    ObjectPool obj_pool;
+    std::vector<ExprContext*> conjunct_ctxs;
+    std::vector<bool> normalized_conjuncts;
+    std::vector<TCondition> is_null_vector;
+    std::map<std::string, ColumnValueRangeType> column_value_ranges;
+    Status status;
+    RETURN_IF_ERROR(details::normalize_conjuncts(_tuple_desc->slots(), obj_pool, conjunct_ctxs, normalized_conjuncts,
+                                                 late_runtime_filters, is_null_vector, column_value_ranges, &status));
+    RETURN_IF_ERROR(status);
+    return details::build_olap_filters(column_value_ranges, *filters);
+}
+
+// Split the tablet of |scan_range| into the rowid ranges to read concurrently, |ranges| is left empty if the tablet
+// should be read as a whole.
+static void split_tablet(const TInternalScanRange& scan_range, bool skip_aggregation,
+                         std::vector<RowidRangeOptionPtr>* ranges) {
+    SchemaHash schema_hash = strtoul(scan_range.schema_hash.c_str(), nullptr, 10);
+    int64_t version = strtoul(scan_range.version.c_str(), nullptr, 10);
+    std::string err;
+    auto tablet =
+            StorageEngine::instance()->tablet_manager()->get_tablet(scan_range.tablet_id, schema_hash, true, &err);
+    if (tablet == nullptr) {
+        // Reported by the scanner.
+        return;
+    }
+    Status st = split_tablet_by_rowid_ranges(tablet, version, skip_aggregation, config::olap_scan_tablet_split_rows,
+                                             ranges);
+    if (!st.ok()) {
+        ranges->clear();
+    }
+}
+
 Status OlapScanNode::_start_scan_thread(RuntimeState* state) {
     if (_scan_ranges.empty()) {
         _update_status(Status::EndOfFile("empty scan ranges"));
@@ -478,6 +577,18 @@ Status OlapScanNode::_start_scan_thread(RuntimeState* state) {
     for (auto& scan_range : _scan_ranges) {
         int num_ranges = cond_ranges.size();
         int ranges_per_scanner = std::max(1, num_ranges / scanners_per_tablet);
+        // A tablet read by a single scanner is split into the rowid ranges of its segments, each read by one scanner,
+        // and all of them feed |_result_chunks|.
+        auto start_version = _tablet_start_versions.find(scan_range->tablet_id);
+        std::vector<RowidRangeOptionPtr> rowid_ranges;
+        // The rowid ranges cover all the segments of the tablet, not only those of the start versions.
+        if (num_ranges == 1 && scanners_per_tablet > 1 && config::olap_scan_tablet_split_rows > 0 &&
+            start_version == _tablet_start_versions.end()) {
+            split_tablet(*scan_range, _olap_scan_node.is_preaggregation, &rowid_ranges);
+        }
+        if (rowid_ranges.empty()) {
+            rowid_ranges.emplace_back(nullptr);
+        }
         for (int i = 0; i < num_ranges;) {
             std::vector<OlapScanRange*> scanner_ranges;
             scanner_ranges.push_back(cond_ranges[i].get());
@@ -488,30 +599,45 @@ Status OlapScanNode::_start_scan_thread(RuntimeState* state) {
                 scanner_ranges.push_back(cond_ranges[i].get());
             }
 
-            OlapScannerParams scanner_params;
-            scanner_params.scan_range = scan_range.get();
-            scanner_params.key_ranges = &scanner_ranges;
-            scanner_params.conjunct_ctxs = &predicates;
-            scanner_params.skip_aggregation = _olap_scan_node.is_preaggregation;
-            scanner_params.need_agg_finalize = true;
-            auto* scanner = _obj_pool.add(new OlapScanner(this));
-            RETURN_IF_ERROR(scanner->init(state, scanner_params));
-            // Assume all scanners have the same schema.
-            _chunk_schema = &scanner->chunk_schema();
-            _pending_scanners.push(scanner);
+            for (auto& rowid_range : rowid_ranges) {
+                OlapScannerParams scanner_params;
+                scanner_params.scan_range = scan_range.get();
+                scanner_params.key_ranges = &scanner_ranges;
+                scanner_params.conjunct_ctxs = &predicates;
+                scanner_params.rowid_range_option = rowid_range;
+                scanner_params.skip_aggregation = _olap_scan_node.is_preaggregation;
+                scanner_params.need_agg_finalize = true;
+                if (start_version != _tablet_start_versions.end()) {
+                    scanner_params.start_version = start_version->second;
+                }
+                auto* scanner = _obj_pool.add(new OlapScanner(this));
+                RETURN_IF_ERROR(scanner->init(state, scanner_params));
+                // Assume all scanners have the same schema.
+                _chunk_schema = &scanner->chunk_schema();
+                _pending_scanners.push(scanner);
+            }
         }
     }
     _pending_scanners.reverse();
     _num_scanners = _pending_scanners.size();
     _chunks_per_scanner = config::doris_scanner_row_num / config::vector_chunk_size;
     _chunks_per_scanner += (config::doris_scanner_row_num % config::vector_chunk_size != 0);
-    int concurrency = std::min<int>(kMaxConcurrency, _num_scanners);
+    // The scanners beyond the slots granted now are submitted by get_next once they are granted.
+    ScanScheduler* scheduler = state->exec_env()->scan_scheduler();
+    scheduler->register_scan(state->query_id());
+    _scan_registered = true;
+    int concurrency = std::min<int>(scheduler->max_scanners(), _num_scanners);
     int chunks = _chunks_per_scanner * concurrency;
+    _result_chunks.init(chunks);
     _chunk_pool.reserve(chunks);
     _fill_chunk_pool(chunks, true);
     std::lock_guard<std::mutex> l(_mtx);
     for (int i = 0; i < concurrency; i++) {
-        CHECK(_submit_scanner(_pending_scanners.pop(), true));
+        OlapScanner* scanner = _pending_scanners.pop();
+        if (!_submit_scanner(scanner, true)) {
+            _pending_scanners.push(scanner);
+            break;
+        }
     }
     return Status::OK();
 }
@@ -551,9 +677,16 @@ void OlapScanNode::_close_pending_scanners() {
 pipeline::OpFactories OlapScanNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
     OpFactories operators;
-    operators.emplace_back(std::make_shared<ScanOperatorFactory>(context->next_operator_id(), id(), _olap_scan_node,
-                                                                 std::move(_conjunct_ctxs),
-                                                                 std::move(_runtime_filter_collector)));
+    auto scan_operator = std::make_shared<ScanOperatorFactory>(context->next_operator_id(), id(), _olap_scan_node,
+                                                               std::move(_conjunct_ctxs),
+                                                               std::move(_runtime_filter_collector));
+    scan_operator->set_runtime_predicate(_runtime_predicate);
+    // There is no need to create more drivers than morsels
+    auto& morsel_queues = context->fragment_context()->morsel_queues();
+    auto num_morsels = morsel_queues[id()]->num_morsels();
+    scan_operator->set_degree_of_parallelism(
+            std::max<size_t>(1, std::min<size_t>(num_morsels, context->driver_instance_count())));
+    operators.emplace_back(std::move(scan_operator));
     if (limit() != -1) {
         operators.emplace_back(std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
     }
@@ -5,14 +5,19 @@
 #include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "column/chunk.h"
 #include "exec/olap_common.h"
 #include "exec/scan_node.h"
 #include "exec/vectorized/olap_scanner.h"
+#include "storage/vectorized/runtime_predicate.h"
+#include "util/mpmc_queue.h"
 
 namespace starrocks {
+class DataDir;
 class DescriptorTbl;
 class SlotDescriptor;
 class TupleDescriptor;
@@ -21,7 +26,8 @@ class TupleDescriptor;
 namespace starrocks::vectorized {
 
 // OlapScanNode fetch records from storage engine and pass them to the parent node.
-// It will submit many OlapScanner to a global-shared thread pool to execute concurrently.
+// It will submit many OlapScanner to a global-shared thread pool to execute concurrently, each of which
+// holds a slot granted by the ScanScheduler of the BE while it's submitted.
 //
 // Execution flow:
 // 1. OlapScanNode creates many empty chunks and put them into _chunk_pool.
@@ -33,7 +39,9 @@ namespace starrocks::vectorized {
 //
 // If _chunk_pool is empty, OlapScanners will quit the thread pool and put themself to the
 // _pending_scanners. After enough chunks has been placed into _chunk_pool, OlapScanNode will
-// resubmit OlapScanners to the thread pool.
+// resubmit OlapScanners to the thread pool, if the ScanScheduler grants them slots.
+// The chunks in _result_chunks are bounded by the chunks created for the max number of the slots, so it's a
+// lock-free queue of that capacity, which the scanners never wait on to put.
 class OlapScanNode final : public starrocks::ScanNode {
 public:
     OlapScanNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
@@ -56,14 +64,25 @@ public:
 
     Status set_scan_range(const TInternalScanRange& range);
 
+    // Read only the versions from |start_versions[tablet id]| on of the tablets in |start_versions|, whose older
+    // versions are aggregated already, see FragmentResultCache.
+    void set_tablet_start_versions(std::unordered_map<int64_t, int64_t> start_versions) {
+        _tablet_start_versions = std::move(start_versions);
+    }
+
     std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
             pipeline::PipelineBuilderContext* context) override;
 
+    const TOlapScanNode& thrift_olap_scan_node() const { return _olap_scan_node; }
+
+    // The scanners prune the data pages by the conditions of |runtime_predicate| published by the parent.
+    void set_runtime_predicate(RuntimePredicatePtr runtime_predicate) {
+        _runtime_predicate = std::move(runtime_predicate);
+    }
+
 private:
     friend class OlapScanner;
 
-    constexpr static const int kMaxConcurrency = 50;
-
     template <typename T>
     class Stack {
     public:
@@ -93,6 +112,9 @@ private:
 
     Status _start_scan(RuntimeState* state);
     Status _start_scan_thread(RuntimeState* state);
+    // Convert the join runtime filters arriving after _start_scan normalized the conjuncts into the
+    // index only olap filters, so that the scanners opened later could still prune with them.
+    Status _get_late_runtime_filters(std::vector<TCondition>* filters) const;
     void _scanner_thread(OlapScanner* scanner);
 
     void _init_counter(RuntimeState* state);
@@ -101,13 +123,16 @@ private:
     Status _get_status();
 
     void _fill_chunk_pool(int count, bool force_column_pool);
+    // Returns false if the ScanScheduler doesn't grant |scanner| a slot or the thread pool is busy.
     bool _submit_scanner(OlapScanner* scanner, bool blockable);
+    void _release_scanner_slot(const DataDir* data_dir);
     void _close_pending_scanners();
     int _compute_priority(int32_t num_submitted_tasks);
 
     // params
     TOlapScanNode _olap_scan_node;
     std::vector<std::unique_ptr<TInternalScanRange>> _scan_ranges;
+    std::unordered_map<int64_t, int64_t> _tablet_start_versions;
     RuntimeState* _runtime_state = nullptr;
 
     // constructed from params
@@ -122,6 +147,9 @@ private:
     const Schema* _chunk_schema = nullptr;
     // same size with |_conjunct_ctxs|, indicate which element has been normalized.
     std::vector<bool> _normalized_conjuncts;
+    // The join runtime filters which had arrived when the conjuncts were normalized.
+    std::set<int32_t> _normalized_runtime_filters;
+    RuntimePredicatePtr _runtime_predicate;
     int32_t _num_scanners = 0;
     int32_t _chunks_per_scanner = 10;
     int32_t _max_scan_key_num = 1024;
@@ -135,12 +163,15 @@ private:
     Stack<Chunk*> _chunk_pool;
     Stack<OlapScanner*> _pending_scanners;
 
-    UnboundedBlockingQueue<Chunk*> _result_chunks;
+    BoundedMPMCQueue<Chunk*> _result_chunks;
 
     // used to compute task priority.
     std::atomic<int32_t> _scanner_submit_count{0};
     std::atomic<int32_t> _running_threads{0};
     std::atomic<int32_t> _closed_scanners{0};
+    // the slots of the ScanScheduler held by the submitted scanners.
+    std::atomic<int32_t> _scheduled_scanners{0};
+    bool _scan_registered = false;
 
     // profile
     RuntimeProfile* _scan_profile = nullptr;
@@ -170,6 +201,11 @@ private:
     RuntimeProfile::Counter* _index_load_timer = nullptr;
     RuntimeProfile::Counter* _total_pages_num_counter = nullptr;
     RuntimeProfile::Counter* _cached_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _cache_missed_pages_num_counter = nullptr;
+    RuntimeProfile::Counter* _read_ahead_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _page_cache_bytes_counter = nullptr;
+    RuntimeProfile::Counter* _io_counter = nullptr;
+    RuntimeProfile::Counter* _index_filtered_bytes_counter = nullptr;
     RuntimeProfile::Counter* _bi_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bi_filter_timer = nullptr;
     RuntimeProfile::Counter* _pushdown_predicates_counter = nullptr;
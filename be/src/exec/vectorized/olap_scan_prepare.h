@@ -2,8 +2,12 @@
 
 #pragma once
 
+#include <algorithm>
+
+#include "column/binary_column.h"
 #include "column/const_column.h"
 #include "column/type_traits.h"
+#include "common/config.h"
 #include "common/status.h"
 #include "exec/olap_common.h"
 #include "exprs/expr.h"
@@ -690,6 +694,86 @@ static Status build_olap_filters(const std::map<std::string, ColumnValueRangeTyp
     return Status::OK();
 }
 
+// Split a LIKE pattern into the literal substrings between the wildcards.
+static std::vector<std::string> like_pattern_substrings(const Slice& pattern) {
+    std::vector<std::string> substrings;
+    std::string substring;
+    for (size_t i = 0; i < pattern.size; ++i) {
+        char c = pattern.data[i];
+        if (c == '\\' && i + 1 < pattern.size) {
+            substring.push_back(pattern.data[++i]);
+        } else if (c == '%' || c == '_') {
+            if (!substring.empty()) {
+                substrings.emplace_back(std::move(substring));
+                substring.clear();
+            }
+        } else {
+            substring.push_back(c);
+        }
+    }
+    if (!substring.empty()) {
+        substrings.emplace_back(std::move(substring));
+    }
+    return substrings;
+}
+
+// The string column of `col LIKE 'pattern'` contains all the literal substrings of the pattern, which are
+// pushed down as an index-only predicate to skip the data pages by their n-gram bloom filters. The conjuncts are
+// still evaluated by the scan.
+static Status build_contains_filters(const std::vector<SlotDescriptor*>& slots,
+                                     const std::vector<ExprContext*>& conjunct_ctxs,
+                                     std::vector<TCondition>& olap_filter) {
+    RETURN_IF(config::ngram_bloom_filter_gram_size <= 0, Status::OK());
+    for (ExprContext* ctx : conjunct_ctxs) {
+        const Expr* root_expr = ctx->root();
+        if (root_expr->node_type() != TExprNodeType::FUNCTION_CALL || root_expr->get_num_children() != 2 ||
+            root_expr->fn().name.function_name != "like") {
+            continue;
+        }
+        Expr* l = root_expr->get_child(0);
+        Expr* r = root_expr->get_child(1);
+        if (l->node_type() != TExprNodeType::SLOT_REF || !r->is_constant()) {
+            continue;
+        }
+        std::vector<SlotId> slot_ids;
+        if (l->get_slot_ids(&slot_ids) != 1) {
+            continue;
+        }
+        auto iter = std::find_if(slots.begin(), slots.end(),
+                                 [&](const SlotDescriptor* slot) { return slot->id() == slot_ids[0]; });
+        if (iter == slots.end() || ((*iter)->type().type != TYPE_CHAR && (*iter)->type().type != TYPE_VARCHAR)) {
+            continue;
+        }
+
+        ColumnPtr column = ctx->evaluate(r, nullptr);
+        if (column == nullptr || column->size() != 1 || column->only_null() || column->is_null(0)) {
+            continue;
+        }
+        ColumnPtr data = column;
+        if (column->is_nullable()) {
+            data = down_cast<NullableColumn*>(column.get())->data_column();
+        } else if (column->is_constant()) {
+            data = down_cast<ConstColumn*>(column.get())->data_column();
+        }
+        if (!data->is_binary()) {
+            continue;
+        }
+        Slice pattern = down_cast<BinaryColumn*>(data.get())->get_slice(0);
+        std::vector<std::string> substrings = like_pattern_substrings(pattern);
+        if (substrings.empty()) {
+            continue;
+        }
+
+        TCondition condition;
+        condition.column_name = (*iter)->col_name();
+        condition.condition_op = "contains";
+        condition.condition_values = std::move(substrings);
+        condition.__set_is_index_filter_only(true);
+        olap_filter.emplace_back(std::move(condition));
+    }
+    return Status::OK();
+}
+
 // Try to convert the ranges predicates applied on key columns to in predicates to increase
 // the scan concurrency, i.e, the number of OlapScanners.
 // For example, if the original query is `select * from t where c0 between 1 and 3 and c1 between 12 and 13`,
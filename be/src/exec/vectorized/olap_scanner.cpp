@@ -22,6 +22,8 @@ Status OlapScanner::init(RuntimeState* runtime_state, const OlapScannerParams& p
     _runtime_state = runtime_state;
     _skip_aggregation = params.skip_aggregation;
     _need_agg_finalize = params.need_agg_finalize;
+    _start_version = params.start_version;
+    _params.rowid_range_option = params.rowid_range_option;
 
     RETURN_IF_ERROR(Expr::clone_if_not_exists(*params.conjunct_ctxs, runtime_state, &_conjunct_ctxs));
     RETURN_IF_ERROR(_get_tablet(params.scan_range));
@@ -97,7 +99,7 @@ Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_r
     _params.tablet = _tablet;
     _params.reader_type = READER_QUERY;
     _params.skip_aggregation = _skip_aggregation;
-    _params.version = Version(0, _version);
+    _params.version = Version(_start_version, _version);
     _params.profile = _parent->_scan_profile;
     _params.runtime_state = _runtime_state;
     // If a agg node is this scan node direct parent
@@ -106,6 +108,7 @@ Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_r
     _params.need_agg_finalize = _need_agg_finalize;
     _params.use_page_cache = !config::disable_storage_page_cache;
     _params.chunk_size = config::vector_chunk_size;
+    _params.runtime_predicate = _parent->_runtime_predicate;
 
     PredicateParser parser(_tablet->tablet_schema());
 
@@ -120,6 +123,17 @@ Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_r
             _predicates.add(p);
         }
     }
+    // The join runtime filters which arrived after the scan node started, they only prune by the indexes.
+    std::vector<TCondition> late_runtime_filters;
+    RETURN_IF_ERROR(_parent->_get_late_runtime_filters(&late_runtime_filters));
+    for (auto& filter : late_runtime_filters) {
+        ColumnPredicate* p = parser.parse(filter);
+        p->set_index_filter_only(filter.is_index_filter_only);
+        _predicate_free_pool.emplace_back(p);
+        if (parser.can_pushdown(p)) {
+            _params.predicates.push_back(p);
+        }
+    }
     for (auto& is_null_str : _parent->_is_null_vector) {
         ColumnPredicate* p = parser.parse(is_null_str);
         _predicate_free_pool.emplace_back(p);
@@ -130,6 +144,20 @@ Status OlapScanner::_init_reader_params(const std::vector<OlapScanRange*>* key_r
         }
     }
 
+    // The rows of the metadata scan are only valid for count(*), min and max without any predicate.
+    const TOlapScanNode& thrift_olap_scan_node = _parent->_olap_scan_node;
+    if (thrift_olap_scan_node.__isset.metadata_scan && thrift_olap_scan_node.metadata_scan &&
+        _conjunct_ctxs.empty() && _predicates.empty() && _params.predicates.empty() &&
+        _parent->_runtime_filter_collector.descriptors().empty()) {
+        _params.metadata_scan = true;
+        for (const auto& name : thrift_olap_scan_node.metadata_min_max_columns) {
+            int32_t index = _tablet->field_index(name);
+            if (index >= 0) {
+                _params.metadata_min_max_columns.push_back(index);
+            }
+        }
+    }
+
     // Range
     for (auto key_range : *key_ranges) {
         if (key_range->begin_scan_range.size() == 1 && key_range->begin_scan_range.get_value(0) == NEGATIVE_INFINITY) {
@@ -215,7 +243,7 @@ Status OlapScanner::get_chunk(RuntimeState* state, Chunk* chunk) {
         if (!_conjunct_ctxs.empty()) {
             int64_t old_mem_usage = chunk->memory_usage();
             SCOPED_TIMER(_expr_filter_timer);
-            ExecNode::eval_conjuncts(_conjunct_ctxs, chunk);
+            ExecNode::eval_conjuncts(_conjunct_ctxs, chunk, nullptr, &_conjunct_order);
             CurrentMemTracker::consume((int64_t)chunk->memory_usage() - old_mem_usage);
             DCHECK_CHUNK(chunk);
         }
@@ -242,6 +270,8 @@ void OlapScanner::update_counter() {
     COUNTER_UPDATE(_parent->_rows_read_counter, _num_rows_read);
 
     COUNTER_UPDATE(_parent->_io_timer, _reader->stats().io_ns);
+    COUNTER_UPDATE(_parent->_io_counter, _reader->stats().io_count);
+    _reader->stats().io_latency.update_profile(_parent->_scan_profile, "IOTime");
     COUNTER_UPDATE(_parent->_read_compressed_counter, _reader->stats().compressed_bytes_read);
     _compressed_bytes_read += _reader->stats().compressed_bytes_read;
     COUNTER_UPDATE(_parent->_decompress_timer, _reader->stats().decompress_ns);
@@ -270,6 +300,10 @@ void OlapScanner::update_counter() {
 
     COUNTER_UPDATE(_parent->_total_pages_num_counter, _reader->stats().total_pages_num);
     COUNTER_UPDATE(_parent->_cached_pages_num_counter, _reader->stats().cached_pages_num);
+    COUNTER_UPDATE(_parent->_cache_missed_pages_num_counter, _reader->stats().cache_missed_pages_num);
+    COUNTER_UPDATE(_parent->_read_ahead_bytes_counter, _reader->stats().read_ahead_bytes);
+    COUNTER_UPDATE(_parent->_page_cache_bytes_counter, _reader->stats().page_cache_bytes_read);
+    COUNTER_UPDATE(_parent->_index_filtered_bytes_counter, _reader->stats().bytes_index_filtered);
 
     COUNTER_UPDATE(_parent->_bi_filtered_counter, _reader->stats().rows_bitmap_index_filtered);
     COUNTER_UPDATE(_parent->_bi_filter_timer, _reader->stats().bitmap_index_filter_timer);
@@ -279,6 +313,8 @@ void OlapScanner::update_counter() {
 
     StarRocksMetrics::instance()->query_scan_bytes.increment(_compressed_bytes_read);
     StarRocksMetrics::instance()->query_scan_rows.increment(_raw_rows_read);
+    StarRocksMetrics::instance()->query_scan_page_cache_bytes.increment(_reader->stats().page_cache_bytes_read);
+    StarRocksMetrics::instance()->query_scan_index_filtered_bytes.increment(_reader->stats().bytes_index_filtered);
 
     if (_reader->stats().decode_dict_ns > 0) {
         RuntimeProfile::Counter* c = ADD_TIMER(_parent->_scan_profile, "DictDecode");
@@ -13,6 +13,7 @@
 #include "runtime/runtime_state.h"
 #include "storage/vectorized/conjunctive_predicates.h"
 #include "storage/vectorized/reader.h"
+#include "util/adaptive_predicate_order.h"
 #include "storage/vectorized/reader_params.h"
 
 namespace starrocks::vectorized {
@@ -23,9 +24,13 @@ struct OlapScannerParams {
     const TInternalScanRange* scan_range = nullptr;
     const std::vector<OlapScanRange*>* key_ranges = nullptr;
     const std::vector<ExprContext*>* conjunct_ctxs = nullptr;
+    // Read only the rowid range of a segment of the tablet, if not null.
+    RowidRangeOptionPtr rowid_range_option = nullptr;
 
     bool skip_aggregation = false;
     bool need_agg_finalize = true;
+    // Read only the rowsets of the versions from |start_version| on.
+    int64_t start_version = 0;
 };
 
 class OlapScanner {
@@ -49,6 +54,9 @@ public:
     // REQUIRES: `init(RuntimeState*, const OlapScannerParams&)` has been called.
     const Schema& chunk_schema() const { return _prj_iter->schema(); }
 
+    // REQUIRES: `init(RuntimeState*, const OlapScannerParams&)` has been called.
+    const DataDir* data_dir() const { return _tablet->data_dir(); }
+
     void set_keep_priority(bool v) { _keep_priority = v; }
     bool keep_priority() const { return _keep_priority; }
 
@@ -65,6 +73,7 @@ private:
     using PredicatePtr = std::unique_ptr<ColumnPredicate>;
 
     std::vector<ExprContext*> _conjunct_ctxs;
+    AdaptivePredicateOrder _conjunct_order;
     ConjunctivePredicates _predicates;
     std::vector<uint8_t> _selection;
 
@@ -81,6 +90,7 @@ private:
     std::shared_ptr<Reader> _reader;
 
     TabletSharedPtr _tablet;
+    int64_t _start_version = 0;
     int64_t _version = 0;
 
     // output columns of `this` OlapScanner, i.e, the final output columns of `get_chunk`.
@@ -4,9 +4,11 @@
 
 #include <glog/logging.h>
 
+#include <cstring>
 #include <exception>
 #include <limits>
 #include <set>
+#include <type_traits>
 #include <unordered_map>
 
 #include "cctz/civil_time.h"
@@ -91,6 +93,18 @@ static void fill_boolean_column_with_null(orc::ColumnVectorBatch* cvb, ColumnPtr
     c->update_has_null();
 }
 
+// the values of the same type, e.g. BIGINT from LongVectorBatch and DOUBLE from DoubleVectorBatch, are copied at once.
+template <typename T, typename OrcT>
+static inline void copy_orc_values(T* values, const OrcT* cvbd, int size) {
+    if constexpr (std::is_same_v<T, OrcT>) {
+        memcpy(values, cvbd, size * sizeof(T));
+    } else {
+        for (int i = 0; i < size; ++i) {
+            values[i] = cvbd[i];
+        }
+    }
+}
+
 template <PrimitiveType Type, typename OrcColumnVectorBatch>
 static void fill_int_column_from_cvb(OrcColumnVectorBatch* data, ColumnPtr& col, int from, int size,
                                      const TypeDescriptor& type_desc, void* ctx) {
@@ -102,11 +116,7 @@ static void fill_int_column_from_cvb(OrcColumnVectorBatch* data, ColumnPtr& col,
     auto* values = ColumnHelper::cast_to_raw<Type>(col)->get_data().data();
 
     auto* cvbd = data->data.data();
-
-    auto pos = from;
-    for (int i = col_start; i < col_start + size; ++i, ++pos) {
-        values[i] = cvbd[pos];
-    }
+    copy_orc_values(values + col_start, cvbd + from, size);
 
     // col_start == 0 and from == 0 means it's at top level of fill chunk, not in the middle of array
     // otherwise `broker_load_filter` does not work.
@@ -153,10 +163,7 @@ static void fill_int_column_with_null_from_cvb(OrcColumnVectorBatch* data, Colum
             nulls[i] = !cvbn[pos];
         }
     }
-    pos = from;
-    for (int i = col_start; i < col_start + size; ++i, ++pos) {
-        values[i] = cvbd[pos];
-    }
+    copy_orc_values(values + col_start, cvbd + from, size);
 
     // col_start == 0 and from == 0 means it's at top level of fill chunk, not in the middle of array
     // otherwise `broker_load_filter` does not work.
@@ -249,9 +256,7 @@ static void fill_float_column(orc::ColumnVectorBatch* cvb, ColumnPtr& col, int f
     auto* values = ColumnHelper::cast_to_raw<Type>(col)->get_data().data();
 
     auto* cvbd = data->data.data();
-    for (int i = col_start; i < col_start + size; ++i, ++from) {
-        values[i] = cvbd[from];
-    }
+    copy_orc_values(values + col_start, cvbd + from, size);
 }
 
 template <PrimitiveType Type>
@@ -273,10 +278,7 @@ static void fill_float_column_with_null(orc::ColumnVectorBatch* cvb, ColumnPtr&
             nulls[i] = !cvbn[pos];
         }
     }
-    pos = from;
-    for (int i = col_start; i < col_start + size; ++i, ++pos) {
-        values[i] = cvbd[pos];
-    }
+    copy_orc_values(values + col_start, cvbd + from, size);
     c->update_has_null();
 }
 
@@ -1011,6 +1013,9 @@ Status OrcScannerAdapter::_init_include_columns() {
     build_column_name_to_id_mapping(&_name_to_column_id, _hive_column_names, _reader->getType());
     std::unordered_map<int, std::string> column_id_to_orc_name;
     std::list<std::string> orc_column_names;
+    std::list<std::string> lazy_load_column_names;
+    _is_lazy_load_column.assign(_src_slot_descriptors.size(), false);
+    _has_lazy_load_columns = false;
 
     const auto& root_type = _reader->getType();
     for (size_t i = 0; i < root_type.getSubtypeCount(); i++) {
@@ -1018,7 +1023,8 @@ Status OrcScannerAdapter::_init_include_columns() {
         column_id_to_orc_name.emplace(sub_type->getColumnId(), root_type.getFieldName(i));
     }
 
-    for (SlotDescriptor* desc : _src_slot_descriptors) {
+    for (size_t i = 0; i < _src_slot_descriptors.size(); i++) {
+        SlotDescriptor* desc = _src_slot_descriptors[i];
         if (desc == nullptr) continue;
         auto it = _name_to_column_id.find(desc->col_name());
         if (it == _name_to_column_id.end()) {
@@ -1033,8 +1039,21 @@ Status OrcScannerAdapter::_init_include_columns() {
             return Status::NotFound(s);
         }
         orc_column_names.push_back(it2->second);
+        // broker load filters the rows while filling the columns
+        if (!_broker_load_mode && _lazy_load_slot_ids.count(desc->id()) > 0) {
+            lazy_load_column_names.push_back(it2->second);
+            _is_lazy_load_column[i] = true;
+            _has_lazy_load_columns = true;
+        }
+    }
+    // the columns are all lazy load columns if no columns filter the rows.
+    if (lazy_load_column_names.size() == orc_column_names.size()) {
+        lazy_load_column_names.clear();
+        _is_lazy_load_column.assign(_src_slot_descriptors.size(), false);
+        _has_lazy_load_columns = false;
     }
     _row_reader_options.include(orc_column_names);
+    _row_reader_options.setLazyLoadColumnNames(lazy_load_column_names);
     return Status::OK();
 }
 
@@ -1241,6 +1260,9 @@ Status OrcScannerAdapter::read_next() {
         if (!_row_reader->next(*_batch)) {
             return Status::EndOfFile("");
         }
+        if (_has_lazy_load_columns) {
+            _lazy_load_selection.assign(_batch->numElements, 1);
+        }
     } catch (std::exception& e) {
         auto s = strings::Substitute("OrcScannerAdpater::read_next failed. reason = $0", e.what());
         LOG(WARNING) << s;
@@ -1266,7 +1288,7 @@ Status OrcScannerAdapter::fill_chunk(ChunkPtr* chunk) {
     }
     for (int column_pos = 0; column_pos < column_size; ++column_pos) {
         SlotDescriptor* slot_desc = _src_slot_descriptors[column_pos];
-        if (slot_desc == nullptr) {
+        if (slot_desc == nullptr || _is_lazy_load_column[column_pos]) {
             continue;
         }
         set_current_slot(slot_desc);
@@ -1311,7 +1333,7 @@ ChunkPtr OrcScannerAdapter::create_chunk() {
 
     for (int column_pos = 0; column_pos < column_size; ++column_pos) {
         auto slot_desc = _src_slot_descriptors[column_pos];
-        if (slot_desc == nullptr) {
+        if (slot_desc == nullptr || _is_lazy_load_column[column_pos]) {
             continue;
         }
         auto col = ColumnHelper::create_column(_src_types[column_pos], slot_desc->is_nullable());
@@ -1326,7 +1348,7 @@ ChunkPtr OrcScannerAdapter::cast_chunk(ChunkPtr* chunk) {
     int column_size = _src_slot_descriptors.size();
     for (int column_pos = 0; column_pos < column_size; ++column_pos) {
         auto slot = _src_slot_descriptors[column_pos];
-        if (slot == nullptr) {
+        if (slot == nullptr || _is_lazy_load_column[column_pos]) {
             continue;
         }
         ColumnPtr col = _cast_exprs[column_pos]->evaluate(nullptr, src.get());
@@ -1336,6 +1358,105 @@ ChunkPtr OrcScannerAdapter::cast_chunk(ChunkPtr* chunk) {
     return cast_chunk;
 }
 
+void OrcScannerAdapter::select_lazy_load_rows(const Column::Filter* filter) {
+    uint8_t* selection = _lazy_load_selection.data();
+    if (filter == nullptr) {
+        memset(selection, 0, _lazy_load_selection.size());
+        return;
+    }
+    for (size_t i = 0, j = 0; i < _lazy_load_selection.size(); i++) {
+        if (selection[i]) {
+            DCHECK_LT(j, filter->size());
+            selection[i] = (*filter)[j++];
+        }
+    }
+}
+
+Status OrcScannerAdapter::lazy_load_chunk(ChunkPtr* chunk) {
+    DCHECK(_has_lazy_load_columns);
+    ChunkPtr lazy_chunk = std::make_shared<Chunk>();
+    int column_size = _src_slot_descriptors.size();
+    for (int column_pos = 0; column_pos < column_size; ++column_pos) {
+        auto slot_desc = _src_slot_descriptors[column_pos];
+        if (slot_desc != nullptr && _is_lazy_load_column[column_pos]) {
+            auto col = ColumnHelper::create_column(_src_types[column_pos], slot_desc->is_nullable());
+            lazy_chunk->append_column(std::move(col), slot_desc->id());
+        }
+    }
+
+    // the rows read but not selected, in the short runs of the rows filtered out, are filtered after reading
+    const uint8_t* selection = _lazy_load_selection.data();
+    const size_t num_rows = _lazy_load_selection.size();
+    Column::Filter read_filter;
+    read_filter.reserve(num_rows);
+    try {
+        size_t read_from = 0;
+        size_t i = 0;
+        while (i < num_rows) {
+            if (selection[i]) {
+                i++;
+                continue;
+            }
+            size_t j = i;
+            while (j < num_rows && !selection[j]) {
+                j++;
+            }
+            if (j - i >= kMinLazySkipRows) {
+                RETURN_IF_ERROR(_lazy_load_rows(read_from, i - read_from, lazy_chunk, &read_filter));
+                _row_reader->lazyLoadSkip(j - i);
+                read_from = j;
+            }
+            i = j;
+        }
+        RETURN_IF_ERROR(_lazy_load_rows(read_from, num_rows - read_from, lazy_chunk, &read_filter));
+    } catch (std::exception& e) {
+        auto s = strings::Substitute("OrcScannerAdapter::lazy_load_chunk failed. reason = $0", e.what());
+        LOG(WARNING) << s;
+        return Status::InternalError(s);
+    }
+    if (SIMD::count_zero(read_filter.data(), read_filter.size()) != 0) {
+        lazy_chunk->filter(read_filter);
+    }
+    DCHECK_EQ(lazy_chunk->num_rows(), (*chunk)->num_rows());
+
+    for (int column_pos = 0; column_pos < column_size; ++column_pos) {
+        auto slot = _src_slot_descriptors[column_pos];
+        if (slot == nullptr || !_is_lazy_load_column[column_pos]) {
+            continue;
+        }
+        ColumnPtr col = _cast_exprs[column_pos]->evaluate(nullptr, lazy_chunk.get());
+        col = ColumnHelper::unfold_const_column(slot->type(), lazy_chunk->num_rows(), col);
+        (*chunk)->append_column(std::move(col), slot->id());
+    }
+    return Status::OK();
+}
+
+Status OrcScannerAdapter::_lazy_load_rows(size_t from, size_t size, ChunkPtr& chunk, Column::Filter* read_filter) {
+    if (size == 0) {
+        return Status::OK();
+    }
+    _row_reader->lazyLoadNext(*_batch, size);
+    const auto& batch_vec = down_cast<orc::StructVectorBatch*>(_batch.get())->fields;
+    int column_size = _src_slot_descriptors.size();
+    for (int column_pos = 0; column_pos < column_size; ++column_pos) {
+        SlotDescriptor* slot_desc = _src_slot_descriptors[column_pos];
+        if (slot_desc == nullptr || !_is_lazy_load_column[column_pos]) {
+            continue;
+        }
+        set_current_slot(slot_desc);
+        orc::ColumnVectorBatch* cvb = batch_vec[_position_in_orc[column_pos]];
+        if (!slot_desc->is_nullable() && cvb->hasNulls) {
+            auto s = strings::Substitute("column '$0' is not nullable", slot_desc->col_name());
+            return Status::InternalError(s);
+        }
+        ColumnPtr& col = chunk->get_column_by_slot_id(slot_desc->id());
+        _fill_functions[column_pos](cvb, col, 0, size, slot_desc->type(), this);
+    }
+    read_filter->insert(read_filter->end(), _lazy_load_selection.begin() + from,
+                        _lazy_load_selection.begin() + from + size);
+    return Status::OK();
+}
+
 void OrcScannerAdapter::set_row_reader_filter(std::shared_ptr<orc::RowReaderFilter> filter) {
     _row_reader_options.rowReaderFilter(filter);
 }
@@ -1940,7 +2061,19 @@ Status OrcScannerAdapter::apply_dict_filter_eval_cache(
 
     if (!filter_all) {
         uint32_t one_count = filter.size() - SIMD::count_zero(filter);
-        if (one_count != filter.size()) {
+        if (one_count == filter.size()) {
+            return Status::OK();
+        }
+        if (_has_lazy_load_columns) {
+            // the lazy load columns are not read yet, and read by the rows of the batch from the first one.
+            for (int column_pos = 0; column_pos < _src_slot_descriptors.size(); ++column_pos) {
+                if (_src_slot_descriptors[column_pos] != nullptr && !_is_lazy_load_column[column_pos]) {
+                    batch_vec[_position_in_orc[column_pos]]->filter(filter.data(), filter.size(), one_count);
+                }
+            }
+            _batch->numElements = one_count;
+            _lazy_load_selection.swap(filter);
+        } else {
             _batch->filter(filter.data(), filter.size(), one_count);
         }
     } else {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <orc/OrcFile.hh>
+#include <unordered_set>
 
 #include "column/column_helper.h"
 #include "common/object_pool.h"
@@ -45,8 +46,16 @@ public:
     Status fill_chunk(ChunkPtr* chunk);
     // some type cast & conversion.
     ChunkPtr cast_chunk(ChunkPtr* chunk);
+    // The lazy load columns are not read by read_next, nor created, filled or cast by the methods above, but read after
+    // the other columns have filtered the rows of the batch, so that their rows filtered out are skipped without
+    // decoding. |filter| selects the rows of the chunk filled by the other columns, nullptr if none is selected.
+    void select_lazy_load_rows(const Column::Filter* filter);
+    // read, cast and append the lazy load columns of the selected rows to the chunk.
+    Status lazy_load_chunk(ChunkPtr* chunk);
+    bool has_lazy_load_columns() const { return _has_lazy_load_columns; }
     // call them before calling init.
     void set_read_chunk_size(uint64_t v) { _read_chunk_size = v; }
+    void set_lazy_load_slot_ids(const std::unordered_set<SlotId>& slot_ids) { _lazy_load_slot_ids = slot_ids; }
     void set_row_reader_filter(std::shared_ptr<orc::RowReaderFilter> filter);
     void set_conjuncts(const std::vector<Expr*>& conjuncts);
     void set_conjuncts_and_runtime_filters(const std::vector<Expr*>& conjuncts,
@@ -97,6 +106,11 @@ private:
     void _add_conjunct(const Expr* conjunct, std::unique_ptr<orc::SearchArgumentBuilder>& builder);
     bool _add_runtime_filter(const SlotDescriptor* slot_desc, const JoinRuntimeFilter* rf,
                              std::unique_ptr<orc::SearchArgumentBuilder>& builder);
+    // read the |size| rows from |from| of the lazy load columns of the batch into |chunk|.
+    Status _lazy_load_rows(size_t from, size_t size, ChunkPtr& chunk, Column::Filter* read_filter);
+
+    // the runs of at least this many rows filtered out are skipped instead of read.
+    static constexpr size_t kMinLazySkipRows = 32;
 
     std::unique_ptr<orc::ColumnVectorBatch> _batch;
     std::unique_ptr<orc::Reader> _reader;
@@ -112,6 +126,12 @@ private:
     std::unordered_map<SlotId, int> _slot_id_to_position;
     std::vector<Expr*> _cast_exprs;
     std::vector<FillColumnFunction> _fill_functions;
+    std::unordered_set<SlotId> _lazy_load_slot_ids;
+    // _src_slot index to whether it is read lazily
+    std::vector<bool> _is_lazy_load_column;
+    bool _has_lazy_load_columns = false;
+    // the rows of the batch selected by the other columns
+    Column::Filter _lazy_load_selection;
     Status _init_include_columns();
     Status _init_position_in_orc();
     Status _init_src_types();
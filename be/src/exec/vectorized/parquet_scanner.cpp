@@ -111,8 +111,11 @@ Status ParquetScanner::append_batch_to_src_chunk(ChunkPtr* chunk) {
 }
 
 Status ParquetScanner::finalize_src_chunk(ChunkPtr* chunk) {
-    auto num_rows = (*chunk)->filter(_chunk_filter);
-    _counter->num_rows_filtered += _chunk_start_idx - num_rows;
+    // Most chunks keep all their rows, which needn't be filtered.
+    if (SIMD::count_zero(_chunk_filter) > 0) {
+        auto num_rows = (*chunk)->filter(_chunk_filter);
+        _counter->num_rows_filtered += _chunk_start_idx - num_rows;
+    }
     ChunkPtr cast_chunk = std::make_shared<Chunk>();
     for (auto i = 0; i < _num_of_columns_from_file; ++i) {
         SlotDescriptor* slot_desc = _src_slot_descriptors[i];
@@ -0,0 +1,363 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/parquet_writer.h"
+
+#include <parquet/api/writer.h>
+#include <parquet/exception.h>
+
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "common/statusor.h"
+#include "exec/parquet_writer.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/large_int_value.h"
+#include "runtime/vectorized/time_types.h"
+#include "util/threadpool.h"
+
+namespace starrocks::vectorized {
+
+// The values of the non-null rows are converted into this many at a time.
+static constexpr size_t kWriteBatchSize = 4096;
+static constexpr int kDecimalV2Precision = 27;
+static constexpr int kDecimalV2Scale = 9;
+static constexpr int kInt128Bytes = 16;
+
+static StatusOr<::parquet::schema::NodePtr> make_parquet_node(const std::string& name, const TypeDescriptor& type) {
+    using ::parquet::LogicalType;
+    using ::parquet::Type;
+    using ::parquet::schema::PrimitiveNode;
+    const auto optional = ::parquet::Repetition::OPTIONAL;
+    switch (type.type) {
+    case TYPE_BOOLEAN:
+        return PrimitiveNode::Make(name, optional, LogicalType::None(), Type::BOOLEAN);
+    case TYPE_TINYINT:
+        return PrimitiveNode::Make(name, optional, LogicalType::Int(8, true), Type::INT32);
+    case TYPE_SMALLINT:
+        return PrimitiveNode::Make(name, optional, LogicalType::Int(16, true), Type::INT32);
+    case TYPE_INT:
+        return PrimitiveNode::Make(name, optional, LogicalType::None(), Type::INT32);
+    case TYPE_BIGINT:
+        return PrimitiveNode::Make(name, optional, LogicalType::None(), Type::INT64);
+    case TYPE_FLOAT:
+        return PrimitiveNode::Make(name, optional, LogicalType::None(), Type::FLOAT);
+    case TYPE_DOUBLE:
+        return PrimitiveNode::Make(name, optional, LogicalType::None(), Type::DOUBLE);
+    case TYPE_DATE:
+        return PrimitiveNode::Make(name, optional, LogicalType::Date(), Type::INT32);
+    case TYPE_DATETIME:
+        // the datetimes are local, not adjusted to utc
+        return PrimitiveNode::Make(name, optional, LogicalType::Timestamp(false, LogicalType::TimeUnit::MICROS),
+                                   Type::INT64);
+    case TYPE_DECIMAL32:
+        return PrimitiveNode::Make(name, optional, LogicalType::Decimal(type.precision, type.scale), Type::INT32);
+    case TYPE_DECIMAL64:
+        return PrimitiveNode::Make(name, optional, LogicalType::Decimal(type.precision, type.scale), Type::INT64);
+    case TYPE_DECIMAL128:
+        return PrimitiveNode::Make(name, optional, LogicalType::Decimal(type.precision, type.scale),
+                                   Type::FIXED_LEN_BYTE_ARRAY, kInt128Bytes);
+    case TYPE_DECIMALV2:
+        return PrimitiveNode::Make(name, optional, LogicalType::Decimal(kDecimalV2Precision, kDecimalV2Scale),
+                                   Type::FIXED_LEN_BYTE_ARRAY, kInt128Bytes);
+    case TYPE_LARGEINT:
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        return PrimitiveNode::Make(name, optional, LogicalType::String(), Type::BYTE_ARRAY);
+    default:
+        return Status::NotSupported(strings::Substitute("unsupported type of parquet file: $0", type.debug_string()));
+    }
+}
+
+static ::parquet::Compression::type to_parquet_compression(TCompressionType::type type) {
+    switch (type) {
+    case TCompressionType::NO_COMPRESSION:
+        return ::parquet::Compression::UNCOMPRESSED;
+    case TCompressionType::LZ4:
+    case TCompressionType::LZ4_FRAME:
+        return ::parquet::Compression::LZ4;
+    case TCompressionType::ZSTD:
+        return ::parquet::Compression::ZSTD;
+    case TCompressionType::ZLIB:
+    case TCompressionType::GZIP:
+    case TCompressionType::DEFLATE:
+        return ::parquet::Compression::GZIP;
+    default:
+        return ::parquet::Compression::SNAPPY;
+    }
+}
+
+// The big-endian two's complement of |value|, of the decimals of the fixed-length byte arrays.
+static void to_big_endian(int128_t value, uint8_t* buf) {
+    for (int i = kInt128Bytes - 1; i >= 0; i--) {
+        buf[i] = static_cast<uint8_t>(value);
+        value >>= 8;
+    }
+}
+
+// Write the values of |column| converted by |convert|, which converts the |row|th value into the |n|th value to write
+// of a batch.
+template <typename DType, typename Convert>
+static void write_values(const NullableColumn& column, ::parquet::ColumnWriter* writer, Convert&& convert) {
+    using ValueType = typename DType::c_type;
+    auto* typed_writer = static_cast<::parquet::TypedColumnWriter<DType>*>(writer);
+    const auto& nulls = column.null_column()->get_data();
+    const size_t num_rows = column.size();
+
+    std::vector<int16_t> def_levels(kWriteBatchSize);
+    std::unique_ptr<ValueType[]> values(new ValueType[kWriteBatchSize]);
+    for (size_t from = 0; from < num_rows; from += kWriteBatchSize) {
+        size_t count = std::min(kWriteBatchSize, num_rows - from);
+        size_t num_values = 0;
+        for (size_t i = 0; i < count; i++) {
+            size_t row = from + i;
+            def_levels[i] = !nulls[row];
+            if (!nulls[row]) {
+                values[num_values] = convert(row, num_values);
+                num_values++;
+            }
+        }
+        typed_writer->WriteBatch(count, def_levels.data(), nullptr, values.get());
+    }
+}
+
+template <PrimitiveType PT, typename DType>
+static void write_fixed_values(const NullableColumn& column, ::parquet::ColumnWriter* writer) {
+    using ValueType = typename DType::c_type;
+    const auto& data = ColumnHelper::cast_to_raw<PT>(column.data_column())->get_data();
+    write_values<DType>(column, writer, [&](size_t row, size_t) { return static_cast<ValueType>(data[row]); });
+}
+
+template <PrimitiveType PT>
+static void write_decimal128_values(const NullableColumn& column, ::parquet::ColumnWriter* writer) {
+    const auto& data = ColumnHelper::cast_to_raw<PT>(column.data_column())->get_data();
+    std::vector<uint8_t> buf(kWriteBatchSize * kInt128Bytes);
+    write_values<::parquet::FLBAType>(column, writer, [&](size_t row, size_t n) {
+        uint8_t* ptr = buf.data() + n * kInt128Bytes;
+        if constexpr (PT == TYPE_DECIMALV2) {
+            to_big_endian(data[row].value(), ptr);
+        } else {
+            to_big_endian(data[row], ptr);
+        }
+        return ::parquet::FixedLenByteArray(ptr);
+    });
+}
+
+ParquetChunkWriter::ParquetChunkWriter(FileWriter* file_writer, std::vector<TypeDescriptor> types,
+                                       ParquetWriterOptions options)
+        : _file_writer(file_writer), _types(std::move(types)), _options(std::move(options)) {}
+
+ParquetChunkWriter::~ParquetChunkWriter() {
+    close();
+}
+
+Status ParquetChunkWriter::init() {
+    ::parquet::schema::NodeVector fields;
+    ::parquet::WriterProperties::Builder builder;
+    builder.created_by("StarRocks");
+    for (size_t i = 0; i < _types.size(); i++) {
+        std::string name = i < _options.column_names.size() ? _options.column_names[i] : "col" + std::to_string(i);
+        auto node = make_parquet_node(name, _types[i]);
+        if (!node.ok()) {
+            return node.status();
+        }
+        fields.emplace_back(std::move(node).value());
+
+        auto compression = TCompressionType::SNAPPY;
+        if (i < _options.compression_types.size()) {
+            compression = _options.compression_types[i];
+        }
+        builder.compression(name, to_parquet_compression(compression));
+        if (i < _options.use_dict.size() && !_options.use_dict[i]) {
+            builder.disable_dictionary(name);
+        }
+        _buffered_columns.emplace_back(ColumnHelper::create_column(_types[i], true));
+    }
+    auto schema = std::static_pointer_cast<::parquet::schema::GroupNode>(
+            ::parquet::schema::GroupNode::Make("schema", ::parquet::Repetition::REQUIRED, fields));
+
+    _outstream = std::make_shared<ParquetOutputStream>(_file_writer);
+    try {
+        _writer = ::parquet::ParquetFileWriter::Open(_outstream, schema, builder.build());
+    } catch (const ::parquet::ParquetException& e) {
+        return Status::InternalError(strings::Substitute("fail to create parquet file writer: $0", e.what()));
+    }
+
+    if (_options.num_encode_threads > 1 && _types.size() > 1) {
+        RETURN_IF_ERROR(ThreadPoolBuilder("parquet_encode")
+                                .set_min_threads(0)
+                                .set_max_threads(_options.num_encode_threads)
+                                .build(&_encode_pool));
+    }
+    return Status::OK();
+}
+
+Status ParquetChunkWriter::write(const Columns& columns) {
+    DCHECK_EQ(columns.size(), _types.size());
+    if (columns.empty() || columns[0]->size() == 0) {
+        return Status::OK();
+    }
+    const size_t num_rows = columns[0]->size();
+    size_t buffered_bytes = 0;
+    for (size_t i = 0; i < columns.size(); i++) {
+        ColumnPtr column = ColumnHelper::unfold_const_column(_types[i], num_rows, columns[i]);
+        _buffered_columns[i]->append(*column, 0, num_rows);
+        buffered_bytes += _buffered_columns[i]->byte_size();
+    }
+    if (buffered_bytes >= _options.max_row_group_bytes) {
+        RETURN_IF_ERROR(_flush_row_group());
+    }
+    return Status::OK();
+}
+
+Status ParquetChunkWriter::_flush_row_group() {
+    if (_buffered_columns.empty() || _buffered_columns[0]->size() == 0) {
+        return Status::OK();
+    }
+    const size_t num_columns = _buffered_columns.size();
+    std::vector<Status> statuses(num_columns);
+    try {
+        // the column chunks of a buffered row group are encoded into the buffers of their own, and written into the
+        // file in order once the row group is closed
+        auto* row_group_writer = _writer->AppendBufferedRowGroup();
+        std::vector<::parquet::ColumnWriter*> column_writers(num_columns);
+        for (size_t i = 0; i < num_columns; i++) {
+            column_writers[i] = row_group_writer->column(i);
+        }
+        for (size_t i = 0; i < num_columns; i++) {
+            if (_encode_pool == nullptr ||
+                !_encode_pool->submit_func([&, i]() { statuses[i] = _write_column(i, column_writers[i]); }).ok()) {
+                statuses[i] = _write_column(i, column_writers[i]);
+            }
+        }
+        if (_encode_pool != nullptr) {
+            _encode_pool->wait();
+        }
+        for (const auto& st : statuses) {
+            RETURN_IF_ERROR(st);
+        }
+        row_group_writer->Close();
+    } catch (const ::parquet::ParquetException& e) {
+        return Status::InternalError(strings::Substitute("fail to write parquet row group: $0", e.what()));
+    }
+
+    for (auto& column : _buffered_columns) {
+        column->reset_column();
+    }
+    return Status::OK();
+}
+
+Status ParquetChunkWriter::_write_column(size_t index, ::parquet::ColumnWriter* writer) {
+    const auto& column = down_cast<const NullableColumn&>(*_buffered_columns[index]);
+    try {
+        switch (_types[index].type) {
+        case TYPE_BOOLEAN:
+            write_fixed_values<TYPE_BOOLEAN, ::parquet::BooleanType>(column, writer);
+            break;
+        case TYPE_TINYINT:
+            write_fixed_values<TYPE_TINYINT, ::parquet::Int32Type>(column, writer);
+            break;
+        case TYPE_SMALLINT:
+            write_fixed_values<TYPE_SMALLINT, ::parquet::Int32Type>(column, writer);
+            break;
+        case TYPE_INT:
+            write_fixed_values<TYPE_INT, ::parquet::Int32Type>(column, writer);
+            break;
+        case TYPE_BIGINT:
+            write_fixed_values<TYPE_BIGINT, ::parquet::Int64Type>(column, writer);
+            break;
+        case TYPE_FLOAT:
+            write_fixed_values<TYPE_FLOAT, ::parquet::FloatType>(column, writer);
+            break;
+        case TYPE_DOUBLE:
+            write_fixed_values<TYPE_DOUBLE, ::parquet::DoubleType>(column, writer);
+            break;
+        case TYPE_DECIMAL32:
+            write_fixed_values<TYPE_DECIMAL32, ::parquet::Int32Type>(column, writer);
+            break;
+        case TYPE_DECIMAL64:
+            write_fixed_values<TYPE_DECIMAL64, ::parquet::Int64Type>(column, writer);
+            break;
+        case TYPE_DECIMAL128:
+            write_decimal128_values<TYPE_DECIMAL128>(column, writer);
+            break;
+        case TYPE_DECIMALV2:
+            write_decimal128_values<TYPE_DECIMALV2>(column, writer);
+            break;
+        case TYPE_DATE: {
+            const auto& data = ColumnHelper::cast_to_raw<TYPE_DATE>(column.data_column())->get_data();
+            write_values<::parquet::Int32Type>(column, writer, [&](size_t row, size_t) {
+                return static_cast<int32_t>(data[row].julian() - date::UNIX_EPOCH_JULIAN);
+            });
+            break;
+        }
+        case TYPE_DATETIME: {
+            const auto& data = ColumnHelper::cast_to_raw<TYPE_DATETIME>(column.data_column())->get_data();
+            write_values<::parquet::Int64Type>(column, writer, [&](size_t row, size_t) {
+                Timestamp ts = data[row].timestamp();
+                return static_cast<int64_t>((timestamp::to_julian(ts) - date::UNIX_EPOCH_JULIAN) * USECS_PER_DAY +
+                                            timestamp::to_time(ts));
+            });
+            break;
+        }
+        case TYPE_LARGEINT: {
+            const auto& data = ColumnHelper::cast_to_raw<TYPE_LARGEINT>(column.data_column())->get_data();
+            std::vector<std::string> strings(kWriteBatchSize);
+            write_values<::parquet::ByteArrayType>(column, writer, [&](size_t row, size_t n) {
+                strings[n] = LargeIntValue::to_string(data[row]);
+                return ::parquet::ByteArray(strings[n].size(), reinterpret_cast<const uint8_t*>(strings[n].data()));
+            });
+            break;
+        }
+        case TYPE_CHAR:
+        case TYPE_VARCHAR: {
+            const auto* data = ColumnHelper::get_binary_column(column.data_column().get());
+            write_values<::parquet::ByteArrayType>(column, writer, [&](size_t row, size_t) {
+                Slice slice = data->get_slice(row);
+                return ::parquet::ByteArray(slice.size, reinterpret_cast<const uint8_t*>(slice.data));
+            });
+            break;
+        }
+        default:
+            return Status::NotSupported(
+                    strings::Substitute("unsupported type of parquet file: $0", _types[index].debug_string()));
+        }
+    } catch (const ::parquet::ParquetException& e) {
+        return Status::InternalError(strings::Substitute("fail to write parquet column: $0", e.what()));
+    }
+    return Status::OK();
+}
+
+Status ParquetChunkWriter::close() {
+    if (_closed) {
+        return Status::OK();
+    }
+    _closed = true;
+    Status st;
+    if (_writer != nullptr) {
+        st = _flush_row_group();
+        try {
+            _writer->Close();
+        } catch (const ::parquet::ParquetException& e) {
+            st = Status::InternalError(strings::Substitute("fail to close parquet file writer: $0", e.what()));
+        }
+    }
+    if (_encode_pool != nullptr) {
+        _encode_pool->shutdown();
+    }
+    if (_outstream != nullptr && !_outstream->closed()) {
+        auto arrow_st = _outstream->Close();
+        if (st.ok() && !arrow_st.ok()) {
+            st = Status::IOError(arrow_st.ToString());
+        }
+    }
+    return st;
+}
+
+int64_t ParquetChunkWriter::written_bytes() const {
+    int64_t position = 0;
+    if (_outstream != nullptr) {
+        _outstream->Tell(&position);
+    }
+    return position;
+}
+
+} // namespace starrocks::vectorized
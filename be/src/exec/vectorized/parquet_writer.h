@@ -0,0 +1,79 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "gen_cpp/Types_types.h"
+#include "gutil/macros.h"
+#include "runtime/types.h"
+
+namespace parquet {
+class ColumnWriter;
+class ParquetFileWriter;
+} // namespace parquet
+
+namespace starrocks {
+
+class FileWriter;
+class ParquetOutputStream;
+class ThreadPool;
+
+namespace vectorized {
+
+struct ParquetWriterOptions {
+    // The buffered rows are written as a row group once their columns are more than this many bytes.
+    int64_t max_row_group_bytes = 128 * 1024 * 1024;
+    // The names, compression types and whether to use the dictionary encoding of the columns, empty to use the
+    // defaults, "col<i>", snappy and the dictionary encoding.
+    std::vector<std::string> column_names;
+    std::vector<TCompressionType::type> compression_types;
+    std::vector<bool> use_dict;
+    // The column chunks of a row group are encoded in parallel by this many threads.
+    int num_encode_threads = 1;
+};
+
+// ParquetChunkWriter writes the columns of the chunks, of |types|, into a parquet file through |file_writer|. The
+// columns are buffered till they are a row group, of which the column chunks are encoded and compressed in parallel,
+// and then written into the file in order.
+class ParquetChunkWriter {
+public:
+    ParquetChunkWriter(FileWriter* file_writer, std::vector<TypeDescriptor> types, ParquetWriterOptions options);
+    ~ParquetChunkWriter();
+
+    Status init();
+
+    // Append the columns of a chunk, one of each of |types|.
+    Status write(const Columns& columns);
+
+    // Write the buffered rows and the footer, and close |file_writer|.
+    Status close();
+
+    // The bytes written into the file, not including the buffered rows.
+    int64_t written_bytes() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(ParquetChunkWriter);
+
+    Status _flush_row_group();
+    Status _write_column(size_t index, ::parquet::ColumnWriter* writer);
+
+    FileWriter* _file_writer; // not owned
+    const std::vector<TypeDescriptor> _types;
+    const ParquetWriterOptions _options;
+
+    std::shared_ptr<ParquetOutputStream> _outstream;
+    std::unique_ptr<::parquet::ParquetFileWriter> _writer;
+    std::unique_ptr<ThreadPool> _encode_pool;
+
+    // the nullable columns of the rows of the next row group
+    Columns _buffered_columns;
+    bool _closed = false;
+};
+
+} // namespace vectorized
+} // namespace starrocks
@@ -2,22 +2,155 @@
 
 #include "exec/vectorized/project_node.h"
 
+#include <map>
 #include <memory>
+#include <tuple>
 
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
 #include "exec/pipeline/project_operator.h"
 #include "exprs/expr.h"
 #include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/runtime_filter.h"
+#include "runtime/descriptors.h"
 #include "runtime/runtime_state.h"
+#include "util/thrift_util.h"
 
 namespace starrocks::vectorized {
 
+// The functions whose results may differ from call to call, which are evaluated for each occurrence.
+static bool is_nondeterministic(const TExprNode& node) {
+    if (!node.__isset.fn) {
+        return false;
+    }
+    const auto& name = node.fn.name.function_name;
+    return name == "rand" || name == "random" || name == "uuid" || name == "uuid_numeric" || name == "sleep";
+}
+
+// The exprs which evaluate their children, other than the first, only if the others don't decide the result, whose
+// children are left as they are, lest they are evaluated for the rows they don't apply to.
+static bool is_conditional(const TExprNode& node) {
+    if (node.node_type == TExprNodeType::CASE_EXPR) {
+        return true;
+    }
+    if (!node.__isset.fn) {
+        return false;
+    }
+    const auto& name = node.fn.name.function_name;
+    return name == "if" || name == "ifnull" || name == "nullif" || name == "coalesce";
+}
+
+// Walk the subtree of |nodes| rooted at |begin|, and return its end. The subtrees which could be evaluated once for
+// all their occurrences are added into |candidates|: neither the root nor the leaves, nor under a conditional expr,
+// but deterministic ones of some slots. The first slot ref of the subtree is set in |slot_ref|, or -1 if none.
+static int collect_sub_exprs(const std::vector<TExprNode>& nodes, int begin, bool is_root, bool under_conditional,
+                             std::vector<std::pair<int, int>>* candidates, bool* deterministic, int* slot_ref) {
+    const TExprNode& node = nodes[begin];
+    *deterministic = !is_nondeterministic(node);
+    *slot_ref = node.node_type == TExprNodeType::SLOT_REF ? begin : -1;
+    bool conditional = under_conditional || is_conditional(node);
+    int end = begin + 1;
+    for (int i = 0; i < node.num_children; i++) {
+        bool child_deterministic = true;
+        int child_slot_ref = -1;
+        end = collect_sub_exprs(nodes, end, false, conditional, candidates, &child_deterministic, &child_slot_ref);
+        *deterministic &= child_deterministic;
+        if (*slot_ref == -1) {
+            *slot_ref = child_slot_ref;
+        }
+    }
+    if (!is_root && !under_conditional && node.num_children > 0 && *deterministic && *slot_ref != -1) {
+        candidates->emplace_back(begin, end);
+    }
+    return end;
+}
+
+// Extract the subtrees occurring more than once in |exprs| into |common_exprs|, as the exprs of the new slots from
+// |next_slot_id|, and replace each occurrence by a slot ref of its slot, so that they are evaluated once per chunk.
+// The smaller ones are extracted first, so a common expr only refers to the slots of those before it.
+static Status extract_common_sub_exprs(std::vector<TExpr>* exprs, SlotId next_slot_id,
+                                       std::vector<std::pair<SlotId, TExpr>>* common_exprs) {
+    ThriftSerializer serializer(false, 1024);
+    std::string node_key;
+    while (static_cast<int>(common_exprs->size()) < config::project_max_extracted_common_sub_exprs) {
+        // The occurrences, i.e. the index of the expr and the range of the nodes, of the subtrees by their keys
+        // concatenated from the serialized nodes, which are self-delimited.
+        std::map<std::string, std::vector<std::tuple<size_t, int, int>>> occurrences;
+        for (size_t i = 0; i < exprs->size(); i++) {
+            const auto& nodes = (*exprs)[i].nodes;
+            if (nodes.empty()) {
+                continue;
+            }
+            std::vector<std::pair<int, int>> candidates;
+            bool deterministic = true;
+            int slot_ref = -1;
+            collect_sub_exprs(nodes, 0, true, false, &candidates, &deterministic, &slot_ref);
+            for (auto [begin, end] : candidates) {
+                std::string key;
+                for (int j = begin; j < end; j++) {
+                    RETURN_IF_ERROR(serializer.serialize(&nodes[j], &node_key));
+                    key.append(node_key);
+                }
+                occurrences[key].emplace_back(i, begin, end);
+            }
+        }
+
+        const std::vector<std::tuple<size_t, int, int>>* common = nullptr;
+        for (const auto& [key, list] : occurrences) {
+            if (list.size() < 2) {
+                continue;
+            }
+            auto [expr, begin, end] = list[0];
+            if (common == nullptr || end - begin < std::get<2>((*common)[0]) - std::get<1>((*common)[0])) {
+                common = &list;
+            }
+        }
+        if (common == nullptr) {
+            break;
+        }
+
+        auto [expr, begin, end] = (*common)[0];
+        const auto& nodes = (*exprs)[expr].nodes;
+        TExpr common_expr;
+        common_expr.nodes.assign(nodes.begin() + begin, nodes.begin() + end);
+        const TExprNode& root = common_expr.nodes[0];
+
+        int tuple_id = 0;
+        for (const auto& node : common_expr.nodes) {
+            if (node.node_type == TExprNodeType::SLOT_REF) {
+                tuple_id = node.slot_ref.tuple_id;
+                break;
+            }
+        }
+        TExprNode slot_node;
+        slot_node.node_type = TExprNodeType::SLOT_REF;
+        slot_node.type = root.type;
+        slot_node.num_children = 0;
+        slot_node.output_scale = root.output_scale;
+        TSlotRef slot_ref;
+        slot_ref.slot_id = next_slot_id;
+        slot_ref.tuple_id = tuple_id;
+        slot_node.__set_slot_ref(slot_ref);
+        slot_node.__set_use_vectorized(true);
+        slot_node.__set_is_nullable(!root.__isset.is_nullable || root.is_nullable);
+
+        // The occurrences of a subtree in an expr don't overlap, so they're replaced from the last one.
+        for (auto it = common->rbegin(); it != common->rend(); ++it) {
+            auto [i, b, e] = *it;
+            auto& expr_nodes = (*exprs)[i].nodes;
+            expr_nodes.erase(expr_nodes.begin() + b + 1, expr_nodes.begin() + e);
+            expr_nodes[b] = slot_node;
+        }
+        common_exprs->emplace_back(next_slot_id++, std::move(common_expr));
+    }
+    return Status::OK();
+}
+
 ProjectNode::ProjectNode(starrocks::ObjectPool* pool, const starrocks::TPlanNode& node,
                          const starrocks::DescriptorTbl& desc)
         : ExecNode(pool, node, desc) {}
@@ -36,12 +169,39 @@ Status ProjectNode::init(const TPlanNode& tnode, RuntimeState* state) {
         slot_null_mapping[slot->id()] = slot->is_nullable();
     }
 
+    std::vector<TExpr> exprs;
+    exprs.reserve(column_size);
     for (auto const& [key, val] : tnode.project_node.slot_map) {
         _slot_ids.emplace_back(key);
+        exprs.emplace_back(val);
+        _type_is_nullable.emplace_back(slot_null_mapping[key]);
+    }
+
+    // The subtrees shared by the output exprs, which the common_slot_map of FE doesn't cover, are evaluated once as
+    // well, into the slots after all the others.
+    std::vector<std::pair<SlotId, TExpr>> extracted_exprs;
+    if (config::project_max_extracted_common_sub_exprs > 0) {
+        SlotId next_slot_id = 0;
+        std::vector<TupleDescriptor*> tuple_descs;
+        state->desc_tbl().get_tuple_descs(&tuple_descs);
+        for (const auto* tuple_desc : tuple_descs) {
+            for (const auto* slot : tuple_desc->slots()) {
+                next_slot_id = std::max(next_slot_id, slot->id() + 1);
+            }
+        }
+        for (auto const& [key, val] : tnode.project_node.slot_map) {
+            next_slot_id = std::max(next_slot_id, key + 1);
+        }
+        for (auto const& [key, val] : tnode.project_node.common_slot_map) {
+            next_slot_id = std::max(next_slot_id, key + 1);
+        }
+        RETURN_IF_ERROR(extract_common_sub_exprs(&exprs, next_slot_id, &extracted_exprs));
+    }
+
+    for (const auto& texpr : exprs) {
         ExprContext* context;
-        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, val, &context));
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, texpr, &context));
         _expr_ctxs.emplace_back(context);
-        _type_is_nullable.emplace_back(slot_null_mapping[key]);
     }
 
     size_t common_sub_column_size = tnode.project_node.common_slot_map.size();
@@ -54,6 +214,12 @@ Status ProjectNode::init(const TPlanNode& tnode, RuntimeState* state) {
         _common_sub_slot_ids.emplace_back(key);
         _common_sub_expr_ctxs.emplace_back(context);
     }
+    for (auto const& [slot_id, texpr] : extracted_exprs) {
+        ExprContext* context;
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, texpr, &context));
+        _common_sub_slot_ids.emplace_back(slot_id);
+        _common_sub_expr_ctxs.emplace_back(context);
+    }
 
     return Status::OK();
 }
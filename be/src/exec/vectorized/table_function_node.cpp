@@ -87,8 +87,7 @@ Status TableFunctionNode::get_next(RuntimeState* state, RowBatch* row_batch, boo
 Status TableFunctionNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
     RETURN_IF_CANCELLED(state);
     SCOPED_TIMER(_runtime_profile->total_time_counter());
-    int chunk_size = config::vector_chunk_size;
-    int reserve_chunk_size = chunk_size;
+    size_t chunk_size = config::vector_chunk_size;
     std::vector<ColumnPtr> output_columns;
 
     if (reached_limit()) {
@@ -110,89 +109,62 @@ Status TableFunctionNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* e
         output_columns.emplace_back(_table_function_result.first[result_idx]->clone_empty());
     }
 
-    //If _outer_column_remain_repeat_times > 0, first use the remaining data of the previous chunk to construct this data
-    if (_outer_column_remain_repeat_times > 0) {
-        size_t repeat_times = std::min(_outer_column_remain_repeat_times, chunk_size);
-        //Build outer data, repeat multiple times
-        for (int outer_idx = 0; outer_idx < _outer_slots.size(); ++outer_idx) {
-            ColumnPtr& input_column_ptr = _input_chunk_ptr->get_column_by_slot_id(_outer_slots[outer_idx]);
-            Datum value = input_column_ptr->get(_input_chunk_seek_rows);
-            if (value.is_null()) {
-                //The output_columns[outer_idx] is must Nullable, if value has null
-                down_cast<NullableColumn*>(output_columns[outer_idx].get())->append_nulls(repeat_times);
-            } else {
-                output_columns[outer_idx]->append_value_multiple_times(&value, repeat_times);
-            }
+    size_t num_rows = append_output_rows(output_columns, chunk_size);
+    while (num_rows < chunk_size) {
+        if (_table_function_result_eos) {
+            _input_chunk_ptr = nullptr;
         }
-        //Build table function result
-        for (int result_idx = 0; result_idx < _fn_result_slots.size(); ++result_idx) {
-            int tvf_offset_start = _table_function_result.second->get(_input_chunk_seek_rows + 1).get_int32() -
-                                   _outer_column_remain_repeat_times;
-            output_columns[_outer_slots.size() + result_idx]->append(*(_table_function_result.first[result_idx]),
-                                                                     tvf_offset_start, repeat_times);
-        }
-
-        reserve_chunk_size -= repeat_times;
-        _outer_column_remain_repeat_times -= repeat_times;
-        if (_outer_column_remain_repeat_times == 0) {
-            ++_input_chunk_seek_rows;
-        }
-
-        if (reserve_chunk_size == 0) {
+        RETURN_IF_ERROR(get_next_input_chunk(state, eos));
+        if (*eos) {
+            (*eos) = false;
             return build_chunk(chunk, output_columns);
         }
+        num_rows += append_output_rows(output_columns, chunk_size - num_rows);
     }
+    return build_chunk(chunk, output_columns);
+}
 
-    while (true) {
-        if (_input_chunk_ptr == nullptr || !_table_function_result_eos) {
-            RETURN_IF_ERROR(get_next_input_chunk(state, eos));
-            if (*eos) {
-                (*eos) = false;
-                _input_chunk_ptr = nullptr;
-                return build_chunk(chunk, output_columns);
-            }
-        }
-
-        while (_input_chunk_seek_rows < _input_chunk_ptr->num_rows()) {
-            int tvf_result_size = _table_function_result.second->get(_input_chunk_seek_rows + 1).get_int32() -
-                                  _table_function_result.second->get(_input_chunk_seek_rows).get_int32();
-            int repeat_times = std::min(tvf_result_size, reserve_chunk_size);
-            if (repeat_times == 0) {
-                ++_input_chunk_seek_rows;
-                continue;
-            }
-            //Build outer data, repeat multiple times
-            for (int outer_idx = 0; outer_idx < _outer_slots.size(); ++outer_idx) {
-                ColumnPtr& input_column_ptr = _input_chunk_ptr->get_column_by_slot_id(_outer_slots[outer_idx]);
-                Datum value = input_column_ptr->get(_input_chunk_seek_rows);
-                if (value.is_null()) {
-                    //The output_columns[outer_idx] is must Nullable, if value has null
-                    down_cast<NullableColumn*>(output_columns[outer_idx].get())->append_nulls(repeat_times);
-                } else {
-                    output_columns[outer_idx]->append_value_multiple_times(&value, repeat_times);
-                }
-            }
-            //Build table function result
-            for (int result_idx = 0; result_idx < _fn_result_slots.size(); ++result_idx) {
-                output_columns[_outer_slots.size() + result_idx]->append(
-                        *(_table_function_result.first[result_idx]),
-                        _table_function_result.second->get(_input_chunk_seek_rows).get_int32(), repeat_times);
-            }
-
-            reserve_chunk_size -= repeat_times;
-
-            _outer_column_remain_repeat_times = tvf_result_size - repeat_times;
-            if (_outer_column_remain_repeat_times == 0) {
-                ++_input_chunk_seek_rows;
-            }
-
-            if (reserve_chunk_size == 0) {
-                return build_chunk(chunk, output_columns);
-            }
+size_t TableFunctionNode::append_output_rows(const std::vector<ColumnPtr>& output_columns, size_t max_rows) {
+    size_t num_input_rows = _input_chunk_ptr->num_rows();
+    if (_input_chunk_seek_rows >= num_input_rows) {
+        return 0;
+    }
+    const auto& offsets = down_cast<const UInt32Column*>(_table_function_result.second.get())->get_data();
+
+    // The results of the consecutive input rows are consecutive, starting from the remaining ones of the row, which
+    // is split by the last output chunk.
+    uint32_t result_start = _outer_column_remain_repeat_times > 0
+                                    ? offsets[_input_chunk_seek_rows + 1] - _outer_column_remain_repeat_times
+                                    : offsets[_input_chunk_seek_rows];
+    uint32_t result_end = result_start;
+    size_t row = _input_chunk_seek_rows;
+    _outer_indexes.clear();
+    while (row < num_input_rows && _outer_indexes.size() < max_rows) {
+        size_t repeat_times = std::min<size_t>(offsets[row + 1] - result_end, max_rows - _outer_indexes.size());
+        _outer_indexes.insert(_outer_indexes.end(), repeat_times, row);
+        result_end += repeat_times;
+        if (result_end == offsets[row + 1]) {
+            ++row;
         }
+    }
+    _input_chunk_seek_rows = row;
+    _outer_column_remain_repeat_times =
+            row < num_input_rows && result_end > offsets[row] ? offsets[row + 1] - result_end : 0;
 
-        _input_chunk_ptr = nullptr;
+    size_t num_rows = _outer_indexes.size();
+    if (num_rows == 0) {
+        return 0;
+    }
+    // Replicate the outer rows by one selective append per column, and append the results as a single range.
+    for (int outer_idx = 0; outer_idx < _outer_slots.size(); ++outer_idx) {
+        const ColumnPtr& input_column_ptr = _input_chunk_ptr->get_column_by_slot_id(_outer_slots[outer_idx]);
+        output_columns[outer_idx]->append_selective(*input_column_ptr, _outer_indexes.data(), 0, num_rows);
+    }
+    for (int result_idx = 0; result_idx < _fn_result_slots.size(); ++result_idx) {
+        output_columns[_outer_slots.size() + result_idx]->append(*(_table_function_result.first[result_idx]),
+                                                                 result_start, num_rows);
     }
+    return num_rows;
 }
 
 Status TableFunctionNode::reset(RuntimeState* state) {
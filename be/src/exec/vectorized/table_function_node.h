@@ -32,6 +32,10 @@ public:
 
     Status get_next_input_chunk(RuntimeState* state, bool* eos);
 
+    // Append the rows of the input chunk from _input_chunk_seek_rows, joined with their table function results, to
+    // |output_columns|, at most |max_rows| rows. Returns the number of the appended rows.
+    size_t append_output_rows(const std::vector<ColumnPtr>& output_columns, size_t max_rows);
+
 private:
     const TableFunction* _table_function;
 
@@ -50,6 +54,8 @@ private:
     int _input_chunk_seek_rows;
     //The current outer line needs to be repeated several times
     int _outer_column_remain_repeat_times;
+    //The input rows of the outer columns of the output rows, reused by every output chunk
+    std::vector<uint32_t> _outer_indexes;
     //table function result
     std::pair<Columns, ColumnPtr> _table_function_result;
     //table function return result end ?
@@ -5,16 +5,23 @@
 #include <memory>
 
 #include "column/column_helper.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/sort/local_merge_sort_source_operator.h"
+#include "exec/pipeline/sort/partition_sort_sink_operator.h"
 #include "exec/vectorized/chunks_sorter.h"
+#include "exec/vectorized/chunks_sorter_external_sort.h"
 #include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exec/vectorized/chunks_sorter_partition_topn.h"
 #include "exec/vectorized/chunks_sorter_topn.h"
+#include "exec/vectorized/olap_scan_node.h"
+#include "exprs/vectorized/column_ref.h"
 #include "gutil/casts.h"
 #include "runtime/mem_tracker.h"
 
 namespace starrocks::vectorized {
 
 TopNNode::TopNNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
-        : ExecNode(pool, tnode, descs) {
+        : ExecNode(pool, tnode, descs), _tnode(tnode) {
     _offset = tnode.sort_node.__isset.offset ? tnode.sort_node.offset : 0;
     _materialized_tuple_desc = nullptr;
     _sort_timer = nullptr;
@@ -28,6 +35,10 @@ Status TopNNode::init(const TPlanNode& tnode, RuntimeState* state) {
     RETURN_IF_ERROR(_sort_exec_exprs.init(tnode.sort_node.sort_info, _pool));
     _is_asc_order = tnode.sort_node.sort_info.is_asc_order;
     _is_null_first = tnode.sort_node.sort_info.nulls_first;
+    if (tnode.sort_node.__isset.partition_exprs) {
+        RETURN_IF_ERROR(Expr::create_expr_trees(_pool, tnode.sort_node.partition_exprs, &_partition_expr_ctxs));
+        _partition_limit = tnode.sort_node.partition_limit;
+    }
     bool has_outer_join_child = tnode.sort_node.__isset.has_outer_join_child && tnode.sort_node.has_outer_join_child;
     if (!_sort_exec_exprs.sort_tuple_slot_expr_ctxs().empty()) {
         size_t size = _sort_exec_exprs.sort_tuple_slot_expr_ctxs().size();
@@ -47,15 +58,62 @@ Status TopNNode::init(const TPlanNode& tnode, RuntimeState* state) {
     if (tnode.sort_node.__isset.sql_sort_keys) {
         _runtime_profile->add_info_string("SortKeys", tnode.sort_node.sql_sort_keys);
     }
-    _runtime_profile->add_info_string("SortType", tnode.sort_node.use_top_n ? "TopN" : "All");
+    if (!_partition_expr_ctxs.empty()) {
+        _runtime_profile->add_info_string("SortType", "PartitionTopN");
+    } else {
+        _runtime_profile->add_info_string("SortType", tnode.sort_node.use_top_n ? "TopN" : "All");
+    }
+    _init_runtime_predicate(state);
     return Status::OK();
 }
 
+// The children have been initialized, and the scan node would pass |_runtime_predicate| to its scanners.
+void TopNNode::_init_runtime_predicate(RuntimeState* state) {
+    if (!config::enable_topn_runtime_predicate || _limit <= 0 || state == nullptr) {
+        return;
+    }
+    // The rows skipped by the scan node with a limit would be replaced by the others.
+    auto* scan_node = dynamic_cast<OlapScanNode*>(child(0));
+    if (scan_node == nullptr || scan_node->limit() != -1) {
+        return;
+    }
+
+    Expr* expr = _sort_exec_exprs.lhs_ordering_expr_ctxs()[0]->root();
+    if (!expr->is_slotref()) {
+        return;
+    }
+    SlotId slot_id = down_cast<ColumnRef*>(expr)->slot_id();
+    const auto& sort_tuple_slot_exprs = _sort_exec_exprs.sort_tuple_slot_expr_ctxs();
+    if (!sort_tuple_slot_exprs.empty()) {
+        // The ordering expr refers to the materialized sort tuple, whose slot is materialized from the child.
+        const auto& slots = _materialized_tuple_desc->slots();
+        auto iter = std::find_if(slots.begin(), slots.end(), [slot_id](auto* slot) { return slot->id() == slot_id; });
+        if (iter == slots.end()) {
+            return;
+        }
+        expr = sort_tuple_slot_exprs[iter - slots.begin()]->root();
+        if (!expr->is_slotref()) {
+            return;
+        }
+        slot_id = down_cast<ColumnRef*>(expr)->slot_id();
+    }
+
+    SlotDescriptor* slot = state->desc_tbl().get_slot_descriptor(slot_id);
+    if (slot == nullptr || slot->parent() != scan_node->thrift_olap_scan_node().tuple_id ||
+        !ChunksSorterTopn::support_runtime_predicate(slot->type().type)) {
+        return;
+    }
+    _runtime_predicate = std::make_shared<RuntimePredicate>(slot->col_name());
+    scan_node->set_runtime_predicate(_runtime_predicate);
+}
+
 Status TopNNode::prepare(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
 
     RETURN_IF_ERROR(ExecNode::prepare(state));
     RETURN_IF_ERROR(_sort_exec_exprs.prepare(state, child(0)->row_desc(), _row_descriptor, expr_mem_tracker()));
+    // The partition exprs are evaluated on the materialized sort tuple like the ordering exprs.
+    RETURN_IF_ERROR(Expr::prepare(_partition_expr_ctxs, state, _row_descriptor, expr_mem_tracker()));
 
     _abort_on_default_limit_exceeded = _abort_on_default_limit_exceeded && state->abort_on_default_limit_exceeded();
 
@@ -70,6 +128,7 @@ Status TopNNode::open(RuntimeState* state) {
     RETURN_IF_CANCELLED(state);
     RETURN_IF_ERROR(state->check_query_state("Top n, before open."));
     RETURN_IF_ERROR(_sort_exec_exprs.open(state));
+    RETURN_IF_ERROR(Expr::open(_partition_expr_ctxs, state));
 
     // sort all input chunk in turn, keep top N rows.
     ExecNode* data_source = child(0);
@@ -98,7 +157,7 @@ Status TopNNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
 
     {
         SCOPED_TIMER(_sort_timer);
-        _chunks_sorter->get_next(chunk, eos);
+        RETURN_IF_ERROR(_chunks_sorter->get_next(chunk, eos));
     }
     if (*eos) {
         _chunks_sorter = nullptr;
@@ -121,22 +180,31 @@ Status TopNNode::close(RuntimeState* state) {
     _chunks_sorter = nullptr;
 
     _sort_exec_exprs.close(state);
+    Expr::close(_partition_expr_ctxs, state);
     return ExecNode::close(state);
 }
 
 Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
-    static const uint SIZE_OF_CHUNK_FOR_TOPN = 3000;
-    static const uint SIZE_OF_CHUNK_FOR_FULL_SORT = 5000;
-
     ScopedTimer<MonotonicStopWatch> timer(_sort_timer);
-    if (_limit > 0) {
-        _chunks_sorter =
-                std::make_unique<ChunksSorterTopn>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order,
-                                                   &_is_null_first, _offset, _limit, SIZE_OF_CHUNK_FOR_TOPN);
+    if (!_partition_expr_ctxs.empty()) {
+        _chunks_sorter = std::make_unique<ChunksSorterPartitionTopn>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()),
+                                                                     &_is_asc_order, &_is_null_first,
+                                                                     &_partition_expr_ctxs, _partition_limit);
+    } else if (_limit > 0) {
+        auto topn_sorter = std::make_unique<ChunksSorterTopn>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()),
+                                                              &_is_asc_order, &_is_null_first, _offset, _limit,
+                                                              ChunksSorter::SIZE_OF_CHUNK_FOR_TOPN);
+        if (_runtime_predicate != nullptr) {
+            topn_sorter->set_runtime_predicate(_runtime_predicate, 0);
+        }
+        _chunks_sorter = std::move(topn_sorter);
+    } else if (state->enable_spill()) {
+        _chunks_sorter = std::make_unique<ChunksSorterExternalSort>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()),
+                                                                    &_is_asc_order, &_is_null_first, _row_descriptor);
     } else {
         _chunks_sorter =
                 std::make_unique<ChunksSorterFullSort>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order,
-                                                       &_is_null_first, SIZE_OF_CHUNK_FOR_FULL_SORT);
+                                                       &_is_null_first, ChunksSorter::SIZE_OF_CHUNK_FOR_FULL_SORT);
     }
 
     bool eos = false;
@@ -151,7 +219,8 @@ Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
         }
         timer.start();
         if (chunk != nullptr && chunk->num_rows() > 0) {
-            ChunkPtr materialize_chunk = _materialize_chunk_before_sort(chunk.get());
+            ChunkPtr materialize_chunk = ChunksSorter::materialize_chunk_before_sort(
+                    chunk.get(), _materialized_tuple_desc, _sort_exec_exprs, _order_by_types);
             RETURN_IF_ERROR(_chunks_sorter->update(state, materialize_chunk));
         }
     } while (!eos);
@@ -159,56 +228,29 @@ Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
     return Status::OK();
 }
 
-ChunkPtr TopNNode::_materialize_chunk_before_sort(Chunk* chunk) {
-    ChunkPtr materialize_chunk = std::make_shared<Chunk>();
-
-    // materialize all sorting columns: replace old columns with evaluated columns
-    const size_t row_num = chunk->num_rows();
-    const auto& slots_in_row_descriptor = _materialized_tuple_desc->slots();
-    const auto& slots_in_sort_exprs = _sort_exec_exprs.sort_tuple_slot_expr_ctxs();
-
-    DCHECK_EQ(slots_in_row_descriptor.size(), slots_in_sort_exprs.size());
-
-    for (size_t i = 0; i < slots_in_sort_exprs.size(); ++i) {
-        ExprContext* expr_ctx = slots_in_sort_exprs[i];
-        ColumnPtr col = expr_ctx->evaluate(chunk);
-        if (col->is_constant()) {
-            if (col->is_nullable()) {
-                // Constant null column doesn't have original column data type information,
-                // so replace it by a nullable column of original data type filled with all NULLs.
-                ColumnPtr new_col = ColumnHelper::create_column(_order_by_types[i].type_desc, true);
-                new_col->append_nulls(row_num);
-                materialize_chunk->append_column(new_col, slots_in_row_descriptor[i]->id());
-            } else {
-                // Case 1: an expression may generate a constant column which will be reused by
-                // another call of evaluate(). We clone its data column to resize it as same as
-                // the size of the chunk, so that Chunk::num_rows() can return the right number
-                // if this ConstColumn is the first column of the chunk.
-                // Case 2: an expression may generate a constant column for one Chunk, but a
-                // non-constant one for another Chunk, we replace them all by non-constant columns.
-                auto* const_col = down_cast<ConstColumn*>(col.get());
-                const auto& data_col = const_col->data_column();
-                auto new_col = data_col->clone_empty();
-                new_col->append(*data_col, 0, 1);
-                new_col->assign(row_num, 0);
-                if (_order_by_types[i].is_nullable) {
-                    ColumnPtr null_col =
-                            NullableColumn::create(ColumnPtr(new_col.release()), NullColumn::create(row_num, 0));
-                    materialize_chunk->append_column(null_col, slots_in_row_descriptor[i]->id());
-                } else {
-                    materialize_chunk->append_column(ColumnPtr(new_col.release()), slots_in_row_descriptor[i]->id());
-                }
-            }
-        } else {
-            // When get a non-null column, but it should be nullable, we wrap it with a NullableColumn.
-            if (!col->is_nullable() && _order_by_types[i].is_nullable) {
-                col = NullableColumn::create(col, NullColumn::create(col->size(), 0));
-            }
-            materialize_chunk->append_column(col, slots_in_row_descriptor[i]->id());
-        }
+pipeline::OpFactories TopNNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    // Every driver of the child pipeline sorts its own chunks, and then the sorted runs
+    // are merged by a single driver.
+    OpFactories operators_sink_with_sort = _children[0]->decompose_to_pipeline(context);
+    auto sort_context = std::make_shared<SortContext>(_offset, _limit);
+    auto sink_operator = std::make_shared<PartitionSortSinkOperatorFactory>(
+            context->next_operator_id(), id(), sort_context, _tnode.sort_node.sort_info, _is_asc_order,
+            _is_null_first, _order_by_types, _materialized_tuple_desc, child(0)->row_desc(), _row_descriptor);
+    sink_operator->set_runtime_predicate(_runtime_predicate);
+    if (_tnode.sort_node.__isset.partition_exprs) {
+        sink_operator->set_partition_topn(_tnode.sort_node.partition_exprs, _partition_limit);
     }
-
-    return materialize_chunk;
+    operators_sink_with_sort.emplace_back(std::move(sink_operator));
+    context->add_pipeline(operators_sink_with_sort);
+
+    OpFactories operators_source_with_sort;
+    auto source_operator = std::make_shared<LocalMergeSortSourceOperatorFactory>(
+            context->next_operator_id(), id(), sort_context, _tnode.sort_node.sort_info, _is_asc_order,
+            _is_null_first, child(0)->row_desc(), _row_descriptor);
+    source_operator->set_degree_of_parallelism(1);
+    operators_source_with_sort.emplace_back(std::move(source_operator));
+    return operators_source_with_sort;
 }
 
 } // namespace starrocks::vectorized
@@ -4,11 +4,11 @@
 
 #include "exec/exec_node.h"
 #include "exec/sort_exec_exprs.h"
+#include "exec/vectorized/chunks_sorter.h"
+#include "storage/vectorized/runtime_predicate.h"
 
 namespace starrocks::vectorized {
 
-class ChunksSorter;
-
 // Node for in-memory TopN (ORDER BY ... LIMIT).
 //
 // It sorts rows in a batch of chunks in turn at the open stage,
@@ -27,10 +27,14 @@ public:
 
     Status close(RuntimeState* state) override;
 
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
 private:
     Status _consume_chunks(RuntimeState* state, ExecNode* child);
-    ChunkPtr _materialize_chunk_before_sort(Chunk* chunk);
+    void _init_runtime_predicate(RuntimeState* state);
 
+    const TPlanNode _tnode;
     int64_t _offset;
 
     // _sort_exec_exprs contains the ordering expressions
@@ -38,12 +42,13 @@ private:
     std::vector<bool> _is_asc_order;
     std::vector<bool> _is_null_first;
 
-    struct OrderByType {
-        TypeDescriptor type_desc;
-        bool is_nullable;
-    };
     std::vector<OrderByType> _order_by_types;
 
+    // Not empty if only the first _partition_limit rows of every partition are output, without being
+    // sorted by the partition exprs.
+    std::vector<ExprContext*> _partition_expr_ctxs;
+    int64_t _partition_limit = -1;
+
     // Cached descriptor for the materialized tuple. Assigned in Prepare().
     TupleDescriptor* _materialized_tuple_desc;
 
@@ -53,6 +58,10 @@ private:
 
     std::unique_ptr<ChunksSorter> _chunks_sorter;
 
+    // Not null if the top rows are ordered by a column of the olap scan node below firstly, whose data pages
+    // are pruned by the boundary of the top rows.
+    RuntimePredicatePtr _runtime_predicate;
+
     RuntimeProfile::Counter* _sort_timer;
 };
 
@@ -4,6 +4,11 @@
 
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
+#include "exec/pipeline/limit_operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/project_operator.h"
+#include "exec/pipeline/set/union_const_source_operator.h"
+#include "exec/pipeline/set/union_passthrough_operator.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 
@@ -148,6 +153,64 @@ Status UnionNode::close(RuntimeState* state) {
     return ExecNode::close(state);
 }
 
+pipeline::OpFactories UnionNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+    const auto* tuple_desc = context->fragment_context()->runtime_state()->desc_tbl().get_tuple_descriptor(_tuple_id);
+    const auto& dst_slots = tuple_desc->slots();
+
+    // Every child is decomposed to its own pipelines, the outputs of all the children are moved to
+    // the union tuple by the last operator of each child pipeline, and then fanned into one local
+    // exchange, so the children are executed in parallel rather than one after another.
+    std::vector<OpFactories> operators_list;
+    operators_list.reserve(_children.size() + 1);
+    for (int i = 0; i < _first_materialized_child_idx; ++i) {
+        UnionPassthroughOperator::Dst2SrcSlotMap dst2src_slot_map;
+        if (!_pass_through_slot_maps.empty()) {
+            for (const auto& [dst_slot_id, slot_item] : _pass_through_slot_maps[i]) {
+                dst2src_slot_map[dst_slot_id] = {slot_item.slot_id, slot_item.ref_count};
+            }
+        } else {
+            // For backward compatibility, the child tuple size must be 1.
+            const auto& src_slots = child(i)->row_desc().tuple_descriptors()[0]->slots();
+            for (size_t j = 0; j < src_slots.size(); ++j) {
+                dst2src_slot_map[dst_slots[j]->id()] = {src_slots[j]->id(), 1};
+            }
+        }
+
+        operators_list.emplace_back(_children[i]->decompose_to_pipeline(context));
+        operators_list.back().emplace_back(std::make_shared<UnionPassthroughOperatorFactory>(
+                context->next_operator_id(), id(), std::move(dst2src_slot_map), dst_slots));
+    }
+
+    for (int i = _first_materialized_child_idx; i < _children.size(); ++i) {
+        std::vector<int32_t> dst_slot_ids;
+        std::vector<bool> dst_type_is_nullable;
+        for (auto* dst_slot : dst_slots) {
+            dst_slot_ids.emplace_back(dst_slot->id());
+            dst_type_is_nullable.emplace_back(dst_slot->is_nullable());
+        }
+
+        operators_list.emplace_back(_children[i]->decompose_to_pipeline(context));
+        operators_list.back().emplace_back(std::make_shared<ProjectOperatorFactory>(
+                context->next_operator_id(), id(), std::move(dst_slot_ids),
+                std::vector<ExprContext*>(_child_expr_lists[i]), std::move(dst_type_is_nullable),
+                std::vector<int32_t>(), std::vector<ExprContext*>()));
+    }
+
+    if (!_const_expr_lists.empty()) {
+        operators_list.emplace_back();
+        operators_list.back().emplace_back(std::make_shared<UnionConstSourceOperatorFactory>(
+                context->next_operator_id(), id(), dst_slots, _const_expr_lists));
+    }
+
+    OpFactories operators = context->gather_pipelines_to_local_exchange(operators_list);
+    if (limit() != -1) {
+        operators = context->maybe_interpolate_local_passthrough_exchange(operators);
+        operators.emplace_back(std::make_shared<LimitOperatorFactory>(context->next_operator_id(), id(), limit()));
+    }
+    return operators;
+}
+
 Status UnionNode::_get_next_passthrough(RuntimeState* state, ChunkPtr* chunk) {
     (*chunk) = std::make_shared<Chunk>();
     ChunkPtr tmp_chunk = nullptr;
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "column/column.h"
 
 namespace starrocks_udf {
@@ -88,6 +90,15 @@ public:
     virtual void create(AggDataPtr ptr) const = 0;
     virtual void destroy(AggDataPtr ptr) const = 0;
 
+    // Batch create or destroy the states of many groups to reduce virtual function call,
+    // the state of the i-th group is at states[i] + state_offset.
+    virtual void batch_create(size_t batch_size, AggDataPtr* states, size_t state_offset) const = 0;
+    virtual void batch_destroy(size_t batch_size, AggDataPtr* states, size_t state_offset) const = 0;
+
+    // Whether the state is trivially copyable and destructible, like the states of sum/count/avg,
+    // so that it could be created by copying a created state, and needn't be destroyed.
+    virtual bool is_trivial_state() const = 0;
+
     // Contains a loop with calls to "update" function.
     // You can collect arguments into array "states"
     // and do a single call to "update_batch" for devirtualization and inlining.
@@ -110,6 +121,17 @@ public:
                                            int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                            int64_t frame_end) const {}
 
+    // For sliding window frames
+    // Remove the rows [start, end) from |state| of the frame [start, frame_end), so that it becomes the state of
+    // the frame [end, frame_end), and the frame could slide by removing the rows leaving it and adding the rows
+    // entering it, instead of being computed from scratch for every row.
+    // Return false if the state couldn't be restored without the removed rows, e.g. MAX when the maximum is
+    // removed, then the state must be reset and computed from scratch.
+    virtual bool remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
+                                           int64_t start, int64_t end, int64_t frame_end) const {
+        return false;
+    }
+
     // Contains a loop with calls to "merge" function.
     // You can collect arguments into array "states"
     // and do a single call to "merge_batch" for devirtualization and inlining.
@@ -132,6 +154,24 @@ public:
 
     void destroy(AggDataPtr ptr) const final { data(ptr).~State(); }
 
+    void batch_create(size_t batch_size, AggDataPtr* states, size_t state_offset) const final {
+        for (size_t i = 0; i < batch_size; i++) {
+            new (states[i] + state_offset) State;
+        }
+    }
+
+    void batch_destroy(size_t batch_size, AggDataPtr* states, size_t state_offset) const final {
+        if constexpr (!std::is_trivially_destructible_v<State>) {
+            for (size_t i = 0; i < batch_size; i++) {
+                data(states[i] + state_offset).~State();
+            }
+        }
+    }
+
+    bool is_trivial_state() const final {
+        return std::is_trivially_copyable_v<State> && std::is_trivially_destructible_v<State>;
+    }
+
     size_t size() const final { return sizeof(State); }
 
     size_t alignof_size() const final { return alignof(State); }
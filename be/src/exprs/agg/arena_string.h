@@ -0,0 +1,133 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/logging.h"
+#include "runtime/mem_pool.h"
+#include "util/slice.h"
+
+namespace starrocks::vectorized {
+
+// ArenaStringBuilder is a string of an agg state which only grows by appending, e.g. the result of group_concat.
+// The bytes are appended to a list of chunks allocated from the MemPool of the aggregator, so that a growing string
+// is never reallocated and copied, and the strings of many groups don't fragment the heap. The chunks grow from
+// kMinChunkSize to kMaxChunkSize, or larger for a larger value. They are freed along with the MemPool, and reused
+// by the appends after clear().
+class ArenaStringBuilder {
+public:
+    void append(MemPool* mem_pool, const char* data, size_t size) {
+        while (size > 0) {
+            if (_tail == nullptr || _tail->size == _tail->capacity) {
+                _next_chunk(mem_pool, size);
+            }
+            size_t n = std::min(size, _tail->capacity - _tail->size);
+            memcpy(_tail->data() + _tail->size, data, n);
+            _tail->size += n;
+            _size += n;
+            data += n;
+            size -= n;
+        }
+    }
+
+    void append(MemPool* mem_pool, const Slice& value) { append(mem_pool, value.data, value.size); }
+
+    size_t size() const { return _size; }
+
+    bool empty() const { return _size == 0; }
+
+    // Copy the |size| bytes from |offset| into |dst|, e.g. into the bytes of a BinaryColumn directly.
+    void copy_to(size_t offset, size_t size, void* dst) const {
+        DCHECK_LE(offset + size, _size);
+        auto* pos = reinterpret_cast<char*>(dst);
+        for (const Chunk* chunk = _head; size > 0; chunk = chunk->next) {
+            if (offset >= chunk->size) {
+                offset -= chunk->size;
+                continue;
+            }
+            size_t n = std::min(size, chunk->size - offset);
+            memcpy(pos, chunk->data() + offset, n);
+            pos += n;
+            size -= n;
+            offset = 0;
+        }
+    }
+
+    // Keep the chunks for the following appends, e.g. of the next partition of a window function.
+    void clear() {
+        if (_head != nullptr) {
+            _head->size = 0;
+        }
+        _tail = _head;
+        _size = 0;
+    }
+
+private:
+    static constexpr size_t kMinChunkSize = 64;
+    static constexpr size_t kMaxChunkSize = 64 * 1024;
+
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+        size_t capacity;
+
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+        const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+    };
+
+    void _next_chunk(MemPool* mem_pool, size_t size) {
+        if (_tail != nullptr && _tail->next != nullptr) {
+            _tail = _tail->next;
+            _tail->size = 0;
+            return;
+        }
+        size_t capacity = _tail == nullptr ? kMinChunkSize : std::min(_tail->capacity * 2, kMaxChunkSize);
+        capacity = std::max(capacity, size);
+        auto* chunk = reinterpret_cast<Chunk*>(mem_pool->allocate(sizeof(Chunk) + capacity));
+        chunk->next = nullptr;
+        chunk->size = 0;
+        chunk->capacity = capacity;
+        if (_tail == nullptr) {
+            _head = chunk;
+        } else {
+            _tail->next = chunk;
+        }
+        _tail = chunk;
+    }
+
+    Chunk* _head = nullptr;
+    Chunk* _tail = nullptr;
+    size_t _size = 0;
+};
+
+// ArenaString is a string of an agg state which is replaced as a whole, e.g. the result of max and min. The bytes
+// are allocated from the MemPool of the aggregator, and reused by the following assignments that fit in them, so
+// the space grows geometrically like a std::string but is freed along with the MemPool.
+class ArenaString {
+public:
+    void assign(MemPool* mem_pool, const Slice& value) {
+        if (value.size > _capacity) {
+            _capacity = std::max(value.size, _capacity * 2);
+            _data = reinterpret_cast<char*>(mem_pool->allocate(_capacity));
+        }
+        if (value.size > 0) {
+            memcpy(_data, value.data, value.size);
+        }
+        _size = value.size;
+    }
+
+    size_t size() const { return _size; }
+
+    Slice slice() const { return {_data, _size}; }
+
+    void clear() { _size = 0; }
+
+private:
+    char* _data = nullptr;
+    size_t _size = 0;
+    size_t _capacity = 0;
+};
+
+} // namespace starrocks::vectorized
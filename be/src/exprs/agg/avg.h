@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <cmath>
+
 #include "column/type_traits.h"
 #include "exprs/agg/aggregate.h"
 #include "exprs/vectorized/arithmetic_operation.h"
@@ -102,6 +104,28 @@ public:
         }
     }
 
+    // The floating sums can't be slid by subtraction, see SumAggregateFunction::remove_batch_single_state.
+    bool remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns, int64_t start,
+                                   int64_t end, int64_t frame_end) const override {
+        if constexpr (pt_is_float<PT>) {
+            return false;
+        }
+        [[maybe_unused]] const InputColumnType* column = down_cast<const InputColumnType*>(columns[0]);
+        for (size_t i = start; i < end; ++i) {
+            if constexpr (pt_is_datetime<PT>) {
+                this->data(state).sum -= column->get_data()[i].to_unix_second();
+            } else if constexpr (pt_is_date<PT>) {
+                this->data(state).sum -= column->get_data()[i].julian();
+            } else if constexpr (pt_is_arithmetic<PT> || pt_is_decimalv2<PT> || pt_is_decimal<PT>) {
+                this->data(state).sum = this->data(state).sum - column->get_data()[i];
+            } else {
+                return false;
+            }
+        }
+        this->data(state).count -= (end - start);
+        return true;
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         DCHECK(column->is_binary());
         Slice slice = column->get(row_num).get_slice();
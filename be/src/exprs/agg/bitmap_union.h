@@ -43,6 +43,16 @@ public:
         this->data(state) |= *(col->get_object(row_num));
     }
 
+    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                   AggDataPtr state) const override {
+        _union_rows(columns[0], batch_size, state);
+    }
+
+    void merge_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column* column,
+                                  AggDataPtr state) const override {
+        _union_rows(column, batch_size, state);
+    }
+
     void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override {
         BitmapColumn* col = down_cast<BitmapColumn*>(to);
         col->append(&(this->data(state)));
@@ -58,6 +68,17 @@ public:
     }
 
     std::string get_name() const override { return "bitmap_union"; }
+
+private:
+    // Union the bitmaps of a chunk at once.
+    void _union_rows(const Column* column, size_t batch_size, AggDataPtr state) const {
+        const auto* col = down_cast<const BitmapColumn*>(column);
+        std::vector<const BitmapValue*> values(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            values[i] = col->get_object(i);
+        }
+        this->data(state).fastunion(values);
+    }
 };
 
 } // namespace starrocks::vectorized
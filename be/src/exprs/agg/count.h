@@ -54,6 +54,12 @@ public:
         this->data(state).count += (frame_end - frame_start);
     }
 
+    bool remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns, int64_t start,
+                                   int64_t end, int64_t frame_end) const override {
+        this->data(state).count -= (end - start);
+        return true;
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         DCHECK(column->is_numeric());
         const auto* input_column = down_cast<const Int64Column*>(column);
@@ -147,6 +153,20 @@ public:
         }
     }
 
+    bool remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns, int64_t start,
+                                   int64_t end, int64_t frame_end) const override {
+        if (columns[0]->is_nullable() && columns[0]->has_null()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(columns[0]);
+            const uint8_t* null_data = nullable_column->immutable_null_column_data().data();
+            for (size_t i = start; i < end; ++i) {
+                this->data(state).count -= !null_data[i];
+            }
+        } else {
+            this->data(state).count -= (end - start);
+        }
+        return true;
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         DCHECK(column->is_numeric());
         const auto* input_column = down_cast<const Int64Column*>(column);
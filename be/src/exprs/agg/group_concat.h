@@ -7,7 +7,9 @@
 #include "column/column_helper.h"
 #include "column/type_traits.h"
 #include "exprs/agg/aggregate.h"
+#include "exprs/agg/arena_string.h"
 #include "gutil/casts.h"
+#include "udf/udf_internal.h"
 
 namespace starrocks::vectorized {
 template <PrimitiveType PT, typename = guard::Guard>
@@ -16,7 +18,7 @@ inline constexpr PrimitiveType GroupConcatResultPT = TYPE_VARCHAR;
 struct GroupConcatAggregateState {
     // intermediate_string.
     // concat with sep_length first.
-    std::string intermediate_string{};
+    ArenaStringBuilder intermediate_string{};
     // is initial
     bool initial{};
 };
@@ -31,87 +33,35 @@ public:
     using ResultColumnType = InputColumnType;
 
     void reset(FunctionContext* ctx, const Columns& args, AggDataPtr state) const override {
-        this->data(state).intermediate_string = {};
+        this->data(state).intermediate_string.clear();
         this->data(state).initial = false;
     }
 
     void update(FunctionContext* ctx, const Column** columns, AggDataPtr state, size_t row_num) const override {
         DCHECK(columns[0]->is_binary());
+        const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
+        Slice val = column_val->get_slice(row_num);
+        Slice sep(", ", 2);
         if (ctx->get_num_args() > 1) {
             auto const_column_sep = ctx->get_constant_column(1);
             if (const_column_sep == nullptr) {
-                const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
-                const InputColumnType* column_sep = down_cast<const InputColumnType*>(columns[1]);
-
-                std::string& result = this->data(state).intermediate_string;
-
-                Slice val = column_val->get_slice(row_num);
-                Slice sep = column_sep->get_slice(row_num);
-                if (!this->data(state).initial) {
-                    this->data(state).initial = true;
-
-                    // separator's length;
-                    uint32_t size = sep.get_size();
-                    result.append(reinterpret_cast<const char*>(&size), sizeof(uint32_t))
-                            .append(sep.get_data(), sep.get_size())
-                            .append(val.get_data(), val.get_size());
-                } else {
-                    result.append(sep.get_data(), sep.get_size()).append(val.get_data(), val.get_size());
-                }
-            } else {
-                const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
-                std::string& result = this->data(state).intermediate_string;
-
-                Slice val = column_val->get_slice(row_num);
-                Slice sep = ColumnHelper::get_const_value<TYPE_VARCHAR>(const_column_sep);
-
-                if (!this->data(state).initial) {
-                    this->data(state).initial = true;
-
-                    // separator's length;
-                    uint32_t size = sep.get_size();
-                    result.append(reinterpret_cast<const char*>(&size), sizeof(uint32_t))
-                            .append(sep.get_data(), sep.get_size())
-                            .append(val.get_data(), val.get_size());
-                } else {
-                    result.append(sep.get_data(), sep.get_size()).append(val.get_data(), val.get_size());
-                }
-            }
-        } else {
-            const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
-            std::string& result = this->data(state).intermediate_string;
-
-            Slice val = column_val->get_slice(row_num);
-            //DEFAULT sep_length.
-            if (!this->data(state).initial) {
-                this->data(state).initial = true;
-
-                // separator's length;
-                uint32_t size = 2;
-                result.append(reinterpret_cast<const char*>(&size), sizeof(uint32_t))
-                        .append(", ")
-                        .append(val.get_data(), val.get_size());
+                sep = down_cast<const InputColumnType*>(columns[1])->get_slice(row_num);
             } else {
-                result.append(", ").append(val.get_data(), val.get_size());
+                sep = ColumnHelper::get_const_value<TYPE_VARCHAR>(const_column_sep);
             }
         }
-    }
 
-    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
-                                   AggDataPtr state) const override {
-        if (ctx->get_num_args() > 1) {
-            const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
-            const InputColumnType* column_sep = down_cast<const InputColumnType*>(columns[1]);
-            this->data(state).intermediate_string.reserve(column_val->get_bytes().size() +
-                                                          column_sep->get_bytes().size());
-        } else {
-            const InputColumnType* column_val = down_cast<const InputColumnType*>(columns[0]);
-            this->data(state).intermediate_string.reserve(column_val->get_bytes().size() + 2 * batch_size);
-        }
+        MemPool* mem_pool = ctx->impl()->mem_pool();
+        ArenaStringBuilder& result = this->data(state).intermediate_string;
+        if (!this->data(state).initial) {
+            this->data(state).initial = true;
 
-        for (size_t i = 0; i < batch_size; ++i) {
-            update(ctx, columns, state, i);
+            // separator's length;
+            uint32_t size = sep.get_size();
+            result.append(mem_pool, reinterpret_cast<const char*>(&size), sizeof(uint32_t));
         }
+        result.append(mem_pool, sep);
+        result.append(mem_pool, val);
     }
 
     void update_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
@@ -128,13 +78,14 @@ public:
         uint32_t size_value = *reinterpret_cast<uint32_t*>(data);
         data += sizeof(uint32_t);
 
+        MemPool* mem_pool = ctx->impl()->mem_pool();
         if (!this->data(state).initial) {
             this->data(state).initial = true;
-            this->data(state).intermediate_string.append(data, size_value);
+            this->data(state).intermediate_string.append(mem_pool, data, size_value);
         } else {
             data += sizeof(uint32_t);
 
-            this->data(state).intermediate_string.append(data, size_value - sizeof(uint32_t));
+            this->data(state).intermediate_string.append(mem_pool, data, size_value - sizeof(uint32_t));
         }
     }
 
@@ -144,7 +95,7 @@ public:
         auto* column = down_cast<BinaryColumn*>(to);
         Bytes& bytes = column->get_bytes();
 
-        const std::string& value = this->data(state).intermediate_string;
+        const ArenaStringBuilder& value = this->data(state).intermediate_string;
 
         size_t old_size = bytes.size();
         size_t new_size = old_size + sizeof(uint32_t) + value.size();
@@ -152,7 +103,7 @@ public:
 
         uint32_t size_value = value.size();
         memcpy(bytes.data() + old_size, &size_value, sizeof(uint32_t));
-        memcpy(bytes.data() + old_size + sizeof(uint32_t), value.data(), size_value);
+        value.copy_to(0, size_value, bytes.data() + old_size + sizeof(uint32_t));
 
         column->get_offset().emplace_back(new_size);
     }
@@ -253,17 +204,22 @@ public:
     }
 
     void finalize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override {
-        const std::string& value = this->data(state).intermediate_string;
-        // Remove first sep_length.
-        const char* data = value.data();
-        uint32_t size = value.size();
+        const ArenaStringBuilder& value = this->data(state).intermediate_string;
+        auto* column = down_cast<ResultColumnType*>(to);
+        Bytes& bytes = column->get_bytes();
 
-        uint32_t sep_size = *reinterpret_cast<const uint32_t*>(data);
+        // Remove first sep_length.
+        uint32_t sep_size = 0;
+        value.copy_to(0, sizeof(uint32_t), &sep_size);
         uint32_t offset = sizeof(uint32_t) + sep_size;
+        uint32_t size = value.size() - offset;
 
-        data = data + offset;
-        size = size - offset;
-        down_cast<ResultColumnType*>(to)->append(Slice(data, size));
+        // The bytes are copied from the chunks into the column directly rather than through a contiguous string.
+        size_t old_size = bytes.size();
+        bytes.resize(old_size + size);
+        value.copy_to(offset, size, bytes.data() + old_size);
+        column->get_offset().emplace_back(bytes.size());
+        column->invalidate_slice_cache();
     }
 
     std::string get_name() const override { return "group concat"; }
@@ -42,32 +42,15 @@ public:
         }
     }
 
+    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                   AggDataPtr state) const override {
+        _update_rows(columns[0], 0, batch_size, state);
+    }
+
     void update_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
                                    int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                    int64_t frame_end) const override {
-        const ColumnType* column = down_cast<const ColumnType*>(columns[0]);
-
-        if constexpr (pt_is_binary<PT>) {
-            uint64_t value = 0;
-            for (size_t i = frame_start; i < frame_end; ++i) {
-                Slice s = column->get_slice(i);
-                value = HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
-
-                if (value != 0) {
-                    this->data(state).update(value);
-                }
-            }
-        } else {
-            uint64_t value = 0;
-            const auto& v = column->get_data();
-            for (size_t i = frame_start; i < frame_end; ++i) {
-                value = HashUtil::murmur_hash64A(&v[i], sizeof(v[i]), HashUtil::MURMUR_SEED);
-
-                if (value != 0) {
-                    this->data(state).update(value);
-                }
-            }
-        }
+        _update_rows(columns[0], frame_start, frame_end, state);
     }
 
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
@@ -141,6 +124,28 @@ public:
     }
 
     std::string get_name() const override { return "ndv"; }
+
+private:
+    // Hash the rows [start, end) first and add the hash values in a batch.
+    void _update_rows(const Column* input, size_t start, size_t end, AggDataPtr state) const {
+        const ColumnType* column = down_cast<const ColumnType*>(input);
+        std::vector<uint64_t> hash_values;
+        hash_values.reserve(end - start);
+        for (size_t i = start; i < end; ++i) {
+            uint64_t value = 0;
+            if constexpr (pt_is_binary<PT>) {
+                Slice s = column->get_slice(i);
+                value = HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
+            } else {
+                const auto& v = column->get_data();
+                value = HashUtil::murmur_hash64A(&v[i], sizeof(v[i]), HashUtil::MURMUR_SEED);
+            }
+            if (value != 0) {
+                hash_values.push_back(value);
+            }
+        }
+        this->data(state).update_batch(hash_values.data(), hash_values.size());
+    }
 };
 
 } // namespace starrocks::vectorized
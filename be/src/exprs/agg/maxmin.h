@@ -27,7 +27,9 @@
 #include "column/fixed_length_column.h"
 #include "column/type_traits.h"
 #include "exprs/agg/aggregate.h"
+#include "exprs/agg/arena_string.h"
 #include "gutil/casts.h"
+#include "udf/udf_internal.h"
 
 namespace starrocks::vectorized {
 
@@ -80,14 +82,14 @@ struct MaxAggregateData<TYPE_DATE, guard::Guard> {
 template <PrimitiveType PT>
 struct MaxAggregateData<PT, BinaryPTGuard<PT>> {
     int32_t size = -1;
-    Buffer<uint8_t> buffer;
+    ArenaString value;
 
-    bool has_value() const { return buffer.size() > 0; }
+    bool has_value() const { return value.size() > 0; }
 
-    Slice slice() const { return {buffer.data(), buffer.size()}; }
+    Slice slice() const { return value.slice(); }
 
     void reset() {
-        buffer.clear();
+        value.clear();
         size = -1;
     }
 };
@@ -141,14 +143,14 @@ struct MinAggregateData<TYPE_DATE, guard::Guard> {
 template <PrimitiveType PT>
 struct MinAggregateData<PT, BinaryPTGuard<PT>> {
     int32_t size = -1;
-    Buffer<uint8_t> buffer;
+    ArenaString value;
 
     bool has_value() const { return size > -1; }
 
-    Slice slice() const { return {buffer.data(), buffer.size()}; }
+    Slice slice() const { return value.slice(); }
 
     void reset() {
-        buffer.clear();
+        value.clear();
         size = -1;
     }
 };
@@ -167,11 +169,9 @@ struct MinElement {
 
 template <PrimitiveType PT>
 struct MaxElement<PT, MaxAggregateData<PT>, BinaryPTGuard<PT>> {
-    void operator()(MaxAggregateData<PT>& state, const Slice& right) const {
+    void operator()(MemPool* mem_pool, MaxAggregateData<PT>& state, const Slice& right) const {
         if (!state.has_value() || state.slice().compare(right) < 0) {
-            // TODO(kks): resize don't initialize
-            state.buffer.resize(right.size);
-            memcpy(state.buffer.data(), right.data, right.size);
+            state.value.assign(mem_pool, right);
             state.size = right.size;
         }
     }
@@ -179,11 +179,9 @@ struct MaxElement<PT, MaxAggregateData<PT>, BinaryPTGuard<PT>> {
 
 template <PrimitiveType PT>
 struct MinElement<PT, MinAggregateData<PT>, BinaryPTGuard<PT>> {
-    void operator()(MinAggregateData<PT>& state, const Slice& right) const {
+    void operator()(MemPool* mem_pool, MinAggregateData<PT>& state, const Slice& right) const {
         if (!state.has_value() || state.slice().compare(right) > 0) {
-            // TODO(kks): resize don't initialize
-            state.buffer.resize(right.size);
-            memcpy(state.buffer.data(), right.data, right.size);
+            state.value.assign(mem_pool, right);
             state.size = right.size;
         }
     }
@@ -214,6 +212,19 @@ public:
         }
     }
 
+    bool remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns, int64_t start,
+                                   int64_t end, int64_t frame_end) const override {
+        const auto& column = down_cast<const InputColumnType&>(*columns[0]);
+        const T* data = column.get_data().data();
+        for (size_t i = start; i < end; ++i) {
+            // The extreme is removed, it must be found again from the rest rows.
+            if (data[i] == this->data(state).result) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         DCHECK(!column->is_nullable() && !column->is_binary());
         const auto* input_column = down_cast<const InputColumnType*>(column);
@@ -257,7 +268,7 @@ public:
     void update(FunctionContext* ctx, const Column** columns, AggDataPtr state, size_t row_num) const override {
         DCHECK((*columns[0]).is_binary());
         Slice value = columns[0]->get(row_num).get_slice();
-        OP()(this->data(state), value);
+        OP()(ctx->impl()->mem_pool(), this->data(state), value);
     }
 
     void update_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
@@ -271,7 +282,7 @@ public:
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         DCHECK(column->is_binary());
         Slice value = column->get(row_num).get_slice();
-        OP()(this->data(state), value);
+        OP()(ctx->impl()->mem_pool(), this->data(state), value);
     }
 
     void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override {
@@ -23,6 +23,7 @@
 
 #include <immintrin.h>
 
+#include <cstring>
 #include <utility>
 
 #include "column/column_helper.h"
@@ -393,7 +394,7 @@ public:
                                    int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                    int64_t frame_end) const override {
         // For cases like: rows between 2 preceding and 1 preceding
-        // Please refer to AnalyticNode::_update_window_batch_normal
+        // Please refer to Analytor::_update_window_batch_normal
         // If frame_start ge frame_end, means the frame is empty,
         // we could directly return.
         if (frame_start >= frame_end) {
@@ -428,6 +429,42 @@ public:
                                                              peer_group_start, peer_group_end, frame_start, frame_end);
         }
     }
+
+    bool remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns, int64_t start,
+                                   int64_t end, int64_t frame_end) const override {
+        if (start >= end) {
+            return true;
+        }
+
+        if (columns[0]->is_nullable() && columns[0]->has_null()) {
+            const auto* column = down_cast<const NullableColumn*>(columns[0]);
+            const Column* data_column = &column->data_column_ref();
+            const uint8_t* f_data = column->null_column()->raw_data();
+            for (size_t i = start; i < end; ++i) {
+                if (f_data[i] == 0 && !this->nested_function->remove_batch_single_state(
+                                              ctx, this->data(state).mutable_nest_state(), &data_column, i, i + 1,
+                                              frame_end)) {
+                    return false;
+                }
+            }
+            // The result is null if all the rest rows are null.
+            if (!this->data(state).is_null) {
+                this->data(state).is_null =
+                        end >= frame_end || memchr(f_data + end, 0, frame_end - end) == nullptr;
+            }
+            return true;
+        }
+
+        const Column* data_column = columns[0]->is_nullable()
+                                            ? &down_cast<const NullableColumn*>(columns[0])->data_column_ref()
+                                            : columns[0];
+        if (!this->nested_function->remove_batch_single_state(ctx, this->data(state).mutable_nest_state(),
+                                                              &data_column, start, end, frame_end)) {
+            return false;
+        }
+        this->data(state).is_null = end >= frame_end;
+        return true;
+    }
 };
 
 template <typename State>
@@ -43,6 +43,41 @@ public:
         data(state).is_null = false;
     }
 
+    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                   AggDataPtr state) const override {
+        const DoubleColumn* column = nullptr;
+        const uint8_t* null_data = nullptr;
+        if (columns[0]->is_nullable()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(columns[0]);
+            column = down_cast<const DoubleColumn*>(nullable_column->data_column().get());
+            if (nullable_column->has_null()) {
+                null_data = nullable_column->immutable_null_column_data().data();
+            }
+        } else {
+            column = down_cast<const DoubleColumn*>(columns[0]);
+        }
+
+        // Add the values of the chunk at once.
+        std::vector<float> values;
+        values.reserve(batch_size);
+        const double* input = column->get_data().data();
+        for (size_t i = 0; i < batch_size; ++i) {
+            if (null_data == nullptr || !null_data[i]) {
+                values.push_back(implicit_cast<float>(input[i]));
+            }
+        }
+        if (values.empty()) {
+            return;
+        }
+
+        DCHECK(!columns[1]->only_null());
+        DCHECK(!columns[1]->is_null(0));
+
+        data(state).percentile->add(values.data(), values.size());
+        data(state).targetQuantile = columns[1]->get(0).get_double();
+        data(state).is_null = false;
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         Slice src;
         if (column->is_nullable()) {
@@ -68,8 +103,10 @@ public:
     }
 
     void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr state, Column* to) const override {
-        size_t size = data(state).percentile->serialize_size();
-        uint8_t result[size + sizeof(double)];
+        // The buffered values are processed into fewer centroids before being sent to merge.
+        data(state).percentile->compress();
+        size_t size = data(state).percentile->serialize_size() + sizeof(double);
+        uint8_t result[size];
         memcpy(result, &(data(state).targetQuantile), sizeof(double));
         data(state).percentile->serialize(result + sizeof(double));
 
@@ -19,10 +19,17 @@ public:
     void update_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns,
                                    int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                    int64_t frame_end) const override {
-        const PercentileColumn* column = down_cast<const PercentileColumn*>(columns[0]);
-        for (size_t i = frame_start; i < frame_end; ++i) {
-            this->data(state).merge(column->get_object(i));
-        }
+        _merge_rows(columns[0], frame_start, frame_end, state);
+    }
+
+    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                   AggDataPtr state) const override {
+        _merge_rows(columns[0], 0, batch_size, state);
+    }
+
+    void merge_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column* column,
+                                  AggDataPtr state) const override {
+        _merge_rows(column, 0, batch_size, state);
     }
 
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
@@ -51,5 +58,17 @@ public:
     }
 
     std::string get_name() const override { return "percentile_union"; }
+
+private:
+    // Merge the values of the rows [start, end) at once.
+    void _merge_rows(const Column* column, size_t start, size_t end, AggDataPtr state) const {
+        const auto* percentile_column = down_cast<const PercentileColumn*>(column);
+        std::vector<const PercentileValue*> values;
+        values.reserve(end - start);
+        for (size_t i = start; i < end; ++i) {
+            values.push_back(percentile_column->get_object(i));
+        }
+        this->data(state).merge(values);
+    }
 };
 } // namespace starrocks::vectorized
\ No newline at end of file
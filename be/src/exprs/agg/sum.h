@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <cmath>
+
 #include "column/type_traits.h"
 #include "exprs/agg/aggregate.h"
 #include "gutil/casts.h"
@@ -87,6 +89,22 @@ public:
         }
     }
 
+    // The floating sums can't be slid by subtraction, e.g. (1e20 + 1 + 1) - 1e20 is 0 rather than 2, so their frames
+    // are computed from scratch.
+    bool remove_batch_single_state(FunctionContext* ctx, AggDataPtr state, const Column** columns, int64_t start,
+                                   int64_t end, int64_t frame_end) const override {
+        if constexpr (pt_is_datetime<PT> || pt_is_date<PT> || pt_is_float<PT>) {
+            return false;
+        } else {
+            const auto* column = down_cast<const InputColumnType*>(columns[0]);
+            const auto* data = column->get_data().data();
+            for (size_t i = start; i < end; ++i) {
+                this->data(state).sum = this->data(state).sum - data[i];
+            }
+            return true;
+        }
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr state, size_t row_num) const override {
         DCHECK(column->is_numeric() || column->is_decimal());
         const auto* input_column = down_cast<const ResultColumnType*>(column);
@@ -20,30 +20,41 @@ class Unnest final : public TableFunction {
         auto* col_array = down_cast<ArrayColumn*>(ColumnHelper::get_data_column(arg0));
         Columns result;
         if (arg0->has_null()) {
-            NullableColumn* nullable_array_column = down_cast<NullableColumn*>(arg0);
+            const auto* nullable_array_column = down_cast<const NullableColumn*>(arg0);
+            const NullData& nulls = nullable_array_column->immutable_null_column_data();
+            const auto& offsets = col_array->offsets_column()->get_data();
+            size_t num_rows = nullable_array_column->size();
 
-            auto offset_column = col_array->offsets_column();
-            ColumnPtr compacted_offset_column = offset_column->clone_empty();
-            compacted_offset_column->append_datum(Datum(0));
+            // The null arrays are usually empty, whose rows produce nothing with the offsets as they are, so the
+            // array's columns are returned directly.
+            bool has_null_elements = false;
+            for (size_t row_idx = 0; row_idx < num_rows; ++row_idx) {
+                has_null_elements |= nulls[row_idx] && offsets[row_idx + 1] != offsets[row_idx];
+            }
+            if (!has_null_elements) {
+                result.emplace_back(col_array->elements_column());
+                return std::make_pair(result, col_array->offsets_column());
+            }
 
+            // Compact the elements of the non-null arrays, range by range of the consecutive non-null rows.
+            auto compacted_offset_column = UInt32Column::create();
+            auto& compacted_offsets = compacted_offset_column->get_data();
+            compacted_offsets.resize(num_rows + 1);
+            compacted_offsets[0] = 0;
             ColumnPtr compacted_array_elements = col_array->elements_column()->clone_empty();
-            int compact_offset = 0;
-
-            for (int row_idx = 0; row_idx < nullable_array_column->size(); ++row_idx) {
-                if (nullable_array_column->is_null(row_idx)) {
-                    compact_offset +=
-                            offset_column->get(row_idx + 1).get_int32() - offset_column->get(row_idx).get_int32();
-                    int32 offset = offset_column->get(row_idx + 1).get_int32();
-                    compacted_offset_column->append_datum(offset - compact_offset);
-                } else {
-                    int32 offset = offset_column->get(row_idx + 1).get_int32();
-                    compacted_offset_column->append_datum(offset - compact_offset);
-
-                    compacted_array_elements->append(
-                            *(col_array->elements_column()), offset_column->get(row_idx).get_int32(),
-                            offset_column->get(row_idx + 1).get_int32() - offset_column->get(row_idx).get_int32());
+            uint32_t compact_offset = 0;
+            uint32_t range_start = offsets[0];
+            for (size_t row_idx = 0; row_idx < num_rows; ++row_idx) {
+                if (nulls[row_idx]) {
+                    compacted_array_elements->append(*col_array->elements_column(), range_start,
+                                                     offsets[row_idx] - range_start);
+                    range_start = offsets[row_idx + 1];
+                    compact_offset += offsets[row_idx + 1] - offsets[row_idx];
                 }
+                compacted_offsets[row_idx + 1] = offsets[row_idx + 1] - compact_offset;
             }
+            compacted_array_elements->append(*col_array->elements_column(), range_start,
+                                             offsets[num_rows] - range_start);
 
             result.emplace_back(compacted_array_elements);
             return std::make_pair(result, compacted_offset_column);
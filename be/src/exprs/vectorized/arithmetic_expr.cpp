@@ -32,6 +32,10 @@ public:
             return VectorizedStrictDecimalBinaryFunction<OP, false>::template evaluate<Type>(l, r);
         } else {
             using ArithmeticOp = ArithmeticBinaryOperator<OP, Type>;
+            // The results are written into the column of either child, if it's a temporary one.
+            if (auto result = InPlaceBinaryFunction<ArithmeticOp>::template evaluate<Type>(l, r); result != nullptr) {
+                return result;
+            }
             return VectorizedStrictBinaryFunction<ArithmeticOp>::template evaluate<Type>(l, r);
         }
     }
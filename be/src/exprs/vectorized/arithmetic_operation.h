@@ -295,9 +295,8 @@ struct ArithmeticBinaryOperator<Op, Type, DecimalOpGuard<Op>, DecimalPTGuard<Typ
             [[maybe_unused]] auto overflow =
                     DecimalV3Cast::scale_up<LType, LType, check_overflow>(l, scale_factor, &ll);
             if constexpr (check_overflow) {
-                if (overflow) {
-                    return true;
-                }
+                // combine the overflows without a branch, so the loop over the rows is vectorized.
+                return apply<check_overflow, LType, RType, ResultType>(ll, r, result) | overflow;
             }
             return apply<check_overflow, LType, RType, ResultType>(ll, r, result);
         } else {
@@ -114,11 +114,88 @@ public:
     }
 
 private:
+    // The fixed length elements are compared with the target without a branch, so the compiler vectorizes the
+    // comparisons of an array, which costs less than breaking at the first match for the short arrays, e.g. tags.
+    template <bool NullableElement, bool ConstTarget, typename ElementColumn, typename TargetColumn>
+    static ColumnPtr _process_fixed_length(const ElementColumn& elements, const UInt32Column& offsets,
+                                           const TargetColumn& targets,
+                                           const NullColumn::Container* null_map_elements) {
+        using ValueType = typename ElementColumn::ValueType;
+
+        const size_t num_array = offsets.size() - 1;
+        auto result = UInt8Column::create();
+        result->resize(num_array);
+
+        uint8_t* result_ptr = result->get_data().data();
+        const uint32_t* offsets_ptr = offsets.get_data().data();
+        const ValueType* elements_ptr = elements.get_data().data();
+        const auto* targets_ptr = (const ValueType*)(targets.raw_data());
+        [[maybe_unused]] const uint8_t* nulls = NullableElement ? null_map_elements->data() : nullptr;
+
+        for (size_t i = 0; i < num_array; i++) {
+            const ValueType& target = ConstTarget ? targets_ptr[0] : targets_ptr[i];
+            uint8_t found = 0;
+            for (size_t j = offsets_ptr[i]; j < offsets_ptr[i + 1]; j++) {
+                if constexpr (NullableElement) {
+                    found |= (elements_ptr[j] == target) & !nulls[j];
+                } else {
+                    found |= (elements_ptr[j] == target);
+                }
+            }
+            result_ptr[i] = found;
+        }
+        return result;
+    }
+
+    // The strings are compared on the bytes and offsets of the elements column, the lengths first, rather than on
+    // the slices of every element.
+    template <bool NullableElement, bool ConstTarget, typename TargetColumn>
+    static ColumnPtr _process_binary(const BinaryColumn& elements, const UInt32Column& offsets,
+                                     const TargetColumn& targets, const NullColumn::Container* null_map_elements) {
+        const size_t num_array = offsets.size() - 1;
+        auto result = UInt8Column::create();
+        result->resize(num_array);
+
+        uint8_t* result_ptr = result->get_data().data();
+        const uint32_t* offsets_ptr = offsets.get_data().data();
+        const uint32_t* element_offsets = elements.get_offset().data();
+        const uint8_t* bytes = elements.get_bytes().data();
+        const BinaryColumn* target_column = down_cast<const BinaryColumn*>(ColumnHelper::get_data_column(
+                ConstTarget ? down_cast<const ConstColumn&>(targets).data_column().get() : &targets));
+        [[maybe_unused]] const uint8_t* nulls = NullableElement ? null_map_elements->data() : nullptr;
+
+        for (size_t i = 0; i < num_array; i++) {
+            const Slice target = target_column->get_slice(ConstTarget ? 0 : i);
+            uint8_t found = 0;
+            for (size_t j = offsets_ptr[i]; j < offsets_ptr[i + 1]; j++) {
+                if constexpr (NullableElement) {
+                    if (nulls[j]) {
+                        continue;
+                    }
+                }
+                if (element_offsets[j + 1] - element_offsets[j] == target.size &&
+                    memcmp(bytes + element_offsets[j], target.data, target.size) == 0) {
+                    found = 1;
+                    break;
+                }
+            }
+            result_ptr[i] = found;
+        }
+        return result;
+    }
+
     template <bool NullableElement, bool NullableTarget, bool ConstTarget, typename ElementColumn,
               typename TargetColumn>
     static ColumnPtr _process(const ElementColumn& elements, const UInt32Column& offsets, const TargetColumn& targets,
                               const NullColumn::Container* null_map_elements,
                               const NullColumn::Container* null_map_targets) {
+        if constexpr (!NullableTarget && std::is_same_v<BinaryColumn, ElementColumn>) {
+            return _process_binary<NullableElement, ConstTarget>(elements, offsets, targets, null_map_elements);
+        } else if constexpr (!NullableTarget && !std::is_same_v<ArrayColumn, ElementColumn>) {
+            return _process_fixed_length<NullableElement, ConstTarget>(elements, offsets, targets,
+                                                                       null_map_elements);
+        }
+
         const size_t num_array = offsets.size() - 1;
         auto result = UInt8Column::create();
         result->resize(num_array);
@@ -343,21 +420,30 @@ public:
             ResultType sum{};
 
             bool has_data = false;
-            for (size_t j = 0; j < array_size; j++) {
-                if constexpr (has_null) {
-                    if ((*null_elements)[offset + j] != 0) {
-                        continue;
-                    }
+            if constexpr (has_null && pt_is_arithmetic<value_type>) {
+                // Add zeros for the null elements instead of a branch, so that the compiler vectorizes the sum.
+                const uint8_t* nulls = null_elements->data() + offset;
+                for (size_t j = 0; j < array_size; j++) {
+                    sum += nulls[j] ? ResultType{} : static_cast<ResultType>(elements_ptr[offset + j]);
+                    has_data |= !nulls[j];
                 }
+            } else {
+                for (size_t j = 0; j < array_size; j++) {
+                    if constexpr (has_null) {
+                        if ((*null_elements)[offset + j] != 0) {
+                            continue;
+                        }
+                    }
 
-                has_data = true;
-                auto& value = elements_ptr[offset + j];
-                if constexpr (pt_is_datetime<value_type>) {
-                    sum += value.to_unix_second();
-                } else if constexpr (pt_is_date<value_type>) {
-                    sum += value.julian();
-                } else {
-                    sum += value;
+                    has_data = true;
+                    auto& value = elements_ptr[offset + j];
+                    if constexpr (pt_is_datetime<value_type>) {
+                        sum += value.to_unix_second();
+                    } else if constexpr (pt_is_date<value_type>) {
+                        sum += value.julian();
+                    } else {
+                        sum += value;
+                    }
                 }
             }
 
@@ -480,19 +566,33 @@ public:
                 }
 
                 bool has_data = false;
-                for (; index < array_size; index++) {
-                    if constexpr (has_null) {
-                        if ((*null_elements)[offset + index] != 0) {
-                            continue;
+                if constexpr (has_null && pt_is_arithmetic<value_type>) {
+                    // Keep the result for the null elements instead of a branch, so that the compiler vectorizes it.
+                    const uint8_t* nulls = null_elements->data() + offset;
+                    for (; index < array_size; index++) {
+                        const ValueType& value = elements_ptr[offset + index];
+                        if constexpr (is_min) {
+                            result = nulls[index] || result < value ? result : value;
+                        } else {
+                            result = !nulls[index] && result < value ? value : result;
                         }
+                        has_data |= !nulls[index];
                     }
+                } else {
+                    for (; index < array_size; index++) {
+                        if constexpr (has_null) {
+                            if ((*null_elements)[offset + index] != 0) {
+                                continue;
+                            }
+                        }
 
-                    has_data = true;
-                    auto& value = elements_ptr[offset + index];
-                    if constexpr (is_min) {
-                        result = result < value ? result : value;
-                    } else {
-                        result = result < value ? value : result;
+                        has_data = true;
+                        auto& value = elements_ptr[offset + index];
+                        if constexpr (is_min) {
+                            result = result < value ? result : value;
+                        } else {
+                            result = result < value ? value : result;
+                        }
                     }
                 }
 
@@ -383,9 +383,11 @@ class LogicPredicateBinaryFunction {
 public:
     template <PrimitiveType LType, PrimitiveType RType, PrimitiveType ResultType>
     static ColumnPtr evaluate(const ColumnPtr& v1, const ColumnPtr& v2) {
-        // const/regular
-        if (!v1->is_nullable() && !v2->is_nullable()) {
-            return CONST_FN::template evaluate<LType, RType, ResultType>(v1, v2);
+        // const/regular, or the nullable columns without null
+        const ColumnPtr& data1 = FunctionHelper::get_data_column_if_no_null(v1);
+        const ColumnPtr& data2 = FunctionHelper::get_data_column_if_no_null(v2);
+        if (!data1->is_nullable() && !data2->is_nullable()) {
+            return CONST_FN::template evaluate<LType, RType, ResultType>(data1, data2);
         }
 
         ColumnPtr ld;
@@ -452,6 +454,94 @@ public:
     }
 };
 
+/**
+ * Execute the operation without allocating the result column, by writing the results into |v1| or |v2|, whichever
+ * is a temporary column of the result type referred to only by the caller, e.g. the result of a child expression,
+ * so that a tree of the operations, like a * 2 + b - c, doesn't allocate and walk a column per node. The null flags
+ * of the other column are unioned into the reused one.
+ *
+ * Only for the strict operations of the same type of the operands and the result, e.g. +, -, *, &.
+ * Return nullptr if neither of the columns could be reused, or either is only null.
+ *
+ * @param OP: the operation impl
+ */
+template <typename OP>
+class InPlaceBinaryFunction {
+public:
+    template <PrimitiveType Type>
+    static ColumnPtr evaluate(const ColumnPtr& v1, const ColumnPtr& v2) {
+        if (v1->only_null() || v2->only_null()) {
+            return nullptr;
+        }
+        bool reuse_left = is_reusable(v1);
+        if (!reuse_left && !is_reusable(v2)) {
+            return nullptr;
+        }
+        const ColumnPtr& result = reuse_left ? v1 : v2;
+        const ColumnPtr& other = reuse_left ? v2 : v1;
+        if (!other->is_constant() && other->size() != result->size()) {
+            return nullptr;
+        }
+
+        using CppType = RunTimeCppType<Type>;
+        auto* out = ColumnHelper::cast_to_raw<Type>(FunctionHelper::get_real_data_column(result))->get_data().data();
+        const ColumnPtr& other_data = other->is_constant()
+                                              ? ColumnHelper::as_raw_column<ConstColumn>(other)->data_column()
+                                              : FunctionHelper::get_real_data_column(other);
+        const auto* in = ColumnHelper::cast_to_raw<Type>(other_data)->get_data().data();
+        const size_t size = result->size();
+        if (other->is_constant()) {
+            const CppType value = in[0];
+            if (reuse_left) {
+                for (size_t i = 0; i < size; ++i) {
+                    out[i] = OP::template apply<CppType, CppType, CppType>(out[i], value);
+                }
+            } else {
+                for (size_t i = 0; i < size; ++i) {
+                    out[i] = OP::template apply<CppType, CppType, CppType>(value, out[i]);
+                }
+            }
+        } else if (reuse_left) {
+            for (size_t i = 0; i < size; ++i) {
+                out[i] = OP::template apply<CppType, CppType, CppType>(out[i], in[i]);
+            }
+        } else {
+            for (size_t i = 0; i < size; ++i) {
+                out[i] = OP::template apply<CppType, CppType, CppType>(in[i], out[i]);
+            }
+        }
+
+        if (!other->has_null()) {
+            return result;
+        }
+        const auto& other_nulls = down_cast<NullableColumn*>(other.get())->null_column();
+        if (!result->is_nullable()) {
+            return NullableColumn::create(result, ColumnHelper::as_column<NullColumn>(other_nulls->clone_shared()));
+        }
+        auto* nullable = down_cast<NullableColumn*>(result.get());
+        auto* nulls = nullable->null_column_data().data();
+        const auto* nulls2 = other_nulls->get_data().data();
+        for (size_t i = 0; i < size; ++i) {
+            nulls[i] |= nulls2[i];
+        }
+        nullable->set_has_null(true);
+        return result;
+    }
+
+private:
+    // Whether nothing but |column| itself refers to it and its data, so it could be overwritten.
+    static bool is_reusable(const ColumnPtr& column) {
+        if (column.use_count() != 1 || column->is_constant()) {
+            return false;
+        }
+        if (column->is_nullable()) {
+            auto* nullable = down_cast<NullableColumn*>(column.get());
+            return nullable->data_column().use_count() == 1 && nullable->null_column().use_count() == 1;
+        }
+        return true;
+    }
+};
+
 /**
  * Use for strict binary operations function, usually the result
  * contains (nullable column, data column) , like:
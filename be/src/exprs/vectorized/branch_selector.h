@@ -0,0 +1,98 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+#include "column/column_builder.h"
+#include "column/column_helper.h"
+#include "column/column_viewer.h"
+#include "simd/simd.h"
+
+namespace starrocks::vectorized {
+
+// BranchSelector merges the results of the branches of the conditional exprs, e.g. CASE WHEN and IF, which decide
+// the branch of every row first and evaluate the branches chosen by any row afterwards. The value of a row is
+// the one in columns[branches[row]].
+//
+// The fixed length values are merged column by column by a branchless select, which the compiler vectorizes,
+// instead of being appended row by row.
+template <PrimitiveType Type>
+class BranchSelector {
+public:
+    using CppType = RunTimeCppType<Type>;
+
+    static constexpr bool is_fixed_length =
+            !isSlicePT<Type> && Type != TYPE_OBJECT && Type != TYPE_HLL && Type != TYPE_PERCENTILE;
+
+    static ColumnPtr select(const Columns& columns, const std::vector<uint32_t>& branches, int precision, int scale,
+                            bool is_const) {
+        size_t size = branches.size();
+        if constexpr (is_fixed_length) {
+            if (!is_const) {
+                ColumnBuilder<Type> builder(precision, scale);
+                auto data_column = builder.data_column();
+                data_column->resize_uninitialized(size);
+                auto null_column = NullColumn::create(size, DATUM_NOT_NULL);
+                CppType* data = data_column->get_data().data();
+                NullColumn::ValueType* nulls = null_column->get_data().data();
+                for (uint32_t branch = 0; branch < columns.size(); branch++) {
+                    _select_fixed_length(columns[branch], branch, branches.data(), size, data, nulls);
+                }
+                bool has_null = SIMD::count_nonzero(null_column->get_data()) > 0;
+                return ColumnBuilder<Type>(data_column, null_column, has_null).build(false);
+            }
+        }
+
+        std::vector<ColumnViewer<Type>> viewers;
+        viewers.reserve(columns.size());
+        for (const ColumnPtr& column : columns) {
+            viewers.emplace_back(column);
+        }
+        ColumnBuilder<Type> builder(precision, scale);
+        builder.reserve(size);
+        for (size_t row = 0; row < size; ++row) {
+            const ColumnViewer<Type>& viewer = viewers[branches[row]];
+            if (!viewer.is_null(row)) {
+                builder.append(viewer.value(row));
+            } else {
+                builder.append_null();
+            }
+        }
+        return builder.build(is_const);
+    }
+
+private:
+    static void _select_fixed_length(const ColumnPtr& column, uint32_t branch, const uint32_t* branches, size_t size,
+                                     CppType* data, NullColumn::ValueType* nulls) {
+        ColumnViewer<Type> viewer(column);
+        if (column->only_null() || column->is_constant()) {
+            const CppType value = viewer.value(0);
+            const NullColumn::ValueType is_null = viewer.is_null(0);
+            for (size_t row = 0; row < size; ++row) {
+                bool selected = branches[row] == branch;
+                data[row] = selected ? value : data[row];
+                nulls[row] = selected ? is_null : nulls[row];
+            }
+            return;
+        }
+
+        const CppType* values = viewer.column()->get_data().data();
+        if (column->is_nullable()) {
+            const NullColumn::ValueType* value_nulls = viewer.null_column()->get_data().data();
+            for (size_t row = 0; row < size; ++row) {
+                bool selected = branches[row] == branch;
+                data[row] = selected ? values[row] : data[row];
+                nulls[row] = selected ? value_nulls[row] : nulls[row];
+            }
+        } else {
+            for (size_t row = 0; row < size; ++row) {
+                bool selected = branches[row] == branch;
+                data[row] = selected ? values[row] : data[row];
+                nulls[row] = selected ? DATUM_NOT_NULL : nulls[row];
+            }
+        }
+    }
+};
+
+} // namespace starrocks::vectorized
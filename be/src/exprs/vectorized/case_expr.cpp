@@ -2,10 +2,13 @@
 
 #include "exprs/vectorized/case_expr.h"
 
+#include <limits>
+
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
 #include "common/object_pool.h"
+#include "exprs/vectorized/branch_selector.h"
 #include "exprs/vectorized/function_helper.h"
 
 namespace starrocks::vectorized {
@@ -24,6 +27,9 @@ namespace starrocks::vectorized {
  *  ELSE 'other' END
  *
  *  ELSE is not necessary.
+ *
+ *  The rows choose their branch WHEN by WHEN, the rest WHEN aren't evaluated once all the rows have matched, and
+ *  a THEN or ELSE is evaluated only if any row chooses it. The results of the branches are merged by BranchSelector.
  */
 
 template <PrimitiveType WhenType, PrimitiveType ResultType>
@@ -77,32 +83,20 @@ private:
     //   If `CASE` equals `WHEN`, return `THEN`
     //   If `CASE` can't match ANY `WHEN`, return NULL
     ColumnPtr evaluate_case(ExprContext* context, vectorized::Chunk* chunk) {
-        ColumnPtr else_column = nullptr;
-        if (!_has_else_expr) {
-            else_column = ColumnHelper::create_const_null_column(chunk != nullptr ? chunk->num_rows() : 1);
-        } else {
-            else_column = _children[_children.size() - 1]->evaluate(context, chunk);
-        }
-
         ColumnPtr case_column = _children[0]->evaluate(context, chunk);
         if (ColumnHelper::count_nulls(case_column) == case_column->size()) {
-            return else_column->clone();
+            return _evaluate_else(context, chunk)->clone();
         }
 
-        int loop_end = _children.size() - 1;
-
-        Columns when_columns;
-        when_columns.reserve(loop_end);
+        size_t size = case_column->size();
+        std::vector<uint32_t> branches(size, kUnmatched);
+        size_t num_unmatched = size;
 
+        Columns when_columns{case_column};
         Columns then_columns;
-        then_columns.reserve(loop_end);
-
-        std::vector<ColumnViewer<WhenType>> when_viewers;
-        when_viewers.reserve(loop_end);
-
-        std::vector<ColumnViewer<ResultType>> then_viewers;
-        then_viewers.reserve(loop_end);
+        ColumnViewer<WhenType> case_viewer(case_column);
 
+        int loop_end = _children.size() - 1;
         for (int i = 1; i < loop_end; i += 2) {
             ColumnPtr when_column = _children[i]->evaluate(context, chunk);
 
@@ -111,65 +105,34 @@ private:
                 continue;
             }
 
-            ColumnPtr then_column = _children[i + 1]->evaluate(context, chunk);
-
-            when_viewers.emplace_back(when_column);
-            then_viewers.emplace_back(then_column);
+            const uint32_t branch = then_columns.size();
+            ColumnViewer<WhenType> when_viewer(when_column);
+            size_t num_matched = 0;
+            for (size_t row = 0; row < size; ++row) {
+                bool matched = branches[row] == kUnmatched && !case_viewer.is_null(row) && !when_viewer.is_null(row) &&
+                               when_viewer.value(row) == case_viewer.value(row);
+                branches[row] = matched ? branch : branches[row];
+                num_matched += matched;
+            }
 
+            // THEN is evaluated only if any row chooses it.
+            if (num_matched == 0) {
+                continue;
+            }
+            num_unmatched -= num_matched;
             when_columns.emplace_back(when_column);
-            then_columns.emplace_back(then_column);
-        }
+            then_columns.emplace_back(_children[i + 1]->evaluate(context, chunk));
 
-        if (when_viewers.empty()) {
-            return else_column->clone();
-        }
-        when_columns.emplace_back(case_column);
-        then_columns.emplace_back(else_column);
-
-        ColumnViewer<WhenType> case_viewer(case_column);
-        then_viewers.emplace_back(else_column);
-
-        ColumnBuilder<ResultType> builder(this->type().precision, this->type().scale);
-        size_t size = when_columns[0]->size();
-        builder.reserve(size);
-
-        bool columns_has_null = false;
-        for (ColumnPtr& column : when_columns) {
-            columns_has_null |= column->has_null();
-        }
-
-        size_t view_size = when_viewers.size();
-        if (!columns_has_null) {
-            for (int row = 0; row < size; ++row) {
-                int i = 0;
-                while ((i < view_size) && (when_viewers[i].value(row) != case_viewer.value(row))) {
-                    i += 1;
-                }
-                if (!then_viewers[i].is_null(row)) {
-                    builder.append(then_viewers[i].value(row));
-                } else {
-                    builder.append_null();
-                }
-            }
-        } else {
-            for (int row = 0; row < size; ++row) {
-                int i = view_size;
-                if (!case_viewer.is_null(row)) {
-                    i = 0;
-                    while ((i < view_size) &&
-                           (when_viewers[i].is_null(row) || when_viewers[i].value(row) != case_viewer.value(row))) {
-                        i += 1;
-                    }
-                }
-                if (!then_viewers[i].is_null(row)) {
-                    builder.append(then_viewers[i].value(row));
-                } else {
-                    builder.append_null();
-                }
+            // the rest WHEN aren't evaluated if all the rows have matched.
+            if (num_unmatched == 0) {
+                break;
             }
         }
 
-        return builder.build(ColumnHelper::is_all_const(when_columns) && ColumnHelper::is_all_const(then_columns));
+        if (then_columns.empty()) {
+            return _evaluate_else(context, chunk)->clone();
+        }
+        return _select(context, chunk, num_unmatched, when_columns, &then_columns, &branches);
     }
 
     // CASE 1:
@@ -189,30 +152,15 @@ private:
     //  If all `WHEN` is null/false, return NULL
     //  If `WHEN` is not null and true, return `THEN`
     ColumnPtr evaluate_no_case(ExprContext* context, vectorized::Chunk* chunk) {
-        ColumnPtr else_column = nullptr;
-        if (!_has_else_expr) {
-            else_column = ColumnHelper::create_const_null_column(chunk != nullptr ? chunk->num_rows() : 1);
-        } else {
-            else_column = _children[_children.size() - 1]->evaluate(context, chunk);
-        }
-
-        int loop_end = _children.size() - 1;
+        std::vector<uint32_t> branches;
+        size_t num_unmatched = 0;
 
         Columns when_columns;
-        when_columns.reserve(loop_end);
-
         Columns then_columns;
-        then_columns.reserve(loop_end);
-
-        std::vector<ColumnViewer<TYPE_BOOLEAN>> when_viewers;
-        when_viewers.reserve(loop_end);
-
-        std::vector<ColumnViewer<ResultType>> then_viewers;
-        then_viewers.reserve(loop_end);
 
+        int loop_end = _children.size() - 1;
         for (int i = 0; i < loop_end; i += 2) {
             ColumnPtr when_column = _children[i]->evaluate(context, chunk);
-
             size_t trues_count = ColumnHelper::count_true_with_notnull(when_column);
 
             // skip if all false or all null
@@ -220,67 +168,73 @@ private:
                 continue;
             }
 
-            ColumnPtr then_column = _children[i + 1]->evaluate(context, chunk);
-
             // direct return if first when is all true
-            if (when_viewers.empty() && trues_count == when_column->size()) {
-                return then_column->clone();
+            if (then_columns.empty() && trues_count == when_column->size()) {
+                return _children[i + 1]->evaluate(context, chunk)->clone();
+            }
+
+            if (then_columns.empty()) {
+                branches.assign(when_column->size(), kUnmatched);
+                num_unmatched = when_column->size();
             }
 
+            const uint32_t branch = then_columns.size();
+            ColumnViewer<TYPE_BOOLEAN> when_viewer(when_column);
+            size_t size = branches.size();
+            size_t num_matched = 0;
+            for (size_t row = 0; row < size; ++row) {
+                bool matched = (branches[row] == kUnmatched) & !when_viewer.is_null(row) & when_viewer.value(row);
+                branches[row] = matched ? branch : branches[row];
+                num_matched += matched;
+            }
+
+            // THEN is evaluated only if any row chooses it.
+            if (num_matched == 0) {
+                continue;
+            }
+            num_unmatched -= num_matched;
             when_columns.emplace_back(when_column);
-            then_columns.emplace_back(then_column);
+            then_columns.emplace_back(_children[i + 1]->evaluate(context, chunk));
 
-            when_viewers.emplace_back(when_column);
-            then_viewers.emplace_back(then_column);
+            // the rest WHEN aren't evaluated if all the rows have matched.
+            if (num_unmatched == 0) {
+                break;
+            }
         }
 
-        if (when_viewers.empty()) {
-            return else_column->clone();
+        if (then_columns.empty()) {
+            return _evaluate_else(context, chunk)->clone();
         }
-        then_columns.emplace_back(else_column);
-        then_viewers.emplace_back(else_column);
-
-        ColumnBuilder<ResultType> builder(this->type().precision, this->type().scale);
-        size_t size = when_columns[0]->size();
-        builder.reserve(size);
+        return _select(context, chunk, num_unmatched, when_columns, &then_columns, &branches);
+    }
 
-        bool columns_has_null = false;
-        for (ColumnPtr& column : when_columns) {
-            columns_has_null |= column->has_null();
+    ColumnPtr _evaluate_else(ExprContext* context, vectorized::Chunk* chunk) {
+        if (!_has_else_expr) {
+            return ColumnHelper::create_const_null_column(chunk != nullptr ? chunk->num_rows() : 1);
         }
+        return _children[_children.size() - 1]->evaluate(context, chunk);
+    }
 
-        size_t view_size = when_viewers.size();
-        if (!columns_has_null) {
-            for (int row = 0; row < size; ++row) {
-                int i = 0;
-                while (i < view_size && !(when_viewers[i].value(row))) {
-                    i += 1;
-                }
-                if (!then_viewers[i].is_null(row)) {
-                    builder.append(then_viewers[i].value(row));
-                } else {
-                    builder.append_null();
-                }
-            }
-        } else {
-            for (int row = 0; row < size; ++row) {
-                int i = 0;
-                while ((i < view_size) && (when_viewers[i].is_null(row) || !when_viewers[i].value(row))) {
-                    i += 1;
-                }
-
-                if (!then_viewers[i].is_null(row)) {
-                    builder.append(then_viewers[i].value(row));
-                } else {
-                    builder.append_null();
-                }
+    // Merge the results of THEN, by the index of THEN chosen by every row in |branches|, and ELSE for the rows
+    // choosing none, the latter evaluated only if there are such rows.
+    ColumnPtr _select(ExprContext* context, vectorized::Chunk* chunk, size_t num_unmatched,
+                      const Columns& when_columns, Columns* then_columns, std::vector<uint32_t>* branches) {
+        if (num_unmatched > 0) {
+            then_columns->emplace_back(_evaluate_else(context, chunk));
+            const uint32_t else_branch = then_columns->size() - 1;
+            for (uint32_t& branch : *branches) {
+                branch = std::min(branch, else_branch);
             }
         }
-
-        return builder.build(ColumnHelper::is_all_const(when_columns) && ColumnHelper::is_all_const(then_columns));
+        bool is_const = ColumnHelper::is_all_const(when_columns) && ColumnHelper::is_all_const(*then_columns);
+        return BranchSelector<ResultType>::select(*then_columns, *branches, this->type().precision,
+                                                  this->type().scale, is_const);
     }
 
 private:
+    // The branch of the rows which match no WHEN yet.
+    static constexpr uint32_t kUnmatched = std::numeric_limits<uint32_t>::max();
+
     const bool _has_case_expr;
     const bool _has_else_expr;
 };
@@ -156,8 +156,153 @@ DEFINE_UNARY_FN_WITH_IMPL(TimestampToNumber, value) {
     return value.to_timestamp_literal();
 }
 
+// The bytes of a little-endian word which are all the ascii digits.
+static constexpr uint64_t kAsciiZeros = 0x3030303030303030ULL;
+
+// Whether all the 8 bytes of |word| are the ascii digits, checking them at once, without a branch per byte.
+static inline bool is_eight_digits(uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0ULL) | (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+           0x3333333333333333ULL;
+}
+
+// The number of the 8 ascii digits in |word|, whose first digit is in the lowest byte.
+static inline uint32_t parse_eight_digits(uint64_t word) {
+    word -= kAsciiZeros;
+    word = (word * 10) + (word >> 8);
+    word = (((word & 0x000000FF000000FFULL) * 0x000F424000000064ULL) +
+            (((word >> 16) & 0x000000FF000000FFULL) * 0x0000271000000001ULL)) >>
+           32;
+    return static_cast<uint32_t>(word);
+}
+
+// Parse the integer of at most |MaxDigits| digits, with an optional sign and nothing else, e.g. no spaces, which is
+// the most common form of the integer strings, 8 digits at a time. Return false for any other form, to be parsed by
+// StringParser, which handles the spaces and reports the overflows.
+template <typename T, int MaxDigits = std::min(std::numeric_limits<T>::digits10, 18)>
+static inline bool string_to_int_fast(const char* s, size_t len, T* res) {
+    bool negative = false;
+    if (len > 0 && (s[0] == '-' || s[0] == '+')) {
+        negative = s[0] == '-';
+        ++s;
+        --len;
+    }
+    if (len == 0 || len > MaxDigits) {
+        return false;
+    }
+
+    uint64_t value = 0;
+    // the leading digits are padded by the zeros on the left to a full word
+    size_t head = len % 8 == 0 ? 8 : len % 8;
+    uint64_t word = kAsciiZeros;
+    memcpy(reinterpret_cast<char*>(&word) + 8 - head, s, head);
+    if (!is_eight_digits(word)) {
+        return false;
+    }
+    value = parse_eight_digits(word);
+    for (size_t i = head; i < len; i += 8) {
+        memcpy(&word, s + i, 8);
+        if (!is_eight_digits(word)) {
+            return false;
+        }
+        value = value * 100000000 + parse_eight_digits(word);
+    }
+    *res = negative ? -static_cast<T>(value) : static_cast<T>(value);
+    return true;
+}
+
+// Parse the date of the exact layout "YYYY-MM-DD", whose separators are replaced by zeros to check all the digits of
+// the year and the month at once. Return false for any other layout, which is left to DateValue::from_string.
+static inline bool string_to_date_fast(const char* s, int* year, int* month, int* day) {
+    constexpr uint64_t kSeparatorMask = 0xFF0000FF00000000ULL;
+    constexpr uint64_t kSeparators = 0x2D00002D00000000ULL;
+    uint64_t word;
+    memcpy(&word, s, 8);
+    if ((word & kSeparatorMask) != kSeparators) {
+        return false;
+    }
+    word = (word & ~kSeparatorMask) | (kAsciiZeros & kSeparatorMask);
+    if (!is_eight_digits(word) || !isdigit(s[8]) || !isdigit(s[9])) {
+        return false;
+    }
+    uint32_t year_month = parse_eight_digits(word);
+    // YYYY0MM0
+    *year = year_month / 10000;
+    *month = year_month / 10 % 100;
+    *day = (s[8] - '0') * 10 + (s[9] - '0');
+    return true;
+}
+
+// Parse the time of the exact layout "HH:MM:SS", like string_to_date_fast.
+static inline bool string_to_time_fast(const char* s, int* hour, int* minute, int* second) {
+    constexpr uint64_t kSeparatorMask = 0x0000FF0000FF0000ULL;
+    constexpr uint64_t kSeparators = 0x00003A00003A0000ULL;
+    uint64_t word;
+    memcpy(&word, s, 8);
+    if ((word & kSeparatorMask) != kSeparators) {
+        return false;
+    }
+    word = (word & ~kSeparatorMask) | (kAsciiZeros & kSeparatorMask);
+    if (!is_eight_digits(word)) {
+        return false;
+    }
+    // HH0MM0SS
+    uint32_t time = parse_eight_digits(word);
+    *hour = time / 1000000;
+    *minute = time / 1000 % 100;
+    *second = time % 100;
+    return true;
+}
+
+// Cast the non-constant string |column| by |parse|, which returns whether the value is parsed into its output, and
+// the values failed to parse are null. The values and the null flags are written into the columns in place, rather
+// than appended row by row.
+template <PrimitiveType ToType, typename ParseFunc>
+ColumnPtr cast_from_string_in_batch(const ColumnPtr& column, ParseFunc&& parse) {
+    DCHECK(!column->is_constant());
+    const BinaryColumn* values = nullptr;
+    const uint8_t* value_nulls = nullptr;
+    if (column->is_nullable()) {
+        const auto* nullable_column = down_cast<const NullableColumn*>(column.get());
+        values = down_cast<const BinaryColumn*>(nullable_column->data_column().get());
+        value_nulls = nullable_column->null_column()->get_data().data();
+    } else {
+        values = down_cast<const BinaryColumn*>(column.get());
+    }
+
+    size_t num_rows = values->size();
+    auto result = RunTimeColumnType<ToType>::create(num_rows);
+    auto nulls = NullColumn::create(num_rows, 0);
+    auto* data = result->get_data().data();
+    uint8_t* null_data = nulls->get_data().data();
+    uint8_t has_null = 0;
+    for (size_t row = 0; row < num_rows; ++row) {
+        if (value_nulls != nullptr && value_nulls[row]) {
+            null_data[row] = 1;
+        } else {
+            null_data[row] = !parse(values->get_slice(row), &data[row]);
+        }
+        has_null |= null_data[row];
+    }
+
+    if (has_null) {
+        return NullableColumn::create(result, nulls);
+    }
+    return result;
+}
+
 template <PrimitiveType FromType, PrimitiveType ToType>
 ColumnPtr cast_int_from_string_fn(ColumnPtr& column) {
+    if (!column->is_constant()) {
+        return cast_from_string_in_batch<ToType>(column, [](const Slice& value, RunTimeCppType<ToType>* r) {
+            if (string_to_int_fast(value.data, value.size, r)) {
+                return true;
+            }
+            StringParser::ParseResult result;
+            *r = StringParser::string_to_int<RunTimeCppType<ToType>>(value.data, value.size, &result);
+            return result == StringParser::PARSE_SUCCESS;
+        });
+    }
+
     ColumnBuilder<ToType> builder;
     ColumnViewer<TYPE_VARCHAR> viewer(column);
 
@@ -182,6 +327,23 @@ ColumnPtr cast_int_from_string_fn(ColumnPtr& column) {
 
 template <PrimitiveType FromType, PrimitiveType ToType>
 ColumnPtr cast_float_from_string_fn(ColumnPtr& column) {
+    if (!column->is_constant()) {
+        return cast_from_string_in_batch<ToType>(column, [](const Slice& value, RunTimeCppType<ToType>* r) {
+            // The integers of at most digits10 digits are exact in the floating type, as StringParser parses them.
+            using FloatType = RunTimeCppType<ToType>;
+            int64_t int_value;
+            if (string_to_int_fast<int64_t, std::numeric_limits<FloatType>::digits10>(value.data, value.size,
+                                                                                       &int_value)) {
+                // "-0" is parsed into -0.0
+                *r = int_value == 0 && value.data[0] == '-' ? -0.0 : static_cast<FloatType>(int_value);
+                return true;
+            }
+            StringParser::ParseResult result;
+            *r = StringParser::string_to_float<FloatType>(value.data, value.size, &result);
+            return result == StringParser::PARSE_SUCCESS && !std::isnan(*r) && !std::isinf(*r);
+        });
+    }
+
     ColumnBuilder<ToType> builder;
     ColumnViewer<TYPE_VARCHAR> viewer(column);
 
@@ -424,6 +586,18 @@ UNARY_FN_CAST(TYPE_DATETIME, TYPE_DATE, TimestampToDate);
 
 template <>
 ColumnPtr cast_fn<TYPE_VARCHAR, TYPE_DATE>(ColumnPtr& column) {
+    if (!column->is_constant()) {
+        return cast_from_string_in_batch<TYPE_DATE>(column, [](const Slice& value, DateValue* v) {
+            int year, month, day;
+            if (value.size == 10 && string_to_date_fast(value.data, &year, &month, &day) &&
+                date::check(year, month, day)) {
+                v->from_date(year, month, day);
+                return true;
+            }
+            return v->from_string(value.data, value.size);
+        });
+    }
+
     ColumnBuilder<TYPE_DATE> builder;
     ColumnViewer<TYPE_VARCHAR> viewer(column);
 
@@ -494,6 +668,21 @@ UNARY_FN_CAST(TYPE_DATE, TYPE_DATETIME, DateToTimestmap);
 
 template <>
 ColumnPtr cast_fn<TYPE_VARCHAR, TYPE_DATETIME>(ColumnPtr& column) {
+    if (!column->is_constant()) {
+        return cast_from_string_in_batch<TYPE_DATETIME>(column, [](const Slice& value, TimestampValue* v) {
+            int year, month, day;
+            int hour = 0, minute = 0, second = 0;
+            if ((value.size == 10 || (value.size == 19 && value.data[10] == ' ')) &&
+                string_to_date_fast(value.data, &year, &month, &day) &&
+                (value.size == 10 || string_to_time_fast(value.data + 11, &hour, &minute, &second)) &&
+                timestamp::check(year, month, day, hour, minute, second, 0)) {
+                v->from_timestamp(year, month, day, hour, minute, second, 0);
+                return true;
+            }
+            return v->from_string(value.data, value.size);
+        });
+    }
+
     ColumnBuilder<TYPE_DATETIME> builder;
     ColumnViewer<TYPE_VARCHAR> viewer(column);
 
@@ -5,6 +5,8 @@
 #include "common/object_pool.h"
 #include "exprs/predicate.h"
 #include "exprs/vectorized/binary_function.h"
+#include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/like_predicate.h"
 #include "exprs/vectorized/unary_function.h"
 
 namespace starrocks {
@@ -38,10 +40,16 @@ public:
 
         // left all false and not null
         if (l_falses == l->size()) {
-            return l->clone();
+            return l.use_count() == 1 ? l : l->clone();
         }
 
         auto r = _children[1]->evaluate(context, ptr);
+        // Without nulls, the results are written into the column of either child, if it's a temporary one.
+        if (!l->is_nullable() && !r->is_nullable()) {
+            if (auto result = InPlaceBinaryFunction<AndImpl>::evaluate<TYPE_BOOLEAN>(l, r); result != nullptr) {
+                return result;
+            }
+        }
 
         return VectorizedLogicPredicateBinaryFunction<AndNullImpl, AndImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
@@ -61,22 +69,137 @@ DEFINE_BINARY_FUNCTION_WITH_IMPL(OrImpl, l_value, r_value) {
     return l_value | r_value;
 }
 
+// The ORed LIKEs of the same column, with constant patterns, are merged into one set of patterns, if there are at
+// least this many of them, so the values are matched against all the patterns in one pass.
+static constexpr size_t kMinMergedLikePatterns = 3;
+
 class VectorizedOrCompoundPredicate final : public Predicate {
 public:
     DEFINE_COMPOUND_CONSTRUCT(VectorizedOrCompoundPredicate);
+    // The copy has its own children, so the LIKEs are merged again when it's prepared.
+    VectorizedOrCompoundPredicate(const VectorizedOrCompoundPredicate& rhs) : Predicate(rhs) {}
+
+    Status prepare(RuntimeState* state, const RowDescriptor& row_desc, ExprContext* context) override {
+        // The nested ORs are merged by the outermost one, which is prepared first.
+        if (!_is_nested && _like_pattern_set == nullptr) {
+            _merge_like_children();
+        }
+        return Predicate::prepare(state, row_desc, context);
+    }
+
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override {
+        if (_like_pattern_set != nullptr) {
+            return _evaluate_merged(context, ptr);
+        }
+
         auto l = _children[0]->evaluate(context, ptr);
 
         int l_trues = ColumnHelper::count_true_with_notnull(l);
         // left all true and not null
         if (l_trues == l->size()) {
-            return l->clone();
+            return l.use_count() == 1 ? l : l->clone();
         }
 
         auto r = _children[1]->evaluate(context, ptr);
+        if (!l->is_nullable() && !r->is_nullable()) {
+            if (auto result = InPlaceBinaryFunction<OrImpl>::evaluate<TYPE_BOOLEAN>(l, r); result != nullptr) {
+                return result;
+            }
+        }
 
         return VectorizedLogicPredicateBinaryFunction<OrNullImpl, OrImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
+
+private:
+    void _collect_or_children(Expr* expr, std::vector<Expr*>* children) {
+        auto* pred = dynamic_cast<VectorizedOrCompoundPredicate*>(expr);
+        if (pred == nullptr) {
+            children->emplace_back(expr);
+            return;
+        }
+        if (pred != this) {
+            pred->_is_nested = true;
+        }
+        for (Expr* child : pred->_children) {
+            _collect_or_children(child, children);
+        }
+    }
+
+    // The column ref of |expr| if it's a LIKE of the column with a constant pattern, whose value is put in |pattern|.
+    static ColumnRef* _as_constant_like(Expr* expr, std::string* pattern) {
+        if (expr->node_type() != TExprNodeType::FUNCTION_CALL || !expr->fn().__isset.fid ||
+            expr->get_num_children() != 2) {
+            return nullptr;
+        }
+        const FunctionDescriptor* fn_desc = BuiltinFunctions::find_builtin_function(expr->fn().fid);
+        if (fn_desc == nullptr || fn_desc->scalar_function != &LikePredicate::like) {
+            return nullptr;
+        }
+        auto* column_ref = dynamic_cast<ColumnRef*>(expr->get_child(0));
+        if (column_ref == nullptr || expr->get_child(1)->node_type() != TExprNodeType::STRING_LITERAL) {
+            return nullptr;
+        }
+        ColumnPtr value = expr->get_child(1)->evaluate(nullptr, nullptr);
+        if (value->only_null() || value->is_null(0)) {
+            return nullptr;
+        }
+        *pattern = ColumnHelper::get_const_value<TYPE_VARCHAR>(value).to_string();
+        return column_ref;
+    }
+
+    void _merge_like_children() {
+        std::vector<Expr*> children;
+        _collect_or_children(this, &children);
+
+        ColumnRef* column = nullptr;
+        std::vector<std::string> patterns;
+        std::vector<Expr*> unmerged_children;
+        for (Expr* child : children) {
+            std::string pattern;
+            ColumnRef* column_ref = _as_constant_like(child, &pattern);
+            if (column_ref != nullptr && (column == nullptr || column->slot_id() == column_ref->slot_id())) {
+                column = column_ref;
+                patterns.emplace_back(std::move(pattern));
+            } else {
+                unmerged_children.emplace_back(child);
+            }
+        }
+        if (patterns.size() < kMinMergedLikePatterns) {
+            return;
+        }
+
+        std::unique_ptr<re2::RE2::Set> pattern_set;
+        Status st = LikePredicate::compile_like_pattern_set(patterns, &pattern_set);
+        if (!st.ok()) {
+            // The LIKEs are evaluated one by one, which reports the error of its pattern as before.
+            LOG(WARNING) << "Failed to merge the ORed like predicates: " << st.to_string();
+            return;
+        }
+        _like_column = column;
+        _like_pattern_set = std::move(pattern_set);
+        _unmerged_children = std::move(unmerged_children);
+    }
+
+    ColumnPtr _evaluate_merged(ExprContext* context, vectorized::Chunk* ptr) {
+        ColumnPtr result =
+                LikePredicate::match_like_pattern_set(*_like_pattern_set, _like_column->evaluate(context, ptr));
+        for (Expr* child : _unmerged_children) {
+            if (ColumnHelper::count_true_with_notnull(result) == result->size()) {
+                break;
+            }
+            auto r = child->evaluate(context, ptr);
+            result = VectorizedLogicPredicateBinaryFunction<OrNullImpl, OrImpl>::template evaluate<TYPE_BOOLEAN>(
+                    result, r);
+        }
+        return result;
+    }
+
+    // Whether this is a child of another OR, which evaluates it in its own way if the LIKEs are merged.
+    bool _is_nested = false;
+    // Built in prepare and read-only after that, so it's shared by all the contexts of the expr.
+    std::unique_ptr<re2::RE2::Set> _like_pattern_set;
+    ColumnRef* _like_column = nullptr;
+    std::vector<Expr*> _unmerged_children;
 };
 
 DEFINE_UNARY_FN_WITH_IMPL(CompoundPredNot, l) {
@@ -6,6 +6,7 @@
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
 #include "common/object_pool.h"
+#include "exprs/vectorized/branch_selector.h"
 #include "exprs/vectorized/function_helper.h"
 
 namespace starrocks {
@@ -106,60 +107,32 @@ public:
         auto bhs = _children[0]->evaluate(context, ptr);
         int true_count = ColumnHelper::count_true_with_notnull(bhs);
 
-        auto lhs = _children[1]->evaluate(context, ptr);
+        // Only the branches chosen by any row are evaluated.
         if (true_count == bhs->size()) {
-            return lhs->clone();
+            return _children[1]->evaluate(context, ptr)->clone();
         }
-
-        auto rhs = _children[2]->evaluate(context, ptr);
         if (true_count == 0) {
-            return rhs->clone();
+            return _children[2]->evaluate(context, ptr)->clone();
         }
 
+        auto lhs = _children[1]->evaluate(context, ptr);
+        auto rhs = _children[2]->evaluate(context, ptr);
         if (lhs->only_null() && rhs->only_null()) {
             return lhs->clone();
         }
 
         Columns list = {bhs, lhs, rhs};
-        ColumnBuilder<Type> result(this->type().precision, this->type().scale);
-
-        auto bhs_nulls = ColumnHelper::count_nulls(bhs);
-        auto lhs_nulls = ColumnHelper::count_nulls(lhs);
-        auto rhs_nulls = ColumnHelper::count_nulls(rhs);
-
         ColumnViewer<TYPE_BOOLEAN> bhs_viewer(bhs);
-        ColumnViewer<Type> lhs_viewer(lhs);
-        ColumnViewer<Type> rhs_viewer(rhs);
-        size_t size = list[0]->size();
+        size_t size = bhs->size();
 
-        // optimization for 3 columns all not null.
-        if (bhs_nulls == 0 && lhs_nulls == 0 && rhs_nulls == 0) {
-            for (int row = 0; row < size; ++row) {
-                if (!bhs_viewer.value(row)) {
-                    result.append(rhs_viewer.value(row));
-                } else {
-                    result.append(lhs_viewer.value(row));
-                }
-            }
-        } else {
-            for (int row = 0; row < size; ++row) {
-                if (bhs_viewer.is_null(row) || !bhs_viewer.value(row)) {
-                    if (rhs_viewer.is_null(row)) {
-                        result.append_null();
-                    } else {
-                        result.append(rhs_viewer.value(row));
-                    }
-                } else {
-                    if (lhs_viewer.is_null(row)) {
-                        result.append_null();
-                    } else {
-                        result.append(lhs_viewer.value(row));
-                    }
-                }
-            }
+        // 0 for lhs, 1 for rhs.
+        std::vector<uint32_t> branches(size);
+        for (size_t row = 0; row < size; ++row) {
+            branches[row] = bhs_viewer.is_null(row) | !bhs_viewer.value(row);
         }
 
-        return result.build(ColumnHelper::is_all_const(list));
+        return BranchSelector<Type>::select({lhs, rhs}, branches, this->type().precision, this->type().scale,
+                                            ColumnHelper::is_all_const(list));
     }
 };
 
@@ -39,6 +39,7 @@ struct DecimalBinaryFunction {
         [[maybe_unused]] RhsCppType rhs_datum;
         [[maybe_unused]] const auto scale_factor = get_scale_factor<LhsCppType>(adjust_scale);
         [[maybe_unused]] auto overflow = false;
+        [[maybe_unused]] bool row_overflow = false;
 
         // if lhs is a const column and needs to adjust, adjust lhs outside of loop.
         if constexpr (lhs_is_const) {
@@ -77,12 +78,15 @@ struct DecimalBinaryFunction {
                                                                          scale_factor);
             }
             if constexpr (check_overflow) {
-                if (overflow) {
-                    *has_null = true;
-                    nulls[i] = DATUM_NULL;
-                }
+                // mark the overflows without a branch, so the loop is vectorized for the 32-bit and 64-bit decimals,
+                // whose overflows are detected by the sign bits.
+                nulls[i] = overflow;
+                row_overflow |= overflow;
             }
         }
+        if constexpr (check_overflow) {
+            *has_null |= row_overflow;
+        }
         return false;
     }
 
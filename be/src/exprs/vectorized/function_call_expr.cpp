@@ -5,8 +5,10 @@
 #include "column/column_helper.h"
 #include "column/const_column.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
 #include "exprs/anyval_util.h"
 #include "exprs/vectorized/builtin_functions.h"
+#include "exprs/vectorized/function_helper.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/user_function_cache.h"
 
@@ -88,6 +90,8 @@ Status VectorizedFunctionCallExpr::open(starrocks::RuntimeState* state, starrock
     } else {
         _is_rand_function = false;
     }
+    const std::string& name = _fn.name.function_name;
+    _is_deterministic = !_is_rand_function && name != "uuid" && name != "uuid_numeric" && name != "sleep";
 
     return Status::OK();
 }
@@ -121,7 +125,8 @@ ColumnPtr VectorizedFunctionCallExpr::evaluate(starrocks::ExprContext* context,
     args.reserve(_children.size());
     for (Expr* child : _children) {
         ColumnPtr column = context->evaluate(child, ptr);
-        args.emplace_back(column);
+        // The functions take the nullable column without null as its data column, to skip the null flags.
+        args.emplace_back(FunctionHelper::get_data_column_if_no_null(column));
     }
 
     if (_is_rand_function) {
@@ -142,6 +147,11 @@ ColumnPtr VectorizedFunctionCallExpr::evaluate(starrocks::ExprContext* context,
     }
 #endif
 
+    if (_is_deterministic && ptr != nullptr && ptr->num_rows() > 1 && !args.empty() &&
+        ColumnHelper::is_all_const(args)) {
+        return _evaluate_on_const_args(fn_ctx, args, ptr->num_rows());
+    }
+
     ColumnPtr result = _fn_desc->scalar_function(fn_ctx, args);
     // For no args function call (pi, e)
     if (result->is_constant() && ptr != nullptr) {
@@ -150,4 +160,26 @@ ColumnPtr VectorizedFunctionCallExpr::evaluate(starrocks::ExprContext* context,
     return result;
 }
 
+ColumnPtr VectorizedFunctionCallExpr::_evaluate_on_const_args(FunctionContext* fn_ctx, const Columns& args,
+                                                              size_t num_rows) {
+    Columns one_row_args;
+    one_row_args.reserve(args.size());
+    for (const ColumnPtr& arg : args) {
+        one_row_args.emplace_back(ConstColumn::create(down_cast<ConstColumn*>(arg.get())->data_column(), 1));
+    }
+
+    ColumnPtr result = _fn_desc->scalar_function(fn_ctx, one_row_args);
+    if (result->is_null(0)) {
+        return ColumnHelper::create_const_null_column(num_rows);
+    }
+    if (result->is_constant()) {
+        result->resize(num_rows);
+        return result;
+    }
+    if (result->is_nullable()) {
+        return ConstColumn::create(down_cast<NullableColumn*>(result.get())->data_column(), num_rows);
+    }
+    return ConstColumn::create(result, num_rows);
+}
+
 } // namespace starrocks::vectorized
@@ -29,10 +29,17 @@ protected:
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override;
 
 private:
+    // Evaluate the function on a row of the const |args|, and return it as a const column of |num_rows| rows.
+    ColumnPtr _evaluate_on_const_args(FunctionContext* fn_ctx, const Columns& args, size_t num_rows);
+
     const FunctionDescriptor* _fn_desc;
 
     // is rand/random function.
     bool _is_rand_function = false;
+
+    // Whether the function returns the same result for the same arguments, so it's evaluated once if all the
+    // arguments are const, instead of on every row.
+    bool _is_deterministic = true;
 };
 
 } // namespace vectorized
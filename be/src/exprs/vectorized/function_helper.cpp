@@ -14,11 +14,12 @@ NullColumnPtr FunctionHelper::union_nullable_column(const ColumnPtr& v1, const C
     if (v1->is_nullable() && v2->is_nullable()) {
         const auto& n1 = ColumnHelper::as_raw_column<NullableColumn>(v1)->null_column();
         const auto& n2 = ColumnHelper::as_raw_column<NullableColumn>(v2)->null_column();
+        // only the null flags of the other one are needed.
         if (!v1->has_null()) {
-            result = std::move(n2->clone());
+            return ColumnHelper::as_column<NullColumn>(n2->clone_shared());
         }
         if (!v2->has_null()) {
-            result = std::move(n1->clone());
+            return ColumnHelper::as_column<NullColumn>(n1->clone_shared());
         }
         return union_null_column(n1, n2);
     } else if (v1->is_nullable()) {
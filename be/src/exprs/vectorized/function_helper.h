@@ -24,6 +24,19 @@ public:
         return ptr;
     }
 
+    /**
+     * if ptr is not const NullableColumn without null, return data column, so the kernels needn't read
+     * and merge the null flags, which are all zeros
+     * else return ptr
+     * @param ptr
+     */
+    static inline const ColumnPtr& get_data_column_if_no_null(const ColumnPtr& ptr) {
+        if (ptr->is_nullable() && !ptr->is_constant() && !ptr->has_null()) {
+            return down_cast<NullableColumn*>(ptr.get())->data_column();
+        }
+        return ptr;
+    }
+
     /**
      * if v1 is NullableColumn and v2 is NullableColumn, union
      * if v1 is NullableColumn and v2 is not NullableColumn, return v1.nullColumn
@@ -5,6 +5,7 @@
 #include "column/column_builder.h"
 #include "column/column_viewer.h"
 #include "column/object_column.h"
+#include "exprs/vectorized/hash_functions.h"
 #include "exprs/vectorized/unary_function.h"
 
 namespace starrocks {
@@ -33,20 +34,19 @@ ColumnPtr HyperloglogFunction::hll_cardinality(FunctionContext* context,
 
 // hll_hash
 ColumnPtr HyperloglogFunction::hll_hash(FunctionContext* context, const Columns& columns) {
-    ColumnViewer<TYPE_VARCHAR> str_viewer(columns[0]);
+    size_t size = columns[0]->size();
+    std::vector<uint64_t> hashes(size);
+    std::vector<NullColumn::ValueType> nulls(size, DATUM_NOT_NULL);
+    HashFunctions::murmur_hash64A(*columns[0], size, hashes.data(), nulls.data());
 
     auto hll_column = HyperLogLogColumn::create();
-
-    size_t size = columns[0]->size();
-    for (int row = 0; row < size; ++row) {
-        HyperLogLog hll;
-        if (!str_viewer.is_null(row)) {
-            Slice s = str_viewer.value(row);
-            uint64_t hash = HashUtil::murmur_hash64A(s.data, s.size, HashUtil::MURMUR_SEED);
-            hll.update(hash);
+    hll_column->reserve(size);
+    for (size_t row = 0; row < size; ++row) {
+        if (nulls[row]) {
+            hll_column->append_default();
+        } else {
+            hll_column->append(HyperLogLog(hashes[row]));
         }
-
-        hll_column->append(&hll);
     }
 
     if (ColumnHelper::is_all_const(columns)) {
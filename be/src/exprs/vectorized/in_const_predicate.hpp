@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "column/array_set.h"
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
@@ -32,6 +33,10 @@ using PHashSetType = typename PHashSet<Type>::PType;
  *
  *  Not support:
  *  a in (column1, 'a', column3), a in (select * from ....)...
+ *
+ *  The values of fixed length type are also put in an ArraySet while there are at most kMaxArraySetSize of them,
+ *  which is looked up by SIMD compares instead of hashing. For the strings, the hash set stores their hashes, and
+ *  the values out of the length range of the set are rejected before hashing.
  */
 template <PrimitiveType Type>
 class VectorizedInConstPredicate final : public Predicate {
@@ -56,6 +61,7 @@ public:
             return Status::OK();
         }
         _hash_set.clear();
+        _array_set.clear();
         _is_prepare = true;
         return Status::OK();
     }
@@ -77,6 +83,7 @@ public:
         }
 
         _hash_set.clear();
+        _array_set.clear();
         _is_prepare = true;
         return Status::OK();
     }
@@ -112,19 +119,18 @@ public:
             }
 
             // insert into set
-            if constexpr (isSlicePT<Type>) {
-                if (_hash_set.emplace(viewer.value(0)).second) {
+            if (_insert_value(viewer.value(0))) {
+                if constexpr (isSlicePT<Type>) {
                     _string_values.emplace_back(value);
                 }
-            } else {
-                _hash_set.emplace(viewer.value(0));
             }
         }
 
         return Status::OK();
     }
 
-    ColumnPtr eval_on_chunk_both_column_and_set_not_has_null(const ColumnPtr& lhs) {
+    template <typename Set>
+    ColumnPtr eval_on_chunk_both_column_and_set_not_has_null(const ColumnPtr& lhs, const Set& set) {
         DCHECK(!_null_in_set);
 
         const bool yes_value = !_is_not_in;
@@ -145,7 +151,7 @@ public:
 
         if (!lhs->is_constant()) {
             for (int row = 0; row < size; ++row) {
-                if (_hash_set.contains(data[row])) {
+                if (_contains(set, data[row])) {
                     data3[row] = yes_value;
                 } else {
                     data3[row] = no_value;
@@ -153,7 +159,7 @@ public:
             }
         } else {
             if (size > 0) {
-                bool value = _hash_set.contains(data[0]) ? yes_value : no_value;
+                bool value = _contains(set, data[0]) ? yes_value : no_value;
                 data3[0] = value;
                 for (int row = 1; row < size; ++row) {
                     data3[row] = value;
@@ -166,8 +172,8 @@ public:
 
     // null_in_set: true means null is a value of _hash_set.
     // equal_null: true means that 'null' in column and 'null' in set is equal.
-    template <bool null_in_set, bool equal_null>
-    ColumnPtr eval_on_chunk(const ColumnPtr& lhs) {
+    template <bool null_in_set, bool equal_null, typename Set>
+    ColumnPtr eval_on_chunk(const ColumnPtr& lhs, const Set& set) {
         ColumnBuilder<TYPE_BOOLEAN> builder;
         ColumnViewer<Type> viewer(lhs);
 
@@ -183,7 +189,7 @@ public:
                 continue;
             }
             // find value
-            if (_hash_set.contains(viewer.value(row))) {
+            if (_contains(set, viewer.value(row))) {
                 builder.append(yes_value);
                 continue;
             }
@@ -203,24 +209,19 @@ public:
             return ColumnHelper::create_const_null_column(lhs->size());
         }
 
-        if (_null_in_set) {
-            if (_eq_null) {
-                return this->template eval_on_chunk<true, true>(lhs);
-            } else {
-                return this->template eval_on_chunk<true, false>(lhs);
+        if constexpr (!isSlicePT<Type>) {
+            if (!_array_set.empty() && _hash_set.size() <= kMaxArraySetSize) {
+                return _evaluate(lhs, _array_set);
             }
-        } else if (lhs->is_nullable()) {
-            return this->template eval_on_chunk<false, false>(lhs);
-        } else {
-            return eval_on_chunk_both_column_and_set_not_has_null(lhs);
         }
+        return _evaluate(lhs, _hash_set);
     }
 
     void insert(typename RunTimeTypeTraits<Type>::CppType* value) {
         if (value == nullptr) {
             _null_in_set = true;
         } else {
-            _hash_set.emplace(*value);
+            _insert_value(*value);
         }
     }
 
@@ -237,6 +238,50 @@ public:
     void set_eq_null(bool value) { _eq_null = value; }
 
 private:
+    using CppType = RunTimeCppType<Type>;
+
+    template <typename Set>
+    ColumnPtr _evaluate(const ColumnPtr& lhs, const Set& set) {
+        if (_null_in_set) {
+            if (_eq_null) {
+                return this->template eval_on_chunk<true, true>(lhs, set);
+            } else {
+                return this->template eval_on_chunk<true, false>(lhs, set);
+            }
+        } else if (lhs->is_nullable()) {
+            return this->template eval_on_chunk<false, false>(lhs, set);
+        } else {
+            return eval_on_chunk_both_column_and_set_not_has_null(lhs, set);
+        }
+    }
+
+    // Return true if |v| is a new value of the set.
+    bool _insert_value(const CppType& v) {
+        if (!_hash_set.emplace(v).second) {
+            return false;
+        }
+        if constexpr (isSlicePT<Type>) {
+            _min_size = std::min(_min_size, v.size);
+            _max_size = std::max(_max_size, v.size);
+        } else {
+            if (_array_set.size() < kMaxArraySetSize) {
+                _array_set.push_back(v);
+            }
+        }
+        return true;
+    }
+
+    template <typename Set>
+    bool _contains(const Set& set, const CppType& v) const {
+        if constexpr (isSlicePT<Type>) {
+            // Comparing the size is much cheaper than hashing the string.
+            if (v.size < _min_size || v.size > _max_size) {
+                return false;
+            }
+        }
+        return set.contains(v);
+    }
+
     const bool _is_not_in;
     bool _is_prepare;
     bool _null_in_set;
@@ -244,6 +289,11 @@ private:
     bool _eq_null = false;
 
     PHashSetType<Type> _hash_set;
+    // The first kMaxArraySetSize values of _hash_set, only for the fixed length types.
+    ArraySet<CppType, kMaxArraySetSize> _array_set;
+    // The range of the sizes of the strings in _hash_set.
+    size_t _min_size = std::numeric_limits<size_t>::max();
+    size_t _max_size = 0;
     // Ensure the string memory don't early free
     std::vector<ColumnPtr> _string_values;
 };
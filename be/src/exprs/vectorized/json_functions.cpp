@@ -14,6 +14,7 @@
 #include "column/column_viewer.h"
 #include "common/status.h"
 #include "rapidjson/error/en.h"
+#include "util/raw_container.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -179,15 +180,21 @@ rapidjson::Value* JsonFunctions::match_value(const std::vector<JsonPath>& parsed
                             }
                             continue;
                         }
+                        // The values are copied rather than moved out of the document, which may be matched by
+                        // other paths later, see JsonDocumentCache.
                         rapidjson::Value* obj = &((*json_elem)[col.c_str()]);
                         if (obj->IsArray()) {
                             is_null = false;
                             for (int k = 0; k < obj->Size(); k++) {
-                                array_obj->PushBack((*obj)[k], mem_allocator);
+                                rapidjson::Value v;
+                                v.CopyFrom((*obj)[k], mem_allocator);
+                                array_obj->PushBack(v, mem_allocator);
                             }
                         } else if (!obj->IsNull()) {
                             is_null = false;
-                            array_obj->PushBack(*obj, mem_allocator);
+                            rapidjson::Value v;
+                            v.CopyFrom(*obj, mem_allocator);
+                            array_obj->PushBack(v, mem_allocator);
                         }
                     }
                 }
@@ -247,59 +254,86 @@ void JsonFunctions::parse_json_paths(const std::string& path_string, std::vector
     get_parsed_paths(paths, parsed_paths);
 }
 
-rapidjson::Value* JsonFunctions::get_json_object(FunctionContext* context, const std::string& json_string,
-                                                 const std::string& path_string, const JsonFunctionType& fntype,
-                                                 rapidjson::Document* document) {
-    // split path by ".", and escape quota by "\"
-    // eg:
-    //    '$.text#abc.xyz'  ->  [$, text#abc, xyz]
-    //    '$."text.abc".xyz'  ->  [$, text.abc, xyz]
-    //    '$."text.abc"[1].xyz'  ->  [$, text.abc[1], xyz]
-    std::vector<JsonPath>* parsed_paths;
-    std::vector<JsonPath> tmp_parsed_paths;
-#ifndef BE_TEST
-    parsed_paths =
-            reinterpret_cast<std::vector<JsonPath>*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
-    if (parsed_paths == nullptr) {
-        boost::tokenizer<boost::escaped_list_separator<char> > tok(
-                path_string, boost::escaped_list_separator<char>("\\", ".", "\""));
-        std::vector<std::string> paths(tok.begin(), tok.end());
-        get_parsed_paths(paths, &tmp_parsed_paths);
-        parsed_paths = &tmp_parsed_paths;
-    }
-#else
-    boost::tokenizer<boost::escaped_list_separator<char> > tok(path_string,
-                                                               boost::escaped_list_separator<char>("\\", ".", "\""));
-    std::vector<std::string> paths(tok.begin(), tok.end());
-    get_parsed_paths(paths, &tmp_parsed_paths);
-    parsed_paths = &tmp_parsed_paths;
-#endif
+rapidjson::Value* JsonFunctions::get_json_object(const Slice& json_string, const std::vector<JsonPath>& parsed_paths,
+                                                 const JsonFunctionType& fntype, rapidjson::Document* document) {
+    VLOG(10) << "first parsed path: " << parsed_paths[0].debug_string();
 
-    VLOG(10) << "first parsed path: " << (*parsed_paths)[0].debug_string();
-
-    if (!(*parsed_paths)[0].is_valid) {
+    if (!parsed_paths[0].is_valid) {
         return document;
     }
 
-    if (UNLIKELY((*parsed_paths).size() == 1)) {
+    if (UNLIKELY(parsed_paths.size() == 1)) {
         if (fntype == JSON_FUN_STRING) {
-            document->SetString(json_string.c_str(), document->GetAllocator());
+            document->SetString(json_string.data, json_string.size, document->GetAllocator());
         } else {
             return document;
         }
     }
 
-    //rapidjson::Document document;
-    document->Parse(json_string.c_str());
+    document->Parse(json_string.data, json_string.size);
     if (UNLIKELY(document->HasParseError())) {
         VLOG(1) << "Error at offset " << document->GetErrorOffset() << ": "
                 << GetParseError_En(document->GetParseError());
         document->SetNull();
         return document;
     }
-    return match_value(*parsed_paths, document, document->GetAllocator());
+    return match_value(parsed_paths, document, document->GetAllocator());
 }
 
+// JsonDocumentCache keeps the parsed documents of the last json column evaluated by a thread, so that the get_json_*
+// calls of a projection on the same column, e.g. `get_json_string(j, '$.a'), get_json_int(j, '$.b')`, parse every
+// document once and only match their own paths. The column is recognized by its offsets and bytes, which cost much
+// less to compare than to parse, so a column refilled in place is never mistaken for the cached one.
+class JsonDocumentCache {
+public:
+    // The columns of more bytes are not cached, to bound the memory of the parsed documents held by a thread.
+    static constexpr size_t kMaxCachedBytes = 16 * 1024 * 1024;
+
+    // Cache the documents of |column| if it differs from the cached one, and returns false if it is too large.
+    bool reset(const BinaryColumn& column) {
+        const auto& bytes = column.get_bytes();
+        const auto& offsets = column.get_offset();
+        if (bytes.size() > kMaxCachedBytes) {
+            return false;
+        }
+        if (bytes.size() == _bytes.size() && offsets.size() == _offsets.size() &&
+            memcmp(bytes.data(), _bytes.data(), bytes.size()) == 0 &&
+            memcmp(offsets.data(), _offsets.data(), offsets.size() * sizeof(uint32_t)) == 0) {
+            return true;
+        }
+        _documents.clear();
+        _allocator.Clear();
+        _bytes.assign(bytes.begin(), bytes.end());
+        _offsets.assign(offsets.begin(), offsets.end());
+        _documents.resize(offsets.size() - 1);
+        return true;
+    }
+
+    // The document of |row|, which is parsed at the first call. Its value is null if it is malformed.
+    rapidjson::Document* document(size_t row) {
+        std::unique_ptr<rapidjson::Document>& document = _documents[row];
+        if (document == nullptr) {
+            document = std::make_unique<rapidjson::Document>(&_allocator);
+            document->Parse(reinterpret_cast<const char*>(_bytes.data()) + _offsets[row],
+                            _offsets[row + 1] - _offsets[row]);
+            if (UNLIKELY(document->HasParseError())) {
+                VLOG(1) << "Error at offset " << document->GetErrorOffset() << ": "
+                        << GetParseError_En(document->GetParseError());
+                document->SetNull();
+            }
+        }
+        return document.get();
+    }
+
+private:
+    std::vector<uint8_t> _bytes;
+    std::vector<uint32_t> _offsets;
+    std::vector<std::unique_ptr<rapidjson::Document>> _documents;
+    rapidjson::MemoryPoolAllocator<> _allocator;
+};
+
+static thread_local JsonDocumentCache tls_json_document_cache;
+
 JsonFunctionType JsonTypeTraits<TYPE_INT>::JsonType = JSON_FUN_INT;
 JsonFunctionType JsonTypeTraits<TYPE_DOUBLE>::JsonType = JSON_FUN_DOUBLE;
 JsonFunctionType JsonTypeTraits<TYPE_VARCHAR>::JsonType = JSON_FUN_STRING;
@@ -309,6 +343,29 @@ ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& c
     auto json_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto path_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
 
+    // The constant paths are parsed once by json_path_prepare(), the others at every row.
+    auto* prepared_paths =
+            reinterpret_cast<std::vector<JsonPath>*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
+    std::vector<JsonPath> row_paths;
+
+    // The documents of all the rows are parsed into the same memory pool, which is cleared at every row but keeps
+    // its first chunk, instead of allocating a new pool for every row.
+    constexpr size_t kPoolBufferSize = 64 * 1024;
+    raw::RawVector<char> pool_buffer(kPoolBufferSize);
+    rapidjson::MemoryPoolAllocator<> allocator(pool_buffer.data(), pool_buffer.size());
+
+    // The documents are shared with the other calls on the same json column by the cache, if the paths of all the
+    // rows are the constant ones, which need a parsed document.
+    JsonDocumentCache* cache = nullptr;
+    bool json_is_const = columns[0]->is_constant();
+    if (prepared_paths != nullptr && prepared_paths->size() > 1 && (*prepared_paths)[0].is_valid) {
+        const Column* json_column = ColumnHelper::get_data_column(columns[0].get());
+        json_column = ColumnHelper::get_data_column(json_column);
+        if (tls_json_document_cache.reset(*down_cast<const BinaryColumn*>(json_column))) {
+            cache = &tls_json_document_cache;
+        }
+    }
+
     ColumnBuilder<primitive_type> result;
     auto size = columns[0]->size();
     for (int row = 0; row < size; ++row) {
@@ -322,20 +379,32 @@ ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& c
             result.append_null();
             continue;
         }
-        std::string json_string(json_value.data, json_value.size);
 
-        auto path_value = path_viewer.value(row);
-        std::string path_string(path_value.data, path_value.size);
-        // Must remove or replace the escape sequence.
-        path_string.erase(std::remove(path_string.begin(), path_string.end(), '\\'), path_string.end());
-        if (path_string.empty()) {
-            result.append_null();
-            continue;
+        const std::vector<JsonPath>* parsed_paths = prepared_paths;
+        if (parsed_paths == nullptr) {
+            auto path_value = path_viewer.value(row);
+            std::string path_string(path_value.data, path_value.size);
+            // Must remove or replace the escape sequence.
+            path_string.erase(std::remove(path_string.begin(), path_string.end(), '\\'), path_string.end());
+            if (path_string.empty()) {
+                result.append_null();
+                continue;
+            }
+            row_paths.clear();
+            parse_json_paths(path_string, &row_paths);
+            parsed_paths = &row_paths;
         }
 
-        rapidjson::Document document;
-        rapidjson::Value* root = JsonFunctions::get_json_object(context, json_string, path_string,
-                                                                JsonTypeTraits<primitive_type>::JsonType, &document);
+        allocator.Clear();
+        rapidjson::Document document(&allocator);
+        rapidjson::Value* root = nullptr;
+        if (cache != nullptr) {
+            // The values matched in the cached document are copied into the pool of this call.
+            root = match_value(*parsed_paths, cache->document(json_is_const ? 0 : row), allocator);
+        } else {
+            root = JsonFunctions::get_json_object(json_value, *parsed_paths, JsonTypeTraits<primitive_type>::JsonType,
+                                                  &document);
+        }
 
         if constexpr (primitive_type == TYPE_INT) {
             if (root != nullptr && root->IsInt()) {
@@ -357,7 +426,7 @@ ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& c
             if (root == nullptr || root->IsNull()) {
                 result.append_null();
             } else if (root->IsString()) {
-                result.append(Slice(root->GetString()));
+                result.append(Slice(root->GetString(), root->GetStringLength()));
             } else {
                 rapidjson::StringBuffer buf;
                 rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
@@ -89,6 +89,7 @@ Status LikePredicate::like_prepare(starrocks_udf::FunctionContext* context,
             context->set_error(strings::Substitute("Invalid regex: $0", re_pattern).c_str());
             return Status::InvalidArgument("Invalid regex: " + pattern.to_string());
         }
+        state->required_literal = extract_like_literal(pattern, state->escape_char);
     }
     return Status::OK();
 }
@@ -167,6 +168,7 @@ Status LikePredicate::regex_prepare(starrocks_udf::FunctionContext* context,
 
             return Status::InvalidArgument(error.str());
         }
+        state->required_literal = extract_regex_literal(pattern_str);
     }
 
     return Status::OK();
@@ -274,50 +276,51 @@ ColumnPtr LikePredicate::constant_substring_fn(FunctionContext* context,
         haystack = ColumnHelper::as_raw_column<BinaryColumn>(columns[0]);
     }
 
+    res->resize(haystack->size());
+    substring_match(haystack, needle, res->get_data().data());
+
+    if (columns[0]->has_null()) {
+        return NullableColumn::create(res, res_null);
+    }
+    return res;
+}
+
+void LikePredicate::substring_match(const BinaryColumn* haystack, const Slice& needle, uint8_t* res) {
+    size_t num_rows = haystack->size();
     if (needle.size == 0) {
         // if needle is empty string, every haystack can be matched.
-        res->resize(haystack->size());
-        size_t type_size = res->type_size();
-        memset(res->mutable_raw_data(), 1, res->size() * type_size);
-    } else {
-        const std::vector<uint32_t>& offsets = haystack->get_offset();
-        res->resize(haystack->size());
-
-        const char* begin = haystack->get_slice(0).data;
-        const char* pos = begin;
-        const char* end = pos + haystack->get_bytes().size();
-
-        /// Current index in the array of strings.
-        size_t i = 0;
-
-        auto searcher = VolnitskyUTF8(needle.data, needle.size, end - pos);
-        /// We will search for the next occurrence in all strings at once.
-        while (pos < end && end != (pos = searcher.search(pos, end - pos))) {
-            /// Determine which index it refers to.
-            while (begin + offsets[i + 1] <= pos) {
-                res->get_data()[i] = false;
-                ++i;
-            }
-            /// We check that the entry does not pass through the boundaries of strings.
-            if (pos + needle.size > begin + offsets[i + 1]) {
-                res->get_data()[i] = false;
-            } else {
-                res->get_data()[i] = true;
-            }
-            pos = begin + offsets[i + 1];
-            ++i;
-        }
+        memset(res, 1, num_rows);
+        return;
+    }
+    if (num_rows == 0) {
+        return;
+    }
+
+    const auto& offsets = haystack->get_offset();
+    const char* begin = haystack->get_slice(0).data;
+    const char* pos = begin;
+    const char* end = pos + haystack->get_bytes().size();
 
-        if (i < res->size()) {
-            size_t type_size = res->type_size();
-            memset(res->mutable_raw_data() + i * type_size, 0, (res->size() - i) * type_size);
+    /// Current index in the array of strings.
+    size_t i = 0;
+
+    auto searcher = VolnitskyUTF8(needle.data, needle.size, end - pos);
+    /// We will search for the next occurrence in all strings at once.
+    while (pos < end && end != (pos = searcher.search(pos, end - pos))) {
+        /// Determine which index it refers to.
+        while (begin + offsets[i + 1] <= pos) {
+            res[i] = false;
+            ++i;
         }
+        /// We check that the entry does not pass through the boundaries of strings.
+        res[i] = pos + needle.size <= begin + offsets[i + 1];
+        pos = begin + offsets[i + 1];
+        ++i;
     }
 
-    if (columns[0]->has_null()) {
-        return NullableColumn::create(res, res_null);
+    if (i < num_rows) {
+        memset(res + i, 0, num_rows - i);
     }
-    return res;
 }
 
 // regex_match
@@ -341,6 +344,9 @@ ColumnPtr LikePredicate::regex_match_full(FunctionContext* context, const starro
     // pattern is constant value, use context's regex
     if (context->is_constant_column(1)) {
         auto state = reinterpret_cast<LikePredicateState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
+        if (!state->required_literal.empty() && !value_column->is_constant()) {
+            return regex_match_with_prefilter(state, value_column, true);
+        }
 
         for (int row = 0; row < value_viewer.size(); ++row) {
             auto v = RE2::FullMatch(re2::StringPiece(value_viewer.value(row).data, value_viewer.value(row).size),
@@ -390,6 +396,9 @@ ColumnPtr LikePredicate::regex_match_partial(FunctionContext* context, const sta
     // pattern is constant value, use context's regex
     if (context->is_constant_column(1)) {
         auto state = reinterpret_cast<LikePredicateState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
+        if (!state->required_literal.empty() && !value_column->is_constant()) {
+            return regex_match_with_prefilter(state, value_column, false);
+        }
 
         for (int row = 0; row < value_viewer.size(); ++row) {
             auto v = RE2::PartialMatch(re2::StringPiece(value_viewer.value(row).data, value_viewer.value(row).size),
@@ -430,11 +439,199 @@ ColumnPtr LikePredicate::regex_match_partial(FunctionContext* context, const sta
     return result.build(ColumnHelper::is_all_const(columns));
 }
 
+ColumnPtr LikePredicate::regex_match_with_prefilter(LikePredicateState* state, const ColumnPtr& value_column,
+                                                    bool full_match) {
+    BinaryColumn* values = nullptr;
+    NullColumnPtr nulls = nullptr;
+    if (value_column->is_nullable()) {
+        auto nullable_column = ColumnHelper::as_column<NullableColumn>(value_column);
+        values = ColumnHelper::as_raw_column<BinaryColumn>(nullable_column->data_column());
+        nulls = nullable_column->null_column();
+    } else {
+        values = ColumnHelper::as_raw_column<BinaryColumn>(value_column);
+    }
+
+    auto res = RunTimeColumnType<TYPE_BOOLEAN>::create();
+    res->resize(values->size());
+    uint8_t* matched = res->get_data().data();
+    // Most values are expected to be filtered out by the literal, which is searched in all the values at once.
+    substring_match(values, Slice(state->required_literal), matched);
+    for (size_t row = 0; row < values->size(); ++row) {
+        if (matched[row]) {
+            Slice value = values->get_slice(row);
+            re2::StringPiece text(value.data, value.size);
+            matched[row] = full_match ? RE2::FullMatch(text, *state->regex) : RE2::PartialMatch(text, *state->regex);
+        }
+    }
+
+    if (value_column->has_null()) {
+        return NullableColumn::create(res, nulls);
+    }
+    return res;
+}
+
+Status LikePredicate::compile_like_pattern_set(const std::vector<std::string>& patterns,
+                                               std::unique_ptr<re2::RE2::Set>* pattern_set) {
+    RE2::Options opts;
+    opts.set_never_nl(false);
+    opts.set_dot_nl(true);
+
+    auto like_set = std::make_unique<re2::RE2::Set>(opts, RE2::ANCHOR_BOTH);
+    for (const auto& pattern : patterns) {
+        // with the default escape char of the like predicates
+        auto re_pattern = convert_like_pattern(Slice(pattern), '\\');
+        std::string error;
+        if (like_set->Add(re_pattern, &error) < 0) {
+            return Status::InvalidArgument(strings::Substitute("Invalid regex: $0, $1", re_pattern, error));
+        }
+    }
+    if (!like_set->Compile()) {
+        return Status::InternalError("Failed to compile the like patterns");
+    }
+    *pattern_set = std::move(like_set);
+    return Status::OK();
+}
+
+ColumnPtr LikePredicate::match_like_pattern_set(const re2::RE2::Set& pattern_set, const ColumnPtr& value_column) {
+    ColumnViewer<TYPE_VARCHAR> value_viewer(value_column);
+    ColumnBuilder<TYPE_BOOLEAN> result;
+
+    for (int row = 0; row < value_viewer.size(); ++row) {
+        Slice value = value_viewer.value(row);
+        // It only tells whether any pattern is matched, so the scan stops at the first match.
+        auto v = pattern_set.Match(re2::StringPiece(value.data, value.size), nullptr);
+        result.append(v, value_viewer.is_null(row));
+    }
+    return result.build(value_column->is_constant());
+}
+
+std::string LikePredicate::extract_like_literal(const Slice& pattern, char escape_char) {
+    std::string longest;
+    std::string literal;
+    bool is_escaped = false;
+
+    for (int i = 0; i < pattern.size; ++i) {
+        if (!is_escaped && (pattern.data[i] == '%' || pattern.data[i] == '_')) {
+            if (literal.size() > longest.size()) {
+                longest.swap(literal);
+            }
+            literal.clear();
+        } else if (!is_escaped && pattern.data[i] == escape_char) {
+            is_escaped = true;
+        } else {
+            literal.append(1, pattern.data[i]);
+            is_escaped = false;
+        }
+    }
+    if (literal.size() > longest.size()) {
+        longest.swap(literal);
+    }
+    return longest;
+}
+
+std::string LikePredicate::extract_regex_literal(const std::string& pattern) {
+    std::string longest;
+    std::string literal;
+    auto end_literal = [&]() {
+        if (literal.size() > longest.size()) {
+            longest.swap(literal);
+        }
+        literal.clear();
+    };
+
+    // The literals are only collected out of the groups, which may be optional or repeated.
+    int depth = 0;
+    size_t size = pattern.size();
+    for (size_t i = 0; i < size; ++i) {
+        char c = pattern[i];
+        if (c == '\\') {
+            if (i + 1 == size) {
+                return "";
+            }
+            auto e = static_cast<unsigned char>(pattern[++i]);
+            if (e >= 0x80) {
+                return "";
+            } else if (isalnum(e)) {
+                // \d, \w, \b, etc. are not literals, and the others, e.g. \x41 and \Q...\E, are not parsed here.
+                if (strchr("dDwWsSbBAzC", e) == nullptr) {
+                    return "";
+                }
+                end_literal();
+            } else if (depth == 0) {
+                literal.append(1, e);
+            }
+        } else if (c == '|') {
+            // any of the alternatives may be matched
+            return "";
+        } else if (c == '(') {
+            if (i + 1 < size && pattern[i + 1] == '?') {
+                // the flags, e.g. (?i), may change how the literals are matched
+                return "";
+            }
+            end_literal();
+            ++depth;
+        } else if (c == ')') {
+            end_literal();
+            --depth;
+        } else if (c == '[') {
+            end_literal();
+            // skip the character class, where ']' is a literal if it's the first one
+            size_t j = i + 1;
+            if (j < size && pattern[j] == '^') {
+                ++j;
+            }
+            if (j < size && pattern[j] == ']') {
+                ++j;
+            }
+            while (j < size && pattern[j] != ']') {
+                if (pattern[j] == '\\') {
+                    ++j;
+                } else if (pattern[j] == '[' && j + 1 < size && pattern[j + 1] == ':') {
+                    // [:alpha:]
+                    auto close = pattern.find(":]", j + 2);
+                    if (close == std::string::npos) {
+                        return "";
+                    }
+                    j = close + 1;
+                }
+                ++j;
+            }
+            i = j;
+        } else if (c == '*' || c == '?' || c == '{') {
+            // the preceding character, which may be of multiple bytes, is optional
+            while (!literal.empty() && (static_cast<unsigned char>(literal.back()) & 0xC0) == 0x80) {
+                literal.pop_back();
+            }
+            if (!literal.empty()) {
+                literal.pop_back();
+            }
+            end_literal();
+            if (c == '{') {
+                auto close = pattern.find('}', i);
+                if (close == std::string::npos) {
+                    return "";
+                }
+                i = close;
+            }
+        } else if (c == '+' || c == '.' || c == '^' || c == '$') {
+            end_literal();
+        } else if (depth == 0) {
+            literal.append(1, c);
+        }
+    }
+    end_literal();
+    return longest;
+}
+
 std::string LikePredicate::convert_like_pattern(FunctionContext* context, const Slice& pattern) {
+    auto state = reinterpret_cast<LikePredicateState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
+    return convert_like_pattern(pattern, state->escape_char);
+}
+
+std::string LikePredicate::convert_like_pattern(const Slice& pattern, char escape_char) {
     std::string re_pattern;
     re_pattern.clear();
 
-    auto state = reinterpret_cast<LikePredicateState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
     bool is_escaped = false;
 
     for (int i = 0; i < pattern.size; ++i) {
@@ -443,7 +640,7 @@ std::string LikePredicate::convert_like_pattern(FunctionContext* context, const
         } else if (!is_escaped && pattern.data[i] == '_') {
             re_pattern.append(".");
             // check for escape char before checking for regex special chars, they might overlap
-        } else if (!is_escaped && pattern.data[i] == state->escape_char) {
+        } else if (!is_escaped && pattern.data[i] == escape_char) {
             is_escaped = true;
         } else if (pattern.data[i] == '.' || pattern.data[i] == '[' || pattern.data[i] == ']' ||
                    pattern.data[i] == '{' || pattern.data[i] == '}' || pattern.data[i] == '(' ||
@@ -3,9 +3,11 @@
 #pragma once
 
 #include <re2/re2.h>
+#include <re2/set.h>
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "exprs/vectorized/builtin_functions.h"
 #include "exprs/vectorized/function_helper.h"
@@ -47,7 +49,20 @@ public:
      */
     DEFINE_VECTORIZED_FN(regex);
 
+    /// Convert a LIKE pattern (with embedded % and _) into the corresponding
+    /// regular expression pattern. Escaped chars are copied verbatim.
+    static std::string convert_like_pattern(const Slice& pattern, char escape_char);
+
+    /// Compile the LIKE |patterns| into one set, to match a value against all of them in a single pass.
+    static Status compile_like_pattern_set(const std::vector<std::string>& patterns,
+                                           std::unique_ptr<re2::RE2::Set>* pattern_set);
+
+    /// Whether the values of |value_column| are LIKE any of the patterns in |pattern_set|.
+    static ColumnPtr match_like_pattern_set(const re2::RE2::Set& pattern_set, const ColumnPtr& value_column);
+
 private:
+    struct LikePredicateState;
+
     /**
      * use for:
      *  a like "....", such as "!@#$%^&*"..=
@@ -130,8 +145,20 @@ private:
 
     static ColumnPtr regex_match_partial(FunctionContext* context, const Columns& columns);
 
-    /// Convert a LIKE pattern (with embedded % and _) into the corresponding
-    /// regular expression pattern. Escaped chars are copied verbatim.
+    /// Match the values against the constant regex only if they contain the required literal of it.
+    static ColumnPtr regex_match_with_prefilter(LikePredicateState* state, const ColumnPtr& value_column,
+                                                bool full_match);
+
+    /// Set res[i] to whether the i-th value of |haystack| contains |needle|, searching all the values at once.
+    static void substring_match(const BinaryColumn* haystack, const Slice& needle, uint8_t* res);
+
+    /// The longest literal which every value LIKE |pattern| must contain, or empty if none.
+    static std::string extract_like_literal(const Slice& pattern, char escape_char);
+
+    /// The longest literal which every value matching the regex |pattern| must contain, or empty if
+    /// it can't be told, e.g. the pattern has alternations or flags.
+    static std::string extract_regex_literal(const std::string& pattern);
+
     static std::string convert_like_pattern(starrocks_udf::FunctionContext* context, const Slice& pattern);
 
     static void remove_escape_character(std::string* search_string);
@@ -163,6 +190,10 @@ private:
         /// Used for RLIKE and REGEXP predicates if the pattern is a constant argument.
         std::unique_ptr<re2::RE2> regex;
 
+        /// The literal which the values matching the constant regex must contain. The values without it
+        /// are not matched against the regex at all.
+        std::string required_literal;
+
         LikePredicateState() : escape_char('\\') {}
 
         void set_search_string(const std::string& search_string_arg) {
@@ -18,6 +18,13 @@ void SimdBlockFilter::init(size_t nums) {
     memset(_directory, 0, alloc_size);
 }
 
+void SimdBlockFilter::init_full() {
+    free(_directory);
+    _directory = nullptr;
+    init(1);
+    memset(_directory, 0xff, get_alloc_size());
+}
+
 SimdBlockFilter::SimdBlockFilter(SimdBlockFilter&& bf) {
     _log_num_buckets = bf._log_num_buckets;
     _directory_mask = bf._directory_mask;
@@ -86,9 +93,6 @@ void SimdBlockFilter::merge(const SimdBlockFilter& bf) {
     }
 }
 
-static constexpr uint32_t SALT[8] = {0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d,
-                                     0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31};
-
 // For scalar version:
 void SimdBlockFilter::make_mask(uint32_t key, uint32_t* masks) const {
     for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
@@ -101,6 +105,43 @@ void SimdBlockFilter::make_mask(uint32_t key, uint32_t* masks) const {
     }
 }
 
+// How many hashes ahead the buckets are prefetched, to hide the cache misses of a filter larger than the cache.
+static constexpr size_t PREFETCH_DISTANCE = 16;
+
+void SimdBlockFilter::test_hashes(const uint64_t* hashes, size_t n, uint8_t* results) const noexcept {
+    size_t i = 0;
+#ifdef __AVX512F__
+    // Each half of a register holds the bucket or the masks of one hash.
+    const __m512i rehash = _mm512_broadcast_i64x4(_mm256_load_si256(reinterpret_cast<const __m256i*>(SALT)));
+    const __m512i ones = _mm512_set1_epi32(1);
+    for (; i + 2 <= n; i += 2) {
+        if (i + PREFETCH_DISTANCE + 1 < n) {
+            __builtin_prefetch(_directory + (hashes[i + PREFETCH_DISTANCE] & _directory_mask));
+            __builtin_prefetch(_directory + (hashes[i + PREFETCH_DISTANCE + 1] & _directory_mask));
+        }
+        const __m256i* bucket0 = reinterpret_cast<const __m256i*>(_directory + (hashes[i] & _directory_mask));
+        const __m256i* bucket1 = reinterpret_cast<const __m256i*>(_directory + (hashes[i + 1] & _directory_mask));
+        const __m512i buckets =
+                _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_load_si256(bucket0)), _mm256_load_si256(bucket1), 1);
+        const __m512i hash_data =
+                _mm512_inserti64x4(_mm512_set1_epi32(static_cast<uint32_t>(hashes[i] >> _log_num_buckets)),
+                                   _mm256_set1_epi32(static_cast<uint32_t>(hashes[i + 1] >> _log_num_buckets)), 1);
+        const __m512i masks = _mm512_sllv_epi32(ones, _mm512_srli_epi32(_mm512_mullo_epi32(rehash, hash_data), 27));
+        // The lanes having a bit of the masks missing in the buckets.
+        const __m512i missing = _mm512_andnot_si512(buckets, masks);
+        const __mmask16 missing_lanes = _mm512_test_epi32_mask(missing, missing);
+        results[i] = (missing_lanes & 0xff) == 0;
+        results[i + 1] = (missing_lanes >> 8) == 0;
+    }
+#endif
+    for (; i < n; i++) {
+        if (i + PREFETCH_DISTANCE < n) {
+            __builtin_prefetch(_directory + (hashes[i + PREFETCH_DISTANCE] & _directory_mask));
+        }
+        results[i] = test_hash(hashes[i]);
+    }
+}
+
 bool SimdBlockFilter::check_equal(const SimdBlockFilter& bf) const {
     const size_t alloc_size = get_alloc_size();
     return _log_num_buckets == bf._log_num_buckets && _directory_mask == bf._directory_mask &&
@@ -2,6 +2,10 @@
 
 #pragma once
 
+#ifdef __aarch64__
+#include <arm_neon.h>
+#endif
+
 #include "column/chunk.h"
 #include "column/column_hash.h"
 #include "column/const_column.h"
@@ -30,6 +34,8 @@ public:
     SimdBlockFilter(SimdBlockFilter&& bf);
 
     void init(size_t nums);
+    // Init the smallest filter with all the bits set, which contains every hash.
+    void init_full();
 
     void insert_hash(const uint64_t hash) noexcept {
         const uint32_t bucket_idx = hash & _directory_mask;
@@ -56,6 +62,8 @@ public:
         // our case, the result is zero everywhere iff there is a one in 'bucket' wherever
         // 'mask' is one. testc returns 1 if the result is 0 everywhere and returns 0 otherwise.
         return _mm256_testc_si256(bucket, mask);
+#elif defined(__aarch64__)
+        return test_bucket(_directory[bucket_idx], hash >> _log_num_buckets);
 #else
         uint32_t masks[BITS_SET_PER_BLOCK];
         make_mask(hash >> _log_num_buckets, masks);
@@ -68,8 +76,14 @@ public:
 #endif
     }
 
+    // Test the |n| hashes of |hashes| at once, setting |results[i]| to 1 if |hashes[i]| may be in the filter and to 0
+    // if not. The buckets of the following hashes are prefetched while testing the current ones, and two hashes are
+    // tested at once with AVX-512.
+    void test_hashes(const uint64_t* hashes, size_t n, uint8_t* results) const noexcept;
+
     void insert_hash_in_same_bucket(const uint64_t* hash_values, size_t n) {
         if (n == 0) return;
+#ifdef __AVX2__
         const uint32_t bucket_idx = hash_values[0] & _directory_mask;
         __m256i* addr = reinterpret_cast<__m256i*>(_directory + bucket_idx);
         __m256i now = _mm256_load_si256(addr);
@@ -78,6 +92,11 @@ public:
             now = _mm256_or_si256(now, mask);
         }
         _mm256_store_si256(addr, now);
+#else
+        for (size_t i = 0; i < n; i++) {
+            insert_hash(hash_values[i]);
+        }
+#endif
     }
 
     size_t max_serialized_size() const;
@@ -90,9 +109,29 @@ public:
 private:
     // The number of bits to set in a tiny Bloom filter block
 
+    // The odd constants to rehash the hash by for each word of the bucket.
+    alignas(32) static constexpr uint32_t SALT[BITS_SET_PER_BLOCK] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU,
+                                                                       0xa2b7289dU, 0x705495c7U, 0x2df1424bU,
+                                                                       0x9efc4947U, 0x5c6bfb31U};
+
     // For scalar version:
     void make_mask(uint32_t key, uint32_t* masks) const;
 
+#ifdef __aarch64__
+    // For neon version, which tests the two halves of the bucket:
+    static bool test_bucket(const Bucket& bucket, uint32_t hash) noexcept {
+        const uint32x4_t hash_data = vdupq_n_u32(hash);
+        const int32x4_t shift_lo = vreinterpretq_s32_u32(vshrq_n_u32(vmulq_u32(hash_data, vld1q_u32(SALT)), 27));
+        const int32x4_t shift_hi = vreinterpretq_s32_u32(vshrq_n_u32(vmulq_u32(hash_data, vld1q_u32(SALT + 4)), 27));
+        const uint32x4_t ones = vdupq_n_u32(1);
+        // The bits of the masks missing in the bucket.
+        const uint32x4_t missing_lo = vbicq_u32(vshlq_u32(ones, shift_lo), vld1q_u32(bucket));
+        const uint32x4_t missing_hi = vbicq_u32(vshlq_u32(ones, shift_hi), vld1q_u32(bucket + 4));
+        return vmaxvq_u32(vorrq_u32(missing_lo, missing_hi)) == 0;
+    }
+#endif
+
+#ifdef __AVX2__
     // For simd version:
     __m256i make_mask(const uint32_t hash) const noexcept {
         // Load hash into a YMM register, repeated eight times
@@ -107,6 +146,7 @@ private:
         // Use these 5 bits to shift a single bit to a location in each 32-bit lane
         return _mm256_sllv_epi32(ones, hash_data);
     }
+#endif
     // log2(number of bytes in a bucket):
     static constexpr int LOG_BUCKET_BYTE_SIZE = 5;
 
@@ -185,6 +225,8 @@ public:
     public:
         Column::Filter selection;
         std::vector<uint32_t> hash_values;
+        // the hashes of the values tested by the bloom filter at once
+        std::vector<uint64_t> bloom_hashes;
     };
 
     virtual Column::Filter& evaluate(Column* input_column, RunningContext* ctx) const = 0;
@@ -214,6 +256,18 @@ public:
     virtual bool check_equal(const JoinRuntimeFilter& rf) const;
     virtual JoinRuntimeFilter* create_empty(ObjectPool* pool) = 0;
 
+    // Whether any value of [min, max], the single values of |min_column| and |max_column|, may pass the filter, e.g.
+    // to skip a row group of a file of these min/max values. True if unknown.
+    virtual bool test_range(const Column& min_column, const Column& max_column) const { return true; }
+
+    // Replace the bloom filters by a tiny one containing every hash, so that the filter only tests the
+    // min/max values, e.g. when the merged bloom filter would be too large to send.
+    void drop_bloom_filter() {
+        _hash_partition_bf.clear();
+        _hash_partition_number = 0;
+        _bf.init_full();
+    }
+
 protected:
     bool _has_null = false;
     size_t _size = 0;
@@ -314,6 +368,45 @@ public:
         return _hash_partition_bf[bucket_idx].test_hash(hash);
     }
 
+    // Test the |size| values of |input_data| into |ctx->selection| at once, with the nulls of |null_data| if it is
+    // not null.
+    void test_data_batch(const CppType* input_data, const uint8_t* null_data, size_t size,
+                         RunningContext* ctx) const {
+        uint8_t* selection = ctx->selection.data();
+        std::vector<uint64_t>& hashes = ctx->bloom_hashes;
+        hashes.resize(size);
+        for (size_t i = 0; i < size; i++) {
+            hashes[i] = compute_hash(input_data[i]);
+        }
+        _bf.test_hashes(hashes.data(), size, selection);
+        if constexpr (!IsSlice<CppType>) {
+            for (size_t i = 0; i < size; i++) {
+                selection[i] &= !(input_data[i] < _min) & !(input_data[i] > _max);
+            }
+        }
+        if (null_data != nullptr) {
+            for (size_t i = 0; i < size; i++) {
+                if (null_data[i]) {
+                    selection[i] = _has_null;
+                }
+            }
+        }
+    }
+
+    bool test_range(const Column& min_column, const Column& max_column) const override {
+        if constexpr (IsSlice<CppType>) {
+            return true;
+        } else {
+            const CppType* min_value = _single_value(min_column);
+            const CppType* max_value = _single_value(max_column);
+            if (_has_null || min_value == nullptr || max_value == nullptr) {
+                return true;
+            }
+            // The same min/max test as test_data.
+            return !(*max_value < _min) && !(*min_value > _max);
+        }
+    }
+
     Column::Filter& evaluate(Column* input_column, RunningContext* ctx) const override {
         if (_hash_partition_number != 0) {
             return t_evaluate<true>(input_column, ctx);
@@ -378,7 +471,11 @@ public:
         } else if (input_column->is_nullable()) {
             const auto* nullable_column = down_cast<const NullableColumn*>(input_column);
             auto* input_data = down_cast<const ColumnType*>(nullable_column->data_column().get())->get_data().data();
-            if (nullable_column->has_null()) {
+            if constexpr (!hash_partition) {
+                const uint8_t* null_data =
+                        nullable_column->has_null() ? nullable_column->immutable_null_column_data().data() : nullptr;
+                test_data_batch(input_data, null_data, size, ctx);
+            } else if (nullable_column->has_null()) {
                 const uint8_t* null_data = nullable_column->immutable_null_column_data().data();
                 for (int i = 0; i < size; ++i) {
                     if (null_data[i]) {
@@ -402,6 +499,9 @@ public:
                     }
                 }
             }
+        } else if constexpr (!hash_partition) {
+            auto* input_data = down_cast<const ColumnType*>(input_column)->get_data().data();
+            test_data_batch(input_data, nullptr, size, ctx);
         } else {
             auto* input_data = down_cast<const ColumnType*>(input_column)->get_data().data();
             for (int i = 0; i < size; ++i) {
@@ -580,6 +680,19 @@ public:
     }
 
 private:
+    // The value of the single row |column| of the type of the filter, null if it is null or of another type.
+    static const CppType* _single_value(const Column& column) {
+        if (column.size() != 1 || column.is_null(0)) {
+            return nullptr;
+        }
+        const Column* data_column = &column;
+        if (column.is_nullable()) {
+            data_column = down_cast<const NullableColumn&>(column).data_column().get();
+        }
+        const auto* typed_column = dynamic_cast<const ColumnType*>(data_column);
+        return typed_column != nullptr ? typed_column->get_data().data() : nullptr;
+    }
+
     CppType _min;
     CppType _max;
     std::string _slice_min;
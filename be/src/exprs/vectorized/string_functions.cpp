@@ -1520,12 +1520,34 @@ ColumnPtr StringFunctions::length(FunctionContext* context, const Columns& colum
     return VectorizedStrictUnaryFunction<lengthImpl>::evaluate<TYPE_VARCHAR, TYPE_INT>(columns[0]);
 }
 
-DEFINE_UNARY_FN_WITH_IMPL(utf8LengthImpl, str) {
-    return utf8_len(str.data, str.data + str.size);
-}
+struct Utf8LengthFunction {
+    template <PrimitiveType Type, PrimitiveType ResultType>
+    static inline ColumnPtr evaluate(const ColumnPtr& column) {
+        BinaryColumn* src = down_cast<BinaryColumn*>(column.get());
+        const auto& src_bytes = src->get_bytes();
+        const auto& src_offsets = src->get_offset();
+        const size_t num_rows = src->size();
+
+        auto result = RunTimeColumnType<ResultType>::create();
+        result->resize_uninitialized(num_rows);
+        auto* lengths = result->get_data().data();
+        // the length of an ascii string is its size, got from the offsets without reading the bytes.
+        if (validate_ascii_fast((const char*)src_bytes.data(), src_bytes.size())) {
+            for (size_t i = 0; i < num_rows; ++i) {
+                lengths[i] = src_offsets[i + 1] - src_offsets[i];
+            }
+        } else {
+            const char* begin = (const char*)src_bytes.data();
+            for (size_t i = 0; i < num_rows; ++i) {
+                lengths[i] = utf8_len(begin + src_offsets[i], begin + src_offsets[i + 1]);
+            }
+        }
+        return result;
+    }
+};
 
 ColumnPtr StringFunctions::utf8_length(FunctionContext* context, const starrocks::vectorized::Columns& columns) {
-    return VectorizedStrictUnaryFunction<utf8LengthImpl>::evaluate<TYPE_VARCHAR, TYPE_INT>(columns[0]);
+    return VectorizedUnaryFunction<Utf8LengthFunction>::evaluate<TYPE_VARCHAR, TYPE_INT>(columns[0]);
 }
 
 template <char CA, char CZ>
@@ -1549,7 +1571,7 @@ static inline void vectorized_toggle_case(const Bytes* src, Bytes* dst) {
     const auto z_plus1 = _mm_set1_epi8(CZ + 1);
     const auto flips = _mm_set1_epi8(32);
 
-    for (; src_ptr > sse2_end; src_ptr += SSE2_BYTES, dst_ptr += SSE2_BYTES) {
+    for (; src_ptr < sse2_end; src_ptr += SSE2_BYTES, dst_ptr += SSE2_BYTES) {
         auto bytes = _mm_loadu_si128((const __m128i*)src_ptr);
         // the i-th byte of masks is set to 0xff if the corresponding byte is
         // between a..z when computing upper function (A..Z when computing lower function),
@@ -1648,7 +1670,8 @@ static inline void reverse(BinaryColumn* src, Bytes* dst_bytes) {
         auto begin = s.data;
         auto end = s.data + s.size;
         dst_curr += s.size;
-        if constexpr (is_ascii) {
+        // the ascii rows of a non-ascii column are reversed as ascii too.
+        if (is_ascii || validate_ascii_fast(begin, s.size)) {
             ascii_reverse_per_slice(begin, end, dst_curr);
         } else {
             utf8_reverse_per_slice(begin, end, dst_curr);
@@ -380,12 +380,7 @@ DEFINE_TIME_STRING_UNARY_FN(day_name, TYPE_DATETIME, TYPE_VARCHAR);
 
 // day_of_year
 DEFINE_UNARY_FN_WITH_IMPL(day_of_yearImpl, v) {
-    auto day = (DateValue)v;
-    int year, month, day1;
-    day.to_date(&year, &month, &day1);
-    DateValue first_day_year;
-    first_day_year.from_date(year, 1, 1);
-    return day.julian() - first_day_year.julian() + 1;
+    return date::get_day_of_year(((DateValue)v).julian());
 }
 DEFINE_TIME_UNARY_FN(day_of_year, TYPE_DATETIME, TYPE_INT);
 
@@ -157,6 +157,12 @@ public:
             return v1;
         }
 
+        // the null flags are all zeros, the result is computed on the data column only.
+        const ColumnPtr& data = FunctionHelper::get_data_column_if_no_null(v1);
+        if (data.get() != v1.get()) {
+            return FN::template evaluate<Type, ResultType, Args...>(data, std::forward<Args>(args)...);
+        }
+
         if (v1->is_nullable()) {
             auto col = ColumnHelper::as_raw_column<NullableColumn>(v1);
 
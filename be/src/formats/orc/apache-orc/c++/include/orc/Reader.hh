@@ -197,6 +197,15 @@ namespace orc {
      */
     RowReaderOptions& setEnableLazyDecoding(bool enable);
 
+    /**
+     * Set the top-level columns read lazily, which are not read by next() but by
+     * lazyLoadNext() or skipped by lazyLoadSkip() after it, so that their rows
+     * filtered out by the other columns could be skipped without decoding.
+     * @param names the field names of the lazy load columns
+     * @return returns *this
+     */
+    RowReaderOptions& setLazyLoadColumnNames(const std::list<std::string>& names);
+
     /**
      * Set search argument for predicate push down
      */
@@ -208,6 +217,11 @@ namespace orc {
      */
     bool getEnableLazyDecoding() const;
 
+    /**
+     * Get the field names of the lazy load columns.
+     */
+    const std::list<std::string>& getLazyLoadColumnNames() const;
+
     /**
      * Were the field ids set?
      */
@@ -558,6 +572,23 @@ namespace orc {
      */
     virtual bool next(ColumnVectorBatch& data) = 0;
 
+    /**
+     * Read the next rows of the lazy load columns of the rows returned by the
+     * last next() into the fields of them in the row batch, from the first
+     * element of the fields. The rows of the lazy load columns not read or
+     * skipped are skipped by the next call of next().
+     * @param data the row batch the last next() read into.
+     * @param numValues the number of rows to read
+     */
+    virtual void lazyLoadNext(ColumnVectorBatch& data, uint64_t numValues) = 0;
+
+    /**
+     * Skip the next rows of the lazy load columns of the rows returned by the
+     * last next().
+     * @param numValues the number of rows to skip
+     */
+    virtual void lazyLoadSkip(uint64_t numValues) = 0;
+
     /**
      * Get the row number of the first row in the previously read batch.
      * @return the row number of the previous batch.
@@ -951,7 +951,12 @@ void StringDirectColumnReader::seekToRowGroup(std::unordered_map<uint64_t, Posit
 
 class StructColumnReader : public ColumnReader {
 private:
+    // the children read by next and the indexes of their fields in the row batch
     std::vector<std::unique_ptr<ColumnReader>> children;
+    std::vector<size_t> fieldIndexes;
+    // the children read by lazyLoadNext and the indexes of their fields in the row batch
+    std::vector<std::unique_ptr<ColumnReader>> lazyLoadChildren;
+    std::vector<size_t> lazyLoadFieldIndexes;
 
 public:
     StructColumnReader(const Type& type, StripeStreams& stipe);
@@ -964,6 +969,12 @@ public:
 
     void seekToRowGroup(std::unordered_map<uint64_t, PositionProvider>& positions) override;
 
+    void setLazyLoadColumns(const std::vector<bool>& lazyLoadColumns) override;
+
+    void lazyLoadNext(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull, bool encoded) override;
+
+    void lazyLoadSkip(uint64_t numValues) override;
+
     const size_t size() { return children.size(); }
     ColumnReader* childReaderAt(size_t idx) { return children[idx].get(); }
 
@@ -980,6 +991,7 @@ StructColumnReader::StructColumnReader(const Type& type, StripeStreams& stripe)
         for (unsigned int i = 0; i < type.getSubtypeCount(); ++i) {
             const Type& child = *type.getSubtype(i);
             if (selectedColumns[static_cast<uint64_t>(child.getColumnId())]) {
+                fieldIndexes.push_back(children.size());
                 children.push_back(buildReader(child, stripe));
             }
         }
@@ -997,6 +1009,9 @@ uint64_t StructColumnReader::skip(uint64_t numValues) {
     for (auto& ptr : children) {
         ptr->skip(numValues);
     }
+    for (auto& ptr : lazyLoadChildren) {
+        ptr->skip(numValues);
+    }
     return numValues;
 }
 
@@ -1011,13 +1026,13 @@ void StructColumnReader::nextEncoded(ColumnVectorBatch& rowBatch, uint64_t numVa
 template <bool encoded>
 void StructColumnReader::nextInternal(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull) {
     ColumnReader::next(rowBatch, numValues, notNull);
-    uint64_t i = 0;
     notNull = rowBatch.hasNulls ? rowBatch.notNull.data() : nullptr;
-    for (auto iter = children.begin(); iter != children.end(); ++iter, ++i) {
+    auto& fields = dynamic_cast<StructVectorBatch&>(rowBatch).fields;
+    for (size_t i = 0; i < children.size(); ++i) {
         if (encoded) {
-            (*iter)->nextEncoded(*(dynamic_cast<StructVectorBatch&>(rowBatch).fields[i]), numValues, notNull);
+            children[i]->nextEncoded(*fields[fieldIndexes[i]], numValues, notNull);
         } else {
-            (*iter)->next(*(dynamic_cast<StructVectorBatch&>(rowBatch).fields[i]), numValues, notNull);
+            children[i]->next(*fields[fieldIndexes[i]], numValues, notNull);
         }
     }
 }
@@ -1028,6 +1043,44 @@ void StructColumnReader::seekToRowGroup(std::unordered_map<uint64_t, PositionPro
     for (auto& ptr : children) {
         ptr->seekToRowGroup(positions);
     }
+    for (auto& ptr : lazyLoadChildren) {
+        ptr->seekToRowGroup(positions);
+    }
+}
+
+void StructColumnReader::setLazyLoadColumns(const std::vector<bool>& lazyLoadColumns) {
+    std::vector<std::unique_ptr<ColumnReader>> activeChildren;
+    std::vector<size_t> activeFieldIndexes;
+    for (size_t i = 0; i < children.size(); ++i) {
+        if (lazyLoadColumns[children[i]->getColumnId()]) {
+            lazyLoadFieldIndexes.push_back(fieldIndexes[i]);
+            lazyLoadChildren.push_back(std::move(children[i]));
+        } else {
+            activeFieldIndexes.push_back(fieldIndexes[i]);
+            activeChildren.push_back(std::move(children[i]));
+        }
+    }
+    children = std::move(activeChildren);
+    fieldIndexes = std::move(activeFieldIndexes);
+}
+
+// |notNull| is the mask of the rows of this struct to read, since its own nulls have been read by next.
+void StructColumnReader::lazyLoadNext(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull, bool encoded) {
+    auto& fields = dynamic_cast<StructVectorBatch&>(rowBatch).fields;
+    for (size_t i = 0; i < lazyLoadChildren.size(); ++i) {
+        if (encoded) {
+            lazyLoadChildren[i]->nextEncoded(*fields[lazyLoadFieldIndexes[i]], numValues, notNull);
+        } else {
+            lazyLoadChildren[i]->next(*fields[lazyLoadFieldIndexes[i]], numValues, notNull);
+        }
+    }
+}
+
+// |numValues| is the number of the non-null rows of this struct to skip.
+void StructColumnReader::lazyLoadSkip(uint64_t numValues) {
+    for (auto& ptr : lazyLoadChildren) {
+        ptr->skip(numValues);
+    }
 }
 
 class ListColumnReader : public ColumnReader {
@@ -148,6 +148,28 @@ public:
      */
     virtual void seekToRowGroup(std::unordered_map<uint64_t, PositionProvider>& positions);
 
+    /**
+     * Read the children of a struct of the selected column ids lazily, by
+     * lazyLoadNext and lazyLoadSkip instead of next, nextEncoded and skip.
+     * @param lazyLoadColumns an array which contains true at the column id of
+     *           each lazy load child.
+     */
+    virtual void setLazyLoadColumns(const std::vector<bool>& lazyLoadColumns) {
+        throw NotImplementedYet("setLazyLoadColumns");
+    }
+
+    /**
+     * Read the next group of values of the lazy load children into this rowBatch.
+     */
+    virtual void lazyLoadNext(ColumnVectorBatch& rowBatch, uint64_t numValues, char* notNull, bool encoded) {
+        throw NotImplementedYet("lazyLoadNext");
+    }
+
+    /**
+     * Skip number of specified rows of the lazy load children.
+     */
+    virtual void lazyLoadSkip(uint64_t numValues) { throw NotImplementedYet("lazyLoadSkip"); }
+
     uint64_t getColumnId() { return columnId; }
 };
 
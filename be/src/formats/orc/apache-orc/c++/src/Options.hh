@@ -133,6 +133,7 @@ namespace orc {
     bool throwOnHive11DecimalOverflow;
     int32_t forcedScaleOnHive11Decimal;
     bool enableLazyDecoding;
+    std::list<std::string> lazyLoadColumnNames;
     std::shared_ptr<SearchArgument> sargs;
     std::shared_ptr<RowReaderFilter> filter;
     std::string readerTimezone;
@@ -261,6 +262,15 @@ namespace orc {
     return *this;
   }
 
+  RowReaderOptions& RowReaderOptions::setLazyLoadColumnNames(const std::list<std::string>& names) {
+    privateBits->lazyLoadColumnNames.assign(names.begin(), names.end());
+    return *this;
+  }
+
+  const std::list<std::string>& RowReaderOptions::getLazyLoadColumnNames() const {
+    return privateBits->lazyLoadColumnNames;
+  }
+
   RowReaderOptions& RowReaderOptions::searchArgument(std::unique_ptr<SearchArgument> sargs) {
     privateBits->sargs = std::move(sargs);
     return *this;
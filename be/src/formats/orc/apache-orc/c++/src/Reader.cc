@@ -193,6 +193,11 @@ RowReaderImpl::RowReaderImpl(std::shared_ptr<FileContents> _contents, const RowR
           footer(contents->footer.get()),
           firstRowOfStripe(*contents->pool, 0),
           enableEncodedBlock(opts.getEnableLazyDecoding()),
+          hasLazyLoadColumns(false),
+          lazyLoadBatchRows(0),
+          lazyLoadRowsLeft(0),
+          lazyLoadNotNull(nullptr),
+          pendingSeekRowGroup(-1),
           readerTimezone(getTimezoneByName(opts.getTimezoneName())),
           useWriterTimezone(opts.getUseWriterTimezone()),
           sharedBuffer(*contents->pool, 0) {
@@ -233,6 +238,21 @@ RowReaderImpl::RowReaderImpl(std::shared_ptr<FileContents> _contents, const RowR
     ColumnSelector column_selector(contents.get());
     column_selector.updateSelected(selectedColumns, opts);
 
+    // only the selected top-level columns could be read lazily
+    const auto& lazyLoadNames = opts.getLazyLoadColumnNames();
+    if (!lazyLoadNames.empty()) {
+        const Type& schema = *contents->schema;
+        lazyLoadColumns.assign(selectedColumns.size(), false);
+        std::set<std::string> names(lazyLoadNames.begin(), lazyLoadNames.end());
+        for (uint64_t i = 0; i < schema.getSubtypeCount(); ++i) {
+            uint64_t columnId = schema.getSubtype(i)->getColumnId();
+            if (selectedColumns[columnId] && names.count(schema.getFieldName(i)) > 0) {
+                lazyLoadColumns[columnId] = true;
+                hasLazyLoadColumns = true;
+            }
+        }
+    }
+
     // prepare SargsApplier if SearchArgument is available
     if (opts.getSearchArgument() && footer->rowindexstride() > 0) {
         sargs = opts.getSearchArgument();
@@ -296,6 +316,8 @@ void RowReaderImpl::seekToRow(uint64_t rowNumber) {
         return;
     }
 
+    lazyLoadRowsLeft = 0;
+    pendingSeekRowGroup = -1;
     currentStripe = seekToStripe;
     currentRowInStripe = rowNumber - firstRowOfStripe[currentStripe];
     previousRow = rowNumber;
@@ -925,6 +947,9 @@ void RowReaderImpl::startNextStripe() {
                                             currentStripeInfo.offset(), *contents->stream, writerTimezone,
                                             readerTimezone);
             reader = buildReader(*contents->schema, stripeStreams);
+            if (hasLazyLoadColumns) {
+                reader->setLazyLoadColumns(lazyLoadColumns);
+            }
 
             if (sargsApplier) {
                 if (sargsApplier->getRowReaderFilter()) {
@@ -970,7 +995,11 @@ bool RowReaderImpl::next(ColumnVectorBatch& data) {
         return false;
     }
     if (currentRowInStripe == 0) {
+        lazyLoadRowsLeft = 0;
+        pendingSeekRowGroup = -1;
         startNextStripe();
+    } else if (hasLazyLoadColumns) {
+        finishLazyLoad();
     }
     uint64_t rowsToRead = std::min(static_cast<uint64_t>(data.capacity), rowsInCurrentStripe - currentRowInStripe);
     if (currentStripe >= lastStripe) {
@@ -991,6 +1020,11 @@ bool RowReaderImpl::next(ColumnVectorBatch& data) {
     } else {
         reader->next(data, rowsToRead, nullptr);
     }
+    if (hasLazyLoadColumns) {
+        lazyLoadBatchRows = rowsToRead;
+        lazyLoadRowsLeft = rowsToRead;
+        lazyLoadNotNull = data.hasNulls ? data.notNull.data() : nullptr;
+    }
     // update row number
     previousRow = firstRowOfStripe[currentStripe] + currentRowInStripe;
     currentRowInStripe += rowsToRead;
@@ -1003,7 +1037,13 @@ bool RowReaderImpl::next(ColumnVectorBatch& data) {
             // it is guaranteed to be at start of a row group
             currentRowInStripe = nextRowToRead;
             if (currentRowInStripe < rowsInCurrentStripe) {
-                seekToRowGroup(static_cast<uint32_t>(currentRowInStripe / footer->rowindexstride()));
+                auto rowGroupId = static_cast<uint32_t>(currentRowInStripe / footer->rowindexstride());
+                // the lazy load columns of this batch are still to be read
+                if (hasLazyLoadColumns) {
+                    pendingSeekRowGroup = rowGroupId;
+                } else {
+                    seekToRowGroup(rowGroupId);
+                }
             }
         }
     }
@@ -1015,6 +1055,39 @@ bool RowReaderImpl::next(ColumnVectorBatch& data) {
     return rowsToRead != 0;
 }
 
+void RowReaderImpl::finishLazyLoad() {
+    if (lazyLoadRowsLeft > 0) {
+        lazyLoadSkip(lazyLoadRowsLeft);
+    }
+    if (pendingSeekRowGroup >= 0) {
+        seekToRowGroup(static_cast<uint32_t>(pendingSeekRowGroup));
+        pendingSeekRowGroup = -1;
+    }
+}
+
+void RowReaderImpl::lazyLoadNext(ColumnVectorBatch& data, uint64_t numValues) {
+    if (numValues > lazyLoadRowsLeft) {
+        throw std::logic_error("lazyLoadNext reads more rows than the last batch has");
+    }
+    uint64_t offset = lazyLoadBatchRows - lazyLoadRowsLeft;
+    char* notNull = lazyLoadNotNull == nullptr ? nullptr : data.notNull.data() + offset;
+    reader->lazyLoadNext(data, numValues, notNull, enableEncodedBlock);
+    lazyLoadRowsLeft -= numValues;
+}
+
+void RowReaderImpl::lazyLoadSkip(uint64_t numValues) {
+    if (numValues > lazyLoadRowsLeft) {
+        throw std::logic_error("lazyLoadSkip skips more rows than the last batch has");
+    }
+    uint64_t numNotNull = numValues;
+    if (lazyLoadNotNull != nullptr) {
+        const char* begin = lazyLoadNotNull + (lazyLoadBatchRows - lazyLoadRowsLeft);
+        numNotNull = static_cast<uint64_t>(std::count_if(begin, begin + numValues, [](char c) { return c != 0; }));
+    }
+    reader->lazyLoadSkip(numNotNull);
+    lazyLoadRowsLeft -= numValues;
+}
+
 uint64_t RowReaderImpl::computeBatchSize(uint64_t requestedSize, uint64_t currentRowInStripe,
                                          uint64_t rowsInCurrentStripe, uint64_t rowIndexStride,
                                          const std::vector<bool>& includedRowGroups) {
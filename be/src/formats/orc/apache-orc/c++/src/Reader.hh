@@ -139,6 +139,19 @@ private:
     std::unique_ptr<ColumnReader> reader;
 
     bool enableEncodedBlock;
+
+    // the columns read lazily, by the column id
+    std::vector<bool> lazyLoadColumns;
+    bool hasLazyLoadColumns;
+    // the rows of the lazy load columns of the last batch not read or skipped yet
+    uint64_t lazyLoadBatchRows;
+    uint64_t lazyLoadRowsLeft;
+    const char* lazyLoadNotNull;
+    // the row group to seek to after the lazy load columns of the last batch, -1 if none
+    int64_t pendingSeekRowGroup;
+
+    // Skip the rows of the lazy load columns left and seek to the pending row group
+    void finishLazyLoad();
     // internal methods
     void startNextStripe();
 
@@ -199,6 +212,10 @@ public:
 
     bool next(ColumnVectorBatch& data) override;
 
+    void lazyLoadNext(ColumnVectorBatch& data, uint64_t numValues) override;
+
+    void lazyLoadSkip(uint64_t numValues) override;
+
     CompressionKind getCompression() const;
 
     uint64_t getCompressionSize() const;
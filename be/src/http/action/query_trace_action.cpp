@@ -0,0 +1,42 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "http/action/query_trace_action.h"
+
+#include <string>
+
+#include "common/logging.h"
+#include "exec/pipeline/query_trace.h"
+#include "gutil/strings/substitute.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "util/uid_util.h"
+
+namespace starrocks {
+
+const static std::string HEADER_JSON = "application/json";
+
+void QueryTraceAction::handle(HttpRequest* req) {
+    LOG(INFO) << req->debug_string();
+
+    // The query id printed by print_id, i.e. <hi>-<lo> in hex.
+    const std::string& query_id_str = req->param("query_id");
+    auto pos = query_id_str.find('-');
+    if (pos == std::string::npos) {
+        HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST,
+                                strings::Substitute("invalid query_id '$0', expected <hi>-<lo>", query_id_str));
+        return;
+    }
+    TUniqueId query_id = UniqueId(query_id_str.substr(0, pos), query_id_str.substr(pos + 1)).to_thrift();
+    auto trace = pipeline::QueryTraceManager::instance()->get(query_id);
+    if (trace == nullptr) {
+        HttpChannel::send_reply(req, HttpStatus::NOT_FOUND,
+                                strings::Substitute("query $0 isn't traced, see enable_query_trace", query_id_str));
+        return;
+    }
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    HttpChannel::send_reply(req, HttpStatus::OK, trace->to_chrome_json());
+}
+
+} // namespace starrocks
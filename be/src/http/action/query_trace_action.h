@@ -0,0 +1,20 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "http/http_handler.h"
+
+namespace starrocks {
+
+// Get the timeline of a query traced by this BE, in the Chrome trace event format, by
+// /api/query_trace?query_id=<hi>-<lo>. Only traced if enable_query_trace.
+class QueryTraceAction : public HttpHandler {
+public:
+    QueryTraceAction() = default;
+
+    ~QueryTraceAction() override = default;
+
+    void handle(HttpRequest* req) override;
+};
+
+} // namespace starrocks
@@ -0,0 +1,100 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "http/action/sampling_profile_action.h"
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+
+#include "common/logging.h"
+#include "exec/pipeline/resource_group.h"
+#include "gutil/strings/substitute.h"
+#include "http/http_channel.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "runtime/exec_env.h"
+#include "util/bfd_parser.h"
+#include "util/sampling_profiler.h"
+#include "util/uid_util.h"
+
+namespace starrocks {
+
+void SamplingProfileAction::handle(HttpRequest* req) {
+    LOG(INFO) << req->debug_string();
+
+    auto* profiler = SamplingProfiler::instance();
+    if (!profiler->is_running()) {
+        HttpChannel::send_reply(req, HttpStatus::SERVICE_UNAVAILABLE,
+                                "The sampling profiler isn't running, see enable_sampling_profiler");
+        return;
+    }
+
+    SamplingProfiler::Filter filter;
+    const std::string& seconds_str = req->param("seconds");
+    if (!seconds_str.empty()) {
+        filter.seconds = std::atoll(seconds_str.c_str());
+    }
+    const std::string& query_id_str = req->param("query_id");
+    if (!query_id_str.empty()) {
+        auto pos = query_id_str.find('-');
+        if (pos == std::string::npos) {
+            HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST,
+                                    strings::Substitute("invalid query_id '$0', expected <hi>-<lo>", query_id_str));
+            return;
+        }
+        UniqueId query_id(query_id_str.substr(0, pos), query_id_str.substr(pos + 1));
+        filter.has_query_id = true;
+        filter.query_id_hi = query_id.hi;
+        filter.query_id_lo = query_id.lo;
+    }
+    const std::string& group_name = req->param("resource_group");
+    if (!group_name.empty()) {
+        auto* group = pipeline::ResourceGroupManager::instance()->get(group_name);
+        if (group->name() != group_name) {
+            HttpChannel::send_reply(req, HttpStatus::BAD_REQUEST,
+                                    strings::Substitute("unknown resource_group '$0'", group_name));
+            return;
+        }
+        filter.resource_group_id = group->id();
+    }
+
+    // The frames repeat among the stacks, so each address is only decoded once.
+    std::unordered_map<void*, std::string> names;
+    auto frame_name = [this, &names](void* frame) -> const std::string& {
+        auto [it, inserted] = names.emplace(frame, "");
+        if (inserted) {
+            // The return address is after the call.
+            char address[32];
+            snprintf(address, sizeof(address), "0x%lx", reinterpret_cast<uintptr_t>(frame) - 1);
+            std::string file_name;
+            const char* end = nullptr;
+            unsigned int lineno = 0;
+            if (_exec_env->bfd_parser() == nullptr ||
+                _exec_env->bfd_parser()->decode_address(address, &end, &file_name, &it->second, &lineno) !=
+                        0) {
+                it->second = address;
+            }
+        }
+        return it->second;
+    };
+
+    std::string result;
+    for (const auto& stack : profiler->stacks(filter)) {
+        if (!filter.has_query_id) {
+            result.append(stack.query_id_hi == 0 && stack.query_id_lo == 0
+                                  ? "no_query"
+                                  : print_id(UniqueId(stack.query_id_hi, stack.query_id_lo).to_thrift()));
+            result.push_back(';');
+        }
+        // From the root to the leaf.
+        for (auto it = stack.frames.rbegin(); it != stack.frames.rend(); ++it) {
+            result.append(frame_name(*it));
+            result.push_back(it + 1 == stack.frames.rend() ? ' ' : ';');
+        }
+        result.append(std::to_string(stack.count));
+        result.push_back('\n');
+    }
+    HttpChannel::send_reply(req, HttpStatus::OK, result);
+}
+
+} // namespace starrocks
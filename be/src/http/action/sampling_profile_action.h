@@ -0,0 +1,29 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "http/http_handler.h"
+
+namespace starrocks {
+
+class ExecEnv;
+
+// Get the stacks sampled by the SamplingProfiler in the folded format of the flame graph tools, i.e. one
+// "root;...;leaf count" line per stack, by /api/sampling_profile with the optional parameters:
+//   seconds: the samples of the last seconds, 60 by default.
+//   query_id: the samples of the query <hi>-<lo>, otherwise of all the queries, the root frames of which are
+//             the ids of their queries.
+//   resource_group: the samples of the drivers of the resource group.
+class SamplingProfileAction : public HttpHandler {
+public:
+    explicit SamplingProfileAction(ExecEnv* exec_env) : _exec_env(exec_env) {}
+
+    ~SamplingProfileAction() override = default;
+
+    void handle(HttpRequest* req) override;
+
+private:
+    ExecEnv* _exec_env;
+};
+
+} // namespace starrocks
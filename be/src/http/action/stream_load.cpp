@@ -55,6 +55,7 @@
 #include "util/byte_buffer.h"
 #include "util/debug_util.h"
 #include "util/json_util.h"
+#include "util/load_stage_metrics.h"
 #include "util/metrics.h"
 #include "util/starrocks_metrics.h"
 #include "util/thrift_rpc_helper.h"
@@ -151,6 +152,10 @@ void StreamLoadAction::handle(HttpRequest* req) {
     streaming_load_duration_ms.increment(ctx->load_cost_nanos / 1000000);
     streaming_load_bytes.increment(ctx->receive_bytes);
     streaming_load_current_processing.increment(-1);
+    LoadStageMetrics::add(LoadStageMetrics::RECEIVE, ctx->read_data_cost_nanos);
+    if (ctx->status.ok()) {
+        LoadStageMetrics::add(LoadStageMetrics::COMMIT_PUBLISH, ctx->commit_and_publish_txn_cost_nanos);
+    }
 }
 
 Status StreamLoadAction::_handle(StreamLoadContext* ctx) {
@@ -25,14 +25,17 @@
 #include <gutil/strings/numbers.h>
 #include <gutil/strings/substitute.h>
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <sstream>
 
+#include "common/config.h"
 #include "common/configbase.h"
 #include "http/web_page_handler.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
 #include "util/debug_util.h"
+#include "util/lock_profiler.h"
 #include "util/pretty_printer.h"
 
 namespace starrocks {
@@ -185,6 +188,27 @@ void mem_usage_handler(MemTracker* mem_tracker, const WebPageHandler::ArgumentMa
 #endif
 }
 
+// Registered to handle "/locks", and prints out the contention of the profiled locks, the most waited first.
+void locks_handler(const WebPageHandler::ArgumentMap& args, std::stringstream* output) {
+    std::vector<LockSite*> sites = LockSite::all();
+    std::sort(sites.begin(), sites.end(), [](LockSite* a, LockSite* b) { return a->wait_ns() > b->wait_ns(); });
+
+    (*output) << "<h2>Lock Contention</h2>\n";
+    (*output) << "<p>The wait time is estimated from one of every " << config::lock_contention_sample_period
+              << " contended acquisitions of each thread.</p>\n";
+    (*output) << "<table data-toggle='table' data-pagination='true' data-search='true' "
+                 "class='table table-striped'>\n";
+    (*output) << "<thead><tr><th data-sortable='true'>Lock</th><th data-sortable='true'>Contentions</th>"
+                 "<th data-sortable='true'>Wait Time</th><th data-sortable='true'>Max Sampled Wait Time</th>"
+                 "</tr></thead>\n<tbody>\n";
+    for (auto* site : sites) {
+        (*output) << strings::Substitute("<tr><td>$0</td><td>$1</td><td>$2</td><td>$3</td></tr>\n", site->name(),
+                                         site->contentions(), PrettyPrinter::print(site->wait_ns(), TUnit::TIME_NS),
+                                         PrettyPrinter::print(site->max_wait_ns(), TUnit::TIME_NS));
+    }
+    (*output) << "</tbody></table>\n";
+}
+
 void add_default_path_handlers(WebPageHandler* web_page_handler, MemTracker* process_mem_tracker) {
     // TODO(yingchun): logs_handler is not implemented yet, so not show it on navigate bar
     web_page_handler->register_page("/logs", "Logs", logs_handler, false /* is_on_nav_bar */);
@@ -197,6 +221,7 @@ void add_default_path_handlers(WebPageHandler* web_page_handler, MemTracker* pro
             "/mem_tracker", "MemTracker",
             std::bind<void>(&mem_tracker_handler, process_mem_tracker, std::placeholders::_1, std::placeholders::_2),
             true);
+    web_page_handler->register_page("/locks", "Locks", locks_handler, true /* is_on_nav_bar */);
 }
 
 } // namespace starrocks
@@ -45,6 +45,7 @@ const std::string FILE_PARAMETER = "file";
 const std::string DB_PARAMETER = "db";
 const std::string LABEL_PARAMETER = "label";
 const std::string TOKEN_PARAMETER = "token";
+const std::string CHECKSUM_PARAMETER = "checksum";
 
 DownloadAction::DownloadAction(ExecEnv* exec_env, const std::vector<std::string>& allow_dirs)
         : _exec_env(exec_env), _download_type(NORMAL) {
@@ -82,6 +83,16 @@ void DownloadAction::handle_normal(HttpRequest* req, const std::string& file_par
 
     if (FileUtils::is_dir(file_param)) {
         do_dir_response(file_param, req);
+    } else if (req->param(CHECKSUM_PARAMETER) == "md5") {
+        // Reply the md5sum of the file rather than its content, for a clone to verify the file it downloaded.
+        std::string md5sum;
+        status = FileUtils::md5sum(file_param, &md5sum);
+        if (!status.ok()) {
+            LOG(WARNING) << "Failed to calculate the md5sum of " << file_param << ": " << status.to_string();
+            HttpChannel::send_error(req, HttpStatus::INTERNAL_SERVER_ERROR);
+            return;
+        }
+        HttpChannel::send_reply(req, md5sum);
     } else {
         do_file_response(file_param, req);
     }
@@ -4,22 +4,21 @@
 
 #include "common/logging.h"
 #include "runtime/current_thread.h"
+#include "runtime/mem_hook.h"
 #include "runtime/mem_tracker.h"
 
 namespace starrocks {
 class CurrentMemTracker {
 public:
     inline static void consume(int64_t size) {
-        MemTracker* tracker = CurrentThread::mem_tracker();
-        if (tracker != nullptr && size != 0) {
-            tracker->consume(size);
+        if (!is_mem_hook_enabled()) {
+            CurrentThread::mem_consume(size);
         }
     }
 
     inline static void release(int64_t size) {
-        MemTracker* tracker = CurrentThread::mem_tracker();
-        if (tracker != nullptr && size != 0) {
-            tracker->release(size);
+        if (!is_mem_hook_enabled()) {
+            CurrentThread::mem_release(size);
         }
     }
 };
@@ -0,0 +1,26 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/current_thread.h"
+
+#include "runtime/mem_tracker.h"
+
+namespace starrocks {
+
+starrocks::MemTracker* CurrentThread::set_mem_tracker(starrocks::MemTracker* tracker) {
+    auto* r = s_tls_mem_tracker;
+    if (r != tracker) {
+        mem_tracker_flush();
+    }
+    s_tls_mem_tracker = tracker;
+    return r;
+}
+
+void CurrentThread::mem_tracker_flush() {
+    int64_t size = s_tls_untracked_mem_bytes;
+    s_tls_untracked_mem_bytes = 0;
+    if (s_tls_mem_tracker != nullptr && size != 0) {
+        s_tls_mem_tracker->consume(size);
+    }
+}
+
+} // namespace starrocks
@@ -20,21 +20,72 @@ public:
     static const starrocks::TUniqueId& query_id();
     static const std::string& query_id_string();
 
-    // Return old memory tracker.
+    // The query and the resource group this thread is working for, which tag the samples of the SamplingProfiler.
+    // They are kept as plain thread locals to be read by its signal handler, and are cheap to set per driver.
+    // set_query_id sets the query as well.
+    static void set_sampling_tags(const starrocks::TUniqueId& query_id, int64_t resource_group_id);
+    static void clear_sampling_tags() { set_sampling_tags(starrocks::TUniqueId(), -1); }
+    static void get_sampling_tags(int64_t* query_id_hi, int64_t* query_id_lo, int64_t* resource_group_id);
+
+    // Return old memory tracker. The memory not yet counted by the old tracker is flushed into it.
     static starrocks::MemTracker* set_mem_tracker(starrocks::MemTracker* tracker);
     // Return current memory tracker in this thread.
     static starrocks::MemTracker* mem_tracker();
 
+    // Count |size| bytes into the memory tracker of this thread. The bytes are accumulated in a thread local delta,
+    // which is flushed into the tracker and its ancestors once it exceeds kMemTrackerBatchBytes, so that the threads
+    // don't contend on the atomics of the query and process trackers at every small allocation. The consumption of
+    // the trackers may lag behind by up to kMemTrackerBatchBytes for every thread.
+    static void mem_consume(int64_t size);
+    static void mem_release(int64_t size) { mem_consume(-size); }
+    // Flush the delta into the memory tracker of this thread, e.g. before the tracker is destroyed.
+    static void mem_tracker_flush();
+
 private:
+    static constexpr int64_t kMemTrackerBatchBytes = 1024 * 1024;
+
     // `__thread` is faster than `thread_local`.
     static inline __thread starrocks::MemTracker* s_tls_mem_tracker{nullptr}; // NOLINT
+    static inline __thread int64_t s_tls_untracked_mem_bytes{0};              // NOLINT
     static inline thread_local starrocks::TUniqueId s_tls_query_id{};         // NOLINT
     static inline thread_local std::string s_tls_str_query_id{};              // NOLINT
+    static inline __thread int64_t s_tls_sampling_query_id_hi{0};             // NOLINT
+    static inline __thread int64_t s_tls_sampling_query_id_lo{0};             // NOLINT
+    static inline __thread int64_t s_tls_sampling_resource_group_id{-1};      // NOLINT
+};
+
+// ScopedThreadLocalMemTracker sets the memory tracker of this thread in its scope, e.g. for a fragment or a driver
+// running on a thread of a pool, and restores the old one at the end, which flushes the delta into the tracker.
+class ScopedThreadLocalMemTracker {
+public:
+    explicit ScopedThreadLocalMemTracker(starrocks::MemTracker* tracker)
+            : _prev(CurrentThread::set_mem_tracker(tracker)) {}
+    ~ScopedThreadLocalMemTracker() { CurrentThread::set_mem_tracker(_prev); }
+
+    ScopedThreadLocalMemTracker(const ScopedThreadLocalMemTracker&) = delete;
+    ScopedThreadLocalMemTracker& operator=(const ScopedThreadLocalMemTracker&) = delete;
+
+private:
+    starrocks::MemTracker* _prev;
 };
 
 inline void CurrentThread::set_query_id(const starrocks::TUniqueId& query_id) {
     s_tls_query_id = query_id;
     s_tls_str_query_id = starrocks::print_id(query_id);
+    s_tls_sampling_query_id_hi = query_id.hi;
+    s_tls_sampling_query_id_lo = query_id.lo;
+}
+
+inline void CurrentThread::set_sampling_tags(const starrocks::TUniqueId& query_id, int64_t resource_group_id) {
+    s_tls_sampling_query_id_hi = query_id.hi;
+    s_tls_sampling_query_id_lo = query_id.lo;
+    s_tls_sampling_resource_group_id = resource_group_id;
+}
+
+inline void CurrentThread::get_sampling_tags(int64_t* query_id_hi, int64_t* query_id_lo, int64_t* resource_group_id) {
+    *query_id_hi = s_tls_sampling_query_id_hi;
+    *query_id_lo = s_tls_sampling_query_id_lo;
+    *resource_group_id = s_tls_sampling_resource_group_id;
 }
 
 inline const starrocks::TUniqueId& CurrentThread::query_id() {
@@ -45,14 +96,18 @@ inline const std::string& CurrentThread::query_id_string() {
     return s_tls_str_query_id;
 }
 
-inline starrocks::MemTracker* CurrentThread::set_mem_tracker(starrocks::MemTracker* tracker) {
-    auto* r = s_tls_mem_tracker;
-    s_tls_mem_tracker = tracker;
-    return r;
-}
-
 inline starrocks::MemTracker* CurrentThread::mem_tracker() {
     return s_tls_mem_tracker;
 }
 
+inline void CurrentThread::mem_consume(int64_t size) {
+    if (s_tls_mem_tracker == nullptr) {
+        return;
+    }
+    s_tls_untracked_mem_bytes += size;
+    if (s_tls_untracked_mem_bytes >= kMemTrackerBatchBytes || s_tls_untracked_mem_bytes <= -kMemTrackerBatchBytes) {
+        mem_tracker_flush();
+    }
+}
+
 } // namespace starrocks
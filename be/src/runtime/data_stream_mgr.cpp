@@ -24,6 +24,7 @@
 #include <boost/thread/thread.hpp>
 #include <iostream>
 
+#include "column/chunk.h"
 #include "gen_cpp/InternalService_types.h"
 #include "gen_cpp/types.pb.h" // PUniqueId
 #include "runtime/data_stream_recvr.h"
@@ -128,7 +129,8 @@ Status DataStreamMgr::transmit_data(const PTransmitDataParams* request, ::google
     return Status::OK();
 }
 
-Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done) {
+Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, butil::IOBuf* attachment,
+                                     int64_t* credit_bytes, ::google::protobuf::Closure** done) {
     const PUniqueId& finst_id = request.finst_id();
     // TODO(zc): Use PUniqueId directly
     // We can use PUniqueId directly, because old version StarRocks has already use
@@ -156,11 +158,39 @@ Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::goog
     }
 
     bool eos = request.eos();
+    if (request.use_credit() && request.chunks_size() == 0 && !eos) {
+        // The sender asks for the credit, which is granted once the response is sent.
+        recvr->wait_for_credit(request.sender_id(), done);
+        return Status::OK();
+    }
     if (request.chunks_size() > 0) {
-        RETURN_IF_ERROR(recvr->add_chunks(request, eos ? nullptr : done));
+        // The sender of use_credit doesn't send more than its credit, instead of the response being withheld.
+        RETURN_IF_ERROR(recvr->add_chunks(request, attachment, eos || request.use_credit() ? nullptr : done));
     }
     if (eos) {
         recvr->remove_sender(request.sender_id(), request.be_number());
+    } else if (request.use_credit()) {
+        *credit_bytes = recvr->credit_bytes();
+    }
+    return Status::OK();
+}
+
+Status DataStreamMgr::transmit_chunk_local(const TUniqueId& fragment_instance_id, PlanNodeId node_id, int sender_id,
+                                           int be_number, vectorized::ChunkUniquePtr chunk, bool eos,
+                                           const PQueryStatistics* statistics, ::google::protobuf::Closure** done) {
+    std::shared_ptr<DataStreamRecvr> recvr = find_recvr(fragment_instance_id, node_id);
+    if (recvr == nullptr) {
+        // The receiver may have been deregistered, see transmit_chunk.
+        return Status::OK();
+    }
+    if (statistics != nullptr) {
+        recvr->add_sub_plan_statistics(*statistics, sender_id);
+    }
+    if (chunk != nullptr && chunk->num_rows() > 0) {
+        recvr->add_chunk_local(sender_id, be_number, std::move(chunk), eos ? nullptr : done);
+    }
+    if (eos) {
+        recvr->remove_sender(sender_id, be_number);
     }
     return Status::OK();
 }
@@ -28,6 +28,7 @@
 #include <mutex>
 #include <set>
 
+#include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "gen_cpp/Types_types.h" // for TUniqueId
@@ -43,6 +44,10 @@ class Closure;
 }
 } // namespace google
 
+namespace butil {
+class IOBuf;
+}
+
 namespace starrocks {
 
 class DescriptorTbl;
@@ -84,7 +89,16 @@ public:
 
     Status transmit_data(const PTransmitDataParams* request, ::google::protobuf::Closure** done);
 
-    Status transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    // The data of the chunks of |request| are in |attachment| in order if it is not empty, which are cut from it.
+    // The credit of the sender of use_credit is set in |credit_bytes|, which is left as is if it is not granted.
+    Status transmit_chunk(const PTransmitChunkParams& request, butil::IOBuf* attachment, int64_t* credit_bytes,
+                          ::google::protobuf::Closure** done);
+
+    // Like transmit_chunk, but for the sender on this backend, which passes the chunk, nullptr for none, and the
+    // query statistics, nullptr for none, to the receiver in process.
+    Status transmit_chunk_local(const TUniqueId& fragment_instance_id, PlanNodeId node_id, int sender_id,
+                                int be_number, vectorized::ChunkUniquePtr chunk, bool eos,
+                                const PQueryStatistics* statistics, ::google::protobuf::Closure** done);
     // Closes all receivers registered for fragment_instance_id immediately.
     void cancel(const TUniqueId& fragment_instance_id);
 
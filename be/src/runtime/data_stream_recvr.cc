@@ -21,6 +21,7 @@
 
 #include "runtime/data_stream_recvr.h"
 
+#include <butil/iobuf.h>
 #include <google/protobuf/stubs/common.h>
 
 #include <condition_variable>
@@ -30,8 +31,10 @@
 #include <utility>
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "gen_cpp/data.pb.h"
 #include "runtime/data_stream_mgr.h"
+#include "runtime/exec_env.h"
 #include "runtime/row_batch.h"
 #include "runtime/sorted_run_merger.h"
 #include "runtime/vectorized/sorted_chunks_merger.h"
@@ -78,7 +81,14 @@ public:
     // blocks if this will make the stream exceed its buffer limit.
     // If the total size of the chunks in this queue would exceed the allowed buffer size,
     // the queue is considered full and the call blocks until a chunk is dequeued.
-    Status add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    Status add_chunks(const PTransmitChunkParams& request, butil::IOBuf* attachment,
+                      ::google::protobuf::Closure** done);
+
+    // Adds the chunk of the sender on the same backend as is, like add_chunks.
+    void add_chunk_local(int be_number, ChunkUniquePtr chunk, ::google::protobuf::Closure** done);
+
+    // Withholds |done| till a chunk is taken if the receiver has no credit and the queue is not empty.
+    void wait_for_credit(::google::protobuf::Closure** done);
 
     // Decrement the number of remaining senders for this queue and signal eos ("new data")
     // if the count drops to 0. The number of senders will be 1 for a merging
@@ -101,7 +111,9 @@ public:
 
 private:
     Status _build_chunk_meta(const ChunkPB& pb_chunk);
-    Status _deserialize_chunk(const ChunkPB& pchunk, vectorized::Chunk* chunk, faststring* uncompressed_buffer);
+    // |data| is the data of |pchunk|.
+    Status _deserialize_chunk(const ChunkPB& pchunk, const Slice& data, vectorized::Chunk* chunk,
+                              faststring* uncompressed_buffer);
 
     // Receiver of which this queue is a member.
     DataStreamRecvr* _recvr;
@@ -360,7 +372,19 @@ Status DataStreamRecvr::SenderQueue::_build_chunk_meta(const ChunkPB& pb_chunk)
     return Status::OK();
 }
 
-Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& request,
+// The chunk data in |buf| in place if it is in a single block, which is the common case of the small chunks,
+// otherwise copied into |buffer| once.
+static Slice contiguous_data(const butil::IOBuf& buf, faststring* buffer) {
+    if (buf.backing_block_num() == 1) {
+        butil::StringPiece block = buf.backing_block(0);
+        return {block.data(), block.size()};
+    }
+    buffer->resize(buf.size());
+    buf.copy_to(buffer->data(), buf.size());
+    return {buffer->data(), buffer->size()};
+}
+
+Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& request, butil::IOBuf* attachment,
                                                 ::google::protobuf::Closure** done) {
     DCHECK(request.chunks_size() > 0);
 
@@ -406,10 +430,21 @@ Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& requ
     ChunkQueue chunks;
     size_t total_chunk_bytes = 0;
     faststring uncompressed_buffer;
+    const bool in_attachment = attachment != nullptr && !attachment->empty();
+    butil::IOBuf chunk_data;
+    faststring chunk_data_buffer;
     for (auto& pchunk : request.chunks()) {
-        size_t chunk_bytes = pchunk.data().size();
+        Slice data(pchunk.data());
+        if (in_attachment) {
+            chunk_data.clear();
+            if (attachment->cutn(&chunk_data, pchunk.data_size()) != pchunk.data_size()) {
+                return Status::InternalError("chunk data is missing in the attachment");
+            }
+            data = contiguous_data(chunk_data, &chunk_data_buffer);
+        }
+        size_t chunk_bytes = data.size;
         ChunkUniquePtr chunk = std::make_unique<vectorized::Chunk>();
-        RETURN_IF_ERROR(_deserialize_chunk(pchunk, chunk.get(), &uncompressed_buffer));
+        RETURN_IF_ERROR(_deserialize_chunk(pchunk, data, chunk.get(), &uncompressed_buffer));
 
         // TODO(zc): review this chunk_bytes
         chunks.emplace_back(chunk_bytes, std::move(chunk));
@@ -436,14 +471,56 @@ Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& requ
         _recvr->_num_buffered_bytes += total_chunk_bytes;
     }
     _data_arrival_cv.notify_one();
+    _recvr->_notify_data_arrival();
     return Status::OK();
 }
 
-Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, vectorized::Chunk* chunk,
-                                                        faststring* uncompressed_buffer) {
+void DataStreamRecvr::SenderQueue::add_chunk_local(int be_number, ChunkUniquePtr chunk,
+                                                   ::google::protobuf::Closure** done) {
+    // The chunk is charged by its memory, in place of its serialized size.
+    size_t chunk_bytes = chunk->memory_usage();
+    COUNTER_UPDATE(_recvr->_bytes_received_counter, chunk_bytes);
+    ScopedTimer<MonotonicStopWatch> wait_timer(_recvr->_sender_wait_lock_timer);
+    {
+        std::unique_lock<std::mutex> l(_lock);
+        wait_timer.stop();
+        if (_is_cancelled) {
+            return;
+        }
+        if (_num_remaining_senders <= 0) {
+            DCHECK(_sender_eos_set.end() != _sender_eos_set.find(be_number));
+            return;
+        }
+
+        _chunk_queue.emplace_back(chunk_bytes, std::move(chunk));
+        // if done is nullptr, this function can't delay this response
+        if (done != nullptr && _recvr->exceeds_limit(chunk_bytes)) {
+            MonotonicStopWatch monotonicStopWatch;
+            DCHECK(*done != nullptr);
+            _pending_closures.emplace_back(*done, monotonicStopWatch);
+            *done = nullptr;
+        }
+        _recvr->_num_buffered_bytes += chunk_bytes;
+    }
+    _data_arrival_cv.notify_one();
+    _recvr->_notify_data_arrival();
+}
+
+void DataStreamRecvr::SenderQueue::wait_for_credit(::google::protobuf::Closure** done) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (_is_cancelled || _chunk_queue.empty() || _recvr->credit_bytes() > 0) {
+        return;
+    }
+    MonotonicStopWatch monotonicStopWatch;
+    _pending_closures.emplace_back(*done, monotonicStopWatch);
+    *done = nullptr;
+}
+
+Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, const Slice& data,
+                                                        vectorized::Chunk* chunk, faststring* uncompressed_buffer) {
     if (pchunk.compress_type() == CompressionTypePB::NO_COMPRESSION) {
         SCOPED_TIMER(_recvr->_deserialize_row_batch_timer);
-        RETURN_IF_ERROR(chunk->deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta));
+        RETURN_IF_ERROR(chunk->deserialize((const uint8_t*)data.data, data.size, _chunk_meta));
     } else {
         size_t uncompressed_size = 0;
         {
@@ -453,7 +530,7 @@ Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, v
             uncompressed_size = pchunk.uncompressed_size();
             uncompressed_buffer->resize(uncompressed_size);
             Slice output{uncompressed_buffer->data(), uncompressed_size};
-            RETURN_IF_ERROR(codec->decompress(pchunk.data(), &output));
+            RETURN_IF_ERROR(codec->decompress(data, &output));
         }
         {
             SCOPED_TIMER(_recvr->_deserialize_row_batch_timer);
@@ -464,18 +541,23 @@ Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, v
 }
 
 void DataStreamRecvr::SenderQueue::decrement_senders(int be_number) {
-    std::lock_guard<std::mutex> l(_lock);
-    if (_sender_eos_set.end() != _sender_eos_set.find(be_number)) {
-        return;
-    }
-    _sender_eos_set.insert(be_number);
-    DCHECK_GT(_num_remaining_senders, 0);
-    _num_remaining_senders--;
-    VLOG_FILE << "decremented senders: fragment_instance_id=" << _recvr->fragment_instance_id()
-              << " node_id=" << _recvr->dest_node_id() << " #senders=" << _num_remaining_senders;
-    if (_num_remaining_senders == 0) {
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        if (_sender_eos_set.end() != _sender_eos_set.find(be_number)) {
+            return;
+        }
+        _sender_eos_set.insert(be_number);
+        DCHECK_GT(_num_remaining_senders, 0);
+        _num_remaining_senders--;
+        VLOG_FILE << "decremented senders: fragment_instance_id=" << _recvr->fragment_instance_id()
+                  << " node_id=" << _recvr->dest_node_id() << " #senders=" << _num_remaining_senders;
+        if (_num_remaining_senders != 0) {
+            return;
+        }
         _data_arrival_cv.notify_one();
     }
+    // Notify out of _lock, the notified driver may check has_output() and is_finished() at once.
+    _recvr->_notify_data_arrival();
 }
 
 void DataStreamRecvr::SenderQueue::cancel() {
@@ -491,6 +573,7 @@ void DataStreamRecvr::SenderQueue::cancel() {
     // Wake up all threads waiting to produce/consume batches.  They will all
     // notice that the stream is cancelled and handle it.
     _data_arrival_cv.notify_all();
+    _recvr->_notify_data_arrival();
 
     {
         std::lock_guard<std::mutex> l(_lock);
@@ -514,6 +597,8 @@ void DataStreamRecvr::SenderQueue::close() {
         }
         _pending_closures.clear();
     }
+    // Wake up the mergers of the groups of the senders waiting for the chunks.
+    _data_arrival_cv.notify_all();
 
     // Delete any batches queued in _batch_queue
     for (RowBatchQueue::iterator it = _batch_queue.begin(); it != _batch_queue.end(); ++it) {
@@ -542,13 +627,17 @@ Status DataStreamRecvr::create_merger(const TupleRowComparator& less_than) {
 Status DataStreamRecvr::create_merger(const SortExecExprs* exprs, const std::vector<bool>* is_asc,
                                       const std::vector<bool>* is_null_first) {
     DCHECK(_is_merging);
-    _chunks_merger = std::make_unique<vectorized::SortedChunksMerger>();
+    _chunks_merger = std::make_unique<vectorized::ParallelSortedChunksMerger>();
     vectorized::ChunkSuppliers chunk_suppliers;
     for (SenderQueue* q : _sender_queues) {
         auto f = [q](vectorized::Chunk** chunk) -> Status { return q->get_chunk(chunk); };
         chunk_suppliers.emplace_back(std::move(f));
     }
-    RETURN_IF_ERROR(_chunks_merger->init(chunk_suppliers, &(exprs->lhs_ordering_expr_ctxs()), is_asc, is_null_first));
+    // The lhs ordering exprs are the slot refs of the materialized sort tuple, which the groups of the senders may
+    // evaluate concurrently.
+    RETURN_IF_ERROR(_chunks_merger->init(chunk_suppliers, &(exprs->lhs_ordering_expr_ctxs()), is_asc, is_null_first,
+                                         std::max(config::exchange_merge_senders_per_group, 0),
+                                         ExecEnv::GetInstance()->exchange_merge_thread_pool()));
     _chunks_merger->set_profile(_profile.get());
     return Status::OK();
 }
@@ -569,6 +658,7 @@ DataStreamRecvr::DataStreamRecvr(DataStreamMgr* stream_mgr, MemTracker* parent_t
           _fragment_instance_id(fragment_instance_id),
           _dest_node_id(dest_node_id),
           _total_buffer_limit(total_buffer_limit),
+          _num_senders(std::max(num_senders, 1)),
           _row_desc(row_desc),
           _is_merging(is_merging),
           _num_buffered_bytes(0),
@@ -622,12 +712,32 @@ void DataStreamRecvr::add_batch(const PRowBatch& batch, int sender_id, int be_nu
     _sender_queues[use_sender_id]->add_batch(batch, be_number, packet_seq, done);
 }
 
-Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done) {
+Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, butil::IOBuf* attachment,
+                                   ::google::protobuf::Closure** done) {
     SCOPED_TIMER(_sender_total_timer);
     COUNTER_UPDATE(_request_received_counter, 1);
     int use_sender_id = _is_merging ? request.sender_id() : 0;
     // Add all batches to the same queue if _is_merging is false.
-    return _sender_queues[use_sender_id]->add_chunks(request, done);
+    return _sender_queues[use_sender_id]->add_chunks(request, attachment, done);
+}
+
+void DataStreamRecvr::add_chunk_local(int sender_id, int be_number, ChunkUniquePtr chunk,
+                                      ::google::protobuf::Closure** done) {
+    SCOPED_TIMER(_sender_total_timer);
+    COUNTER_UPDATE(_request_received_counter, 1);
+    int use_sender_id = _is_merging ? sender_id : 0;
+    // Add all chunks to the same queue if _is_merging is false.
+    _sender_queues[use_sender_id]->add_chunk_local(be_number, std::move(chunk), done);
+}
+
+int64_t DataStreamRecvr::credit_bytes() const {
+    int64_t free_bytes = static_cast<int64_t>(_total_buffer_limit) - _num_buffered_bytes;
+    return free_bytes <= 0 ? 0 : std::max<int64_t>(1, free_bytes / _num_senders);
+}
+
+void DataStreamRecvr::wait_for_credit(int sender_id, ::google::protobuf::Closure** done) {
+    int use_sender_id = _is_merging ? sender_id : 0;
+    _sender_queues[use_sender_id]->wait_for_credit(done);
 }
 
 void DataStreamRecvr::remove_sender(int sender_id, int be_number) {
@@ -674,6 +784,18 @@ Status DataStreamRecvr::get_chunk(std::unique_ptr<vectorized::Chunk>* chunk) {
     return status;
 }
 
+void DataStreamRecvr::set_data_arrival_notifier(std::function<void()> notifier) {
+    std::lock_guard<std::mutex> l(_notifier_lock);
+    _data_arrival_notifier = std::move(notifier);
+}
+
+void DataStreamRecvr::_notify_data_arrival() {
+    std::lock_guard<std::mutex> l(_notifier_lock);
+    if (_data_arrival_notifier) {
+        _data_arrival_notifier();
+    }
+}
+
 bool DataStreamRecvr::has_output() const {
     DCHECK(!_is_merging);
     return _sender_queues[0]->has_output();
@@ -22,6 +22,9 @@
 #ifndef STARROCKS_BE_SRC_RUNTIME_DATA_STREAM_RECVR_H
 #define STARROCKS_BE_SRC_RUNTIME_DATA_STREAM_RECVR_H
 
+#include <functional>
+#include <mutex>
+
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
 #include "common/status.h"
@@ -36,10 +39,14 @@ class Closure;
 }
 } // namespace google
 
+namespace butil {
+class IOBuf;
+}
+
 namespace starrocks {
 
 namespace vectorized {
-class SortedChunksMerger;
+class ParallelSortedChunksMerger;
 }
 
 class DataStreamMgr;
@@ -120,6 +127,10 @@ public:
 
     bool is_finished() const;
 
+    // Used by the pipeline engine, |notifier| is invoked after chunks arrive, all the senders
+    // close or the stream is cancelled, so that the driver blocked on this receiver is woken up.
+    void set_data_arrival_notifier(std::function<void()> notifier);
+
 private:
     friend class DataStreamMgr;
     class SenderQueue;
@@ -134,7 +145,22 @@ private:
                    ::google::protobuf::Closure** done);
 
     // If receive queue is full, done is enqueue pending, and return with *done is nullptr
-    Status add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    // The data of the chunks are in |attachment| in order if it is not empty, otherwise in the chunks.
+    Status add_chunks(const PTransmitChunkParams& request, butil::IOBuf* attachment,
+                      ::google::protobuf::Closure** done);
+
+    // Add the chunk of the sender on the same backend as is, without serializing it,
+    // with the same flow control as add_chunks.
+    void add_chunk_local(int sender_id, int be_number, vectorized::ChunkUniquePtr chunk,
+                         ::google::protobuf::Closure** done);
+
+    // The credit of a sender of the credit-based flow control, which is its share of the room of the buffer,
+    // 0 if the buffer is full.
+    int64_t credit_bytes() const;
+
+    // Withhold |done| of the request of the sender asking for the credit, till a chunk of its sender queue is taken,
+    // if the buffer is full. It is never withheld if its sender queue is empty, which a merging receiver may wait for.
+    void wait_for_credit(int sender_id, ::google::protobuf::Closure** done);
 
     // Indicate that a particular sender is done. Delegated to the appropriate
     // sender queue. Called from DataStreamMgr.
@@ -158,6 +184,7 @@ private:
     // all sender queues. we stop acking incoming data once the amount of buffered data
     // exceeds this value
     int _total_buffer_limit;
+    const int _num_senders;
 
     // Row schema, copied from the caller of CreateRecvr().
     RowDescriptor _row_desc;
@@ -180,8 +207,8 @@ private:
 
     // SortedRunMerger used to merge rows from different senders.
     std::unique_ptr<SortedRunMerger> _merger;
-    // vectorized::SortedChunksMerger merges chunks from different senders.
-    std::unique_ptr<vectorized::SortedChunksMerger> _chunks_merger;
+    // vectorized::ParallelSortedChunksMerger merges chunks from different senders.
+    std::unique_ptr<vectorized::ParallelSortedChunksMerger> _chunks_merger;
 
     // Pool of sender queues.
     ObjectPool _sender_queue_pool;
@@ -189,6 +216,11 @@ private:
     // Runtime profile storing the counters below.
     std::shared_ptr<RuntimeProfile> _profile;
 
+    void _notify_data_arrival();
+
+    std::mutex _notifier_lock;
+    std::function<void()> _data_arrival_notifier;
+
     // Number of bytes received
     RuntimeProfile::Counter* _bytes_received_counter;
 
@@ -36,23 +36,28 @@
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/Types_types.h"
 #include "runtime/client_cache.h"
+#include "runtime/data_stream_mgr.h"
 #include "runtime/descriptors.h"
 #include "runtime/dpp_sink_internal.h"
+#include "runtime/exchange_spill_buffer.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/raw_value.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "runtime/tuple_row.h"
+#include "service/backend_options.h"
 #include "service/brpc.h"
 #include "util/block_compression.h"
 #include "util/brpc_stub_cache.h"
 #include "util/compression_utils.h"
+#include "util/countdown_latch.h"
 #include "util/debug_util.h"
 #include "util/network_util.h"
 #include "util/ref_count_closure.h"
 #include "util/thrift_client.h"
 #include "util/thrift_util.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -64,6 +69,30 @@ namespace starrocks {
 // at any one time (ie, sending will block if the most recent rpc hasn't finished,
 // which allows the receiver node to throttle the sender by withholding acks).
 // *Not* thread-safe.
+// The closure of the chunk passed to the receiver on this backend in process, which the receiver runs once it
+// takes the chunk, in place of the response of the rpc. It is released by both the sender and the receiver.
+class LocalChunkClosure final : public google::protobuf::Closure {
+public:
+    LocalChunkClosure() : _latch(1) {}
+
+    void Run() override {
+        _latch.count_down();
+        unref();
+    }
+
+    void wait() { _latch.wait(); }
+
+    void unref() {
+        if (_refs.fetch_sub(1) == 1) {
+            delete this;
+        }
+    }
+
+private:
+    CountDownLatch _latch;
+    std::atomic<int> _refs{2};
+};
+
 class DataStreamSender::Channel {
 public:
     // Create channel to send data to particular ipaddress/port/query/node
@@ -96,6 +125,12 @@ public:
             delete _chunk_closure;
         }
         _chunk_request.release_finst_id();
+        _credit_request.release_finst_id();
+        _spilled_request.release_finst_id();
+
+        if (_local_closure != nullptr) {
+            _local_closure->unref();
+        }
     }
 
     // Initialize channel.
@@ -149,6 +184,12 @@ public:
 
     TUniqueId get_fragment_instance_id() { return _fragment_instance_id; }
 
+    // Whether the destination is on the same host
+    bool is_local() const { return _brpc_dest_addr.hostname == BackendOptions::get_localhost(); }
+
+    // Whether the chunks are passed to the receiver on this backend in process, instead of by the rpcs.
+    bool use_local_passthrough() const { return _use_local_passthrough; }
+
 private:
     inline Status _wait_last_brpc() {
         auto cntl = &_closure->cntl;
@@ -164,6 +205,11 @@ private:
 
     inline Status _wait_prev_request() {
         SCOPED_TIMER(_parent->_wait_response_timer);
+        if (_local_closure != nullptr) {
+            _local_closure->wait();
+            _local_closure->unref();
+            _local_closure = nullptr;
+        }
         if (_request_seq == 0) {
             return Status::OK();
         }
@@ -174,7 +220,47 @@ private:
                          << ", error_text=" << cntl->ErrorText();
             return Status::ThriftRpcError("fail to send batch");
         }
-        return {_chunk_closure->result.status()};
+        // The latency of the rpc, including the time the receiver withholds the response, is a sample of the
+        // network time of the destination.
+        if (_last_request_bytes > 0) {
+            _compression_policy->update_network(_last_request_bytes, cntl->latency_us());
+            if (_last_request_is_broadcast) {
+                _parent->_broadcast_compression_policy->update_network(_last_request_bytes, cntl->latency_us());
+            }
+            _last_request_bytes = 0;
+        }
+        const auto& result = _chunk_closure->result;
+        _credit_bytes = result.has_credit_bytes() ? result.credit_bytes() : -1;
+        return {result.status()};
+    }
+
+    // Wait for the previous request, and then ask the receiver for the credit till it is granted, if it has run out.
+    Status _wait_for_credit() {
+        RETURN_IF_ERROR(_wait_prev_request());
+        while (_credit_bytes == 0) {
+            SCOPED_TIMER(_parent->_wait_credit_timer);
+            RETURN_IF_ERROR(_do_send_chunk_rpc(&_credit_request, butil::IOBuf()));
+            RETURN_IF_ERROR(_wait_prev_request());
+        }
+        return Status::OK();
+    }
+
+    // Without waiting for the receiver, whether it has the credit for the next request, otherwise it's asked for
+    // the credit in the background if it has run out. The receiver answers the requests with the chunks at once,
+    // only the rpc asking for the credit is withheld.
+    Status _try_acquire_credit(bool* can_send) {
+        *can_send = false;
+        if (_is_asking_credit && _chunk_closure->count() > 1) {
+            return Status::OK();
+        }
+        _is_asking_credit = false;
+        RETURN_IF_ERROR(_wait_prev_request());
+        if (_credit_bytes == 0) {
+            _is_asking_credit = true;
+            return _do_send_chunk_rpc(&_credit_request, butil::IOBuf());
+        }
+        *can_send = true;
+        return Status::OK();
     }
 
 private:
@@ -185,6 +271,18 @@ private:
 
     Status _do_send_chunk_rpc(PTransmitChunkParams* request, const butil::IOBuf& attachment);
 
+    // Whether the next request, the last one if |eos|, is spilled instead of being sent, which it is if the spilled
+    // requests are not all sent, or the receiver has run out of the credit. The spilled requests are sent first, as
+    // many as the receiver takes without waiting, or all of them before the last request.
+    Status _should_spill(bool eos, bool* spill);
+    // Spill the chunks of |request|, which are moved out of it, and |attachment|.
+    Status _spill_request(PTransmitChunkParams* request, const butil::IOBuf& attachment);
+    // Send the spilled requests in order, till the receiver runs out of the credit, unless |wait| for it.
+    Status _send_spilled_requests(bool wait);
+
+    // Pass |chunk|, nullptr for none, to the receiver on this backend, after the receiver takes the previous one.
+    Status _send_local_chunk(vectorized::ChunkUniquePtr chunk, bool eos);
+
     Status close_internal();
 
     DataStreamSender* _parent;
@@ -217,9 +315,36 @@ private:
     // When one request is being send, producer will construct the other one.
     // Which one is used is decided by _request_seq.
     PTransmitChunkParams _chunk_request;
+    // The data of the chunks of _chunk_request
+    butil::IOBuf _chunk_attachment;
+    // The request without any chunk asking the receiver for the credit
+    PTransmitChunkParams _credit_request;
+    // The credit granted by the receiver of the last request, -1 if it is not known, with which the next request
+    // is sent only if it is not 0.
+    int64_t _credit_bytes = -1;
+    // Whether the in-flight rpc asks for the credit, sent without waiting for its response.
+    bool _is_asking_credit = false;
     RefCountClosure<PTransmitChunkResult>* _chunk_closure = nullptr;
 
+    // Whether the requests are spilled once the receiver runs out of the credit, instead of waiting for it.
+    bool _spill_to_disk = false;
+    // The spilled requests, which are sent before the following ones, nullptr till a request is spilled.
+    std::unique_ptr<ExchangeSpillBuffer> _spill_buffer;
+    PTransmitChunkParams _spilled_request;
+    butil::IOBuf _spilled_attachment;
+
     size_t _current_request_bytes = 0;
+    // When the first of the batched chunks was batched, 0 if none is batched
+    int64_t _batch_start_ms = 0;
+    // The bytes of the chunks of the in-flight request, and whether it is broadcast to all the channels
+    size_t _last_request_bytes = 0;
+    bool _last_request_is_broadcast = false;
+
+    std::unique_ptr<ExchangeCompressionPolicy> _compression_policy;
+
+    bool _use_local_passthrough = false;
+    // The closure of the last chunk passed in process, which the receiver runs once it takes the chunk.
+    LocalChunkClosure* _local_closure = nullptr;
 
     PBackendService_Stub* _brpc_stub = nullptr;
     RefCountClosure<PTransmitDataResult>* _closure = nullptr;
@@ -258,9 +383,29 @@ Status DataStreamSender::Channel::init(RuntimeState* state) {
     _chunk_request.set_sender_id(_parent->_sender_id);
     _chunk_request.set_be_number(_parent->_be_number);
 
+    _credit_request.set_allocated_finst_id(&_finst_id);
+    _credit_request.set_node_id(_dest_node_id);
+    _credit_request.set_sender_id(_parent->_sender_id);
+    _credit_request.set_be_number(_parent->_be_number);
+    _credit_request.set_eos(false);
+
+    _spilled_request.set_allocated_finst_id(&_finst_id);
+    _spilled_request.set_node_id(_dest_node_id);
+    _spilled_request.set_sender_id(_parent->_sender_id);
+    _spilled_request.set_be_number(_parent->_be_number);
+    _spilled_request.set_eos(false);
+
     _chunk_closure = new RefCountClosure<PTransmitChunkResult>();
     _chunk_closure->ref();
 
+    _compression_policy = std::make_unique<ExchangeCompressionPolicy>(_parent->_compress_type,
+                                                                      _parent->_adaptive_compression, is_local());
+    RETURN_IF_ERROR(_compression_policy->init());
+    _use_local_passthrough = config::exchange_local_passthrough && _parent->_is_vectorized && is_local() &&
+                             _brpc_dest_addr.port == config::brpc_port;
+    _spill_to_disk = config::exchange_spill_to_disk && config::exchange_credit_flow_control &&
+                     _parent->_is_vectorized && !_use_local_passthrough;
+
     _brpc_timeout_ms = std::min(3600, state->query_options().query_timeout) * 1000;
     // For bucket shuffle, the dest is unreachable, there is no need to establish a connection
     if (_fragment_instance_id.lo == -1) {
@@ -304,44 +449,143 @@ Status DataStreamSender::Channel::send_batch(PRowBatch* batch, bool eos) {
 }
 
 Status DataStreamSender::Channel::send_one_chunk(const vectorized::Chunk* chunk, bool eos, bool* is_real_sent) {
+    if (_use_local_passthrough) {
+        *is_real_sent = true;
+        vectorized::ChunkUniquePtr copy;
+        if (chunk != nullptr) {
+            copy = chunk->clone_empty_with_tuple(chunk->num_rows());
+            copy->append(*chunk);
+        }
+        return _send_local_chunk(std::move(copy), eos);
+    }
     *is_real_sent = false;
 
     // If chunk is not null, append it to request
     if (chunk != nullptr) {
         auto pchunk = _chunk_request.add_chunks();
-        RETURN_IF_ERROR(_parent->serialize_chunk(chunk, pchunk, &_is_first_chunk));
-        _current_request_bytes += pchunk->data().size();
+        RETURN_IF_ERROR(_parent->serialize_chunk(chunk, pchunk, &_is_first_chunk, &_chunk_attachment,
+                                                 _compression_policy.get()));
+        _current_request_bytes += pchunk->data_size();
     }
 
-    // Try to accumulate enough bytes before sending a RPC. When eos is true we should send
+    // Try to accumulate enough bytes, or wait long enough, before sending a RPC. When eos is true we should send
     // last packet
-    if (_current_request_bytes > _parent->_request_bytes_threshold || eos) {
+    if (_parent->_is_batch_full(_current_request_bytes, &_batch_start_ms) || eos) {
         // NOTE: Before we send current request, we must wait last RPC's result to make sure
         // it have finished. Because in some cases, receiver depend the order of sender data.
         // We can add KeepOrder flag in Frontend to tell sender if it can send packet before
         // last RPC return. Then we can have a better pipeline. Before that we make wait last
         // RPC first.
-        RETURN_IF_ERROR(_wait_prev_request());
-        _chunk_request.set_eos(eos);
-        // we will send the current request now
-        butil::IOBuf attachment;
-        _parent->construct_brpc_attachment(&_chunk_request, &attachment);
-        RETURN_IF_ERROR(_do_send_chunk_rpc(&_chunk_request, attachment));
+        bool spill = false;
+        RETURN_IF_ERROR(_should_spill(eos, &spill));
+        if (spill) {
+            RETURN_IF_ERROR(_spill_request(&_chunk_request, _chunk_attachment));
+        } else {
+            RETURN_IF_ERROR(_wait_for_credit());
+            _chunk_request.set_eos(eos);
+            // we will send the current request now
+            _last_request_is_broadcast = false;
+            RETURN_IF_ERROR(_do_send_chunk_rpc(&_chunk_request, _chunk_attachment));
+        }
         // lets request sequence increment
         _chunk_request.clear_chunks();
+        _chunk_attachment.clear();
         _current_request_bytes = 0;
+        _batch_start_ms = 0;
         *is_real_sent = true;
     }
 
     return Status::OK();
 }
 
-Status DataStreamSender::Channel::send_chunk_request(PTransmitChunkParams* params, const butil::IOBuf& attachment) {
+Status DataStreamSender::Channel::_send_local_chunk(vectorized::ChunkUniquePtr chunk, bool eos) {
     RETURN_IF_ERROR(_wait_prev_request());
+    SCOPED_TIMER(_parent->_send_request_timer);
+    PQueryStatistics statistics;
+    bool has_statistics = _is_transfer_chain && (_send_query_statistics_with_every_batch || eos);
+    if (has_statistics) {
+        _parent->_query_statistics->to_pb(&statistics);
+    }
+    auto* closure = new LocalChunkClosure();
+    google::protobuf::Closure* done = closure;
+    Status st = _parent->_state->exec_env()->stream_mgr()->transmit_chunk_local(
+            _fragment_instance_id, _dest_node_id, _parent->_sender_id, _parent->_be_number, std::move(chunk), eos,
+            has_statistics ? &statistics : nullptr, &done);
+    // The receiver didn't take the closure, it can take more chunks now.
+    if (done != nullptr) {
+        done->Run();
+    }
+    _local_closure = closure;
+    return st;
+}
+
+Status DataStreamSender::Channel::_should_spill(bool eos, bool* spill) {
+    *spill = false;
+    if (!_spill_to_disk) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_send_spilled_requests(eos));
+    if (eos) {
+        return Status::OK();
+    }
+    if (_spill_buffer != nullptr && !_spill_buffer->empty()) {
+        *spill = true;
+        return Status::OK();
+    }
+    bool can_send = false;
+    RETURN_IF_ERROR(_try_acquire_credit(&can_send));
+    *spill = !can_send;
+    return Status::OK();
+}
+
+Status DataStreamSender::Channel::_spill_request(PTransmitChunkParams* request, const butil::IOBuf& attachment) {
+    SCOPED_TIMER(_parent->_spill_timer);
+    if (_spill_buffer == nullptr) {
+        _spill_buffer = std::make_unique<ExchangeSpillBuffer>();
+        RETURN_IF_ERROR(_spill_buffer->init(_parent->_state, _fragment_instance_id.lo));
+    }
+    int64_t spilled_bytes = _spill_buffer->spilled_bytes();
+    RETURN_IF_ERROR(_spill_buffer->write(request, attachment));
+    COUNTER_UPDATE(_parent->_spilled_bytes_counter, _spill_buffer->spilled_bytes() - spilled_bytes);
+    return Status::OK();
+}
+
+Status DataStreamSender::Channel::_send_spilled_requests(bool wait) {
+    while (_spill_buffer != nullptr && !_spill_buffer->empty()) {
+        if (wait) {
+            RETURN_IF_ERROR(_wait_for_credit());
+        } else {
+            bool can_send = false;
+            RETURN_IF_ERROR(_try_acquire_credit(&can_send));
+            if (!can_send) {
+                return Status::OK();
+            }
+        }
+        {
+            SCOPED_TIMER(_parent->_spill_timer);
+            RETURN_IF_ERROR(_spill_buffer->read(&_spilled_request, &_spilled_attachment));
+        }
+        _last_request_is_broadcast = false;
+        RETURN_IF_ERROR(_do_send_chunk_rpc(&_spilled_request, _spilled_attachment));
+    }
+    return Status::OK();
+}
+
+Status DataStreamSender::Channel::send_chunk_request(PTransmitChunkParams* params, const butil::IOBuf& attachment) {
+    bool spill = false;
+    RETURN_IF_ERROR(_should_spill(params->eos(), &spill));
+    if (spill) {
+        // The request is shared by all the channels.
+        PTransmitChunkParams request;
+        *request.mutable_chunks() = params->chunks();
+        return _spill_request(&request, attachment);
+    }
+    RETURN_IF_ERROR(_wait_for_credit());
     params->set_allocated_finst_id(&_finst_id);
     params->set_node_id(_dest_node_id);
     params->set_sender_id(_parent->_sender_id);
     params->set_be_number(_parent->_be_number);
+    _last_request_is_broadcast = true;
     auto status = _do_send_chunk_rpc(params, attachment);
     params->release_finst_id();
     return status;
@@ -351,6 +595,7 @@ Status DataStreamSender::Channel::_do_send_chunk_rpc(PTransmitChunkParams* reque
     SCOPED_TIMER(_parent->_send_request_timer);
 
     request->set_sequence(_request_seq);
+    request->set_use_credit(config::exchange_credit_flow_control);
     if (_is_transfer_chain && (_send_query_statistics_with_every_batch || request->eos())) {
         auto statistic = request->mutable_query_statistics();
         _parent->_query_statistics->to_pb(statistic);
@@ -359,6 +604,7 @@ Status DataStreamSender::Channel::_do_send_chunk_rpc(PTransmitChunkParams* reque
     _chunk_closure->cntl.Reset();
     _chunk_closure->cntl.set_timeout_ms(_brpc_timeout_ms);
     _chunk_closure->cntl.request_attachment().append(attachment);
+    _last_request_bytes = attachment.size();
     _brpc_stub->transmit_chunk(&_chunk_closure->cntl, request, &_chunk_closure->result, _chunk_closure);
     _request_seq++;
     return Status::OK();
@@ -417,6 +663,12 @@ Status DataStreamSender::Channel::send_current_batch(bool eos) {
 }
 
 Status DataStreamSender::Channel::_send_current_chunk(bool eos) {
+    if (_use_local_passthrough) {
+        // The chunk is passed as is, and the following rows are added into a new one.
+        vectorized::ChunkUniquePtr chunk = std::move(_chunk);
+        _chunk = chunk->clone_empty_with_tuple();
+        return _send_local_chunk(std::move(chunk), eos);
+    }
     bool is_real_sent = false;
     RETURN_IF_ERROR(send_one_chunk(_chunk.get(), eos, &is_real_sent));
 
@@ -572,8 +824,8 @@ Status DataStreamSender::prepare(RuntimeState* state) {
         // If transmission_compression_type is not set, use compress_rowbatches to check if
         // compress transmitted data.
         _compress_type = CompressionTypePB::LZ4;
+        _adaptive_compression = config::exchange_adaptive_compression;
     }
-    RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
 
     std::string instances;
     for (const auto& channel : _channels) {
@@ -611,6 +863,9 @@ Status DataStreamSender::prepare(RuntimeState* state) {
     _compress_timer = ADD_TIMER(profile(), "CompressTime");
     _send_request_timer = ADD_TIMER(profile(), "SendRequestTime");
     _wait_response_timer = ADD_TIMER(profile(), "WaitResponseTime");
+    _wait_credit_timer = ADD_TIMER(profile(), "WaitCreditTime");
+    _spill_timer = ADD_TIMER(profile(), "SpillTime");
+    _spilled_bytes_counter = ADD_COUNTER(profile(), "SpilledBytes", TUnit::BYTES);
     _shuffle_dispatch_timer = ADD_TIMER(profile(), "ShuffleDispatchTime");
     _shuffle_hash_timer = ADD_TIMER(profile(), "ShuffleHashTime");
     _overall_throughput = profile()->add_derived_counter(
@@ -620,6 +875,12 @@ Status DataStreamSender::prepare(RuntimeState* state) {
     for (int i = 0; i < _channels.size(); ++i) {
         RETURN_IF_ERROR(_channels[i]->init(state));
     }
+    bool all_local = std::all_of(_channels.begin(), _channels.end(), [](auto* channel) { return channel->is_local(); });
+    _num_remote_channels = std::count_if(_channels.begin(), _channels.end(),
+                                         [](auto* channel) { return !channel->use_local_passthrough(); });
+    _broadcast_compression_policy =
+            std::make_unique<ExchangeCompressionPolicy>(_compress_type, _adaptive_compression, all_local);
+    RETURN_IF_ERROR(_broadcast_compression_policy->init());
 
     // set eos for all channels.
     // It will be set to true when closing.
@@ -711,21 +972,36 @@ Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chun
     }
     // Unpartition or _channel size
     if (_part_type == TPartitionType::UNPARTITIONED || _channels.size() == 1) {
+        // The channels to the receivers on this backend are passed the chunk in process.
+        for (auto channel : _channels) {
+            if (channel->use_local_passthrough()) {
+                bool is_real_sent = false;
+                RETURN_IF_ERROR(channel->send_one_chunk(chunk, false, &is_real_sent));
+            }
+        }
+        if (_num_remote_channels == 0) {
+            return Status::OK();
+        }
         // We use sender request to avoid serialize chunk many times.
         // 1. create a new chunk PB to serialize
         ChunkPB* pchunk = _chunk_request.add_chunks();
         // 2. serialize input chunk to pchunk
-        RETURN_IF_ERROR(serialize_chunk(chunk, pchunk, &_is_first_chunk, _channels.size()));
-        _current_request_bytes += pchunk->data().size();
-        // 3. if request bytes exceede the threshold, send current request
-        if (_current_request_bytes > _request_bytes_threshold) {
-            butil::IOBuf attachment;
-            construct_brpc_attachment(&_chunk_request, &attachment);
+        RETURN_IF_ERROR(
+                serialize_chunk(chunk, pchunk, &_is_first_chunk, &_chunk_request_attachment,
+                                _broadcast_compression_policy.get(), _num_remote_channels));
+        _current_request_bytes += pchunk->data_size();
+        // 3. if request bytes exceede the threshold or the chunks have waited too long, send current request
+        if (_is_batch_full(_current_request_bytes, &_batch_start_ms)) {
+            // The channels share the blocks of the attachment
             for (auto channel : _channels) {
-                RETURN_IF_ERROR(channel->send_chunk_request(&_chunk_request, attachment));
+                if (!channel->use_local_passthrough()) {
+                    RETURN_IF_ERROR(channel->send_chunk_request(&_chunk_request, _chunk_request_attachment));
+                }
             }
             _current_request_bytes = 0;
+            _batch_start_ms = 0;
             _chunk_request.clear_chunks();
+            _chunk_request_attachment.clear();
         }
     } else if (_part_type == TPartitionType::RANDOM) {
         // Round-robin batches among channels. Wait for the current channel to finish its
@@ -898,6 +1174,20 @@ Status DataStreamSender::compute_range_part_code(RuntimeState* state, TupleRow*
     return Status::OK();
 }
 
+bool DataStreamSender::_is_batch_full(size_t request_bytes, int64_t* batch_start_ms) const {
+    if (request_bytes > _request_bytes_threshold) {
+        return true;
+    }
+    if (request_bytes == 0 || config::max_transmit_batched_wait_ms <= 0) {
+        return false;
+    }
+    int64_t now = MonotonicMillis();
+    if (*batch_start_ms == 0) {
+        *batch_start_ms = now;
+    }
+    return now - *batch_start_ms >= config::max_transmit_batched_wait_ms;
+}
+
 Status DataStreamSender::close(RuntimeState* state, Status exec_status) {
     ScopedTimer<MonotonicStopWatch> close_timer(_profile != nullptr ? _profile->total_time_counter() : nullptr);
     // TODO: only close channels that didn't have any errors
@@ -907,10 +1197,12 @@ Status DataStreamSender::close(RuntimeState* state, Status exec_status) {
     // be sent to receiver.
     if (_current_request_bytes > 0) {
         _chunk_request.set_eos(true);
-        butil::IOBuf attachment;
-        construct_brpc_attachment(&_chunk_request, &attachment);
         for (int i = 0; i < _channels.size(); ++i) {
-            _channels[i]->send_chunk_request(&_chunk_request, attachment);
+            if (_channels[i]->use_local_passthrough()) {
+                _channels[i]->close(state);
+            } else {
+                _channels[i]->send_chunk_request(&_chunk_request, _chunk_request_attachment);
+            }
         }
     } else {
         for (int i = 0; i < _channels.size(); ++i) {
@@ -959,73 +1251,80 @@ Status DataStreamSender::serialize_batch(RowBatch* src, T* dest, int num_receive
 }
 
 Status DataStreamSender::serialize_chunk(const vectorized::Chunk* src, ChunkPB* dst, bool* is_first_chunk,
+                                         butil::IOBuf* attachment, ExchangeCompressionPolicy* compression_policy,
                                          int num_receivers) {
     VLOG_ROW << "serializing " << src->num_rows() << " rows";
 
+    // The chunk data is serialized into a buffer of its own, which is handed over to |attachment|,
+    // instead of being serialized into ChunkPB and then copied into the attachment.
     size_t uncompressed_size = 0;
+    std::unique_ptr<uint8_t[]> data;
     {
         SCOPED_TIMER(_serialize_batch_timer);
         dst->set_compress_type(CompressionTypePB::NO_COMPRESSION);
+        dst->clear_data();
         // We only serialize chunk meta for first chunk
         if (*is_first_chunk) {
-            uncompressed_size = src->serialize_with_meta(dst);
+            src->serialize_meta(dst);
             *is_first_chunk = false;
         } else {
             dst->clear_is_nulls();
             dst->clear_is_consts();
             dst->clear_slot_id_map();
+        }
+        if (config::exchange_encode_chunk) {
+            data.reset(new uint8_t[src->max_serialize_encoded_size()]);
+            uncompressed_size = src->serialize_encoded(data.get());
+        } else {
             uncompressed_size = src->serialize_size();
-            // TODO(kks): resize without initializing the new bytes
-            dst->mutable_data()->resize(uncompressed_size);
-            src->serialize((uint8_t*)dst->mutable_data()->data());
+            data.reset(new uint8_t[uncompressed_size]);
+            src->serialize(data.get());
         }
     }
 
-    if (_compress_codec != nullptr && _compress_codec->exceed_max_input_size(uncompressed_size)) {
+    CompressionTypePB compress_type = CompressionTypePB::NO_COMPRESSION;
+    const BlockCompressionCodec* compress_codec = compression_policy->next_codec(&compress_type);
+    if (compress_codec != nullptr && compress_codec->exceed_max_input_size(uncompressed_size)) {
         return Status::InternalError("The input size for compression should be less than " +
-                                     _compress_codec->max_input_size());
+                                     compress_codec->max_input_size());
     }
 
     dst->set_uncompressed_size(uncompressed_size);
-    // try compress the ChunkPB data
-    if (_compress_codec != nullptr && uncompressed_size > 0) {
+    size_t data_size = uncompressed_size;
+    // try compress the chunk data
+    if (compress_codec != nullptr && uncompressed_size > 0) {
         SCOPED_TIMER(_compress_timer);
-
-        // Try compressing data to _compression_scratch, swap if compressed data is smaller
-        int max_compressed_size = _compress_codec->max_compressed_len(uncompressed_size);
-
-        if (_compression_scratch.size() < max_compressed_size) {
-            _compression_scratch.resize(max_compressed_size);
-        }
-
-        Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
-        _compress_codec->compress(dst->data(), &compressed_slice);
+        MonotonicStopWatch watch;
+        watch.start();
+
+        // Try compressing data into another buffer, which is sent if the compressed data is small enough
+        size_t max_compressed_size = compress_codec->max_compressed_len(uncompressed_size);
+        std::unique_ptr<uint8_t[]> compressed_data(new uint8_t[max_compressed_size]);
+        Slice compressed_slice{compressed_data.get(), max_compressed_size};
+        RETURN_IF_ERROR(compress_codec->compress(Slice(data.get(), uncompressed_size), &compressed_slice));
+        compression_policy->update_compression(compress_type, uncompressed_size, compressed_slice.size,
+                                               watch.elapsed_time());
         double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
         if (LIKELY(compress_ratio > config::rpc_compress_ratio_threshold)) {
-            _compression_scratch.resize(compressed_slice.size);
-            dst->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
-            dst->set_compress_type(_compress_type);
+            data = std::move(compressed_data);
+            data_size = compressed_slice.size;
+            dst->set_compress_type(compress_type);
         }
 
         VLOG_ROW << "uncompressed size: " << uncompressed_size << ", compressed size: " << compressed_slice.size;
     }
-    size_t chunk_size = dst->data().size();
-    VLOG_ROW << "chunk data size " << chunk_size;
+    dst->set_data_size(data_size);
+    if (data_size > 0) {
+        attachment->append_user_data(data.release(), data_size,
+                                     [](void* buf) { delete[] static_cast<uint8_t*>(buf); });
+    }
+    VLOG_ROW << "chunk data size " << data_size;
 
-    COUNTER_UPDATE(_bytes_sent_counter, chunk_size * num_receivers);
+    COUNTER_UPDATE(_bytes_sent_counter, data_size * num_receivers);
     COUNTER_UPDATE(_uncompressed_bytes_counter, uncompressed_size * num_receivers);
     return Status::OK();
 }
 
-void DataStreamSender::construct_brpc_attachment(PTransmitChunkParams* params, butil::IOBuf* attachment) {
-    for (int i = 0; i < params->chunks().size(); ++i) {
-        auto chunk = params->mutable_chunks(i);
-        chunk->set_data_size(chunk->data().size());
-        attachment->append(chunk->data());
-        chunk->clear_data();
-    }
-}
-
 int64_t DataStreamSender::get_num_data_bytes_sent() const {
     // TODO: do we need synchronization here or are reads & writes to 8-byte ints
     // atomic?
@@ -22,6 +22,8 @@
 #ifndef STARROCKS_BE_RUNTIME_DATA_STREAM_SENDER_H
 #define STARROCKS_BE_RUNTIME_DATA_STREAM_SENDER_H
 
+#include <butil/iobuf.h>
+
 #include <string>
 #include <vector>
 
@@ -32,13 +34,9 @@
 #include "exec/data_sink.h"
 #include "gen_cpp/data.pb.h" // for PRowBatch
 #include "gen_cpp/internal_service.pb.h"
-#include "util/raw_container.h"
+#include "runtime/exchange_compression_policy.h"
 #include "util/runtime_profile.h"
 
-namespace butil {
-class IOBuf;
-}
-
 namespace starrocks {
 
 class ExprContext;
@@ -51,7 +49,6 @@ class PartitionInfo;
 class TupleRow;
 class PartRangeKey;
 class MemTracker;
-class BlockCompressionCodec;
 
 // Single sender of an m:n data stream.
 // Row batch data is routed to destinations based on the provided
@@ -103,11 +100,11 @@ public:
     template <class T>
     Status serialize_batch(RowBatch* src, T* dest, int num_receivers = 1);
 
-    // For the first chunk , serialize the chunk data and meta to ChunkPB both.
-    // For other chunk, only serialize the chunk data to ChunkPB.
-    Status serialize_chunk(const vectorized::Chunk* chunk, ChunkPB* dst, bool* is_first_chunk, int num_receivers = 1);
-
-    void construct_brpc_attachment(PTransmitChunkParams* _chunk_request, butil::IOBuf* attachment);
+    // For the first chunk , serialize the chunk meta to ChunkPB.
+    // The chunk data is serialized into a buffer which is appended to |attachment| without being copied, and
+    // ChunkPB only records its size. The data is compressed by the codec |compression_policy| chooses.
+    Status serialize_chunk(const vectorized::Chunk* chunk, ChunkPB* dst, bool* is_first_chunk, butil::IOBuf* attachment,
+                           ExchangeCompressionPolicy* compression_policy, int num_receivers = 1);
 
     // Return total number of bytes sent in TRowBatch.data. If batches are
     // broadcast to multiple receivers, they are counted once per receiver.
@@ -133,6 +130,10 @@ private:
 
     Status process_distribute(RuntimeState* state, TupleRow* row, const PartitionInfo* part, size_t* hash_val);
 
+    // Whether the batched chunks of |request_bytes| bytes, the first of which was batched at |*batch_start_ms|, or
+    // now if it is 0, should be sent in one request.
+    bool _is_batch_full(size_t request_bytes, int64_t* batch_start_ms) const;
+
     bool _is_vectorized;
 
     // Sender instance id, unique within a fragment.
@@ -159,17 +160,15 @@ private:
 
     // Only used when broadcast
     PTransmitChunkParams _chunk_request;
+    // The data of the chunks of _chunk_request
+    butil::IOBuf _chunk_request_attachment;
     size_t _current_request_bytes = 0;
     size_t _request_bytes_threshold = 0;
+    int64_t _batch_start_ms = 0;
 
     std::vector<uint32_t> _hash_values;
     vectorized::Columns _partitions_columns;
     bool _is_first_chunk = true;
-    // String to write compressed chunk data in serialize().
-    // This is a string so we can swap() with the string in the ChunkPB we're serializing
-    // to (we don't compress directly into the ChunkPB in case the compressed data is
-    // longer than the uncompressed data).
-    raw::RawString _compression_scratch;
     // vector query engine data struct
 
     std::vector<ExprContext*> _partition_expr_ctxs; // compute per-row partition values
@@ -194,7 +193,12 @@ private:
     std::vector<uint32_t> _row_indexes;
 
     CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
-    const BlockCompressionCodec* _compress_codec = nullptr;
+    // Whether the channels choose the codecs by ExchangeCompressionPolicy, instead of using _compress_type
+    bool _adaptive_compression = false;
+    // The number of the channels not passing the chunks in process, to which the chunks are broadcast by the rpcs
+    int _num_remote_channels = 0;
+    // The compression of the chunks broadcast to all the channels
+    std::unique_ptr<ExchangeCompressionPolicy> _broadcast_compression_policy;
 
     // Because we should close all channels even if fail to close some channel.
     // We use a global _close_status to record the error close status.
@@ -210,6 +214,11 @@ private:
 
     RuntimeProfile::Counter* _send_request_timer{};
     RuntimeProfile::Counter* _wait_response_timer{};
+    // The time of waiting for the credit of the receivers
+    RuntimeProfile::Counter* _wait_credit_timer{};
+    // The time of spilling the requests the receivers have no room for, and reading them back, and their bytes
+    RuntimeProfile::Counter* _spill_timer{};
+    RuntimeProfile::Counter* _spilled_bytes_counter{};
 
     RuntimeProfile::Counter* _shuffle_dispatch_timer{};
     RuntimeProfile::Counter* _shuffle_hash_timer{};
@@ -131,19 +131,15 @@ void DateValue::trunc_to_day() {}
 void DateValue::trunc_to_month() {
     int year, month, day;
     date::to_date_with_cache(_julian, &year, &month, &day);
-    _julian = date::from_date(year, month, 1);
+    _julian -= day - 1;
 }
 
 void DateValue::trunc_to_year() {
-    int year, month, day;
-    date::to_date_with_cache(_julian, &year, &month, &day);
-    _julian = date::from_date(year, 1, 1);
+    _julian -= date::get_day_of_year(_julian) - 1;
 }
 
 void DateValue::trunc_to_week() {
-    int year, month, day;
-    date::to_date_with_cache(_julian - day_to_first[weekday() + 1], &year, &month, &day);
-    _julian = date::from_date(year, month, day);
+    _julian -= day_to_first[weekday() + 1];
 }
 
 void DateValue::trunc_to_quarter() {
@@ -33,8 +33,16 @@ template <typename T, bool check_overflow>
 class DecimalV3Arithmetics {
 public:
     using Type = std::enable_if_t<starrocks::is_underlying_type_of_decimal<T>, T>;
+    using UnsignedType = typename unsigned_type<Type>::type;
+
+    // The overflows of the 32-bit and 64-bit decimals are detected with the sign bits instead of the overflow
+    // flag, which also costs few instructions for a single value, but lets the compiler vectorize the loops of the
+    // binary functions over a column.
     static inline bool add(Type const& a, Type const& b, Type* c) {
-        if (check_overflow) {
+        if constexpr (check_overflow && sizeof(Type) <= sizeof(int64_t)) {
+            *c = static_cast<Type>(static_cast<UnsignedType>(a) + static_cast<UnsignedType>(b));
+            return ((a ^ *c) & (b ^ *c)) < 0;
+        } else if constexpr (check_overflow) {
             return add_overflow(a, b, c);
         } else {
             *c = a + b;
@@ -43,7 +51,10 @@ public:
     }
 
     static inline bool sub(Type const& a, Type const& b, Type* c) {
-        if constexpr (check_overflow) {
+        if constexpr (check_overflow && sizeof(Type) <= sizeof(int64_t)) {
+            *c = static_cast<Type>(static_cast<UnsignedType>(a) - static_cast<UnsignedType>(b));
+            return ((a ^ b) & (a ^ *c)) < 0;
+        } else if constexpr (check_overflow) {
             return sub_overflow(a, b, c);
         } else {
             *c = a - b;
@@ -52,7 +63,11 @@ public:
     }
 
     static inline bool mul(Type const& a, Type const& b, Type* c) {
-        if constexpr (check_overflow) {
+        if constexpr (check_overflow && sizeof(Type) == sizeof(int32_t)) {
+            int64_t product = static_cast<int64_t>(a) * static_cast<int64_t>(b);
+            *c = static_cast<Type>(product);
+            return product != static_cast<int64_t>(*c);
+        } else if constexpr (check_overflow) {
             return mul_overflow(a, b, c);
         } else {
             *c = a * b;
@@ -68,8 +83,21 @@ public:
 
     // check divide-by-zero before calling div and mod
     static inline bool div_round(Type const& a, Type const& b, Type* c) {
+        Type r;
+#if defined(__x86_64__) && defined(__GNUC__)
+        if constexpr (std::is_same_v<Type, int128_t>) {
+            // the quotient and the remainder of one udivmodti4 instead of the calls of both __divti3 and __modti3.
+            uint128_t remainder;
+            divmodti3(a, b, *c, remainder);
+            r = static_cast<int128_t>(remainder);
+        } else {
+            *c = a / b;
+            r = a % b;
+        }
+#else
         *c = a / b;
-        Type r = a % b;
+        r = a % b;
+#endif
         // case 1: |b| is odd. if [|b|/2] < |r|, then add carry; otherwise add 0.
         // case 2: |b| is even. if [|b|/2] <= |r|, then add carry; otherwise add 0. here
         // [b/2] == r means round half to up.
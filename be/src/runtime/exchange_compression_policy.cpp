@@ -0,0 +1,106 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/exchange_compression_policy.h"
+
+#include "util/block_compression.h"
+
+namespace starrocks {
+
+ExchangeCompressionPolicy::ExchangeCompressionPolicy(CompressionTypePB compress_type, bool adaptive,
+                                                     bool is_local_destination)
+        : _compress_type(compress_type),
+          _adaptive(adaptive),
+          _is_local_destination(is_local_destination),
+          _chosen_type(compress_type) {
+    _candidates[0].type = CompressionTypePB::LZ4;
+    _candidates[1].type = CompressionTypePB::ZSTD;
+}
+
+Status ExchangeCompressionPolicy::init() {
+    RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_chosen_codec));
+    if (!_adaptive) {
+        return Status::OK();
+    }
+    if (_is_local_destination) {
+        _chosen_type = CompressionTypePB::NO_COMPRESSION;
+        _chosen_codec = nullptr;
+        return Status::OK();
+    }
+    for (auto& candidate : _candidates) {
+        RETURN_IF_ERROR(get_block_compression_codec(candidate.type, &candidate.codec));
+    }
+    return Status::OK();
+}
+
+const BlockCompressionCodec* ExchangeCompressionPolicy::next_codec(CompressionTypePB* type) {
+    if (_adaptive && !_is_local_destination) {
+        int64_t index = _num_chunks++ % kSampleInterval;
+        if (index < kNumCandidates) {
+            *type = _candidates[index].type;
+            return _candidates[index].codec;
+        }
+    }
+    *type = _chosen_type;
+    return _chosen_codec;
+}
+
+void ExchangeCompressionPolicy::update_compression(CompressionTypePB type, size_t uncompressed_size,
+                                                   size_t compressed_size, int64_t compress_ns) {
+    if (!_adaptive || uncompressed_size == 0) {
+        return;
+    }
+    for (auto& candidate : _candidates) {
+        if (candidate.type != type) {
+            continue;
+        }
+        double ratio = static_cast<double>(compressed_size) / uncompressed_size;
+        double ns_per_byte = static_cast<double>(compress_ns) / uncompressed_size;
+        if (candidate.num_samples++ == 0) {
+            candidate.ratio = ratio;
+            candidate.ns_per_byte = ns_per_byte;
+        } else {
+            candidate.ratio += kAlpha * (ratio - candidate.ratio);
+            candidate.ns_per_byte += kAlpha * (ns_per_byte - candidate.ns_per_byte);
+        }
+        _choose();
+        return;
+    }
+}
+
+void ExchangeCompressionPolicy::update_network(size_t bytes, int64_t latency_us) {
+    if (!_adaptive || bytes == 0 || latency_us <= 0) {
+        return;
+    }
+    double ns_per_byte = static_cast<double>(latency_us) * 1000 / bytes;
+    if (_num_network_samples++ == 0) {
+        _network_ns_per_byte = ns_per_byte;
+    } else {
+        _network_ns_per_byte += kAlpha * (ns_per_byte - _network_ns_per_byte);
+    }
+    _choose();
+}
+
+void ExchangeCompressionPolicy::_choose() {
+    if (_is_local_destination || _num_network_samples == 0) {
+        return;
+    }
+    for (const auto& candidate : _candidates) {
+        if (candidate.num_samples == 0) {
+            return;
+        }
+    }
+    // The costs of sending a byte of the chunks
+    double min_cost = _network_ns_per_byte;
+    _chosen_type = CompressionTypePB::NO_COMPRESSION;
+    _chosen_codec = nullptr;
+    for (const auto& candidate : _candidates) {
+        double cost = candidate.ns_per_byte + candidate.ratio * _network_ns_per_byte;
+        if (cost < min_cost) {
+            min_cost = cost;
+            _chosen_type = candidate.type;
+            _chosen_codec = candidate.codec;
+        }
+    }
+}
+
+} // namespace starrocks
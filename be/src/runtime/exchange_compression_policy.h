@@ -0,0 +1,78 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/status.h"
+#include "gen_cpp/segment_v2.pb.h"
+
+namespace starrocks {
+
+class BlockCompressionCodec;
+
+// ExchangeCompressionPolicy chooses the codec to compress the chunks sent through an exchange channel.
+//
+// If not |adaptive|, all the chunks are compressed by |compress_type|. Otherwise the chunks are not compressed if
+// the destination is on the same host, where the network is no cost, and for the other destinations the first chunks
+// of every kSampleInterval chunks are compressed by each of the candidate codecs, LZ4 and ZSTD, by turns, to sample
+// their compression ratios and time. Once the network time per byte is measured by the rpcs as well, the rest of the
+// chunks are compressed by the codec, or none, of the least cost of the compression and sending the compressed bytes.
+// The chunks are compressed by |compress_type| till then. A chunk is not compressed by the codec whose compression
+// time is more than the network time it saves, e.g. LZ4 on a fast network, or the chunk isn't compressible.
+//
+// [not thread-safe], like the channel.
+class ExchangeCompressionPolicy {
+public:
+    // Every this many chunks, the first ones are compressed by each of the candidates.
+    static constexpr int64_t kSampleInterval = 64;
+
+    ExchangeCompressionPolicy(CompressionTypePB compress_type, bool adaptive, bool is_local_destination);
+
+    Status init();
+
+    // The codec to compress the next chunk, and its type in |type|, nullptr not to compress it.
+    const BlockCompressionCodec* next_codec(CompressionTypePB* type);
+
+    // Record that a chunk of |uncompressed_size| bytes is compressed by |type| into |compressed_size| bytes in
+    // |compress_ns| nanoseconds.
+    void update_compression(CompressionTypePB type, size_t uncompressed_size, size_t compressed_size,
+                            int64_t compress_ns);
+
+    // Record that a request of |bytes| bytes is sent in |latency_us| microseconds.
+    void update_network(size_t bytes, int64_t latency_us);
+
+    // The type of the codec the chunks, other than the samples, are compressed with.
+    CompressionTypePB chosen_type() const { return _chosen_type; }
+
+private:
+    static constexpr int kNumCandidates = 2;
+    // The weight of the new sample in the moving averages.
+    static constexpr double kAlpha = 0.25;
+
+    struct Candidate {
+        CompressionTypePB type;
+        const BlockCompressionCodec* codec = nullptr;
+        // compressed size / uncompressed size
+        double ratio = 1;
+        double ns_per_byte = 0;
+        int64_t num_samples = 0;
+    };
+
+    void _choose();
+
+    const CompressionTypePB _compress_type;
+    const bool _adaptive;
+    const bool _is_local_destination;
+
+    Candidate _candidates[kNumCandidates];
+    double _network_ns_per_byte = 0;
+    int64_t _num_network_samples = 0;
+    int64_t _num_chunks = 0;
+
+    CompressionTypePB _chosen_type;
+    const BlockCompressionCodec* _chosen_codec = nullptr;
+};
+
+} // namespace starrocks
@@ -0,0 +1,75 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/exchange_spill_buffer.h"
+
+#include <butil/iobuf.h>
+
+#include "env/env.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks {
+
+ExchangeSpillBuffer::~ExchangeSpillBuffer() {
+    if (_rw_file != nullptr) {
+        _rw_file->close();
+    }
+    if (_file != nullptr) {
+        _file->remove();
+    }
+}
+
+Status ExchangeSpillBuffer::init(RuntimeState* state, uint64_t device_hint) {
+    TmpFileMgr* tmp_file_mgr = state->exec_env()->tmp_file_mgr();
+    std::vector<TmpFileMgr::DeviceId> devices = tmp_file_mgr->active_tmp_devices();
+    if (devices.empty()) {
+        return Status::InternalError("no temporary directory to spill the exchange");
+    }
+    TmpFileMgr::File* file = nullptr;
+    RETURN_IF_ERROR(tmp_file_mgr->get_file(devices[device_hint % devices.size()], state->query_id(), &file));
+    _file.reset(file);
+    return Status::OK();
+}
+
+Status ExchangeSpillBuffer::write(PTransmitChunkParams* request, const butil::IOBuf& attachment) {
+    PTransmitChunkParams chunks;
+    chunks.mutable_chunks()->Swap(request->mutable_chunks());
+    _buffer.clear();
+    if (!chunks.SerializeToString(&_buffer)) {
+        return Status::InternalError("serialize spilled exchange request failed");
+    }
+    size_t pb_size = _buffer.size();
+    attachment.append_to(&_buffer);
+
+    int64_t offset = 0;
+    RETURN_IF_ERROR(_file->allocate_space(_buffer.size(), &offset));
+    if (_rw_file == nullptr) {
+        // the file is created by the first allocate_space.
+        RandomRWFileOptions opts;
+        opts.mode = Env::MUST_EXIST;
+        RETURN_IF_ERROR(Env::Default()->new_random_rw_file(opts, _file->path(), &_rw_file));
+    }
+    RETURN_IF_ERROR(_rw_file->write_at(offset, Slice(_buffer)));
+    _blocks.push_back(Block{offset, pb_size, _buffer.size() - pb_size});
+    _spilled_bytes += _buffer.size();
+    return Status::OK();
+}
+
+Status ExchangeSpillBuffer::read(PTransmitChunkParams* request, butil::IOBuf* attachment) {
+    DCHECK(!empty());
+    const Block& block = _blocks[_next_block++];
+    _buffer.resize(block.pb_size + block.attachment_size);
+    RETURN_IF_ERROR(_rw_file->read_at(block.offset, Slice(_buffer.data(), _buffer.size())));
+
+    PTransmitChunkParams chunks;
+    if (!chunks.ParseFromArray(_buffer.data(), block.pb_size)) {
+        return Status::InternalError("parse spilled exchange request failed");
+    }
+    request->clear_chunks();
+    request->mutable_chunks()->Swap(chunks.mutable_chunks());
+    attachment->clear();
+    attachment->append(_buffer.data() + block.pb_size, block.attachment_size);
+    return Status::OK();
+}
+
+} // namespace starrocks
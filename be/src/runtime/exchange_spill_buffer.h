@@ -0,0 +1,63 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/internal_service.pb.h"
+#include "runtime/tmp_file_mgr.h"
+
+namespace butil {
+class IOBuf;
+}
+
+namespace starrocks {
+
+class RandomRWFile;
+class RuntimeState;
+
+// ExchangeSpillBuffer buffers the requests of an exchange channel, which the receiver has no room for, in a
+// temporary file of TmpFileMgr, and gives them back in the written order. The chunks of a request are written as
+// they are serialized to be sent, along with their data in the attachment, so they needn't be serialized again.
+//
+// [not thread-safe], like the channel.
+class ExchangeSpillBuffer {
+public:
+    ExchangeSpillBuffer() = default;
+    ~ExchangeSpillBuffer();
+
+    // Create the temporary file on one of the devices, chosen by |device_hint|.
+    Status init(RuntimeState* state, uint64_t device_hint);
+
+    // Write the chunks of |request|, which are moved out of it, and |attachment|.
+    Status write(PTransmitChunkParams* request, const butil::IOBuf& attachment);
+
+    // Read the chunks of the next written request into |request|, and their data into |attachment|.
+    // Must be !empty().
+    Status read(PTransmitChunkParams* request, butil::IOBuf* attachment);
+
+    // Whether all the written requests are read.
+    bool empty() const { return _next_block >= _blocks.size(); }
+
+    // The bytes written into the file.
+    int64_t spilled_bytes() const { return _spilled_bytes; }
+
+private:
+    struct Block {
+        int64_t offset;
+        size_t pb_size;
+        size_t attachment_size;
+    };
+
+    std::unique_ptr<TmpFileMgr::File> _file;
+    std::unique_ptr<RandomRWFile> _rw_file;
+    std::vector<Block> _blocks;
+    size_t _next_block = 0;
+    int64_t _spilled_bytes = 0;
+    std::string _buffer;
+};
+
+} // namespace starrocks
@@ -25,6 +25,8 @@
 
 #include "common/config.h"
 #include "common/logging.h"
+#include "env/block_cache.h"
+#include "exec/vectorized/hdfs_file_meta_cache.h"
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/FrontendService.h"
 #include "gen_cpp/HeartbeatService_types.h"
@@ -38,6 +40,7 @@
 #include "runtime/disk_io_mgr.h"
 #include "runtime/external_scan_context_mgr.h"
 #include "runtime/fragment_mgr.h"
+#include "runtime/fragment_result_cache.h"
 #include "runtime/heartbeat_flags.h"
 #include "runtime/load_channel_mgr.h"
 #include "runtime/load_path_mgr.h"
@@ -46,14 +49,18 @@
 #include "runtime/result_queue_mgr.h"
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/runtime_filter_worker.h"
+#include "runtime/scan_scheduler.h"
 #include "runtime/small_file_mgr.h"
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "runtime/thread_resource_mgr.h"
 #include "runtime/tmp_file_mgr.h"
 #include "storage/page_cache.h"
+#include "storage/rowset/segment_v2/decoded_page_cache.h"
+#include "storage/rowset/segment_v2/segment_footer_cache.h"
 #include "storage/storage_engine.h"
 #include "storage/update_manager.h"
+#include "storage/vectorized/delete_bitmap_cache.h"
 #include "util/bfd_parser.h"
 #include "util/brpc_stub_cache.h"
 #include "util/debug_util.h"
@@ -63,7 +70,10 @@
 #include "util/parse_util.h"
 #include "util/pretty_printer.h"
 #include "util/priority_thread_pool.hpp"
+#include "util/sampling_profiler.h"
 #include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
+#include "util/work_stealing_thread_pool.h"
 namespace starrocks {
 
 // Calculate the total memory limit of all load tasks on this BE
@@ -92,12 +102,30 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _frontend_client_cache = new FrontendServiceClientCache(config::max_client_cache_size_per_host);
     _broker_client_cache = new BrokerServiceClientCache(config::max_client_cache_size_per_host);
     _thread_mgr = new ThreadResourceMgr();
-    _thread_pool = new PriorityThreadPool(config::doris_scanner_thread_pool_thread_num,
+    _thread_pool = new PriorityThreadPool("scanner", config::doris_scanner_thread_pool_thread_num,
                                           config::doris_scanner_thread_pool_queue_size);
-    _pipeline_io_thread_pool = new PriorityThreadPool(4, config::doris_scanner_thread_pool_queue_size);
+    _scan_scheduler = new ScanScheduler(config::doris_scanner_thread_pool_thread_num);
+    _pipeline_io_thread_pool = new PriorityThreadPool("pipeline_io", config::pipeline_io_thread_pool_thread_num,
+                                                      config::doris_scanner_thread_pool_queue_size);
+    if (config::enable_work_stealing_scan_thread_pool) {
+        _scan_thread_pool =
+                new WorkStealingThreadPool("work_stealing_scanner", config::doris_scanner_thread_pool_thread_num,
+                                           config::doris_scanner_thread_pool_queue_size);
+    }
     _num_scan_operators = 0;
-    _etl_thread_pool = new PriorityThreadPool(config::etl_thread_pool_size, config::etl_thread_pool_queue_size);
+    _etl_thread_pool =
+            new PriorityThreadPool("etl", config::etl_thread_pool_size, config::etl_thread_pool_queue_size);
+    std::unique_ptr<ThreadPool> exchange_merge_thread_pool;
+    // No task is queued, so that every group merged gets a thread at once.
+    RETURN_IF_ERROR(ThreadPoolBuilder("exchange_merge")
+                            .set_min_threads(0)
+                            .set_max_threads(std::max(config::exchange_merge_thread_pool_thread_num, 1))
+                            .set_max_queue_size(0)
+                            .set_idle_timeout(MonoDelta::FromMilliseconds(2000))
+                            .build(&exchange_merge_thread_pool));
+    _exchange_merge_thread_pool = exchange_merge_thread_pool.release();
     _fragment_mgr = new FragmentMgr(this);
+    _fragment_result_cache = new FragmentResultCache(std::max<int64_t>(config::fragment_result_cache_capacity, 0));
 
     std::unique_ptr<ThreadPool> driver_dispatcher_thread_pool;
     // auto thread_num_max = std::thread::hardware_concurrency();
@@ -140,6 +168,11 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
 
     RETURN_IF_ERROR(_load_channel_mgr->init(_load_mem_tracker));
     _heartbeat_flags = new HeartbeatFlags();
+
+    if (config::enable_sampling_profiler) {
+        Status st = SamplingProfiler::instance()->start(config::sampling_profiler_frequency);
+        LOG_IF(WARNING, !st.ok()) << "Failed to start the sampling profiler: " << st;
+    }
     return Status::OK();
 }
 
@@ -183,6 +216,10 @@ Status ExecEnv::init_mem_tracker() {
     _central_column_pool_mem_tracker = new MemTracker(-1, "central_column_pool", _column_pool_mem_tracker);
     _local_column_pool_mem_tracker = new MemTracker(-1, "local_column_pool", _column_pool_mem_tracker);
     _page_cache_mem_tracker = new MemTracker(-1, "page_cache", _mem_tracker);
+    _segment_footer_cache_mem_tracker = new MemTracker(-1, "segment_footer_cache", _mem_tracker);
+    _delete_bitmap_cache_mem_tracker = new MemTracker(-1, "delete_bitmap_cache", _mem_tracker);
+    _decoded_page_cache_mem_tracker = new MemTracker(-1, "decoded_page_cache", _mem_tracker);
+    _hdfs_file_meta_cache_mem_tracker = new MemTracker(-1, "hdfs_file_meta_cache", _mem_tracker);
     _update_mem_tracker = new MemTracker(bytes_limit * 0.6, "update", _mem_tracker);
 
     return Status::OK();
@@ -227,6 +264,30 @@ Status ExecEnv::_init_mem_tracker() {
     }
     StoragePageCache::create_global_cache(_page_cache_mem_tracker, storage_cache_limit);
 
+    int64_t footer_cache_limit = ParseUtil::parse_mem_spec(config::segment_footer_cache_limit, &is_percent);
+    segment_v2::SegmentFooterCache::create_global_cache(_segment_footer_cache_mem_tracker,
+                                                        std::max<int64_t>(footer_cache_limit, 0));
+
+    int64_t delete_bitmap_cache_limit = ParseUtil::parse_mem_spec(config::delete_bitmap_cache_limit, &is_percent);
+    vectorized::DeleteBitmapCache::create_global_cache(_delete_bitmap_cache_mem_tracker,
+                                                       std::max<int64_t>(delete_bitmap_cache_limit, 0));
+
+    int64_t decoded_page_cache_limit = ParseUtil::parse_mem_spec(config::decoded_page_cache_limit, &is_percent);
+    segment_v2::DecodedPageCache::create_global_cache(_decoded_page_cache_mem_tracker,
+                                                      std::max<int64_t>(decoded_page_cache_limit, 0));
+
+    int64_t hdfs_file_meta_cache_limit = ParseUtil::parse_mem_spec(config::hdfs_file_meta_cache_limit, &is_percent);
+    vectorized::HdfsFileMetaCache::create_global_cache(_hdfs_file_meta_cache_mem_tracker,
+                                                       std::max<int64_t>(hdfs_file_meta_cache_limit, 0));
+
+    Status st = BlockCache::create_global_cache(config::block_cache_disk_path,
+                                                std::max<int64_t>(config::block_cache_disk_capacity, 0),
+                                                std::max<int64_t>(config::block_cache_block_size, 0),
+                                                config::block_cache_write_threads);
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to create block cache in " << config::block_cache_disk_path << ": " << st;
+    }
+
     // TODO(zc): The current memory usage configuration is a bit confusing,
     // we need to sort out the use of memory
     return Status::OK();
@@ -240,6 +301,7 @@ void ExecEnv::_init_buffer_pool(int64_t min_page_size, int64_t capacity, int64_t
 }
 
 void ExecEnv::_destory() {
+    SamplingProfiler::instance()->stop();
     delete _runtime_filter_worker;
     delete _brpc_stub_cache;
     delete _load_stream_mgr;
@@ -252,10 +314,23 @@ void ExecEnv::_destory() {
     delete _master_info;
     delete _driver_dispatcher;
     delete _fragment_mgr;
+    delete _fragment_result_cache;
+    delete _exchange_merge_thread_pool;
     delete _etl_thread_pool;
     delete _thread_pool;
+    delete _scan_thread_pool;
+    delete _scan_scheduler;
     delete _thread_mgr;
     delete _update_mem_tracker;
+    segment_v2::SegmentFooterCache::release_global_cache();
+    vectorized::DeleteBitmapCache::release_global_cache();
+    segment_v2::DecodedPageCache::release_global_cache();
+    vectorized::HdfsFileMetaCache::release_global_cache();
+    BlockCache::release_global_cache();
+    delete _segment_footer_cache_mem_tracker;
+    delete _delete_bitmap_cache_mem_tracker;
+    delete _decoded_page_cache_mem_tracker;
+    delete _hdfs_file_meta_cache_mem_tracker;
     delete _page_cache_mem_tracker;
     delete _local_column_pool_mem_tracker;
     delete _central_column_pool_mem_tracker;
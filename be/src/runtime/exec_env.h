@@ -41,6 +41,7 @@ class DiskIoMgr;
 class EvHttpServer;
 class ExternalScanContextMgr;
 class FragmentMgr;
+class FragmentResultCache;
 class LoadPathMgr;
 class LoadStreamMgr;
 class MemTracker;
@@ -51,12 +52,14 @@ class PriorityThreadPool;
 class ReservationTracker;
 class ResultBufferMgr;
 class ResultQueueMgr;
+class ScanScheduler;
 class TMasterInfo;
 class LoadChannelMgr;
 class TestExecEnv;
 class ThreadResourceMgr;
 class TmpFileMgr;
 class WebPageHandler;
+class WorkStealingThreadPool;
 class StreamLoadExecutor;
 class RoutineLoadTaskExecutor;
 class SmallFileMgr;
@@ -123,15 +126,25 @@ public:
     MemTracker* local_column_pool_mem_tracker() { return _local_column_pool_mem_tracker; }
     MemTracker* central_column_pool_mem_tracker() { return _central_column_pool_mem_tracker; }
     MemTracker* page_cache_mem_tracker() { return _page_cache_mem_tracker; }
+    MemTracker* segment_footer_cache_mem_tracker() { return _segment_footer_cache_mem_tracker; }
+    MemTracker* delete_bitmap_cache_mem_tracker() { return _delete_bitmap_cache_mem_tracker; }
+    MemTracker* decoded_page_cache_mem_tracker() { return _decoded_page_cache_mem_tracker; }
+    MemTracker* hdfs_file_meta_cache_mem_tracker() { return _hdfs_file_meta_cache_mem_tracker; }
     MemTracker* update_mem_tracker() { return _update_mem_tracker; }
 
     ThreadResourceMgr* thread_mgr() { return _thread_mgr; }
     PriorityThreadPool* thread_pool() { return _thread_pool; }
+    ScanScheduler* scan_scheduler() { return _scan_scheduler; }
     PriorityThreadPool* pipeline_io_thread_pool() { return _pipeline_io_thread_pool; }
+    // Null unless config::enable_work_stealing_scan_thread_pool.
+    WorkStealingThreadPool* scan_thread_pool() { return _scan_thread_pool; }
     size_t increment_num_scan_operators(size_t n) { return _num_scan_operators.fetch_add(n); }
     size_t decrement_num_scan_operators(size_t n) { return _num_scan_operators.fetch_sub(n); }
     PriorityThreadPool* etl_thread_pool() { return _etl_thread_pool; }
+    // Runs the merges of the groups of the senders of the merging exchanges, see ParallelSortedChunksMerger.
+    ThreadPool* exchange_merge_thread_pool() { return _exchange_merge_thread_pool; }
     FragmentMgr* fragment_mgr() { return _fragment_mgr; }
+    FragmentResultCache* fragment_result_cache() { return _fragment_result_cache; }
     starrocks::pipeline::DriverDispatcher* driver_dispatcher() { return _driver_dispatcher; }
     TMasterInfo* master_info() { return _master_info; }
     LoadPathMgr* load_path_mgr() { return _load_path_mgr; }
@@ -209,15 +222,25 @@ private:
     // The memory used for page cache
     MemTracker* _page_cache_mem_tracker = nullptr;
 
+    // The memory used for segment footer cache
+    MemTracker* _segment_footer_cache_mem_tracker = nullptr;
+    MemTracker* _delete_bitmap_cache_mem_tracker = nullptr;
+    MemTracker* _decoded_page_cache_mem_tracker = nullptr;
+    MemTracker* _hdfs_file_meta_cache_mem_tracker = nullptr;
+
     // The memory tracker for update manager
     MemTracker* _update_mem_tracker = nullptr;
 
     ThreadResourceMgr* _thread_mgr = nullptr;
     PriorityThreadPool* _thread_pool = nullptr;
+    ScanScheduler* _scan_scheduler = nullptr;
     PriorityThreadPool* _pipeline_io_thread_pool = nullptr;
+    WorkStealingThreadPool* _scan_thread_pool = nullptr;
     std::atomic<size_t> _num_scan_operators;
     PriorityThreadPool* _etl_thread_pool = nullptr;
+    ThreadPool* _exchange_merge_thread_pool = nullptr;
     FragmentMgr* _fragment_mgr = nullptr;
+    FragmentResultCache* _fragment_result_cache = nullptr;
     starrocks::pipeline::DriverDispatcher* _driver_dispatcher;
     TMasterInfo* _master_info = nullptr;
     LoadPathMgr* _load_path_mgr = nullptr;
@@ -21,10 +21,12 @@
 
 #include "runtime/file_result_writer.h"
 
+#include "column/chunk.h"
 #include "exec/broker_writer.h"
 #include "exec/local_file_writer.h"
-#include "exec/parquet_writer.h"
+#include "exec/vectorized/parquet_writer.h"
 #include "exprs/expr.h"
+#include "exprs/expr_context.h"
 #include "gen_cpp/InternalService_types.h"
 #include "runtime/primitive_type.h"
 #include "runtime/row_batch.h"
@@ -78,9 +80,21 @@ Status FileResultWriter::_create_file_writer() {
     case TFileFormatType::FORMAT_CSV_PLAIN:
         // just use file writer is enough
         break;
-    case TFileFormatType::FORMAT_PARQUET:
-        _parquet_writer = new ParquetWriterWrapper(_file_writer, _output_expr_ctxs);
+    case TFileFormatType::FORMAT_PARQUET: {
+        std::vector<TypeDescriptor> types;
+        for (auto* ctx : _output_expr_ctxs) {
+            types.emplace_back(ctx->root()->type());
+        }
+        vectorized::ParquetWriterOptions options;
+        options.max_row_group_bytes = _file_opts->parquet_max_row_group_bytes;
+        options.column_names = _file_opts->parquet_column_names;
+        options.compression_types = _file_opts->parquet_compression_types;
+        options.use_dict = _file_opts->parquet_use_dict;
+        options.num_encode_threads = config::export_parquet_encode_threads;
+        _parquet_writer = new vectorized::ParquetChunkWriter(_file_writer, std::move(types), std::move(options));
+        RETURN_IF_ERROR(_parquet_writer->init());
         break;
+    }
     default:
         return Status::InternalError(strings::Substitute("unsupport file format: $0", _file_opts->file_format));
     }
@@ -114,19 +128,47 @@ Status FileResultWriter::append_row_batch(const RowBatch* batch) {
 
     SCOPED_TIMER(_append_row_batch_timer);
     if (_parquet_writer != nullptr) {
-        RETURN_IF_ERROR(_parquet_writer->write(*batch));
-    } else {
-        RETURN_IF_ERROR(_write_csv_file(*batch));
+        return Status::NotSupported("parquet files are only exported from the chunks");
     }
+    RETURN_IF_ERROR(_write_csv_file(*batch));
 
     _written_rows += batch->num_rows();
     return Status::OK();
 }
 
 Status FileResultWriter::append_chunk(vectorized::Chunk* chunk) {
+    if (nullptr == chunk || 0 == chunk->num_rows() || _parquet_writer == nullptr) {
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_append_row_batch_timer);
+    RETURN_IF_ERROR(_write_parquet_file(chunk));
+    _written_rows += chunk->num_rows();
     return Status::OK();
 }
 
+Status FileResultWriter::_write_parquet_file(vectorized::Chunk* chunk) {
+    vectorized::Columns columns;
+    {
+        SCOPED_TIMER(_convert_tuple_timer);
+        columns.reserve(_output_expr_ctxs.size());
+        for (auto* ctx : _output_expr_ctxs) {
+            columns.emplace_back(ctx->evaluate(chunk));
+        }
+    }
+
+    int64_t written_bytes = _parquet_writer->written_bytes();
+    {
+        SCOPED_TIMER(_file_write_timer);
+        RETURN_IF_ERROR(_parquet_writer->write(columns));
+    }
+    // the columns are written into the file once they are a row group
+    written_bytes = _parquet_writer->written_bytes() - written_bytes;
+    COUNTER_UPDATE(_written_data_bytes, written_bytes);
+    _current_written_bytes += written_bytes;
+    return _create_new_file_if_exceed_size();
+}
+
 Status FileResultWriter::_write_csv_file(const RowBatch& batch) {
     int num_rows = batch.num_rows();
     for (int i = 0; i < num_rows; ++i) {
@@ -293,12 +335,13 @@ Status FileResultWriter::_create_new_file_if_exceed_size() {
 
 Status FileResultWriter::_close_file_writer(bool done) {
     if (_parquet_writer != nullptr) {
-        _parquet_writer->close();
+        // the file writer is closed by the parquet writer
+        Status st = _parquet_writer->close();
         delete _parquet_writer;
         _parquet_writer = nullptr;
-        if (!done) {
-            //TODO(cmy): implement parquet writer later
-        }
+        delete _file_writer;
+        _file_writer = nullptr;
+        RETURN_IF_ERROR(st);
     } else if (_file_writer != nullptr) {
         _file_writer->close();
         delete _file_writer;
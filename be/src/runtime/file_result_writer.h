@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "common/config.h"
 #include "gen_cpp/DataSinks_types.h"
 #include "runtime/result_writer.h"
 #include "runtime/runtime_state.h"
@@ -29,11 +30,14 @@ namespace starrocks {
 
 class ExprContext;
 class FileWriter;
-class ParquetWriterWrapper;
 class RowBatch;
 class RuntimeProfile;
 class TupleRow;
 
+namespace vectorized {
+class ParquetChunkWriter;
+}
+
 struct ResultFileOptions {
     bool is_local_file;
     std::string file_path;
@@ -43,6 +47,11 @@ struct ResultFileOptions {
     size_t max_file_size_bytes = 1 * 1024 * 1024 * 1024; // 1GB
     std::vector<TNetworkAddress> broker_addresses;
     std::map<std::string, std::string> broker_properties;
+    // only for parquet
+    int64_t parquet_max_row_group_bytes = config::export_parquet_row_group_bytes;
+    std::vector<std::string> parquet_column_names;
+    std::vector<TCompressionType::type> parquet_compression_types;
+    std::vector<bool> parquet_use_dict;
 
     ResultFileOptions(const TResultFileSinkOptions& t_opt) {
         file_path = t_opt.file_path;
@@ -59,6 +68,18 @@ struct ResultFileOptions {
         if (t_opt.__isset.broker_properties) {
             broker_properties = t_opt.broker_properties;
         }
+        if (t_opt.__isset.parquet_max_row_group_bytes) {
+            parquet_max_row_group_bytes = t_opt.parquet_max_row_group_bytes;
+        }
+        if (t_opt.__isset.parquet_column_names) {
+            parquet_column_names = t_opt.parquet_column_names;
+        }
+        if (t_opt.__isset.parquet_compression_types) {
+            parquet_compression_types = t_opt.parquet_compression_types;
+        }
+        if (t_opt.__isset.parquet_use_dict) {
+            parquet_use_dict = t_opt.parquet_use_dict;
+        }
     }
 };
 
@@ -76,6 +97,7 @@ public:
 
 private:
     Status _write_csv_file(const RowBatch& batch);
+    Status _write_parquet_file(vectorized::Chunk* chunk);
     Status _write_one_row_as_csv(TupleRow* row);
 
     // if buffer exceed the limit, write the data buffered in _plain_text_outstream via file_writer
@@ -97,10 +119,10 @@ private:
     const std::vector<ExprContext*>& _output_expr_ctxs;
 
     // If the result file format is plain text, like CSV, this _file_writer is owned by this FileResultWriter.
-    // If the result file format is Parquet, this _file_writer is owned by _parquet_writer.
+    // If the result file format is Parquet, this _file_writer is closed by _parquet_writer.
     FileWriter* _file_writer = nullptr;
-    // parquet file writer
-    ParquetWriterWrapper* _parquet_writer = nullptr;
+    // parquet file writer of the chunks
+    vectorized::ParquetChunkWriter* _parquet_writer = nullptr;
     // Used to buffer the export data of plain text
     // TODO(cmy): I simply use a stringstrteam to buffer the data, to avoid calling
     // file writer's write() for every single row.
@@ -24,6 +24,7 @@
 #include <gperftools/profiler.h>
 #include <thrift/protocol/TDebugProtocol.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <sstream>
@@ -42,6 +43,7 @@
 #include "runtime/datetime_value.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
 #include "runtime/plan_fragment_executor.h"
 #include "runtime/runtime_filter_worker.h"
 #include "service/backend_options.h"
@@ -50,6 +52,7 @@
 #include "util/stopwatch.hpp"
 #include "util/threadpool.h"
 #include "util/thrift_util.h"
+#include "util/time.h"
 #include "util/uid_util.h"
 #include "util/url_coding.h"
 
@@ -333,6 +336,10 @@ FragmentMgr::FragmentMgr(ExecEnv* exec_env)
         std::lock_guard<std::mutex> lock(_lock);
         return _fragment_map.size();
     });
+    REGISTER_GAUGE_STARROCKS_METRIC(queued_plan_fragment_count, [this]() {
+        std::lock_guard<std::mutex> lock(_admission_lock);
+        return _admission_queue.size();
+    });
     // TODO(zc): we need a better thread-pool
     // now one user can use all the thread pool, others have no resource.
     ThreadPoolBuilder("FragmentMgrThreadPool")
@@ -351,6 +358,10 @@ FragmentMgr::~FragmentMgr() {
     _thread_pool->shutdown();
 
     // Only me can delete
+    {
+        std::lock_guard<std::mutex> lock(_admission_lock);
+        _admission_queue.clear();
+    }
     {
         std::lock_guard<std::mutex> lock(_lock);
         _fragment_map.clear();
@@ -359,6 +370,77 @@ FragmentMgr::~FragmentMgr() {
 
 static void empty_function(PlanFragmentExecutor* exec) {}
 
+int64_t FragmentMgr::_admission_reserved_bytes(FragmentExecState* exec_state) const {
+    int64_t percent = config::fragment_admission_mem_percent;
+    if (percent <= 0) {
+        return 0;
+    }
+    MemTracker* query_pool = _exec_env->query_pool_mem_tracker();
+    const TQueryOptions& options = exec_state->executor()->runtime_state()->query_options();
+    if (query_pool == nullptr || !query_pool->has_limit() || !options.__isset.mem_limit || options.mem_limit <= 0) {
+        return 0;
+    }
+    return std::min(options.mem_limit, query_pool->limit()) * percent / 100;
+}
+
+void FragmentMgr::_admit_queued_fragments() {
+    std::vector<QueuedFragment> admitted;
+    {
+        std::lock_guard<std::mutex> lock(_admission_lock);
+        if (_admission_queue.empty()) {
+            return;
+        }
+        MemTracker* query_pool = _exec_env->query_pool_mem_tracker();
+        int64_t spare_bytes = query_pool->limit() - query_pool->consumption();
+        int64_t now_ns = MonotonicNanos();
+        int64_t timeout_ns = static_cast<int64_t>(config::fragment_admission_timeout_ms) * 1000000;
+        while (!_admission_queue.empty()) {
+            QueuedFragment& fragment = _admission_queue.front();
+            bool has_spare_mem = fragment.reserved_bytes <= spare_bytes;
+            if (!has_spare_mem && now_ns - fragment.queued_ns < timeout_ns) {
+                break;
+            }
+            fragment.timed_out = !has_spare_mem;
+            // The instances admitted at once don't consume the memory yet, so each takes its share of the spare.
+            spare_bytes -= fragment.reserved_bytes;
+            admitted.emplace_back(std::move(fragment));
+            _admission_queue.pop_front();
+        }
+    }
+    for (QueuedFragment& fragment : admitted) {
+        int64_t wait_ns = MonotonicNanos() - fragment.queued_ns;
+        StarRocksMetrics::instance()->fragment_admission_wait_duration_us.increment(wait_ns / NANOS_PER_MICRO);
+        if (fragment.timed_out) {
+            MemTracker* query_pool = _exec_env->query_pool_mem_tracker();
+            StarRocksMetrics::instance()->fragment_admission_timeout_total.increment(1);
+            LOG(WARNING) << "execute fragment without enough memory after waiting " << wait_ns / 1000000
+                         << "ms, instance_id=" << print_id(fragment.exec_state->fragment_instance_id())
+                         << ", reserved=" << fragment.reserved_bytes << ", consumption=" << query_pool->consumption()
+                         << ", limit=" << query_pool->limit();
+        }
+        // The error has been logged, and the instance cancelled.
+        (void)_submit(fragment.exec_state, fragment.cb);
+    }
+}
+
+Status FragmentMgr::_submit(const std::shared_ptr<FragmentExecState>& exec_state, const FinishCallback& cb) {
+    auto st = _thread_pool->submit_func(std::bind<void>(&FragmentMgr::exec_actual, this, exec_state, cb));
+    if (!st.ok()) {
+        const TUniqueId& fragment_instance_id = exec_state->fragment_instance_id();
+        {
+            // Remove the exec state added
+            std::lock_guard<std::mutex> lock(_lock);
+            _fragment_map.erase(fragment_instance_id);
+        }
+        exec_state->cancel(PPlanFragmentCancelReason::INTERNAL_ERROR);
+        std::string error_msg = strings::Substitute("Put planfragment $0 to thread pool failed. err = $1",
+                                                    print_id(fragment_instance_id), st.get_error_msg());
+        LOG(WARNING) << error_msg;
+        return Status::InternalError(error_msg);
+    }
+    return Status::OK();
+}
+
 void FragmentMgr::exec_actual(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb) {
     exec_state->execute();
 
@@ -375,6 +457,8 @@ void FragmentMgr::exec_actual(std::shared_ptr<FragmentExecState> exec_state, Fin
     }
     // Callback after remove from this id
     cb(exec_state->executor());
+    // The memory of the instance has been released once it's executed.
+    _admit_queued_fragments();
     // NOTE: 'exec_state' is desconstructed here without lock
 }
 
@@ -408,21 +492,16 @@ Status FragmentMgr::exec_plan_fragment(const TExecPlanFragmentParams& params, Fi
         _fragment_map.insert(std::make_pair(fragment_instance_id, exec_state));
     }
 
-    auto st = _thread_pool->submit_func(std::bind<void>(&FragmentMgr::exec_actual, this, exec_state, cb));
-    if (!st.ok()) {
-        {
-            // Remove the exec state added
-            std::lock_guard<std::mutex> lock(_lock);
-            _fragment_map.erase(fragment_instance_id);
+    if (int64_t reserved_bytes = _admission_reserved_bytes(exec_state.get()); reserved_bytes > 0) {
+        MemTracker* query_pool = _exec_env->query_pool_mem_tracker();
+        std::lock_guard<std::mutex> lock(_admission_lock);
+        // Behind the instances queued already, so that they are admitted in order.
+        if (!_admission_queue.empty() || query_pool->limit() - query_pool->consumption() < reserved_bytes) {
+            _admission_queue.push_back({exec_state, cb, reserved_bytes, MonotonicNanos()});
+            return Status::OK();
         }
-        exec_state->cancel(PPlanFragmentCancelReason::INTERNAL_ERROR);
-        std::string error_msg = strings::Substitute("Put planfragment $0 to thread pool failed. err = $1",
-                                                    print_id(fragment_instance_id), st.get_error_msg());
-        LOG(WARNING) << error_msg;
-        return Status::InternalError(error_msg);
     }
-
-    return Status::OK();
+    return _submit(exec_state, cb);
 }
 
 Status FragmentMgr::cancel(const TUniqueId& id, const PPlanFragmentCancelReason& reason) {
@@ -486,6 +565,7 @@ void FragmentMgr::cancel_worker() {
             cancel(id, PPlanFragmentCancelReason::TIMEOUT);
             LOG(INFO) << "FragmentMgr cancel worker going to cancel timouet fragment " << print_id(id);
         }
+        _admit_queued_fragments();
 
         // check every 1 seconds
         sleep(1);
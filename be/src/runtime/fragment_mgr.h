@@ -22,6 +22,7 @@
 #ifndef STARROCKS_BE_RUNTIME_FRAGMENT_MGR_H
 #define STARROCKS_BE_RUNTIME_FRAGMENT_MGR_H
 
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -88,6 +89,19 @@ public:
 private:
     void exec_actual(std::shared_ptr<FragmentExecState> exec_state, FinishCallback cb);
 
+    // Submit |exec_state| to the thread pool, unregistering and cancelling it if the pool rejects it.
+    Status _submit(const std::shared_ptr<FragmentExecState>& exec_state, const FinishCallback& cb);
+
+    // The bytes of the query pool which must be spare before |exec_state| executes, i.e.
+    // fragment_admission_mem_percent of its mem_limit, 0 if it's admitted at once.
+    int64_t _admission_reserved_bytes(FragmentExecState* exec_state) const;
+
+    // Submit the queued instances in the order they were queued, while the query pool has the memory reserved for
+    // each one, or once one has been queued for fragment_admission_timeout_ms. Called when an instance finishes, and
+    // every second by the cancel worker, since the instances of the other managers, e.g. the pipeline engine, release
+    // the memory as well.
+    void _admit_queued_fragments();
+
     // This is input params
     ExecEnv* _exec_env;
 
@@ -101,6 +115,17 @@ private:
     std::thread _cancel_thread;
     // every job is a pool
     std::unique_ptr<ThreadPool> _thread_pool;
+
+    // The instances waiting for the memory of the query pool, which hold no thread of the pool till admitted.
+    struct QueuedFragment {
+        std::shared_ptr<FragmentExecState> exec_state;
+        FinishCallback cb;
+        int64_t reserved_bytes;
+        int64_t queued_ns;
+        bool timed_out = false;
+    };
+    std::mutex _admission_lock;
+    std::deque<QueuedFragment> _admission_queue;
 };
 
 } // namespace starrocks
@@ -0,0 +1,200 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/fragment_result_cache.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "column/chunk.h"
+#include "column/column.h"
+#include "storage/lru_cache.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet.h"
+#include "storage/tablet_manager.h"
+#include "util/coding.h"
+#include "util/thrift_util.h"
+
+namespace starrocks {
+
+// The functions whose results change from one call to the next, which make a fragment not cacheable.
+static const std::unordered_set<std::string> NONDETERMINISTIC_FUNCTIONS = {
+        "rand",    "random",       "uuid",          "now",          "current_timestamp", "localtime", "localtimestamp",
+        "curdate", "current_date", "curtime",       "current_time", "unix_timestamp",    "utc_timestamp", "sleep",
+        "connection_id", "current_user", "user"};
+
+static bool is_deterministic(const std::vector<TExpr>& exprs) {
+    for (const auto& expr : exprs) {
+        for (const auto& node : expr.nodes) {
+            if (node.__isset.fn && NONDETERMINISTIC_FUNCTIONS.count(node.fn.name.function_name) > 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Only an AggregateStreamingNode over an OlapScanNode is cached: its chunks are partial aggregations, which the next
+// fragment merges whatever the number and the order of the chunks, so the chunks of the new versions of the tablets
+// can be sent after the cached ones.
+static bool is_cacheable(const TExecPlanFragmentParams& request) {
+    const TPlanFragment& fragment = request.fragment;
+    if (!request.params.use_vectorized || !fragment.__isset.plan || !fragment.__isset.output_sink ||
+        fragment.output_sink.type != TDataSinkType::DATA_STREAM_SINK) {
+        return false;
+    }
+    const std::vector<TPlanNode>& nodes = fragment.plan.nodes;
+    if (nodes.size() != 2) {
+        return false;
+    }
+    const TPlanNode& agg = nodes[0];
+    const TPlanNode& scan = nodes[1];
+    if (agg.node_type != TPlanNodeType::AGGREGATION_NODE || agg.num_children != 1 ||
+        scan.node_type != TPlanNodeType::OLAP_SCAN_NODE) {
+        return false;
+    }
+    const TAggregationNode& agg_node = agg.agg_node;
+    if (!agg_node.__isset.use_streaming_preaggregation || !agg_node.use_streaming_preaggregation ||
+        agg_node.need_finalize || agg_node.aggregate_functions.empty()) {
+        return false;
+    }
+    for (const TPlanNode* node : {&agg, &scan}) {
+        if (node->limit >= 0 || !node->probe_runtime_filters.empty() || !is_deterministic(node->conjuncts)) {
+            return false;
+        }
+    }
+    return is_deterministic(agg_node.grouping_exprs) && is_deterministic(agg_node.aggregate_functions);
+}
+
+// Whether the rows of |tablet_id| from |from_version| + 1 to |to_version| can be aggregated on top of the result
+// computed at |from_version|.
+static bool can_scan_delta(int64_t tablet_id, SchemaHash schema_hash, int64_t from_version, int64_t to_version) {
+    if (to_version < from_version) {
+        return false;
+    }
+    auto tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, schema_hash);
+    // The new rows of the other key models may replace the cached ones.
+    if (tablet == nullptr || tablet->keys_type() != KeysType::DUP_KEYS) {
+        return false;
+    }
+    tablet->obtain_header_rdlock();
+    bool ok = true;
+    // A delete since applies to the cached rows as well.
+    for (const auto& pred : tablet->delete_predicates()) {
+        if (pred.version() > from_version) {
+            ok = false;
+            break;
+        }
+    }
+    // The new rowsets may have been compacted with the cached ones.
+    ok = ok && tablet->capture_consistent_versions(Version(from_version + 1, to_version), nullptr) == OLAP_SUCCESS;
+    tablet->release_header_lock();
+    return ok;
+}
+
+FragmentResultCache::FragmentResultCache(size_t capacity) {
+    if (capacity > 0) {
+        _cache.reset(new_lru_cache(capacity));
+    }
+}
+
+FragmentResultCache::~FragmentResultCache() = default;
+
+FragmentResultCache::Probe FragmentResultCache::probe(const TExecPlanFragmentParams& request,
+                                                      std::vector<TScanRangeParams>* scan_ranges) {
+    Probe probe;
+    if (!enabled() || !is_cacheable(request)) {
+        return probe;
+    }
+    // tablet id -> schema hash
+    std::map<int64_t, SchemaHash> schema_hashes;
+    for (const auto& range : *scan_ranges) {
+        if (!range.scan_range.__isset.internal_scan_range) {
+            return probe;
+        }
+        const TInternalScanRange& scan_range = range.scan_range.internal_scan_range;
+        schema_hashes[scan_range.tablet_id] = strtoul(scan_range.schema_hash.c_str(), nullptr, 10);
+        probe.tablet_versions[scan_range.tablet_id] = strtoul(scan_range.version.c_str(), nullptr, 10);
+    }
+    // A tablet read by several ranges can't be skipped as a whole.
+    if (schema_hashes.empty() || schema_hashes.size() != scan_ranges->size()) {
+        probe.tablet_versions.clear();
+        return probe;
+    }
+
+    ThriftSerializer serializer(false, 4096);
+    std::string plan;
+    std::string desc_tbl;
+    if (!serializer.serialize(const_cast<TPlan*>(&request.fragment.plan), &plan).ok() ||
+        !serializer.serialize(const_cast<TDescriptorTable*>(&request.desc_tbl), &desc_tbl).ok()) {
+        probe.tablet_versions.clear();
+        return probe;
+    }
+    const std::string& time_zone = request.query_globals.time_zone;
+    for (const std::string* part : {&plan, &desc_tbl, &time_zone}) {
+        put_fixed64_le(&probe.key, part->size());
+        probe.key.append(*part);
+    }
+    for (const auto& [tablet_id, schema_hash] : schema_hashes) {
+        put_fixed64_le(&probe.key, tablet_id);
+        put_fixed32_le(&probe.key, schema_hash);
+    }
+
+    EntryPtr cached = _lookup(probe.key);
+    if (cached == nullptr) {
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        return probe;
+    }
+    std::unordered_map<int64_t, int64_t> start_versions;
+    for (const auto& [tablet_id, version] : probe.tablet_versions) {
+        auto it = cached->tablet_versions.find(tablet_id);
+        DCHECK(it != cached->tablet_versions.end());
+        if (it->second == version) {
+            continue;
+        }
+        if (!can_scan_delta(tablet_id, schema_hashes[tablet_id], it->second, version)) {
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            return probe;
+        }
+        start_versions[tablet_id] = it->second + 1;
+    }
+    auto unchanged = [&](const TScanRangeParams& range) {
+        return start_versions.count(range.scan_range.internal_scan_range.tablet_id) == 0;
+    };
+    scan_ranges->erase(std::remove_if(scan_ranges->begin(), scan_ranges->end(), unchanged), scan_ranges->end());
+    (start_versions.empty() ? _hits : _delta_hits).fetch_add(1, std::memory_order_relaxed);
+    probe.cached = std::move(cached);
+    probe.start_versions = std::move(start_versions);
+    return probe;
+}
+
+FragmentResultCache::EntryPtr FragmentResultCache::_lookup(const std::string& key) {
+    auto* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    EntryPtr entry = *reinterpret_cast<EntryPtr*>(_cache->value(handle));
+    _cache->release(handle);
+    return entry;
+}
+
+void FragmentResultCache::insert(const std::string& key, EntryPtr entry) {
+    if (!enabled() || key.empty()) {
+        return;
+    }
+    auto deleter = [](const CacheKey& key, void* value) { delete reinterpret_cast<EntryPtr*>(value); };
+    size_t charge = key.size() + sizeof(Entry) + entry->bytes;
+    auto* handle = _cache->insert(CacheKey(key), new EntryPtr(std::move(entry)), charge, deleter);
+    _cache->release(handle);
+}
+
+vectorized::ChunkPtr FragmentResultCache::copy_chunk(const vectorized::Chunk& chunk) {
+    vectorized::Columns columns;
+    columns.reserve(chunk.num_columns());
+    for (const auto& column : chunk.columns()) {
+        columns.emplace_back(column->clone_shared());
+    }
+    return std::make_shared<vectorized::Chunk>(std::move(columns), chunk.get_slot_id_to_index_map(),
+                                               chunk.get_tuple_id_to_index_map());
+}
+
+} // namespace starrocks
@@ -0,0 +1,80 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "gen_cpp/InternalService_types.h"
+
+namespace starrocks {
+
+class Cache;
+
+// FragmentResultCache caches the chunks sent by the fragment instances which pre-aggregate an olap scan, i.e. of a plan
+// of an AggregateStreamingNode over an OlapScanNode, so that the same aggregation sent again and again over the same
+// tablets, e.g. by a dashboard, skips the scan and the aggregation.
+//
+// A result is keyed by the plan and the descriptors of the fragment, the time zone and the tablets scanned, and
+// records the versions of the tablets it is computed at. As the chunks are the partial aggregations to be merged by
+// the next fragment, a result whose duplicate key tablets only got new rowsets since can be reused as well: only the
+// new versions of the changed tablets are scanned, and their partial aggregations are sent after the cached ones.
+class FragmentResultCache {
+public:
+    struct Entry {
+        // tablet id -> the version the chunks are computed at
+        std::map<int64_t, int64_t> tablet_versions;
+        std::vector<vectorized::ChunkPtr> chunks;
+        size_t bytes = 0;
+    };
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+    // How a fragment instance uses the cache.
+    struct Probe {
+        // Empty if the instance is not cacheable.
+        std::string key;
+        // The result to send before the chunks of the scan, nullptr if there is none to reuse.
+        EntryPtr cached;
+        // tablet id -> the first version to scan, for the tablets changed since |cached|.
+        std::unordered_map<int64_t, int64_t> start_versions;
+        // tablet id -> the version of the tablet scanned.
+        std::map<int64_t, int64_t> tablet_versions;
+    };
+
+    // Disabled if |capacity| is 0.
+    explicit FragmentResultCache(size_t capacity);
+    ~FragmentResultCache();
+
+    FragmentResultCache(const FragmentResultCache&) = delete;
+    void operator=(const FragmentResultCache&) = delete;
+
+    bool enabled() const { return _cache != nullptr; }
+
+    // Probe the cache for the fragment instance of |request|, whose olap scan node reads |*scan_ranges|. The ranges of
+    // the tablets whose results are up to date in the cache are removed from |*scan_ranges|.
+    Probe probe(const TExecPlanFragmentParams& request, std::vector<TScanRangeParams>* scan_ranges);
+
+    void insert(const std::string& key, EntryPtr entry);
+
+    int64_t hits() const { return _hits.load(std::memory_order_relaxed); }
+    int64_t delta_hits() const { return _delta_hits.load(std::memory_order_relaxed); }
+    int64_t misses() const { return _misses.load(std::memory_order_relaxed); }
+
+    // A deep copy of |chunk| to be kept in an entry, as the sinks and the plan may modify their chunks.
+    static vectorized::ChunkPtr copy_chunk(const vectorized::Chunk& chunk);
+
+private:
+    EntryPtr _lookup(const std::string& key);
+
+    std::unique_ptr<Cache> _cache;
+    std::atomic<int64_t> _hits{0};
+    std::atomic<int64_t> _delta_hits{0};
+    std::atomic<int64_t> _misses{0};
+};
+
+} // namespace starrocks
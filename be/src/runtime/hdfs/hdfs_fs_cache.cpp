@@ -2,11 +2,29 @@
 
 #include "runtime/hdfs/hdfs_fs_cache.h"
 
+#include "common/config.h"
+#include "env/env_hdfs.h"
 #include "gutil/strings/substitute.h"
+#include "util/coding.h"
 #include "util/hdfs_util.h"
 
 namespace starrocks {
 
+// The file of a handle in the file cache, which is closed once it is evicted and released by the readers.
+class CachedHdfsRandomAccessFile final : public HdfsRandomAccessFile {
+public:
+    CachedHdfsRandomAccessFile(hdfsFS fs, hdfsFile file, std::string filename)
+            : HdfsRandomAccessFile(fs, file, std::move(filename)) {}
+    ~CachedHdfsRandomAccessFile() override { hdfsCloseFile(hdfs_fs(), hdfs_file()); }
+};
+
+HdfsFsCache::HdfsFsCache() {
+    if (config::hdfs_file_handle_cache_capacity > 0) {
+        _file_cache = std::make_unique<FileCache<RandomAccessFile>>("Hdfs file handle cache",
+                                                                    config::hdfs_file_handle_cache_capacity);
+    }
+}
+
 static Status parse_namenode(const std::string& path, std::string* namenode) {
     const std::string local_fs("file:/");
     size_t n = path.find("://");
@@ -56,6 +74,16 @@ Status HdfsFsCache::get_connection(const std::string& path, hdfsFS* fs, HdfsFsMa
         } else {
             auto hdfs_builder = hdfsNewBuilder();
             hdfsBuilderSetNameNode(hdfs_builder, namenode.c_str());
+            // A read of a block not done in the threshold is hedged by another read of a different replica, the
+            // first of which done is taken. The builder keeps the pointers to the values till it connects.
+            std::string hedged_read_threads = std::to_string(config::hdfs_hedged_read_threads);
+            std::string hedged_read_threshold = std::to_string(config::hdfs_hedged_read_threshold_ms);
+            if (config::hdfs_hedged_read_threads > 0) {
+                hdfsBuilderConfSetStr(hdfs_builder, "dfs.client.hedged.read.threadpool.size",
+                                      hedged_read_threads.c_str());
+                hdfsBuilderConfSetStr(hdfs_builder, "dfs.client.hedged.read.threshold.millis",
+                                      hedged_read_threshold.c_str());
+            }
             *fs = hdfsBuilderConnect(hdfs_builder);
             if (*fs == nullptr) {
                 return Status::InternalError(strings::Substitute("fail to connect hdfs namenode, name=$0, err=$1",
@@ -72,4 +100,23 @@ Status HdfsFsCache::get_connection(const std::string& path, hdfsFS* fs, HdfsFsMa
     return Status::OK();
 }
 
+Status HdfsFsCache::open_file(hdfsFS fs, const std::string& path, int64_t modification_time,
+                              std::shared_ptr<RandomAccessFile>* file) {
+    DCHECK(_file_cache != nullptr);
+    std::string key = path;
+    put_fixed64_le(&key, modification_time);
+
+    auto handle = std::make_shared<OpenedFileHandle<RandomAccessFile>>();
+    if (!_file_cache->lookup(key, handle.get())) {
+        auto* hdfs_file = hdfsOpenFile(fs, path.c_str(), O_RDONLY, 0, 0, 0);
+        if (hdfs_file == nullptr) {
+            return Status::InternalError(strings::Substitute("open file failed, file=$0", path));
+        }
+        _file_cache->insert(key, new CachedHdfsRandomAccessFile(fs, hdfs_file, path), handle.get());
+    }
+    // the file shares the ownership of the handle
+    *file = std::shared_ptr<RandomAccessFile>(handle, handle->file());
+    return Status::OK();
+}
+
 } // namespace starrocks
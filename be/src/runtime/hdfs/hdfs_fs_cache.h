@@ -4,16 +4,20 @@
 
 #include <hdfs/hdfs.h>
 
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
 
 #include "common/status.h"
 #include "gutil/macros.h"
+#include "util/file_cache.h"
 
 namespace starrocks {
 
-// Cache for HDFS file system
+class RandomAccessFile;
+
+// Cache for HDFS file system, and the handles of the recently opened files of them.
 class HdfsFsCache {
 public:
     using HdfsFsMap = std::unordered_map<std::string, hdfsFS>;
@@ -26,11 +30,24 @@ public:
     // This function is thread-safe
     Status get_connection(const std::string& path, hdfsFS* fs, HdfsFsMap* map = nullptr);
 
+    // Open the file of |path| of |fs| modified at |modification_time|, or reuse the handle of it opened before. The
+    // handles are kept open in an LRU cache of hdfs_file_handle_cache_capacity handles, keyed by the path and
+    // modification time, which tell a file rewritten from its old version. The returned file is shared by the
+    // readers of the file, and keeps the handle open till it is released.
+    // This function is thread-safe
+    Status open_file(hdfsFS fs, const std::string& path, int64_t modification_time,
+                     std::shared_ptr<RandomAccessFile>* file);
+
+    // Whether the handles of the files are cached.
+    bool file_handle_cache_enabled() const { return _file_cache != nullptr; }
+
 private:
     std::mutex _lock;
     HdfsFsMap _cache;
 
-    HdfsFsCache() {}
+    std::unique_ptr<FileCache<RandomAccessFile>> _file_cache;
+
+    HdfsFsCache();
     DISALLOW_COPY_AND_ASSIGN(HdfsFsCache);
 };
 
@@ -21,9 +21,12 @@
 
 #include "runtime/load_channel.h"
 
+#include <algorithm>
+
 #include "runtime/mem_tracker.h"
 #include "runtime/tablets_channel.h"
 #include "storage/lru_cache.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -110,8 +113,7 @@ Status LoadChannel::add_batch(const PTabletWriterAddBatchRequest& request,
     return st;
 }
 
-Status LoadChannel::add_chunk(const PTabletWriterAddChunkRequest& request,
-                              google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec) {
+Status LoadChannel::add_chunk(const PTabletWriterAddChunkRequest& request, PTabletWriterAddBatchResult* response) {
     int64_t index_id = request.index_id();
     // 1. get tablets channel
     std::shared_ptr<TabletsChannel> channel;
@@ -142,8 +144,10 @@ Status LoadChannel::add_chunk(const PTabletWriterAddChunkRequest& request,
     Status st;
     if (request.has_eos() && request.eos()) {
         bool finished = false;
-        RETURN_IF_ERROR(channel->close(request.sender_id(), &finished, request.partition_ids(), tablet_vec));
+        RETURN_IF_ERROR(channel->close(request.sender_id(), &finished, request.partition_ids(),
+                                       response->mutable_tablet_vec()));
         if (finished) {
+            channel->get_load_stage_times(response);
             std::lock_guard<std::mutex> l(_lock);
             _tablets_channels.erase(index_id);
             _finished_channel_ids.emplace(index_id);
@@ -153,6 +157,24 @@ Status LoadChannel::add_chunk(const PTabletWriterAddChunkRequest& request,
     return st;
 }
 
+Status LoadChannel::add_segment(const PTabletWriterAddSegmentRequest& request) {
+    int64_t index_id = request.index_id();
+    std::shared_ptr<TabletsChannel> channel;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto it = _tablets_channels.find(index_id);
+        if (it == _tablets_channels.end()) {
+            std::stringstream ss;
+            ss << "load channel " << _load_id << " add segment with unknown index id: " << index_id;
+            return Status::InternalError(ss.str());
+        }
+        channel = it->second;
+    }
+    RETURN_IF_ERROR(channel->add_segment(request));
+    _last_updated_time.store(time(nullptr));
+    return Status::OK();
+}
+
 void LoadChannel::_handle_mem_exceed_limit() {
     // lock so that only one thread can check mem limit
     std::lock_guard<std::mutex> l(_lock);
@@ -164,70 +186,75 @@ void LoadChannel::_handle_mem_exceed_limit() {
               << " has exceeded limit=" << _mem_tracker->limit();
 
     int64_t exceeded_mem = _mem_tracker->consumption() - _mem_tracker->limit();
-    std::vector<FlushTablet> flush_tablets;
-    std::set<int64_t> flush_tablet_ids;
-    int64_t tablet_mem_consumption;
-    do {
-        std::shared_ptr<TabletsChannel> tablets_channel;
-        int64_t tablet_id = -1;
-        _reduce_mem_usage_async_internal(flush_tablet_ids, &tablets_channel, &tablet_id, &tablet_mem_consumption);
-        if (tablet_id != -1) {
-            flush_tablets.emplace_back(this, tablets_channel.get(), tablet_id);
-            flush_tablet_ids.insert(tablet_id);
-            exceeded_mem -= tablet_mem_consumption;
-            VLOG(3) << "Flush " << *this << ", tablet id=" << tablet_id
-                    << ", mem consumption=" << tablet_mem_consumption;
-        } else {
-            break;
-        }
-    } while (exceeded_mem > 0);
-
-    // wait flush finish
-    for (const FlushTablet& flush_tablet : flush_tablets) {
-        Status st = flush_tablet.tablets_channel->wait_mem_usage_reduced(flush_tablet.tablet_id);
-        if (!st.ok()) {
-            // wait may return failed, but no need to handle it here, just log.
-            // tablet_vec will only contains success tablet, and then let FE judge it.
-            LOG(WARNING) << "Fail to wait memory reduced. err=" << st.to_string();
-        }
-    }
-    LOG(INFO) << "Reduce memory finish. " << *this << ", flush tablets num=" << flush_tablet_ids.size()
+    std::vector<FlushCandidate> candidates;
+    _get_flush_candidates_unlocked(&candidates);
+    size_t num_flushed = flush_candidates_and_wait(&candidates, exceeded_mem);
+    LOG(INFO) << "Reduce memory finish. " << *this << ", flush tablets num=" << num_flushed
               << ", current mem consumption=" << _mem_tracker->consumption() << ", limit=" << _mem_tracker->limit();
 }
 
-void LoadChannel::reduce_mem_usage_async(const std::set<int64_t>& flush_tablet_ids,
-                                         std::shared_ptr<TabletsChannel>* tablets_channel, int64_t* tablet_id,
-                                         int64_t* tablet_mem_consumption) {
+void LoadChannel::get_flush_candidates(std::vector<FlushCandidate>* candidates) {
     // lock so that only one thread can check mem limit
     std::lock_guard<std::mutex> l(_lock);
-    _reduce_mem_usage_async_internal(flush_tablet_ids, tablets_channel, tablet_id, tablet_mem_consumption);
+    _get_flush_candidates_unlocked(candidates);
+}
+
+void LoadChannel::_get_flush_candidates_unlocked(std::vector<FlushCandidate>* candidates) {
+    std::vector<TabletMemStat> stats;
+    for (auto& it : _tablets_channels) {
+        stats.clear();
+        it.second->get_tablet_mem_stats(&stats);
+        for (const TabletMemStat& stat : stats) {
+            if (stat.mem_consumption > 0) {
+                candidates->push_back({it.second, FlushTablet(this, it.second.get(), stat.tablet_id),
+                                       stat.mem_consumption, stat.first_write_ms});
+            }
+        }
+    }
 }
 
-void LoadChannel::_reduce_mem_usage_async_internal(const std::set<int64_t>& flush_tablet_ids,
-                                                   std::shared_ptr<TabletsChannel>* tablets_channel, int64_t* tablet_id,
-                                                   int64_t* tablet_mem_consumption) {
-    if (_find_largest_consumption_channel(tablets_channel)) {
-        Status st = (*tablets_channel)->reduce_mem_usage_async(flush_tablet_ids, tablet_id, tablet_mem_consumption);
+// The age of the data of a memtable counts up to this many milliseconds.
+static constexpr int64_t kMaxFlushAgeMs = 10 * 60 * 1000;
+
+size_t flush_candidates_and_wait(std::vector<FlushCandidate>* candidates, int64_t mem_to_reduce) {
+    const int64_t now_ms = MonotonicMillis();
+    auto priority = [now_ms](const FlushCandidate& candidate) {
+        int64_t age_ms = 0;
+        if (candidate.first_write_ms > 0) {
+            age_ms = std::min(std::max<int64_t>(now_ms - candidate.first_write_ms, 0), kMaxFlushAgeMs);
+        }
+        return static_cast<double>(candidate.mem_consumption) * (1.0 + static_cast<double>(age_ms) / kMaxFlushAgeMs);
+    };
+    std::sort(candidates->begin(), candidates->end(),
+              [&priority](const FlushCandidate& a, const FlushCandidate& b) { return priority(a) > priority(b); });
+
+    std::vector<const FlushTablet*> flush_tablets;
+    for (const FlushCandidate& candidate : *candidates) {
+        if (mem_to_reduce <= 0) {
+            break;
+        }
+        const FlushTablet& flush_tablet = candidate.tablet;
+        Status st = flush_tablet.tablets_channel->flush_tablet_async(flush_tablet.tablet_id);
         if (!st.ok()) {
             LOG(WARNING) << "Fail to reduce memory async. error=" << st.to_string();
+            continue;
         }
-    } else {
-        // should not happen, add log to observe
-        LOG(WARNING) << "Fail to find suitable tablets channel when memory exceed. "
-                     << "load_id=" << _load_id;
+        flush_tablets.push_back(&flush_tablet);
+        mem_to_reduce -= candidate.mem_consumption;
+        VLOG(3) << "Flush " << *flush_tablet.load_channel << ", tablet id=" << flush_tablet.tablet_id
+                << ", mem consumption=" << candidate.mem_consumption;
     }
-}
 
-// lock should be held when calling this method
-bool LoadChannel::_find_largest_consumption_channel(std::shared_ptr<TabletsChannel>* channel) {
-    int64_t max_consume = 0;
-    for (auto& it : _tablets_channels) {
-        if (it.second->mem_consumption() > max_consume) {
-            max_consume = it.second->mem_consumption();
-            *channel = it.second;
+    // wait flush finish
+    for (const FlushTablet* flush_tablet : flush_tablets) {
+        Status st = flush_tablet->tablets_channel->wait_mem_usage_reduced(flush_tablet->tablet_id);
+        if (!st.ok()) {
+            // wait may return failed, but no need to handle it here, just log.
+            // tablet_vec will only contains success tablet, and then let FE judge it.
+            LOG(WARNING) << "Fail to wait memory reduced. err=" << st.to_string();
         }
     }
-    return max_consume > 0;
+    return flush_tablets.size();
 }
 
 bool LoadChannel::is_finished() {
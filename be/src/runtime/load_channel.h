@@ -21,10 +21,12 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/InternalService_types.h"
@@ -50,6 +52,20 @@ struct FlushTablet {
 
 // A LoadChannel manages tablets channels for all indexes
 // corresponding to a certain load job
+// A tablet whose memtables may be flushed to reduce the memory of the loads.
+struct FlushCandidate {
+    std::shared_ptr<TabletsChannel> tablets_channel;
+    FlushTablet tablet;
+    int64_t mem_consumption;
+    int64_t first_write_ms;
+};
+
+// Flush the memtables of |candidates| until |mem_to_reduce| bytes are to be freed, and wait for them to be flushed.
+// The more memory a flush frees the sooner it is done, so that the fewest and largest segments are written, and
+// the older the data of a memtable the sooner, up to twice as soon as a memtable of the same size of new data, so
+// that the tablets loaded slowly don't hold the memory for long. Return the number of the tablets flushed.
+size_t flush_candidates_and_wait(std::vector<FlushCandidate>* candidates, int64_t mem_to_reduce);
+
 class LoadChannel {
 public:
     LoadChannel(const UniqueId& load_id, int64_t mem_limit, int64_t timeout_s, MemTracker* mem_tracker);
@@ -62,8 +78,9 @@ public:
     Status add_batch(const PTabletWriterAddBatchRequest& request,
                      google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec);
 
-    Status add_chunk(const PTabletWriterAddChunkRequest& request,
-                     google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec);
+    Status add_chunk(const PTabletWriterAddChunkRequest& request, PTabletWriterAddBatchResult* response);
+
+    Status add_segment(const PTabletWriterAddSegmentRequest& request);
 
     // return true if this load channel has been opened and all tablets channels are closed then.
     bool is_finished();
@@ -74,10 +91,9 @@ public:
 
     const UniqueId& load_id() const { return _load_id; }
 
-    // reduce memory with lock, for handle mem exceed limit in load channel mgr.
-    void reduce_mem_usage_async(const std::set<int64_t>& flush_tablet_ids,
-                                std::shared_ptr<TabletsChannel>* tablets_channel, int64_t* tablet_id,
-                                int64_t* tablet_mem_consumption);
+    // Append the tablets of this load with the memory of their memtables to |candidates|, for handle mem exceed
+    // limit in load channel mgr.
+    void get_flush_candidates(std::vector<FlushCandidate>* candidates);
 
     int64_t mem_consumption() const { return _mem_tracker->consumption(); }
     bool mem_limit_exceeded() const { return _mem_tracker->limit_exceeded(); }
@@ -89,14 +105,8 @@ private:
     // If yes, it will pick several tablets channels to try to reduce memory consumption to limit.
     void _handle_mem_exceed_limit();
 
-    // reduce memory internal without lock, for handle mem exceed limit in load channel
-    void _reduce_mem_usage_async_internal(const std::set<int64_t>& flush_tablet_ids,
-                                          std::shared_ptr<TabletsChannel>* tablets_channel, int64_t* tablet_id,
-                                          int64_t* tablet_mem_consumption);
-
-    // when mem consumption exceeds limit, should call this method to find the channel
-    // that consumes the largest memory(, and then we can reduce its memory usage).
-    bool _find_largest_consumption_channel(std::shared_ptr<TabletsChannel>* channel);
+    // lock should be held when calling this method
+    void _get_flush_candidates_unlocked(std::vector<FlushCandidate>* candidates);
 
     UniqueId _load_id;
     // Tracks the total memory comsupted by current load job on this BE
@@ -29,6 +29,7 @@
 #include "runtime/mem_tracker.h"
 #include "service/backend_options.h"
 #include "storage/lru_cache.h"
+#include "storage/vectorized/memtable.h"
 #include "util/starrocks_metrics.h"
 #include "util/stopwatch.hpp"
 
@@ -73,6 +74,7 @@ LoadChannelMgr::~LoadChannelMgr() {
 
 Status LoadChannelMgr::init(MemTracker* mem_tracker) {
     _mem_tracker = mem_tracker;
+    vectorized::MemTable::set_load_mem_limit(_mem_tracker->limit());
     RETURN_IF_ERROR(_start_bg_worker());
     return Status::OK();
 }
@@ -150,8 +152,7 @@ Status LoadChannelMgr::add_batch(const PTabletWriterAddBatchRequest& request,
     return Status::OK();
 }
 
-Status LoadChannelMgr::add_chunk(const PTabletWriterAddChunkRequest& request,
-                                 google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
+Status LoadChannelMgr::add_chunk(const PTabletWriterAddChunkRequest& request, PTabletWriterAddBatchResult* response,
                                  int64_t* wait_lock_time_ns) {
     UniqueId load_id(request.id());
     // 1. get load channel
@@ -180,7 +181,7 @@ Status LoadChannelMgr::add_chunk(const PTabletWriterAddChunkRequest& request,
     // 3. add batch to load channel
     // batch may not exist in request(eg: eos request without batch),
     // this case will be handled in load channel's add batch method.
-    RETURN_IF_ERROR(channel->add_chunk(request, tablet_vec));
+    RETURN_IF_ERROR(channel->add_chunk(request, response));
 
     // 4. handle finish
     if (channel->is_finished()) {
@@ -208,81 +209,24 @@ void LoadChannelMgr::_handle_mem_exceed_limit(const std::shared_ptr<LoadChannel>
 
     // TODO: ancestors exceeded?
     int64_t exceeded_mem = _mem_tracker->consumption() - _mem_tracker->limit();
-    std::vector<FlushTablet> flush_tablets;
-    std::set<int64_t> flush_tablet_ids;
-    int64_t tablet_mem_consumption;
-    do {
-        std::shared_ptr<LoadChannel> load_channel;
-        std::shared_ptr<TabletsChannel> tablets_channel;
-        int64_t tablet_id = -1;
-        if (!_find_candidate_load_channel(data_channel, &load_channel)) {
-            // should not happen, add log to observe
-            LOG(WARNING) << "Fail to find suitable load channel when total load mem limit exceed";
-            break;
-        }
-        DCHECK(load_channel.get() != nullptr);
-
-        // reduce mem usage of the selected load channel
-        load_channel->reduce_mem_usage_async(flush_tablet_ids, &tablets_channel, &tablet_id, &tablet_mem_consumption);
-        if (tablet_id != -1) {
-            flush_tablets.emplace_back(load_channel.get(), tablets_channel.get(), tablet_id);
-            flush_tablet_ids.insert(tablet_id);
-            exceeded_mem -= tablet_mem_consumption;
-            VLOG(3) << "Flush " << *load_channel.get() << ", tablet id=" << tablet_id
-                    << ", mem consumption=" << tablet_mem_consumption;
-        } else {
-            break;
-        }
-    } while (exceeded_mem > 0);
-
-    // wait flush finish
-    for (const FlushTablet& flush_tablet : flush_tablets) {
-        Status st = flush_tablet.tablets_channel->wait_mem_usage_reduced(flush_tablet.tablet_id);
-        if (!st.ok()) {
-            // wait may return failed, but no need to handle it here, just log.
-            // tablet_vec will only contains success tablet, and then let FE judge it.
-            LOG(WARNING) << "Fail to wait memory reduced. err=" << st.to_string();
-        }
-    }
-    LOG(INFO) << "Reduce memory finish. flush tablets num=" << flush_tablet_ids.size()
-              << ", current mem consumption=" << _mem_tracker->consumption() << ", limit=" << _mem_tracker->limit();
-}
-
-bool LoadChannelMgr::_find_candidate_load_channel(const std::shared_ptr<LoadChannel>& data_channel,
-                                                  std::shared_ptr<LoadChannel>* candidate_channel) {
-    // 1. select the load channel that consume this batch data if limit exceeded.
+    // The memtables of the load channel that consume this batch data first if its limit exceeded, otherwise the
+    // memtables of all the loads are ranked together.
+    std::vector<FlushCandidate> candidates;
     if (data_channel->mem_limit_exceeded()) {
-        *candidate_channel = data_channel;
-        return true;
-    }
-
-    int64_t max_consume = 0;
-    int64_t max_exceeded_consume = 0;
-    std::shared_ptr<LoadChannel> max_channel;
-    std::shared_ptr<LoadChannel> max_exceeded_channel;
-    for (auto& kv : _load_channels) {
-        if (kv.second->mem_consumption() > max_consume) {
-            max_consume = kv.second->mem_consumption();
-            max_channel = kv.second;
-        }
-
-        if (kv.second->mem_limit_exceeded() && kv.second->mem_consumption() > max_exceeded_consume) {
-            max_exceeded_consume = kv.second->mem_consumption();
-            max_exceeded_channel = kv.second;
+        data_channel->get_flush_candidates(&candidates);
+    } else {
+        for (auto& kv : _load_channels) {
+            kv.second->get_flush_candidates(&candidates);
         }
     }
-
-    // 2. select the largest limit exceeded load channel.
-    if (max_exceeded_consume > 0) {
-        *candidate_channel = max_exceeded_channel;
-        return true;
-    }
-    // 3. select the largest consumption load channel.
-    if (max_consume > 0) {
-        *candidate_channel = max_channel;
-        return true;
+    if (candidates.empty()) {
+        // should not happen, add log to observe
+        LOG(WARNING) << "Fail to find suitable load channel when total load mem limit exceed";
+        return;
     }
-    return false;
+    size_t num_flushed = flush_candidates_and_wait(&candidates, exceeded_mem);
+    LOG(INFO) << "Reduce memory finish. flush tablets num=" << num_flushed
+              << ", current mem consumption=" << _mem_tracker->consumption() << ", limit=" << _mem_tracker->limit();
 }
 
 Status LoadChannelMgr::cancel(const PTabletWriterCancelRequest& params) {
@@ -304,6 +248,21 @@ Status LoadChannelMgr::cancel(const PTabletWriterCancelRequest& params) {
     return Status::OK();
 }
 
+Status LoadChannelMgr::add_segment(const PTabletWriterAddSegmentRequest& request) {
+    UniqueId load_id(request.id());
+    std::shared_ptr<LoadChannel> channel;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        auto it = _load_channels.find(load_id);
+        if (it == _load_channels.end()) {
+            return Status::InternalError(strings::Substitute(
+                    "fail to add segment in load channel. unknown load_id=$0", load_id.to_string()));
+        }
+        channel = it->second;
+    }
+    return channel->add_segment(request);
+}
+
 Status LoadChannelMgr::_start_bg_worker() {
     _load_channels_clean_thread = std::thread([this] {
 #ifdef GOOGLE_PROFILER
@@ -54,24 +54,22 @@ public:
     Status add_batch(const PTabletWriterAddBatchRequest& request,
                      google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec, int64_t* wait_lock_time_ns);
 
-    Status add_chunk(const PTabletWriterAddChunkRequest& request,
-                     google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec, int64_t* wait_lock_time_ns);
+    // Fill the tablets written and the load stage times of |response| if the request closes a tablets channel.
+    Status add_chunk(const PTabletWriterAddChunkRequest& request, PTabletWriterAddBatchResult* response,
+                     int64_t* wait_lock_time_ns);
 
     // cancel all tablet stream for 'load_id' load
     Status cancel(const PTabletWriterCancelRequest& request);
 
+    // write a part of the files of a secondary replica in a single replica load
+    Status add_segment(const PTabletWriterAddSegmentRequest& request);
+
 private:
     // check if the total load mem consumption exceeds limit.
-    // If yes, it will pick several load channels to try to reduce memory consumption to limit.
+    // If yes, it will flush the memtables of the tablets of all the loads, ranked by flush_candidates_and_wait(), to
+    // try to reduce memory consumption to limit.
     void _handle_mem_exceed_limit(const std::shared_ptr<LoadChannel>& data_channel);
 
-    // find a load channel to reduce memory consumption
-    // 1. select the load channel that consume this batch data if limit exceeded.
-    // 2. select the largest limit exceeded load channel.
-    // 3. select the largest consumption load channel.
-    bool _find_candidate_load_channel(const std::shared_ptr<LoadChannel>& data_channel,
-                                      std::shared_ptr<LoadChannel>* candidate_channel);
-
     Status _start_bg_worker();
 
     // lock protect the load channel map
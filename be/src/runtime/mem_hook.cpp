@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/mem_hook.h"
+
+#if !defined(ADDRESS_SANITIZER) && !defined(LEAK_SANITIZER) && !defined(THREAD_SANITIZER)
+#include <gperftools/malloc_extension.h>
+#include <gperftools/malloc_hook.h>
+#endif
+
+#include "common/logging.h"
+#include "runtime/current_thread.h"
+
+namespace starrocks {
+
+static bool g_mem_hook_enabled = false;
+
+#if !defined(ADDRESS_SANITIZER) && !defined(LEAK_SANITIZER) && !defined(THREAD_SANITIZER)
+// Set while a hook is counting, so the allocations made by the flush into the trackers, if any, aren't counted again.
+static __thread bool tls_in_mem_hook = false; // NOLINT
+
+// The allocated size, rather than the requested one, is charged, so that the same size is released by the delete hook.
+static void new_hook(const void* ptr, size_t size) {
+    if (ptr == nullptr || tls_in_mem_hook || CurrentThread::mem_tracker() == nullptr) {
+        return;
+    }
+    tls_in_mem_hook = true;
+    CurrentThread::mem_consume(MallocExtension::instance()->GetAllocatedSize(ptr));
+    tls_in_mem_hook = false;
+}
+
+static void delete_hook(const void* ptr) {
+    if (ptr == nullptr || tls_in_mem_hook || CurrentThread::mem_tracker() == nullptr) {
+        return;
+    }
+    tls_in_mem_hook = true;
+    CurrentThread::mem_release(MallocExtension::instance()->GetAllocatedSize(ptr));
+    tls_in_mem_hook = false;
+}
+#endif
+
+void init_mem_hook() {
+#if !defined(ADDRESS_SANITIZER) && !defined(LEAK_SANITIZER) && !defined(THREAD_SANITIZER)
+    if (g_mem_hook_enabled) {
+        return;
+    }
+    if (!MallocHook::AddNewHook(&new_hook) || !MallocHook::AddDeleteHook(&delete_hook)) {
+        LOG(WARNING) << "Failed to install the memory hooks of tcmalloc";
+        MallocHook::RemoveNewHook(&new_hook);
+        return;
+    }
+    g_mem_hook_enabled = true;
+    LOG(INFO) << "Installed the memory hooks of tcmalloc";
+#endif
+}
+
+bool is_mem_hook_enabled() {
+    return g_mem_hook_enabled;
+}
+
+} // namespace starrocks
@@ -0,0 +1,18 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+namespace starrocks {
+
+// Install the hooks of tcmalloc, which charge all the allocations and deallocations of a thread, including those of
+// the std containers, hash maps and protobuf, to CurrentThread::mem_tracker(), batched by CurrentThread::mem_consume.
+// The explicit CurrentMemTracker calls are ignored afterwards, since their memory is charged by the hooks already.
+//
+// The memory freed by another thread, or by a thread without a tracker, is released from the tracker of that thread
+// instead, so it is for the trackers of the long-running queries to follow the resident memory more closely, rather
+// than to be exact. Called once at startup if config::enable_mem_hook, and a no-op in the sanitizer builds.
+void init_mem_hook();
+
+bool is_mem_hook_enabled();
+
+} // namespace starrocks
@@ -139,14 +139,18 @@ bool ChunkAllocator::allocate(size_t size, Chunk* chunk) {
         return true;
     }
     if (_reserved_bytes > size) {
-        // try to allocate from other core's arena
+        // try to allocate from the arenas of the other cores of the same NUMA node first, whose memory is local
+        // to this core, and then from the ones of the other nodes.
+        int numa_node = CpuInfo::get_numa_node_of_core(core_id);
+        for (int other : CpuInfo::get_cores_of_numa_node(numa_node)) {
+            if (other != core_id && _pop_free_chunk(other, size, chunk)) {
+                return true;
+            }
+        }
         ++core_id;
         for (int i = 1; i < _arenas.size(); ++i, ++core_id) {
-            if (_arenas[core_id % _arenas.size()]->pop_free_chunk(size, &chunk->data)) {
-                _reserved_bytes.fetch_sub(size);
-                other_core_alloc_count.increment(1);
-                // reset chunk's core_id to other
-                chunk->core_id = core_id % _arenas.size();
+            int other = core_id % _arenas.size();
+            if (CpuInfo::get_numa_node_of_core(other) != numa_node && _pop_free_chunk(other, size, chunk)) {
                 return true;
             }
         }
@@ -166,6 +170,17 @@ bool ChunkAllocator::allocate(size_t size, Chunk* chunk) {
     return true;
 }
 
+bool ChunkAllocator::_pop_free_chunk(int core_id, size_t size, Chunk* chunk) {
+    if (!_arenas[core_id]->pop_free_chunk(size, &chunk->data)) {
+        return false;
+    }
+    _reserved_bytes.fetch_sub(size);
+    other_core_alloc_count.increment(1);
+    // reset chunk's core_id to other
+    chunk->core_id = core_id;
+    return true;
+}
+
 void ChunkAllocator::free(const Chunk& chunk) {
     int64_t old_reserved_bytes = _reserved_bytes;
     int64_t new_reserved_bytes = 0;
@@ -39,7 +39,7 @@ class ChunkArena;
 // ChunkAllocator has one ChunkArena for each CPU core, it will try to allocate
 // memory from current core arena firstly. In this way, there will be no lock contention
 // between concurrently-running threads. If this fails, ChunkAllocator will try to allocate
-// memroy from other core's arena.
+// memroy from other core's arena, those of the cores in the same NUMA node first.
 //
 // Memory Reservation
 // ChunkAllocator has a limit about how much free chunk bytes it can reserve, above which
@@ -72,6 +72,9 @@ public:
     void free(const Chunk& chunk);
 
 private:
+    // Pop a free chunk from the arena of another core.
+    bool _pop_free_chunk(int core_id, size_t size, Chunk* chunk);
+
     static ChunkAllocator* _s_instance;
 
     size_t _reserve_bytes_limit;
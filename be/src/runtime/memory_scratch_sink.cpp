@@ -26,6 +26,7 @@
 
 #include <sstream>
 
+#include "column/chunk.h"
 #include "common/logging.h"
 #include "exprs/expr.h"
 #include "gen_cpp/DorisExternalService_types.h"
@@ -36,6 +37,7 @@
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "runtime/tuple_row.h"
+#include "util/arrow/chunk.h"
 #include "util/arrow/row_batch.h"
 #include "util/date_func.h"
 #include "util/types.h"
@@ -83,6 +85,20 @@ Status MemoryScratchSink::send(RuntimeState* state, RowBatch* batch) {
     return Status::OK();
 }
 
+Status MemoryScratchSink::send_chunk(RuntimeState* state, vectorized::Chunk* chunk) {
+    if (nullptr == chunk || 0 == chunk->num_rows()) {
+        return Status::OK();
+    }
+    if (_chunk_arrow_schema == nullptr) {
+        RETURN_IF_ERROR(convert_to_arrow_schema(_row_desc, _output_expr_ctxs, &_chunk_arrow_schema));
+    }
+    std::shared_ptr<arrow::RecordBatch> result;
+    RETURN_IF_ERROR(convert_chunk_to_arrow_batch(chunk, _output_expr_ctxs, _chunk_arrow_schema,
+                                                 arrow::default_memory_pool(), &result));
+    _queue->blocking_put(result);
+    return Status::OK();
+}
+
 Status MemoryScratchSink::open(RuntimeState* state) {
     return Expr::open(_output_expr_ctxs, state);
 }
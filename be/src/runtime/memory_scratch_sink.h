@@ -68,6 +68,9 @@ public:
     // Blocks until all rows in batch are pushed to the queue
     virtual Status send(RuntimeState* state, RowBatch* batch);
 
+    // convert the results of the output exprs on |chunk| to an arrow record batch and send it to the queue
+    Status send_chunk(RuntimeState* state, vectorized::Chunk* chunk) override;
+
     virtual Status close(RuntimeState* state, Status exec_status);
 
     virtual RuntimeProfile* profile() { return _profile; }
@@ -79,6 +82,8 @@ private:
     // Owned by the RuntimeState.
     const RowDescriptor& _row_desc;
     std::shared_ptr<arrow::Schema> _arrow_schema;
+    // the schema of the record batches converted from the chunks, of the types of the output exprs
+    std::shared_ptr<arrow::Schema> _chunk_arrow_schema;
 
     BlockQueueSharedPtr _queue;
 
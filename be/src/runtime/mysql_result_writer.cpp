@@ -25,15 +25,20 @@
 
 #include "column/binary_column.h"
 #include "column/const_column.h"
+#include "column/decimalv3_column.h"
+#include "column/fixed_length_column.h"
 #include "column/nullable_column.h"
+#include "column/type_traits.h"
 #include "exprs/expr.h"
 #include "gen_cpp/InternalService_types.h"
 #include "runtime/buffer_control_block.h"
 #include "runtime/primitive_type.h"
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
+#include "runtime/vectorized/time_types.h"
 #include "util/date_func.h"
 #include "util/mysql_row_buffer.h"
+#include "util/raw_container.h"
 #include "util/types.h"
 
 namespace starrocks {
@@ -294,6 +299,114 @@ Status MysqlResultWriter::close() {
     return Status::OK();
 }
 
+// Encode the cells of |column|, whose data column is of |ColumnType|, into |buf| one after another by |encode|, and
+// the end offset of each cell in |offsets|.
+template <typename ColumnType, typename Encode>
+static void encode_cells(const vectorized::Column* column, size_t num_rows, MysqlRowBuffer* buf, uint32_t* offsets,
+                         Encode encode) {
+    const uint8_t* nulls = nullptr;
+    if (column->is_nullable()) {
+        const auto* nullable_column = down_cast<const vectorized::NullableColumn*>(column);
+        if (nullable_column->has_null()) {
+            nulls = nullable_column->immutable_null_column_data().data();
+        }
+    }
+    const auto& data_column = *down_cast<const ColumnType*>(vectorized::ColumnHelper::get_data_column(column));
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (nulls != nullptr && nulls[i]) {
+            buf->push_null();
+        } else {
+            encode(buf, data_column, i);
+        }
+        offsets[i] = buf->length();
+    }
+}
+
+template <PrimitiveType Type>
+static void encode_numbers(const vectorized::Column* column, size_t num_rows, MysqlRowBuffer* buf, uint32_t* offsets) {
+    using ColumnType = vectorized::RunTimeColumnType<Type>;
+    encode_cells<ColumnType>(column, num_rows, buf, offsets, [](MysqlRowBuffer* buf, const ColumnType& data, size_t i) {
+        buf->push_number(data.get_data()[i]);
+    });
+}
+
+template <PrimitiveType Type>
+static void encode_decimalv3s(const vectorized::Column* column, size_t num_rows, MysqlRowBuffer* buf,
+                              uint32_t* offsets) {
+    using ColumnType = vectorized::RunTimeColumnType<Type>;
+    using CppType = vectorized::RunTimeCppType<Type>;
+    encode_cells<ColumnType>(column, num_rows, buf, offsets, [](MysqlRowBuffer* buf, const ColumnType& data, size_t i) {
+        buf->push_decimal(DecimalV3Cast::to_string<CppType>(data.get_data()[i], data.precision(), data.scale()));
+    });
+}
+
+// Encode the cells of |column| of |type| by the kernel of the type, into |buf|, without a virtual call per cell.
+static void encode_column(PrimitiveType type, const vectorized::Column* column, size_t num_rows, MysqlRowBuffer* buf,
+                          uint32_t* offsets) {
+    using namespace vectorized;
+    if (column->is_constant() || column->only_null()) {
+        type = INVALID_TYPE;
+    }
+    switch (type) {
+    case TYPE_BOOLEAN:
+        return encode_numbers<TYPE_BOOLEAN>(column, num_rows, buf, offsets);
+    case TYPE_TINYINT:
+        return encode_numbers<TYPE_TINYINT>(column, num_rows, buf, offsets);
+    case TYPE_SMALLINT:
+        return encode_numbers<TYPE_SMALLINT>(column, num_rows, buf, offsets);
+    case TYPE_INT:
+        return encode_numbers<TYPE_INT>(column, num_rows, buf, offsets);
+    case TYPE_BIGINT:
+        return encode_numbers<TYPE_BIGINT>(column, num_rows, buf, offsets);
+    case TYPE_LARGEINT:
+        return encode_numbers<TYPE_LARGEINT>(column, num_rows, buf, offsets);
+    case TYPE_FLOAT:
+        return encode_numbers<TYPE_FLOAT>(column, num_rows, buf, offsets);
+    case TYPE_DOUBLE:
+        return encode_numbers<TYPE_DOUBLE>(column, num_rows, buf, offsets);
+    case TYPE_DECIMALV2:
+        return encode_cells<DecimalColumn>(column, num_rows, buf, offsets,
+                                           [](MysqlRowBuffer* buf, const DecimalColumn& data, size_t i) {
+                                               char s[64];
+                                               int len = data.get_data()[i].to_string(s);
+                                               buf->push_decimal(Slice(s, len));
+                                           });
+    case TYPE_DECIMAL32:
+        return encode_decimalv3s<TYPE_DECIMAL32>(column, num_rows, buf, offsets);
+    case TYPE_DECIMAL64:
+        return encode_decimalv3s<TYPE_DECIMAL64>(column, num_rows, buf, offsets);
+    case TYPE_DECIMAL128:
+        return encode_decimalv3s<TYPE_DECIMAL128>(column, num_rows, buf, offsets);
+    case TYPE_DATE:
+        return encode_cells<DateColumn>(column, num_rows, buf, offsets,
+                                        [](MysqlRowBuffer* buf, const DateColumn& data, size_t i) {
+                                            int year, month, day;
+                                            data.get_data()[i].to_date(&year, &month, &day);
+                                            char s[10];
+                                            date::to_string(year, month, day, s);
+                                            buf->push_string(s, sizeof(s));
+                                        });
+    case TYPE_DATETIME:
+        return encode_cells<TimestampColumn>(column, num_rows, buf, offsets,
+                                             [](MysqlRowBuffer* buf, const TimestampColumn& data, size_t i) {
+                                                 char s[TimestampValue::max_string_length()];
+                                                 int len = data.get_data()[i].to_string(s, sizeof(s));
+                                                 buf->push_string(s, len);
+                                             });
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        return encode_cells<BinaryColumn>(column, num_rows, buf, offsets,
+                                          [](MysqlRowBuffer* buf, const BinaryColumn& data, size_t i) {
+                                              buf->push_string(data.get_slice(i));
+                                          });
+    default:
+        for (size_t i = 0; i < num_rows; ++i) {
+            column->put_mysql_row_buffer(buf, i);
+            offsets[i] = buf->length();
+        }
+    }
+}
+
 StatusOr<TFetchDataResultPtr> MysqlResultWriter::process_chunk(vectorized::Chunk* chunk) {
     SCOPED_TIMER(_append_row_batch_timer);
     int num_rows = chunk->num_rows();
@@ -345,18 +458,36 @@ StatusOr<TFetchDataResultPtr> MysqlResultWriter::process_chunk(vectorized::Chunk
         result_columns.emplace_back(std::move(column));
     }
 
-    // Step 2: convert chunk to mysql row format row by row
+    // Step 2: convert chunk to mysql row format, by encoding the cells one column at a time and then copying the cells
+    // of each row together
     {
-        _row_buffer->reserve(128);
         SCOPED_TIMER(_convert_tuple_timer);
+        _column_buffers.resize(num_columns);
+        _cell_offsets.resize(static_cast<size_t>(num_columns) * num_rows);
+        for (int j = 0; j < num_columns; ++j) {
+            // The buffer of the last chunk is about as large as this one needs.
+            size_t last_length = _column_buffers[j].length();
+            _column_buffers[j].reset();
+            _column_buffers[j].reserve(last_length);
+            encode_column(_output_expr_ctxs[j]->root()->type().type == TYPE_TIME
+                                  ? TYPE_VARCHAR
+                                  : _output_expr_ctxs[j]->root()->type().type,
+                          result_columns[j].get(), num_rows, &_column_buffers[j], &_cell_offsets[j * num_rows]);
+        }
         for (int i = 0; i < num_rows; ++i) {
-            DCHECK_EQ(0, _row_buffer->length());
-            for (size_t j = 0; j < result_columns.size(); ++j) {
-                result_columns[j]->put_mysql_row_buffer(_row_buffer, i);
+            size_t row_length = 0;
+            for (int j = 0; j < num_columns; ++j) {
+                const uint32_t* offsets = &_cell_offsets[j * num_rows];
+                row_length += offsets[i] - (i == 0 ? 0 : offsets[i - 1]);
+            }
+            raw::stl_string_resize_uninitialized(&result_rows[i], row_length);
+            char* pos = result_rows[i].data();
+            for (int j = 0; j < num_columns; ++j) {
+                const uint32_t* offsets = &_cell_offsets[j * num_rows];
+                uint32_t start = i == 0 ? 0 : offsets[i - 1];
+                memcpy(pos, _column_buffers[j].data().data() + start, offsets[i] - start);
+                pos += offsets[i] - start;
             }
-            size_t len = _row_buffer->length();
-            _row_buffer->move_content(&result_rows[i]);
-            _row_buffer->reserve(len * 1.1);
         }
     }
     return result;
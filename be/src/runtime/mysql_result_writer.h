@@ -70,6 +70,10 @@ private:
     BufferControlBlock* _sinker;
     const std::vector<ExprContext*>& _output_expr_ctxs;
     MysqlRowBuffer* _row_buffer;
+    // The cells of each of the result columns of a chunk, encoded one column at a time, and the end offsets of the
+    // cells, of the columns one after another, in the buffers
+    std::vector<MysqlRowBuffer> _column_buffers;
+    std::vector<uint32_t> _cell_offsets;
 
     RuntimeProfile* _parent_profile; // parent profile from result sink. not owned
     // total time cost on append batch opertion
@@ -27,6 +27,7 @@
 #include "exec/exchange_node.h"
 #include "exec/exec_node.h"
 #include "exec/scan_node.h"
+#include "exec/vectorized/olap_scan_node.h"
 #include "exprs/expr.h"
 #include "gutil/map_util.h"
 #include "runtime/current_thread.h"
@@ -175,6 +176,20 @@ Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request) {
         ScanNode* scan_node = down_cast<ScanNode*>(scan_nodes[i]);
         const std::vector<TScanRangeParams>& scan_ranges =
                 FindWithDefault(params.per_node_scan_ranges, scan_node->id(), no_scan_ranges);
+        FragmentResultCache* result_cache = _exec_env->fragment_result_cache();
+        if (_is_vectorized && scan_node->type() == TPlanNodeType::OLAP_SCAN_NODE && result_cache != nullptr &&
+            result_cache->enabled()) {
+            std::vector<TScanRangeParams> uncached_scan_ranges = scan_ranges;
+            _result_cache_probe = result_cache->probe(request, &uncached_scan_ranges);
+            if (!_result_cache_probe.key.empty()) {
+                auto* olap_scan_node = down_cast<vectorized::OlapScanNode*>(scan_node);
+                olap_scan_node->set_tablet_start_versions(_result_cache_probe.start_versions);
+                olap_scan_node->set_scan_ranges(uncached_scan_ranges);
+                VLOG(1) << "scan_node_Id=" << scan_node->id() << " size=" << uncached_scan_ranges.size()
+                        << " cached=" << (_result_cache_probe.cached != nullptr);
+                continue;
+            }
+        }
         scan_node->set_scan_ranges(scan_ranges);
         VLOG(1) << "scan_node_Id=" << scan_node->id() << " size=" << scan_ranges.size();
     }
@@ -227,6 +242,7 @@ Status PlanFragmentExecutor::prepare(const TExecPlanFragmentParams& request) {
 Status PlanFragmentExecutor::open() {
     LOG(INFO) << "Open(): fragment_instance_id=" << print_id(_runtime_state->fragment_instance_id());
     CurrentThread::set_query_id(_runtime_state->query_id());
+    ScopedThreadLocalMemTracker mem_tracker_setter(_runtime_state->instance_mem_tracker());
 
     Status status = Status::OK();
 
@@ -334,6 +350,16 @@ Status PlanFragmentExecutor::_open_internal_vectorized() {
     }
     RETURN_IF_ERROR(_sink->open(runtime_state()));
 
+    // The partial aggregations of the versions cached go first, those of the newer versions scanned follow.
+    if (_result_cache_probe.cached != nullptr) {
+        for (const auto& cached_chunk : _result_cache_probe.cached->chunks) {
+            _result_cache_chunks.push_back(cached_chunk);
+            _result_cache_bytes += cached_chunk->bytes_usage();
+            auto chunk = FragmentResultCache::copy_chunk(*cached_chunk);
+            RETURN_IF_ERROR(_sink->send_chunk(runtime_state(), chunk.get()));
+        }
+    }
+
     // If there is a sink, do all the work of driving it here, so that
     // when this returns the query has actually finished
     vectorized::ChunkPtr chunk;
@@ -355,6 +381,15 @@ Status PlanFragmentExecutor::_open_internal_vectorized() {
         if (_collect_query_statistics_with_every_batch) {
             collect_query_statistics();
         }
+        if (!_result_cache_probe.key.empty()) {
+            _result_cache_bytes += chunk->bytes_usage();
+            if (static_cast<int64_t>(_result_cache_bytes) > config::fragment_result_cache_max_entry_bytes) {
+                _result_cache_probe.key.clear();
+                _result_cache_chunks.clear();
+            } else {
+                _result_cache_chunks.push_back(FragmentResultCache::copy_chunk(*chunk));
+            }
+        }
         RETURN_IF_ERROR(_sink->send_chunk(runtime_state(), chunk.get()));
     }
 
@@ -380,6 +415,13 @@ Status PlanFragmentExecutor::_open_internal_vectorized() {
         }
         close_status = _sink->close(runtime_state(), status);
     }
+    if (close_status.ok() && !_result_cache_probe.key.empty()) {
+        auto entry = std::make_shared<FragmentResultCache::Entry>();
+        entry->tablet_versions = std::move(_result_cache_probe.tablet_versions);
+        entry->chunks = std::move(_result_cache_chunks);
+        entry->bytes = _result_cache_bytes;
+        _exec_env->fragment_result_cache()->insert(_result_cache_probe.key, std::move(entry));
+    }
 
     update_status(close_status);
     // Setting to NULL ensures that the d'tor won't double-close the sink.
@@ -572,6 +614,8 @@ void PlanFragmentExecutor::close() {
     if (_closed) {
         return;
     }
+    ScopedThreadLocalMemTracker mem_tracker_setter(_runtime_state != nullptr ? _runtime_state->instance_mem_tracker()
+                                                                              : nullptr);
 
     _row_batch.reset();
     _chunk.reset();
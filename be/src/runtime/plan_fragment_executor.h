@@ -30,6 +30,7 @@
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
 #include "common/status.h"
+#include "runtime/fragment_result_cache.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/query_statistics.h"
 #include "runtime/runtime_state.h"
@@ -189,6 +190,12 @@ private:
 
     vectorized::ChunkPtr _chunk;
 
+    // How this instance uses the FragmentResultCache, its key is empty if the result isn't to be cached.
+    FragmentResultCache::Probe _result_cache_probe;
+    // The chunks sent, to be cached once the instance succeeds.
+    std::vector<vectorized::ChunkPtr> _result_cache_chunks;
+    size_t _result_cache_bytes = 0;
+
     // Number of rows returned by this fragment
     RuntimeProfile::Counter* _rows_produced_counter = nullptr;
 
@@ -41,6 +41,10 @@ public:
     void merge(const QueryStatistics& other) {
         scan_rows += other.scan_rows;
         scan_bytes += other.scan_bytes;
+        page_cache_bytes += other.page_cache_bytes;
+        local_disk_bytes += other.local_disk_bytes;
+        remote_bytes += other.remote_bytes;
+        index_filtered_bytes += other.index_filtered_bytes;
         _stats_items.insert(_stats_items.end(), other._stats_items.begin(), other._stats_items.end());
     }
 
@@ -50,6 +54,10 @@ public:
         this->_stats_items.emplace_back(stats_item);
         this->scan_rows += stats_item.scan_rows();
         this->scan_bytes += stats_item.scan_bytes();
+        this->page_cache_bytes += stats_item.page_cache_bytes();
+        this->local_disk_bytes += stats_item.local_disk_bytes();
+        this->remote_bytes += stats_item.remote_bytes();
+        this->index_filtered_bytes += stats_item.index_filtered_bytes();
     }
 
     void merge(QueryStatisticsRecvr* recvr);
@@ -58,6 +66,10 @@ public:
         scan_rows = 0;
         scan_bytes = 0;
         returned_rows = 0;
+        page_cache_bytes = 0;
+        local_disk_bytes = 0;
+        remote_bytes = 0;
+        index_filtered_bytes = 0;
         _stats_items.clear();
     }
 
@@ -66,12 +78,20 @@ public:
         statistics->set_scan_rows(scan_rows);
         statistics->set_scan_bytes(scan_bytes);
         statistics->set_returned_rows(returned_rows);
+        statistics->set_page_cache_bytes(page_cache_bytes);
+        statistics->set_local_disk_bytes(local_disk_bytes);
+        statistics->set_remote_bytes(remote_bytes);
+        statistics->set_index_filtered_bytes(index_filtered_bytes);
         *statistics->mutable_stats_items() = {_stats_items.begin(), _stats_items.end()};
     }
 
     void merge_pb(const PQueryStatistics& statistics) {
         scan_rows += statistics.scan_rows();
         scan_bytes += statistics.scan_bytes();
+        page_cache_bytes += statistics.page_cache_bytes();
+        local_disk_bytes += statistics.local_disk_bytes();
+        remote_bytes += statistics.remote_bytes();
+        index_filtered_bytes += statistics.index_filtered_bytes();
         _stats_items.insert(_stats_items.end(), statistics.stats_items().begin(), statistics.stats_items().end());
     }
 
@@ -81,6 +101,12 @@ private:
     // number rows returned by query.
     // only set once by result sink when closing.
     int64_t returned_rows;
+    // The bytes scanned from the page cache, the local disk and the remote storage, e.g. hdfs, and the bytes
+    // skipped by the indexes of the segments.
+    int64_t page_cache_bytes = 0;
+    int64_t local_disk_bytes = 0;
+    int64_t remote_bytes = 0;
+    int64_t index_filtered_bytes = 0;
     std::vector<QueryStatisticsItemPB> _stats_items;
 };
 
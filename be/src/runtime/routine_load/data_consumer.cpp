@@ -23,14 +23,17 @@
 
 #include <algorithm>
 #include <functional>
+#include <map>
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "gutil/strings/split.h"
 #include "runtime/small_file_mgr.h"
 #include "service/backend_options.h"
 #include "util/defer_op.h"
+#include "util/load_stage_metrics.h"
 #include "util/stopwatch.hpp"
 #include "util/uid_util.h"
 
@@ -160,7 +163,7 @@ Status KafkaDataConsumer::assign_topic_partitions(const std::map<int32_t, int64_
     return Status::OK();
 }
 
-Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms) {
+Status KafkaDataConsumer::group_consume(TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms) {
     _last_visit_time = time(nullptr);
     int64_t left_time = max_running_time_ms;
     LOG(INFO) << "start kafka consumer: " << _id << ", grp: " << _grp_id << ", max running time(ms): " << left_time;
@@ -169,6 +172,10 @@ Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* q
     int64_t put_rows = 0;
     Status st = Status::OK();
     MonotonicStopWatch consumer_watch;
+    const size_t max_batch_rows = std::max<int32_t>(1, config::routine_load_kafka_consume_batch_rows);
+    auto batch = std::make_unique<KafkaMessageBatch>();
+    // partition -> the offset of the last message consumed
+    std::map<int32_t, int64_t> consumed_offsets;
     MonotonicStopWatch watch;
     watch.start();
     while (true) {
@@ -184,25 +191,26 @@ Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* q
         }
 
         bool done = false;
-        // consume 1 message at a time
+        bool flush = false;
+        // wait for the first message of a batch, and take the following ones only if they are already fetched
+        // by librdkafka, so that a batch never delays the messages in it.
         consumer_watch.start();
-        std::unique_ptr<RdKafka::Message> msg(_k_consumer->consume(1000 /* timeout, ms */));
+        std::unique_ptr<RdKafka::Message> msg(_k_consumer->consume(batch->empty() ? 1000 /* timeout, ms */ : 0));
         consumer_watch.stop();
         switch (msg->err()) {
         case RdKafka::ERR_NO_ERROR:
-            if (!queue->blocking_put(msg.get())) {
-                // queue is shutdown
-                done = true;
-            } else {
-                ++put_rows;
-                msg.release(); // release the ownership, msg will be deleted after being processed
-            }
+            consumed_offsets[msg->partition()] = msg->offset();
+            batch->emplace_back(std::move(msg));
+            flush = batch->size() >= max_batch_rows;
             ++received_rows;
             break;
         case RdKafka::ERR__TIMED_OUT:
             // leave the status as OK, because this may happend
             // if there is no data in kafka.
-            LOG(INFO) << "kafka consume timeout: " << _id;
+            if (batch->empty()) {
+                LOG(INFO) << "kafka consume timeout: " << _id;
+            }
+            flush = true;
             break;
         case RdKafka::ERR_OFFSET_OUT_OF_RANGE: {
             done = true;
@@ -220,6 +228,18 @@ Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* q
         }
 
         left_time = max_running_time_ms - watch.elapsed_time() / 1000 / 1000;
+        if ((flush || done || left_time <= 0) && !batch->empty()) {
+            size_t rows = batch->size();
+            if (!queue->blocking_put(batch.get())) {
+                // queue is shutdown
+                done = true;
+            } else {
+                put_rows += rows;
+                // release the ownership, the batch will be deleted after being processed
+                batch.release();
+                batch = std::make_unique<KafkaMessageBatch>();
+            }
+        }
         if (done) {
             break;
         }
@@ -230,6 +250,15 @@ Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* q
               << ", consume cost(ms): " << consumer_watch.elapsed_time() / 1000 / 1000
               << ", received rows: " << received_rows << ", put rows: " << put_rows;
 
+    // The high watermarks are cached by the fetcher of librdkafka, which queries no broker here.
+    for (auto& [partition, offset] : consumed_offsets) {
+        int64_t low = 0;
+        int64_t high = 0;
+        if (_k_consumer->get_watermark_offsets(_topic, partition, &low, &high) == RdKafka::ERR_NO_ERROR) {
+            LoadStageMetrics::set_kafka_partition_lag(_topic, partition, std::max<int64_t>(high - offset - 1, 0));
+        }
+    }
+
     return st;
 }
 
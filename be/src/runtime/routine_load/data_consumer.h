@@ -22,8 +22,10 @@
 #pragma once
 
 #include <ctime>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "librdkafka/rdkafkacpp.h"
 #include "runtime/stream_load/stream_load_context.h"
@@ -36,6 +38,9 @@ class KafkaConsumerPipe;
 class Status;
 class StreamLoadPipe;
 
+// The messages taken from a consumer at a time, put into the queue of a consumer group as a whole.
+using KafkaMessageBatch = std::vector<std::unique_ptr<RdKafka::Message>>;
+
 class DataConsumer {
 public:
     DataConsumer(StreamLoadContext* ctx)
@@ -137,7 +142,7 @@ public:
                                    StreamLoadContext* ctx);
 
     // start the consumer and put msgs to queue
-    Status group_consume(TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms);
+    Status group_consume(TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms);
 
     // get the partitions ids of the topic
     Status get_partition_meta(std::vector<int32_t>* partition_ids);
@@ -55,10 +55,9 @@ KafkaDataConsumerGroup::~KafkaDataConsumerGroup() {
     // clean the msgs left in queue
     _queue.shutdown();
     while (true) {
-        RdKafka::Message* msg;
-        if (_queue.blocking_get(&msg)) {
-            delete msg;
-            msg = nullptr;
+        KafkaMessageBatch* batch;
+        if (_queue.blocking_get(&batch)) {
+            delete batch;
         } else {
             break;
         }
@@ -104,13 +103,10 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
     // copy one
     std::map<int32_t, int64_t> cmt_offset = ctx->kafka_info->cmt_offset;
 
-    //improve performance
-    Status (KafkaConsumerPipe::*append_data)(const char* data, size_t size, char row_delimiter);
+    // every json msg is a buffer of the pipe of its own, while the msgs of a batch of csv are appended at once
+    bool is_json = ctx->format == TFileFormatType::FORMAT_JSON;
     char row_delimiter = '\n';
-    if (ctx->format == TFileFormatType::FORMAT_JSON) {
-        append_data = &KafkaConsumerPipe::append_json;
-    } else {
-        append_data = &KafkaConsumerPipe::append_with_row_delimiter;
+    if (!is_json) {
         auto& per_node_scan_ranges = ctx->put_result.params.params.per_node_scan_ranges;
 
         if (!per_node_scan_ranges.empty()) {
@@ -165,26 +161,39 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
             }
         }
 
-        RdKafka::Message* msg;
-        bool res = _queue.blocking_get(&msg);
+        KafkaMessageBatch* batch;
+        bool res = _queue.blocking_get(&batch);
         if (res) {
-            VLOG(3) << "get kafka message"
-                    << ", partition: " << msg->partition() << ", offset: " << msg->offset() << ", len: " << msg->len();
-
-            (kafka_pipe.get()->*append_data)(static_cast<const char*>(msg->payload()), static_cast<size_t>(msg->len()),
-                                             row_delimiter);
+            std::unique_ptr<KafkaMessageBatch> batch_guard(batch);
+            VLOG(3) << "get kafka messages: " << batch->size();
+
+            // the msgs before the failed one are in the pipe already
+            size_t appended = 0;
+            if (is_json) {
+                for (; appended < batch->size(); ++appended) {
+                    const auto& msg = (*batch)[appended];
+                    st = kafka_pipe->append_json(static_cast<const char*>(msg->payload()), msg->len(), row_delimiter);
+                    if (!st.ok()) {
+                        break;
+                    }
+                }
+            } else {
+                st = kafka_pipe->append_with_row_delimiter(*batch, row_delimiter);
+                appended = st.ok() ? batch->size() : 0;
+            }
 
-            if (st.ok()) {
+            for (size_t i = 0; i < appended; ++i) {
+                const auto& msg = (*batch)[i];
                 received_rows++;
                 left_bytes -= msg->len();
                 cmt_offset[msg->partition()] = msg->offset();
                 VLOG(3) << "consume partition[" << msg->partition() << " - " << msg->offset() << "]";
-            } else {
+            }
+            if (!st.ok()) {
                 // failed to append this msg, we must stop
                 LOG(WARNING) << "failed to append msg to pipe. grp: " << _grp_id;
                 eos = true;
             }
-            delete msg;
         } else {
             // queue is empty and shutdown
             eos = true;
@@ -197,7 +206,7 @@ Status KafkaDataConsumerGroup::start_all(StreamLoadContext* ctx) {
 }
 
 void KafkaDataConsumerGroup::actual_consume(std::shared_ptr<DataConsumer> consumer,
-                                            TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms,
+                                            TimedBlockingQueue<KafkaMessageBatch*>* queue, int64_t max_running_time_ms,
                                             ConsumeFinishCallback cb) {
     Status st = std::static_pointer_cast<KafkaDataConsumer>(consumer)->group_consume(queue, max_running_time_ms);
     cb(st);
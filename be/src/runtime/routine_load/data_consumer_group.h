@@ -67,7 +67,7 @@ protected:
 // for kafka
 class KafkaDataConsumerGroup : public DataConsumerGroup {
 public:
-    KafkaDataConsumerGroup() : DataConsumerGroup(), _queue(500) {}
+    KafkaDataConsumerGroup() : DataConsumerGroup(), _queue(8) {}
 
     virtual ~KafkaDataConsumerGroup();
 
@@ -77,12 +77,13 @@ public:
 
 private:
     // start a single consumer
-    void actual_consume(std::shared_ptr<DataConsumer> consumer, TimedBlockingQueue<RdKafka::Message*>* queue,
+    void actual_consume(std::shared_ptr<DataConsumer> consumer, TimedBlockingQueue<KafkaMessageBatch*>* queue,
                         int64_t max_running_time_ms, ConsumeFinishCallback cb);
 
 private:
-    // blocking queue to receive msgs from all consumers
-    TimedBlockingQueue<RdKafka::Message*> _queue;
+    // blocking queue to receive msgs from all consumers, in batches of up to
+    // config::routine_load_kafka_consume_batch_rows msgs
+    TimedBlockingQueue<KafkaMessageBatch*> _queue;
 };
 
 } // end namespace starrocks
@@ -2,6 +2,7 @@
 
 #include "runtime/runtime_filter_worker.h"
 
+#include "common/config.h"
 #include "exprs/vectorized/runtime_filter_bank.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "gen_cpp/internal_service.pb.h"
@@ -132,7 +133,7 @@ Status RuntimeFilterMerger::init(const TRuntimeFilterParams& params) {
         status.expect_number = it.second;
         status.max_size = params.runtime_filter_max_size;
         status.current_size = 0;
-        status.stop = false;
+        status.min_max_only = false;
         _statuses.insert(std::make_pair(filter_id, std::move(status)));
     }
     return Status::OK();
@@ -162,9 +163,6 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
             // duplicated one, just skip it.
             return;
         }
-        if (status->stop) {
-            return;
-        }
     }
 
     int64_t now = UnixMillis();
@@ -183,15 +181,21 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
         return;
     }
 
-    // exceeds max size, stop building it.
+    // exceeds max size, the consumers still get the min/max values rather than waiting for nothing.
     status->current_size += rf->size();
-    if (status->current_size > status->max_size) {
-        // alreay exceeds max size, no need to build it.
-        VLOG_FILE << "RuntimeFilterMerger::merge_runtime_filter. stop building since size too "
+    status->current_bytes += params.data().size();
+    if (!status->min_max_only && (status->current_size > status->max_size ||
+                                  status->current_bytes > config::runtime_filter_merge_max_bytes)) {
+        VLOG_FILE << "RuntimeFilterMerger::merge_runtime_filter. only merge min/max since size too "
                      "large. size = "
-                  << status->current_size;
-        status->stop = true;
-        return;
+                  << status->current_size << ", bytes = " << status->current_bytes;
+        status->min_max_only = true;
+        for (auto& it : status->filters) {
+            it.second->drop_bloom_filter();
+        }
+    }
+    if (status->min_max_only) {
+        rf->drop_bloom_filter();
     }
 
     status->arrives.insert(be_number);
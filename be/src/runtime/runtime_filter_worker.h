@@ -55,7 +55,8 @@ public:
               filters(std::move(other.filters)),
               current_size(other.current_size),
               max_size(other.max_size),
-              stop(other.stop),
+              current_bytes(other.current_bytes),
+              min_max_only(other.min_max_only),
               recv_first_filter_ts(other.recv_first_filter_ts),
               recv_last_filter_ts(other.recv_last_filter_ts),
               broadcast_filter_ts(other.broadcast_filter_ts) {}
@@ -68,7 +69,11 @@ public:
     std::map<int32_t, vectorized::JoinRuntimeFilter*> filters;
     size_t current_size = 0;
     size_t max_size = 0;
-    bool stop = false;
+    // the serialized bytes of the partitioned rfs received.
+    size_t current_bytes = 0;
+    // the bloom filters are dropped once the rows exceed max_size or the bytes exceed
+    // config::runtime_filter_merge_max_bytes, and only the min/max values are merged and sent.
+    bool min_max_only = false;
 
     // statistics.
     // timestamp in ms since unix epoch;
@@ -35,7 +35,9 @@
 #include "gen_cpp/InternalService_types.h" // for TQueryOptions
 #include "gen_cpp/Types_types.h"           // for TUniqueId
 #include "runtime/mem_pool.h"
+#include "runtime/spill_coordinator.h"
 #include "runtime/thread_resource_mgr.h"
+#include "util/load_stage_metrics.h"
 #include "util/logging.h"
 #include "util/runtime_profile.h"
 
@@ -262,6 +264,11 @@ public:
 
     void update_num_rows_load_unselected(int64_t num_rows) { _num_rows_load_unselected.fetch_add(num_rows); }
 
+    // The total time the load of this fragment spent in |stage|, see LoadStageMetrics.
+    int64_t load_stage_ns(LoadStageMetrics::Stage stage) const { return _load_stage_ns[stage].load(); }
+
+    void update_load_stage_ns(LoadStageMetrics::Stage stage, int64_t ns) { _load_stage_ns[stage].fetch_add(ns); }
+
     void export_load_error(const std::string& error_msg);
 
     void set_per_fragment_instance_idx(int idx) { _per_fragment_instance_idx = idx; }
@@ -282,6 +289,9 @@ public:
 
     bool enable_spill() const { return _query_options.enable_spilling; }
 
+    // Decides which of the spillable operators of this fragment instance spills, see SpillCoordinator.
+    SpillCoordinator* spill_coordinator() { return &_spill_coordinator; }
+
     // the following getters are only valid after Prepare()
     InitialReservations* initial_reservations() const { return _initial_reservations; }
 
@@ -352,6 +362,8 @@ private:
     // Memory usage of this fragment instance
     std::unique_ptr<MemTracker> _instance_mem_tracker;
 
+    SpillCoordinator _spill_coordinator;
+
     std::shared_ptr<ObjectPool> _obj_pool;
 
     // if true, execution should stop with a CANCELLED status
@@ -392,6 +404,7 @@ private:
     std::atomic<int64_t> _num_print_error_rows{0};
 
     std::atomic<int64_t> _num_bytes_load_total{0}; // total bytes read from source
+    std::atomic<int64_t> _load_stage_ns[LoadStageMetrics::NUM_STAGES]{};
 
     std::vector<std::string> _export_output_files;
 
@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/scan_scheduler.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "common/logging.h"
+
+namespace starrocks {
+
+ScanScheduler::ScanScheduler(int max_scanners) : _max_scanners(std::max(1, max_scanners)) {}
+
+void ScanScheduler::register_scan(const TUniqueId& query_id) {
+    std::lock_guard<std::mutex> l(_mutex);
+    _queries[query_id].num_scan_nodes++;
+}
+
+void ScanScheduler::unregister_scan(const TUniqueId& query_id) {
+    std::lock_guard<std::mutex> l(_mutex);
+    auto iter = _queries.find(query_id);
+    DCHECK(iter != _queries.end());
+    if (iter != _queries.end() && --iter->second.num_scan_nodes <= 0) {
+        DCHECK_EQ(0, iter->second.num_scanners);
+        _queries.erase(iter);
+    }
+}
+
+bool ScanScheduler::try_acquire(const TUniqueId& query_id, const DataDir* data_dir, bool force) {
+    std::lock_guard<std::mutex> l(_mutex);
+    QueryScans& query = _queries[query_id];
+    int& disk_scanners = _disk_scanners[data_dir];
+    if (!force) {
+        const int fair_share = std::max<int>(1, _max_scanners / _queries.size());
+        if (_num_scanners >= _max_scanners || disk_scanners >= config::scan_scheduler_max_scanners_per_disk ||
+            query.num_scanners >= fair_share) {
+            return false;
+        }
+    }
+    _num_scanners++;
+    disk_scanners++;
+    query.num_scanners++;
+    return true;
+}
+
+void ScanScheduler::release(const TUniqueId& query_id, const DataDir* data_dir) {
+    std::lock_guard<std::mutex> l(_mutex);
+    auto query = _queries.find(query_id);
+    auto disk = _disk_scanners.find(data_dir);
+    DCHECK(query != _queries.end());
+    DCHECK(disk != _disk_scanners.end());
+    _num_scanners--;
+    if (query != _queries.end()) {
+        query->second.num_scanners--;
+    }
+    if (disk != _disk_scanners.end() && --disk->second <= 0) {
+        _disk_scanners.erase(disk);
+    }
+}
+
+int ScanScheduler::num_scanners() const {
+    std::lock_guard<std::mutex> l(_mutex);
+    return _num_scanners;
+}
+
+int ScanScheduler::num_disk_scanners(const DataDir* data_dir) const {
+    std::lock_guard<std::mutex> l(_mutex);
+    auto iter = _disk_scanners.find(data_dir);
+    return iter == _disk_scanners.end() ? 0 : iter->second;
+}
+
+} // namespace starrocks
@@ -0,0 +1,61 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+#include "gen_cpp/Types_types.h"
+#include "util/hash_util.hpp"
+
+namespace starrocks {
+
+class DataDir;
+
+// ScanScheduler grants the slots of the scanner thread pool to the scanners of the olap scan nodes of all the
+// queries on this BE. A scanner holds one slot while it's submitted to the thread pool. The slots are granted
+// only if all of them hold:
+//   - fewer than |max_scanners| slots are held in total;
+//   - fewer than config::scan_scheduler_max_scanners_per_disk slots are held by the scanners of the data dir,
+//     i.e. the number of the concurrent scanners is the IO queue depth of the disk;
+//   - fewer than the fair share, |max_scanners| divided by the number of the queries scanning, are held by the
+//     scanners of the query.
+// So one big scan could not take all the threads or saturate a disk while the small queries wait. A scan node
+// holding no slot is always granted one, so that every registered query always makes progress.
+// Thread-safe.
+class ScanScheduler {
+public:
+    explicit ScanScheduler(int max_scanners);
+
+    int max_scanners() const { return _max_scanners; }
+
+    // Called once by every scan node of |query_id| before it asks for slots.
+    void register_scan(const TUniqueId& query_id);
+    // Called once by every registered scan node after all of its slots have been released.
+    void unregister_scan(const TUniqueId& query_id);
+
+    // Grant a slot to a scanner of |query_id| reading |data_dir|, even beyond the limits if |force|.
+    // Returns false if not granted.
+    bool try_acquire(const TUniqueId& query_id, const DataDir* data_dir, bool force);
+    // Release a slot granted by try_acquire.
+    void release(const TUniqueId& query_id, const DataDir* data_dir);
+
+    // The number of the slots held in total and by the scanners of |data_dir|.
+    int num_scanners() const;
+    int num_disk_scanners(const DataDir* data_dir) const;
+
+private:
+    struct QueryScans {
+        int num_scan_nodes = 0;
+        int num_scanners = 0;
+    };
+
+    const int _max_scanners;
+
+    mutable std::mutex _mutex;
+    int _num_scanners = 0;
+    std::unordered_map<TUniqueId, QueryScans> _queries;
+    std::unordered_map<const DataDir*, int> _disk_scanners;
+};
+
+} // namespace starrocks
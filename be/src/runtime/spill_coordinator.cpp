@@ -0,0 +1,33 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/spill_coordinator.h"
+
+#include <algorithm>
+
+#include "runtime/mem_tracker.h"
+
+namespace starrocks {
+
+bool SpillCoordinator::should_spill(MemTracker* tracker) {
+    if (tracker->spare_capacity() <= 0) {
+        return true;
+    }
+    std::lock_guard<std::mutex> l(_mutex);
+    if (std::find(_trackers.begin(), _trackers.end(), tracker) == _trackers.end()) {
+        _trackers.push_back(tracker);
+    }
+    int64_t consumption = tracker->consumption();
+    for (MemTracker* other : _trackers) {
+        if (other->consumption() > consumption) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SpillCoordinator::finish(MemTracker* tracker) {
+    std::lock_guard<std::mutex> l(_mutex);
+    _trackers.erase(std::remove(_trackers.begin(), _trackers.end(), tracker), _trackers.end());
+}
+
+} // namespace starrocks
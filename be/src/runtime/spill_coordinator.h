@@ -0,0 +1,37 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+namespace starrocks {
+
+class MemTracker;
+
+// SpillCoordinator decides which of the spillable operators of a fragment instance, e.g. the hash join building its
+// hash table, the aggregation building its hash map and the external sort, spills once the memory nears the limit.
+// Without it, every operator decides by its own once the limit is near, so the small ones spill along with the large
+// one, and spill again and again while the large one keeps growing.
+//
+// An operator is identified by the MemTracker of its node, whose consumption is the memory it would release by
+// spilling. It is registered by its first should_spill(), and must be unregistered by finish() once it takes no
+// more input to spill, e.g. once the hash table is built.
+//
+// [thread-safe], since the build side of a join may be opened by another thread.
+class SpillCoordinator {
+public:
+    // Called by a spillable operator once the memory nears the limit. Returns whether it should spill now, which it
+    // should if it consumes the most memory among the registered operators, or if the limit is exceeded already,
+    // in case the largest operator is stuck in waiting for its input.
+    bool should_spill(MemTracker* tracker);
+
+    // The operator of |tracker| takes no more input to spill.
+    void finish(MemTracker* tracker);
+
+private:
+    std::mutex _mutex;
+    std::vector<MemTracker*> _trackers;
+};
+
+} // namespace starrocks
@@ -84,6 +84,18 @@ std::string StreamLoadContext::to_json() const {
     writer.Int(write_data_cost_nanos / 1000000);
     writer.Key("CommitAndPublishTimeMs");
     writer.Int64(commit_and_publish_txn_cost_nanos / 1000000);
+    writer.Key("ParseTimeMs");
+    writer.Int64(parse_cost_nanos / 1000000);
+    writer.Key("SinkRpcTimeMs");
+    writer.Int64(sink_rpc_cost_nanos / 1000000);
+    writer.Key("TabletsChannelTimeMs");
+    writer.Int64(tablets_channel_cost_nanos / 1000000);
+    writer.Key("MemtableInsertTimeMs");
+    writer.Int64(memtable_insert_cost_nanos / 1000000);
+    writer.Key("MemtableSortTimeMs");
+    writer.Int64(memtable_sort_cost_nanos / 1000000);
+    writer.Key("FlushTimeMs");
+    writer.Int64(flush_cost_nanos / 1000000);
 
     if (!error_url.empty()) {
         writer.Key("ErrorURL");
@@ -181,6 +181,13 @@ public:
     int64_t commit_and_publish_txn_cost_nanos = 0;
     int64_t read_data_cost_nanos = 0;
     int64_t write_data_cost_nanos = 0;
+    // the total time of the stages of the load plan on all the threads and nodes, see LoadStageMetrics
+    int64_t parse_cost_nanos = 0;
+    int64_t sink_rpc_cost_nanos = 0;
+    int64_t tablets_channel_cost_nanos = 0;
+    int64_t memtable_insert_cost_nanos = 0;
+    int64_t memtable_sort_cost_nanos = 0;
+    int64_t flush_cost_nanos = 0;
 
     std::string error_url = "";
     // if label already be used, set existing job's status here
@@ -100,6 +100,13 @@ Status StreamLoadExecutor::execute_plan_fragment(StreamLoadContext* ctx) {
                         break;
                     }
                 }
+                RuntimeState* state = executor->runtime_state();
+                ctx->parse_cost_nanos = state->load_stage_ns(LoadStageMetrics::PARSE);
+                ctx->sink_rpc_cost_nanos = state->load_stage_ns(LoadStageMetrics::SINK_RPC);
+                ctx->tablets_channel_cost_nanos = state->load_stage_ns(LoadStageMetrics::TABLETS_CHANNEL);
+                ctx->memtable_insert_cost_nanos = state->load_stage_ns(LoadStageMetrics::MEMTABLE_INSERT);
+                ctx->memtable_sort_cost_nanos = state->load_stage_ns(LoadStageMetrics::MEMTABLE_SORT);
+                ctx->flush_cost_nanos = state->load_stage_ns(LoadStageMetrics::FLUSH);
                 ctx->write_data_cost_nanos = MonotonicNanos() - ctx->start_write_data_nanos;
                 ctx->promise.set_value(status);
 
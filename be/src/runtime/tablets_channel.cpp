@@ -21,15 +21,26 @@
 
 #include "runtime/tablets_channel.h"
 
+#include "common/config.h"
+#include "env/env.h"
 #include "exec/tablet_info.h"
 #include "gutil/stl_util.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/exec_env.h"
 #include "runtime/row_batch.h"
 #include "runtime/tuple_row.h"
+#include "service/brpc.h"
 #include "storage/delta_writer.h"
 #include "storage/memtable.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/vectorized/delta_writer.h"
 #include "storage/vectorized/memtable.h"
+#include "util/block_compression.h"
+#include "util/brpc_stub_cache.h"
+#include "util/defer_op.h"
+#include "util/load_stage_metrics.h"
+#include "util/raw_container.h"
+#include "util/runtime_profile.h"
 #include "util/starrocks_metrics.h"
 
 namespace starrocks {
@@ -121,6 +132,9 @@ Status TabletsChannel::add_batch(const PTabletWriterAddBatchRequest& params) {
 
 Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
     DCHECK(_is_vectorized == true);
+    int64_t add_chunk_ns = 0;
+    DeferOp update_add_chunk_ns([&]() { _add_chunk_ns.fetch_add(add_chunk_ns); });
+    SCOPED_RAW_TIMER(&add_chunk_ns);
     {
         std::lock_guard<std::mutex> l(_global_lock);
         if (_state == kFinished) {
@@ -147,8 +161,21 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
         }
     }
 
+    // The chunk carries the rows of all the tablets of the sender on this node, which are decoded at once here and
+    // scattered to the delta writers of the tablets below.
     vectorized::Chunk chunk;
-    RETURN_IF_ERROR(chunk.deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta));
+    if (pchunk.compress_type() == CompressionTypePB::NO_COMPRESSION) {
+        RETURN_IF_ERROR(chunk.deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta));
+    } else {
+        const BlockCompressionCodec* codec = nullptr;
+        RETURN_IF_ERROR(get_block_compression_codec(pchunk.compress_type(), &codec));
+        size_t uncompressed_size = pchunk.uncompressed_size();
+        raw::RawString uncompressed_buffer;
+        uncompressed_buffer.resize(uncompressed_size);
+        Slice output{uncompressed_buffer.data(), uncompressed_size};
+        RETURN_IF_ERROR(codec->decompress(pchunk.data(), &output));
+        RETURN_IF_ERROR(chunk.deserialize((const uint8_t*)uncompressed_buffer.data(), uncompressed_size, _chunk_meta));
+    }
     DCHECK_EQ(params.tablet_ids_size(), chunk.num_rows());
 
     size_t channel_size = _tablet_id_to_sorted_indexes.size();
@@ -310,6 +337,7 @@ Status TabletsChannel::close(int sender_id, bool* finished,
                 if (!st.ok()) {
                     LOG(WARNING) << "Fail to close tablet writer, tablet_id=" << it.first
                                  << " transaction_id=" << _txn_id << " err=" << st.to_string();
+                    _send_segments(it.first, nullptr);
                     // just skip this tablet(writer) and continue to close others
                     continue;
                 }
@@ -326,74 +354,102 @@ Status TabletsChannel::close(int sender_id, bool* finished,
             }
         }
 
-        // 2. wait delta writers and build the tablet vector
+        // 2. wait delta writers and build the tablet vector. The primary replicas send their segments before the
+        // secondary replicas wait for theirs, so that no two nodes wait for each other.
         for (auto& it : need_wait_writers) {
+            if (it.second->is_secondary_replica()) {
+                continue;
+            }
+            Status st;
+            {
+                std::lock_guard<std::mutex> l(_tablet_locks[it.first & k_shard_size]);
+                // close may return failed, but no need to handle it here.
+                // tablet_vec will only contains success tablet, and then let FE judge it.
+                st = it.second->close_wait(tablet_vec);
+            }
+            _send_segments(it.first, st.ok() ? it.second->committed_rowset() : nullptr);
+        }
+        for (auto& it : need_wait_writers) {
+            if (!it.second->is_secondary_replica()) {
+                continue;
+            }
+            // wait without the tablet lock, which is taken by cancel()
+            auto st = it.second->wait_segments();
+            if (!st.ok()) {
+                LOG(WARNING) << "Fail to receive segments of tablet_id=" << it.first << " transaction_id=" << _txn_id
+                             << " err=" << st.to_string();
+                continue;
+            }
             std::lock_guard<std::mutex> l(_tablet_locks[it.first & k_shard_size]);
-            // close may return failed, but no need to handle it here.
-            // tablet_vec will only contains success tablet, and then let FE judge it.
             it.second->close_wait(tablet_vec);
         }
+
+        for (auto& it : need_wait_writers) {
+            _memtable_insert_ns += it.second->memtable_insert_ns();
+            _memtable_sort_ns += it.second->memtable_sort_ns();
+            _flush_ns += it.second->flush_ns();
+        }
+        LoadStageMetrics::add(LoadStageMetrics::TABLETS_CHANNEL, _add_chunk_ns);
+        LoadStageMetrics::add(LoadStageMetrics::MEMTABLE_INSERT, _memtable_insert_ns);
+        LoadStageMetrics::add(LoadStageMetrics::MEMTABLE_SORT, _memtable_sort_ns);
+        LoadStageMetrics::add(LoadStageMetrics::FLUSH, _flush_ns);
     }
 
     return Status::OK();
 }
 
-Status TabletsChannel::reduce_mem_usage_async(const std::set<int64_t>& flush_tablet_ids, int64_t* tablet_id,
-                                              int64_t* tablet_mem_consumption) {
-    vectorized::DeltaWriter* vectorized_writer = nullptr;
-    int64_t max_consume = 0L;
+void TabletsChannel::get_load_stage_times(PTabletWriterAddBatchResult* response) const {
+    response->set_memtable_insert_time_us(_memtable_insert_ns / 1000);
+    response->set_memtable_sort_time_us(_memtable_sort_ns / 1000);
+    response->set_flush_time_us(_flush_ns / 1000);
+}
 
+void TabletsChannel::get_tablet_mem_stats(std::vector<TabletMemStat>* stats) {
+    std::lock_guard<std::mutex> l(_global_lock);
+    if (_state == kFinished) {
+        return;
+    }
+    if (_is_vectorized) {
+        for (auto& it : _vectorized_tablet_writers) {
+            stats->push_back({it.first, it.second->mem_consumption(), it.second->memtable_first_write_ms()});
+        }
+    } else {
+        for (auto& it : _tablet_writers) {
+            stats->push_back({it.first, it.second->mem_consumption(), 0});
+        }
+    }
+}
+
+Status TabletsChannel::flush_tablet_async(int64_t tablet_id) {
+    vectorized::DeltaWriter* vectorized_writer = nullptr;
     {
         std::lock_guard<std::mutex> l(_global_lock);
         if (_state == kFinished) {
             // TabletsChannel is closed without LoadChannel's lock,
-            // therefore it's possible for reduce_mem_usage_async() to be called right after close().
+            // therefore it's possible for flush_tablet_async() to be called right after close().
             return _close_status;
         }
 
         if (_is_vectorized) {
-            // find tablet writer with largest mem consumption
-            for (auto& it : _vectorized_tablet_writers) {
-                if (it.second->mem_consumption() > max_consume &&
-                    flush_tablet_ids.find(it.first) == flush_tablet_ids.end()) {
-                    max_consume = it.second->mem_consumption();
-                    vectorized_writer = it.second;
-                    *tablet_id = it.first;
-                }
+            auto it = _vectorized_tablet_writers.find(tablet_id);
+            if (it == _vectorized_tablet_writers.end()) {
+                return Status::OK();
             }
+            vectorized_writer = it->second;
         } else {
-            DeltaWriter* writer = nullptr;
-            // find tablet writer with largest mem consumption
-            for (auto& it : _tablet_writers) {
-                if (it.second->mem_consumption() > max_consume &&
-                    flush_tablet_ids.find(it.first) == flush_tablet_ids.end()) {
-                    max_consume = it.second->mem_consumption();
-                    writer = it.second;
-                    *tablet_id = it.first;
-                }
-            }
-
-            if (writer == nullptr || max_consume == 0) {
-                // barely not happend, just return OK
+            auto it = _tablet_writers.find(tablet_id);
+            if (it == _tablet_writers.end()) {
                 return Status::OK();
             }
-            VLOG(3) << "pick the delta writer to flush, with mem consumption: " << max_consume
+            VLOG(3) << "pick the delta writer to flush, with mem consumption: " << it->second->mem_consumption()
                     << ", channel key: " << _key;
-            *tablet_mem_consumption = max_consume;
-            return writer->flush_memtable_async();
+            return it->second->flush_memtable_async();
         }
     }
-    if (_is_vectorized) {
-        if (vectorized_writer == nullptr || max_consume == 0) {
-            // barely not happend, just return OK
-            return Status::OK();
-        }
-        VLOG(3) << "pick the delta writer to flush, with mem consumption: " << max_consume << ", channel key: " << _key;
-        *tablet_mem_consumption = max_consume;
-        std::lock_guard<std::mutex> l(_tablet_locks[*tablet_id & k_shard_size]);
-        return vectorized_writer->flush_memtable_async();
-    }
-    return Status::OK();
+    VLOG(3) << "pick the delta writer to flush, with mem consumption: " << vectorized_writer->mem_consumption()
+            << ", channel key: " << _key;
+    std::lock_guard<std::mutex> l(_tablet_locks[tablet_id & k_shard_size]);
+    return vectorized_writer->flush_memtable_async();
 }
 
 Status TabletsChannel::wait_mem_usage_reduced(int64_t tablet_id) {
@@ -427,6 +483,103 @@ Status TabletsChannel::wait_mem_usage_reduced(int64_t tablet_id) {
     return Status::OK();
 }
 
+Status TabletsChannel::add_segment(const PTabletWriterAddSegmentRequest& request) {
+    vectorized::DeltaWriter* writer = nullptr;
+    {
+        std::lock_guard<std::mutex> l(_global_lock);
+        auto it = _vectorized_tablet_writers.find(request.tablet_id());
+        if (it == _vectorized_tablet_writers.end()) {
+            return Status::InternalError(
+                    strings::Substitute("unknown tablet to add segment, tablet=$0", request.tablet_id()));
+        }
+        writer = it->second;
+    }
+    // without the tablet lock, which is held by close() of the primary replicas of this node
+    return writer->add_segment(request);
+}
+
+void TabletsChannel::_send_segments(int64_t tablet_id, const RowsetSharedPtr& rowset) {
+    auto it = _secondary_replicas.find(tablet_id);
+    if (it == _secondary_replicas.end()) {
+        return;
+    }
+    for (const auto& replica : it->second) {
+        auto st = _send_segments(replica, tablet_id, rowset);
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to send segments of tablet_id=" << tablet_id << " to " << replica.host() << ":"
+                         << replica.port() << " transaction_id=" << _txn_id << " err=" << st.to_string();
+        }
+    }
+}
+
+Status TabletsChannel::_send_segments(const PNetworkAddress& replica, int64_t tablet_id,
+                                      const RowsetSharedPtr& rowset) {
+    PBackendService_Stub* stub = ExecEnv::GetInstance()->brpc_stub_cache()->get_stub(replica.host(), replica.port());
+    if (stub == nullptr) {
+        return Status::InternalError("Fail to get rpc stub of " + replica.host());
+    }
+    PTabletWriterAddSegmentRequest request;
+    *request.mutable_id() = _key.id.to_proto();
+    request.set_index_id(_index_id);
+    request.set_tablet_id(tablet_id);
+    auto send = [&]() -> Status {
+        brpc::Controller cntl;
+        cntl.set_timeout_ms(config::single_replica_load_wait_timeout_s * 1000);
+        PTabletWriterAddSegmentResult result;
+        stub->tablet_writer_add_segment(&cntl, &request, &result, nullptr);
+        if (cntl.Failed()) {
+            return Status::InternalError(cntl.ErrorText());
+        }
+        return Status(result.status());
+    };
+    if (rowset == nullptr) {
+        request.set_primary_failed(true);
+        return send();
+    }
+
+    // send the files in parts of config::single_replica_load_rpc_bytes, read into the request in place
+    auto send_file = [&](int segment_id, bool is_delete_file) -> Status {
+        std::string path;
+        if (is_delete_file) {
+            path = BetaRowset::segment_del_file_path(rowset->rowset_path(), rowset->rowset_id(), segment_id);
+        } else {
+            path = BetaRowset::segment_file_path(rowset->rowset_path(), rowset->rowset_id(), segment_id);
+        }
+        std::unique_ptr<RandomAccessFile> file;
+        RETURN_IF_ERROR(Env::Default()->new_random_access_file(path, &file));
+        uint64_t file_size = 0;
+        RETURN_IF_ERROR(file->size(&file_size));
+        request.set_segment_id(segment_id);
+        request.set_is_delete_file(is_delete_file);
+        uint64_t part_size = std::max<int64_t>(1, config::single_replica_load_rpc_bytes);
+        uint64_t offset = 0;
+        do {
+            size_t size = std::min(file_size - offset, part_size);
+            std::string* data = request.mutable_data();
+            data->resize(size);
+            RETURN_IF_ERROR(file->read_at(offset, Slice(*data)));
+            request.set_offset(offset);
+            request.set_file_eof(offset + size == file_size);
+            RETURN_IF_ERROR(send());
+            offset += size;
+        } while (offset < file_size);
+        return Status::OK();
+    };
+    const RowsetMetaSharedPtr& meta = rowset->rowset_meta();
+    for (int64_t i = 0; i < meta->num_segments(); i++) {
+        RETURN_IF_ERROR(send_file(i, false));
+    }
+    for (uint32_t i = 0; i < meta->get_num_delete_files(); i++) {
+        RETURN_IF_ERROR(send_file(i, true));
+    }
+    request.Clear();
+    *request.mutable_id() = _key.id.to_proto();
+    request.set_index_id(_index_id);
+    request.set_tablet_id(tablet_id);
+    request.set_rowset_meta(meta->to_rowset_pb().SerializeAsString());
+    return send();
+}
+
 Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& params) {
     std::vector<SlotDescriptor*>* index_slots = nullptr;
     int32_t schema_hash = 0;
@@ -455,9 +608,18 @@ Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& params)
             request.load_id = params.id();
             request.tuple_desc = _tuple_desc;
             request.slots = index_slots;
+            request.is_secondary_replica = tablet.is_secondary_replica();
 
             vectorized::DeltaWriter* writer = nullptr;
             auto st = vectorized::DeltaWriter::open(&request, _mem_tracker.get(), &writer);
+            if (st.ok()) {
+                _vectorized_tablet_writers.emplace(tablet.tablet_id(), writer);
+                // a secondary replica receives the segments from the time the primary replica is closed, which may
+                // be before the secondary replica is.
+                if (request.is_secondary_replica) {
+                    st = writer->init();
+                }
+            }
             if (!st.ok()) {
                 std::stringstream ss;
                 ss << "open delta writer failed, tablet_id=" << tablet.tablet_id() << ", txn_id=" << _txn_id
@@ -465,7 +627,10 @@ Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& params)
                 LOG(WARNING) << ss.str();
                 return Status::InternalError(ss.str());
             }
-            _vectorized_tablet_writers.emplace(tablet.tablet_id(), writer);
+            if (tablet.secondary_replicas_size() > 0) {
+                _secondary_replicas[tablet.tablet_id()].assign(tablet.secondary_replicas().begin(),
+                                                               tablet.secondary_replicas().end());
+            }
             tablet_ids.emplace_back(tablet.tablet_id());
         }
         _s_tablet_writer_count += _vectorized_tablet_writers.size();
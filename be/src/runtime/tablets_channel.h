@@ -20,6 +20,7 @@
 // under the License.
 
 #include <cstdint>
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -57,6 +58,16 @@ std::ostream& operator<<(std::ostream& os, const TabletsChannelKey& key);
 
 class DeltaWriter;
 class OlapTableSchemaParam;
+class Rowset;
+using RowsetSharedPtr = std::shared_ptr<Rowset>;
+
+struct TabletMemStat {
+    int64_t tablet_id;
+    // the memory of the memtables of the tablet, including the ones being flushed
+    int64_t mem_consumption;
+    // the time of the first write to the current memtable by MonotonicMillis(), 0 if unknown or empty
+    int64_t first_write_ms;
+};
 
 // Write channel for a particular (load, index).
 class TabletsChannel {
@@ -83,23 +94,36 @@ public:
     // no-op when this channel has been closed or cancelled
     Status cancel();
 
-    // upper application may call this to try to reduce the mem usage of this channel.
-    // eg. flush the largest memtable async.
+    // Append the memory of the tablets of this channel to |stats|, by which the upper application picks the
+    // memtables to flush to reduce the mem usage.
+    void get_tablet_mem_stats(std::vector<TabletMemStat>* stats);
+    // flush the memtable of |tablet_id| async.
     // no-op when this channel has been closed or cancelled.
     // return Status::OK if flush async success or no-op.
-    Status reduce_mem_usage_async(const std::set<int64_t>& flush_tablet_ids, int64_t* tablet_id,
-                                  int64_t* tablet_mem_consumption);
+    Status flush_tablet_async(int64_t tablet_id);
     // wait tablet memtables in flush queue to be flushed.
     Status wait_mem_usage_reduced(int64_t tablet_id);
 
+    // write a part of the files of a secondary replica in a single replica load, see PTabletWithPartition
+    Status add_segment(const PTabletWriterAddSegmentRequest& request);
+
     int64_t mem_consumption() const { return _mem_tracker->consumption(); }
 
+    // Set the time the delta writers of this channel spent in the stages of the load into |response|, after the
+    // channel is finished by close().
+    void get_load_stage_times(PTabletWriterAddBatchResult* response) const;
+
 private:
     // open all writer
     Status _open_all_writers(const PTabletWriterOpenRequest& params);
 
     Status _build_chunk_meta(const ChunkPB& pb_chunk);
 
+    // Send the files of |rowset| of the primary replica of |tablet_id| to its secondary replicas, or the failure of
+    // the primary replica if |rowset| is null. The secondary replicas failing to receive them fail the tablet.
+    void _send_segments(int64_t tablet_id, const RowsetSharedPtr& rowset);
+    Status _send_segments(const PNetworkAddress& replica, int64_t tablet_id, const RowsetSharedPtr& rowset);
+
     // id of this load channel
     TabletsChannelKey _key;
 
@@ -145,6 +169,14 @@ private:
     std::unordered_map<int64_t, uint32_t> _tablet_id_to_sorted_indexes;
     // tablet_id -> TabletChannel
     std::unordered_map<int64_t, vectorized::DeltaWriter*> _vectorized_tablet_writers;
+    // tablet_id -> the secondary replicas of the tablets of which this node is the primary replica
+    std::unordered_map<int64_t, std::vector<PNetworkAddress>> _secondary_replicas;
+
+    // the time spent in add_chunk(), and the total time of the stages of the delta writers once finished
+    std::atomic<int64_t> _add_chunk_ns{0};
+    int64_t _memtable_insert_ns = 0;
+    int64_t _memtable_sort_ns = 0;
+    int64_t _flush_ns = 0;
 };
 
 } // namespace starrocks
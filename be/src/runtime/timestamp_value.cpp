@@ -787,20 +787,18 @@ void TimestampValue::trunc_to_day() {
 
 void TimestampValue::trunc_to_month() {
     int year, month, day;
-    date::to_date_with_cache(timestamp::to_julian(_timestamp), &year, &month, &day);
-    _timestamp = timestamp::from_datetime(year, month, 1, 0, 0, 0, 0);
+    JulianDate julian = timestamp::to_julian(_timestamp);
+    date::to_date_with_cache(julian, &year, &month, &day);
+    _timestamp = timestamp::from_julian_and_time(julian - day + 1, 0);
 }
 
 void TimestampValue::trunc_to_year() {
-    int year, month, day;
-    date::to_date_with_cache(timestamp::to_julian(_timestamp), &year, &month, &day);
-    _timestamp = timestamp::from_datetime(year, 1, 1, 0, 0, 0, 0);
+    JulianDate julian = timestamp::to_julian(_timestamp);
+    _timestamp = timestamp::from_julian_and_time(julian - date::get_day_of_year(julian) + 1, 0);
 }
 
 void TimestampValue::trunc_to_week(int days) {
-    int year, month, day;
-    date::to_date_with_cache(timestamp::to_julian(_timestamp) + days, &year, &month, &day);
-    _timestamp = timestamp::from_datetime(year, month, day, 0, 0, 0, 0);
+    _timestamp = timestamp::from_julian_and_time(timestamp::to_julian(_timestamp) + days, 0);
 }
 
 void TimestampValue::trunc_to_quarter() {
@@ -30,16 +30,25 @@ ChunkCursor::ChunkCursor(const ChunkSupplier& supplier, const std::vector<ExprCo
 ChunkCursor::~ChunkCursor() {}
 
 bool ChunkCursor::operator<(const ChunkCursor& cursor) const {
+    return _less(_current_pos, cursor, cursor._current_pos);
+}
+
+bool ChunkCursor::is_row_not_after(int32_t pos, const ChunkCursor& cursor) const {
+    DCHECK(pos < _current_chunk->num_rows());
+    return !cursor._less(cursor._current_pos, *this, pos);
+}
+
+bool ChunkCursor::_less(int32_t pos, const ChunkCursor& cursor, int32_t cursor_pos) const {
     DCHECK_EQ(_current_order_by_columns.size(), cursor._current_order_by_columns.size());
     // both cursors must be pointing to valid data.
-    DCHECK(_current_pos >= 0 && _current_chunk != nullptr);
-    DCHECK(cursor._current_pos >= 0 && cursor._current_chunk != nullptr);
+    DCHECK(pos >= 0 && _current_chunk != nullptr);
+    DCHECK(cursor_pos >= 0 && cursor._current_chunk != nullptr);
     const size_t number_of_order_by_columns = _current_order_by_columns.size();
     bool is_ahead = true;
     for (size_t col_index = 0; col_index < number_of_order_by_columns; ++col_index) {
         const auto& left_col = _current_order_by_columns[col_index];
         const auto& right_col = cursor._current_order_by_columns[col_index];
-        int cmp = left_col->compare_at(_current_pos, cursor._current_pos, *right_col, _null_first_flag[col_index]);
+        int cmp = left_col->compare_at(pos, cursor_pos, *right_col, _null_first_flag[col_index]);
         if (cmp != 0) {
             if (_sort_order_flag[col_index] > 0) {
                 is_ahead = cmp < 0;
@@ -69,6 +78,13 @@ void ChunkCursor::next() {
     }
 }
 
+void ChunkCursor::skip(size_t num_rows) {
+    DCHECK_GT(num_rows, 0);
+    DCHECK_LE(_current_pos + num_rows, _current_chunk->num_rows());
+    _current_pos += num_rows - 1;
+    next();
+}
+
 ChunkPtr ChunkCursor::clone_empty_chunk(size_t reserved_row_number) const {
     if (_current_chunk == nullptr) {
         return nullptr;
@@ -28,8 +28,14 @@ public:
     // Whether the record referenced by this cursor is before the one referenced by cursor.
     bool operator<(const ChunkCursor& cursor) const;
 
+    // Whether the row |pos| of the current chunk of this cursor is not after the one referenced by cursor, so that
+    // the rows of this cursor up to |pos| go before it.
+    bool is_row_not_after(int32_t pos, const ChunkCursor& cursor) const;
+
     // Move to next row.
     void next();
+    // Move |num_rows| rows forward, at most to the first row of the next chunk.
+    void skip(size_t num_rows);
     // Is current row valid? A new Cursor without any next() has an invalid row.
     bool is_valid() const;
     // Copy current row to the dest Chunk whose structure is as same as the source Chunk.
@@ -41,6 +47,8 @@ public:
     [[nodiscard]] ChunkPtr clone_empty_chunk(size_t reserved_row_number) const;
 
 private:
+    // Whether the row |pos| of this cursor is before the row |cursor_pos| of cursor.
+    bool _less(int32_t pos, const ChunkCursor& cursor, int32_t cursor_pos) const;
     void _reset_with_next_chunk();
 
 private:
@@ -2,7 +2,12 @@
 
 #include "sorted_chunks_merger.h"
 
+#include <algorithm>
+
 #include "exec/sort_exec_exprs.h"
+#include "exprs/expr.h"
+#include "gutil/strings/substitute.h"
+#include "util/threadpool.h"
 
 namespace starrocks::vectorized {
 
@@ -61,44 +66,152 @@ Status SortedChunksMerger::get_next(ChunkPtr* chunk, bool* eos) {
     ChunkPtr current_chunk = cursor->get_current_chunk();
     std::vector<uint32_t> selective_values; // for append_selective call
     selective_values.reserve(config::vector_chunk_size);
-    selective_values.push_back(cursor->get_current_position_in_chunk());
-    size_t row_number = 1;
-
-    std::pop_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
-    cursor->next();
-    if (cursor->is_valid()) {
-        std::push_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
-    } else {
-        _min_heap.pop_back();
-    }
+    size_t row_number = 0;
+    auto append_selected_rows = [&]() {
+        if (!selective_values.empty()) {
+            (*chunk)->append_selective(*current_chunk, selective_values.data(), 0, selective_values.size());
+            selective_values.clear();
+        }
+    };
 
+    ChunkCursor* last_cursor = nullptr;
     while (row_number < config::vector_chunk_size && !_min_heap.empty()) {
         cursor = _min_heap[0];
+        std::pop_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
         const auto& ptr = cursor->get_current_chunk();
-        if (current_chunk == ptr) {
-            selective_values.push_back(cursor->get_current_position_in_chunk());
-        } else {
-            (*chunk)->append_selective(*current_chunk, selective_values.data(), 0, selective_values.size());
+        if (current_chunk != ptr) {
+            append_selected_rows();
             current_chunk = ptr;
-            selective_values.clear();
-            selective_values.push_back(cursor->get_current_position_in_chunk());
         }
 
-        std::pop_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
-        cursor->next();
+        // Once a cursor comes first twice in a row, the rest of its current chunk is copied at a time if it goes
+        // before the rows of the other cursors, e.g. when the cursors take turns by whole chunks or a single one is
+        // left, at the cost of one more comparison.
+        const int32_t pos = cursor->get_current_position_in_chunk();
+        const size_t num_rows =
+                std::min<size_t>(current_chunk->num_rows() - pos, config::vector_chunk_size - row_number);
+        if (cursor == last_cursor && num_rows > 1 &&
+            (_min_heap.size() == 1 || cursor->is_row_not_after(pos + num_rows - 1, *_min_heap[0]))) {
+            append_selected_rows();
+            (*chunk)->append(*current_chunk, pos, num_rows);
+            cursor->skip(num_rows);
+            row_number += num_rows;
+        } else {
+            selective_values.push_back(pos);
+            cursor->next();
+            ++row_number;
+        }
+        last_cursor = cursor;
+
         if (cursor->is_valid()) {
             std::push_heap(_min_heap.begin(), _min_heap.end(), _cursor_cmp_greater);
         } else {
             _min_heap.pop_back();
         }
-
-        ++row_number;
     }
 
-    (*chunk)->append_selective(*current_chunk, selective_values.data(), 0, selective_values.size());
+    append_selected_rows();
     (*chunk)->set_num_rows(row_number); // set constant column in chunk with right size.
 
     return Status::OK();
 }
 
+ParallelSortedChunksMerger::~ParallelSortedChunksMerger() {
+    close();
+}
+
+void ParallelSortedChunksMerger::close() {
+    for (auto& group : _groups) {
+        group->chunks.shutdown();
+    }
+    if (_groups_done != nullptr) {
+        _groups_done->wait();
+    }
+}
+
+Status ParallelSortedChunksMerger::init(const ChunkSuppliers& suppliers, const std::vector<ExprContext*>* sort_exprs,
+                                        const std::vector<bool>* is_asc, const std::vector<bool>* is_null_first,
+                                        size_t group_size, ThreadPool* thread_pool) {
+    // The threads of the groups evaluate the sort exprs concurrently, which only the slot refs are safe for.
+    bool all_slot_refs = std::all_of(sort_exprs->begin(), sort_exprs->end(),
+                                     [](ExprContext* ctx) { return ctx->root()->is_slotref(); });
+    if (group_size == 0 || suppliers.size() <= group_size || !all_slot_refs) {
+        return _merger.init(suppliers, sort_exprs, is_asc, is_null_first);
+    }
+    _sort_exprs = sort_exprs;
+    _is_asc = is_asc;
+    _is_null_first = is_null_first;
+
+    // Split the suppliers evenly rather than leave a small group last.
+    const size_t num_groups = (suppliers.size() + group_size - 1) / group_size;
+    _groups.reserve(num_groups);
+    for (size_t i = 0; i < num_groups; i++) {
+        auto& group = _groups.emplace_back(std::make_unique<Group>());
+        for (size_t j = i; j < suppliers.size(); j += num_groups) {
+            group->suppliers.push_back(suppliers[j]);
+        }
+    }
+    _groups_done = std::make_unique<CountDownLatch>(num_groups);
+    for (size_t i = 0; i < num_groups; i++) {
+        Group* group = _groups[i].get();
+        Status st = thread_pool->submit_func([this, group] {
+            _merge_group(group);
+            _groups_done->count_down();
+        });
+        if (!st.ok()) {
+            // The groups submitted are stopped, and waited for by close() once the suppliers are unblocked.
+            for (auto& g : _groups) {
+                g->chunks.shutdown();
+            }
+            _groups_done->count_down(num_groups - i);
+            return Status::InternalError(
+                    strings::Substitute("Fail to merge $0 groups of senders in parallel: $1", num_groups,
+                                        st.get_error_msg()));
+        }
+    }
+
+    ChunkSuppliers group_suppliers;
+    group_suppliers.reserve(num_groups);
+    for (auto& group : _groups) {
+        Group* g = group.get();
+        group_suppliers.emplace_back([g](Chunk** chunk) -> Status {
+            ChunkPtr sorted_chunk;
+            // The chunk output by the merger of the group isn't shared with anyone else, so it could be moved out.
+            *chunk = g->chunks.blocking_get(&sorted_chunk) ? new Chunk(std::move(*sorted_chunk)) : nullptr;
+            return Status::OK();
+        });
+    }
+    return _merger.init(group_suppliers, sort_exprs, is_asc, is_null_first);
+}
+
+void ParallelSortedChunksMerger::_merge_group(Group* group) {
+    // The merger of the group is initialized here, as it waits for the first chunk of every supplier.
+    Status status = group->merger.init(group->suppliers, _sort_exprs, _is_asc, _is_null_first);
+    while (status.ok()) {
+        ChunkPtr chunk;
+        bool eos = false;
+        status = group->merger.get_next(&chunk, &eos);
+        if (!status.ok() || eos || !group->chunks.blocking_put(std::move(chunk))) {
+            break;
+        }
+    }
+    if (!status.ok()) {
+        std::lock_guard<std::mutex> l(_status_lock);
+        if (_status.ok()) {
+            _status = status;
+        }
+    }
+    // The final merger takes the end of the chunks of the group as its eos.
+    group->chunks.shutdown();
+}
+
+Status ParallelSortedChunksMerger::get_next(ChunkPtr* chunk, bool* eos) {
+    RETURN_IF_ERROR(_merger.get_next(chunk, eos));
+    if (!_groups.empty()) {
+        std::lock_guard<std::mutex> l(_status_lock);
+        RETURN_IF_ERROR(_status);
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks::vectorized
\ No newline at end of file
@@ -2,14 +2,19 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <queue>
 
 #include "runtime/vectorized/chunk_cursor.h"
+#include "util/blocking_queue.hpp"
+#include "util/countdown_latch.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks {
 
 class SortExecExprs;
+class ThreadPool;
 
 namespace vectorized {
 
@@ -41,6 +46,60 @@ private:
     RuntimeProfile::Counter* _total_timer = nullptr;
 };
 
+// Merge a group of sorted Chunks to one Chunk in order as SortedChunksMerger, but in a tree of two levels if there are
+// more than |group_size| suppliers, e.g. the hundreds of senders of a merging exchange: the suppliers are split into
+// the groups of up to |group_size|, each merged by a SortedChunksMerger in a task of |thread_pool|, whose sorted chunks
+// are merged by a final SortedChunksMerger on the calling thread. The final merger waits on every group, so the pool
+// must run each task it takes at once, i.e. queue no task.
+//
+// The sort exprs are evaluated on the threads concurrently, so the suppliers are merged on the calling thread only,
+// unless the sort exprs are all slot refs, e.g. those of the materialized sort tuple of an exchange. The suppliers
+// must not block once their source is closed or cancelled, so that the merger can be closed, and the sort exprs must
+// not be closed before the merger.
+class ParallelSortedChunksMerger {
+public:
+    ParallelSortedChunksMerger() = default;
+    ~ParallelSortedChunksMerger();
+
+    // Fail if |thread_pool| rejects the task of a group.
+    Status init(const ChunkSuppliers& suppliers, const std::vector<ExprContext*>* sort_exprs,
+                const std::vector<bool>* is_asc, const std::vector<bool>* is_null_first, size_t group_size,
+                ThreadPool* thread_pool);
+
+    void set_profile(RuntimeProfile* profile) { _merger.set_profile(profile); }
+
+    // Return the next sorted chunk from this merger.
+    Status get_next(ChunkPtr* chunk, bool* eos);
+
+    // Stop the groups and wait for their tasks, which wait for the suppliers blocked to return.
+    void close();
+
+private:
+    // The sorted chunks of a group buffered for the final merger.
+    static constexpr size_t kBufferedChunksPerGroup = 4;
+
+    struct Group {
+        ChunkSuppliers suppliers;
+        SortedChunksMerger merger;
+        BlockingQueue<ChunkPtr> chunks{kBufferedChunksPerGroup};
+    };
+
+    void _merge_group(Group* group);
+
+    const std::vector<ExprContext*>* _sort_exprs = nullptr;
+    const std::vector<bool>* _is_asc = nullptr;
+    const std::vector<bool>* _is_null_first = nullptr;
+
+    SortedChunksMerger _merger;
+    std::vector<std::unique_ptr<Group>> _groups;
+    // Counted down by the task of each group once it's done, or for the groups whose tasks are rejected.
+    std::unique_ptr<CountDownLatch> _groups_done;
+
+    std::mutex _status_lock;
+    // The first failure of the groups.
+    Status _status;
+};
+
 } // namespace vectorized
 
 } // namespace starrocks
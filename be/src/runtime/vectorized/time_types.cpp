@@ -1,8 +1,11 @@
 // This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
 #include "runtime/vectorized/time_types.h"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
 #include "util/raw_container.h"
 
@@ -27,11 +30,21 @@ struct JulianToDateEntry {
 
     // 1-53, Base on 6 bits
     uint8_t week_th_of_year;
+
+    // 1-366, Base on 9 bits
+    uint16_t day_of_year;
 };
 
-// Date Cache
-static const uint32_t CACHE_JULIAN_DAYS = 200 * 366;
-static JulianToDateEntry g_julian_to_date_cache[CACHE_JULIAN_DAYS];
+// Date Cache, of the days in [date_cache_min_year, date_cache_max_year], from g_julian_to_date_cache_start.
+static JulianDate g_julian_to_date_cache_start = 0;
+static std::vector<JulianToDateEntry> g_julian_to_date_cache;
+
+// The entry of |julian| in the date cache, or nullptr if it's out of the cache.
+static inline const JulianToDateEntry* get_date_cache_entry(JulianDate julian) {
+    // Both the bounds are checked by one comparison of the unsigned offset.
+    auto offset = static_cast<uint32_t>(julian - g_julian_to_date_cache_start);
+    return offset < g_julian_to_date_cache.size() ? &g_julian_to_date_cache[offset] : nullptr;
+}
 
 static const uint32_t CACHE_DATE_LITERAL_START = 19900101;
 static const uint32_t CACHE_DATE_LITERAL_END = 20250101;
@@ -44,14 +57,19 @@ static JulianDate g_mysql_date_to_julian_cache[CACHE_DATE_LOGIC_END - CACHE_DATE
 
 void date::init_date_cache() {
     // julian date to date cache
-    for (int i = 0; i < CACHE_JULIAN_DAYS; ++i) {
+    g_julian_to_date_cache_start = date::from_date(config::date_cache_min_year, 1, 1);
+    JulianDate cache_end = date::from_date(config::date_cache_max_year + 1, 1, 1);
+    g_julian_to_date_cache.resize(std::max(cache_end - g_julian_to_date_cache_start, 0));
+    for (int i = 0; i < g_julian_to_date_cache.size(); ++i) {
+        JulianDate julian = g_julian_to_date_cache_start + i;
         int year, month, day;
-        to_date(date::UNIX_EPOCH_JULIAN + i, &year, &month, &day);
+        to_date(julian, &year, &month, &day);
 
         g_julian_to_date_cache[i].year = year;
         g_julian_to_date_cache[i].month = month;
         g_julian_to_date_cache[i].day = day;
-        g_julian_to_date_cache[i].week_th_of_year = get_week_of_year(date::UNIX_EPOCH_JULIAN + i);
+        g_julian_to_date_cache[i].week_th_of_year = get_week_of_year(julian);
+        g_julian_to_date_cache[i].day_of_year = julian - date::from_date(year, 1, 1) + 1;
     }
 
     // date to julian date cache
@@ -134,11 +152,10 @@ void date::to_date(JulianDate julian, int* year, int* month, int* day) {
 }
 
 void date::to_date_with_cache(JulianDate julian, int* year, int* month, int* day) {
-    if (julian >= date::UNIX_EPOCH_JULIAN && julian < date::UNIX_EPOCH_JULIAN + CACHE_JULIAN_DAYS) {
-        int p = julian - date::UNIX_EPOCH_JULIAN;
-        *year = g_julian_to_date_cache[p].year;
-        *month = g_julian_to_date_cache[p].month;
-        *day = g_julian_to_date_cache[p].day;
+    if (const auto* entry = get_date_cache_entry(julian); entry != nullptr) {
+        *year = entry->year;
+        *month = entry->month;
+        *day = entry->day;
 
         return;
     }
@@ -147,13 +164,22 @@ void date::to_date_with_cache(JulianDate julian, int* year, int* month, int* day
 }
 
 bool date::get_weeks_of_year_with_cache(JulianDate julian, int* weeks) {
-    if (julian >= date::UNIX_EPOCH_JULIAN && julian < date::UNIX_EPOCH_JULIAN + CACHE_JULIAN_DAYS) {
-        *weeks = g_julian_to_date_cache[julian - date::UNIX_EPOCH_JULIAN].week_th_of_year;
+    if (const auto* entry = get_date_cache_entry(julian); entry != nullptr) {
+        *weeks = entry->week_th_of_year;
         return true;
     }
     return false;
 }
 
+int date::get_day_of_year(JulianDate julian) {
+    if (const auto* entry = get_date_cache_entry(julian); entry != nullptr) {
+        return entry->day_of_year;
+    }
+    int year, month, day;
+    to_date(julian, &year, &month, &day);
+    return julian - from_date(year, 1, 1) + 1;
+}
+
 int64_t date::standardize_date(int64_t value) {
     if (value <= 0) {
         return 0;
@@ -74,6 +74,9 @@ public:
 
     static bool get_weeks_of_year_with_cache(JulianDate julian, int* weeks);
 
+    // 1-366
+    static int get_day_of_year(JulianDate julian);
+
     static int get_days_after_monday(JulianDate julian);
 
     static bool is_leap(int year);
@@ -27,8 +27,10 @@
 #include "http/action/meta_action.h"
 #include "http/action/metrics_action.h"
 #include "http/action/pprof_actions.h"
+#include "http/action/query_trace_action.h"
 #include "http/action/reload_tablet_action.h"
 #include "http/action/restore_tablet_action.h"
+#include "http/action/sampling_profile_action.h"
 #include "http/action/snapshot_action.h"
 #include "http/action/stream_load.h"
 #include "http/action/update_config_action.h"
@@ -117,6 +119,12 @@ Status HttpService::start() {
     UpdateConfigAction* update_config_action = new UpdateConfigAction();
     _ev_http_server->register_handler(HttpMethod::POST, "/api/update_config", update_config_action);
 
+    QueryTraceAction* query_trace_action = new QueryTraceAction();
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/query_trace", query_trace_action);
+
+    SamplingProfileAction* sampling_profile_action = new SamplingProfileAction(_env);
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/sampling_profile", sampling_profile_action);
+
     RETURN_IF_ERROR(_ev_http_server->start());
     return Status::OK();
 }
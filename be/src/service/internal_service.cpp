@@ -21,6 +21,8 @@
 
 #include "service/internal_service.h"
 
+#include <arrow/record_batch.h>
+
 #include "common/config.h"
 #include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/fragment_executor.h"
@@ -31,9 +33,11 @@
 #include "runtime/fragment_mgr.h"
 #include "runtime/load_channel_mgr.h"
 #include "runtime/result_buffer_mgr.h"
+#include "runtime/result_queue_mgr.h"
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/runtime_filter_worker.h"
 #include "service/brpc.h"
+#include "util/arrow/row_batch.h"
 #include "util/thrift_util.h"
 #include "util/uid_util.h"
 
@@ -86,19 +90,11 @@ void PInternalServiceImpl<T>::transmit_chunk(google::protobuf::RpcController* cn
     // If we don't give response here, stream manager will call done->Run before
     // transmit_data(), which will cause a dirty memory access.
     brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
-    PTransmitChunkParams* req = const_cast<PTransmitChunkParams*>(request);
-    if (cntl->request_attachment().size() > 0) {
-        const butil::IOBuf& io_buf = cntl->request_attachment();
-        size_t offset = 0;
-        for (size_t i = 0; i < req->chunks().size(); ++i) {
-            auto chunk = req->mutable_chunks(i);
-            io_buf.copy_to(chunk->mutable_data(), chunk->data_size(), offset);
-            offset += chunk->data_size();
-        }
-    }
     Status st;
     st.to_protobuf(response->mutable_status());
-    st = _exec_env->stream_mgr()->transmit_chunk(*request, &done);
+    // The chunk data are deserialized from the attachment, without being copied into the request.
+    int64_t credit_bytes = -1;
+    st = _exec_env->stream_mgr()->transmit_chunk(*request, &cntl->request_attachment(), &credit_bytes, &done);
     if (!st.ok()) {
         LOG(WARNING) << "transmit_data failed, message=" << st.get_error_msg()
                      << ", fragment_instance_id=" << print_id(request->finst_id()) << ", node=" << request->node_id();
@@ -106,6 +102,9 @@ void PInternalServiceImpl<T>::transmit_chunk(google::protobuf::RpcController* cn
     if (done != nullptr) {
         // NOTE: only when done is not null, we can set response status
         st.to_protobuf(response->mutable_status());
+        if (credit_bytes >= 0) {
+            response->set_credit_bytes(credit_bytes);
+        }
         done->Run();
     }
 }
@@ -198,8 +197,7 @@ void PInternalServiceImpl<T>::tablet_writer_add_chunk(google::protobuf::RpcContr
         int64_t wait_lock_time_ns = 0;
         {
             SCOPED_RAW_TIMER(&execution_time_ns);
-            auto st = _exec_env->load_channel_mgr()->add_chunk(*request, response->mutable_tablet_vec(),
-                                                               &wait_lock_time_ns);
+            auto st = _exec_env->load_channel_mgr()->add_chunk(*request, response, &wait_lock_time_ns);
             if (!st.ok()) {
                 LOG(WARNING) << "tablet writer add chunk failed, message=" << st.get_error_msg()
                              << ", id=" << print_id(request->id()) << ", index_id=" << request->index_id()
@@ -227,6 +225,25 @@ void PInternalServiceImpl<T>::tablet_writer_cancel(google::protobuf::RpcControll
     }
 }
 
+template <typename T>
+void PInternalServiceImpl<T>::tablet_writer_add_segment(google::protobuf::RpcController* controller,
+                                                        const PTabletWriterAddSegmentRequest* request,
+                                                        PTabletWriterAddSegmentResult* response,
+                                                        google::protobuf::Closure* done) {
+    VLOG_RPC << "tablet writer add segment, id=" << request->id() << ", index_id=" << request->index_id()
+             << ", tablet_id=" << request->tablet_id() << ", segment_id=" << request->segment_id();
+    // run in place instead of in _tablet_worker_pool, in which the secondary replicas wait for the segments when
+    // being closed.
+    brpc::ClosureGuard closure_guard(done);
+    auto st = _exec_env->load_channel_mgr()->add_segment(*request);
+    if (!st.ok()) {
+        LOG(WARNING) << "tablet writer add segment failed, message=" << st.get_error_msg()
+                     << ", id=" << print_id(request->id()) << ", index_id=" << request->index_id()
+                     << ", tablet_id=" << request->tablet_id();
+    }
+    st.to_protobuf(response->mutable_status());
+}
+
 template <typename T>
 Status PInternalServiceImpl<T>::_exec_plan_fragment(brpc::Controller* cntl) {
     auto ser_request = cntl->request_attachment().to_string();
@@ -353,6 +370,38 @@ void PInternalServiceImpl<T>::get_info(google::protobuf::RpcController* controll
     Status::OK().to_protobuf(response->mutable_status());
 }
 
+template <typename T>
+void PInternalServiceImpl<T>::fetch_arrow_result(google::protobuf::RpcController* cntl_base,
+                                                 const PFetchArrowResultRequest* request,
+                                                 PFetchArrowResultResult* result, google::protobuf::Closure* done) {
+    // The clients fetch the results of every fragment instance from its backend in parallel, each of which blocks
+    // till the next record batch is converted, like the get_next of the external scan.
+    brpc::ClosureGuard closure_guard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
+    TUniqueId fragment_instance_id;
+    fragment_instance_id.__set_hi(request->finst_id().hi());
+    fragment_instance_id.__set_lo(request->finst_id().lo());
+    std::shared_ptr<arrow::RecordBatch> record_batch;
+    bool eos = false;
+    auto st = _exec_env->result_queue_mgr()->fetch_result(fragment_instance_id, &record_batch, &eos);
+    if (st.ok()) {
+        result->set_eos(eos);
+        if (!eos) {
+            std::string record_batch_str;
+            st = serialize_record_batch(*record_batch, &record_batch_str);
+            if (st.ok()) {
+                result->set_num_rows(record_batch->num_rows());
+                cntl->response_attachment().append(record_batch_str);
+            }
+        }
+    }
+    if (!st.ok()) {
+        LOG(WARNING) << "fetch arrow result failed, fragment_instance_id=" << print_id(fragment_instance_id)
+                     << ", message=" << st.get_error_msg();
+    }
+    st.to_protobuf(result->mutable_status());
+}
+
 template class PInternalServiceImpl<PBackendService>;
 template class PInternalServiceImpl<starrocks::PInternalService>;
 
@@ -43,6 +43,7 @@
 #include "common/status.h"
 #include "runtime/exec_env.h"
 #include "runtime/heartbeat_flags.h"
+#include "runtime/mem_hook.h"
 #include "service/backend_options.h"
 #include "service/backend_service.h"
 #include "service/brpc_service.h"
@@ -145,6 +146,10 @@ int main(int argc, char** argv) {
     }
 #endif
 
+    if (starrocks::config::enable_mem_hook) {
+        starrocks::init_mem_hook();
+    }
+
     std::vector<starrocks::StorePath> paths;
     auto olap_res = starrocks::parse_conf_store_paths(starrocks::config::storage_root_path, &paths);
     if (olap_res != starrocks::OLAP_SUCCESS) {
@@ -0,0 +1,69 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/compaction_scheduler.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "storage/data_dir.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+// The loads of a tablet are rejected once its versions are more than tablet_max_versions, and the compactions of it
+// skip the queue and the IO budget from this fraction of the limit on.
+static constexpr double kUrgentVersionRatio = 0.8;
+// The IO budget unused by a disk is kept for up to this many seconds of compactions.
+static constexpr double kMaxBudgetSeconds = 60;
+
+bool CompactionScheduler::is_urgent(int64_t version_count) {
+    return version_count >= kUrgentVersionRatio * std::max<int64_t>(1, config::tablet_max_versions);
+}
+
+double CompactionScheduler::priority(uint32_t score, int64_t input_bytes, int64_t version_count, double recent_reads) {
+    if (score <= 1) {
+        return 0;
+    }
+    if (is_urgent(version_count)) {
+        // The nearer to the limit the sooner, whatever the cost.
+        return kUrgentPriority + version_count;
+    }
+    // Every sorted run merged away is one less to merge by every read of the tablet, and the cold tablets are still
+    // worth compacting once the hot ones are done.
+    double benefit = static_cast<double>(score - 1) * (1.0 + recent_reads);
+    // At least 1MB, so that the tiny rowsets don't win by the size alone.
+    double cost_mb = std::max(1.0, static_cast<double>(input_bytes) / (1024 * 1024));
+    return benefit / cost_mb;
+}
+
+bool CompactionScheduler::_refill(IOBudget* budget, int64_t now_ms) {
+    int64_t mb_per_sec = config::compaction_io_budget_mb_per_sec_per_disk;
+    if (mb_per_sec <= 0) {
+        return false;
+    }
+    double bytes_per_sec = static_cast<double>(mb_per_sec) * 1024 * 1024;
+    if (budget->refill_ms == 0) {
+        budget->available_bytes = bytes_per_sec;
+    } else if (now_ms > budget->refill_ms) {
+        budget->available_bytes += bytes_per_sec * (now_ms - budget->refill_ms) / 1000;
+    }
+    budget->available_bytes = std::min(budget->available_bytes, bytes_per_sec * kMaxBudgetSeconds);
+    budget->refill_ms = now_ms;
+    return true;
+}
+
+bool CompactionScheduler::has_io_budget(DataDir* data_dir) {
+    std::lock_guard<std::mutex> l(_mutex);
+    IOBudget& budget = _budgets[data_dir->path_hash()];
+    return !_refill(&budget, MonotonicMillis()) || budget.available_bytes > 0;
+}
+
+void CompactionScheduler::consume_io_budget(DataDir* data_dir, int64_t bytes) {
+    std::lock_guard<std::mutex> l(_mutex);
+    IOBudget& budget = _budgets[data_dir->path_hash()];
+    if (_refill(&budget, MonotonicMillis())) {
+        budget.available_bytes -= static_cast<double>(bytes);
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,64 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include "gutil/macros.h"
+
+namespace starrocks {
+
+class DataDir;
+
+// CompactionScheduler decides which base and cumulative compactions are worth their IO.
+//
+// The candidates of all the tablets and data dirs are ranked by the same cost model: the read amplification
+// removed by a compaction, i.e. the number of the sorted runs (the segments of the overlapping rowsets and the
+// non-overlapping rowsets) merged into one, weighted by how often the tablet has been read recently, per MB
+// rewritten. The tablets whose versions are close to tablet_max_versions go first regardless of the cost, since
+// their loads are about to be rejected.
+//
+// The compactions of every data dir are charged to its IO budget of compaction_io_budget_mb_per_sec_per_disk, and
+// once it is used up only the urgent ones run on the disk until it is refilled.
+class CompactionScheduler {
+public:
+    // The priority of the urgent candidates is above kUrgentPriority.
+    static constexpr double kUrgentPriority = 1e12;
+
+    CompactionScheduler() = default;
+
+    // The priority of compacting a tablet with |version_count| versions, whose rowsets to compact have a compaction
+    // score of |score| and |input_bytes| bytes, and which has been read |recent_reads| times recently. 0 if the
+    // compaction removes no read amplification.
+    static double priority(uint32_t score, int64_t input_bytes, int64_t version_count, double recent_reads);
+
+    // Whether a tablet with |version_count| versions must be compacted to keep accepting loads.
+    static bool is_urgent(int64_t version_count);
+
+    // Whether the compactions of |data_dir| haven't used up its IO budget.
+    bool has_io_budget(DataDir* data_dir);
+
+    // Charge |bytes| rewritten by a compaction to the IO budget of |data_dir|.
+    void consume_io_budget(DataDir* data_dir, int64_t bytes);
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(CompactionScheduler);
+
+    struct IOBudget {
+        // The bytes available, negative if the running compactions have overdrawn the budget.
+        double available_bytes = 0;
+        int64_t refill_ms = 0;
+    };
+
+    // Refill |budget| by the bytes per second of the config since the last refill, and return whether the budget is
+    // limited at all.
+    static bool _refill(IOBudget* budget, int64_t now_ms);
+
+    std::mutex _mutex;
+    // Keyed by the path hash of the data dirs.
+    std::unordered_map<int64_t, IOBudget> _budgets;
+};
+
+} // namespace starrocks
@@ -34,8 +34,10 @@
 #include <boost/algorithm/string/trim.hpp>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
 
 #include "env/env.h"
 #include "gen_cpp/version.h"
@@ -50,6 +52,7 @@
 #include "storage/tablet_meta_manager.h"
 #include "storage/utils.h" // for check_dir_existed
 #include "util/errno.h"
+#include "util/blocking_queue.hpp"
 #include "util/file_utils.h"
 #include "util/monotime.h"
 #include "util/string_util.h"
@@ -450,14 +453,17 @@ OLAPStatus DataDir::load() {
     }
 
     // load tablet
-    // create tablet from tablet meta and add it to tablet mgr
+    // create tablet from tablet meta and add it to tablet mgr. The metas are traversed by this thread, and parsed and
+    // loaded by config::load_tablet_meta_threads threads taking them from a bounded queue.
     LOG(INFO) << "begin loading tablet from meta";
     std::set<int64_t> tablet_ids;
     std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](int64_t tablet_id, int32_t schema_hash,
-                                                                    const std::string& value) -> bool {
+    std::mutex tablet_ids_lock;
+    auto load_tablet = [this, &tablet_ids, &failed_tablet_ids, &tablet_ids_lock](int64_t tablet_id, int32_t schema_hash,
+                                                                                 const std::string& value) {
         Status st =
                 _tablet_manager->load_tablet_from_meta(this, tablet_id, schema_hash, value, false, false, false, false);
+        std::lock_guard l(tablet_ids_lock);
         if (!st.ok() && !st.is_not_found()) {
             // load_tablet_from_meta() may return NotFound which means the tablet status is DELETED
             // This may happen when the tablet was just deleted before the BE restarted,
@@ -471,9 +477,32 @@ OLAPStatus DataDir::load() {
         } else {
             tablet_ids.insert(tablet_id);
         }
-        return true;
+    };
+    struct TabletMetaValue {
+        int64_t tablet_id;
+        int32_t schema_hash;
+        std::string value;
+    };
+    const int num_threads = std::max(1, config::load_tablet_meta_threads);
+    BlockingQueue<TabletMetaValue> tablet_metas(num_threads * 16);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&tablet_metas, &load_tablet] {
+            TabletMetaValue meta;
+            while (tablet_metas.blocking_get(&meta)) {
+                load_tablet(meta.tablet_id, meta.schema_hash, meta.value);
+            }
+        });
+    }
+    auto load_tablet_func = [&tablet_metas](int64_t tablet_id, int32_t schema_hash, const std::string& value) -> bool {
+        return tablet_metas.blocking_put(TabletMetaValue{tablet_id, schema_hash, value});
     };
     Status load_tablet_status = TabletMetaManager::traverse_headers(_meta, load_tablet_func);
+    tablet_metas.shutdown();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    threads.clear();
     if (failed_tablet_ids.size() != 0) {
         LOG(ERROR) << "load tablets from header failed"
                    << ", loaded tablet: " << tablet_ids.size() << ", error tablet: " << failed_tablet_ids.size()
@@ -496,7 +525,9 @@ OLAPStatus DataDir::load() {
     // 1. add committed rowset to txn map
     // 2. add visible rowset to tablet
     // ignore any errors when load tablet or rowset, because fe will repair them after report
-    for (const auto& rowset_meta : dir_rowset_metas) {
+    // The rowsets are loaded by config::load_tablet_meta_threads threads, each of which loads the rowsets of the
+    // tablets whose ids are of its remainder, so that the rowsets of a tablet are still added in order.
+    auto load_rowset = [this](const RowsetMetaSharedPtr& rowset_meta) {
         TabletSharedPtr tablet =
                 _tablet_manager->get_tablet(rowset_meta->tablet_id(), rowset_meta->tablet_schema_hash());
         // tablet maybe dropped, but not drop related rowset meta
@@ -504,7 +535,7 @@ OLAPStatus DataDir::load() {
             // LOG(WARNING) << "could not find tablet id: " << rowset_meta->tablet_id()
             //              << ", schema hash: " << rowset_meta->tablet_schema_hash()
             //              << ", for rowset: " << rowset_meta->rowset_id() << ", skip this rowset";
-            continue;
+            return;
         }
         RowsetSharedPtr rowset;
         OLAPStatus create_status =
@@ -514,7 +545,7 @@ OLAPStatus DataDir::load() {
             LOG(WARNING) << "Fail to create rowset from rowsetmeta,"
                          << " rowset=" << rowset_meta->rowset_id() << " type=" << rowset_meta->rowset_type()
                          << " state=" << rowset_meta->rowset_state();
-            continue;
+            return;
         }
         if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED &&
             rowset_meta->tablet_uid() == tablet->tablet_uid()) {
@@ -544,6 +575,18 @@ OLAPStatus DataDir::load() {
                          << " schema hash=" << rowset_meta->tablet_schema_hash() << " txn=" << rowset_meta->txn_id()
                          << " current valid tablet uid=" << tablet->tablet_uid();
         }
+    };
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&dir_rowset_metas, &load_rowset, num_threads, i] {
+            for (const auto& rowset_meta : dir_rowset_metas) {
+                if (rowset_meta->tablet_id() % num_threads == i) {
+                    load_rowset(rowset_meta);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
     }
     return OLAP_SUCCESS;
 }
@@ -28,6 +28,7 @@ void DelVector::_add_dels(const std::vector<uint32_t>& dels) {
     } else {
         _roaring->addMany(dels.size(), dels.data());
     }
+    _compress();
     _update_stats();
 }
 
@@ -67,6 +68,7 @@ void DelVector::init(int64_t version, const uint32_t* data, size_t length) {
     _version = version;
     if (length > 0) {
         _roaring = std::make_unique<Roaring>(length, data);
+        _compress();
     }
     _update_stats();
 }
@@ -86,6 +88,13 @@ string DelVector::to_string() const {
     return strings::Substitute("version:$0 $1", _version, _roaring ? _roaring->toString() : string("null"));
 }
 
+void DelVector::_compress() {
+    // the deleted rows are mostly in runs, e.g. the rows of a file or of a range of keys deleted, and the run
+    // containers of them are far smaller in the cache and the meta
+    _roaring->runOptimize();
+    _roaring->shrinkToFit();
+}
+
 void DelVector::_update_stats() {
     // TODO(cbl): optimization
     if (_roaring) {
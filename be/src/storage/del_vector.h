@@ -48,6 +48,9 @@ public:
 private:
     void _add_dels(const std::vector<uint32_t>& dels);
 
+    // Convert the containers of runs of rows into run containers.
+    void _compress();
+
     void _update_stats();
 
     bool _loaded = false;
@@ -165,6 +165,9 @@ public:
     // If an error was encountered, returns a non-OK status.
     virtual Status readv(uint64_t offset, const Slice* res, size_t res_cnt) const = 0;
 
+    // Hints that 'length' bytes beginning from 'offset' in the block will be read soon.
+    virtual Status prefetch(uint64_t offset, size_t length) const = 0;
+
     // Returns the memory usage of this object including the object itself.
     // virtual size_t memory_footprint() const = 0;
 };
@@ -270,6 +270,8 @@ public:
 
     virtual Status readv(uint64_t offset, const Slice* results, size_t res_cnt) const override;
 
+    virtual Status prefetch(uint64_t offset, size_t length) const override;
+
     void handle_error(const Status& s) const;
 
 private:
@@ -357,6 +359,11 @@ Status FileReadableBlock::readv(uint64_t offset, const Slice* results, size_t re
     return Status::OK();
 }
 
+Status FileReadableBlock::prefetch(uint64_t offset, size_t length) const {
+    DCHECK(!_closed.load());
+    return _file->prefetch(offset, length);
+}
+
 } // namespace internal
 
 ////////////////////////////////////////////////////////////
@@ -71,8 +71,70 @@ void HyperLogLog::_convert_explicit_to_register() {
     phmap::flat_hash_set<uint64_t>().swap(_hash_set);
 }
 
-// Change HLL_DATA_EXPLICIT to HLL_DATA_FULL directly, because HLL_DATA_SPRASE
-// is implemented in the same way in memory with HLL_DATA_FULL.
+// Convert sparse registers to register format, and clear sparse registers.
+// NOTE: this function won't modify _type.
+void HyperLogLog::_convert_sparse_to_register() {
+    DCHECK(_type == HLL_DATA_SPRASE) << "_type(" << _type << ") should be sparse(" << HLL_DATA_SPRASE << ")";
+    DCHECK_EQ(_registers.data, nullptr);
+    ChunkAllocator::instance()->allocate(HLL_REGISTERS_COUNT, &_registers);
+    DCHECK_NE(_registers.data, nullptr);
+    DCHECK_EQ(_registers.size, HLL_REGISTERS_COUNT);
+    memset(_registers.data, 0, HLL_REGISTERS_COUNT);
+
+    for (auto [idx, value] : _sparse_registers) {
+        _registers.data[idx] = value;
+    }
+    std::vector<SparseRegister>().swap(_sparse_registers);
+}
+
+std::vector<HyperLogLog::SparseRegister> HyperLogLog::_explicit_to_sparse_registers(
+        const phmap::flat_hash_set<uint64_t>& hash_set) {
+    std::vector<SparseRegister> registers;
+    registers.reserve(hash_set.size());
+    for (auto hash_value : hash_set) {
+        registers.push_back(_to_sparse_register(hash_value));
+    }
+    _sort_sparse_registers(&registers);
+    return registers;
+}
+
+void HyperLogLog::_sort_sparse_registers(std::vector<SparseRegister>* registers) {
+    // Keep the max value of every index, which is sorted to the last.
+    std::sort(registers->begin(), registers->end());
+    auto last = std::unique(registers->rbegin(), registers->rend(),
+                            [](const SparseRegister& a, const SparseRegister& b) { return a.first == b.first; });
+    registers->erase(registers->begin(), last.base());
+}
+
+void HyperLogLog::_merge_sparse_registers(const std::vector<SparseRegister>& other_registers) {
+    DCHECK(_type == HLL_DATA_SPRASE);
+    std::vector<SparseRegister> registers;
+    registers.reserve(_sparse_registers.size() + other_registers.size());
+    auto it = _sparse_registers.begin();
+    auto other_it = other_registers.begin();
+    while (it != _sparse_registers.end() && other_it != other_registers.end()) {
+        if (it->first < other_it->first) {
+            registers.push_back(*it++);
+        } else if (other_it->first < it->first) {
+            registers.push_back(*other_it++);
+        } else {
+            registers.emplace_back(it->first, std::max(it->second, other_it->second));
+            ++it;
+            ++other_it;
+        }
+    }
+    registers.insert(registers.end(), it, _sparse_registers.end());
+    registers.insert(registers.end(), other_it, other_registers.end());
+    _sparse_registers.swap(registers);
+
+    if (_sparse_registers.size() > HLL_SPARSE_THRESHOLD) {
+        _convert_sparse_to_register();
+        _type = HLL_DATA_FULL;
+    }
+}
+
+// Change HLL_DATA_EXPLICIT to HLL_DATA_FULL directly, because the updated values
+// are likely to grow out of HLL_DATA_SPRASE.
 void HyperLogLog::update(uint64_t hash_value) {
     switch (_type) {
     case HLL_DATA_EMPTY:
@@ -86,14 +148,29 @@ void HyperLogLog::update(uint64_t hash_value) {
         }
         _convert_explicit_to_register();
         _type = HLL_DATA_FULL;
-        // fall through
+        _update_registers(hash_value);
+        break;
     case HLL_DATA_SPRASE:
+        _convert_sparse_to_register();
+        _type = HLL_DATA_FULL;
+        _update_registers(hash_value);
+        break;
     case HLL_DATA_FULL:
         _update_registers(hash_value);
         break;
     }
 }
 
+void HyperLogLog::update_batch(const uint64_t* hash_values, size_t size) {
+    size_t i = 0;
+    for (; i < size && _type != HLL_DATA_FULL; i++) {
+        update(hash_values[i]);
+    }
+    for (; i < size; i++) {
+        _update_registers(hash_values[i]);
+    }
+}
+
 void HyperLogLog::merge(const HyperLogLog& other) {
     // fast path
     if (other._type == HLL_DATA_EMPTY) {
@@ -108,6 +185,8 @@ void HyperLogLog::merge(const HyperLogLog& other) {
             _hash_set = other._hash_set;
             break;
         case HLL_DATA_SPRASE:
+            _sparse_registers = other._sparse_registers;
+            break;
         case HLL_DATA_FULL:
             DCHECK_EQ(_registers.data, nullptr);
             ChunkAllocator::instance()->allocate(HLL_REGISTERS_COUNT, &_registers);
@@ -132,6 +211,11 @@ void HyperLogLog::merge(const HyperLogLog& other) {
             }
             break;
         case HLL_DATA_SPRASE:
+            _sparse_registers = _explicit_to_sparse_registers(_hash_set);
+            phmap::flat_hash_set<uint64_t>().swap(_hash_set);
+            _type = HLL_DATA_SPRASE;
+            _merge_sparse_registers(other._sparse_registers);
+            break;
         case HLL_DATA_FULL:
             _convert_explicit_to_register();
             _merge_registers(other._registers.data);
@@ -142,7 +226,24 @@ void HyperLogLog::merge(const HyperLogLog& other) {
         }
         break;
     }
-    case HLL_DATA_SPRASE:
+    case HLL_DATA_SPRASE: {
+        switch (other._type) {
+        case HLL_DATA_EXPLICIT:
+            _merge_sparse_registers(_explicit_to_sparse_registers(other._hash_set));
+            break;
+        case HLL_DATA_SPRASE:
+            _merge_sparse_registers(other._sparse_registers);
+            break;
+        case HLL_DATA_FULL:
+            _convert_sparse_to_register();
+            _merge_registers(other._registers.data);
+            _type = HLL_DATA_FULL;
+            break;
+        default:
+            break;
+        }
+        break;
+    }
     case HLL_DATA_FULL: {
         switch (other._type) {
         case HLL_DATA_EXPLICIT:
@@ -151,6 +252,10 @@ void HyperLogLog::merge(const HyperLogLog& other) {
             }
             break;
         case HLL_DATA_SPRASE:
+            for (auto [idx, value] : other._sparse_registers) {
+                _registers.data[idx] = std::max(_registers.data[idx], value);
+            }
+            break;
         case HLL_DATA_FULL:
             _merge_registers(other._registers.data);
             break;
@@ -170,6 +275,7 @@ size_t HyperLogLog::max_serialized_size() const {
     case HLL_DATA_EXPLICIT:
         return 2 + _hash_set.size() * 8;
     case HLL_DATA_SPRASE:
+        return 1 + 4 + _sparse_registers.size() * 3;
     case HLL_DATA_FULL:
         return 1 + HLL_REGISTERS_COUNT;
     }
@@ -197,7 +303,17 @@ size_t HyperLogLog::serialize(uint8_t* dst) const {
         }
         break;
     }
-    case HLL_DATA_SPRASE:
+    case HLL_DATA_SPRASE: {
+        *ptr++ = HLL_DATA_SPRASE;
+        encode_fixed32_le(ptr, _sparse_registers.size());
+        ptr += 4;
+        for (auto [idx, value] : _sparse_registers) {
+            encode_fixed16_le(ptr, idx);
+            ptr += 2;
+            *ptr++ = value;
+        }
+        break;
+    }
     case HLL_DATA_FULL: {
         uint32_t num_non_zero_registers = 0;
         for (int i = 0; i < HLL_REGISTERS_COUNT; i++) {
@@ -308,21 +424,26 @@ bool HyperLogLog::deserialize(const Slice& slice) {
         break;
     }
     case HLL_DATA_SPRASE: {
-        DCHECK_EQ(_registers.data, nullptr);
-        ChunkAllocator::instance()->allocate(HLL_REGISTERS_COUNT, &_registers);
-        DCHECK_NE(_registers.data, nullptr);
-        DCHECK_EQ(_registers.size, HLL_REGISTERS_COUNT);
-        memset(_registers.data, 0, HLL_REGISTERS_COUNT);
-
         // 2-5(4 byte): number of registers
         uint32_t num_registers = decode_fixed32_le(ptr);
         ptr += 4;
+        _sparse_registers.resize(num_registers);
         for (uint32_t i = 0; i < num_registers; ++i) {
             // 2 bytes: register index
             // 1 byte: register value
-            uint16_t register_idx = decode_fixed16_le(ptr);
+            _sparse_registers[i].first = decode_fixed16_le(ptr) % HLL_REGISTERS_COUNT;
             ptr += 2;
-            _registers.data[register_idx] = *ptr++;
+            _sparse_registers[i].second = *ptr++;
+        }
+        // The registers are serialized in order of index, sort them in case they are not.
+        if (std::adjacent_find(_sparse_registers.begin(), _sparse_registers.end(),
+                               [](const SparseRegister& a, const SparseRegister& b) { return a.first >= b.first; }) !=
+            _sparse_registers.end()) {
+            _sort_sparse_registers(&_sparse_registers);
+        }
+        if (_sparse_registers.size() > HLL_SPARSE_THRESHOLD) {
+            _convert_sparse_to_register();
+            _type = HLL_DATA_FULL;
         }
         break;
     }
@@ -365,14 +486,25 @@ int64_t HyperLogLog::estimate_cardinality() const {
         alpha = 0.7213f / (1 + 1.079f / num_streams);
     }
 
-    float harmonic_mean = 0;
-    int num_zero_registers = 0;
-
-    for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
-        harmonic_mean += powf(2.0f, -_registers.data[i]);
+    // Count the registers of every value first, which is cheaper than powf() for every register,
+    // and gives the same estimate for the sparse and the full registers.
+    int value_counts[256] = {0};
+    if (_type == HLL_DATA_SPRASE) {
+        value_counts[0] = HLL_REGISTERS_COUNT - _sparse_registers.size();
+        for (const auto& reg : _sparse_registers) {
+            ++value_counts[reg.second];
+        }
+    } else {
+        for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
+            ++value_counts[_registers.data[i]];
+        }
+    }
 
-        if (_registers.data[i] == 0) {
-            ++num_zero_registers;
+    float harmonic_mean = 0;
+    int num_zero_registers = value_counts[0];
+    for (int value = 0; value < 256; ++value) {
+        if (value_counts[value] != 0) {
+            harmonic_mean += value_counts[value] * powf(2.0f, -value);
         }
     }
 
@@ -27,6 +27,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "common/compiler_util.h"
@@ -71,7 +72,10 @@ const static int HLL_EMPTY_SIZE = 1;
 //
 // HLL_DATA_SPRASE: only store non-zero registers. If the number of non-zero registers
 // is not greater than 4096, set is encoded in this format. The max space occupied is
-// (1 + 4 + 3 * 4096) = 12293.
+// (1 + 4 + 3 * 4096) = 12293. In memory, the non-zero registers are kept as the
+// (index, value) pairs sorted by index, so that the sparse values, e.g. the pre-aggregated
+// HLL columns, are merged without expanding them to the full registers, till the number
+// of the non-zero registers exceeds 4096.
 //
 // HLL_DATA_FULL: most space-consuming, store all registers
 //
@@ -91,7 +95,8 @@ class HyperLogLog {
 public:
     HyperLogLog() = default;
 
-    HyperLogLog(const HyperLogLog& other) : _type(other._type), _hash_set(other._hash_set) {
+    HyperLogLog(const HyperLogLog& other)
+            : _type(other._type), _hash_set(other._hash_set), _sparse_registers(other._sparse_registers) {
         if (_registers.data != nullptr) {
             ChunkAllocator::instance()->free(_registers);
             _registers.data = nullptr;
@@ -109,6 +114,7 @@ public:
         if (this != &other) {
             this->_type = other._type;
             this->_hash_set = other._hash_set;
+            this->_sparse_registers = other._sparse_registers;
 
             if (_registers.data != nullptr) {
                 ChunkAllocator::instance()->free(_registers);
@@ -125,7 +131,10 @@ public:
         return *this;
     }
 
-    HyperLogLog(HyperLogLog&& other) : _type(other._type), _hash_set(std::move(other._hash_set)) {
+    HyperLogLog(HyperLogLog&& other)
+            : _type(other._type),
+              _hash_set(std::move(other._hash_set)),
+              _sparse_registers(std::move(other._sparse_registers)) {
         if (_registers.data != nullptr) {
             ChunkAllocator::instance()->free(_registers);
         }
@@ -139,6 +148,7 @@ public:
         if (this != &other) {
             this->_type = other._type;
             this->_hash_set = std::move(other._hash_set);
+            this->_sparse_registers = std::move(other._sparse_registers);
 
             if (_registers.data != nullptr) {
                 ChunkAllocator::instance()->free(_registers);
@@ -161,11 +171,16 @@ public:
     typedef int32_t SparseLengthValueType;
     typedef uint16_t SparseIndexType;
     typedef uint8_t SparseValueType;
+    typedef std::pair<SparseIndexType, SparseValueType> SparseRegister;
 
     // Add a hash value to this HLL value
     // NOTE: input must be a hash_value
     void update(uint64_t hash_value);
 
+    // Add the hash values of a column, which saves the dispatch by the type once
+    // the registers are full.
+    void update_batch(const uint64_t* hash_values, size_t size);
+
     void merge(const HyperLogLog& other);
 
     // Return max size of serialized binary
@@ -204,12 +219,16 @@ public:
     void clear() {
         _type = HLL_DATA_EMPTY;
         _hash_set.clear();
+        _sparse_registers.clear();
     }
 
 private:
     HllDataType _type = HLL_DATA_EMPTY;
     phmap::flat_hash_set<uint64_t> _hash_set;
 
+    // The non-zero registers of HLL_DATA_SPRASE, sorted by index.
+    std::vector<SparseRegister> _sparse_registers;
+
     // This field is much space consumming(HLL_REGISTERS_COUNT), we craete
     // it only when it is really needed.
     // Allocate memory by ChunkAllocator in order to reuse memory.
@@ -218,18 +237,36 @@ private:
 private:
     void _convert_explicit_to_register();
 
+    void _convert_sparse_to_register();
+
     // absorb other registers into this registers
     void _merge_registers(uint8_t* other_registers);
 
-    // update one hash value into this registers
-    void _update_registers(uint64_t hash_value) {
+    // absorb other sparse registers, sorted by index, into this sparse registers, which
+    // are converted to the full registers if there are too many.
+    void _merge_sparse_registers(const std::vector<SparseRegister>& other_registers);
+
+    // Sort the sparse registers by index, and keep the max value of the duplicate indexes.
+    static void _sort_sparse_registers(std::vector<SparseRegister>* registers);
+
+    // The sparse registers of the explicit hash values, sorted by index.
+    static std::vector<SparseRegister> _explicit_to_sparse_registers(const phmap::flat_hash_set<uint64_t>& hash_set);
+
+    // The register of one hash value
+    static SparseRegister _to_sparse_register(uint64_t hash_value) {
         // Use the lower bits to index into the number of streams and then
         // find the first 1 bit after the index bits.
-        int idx = hash_value % HLL_REGISTERS_COUNT;
+        SparseIndexType idx = hash_value % HLL_REGISTERS_COUNT;
         hash_value >>= HLL_COLUMN_PRECISION;
         // make sure max first_one_bit is HLL_ZERO_COUNT_BITS + 1
         hash_value |= ((uint64_t)1 << HLL_ZERO_COUNT_BITS);
-        uint8_t first_one_bit = __builtin_ctzl(hash_value) + 1;
+        SparseValueType first_one_bit = __builtin_ctzl(hash_value) + 1;
+        return {idx, first_one_bit};
+    }
+
+    // update one hash value into this registers
+    void _update_registers(uint64_t hash_value) {
+        auto [idx, first_one_bit] = _to_sparse_register(hash_value);
         _registers.data[idx] = std::max((uint8_t)_registers.data[idx], first_one_bit);
     }
 };
@@ -8,9 +8,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <algorithm>
 #include <sstream>
 #include <string>
+#include <thread>
 
+#include "common/config.h"
 #include "storage/olap_common.h"
 #include "storage/olap_define.h"
 #include "storage/row_block.h"
@@ -154,10 +157,13 @@ bool HandleTable::_resize() {
     return true;
 }
 
-LRUCache::LRUCache() : _usage(0), _last_id(0), _lookup_count(0), _hit_count(0) {
+LRUCache::LRUCache()
+        : _usage(0), _last_id(0), _protected_usage(0), _lookup_count(0), _hit_count(0), _evict_count(0) {
     // Make empty circular linked list
     _lru.next = &_lru;
     _lru.prev = &_lru;
+    _protected_lru.next = &_protected_lru;
+    _protected_lru.prev = &_protected_lru;
 }
 
 LRUCache::~LRUCache() {
@@ -195,6 +201,11 @@ Cache::Handle* LRUCache::lookup(const CacheKey& key, uint32_t hash) {
             // only in LRU free list, remove it from list
             _lru_remove(e);
         }
+        if (_policy == CacheEvictionPolicy::SLRU && !e->in_protected) {
+            // Moved into the protected list once released.
+            e->in_protected = true;
+            _protected_usage += e->charge;
+        }
         e->refs++;
         ++_hit_count;
     }
@@ -217,10 +228,13 @@ void LRUCache::release(Cache::Handle* handle) {
             if (_usage > _capacity) {
                 // take this opportunity and remove the item
                 _table.remove(e->key(), e->hash);
-                e->in_cache = false;
+                _leave_cache(e);
                 _unref(e);
                 _usage -= e->charge;
                 last_ref = true;
+            } else if (e->in_protected) {
+                _lru_append(&_protected_lru, e);
+                _demote_protected();
             } else {
                 // put it to LRU free list
                 _lru_append(&_lru, e);
@@ -235,23 +249,22 @@ void LRUCache::release(Cache::Handle* handle) {
 }
 
 void LRUCache::_evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted) {
-    LRUHandle* cur = &_lru;
-    // 1. evict normal cache entries
-    while (_usage + charge > _capacity && cur->next != &_lru) {
-        LRUHandle* old = cur->next;
-        if (old->priority == CachePriority::DURABLE) {
-            cur = cur->next;
-            continue;
+    // 1. evict normal cache entries, 2. evict durable cache entries if need, the probationary ones before the protected
+    // ones each time.
+    for (bool evict_durable : {false, true}) {
+        for (LRUHandle* list : {&_lru, &_protected_lru}) {
+            LRUHandle* cur = list;
+            while (_usage + charge > _capacity && cur->next != list) {
+                LRUHandle* old = cur->next;
+                if (!evict_durable && old->priority == CachePriority::DURABLE) {
+                    cur = cur->next;
+                    continue;
+                }
+                _evict_one_entry(old);
+                deleted->push_back(old);
+                ++_evict_count;
+            }
         }
-        _evict_one_entry(old);
-        deleted->push_back(old);
-    }
-    // 2. evict durable cache entries if need
-    while (_usage + charge > _capacity && _lru.next != &_lru) {
-        LRUHandle* old = _lru.next;
-        DCHECK(old->priority == CachePriority::DURABLE);
-        _evict_one_entry(old);
-        deleted->push_back(old);
     }
 }
 
@@ -260,11 +273,31 @@ void LRUCache::_evict_one_entry(LRUHandle* e) {
     DCHECK(e->refs == 1); // LRU list contains elements which may be evicted
     _lru_remove(e);
     _table.remove(e->key(), e->hash);
-    e->in_cache = false;
+    _leave_cache(e);
     _unref(e);
     _usage -= e->charge;
 }
 
+void LRUCache::_leave_cache(LRUHandle* e) {
+    e->in_cache = false;
+    if (e->in_protected) {
+        e->in_protected = false;
+        _protected_usage -= e->charge;
+    }
+}
+
+// Move the oldest protected entries back to the probationary list, as the newest ones there, until the protected
+// segment is within its share of the capacity.
+void LRUCache::_demote_protected() {
+    while (_protected_usage * 100 > _capacity * kSlruProtectedPercent && _protected_lru.next != &_protected_lru) {
+        LRUHandle* e = _protected_lru.next;
+        _lru_remove(e);
+        e->in_protected = false;
+        _protected_usage -= e->charge;
+        _lru_append(&_lru, e);
+    }
+}
+
 Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
                                 void (*deleter)(const CacheKey& key, void* value), CachePriority priority) {
     LRUHandle* e = reinterpret_cast<LRUHandle*>(malloc(sizeof(LRUHandle) - 1 + key.size()));
@@ -277,6 +310,7 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
     e->next = e->prev = nullptr;
     e->in_cache = true;
     e->priority = priority;
+    e->in_protected = false;
     memcpy(e->key_data, key.data(), key.size());
     std::vector<LRUHandle*> last_ref_list;
     {
@@ -292,7 +326,7 @@ Cache::Handle* LRUCache::insert(const CacheKey& key, uint32_t hash, void* value,
         auto old = _table.insert(e);
         _usage += charge;
         if (old != nullptr) {
-            old->in_cache = false;
+            _leave_cache(old);
             if (_unref(old)) {
                 _usage -= old->charge;
                 // old is on LRU because it's in cache and its reference count
@@ -327,7 +361,7 @@ void LRUCache::erase(const CacheKey& key, uint32_t hash) {
                     _lru_remove(e);
                 }
             }
-            e->in_cache = false;
+            _leave_cache(e);
         }
     }
     // free handle out of mutex, when last_ref is true, e must not be nullptr
@@ -340,16 +374,12 @@ int LRUCache::prune() {
     std::vector<LRUHandle*> last_ref_list;
     {
         std::lock_guard l(_mutex);
-        while (_lru.next != &_lru) {
-            LRUHandle* old = _lru.next;
-            DCHECK(old->in_cache);
-            DCHECK(old->refs == 1); // LRU list contains elements which may be evicted
-            _lru_remove(old);
-            _table.remove(old->key(), old->hash);
-            old->in_cache = false;
-            _unref(old);
-            _usage -= old->charge;
-            last_ref_list.push_back(old);
+        for (LRUHandle* list : {&_lru, &_protected_lru}) {
+            while (list->next != list) {
+                LRUHandle* old = list->next;
+                _evict_one_entry(old);
+                last_ref_list.push_back(old);
+            }
         }
     }
     for (auto entry : last_ref_list) {
@@ -362,15 +392,18 @@ inline uint32_t ShardedLRUCache::_hash_slice(const CacheKey& s) {
     return s.hash(s.data(), s.size(), 0);
 }
 
-uint32_t ShardedLRUCache::_shard(uint32_t hash) {
-    return hash >> (32 - kNumShardBits);
-}
-
-ShardedLRUCache::ShardedLRUCache(size_t capacity) : _last_id(0) {
-    const size_t per_shard = (capacity + (kNumShards - 1)) / kNumShards;
+ShardedLRUCache::ShardedLRUCache(size_t capacity, CacheEvictionPolicy policy, int num_shards) : _last_id(0) {
+    _num_shard_bits = 1;
+    while ((1 << _num_shard_bits) < std::min(num_shards, kMaxNumShards)) {
+        _num_shard_bits++;
+    }
+    _num_shards = 1 << _num_shard_bits;
+    _shards.reset(new LRUCache[_num_shards]);
+    const size_t per_shard = (capacity + (_num_shards - 1)) / _num_shards;
 
-    for (int s = 0; s < kNumShards; s++) {
+    for (int s = 0; s < _num_shards; s++) {
         _shards[s].set_capacity(per_shard);
+        _shards[s].set_eviction_policy(policy);
     }
 }
 
@@ -411,7 +444,7 @@ uint64_t ShardedLRUCache::new_id() {
 
 void ShardedLRUCache::prune() {
     int num_prune = 0;
-    for (int s = 0; s < kNumShards; s++) {
+    for (int s = 0; s < _num_shards; s++) {
         num_prune += _shards[s].prune();
     }
     VLOG(7) << "Successfully prune cache, clean " << num_prune << " entries.";
@@ -419,16 +452,22 @@ void ShardedLRUCache::prune() {
 
 size_t ShardedLRUCache::get_memory_usage() {
     size_t total_usage = 0;
-    for (int s = 0; s < kNumShards; s++) {
+    for (int s = 0; s < _num_shards; s++) {
         total_usage += _shards[s].get_usage();
     }
     return total_usage;
 }
 
-void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
-    size_t shard_count = sizeof(_shards) / sizeof(LRUCache);
+uint64_t ShardedLRUCache::get_evict_count() {
+    uint64_t evict_count = 0;
+    for (int s = 0; s < _num_shards; s++) {
+        evict_count += _shards[s].get_evict_count();
+    }
+    return evict_count;
+}
 
-    for (uint32_t i = 0; i < shard_count; ++i) {
+void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
+    for (int i = 0; i < _num_shards; ++i) {
         size_t capacity = _shards[i].get_capacity();
         size_t usage = _shards[i].get_usage();
         rapidjson::Value shard_info(rapidjson::kObjectType);
@@ -442,11 +481,15 @@ void ShardedLRUCache::get_cache_status(rapidjson::Document* document) {
         }
 
         shard_info.AddMember("usage_ratio", usage_ratio, document->GetAllocator());
+        shard_info.AddMember("protected_usage", static_cast<double>(_shards[i].get_protected_usage()),
+                             document->GetAllocator());
 
         size_t lookup_count = _shards[i].get_lookup_count();
         size_t hit_count = _shards[i].get_hit_count();
         shard_info.AddMember("lookup_count", static_cast<double>(lookup_count), document->GetAllocator());
         shard_info.AddMember("hit_count", static_cast<double>(hit_count), document->GetAllocator());
+        shard_info.AddMember("evict_count", static_cast<double>(_shards[i].get_evict_count()),
+                             document->GetAllocator());
 
         float hit_ratio = 0.0f;
 
@@ -463,4 +506,21 @@ Cache* new_lru_cache(size_t capacity) {
     return new ShardedLRUCache(capacity);
 }
 
+Cache* new_lru_cache(size_t capacity, CacheEvictionPolicy policy, int num_shards) {
+    return new ShardedLRUCache(capacity, policy, num_shards);
+}
+
+int cache_num_shards_by_cores(size_t capacity) {
+    const int max_num_shards = std::min<int>(2 * std::thread::hardware_concurrency(), kMaxNumShards);
+    int num_shards = kNumShards;
+    while (num_shards * 2 <= max_num_shards && capacity / (num_shards * 2) >= kMinShardCapacity) {
+        num_shards *= 2;
+    }
+    return num_shards;
+}
+
+CacheEvictionPolicy storage_cache_eviction_policy() {
+    return config::storage_cache_scan_resistant ? CacheEvictionPolicy::SLRU : CacheEvictionPolicy::LRU;
+}
+
 } // namespace starrocks
@@ -9,11 +9,13 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include "storage/olap_common.h"
+#include "util/lock_profiler.h"
 #include "util/slice.h"
 
 namespace starrocks {
@@ -45,9 +47,31 @@ namespace starrocks {
 class Cache;
 class CacheKey;
 
+enum class CacheEvictionPolicy {
+    // Least-recently-used.
+    LRU = 0,
+    // Segmented LRU: an entry is inserted into the probationary segment, and moved into the protected segment, of up to
+    // kSlruProtectedPercent of the capacity, once it is hit. The probationary entries are evicted first, so the
+    // entries read only once, e.g. by a large scan, don't evict those read again and again.
+    SLRU = 1,
+};
+
+static const int kNumShardBits = 4;
+static const int kNumShards = 1 << kNumShardBits;
+
 // Create a new cache with a fixed size capacity.  This implementation
 // of Cache uses a least-recently-used eviction policy.
 extern Cache* new_lru_cache(size_t capacity);
+// |num_shards| is rounded up to a power of two.
+extern Cache* new_lru_cache(size_t capacity, CacheEvictionPolicy policy, int num_shards = kNumShards);
+
+// The number of shards of a cache of |capacity| bytes: kNumShards, or up to twice the number of cores as long as each
+// shard still gets kMinShardCapacity bytes, so that the threads of a many-core machine hardly contend on the shards.
+extern int cache_num_shards_by_cores(size_t capacity);
+
+// The eviction policy of the caches of the storage data, e.g. the pages and the footers of the segments, see
+// config::storage_cache_scan_resistant.
+extern CacheEvictionPolicy storage_cache_eviction_policy();
 
 class CacheKey {
 public:
@@ -199,6 +223,8 @@ public:
     virtual void prune() {}
 
     virtual size_t get_memory_usage() = 0;
+    // The number of the entries evicted to make room for the new ones, not counting the erased, replaced or pruned.
+    virtual uint64_t get_evict_count() = 0;
     virtual void get_cache_status(rapidjson::Document* document) = 0;
 
 private:
@@ -219,7 +245,8 @@ typedef struct LRUHandle {
     uint32_t refs;
     uint32_t hash; // Hash of key(); used for fast sharding and comparisons
     CachePriority priority = CachePriority::NORMAL;
-    char key_data[1]; // Beginning of key
+    bool in_protected; // Whether entry is in the protected segment of a SLRU cache.
+    char key_data[1];  // Beginning of key
 
     CacheKey key() const {
         // For cheaper lookups, we allow a temporary Handle object
@@ -278,6 +305,7 @@ public:
 
     // Separate from constructor so caller can easily make an array of LRUCache
     void set_capacity(size_t capacity) { _capacity = capacity; }
+    void set_eviction_policy(CacheEvictionPolicy policy) { _policy = policy; }
 
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
@@ -290,7 +318,9 @@ public:
 
     uint64_t get_lookup_count() const { return _lookup_count; }
     uint64_t get_hit_count() const { return _hit_count; }
+    uint64_t get_evict_count() const { return _evict_count; }
     size_t get_usage() const { return _usage; }
+    size_t get_protected_usage() const { return _protected_usage; }
     size_t get_capacity() const { return _capacity; }
 
 private:
@@ -299,12 +329,15 @@ private:
     bool _unref(LRUHandle* e);
     void _evict_from_lru(size_t charge, std::vector<LRUHandle*>* deleted);
     void _evict_one_entry(LRUHandle* e);
+    void _leave_cache(LRUHandle* e);
+    void _demote_protected();
 
     // Initialized before use.
     size_t _capacity;
+    CacheEvictionPolicy _policy = CacheEvictionPolicy::LRU;
 
     // _mutex protects the following state.
-    std::mutex _mutex;
+    ProfiledMutex _mutex{LockSite::get("lru_cache_shard")};
     size_t _usage;
     uint64_t _last_id;
 
@@ -312,19 +345,27 @@ private:
     // lru.prev is newest entry, lru.next is oldest entry.
     // Entries have refs==1 and in_cache==true.
     LRUHandle _lru;
+    // Dummy head of the LRU list of the protected segment of a SLRU cache, the entries of |_lru| are then the
+    // probationary ones.
+    LRUHandle _protected_lru;
+    // The charges of the entries in the protected segment, whether pinned or not.
+    size_t _protected_usage;
 
     HandleTable _table;
 
     uint64_t _lookup_count;
     uint64_t _hit_count;
+    uint64_t _evict_count;
 };
 
-static const int kNumShardBits = 4;
-static const int kNumShards = 1 << kNumShardBits;
+static const int kMaxNumShards = 256;
+static const size_t kMinShardCapacity = 8 * 1024 * 1024;
+static const int kSlruProtectedPercent = 80;
 
 class ShardedLRUCache : public Cache {
 public:
-    explicit ShardedLRUCache(size_t capacity);
+    explicit ShardedLRUCache(size_t capacity, CacheEvictionPolicy policy = CacheEvictionPolicy::LRU,
+                             int num_shards = kNumShards);
     virtual ~ShardedLRUCache() {}
     virtual Handle* insert(const CacheKey& key, void* value, size_t charge,
                            void (*deleter)(const CacheKey& key, void* value),
@@ -337,13 +378,16 @@ public:
     virtual uint64_t new_id();
     virtual void prune();
     virtual size_t get_memory_usage();
+    uint64_t get_evict_count() override;
     virtual void get_cache_status(rapidjson::Document* document);
 
 private:
     static inline uint32_t _hash_slice(const CacheKey& s);
-    static uint32_t _shard(uint32_t hash);
+    uint32_t _shard(uint32_t hash) const { return hash >> (32 - _num_shard_bits); }
 
-    LRUCache _shards[kNumShards];
+    int _num_shard_bits;
+    int _num_shards;
+    std::unique_ptr<LRUCache[]> _shards;
     std::mutex _id_mutex;
     uint64_t _last_id;
 };
@@ -24,6 +24,7 @@
 #include "storage/memory/mem_sub_tablet.h"
 #include "storage/memory/mem_tablet_scan.h"
 #include "storage/memory/write_txn.h"
+#include "storage/vectorized/column_predicate.h"
 
 namespace starrocks {
 namespace memory {
@@ -70,6 +71,11 @@ Status MemTablet::scan(std::unique_ptr<ScanSpec>* spec, std::unique_ptr<MemTable
         }
         RETURN_IF_ERROR(_sub_tablet->read_column(version, cs->cid(), &readers[i]));
     }
+    for (const auto* predicate : (*spec)->predicates()) {
+        if (predicate->column_id() >= columns.size()) {
+            return Status::InvalidArgument("predicate on a column not in the scan");
+        }
+    }
     scan->reset(new MemTabletScan(std::static_pointer_cast<MemTablet>(shared_from_this()), spec, num_rows, &readers));
     return Status::OK();
 }
@@ -57,8 +57,8 @@ public:
     Status init();
 
     // Scan the tablet, return a MemTabletScan object scan, user can specify projections
-    // using ScanSpec, currently only support full scan with projection, will support
-    // filter/aggregation in the future.
+    // and predicates using ScanSpec, the predicates are applied by MemTabletScan::next_chunk
+    // only, will support aggregation in the future.
     //
     // Note: spec will be passed to scan object
     // Note: thread-safe, supports multi-reader concurrency.
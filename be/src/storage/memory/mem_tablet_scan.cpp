@@ -21,9 +21,15 @@
 
 #include "storage/memory/mem_tablet_scan.h"
 
+#include "column/chunk.h"
+#include "column/datum.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "gutil/casts.h"
 #include "storage/memory/column_reader.h"
 #include "storage/memory/mem_sub_tablet.h"
 #include "storage/memory/mem_tablet.h"
+#include "storage/vectorized/column_predicate.h"
 
 namespace starrocks {
 namespace memory {
@@ -40,6 +46,83 @@ MemTabletScan::MemTabletScan(std::shared_ptr<MemTablet>&& tablet, std::unique_pt
     _row_block.reset(new RowBlock(_readers.size()));
     _next_block = 0;
     _num_blocks = num_block(_num_rows, Column::BLOCK_SIZE);
+
+    auto& columns = _spec->columns();
+    vectorized::Fields fields;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        const ColumnSchema* cs = _schema->get_by_name(columns[i]);
+        _column_schemas.push_back(cs);
+        fields.emplace_back(std::make_shared<vectorized::Field>(i, cs->name(), cs->type(), cs->is_nullable()));
+    }
+    _chunk_schema = vectorized::Schema(std::move(fields));
+    _column_predicates.resize(columns.size());
+    for (const auto* predicate : _spec->predicates()) {
+        _column_predicates[predicate->column_id()].push_back(predicate);
+    }
+}
+
+// The min/max of the first nrows of a block in the manner of the zone maps of the segments: min is null if the
+// block has a null, and max is null if the block has nulls only.
+template <class T>
+static void block_min_max(const ColumnBlock& block, size_t nrows, vectorized::Datum* min, vectorized::Datum* max) {
+    const T* data = block.data().as<T>();
+    bool has_null = false;
+    bool has_not_null = false;
+    T lo = T();
+    T hi = T();
+    for (size_t i = 0; i < nrows; ++i) {
+        if (block.is_null(i)) {
+            has_null = true;
+        } else if (!has_not_null) {
+            has_not_null = true;
+            lo = data[i];
+            hi = data[i];
+        } else {
+            lo = std::min(lo, data[i]);
+            hi = std::max(hi, data[i]);
+        }
+    }
+    min->set_null();
+    max->set_null();
+    if (has_not_null) {
+        max->set(hi);
+        if (!has_null) {
+            min->set(lo);
+        }
+    }
+}
+
+// Return false if the type has no min/max.
+static bool block_min_max(ColumnType type, const ColumnBlock& block, size_t nrows, vectorized::Datum* min,
+                          vectorized::Datum* max) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+        block_min_max<int8_t>(block, nrows, min, max);
+        return true;
+    case OLAP_FIELD_TYPE_SMALLINT:
+        block_min_max<int16_t>(block, nrows, min, max);
+        return true;
+    case OLAP_FIELD_TYPE_INT:
+        block_min_max<int32_t>(block, nrows, min, max);
+        return true;
+    case OLAP_FIELD_TYPE_BIGINT:
+        block_min_max<int64_t>(block, nrows, min, max);
+        return true;
+    case OLAP_FIELD_TYPE_LARGEINT:
+        block_min_max<int128_t>(block, nrows, min, max);
+        return true;
+    case OLAP_FIELD_TYPE_FLOAT:
+        block_min_max<float>(block, nrows, min, max);
+        return true;
+    case OLAP_FIELD_TYPE_DOUBLE:
+        block_min_max<double>(block, nrows, min, max);
+        return true;
+    case OLAP_FIELD_TYPE_BOOL:
+        block_min_max<bool>(block, nrows, min, max);
+        return true;
+    default:
+        return false;
+    }
 }
 
 Status MemTabletScan::next_block(const RowBlock** block) {
@@ -57,5 +140,98 @@ Status MemTabletScan::next_block(const RowBlock** block) {
     return Status::OK();
 }
 
+Status MemTabletScan::_read_next_block() {
+    for (; _next_block < _num_blocks; _next_block++) {
+        size_t rows_in_block = std::min((size_t)Column::BLOCK_SIZE, _num_rows - _next_block * Column::BLOCK_SIZE);
+        // Read the predicate columns first, the others are only read if the block isn't filtered by them.
+        bool matched = true;
+        for (size_t i = 0; i < _readers.size() && matched; ++i) {
+            if (_column_predicates[i].empty()) {
+                continue;
+            }
+            RETURN_IF_ERROR(_readers[i]->get_block(rows_in_block, _next_block, &_row_block->_columns[i]));
+            vectorized::Datum min;
+            vectorized::Datum max;
+            if (!block_min_max(_column_schemas[i]->type(), _row_block->get_column(i), rows_in_block, &min, &max)) {
+                continue;
+            }
+            for (const auto* predicate : _column_predicates[i]) {
+                if (!predicate->zone_map_filter(min, max)) {
+                    matched = false;
+                    break;
+                }
+            }
+        }
+        if (!matched) {
+            _num_blocks_filtered++;
+            continue;
+        }
+        for (size_t i = 0; i < _readers.size(); ++i) {
+            if (_column_predicates[i].empty()) {
+                RETURN_IF_ERROR(_readers[i]->get_block(rows_in_block, _next_block, &_row_block->_columns[i]));
+            }
+        }
+        _row_block->_nrows = rows_in_block;
+        _block_offset = 0;
+        _next_block++;
+        return Status::OK();
+    }
+    return Status::EndOfFile("no more blocks");
+}
+
+void MemTabletScan::_append_column(size_t idx, size_t from, size_t to, vectorized::Column* column) const {
+    const ColumnBlock& block = _row_block->get_column(idx);
+    size_t esize = _schema->get_column_byte_size(_column_schemas[idx]->cid());
+    const uint8_t* data = block.data().data() + from * esize;
+    if (!column->is_nullable()) {
+        column->append_numbers(data, (to - from) * esize);
+        return;
+    }
+    auto* nullable = down_cast<vectorized::NullableColumn*>(column);
+    nullable->mutable_data_column()->append_numbers(data, (to - from) * esize);
+    auto& nulls = nullable->null_column_data();
+    if (block.nulls()) {
+        const uint8_t* block_nulls = block.nulls().data();
+        nulls.insert(nulls.end(), block_nulls + from, block_nulls + to);
+    } else {
+        nulls.resize(nulls.size() + to - from, 0);
+    }
+    nullable->update_has_null();
+}
+
+Status MemTabletScan::next_chunk(vectorized::Chunk* chunk) {
+    DCHECK_EQ(0, chunk->num_rows());
+    while (true) {
+        if (_block_offset >= _row_block->num_rows()) {
+            RETURN_IF_ERROR(_read_next_block());
+        }
+        size_t from = _block_offset;
+        size_t to = std::min(_row_block->num_rows(), from + config::vector_chunk_size);
+        _block_offset = to;
+        for (size_t i = 0; i < _readers.size(); ++i) {
+            _append_column(i, from, to, chunk->get_column_by_index(i).get());
+        }
+        if (_spec->predicates().empty()) {
+            return Status::OK();
+        }
+        _selection.resize(to - from);
+        bool first = true;
+        for (size_t i = 0; i < _readers.size(); ++i) {
+            const vectorized::Column* column = chunk->get_column_by_index(i).get();
+            for (const auto* predicate : _column_predicates[i]) {
+                if (first) {
+                    predicate->evaluate(column, _selection.data(), 0, to - from);
+                    first = false;
+                } else {
+                    predicate->evaluate_and(column, _selection.data(), 0, to - from);
+                }
+            }
+        }
+        if (chunk->filter(_selection) > 0) {
+            return Status::OK();
+        }
+    }
+}
+
 } // namespace memory
 } // namespace starrocks
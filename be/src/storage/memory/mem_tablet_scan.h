@@ -21,11 +21,19 @@
 
 #pragma once
 
+#include "column/schema.h"
 #include "storage/memory/common.h"
 #include "storage/memory/row_block.h"
 #include "storage/memory/schema.h"
 
 namespace starrocks {
+
+namespace vectorized {
+class Chunk;
+class Column;
+class ColumnPredicate;
+} // namespace vectorized
+
 namespace memory {
 
 class ScanSpec {
@@ -39,12 +47,19 @@ public:
 
     const vector<std::string> columns() const { return _columns; }
 
+    // Add a predicate on the column columns()[predicate->column_id()], MemTabletScan::next_chunk only returns
+    // the rows matching all the predicates. The predicate is not owned, and must outlive the scan.
+    void add_predicate(const vectorized::ColumnPredicate* predicate) { _predicates.push_back(predicate); }
+
+    const vector<const vectorized::ColumnPredicate*>& predicates() const { return _predicates; }
+
 private:
     friend class MemTablet;
 
     uint64_t _version = UINT64_MAX;
     uint64_t _limit = UINT64_MAX;
     vector<std::string> _columns;
+    vector<const vectorized::ColumnPredicate*> _predicates;
 };
 
 class HashIndex;
@@ -59,6 +74,20 @@ public:
     // Get next row_block, it will remain valid until next call to next_block.
     Status next_block(const RowBlock** block);
 
+    // The schema of the chunks of next_chunk, with a field of id i for the i-th column of the ScanSpec.
+    const vectorized::Schema& chunk_schema() const { return _chunk_schema; }
+
+    // Get the next rows matching the predicates of the ScanSpec into chunk, an empty chunk created from
+    // chunk_schema(), up to config::vector_chunk_size rows at a time and copied straight from the column blocks.
+    // A block whose min/max of a predicate column rules out the predicate is skipped without reading the other
+    // columns. Returns EndOfFile after the last block.
+    //
+    // Note: next_block and next_chunk should not be mixed in the same scan.
+    Status next_chunk(vectorized::Chunk* chunk);
+
+    // The number of blocks skipped by the min/max of the predicate columns.
+    size_t num_blocks_filtered() const { return _num_blocks_filtered; }
+
 private:
     friend class MemTablet;
 
@@ -78,6 +107,20 @@ private:
     std::unique_ptr<RowBlock> _row_block;
     size_t _next_block = 0;
 
+    // Read the next block not filtered by the min/max of the predicate columns into _row_block.
+    Status _read_next_block();
+    void _append_column(size_t idx, size_t from, size_t to, vectorized::Column* column) const;
+
+    // chunk scan support
+    vectorized::Schema _chunk_schema;
+    std::vector<const ColumnSchema*> _column_schemas;
+    // Indexed by the column of the ScanSpec.
+    std::vector<std::vector<const vectorized::ColumnPredicate*>> _column_predicates;
+    // The rows of _row_block not returned yet are [_block_offset, _row_block->num_rows()).
+    size_t _block_offset = 0;
+    size_t _num_blocks_filtered = 0;
+    std::vector<uint8_t> _selection;
+
     DISALLOW_COPY_AND_ASSIGN(MemTabletScan);
 };
 
@@ -109,10 +109,18 @@ Status MemTableFlushExecutor::init(const std::vector<DataDir*>& data_dirs) {
     int32_t data_dir_num = data_dirs.size();
     size_t min_threads = std::max(1, config::flush_thread_num_per_store);
     size_t max_threads = data_dir_num * min_threads;
-    return ThreadPoolBuilder("MemTableFlushThreadPool")
-            .set_min_threads(min_threads)
-            .set_max_threads(max_threads)
-            .build(&_flush_pool);
+    RETURN_IF_ERROR(ThreadPoolBuilder("MemTableFlushThreadPool")
+                            .set_min_threads(min_threads)
+                            .set_max_threads(max_threads)
+                            .build(&_flush_pool));
+    if (config::memtable_flush_encode_thread_num > 0) {
+        // The flush threads wait for the tasks of this pool, so it must not be the flush pool.
+        RETURN_IF_ERROR(ThreadPoolBuilder("MemTableEncodeThreadPool")
+                                .set_min_threads(0)
+                                .set_max_threads(config::memtable_flush_encode_thread_num)
+                                .build(&_encode_pool));
+    }
+    return Status::OK();
 }
 
 // NOTE: we use SERIAL mode here to ensure all mem-tables from one tablet are flushed in order.
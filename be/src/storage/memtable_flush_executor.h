@@ -110,8 +110,13 @@ public:
     OLAPStatus create_flush_token(std::unique_ptr<FlushToken>* flush_token,
                                   ThreadPool::ExecutionMode execution_mode = ThreadPool::ExecutionMode::SERIAL);
 
+    // The pool encoding the columns and segments of the memtables flushed, shared by all the tablets.
+    // nullptr if memtable_flush_encode_thread_num is 0.
+    ThreadPool* encode_pool() { return _encode_pool.get(); }
+
 private:
     std::unique_ptr<ThreadPool> _flush_pool;
+    std::unique_ptr<ThreadPool> _encode_pool;
 };
 
 } // namespace starrocks
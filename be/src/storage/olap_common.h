@@ -40,6 +40,7 @@
 #include "storage/olap_define.h"
 #include "util/guard.h"
 #include "util/hash_util.hpp"
+#include "util/io_latency_histogram.h"
 #include "util/uid_util.h"
 
 #define LOW_56_BITS 0x00ffffffffffffff
@@ -375,8 +376,11 @@ using KeyRange = std::pair<WrapperField*, WrapperField*>;
 // ReaderStatistics used to collect statistics when scan data from storage
 struct OlapReaderStatistics {
     int64_t capture_rowset_ns = 0;
+    // The reads of the pages from the local disk, i.e. of the pages not in the page cache.
     int64_t io_ns = 0;
+    int64_t io_count = 0;
     int64_t compressed_bytes_read = 0;
+    IOLatencyHistogram io_latency;
 
     int64_t decompress_ns = 0;
     int64_t uncompressed_bytes_read = 0;
@@ -414,11 +418,21 @@ struct OlapReaderStatistics {
 
     int64_t total_pages_num = 0;
     int64_t cached_pages_num = 0;
+    // The bytes of the pages found in the page cache.
+    int64_t page_cache_bytes_read = 0;
+    // The pages to be cached but not found in the page cache.
+    int64_t cache_missed_pages_num = 0;
+    // The bytes of the data pages prefetched by the segment iterators.
+    int64_t read_ahead_bytes = 0;
 
     int64_t rows_bitmap_index_filtered = 0;
     int64_t bitmap_index_filter_timer = 0;
 
     int64_t rows_del_vec_filtered = 0;
+
+    // The compressed bytes of the data pages skipped because none of their rows is left by the short key, zone map,
+    // bitmap and bloom filter indexes.
+    int64_t bytes_index_filtered = 0;
 };
 
 typedef uint32_t ColumnId;
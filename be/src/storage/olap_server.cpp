@@ -25,14 +25,17 @@
 
 #include <cmath>
 #include <ctime>
+#include <functional>
 #include <string>
 
 #include "common/status.h"
 #include "storage/olap_common.h"
 #include "storage/olap_define.h"
 #include "storage/storage_engine.h"
+#include "storage/storage_tiering.h"
 #include "storage/update_manager.h"
 #include "storage/vectorized/compaction.h"
+#include "util/thread_pool_metrics.h"
 #include "util/time.h"
 
 using std::string;
@@ -53,6 +56,15 @@ namespace starrocks {
 // number of running SCHEMA-CHANGE threads
 volatile uint32_t g_schema_change_active_threads = 0;
 
+// The compaction threads are reported like the workers of a thread pool, each compaction being a task.
+static Status run_as_task(ThreadPoolMetrics* metrics, const std::function<Status()>& func) {
+    metrics->task_started();
+    int64_t start_ns = MonotonicNanos();
+    Status status = func();
+    metrics->task_finished(MonotonicNanos() - start_ns);
+    return status;
+}
+
 Status StorageEngine::start_bg_threads() {
     _update_cache_expire_thread = std::thread([this] { _update_cache_expire_thread_callback(nullptr); });
     LOG(INFO) << "update cache expire thread started";
@@ -143,6 +155,10 @@ Status StorageEngine::start_bg_threads() {
     _fd_cache_clean_thread.detach();
     LOG(INFO) << "fd cache clean thread started";
 
+    _storage_tiering_thread = std::thread([this] { _storage_tiering_thread_callback(nullptr); });
+    _storage_tiering_thread.detach();
+    LOG(INFO) << "storage tiering thread started";
+
     // path scan and gc thread
     if (config::path_gc_check) {
         for (auto data_dir : get_stores()) {
@@ -181,17 +197,34 @@ void* StorageEngine::_fd_cache_clean_callback(void* arg) {
     return nullptr;
 }
 
+void* StorageEngine::_storage_tiering_thread_callback(void* arg) {
+#ifdef GOOGLE_PROFILER
+    ProfilerRegisterThread();
+#endif
+    while (!_stop_bg_worker) {
+        SLEEP_IN_BG_WORKER(std::max<int32_t>(config::storage_tiering_interval_seconds, 1));
+
+        if (config::enable_storage_tiering) {
+            int num_migrated = StorageTiering::run_once(this);
+            LOG_IF(INFO, num_migrated > 0) << "Migrated " << num_migrated << " tablets by their temperature";
+        }
+    }
+
+    return nullptr;
+}
+
 void* StorageEngine::_base_compaction_thread_callback(void* arg, DataDir* data_dir) {
 #ifdef GOOGLE_PROFILER
     ProfilerRegisterThread();
 #endif
     //string last_base_compaction_fs;
     //TTabletId last_base_compaction_tablet_id = -1;
+    auto* metrics = ThreadPoolMetrics::get("base_compaction");
     Status status = Status::OK();
     while (!_stop_bg_worker) {
         // must be here, because this thread is start on start and
         if (!data_dir->reach_capacity_limit(0)) {
-            status = _perform_base_compaction(data_dir);
+            status = run_as_task(metrics, [&] { return _perform_base_compaction(data_dir); });
         }
         if (status.ok()) {
             continue;
@@ -212,11 +245,12 @@ void* StorageEngine::_update_compaction_thread_callback(void* arg, DataDir* data
 #ifdef GOOGLE_PROFILER
     ProfilerRegisterThread();
 #endif
+    auto* metrics = ThreadPoolMetrics::get("update_compaction");
     Status status = Status::OK();
     while (!_stop_bg_worker) {
         // must be here, because this thread is start on start and
         if (!data_dir->reach_capacity_limit(0)) {
-            status = _perform_update_compaction(data_dir);
+            status = run_as_task(metrics, [&] { return _perform_update_compaction(data_dir); });
         }
         if (status.ok()) {
             continue;
@@ -301,11 +335,12 @@ void* StorageEngine::_cumulative_compaction_thread_callback(void* arg, DataDir*
 #endif
     LOG(INFO) << "try to start cumulative compaction process!";
 
+    auto* metrics = ThreadPoolMetrics::get("cumulative_compaction");
     Status status = Status::OK();
     while (!_stop_bg_worker) {
         // must be here, because this thread is start on start and
         if (!data_dir->reach_capacity_limit(0)) {
-            status = _perform_cumulative_compaction(data_dir);
+            status = run_as_task(metrics, [&] { return _perform_cumulative_compaction(data_dir); });
         }
         if (status.ok()) {
             continue;
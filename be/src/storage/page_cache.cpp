@@ -21,6 +21,8 @@
 
 #include "storage/page_cache.h"
 
+#include <atomic>
+
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
 #include "util/metrics.h"
@@ -28,7 +30,10 @@
 
 namespace starrocks {
 
-UIntGauge g_cache_size(MetricUnit::BYTES); // NOLINT
+UIntGauge g_cache_size(MetricUnit::BYTES);              // NOLINT
+IntCounter g_cache_hit_count(MetricUnit::OPERATIONS);   // NOLINT
+IntCounter g_cache_miss_count(MetricUnit::OPERATIONS);  // NOLINT
+UIntGauge g_cache_evict_count(MetricUnit::OPERATIONS);  // NOLINT
 
 [[maybe_unused]] static void update_cache_size() {
     StoragePageCache::instance()->update_memory_usage_statistics();
@@ -36,6 +41,8 @@ UIntGauge g_cache_size(MetricUnit::BYTES); // NOLINT
 
 StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
+static_assert(sizeof(StoragePageCache::CacheKey) == 16, "the cache key is used as LRUCache's key as is");
+
 void StoragePageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
     if (_s_instance == nullptr) {
         _s_instance = new StoragePageCache(mem_tracker, capacity);
@@ -43,6 +50,9 @@ void StoragePageCache::create_global_cache(MemTracker* mem_tracker, size_t capac
         MetricRegistry* reg = StarRocksMetrics::instance()->metrics();
         reg->register_hook("page_cache_size_hook", update_cache_size);
         reg->register_metric("storage_page_cache_bytes", &g_cache_size);
+        reg->register_metric("storage_page_cache_hit_count", &g_cache_hit_count);
+        reg->register_metric("storage_page_cache_miss_count", &g_cache_miss_count);
+        reg->register_metric("storage_page_cache_evict_count", &g_cache_evict_count);
 #endif
     }
 }
@@ -57,11 +67,13 @@ void StoragePageCache::release_global_cache() {
 void StoragePageCache::update_memory_usage_statistics() {
     int64_t mem_usage = memory_usage();
     g_cache_size.set_value(mem_usage);
+    g_cache_evict_count.set_value(evict_count());
     _mem_tracker->consume(mem_usage - _mem_tracker->consumption());
 }
 
 StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity)
-        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {}
+        : _mem_tracker(mem_tracker),
+          _cache(new_lru_cache(capacity, storage_cache_eviction_policy(), cache_num_shards_by_cores(capacity))) {}
 
 StoragePageCache::~StoragePageCache() {
     _mem_tracker->release(_mem_tracker->consumption());
@@ -70,8 +82,10 @@ StoragePageCache::~StoragePageCache() {
 bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle) {
     auto* lru_handle = _cache->lookup(key.encode());
     if (lru_handle == nullptr) {
+        g_cache_miss_count.increment(1);
         return false;
     }
+    g_cache_hit_count.increment(1);
     *handle = PageCacheHandle(_cache.get(), lru_handle);
     return true;
 }
@@ -88,4 +102,17 @@ void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheH
     *handle = PageCacheHandle(_cache.get(), lru_handle);
 }
 
+int64_t StoragePageCache::hit_count() {
+    return g_cache_hit_count.value();
+}
+
+int64_t StoragePageCache::miss_count() {
+    return g_cache_miss_count.value();
+}
+
+uint64_t StoragePageCache::new_file_id() {
+    static std::atomic<uint64_t> s_last_file_id{0};
+    return s_last_file_id.fetch_add(1) + 1;
+}
+
 } // namespace starrocks
@@ -35,7 +35,6 @@ class MemTracker;
 
 // Warpper around Cache, and used for cache page of column datas
 // in Segment.
-// TODO(zc): We should add some metric to see cache hit/miss rate.
 class StoragePageCache {
 public:
     virtual ~StoragePageCache();
@@ -43,21 +42,22 @@ public:
     // Each cached page corresponds to a specific offset within
     // a file.
     //
-    // TODO(zc): Now we use file name(std::string) as a part of
-    // key, which is not efficient. We should make it better later
+    // The file is identified by the unique id from new_file_id(), so that the key is
+    // 16 bytes, which are used as the LRUCache's key as is, and no two files share a key.
     struct CacheKey {
-        CacheKey(std::string fname_, int64_t offset_) : fname(std::move(fname_)), offset(offset_) {}
-        std::string fname;
+        CacheKey(uint64_t file_id_, int64_t offset_) : file_id(file_id_), offset(offset_) {}
+        uint64_t file_id;
         int64_t offset;
 
-        // Encode to a flat binary which can be used as LRUCache's key
-        std::string encode() const {
-            std::string key_buf(fname);
-            key_buf.append((char*)&offset, sizeof(offset));
-            return key_buf;
-        }
+        // The flat binary used as LRUCache's key, which refers to this key.
+        starrocks::CacheKey encode() const { return {reinterpret_cast<const char*>(this), sizeof(*this)}; }
     };
 
+    // Return an id of a file which is unique in the process, e.g. for a segment
+    // file once it is opened. The ids are never reused, so the pages cached for
+    // a file closed are evicted at last but never returned for another file.
+    static uint64_t new_file_id();
+
     // Create global instance of this class
     static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
 
@@ -89,6 +89,14 @@ public:
 
     size_t memory_usage() const { return _cache->get_memory_usage(); }
 
+    // The number of the lookups found or not found in the cache, of all the page
+    // caches of the process.
+    static int64_t hit_count();
+    static int64_t miss_count();
+
+    // The number of the pages evicted to make room for the new ones.
+    int64_t evict_count() const { return _cache->get_evict_count(); }
+
 private:
     static StoragePageCache* _s_instance;
 
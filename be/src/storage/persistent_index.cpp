@@ -0,0 +1,536 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/persistent_index.h"
+
+#include <algorithm>
+#include <string_view>
+
+#include "common/config.h"
+#include "env/env.h"
+#include "gutil/strings/substitute.h"
+#include "storage/tablet_updates.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+
+namespace starrocks {
+
+// L1 file: the pages of the sorted keys, the first keys of the pages and the footer.
+//  - page: (length prefixed key, fixed64 value)*, fixed32 number of entries, fixed32 crc32c of the page before it.
+//  - index: (fixed64 offset, fixed32 size, length prefixed first key) of every page.
+//  - footer: fixed64 offset of the index, fixed32 size of the index, fixed32 crc32c of the index, fixed64 number of
+//    keys, fixed64 major version, fixed64 minor version, fixed32 format version, fixed32 magic.
+// L0 log: the records of the commits, fixed32 size of the body, fixed32 crc32c of the body, and the body: fixed64
+// major and minor version of the previous commit and of this one, fixed64 number of keys, fixed32 number of changes,
+// and (length prefixed key, fixed64 value)* of the changes, NullValue for the erased keys.
+static const size_t kL1PageSize = 16 * 1024;
+static const size_t kL1FooterSize = 48;
+static const uint32_t kL1FormatVersion = 1;
+static const uint32_t kL1Magic = 0x31495053; // "SPI1"
+static const size_t kL0RecordHeaderSize = 8;
+static const size_t kL0RecordFixedBodySize = 44;
+
+static std::string_view to_string_view(const Slice& s) {
+    return std::string_view(s.data, s.size);
+}
+
+static bool version_less(int64_t major1, int64_t minor1, int64_t major2, int64_t minor2) {
+    return major1 < major2 || (major1 == major2 && minor1 < minor2);
+}
+
+PersistentIndex::PersistentIndex(std::string dir) : _dir(std::move(dir)) {}
+
+PersistentIndex::~PersistentIndex() {
+    if (_l0_log != nullptr) {
+        WARN_IF_ERROR(_l0_log->close(), "Fail to close the log of persistent index " + _dir);
+    }
+}
+
+void PersistentIndex::_clear() {
+    _major = 0;
+    _minor = 0;
+    _size = 0;
+    _l0.clear();
+    _l0_bytes = 0;
+    _l0_changes.clear();
+    _l0_num_changes = 0;
+    _l0_log.reset();
+    _l1_major = 0;
+    _l1_minor = 0;
+    _l1_size = 0;
+    _l1_pages.clear();
+    _l1_index_bytes = 0;
+    _l1_file.reset();
+}
+
+Status PersistentIndex::load(const EditVersion& version) {
+    _clear();
+    Env* env = Env::Default();
+    bool has_l1 = env->path_exists(_l1_path()).ok();
+    bool has_l0 = env->path_exists(_l0_path()).ok();
+    if (!has_l1 && !has_l0) {
+        return Status::NotFound("no persistent index in " + _dir);
+    }
+    Status st;
+    bool clean = true;
+    if (has_l1) {
+        st = _load_l1();
+    }
+    if (st.ok() && has_l0) {
+        st = _replay_l0(version.major(), version.minor(), &clean);
+    }
+    if (st.ok() && (_major != version.major() || _minor != version.minor())) {
+        st = Status::NotFound(strings::Substitute("persistent index in $0 is at version $1.$2 other than $3", _dir,
+                                                  _major, _minor, version.to_string()));
+    }
+    if (st.ok()) {
+        if (!clean || !has_l0) {
+            // Rewrite the files at |version|, without the records after it appended by the applies failed to make
+            // their meta durable.
+            st = _write_l1(_major, _minor);
+        } else {
+            WritableFileOptions opts;
+            opts.mode = Env::MUST_EXIST;
+            st = env->new_writable_file(opts, _l0_path(), &_l0_log);
+        }
+    }
+    if (!st.ok()) {
+        _clear();
+    }
+    return st;
+}
+
+Status PersistentIndex::reset() {
+    _clear();
+    return remove_files(_dir);
+}
+
+Status PersistentIndex::remove_files(const std::string& dir) {
+    PersistentIndex index(dir);
+    Env* env = Env::Default();
+    for (const std::string& path : {index._l1_path(), index._l1_path() + ".tmp", index._l0_path()}) {
+        if (env->path_exists(path).ok()) {
+            RETURN_IF_ERROR(env->delete_file(path));
+        }
+    }
+    return Status::OK();
+}
+
+Status PersistentIndex::_load_l1() {
+    RETURN_IF_ERROR(Env::Default()->new_random_access_file(_l1_path(), &_l1_file));
+    uint64_t file_size = 0;
+    RETURN_IF_ERROR(_l1_file->size(&file_size));
+    if (file_size < kL1FooterSize) {
+        return Status::Corruption("bad persistent index file size: " + _l1_path());
+    }
+    uint8_t footer[kL1FooterSize];
+    RETURN_IF_ERROR(_l1_file->read_at(file_size - kL1FooterSize, Slice(footer, kL1FooterSize)));
+    uint64_t index_offset = decode_fixed64_le(footer);
+    uint32_t index_size = decode_fixed32_le(footer + 8);
+    uint32_t index_crc = decode_fixed32_le(footer + 12);
+    if (decode_fixed32_le(footer + 40) != kL1FormatVersion || decode_fixed32_le(footer + 44) != kL1Magic ||
+        index_offset + index_size + kL1FooterSize != file_size) {
+        return Status::Corruption("bad persistent index file footer: " + _l1_path());
+    }
+    std::string index(index_size, '\0');
+    RETURN_IF_ERROR(_l1_file->read_at(index_offset, Slice(index)));
+    if (crc32c::Value(index.data(), index.size()) != index_crc) {
+        return Status::Corruption("bad persistent index file checksum: " + _l1_path());
+    }
+    Slice input(index);
+    while (!input.empty()) {
+        L1Page page;
+        Slice first_key;
+        if (input.size < 12) {
+            return Status::Corruption("bad persistent index file index: " + _l1_path());
+        }
+        page.offset = decode_fixed64_le(reinterpret_cast<const uint8_t*>(input.data));
+        page.size = decode_fixed32_le(reinterpret_cast<const uint8_t*>(input.data + 8));
+        input.remove_prefix(12);
+        if (!get_length_prefixed_slice(&input, &first_key)) {
+            return Status::Corruption("bad persistent index file index: " + _l1_path());
+        }
+        page.first_key = first_key.to_string();
+        _l1_index_bytes += sizeof(L1Page) + page.first_key.size();
+        _l1_pages.emplace_back(std::move(page));
+    }
+    _l1_size = decode_fixed64_le(footer + 16);
+    _l1_major = decode_fixed64_le(footer + 24);
+    _l1_minor = decode_fixed64_le(footer + 32);
+    _size = _l1_size;
+    _major = _l1_major;
+    _minor = _l1_minor;
+    return Status::OK();
+}
+
+Status PersistentIndex::_replay_l0(int64_t major, int64_t minor, bool* clean) {
+    std::unique_ptr<RandomAccessFile> file;
+    RETURN_IF_ERROR(Env::Default()->new_random_access_file(_l0_path(), &file));
+    uint64_t file_size = 0;
+    RETURN_IF_ERROR(file->size(&file_size));
+    std::string buf(file_size, '\0');
+    RETURN_IF_ERROR(file->read_at(0, Slice(buf)));
+    Slice input(buf);
+    size_t num_records = 0;
+    while (!input.empty()) {
+        if (input.size < kL0RecordHeaderSize) {
+            break;
+        }
+        auto header = reinterpret_cast<const uint8_t*>(input.data);
+        uint32_t body_size = decode_fixed32_le(header);
+        if (input.size - kL0RecordHeaderSize < body_size || body_size < kL0RecordFixedBodySize) {
+            // A torn record of a commit crashed.
+            break;
+        }
+        Slice body(input.data + kL0RecordHeaderSize, body_size);
+        if (crc32c::Value(body.data, body.size) != decode_fixed32_le(header + 4)) {
+            break;
+        }
+        auto fixed = reinterpret_cast<const uint8_t*>(body.data);
+        int64_t prev_major = decode_fixed64_le(fixed);
+        int64_t prev_minor = decode_fixed64_le(fixed + 8);
+        int64_t rec_major = decode_fixed64_le(fixed + 16);
+        int64_t rec_minor = decode_fixed64_le(fixed + 24);
+        if (!version_less(_major, _minor, rec_major, rec_minor)) {
+            // Merged into L1 already.
+            input.remove_prefix(kL0RecordHeaderSize + body_size);
+            continue;
+        }
+        if (version_less(major, minor, rec_major, rec_minor) || prev_major != _major || prev_minor != _minor) {
+            break;
+        }
+        uint64_t size = decode_fixed64_le(fixed + 32);
+        uint32_t num_changes = decode_fixed32_le(fixed + 40);
+        body.remove_prefix(kL0RecordFixedBodySize);
+        for (uint32_t i = 0; i < num_changes; i++) {
+            Slice key;
+            if (!get_length_prefixed_slice(&body, &key) || body.size < 8) {
+                return Status::Corruption("bad persistent index log record: " + _l0_path());
+            }
+            _put_l0(key, decode_fixed64_le(reinterpret_cast<const uint8_t*>(body.data)));
+            body.remove_prefix(8);
+        }
+        _size = size;
+        _major = rec_major;
+        _minor = rec_minor;
+        num_records++;
+        input.remove_prefix(kL0RecordHeaderSize + body_size);
+    }
+    *clean = input.empty();
+    VLOG(1) << "replay persistent index log " << _l0_path() << " #record:" << num_records << " #key:" << _l0.size()
+            << " version:" << _major << "." << _minor << " clean:" << *clean;
+    return Status::OK();
+}
+
+Status PersistentIndex::_read_l1_page(size_t page, std::string* buf,
+                                      std::vector<std::pair<Slice, uint64_t>>* entries) const {
+    const L1Page& p = _l1_pages[page];
+    buf->resize(p.size);
+    entries->clear();
+    RETURN_IF_ERROR(_l1_file->read_at(p.offset, Slice(*buf)));
+    auto data = reinterpret_cast<const uint8_t*>(buf->data());
+    if (p.size < 8 || crc32c::Value(buf->data(), p.size - 4) != decode_fixed32_le(data + p.size - 4)) {
+        return Status::Corruption(strings::Substitute("bad persistent index page $0 of $1", page, _l1_path()));
+    }
+    uint32_t num_entries = decode_fixed32_le(data + p.size - 8);
+    entries->reserve(num_entries);
+    Slice input(buf->data(), p.size - 8);
+    for (uint32_t i = 0; i < num_entries; i++) {
+        Slice key;
+        if (!get_length_prefixed_slice(&input, &key) || input.size < 8) {
+            return Status::Corruption(strings::Substitute("bad persistent index page $0 of $1", page, _l1_path()));
+        }
+        entries->emplace_back(key, decode_fixed64_le(reinterpret_cast<const uint8_t*>(input.data)));
+        input.remove_prefix(8);
+    }
+    return Status::OK();
+}
+
+Status PersistentIndex::_get_from_l1(size_t n, const Slice* keys, uint64_t* values) const {
+    // (page, index of the key) of the keys to read from L1, sorted to read every page once.
+    std::vector<std::pair<uint32_t, uint32_t>> page_keys;
+    for (uint32_t i = 0; i < n; i++) {
+        values[i] = NullValue;
+        if (_l1_pages.empty() || _l0.find(to_string_view(keys[i])) != _l0.end()) {
+            continue;
+        }
+        auto iter = std::upper_bound(_l1_pages.begin(), _l1_pages.end(), keys[i],
+                                     [](const Slice& key, const L1Page& page) {
+                                         return key.compare(Slice(page.first_key)) < 0;
+                                     });
+        if (iter != _l1_pages.begin()) {
+            page_keys.emplace_back(iter - _l1_pages.begin() - 1, i);
+        }
+    }
+    std::sort(page_keys.begin(), page_keys.end());
+    std::string buf;
+    std::vector<std::pair<Slice, uint64_t>> entries;
+    uint32_t cur_page = UINT32_MAX;
+    for (auto [page, i] : page_keys) {
+        if (page != cur_page) {
+            RETURN_IF_ERROR(_read_l1_page(page, &buf, &entries));
+            cur_page = page;
+        }
+        auto iter = std::lower_bound(
+                entries.begin(), entries.end(), keys[i],
+                [](const std::pair<Slice, uint64_t>& entry, const Slice& key) { return entry.first.compare(key) < 0; });
+        if (iter != entries.end() && iter->first == keys[i]) {
+            values[i] = iter->second;
+        }
+    }
+    return Status::OK();
+}
+
+uint64_t PersistentIndex::_get_from_l0(const Slice& key, uint64_t l1_value) const {
+    auto iter = _l0.find(to_string_view(key));
+    return iter != _l0.end() ? iter->second : l1_value;
+}
+
+void PersistentIndex::_put_l0(const Slice& key, uint64_t value) {
+    auto iter = _l0.find(to_string_view(key));
+    if (iter != _l0.end()) {
+        iter->second = value;
+    } else {
+        _l0.emplace(key.to_string(), value);
+        _l0_bytes += sizeof(std::string) + key.size + sizeof(uint64_t) + 1;
+    }
+}
+
+void PersistentIndex::_set_l0(const Slice& key, uint64_t value) {
+    _put_l0(key, value);
+    put_length_prefixed_slice(&_l0_changes, key);
+    put_fixed64_le(&_l0_changes, value);
+    _l0_num_changes++;
+}
+
+Status PersistentIndex::get(size_t n, const Slice* keys, uint64_t* values) const {
+    RETURN_IF_ERROR(_get_from_l1(n, keys, values));
+    for (size_t i = 0; i < n; i++) {
+        values[i] = _get_from_l0(keys[i], values[i]);
+    }
+    return Status::OK();
+}
+
+Status PersistentIndex::insert(size_t n, const Slice* keys, const uint64_t* values) {
+    std::vector<uint64_t> l1_values(n);
+    RETURN_IF_ERROR(_get_from_l1(n, keys, l1_values.data()));
+    for (size_t i = 0; i < n; i++) {
+        uint64_t old = _get_from_l0(keys[i], l1_values[i]);
+        if (old != NullValue) {
+            return Status::InternalError(strings::Substitute(
+                    "insert found duplicate key new(rssid=$0 rowid=$1) old(rssid=$2 rowid=$3)", values[i] >> 32,
+                    values[i] & 0xffffffff, old >> 32, old & 0xffffffff));
+        }
+        _set_l0(keys[i], values[i]);
+        _size++;
+    }
+    return Status::OK();
+}
+
+Status PersistentIndex::upsert(size_t n, const Slice* keys, const uint64_t* values, uint64_t* old_values) {
+    RETURN_IF_ERROR(_get_from_l1(n, keys, old_values));
+    for (size_t i = 0; i < n; i++) {
+        // Read L0 after the keys before, in case of the duplicate keys.
+        old_values[i] = _get_from_l0(keys[i], old_values[i]);
+        if (old_values[i] == NullValue) {
+            _size++;
+        }
+        _set_l0(keys[i], values[i]);
+    }
+    return Status::OK();
+}
+
+Status PersistentIndex::try_replace(size_t n, const Slice* keys, const uint64_t* values, const uint32_t* src_rssids,
+                                    std::vector<uint32_t>* failed) {
+    std::vector<uint64_t> l1_values(n);
+    RETURN_IF_ERROR(_get_from_l1(n, keys, l1_values.data()));
+    for (uint32_t i = 0; i < n; i++) {
+        uint64_t old = _get_from_l0(keys[i], l1_values[i]);
+        if (old != NullValue && (uint32_t)(old >> 32) == src_rssids[i]) {
+            _set_l0(keys[i], values[i]);
+        } else {
+            failed->push_back(i);
+        }
+    }
+    return Status::OK();
+}
+
+Status PersistentIndex::erase(size_t n, const Slice* keys, uint64_t* old_values) {
+    RETURN_IF_ERROR(_get_from_l1(n, keys, old_values));
+    for (size_t i = 0; i < n; i++) {
+        old_values[i] = _get_from_l0(keys[i], old_values[i]);
+        if (old_values[i] != NullValue) {
+            _size--;
+            _set_l0(keys[i], NullValue);
+        }
+    }
+    return Status::OK();
+}
+
+Status PersistentIndex::commit(const EditVersion& version) {
+    Status st;
+    if (_l0_log == nullptr || _l0_bytes > config::persistent_index_l0_max_mem_usage) {
+        st = _write_l1(version.major(), version.minor());
+    } else {
+        st = _append_l0_log(version.major(), version.minor());
+    }
+    _major = version.major();
+    _minor = version.minor();
+    _l0_changes.clear();
+    _l0_num_changes = 0;
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to commit persistent index " << _dir << " version:" << version << ": " << st;
+        // The next commit rewrites L1 from the index in memory.
+        _l0_log.reset();
+        WARN_IF_ERROR(remove_files(_dir), "Fail to remove persistent index " + _dir);
+    }
+    return st;
+}
+
+Status PersistentIndex::_append_l0_log(int64_t major, int64_t minor) {
+    std::string fixed;
+    put_fixed64_le(&fixed, _major);
+    put_fixed64_le(&fixed, _minor);
+    put_fixed64_le(&fixed, major);
+    put_fixed64_le(&fixed, minor);
+    put_fixed64_le(&fixed, _size);
+    put_fixed32_le(&fixed, _l0_num_changes);
+    DCHECK_EQ(kL0RecordFixedBodySize, fixed.size());
+    std::string header;
+    put_fixed32_le(&header, fixed.size() + _l0_changes.size());
+    put_fixed32_le(&header, crc32c::Extend(crc32c::Value(fixed.data(), fixed.size()), _l0_changes.data(),
+                                           _l0_changes.size()));
+    Slice slices[3] = {Slice(header), Slice(fixed), Slice(_l0_changes)};
+    RETURN_IF_ERROR(_l0_log->appendv(slices, 3));
+    return _l0_log->sync();
+}
+
+Status PersistentIndex::_write_l1(int64_t major, int64_t minor) {
+    Env* env = Env::Default();
+    std::vector<std::pair<Slice, uint64_t>> l0_entries;
+    l0_entries.reserve(_l0.size());
+    for (const auto& [key, value] : _l0) {
+        l0_entries.emplace_back(Slice(key), value);
+    }
+    std::sort(l0_entries.begin(), l0_entries.end(),
+              [](const std::pair<Slice, uint64_t>& a, const std::pair<Slice, uint64_t>& b) {
+                  return a.first.compare(b.first) < 0;
+              });
+
+    std::string tmp_path = _l1_path() + ".tmp";
+    std::unique_ptr<WritableFile> wfile;
+    RETURN_IF_ERROR(env->new_writable_file(tmp_path, &wfile));
+    std::vector<L1Page> pages;
+    std::string page;
+    uint32_t page_entries = 0;
+    uint64_t offset = 0;
+    size_t num_keys = 0;
+    auto finish_page = [&]() -> Status {
+        if (page_entries == 0) {
+            return Status::OK();
+        }
+        put_fixed32_le(&page, page_entries);
+        put_fixed32_le(&page, crc32c::Value(page.data(), page.size()));
+        RETURN_IF_ERROR(wfile->append(page));
+        pages.back().size = page.size();
+        offset += page.size();
+        page.clear();
+        page_entries = 0;
+        return Status::OK();
+    };
+    auto add = [&](const Slice& key, uint64_t value) -> Status {
+        if (value == NullValue) {
+            return Status::OK();
+        }
+        if (page_entries == 0) {
+            pages.push_back({offset, 0, key.to_string()});
+        }
+        put_length_prefixed_slice(&page, key);
+        put_fixed64_le(&page, value);
+        page_entries++;
+        num_keys++;
+        return page.size() >= kL1PageSize ? finish_page() : Status::OK();
+    };
+
+    // Merge L0 into the old L1, the keys of which are replaced by the ones of L0.
+    size_t j = 0;
+    std::string buf;
+    std::vector<std::pair<Slice, uint64_t>> entries;
+    for (size_t p = 0; p < _l1_pages.size(); p++) {
+        RETURN_IF_ERROR(_read_l1_page(p, &buf, &entries));
+        for (const auto& entry : entries) {
+            int c = -1;
+            while (j < l0_entries.size() && (c = l0_entries[j].first.compare(entry.first)) < 0) {
+                RETURN_IF_ERROR(add(l0_entries[j].first, l0_entries[j].second));
+                j++;
+            }
+            if (j < l0_entries.size() && c == 0) {
+                RETURN_IF_ERROR(add(l0_entries[j].first, l0_entries[j].second));
+                j++;
+            } else {
+                RETURN_IF_ERROR(add(entry.first, entry.second));
+            }
+        }
+    }
+    for (; j < l0_entries.size(); j++) {
+        RETURN_IF_ERROR(add(l0_entries[j].first, l0_entries[j].second));
+    }
+    RETURN_IF_ERROR(finish_page());
+
+    std::string index;
+    size_t index_bytes = 0;
+    for (const L1Page& p : pages) {
+        put_fixed64_le(&index, p.offset);
+        put_fixed32_le(&index, p.size);
+        put_length_prefixed_slice(&index, Slice(p.first_key));
+        index_bytes += sizeof(L1Page) + p.first_key.size();
+    }
+    std::string footer;
+    put_fixed64_le(&footer, offset);
+    put_fixed32_le(&footer, index.size());
+    put_fixed32_le(&footer, crc32c::Value(index.data(), index.size()));
+    put_fixed64_le(&footer, num_keys);
+    put_fixed64_le(&footer, major);
+    put_fixed64_le(&footer, minor);
+    put_fixed32_le(&footer, kL1FormatVersion);
+    put_fixed32_le(&footer, kL1Magic);
+    DCHECK_EQ(kL1FooterSize, footer.size());
+    RETURN_IF_ERROR(wfile->append(index));
+    RETURN_IF_ERROR(wfile->append(footer));
+    RETURN_IF_ERROR(wfile->sync());
+    RETURN_IF_ERROR(wfile->close());
+    RETURN_IF_ERROR(env->rename_file(tmp_path, _l1_path()));
+    // The records of the log are all merged into L1 from now on, and are skipped by the replay if the log is left
+    // as is by a crash.
+    std::unique_ptr<WritableFile> log;
+    RETURN_IF_ERROR(env->new_writable_file(_l0_path(), &log));
+    RETURN_IF_ERROR(log->sync());
+    RETURN_IF_ERROR(env->sync_dir(_dir));
+    std::unique_ptr<RandomAccessFile> file;
+    RETURN_IF_ERROR(env->new_random_access_file(_l1_path(), &file));
+    LOG_IF(WARNING, num_keys != _size) << "persistent index " << _dir << " key count not match L1:" << num_keys
+                                       << " != " << _size;
+
+    _l0.clear();
+    _l0_bytes = 0;
+    _l0_log = std::move(log);
+    _l1_major = major;
+    _l1_minor = minor;
+    _l1_size = num_keys;
+    _l1_pages = std::move(pages);
+    _l1_index_bytes = index_bytes;
+    _l1_file = std::move(file);
+    VLOG(1) << "write persistent index " << _l1_path() << " version:" << major << "." << minor
+            << " #key:" << num_keys << " #page:" << _l1_pages.size();
+    return Status::OK();
+}
+
+size_t PersistentIndex::memory_usage() const {
+    return _l0_bytes + _l0_changes.size() + _l1_index_bytes;
+}
+
+std::string PersistentIndex::memory_info() const {
+    return strings::Substitute("$0M(l0:$1 l1:$2/$3 pages)", memory_usage() / (1024 * 1024), _l0.size(), _l1_size,
+                               _l1_pages.size());
+}
+
+} // namespace starrocks
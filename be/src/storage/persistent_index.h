@@ -0,0 +1,133 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "util/phmap/phmap.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+class RandomAccessFile;
+class WritableFile;
+struct EditVersion;
+
+// PersistentIndex maps the encoded primary keys of a tablet to their positions, rssid in the high 32 bits and rowid
+// in the low, in two layers kept in the tablet directory, so that the primary index is neither rebuilt from all the
+// segments of the tablet at every load nor held wholly in memory:
+//  - L1 is an immutable file of all the keys sorted, in pages, of which only the first key of every page is held in
+//    memory, and the pages of the keys looked up are read on demand.
+//  - L0 is an in-memory hash map of the keys changed since L1 was written, erased ones included, which is made
+//    durable by an append-only log of the changes of every commit, replayed on load.
+// Once L0 is larger than config::persistent_index_l0_max_mem_usage, a commit merges it into a new L1 and truncates
+// the log. Every commit is tagged with the edit version of the tablet it is made at, and a load only accepts the
+// files reaching exactly the applied version of the tablet, otherwise the index has to be rebuilt.
+//
+// [not thread-safe]
+class PersistentIndex {
+public:
+    // The value of the keys not in the index.
+    static constexpr uint64_t NullValue = std::numeric_limits<uint64_t>::max();
+
+    explicit PersistentIndex(std::string dir);
+    ~PersistentIndex();
+
+    // Open the L1 file and replay the L0 log in the directory up to |version|. NotFound if there are no files, or
+    // they are at a version other than |version|, in which case the index is left empty to be rebuilt.
+    Status load(const EditVersion& version);
+
+    // Clear the index and remove its files.
+    Status reset();
+
+    // Remove the files of the index in |dir|, which are no longer valid once the rowsets of the tablet are replaced.
+    static Status remove_files(const std::string& dir);
+
+    // The values of the |n| keys, NullValue for the ones not in the index.
+    Status get(size_t n, const Slice* keys, uint64_t* values) const;
+
+    // Insert the keys, which must not be in the index.
+    Status insert(size_t n, const Slice* keys, const uint64_t* values);
+
+    // Insert or assign the keys, and save their old values into |old_values|, NullValue for the new keys.
+    Status upsert(size_t n, const Slice* keys, const uint64_t* values, uint64_t* old_values);
+
+    // Assign the keys whose current rssid is |src_rssids|, and append the indexes of the others into |failed|.
+    Status try_replace(size_t n, const Slice* keys, const uint64_t* values, const uint32_t* src_rssids,
+                       std::vector<uint32_t>* failed);
+
+    // Erase the keys, and save their old values into |old_values|, NullValue for the ones not in the index.
+    Status erase(size_t n, const Slice* keys, uint64_t* old_values);
+
+    // Make the changes since the last commit durable as of |version|. The files are removed on failure, the index
+    // in memory is still valid.
+    Status commit(const EditVersion& version);
+
+    // The number of keys in the index.
+    size_t size() const { return _size; }
+
+    // The memory of L0 and of the first keys of the pages of L1.
+    size_t memory_usage() const;
+
+    std::string memory_info() const;
+
+private:
+    struct L1Page {
+        uint64_t offset = 0;
+        uint32_t size = 0;
+        std::string first_key;
+    };
+
+    std::string _l1_path() const { return _dir + "/primary_index.l1"; }
+    std::string _l0_path() const { return _dir + "/primary_index.l0"; }
+
+    Status _load_l1();
+    // Replay the records of the log from the version of L1 to |major|.|minor|, and set |*clean| to false if the log
+    // has records after it.
+    Status _replay_l0(int64_t major, int64_t minor, bool* clean);
+
+    void _clear();
+
+    // The values in L1 of the keys not in L0, by reading the pages they are in, and NullValue for the others, which
+    // are read from L0 by |_get_from_l0| instead, since L0 keeps its keys till it is merged into L1.
+    Status _get_from_l1(size_t n, const Slice* keys, uint64_t* values) const;
+    Status _read_l1_page(size_t page, std::string* buf, std::vector<std::pair<Slice, uint64_t>>* entries) const;
+    uint64_t _get_from_l0(const Slice& key, uint64_t l1_value) const;
+
+    void _put_l0(const Slice& key, uint64_t value);
+    // Put the key into L0 and add it to the changes of the next commit.
+    void _set_l0(const Slice& key, uint64_t value);
+
+    Status _append_l0_log(int64_t major, int64_t minor);
+    Status _write_l1(int64_t major, int64_t minor);
+
+    std::string _dir;
+
+    // The version of the last commit.
+    int64_t _major = 0;
+    int64_t _minor = 0;
+    size_t _size = 0;
+
+    // L0: the keys changed since L1 was written, and the changes since the last commit, encoded to be appended to
+    // the log.
+    phmap::flat_hash_map<std::string, uint64_t> _l0;
+    size_t _l0_bytes = 0;
+    std::string _l0_changes;
+    uint32_t _l0_num_changes = 0;
+    std::unique_ptr<WritableFile> _l0_log;
+
+    // L1
+    int64_t _l1_major = 0;
+    int64_t _l1_minor = 0;
+    size_t _l1_size = 0;
+    std::vector<L1Page> _l1_pages;
+    size_t _l1_index_bytes = 0;
+    std::unique_ptr<RandomAccessFile> _l1_file;
+};
+
+} // namespace starrocks
@@ -3,7 +3,11 @@
 #include "storage/primary_index.h"
 
 #include <mutex>
+#include <tuple>
 
+#include "column/binary_column.h"
+#include "common/config.h"
+#include "storage/persistent_index.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset.h"
@@ -12,7 +16,9 @@
 #include "storage/tablet_updates.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/reader.h"
+#include "util/countdown_latch.h"
 #include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -48,6 +54,11 @@ public:
     virtual void try_replace(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
                              const vector<uint32_t>& src_rssid, vector<uint32_t>* failed) = 0;
     virtual void erase(const vectorized::Column& pks, DeletesMap* deletes) = 0;
+    virtual void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const = 0;
+
+    // The keys of a shard are all in one submap of the hash map, updated by the methods above without touching the
+    // others, so that the shards are updated concurrently. |shards| is the shard of every key of |pks|.
+    virtual void get_shards(const vectorized::Column& pks, vector<uint8_t>* shards) const = 0;
 
     // just an estimate value for now.
     virtual std::size_t memory_usage() const = 0;
@@ -89,6 +100,9 @@ public:
 
 const uint32_t PREFETCHN = 8;
 
+// The rowsets of fewer keys are applied by the apply thread alone.
+static const size_t kMinKeysToUpsertConcurrently = 65536;
+
 template <typename Key>
 class HashIndexImpl : public HashIndex {
 private:
@@ -247,6 +261,24 @@ public:
         }
     }
 
+    void get_shards(const vectorized::Column& pks, vector<uint8_t>* shards) const override {
+        auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
+        shards->resize(pks.size());
+        for (size_t i = 0; i < pks.size(); i++) {
+            (*shards)[i] = _map.subidx(_map.hash(keys[i]));
+        }
+    }
+
+    void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const override {
+        auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
+        auto size = pks.size();
+        rowids->resize(size);
+        for (auto i = 0; i < size; i++) {
+            auto iter = _map.find(keys[i]);
+            (*rowids)[i] = iter != _map.end() ? iter->second.value : PrimaryIndex::NullIndex;
+        }
+    }
+
     std::size_t memory_usage() const final {
         return _map.capacity() * (1 + (sizeof(Key) + 3) / 4 * 4 + sizeof(RowIdPack4));
     }
@@ -525,6 +557,27 @@ public:
         }
     }
 
+    void get_shards(const vectorized::Column& pks, vector<uint8_t>* shards) const override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        shards->resize(pks.size());
+        for (size_t i = 0; i < pks.size(); i++) {
+            (*shards)[i] = _map.subidx(FixSliceHash<S>()(FixSlice<S>(keys[i])));
+        }
+    }
+
+    void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        uint32_t size = pks.size();
+        rowids->resize(size);
+        FixSlice<S> key;
+        for (uint32_t i = 0; i < size; i++) {
+            key.assign(keys[i]);
+            // by the raw hash the keys are emplaced with
+            auto iter = _map.find(key, FixSliceHash<S>()(key));
+            (*rowids)[i] = iter != _map.end() ? iter->second.value : PrimaryIndex::NullIndex;
+        }
+    }
+
     std::size_t memory_usage() const final { return _map.capacity() * (1 + S * 4 + sizeof(RowIdPack4)); }
 
     std::string memory_info() const {
@@ -539,6 +592,7 @@ public:
 
 struct StringHash {
     size_t operator()(const string& v) const { return vectorized::crc_hash_64(v.data(), v.length(), 0x811C9DC5); }
+    size_t operator()(const Slice& v) const { return vectorized::crc_hash_64(v.data, v.size, 0x811C9DC5); }
 };
 
 template <>
@@ -550,7 +604,8 @@ private:
                                           phmap::NullMutex, false>;
 
     StringMap _map;
-    size_t _total_length = 0;
+    // updated by the shards concurrently
+    std::atomic<size_t> _total_length{0};
 
 public:
     HashIndexImpl() = default;
@@ -733,6 +788,25 @@ public:
         }
     }
 
+    void get_shards(const vectorized::Column& pks, vector<uint8_t>* shards) const override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        shards->resize(pks.size());
+        for (size_t i = 0; i < pks.size(); i++) {
+            // the same mixed hash as the one the map looks up the key by
+            (*shards)[i] = _map.subidx(_map.hash(keys[i]));
+        }
+    }
+
+    void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        uint32_t size = pks.size();
+        rowids->resize(size);
+        for (uint32_t i = 0; i < size; i++) {
+            auto p = _map.find(keys[i].to_string());
+            (*rowids)[i] = p != _map.end() ? p->second : PrimaryIndex::NullIndex;
+        }
+    }
+
     std::size_t memory_usage() const final {
         // TODO(cbl): more accurate value
         size_t ret = _map.capacity() * (1 + 32 + sizeof(tablet_rowid_t));
@@ -798,6 +872,32 @@ static std::unique_ptr<HashIndex> create_hash_index(FieldType key_type, size_t f
     }
 }
 
+// The encoded primary keys of |pks| as the keys of PersistentIndex.
+static void get_key_slices(const Column& pks, std::vector<Slice>* keys) {
+    keys->resize(pks.size());
+    if (pks.is_binary()) {
+        auto& binary = down_cast<const vectorized::BinaryColumn&>(pks);
+        for (size_t i = 0; i < pks.size(); i++) {
+            (*keys)[i] = binary.get_slice(i);
+        }
+    } else {
+        const uint8_t* data = pks.raw_data();
+        size_t type_size = pks.type_size();
+        for (size_t i = 0; i < pks.size(); i++) {
+            (*keys)[i] = Slice(data + i * type_size, type_size);
+        }
+    }
+}
+
+static void get_values(uint32_t rssid, uint32_t rowid_start, const vector<uint32_t>* rowids, size_t n,
+                       std::vector<uint64_t>* values) {
+    values->resize(n);
+    uint64_t base = ((uint64_t)rssid) << 32;
+    for (size_t i = 0; i < n; i++) {
+        (*values)[i] = base + (rowids != nullptr ? (*rowids)[i] : rowid_start + i);
+    }
+}
+
 PrimaryIndex::PrimaryIndex() {}
 
 PrimaryIndex::~PrimaryIndex() {
@@ -837,6 +937,7 @@ void PrimaryIndex::unload() {
     if (_pkey_to_rssid_rowid) {
         _pkey_to_rssid_rowid.reset();
     }
+    _persistent_index.reset();
     _status = Status::OK();
     _loaded = false;
 }
@@ -868,9 +969,27 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
     _set_schema(pkey_schema);
 
     int64_t apply_version = 0;
+    EditVersion apply_edit_version;
     std::vector<RowsetSharedPtr> rowsets;
     std::vector<uint32_t> rowset_ids;
-    RETURN_IF_ERROR(tablet->updates()->_get_apply_version_and_rowsets(&apply_version, &rowsets, &rowset_ids));
+    RETURN_IF_ERROR(tablet->updates()->_get_apply_version_and_rowsets(&apply_version, &rowsets, &rowset_ids,
+                                                                      &apply_edit_version));
+
+    if (config::enable_persistent_index) {
+        _pkey_to_rssid_rowid.reset();
+        _persistent_index = std::make_unique<PersistentIndex>(tablet->tablet_path());
+        auto st = _persistent_index->load(apply_edit_version);
+        if (st.ok()) {
+            _tablet_id = tablet->tablet_id();
+            LOG(INFO) << "load persistent primary index finish tablet:" << tablet->tablet_id()
+                      << " version:" << apply_edit_version << " size:" << size() << " memory:" << memory_usage()
+                      << " duration: " << timer.elapsed_time() / 1000000 << "ms";
+            return Status::OK();
+        }
+        LOG(INFO) << "rebuild persistent primary index tablet:" << tablet->tablet_id()
+                  << " version:" << apply_edit_version << " reason: " << st;
+        RETURN_IF_ERROR(_persistent_index->reset());
+    }
 
     size_t total_data_size = 0;
     size_t total_segments = 0;
@@ -892,7 +1011,7 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
                   << " #rowset:" << rowsets.size() << " #segment:" << total_segments << " #row:" << total_rows << " -"
                   << total_dels << "=" << total_rows - total_dels << " bytes:" << total_data_size;
     }
-    if (total_rows > total_dels) {
+    if (total_rows > total_dels && _pkey_to_rssid_rowid) {
         _pkey_to_rssid_rowid->reserve(total_rows - total_dels);
     }
 
@@ -956,6 +1075,9 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
         }
     }
     _tablet_id = tablet->tablet_id();
+    if (_persistent_index) {
+        RETURN_IF_ERROR(_persistent_index->commit(apply_edit_version));
+    }
     if (size() != total_rows - total_dels) {
         LOG(WARNING) << Substitute("load primary index row count not match tablet:$0 index:$1 != stats:$2", _tablet_id,
                                    size(), total_rows - total_dels);
@@ -968,56 +1090,254 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
 }
 
 Status PrimaryIndex::insert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks) {
+    if (_persistent_index) {
+        return _persistent_insert(rssid, rowid_start, nullptr, pks);
+    }
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
     return _pkey_to_rssid_rowid->insert(rssid, rowid_start, pks);
 }
 
 Status PrimaryIndex::insert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks) {
+    if (_persistent_index) {
+        return _persistent_insert(rssid, 0, &rowids, pks);
+    }
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
     return _pkey_to_rssid_rowid->insert(rssid, rowids, pks);
 }
 
-void PrimaryIndex::upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks, DeletesMap* deletes) {
+Status PrimaryIndex::upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks,
+                            DeletesMap* deletes) {
+    if (_persistent_index) {
+        return _persistent_upsert(rssid, rowid_start, nullptr, pks, deletes);
+    }
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
     _pkey_to_rssid_rowid->upsert(rssid, rowid_start, pks, deletes);
+    return Status::OK();
 }
 
-void PrimaryIndex::upsert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
-                          DeletesMap* deletes) {
+Status PrimaryIndex::upsert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                            DeletesMap* deletes) {
+    if (_persistent_index) {
+        return _persistent_upsert(rssid, 0, &rowids, pks, deletes);
+    }
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
     _pkey_to_rssid_rowid->upsert(rssid, rowids, pks, deletes);
+    return Status::OK();
 }
 
-void PrimaryIndex::try_replace(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks,
-                               const vector<uint32_t>& src_rssid, vector<uint32_t>* deletes) {
+Status PrimaryIndex::try_replace(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks,
+                                 const vector<uint32_t>& src_rssid, vector<uint32_t>* deletes) {
+    if (_persistent_index) {
+        return _persistent_try_replace(rssid, rowid_start, nullptr, pks, src_rssid, deletes);
+    }
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
     _pkey_to_rssid_rowid->try_replace(rssid, rowid_start, pks, src_rssid, deletes);
+    return Status::OK();
 }
 
-void PrimaryIndex::try_replace(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
-                               const vector<uint32_t>& src_rssid, vector<uint32_t>* deletes) {
+Status PrimaryIndex::try_replace(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                                 const vector<uint32_t>& src_rssid, vector<uint32_t>* deletes) {
+    if (_persistent_index) {
+        return _persistent_try_replace(rssid, 0, &rowids, pks, src_rssid, deletes);
+    }
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
     _pkey_to_rssid_rowid->try_replace(rssid, rowids, pks, src_rssid, deletes);
+    return Status::OK();
 }
 
-void PrimaryIndex::erase(const Column& key_col, DeletesMap* deletes) {
+Status PrimaryIndex::upsert_rowset(uint32_t rssid, const vector<std::unique_ptr<Column>>& upserts,
+                                   const vector<std::unique_ptr<Column>>& deletes, ThreadPool* pool,
+                                   DeletesMap* new_deletes) {
+    size_t num_keys = 0;
+    for (const auto& col : upserts) {
+        num_keys += col != nullptr ? col->size() : 0;
+    }
+    if (pool == nullptr || _persistent_index || num_keys < kMinKeysToUpsertConcurrently) {
+        for (uint32_t i = 0; i < upserts.size(); i++) {
+            if (upserts[i] != nullptr) {
+                RETURN_IF_ERROR(upsert(rssid + i, 0, *upserts[i], new_deletes));
+            }
+        }
+        for (const auto& col : deletes) {
+            RETURN_IF_ERROR(erase(*col, new_deletes));
+        }
+        return Status::OK();
+    }
+    DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+
+    // Split the keys of every segment by the shards, rowid_start is 0 for upsert.
+    struct ShardKeys {
+        // (segment, keys, rowids) of the upserts
+        vector<std::tuple<uint32_t, std::unique_ptr<Column>, vector<uint32_t>>> upserts;
+        vector<std::unique_ptr<Column>> deletes;
+    };
+    vector<ShardKeys> shard_keys(phmap_hash_table_shard);
+    vector<uint8_t> shards;
+    vector<vector<uint32_t>> shard_rows(phmap_hash_table_shard);
+    auto split = [&](const Column& col) {
+        _pkey_to_rssid_rowid->get_shards(col, &shards);
+        for (auto& rows : shard_rows) {
+            rows.clear();
+        }
+        for (uint32_t i = 0; i < shards.size(); i++) {
+            shard_rows[shards[i]].push_back(i);
+        }
+    };
+    auto select = [&](const Column& col, size_t shard) {
+        auto keys = col.clone_empty();
+        keys->append_selective(col, shard_rows[shard].data(), 0, shard_rows[shard].size());
+        return keys;
+    };
+    for (uint32_t i = 0; i < upserts.size(); i++) {
+        if (upserts[i] == nullptr) {
+            continue;
+        }
+        split(*upserts[i]);
+        for (size_t s = 0; s < phmap_hash_table_shard; s++) {
+            if (!shard_rows[s].empty()) {
+                shard_keys[s].upserts.emplace_back(i, select(*upserts[i], s), shard_rows[s]);
+            }
+        }
+    }
+    for (const auto& col : deletes) {
+        split(*col);
+        for (size_t s = 0; s < phmap_hash_table_shard; s++) {
+            if (!shard_rows[s].empty()) {
+                shard_keys[s].deletes.emplace_back(select(*col, s));
+            }
+        }
+    }
+
+    vector<DeletesMap> shard_deletes(phmap_hash_table_shard);
+    CountDownLatch latch(phmap_hash_table_shard);
+    for (size_t s = 0; s < phmap_hash_table_shard; s++) {
+        auto task = [&, s]() {
+            for (auto& [i, keys, rowids] : shard_keys[s].upserts) {
+                _pkey_to_rssid_rowid->upsert(rssid + i, rowids, *keys, &shard_deletes[s]);
+            }
+            for (auto& keys : shard_keys[s].deletes) {
+                _pkey_to_rssid_rowid->erase(*keys, &shard_deletes[s]);
+            }
+            latch.count_down();
+        };
+        if (!pool->submit_func(task).ok()) {
+            task();
+        }
+    }
+    latch.wait();
+
+    for (auto& deletes_of_shard : shard_deletes) {
+        for (auto& [id, rowids] : deletes_of_shard) {
+            auto& dst = (*new_deletes)[id];
+            dst.insert(dst.end(), rowids.begin(), rowids.end());
+        }
+    }
+    for (auto& [id, rowids] : *new_deletes) {
+        std::sort(rowids.begin(), rowids.end());
+    }
+    return Status::OK();
+}
+
+Status PrimaryIndex::erase(const Column& key_col, DeletesMap* deletes) {
+    if (_persistent_index) {
+        std::vector<Slice> keys;
+        get_key_slices(key_col, &keys);
+        std::vector<uint64_t> old_values(keys.size());
+        RETURN_IF_ERROR(_persistent_index->erase(keys.size(), keys.data(), old_values.data()));
+        for (uint64_t old : old_values) {
+            if (old != NullIndex) {
+                (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
+            }
+        }
+        return Status::OK();
+    }
     DCHECK(_status.ok() && _pkey_to_rssid_rowid);
     _pkey_to_rssid_rowid->erase(key_col, deletes);
+    return Status::OK();
+}
+
+Status PrimaryIndex::get(const Column& key_col, vector<uint64_t>* rowids) const {
+    if (_persistent_index) {
+        std::vector<Slice> keys;
+        get_key_slices(key_col, &keys);
+        rowids->resize(keys.size());
+        return _persistent_index->get(keys.size(), keys.data(), rowids->data());
+    }
+    DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    _pkey_to_rssid_rowid->get(key_col, rowids);
+    return Status::OK();
+}
+
+Status PrimaryIndex::commit(const EditVersion& version) {
+    return _persistent_index ? _persistent_index->commit(version) : Status::OK();
+}
+
+Status PrimaryIndex::_persistent_insert(uint32_t rssid, uint32_t rowid_start, const vector<uint32_t>* rowids,
+                                        const vectorized::Column& pks) {
+    std::vector<Slice> keys;
+    std::vector<uint64_t> values;
+    get_key_slices(pks, &keys);
+    get_values(rssid, rowid_start, rowids, keys.size(), &values);
+    return _persistent_index->insert(keys.size(), keys.data(), values.data());
+}
+
+Status PrimaryIndex::_persistent_upsert(uint32_t rssid, uint32_t rowid_start, const vector<uint32_t>* rowids,
+                                        const vectorized::Column& pks, DeletesMap* deletes) {
+    std::vector<Slice> keys;
+    std::vector<uint64_t> values;
+    get_key_slices(pks, &keys);
+    get_values(rssid, rowid_start, rowids, keys.size(), &values);
+    std::vector<uint64_t> old_values(keys.size());
+    RETURN_IF_ERROR(_persistent_index->upsert(keys.size(), keys.data(), values.data(), old_values.data()));
+    for (uint64_t old : old_values) {
+        if (old != NullIndex) {
+            (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
+        }
+    }
+    return Status::OK();
+}
+
+Status PrimaryIndex::_persistent_try_replace(uint32_t rssid, uint32_t rowid_start, const vector<uint32_t>* rowids,
+                                             const vectorized::Column& pks, const vector<uint32_t>& src_rssid,
+                                             vector<uint32_t>* failed) {
+    std::vector<Slice> keys;
+    std::vector<uint64_t> values;
+    get_key_slices(pks, &keys);
+    get_values(rssid, rowid_start, rowids, keys.size(), &values);
+    std::vector<uint32_t> failed_idxes;
+    RETURN_IF_ERROR(_persistent_index->try_replace(keys.size(), keys.data(), values.data(), src_rssid.data(),
+                                                   &failed_idxes));
+    for (uint32_t i : failed_idxes) {
+        failed->push_back((uint32_t)(values[i] & 0xffffffff));
+    }
+    return Status::OK();
 }
 
 std::size_t PrimaryIndex::memory_usage() const {
+    if (_persistent_index) {
+        return _persistent_index->memory_usage();
+    }
     return _pkey_to_rssid_rowid ? _pkey_to_rssid_rowid->memory_usage() : 0;
 }
 
 std::string PrimaryIndex::memory_info() const {
+    if (_persistent_index) {
+        return _persistent_index->memory_info();
+    }
     return _pkey_to_rssid_rowid ? _pkey_to_rssid_rowid->memory_info() : "Null";
 }
 
 std::size_t PrimaryIndex::size() const {
+    if (_persistent_index) {
+        return _persistent_index->size();
+    }
     return _pkey_to_rssid_rowid ? _pkey_to_rssid_rowid->size() : 0;
 }
 
 std::size_t PrimaryIndex::capacity() const {
+    if (_persistent_index) {
+        return _persistent_index->size();
+    }
     return _pkey_to_rssid_rowid ? _pkey_to_rssid_rowid->capacity() : 0;
 }
 
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <limits>
 #include <string>
 #include <unordered_map>
 
@@ -16,10 +17,13 @@ class Tablet;
 class TabletMeta;
 using TabletSharedPtr = std::shared_ptr<Tablet>;
 class HashIndex;
+class PersistentIndex;
+struct EditVersion;
+class ThreadPool;
 
 // An index to lookup a record's position(rowset->segment->rowid) by primary key.
 // It's only used to handle updates/deletes in the write pipeline for now.
-// Use a simple in-memory hash_map implementation for demo purpose.
+// It's an in-memory hash_map, or a PersistentIndex in the tablet directory if config::enable_persistent_index.
 class PrimaryIndex {
 public:
     using segment_rowid_t = uint32_t;
@@ -27,12 +31,16 @@ public:
     using tablet_rowid_t = uint64_t;
     using TabletRowidColumn = vectorized::UInt64Column;
 
+    // The position returned by |get| for the keys not in the index.
+    static constexpr tablet_rowid_t NullIndex = std::numeric_limits<tablet_rowid_t>::max();
+
     PrimaryIndex();
     PrimaryIndex(const vectorized::Schema& pk_schema);
     ~PrimaryIndex();
 
     // Fetch all primary keys from the tablet associated with this index into memory
-    // to build a hash index.
+    // to build a hash index, or open the persistent index of the tablet, which is rebuilt
+    // the same way if it's not at the applied version of the tablet.
     //
     // [thread-safe]
     Status load(Tablet* tablet);
@@ -53,8 +61,8 @@ public:
     // old position to |deletes|.
     //
     // [not thread-safe]
-    void upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks, DeletesMap* deletes);
-    void upsert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks, DeletesMap* deletes);
+    Status upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks, DeletesMap* deletes);
+    Status upsert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks, DeletesMap* deletes);
 
     // used for compaction, try replace input rowsets' rowid with output segment's rowid, if
     // input rowsets' rowid doesn't exist, this indicates that the row of output rowset is
@@ -65,16 +73,37 @@ public:
     // |failed| rowids of output segment's rows that failed to replace
     //
     // [not thread-safe]
-    void try_replace(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks,
-                     const vector<uint32_t>& src_rssid, vector<uint32_t>* failed);
-    void try_replace(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
-                     const vector<uint32_t>& src_rssid, vector<uint32_t>* failed);
+    Status try_replace(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks,
+                       const vector<uint32_t>& src_rssid, vector<uint32_t>* failed);
+    Status try_replace(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                       const vector<uint32_t>& src_rssid, vector<uint32_t>* failed);
+
+    // Upsert the keys of the segments of a rowset, |upserts[i]| the keys of segment |rssid| + i if not null, and
+    // then erase |deletes|, the same as upsert and erase them one by one, but concurrently on |pool| by the shards
+    // of the hash index if there are many keys.
+    //
+    // [not thread-safe]
+    Status upsert_rowset(uint32_t rssid, const vector<std::unique_ptr<vectorized::Column>>& upserts,
+                         const vector<std::unique_ptr<vectorized::Column>>& deletes, ThreadPool* pool,
+                         DeletesMap* new_deletes);
 
     // |key_col| contains the *encoded* primary keys to be deleted from this index.
     // The position of deleted keys will be appended into |new_deletes|.
     //
     // [not thread-safe]
-    void erase(const vectorized::Column& pks, DeletesMap* deletes);
+    Status erase(const vectorized::Column& pks, DeletesMap* deletes);
+
+    // |pks| contains the *encoded* primary keys to look up, the position of each key, rssid in the high 32 bits
+    // and rowid in the low, or |NullIndex| if it doesn't exist, is saved into |rowids| in the same order.
+    //
+    // [not thread-safe]
+    Status get(const vectorized::Column& pks, vector<tablet_rowid_t>* rowids) const;
+
+    // Make the changes since the last commit durable as of |version|, the edit version applied, if the index is
+    // persistent. A failure leaves the persistent index to be rebuilt at the next load, and the index in memory valid.
+    //
+    // [not thread-safe]
+    Status commit(const EditVersion& version);
 
     // [not thread-safe]
     std::size_t memory_usage() const;
@@ -93,6 +122,15 @@ public:
 private:
     void _set_schema(const vectorized::Schema& pk_schema);
 
+    // The rowid of the i-th key in |pks| is (*rowids)[i], or |rowid_start| + i if |rowids| is null.
+    Status _persistent_insert(uint32_t rssid, uint32_t rowid_start, const vector<uint32_t>* rowids,
+                              const vectorized::Column& pks);
+    Status _persistent_upsert(uint32_t rssid, uint32_t rowid_start, const vector<uint32_t>* rowids,
+                              const vectorized::Column& pks, DeletesMap* deletes);
+    Status _persistent_try_replace(uint32_t rssid, uint32_t rowid_start, const vector<uint32_t>* rowids,
+                                   const vectorized::Column& pks, const vector<uint32_t>& src_rssid,
+                                   vector<uint32_t>* failed);
+
     Status _do_load(Tablet* tablet);
 
     std::mutex _lock;
@@ -102,6 +140,7 @@ private:
     vectorized::Schema _pk_schema;
     FieldType _enc_pk_type = OLAP_FIELD_TYPE_UNKNOWN;
     std::unique_ptr<HashIndex> _pkey_to_rssid_rowid;
+    std::unique_ptr<PersistentIndex> _persistent_index;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const PrimaryIndex& o) {
@@ -28,6 +28,7 @@
 #include <memory>
 #include <set>
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
 #include "storage/rowset/beta_rowset_reader.h"
 #include "storage/rowset/vectorized/rowset_options.h"
@@ -37,10 +38,12 @@
 #include "storage/utils.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/chunk_iterator.h"
+#include "storage/vectorized/delete_bitmap_cache.h"
 #include "storage/vectorized/delete_predicates.h"
 #include "storage/vectorized/empty_iterator.h"
 #include "storage/vectorized/merge_iterator.h"
 #include "storage/vectorized/projection_iterator.h"
+#include "storage/vectorized/rowid_range_option.h"
 #include "storage/vectorized/union_iterator.h"
 
 namespace starrocks {
@@ -248,7 +251,13 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
     seg_options.block_mgr = options.block_mgr;
     seg_options.stats = options.stats;
     seg_options.ranges = options.ranges;
+    if (options.rowid_range_option != nullptr) {
+        seg_options.rowid_range = &options.rowid_range_option->rowid_range;
+    }
     seg_options.predicates = options.predicates;
+    seg_options.runtime_predicate = options.runtime_predicate;
+    seg_options.metadata_scan = options.metadata_scan;
+    seg_options.metadata_min_max_columns = options.metadata_min_max_columns;
     seg_options.use_page_cache = options.use_page_cache;
     seg_options.profile = options.profile;
     seg_options.reader_type = options.reader_type;
@@ -276,25 +285,59 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
         }
     }
 
+    // The segments whose rows deleted by many delete predicates have been materialized into bitmaps neither read
+    // the delete columns nor evaluate the predicates.
+    vectorized::DeleteBitmapCache* delete_bitmap_cache = vectorized::DeleteBitmapCache::instance();
+    std::vector<int32_t> delete_versions;
+    if (delete_bitmap_cache != nullptr && options.tablet != nullptr && options.delete_predicates != nullptr) {
+        delete_versions = options.delete_predicates->get_versions(end_version());
+    }
+    const bool use_delete_bitmaps =
+            !delete_versions.empty() &&
+            delete_versions.size() >= static_cast<size_t>(std::max(1, config::delete_bitmap_min_predicates));
+    bool has_missing_bitmaps = false;
+
     std::vector<vectorized::ChunkIteratorPtr> tmp_seg_iters;
     tmp_seg_iters.reserve(num_segments());
     for (auto& seg_ptr : segments()) {
         if (seg_ptr->num_rows() == 0) {
             continue;
         }
-        auto res = seg_ptr->new_iterator(segment_schema, seg_options);
+        if (options.rowid_range_option != nullptr && seg_ptr->id() != options.rowid_range_option->segment_id) {
+            continue;
+        }
+        DelVectorPtr delete_bitmap;
+        if (use_delete_bitmaps) {
+            delete_bitmap = delete_bitmap_cache->lookup(
+                    vectorized::DeleteBitmapCache::key(rowset_id(), seg_ptr->id(), delete_versions));
+            has_missing_bitmaps |= delete_bitmap == nullptr;
+        }
+        vectorized::SegmentReadOptions bitmap_options;
+        if (delete_bitmap != nullptr) {
+            bitmap_options = seg_options;
+            bitmap_options.delete_predicates = vectorized::DisjunctivePredicates();
+            bitmap_options.delete_bitmap = std::move(delete_bitmap);
+        }
+        const bool read_delete_columns =
+                bitmap_options.delete_bitmap == nullptr && segment_schema.num_fields() > schema.num_fields();
+        auto res = bitmap_options.delete_bitmap != nullptr ? seg_ptr->new_iterator(schema, bitmap_options)
+                                                           : seg_ptr->new_iterator(segment_schema, seg_options);
         if (res.status().is_end_of_file()) {
             continue;
         }
         if (!res.ok()) {
             return res.status();
         }
-        if (segment_schema.num_fields() > schema.num_fields()) {
+        if (read_delete_columns) {
             tmp_seg_iters.emplace_back(vectorized::new_projection_iterator(schema, std::move(res).value()));
         } else {
             tmp_seg_iters.emplace_back(std::move(res).value());
         }
     }
+    if (has_missing_bitmaps && options.reader_type == READER_QUERY) {
+        delete_bitmap_cache->materialize(options.tablet, std::static_pointer_cast<BetaRowset>(shared_from_this()),
+                                         std::move(delete_versions));
+    }
 
     auto this_rowset = shared_from_this();
     if (tmp_seg_iters.empty()) {
@@ -43,8 +43,10 @@
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/merge_iterator.h"
 #include "storage/vectorized/type_utils.h"
+#include "util/countdown_latch.h"
 #include "util/defer_op.h"
 #include "util/pretty_printer.h"
+#include "util/threadpool.h"
 
 namespace starrocks {
 
@@ -66,6 +68,7 @@ BetaRowsetWriter::~BetaRowsetWriter() {
     // TODO(lingbin): Should wrapper exception logic, no need to know file ops directly.
     if (!_already_built) {       // abnormal exit, remove all files generated
         _segment_writer.reset(); // ensure all files are closed
+        _segment_writers.clear();
         if (_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS) {
             for (const auto& tmp_segment_file : _tmp_segment_files) {
                 // Even if an error is encountered, these files that have not been cleaned up
@@ -124,13 +127,13 @@ BetaRowsetWriter::~BetaRowsetWriter() {
 }
 
 OLAPStatus BetaRowsetWriter::init() {
-    DCHECK(!(_context.tablet_schema->contains_format_v1_column() &&
-             _context.tablet_schema->contains_format_v2_column()));
+    const TabletSchema& written_schema = _written_schema();
+    DCHECK(!(written_schema.contains_format_v1_column() && written_schema.contains_format_v2_column()));
     auto real_data_format = _context.storage_format_version;
     auto tablet_format = real_data_format;
-    if (_context.tablet_schema->contains_format_v1_column()) {
+    if (written_schema.contains_format_v1_column()) {
         tablet_format = kDataFormatV1;
-    } else if (_context.tablet_schema->contains_format_v2_column()) {
+    } else if (written_schema.contains_format_v2_column()) {
         tablet_format = kDataFormatV2;
     }
 
@@ -140,7 +143,7 @@ OLAPStatus BetaRowsetWriter::init() {
     // be different from the tablet schema, so here we create a new schema matched with the
     // real data format to init `SegmentWriter`.
     if (real_data_format != tablet_format) {
-        _rowset_schema = _context.tablet_schema->convert_to_format(real_data_format);
+        _rowset_schema = written_schema.convert_to_format(real_data_format);
     }
 
     _rowset_meta = std::make_shared<RowsetMeta>();
@@ -160,6 +163,9 @@ OLAPStatus BetaRowsetWriter::init() {
         _rowset_meta->set_version_hash(_context.version_hash);
     }
     _rowset_meta->set_tablet_uid(_context.tablet_uid);
+    if (_context.partial_update_tablet_schema != nullptr) {
+        _rowset_meta->set_partial_update_column_ids(_context.partial_update_column_ids);
+    }
     return OLAP_SUCCESS;
 }
 
@@ -240,7 +246,8 @@ Status BetaRowsetWriter::_final_merge() {
     MonotonicStopWatch timer;
     timer.start();
 
-    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(*_context.tablet_schema);
+    const TabletSchema& written_schema = _written_schema();
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(written_schema);
 
     std::vector<vectorized::ChunkIteratorPtr> seg_iterators;
     seg_iterators.reserve(_num_segment);
@@ -260,7 +267,7 @@ Status BetaRowsetWriter::_final_merge() {
         std::shared_ptr<segment_v2::Segment> segment;
 
         auto s = segment_v2::Segment::open(&tracker, fs::fs_util::block_manager(), tmp_segment_file, seg_id,
-                                           _context.tablet_schema, &segment);
+                                           &written_schema, &segment);
         if (!s.ok()) {
             LOG(WARNING) << "Fail to open segment=" << tmp_segment_file
                          << " of rowset=" << _context.rowset_path_prefix + "/" + _context.rowset_id.to_string() << ", "
@@ -306,7 +313,7 @@ Status BetaRowsetWriter::_final_merge() {
         if (st.is_end_of_file()) {
             break;
         } else if (st.ok()) {
-            vectorized::ChunkHelper::padding_char_columns(char_field_indexes, schema, *_context.tablet_schema, chunk);
+            vectorized::ChunkHelper::padding_char_columns(char_field_indexes, schema, written_schema, chunk);
             total_rows += chunk->num_rows();
             total_chunk++;
             add_chunk(*chunk);
@@ -390,7 +397,7 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     return rowset;
 }
 
-std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer() {
+std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer(const std::vector<uint32_t>* column_indexes) {
     std::lock_guard<std::mutex> l(_lock);
     std::string path;
     if (_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS && _context.segments_overlap != NONOVERLAPPING) {
@@ -414,11 +421,12 @@ std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer() {
     segment_v2::SegmentWriterOptions writer_options;
     writer_options.storage_format_version = _context.storage_format_version;
     writer_options.mem_tracker = _context.mem_tracker;
-    const auto* schema = _rowset_schema != nullptr ? _rowset_schema.get() : _context.tablet_schema;
+    const auto* schema = _rowset_schema != nullptr ? _rowset_schema.get() : &_written_schema();
     std::unique_ptr<SegmentWriter> segment_writer =
             std::make_unique<segment_v2::SegmentWriter>(std::move(wblock), _num_segment, schema, writer_options);
     // TODO set write_mbytes_per_sec based on writer type (load/base compaction/cumulative compaction)
-    auto s = segment_writer->init(config::push_write_mbytes_per_sec);
+    auto s = column_indexes == nullptr ? segment_writer->init(config::push_write_mbytes_per_sec)
+                                       : segment_writer->init(*column_indexes, true);
     if (!s.ok()) {
         LOG(WARNING) << "Fail to init segment writer, " << s.to_string();
         segment_writer.reset(nullptr);
@@ -442,7 +450,7 @@ OLAPStatus BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::S
         _total_index_size += index_size;
     }
     if (_src_rssids) {
-        Status st = _flush_src_rssids();
+        Status st = _flush_src_rssids((*segment_writer)->segment_id());
         if (!st.ok()) {
             LOG(WARNING) << "_flush_src_rssids error: " << st.to_string();
             return OLAP_ERR_IO_ERROR;
@@ -452,9 +460,8 @@ OLAPStatus BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::S
     return OLAP_SUCCESS;
 }
 
-Status BetaRowsetWriter::_flush_src_rssids() {
-    auto path = BetaRowset::segment_srcrssid_file_path(_context.rowset_path_prefix, _context.rowset_id,
-                                                       _segment_writer->segment_id());
+Status BetaRowsetWriter::_flush_src_rssids(uint32_t segment_id) {
+    auto path = BetaRowset::segment_srcrssid_file_path(_context.rowset_path_prefix, _context.rowset_id, segment_id);
     std::unique_ptr<fs::WritableBlock> wblock;
     fs::CreateBlockOptions opts({path});
     Status st = _context.block_mgr->create_block(opts, &wblock);
@@ -522,7 +529,149 @@ OLAPStatus BetaRowsetWriter::add_chunk_with_rssid(const vectorized::Chunk& chunk
     return OLAP_SUCCESS;
 }
 
+OLAPStatus BetaRowsetWriter::add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                                         bool is_key) {
+    const size_t num_rows = chunk.num_rows();
+    if (is_key) {
+        DCHECK(!_vertical_keys_flushed);
+        // The segments are split by the size of the key columns, scaled by the width of the rows.
+        const size_t num_columns = _context.tablet_schema->num_columns();
+        if (_segment_writers.empty() ||
+            _segment_writers.back()->estimate_segment_size() * num_columns / column_indexes.size() >=
+                    MAX_SEGMENT_SIZE ||
+            _segment_writers.back()->num_rows_written() + num_rows >= _context.max_rows_per_segment) {
+            if (!_segment_writers.empty()) {
+                RETURN_NOT_OK(_flush_columns(_segment_writers.back().get(), true));
+            }
+            auto segment_writer = _create_segment_writer(&column_indexes);
+            if (segment_writer == nullptr) {
+                return OLAP_ERR_INIT_FAILED;
+            }
+            _segment_writers.emplace_back(std::move(segment_writer));
+        }
+        auto s = _segment_writers.back()->append_chunk(chunk);
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to append chunk, " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        _num_rows_written += num_rows;
+        _total_row_size += chunk.bytes_usage();
+        return OLAP_SUCCESS;
+    }
+
+    DCHECK(_vertical_keys_flushed);
+    // The rows are of the segments from |_vertical_segment| on, in the order of their keys.
+    size_t offset = 0;
+    while (offset < num_rows) {
+        if (_vertical_segment >= _segment_writers.size()) {
+            LOG(WARNING) << "Fail to append columns, more rows than the keys";
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        SegmentWriter* segment_writer = _segment_writers[_vertical_segment].get();
+        if (!_vertical_columns_inited) {
+            auto s = segment_writer->init(column_indexes, false);
+            if (!s.ok()) {
+                LOG(WARNING) << "Fail to init segment writer, " << s.to_string();
+                return OLAP_ERR_INIT_FAILED;
+            }
+            _vertical_columns_inited = true;
+        }
+        size_t n = std::min<size_t>(segment_writer->num_rows_written() - segment_writer->num_rows_of_columns(),
+                                    num_rows - offset);
+        Status s;
+        if (n == num_rows) {
+            s = segment_writer->append_chunk(chunk);
+        } else {
+            auto part = chunk.clone_empty(n);
+            part->append(chunk, offset, n);
+            s = segment_writer->append_chunk(*part);
+        }
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to append chunk, " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        offset += n;
+        if (segment_writer->num_rows_of_columns() == segment_writer->num_rows_written()) {
+            RETURN_NOT_OK(_flush_columns(segment_writer, false));
+            _vertical_segment++;
+            _vertical_columns_inited = false;
+        }
+    }
+    _total_row_size += chunk.bytes_usage();
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::add_columns_with_rssid(const vectorized::Chunk& chunk,
+                                                    const std::vector<uint32_t>& column_indexes,
+                                                    const vector<uint32_t>& rssid) {
+    RETURN_NOT_OK(add_columns(chunk, column_indexes, true));
+    if (!_src_rssids) {
+        _src_rssids = std::make_unique<vector<uint32_t>>();
+    }
+    _src_rssids->insert(_src_rssids->end(), rssid.begin(), rssid.end());
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::_flush_columns(SegmentWriter* segment_writer, bool is_key) {
+    uint64_t index_size = 0;
+    Status s = segment_writer->finalize_columns(&index_size);
+    if (!s.ok()) {
+        LOG(WARNING) << "Fail to finalize columns of segment, " << s.to_string();
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+    }
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _total_index_size += index_size;
+    }
+    // the src rssids of the rows of a segment are flushed along with its keys.
+    if (is_key && _src_rssids) {
+        Status st = _flush_src_rssids(segment_writer->segment_id());
+        if (!st.ok()) {
+            LOG(WARNING) << "_flush_src_rssids error: " << st.to_string();
+            return OLAP_ERR_IO_ERROR;
+        }
+    }
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::flush_columns() {
+    if (!_vertical_keys_flushed) {
+        if (!_segment_writers.empty()) {
+            RETURN_NOT_OK(_flush_columns(_segment_writers.back().get(), true));
+        }
+        _vertical_keys_flushed = true;
+    } else if (_vertical_segment != _segment_writers.size()) {
+        LOG(WARNING) << "Fail to flush columns, fewer rows than the keys";
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+    }
+    _vertical_segment = 0;
+    _vertical_columns_inited = false;
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::final_flush() {
+    for (auto& segment_writer : _segment_writers) {
+        uint64_t segment_size = 0;
+        Status s = segment_writer->finalize_footer(&segment_size);
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to finalize segment, " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        std::lock_guard<std::mutex> l(_lock);
+        _total_data_size += segment_size;
+    }
+    _segment_writers.clear();
+    _vertical_keys_flushed = false;
+    return OLAP_SUCCESS;
+}
+
 OLAPStatus BetaRowsetWriter::flush_chunk(const vectorized::Chunk& chunk) {
+    const size_t split_rows = config::memtable_flush_segment_split_rows;
+    if (_context.encode_pool != nullptr && split_rows > 0 && chunk.num_rows() > split_rows &&
+        _context.tablet_schema->keys_type() != KeysType::PRIMARY_KEYS) {
+        return _flush_chunk_concurrently(chunk, split_rows);
+    }
+
     // create segment writer
     std::unique_ptr<segment_v2::SegmentWriter> segment_writer = _create_segment_writer();
     if (segment_writer == nullptr) {
@@ -530,7 +679,7 @@ OLAPStatus BetaRowsetWriter::flush_chunk(const vectorized::Chunk& chunk) {
     }
 
     // append chunk
-    auto s = segment_writer->append_chunk(chunk);
+    auto s = segment_writer->append_chunk(chunk, _context.encode_pool);
     if (!s.ok()) {
         LOG(WARNING) << "Fail to append chunk, " << s.to_string();
         return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
@@ -546,6 +695,51 @@ OLAPStatus BetaRowsetWriter::flush_chunk(const vectorized::Chunk& chunk) {
     return OLAP_SUCCESS;
 }
 
+// The segments are created in the order of the rows, so that the ids of the segments are in the order of their rows,
+// and then the rows of every segment are encoded, compressed and written by a task of the encode pool.
+OLAPStatus BetaRowsetWriter::_flush_chunk_concurrently(const vectorized::Chunk& chunk, size_t split_rows) {
+    const size_t num_segments = (chunk.num_rows() + split_rows - 1) / split_rows;
+    std::vector<std::unique_ptr<segment_v2::SegmentWriter>> segment_writers(num_segments);
+    for (auto& segment_writer : segment_writers) {
+        segment_writer = _create_segment_writer();
+        if (segment_writer == nullptr) {
+            return OLAP_ERR_INIT_FAILED;
+        }
+    }
+
+    std::vector<OLAPStatus> statuses(num_segments, OLAP_SUCCESS);
+    CountDownLatch latch(num_segments);
+    for (size_t i = 0; i < num_segments; ++i) {
+        auto flush = [this, &chunk, &segment_writers, &statuses, &latch, split_rows, i]() {
+            size_t from = i * split_rows;
+            size_t count = std::min(split_rows, chunk.num_rows() - from);
+            auto segment_chunk = chunk.clone_empty_with_schema(count);
+            segment_chunk->append(chunk, from, count);
+            auto s = segment_writers[i]->append_chunk(*segment_chunk);
+            if (!s.ok()) {
+                LOG(WARNING) << "Fail to append chunk, " << s.to_string();
+                statuses[i] = OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+            } else {
+                statuses[i] = _flush_segment_writer(&segment_writers[i]);
+            }
+            latch.count_down();
+        };
+        if (!_context.encode_pool->submit_func(flush).ok()) {
+            flush();
+        }
+    }
+    latch.wait();
+    for (OLAPStatus st : statuses) {
+        RETURN_NOT_OK(st);
+    }
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _num_rows_written += chunk.num_rows();
+        _total_row_size += chunk.bytes_usage();
+    }
+    return OLAP_SUCCESS;
+}
+
 OLAPStatus BetaRowsetWriter::flush_chunk_with_deletes(const vectorized::Chunk& upserts,
                                                       const vectorized::Column& deletes) {
     if (!deletes.empty()) {
@@ -54,6 +54,16 @@ public:
 
     OLAPStatus add_chunk_with_rssid(const vectorized::Chunk& chunk, const vector<uint32_t>& rssid);
 
+    OLAPStatus add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                           bool is_key) override;
+
+    OLAPStatus add_columns_with_rssid(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                                      const vector<uint32_t>& rssid) override;
+
+    OLAPStatus flush_columns() override;
+
+    OLAPStatus final_flush() override;
+
     OLAPStatus flush_chunk(const vectorized::Chunk& chunk) override;
 
     virtual OLAPStatus flush_chunk_with_deletes(const vectorized::Chunk& upserts,
@@ -81,13 +91,24 @@ private:
     template <typename RowType>
     OLAPStatus _add_row(const RowType& row);
 
-    std::unique_ptr<segment_v2::SegmentWriter> _create_segment_writer();
+    // Create a writer of all the columns, or of the key columns |column_indexes| only.
+    std::unique_ptr<segment_v2::SegmentWriter> _create_segment_writer(
+            const std::vector<uint32_t>* column_indexes = nullptr);
 
     OLAPStatus _flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* segment_writer);
-    Status _flush_src_rssids();
+    // Flush |chunk| into the segments of |split_rows| rows, written concurrently by the encode pool.
+    OLAPStatus _flush_chunk_concurrently(const vectorized::Chunk& chunk, size_t split_rows);
+    OLAPStatus _flush_columns(segment_v2::SegmentWriter* segment_writer, bool is_key);
+    Status _flush_src_rssids(uint32_t segment_id);
 
     Status _final_merge();
 
+    // The schema of the columns in the segments, the updated ones only of a partial update.
+    const TabletSchema& _written_schema() const {
+        return _context.partial_update_tablet_schema != nullptr ? *_context.partial_update_tablet_schema
+                                                                : *_context.tablet_schema;
+    }
+
     RowsetWriterContext _context;
     std::shared_ptr<RowsetMeta> _rowset_meta;
     std::unique_ptr<TabletSchema> _rowset_schema;
@@ -96,6 +117,12 @@ private:
     vector<bool> _segment_has_deletes;
     vector<std::string> _tmp_segment_files;
     std::unique_ptr<segment_v2::SegmentWriter> _segment_writer;
+    // The segments written by the groups of columns, see add_columns(). The value columns of a group are being
+    // written to |_segment_writers[_vertical_segment]|, whose writers are inited iff |_vertical_columns_inited|.
+    std::vector<std::unique_ptr<segment_v2::SegmentWriter>> _segment_writers;
+    size_t _vertical_segment = 0;
+    bool _vertical_columns_inited = false;
+    bool _vertical_keys_flushed = false;
     // mutex lock for vectorized add chunk and flush
     std::mutex _lock;
 
@@ -33,6 +33,7 @@
 #include "runtime/mem_tracker.h"
 #include "storage/rowset/rowset_meta.h"
 #include "storage/vectorized/chunk_iterator.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -180,6 +181,15 @@ public:
     int64_t num_segments() const { return rowset_meta()->num_segments(); }
     uint32_t num_delete_files() const { return rowset_meta()->get_num_delete_files(); }
 
+    // Count a read of the rowset by a query, see StorageTiering.
+    void record_read() {
+        _num_reads.fetch_add(1, std::memory_order_relaxed);
+        _last_read_time.store(UnixSeconds(), std::memory_order_relaxed);
+    }
+    int64_t num_reads() const { return _num_reads.load(std::memory_order_relaxed); }
+    // In the seconds since the epoch, 0 if the rowset has not been read since the BE started.
+    int64_t last_read_time() const { return _last_read_time.load(std::memory_order_relaxed); }
+
     // remove all files in this rowset
     // TODO should we rename the method to remove_files() to be more specific?
     virtual OLAPStatus remove() = 0;
@@ -293,6 +303,8 @@ protected:
     bool _need_delete_file = false;
     // variable to indicate how many rowset readers owned this rowset
     std::atomic<uint64_t> _refs_by_reader;
+    std::atomic<int64_t> _num_reads{0};
+    std::atomic<int64_t> _last_read_time{0};
     // rowset state machine
     RowsetStateMachine _rowset_state_machine;
 };
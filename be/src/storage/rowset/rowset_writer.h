@@ -88,6 +88,26 @@ public:
         return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
     }
 
+    // Used for vertical compaction, which writes the segments by the groups of columns: the columns
+    // |column_indexes| of the rows of |chunk|. The group of the key columns, i.e, |is_key|, is written first,
+    // which decides the rows of the segments, and then each group of the value columns, of the same rows in the
+    // same order. Each group is ended by flush_columns(), and the segments are ended by final_flush().
+    virtual OLAPStatus add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                                   bool is_key) {
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+
+    // Like add_columns() of the key columns, but also writes the src rssids like add_chunk_with_rssid().
+    virtual OLAPStatus add_columns_with_rssid(const vectorized::Chunk& chunk,
+                                              const std::vector<uint32_t>& column_indexes,
+                                              const vector<uint32_t>& rssid) {
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+
+    virtual OLAPStatus flush_columns() { return OLAP_ERR_FUNC_NOT_IMPLEMENTED; }
+
+    virtual OLAPStatus final_flush() { return OLAP_ERR_FUNC_NOT_IMPLEMENTED; }
+
     // This routine is free to modify the content of |chunk|.
     virtual OLAPStatus flush_chunk(const vectorized::Chunk& chunk) = 0;
 
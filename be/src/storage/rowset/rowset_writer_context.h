@@ -30,6 +30,7 @@
 namespace starrocks {
 
 class TabletSchema;
+class ThreadPool;
 
 class RowsetWriterContext {
 public:
@@ -52,6 +53,13 @@ public:
     Env* env = Env::Default();
     fs::BlockManager* block_mgr = fs::fs_util::block_manager();
     const TabletSchema* tablet_schema = nullptr;
+    // A partial update of a primary key tablet writes only the columns |partial_update_column_ids| of |tablet_schema|,
+    // whose schema is |partial_update_tablet_schema|, and the others are filled when the rowset is applied.
+    const TabletSchema* partial_update_tablet_schema = nullptr;
+    std::vector<uint32_t> partial_update_column_ids;
+    // The pool encoding the columns and segments of the flushed chunks concurrently, nullptr to encode them by the
+    // flushing thread.
+    ThreadPool* encode_pool = nullptr;
 
     RowsetId rowset_id{};
     int64_t tablet_id = 0;
@@ -0,0 +1,96 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gen_cpp/segment_v2.pb.h"
+#include "storage/rowset/segment_v2/page_builder.h"
+#include "util/faststring.h"
+
+namespace starrocks::segment_v2 {
+
+// AdaptivePageBuilder builds every data page by the page builder of the column's encoding, and re-encodes the
+// values of the page by the page builders of the other encodings at finish(), e.g. FOR_ENCODING for a page of
+// close integers or RLE for a page of long runs. A page of another encoding is kept only if it is smaller than
+// kMaxSizeRatio of the page of the column's encoding, which decodes the fastest, and its encoding is written in
+// the DataPageFooterPB of the page.
+class AdaptivePageBuilder final : public PageBuilder {
+public:
+    static constexpr double kMaxSizeRatio = 0.9;
+
+    using Candidate = std::pair<EncodingTypePB, std::unique_ptr<PageBuilder>>;
+
+    AdaptivePageBuilder(std::unique_ptr<PageBuilder> builder, EncodingTypePB encoding, size_t value_size,
+                        std::vector<Candidate> candidates)
+            : _builder(std::move(builder)),
+              _encoding(encoding),
+              _page_encoding(encoding),
+              _value_size(value_size),
+              _candidates(std::move(candidates)) {}
+
+    ~AdaptivePageBuilder() override = default;
+
+    void reserve_head(uint8_t head_size) override { _builder->reserve_head(head_size); }
+
+    bool is_page_full() override { return _builder->is_page_full(); }
+
+    size_t add(const uint8_t* vals, size_t count) override {
+        size_t n = _builder->add(vals, count);
+        _values.append(vals, n * _value_size);
+        return n;
+    }
+
+    faststring* finish() override {
+        faststring* page = _builder->finish();
+        _page_encoding = _encoding;
+        size_t count = _builder->count();
+        if (count == 0) {
+            return page;
+        }
+        size_t max_size = page->size() * kMaxSizeRatio;
+        for (auto& [encoding, builder] : _candidates) {
+            builder->reset();
+            if (builder->add(_values.data(), count) != count) {
+                continue;
+            }
+            faststring* candidate = builder->finish();
+            if (candidate->size() < max_size) {
+                page = candidate;
+                max_size = candidate->size();
+                _page_encoding = encoding;
+            }
+        }
+        return page;
+    }
+
+    void reset() override {
+        _builder->reset();
+        _values.clear();
+        _page_encoding = _encoding;
+    }
+
+    size_t count() const override { return _builder->count(); }
+
+    uint64_t size() const override { return _builder->size(); }
+
+    Status get_first_value(void* value) const override { return _builder->get_first_value(value); }
+
+    Status get_last_value(void* value) const override { return _builder->get_last_value(value); }
+
+    // The encoding of the page returned by the last finish().
+    EncodingTypePB page_encoding() const { return _page_encoding; }
+
+private:
+    std::unique_ptr<PageBuilder> _builder;
+    const EncodingTypePB _encoding;
+    EncodingTypePB _page_encoding;
+    const size_t _value_size;
+    std::vector<Candidate> _candidates;
+    // The values added to the current page.
+    faststring _values;
+};
+
+} // namespace starrocks::segment_v2
@@ -1,6 +1,7 @@
 #include "storage/rowset/segment_v2/binary_plain_page.h"
 
 #include "column/binary_column.h"
+#include "gutil/casts.h"
 
 namespace starrocks::segment_v2 {
 
@@ -12,6 +13,19 @@ Status BinaryPlainPageDecoder<Type>::next_batch(size_t* count, vectorized::Colum
         return Status::OK();
     }
     *count = std::min(*count, static_cast<size_t>(_num_elems - _cur_idx));
+    if constexpr (Type != OLAP_FIELD_TYPE_CHAR) {
+        // The strings of the rows are back to back in the page, which are copied at once with their offsets
+        // rebased.
+        if (dst->is_binary()) {
+            const uint32_t begin = offset(_cur_idx);
+            const uint32_t first = _cur_idx;
+            down_cast<vectorized::BinaryColumn*>(dst)->append_continuous_strings(
+                    reinterpret_cast<const uint8_t*>(&_data[begin]), *count,
+                    [this, begin, first](size_t i) { return offset(first + i + 1) - begin; });
+            _cur_idx += *count;
+            return Status::OK();
+        }
+    }
     std::vector<Slice> strs;
     strs.reserve(*count);
     size_t end = _cur_idx + *count;
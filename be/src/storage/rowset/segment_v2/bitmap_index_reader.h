@@ -53,8 +53,8 @@ class BitmapIndexReader {
 public:
     BitmapIndexReader() = default;
 
-    Status load(fs::BlockManager* block_mgr, const std::string& file_name, const BitmapIndexPB* bitmap_index_meta,
-                bool use_page_cache, bool kept_in_memory);
+    Status load(fs::BlockManager* block_mgr, const std::string& file_name, uint64_t file_id,
+                const BitmapIndexPB* bitmap_index_meta, bool use_page_cache, bool kept_in_memory);
 
     // create a new column iterator. Client should delete returned iterator
     Status new_iterator(BitmapIndexIterator** iterator);
@@ -30,38 +30,28 @@ const uint32_t BlockSplitBloomFilter::SALT[8] = {0x47b6137b, 0x44974d91, 0x8824a
                                                  0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31};
 
 void BlockSplitBloomFilter::add_hash(uint64_t hash) {
-    // most significant 32 bit mod block size as block index(BTW:block size is
-    // power of 2)
     DCHECK(_num_bytes >= BYTES_PER_BLOCK);
-    uint32_t block_size = _num_bytes / BYTES_PER_BLOCK;
-    uint32_t block_index = (uint32_t)(hash >> 32) & (block_size - 1);
-    uint32_t key = (uint32_t)hash;
+    _add_hash(hash);
+}
+
+bool BlockSplitBloomFilter::test_hash(uint64_t hash) const {
+    return _test_hash(hash);
+}
 
-    // Calculate masks for bucket.
-    uint32_t masks[8];
-    _set_masks(key, masks);
-    uint32_t* block_offset = (uint32_t*)(_data + BYTES_PER_BLOCK * block_index);
-    for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
-        *(block_offset + i) |= masks[i];
+void BlockSplitBloomFilter::add_hashes(const uint64_t* hashes, size_t count) {
+    DCHECK(_num_bytes >= BYTES_PER_BLOCK);
+    for (size_t i = 0; i < count; i++) {
+        _add_hash(hashes[i]);
     }
 }
 
-bool BlockSplitBloomFilter::test_hash(uint64_t hash) const {
-    // most significant 32 bit mod block size as block index(BTW:block size is
-    // power of 2)
-    uint32_t block_size = _num_bytes / BYTES_PER_BLOCK;
-    uint32_t block_index = (uint32_t)(hash >> 32) & (block_size - 1);
-    uint32_t key = (uint32_t)hash;
-    // Calculate masks for bucket.
-    uint32_t masks[BITS_SET_PER_BLOCK];
-    _set_masks(key, masks);
-    uint32_t* block_offset = (uint32_t*)(_data + BYTES_PER_BLOCK * block_index);
-    for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
-        if ((*(block_offset + i) & masks[i]) == 0) {
-            return false;
+bool BlockSplitBloomFilter::test_any_hash(const uint64_t* hashes, size_t count) const {
+    for (size_t i = 0; i < count; i++) {
+        if (_test_hash(hashes[i])) {
+            return true;
         }
     }
-    return true;
+    return false;
 }
 
 } // namespace segment_v2
@@ -37,7 +37,40 @@ public:
 
     bool test_hash(uint64_t hash) const override;
 
+    void add_hashes(const uint64_t* hashes, size_t count) override;
+
+    bool test_any_hash(const uint64_t* hashes, size_t count) const override;
+
 private:
+    // The tiny Bloom filter block of |hash|.
+    uint32_t* _block(uint64_t hash) const {
+        // most significant 32 bit mod block size as block index(BTW:block size is power of 2)
+        uint32_t block_size = _num_bytes / BYTES_PER_BLOCK;
+        uint32_t block_index = (uint32_t)(hash >> 32) & (block_size - 1);
+        return (uint32_t*)(_data + BYTES_PER_BLOCK * block_index);
+    }
+
+    void _add_hash(uint64_t hash) {
+        uint32_t masks[BITS_SET_PER_BLOCK];
+        _set_masks((uint32_t)hash, masks);
+        uint32_t* block_offset = _block(hash);
+        for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
+            *(block_offset + i) |= masks[i];
+        }
+    }
+
+    bool _test_hash(uint64_t hash) const {
+        uint32_t masks[BITS_SET_PER_BLOCK];
+        _set_masks((uint32_t)hash, masks);
+        const uint32_t* block_offset = _block(hash);
+        // Test all the bits at once rather than branch on each of them.
+        uint32_t missing = 0;
+        for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
+            missing |= ~*(block_offset + i) & masks[i];
+        }
+        return missing == 0;
+    }
+
     void _set_masks(uint32_t key, uint32_t* masks) const {
         for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
             // add some salt to key
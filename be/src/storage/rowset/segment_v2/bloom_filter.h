@@ -30,6 +30,7 @@
 #include "gutil/strings/substitute.h"
 #include "storage/utils.h"
 #include "util/murmur_hash3.h"
+#include "util/slice.h"
 
 namespace starrocks {
 namespace segment_v2 {
@@ -38,6 +39,9 @@ struct BloomFilterOptions {
     // false positive probablity
     double fpp = 0.05;
     HashStrategyPB strategy = HASH_MURMUR3_X64_64;
+    // the number of bytes of every n-gram of the n-gram bloom filter, which has the n-grams of the
+    // string values instead of the values. 0 if it's not an n-gram bloom filter.
+    uint32_t gram_size = 0;
 };
 
 // Base class for bloom filter
@@ -125,6 +129,20 @@ public:
         return test_hash(code);
     }
 
+    // The hashes of HASH_MURMUR3_X64_64 of the |count| values at |values|, which may be unaligned, into |hashes|.
+    template <typename T>
+    static void hash_values(const T* values, size_t count, uint64_t* hashes) {
+        for (size_t i = 0; i < count; i++) {
+            hashes[i] = murmur_hash3_x64_64_fixed<sizeof(T)>(values + i, DEFAULT_SEED);
+        }
+    }
+
+    static void hash_values(const Slice* values, size_t count, uint64_t* hashes) {
+        for (size_t i = 0; i < count; i++) {
+            murmur_hash3_x64_64(values[i].data, values[i].size, DEFAULT_SEED, hashes + i);
+        }
+    }
+
     char* data() const { return _data; }
 
     uint32_t num_bytes() const { return _num_bytes; }
@@ -138,6 +156,22 @@ public:
     virtual void add_hash(uint64_t hash) = 0;
     virtual bool test_hash(uint64_t hash) const = 0;
 
+    virtual void add_hashes(const uint64_t* hashes, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            add_hash(hashes[i]);
+        }
+    }
+
+    // Whether any of the |count| hashes at |hashes| may be in the filter.
+    virtual bool test_any_hash(const uint64_t* hashes, size_t count) const {
+        for (size_t i = 0; i < count; i++) {
+            if (test_hash(hashes[i])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
 private:
     // Compute the optimal bit number according to the following rule:
     //     m = -n * ln(fpp) / (ln(2) ^ 2)
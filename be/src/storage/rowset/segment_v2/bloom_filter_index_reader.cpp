@@ -28,7 +28,7 @@
 
 namespace starrocks::segment_v2 {
 
-Status BloomFilterIndexReader::load(fs::BlockManager* block_mgr, const std::string& file_name,
+Status BloomFilterIndexReader::load(fs::BlockManager* block_mgr, const std::string& file_name, uint64_t file_id,
                                     const BloomFilterIndexPB* bloom_filter_index_meta, bool use_page_cache,
                                     bool kept_in_memory) {
     _typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
@@ -36,7 +36,7 @@ Status BloomFilterIndexReader::load(fs::BlockManager* block_mgr, const std::stri
     _hash_strategy = bloom_filter_index_meta->hash_strategy();
     const IndexedColumnMetaPB& bf_index_meta = bloom_filter_index_meta->bloom_filter();
 
-    _bloom_filter_reader = std::make_unique<IndexedColumnReader>(block_mgr, file_name, bf_index_meta);
+    _bloom_filter_reader = std::make_unique<IndexedColumnReader>(block_mgr, file_name, file_id, bf_index_meta);
     RETURN_IF_ERROR(_bloom_filter_reader->load(use_page_cache, kept_in_memory));
     return Status::OK();
 }
@@ -50,9 +50,11 @@ Status BloomFilterIndexReader::new_iterator(std::unique_ptr<BloomFilterIndexIter
 
 Status BloomFilterIndexIterator::read_bloom_filter(rowid_t ordinal, std::unique_ptr<BloomFilter>* bf) {
     size_t num_to_read = 1;
-    std::unique_ptr<ColumnVectorBatch> cvb;
-    RETURN_IF_ERROR(ColumnVectorBatch::create(num_to_read, false, _reader->type_info(), nullptr, &cvb));
-    ColumnBlock block(cvb.get(), _pool.get());
+    // The batch is reused by the bloom filters of all the pages read by the iterator.
+    if (_cvb == nullptr) {
+        RETURN_IF_ERROR(ColumnVectorBatch::create(num_to_read, false, _reader->type_info(), nullptr, &_cvb));
+    }
+    ColumnBlock block(_cvb.get(), _pool.get());
     ColumnBlockView column_block_view(&block);
 
     RETURN_IF_ERROR(_bloom_filter_iter->seek_to_ordinal(ordinal));
@@ -54,7 +54,7 @@ class BloomFilterIndexReader {
 public:
     BloomFilterIndexReader() = default;
 
-    Status load(fs::BlockManager* block_mgr, const std::string& file_name,
+    Status load(fs::BlockManager* block_mgr, const std::string& file_name, uint64_t file_id,
                 const BloomFilterIndexPB* bloom_filter_index_meta, bool use_page_cache, bool kept_in_memory);
 
     // create a new column iterator.
@@ -90,6 +90,7 @@ private:
 
     BloomFilterIndexReader* _reader;
     std::unique_ptr<IndexedColumnIterator> _bloom_filter_iter;
+    std::unique_ptr<ColumnVectorBatch> _cvb;
     MemTracker _tracker;
     std::unique_ptr<MemPool> _pool;
 };
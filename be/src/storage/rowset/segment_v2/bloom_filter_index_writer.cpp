@@ -23,10 +23,9 @@
 
 #include <map>
 #include <memory>
+#include <unordered_set>
 
 #include "env/env.h"
-#include "runtime/mem_pool.h"
-#include "runtime/mem_tracker.h"
 #include "storage/fs/block_manager.h"
 #include "storage/rowset/segment_v2/bloom_filter.h" // for BloomFilterOptions, BloomFilter
 #include "storage/rowset/segment_v2/common.h"
@@ -40,49 +39,25 @@ namespace segment_v2 {
 
 namespace {
 
-template <typename CppType>
-struct BloomFilterTraits {
-    using ValueDict = std::set<CppType>;
-};
-
-template <>
-struct BloomFilterTraits<Slice> {
-    using ValueDict = std::set<Slice, Slice::Comparator>;
-};
-
-// supported slice types are: OLAP_FIELD_TYPE_CHAR|OLAP_FIELD_TYPE_VARCHAR
-template <FieldType type>
-constexpr bool is_slice_type() {
-    return type == OLAP_FIELD_TYPE_VARCHAR || type == OLAP_FIELD_TYPE_CHAR;
-}
-
 template <FieldType type>
 constexpr bool is_int128() {
     return type == OLAP_FIELD_TYPE_LARGEINT || type == OLAP_FIELD_TYPE_DECIMAL_V2;
 }
 
-template <FieldType type>
-inline typename CppTypeTraits<type>::CppType get_value(const typename CppTypeTraits<type>::CppType* v,
-                                                       const TypeInfoPtr& type_info, MemPool* pool) {
-    using CppType = typename CppTypeTraits<type>::CppType;
-    if constexpr (is_slice_type<type>()) {
-        CppType new_value;
-        type_info->deep_copy(&new_value, v, pool);
-        return new_value;
-    } else {
-        return unaligned_load<CppType>(v);
-    }
-}
-
-template <FieldType type>
-inline void update_bf(BloomFilter* bf, const typename CppTypeTraits<type>::CppType& v) {
-    using CppType = typename CppTypeTraits<type>::CppType;
-    if constexpr (is_slice_type<type>()) {
-        const Slice* s = reinterpret_cast<const Slice*>(&v);
-        bf->add_bytes(s->data, s->size);
-    } else {
-        bf->add_bytes(reinterpret_cast<const char*>(&v), sizeof(CppType));
+Status write_bloom_filters(fs::WritableBlock* wblock, const std::vector<std::unique_ptr<BloomFilter>>& bfs,
+                           BloomFilterIndexPB* meta) {
+    TypeInfoPtr bf_typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
+    IndexedColumnWriterOptions options;
+    options.write_ordinal_index = true;
+    options.write_value_index = false;
+    options.encoding = PLAIN_ENCODING;
+    IndexedColumnWriter bf_writer(options, bf_typeinfo, wblock);
+    RETURN_IF_ERROR(bf_writer.init());
+    for (auto& bf : bfs) {
+        Slice data(bf->data(), bf->size());
+        bf_writer.add(&data);
     }
+    return bf_writer.finish(meta->mutable_bloom_filter());
 }
 
 // Builder for bloom filter. In starrocks, bloom filter index is used in
@@ -91,30 +66,24 @@ inline void update_bf(BloomFilter* bf, const typename CppTypeTraits<type>::CppTy
 // This builder builds a bloom filter page by every data page, with a page id index.
 // Meanswhile, It adds an ordinal index to load bloom filter index according to requirement.
 //
+// The values are hashed a batch at a time as they are added, and the distinct hashes of a page are collected
+// instead of the distinct values, so that the values needn't be compared or copied.
 template <FieldType field_type>
 class BloomFilterIndexWriterImpl : public BloomFilterIndexWriter {
 public:
     using CppType = typename CppTypeTraits<field_type>::CppType;
-    using ValueDict = typename BloomFilterTraits<CppType>::ValueDict;
 
     explicit BloomFilterIndexWriterImpl(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo)
-            : _bf_options(bf_options),
-              _typeinfo(typeinfo),
-              _tracker(),
-              _pool(&_tracker),
-              _has_null(false),
-              _bf_buffer_size(0) {}
+            : _bf_options(bf_options), _typeinfo(typeinfo), _has_null(false), _bf_buffer_size(0) {
+        DCHECK_EQ(HASH_MURMUR3_X64_64, _bf_options.strategy);
+    }
 
     ~BloomFilterIndexWriterImpl() override = default;
 
     void add_values(const void* values, size_t count) override {
-        const CppType* v = (const CppType*)values;
-        for (int i = 0; i < count; ++i) {
-            if (_values.find(unaligned_load<CppType>(v)) == _values.end()) {
-                _values.insert(get_value<field_type>(v, _typeinfo, &_pool));
-            }
-            ++v;
-        }
+        _batch_hashes.resize(count);
+        BloomFilter::hash_values(reinterpret_cast<const CppType*>(values), count, _batch_hashes.data());
+        _hashes.insert(_batch_hashes.begin(), _batch_hashes.end());
     }
 
     void add_nulls(uint32_t count) override { _has_null |= (count > 0); }
@@ -122,57 +91,101 @@ public:
     Status flush() override {
         std::unique_ptr<BloomFilter> bf;
         RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
-        RETURN_IF_ERROR(bf->init(_values.size(), _bf_options.fpp, _bf_options.strategy));
+        RETURN_IF_ERROR(bf->init(_hashes.size(), _bf_options.fpp, _bf_options.strategy));
         bf->set_has_null(_has_null);
-        for (auto& v : _values) {
-            update_bf<field_type>(bf.get(), v);
-        }
+        _batch_hashes.assign(_hashes.begin(), _hashes.end());
+        bf->add_hashes(_batch_hashes.data(), _batch_hashes.size());
         _bf_buffer_size += bf->size();
         _bfs.push_back(std::move(bf));
-        _values.clear();
+        _hashes.clear();
         return Status::OK();
     }
 
     Status finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) override {
-        if (!_values.empty()) {
+        if (!_hashes.empty()) {
             RETURN_IF_ERROR(flush());
         }
         index_meta->set_type(BLOOM_FILTER_INDEX);
         BloomFilterIndexPB* meta = index_meta->mutable_bloom_filter_index();
         meta->set_hash_strategy(_bf_options.strategy);
         meta->set_algorithm(BLOCK_BLOOM_FILTER);
+        return write_bloom_filters(wblock, _bfs, meta);
+    }
+
+    uint64_t size() override { return _bf_buffer_size + _hashes.size() * sizeof(uint64_t); }
+
+private:
+    BloomFilterOptions _bf_options;
+    TypeInfoPtr _typeinfo;
+    bool _has_null;
+    uint64_t _bf_buffer_size;
+    // distinct hashes of the values of the current page
+    std::unordered_set<uint64_t> _hashes;
+    std::vector<uint64_t> _batch_hashes;
+    std::vector<std::unique_ptr<BloomFilter>> _bfs;
+};
+
+// Builder for n-gram bloom filter, which has every n-gram of the string values of a data page, so that the pages
+// without a substring could be filtered out, e.g. by `LIKE '%substring%'`. The values shorter than an n-gram add
+// nothing. The distinct hashes of the n-grams are collected instead of the n-grams.
+class NgramBloomFilterIndexWriter : public BloomFilterIndexWriter {
+public:
+    explicit NgramBloomFilterIndexWriter(const BloomFilterOptions& bf_options) : _bf_options(bf_options) {
+        DCHECK_GT(_bf_options.gram_size, 0);
+        DCHECK_EQ(HASH_MURMUR3_X64_64, _bf_options.strategy);
+    }
+
+    ~NgramBloomFilterIndexWriter() override = default;
+
+    void add_values(const void* values, size_t count) override {
+        const auto* v = reinterpret_cast<const Slice*>(values);
+        const size_t gram_size = _bf_options.gram_size;
+        for (size_t i = 0; i < count; ++i, ++v) {
+            for (size_t pos = 0; pos + gram_size <= v->size; ++pos) {
+                uint64_t hash = 0;
+                murmur_hash3_x64_64(v->data + pos, gram_size, BloomFilter::DEFAULT_SEED, &hash);
+                _hashes.insert(hash);
+            }
+        }
+    }
 
-        // write bloom filters
-        TypeInfoPtr bf_typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
-        IndexedColumnWriterOptions options;
-        options.write_ordinal_index = true;
-        options.write_value_index = false;
-        options.encoding = PLAIN_ENCODING;
-        IndexedColumnWriter bf_writer(options, bf_typeinfo, wblock);
-        RETURN_IF_ERROR(bf_writer.init());
-        for (auto& bf : _bfs) {
-            Slice data(bf->data(), bf->size());
-            bf_writer.add(&data);
+    void add_nulls(uint32_t count) override { _has_null |= (count > 0); }
+
+    Status flush() override {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+        RETURN_IF_ERROR(bf->init(_hashes.size(), _bf_options.fpp, _bf_options.strategy));
+        bf->set_has_null(_has_null);
+        for (uint64_t hash : _hashes) {
+            bf->add_hash(hash);
         }
-        RETURN_IF_ERROR(bf_writer.finish(meta->mutable_bloom_filter()));
+        _bf_buffer_size += bf->size();
+        _bfs.push_back(std::move(bf));
+        _hashes.clear();
+        _has_null = false;
         return Status::OK();
     }
 
-    uint64_t size() override {
-        uint64_t total_size = _bf_buffer_size;
-        total_size += _pool.total_allocated_bytes();
-        return total_size;
+    Status finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) override {
+        if (!_hashes.empty()) {
+            RETURN_IF_ERROR(flush());
+        }
+        index_meta->set_type(NGRAM_BLOOM_FILTER_INDEX);
+        BloomFilterIndexPB* meta = index_meta->mutable_bloom_filter_index();
+        meta->set_hash_strategy(_bf_options.strategy);
+        meta->set_algorithm(BLOCK_BLOOM_FILTER);
+        meta->set_gram_size(_bf_options.gram_size);
+        return write_bloom_filters(wblock, _bfs, meta);
     }
 
+    uint64_t size() override { return _bf_buffer_size + _hashes.size() * sizeof(uint64_t); }
+
 private:
     BloomFilterOptions _bf_options;
-    TypeInfoPtr _typeinfo;
-    MemTracker _tracker;
-    MemPool _pool;
-    bool _has_null;
-    uint64_t _bf_buffer_size;
-    // distinct values
-    ValueDict _values;
+    bool _has_null = false;
+    uint64_t _bf_buffer_size = 0;
+    // distinct hashes of the n-grams of the current page
+    std::unordered_set<uint64_t> _hashes;
     std::vector<std::unique_ptr<BloomFilter>> _bfs;
 };
 
@@ -182,6 +195,13 @@ private:
 Status BloomFilterIndexWriter::create(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo,
                                       std::unique_ptr<BloomFilterIndexWriter>* res) {
     FieldType type = typeinfo->type();
+    if (bf_options.gram_size > 0) {
+        if (type != OLAP_FIELD_TYPE_CHAR && type != OLAP_FIELD_TYPE_VARCHAR) {
+            return Status::NotSupported("unsupported type for n-gram bloom filter: " + std::to_string(type));
+        }
+        *res = std::make_unique<NgramBloomFilterIndexWriter>(bf_options);
+        return Status::OK();
+    }
     switch (type) {
     case OLAP_FIELD_TYPE_SMALLINT:
         *res = std::make_unique<BloomFilterIndexWriterImpl<OLAP_FIELD_TYPE_SMALLINT>>(bf_options, typeinfo);
@@ -39,6 +39,7 @@
 #include "storage/rowset/segment_v2/binary_dict_page.h" // for BinaryDictPageDecoder
 #include "storage/rowset/segment_v2/bitmap_index_reader.h"
 #include "storage/rowset/segment_v2/bloom_filter_index_reader.h"
+#include "storage/rowset/segment_v2/decoded_page_cache.h"
 #include "storage/rowset/segment_v2/encoding_info.h" // for EncodingInfo
 #include "storage/rowset/segment_v2/page_handle.h"   // for PageHandle
 #include "storage/rowset/segment_v2/page_io.h"
@@ -135,6 +136,9 @@ Status ColumnReader::init(const ColumnMetaPB& meta) {
         case BLOOM_FILTER_INDEX:
             _bf_index_meta = &index_meta.bloom_filter_index();
             break;
+        case NGRAM_BLOOM_FILTER_INDEX:
+            _ngram_bf_index_meta = &index_meta.bloom_filter_index();
+            break;
         default:
             return Status::Corruption(
                     strings::Substitute("Bad file $0: invalid column index type $1", _file_name, index_meta.type()));
@@ -157,6 +161,7 @@ Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const Pag
     iter_opts.sanity_check();
     PageReadOptions opts;
     opts.rblock = iter_opts.rblock;
+    opts.file_id = _opts.file_id;
     opts.page_pointer = pp;
     opts.codec = _compress_codec;
     opts.stats = iter_opts.stats;
@@ -342,11 +347,70 @@ Status ColumnReader::bloom_filter(const std::vector<const vectorized::ColumnPred
     return Status::OK();
 }
 
+Status ColumnReader::ngram_bloom_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                        vectorized::SparseRange* row_ranges) {
+    vectorized::SparseRange bf_row_ranges;
+    std::unique_ptr<BloomFilterIndexIterator> bf_iter;
+    RETURN_IF_ERROR(_ngram_bloom_filter_index->new_iterator(&bf_iter));
+    const size_t gram_size = _ngram_bf_index_meta->gram_size();
+    std::set<int32_t> page_ids;
+    for (size_t i = 0; i < row_ranges->size(); ++i) {
+        vectorized::Range r = (*row_ranges)[i];
+        int64_t idx = r.begin();
+        auto iter = _ordinal_index->seek_at_or_before(r.begin());
+        while (idx < r.end()) {
+            page_ids.insert(iter.page_index());
+            idx = iter.last_ordinal() + 1;
+            iter.next();
+        }
+    }
+    for (const auto& pid : page_ids) {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
+        bool matched = true;
+        for (const auto* pred : predicates) {
+            if (pred->support_ngram_bloom_filter() && !pred->ngram_bloom_filter(bf.get(), gram_size)) {
+                matched = false;
+                break;
+            }
+        }
+        if (matched) {
+            bf_row_ranges.add(vectorized::Range(_ordinal_index->get_first_ordinal(pid),
+                                                _ordinal_index->get_last_ordinal(pid) + 1));
+        }
+    }
+    *row_ranges = row_ranges->intersection(bf_row_ranges);
+    return Status::OK();
+}
+
+void ColumnReader::get_data_pages(const vectorized::SparseRange& row_ranges, std::vector<ordinal_t>* first_ordinals,
+                                  std::vector<PagePointer>* pages) {
+    if (_ordinal_index == nullptr) {
+        return;
+    }
+    int32_t last_page_index = -1;
+    for (size_t i = 0; i < row_ranges.size(); ++i) {
+        vectorized::Range r = row_ranges[i];
+        int64_t idx = r.begin();
+        auto iter = _ordinal_index->seek_at_or_before(r.begin());
+        while (idx < r.end() && iter.valid()) {
+            // the ranges sharing a page are adjacent
+            if (iter.page_index() != last_page_index) {
+                last_page_index = iter.page_index();
+                first_ordinals->push_back(iter.first_ordinal());
+                pages->push_back(iter.page());
+            }
+            idx = iter.last_ordinal() + 1;
+            iter.next();
+        }
+    }
+}
+
 Status ColumnReader::_load_ordinal_index(bool use_page_cache, bool kept_in_memory) {
     DCHECK(_ordinal_index_meta != nullptr);
     _ordinal_index = std::make_unique<OrdinalIndexReader>();
-    Status status = _ordinal_index->load(_opts.block_mgr, _file_name, _ordinal_index_meta, _num_rows, use_page_cache,
-                                         kept_in_memory);
+    Status status = _ordinal_index->load(_opts.block_mgr, _file_name, _opts.file_id, _ordinal_index_meta, _num_rows,
+                                         use_page_cache, kept_in_memory);
     _mem_tracker->consume(_ordinal_index->mem_usage());
     return Status::OK();
 }
@@ -354,8 +418,8 @@ Status ColumnReader::_load_ordinal_index(bool use_page_cache, bool kept_in_memor
 Status ColumnReader::_load_zone_map_index(bool use_page_cache, bool kept_in_memory) {
     if (_zone_map_index_meta != nullptr) {
         _zone_map_index = std::make_unique<ZoneMapIndexReader>();
-        Status status = _zone_map_index->load(_opts.block_mgr, _file_name, _zone_map_index_meta, use_page_cache,
-                                              kept_in_memory);
+        Status status = _zone_map_index->load(_opts.block_mgr, _file_name, _opts.file_id, _zone_map_index_meta,
+                                              use_page_cache, kept_in_memory);
         _mem_tracker->consume(_zone_map_index->mem_usage());
         return status;
     }
@@ -365,8 +429,8 @@ Status ColumnReader::_load_zone_map_index(bool use_page_cache, bool kept_in_memo
 Status ColumnReader::_load_bitmap_index(bool use_page_cache, bool kept_in_memory) {
     if (_bitmap_index_meta != nullptr) {
         _bitmap_index = std::make_unique<BitmapIndexReader>();
-        Status status =
-                _bitmap_index->load(_opts.block_mgr, _file_name, _bitmap_index_meta, use_page_cache, kept_in_memory);
+        Status status = _bitmap_index->load(_opts.block_mgr, _file_name, _opts.file_id, _bitmap_index_meta,
+                                            use_page_cache, kept_in_memory);
         _mem_tracker->consume(_bitmap_index->mem_usage());
         return status;
     }
@@ -376,10 +440,18 @@ Status ColumnReader::_load_bitmap_index(bool use_page_cache, bool kept_in_memory
 Status ColumnReader::_load_bloom_filter_index(bool use_page_cache, bool kept_in_memory) {
     if (_bf_index_meta != nullptr) {
         _bloom_filter_index = std::make_unique<BloomFilterIndexReader>();
-        Status status =
-                _bloom_filter_index->load(_opts.block_mgr, _file_name, _bf_index_meta, use_page_cache, kept_in_memory);
+        Status status = _bloom_filter_index->load(_opts.block_mgr, _file_name, _opts.file_id, _bf_index_meta,
+                                                  use_page_cache, kept_in_memory);
         _mem_tracker->consume(_bloom_filter_index->mem_usage());
-        return status;
+        RETURN_IF_ERROR(status);
+    }
+    if (_ngram_bf_index_meta != nullptr) {
+        _ngram_bloom_filter_index = std::make_unique<BloomFilterIndexReader>();
+        Status status = _ngram_bloom_filter_index->load(_opts.block_mgr, _file_name, _opts.file_id,
+                                                        _ngram_bf_index_meta,
+                                                        use_page_cache, kept_in_memory);
+        _mem_tracker->consume(_ngram_bloom_filter_index->mem_usage());
+        RETURN_IF_ERROR(status);
     }
     return Status::OK();
 }
@@ -452,6 +524,21 @@ bool ColumnReader::segment_zone_map_filter(const std::vector<const vectorized::C
     return std::all_of(predicates.begin(), predicates.end(), filter);
 }
 
+Status ColumnReader::segment_zone_map_min_max(vectorized::Datum* min, vectorized::Datum* max) const {
+    if (_zone_map_index_meta == nullptr || !_zone_map_index_meta->has_segment_zone_map()) {
+        return Status::NotFound("segment zone map not found");
+    }
+    const ZoneMapPB& zm = _zone_map_index_meta->segment_zone_map();
+    min->set_null();
+    max->set_null();
+    if (!zm.has_not_null()) {
+        return Status::OK();
+    }
+    TypeInfoPtr type_info = get_type_info(delegate_type(_column_type));
+    RETURN_IF_ERROR(vectorized::datum_from_string(type_info.get(), min, zm.min(), nullptr));
+    return vectorized::datum_from_string(type_info.get(), max, zm.max(), nullptr);
+}
+
 Status ColumnReader::new_iterator(ColumnIterator** iterator) {
     if (is_scalar_type(delegate_type(_column_type))) {
         *iterator = new FileColumnIterator(this);
@@ -668,8 +755,12 @@ FileColumnIterator::~FileColumnIterator() = default;
 Status FileColumnIterator::init(const ColumnIteratorOptions& opts) {
     _opts = opts;
     RETURN_IF_ERROR(_reader->ensure_index_loaded(_opts.reader_type));
+    // enabled once the dictionary encoding has been checked, by which a page may be read.
+    bool use_decoded_page_cache =
+            opts.use_decoded_page_cache && _reader->file_id() != 0 && DecodedPageCache::instance() != nullptr;
 
     if (_reader->encoding_info()->encoding() != DICT_ENCODING) {
+        _use_decoded_page_cache = use_decoded_page_cache;
         return Status::OK();
     }
 
@@ -684,8 +775,11 @@ Status FileColumnIterator::init(const ColumnIteratorOptions& opts) {
     if (opts.check_dict_encoding) {
         if (_reader->has_all_dict_encoded()) {
             _all_dict_encoded = _reader->all_dict_encoded();
+            if (!_all_dict_encoded) {
+                _use_decoded_page_cache = use_decoded_page_cache;
+                return Status::OK();
+            }
             // if _all_dict_encoded is true, load dictionary page into memory for `dict_lookup`.
-            RETURN_IF(!_all_dict_encoded, Status::OK());
             RETURN_IF_ERROR(_load_dict_page());
         } else if (_reader->num_rows() > 0) {
             // old version segment file dost not have `all_dict_encoded`, in order to check
@@ -706,6 +800,7 @@ Status FileColumnIterator::init(const ColumnIteratorOptions& opts) {
         _dict_lookup_func = &FileColumnIterator::_do_dict_lookup<OLAP_FIELD_TYPE_VARCHAR>;
         _next_dict_codes_func = &FileColumnIterator::_do_next_dict_codes<OLAP_FIELD_TYPE_VARCHAR>;
     }
+    _use_decoded_page_cache = use_decoded_page_cache && !_all_dict_encoded;
     return Status::OK();
 }
 
@@ -797,6 +892,9 @@ Status FileColumnIterator::next_batch(size_t* n, vectorized::Column* dst) {
                 break;
             }
         }
+        if (_use_decoded_page_cache && !_page_decoded) {
+            RETURN_IF_ERROR(_decode_page(*dst));
+        }
 
         contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
         // number of rows to be read from this page
@@ -855,6 +953,13 @@ Status FileColumnIterator::_do_init_dict_decoder() {
 }
 
 Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter) {
+    if (_use_decoded_page_cache) {
+        auto page = DecodedPageCache::instance()->lookup(_reader->file_id(), iter.page().offset);
+        _page_decoded = page != nullptr;
+        if (_page_decoded) {
+            return parse_decoded_page(&_page, std::move(page), iter.page(), iter.page_index());
+        }
+    }
     PageHandle handle;
     Slice page_body;
     PageFooterPB footer;
@@ -873,6 +978,26 @@ Status FileColumnIterator::_read_data_page(const OrdinalPageIndexIterator& iter)
     return Status::OK();
 }
 
+Status FileColumnIterator::_decode_page(const vectorized::Column& prototype) {
+    DCHECK(!_page_decoded);
+    const ordinal_t offset = _page->offset();
+    auto column = prototype.clone_empty();
+    size_t num_rows = _page->num_rows();
+    RETURN_IF_ERROR(_page->seek(0));
+    RETURN_IF_ERROR(_page->read(column.get(), &num_rows));
+    DCHECK_EQ(_page->num_rows(), num_rows);
+
+    auto page = std::make_shared<DecodedPageCache::Page>();
+    page->column = std::move(column);
+    page->first_ordinal = _page->first_ordinal();
+    page->corresponding_element_ordinal = _page->corresponding_element_ordinal();
+    const PagePointer page_pointer = _page->page_pointer();
+    DecodedPageCache::instance()->insert(_reader->file_id(), page_pointer.offset, page, _reader->kept_in_memory());
+    RETURN_IF_ERROR(parse_decoded_page(&_page, std::move(page), page_pointer, _page->page_index()));
+    _page_decoded = true;
+    return _page->seek(offset);
+}
+
 Status FileColumnIterator::get_row_ranges_by_zone_map(CondColumn* cond_column, CondColumn* delete_condition,
                                                       RowRanges* row_ranges) {
     if (_reader->has_zone_map()) {
@@ -904,6 +1029,15 @@ Status FileColumnIterator::get_row_ranges_by_bloom_filter(CondColumn* cond_colum
 
 Status FileColumnIterator::get_row_ranges_by_bloom_filter(
         const std::vector<const vectorized::ColumnPredicate*>& predicates, vectorized::SparseRange* row_ranges) {
+    if (_reader->has_ngram_bloom_filter_index()) {
+        bool support = false;
+        for (const auto* pred : predicates) {
+            support = support | pred->support_ngram_bloom_filter();
+        }
+        if (support) {
+            RETURN_IF_ERROR(_reader->ngram_bloom_filter(predicates, row_ranges));
+        }
+    }
     RETURN_IF(!_reader->has_bloom_filter_index(), Status::OK());
     bool support = false;
     for (const auto* pred : predicates) {
@@ -919,6 +1053,11 @@ int FileColumnIterator::dict_lookup(const Slice& word) {
     return (this->*_dict_lookup_func)(word);
 }
 
+int FileColumnIterator::dict_size() {
+    DCHECK(all_page_dict_encoded());
+    return static_cast<int>(_dict_decoder->count());
+}
+
 Status FileColumnIterator::next_dict_codes(size_t* n, vectorized::Column* dst) {
     DCHECK(all_page_dict_encoded());
     return (this->*_next_dict_codes_func)(n, dst);
@@ -994,6 +1133,9 @@ Status FileColumnIterator::fetch_values_by_rowid(const rowid_t* rowids, size_t s
     bool contain_deleted_row = (values->delete_state() != DEL_NOT_SATISFIED);
     do {
         RETURN_IF_ERROR(seek_to_ordinal(*rowids));
+        if (_use_decoded_page_cache && !_page_decoded) {
+            RETURN_IF_ERROR(_decode_page(*values));
+        }
         contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
         auto last_rowid = implicit_cast<rowid_t>(_page->first_ordinal() + _page->num_rows());
         const rowid_t* next_page_rowid = std::lower_bound(rowids, end, last_rowid);
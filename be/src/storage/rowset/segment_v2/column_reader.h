@@ -84,6 +84,8 @@ struct ColumnReaderOptions {
     bool verify_checksum = true;
     // for in memory olap table, use DURABLE CachePriority in page cache
     bool kept_in_memory = false;
+    // unique id of the file in the page caches, see `PageReadOptions::file_id`
+    uint64_t file_id = 0;
 };
 
 struct ColumnIteratorOptions {
@@ -95,6 +97,10 @@ struct ColumnIteratorOptions {
     // check whether column pages are all dictionary encoding.
     bool check_dict_encoding = false;
 
+    // read the vectorized columns from the pages in DecodedPageCache, and put the pages decoded into it, unless
+    // the dictionary codes are read, i.e. all pages are dictionary encoding.
+    bool use_decoded_page_cache = false;
+
     void sanity_check() const {
         CHECK_NOTNULL(rblock);
         CHECK_NOTNULL(stats);
@@ -136,11 +142,15 @@ public:
 
     bool is_nullable() const { return _is_nullable; }
 
+    bool kept_in_memory() const { return _opts.kept_in_memory; }
+    uint64_t file_id() const { return _opts.file_id; }
+
     const EncodingInfo* encoding_info() const { return _encoding_info; }
 
     bool has_zone_map() const { return _zone_map_index_meta != nullptr; }
     bool has_bitmap_index() const { return _bitmap_index_meta != nullptr; }
     bool has_bloom_filter_index() const { return _bf_index_meta != nullptr; }
+    bool has_ngram_bloom_filter_index() const { return _ngram_bf_index_meta != nullptr; }
 
     // Check if this column could match `cond' using segment zone map.
     // Since segment zone map is stored in metadata, this function is fast without I/O.
@@ -179,10 +189,24 @@ public:
     // same as `match_condition`, used by vector engine.
     bool segment_zone_map_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& predicates) const;
 
+    // Parse the min and max of the non-null values from the segment-level zone map, which are left null if all
+    // the values are null. Return NotFound if there isn't a segment-level zone map.
+    Status segment_zone_map_min_max(vectorized::Datum* min, vectorized::Datum* max) const;
+
     // prerequisite: at least one predicate in |predicates| support bloom filter.
     Status bloom_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& p,
                         vectorized::SparseRange* ranges);
 
+    // prerequisite: at least one predicate in |predicates| support n-gram bloom filter.
+    // A page is filtered out if any of the predicates supporting n-gram bloom filter filters it out.
+    Status ngram_bloom_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& p,
+                              vectorized::SparseRange* ranges);
+
+    // Append the first ordinals and the pointers of the data pages holding the rows of |row_ranges|
+    // in the order of rows. Nothing is appended if the ordinal index hasn't been loaded.
+    void get_data_pages(const vectorized::SparseRange& row_ranges, std::vector<ordinal_t>* first_ordinals,
+                        std::vector<PagePointer>* pages);
+
     uint32_t version() const { return _opts.storage_format_version; }
 
     // Read and load necessary column indexes into memory if it hasn't been loaded.
@@ -244,6 +268,7 @@ private:
     const OrdinalIndexPB* _ordinal_index_meta = nullptr;
     const BitmapIndexPB* _bitmap_index_meta = nullptr;
     const BloomFilterIndexPB* _bf_index_meta = nullptr;
+    const BloomFilterIndexPB* _ngram_bf_index_meta = nullptr;
 
     // The read operation comprise of compaction, query, checksum and so on.
     // The ordinal index must be loaded before read operation.
@@ -256,6 +281,7 @@ private:
     std::unique_ptr<OrdinalIndexReader> _ordinal_index;
     std::unique_ptr<BitmapIndexReader> _bitmap_index;
     std::unique_ptr<BloomFilterIndexReader> _bloom_filter_index;
+    std::unique_ptr<BloomFilterIndexReader> _ngram_bloom_filter_index;
 
     std::vector<std::unique_ptr<ColumnReader>> _sub_readers;
 };
@@ -323,6 +349,10 @@ public:
     // NOTE: this method can be invoked only if `all_page_dict_encoded` returns true.
     virtual int dict_lookup(const Slice& word) { return -1; }
 
+    // return the number of words in the dictionary of this segment file, the codes are [0, dict_size()).
+    // NOTE: this method can be invoked only if `all_page_dict_encoded` returns true.
+    virtual int dict_size() { return 0; }
+
     // like `next_batch` but instead of return a batch of column values, this method returns a
     // batch of dictionary codes for dictionary encoded values.
     // this method can be invoked only if `all_page_dict_encoded` returns true.
@@ -398,6 +428,8 @@ public:
 
     int dict_lookup(const Slice& word) override;
 
+    int dict_size() override;
+
     Status next_dict_codes(size_t* n, vectorized::Column* dst) override;
 
     Status decode_dict_codes(const int32_t* codes, size_t size, vectorized::Column* words) override;
@@ -414,6 +446,9 @@ private:
     static void _seek_to_pos_in_page(ParsedPage* page, ordinal_t offset_in_page);
     Status _load_next_page(bool* eos);
     Status _read_data_page(const OrdinalPageIndexIterator& iter);
+    // Decode all the rows of the current page into a column like |prototype|, put it into DecodedPageCache and
+    // read the following rows from it.
+    Status _decode_page(const vectorized::Column& prototype);
 
     template <FieldType Type>
     int _do_dict_lookup(const Slice& word);
@@ -470,6 +505,10 @@ private:
     // whether all data pages are dict-encoded.
     bool _all_dict_encoded = false;
 
+    bool _use_decoded_page_cache = false;
+    // whether |_page| reads the values in DecodedPageCache.
+    bool _page_decoded = false;
+
     // variable used for array column(offset, element)
     // It's used to get element ordinal for specfied offset value.
     int64_t _element_ordinal = 0;
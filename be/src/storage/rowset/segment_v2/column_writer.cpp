@@ -21,6 +21,7 @@
 
 #include "storage/rowset/segment_v2/column_writer.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 
@@ -33,6 +34,7 @@
 #include "gutil/strings/substitute.h"
 #include "simd/simd.h"
 #include "storage/fs/block_manager.h"
+#include "storage/rowset/segment_v2/adaptive_page_builder.h"
 #include "storage/rowset/segment_v2/bitmap_index_writer.h"
 #include "storage/rowset/segment_v2/bitshuffle_page.h"
 #include "storage/rowset/segment_v2/bloom_filter.h"
@@ -356,6 +358,13 @@ Status ScalarColumnWriter::init() {
         RETURN_IF_ERROR(BloomFilterIndexWriter::create(BloomFilterOptions(), get_field()->type_info(),
                                                        &_bloom_filter_index_builder));
     }
+    if (_opts.ngram_bloom_filter_gram_size > 0) {
+        _has_index_builder = true;
+        BloomFilterOptions bf_options;
+        bf_options.gram_size = _opts.ngram_bloom_filter_gram_size;
+        RETURN_IF_ERROR(BloomFilterIndexWriter::create(bf_options, get_field()->type_info(),
+                                                       &_ngram_bloom_filter_index_builder));
+    }
     return Status::OK();
 }
 
@@ -379,6 +388,9 @@ uint64_t ScalarColumnWriter::estimate_buffer_size() {
     if (_bloom_filter_index_builder != nullptr) {
         size += _bloom_filter_index_builder->size();
     }
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        size += _ngram_bloom_filter_index_builder->size();
+    }
     return size;
 }
 
@@ -438,9 +450,41 @@ inline Status ScalarColumnWriter::set_encoding(const EncodingTypePB& encoding) {
     // because the default encoding of a data type can be changed in the future
     DCHECK_NE(_opts.meta->encoding(), DEFAULT_ENCODING);
     _page_builder.reset(page_builder);
+    _adaptive_page_builder = nullptr;
+    if (_opts.adaptive_page_encoding) {
+        _init_adaptive_page_builder(opts);
+    }
     return Status::OK();
 }
 
+// The integer, date and bool pages of BIT_SHUFFLE, FOR_ENCODING or RLE are also built by the page builders of
+// the others of them supported by the type.
+void ScalarColumnWriter::_init_adaptive_page_builder(const PageBuilderOptions& opts) {
+    static const EncodingTypePB kEncodings[] = {BIT_SHUFFLE, FOR_ENCODING, RLE};
+    const EncodingTypePB encoding = _encoding_info->encoding();
+    if (std::find(std::begin(kEncodings), std::end(kEncodings), encoding) == std::end(kEncodings)) {
+        return;
+    }
+    std::vector<AdaptivePageBuilder::Candidate> candidates;
+    for (EncodingTypePB candidate : kEncodings) {
+        const EncodingInfo* info = nullptr;
+        if (candidate == encoding || !EncodingInfo::get(_encoding_info->type(), candidate, &info).ok()) {
+            continue;
+        }
+        PageBuilder* builder = nullptr;
+        if (info->create_page_builder(opts, &builder).ok() && builder != nullptr) {
+            candidates.emplace_back(candidate, std::unique_ptr<PageBuilder>(builder));
+        }
+    }
+    if (candidates.empty()) {
+        return;
+    }
+    auto adaptive_builder = std::make_unique<AdaptivePageBuilder>(std::move(_page_builder), encoding,
+                                                                  get_field()->size(), std::move(candidates));
+    _adaptive_page_builder = adaptive_builder.get();
+    _page_builder = std::move(adaptive_builder);
+}
+
 Status ScalarColumnWriter::write_ordinal_index() {
     return _ordinal_index_builder->finish(_wblock, _opts.meta->add_indexes());
 }
@@ -461,7 +505,10 @@ Status ScalarColumnWriter::write_bitmap_index() {
 
 Status ScalarColumnWriter::write_bloom_filter_index() {
     if (_bloom_filter_index_builder != nullptr) {
-        return _bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes());
+        RETURN_IF_ERROR(_bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes()));
+    }
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes()));
     }
     return Status::OK();
 }
@@ -487,6 +534,10 @@ Status ScalarColumnWriter::finish_current_page() {
         RETURN_IF_ERROR(_bloom_filter_index_builder->flush());
     }
 
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->flush());
+    }
+
     // build data page body : encoded values + [nullmap]
     std::vector<Slice> body;
     faststring* encoded_values = _page_builder->finish();
@@ -517,6 +568,9 @@ Status ScalarColumnWriter::finish_current_page() {
     data_page_footer->set_nullmap_size(nullmap.slice().size);
     data_page_footer->set_format_version(_curr_page_format);
     data_page_footer->set_corresponding_element_ordinal(_element_ordinal);
+    if (_adaptive_page_builder != nullptr && _adaptive_page_builder->page_encoding() != _encoding_info->encoding()) {
+        data_page_footer->set_encoding(_adaptive_page_builder->page_encoding());
+    }
     // trying to compress page body
     faststring compressed_body;
     RETURN_IF_ERROR(
@@ -675,10 +729,12 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
                     INDEX_ADD_NULLS(_zone_map_index_builder, run);
                     INDEX_ADD_NULLS(_bitmap_index_builder, run);
                     INDEX_ADD_NULLS(_bloom_filter_index_builder, run);
+                    INDEX_ADD_NULLS(_ngram_bloom_filter_index_builder, run);
                 } else {
                     INDEX_ADD_VALUES(_zone_map_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bitmap_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bloom_filter_index_builder, pdata, run);
+                    INDEX_ADD_VALUES(_ngram_bloom_filter_index_builder, pdata, run);
                 }
                 pdata += get_field()->size() * run;
             }
@@ -686,6 +742,7 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
             INDEX_ADD_VALUES(_zone_map_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bitmap_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bloom_filter_index_builder, data, num_written);
+            INDEX_ADD_VALUES(_ngram_bloom_filter_index_builder, data, num_written);
         }
 
         _next_rowid += num_written;
@@ -62,18 +62,24 @@ struct ColumnWriterOptions {
     bool need_zone_map = false;
     bool need_bitmap_index = false;
     bool need_bloom_filter = false;
+    // > 0 to build an n-gram bloom filter of n-grams of this size for char/varchar
+    uint32_t ngram_bloom_filter_gram_size = 0;
     bool adaptive_page_format = false;
+    // choose the smallest of the encodings of the type for every data page, see AdaptivePageBuilder
+    bool adaptive_page_encoding = false;
     // for char/varchar will speculate encoding in append
     // for others will decide encoding in init method
     bool need_speculate_encoding = false;
 };
 
+class AdaptivePageBuilder;
 class BitmapIndexWriter;
 class EncodingInfo;
 class NullMapRLEBuilder;
 class NullMapBitshuffleBuilder;
 class OrdinalIndexWriter;
 class PageBuilder;
+class PageBuilderOptions;
 class BloomFilterIndexWriter;
 class ZoneMapIndexWriter;
 
@@ -186,6 +192,8 @@ private:
         Page* tail = nullptr;
     };
 
+    void _init_adaptive_page_builder(const PageBuilderOptions& opts);
+
     void _push_back_page(Page* page) {
         // add page to pages' tail
         if (_pages.tail != nullptr) {
@@ -219,6 +227,8 @@ private:
     const EncodingInfo* _encoding_info = nullptr;
 
     std::unique_ptr<PageBuilder> _page_builder;
+    // |_page_builder| if it is an AdaptivePageBuilder, otherwise nullptr.
+    AdaptivePageBuilder* _adaptive_page_builder = nullptr;
 
     // Used when _opts.page_format == 1, using Run-Length encoding to build the null map.
     std::unique_ptr<NullMapRLEBuilder> _null_map_builder_v1;
@@ -230,7 +240,8 @@ private:
     std::unique_ptr<ZoneMapIndexWriter> _zone_map_index_builder;
     std::unique_ptr<BitmapIndexWriter> _bitmap_index_builder;
     std::unique_ptr<BloomFilterIndexWriter> _bloom_filter_index_builder;
-    // _zone_map_index_builder != NULL || _bitmap_index_builder != NULL || _bloom_filter_index_builder != NULL
+    std::unique_ptr<BloomFilterIndexWriter> _ngram_bloom_filter_index_builder;
+    // any of the index builders above is not NULL
     bool _has_index_builder = false;
     int64_t _element_ordinal = 0;
     int64_t _previous_ordinal = 0;
@@ -0,0 +1,84 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/decoded_page_cache.h"
+
+#include "column/column.h"
+#include "runtime/mem_tracker.h"
+#include "storage/page_cache.h"
+#include "util/metrics.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks::segment_v2 {
+
+UIntGauge g_decoded_page_cache_size(MetricUnit::BYTES);             // NOLINT
+IntCounter g_decoded_page_cache_hit_count(MetricUnit::OPERATIONS);  // NOLINT
+IntCounter g_decoded_page_cache_miss_count(MetricUnit::OPERATIONS); // NOLINT
+
+[[maybe_unused]] static void update_decoded_page_cache_size() {
+    g_decoded_page_cache_size.set_value(DecodedPageCache::instance()->memory_usage());
+}
+
+DecodedPageCache* DecodedPageCache::_s_instance = nullptr;
+
+void DecodedPageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+    if (_s_instance == nullptr && capacity > 0) {
+        _s_instance = new DecodedPageCache(mem_tracker, capacity);
+#ifndef BE_TEST
+        MetricRegistry* reg = StarRocksMetrics::instance()->metrics();
+        reg->register_hook("decoded_page_cache_size_hook", update_decoded_page_cache_size);
+        reg->register_metric("decoded_page_cache_bytes", &g_decoded_page_cache_size);
+        reg->register_metric("decoded_page_cache_hit_count", &g_decoded_page_cache_hit_count);
+        reg->register_metric("decoded_page_cache_miss_count", &g_decoded_page_cache_miss_count);
+#endif
+    }
+}
+
+void DecodedPageCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+DecodedPageCache::DecodedPageCache(MemTracker* mem_tracker, size_t capacity)
+        : _mem_tracker(mem_tracker),
+          _cache(new_lru_cache(capacity, storage_cache_eviction_policy(), cache_num_shards_by_cores(capacity))) {}
+
+DecodedPageCache::~DecodedPageCache() {
+    _cache.reset();
+    _mem_tracker->release(_mem_tracker->consumption());
+}
+
+DecodedPageCache::PagePtr DecodedPageCache::lookup(uint64_t file_id, int64_t offset) {
+    StoragePageCache::CacheKey key(file_id, offset);
+    auto* handle = _cache->lookup(key.encode());
+    if (handle == nullptr) {
+        g_decoded_page_cache_miss_count.increment(1);
+        return nullptr;
+    }
+    g_decoded_page_cache_hit_count.increment(1);
+    PagePtr page = *reinterpret_cast<PagePtr*>(_cache->value(handle));
+    _cache->release(handle);
+    return page;
+}
+
+void DecodedPageCache::insert(uint64_t file_id, int64_t offset, const PagePtr& page, bool in_memory) {
+    // The page is kept alive by the column iterators still reading it after it has been evicted.
+    auto deleter = [](const CacheKey& key, void* value) { delete reinterpret_cast<PagePtr*>(value); };
+    StoragePageCache::CacheKey key(file_id, offset);
+    size_t charge = sizeof(key) + sizeof(Page) + page->column->memory_usage();
+    CachePriority priority = in_memory ? CachePriority::DURABLE : CachePriority::NORMAL;
+    auto* handle = _cache->insert(key.encode(), new PagePtr(page), charge, deleter, priority);
+    _cache->release(handle);
+    _mem_tracker->consume(static_cast<int64_t>(memory_usage()) - _mem_tracker->consumption());
+}
+
+int64_t DecodedPageCache::hit_count() {
+    return g_decoded_page_cache_hit_count.value();
+}
+
+int64_t DecodedPageCache::miss_count() {
+    return g_decoded_page_cache_miss_count.value();
+}
+
+} // namespace starrocks::segment_v2
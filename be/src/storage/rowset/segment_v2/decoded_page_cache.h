@@ -0,0 +1,71 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "gutil/macros.h"
+#include "storage/lru_cache.h"
+#include "storage/rowset/segment_v2/common.h"
+
+namespace starrocks {
+
+class MemTracker;
+
+namespace vectorized {
+class Column;
+}
+
+namespace segment_v2 {
+
+// DecodedPageCache keeps the decoded values of the recently read data pages of the columns, so that the hot pages
+// are read again without decompressing and decoding them, which StoragePageCache, keeping the page bodies, has to
+// do on every read. A page is keyed by the file name and its offset in the file, like StoragePageCache, evicted in
+// LRU order once the pages are more than the capacity, after the ones of the columns kept in memory, and accounted
+// in |mem_tracker|.
+class DecodedPageCache {
+public:
+    struct Page {
+        // The values of all the rows of the page, of the column type read by the first reader.
+        std::shared_ptr<const vectorized::Column> column;
+        ordinal_t first_ordinal = 0;
+        ordinal_t corresponding_element_ordinal = 0;
+    };
+    using PagePtr = std::shared_ptr<const Page>;
+
+    // Create global instance of this class
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+
+    static void release_global_cache();
+
+    // Return global instance, nullptr if the cache has not been created or is disabled.
+    static DecodedPageCache* instance() { return _s_instance; }
+
+    DecodedPageCache(MemTracker* mem_tracker, size_t capacity);
+    ~DecodedPageCache();
+
+    // Return the page at |offset| of the file of |file_id|, see StoragePageCache::new_file_id(), nullptr if it is not
+    // in the cache.
+    PagePtr lookup(uint64_t file_id, int64_t offset);
+
+    // Insert the page at |offset| of the file of |file_id|, which replaces the one inserted concurrently if any.
+    void insert(uint64_t file_id, int64_t offset, const PagePtr& page, bool in_memory = false);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+    // The number of the lookups found or not found in the cache of the process.
+    static int64_t hit_count();
+    static int64_t miss_count();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(DecodedPageCache);
+
+    static DecodedPageCache* _s_instance;
+
+    MemTracker* _mem_tracker = nullptr;
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace segment_v2
+} // namespace starrocks
@@ -83,6 +83,7 @@ Status IndexedColumnReader::read_page(fs::ReadableBlock* rblock, const PagePoint
                                       PageFooterPB* footer) const {
     PageReadOptions opts;
     opts.rblock = rblock;
+    opts.file_id = _file_id;
     opts.page_pointer = pp;
     opts.codec = _compress_codec;
     OlapReaderStatistics tmp_stats;
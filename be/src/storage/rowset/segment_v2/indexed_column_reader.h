@@ -109,8 +109,10 @@ class IndexedColumnReader {
 
 public:
     // Does *NOT* take the ownership of |block_mgr|.
-    IndexedColumnReader(fs::BlockManager* block_mgr, std::string file_name, const IndexedColumnMetaPB& meta)
-            : _block_mgr(block_mgr), _file_name(std::move(file_name)), _meta(meta){};
+    // |file_id| keys the pages of this column in the page cache, see `PageReadOptions::file_id`.
+    IndexedColumnReader(fs::BlockManager* block_mgr, std::string file_name, uint64_t file_id,
+                        const IndexedColumnMetaPB& meta)
+            : _block_mgr(block_mgr), _file_name(std::move(file_name)), _file_id(file_id), _meta(meta){};
 
     Status load(bool use_page_cache, bool kept_in_memory);
 
@@ -138,6 +140,7 @@ private:
 
     fs::BlockManager* _block_mgr;
     std::string _file_name;
+    uint64_t _file_id;
     IndexedColumnMetaPB _meta;
 
     bool _use_page_cache = true;
@@ -62,7 +62,7 @@ Status OrdinalIndexWriter::finish(fs::WritableBlock* wblock, ColumnIndexMetaPB*
     return Status::OK();
 }
 
-Status OrdinalIndexReader::load(fs::BlockManager* block_mgr, const std::string& filename,
+Status OrdinalIndexReader::load(fs::BlockManager* block_mgr, const std::string& filename, uint64_t file_id,
                                 const OrdinalIndexPB* index_meta, ordinal_t num_values, bool use_page_cache,
                                 bool kept_in_memory) {
     if (index_meta->root_page().is_root_data_page()) {
@@ -79,6 +79,7 @@ Status OrdinalIndexReader::load(fs::BlockManager* block_mgr, const std::string&
 
     PageReadOptions opts;
     opts.rblock = rblock.get();
+    opts.file_id = file_id;
     opts.page_pointer = PagePointer(index_meta->root_page().root_page());
     opts.codec = nullptr; // ordinal index page uses NO_COMPRESSION right now
     OlapReaderStatistics tmp_stats;
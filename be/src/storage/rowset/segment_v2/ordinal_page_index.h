@@ -69,8 +69,8 @@ public:
     OrdinalIndexReader() = default;
 
     // load and parse the index page into memory
-    Status load(fs::BlockManager* block_mgr, const std::string& filename, const OrdinalIndexPB* index_meta,
-                ordinal_t num_values, bool use_page_cache, bool kept_in_memory);
+    Status load(fs::BlockManager* block_mgr, const std::string& filename, uint64_t file_id,
+                const OrdinalIndexPB* index_meta, ordinal_t num_values, bool use_page_cache, bool kept_in_memory);
 
     OrdinalPageIndexIterator seek_at_or_before(ordinal_t ordinal);
     inline OrdinalPageIndexIterator begin();
@@ -117,11 +117,13 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
 
     auto cache = StoragePageCache::instance();
     PageCacheHandle cache_handle;
-    StoragePageCache::CacheKey cache_key(opts.rblock->path(), opts.page_pointer.offset);
-    if (opts.use_page_cache && cache->lookup(cache_key, &cache_handle)) {
+    StoragePageCache::CacheKey cache_key(opts.file_id, opts.page_pointer.offset);
+    const bool use_page_cache = opts.use_page_cache && opts.file_id != 0;
+    if (use_page_cache && cache->lookup(cache_key, &cache_handle)) {
         // we find page in cache, use it
         *handle = PageHandle(std::move(cache_handle));
         opts.stats->cached_pages_num++;
+        opts.stats->page_cache_bytes_read += handle->data().size;
         // parse body and footer
         Slice page_slice = handle->data();
         uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
@@ -132,6 +134,9 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
         return Status::OK();
     }
+    if (use_page_cache) {
+        opts.stats->cache_missed_pages_num++;
+    }
 
     // every page contains 4 bytes footer length and 4 bytes checksum
     const uint32_t page_size = opts.page_pointer.size;
@@ -144,8 +149,9 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     std::unique_ptr<char[]> page(new char[page_size + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE]);
     Slice page_slice(page.get(), page_size);
     {
-        SCOPED_RAW_TIMER(&opts.stats->io_ns);
+        ScopedIOTimer io_timer(&opts.stats->io_ns, &opts.stats->io_latency);
         RETURN_IF_ERROR(opts.rblock->read(opts.page_pointer.offset, page_slice));
+        opts.stats->io_count++;
         opts.stats->compressed_bytes_read += page_size;
     }
 
@@ -196,7 +202,7 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     }
 
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
-    if (opts.use_page_cache) {
+    if (use_page_cache) {
         // insert this page into cache and return the cache handle
         cache->insert(cache_key, page_slice, &cache_handle, opts.kept_in_memory);
         *handle = PageHandle(std::move(cache_handle));
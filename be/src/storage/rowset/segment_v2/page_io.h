@@ -45,6 +45,9 @@ namespace segment_v2 {
 struct PageReadOptions {
     // block to read page
     fs::ReadableBlock* rblock = nullptr;
+    // id of the file of the block in the page cache, see StoragePageCache::new_file_id(),
+    // the pages of a file without id are not cached.
+    uint64_t file_id = 0;
     // location of the page
     PagePointer page_pointer;
     // decompressor for page body (null means page body is not compressed)
@@ -258,6 +258,49 @@ private:
     PageHandle _page_handle;
 };
 
+class DecodedPage : public ParsedPage {
+public:
+    explicit DecodedPage(DecodedPageCache::PagePtr page) : _page(std::move(page)) {}
+
+    Status seek(ordinal_t offset) override {
+        DCHECK_LE(offset, _num_rows);
+        _offset_in_page = offset;
+        return Status::OK();
+    }
+
+    Status read(vectorized::Column* column, size_t* count) override {
+        *count = std::min(*count, remaining());
+        const vectorized::Column* src = _page->column.get();
+        if (column->is_nullable() == src->is_nullable()) {
+            column->append(*src, _offset_in_page, *count);
+        } else if (column->is_nullable()) {
+            // The page without null of a column read as nullable, e.g. after a linked schema change.
+            auto nc = down_cast<vectorized::NullableColumn*>(column);
+            nc->data_column()->append(*src, _offset_in_page, *count);
+            nc->null_column()->resize(nc->null_column()->size() + *count);
+        } else {
+            auto nc = down_cast<const vectorized::NullableColumn*>(src);
+            column->append(*nc->data_column(), _offset_in_page, *count);
+        }
+        _offset_in_page += *count;
+        return Status::OK();
+    }
+
+    Status read(ColumnBlockView* block, size_t* count) override {
+        return Status::NotSupported("decoded page does not support reading column block");
+    }
+
+    Status read_dict_codes(vectorized::Column* column, size_t* count) override {
+        return Status::NotSupported("decoded page does not support reading dictionary codes");
+    }
+
+private:
+    friend Status parse_decoded_page(std::unique_ptr<ParsedPage>* result, DecodedPageCache::PagePtr page,
+                                     const PagePointer& page_pointer, uint32_t page_index);
+
+    DecodedPageCache::PagePtr _page;
+};
+
 Status parse_page_v1(std::unique_ptr<ParsedPage>* result, PageHandle handle, const Slice& body,
                      const DataPageFooterPB& footer, const EncodingInfo* encoding, const PagePointer& page_pointer,
                      uint32_t page_index) {
@@ -333,6 +376,10 @@ Status parse_page(std::unique_ptr<ParsedPage>* result, PageHandle handle, const
                   const DataPageFooterPB& footer, const EncodingInfo* encoding, const PagePointer& page_pointer,
                   uint32_t page_index) {
     uint32_t version = footer.has_format_version() ? footer.format_version() : 1;
+    // The page is of another encoding than the column chosen by AdaptivePageBuilder.
+    if (footer.has_encoding() && footer.encoding() != encoding->encoding()) {
+        RETURN_IF_ERROR(EncodingInfo::get(encoding->type(), footer.encoding(), &encoding));
+    }
     if (version == 1) {
         return parse_page_v1(result, std::move(handle), body, footer, encoding, page_pointer, page_index);
     }
@@ -342,5 +389,17 @@ Status parse_page(std::unique_ptr<ParsedPage>* result, PageHandle handle, const
     return Status::InternalError(strings::Substitute("Unknown page format version $0", version));
 }
 
+Status parse_decoded_page(std::unique_ptr<ParsedPage>* result, DecodedPageCache::PagePtr page,
+                          const PagePointer& page_pointer, uint32_t page_index) {
+    auto decoded = std::make_unique<DecodedPage>(page);
+    decoded->_first_ordinal = page->first_ordinal;
+    decoded->_num_rows = page->column->size();
+    decoded->_corresponding_element_ordinal = page->corresponding_element_ordinal;
+    decoded->_page_pointer = page_pointer;
+    decoded->_page_index = page_index;
+    *result = std::move(decoded);
+    return Status::OK();
+}
+
 } // namespace segment_v2
 } // namespace starrocks
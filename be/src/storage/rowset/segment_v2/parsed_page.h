@@ -24,6 +24,7 @@
 #include <memory>
 
 #include "storage/rowset/segment_v2/common.h" // ordinal_t
+#include "storage/rowset/segment_v2/decoded_page_cache.h"
 #include "storage/rowset/segment_v2/page_decoder.h"
 #include "storage/rowset/segment_v2/page_pointer.h"
 
@@ -74,6 +75,7 @@ public:
     size_t remaining() const { return _num_rows - _offset_in_page; }
 
     // Return the encoding type of this page.
+    // prerequisite: the page is not a decoded page, which has no data decoder.
     EncodingTypePB encoding_type() const { return _data_decoder->encoding_type(); }
 
     // Set the page offset indicator to the specified position |offset|.
@@ -124,5 +126,10 @@ Status parse_page(std::unique_ptr<ParsedPage>* result, PageHandle handle, const
                   const DataPageFooterPB& footer, const EncodingInfo* encoding, const PagePointer& page_pointer,
                   uint32_t page_index);
 
+// Create a page reading the values decoded into |page| by a previous reader, which only supports reading
+// vectorized columns.
+Status parse_decoded_page(std::unique_ptr<ParsedPage>* result, DecodedPageCache::PagePtr page,
+                          const PagePointer& page_pointer, uint32_t page_index);
+
 } // namespace segment_v2
 } // namespace starrocks
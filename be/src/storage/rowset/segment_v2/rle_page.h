@@ -106,6 +106,7 @@ public:
 
     void reset() override {
         _count = 0;
+        _finished = false;
         _rle_encoder->Clear();
         _rle_encoder->Reserve(RLE_PAGE_HEADER_SIZE, 0);
     }
@@ -198,14 +199,8 @@ public:
         }
 
         size_t to_fetch = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
-        size_t remaining = to_fetch;
-        uint8_t* data_ptr = dst->data();
-        while (remaining > 0) {
-            bool result = _rle_decoder.Get(reinterpret_cast<CppType*>(data_ptr));
-            DCHECK(result);
-            remaining--;
-            data_ptr += SIZE_OF_TYPE;
-        }
+        [[maybe_unused]] size_t num_read = _rle_decoder.GetBatch(reinterpret_cast<CppType*>(dst->data()), to_fetch);
+        DCHECK_EQ(to_fetch, num_read);
 
         _cur_index += to_fetch;
         *n = to_fetch;
@@ -218,14 +213,15 @@ public:
             *n = 0;
             return Status::OK();
         }
-        CppType value{};
         *n = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
-        for (size_t i = 0; i < *n; i++) {
-            if (PREDICT_FALSE(!_rle_decoder.Get(&value))) {
-                return Status::Corruption("RLE decode failed");
-            }
-            [[maybe_unused]] int r = dst->append_numbers(&value, sizeof(value));
-            DCHECK_EQ(1, r);
+        // The values are decoded into the column directly, the repeated runs are filled and the literal runs
+        // are unpacked in batches.
+        const size_t ori_size = dst->size();
+        dst->resize(ori_size + *n);
+        auto* p = reinterpret_cast<CppType*>(dst->mutable_raw_data()) + ori_size;
+        if (PREDICT_FALSE(_rle_decoder.GetBatch(p, *n) != *n)) {
+            dst->resize(ori_size);
+            return Status::Corruption("RLE decode failed");
         }
         _cur_index += *n;
         return Status::OK();
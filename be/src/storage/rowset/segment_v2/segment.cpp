@@ -27,13 +27,16 @@
 #include "common/logging.h"
 #include "gutil/strings/substitute.h"
 #include "storage/fs/fs_util.h"
+#include "storage/page_cache.h"
 #include "storage/rowset/segment_v2/column_reader.h"
 #include "storage/rowset/segment_v2/empty_segment_iterator.h"
 #include "storage/rowset/segment_v2/page_io.h"
+#include "storage/rowset/segment_v2/segment_footer_cache.h"
 #include "storage/rowset/segment_v2/segment_iterator.h"
 #include "storage/rowset/segment_v2/segment_writer.h" // k_segment_magic_length
 #include "storage/rowset/vectorized/segment_chunk_iterator_adapter.h"
 #include "storage/rowset/vectorized/segment_iterator.h"
+#include "storage/rowset/vectorized/segment_metadata_iterator.h"
 #include "storage/rowset/vectorized/segment_options.h"
 #include "storage/rowset/vectorized/segment_v2_iterator_adapter.h"
 #include "storage/tablet_schema.h"
@@ -59,6 +62,7 @@ Segment::Segment(MemTracker* mem_tracker, fs::BlockManager* blk_mgr, std::string
           _block_mgr(blk_mgr),
           _fname(std::move(fname)),
           _segment_id(segment_id),
+          _file_id(StoragePageCache::new_file_id()),
           _tablet_schema(tablet_schema) {
     _mem_tracker->consume(sizeof(Segment) + _fname.size());
 }
@@ -130,6 +134,12 @@ StatusOr<ChunkIteratorPtr> Segment::_new_iterator(const vectorized::Schema& sche
             return Status::EndOfFile("empty iterator");
         }
     }
+    if (read_options.metadata_scan) {
+        auto res = vectorized::new_segment_metadata_iterator(shared_from_this(), schema, read_options);
+        if (!res.ok() || res.value() != nullptr) {
+            return res;
+        }
+    }
     return vectorized::new_segment_iterator(shared_from_this(), schema, read_options);
 }
 
@@ -157,6 +167,23 @@ StatusOr<ChunkIteratorPtr> Segment::new_iterator(const vectorized::Schema& schem
 }
 
 Status Segment::_parse_footer() {
+    SegmentFooterCache* footer_cache = SegmentFooterCache::instance();
+    if (footer_cache != nullptr) {
+        _footer = footer_cache->lookup(_fname);
+    }
+    if (_footer == nullptr) {
+        RETURN_IF_ERROR(_read_footer());
+        if (footer_cache != nullptr) {
+            footer_cache->insert(_fname, _footer);
+        }
+    }
+    // The memory usage obtained through SpaceUsedLong() is an estimate
+    _mem_tracker->consume(static_cast<int64_t>(_footer->SpaceUsedLong()) -
+                          static_cast<int64_t>(sizeof(SegmentFooterPB)));
+    return Status::OK();
+}
+
+Status Segment::_read_footer() {
     // Footer := SegmentFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
     std::unique_ptr<fs::ReadableBlock> rblock;
     RETURN_IF_ERROR(_block_mgr->open_block(_fname, &rblock));
@@ -196,12 +223,11 @@ Status Segment::_parse_footer() {
     }
 
     // deserialize footer PB
-    if (!_footer.ParseFromString(footer_buf)) {
+    auto footer = std::make_shared<SegmentFooterPB>();
+    if (!footer->ParseFromString(footer_buf)) {
         return Status::Corruption(strings::Substitute("Bad segment file $0: failed to parse SegmentFooterPB", _fname));
     }
-    // The memory usage obtained through SpaceUsedLong() is an estimate
-    _mem_tracker->consume(static_cast<int64_t>(_footer.SpaceUsedLong()) -
-                          static_cast<int64_t>(sizeof(SegmentFooterPB)));
+    _footer = std::move(footer);
     return Status::OK();
 }
 
@@ -214,7 +240,8 @@ Status Segment::_load_index() {
         PageReadOptions opts;
         opts.use_page_cache = !config::disable_storage_page_cache;
         opts.rblock = rblock.get();
-        opts.page_pointer = PagePointer(_footer.short_key_index_page());
+        opts.file_id = _file_id;
+        opts.page_pointer = PagePointer(_footer->short_key_index_page());
         opts.codec = nullptr; // short key index page uses NO_COMPRESSION for now
         OlapReaderStatistics tmp_stats;
         opts.stats = &tmp_stats;
@@ -237,8 +264,8 @@ Status Segment::_load_index() {
 
 Status Segment::_create_column_readers() {
     std::unordered_map<uint32_t, uint32_t> column_id_to_footer_ordinal;
-    for (uint32_t ordinal = 0; ordinal < _footer.columns().size(); ++ordinal) {
-        const auto& column_pb = _footer.columns(ordinal);
+    for (uint32_t ordinal = 0; ordinal < _footer->columns().size(); ++ordinal) {
+        const auto& column_pb = _footer->columns(ordinal);
         column_id_to_footer_ordinal.emplace(column_pb.unique_id(), ordinal);
     }
 
@@ -252,10 +279,11 @@ Status Segment::_create_column_readers() {
 
         ColumnReaderOptions opts;
         opts.block_mgr = _block_mgr;
-        opts.storage_format_version = _footer.version();
+        opts.storage_format_version = _footer->version();
         opts.kept_in_memory = _tablet_schema->is_in_memory();
+        opts.file_id = _file_id;
         std::unique_ptr<ColumnReader> reader;
-        RETURN_IF_ERROR(ColumnReader::create(_mem_tracker, opts, _footer.columns(iter->second), _footer.num_rows(),
+        RETURN_IF_ERROR(ColumnReader::create(_mem_tracker, opts, _footer->columns(iter->second), _footer->num_rows(),
                                              _fname, &reader));
         _column_readers[ordinal] = std::move(reader);
     }
@@ -89,14 +89,20 @@ public:
 
     uint64_t id() const { return _segment_id; }
 
-    uint32_t num_rows() const { return _footer.num_rows(); }
+    uint32_t num_rows() const { return _footer->num_rows(); }
 
     Status new_column_iterator(uint32_t cid, ColumnIterator** iter);
 
+    // The reader of the column |cid|, nullptr if the column was added after the segment had been written.
+    const ColumnReader* column_reader(uint32_t cid) const { return _column_readers[cid].get(); }
+
     Status new_bitmap_index_iterator(uint32_t cid, BitmapIndexIterator** iter);
 
     size_t num_short_keys() const { return _tablet_schema->num_short_key_columns(); }
 
+    // Load and decode short key index, which is required by num_rows_per_block, lower_bound and upper_bound.
+    Status load_index() { return _load_index(); }
+
     uint32_t num_rows_per_block() const {
         DCHECK(_load_index_once.has_called() && _load_index_once.stored_result().ok());
         return _sk_index_decoder->num_rows_per_block();
@@ -122,17 +128,24 @@ public:
     }
 
     // only used by UT
-    const SegmentFooterPB& footer() const { return _footer; }
+    const SegmentFooterPB& footer() const { return *_footer; }
 
     const std::string& file_name() const { return _fname; }
 
+    // the unique id keying the pages of this segment in the page caches
+    uint64_t file_id() const { return _file_id; }
+
+    const TabletSchema& tablet_schema() const { return *_tablet_schema; }
+
 private:
     DISALLOW_COPY_AND_ASSIGN(Segment);
     Segment(MemTracker* mem_tracker, fs::BlockManager* blk_mgr, std::string fname, uint32_t segment_id,
             const TabletSchema* tablet_schema);
     // open segment file and read the minimum amount of necessary information (footer)
     Status _open();
+    // Get the footer from SegmentFooterCache, or read it from the file.
     Status _parse_footer();
+    Status _read_footer();
     Status _create_column_readers();
     // Load and decode short key index.
     // May be called multiple times, subsequent calls will no op.
@@ -154,9 +167,11 @@ private:
     fs::BlockManager* _block_mgr;
     std::string _fname;
     uint32_t _segment_id;
+    uint64_t _file_id;
     const TabletSchema* _tablet_schema;
 
-    SegmentFooterPB _footer;
+    // Shared with SegmentFooterCache, the ColumnReaders refer to the metas of its columns.
+    std::shared_ptr<const SegmentFooterPB> _footer;
 
     // ColumnReader for each column in TabletSchema. If ColumnReader is nullptr,
     // This means that this segment has no data for that column, which may be added
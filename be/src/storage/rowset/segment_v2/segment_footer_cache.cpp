@@ -0,0 +1,79 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/segment_footer_cache.h"
+
+#include "runtime/mem_tracker.h"
+#include "util/metrics.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks::segment_v2 {
+
+UIntGauge g_footer_cache_size(MetricUnit::BYTES);             // NOLINT
+IntCounter g_footer_cache_hit_count(MetricUnit::OPERATIONS);  // NOLINT
+IntCounter g_footer_cache_miss_count(MetricUnit::OPERATIONS); // NOLINT
+
+[[maybe_unused]] static void update_footer_cache_size() {
+    g_footer_cache_size.set_value(SegmentFooterCache::instance()->memory_usage());
+}
+
+SegmentFooterCache* SegmentFooterCache::_s_instance = nullptr;
+
+void SegmentFooterCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+    if (_s_instance == nullptr && capacity > 0) {
+        _s_instance = new SegmentFooterCache(mem_tracker, capacity);
+#ifndef BE_TEST
+        MetricRegistry* reg = StarRocksMetrics::instance()->metrics();
+        reg->register_hook("segment_footer_cache_size_hook", update_footer_cache_size);
+        reg->register_metric("segment_footer_cache_bytes", &g_footer_cache_size);
+        reg->register_metric("segment_footer_cache_hit_count", &g_footer_cache_hit_count);
+        reg->register_metric("segment_footer_cache_miss_count", &g_footer_cache_miss_count);
+#endif
+    }
+}
+
+void SegmentFooterCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+SegmentFooterCache::SegmentFooterCache(MemTracker* mem_tracker, size_t capacity)
+        : _mem_tracker(mem_tracker),
+          _cache(new_lru_cache(capacity, storage_cache_eviction_policy(), cache_num_shards_by_cores(capacity))) {}
+
+SegmentFooterCache::~SegmentFooterCache() {
+    _cache.reset();
+    _mem_tracker->release(_mem_tracker->consumption());
+}
+
+SegmentFooterCache::FooterPtr SegmentFooterCache::lookup(const std::string& fname) {
+    auto* handle = _cache->lookup(CacheKey(fname));
+    if (handle == nullptr) {
+        g_footer_cache_miss_count.increment(1);
+        return nullptr;
+    }
+    g_footer_cache_hit_count.increment(1);
+    FooterPtr footer = *reinterpret_cast<FooterPtr*>(_cache->value(handle));
+    _cache->release(handle);
+    return footer;
+}
+
+void SegmentFooterCache::insert(const std::string& fname, const FooterPtr& footer) {
+    // The footer is kept alive by the segments still using it after it has been evicted.
+    auto deleter = [](const CacheKey& key, void* value) { delete reinterpret_cast<FooterPtr*>(value); };
+    size_t charge = fname.size() + footer->SpaceUsedLong();
+    auto* handle = _cache->insert(CacheKey(fname), new FooterPtr(footer), charge, deleter);
+    _cache->release(handle);
+    _mem_tracker->consume(static_cast<int64_t>(memory_usage()) - _mem_tracker->consumption());
+}
+
+int64_t SegmentFooterCache::hit_count() {
+    return g_footer_cache_hit_count.value();
+}
+
+int64_t SegmentFooterCache::miss_count() {
+    return g_footer_cache_miss_count.value();
+}
+
+} // namespace starrocks::segment_v2
@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "gen_cpp/segment_v2.pb.h"
+#include "gutil/macros.h"
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+class MemTracker;
+
+namespace segment_v2 {
+
+// SegmentFooterCache keeps the parsed SegmentFooterPB of the recently opened segment files, which has the segment
+// level zone maps and the metas of the ordinal, zone map and other indexes of every column, so that a segment
+// opened again, e.g. after its rowset has been evicted, neither reads nor parses its footer. The footers are keyed
+// by the file name, which is never reused by another segment, evicted in LRU order once they are more than the
+// capacity, and accounted in |mem_tracker|.
+class SegmentFooterCache {
+public:
+    using FooterPtr = std::shared_ptr<const SegmentFooterPB>;
+
+    // Create global instance of this class
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+
+    static void release_global_cache();
+
+    // Return global instance, nullptr if the cache has not been created or is disabled.
+    static SegmentFooterCache* instance() { return _s_instance; }
+
+    SegmentFooterCache(MemTracker* mem_tracker, size_t capacity);
+    ~SegmentFooterCache();
+
+    // Return the footer of |fname|, nullptr if it is not in the cache.
+    FooterPtr lookup(const std::string& fname);
+
+    // Insert the footer of |fname|, which replaces the one inserted concurrently if any.
+    void insert(const std::string& fname, const FooterPtr& footer);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+    // The number of the lookups found or not found in the cache of the process.
+    static int64_t hit_count();
+    static int64_t miss_count();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(SegmentFooterCache);
+
+    static SegmentFooterCache* _s_instance;
+
+    MemTracker* _mem_tracker = nullptr;
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace segment_v2
+} // namespace starrocks
@@ -22,10 +22,12 @@
 #include "storage/rowset/segment_v2/segment_writer.h"
 
 #include <memory>
+#include <numeric>
 
 #include "column/chunk.h"
 #include "column/datum_tuple.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "env/env.h"        // Env
 #include "storage/fs/block_manager.h"
@@ -36,8 +38,10 @@
 #include "storage/schema.h"
 #include "storage/short_key_index.h"
 #include "storage/vectorized/seek_tuple.h"
+#include "util/countdown_latch.h"
 #include "util/crc32c.h"
 #include "util/faststring.h"
+#include "util/threadpool.h"
 
 namespace starrocks::segment_v2 {
 
@@ -62,7 +66,7 @@ void SegmentWriter::_init_column_meta(ColumnMetaPB* meta, uint32_t* column_id, c
     meta->set_type(column.type());
     meta->set_length(column.length());
     meta->set_encoding(DEFAULT_ENCODING);
-    meta->set_compression(LZ4_FRAME);
+    meta->set_compression(_opts.compression);
     meta->set_is_nullable(column.is_nullable());
     if (column.get_subtype_count() > 0) {
         for (uint32_t i = 0; i < column.get_subtype_count(); ++i) {
@@ -72,19 +76,35 @@ void SegmentWriter::_init_column_meta(ColumnMetaPB* meta, uint32_t* column_id, c
 }
 
 Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))) {
-    uint32_t column_id = 0;
+    std::vector<uint32_t> column_indexes(_tablet_schema->num_columns());
+    std::iota(column_indexes.begin(), column_indexes.end(), 0);
+    return init(column_indexes, true);
+}
+
+Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has_key) {
     if (_opts.storage_format_version != 1 && _opts.storage_format_version != 2) {
         auto v = _opts.storage_format_version;
         return Status::InvalidArgument(strings::Substitute("Invalid storage_format_version $0", v));
     }
-    _column_writers.reserve(_tablet_schema->columns().size());
-    for (const auto& column : _tablet_schema->columns()) {
+    if (_footer.columns_size() == 0) {
+        // the column ids are assigned in the order of the columns and their sub columns.
+        uint32_t column_id = 0;
+        for (const auto& column : _tablet_schema->columns()) {
+            _init_column_meta(_footer.add_columns(), &column_id, column);
+        }
+        for (const auto& [cid, encoding] : _opts.encodings) {
+            _footer.mutable_columns(cid)->set_encoding(encoding);
+        }
+    }
+    DCHECK(_column_writers.empty());
+    _column_writers.reserve(column_indexes.size());
+    for (uint32_t cid : column_indexes) {
+        const TabletColumn& column = _tablet_schema->column(cid);
         ColumnWriterOptions opts;
         opts.page_format = (_opts.storage_format_version == 1) ? 1 : 2;
         opts.adaptive_page_format = (_opts.storage_format_version > 1);
-        opts.meta = _footer.add_columns();
-
-        _init_column_meta(opts.meta, &column_id, column);
+        opts.adaptive_page_encoding = config::enable_adaptive_page_encoding;
+        opts.meta = _footer.mutable_columns(cid);
 
         // now we create zone map for key columns
         // and not support zone map for array type.
@@ -95,6 +115,10 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
             opts.need_zone_map = false;
         }
         opts.need_bloom_filter = column.is_bf_column();
+        if (opts.need_bloom_filter && config::ngram_bloom_filter_gram_size > 0 &&
+            (column.type() == FieldType::OLAP_FIELD_TYPE_CHAR || column.type() == FieldType::OLAP_FIELD_TYPE_VARCHAR)) {
+            opts.ngram_bloom_filter_gram_size = config::ngram_bloom_filter_gram_size;
+        }
         opts.need_bitmap_index = column.has_bitmap_index();
         if (column.type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
             if (opts.need_bloom_filter) {
@@ -110,7 +134,11 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
         RETURN_IF_ERROR(writer->init());
         _column_writers.push_back(std::move(writer));
     }
-    _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
+    if (has_key) {
+        _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
+    }
+    _has_key = has_key;
+    _num_rows_of_columns = 0;
     return Status::OK();
 }
 
@@ -129,6 +157,7 @@ Status SegmentWriter::append_row(const RowType& row) {
         _mem_tracker->consume(static_cast<int64_t>(estimate_segment_size()) - _mem_tracker->consumption());
     }
     ++_row_count;
+    ++_num_rows_of_columns;
     return Status::OK();
 }
 
@@ -145,11 +174,20 @@ uint64_t SegmentWriter::estimate_segment_size() {
     for (auto& column_writer : _column_writers) {
         size += column_writer->estimate_buffer_size();
     }
-    size += _index_builder->size();
+    size += _index_builder != nullptr ? _index_builder->size() : 0;
     return size;
 }
 
 Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size) {
+    RETURN_IF_ERROR(finalize_columns(index_size));
+    return finalize_footer(segment_file_size);
+}
+
+Status SegmentWriter::finalize_columns(uint64_t* index_size) {
+    if (_num_rows_of_columns != _row_count) {
+        return Status::InternalError(strings::Substitute("$0 rows of the columns written, but $1 rows of the keys",
+                                                         _num_rows_of_columns, _row_count));
+    }
     for (auto& column_writer : _column_writers) {
         RETURN_IF_ERROR(column_writer->finish());
     }
@@ -159,8 +197,17 @@ Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size
     RETURN_IF_ERROR(_write_zone_map());
     RETURN_IF_ERROR(_write_bitmap_index());
     RETURN_IF_ERROR(_write_bloom_filter_index());
-    RETURN_IF_ERROR(_write_short_key_index());
+    if (_has_key) {
+        RETURN_IF_ERROR(_write_short_key_index());
+    }
     *index_size = _wblock->bytes_appended() - index_offset;
+    _column_writers.clear();
+    _mem_tracker->consume(static_cast<int64_t>(estimate_segment_size()) - _mem_tracker->consumption());
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_footer(uint64_t* segment_file_size) {
+    DCHECK(_column_writers.empty());
     RETURN_IF_ERROR(_write_footer());
     RETURN_IF_ERROR(_wblock->finalize());
     *segment_file_size = _wblock->bytes_appended();
@@ -244,11 +291,35 @@ Status SegmentWriter::_write_raw_data(const std::vector<Slice>& slices) {
     return Status::OK();
 }
 
-Status SegmentWriter::append_chunk(const vectorized::Chunk& chunk) {
+Status SegmentWriter::append_chunk(const vectorized::Chunk& chunk, ThreadPool* encode_pool) {
     DCHECK_EQ(_column_writers.size(), chunk.num_columns());
-    for (size_t i = 0; i < _column_writers.size(); ++i) {
-        const vectorized::Column* col = chunk.get_column_by_index(i).get();
-        RETURN_IF_ERROR(_column_writers[i]->append(*col));
+    if (encode_pool != nullptr && _column_writers.size() > 1) {
+        // The column writers share nothing but the mem tracker until they are finished.
+        std::vector<Status> statuses(_column_writers.size());
+        CountDownLatch latch(_column_writers.size());
+        for (size_t i = 0; i < _column_writers.size(); ++i) {
+            auto append = [this, &chunk, &statuses, &latch, i]() {
+                statuses[i] = _column_writers[i]->append(*chunk.get_column_by_index(i));
+                latch.count_down();
+            };
+            if (!encode_pool->submit_func(append).ok()) {
+                append();
+            }
+        }
+        latch.wait();
+        for (const Status& st : statuses) {
+            RETURN_IF_ERROR(st);
+        }
+    } else {
+        for (size_t i = 0; i < _column_writers.size(); ++i) {
+            const vectorized::Column* col = chunk.get_column_by_index(i).get();
+            RETURN_IF_ERROR(_column_writers[i]->append(*col));
+        }
+    }
+    _num_rows_of_columns += chunk.num_rows();
+    if (!_has_key) {
+        _mem_tracker->consume(static_cast<int64_t>(estimate_segment_size()) - _mem_tracker->consumption());
+        return Status::OK();
     }
 
     for (size_t i = 0; i < chunk.num_rows(); i++) {
@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <memory> // unique_ptr
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "common/status.h" // Status
@@ -38,6 +39,7 @@ class TabletSchema;
 class TabletColumn;
 class ShortKeyIndexBuilder;
 class MemTracker;
+class ThreadPool;
 
 namespace fs {
 class WritableBlock;
@@ -58,6 +60,9 @@ struct SegmentWriterOptions {
     uint32_t storage_format_version = 1;
     uint32_t num_rows_per_block = 1024;
     MemTracker* mem_tracker = nullptr;
+    // The encodings of the columns by their indexes, and DEFAULT_ENCODING of the type for the others.
+    std::unordered_map<uint32_t, EncodingTypePB> encodings;
+    CompressionTypePB compression = LZ4_FRAME;
 };
 
 class SegmentWriter {
@@ -71,17 +76,43 @@ public:
 
     Status init(uint32_t write_mbytes_per_sec);
 
+    // Init the writers of the columns |column_indexes| only, for writing the segment by the groups of columns,
+    // e.g, by vertical compaction. The chunks appended have the columns of the group only. The group of the key
+    // columns, i.e, |has_key|, is written first, which decides the rows of the segment, and each group of the
+    // value columns is written by the same number of rows after it.
+    // Usage:
+    //      init(key_column_indexes, true);
+    //      append_chunk(key_chunk) ...
+    //      finalize_columns(&index_size);
+    //      init(value_column_indexes, false);
+    //      append_chunk(value_chunk) ...
+    //      finalize_columns(&index_size);
+    //      ...
+    //      finalize_footer(&segment_file_size);
+    Status init(const std::vector<uint32_t>& column_indexes, bool has_key);
+
     template <typename RowType>
     Status append_row(const RowType& row);
 
-    Status append_chunk(const vectorized::Chunk& chunk);
+    // Append the rows of |chunk|, whose columns are encoded and compressed concurrently by |encode_pool| if it is not
+    // nullptr, or by the calling thread if the pool is too busy.
+    Status append_chunk(const vectorized::Chunk& chunk, ThreadPool* encode_pool = nullptr);
 
     uint64_t estimate_segment_size();
 
     uint32_t num_rows_written() const { return _row_count; }
 
+    // The number of the rows of the current group of columns written.
+    uint32_t num_rows_of_columns() const { return _num_rows_of_columns; }
+
     Status finalize(uint64_t* segment_file_size, uint64_t* index_size);
 
+    // Write the data and indexes of the current group of columns, and release their writers.
+    Status finalize_columns(uint64_t* index_size);
+
+    // Write the footer once all the groups of columns have been written.
+    Status finalize_footer(uint64_t* segment_file_size);
+
     uint32_t segment_id() const { return _segment_id; }
 
 private:
@@ -106,6 +137,9 @@ private:
     std::unique_ptr<ShortKeyIndexBuilder> _index_builder;
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
     uint32_t _row_count = 0;
+    uint32_t _num_rows_of_columns = 0;
+    // whether the current group of columns contains the key columns.
+    bool _has_key = true;
 };
 
 } // namespace segment_v2
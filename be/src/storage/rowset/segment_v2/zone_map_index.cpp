@@ -239,9 +239,9 @@ Status ZoneMapIndexWriterImpl<type>::finish(fs::WritableBlock* wblock, ColumnInd
     return writer.finish(meta->mutable_page_zone_maps());
 }
 
-Status ZoneMapIndexReader::load(fs::BlockManager* block_mgr, const std::string& filename,
+Status ZoneMapIndexReader::load(fs::BlockManager* block_mgr, const std::string& filename, uint64_t file_id,
                                 const ZoneMapIndexPB* index_meta, bool use_page_cache, bool kept_in_memory) {
-    IndexedColumnReader reader(block_mgr, filename, index_meta->page_zone_maps());
+    IndexedColumnReader reader(block_mgr, filename, file_id, index_meta->page_zone_maps());
     RETURN_IF_ERROR(reader.load(use_page_cache, kept_in_memory));
     std::unique_ptr<IndexedColumnIterator> iter;
     RETURN_IF_ERROR(reader.new_iterator(&iter));
@@ -70,8 +70,8 @@ public:
     ZoneMapIndexReader() = default;
 
     // load all page zone maps into memory
-    Status load(fs::BlockManager* block_mgr, const std::string& filename, const ZoneMapIndexPB* index_meta,
-                bool use_page_cache, bool kept_in_memory);
+    Status load(fs::BlockManager* block_mgr, const std::string& filename, uint64_t file_id,
+                const ZoneMapIndexPB* index_meta, bool use_page_cache, bool kept_in_memory);
 
     const std::vector<ZoneMapPB>& page_zone_maps() const { return _page_zone_maps; }
 
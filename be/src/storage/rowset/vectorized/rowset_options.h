@@ -17,6 +17,7 @@ class OlapReaderStatistics;
 class RuntimeProfile;
 class RowCursor;
 class RuntimeState;
+class Tablet;
 class TabletSchema;
 } // namespace starrocks
 
@@ -24,7 +25,9 @@ namespace starrocks::vectorized {
 
 class ColumnPredicate;
 class DeletePredicates;
+class RuntimePredicate;
 class Schema;
+struct RowidRangeOption;
 
 class RowsetReadOptions {
 public:
@@ -49,6 +52,8 @@ public:
     const DeletePredicates* delete_predicates = nullptr;
 
     const TabletSchema* tablet_schema = nullptr;
+    // If not null, the delete predicates of the segments are materialized into the bitmaps of DeleteBitmapCache.
+    std::shared_ptr<Tablet> tablet;
 
     bool is_primary_keys = false;
     int64_t version = 0;
@@ -58,6 +63,15 @@ public:
     starrocks::RuntimeState* runtime_state = nullptr;
     starrocks::RuntimeProfile* profile = nullptr;
     bool use_page_cache = false;
+
+    // If not null, only the rowid range of one segment of one rowset is read.
+    std::shared_ptr<RowidRangeOption> rowid_range_option = nullptr;
+
+    std::shared_ptr<RuntimePredicate> runtime_predicate = nullptr;
+
+    // See SegmentReadOptions::metadata_scan.
+    bool metadata_scan = false;
+    std::vector<ColumnId> metadata_min_max_columns;
 };
 
 } // namespace starrocks::vectorized
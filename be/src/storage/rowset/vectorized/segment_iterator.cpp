@@ -2,7 +2,10 @@
 
 #include "storage/rowset/vectorized/segment_iterator.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <tuple>
 
 #include "butil/containers/flat_map.h"
 #include "column/chunk.h"
@@ -30,9 +33,12 @@
 #include "storage/vectorized/chunk_iterator.h"
 #include "storage/vectorized/column_or_predicate.h"
 #include "storage/vectorized/column_predicate.h"
+#include "storage/vectorized/predicate_parser.h"
 #include "storage/vectorized/projection_iterator.h"
 #include "storage/vectorized/range.h"
 #include "storage/vectorized/roaring2range.h"
+#include "storage/vectorized/runtime_predicate.h"
+#include "util/adaptive_predicate_order.h"
 #include "util/starrocks_metrics.h"
 
 namespace starrocks::vectorized {
@@ -149,9 +155,13 @@ private:
             _final_chunk.reset();
         }
 
+        bool is_stage_column(size_t i) const { return !_is_stage_column.empty() && _is_stage_column[i]; }
+
         Status seek_columns(ordinal_t pos) {
-            for (auto iter : _column_iterators) {
-                RETURN_IF_ERROR(iter->seek_to_ordinal(pos));
+            for (size_t i = 0; i < _column_iterators.size(); i++) {
+                if (!is_stage_column(i)) {
+                    RETURN_IF_ERROR(_column_iterators[i]->seek_to_ordinal(pos));
+                }
             }
             return Status::OK();
         }
@@ -160,6 +170,11 @@ private:
             bool may_has_del_row = chunk->delete_state() != DEL_NOT_SATISFIED;
             for (size_t i = 0; i < _column_iterators.size(); i++) {
                 const ColumnPtr& col = chunk->get_column_by_index(i);
+                if (is_stage_column(i)) {
+                    // fetched by the rowids of the rows left by the previous stages.
+                    col->append_default(n);
+                    continue;
+                }
                 RETURN_IF_ERROR(_column_iterators[i]->next_batch(&n, col.get()));
                 may_has_del_row |= (col->delete_state() != DEL_NOT_SATISFIED);
             }
@@ -192,6 +207,18 @@ private:
         // if true, the last item of |_column_iterators| is a `RowIdColumnIterator` and
         // the last item of |_read_schema| and |_dict_decode_schema| is a row id field.
         bool _late_materialize;
+
+        // The predicate columns evaluated by stages, by their indexes in |_column_iterators|, in the order of
+        // the stages. They are not read along with the other columns, but fetched by the rowids of the rows left
+        // by the previous stages, and |_stage_predicates[i]| are the predicates of |_stage_columns[i]|.
+        // Empty unless |_late_materialize|.
+        std::vector<size_t> _stage_columns;
+        std::vector<std::vector<const ColumnPredicate*>> _stage_predicates;
+        std::vector<bool> _is_stage_column;
+        // The predicates of the first stage, i.e, of the columns read along with the rowids, if there are stages.
+        std::vector<const ColumnPredicate*> _vectorized_preds;
+        std::vector<const ColumnPredicate*> _branchless_preds;
+        AdaptivePredicateOrder _branchless_order;
     };
 
     Status _init();
@@ -201,6 +228,7 @@ private:
     Status _get_row_ranges_by_keys();
     Status _get_row_ranges_by_zone_map();
     Status _get_row_ranges_by_bloom_filter();
+    Status _get_row_ranges_by_runtime_predicate();
 
     uint32_t segment_id() const { return _segment->id(); }
     uint32_t num_rows() const { return _segment->num_rows(); }
@@ -210,9 +238,12 @@ private:
     Status _read_columns(const Schema& schema, Chunk* chunk, size_t nrows);
 
     uint16_t _filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t to);
+    Status _filter_by_stages(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t* to);
 
     void _init_column_predicates();
 
+    void _init_predicate_stages(ScanContext* ctx);
+
     void _init_context();
 
     template <bool late_materialization>
@@ -221,6 +252,7 @@ private:
     void _rewrite_predicates();
 
     bool _rewrite_predicate(const FieldPtr& field);
+    bool _rewrite_predicates_by_dict_filter(const FieldPtr& field);
 
     Status _decode_dict_codes(ScanContext* ctx);
 
@@ -237,9 +269,16 @@ private:
     Status _init_bitmap_index_iterators();
 
     Status _apply_bitmap_index();
+    // Read the rows whose values of the column |cid| are of the dictionary entries |selected|, excluding
+    // the null rows unless |has_is_null|.
+    Status _read_bitmap_index(ColumnId cid, const SparseRange& selected, bool has_is_null, Roaring* rows);
 
     Status _read(Chunk* chunk, vector<rowid_t>* rowid, size_t n);
 
+    void _init_read_ahead();
+    void _count_index_filtered_bytes();
+    void _read_ahead(rowid_t rowid);
+
 private:
     std::shared_ptr<Segment> _segment;
     vectorized::SegmentReadOptions _opts;
@@ -256,8 +295,22 @@ private:
     SparseRange _scan_range;
     SparseRangeIterator _range_iter;
 
+    // The data pages of all the columns to be read, in the order of their first rows. The pages before
+    // |_read_ahead_pos| have been prefetched, and the next pages are prefetched once the rows before
+    // |_read_ahead_rowid| have been read.
+    struct ReadAheadPage {
+        rowid_t first_rowid;
+        uint64_t offset;
+        uint32_t size;
+    };
+    std::vector<ReadAheadPage> _read_ahead_pages;
+    size_t _read_ahead_pos = 0;
+    rowid_t _read_ahead_rowid = 0;
+
     std::vector<const ColumnPredicate*> _vectorized_preds;
     std::vector<const ColumnPredicate*> _branchless_preds;
+    // The branchless predicates are evaluated on the rows left by each other in this order.
+    AdaptivePredicateOrder _branchless_order;
     // _selection is used to accelerate
     Buffer<uint8_t> _selection;
 
@@ -273,6 +326,10 @@ private:
     // a mapping from column id to a indicate whether it's predicate need rewrite.
     std::vector<uint8_t> _predicate_need_rewrite;
 
+    // The estimated fractions of the rows selected by the predicates of the columns, by the bitmap indexes, or
+    // by the zone maps of the columns without bitmap index.
+    std::map<ColumnId, double> _predicate_selectivity;
+
     ObjectPool _obj_pool;
 
     // initial size of |_opts.predicates|.
@@ -281,6 +338,9 @@ private:
     // the next rowid to read
     rowid_t _cur_rowid = 0;
 
+    // the version of |_opts.runtime_predicate| the rows not read yet have been pruned with.
+    int64_t _runtime_predicate_version = 0;
+
     int _late_materialization_ratio = 0;
 
     bool _inited = false;
@@ -306,15 +366,18 @@ Status SegmentIterator::_init() {
         if (_del_vec && _del_vec->empty()) {
             _del_vec.reset();
         }
-        if (_del_vec) {
-            if (_segment->num_rows() == _del_vec->cardinality()) {
-                return Status::EndOfFile("all rows deleted");
-            }
-            VLOG(1) << "seg_iter init delvec tablet:" << _opts.tablet_id << " rowset:" << _opts.rowset_id
-                    << " seg:" << segment_id() << " version req:" << _opts.version << " actual:" << _del_vec->version()
-                    << " " << _del_vec->cardinality() << "/" << _segment->num_rows();
-            roaring_init_iterator(&_del_vec->roaring()->roaring, &_roaring_iter);
+    } else if (_opts.delete_bitmap != nullptr && !_opts.delete_bitmap->empty()) {
+        // The rows deleted by the materialized delete predicates are filtered out like a delete vector.
+        _del_vec = _opts.delete_bitmap;
+    }
+    if (_del_vec) {
+        if (_segment->num_rows() == _del_vec->cardinality()) {
+            return Status::EndOfFile("all rows deleted");
         }
+        VLOG(1) << "seg_iter init delvec tablet:" << _opts.tablet_id << " rowset:" << _opts.rowset_id
+                << " seg:" << segment_id() << " version req:" << _opts.version << " actual:" << _del_vec->version()
+                << " " << _del_vec->cardinality() << "/" << _segment->num_rows();
+        roaring_init_iterator(&_del_vec->roaring()->roaring, &_roaring_iter);
     }
 
     RETURN_IF_ERROR(_segment->_load_index());
@@ -336,10 +399,16 @@ Status SegmentIterator::_init() {
     RETURN_IF_ERROR(_apply_bitmap_index());
     RETURN_IF_ERROR(_get_row_ranges_by_zone_map());
     RETURN_IF_ERROR(_get_row_ranges_by_bloom_filter());
+    _count_index_filtered_bytes();
     _rewrite_predicates();
     _init_context();
     _init_column_predicates();
+    for (ScanContext& ctx : _context_list) {
+        _init_predicate_stages(&ctx);
+    }
     _range_iter = _scan_range.new_iterator();
+    _init_read_ahead();
+    _read_ahead(_range_iter.begin());
 
     return Status::OK();
 }
@@ -366,6 +435,7 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
             ColumnIteratorOptions iter_opts;
             iter_opts.stats = _opts.stats;
             iter_opts.use_page_cache = _opts.use_page_cache;
+            iter_opts.use_decoded_page_cache = _opts.use_page_cache;
             iter_opts.rblock = _rblock.get();
             iter_opts.check_dict_encoding = check_dict_enc;
             RETURN_IF_ERROR(_column_iterators[cid]->init(iter_opts));
@@ -397,11 +467,74 @@ void SegmentIterator::_init_column_predicates() {
     }
 }
 
+// Order the predicate columns of the late materialization context |ctx| by the estimated selectivities of their
+// predicates, so that only the most selective one is read along with the rowids, and each of the others is fetched
+// only for the rows left by the previous ones. The dict-coded columns are always read in the first stage, since
+// their codes can't be fetched by the rowids.
+void SegmentIterator::_init_predicate_stages(ScanContext* ctx) {
+    if (!config::enable_segment_predicate_stages || !ctx->_late_materialize || _opts.predicates.empty()) {
+        return;
+    }
+    std::vector<std::vector<const ColumnPredicate*>> preds(_predicate_columns);
+    // (estimated selectivity, whether of variable length, index in |ctx->_column_iterators|)
+    std::vector<std::tuple<double, bool, size_t>> candidates;
+    for (size_t i = 0; i < _predicate_columns; i++) {
+        const FieldPtr& f = _schema.field(i);
+        auto iter = _opts.predicates.find(f->id());
+        if (iter == _opts.predicates.end()) {
+            continue;
+        }
+        for (const ColumnPredicate* pred : iter->second) {
+            if (!pred->is_index_filter_only()) {
+                preds[i].emplace_back(pred);
+            }
+        }
+        if (preds[i].empty()) {
+            continue;
+        }
+        auto estimate = _predicate_selectivity.find(f->id());
+        double selectivity = estimate != _predicate_selectivity.end() ? estimate->second : 1.0;
+        // the cheaper columns are evaluated first if their predicates are estimated alike.
+        candidates.emplace_back(selectivity, is_string_type(f->type()->type()), i);
+    }
+    if (candidates.size() < 2) {
+        return;
+    }
+    std::stable_sort(candidates.begin(), candidates.end());
+
+    ctx->_is_stage_column.assign(ctx->_column_iterators.size(), false);
+    for (size_t k = 1; k < candidates.size(); k++) {
+        size_t i = std::get<2>(candidates[k]);
+        if (!ctx->_is_dict_column[i]) {
+            ctx->_is_stage_column[i] = true;
+            ctx->_stage_columns.emplace_back(i);
+            ctx->_stage_predicates.emplace_back(std::move(preds[i]));
+            preds[i].clear();
+        }
+    }
+    if (ctx->_stage_columns.empty()) {
+        ctx->_is_stage_column.clear();
+        return;
+    }
+    for (size_t i = 0; i < _predicate_columns; i++) {
+        for (const ColumnPredicate* pred : preds[i]) {
+            if (pred->can_vectorized()) {
+                ctx->_vectorized_preds.emplace_back(pred);
+            } else {
+                ctx->_branchless_preds.emplace_back(pred);
+            }
+        }
+    }
+}
+
 Status SegmentIterator::_get_row_ranges_by_keys() {
     StarRocksMetrics::instance()->segment_row_total.increment(num_rows());
 
     if (_opts.ranges.empty()) {
         _scan_range.add(Range(0, num_rows()));
+        if (_opts.rowid_range != nullptr) {
+            _scan_range &= *_opts.rowid_range;
+        }
         return Status::OK();
     }
     DCHECK_EQ(0, _scan_range.span_size());
@@ -421,7 +554,13 @@ Status SegmentIterator::_get_row_ranges_by_keys() {
             _scan_range.add(Range{lower_rowid, upper_rowid});
         }
     }
-    _opts.stats->rows_key_range_filtered += num_rows() - _scan_range.span_size();
+    size_t num_candidate_rows = num_rows();
+    if (_opts.rowid_range != nullptr) {
+        // The rows out of |rowid_range| are read by the other scan tasks, so they are not key range filtered.
+        _scan_range &= *_opts.rowid_range;
+        num_candidate_rows = _opts.rowid_range->span_size();
+    }
+    _opts.stats->rows_key_range_filtered += num_candidate_rows - _scan_range.span_size();
     StarRocksMetrics::instance()->segment_rows_by_short_key.increment(_scan_range.span_size());
     return Status::OK();
 }
@@ -470,6 +609,11 @@ Status SegmentIterator::_get_row_ranges_by_zone_map() {
         SparseRange r;
         RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map(query_preds, del_pred, &r));
         zm_range = zm_range.intersection(r);
+        if (!query_preds.empty() && _scan_range.span_size() > 0 && !_predicate_selectivity.count(cid)) {
+            // the pages partially satisfying the predicates are taken as all selected.
+            size_t selected = _scan_range.intersection(r).span_size();
+            _predicate_selectivity[cid] = static_cast<double>(selected) / _scan_range.span_size();
+        }
     }
     StarRocksMetrics::instance()->segment_rows_read_by_zone_map.increment(zm_range.span_size());
     size_t prev_size = _scan_range.span_size();
@@ -478,6 +622,38 @@ Status SegmentIterator::_get_row_ranges_by_zone_map() {
     return Status::OK();
 }
 
+// Prune the rows not read yet by the zone maps with the conditions of |_opts.runtime_predicate|,
+// which are more selective than the last time.
+Status SegmentIterator::_get_row_ranges_by_runtime_predicate() {
+    _runtime_predicate_version = _opts.runtime_predicate->version();
+    if (!_range_iter.has_more()) {
+        return Status::OK();
+    }
+
+    PredicateParser parser(_segment->tablet_schema());
+    SparseRange zm_range(0, num_rows());
+    for (const TCondition& condition : _opts.runtime_predicate->conditions()) {
+        std::unique_ptr<ColumnPredicate> pred(parser.parse(condition));
+        if (pred == nullptr) {
+            continue;
+        }
+        const ColumnId cid = pred->column_id();
+        if (cid >= _column_iterators.size() || _column_iterators[cid] == nullptr) {
+            continue;
+        }
+        SparseRange r;
+        RETURN_IF_ERROR(_column_iterators[cid]->get_row_ranges_by_zone_map({pred.get()}, nullptr, &r));
+        zm_range = zm_range.intersection(r);
+    }
+    // the rows before |_range_iter| have been read.
+    _scan_range = _scan_range.intersection(SparseRange(_range_iter.begin(), num_rows()));
+    size_t prev_size = _scan_range.span_size();
+    _scan_range = _scan_range.intersection(zm_range);
+    _opts.stats->rows_stats_filtered += (prev_size - _scan_range.span_size());
+    _range_iter = _scan_range.new_iterator();
+    return Status::OK();
+}
+
 // if |lower| is true, return the first row in the range [0, end) that is not less than |key|,
 // or end if no such row is found.
 // if |lower| is false, return the first row in the range [0, end) that is greater than |key|,
@@ -565,8 +741,100 @@ Status SegmentIterator::_read_columns(const Schema& schema, Chunk* chunk, size_t
     return Status::OK();
 }
 
+void SegmentIterator::_init_read_ahead() {
+    if (config::segment_read_ahead_bytes <= 0 || !is_query(_opts.reader_type)) {
+        return;
+    }
+    std::vector<ordinal_t> first_ordinals;
+    std::vector<PagePointer> pages;
+    for (const FieldPtr& f : _schema.fields()) {
+        const ColumnId cid = f->id();
+        // the columns added after the segment was written have no pages.
+        if (cid < _segment->_column_readers.size() && _segment->_column_readers[cid] != nullptr) {
+            _segment->_column_readers[cid]->get_data_pages(_scan_range, &first_ordinals, &pages);
+        }
+    }
+    _read_ahead_pages.reserve(pages.size());
+    for (size_t i = 0; i < pages.size(); ++i) {
+        _read_ahead_pages.push_back({static_cast<rowid_t>(first_ordinals[i]), pages[i].offset, pages[i].size});
+    }
+    std::stable_sort(_read_ahead_pages.begin(), _read_ahead_pages.end(),
+                     [](const ReadAheadPage& lhs, const ReadAheadPage& rhs) {
+                         return lhs.first_rowid < rhs.first_rowid;
+                     });
+}
+
+// The data pages of the columns to read which are not read at all, because none of their rows is left by the indexes.
+void SegmentIterator::_count_index_filtered_bytes() {
+    SparseRange candidates = _opts.rowid_range != nullptr ? *_opts.rowid_range : SparseRange(0, num_rows());
+    if (_scan_range.span_size() == candidates.span_size()) {
+        return;
+    }
+    std::vector<ordinal_t> first_ordinals;
+    std::vector<PagePointer> candidate_pages;
+    std::vector<PagePointer> pages;
+    for (const FieldPtr& f : _schema.fields()) {
+        const ColumnId cid = f->id();
+        if (cid < _segment->_column_readers.size() && _segment->_column_readers[cid] != nullptr) {
+            _segment->_column_readers[cid]->get_data_pages(candidates, &first_ordinals, &candidate_pages);
+            _segment->_column_readers[cid]->get_data_pages(_scan_range, &first_ordinals, &pages);
+        }
+    }
+    int64_t bytes = 0;
+    for (const PagePointer& page : candidate_pages) {
+        bytes += page.size;
+    }
+    for (const PagePointer& page : pages) {
+        bytes -= page.size;
+    }
+    _opts.stats->bytes_index_filtered += bytes;
+}
+
+void SegmentIterator::_read_ahead(rowid_t rowid) {
+    if (_read_ahead_pos >= _read_ahead_pages.size() || rowid < _read_ahead_rowid) {
+        return;
+    }
+    // The pages starting before |rowid| are being read, and are always prefetched along with the next ones.
+    const size_t begin = _read_ahead_pos;
+    int64_t bytes = 0;
+    std::vector<std::pair<uint64_t, uint64_t>> extents;
+    while (_read_ahead_pos < _read_ahead_pages.size() &&
+           (bytes < config::segment_read_ahead_bytes || _read_ahead_pages[_read_ahead_pos].first_rowid <= rowid)) {
+        const ReadAheadPage& page = _read_ahead_pages[_read_ahead_pos++];
+        extents.emplace_back(page.offset, page.offset + page.size);
+        bytes += page.size;
+    }
+    const rowid_t first_rowid = _read_ahead_pages[begin].first_rowid;
+    const rowid_t last_rowid = _read_ahead_pages[_read_ahead_pos - 1].first_rowid;
+    _read_ahead_rowid = first_rowid + (last_rowid - first_rowid) / 2;
+
+    // The pages of a column are contiguous in the file, so are coalesced into a few large ranges.
+    std::sort(extents.begin(), extents.end());
+    constexpr uint64_t kMaxGap = 64 * 1024;
+    size_t n = 0;
+    for (size_t i = 1; i < extents.size(); ++i) {
+        if (extents[i].first <= extents[n].second + kMaxGap) {
+            extents[n].second = std::max(extents[n].second, extents[i].second);
+        } else {
+            extents[++n] = extents[i];
+        }
+    }
+    extents.resize(n + 1);
+    for (const auto& [begin_offset, end_offset] : extents) {
+        Status st = _rblock->prefetch(begin_offset, end_offset - begin_offset);
+        if (!st.ok()) {
+            // It's only a hint, give up the read-ahead.
+            LOG(WARNING) << "Fail to prefetch " << _segment->file_name() << ": " << st.to_string();
+            _read_ahead_pos = _read_ahead_pages.size();
+            return;
+        }
+    }
+    _opts.stats->read_ahead_bytes += bytes;
+}
+
 inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowid, size_t n) {
     Range r = _range_iter.next(n);
+    _read_ahead(r.begin());
     size_t nread = r.span_size();
     if (_cur_rowid != r.begin() || _cur_rowid == 0) {
         _cur_rowid = r.begin();
@@ -642,6 +910,10 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
 
     Chunk* chunk = _context->_read_chunk.get();
 
+    if (_opts.runtime_predicate != nullptr && _opts.runtime_predicate->version() != _runtime_predicate_version) {
+        RETURN_IF_ERROR(_get_row_ranges_by_runtime_predicate());
+    }
+
     while ((chunk_start < chunk_capacity) & _range_iter.has_more()) {
         RETURN_IF_ERROR(_read(chunk, rowid, chunk_capacity - chunk_start));
         chunk->check_or_die();
@@ -651,6 +923,10 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
             next_start = _filter(chunk, rowid, chunk_start, next_start);
             chunk->check_or_die();
         }
+        if (!_context->_stage_columns.empty()) {
+            RETURN_IF_ERROR(_filter_by_stages(chunk, rowid, chunk_start, &next_start));
+            chunk->check_or_die();
+        }
         chunk_start = next_start;
         DCHECK_EQ(chunk_start, chunk->num_rows());
     }
@@ -727,7 +1003,12 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
 
 void SegmentIterator::_switch_context(ScanContext* to) {
     if (_context != nullptr) {
-        const ordinal_t ordinal = _context->_column_iterators[0]->get_current_ordinal();
+        // the columns of the later stages are not read sequentially.
+        size_t i = 0;
+        while (_context->is_stage_column(i)) {
+            i++;
+        }
+        const ordinal_t ordinal = _context->_column_iterators[i]->get_current_ordinal();
         for (ColumnIterator* iter : to->_column_iterators) {
             iter->seek_to_ordinal(ordinal);
         }
@@ -761,30 +1042,37 @@ void SegmentIterator::_switch_context(ScanContext* to) {
 }
 
 uint16_t SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t to) {
-    // There must be one predicate, either vectorized or branchless.
-    DCHECK(_vectorized_preds.size() + _branchless_preds.size() > 0 || _del_vec);
+    // The predicates of the later stages are evaluated by `_filter_by_stages`.
+    const bool staged = !_context->_stage_columns.empty();
+    const auto& vectorized_preds = staged ? _context->_vectorized_preds : _vectorized_preds;
+    const auto& branchless_preds = staged ? _context->_branchless_preds : _branchless_preds;
+    auto& branchless_order = staged ? _context->_branchless_order : _branchless_order;
+
+    if (vectorized_preds.empty() && branchless_preds.empty() && !_del_vec) {
+        return to;
+    }
 
     SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
 
     // first evaluate
-    if (!_vectorized_preds.empty()) {
+    if (!vectorized_preds.empty()) {
         SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
-        const ColumnPredicate* pred = _vectorized_preds[0];
+        const ColumnPredicate* pred = vectorized_preds[0];
         Column* c = chunk->get_column_by_id(pred->column_id()).get();
         pred->evaluate(c, _selection.data(), from, to);
-        for (int i = 1; i < _vectorized_preds.size(); ++i) {
-            pred = _vectorized_preds[i];
+        for (int i = 1; i < vectorized_preds.size(); ++i) {
+            pred = vectorized_preds[i];
             c = chunk->get_column_by_id(pred->column_id()).get();
             pred->evaluate_and(c, _selection.data(), from, to);
         }
     }
 
     // evaluate brachless
-    if (!_branchless_preds.empty()) {
+    if (!branchless_preds.empty()) {
         SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
 
         uint16_t selected_size = 0;
-        if (!_vectorized_preds.empty()) {
+        if (!vectorized_preds.empty()) {
             for (uint16_t i = from; i < to; ++i) {
                 _selected_idx[selected_size] = i;
                 selected_size += _selection[i];
@@ -798,11 +1086,11 @@ uint16_t SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t
             }
         }
 
-        for (size_t i = 0; selected_size > 0 && i < _branchless_preds.size(); ++i) {
-            const ColumnPredicate* pred = _branchless_preds[i];
+        selected_size = branchless_order.evaluate(branchless_preds.size(), selected_size, [&](size_t i, size_t rows) {
+            const ColumnPredicate* pred = branchless_preds[i];
             ColumnPtr& c = chunk->get_column_by_id(pred->column_id());
-            selected_size = pred->evaluate_branchless(c.get(), _selected_idx.data(), selected_size);
-        }
+            return pred->evaluate_branchless(c.get(), _selected_idx.data(), rows);
+        });
 
         memset(&_selection[from], 0, to - from);
         for (uint16_t i = 0; i < selected_size; ++i) {
@@ -812,7 +1100,7 @@ uint16_t SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t
 
     int64_t del_vec_filtered = 0;
     if (_del_vec) {
-        if (_vectorized_preds.empty() && _branchless_preds.empty()) {
+        if (vectorized_preds.empty() && branchless_preds.empty()) {
             // setup selection vector
             memset(_selection.data() + from, 1, to - from);
         }
@@ -851,6 +1139,62 @@ uint16_t SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t
     return chunk_size;
 }
 
+// Evaluate the predicates of the later stages on the rows [from, *to) of |chunk| left by the first stage, fetching
+// the values of the column of each stage only for the rows left by the previous stages.
+Status SegmentIterator::_filter_by_stages(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t* to) {
+    SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
+    ScanContext* ctx = _context;
+    const size_t m = ctx->_read_schema.num_fields();
+    // last column of |_read_chunk| is filled by `RowIdColumnIterator`.
+    const auto* ordinals = down_cast<FixedLengthColumn<rowid_t>*>(chunk->get_column_by_index(m - 1).get());
+    const uint16_t input_rows = *to;
+    for (size_t s = 0; s < ctx->_stage_columns.size(); s++) {
+        const size_t i = ctx->_stage_columns[s];
+        ColumnPtr& col = chunk->get_column_by_index(i);
+        // the rows before |from| are of the previous reads of this chunk, whose values have been fetched.
+        col->resize(from);
+        if (*to == from) {
+            // no row left, the columns of the next stages are truncated likewise.
+            continue;
+        }
+        {
+            SCOPED_RAW_TIMER(&_opts.stats->block_fetch_ns);
+            const rowid_t* rowids = ordinals->get_data().data() + from;
+            RETURN_IF_ERROR(ctx->_column_iterators[i]->fetch_values_by_rowid(rowids, *to - from, col.get()));
+            DCHECK_EQ(*to, col->size());
+            if (col->delete_state() != DEL_NOT_SATISFIED) {
+                chunk->set_delete_state(DEL_PARTIAL_SATISFIED);
+            }
+        }
+        {
+            SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
+            const auto& preds = ctx->_stage_predicates[s];
+            preds[0]->evaluate(col.get(), _selection.data(), from, *to);
+            for (size_t j = 1; j < preds.size(); j++) {
+                preds[j]->evaluate_and(col.get(), _selection.data(), from, *to);
+            }
+        }
+        auto hit_count = SIMD::count_nonzero(&_selection[from], *to - from);
+        SCOPED_RAW_TIMER(&_opts.stats->vec_cond_chunk_copy_ns);
+        if (hit_count == 0) {
+            chunk->set_num_rows(from);
+            if (rowid != nullptr) {
+                rowid->resize(from);
+            }
+            *to = from;
+        } else if (hit_count != *to - from) {
+            uint16_t chunk_size = chunk->filter_range(_selection, from, *to);
+            if (rowid != nullptr) {
+                auto size = ColumnHelper::filter_range<uint32_t>(_selection, rowid->data(), from, *to);
+                rowid->resize(size);
+            }
+            *to = chunk_size;
+        }
+    }
+    _opts.stats->rows_vec_cond_filtered += input_rows - *to;
+    return Status::OK();
+}
+
 inline bool SegmentIterator::_can_using_dict_code(const FieldPtr& field) const {
     if (_opts.predicates.find(field->id()) != _opts.predicates.end()) {
         return _predicate_need_rewrite[field->id()];
@@ -959,6 +1303,10 @@ bool SegmentIterator::_rewrite_predicate(const FieldPtr& field) {
     PredicateList& preds = iter->second;
     // the predicate has been erased, because of bitmap index filter.
     RETURN_IF(preds.empty(), false);
+    if (preds.size() > 1 || preds[0]->type() == PredicateType::kGT || preds[0]->type() == PredicateType::kGE ||
+        preds[0]->type() == PredicateType::kLT || preds[0]->type() == PredicateType::kLE) {
+        return _rewrite_predicates_by_dict_filter(field);
+    }
     const ColumnPredicate* pred = preds[0];
     if (PredicateType::kEQ == pred->type()) {
         Datum value = pred->value();
@@ -1045,6 +1393,57 @@ bool SegmentIterator::_rewrite_predicate(const FieldPtr& field) {
     return false;
 }
 
+// Evaluate the predicates on every word of the segment dictionary once, and replace them with a predicate
+// selecting the codes of the words satisfying all of them.
+bool SegmentIterator::_rewrite_predicates_by_dict_filter(const FieldPtr& field) {
+    ColumnId cid = field->id();
+    ColumnIterator* column_iter = _column_iterators[cid];
+    PredicateList& preds = _opts.predicates[cid];
+    const int dict_size = column_iter->dict_size();
+    RETURN_IF(dict_size <= 0, false);
+
+    std::vector<uint8_t> dict_filter(dict_size);
+    std::vector<int32_t> codes;
+    ColumnPtr words = ChunkHelper::column_from_field_type(field->type()->type(), false);
+    constexpr int kBatchSize = 4096;
+    for (int begin = 0; begin < dict_size; begin += kBatchSize) {
+        const int end = std::min(dict_size, begin + kBatchSize);
+        codes.resize(end - begin);
+        for (int code = begin; code < end; code++) {
+            codes[code - begin] = code;
+        }
+        words->resize(0);
+        if (!column_iter->decode_dict_codes(codes.data(), codes.size(), words.get()).ok()) {
+            return false;
+        }
+        uint8_t* selection = dict_filter.data() + begin;
+        preds[0]->evaluate(words.get(), selection, 0, end - begin);
+        for (size_t i = 1; i < preds.size(); i++) {
+            preds[i]->evaluate_and(words.get(), selection, 0, end - begin);
+        }
+    }
+
+    const size_t num_selected = SIMD::count_nonzero(dict_filter);
+    if (num_selected == 0) {
+        // predicate always false, clear scan range.
+        _scan_range = _scan_range.intersection(SparseRange());
+        return false;
+    }
+    if (num_selected == static_cast<size_t>(dict_size)) {
+        preds.clear();
+        if (field->is_nullable()) {
+            // the predicates are only false for null.
+            preds.emplace_back(
+                    _obj_pool.add(new_column_null_predicate(get_type_info(OLAP_FIELD_TYPE_VARCHAR), cid, false)));
+        }
+        return false;
+    }
+    auto ptr = new_column_dict_filter_predicate(get_type_info(kDictCodeType), cid, std::move(dict_filter));
+    preds.clear();
+    preds.emplace_back(_obj_pool.add(ptr));
+    return true;
+}
+
 Status SegmentIterator::_decode_dict_codes(ScanContext* ctx) {
     DCHECK_NE(ctx->_read_chunk, ctx->_dict_chunk);
     const Schema& decode_schema = ctx->_dict_decode_schema;
@@ -1089,12 +1488,22 @@ void SegmentIterator::_check_low_cardinality_optimization() {
         auto iter = _opts.predicates.find(cid);
         DCHECK(iter != _opts.predicates.end());
         const PredicateList& preds = iter->second;
-        if (preds.size() != 1) {
+        const PredicateType type0 = preds.empty() ? PredicateType::kUnknown : preds[0]->type();
+        if (preds.size() == 1 && (type0 == PredicateType::kEQ || type0 == PredicateType::kInList ||
+                                  type0 == PredicateType::kNE || type0 == PredicateType::kNotInList)) {
+            _predicate_need_rewrite[cid] = true;
             continue;
         }
-        _predicate_need_rewrite[cid] =
-                preds[0]->type() == PredicateType::kEQ || preds[0]->type() == PredicateType::kInList ||
-                preds[0]->type() == PredicateType::kNE || preds[0]->type() == PredicateType::kNotInList;
+        // the other predicates comparing the values are evaluated on the dictionary words instead.
+        _predicate_need_rewrite[cid] = !preds.empty();
+        for (const ColumnPredicate* pred : preds) {
+            const PredicateType t = pred->type();
+            _predicate_need_rewrite[cid] &= !pred->is_index_filter_only() &&
+                                            (t == PredicateType::kEQ || t == PredicateType::kNE ||
+                                             t == PredicateType::kGT || t == PredicateType::kGE ||
+                                             t == PredicateType::kLT || t == PredicateType::kLE ||
+                                             t == PredicateType::kInList || t == PredicateType::kNotInList);
+        }
     }
 }
 
@@ -1131,9 +1540,13 @@ Status SegmentIterator::_finish_late_materialization(ScanContext* ctx) {
 Status SegmentIterator::_init_bitmap_index_iterators() {
     DCHECK_EQ(_predicate_columns, _opts.predicates.size());
     _bitmap_index_iterators.resize(ChunkHelper::max_column_id(_schema) + 1, nullptr);
+    std::set<ColumnId> columns;
+    _opts.delete_predicates.get_column_ids(&columns);
     for (const auto& pair : _opts.predicates) {
-        ColumnId cid = pair.first;
-        if (_bitmap_index_iterators[cid] == nullptr) {
+        columns.insert(pair.first);
+    }
+    for (ColumnId cid : columns) {
+        if (cid < _bitmap_index_iterators.size() && _bitmap_index_iterators[cid] == nullptr) {
             RETURN_IF_ERROR(_segment->new_bitmap_index_iterator(cid, &_bitmap_index_iterators[cid]));
             _has_bitmap_index |= (_bitmap_index_iterators[cid] != nullptr);
         }
@@ -1141,6 +1554,18 @@ Status SegmentIterator::_init_bitmap_index_iterators() {
     return Status::OK();
 }
 
+Status SegmentIterator::_read_bitmap_index(ColumnId cid, const SparseRange& selected, bool has_is_null,
+                                           Roaring* rows) {
+    BitmapIndexIterator* bitmap_iter = _bitmap_index_iterators[cid];
+    RETURN_IF_ERROR(bitmap_iter->read_union_bitmap(selected, rows));
+    if (bitmap_iter->has_null_bitmap() && !has_is_null) {
+        Roaring null_bitmap;
+        RETURN_IF_ERROR(bitmap_iter->read_null_bitmap(&null_bitmap));
+        *rows -= null_bitmap;
+    }
+    return Status::OK();
+}
+
 // filter rows by evaluating column predicates using bitmap indexes.
 // upon return, predicates that have been evaluated by bitmap indexes will be removed.
 Status SegmentIterator::_apply_bitmap_index() {
@@ -1158,8 +1583,8 @@ Status SegmentIterator::_apply_bitmap_index() {
     std::vector<bool> has_is_null_predicate;
     std::vector<const ColumnPredicate*> erased_preds;
 
-    size_t mul_selected = 1;
-    size_t mul_cardinality = 1;
+    // the estimated fraction of the rows selected by the predicates.
+    double selectivity = 1;
     for (auto& [cid, pred_list] : _opts.predicates) {
         BitmapIndexIterator* bitmap_iter = _bitmap_index_iterators[cid];
         if (bitmap_iter == nullptr) {
@@ -1184,19 +1609,92 @@ Status SegmentIterator::_apply_bitmap_index() {
             _scan_range.clear();
             return Status::OK();
         }
+        if (cardinality > 0) {
+            // the predicates not erased are evaluated by stages in this order, if the bitmap index is bypassed.
+            _predicate_selectivity[cid] = static_cast<double>(selected.span_size()) / cardinality;
+        }
         if (selected.span_size() < cardinality) {
             bitmap_columns.emplace_back(cid);
             bitmap_ranges.emplace_back(selected);
             has_is_null_predicate.emplace_back(has_is_null);
-            mul_selected *= selected.span_size();
-            mul_cardinality *= cardinality;
+            selectivity *= static_cast<double>(selected.span_size()) / cardinality;
+        }
+    }
+
+    // ---------------------------------------------------------
+    // Seek bitmap index by the delete predicates.
+    //  - The rows deleted by a conjunction of the (disjunctive)
+    //    delete predicates are the intersection of the rows of
+    //    its columns, so it's evaluated by bitmap index only if
+    //    all of its columns have bitmap index, and all of its
+    //    predicates could seek the dictionary.
+    // ---------------------------------------------------------
+    struct DeleteConjunction {
+        size_t index;
+        std::vector<ColumnId> columns;
+        std::vector<SparseRange> ranges;
+        std::vector<bool> has_is_null;
+    };
+    std::vector<DeleteConjunction> delete_conjunctions;
+    // the estimated fraction of the rows deleted by |delete_conjunctions|.
+    double delete_selectivity = 0;
+    for (size_t i = 0; i < _opts.delete_predicates.size(); i++) {
+        std::set<ColumnId> columns;
+        _opts.delete_predicates[i].get_column_ids(&columns);
+        DeleteConjunction conjunction{i, {}, {}, {}};
+        double conjunction_selectivity = 1;
+        bool served = !columns.empty();
+        for (auto iter = columns.begin(); served && iter != columns.end(); ++iter) {
+            ColumnId cid = *iter;
+            BitmapIndexIterator* bitmap_iter = cid < _bitmap_index_iterators.size() ? _bitmap_index_iterators[cid]
+                                                                                      : nullptr;
+            if (bitmap_iter == nullptr || bitmap_iter->bitmap_nums() == 0) {
+                served = false;
+                break;
+            }
+            size_t cardinality = bitmap_iter->bitmap_nums();
+            SparseRange selected(0, cardinality);
+            bool has_is_null = false;
+            std::vector<const ColumnPredicate*> preds;
+            _opts.delete_predicates[i].predicates_of_column(cid, &preds);
+            for (const ColumnPredicate* pred : preds) {
+                SparseRange r;
+                Status st = pred->seek_bitmap_dictionary(bitmap_iter, &r);
+                if (st.is_cancelled()) {
+                    served = false;
+                    break;
+                }
+                RETURN_IF_ERROR(st);
+                selected &= r;
+                has_is_null |= (pred->type() == PredicateType::kIsNull);
+            }
+            conjunction.columns.emplace_back(cid);
+            conjunction.ranges.emplace_back(selected);
+            conjunction.has_is_null.emplace_back(has_is_null);
+            conjunction_selectivity *= static_cast<double>(selected.span_size()) / cardinality;
+        }
+        if (served) {
+            delete_conjunctions.emplace_back(std::move(conjunction));
+            delete_selectivity += conjunction_selectivity;
         }
     }
+    // The delete predicates deleting few rows are left to be evaluated on the pages partially satisfying them
+    // by the zone maps, where reading their bitmaps costs more than evaluating them.
+    if (delete_selectivity * 1000 < config::bitmap_index_delete_min_ratio) {
+        delete_conjunctions.clear();
+        delete_selectivity = 0;
+    }
 
     // ---------------------------------------------------------
     // Estimate the selectivity of the bitmap index.
+    //  - Bypass the bitmap index if the rows left by it are
+    //    estimated to be close to the rows of the segment.
     // ---------------------------------------------------------
-    if (bitmap_columns.empty() || (mul_selected * 1000 > mul_cardinality * config::bitmap_max_filter_ratio)) {
+    if (bitmap_columns.empty() || selectivity * 1000 > config::bitmap_max_filter_ratio) {
+        bitmap_columns.clear();
+        erased_preds.clear();
+    }
+    if (bitmap_columns.empty() && delete_conjunctions.empty()) {
         return Status::OK();
     }
 
@@ -1209,16 +1707,25 @@ Status SegmentIterator::_apply_bitmap_index() {
 
     for (size_t i = 0; i < bitmap_columns.size(); i++) {
         Roaring roaring;
-        BitmapIndexIterator* bitmap_iter = _bitmap_index_iterators[bitmap_columns[i]];
-        if (bitmap_iter->has_null_bitmap() && !has_is_null_predicate[i]) {
-            Roaring null_bitmap;
-            RETURN_IF_ERROR(bitmap_iter->read_null_bitmap(&null_bitmap));
-            row_bitmap -= null_bitmap;
-        }
-        RETURN_IF_ERROR(bitmap_iter->read_union_bitmap(bitmap_ranges[i], &roaring));
+        RETURN_IF_ERROR(_read_bitmap_index(bitmap_columns[i], bitmap_ranges[i], has_is_null_predicate[i], &roaring));
         row_bitmap &= roaring;
     }
 
+    for (const DeleteConjunction& conjunction : delete_conjunctions) {
+        Roaring deleted;
+        for (size_t i = 0; i < conjunction.columns.size(); i++) {
+            Roaring roaring;
+            RETURN_IF_ERROR(_read_bitmap_index(conjunction.columns[i], conjunction.ranges[i],
+                                               conjunction.has_is_null[i], &roaring));
+            if (i == 0) {
+                deleted = std::move(roaring);
+            } else {
+                deleted &= roaring;
+            }
+        }
+        row_bitmap -= deleted;
+    }
+
     DCHECK_LE(row_bitmap.cardinality(), _scan_range.span_size());
     if (row_bitmap.cardinality() < _scan_range.span_size()) {
         _scan_range = roaring2range(row_bitmap);
@@ -1231,6 +1738,9 @@ Status SegmentIterator::_apply_bitmap_index() {
         PredicateList& pred_list = _opts.predicates[pred->column_id()];
         pred_list.erase(std::find(pred_list.begin(), pred_list.end(), pred));
     }
+    for (auto iter = delete_conjunctions.rbegin(); iter != delete_conjunctions.rend(); ++iter) {
+        _opts.delete_predicates.erase(iter->index);
+    }
 
     _opts.stats->rows_bitmap_index_filtered += (input_rows - _scan_range.span_size());
     return Status::OK();
@@ -0,0 +1,129 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/vectorized/segment_metadata_iterator.h"
+
+#include <algorithm>
+
+#include "column/chunk.h"
+#include "column/datum.h"
+#include "storage/del_vector.h"
+#include "storage/rowset/segment_v2/column_reader.h"
+#include "storage/rowset/segment_v2/segment.h"
+#include "storage/rowset/vectorized/segment_options.h"
+#include "storage/storage_engine.h"
+#include "storage/update_manager.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks::vectorized {
+
+class SegmentMetadataIterator final : public ChunkIterator {
+public:
+    // |values| has two rows, the min values and the max values of the columns.
+    SegmentMetadataIterator(Schema schema, int chunk_size, size_t num_rows, ChunkPtr values)
+            : ChunkIterator(std::move(schema), chunk_size), _num_rows(num_rows), _values(std::move(values)) {}
+
+    void close() override { _values.reset(); }
+
+protected:
+    Status do_get_next(Chunk* chunk) override {
+        if (_next_row >= _num_rows) {
+            return Status::EndOfFile("end of segment metadata iterator");
+        }
+        size_t n = std::min<size_t>(_chunk_size, _num_rows - _next_row);
+        _next_row += n;
+        size_t num_max_rows = _next_row == _num_rows ? 1 : 0;
+        for (size_t i = 0; i < _values->num_columns(); i++) {
+            const Column& values = *_values->get_column_by_index(i);
+            Column* dst = chunk->get_column_by_index(i).get();
+            dst->append_value_multiple_times(values, 0, n - num_max_rows);
+            dst->append_value_multiple_times(values, 1, num_max_rows);
+        }
+        return Status::OK();
+    }
+
+private:
+    const size_t _num_rows;
+    size_t _next_row = 0;
+    ChunkPtr _values;
+};
+
+// The zone maps of the other types may be inexact, e.g. the strings and the floating point numbers.
+static bool is_exact_zone_map_type(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_BOOL:
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_DATE_V2:
+    case OLAP_FIELD_TYPE_TIMESTAMP:
+    case OLAP_FIELD_TYPE_DECIMAL_V2:
+    case OLAP_FIELD_TYPE_DECIMAL32:
+    case OLAP_FIELD_TYPE_DECIMAL64:
+    case OLAP_FIELD_TYPE_DECIMAL128:
+        return true;
+    default:
+        return false;
+    }
+}
+
+StatusOr<ChunkIteratorPtr> new_segment_metadata_iterator(const std::shared_ptr<segment_v2::Segment>& segment,
+                                                         const Schema& schema, const SegmentReadOptions& options) {
+    if (!options.predicates.empty() || !options.ranges.empty() || options.rowid_range != nullptr ||
+        !options.delete_predicates.empty() || options.delete_bitmap != nullptr ||
+        options.runtime_predicate != nullptr) {
+        return ChunkIteratorPtr();
+    }
+    std::vector<ColumnId> min_max_columns = options.metadata_min_max_columns;
+    std::sort(min_max_columns.begin(), min_max_columns.end());
+
+    size_t num_rows = segment->num_rows();
+    if (options.is_primary_keys && options.version > 0) {
+        TabletSegmentId tsid;
+        tsid.tablet_id = options.tablet_id;
+        tsid.segment_id = options.rowset_id + segment->id();
+        DelVectorPtr del_vec;
+        RETURN_IF_ERROR(StorageEngine::instance()->update_manager()->get_del_vec(options.meta, tsid, options.version,
+                                                                                 &del_vec));
+        if (del_vec != nullptr && !del_vec->empty()) {
+            // The min or max value may have been deleted.
+            for (const FieldPtr& field : schema.fields()) {
+                if (std::binary_search(min_max_columns.begin(), min_max_columns.end(), field->id())) {
+                    return ChunkIteratorPtr();
+                }
+            }
+            num_rows -= std::min<size_t>(num_rows, del_vec->cardinality());
+        }
+    }
+    if (num_rows == 0) {
+        return Status::EndOfFile("all rows deleted");
+    }
+
+    ChunkPtr values = ChunkHelper::new_chunk(schema, 2);
+    for (size_t i = 0; i < schema.num_fields(); i++) {
+        const FieldPtr& field = schema.field(i);
+        const segment_v2::ColumnReader* reader = segment->column_reader(field->id());
+        if (reader == nullptr || !is_exact_zone_map_type(field->type()->type())) {
+            return ChunkIteratorPtr();
+        }
+        Datum min;
+        Datum max;
+        Status st = reader->segment_zone_map_min_max(&min, &max);
+        if (st.is_not_found()) {
+            return ChunkIteratorPtr();
+        }
+        RETURN_IF_ERROR(st);
+        Column* column = values->get_column_by_index(i).get();
+        for (const Datum& datum : {min, max}) {
+            if (!datum.is_null()) {
+                column->append_datum(datum);
+            } else if (!column->append_nulls(1)) {
+                return ChunkIteratorPtr();
+            }
+        }
+    }
+    return std::make_shared<SegmentMetadataIterator>(schema, options.chunk_size, num_rows, std::move(values));
+}
+
+} // namespace starrocks::vectorized
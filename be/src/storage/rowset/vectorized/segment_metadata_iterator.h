@@ -0,0 +1,28 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+
+#include "common/statusor.h"
+#include "storage/vectorized/chunk_iterator.h"
+
+namespace starrocks::segment_v2 {
+class Segment;
+}
+
+namespace starrocks::vectorized {
+
+class Schema;
+class SegmentReadOptions;
+
+// new_segment_metadata_iterator creates an iterator generating the rows of |segment| from its row count and
+// segment-level zone maps instead of reading the data pages, for the metadata scan of count(*) and min/max.
+// All but the last rows hold the min values of the columns, and the last row holds the max values, so that
+// count(*), and min and max of every column give the same results as they do on the real rows.
+// Return nullptr if the rows couldn't be generated, e.g. |options| has predicates, or some rows with the min or
+// max values of |options.metadata_min_max_columns| may have been deleted.
+StatusOr<ChunkIteratorPtr> new_segment_metadata_iterator(const std::shared_ptr<segment_v2::Segment>& segment,
+                                                         const Schema& schema, const SegmentReadOptions& options);
+
+} // namespace starrocks::vectorized
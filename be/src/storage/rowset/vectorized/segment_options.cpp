@@ -12,6 +12,7 @@ Status SegmentReadOptions::convert_to(SegmentReadOptions* dst, const std::vector
     for (int i = 0; i < num_ranges; ++i) {
         ranges[i].convert_to(&dst->ranges[i], new_types);
     }
+    dst->rowid_range = rowid_range;
 
     // predicates
     for (auto& pair : predicates) {
@@ -26,6 +27,7 @@ Status SegmentReadOptions::convert_to(SegmentReadOptions* dst, const std::vector
 
     // delete predicates
     RETURN_IF_ERROR(delete_predicates.convert_to(&dst->delete_predicates, new_types, obj_pool));
+    dst->delete_bitmap = delete_bitmap;
 
     dst->stats = stats;
     dst->use_page_cache = use_page_cache;
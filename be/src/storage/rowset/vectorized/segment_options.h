@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -12,6 +13,7 @@
 
 namespace starrocks {
 class Condition;
+class DelVector;
 struct OlapReaderStatistics;
 class RuntimeProfile;
 class TabletSchema;
@@ -21,6 +23,8 @@ class OlapMeta;
 namespace starrocks::vectorized {
 
 class ColumnPredicate;
+class RuntimePredicate;
+class SparseRange;
 
 class SegmentReadOptions {
 public:
@@ -30,9 +34,25 @@ public:
 
     std::vector<SeekRange> ranges;
 
+    // If not null, the rows out of |rowid_range| are not read.
+    const SparseRange* rowid_range = nullptr;
+
     std::unordered_map<ColumnId, PredicateList> predicates;
 
     DisjunctivePredicates delete_predicates;
+    // If not null, the rows of |delete_bitmap| have been deleted by the delete predicates materialized into it,
+    // see DeleteBitmapCache, and are filtered out like the rows of the delete vector of a primary keys tablet.
+    std::shared_ptr<DelVector> delete_bitmap;
+
+    // If not null, the rows not read yet are pruned by the zone maps again once it's updated.
+    // It's not converted by `convert_to`, whose segments are not pruned by it.
+    std::shared_ptr<RuntimePredicate> runtime_predicate;
+
+    // If true, the rows are generated from the row count and the segment-level zone maps instead of the data
+    // pages when they could be, see new_segment_metadata_iterator. It's not converted by `convert_to` either.
+    bool metadata_scan = false;
+    // The columns aggregated by min or max in the metadata scan, the others are only counted.
+    std::vector<ColumnId> metadata_min_max_columns;
 
     // used for updatable tablet to get delvec
     bool is_primary_keys = false;
@@ -25,9 +25,15 @@
 #include <util/defer_op.h>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <numeric>
+#include <thread>
 #include <vector>
 
+#include "column/chunk.h"
+#include "column/datum_convert.h"
 #include "runtime/exec_env.h"
 #include "runtime/heartbeat_flags.h"
 #include "runtime/mem_pool.h"
@@ -40,8 +46,14 @@
 #include "storage/rowset/rowset_id_generator.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet.h"
+#include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/tablet_updates.h"
+#include "storage/vectorized/aggregate_iterator.h"
+#include "storage/vectorized/chunk_aggregator.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/chunk_iterator.h"
 #include "storage/vectorized/convert_helper.h"
+#include "storage/vectorized/merge_iterator.h"
 #include "storage/wrapper_field.h"
 #include "util/unaligned_access.h"
 
@@ -1047,7 +1059,8 @@ SchemaChangeDirectly::SchemaChangeDirectly(MemTracker* mem_tracker, const RowBlo
         : SchemaChange(mem_tracker),
           _row_block_changer(row_block_changer),
           _row_block_allocator(nullptr),
-          _cursor(nullptr) {}
+          _cursor(nullptr),
+          _chunk_changer(row_block_changer) {}
 
 SchemaChangeDirectly::~SchemaChangeDirectly() {
     VLOG(3) << "~SchemaChangeDirectly()";
@@ -1115,6 +1128,11 @@ bool SchemaChangeDirectly::process(RowsetReaderSharedPtr rowset_reader, RowsetWr
         return true;
     }
 
+    if (rowset_reader->rowset()->rowset_meta()->rowset_type() == BETA_ROWSET &&
+        _chunk_changer.init(base_tablet->tablet_schema(), new_tablet->tablet_schema(), _mem_tracker.get())) {
+        return _change_by_chunks(rowset_reader, rowset_writer, new_tablet, base_tablet);
+    }
+
     VLOG(3) << "init writer. new_tablet=" << new_tablet->full_name()
             << ", block_row_number=" << new_tablet->num_rows_per_row_block();
     bool result = true;
@@ -1196,12 +1214,153 @@ DIRECTLY_PROCESS_ERR:
     return result;
 }
 
+bool ChunkChanger::init(const TabletSchema& base_schema, const TabletSchema& new_schema, MemTracker* mem_tracker) {
+    if (_inited) {
+        return _can_change;
+    }
+    _inited = true;
+    if (_row_block_changer.has_delete_conditions()) {
+        return false;
+    }
+
+    SchemaMapping mapping = _row_block_changer.get_schema_mapping();
+    std::vector<ColumnId> ref_cids;
+    for (size_t i = 0; i < mapping.size(); ++i) {
+        const ColumnMapping& column_mapping = mapping[i];
+        const TabletColumn& new_column = new_schema.column(i);
+        if (!column_mapping.materialized_function.empty()) {
+            return false;
+        }
+        if (column_mapping.ref_column >= 0) {
+            const TabletColumn& ref_column = base_schema.column(column_mapping.ref_column);
+            if (ref_column.type() != new_column.type() || ref_column.is_nullable() != new_column.is_nullable()) {
+                return false;
+            }
+            ref_cids.push_back(column_mapping.ref_column);
+        } else if (column_mapping.default_value == nullptr) {
+            return false;
+        }
+    }
+    std::sort(ref_cids.begin(), ref_cids.end());
+    ref_cids.erase(std::unique(ref_cids.begin(), ref_cids.end()), ref_cids.end());
+
+    _base_read_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(base_schema, ref_cids);
+    auto new_vectorized_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(new_schema);
+    _new_schema = std::make_shared<vectorized::Schema>(std::move(new_vectorized_schema));
+    _ref_column_indexes.assign(mapping.size(), -1);
+    _default_columns.assign(mapping.size(), nullptr);
+    MemPool mem_pool(mem_tracker);
+    for (size_t i = 0; i < mapping.size(); ++i) {
+        const ColumnMapping& column_mapping = mapping[i];
+        if (column_mapping.ref_column >= 0) {
+            auto iter = std::lower_bound(ref_cids.begin(), ref_cids.end(), column_mapping.ref_column);
+            _ref_column_indexes[i] = iter - ref_cids.begin();
+            continue;
+        }
+        const vectorized::FieldPtr& field = _new_schema->field(i);
+        vectorized::Datum datum;
+        if (column_mapping.default_value->is_null()) {
+            if (!field->is_nullable()) {
+                return false;
+            }
+            datum.set_null();
+        } else if (!datum_from_string(field->type().get(), &datum, column_mapping.default_value->to_string(),
+                                      &mem_pool)
+                            .ok()) {
+            return false;
+        }
+        _default_columns[i] = vectorized::ChunkHelper::column_from_field(*field);
+        _default_columns[i]->append_datum(datum);
+    }
+    _can_change = true;
+    return true;
+}
+
+vectorized::ChunkPtr ChunkChanger::change(const vectorized::Chunk& base_chunk) const {
+    size_t num_rows = base_chunk.num_rows();
+    vectorized::Columns columns(_ref_column_indexes.size());
+    for (size_t i = 0; i < _ref_column_indexes.size(); ++i) {
+        if (_ref_column_indexes[i] >= 0) {
+            columns[i] = base_chunk.get_column_by_index(_ref_column_indexes[i]);
+        } else {
+            columns[i] = _default_columns[i]->clone_empty();
+            columns[i]->append_value_multiple_times(*_default_columns[i], 0, num_rows);
+        }
+    }
+    return std::make_shared<vectorized::Chunk>(std::move(columns), _new_schema);
+}
+
+bool SchemaChangeDirectly::_change_by_chunks(RowsetReaderSharedPtr rowset_reader, RowsetWriter* rowset_writer,
+                                             TabletSharedPtr new_tablet, TabletSharedPtr base_tablet) {
+    RowsetSharedPtr rowset = rowset_reader->rowset();
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions read_options;
+    read_options.reader_type = READER_ALTER_TABLE;
+    read_options.chunk_size = config::vector_chunk_size;
+    read_options.tablet_schema = &base_tablet->tablet_schema();
+    read_options.stats = &stats;
+    std::vector<vectorized::ChunkIteratorPtr> seg_iterators;
+    Status st = rowset->get_segment_iterators(_chunk_changer.base_read_schema(), read_options, &seg_iterators);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to get the segment iterators of rowset " << rowset->rowset_id()
+                     << ". status=" << st.to_string();
+        return false;
+    }
+
+    reset_merged_rows();
+    reset_filtered_rows();
+
+    const vectorized::Schema& new_schema = *_chunk_changer.new_schema();
+    auto char_field_indexes = vectorized::ChunkHelper::get_char_field_indexes(new_schema);
+    auto base_chunk = vectorized::ChunkHelper::new_chunk(_chunk_changer.base_read_schema(), config::vector_chunk_size);
+    for (auto& seg_iterator : seg_iterators) {
+        if (seg_iterator == nullptr) {
+            continue;
+        }
+        while (true) {
+            base_chunk->reset();
+            st = seg_iterator->get_next(base_chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            } else if (!st.ok()) {
+                LOG(WARNING) << "failed to read rowset " << rowset->rowset_id() << ". status=" << st.to_string();
+                return false;
+            }
+            auto new_chunk = _chunk_changer.change(*base_chunk);
+            vectorized::ChunkHelper::padding_char_columns(char_field_indexes, new_schema, new_tablet->tablet_schema(),
+                                                          new_chunk.get());
+            if (rowset_writer->add_chunk(*new_chunk) != OLAP_SUCCESS) {
+                LOG(WARNING) << "failed to write chunk of rowset " << rowset->rowset_id();
+                return false;
+            }
+        }
+        seg_iterator->close();
+        // The segments of an overlapping rowset are sorted one by one, and so must the written ones be.
+        if (rowset->rowset_meta()->segments_overlap() != NONOVERLAPPING && rowset_writer->flush() != OLAP_SUCCESS) {
+            return false;
+        }
+    }
+    if (rowset_writer->flush() != OLAP_SUCCESS) {
+        return false;
+    }
+
+    if (config::row_nums_check && rowset->num_rows() != rowset_writer->num_rows()) {
+        LOG(WARNING) << "fail to check row num! source_rows=" << rowset->num_rows()
+                     << ", new_index_rows=" << rowset_writer->num_rows();
+        return false;
+    }
+    LOG(INFO) << "all row nums changed by chunks. source_rows=" << rowset->num_rows()
+              << ", new_index_rows=" << rowset_writer->num_rows();
+    return true;
+}
+
 SchemaChangeWithSorting::SchemaChangeWithSorting(MemTracker* mem_tracker, const RowBlockChanger& row_block_changer,
                                                  size_t memory_limitation)
         : SchemaChange(mem_tracker),
           _row_block_changer(row_block_changer),
           _memory_limitation(memory_limitation),
-          _row_block_allocator(nullptr) {
+          _row_block_allocator(nullptr),
+          _chunk_changer(row_block_changer) {
     // Each time SchemaChange does the outer row, it writes some temporary versions (such as 999,1000,1001).
     // To avoid Cache conflicts, the temporary versions are processed in 2 ways.
     // Random value as VersionHash
@@ -1246,6 +1405,13 @@ bool SchemaChangeWithSorting::process(RowsetReaderSharedPtr rowset_reader, Rowse
         return true;
     }
 
+    if (rowset->rowset_meta()->rowset_type() == BETA_ROWSET &&
+        new_tablet->tablet_meta()->preferred_rowset_type() == BETA_ROWSET &&
+        new_tablet->keys_type() != KeysType::PRIMARY_KEYS &&
+        _chunk_changer.init(base_tablet->tablet_schema(), new_tablet->tablet_schema(), _mem_tracker.get())) {
+        return _sort_by_chunks(rowset_reader, new_rowset_writer, new_tablet, base_tablet);
+    }
+
     bool result = true;
     RowBlockSorter row_block_sorter(_row_block_allocator);
 
@@ -1425,6 +1591,27 @@ bool SchemaChangeWithSorting::_internal_sorting(const std::vector<RowBlock*>& ro
     uint64_t merged_rows = 0;
     RowBlockMerger merger(_mem_tracker.get(), new_tablet);
 
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    if (_create_rowset_writer(version, version_hash, new_tablet, new_rowset_type, segments_overlap, &rowset_writer) !=
+        OLAP_SUCCESS) {
+        return false;
+    }
+
+    if (!merger.merge(row_block_arr, rowset_writer.get(), &merged_rows)) {
+        LOG(WARNING) << "failed to merge row blocks.";
+        new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
+        return false;
+    }
+    new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
+    add_merged_rows(merged_rows);
+    *rowset = rowset_writer->build();
+    return true;
+}
+
+OLAPStatus SchemaChangeWithSorting::_create_rowset_writer(const Version& version, VersionHash version_hash,
+                                                          TabletSharedPtr new_tablet, RowsetTypePB rowset_type,
+                                                          SegmentsOverlapPB segments_overlap,
+                                                          std::unique_ptr<RowsetWriter>* rowset_writer) {
     RowsetWriterContext context(kDataFormatUnknown, config::storage_format_version);
     context.mem_tracker = _mem_tracker.get();
     context.rowset_id = StorageEngine::instance()->next_rowset_id();
@@ -1432,7 +1619,7 @@ bool SchemaChangeWithSorting::_internal_sorting(const std::vector<RowBlock*>& ro
     context.tablet_id = new_tablet->tablet_id();
     context.partition_id = new_tablet->partition_id();
     context.tablet_schema_hash = new_tablet->schema_hash();
-    context.rowset_type = new_rowset_type;
+    context.rowset_type = rowset_type;
     context.rowset_path_prefix = new_tablet->tablet_path();
     context.tablet_schema = &(new_tablet->tablet_schema());
     context.rowset_state = VISIBLE;
@@ -1441,21 +1628,7 @@ bool SchemaChangeWithSorting::_internal_sorting(const std::vector<RowBlock*>& ro
     context.segments_overlap = segments_overlap;
     VLOG(3) << "init rowset builder. tablet=" << new_tablet->full_name()
             << ", block_row_size=" << new_tablet->num_rows_per_row_block();
-
-    std::unique_ptr<RowsetWriter> rowset_writer;
-    if (RowsetFactory::create_rowset_writer(context, &rowset_writer) != OLAP_SUCCESS) {
-        return false;
-    }
-
-    if (!merger.merge(row_block_arr, rowset_writer.get(), &merged_rows)) {
-        LOG(WARNING) << "failed to merge row blocks.";
-        new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
-        return false;
-    }
-    new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
-    add_merged_rows(merged_rows);
-    *rowset = rowset_writer->build();
-    return true;
+    return RowsetFactory::create_rowset_writer(context, rowset_writer);
 }
 
 bool SchemaChangeWithSorting::_external_sorting(vector<RowsetSharedPtr>& src_rowsets, RowsetWriter* rowset_writer,
@@ -1484,6 +1657,173 @@ bool SchemaChangeWithSorting::_external_sorting(vector<RowsetSharedPtr>& src_row
     return true;
 }
 
+vectorized::ChunkPtr SchemaChangeWithSorting::_sort_run(const vectorized::ChunkPtr& run,
+                                                        const TabletSchema& new_schema) {
+    const size_t num_key_columns = new_schema.num_key_columns();
+    std::vector<uint32_t> permutation(run->num_rows());
+    std::iota(permutation.begin(), permutation.end(), 0);
+    auto less = [&](uint32_t lhs, uint32_t rhs) {
+        for (size_t i = 0; i < num_key_columns; ++i) {
+            const vectorized::Column* column = run->get_column_by_index(i).get();
+            int r = column->compare_at(lhs, rhs, *column, -1);
+            if (r != 0) {
+                return r < 0;
+            }
+        }
+        return false;
+    };
+    // Stable, so that the later rows of the same keys still replace the earlier ones.
+    std::stable_sort(permutation.begin(), permutation.end(), less);
+    vectorized::ChunkPtr sorted = run->clone_empty_with_schema(permutation.size());
+    sorted->append_selective(*run, permutation.data(), 0, permutation.size());
+    if (new_schema.keys_type() == KeysType::DUP_KEYS) {
+        return sorted;
+    }
+    vectorized::ChunkAggregator aggregator(_chunk_changer.new_schema().get(), 0, INT_MAX, 0);
+    aggregator.update_source(sorted);
+    aggregator.aggregate();
+    DCHECK(aggregator.source_exhausted());
+    add_merged_rows(aggregator.merged_rows());
+    return aggregator.aggregate_result();
+}
+
+bool SchemaChangeWithSorting::_sort_by_chunks(RowsetReaderSharedPtr rowset_reader, RowsetWriter* rowset_writer,
+                                              TabletSharedPtr new_tablet, TabletSharedPtr base_tablet) {
+    RowsetSharedPtr rowset = rowset_reader->rowset();
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions read_options;
+    read_options.reader_type = READER_ALTER_TABLE;
+    read_options.chunk_size = config::vector_chunk_size;
+    read_options.tablet_schema = &base_tablet->tablet_schema();
+    read_options.stats = &stats;
+    std::vector<vectorized::ChunkIteratorPtr> seg_iterators;
+    Status st = rowset->get_segment_iterators(_chunk_changer.base_read_schema(), read_options, &seg_iterators);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to get the segment iterators of rowset " << rowset->rowset_id()
+                     << ". status=" << st.to_string();
+        return false;
+    }
+
+    reset_merged_rows();
+    reset_filtered_rows();
+
+    const TabletSchema& new_tablet_schema = new_tablet->tablet_schema();
+    const vectorized::Schema& new_schema = *_chunk_changer.new_schema();
+    auto char_field_indexes = vectorized::ChunkHelper::get_char_field_indexes(new_schema);
+    auto base_chunk = vectorized::ChunkHelper::new_chunk(_chunk_changer.base_read_schema(), config::vector_chunk_size);
+    vectorized::ChunkPtr run;
+    // The runs of a rowset larger than a run, a segment each.
+    std::unique_ptr<RowsetWriter> runs_writer;
+    _temp_delta_versions.first = _temp_delta_versions.second;
+    auto flush_run = [&]() {
+        auto sorted = _sort_run(run, new_tablet_schema);
+        run.reset();
+        vectorized::ChunkHelper::padding_char_columns(char_field_indexes, new_schema, new_tablet_schema, sorted.get());
+        if (runs_writer == nullptr &&
+            _create_rowset_writer(Version(_temp_delta_versions.second, _temp_delta_versions.second),
+                                  rowset_reader->version_hash(), new_tablet, BETA_ROWSET, OVERLAPPING,
+                                  &runs_writer) != OLAP_SUCCESS) {
+            return false;
+        }
+        return runs_writer->flush_chunk(*sorted) == OLAP_SUCCESS;
+    };
+    for (auto& seg_iterator : seg_iterators) {
+        if (seg_iterator == nullptr) {
+            continue;
+        }
+        while (true) {
+            base_chunk->reset();
+            st = seg_iterator->get_next(base_chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            } else if (!st.ok()) {
+                LOG(WARNING) << "failed to read rowset " << rowset->rowset_id() << ". status=" << st.to_string();
+                return false;
+            }
+            auto new_chunk = _chunk_changer.change(*base_chunk);
+            if (run == nullptr) {
+                run = new_chunk->clone_empty_with_schema();
+            }
+            run->append(*new_chunk);
+            if (run->memory_usage() >= _memory_limitation && !flush_run()) {
+                LOG(WARNING) << "failed to write a sorted run of rowset " << rowset->rowset_id();
+                return false;
+            }
+        }
+        seg_iterator->close();
+    }
+
+    if (run != nullptr && runs_writer == nullptr) {
+        // The whole rowset is a single run.
+        auto sorted = _sort_run(run, new_tablet_schema);
+        vectorized::ChunkHelper::padding_char_columns(char_field_indexes, new_schema, new_tablet_schema, sorted.get());
+        if (rowset_writer->flush_chunk(*sorted) != OLAP_SUCCESS) {
+            LOG(WARNING) << "failed to write the sorted rowset " << rowset->rowset_id();
+            return false;
+        }
+    } else if (run != nullptr && !flush_run()) {
+        LOG(WARNING) << "failed to write a sorted run of rowset " << rowset->rowset_id();
+        return false;
+    }
+
+    if (runs_writer != nullptr) {
+        ++_temp_delta_versions.second;
+        RowsetSharedPtr runs = runs_writer->build();
+        new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + runs_writer->rowset_id().to_string());
+        if (runs == nullptr) {
+            return false;
+        }
+        DeferOp remove_runs([&] { StorageEngine::instance()->add_unused_rowset(runs); });
+        read_options.tablet_schema = &new_tablet_schema;
+        std::vector<vectorized::ChunkIteratorPtr> run_iterators;
+        st = runs->get_segment_iterators(new_schema, read_options, &run_iterators);
+        if (!st.ok()) {
+            LOG(WARNING) << "failed to read the sorted runs of rowset " << rowset->rowset_id()
+                         << ". status=" << st.to_string();
+            return false;
+        }
+        run_iterators.erase(std::remove(run_iterators.begin(), run_iterators.end(), nullptr), run_iterators.end());
+        auto iter = vectorized::new_merge_iterator(run_iterators);
+        if (new_tablet_schema.keys_type() != KeysType::DUP_KEYS) {
+            iter = vectorized::new_aggregate_iterator(std::move(iter), 0);
+        }
+        auto chunk = vectorized::ChunkHelper::new_chunk(new_schema, config::vector_chunk_size);
+        size_t num_rows_merged = 0;
+        while (true) {
+            chunk->reset();
+            st = iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            } else if (!st.ok()) {
+                LOG(WARNING) << "failed to merge the sorted runs of rowset " << rowset->rowset_id()
+                             << ". status=" << st.to_string();
+                return false;
+            }
+            num_rows_merged += chunk->num_rows();
+            vectorized::ChunkHelper::padding_char_columns(char_field_indexes, new_schema, new_tablet_schema,
+                                                          chunk.get());
+            if (rowset_writer->add_chunk(*chunk) != OLAP_SUCCESS) {
+                LOG(WARNING) << "failed to write the merged runs of rowset " << rowset->rowset_id();
+                return false;
+            }
+        }
+        iter->close();
+        add_merged_rows(runs->num_rows() - num_rows_merged);
+    }
+    if (rowset_writer->flush() != OLAP_SUCCESS) {
+        return false;
+    }
+
+    if (config::row_nums_check && rowset->num_rows() != rowset_writer->num_rows() + merged_rows()) {
+        LOG(WARNING) << "fail to check row num! source_rows=" << rowset->num_rows() << ", merged_rows=" << merged_rows()
+                     << ", new_index_rows=" << rowset_writer->num_rows();
+        return false;
+    }
+    LOG(INFO) << "all row nums sorted by chunks. source_rows=" << rowset->num_rows()
+              << ", merged_rows=" << merged_rows() << ", new_index_rows=" << rowset_writer->num_rows();
+    return true;
+}
+
 OLAPStatus SchemaChangeHandler::process_alter_tablet_v2(const TAlterTabletReqV2& request) {
     LOG(INFO) << "begin to do request alter tablet: base_tablet_id=" << request.base_tablet_id
               << ", base_schema_hash=" << request.base_schema_hash << ", new_tablet_id=" << request.new_tablet_id
@@ -1783,7 +2123,7 @@ OLAPStatus SchemaChangeHandler::_convert_historical_rowsets(const SchemaChangePa
 
     bool sc_sorting = false;
     bool sc_directly = false;
-    SchemaChange* sc_procedure = nullptr;
+    std::function<std::unique_ptr<SchemaChange>()> new_procedure;
     MemTracker* mem_tracker = ExecEnv::GetInstance()->schema_change_mem_tracker();
 
     // a. parse Alter request
@@ -1796,102 +2136,64 @@ OLAPStatus SchemaChangeHandler::_convert_historical_rowsets(const SchemaChangePa
 
     // b. create converter for history data
     if (sc_sorting) {
-        size_t memory_limitation = config::memory_limitation_per_thread_for_schema_change;
         LOG(INFO) << "doing schema change with sorting for base_tablet " << sc_params.base_tablet->full_name();
-        sc_procedure =
-                new (nothrow) SchemaChangeWithSorting(mem_tracker, rb_changer, memory_limitation * 1024 * 1024 * 1024);
     } else if (sc_directly) {
         LOG(INFO) << "doing schema change directly for base_tablet " << sc_params.base_tablet->full_name();
-        sc_procedure = new (nothrow) SchemaChangeDirectly(mem_tracker, rb_changer);
     } else {
         LOG(INFO) << "doing linked schema change for base_tablet " << sc_params.base_tablet->full_name();
-        sc_procedure = new (nothrow) LinkedSchemaChange(mem_tracker, rb_changer);
     }
+    new_procedure = [&]() -> std::unique_ptr<SchemaChange> {
+        if (sc_sorting) {
+            size_t memory_limitation = config::memory_limitation_per_thread_for_schema_change;
+            return std::make_unique<SchemaChangeWithSorting>(mem_tracker, rb_changer,
+                                                             memory_limitation * 1024 * 1024 * 1024);
+        } else if (sc_directly) {
+            return std::make_unique<SchemaChangeDirectly>(mem_tracker, rb_changer);
+        } else {
+            return std::make_unique<LinkedSchemaChange>(mem_tracker, rb_changer);
+        }
+    };
 
-    if (sc_procedure == nullptr) {
-        LOG(WARNING) << "failed to malloc SchemaChange. "
-                     << "malloc_size=" << sizeof(SchemaChangeWithSorting);
-        res = OLAP_ERR_MALLOC_ERROR;
-        goto PROCESS_ALTER_EXIT;
-    }
+    // c. convert history data, by up to config::schema_change_convert_threads threads, each of which has its own
+    // procedure and takes the next rowset not converted yet, till all the rowsets are converted or one fails.
+    {
+        const auto& rs_readers = sc_params.ref_rowset_readers;
+        std::atomic<size_t> next_rowset{0};
+        std::atomic<bool> failed{false};
+        auto convert = [&]() -> OLAPStatus {
+            std::unique_ptr<SchemaChange> sc_procedure = new_procedure();
+            while (!failed.load()) {
+                size_t i = next_rowset.fetch_add(1);
+                if (i >= rs_readers.size()) {
+                    break;
+                }
+                OLAPStatus st = _convert_rowset(sc_params, sc_procedure.get(), rs_readers[i]);
+                if (st != OLAP_SUCCESS) {
+                    failed.store(true);
+                    return st;
+                }
+            }
+            return OLAP_SUCCESS;
+        };
 
-    // c. convert history data
-    for (auto& rs_reader : sc_params.ref_rowset_readers) {
-        VLOG(10) << "begin to convert a history rowset. version=" << rs_reader->version().first << "-"
-                 << rs_reader->version().second;
-
-        // set status for monitor
-        // If only one new_table is running, ref table will be set to running
-        // NOTE if the first sub_table is fail, it will continue as normal
-        TabletSharedPtr new_tablet = sc_params.new_tablet;
-
-        RowsetWriterContext writer_context(kDataFormatUnknown, config::storage_format_version);
-        writer_context.mem_tracker = ExecEnv::GetInstance()->schema_change_mem_tracker();
-        writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
-        writer_context.tablet_uid = new_tablet->tablet_uid();
-        writer_context.tablet_id = new_tablet->tablet_id();
-        writer_context.partition_id = new_tablet->partition_id();
-        writer_context.tablet_schema_hash = new_tablet->schema_hash();
-        // linked schema change can't change rowset type, therefore we preserve rowset type in schema change now
-        writer_context.rowset_type = rs_reader->rowset()->rowset_meta()->rowset_type();
-        if (sc_params.new_tablet->tablet_meta()->preferred_rowset_type() == BETA_ROWSET) {
-            // Use beta rowset to do schema change
-            // And in this case, linked schema change will not be used.
-            writer_context.rowset_type = BETA_ROWSET;
-        }
-        writer_context.rowset_path_prefix = new_tablet->tablet_path();
-        writer_context.tablet_schema = &(new_tablet->tablet_schema());
-        writer_context.rowset_state = VISIBLE;
-        writer_context.version = rs_reader->version();
-        writer_context.version_hash = rs_reader->version_hash();
-        writer_context.segments_overlap = rs_reader->rowset()->rowset_meta()->segments_overlap();
-
-        std::unique_ptr<RowsetWriter> rowset_writer;
-        OLAPStatus status = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
-        if (status != OLAP_SUCCESS) {
-            res = OLAP_ERR_ROWSET_BUILDER_INIT;
-            goto PROCESS_ALTER_EXIT;
-        }
-
-        if (!sc_procedure->process(rs_reader, rowset_writer.get(), sc_params.new_tablet, sc_params.base_tablet)) {
-            LOG(WARNING) << "failed to process the version."
-                         << " version=" << rs_reader->version().first << "-" << rs_reader->version().second;
-            res = OLAP_ERR_INPUT_PARAMETER_ERROR;
-            new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
-            goto PROCESS_ALTER_EXIT;
+        size_t num_threads = std::min<size_t>(std::max(1, config::schema_change_convert_threads), rs_readers.size());
+        std::vector<OLAPStatus> results(num_threads, OLAP_SUCCESS);
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < num_threads; ++i) {
+            threads.emplace_back([&results, &convert, i] { results[i] = convert(); });
         }
-        new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
-        // Add the new version of the data to the header,
-        // To prevent deadlocks, be sure to lock the old table first and then the new one
-        sc_params.new_tablet->obtain_push_lock();
-        RowsetSharedPtr new_rowset = rowset_writer->build();
-        if (new_rowset == nullptr) {
-            LOG(WARNING) << "failed to build rowset, exit alter process";
-            sc_params.new_tablet->release_push_lock();
-            goto PROCESS_ALTER_EXIT;
-        }
-        res = sc_params.new_tablet->add_rowset(new_rowset, false);
-        if (res == OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
-            LOG(WARNING) << "version already exist, version revert occured. "
-                         << "tablet=" << sc_params.new_tablet->full_name() << ", version='"
-                         << rs_reader->version().first << "-" << rs_reader->version().second;
-            StorageEngine::instance()->add_unused_rowset(new_rowset);
-            res = OLAP_SUCCESS;
-        } else if (res != OLAP_SUCCESS) {
-            LOG(WARNING) << "failed to register new version. "
-                         << " tablet=" << sc_params.new_tablet->full_name()
-                         << ", version=" << rs_reader->version().first << "-" << rs_reader->version().second;
-            StorageEngine::instance()->add_unused_rowset(new_rowset);
-            sc_params.new_tablet->release_push_lock();
-            goto PROCESS_ALTER_EXIT;
-        } else {
-            VLOG(3) << "register new version. tablet=" << sc_params.new_tablet->full_name()
-                    << ", version=" << rs_reader->version().first << "-" << rs_reader->version().second;
+        if (num_threads > 0) {
+            results[0] = convert();
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (OLAPStatus st : results) {
+            if (st != OLAP_SUCCESS) {
+                res = st;
+                break;
+            }
         }
-        sc_params.new_tablet->release_push_lock();
-
-        VLOG(10) << "succeed to convert a history version."
-                 << " version=" << rs_reader->version().first << "-" << rs_reader->version().second;
     }
     // XXX: The SchemaChange state should not be cancelled at this point,
     // because the new Delta has to be converted to the old and new Schema versions
@@ -1904,7 +2206,6 @@ PROCESS_ALTER_EXIT : {
         Version test_version(0, end_version);
         res = sc_params.new_tablet->check_version_integrity(test_version);
     }
-    SAFE_DELETE(sc_procedure);
 
     LOG(INFO) << "finish converting rowsets for new_tablet from base_tablet. "
               << "base_tablet=" << sc_params.base_tablet->full_name()
@@ -1912,6 +2213,78 @@ PROCESS_ALTER_EXIT : {
     return res;
 }
 
+OLAPStatus SchemaChangeHandler::_convert_rowset(const SchemaChangeParams& sc_params, SchemaChange* sc_procedure,
+                                                const RowsetReaderSharedPtr& rs_reader) {
+    VLOG(10) << "begin to convert a history rowset. version=" << rs_reader->version().first << "-"
+             << rs_reader->version().second;
+
+    TabletSharedPtr new_tablet = sc_params.new_tablet;
+
+    RowsetWriterContext writer_context(kDataFormatUnknown, config::storage_format_version);
+    writer_context.mem_tracker = ExecEnv::GetInstance()->schema_change_mem_tracker();
+    writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+    writer_context.tablet_uid = new_tablet->tablet_uid();
+    writer_context.tablet_id = new_tablet->tablet_id();
+    writer_context.partition_id = new_tablet->partition_id();
+    writer_context.tablet_schema_hash = new_tablet->schema_hash();
+    // linked schema change can't change rowset type, therefore we preserve rowset type in schema change now
+    writer_context.rowset_type = rs_reader->rowset()->rowset_meta()->rowset_type();
+    if (new_tablet->tablet_meta()->preferred_rowset_type() == BETA_ROWSET) {
+        // Use beta rowset to do schema change
+        // And in this case, linked schema change will not be used.
+        writer_context.rowset_type = BETA_ROWSET;
+    }
+    writer_context.rowset_path_prefix = new_tablet->tablet_path();
+    writer_context.tablet_schema = &(new_tablet->tablet_schema());
+    writer_context.rowset_state = VISIBLE;
+    writer_context.version = rs_reader->version();
+    writer_context.version_hash = rs_reader->version_hash();
+    writer_context.segments_overlap = rs_reader->rowset()->rowset_meta()->segments_overlap();
+
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    OLAPStatus status = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+    if (status != OLAP_SUCCESS) {
+        return OLAP_ERR_ROWSET_BUILDER_INIT;
+    }
+
+    if (!sc_procedure->process(rs_reader, rowset_writer.get(), new_tablet, sc_params.base_tablet)) {
+        LOG(WARNING) << "failed to process the version."
+                     << " version=" << rs_reader->version().first << "-" << rs_reader->version().second;
+        new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
+        return OLAP_ERR_INPUT_PARAMETER_ERROR;
+    }
+    new_tablet->data_dir()->remove_pending_ids(ROWSET_ID_PREFIX + rowset_writer->rowset_id().to_string());
+    // Add the new version of the data to the header,
+    // To prevent deadlocks, be sure to lock the old table first and then the new one
+    std::lock_guard push_lock(new_tablet->get_push_lock());
+    RowsetSharedPtr new_rowset = rowset_writer->build();
+    if (new_rowset == nullptr) {
+        LOG(WARNING) << "failed to build rowset, exit alter process";
+        return OLAP_ERR_ROWSET_BUILDER_INIT;
+    }
+    OLAPStatus res = new_tablet->add_rowset(new_rowset, false);
+    if (res == OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
+        LOG(WARNING) << "version already exist, version revert occured. "
+                     << "tablet=" << new_tablet->full_name() << ", version='" << rs_reader->version().first << "-"
+                     << rs_reader->version().second;
+        StorageEngine::instance()->add_unused_rowset(new_rowset);
+        res = OLAP_SUCCESS;
+    } else if (res != OLAP_SUCCESS) {
+        LOG(WARNING) << "failed to register new version. "
+                     << " tablet=" << new_tablet->full_name() << ", version=" << rs_reader->version().first << "-"
+                     << rs_reader->version().second;
+        StorageEngine::instance()->add_unused_rowset(new_rowset);
+        return res;
+    } else {
+        VLOG(3) << "register new version. tablet=" << new_tablet->full_name()
+                << ", version=" << rs_reader->version().first << "-" << rs_reader->version().second;
+    }
+
+    VLOG(10) << "succeed to convert a history version."
+             << " version=" << rs_reader->version().first << "-" << rs_reader->version().second;
+    return res;
+}
+
 // @static
 OLAPStatus SchemaChangeHandler::_parse_request(
         TabletSharedPtr base_tablet, TabletSharedPtr new_tablet, RowBlockChanger* rb_changer, bool* sc_sorting,
@@ -26,6 +26,8 @@
 #include <queue>
 #include <vector>
 
+#include "column/schema.h"
+#include "column/vectorized_fwd.h"
 #include "gen_cpp/AgentService_types.h"
 #include "storage/column_mapping.h"
 #include "storage/delete_handler.h"
@@ -63,6 +65,8 @@ public:
 
     SchemaMapping get_schema_mapping() const { return _schema_mapping; }
 
+    bool has_delete_conditions() const { return !_delete_handler.empty(); }
+
     bool change_row_block(const RowBlock* ref_block, int32_t data_version, RowBlock* mutable_block,
                           uint64_t* filtered_rows) const;
 
@@ -91,6 +95,37 @@ private:
     size_t _memory_limitation;
 };
 
+// ChunkChanger changes the chunks of the referenced columns of the base schema into the chunks of the new schema,
+// the vectorized counterpart of RowBlockChanger for the simple mappings.
+class ChunkChanger {
+public:
+    explicit ChunkChanger(const RowBlockChanger& row_block_changer) : _row_block_changer(row_block_changer) {}
+
+    // Whether the rows can be changed chunk by chunk rather than row by row: there is no delete condition, and
+    // every column of the new schema is either a column of the base schema of the same type and nullability, or a
+    // new column of a default value.
+    bool init(const TabletSchema& base_schema, const TabletSchema& new_schema, MemTracker* mem_tracker);
+
+    // The referenced columns of the base schema, in the order of their ids.
+    const vectorized::Schema& base_read_schema() const { return _base_read_schema; }
+
+    const vectorized::SchemaPtr& new_schema() const { return _new_schema; }
+
+    // The chunk of the new schema made of |base_chunk| of base_read_schema(), without copying the referenced columns.
+    vectorized::ChunkPtr change(const vectorized::Chunk& base_chunk) const;
+
+private:
+    const RowBlockChanger& _row_block_changer;
+    bool _inited = false;
+    bool _can_change = false;
+    vectorized::Schema _base_read_schema;
+    vectorized::SchemaPtr _new_schema;
+    // For every column of the new schema, its index in |_base_read_schema|, or -1 for a new column, whose value is
+    // the only row of |_default_columns|.
+    std::vector<int> _ref_column_indexes;
+    vectorized::Columns _default_columns;
+};
+
 class SchemaChange {
 public:
     SchemaChange(MemTracker* mem_tracker) : _filtered_rows(0), _merged_rows(0) {
@@ -153,6 +188,13 @@ private:
 
     bool _write_row_block(RowsetWriter* rowset_builder, RowBlock* row_block);
 
+    // Read the segments of the beta rowset of |rowset_reader| in chunks of the columns referenced by the new schema,
+    // and write the chunks of the new schema made of them, without copying the referenced columns.
+    bool _change_by_chunks(RowsetReaderSharedPtr rowset_reader, RowsetWriter* rowset_writer,
+                           TabletSharedPtr new_tablet, TabletSharedPtr base_tablet);
+
+    ChunkChanger _chunk_changer;
+
     DISALLOW_COPY_AND_ASSIGN(SchemaChangeDirectly);
 };
 
@@ -174,7 +216,22 @@ private:
     bool _external_sorting(std::vector<RowsetSharedPtr>& src_rowsets, RowsetWriter* rowset_writer,
                            TabletSharedPtr new_tablet);
 
+    OLAPStatus _create_rowset_writer(const Version& version, VersionHash version_hash, TabletSharedPtr new_tablet,
+                                     RowsetTypePB rowset_type, SegmentsOverlapPB segments_overlap,
+                                     std::unique_ptr<RowsetWriter>* rowset_writer);
+
+    // Like _change_by_chunks of SchemaChangeDirectly, but the chunks of the new schema are gathered into runs of up
+    // to the memory limitation, each sorted by the new keys and aggregated with ChunkAggregator unless of duplicate
+    // keys. A single run is written as is, the runs of a larger rowset are written to a temporary rowset a segment
+    // each, and merged by the new keys, and aggregated, into the new rowset.
+    bool _sort_by_chunks(RowsetReaderSharedPtr rowset_reader, RowsetWriter* rowset_writer, TabletSharedPtr new_tablet,
+                         TabletSharedPtr base_tablet);
+
+    // Sort |run| by the key columns of the new schema and aggregate it.
+    vectorized::ChunkPtr _sort_run(const vectorized::ChunkPtr& run, const TabletSchema& new_schema);
+
     const RowBlockChanger& _row_block_changer;
+    ChunkChanger _chunk_changer;
     size_t _memory_limitation;
     Version _temp_delta_versions;
     RowBlockAllocator* _row_block_allocator;
@@ -217,6 +274,10 @@ private:
 
     static OLAPStatus _convert_historical_rowsets(const SchemaChangeParams& sc_params);
 
+    // Convert the rowset of |rs_reader| by |sc_procedure| into a rowset of the new tablet, and add it to the tablet.
+    static OLAPStatus _convert_rowset(const SchemaChangeParams& sc_params, SchemaChange* sc_procedure,
+                                      const RowsetReaderSharedPtr& rs_reader);
+
     static OLAPStatus _parse_request(
             TabletSharedPtr base_tablet, TabletSharedPtr new_tablet, RowBlockChanger* rb_changer, bool* sc_sorting,
             bool* sc_directly,
@@ -21,13 +21,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <string>
 #include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/segment_v2.pb.h"
+#include "gutil/endian.h"
 #include "util/debug_util.h"
 #include "util/faststring.h"
 #include "util/slice.h"
@@ -256,18 +259,51 @@ public:
     }
 
     int64_t mem_usage() const {
-        return sizeof(ShortKeyIndexDecoder) + sizeof(uint32_t) * _offsets.size() + _key_data.size +
-               _footer.ByteSizeLong() - sizeof(_footer);
+        return sizeof(ShortKeyIndexDecoder) + sizeof(uint32_t) * _offsets.size() + sizeof(uint64_t) * _prefixes.size() +
+               _key_data.size + _footer.ByteSizeLong() - sizeof(_footer);
+    }
+
+    // The first 8 bytes of |key|, padded with zeros, as a big-endian integer, so that the keys whose prefixes are
+    // less are less.
+    static uint64_t key_prefix(const Slice& key) {
+        uint64_t prefix = 0;
+        memcpy(&prefix, key.data, std::min<size_t>(sizeof(prefix), key.size));
+        return BigEndian::ToHost64(prefix);
     }
 
 private:
+    // Return the index of the first prefix of |_prefixes| not less than (lower_bound) or greater than |prefix|,
+    // by a binary search without branches, prefetching both the candidates of the next step.
+    template <bool lower_bound>
+    uint32_t seek_prefix(uint64_t prefix) const {
+        const uint64_t* base = _prefixes.data();
+        size_t len = _prefixes.size();
+        if (len == 0) {
+            return 0;
+        }
+        while (len > 1) {
+            size_t half = len / 2;
+            __builtin_prefetch(base + half / 2);
+            __builtin_prefetch(base + half + half / 2);
+            base = (lower_bound ? base[half] < prefix : base[half] <= prefix) ? base + half : base;
+            len -= half;
+        }
+        base += lower_bound ? *base < prefix : *base <= prefix;
+        return base - _prefixes.data();
+    }
+
+    // The keys with a less or greater prefix are less or greater than |key|, only the ones with the same prefix
+    // are compared byte by byte.
     template <bool lower_bound>
     ShortKeyIndexIterator seek(const Slice& key) const {
         auto comparator = [](const Slice& lhs, const Slice& rhs) { return lhs.compare(rhs) < 0; };
+        uint64_t prefix = key_prefix(key);
+        ShortKeyIndexIterator first(this, seek_prefix<true>(prefix));
+        ShortKeyIndexIterator last(this, seek_prefix<false>(prefix));
         if (lower_bound) {
-            return std::lower_bound(begin(), end(), key, comparator);
+            return std::lower_bound(first, last, key, comparator);
         } else {
-            return std::upper_bound(begin(), end(), key, comparator);
+            return std::upper_bound(first, last, key, comparator);
         }
     }
 
@@ -276,6 +312,8 @@ private:
     // All following fields are only valid after parse has been executed successfully
     segment_v2::ShortKeyFooterPB _footer;
     std::vector<uint32_t> _offsets;
+    // The key_prefix of each key.
+    std::vector<uint64_t> _prefixes;
     Slice _key_data;
 };
 
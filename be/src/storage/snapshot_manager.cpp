@@ -24,10 +24,13 @@
 #include <stdio.h>
 
 #include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <map>
 #include <set>
+#include <thread>
 
+#include "common/config.h"
 #include "env/env.h"
 #include "env/output_stream_wrapper.h"
 #include "gen_cpp/Types_constants.h"
@@ -51,6 +54,35 @@ using std::list;
 
 namespace starrocks {
 
+// Links the files of |rowsets| to |dir| by up to snapshot_link_threads threads, as the links take a round trip to
+// the file system each, which adds up for the tablets of many rowsets.
+static Status link_rowset_files(const std::vector<RowsetSharedPtr>& rowsets, const std::string& dir) {
+    std::atomic<size_t> next{0};
+    std::mutex mutex;
+    Status status;
+    auto run = [&]() {
+        for (size_t i = next++; i < rowsets.size(); i = next++) {
+            auto st = rowsets[i]->link_files_to(dir, rowsets[i]->rowset_id());
+            if (!st.ok()) {
+                std::lock_guard l(mutex);
+                status = st;
+                next = rowsets.size();
+                return;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    const size_t num_threads = std::min<size_t>(std::max(config::snapshot_link_threads, 1), rowsets.size());
+    for (size_t t = 1; t < num_threads; t++) {
+        threads.emplace_back(run);
+    }
+    run();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return status;
+}
+
 SnapshotManager* SnapshotManager::_s_instance = nullptr;
 std::mutex SnapshotManager::_mlock;
 
@@ -335,14 +367,13 @@ StatusOr<std::string> SnapshotManager::snapshot_incremental(const TabletSharedPt
     RETURN_IF_ERROR(FileUtils::create_dir(snapshot_dir));
 
     // 3. Link files to snapshot directory.
+    if (auto st = link_rowset_files(snapshot_rowsets, snapshot_dir); !st.ok()) {
+        LOG(WARNING) << "Fail to link rowset file:" << st;
+        (void)FileUtils::remove_all(snapshot_id_path);
+        return st;
+    }
     snapshot_rowset_metas.reserve(snapshot_rowsets.size());
     for (const auto& rowset : snapshot_rowsets) {
-        auto st = rowset->link_files_to(snapshot_dir, rowset->rowset_id());
-        if (!st.ok()) {
-            LOG(WARNING) << "Fail to link rowset file:" << st;
-            (void)FileUtils::remove_all(snapshot_id_path);
-            return st;
-        }
         snapshot_rowset_metas.emplace_back(rowset->rowset_meta());
     }
 
@@ -401,14 +432,13 @@ StatusOr<std::string> SnapshotManager::snapshot_full(const TabletSharedPtr& tabl
     RETURN_IF_ERROR(FileUtils::create_dir(snapshot_dir));
 
     // 3. Link files to snapshot directory.
+    if (auto st = link_rowset_files(snapshot_rowsets, snapshot_dir); !st.ok()) {
+        LOG(WARNING) << "Fail to link rowset file:" << st;
+        (void)FileUtils::remove_all(snapshot_id_path);
+        return st;
+    }
     snapshot_rowset_metas.reserve(snapshot_rowsets.size());
     for (const auto& rowset : snapshot_rowsets) {
-        auto st = rowset->link_files_to(snapshot_dir, rowset->rowset_id());
-        if (!st.ok()) {
-            LOG(WARNING) << "Fail to link rowset file:" << st;
-            (void)FileUtils::remove_all(snapshot_id_path);
-            return st;
-        }
         snapshot_rowset_metas.emplace_back(rowset->rowset_meta());
     }
 
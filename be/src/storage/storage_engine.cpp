@@ -39,6 +39,7 @@
 #include "common/status.h"
 #include "env/env.h"
 #include "runtime/exec_env.h"
+#include "storage/compaction_scheduler.h"
 #include "storage/data_dir.h"
 #include "storage/fs/file_block_manager.h"
 #include "storage/lru_cache.h"
@@ -114,6 +115,7 @@ StorageEngine::StorageEngine(const EngineOptions& options)
           _memtable_flush_executor(nullptr),
           _block_manager(nullptr),
           _update_manager(new UpdateManager(options.update_mem_tracker)),
+          _compaction_scheduler(new CompactionScheduler()),
           _heartbeat_flags(nullptr) {
     if (_s_instance == nullptr) {
         _s_instance = this;
@@ -511,8 +513,10 @@ Status StorageEngine::_perform_cumulative_compaction(DataDir* data_dir) {
     });
     ADOPT_TRACE(trace.get());
     TRACE("start to perform cumulative compaction");
-    TabletSharedPtr best_tablet =
-            _tablet_manager->find_best_tablet_to_compaction(CompactionType::CUMULATIVE_COMPACTION, data_dir);
+    // Only the tablets about to reject loads are compacted once the disk has used up its IO budget.
+    bool urgent_only = !_compaction_scheduler->has_io_budget(data_dir);
+    TabletSharedPtr best_tablet = _tablet_manager->find_best_tablet_to_compaction(
+            CompactionType::CUMULATIVE_COMPACTION, data_dir, urgent_only);
     if (best_tablet == nullptr) {
         return Status::NotFound("there are no suitable tablets");
     }
@@ -522,6 +526,7 @@ Status StorageEngine::_perform_cumulative_compaction(DataDir* data_dir) {
     vectorized::CumulativeCompaction cumulative_compaction(_options.compaction_mem_tracker, best_tablet);
 
     Status res = cumulative_compaction.compact();
+    _compaction_scheduler->consume_io_budget(data_dir, cumulative_compaction.input_rowsets_size());
     if (!res.ok()) {
         best_tablet->set_last_cumu_compaction_failure_time(UnixMillis());
         if (!res.is_not_found()) {
@@ -547,8 +552,10 @@ Status StorageEngine::_perform_base_compaction(DataDir* data_dir) {
     });
     ADOPT_TRACE(trace.get());
     TRACE("start to perform base compaction");
+    // Only the tablets about to reject loads are compacted once the disk has used up its IO budget.
+    bool urgent_only = !_compaction_scheduler->has_io_budget(data_dir);
     TabletSharedPtr best_tablet =
-            _tablet_manager->find_best_tablet_to_compaction(CompactionType::BASE_COMPACTION, data_dir);
+            _tablet_manager->find_best_tablet_to_compaction(CompactionType::BASE_COMPACTION, data_dir, urgent_only);
     if (best_tablet == nullptr) {
         return Status::NotFound("there are no suitable tablets");
     }
@@ -557,6 +564,7 @@ Status StorageEngine::_perform_base_compaction(DataDir* data_dir) {
     StarRocksMetrics::instance()->base_compaction_request_total.increment(1);
     vectorized::BaseCompaction base_compaction(_options.compaction_mem_tracker, best_tablet);
     Status res = base_compaction.compact();
+    _compaction_scheduler->consume_io_budget(data_dir, base_compaction.input_rowsets_size());
     if (!res.ok()) {
         best_tablet->set_last_base_compaction_failure_time(UnixMillis());
         if (!res.is_not_found()) {
@@ -54,6 +54,7 @@
 
 namespace starrocks {
 
+class CompactionScheduler;
 class DataDir;
 class EngineTask;
 class BlockManager;
@@ -211,6 +212,9 @@ private:
     // clean file descriptors cache
     void* _fd_cache_clean_callback(void* arg);
 
+    // migrate the hot and the cold tablets across the SSD and the HDD data dirs, see StorageTiering
+    void* _storage_tiering_thread_callback(void* arg);
+
     // path gc process function
     void* _path_gc_thread_callback(void* arg);
 
@@ -291,6 +295,7 @@ private:
     std::vector<std::thread> _update_compaction_threads;
     // threads to clean all file descriptor not actively in use
     std::thread _fd_cache_clean_thread;
+    std::thread _storage_tiering_thread;
     std::vector<std::thread> _path_gc_threads;
     // threads to scan disk paths
     std::vector<std::thread> _path_scan_threads;
@@ -316,6 +321,8 @@ private:
 
     std::unique_ptr<UpdateManager> _update_manager;
 
+    std::unique_ptr<CompactionScheduler> _compaction_scheduler;
+
     HeartbeatFlags* _heartbeat_flags = nullptr;
 
     DISALLOW_COPY_AND_ASSIGN(StorageEngine);
@@ -0,0 +1,130 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/storage_tiering.h"
+
+#include <algorithm>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gen_cpp/AgentService_types.h"
+#include "storage/data_dir.h"
+#include "storage/rowset/rowset.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet.h"
+#include "storage/tablet_manager.h"
+#include "storage/task/engine_storage_migration_task.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+// The reads are tracked in memory only, so the tablets not read since the BE started are not known to be cold until
+// it has been up for storage_tiering_cold_seconds.
+static const int64_t s_tracked_since = UnixSeconds();
+
+StorageTiering::Temperature StorageTiering::temperature(const std::vector<RowsetAccess>& rowsets, int64_t now,
+                                                        int64_t tracked_since, int64_t hot_seconds,
+                                                        int64_t cold_seconds) {
+    int64_t last_access = 0;
+    for (const auto& rowset : rowsets) {
+        last_access = std::max(last_access, rowset.last_read_time);
+        if (rowset.loaded) {
+            last_access = std::max(last_access, rowset.creation_time);
+        }
+    }
+    if (last_access >= now - hot_seconds) {
+        return HOT;
+    }
+    if (last_access < now - cold_seconds && tracked_since <= now - cold_seconds) {
+        return COLD;
+    }
+    return WARM;
+}
+
+StorageTiering::Temperature StorageTiering::tablet_temperature(Tablet* tablet, int64_t now) {
+    std::vector<RowsetAccess> rowsets;
+    {
+        std::shared_lock rdlock(tablet->get_header_lock());
+        const RowsetSharedPtr max_rowset = tablet->rowset_with_max_version();
+        std::vector<RowsetSharedPtr> consistent_rowsets;
+        if (max_rowset == nullptr ||
+            tablet->capture_consistent_rowsets(Version(0, max_rowset->end_version()), &consistent_rowsets) !=
+                    OLAP_SUCCESS) {
+            return WARM;
+        }
+        rowsets.reserve(consistent_rowsets.size());
+        for (const auto& rowset : consistent_rowsets) {
+            RowsetAccess& access = rowsets.emplace_back();
+            access.loaded = rowset->start_version() == rowset->end_version();
+            access.creation_time = rowset->creation_time();
+            access.last_read_time = rowset->last_read_time();
+        }
+    }
+    return temperature(rowsets, now, s_tracked_since, config::storage_tiering_hot_seconds,
+                       config::storage_tiering_cold_seconds);
+}
+
+// The fraction of the capacity of the SSD data dirs used.
+static double ssd_usage(StorageEngine* engine) {
+    int64_t capacity = 0;
+    int64_t available = 0;
+    for (DataDir* store : engine->get_stores()) {
+        if (store->is_used() && store->is_ssd_disk()) {
+            DataDirInfo info = store->get_dir_info();
+            capacity += info.disk_capacity;
+            available += info.available;
+        }
+    }
+    return capacity > 0 ? 1.0 - static_cast<double>(available) / capacity : 1.0;
+}
+
+int StorageTiering::run_once(StorageEngine* engine) {
+    if (engine->available_storage_medium_type_count() <= 1) {
+        return 0;
+    }
+    const int64_t now = UnixSeconds();
+    const bool ssd_full = ssd_usage(engine) >= config::storage_tiering_ssd_max_usage;
+    std::vector<TabletSharedPtr> to_hdd;
+    std::vector<std::pair<double, TabletSharedPtr>> to_ssd;
+    for (const TabletSharedPtr& tablet : engine->tablet_manager()->get_all_tablets()) {
+        // The migration doesn't support the primary key tablets yet.
+        if (tablet->updates() != nullptr || tablet->tablet_state() != TABLET_RUNNING || !tablet->is_used()) {
+            continue;
+        }
+        const bool on_ssd = tablet->data_dir()->is_ssd_disk();
+        if (!on_ssd && ssd_full) {
+            continue;
+        }
+        Temperature temperature = tablet_temperature(tablet.get(), now);
+        if (on_ssd && temperature == COLD) {
+            to_hdd.push_back(tablet);
+        } else if (!on_ssd && temperature == HOT) {
+            to_ssd.emplace_back(tablet->recent_query_count(), tablet);
+        }
+    }
+    // The most read tablets go to the SSD first.
+    std::sort(to_ssd.begin(), to_ssd.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    int num_migrated = 0;
+    int budget = config::storage_tiering_max_migrations_per_round;
+    auto migrate = [&](const TabletSharedPtr& tablet, TStorageMedium::type storage_medium) {
+        TStorageMediumMigrateReq request;
+        request.tablet_id = tablet->tablet_id();
+        request.schema_hash = tablet->schema_hash();
+        request.storage_medium = storage_medium;
+        EngineStorageMigrationTask task(request);
+        OLAPStatus res = task.execute();
+        LOG(INFO) << "Migrate the " << (storage_medium == TStorageMedium::SSD ? "hot" : "cold") << " tablet "
+                  << tablet->tablet_id() << " to " << (storage_medium == TStorageMedium::SSD ? "SSD" : "HDD")
+                  << ", res=" << res;
+        num_migrated += res == OLAP_SUCCESS;
+    };
+    for (size_t i = 0; i < to_hdd.size() && budget > 0; i++, budget--) {
+        migrate(to_hdd[i], TStorageMedium::HDD);
+    }
+    for (size_t i = 0; i < to_ssd.size() && budget > 0; i++, budget--) {
+        migrate(to_ssd[i].second, TStorageMedium::SSD);
+    }
+    return num_migrated;
+}
+
+} // namespace starrocks
@@ -0,0 +1,44 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace starrocks {
+
+class StorageEngine;
+class Tablet;
+
+// StorageTiering keeps the hot tablets on the SSD data dirs and the cold ones on the HDD data dirs of a BE of mixed
+// media, by migrating the tablets of the wrong temperature with EngineStorageMigrationTask in the background.
+//
+// The temperature of a tablet is that of the rowset accessed last: the time a rowset was last read by a query, see
+// Rowset::record_read, or the time it was loaded, the output of a compaction counting by its reads only, as it may
+// well be compacted from year-old data. A tablet is hot if accessed in the last storage_tiering_hot_seconds, and cold
+// if not accessed in the last storage_tiering_cold_seconds.
+class StorageTiering {
+public:
+    enum Temperature { HOT, WARM, COLD };
+
+    struct RowsetAccess {
+        // Whether the rowset is loaded, rather than the output of a compaction.
+        bool loaded = false;
+        int64_t creation_time = 0;
+        // 0 if the rowset has not been read since the BE started.
+        int64_t last_read_time = 0;
+    };
+
+    // The temperature at |now| of a tablet of |rowsets|, whose reads are tracked from |tracked_since| on only, in the
+    // seconds since the epoch.
+    static Temperature temperature(const std::vector<RowsetAccess>& rowsets, int64_t now, int64_t tracked_since,
+                                   int64_t hot_seconds, int64_t cold_seconds);
+
+    static Temperature tablet_temperature(Tablet* tablet, int64_t now);
+
+    // Migrate up to storage_tiering_max_migrations_per_round tablets of the wrong temperature, the cold tablets on the
+    // SSD first to make room for the hot ones on the HDD. Returns the number of the tablets migrated.
+    static int run_once(StorageEngine* engine);
+};
+
+} // namespace starrocks
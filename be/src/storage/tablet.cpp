@@ -27,6 +27,7 @@
 #include <stdio.h>
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 
 #include "storage/olap_common.h"
@@ -712,8 +713,9 @@ bool Tablet::can_do_compaction() {
     return true;
 }
 
-const uint32_t Tablet::calc_cumulative_compaction_score() const {
+const uint32_t Tablet::calc_cumulative_compaction_score(int64_t* input_bytes) const {
     uint32_t score = 0;
+    int64_t bytes = 0;
     bool base_rowset_exist = false;
     const int64_t point = cumulative_layer_point();
     for (auto& rs_meta : _tablet_meta->all_rs_metas()) {
@@ -726,14 +728,19 @@ const uint32_t Tablet::calc_cumulative_compaction_score() const {
         }
 
         score += rs_meta->get_compaction_score();
+        bytes += rs_meta->data_disk_size();
     }
 
+    if (input_bytes != nullptr) {
+        *input_bytes = bytes;
+    }
     // If base doesn't exist, tablet may be altering, skip it, set score to 0
     return base_rowset_exist ? score : 0;
 }
 
-const uint32_t Tablet::calc_base_compaction_score() const {
+const uint32_t Tablet::calc_base_compaction_score(int64_t* input_bytes) const {
     uint32_t score = 0;
+    int64_t bytes = 0;
     const int64_t point = cumulative_layer_point();
     bool base_rowset_exist = false;
     for (auto& rs_meta : _tablet_meta->all_rs_metas()) {
@@ -746,11 +753,31 @@ const uint32_t Tablet::calc_base_compaction_score() const {
         }
 
         score += rs_meta->get_compaction_score();
+        bytes += rs_meta->data_disk_size();
     }
 
+    if (input_bytes != nullptr) {
+        *input_bytes = bytes;
+    }
     return base_rowset_exist ? score : 0;
 }
 
+// The recent reads of a tablet count for half every this many milliseconds.
+static constexpr double kQueryCountHalfLifeMs = 10 * 60 * 1000;
+
+void Tablet::record_query() {
+    std::lock_guard<std::mutex> l(_query_stat_lock);
+    int64_t now_ms = MonotonicMillis();
+    _recent_query_count =
+            _recent_query_count * std::exp2(-(now_ms - _recent_query_count_ms) / kQueryCountHalfLifeMs) + 1;
+    _recent_query_count_ms = now_ms;
+}
+
+double Tablet::recent_query_count() {
+    std::lock_guard<std::mutex> l(_query_stat_lock);
+    return _recent_query_count * std::exp2(-(MonotonicMillis() - _recent_query_count_ms) / kQueryCountHalfLifeMs);
+}
+
 void Tablet::compute_version_hash_from_rowsets(const std::vector<RowsetSharedPtr>& rowsets, VersionHash* version_hash) {
     DCHECK(version_hash != nullptr) << "invalid parameter, version_hash is nullptr";
     int64_t v_hash = 0;
@@ -1307,6 +1334,9 @@ StatusOr<Tablet::IteratorList> Tablet::capture_segment_iterators(const Version&
     IteratorList iterators;
     for (auto& rowset : rowsets) {
         RETURN_IF_ERROR(rowset->get_segment_iterators(schema, options, &iterators));
+        if (options.reader_type == READER_QUERY) {
+            rowset->record_read();
+        }
     }
     return std::move(iterators);
 }
@@ -173,8 +173,9 @@ public:
 
     // operation for compaction
     bool can_do_compaction();
-    const uint32_t calc_cumulative_compaction_score() const;
-    const uint32_t calc_base_compaction_score() const;
+    // The score of the rowsets to compact, and their bytes in |input_bytes| if it is not nullptr.
+    const uint32_t calc_cumulative_compaction_score(int64_t* input_bytes = nullptr) const;
+    const uint32_t calc_base_compaction_score(int64_t* input_bytes = nullptr) const;
     static void compute_version_hash_from_rowsets(const std::vector<RowsetSharedPtr>& rowsets,
                                                   VersionHash* version_hash);
 
@@ -196,6 +197,11 @@ public:
     int64_t last_base_compaction_failure_time() { return _last_base_compaction_failure_millis; }
     void set_last_base_compaction_failure_time(int64_t millis) { _last_base_compaction_failure_millis = millis; }
 
+    // Record a read of the tablet by a query. The compactions of the tablets read often are scheduled first.
+    void record_query();
+    // The number of the recent reads by the queries, each of which counts for half every 10 minutes.
+    double recent_query_count();
+
     int64_t last_cumu_compaction_success_time() { return _last_cumu_compaction_success_millis; }
     void set_last_cumu_compaction_success_time(int64_t millis) { _last_cumu_compaction_success_millis = millis; }
 
@@ -305,6 +311,10 @@ private:
     // timestamp of last base compaction success
     std::atomic<int64_t> _last_base_compaction_success_millis{0};
 
+    std::mutex _query_stat_lock;
+    double _recent_query_count = 0;
+    int64_t _recent_query_count_ms = 0;
+
     std::atomic<int64_t> _cumulative_point{0};
     std::atomic<int32_t> _newly_created_rowset_num{0};
     std::atomic<int64_t> _last_checkpoint_time{0};
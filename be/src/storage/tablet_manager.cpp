@@ -27,9 +27,11 @@
 #include <cstdlib>
 #include <ctime>
 #include <memory>
+#include <thread>
 
 #include "env/env.h"
 #include "gutil/strings/strcat.h"
+#include "storage/compaction_scheduler.h"
 #include "storage/data_dir.h"
 #include "storage/olap_common.h"
 #include "storage/reader.h"
@@ -67,8 +69,9 @@ TabletManager::TabletManager(MemTracker* mem_tracker, int32_t tablet_map_lock_sh
     CHECK_GT(_tablets_shards_size, 0);
     CHECK_EQ(_tablets_shards_size & _tablets_shards_mask, 0);
     _tablets_shards.resize(_tablets_shards_size);
+    auto* lock_site = LockSite::get("tablet_manager_shard");
     for (auto& tablets_shard : _tablets_shards) {
-        tablets_shard.lock = std::make_unique<std::shared_mutex>();
+        tablets_shard.lock = std::make_unique<ProfiledSharedMutex>(lock_site);
     }
 }
 
@@ -645,11 +648,13 @@ void TabletManager::get_tablet_stat(TTabletStatResult* result) {
     result->__set_tablets_stats(_tablet_stat_cache);
 }
 
-TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType compaction_type, DataDir* data_dir) {
+TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType compaction_type, DataDir* data_dir,
+                                                              bool urgent_only) {
     int64_t now_ms = UnixMillis();
     const std::string& compaction_type_str = compaction_type == CompactionType::BASE_COMPACTION ? "base" : "cumulative";
-    // only do compaction if compaction #rowset > 1
-    uint32_t highest_score = 1;
+    // only do compaction if compaction #rowset > 1, i.e. priority > 0
+    double highest_priority = 0;
+    uint32_t highest_score = 0;
     TabletSharedPtr best_tablet;
     for (const auto& tablets_shard : _tablets_shards) {
         std::shared_lock rlock(*tablets_shard.lock);
@@ -702,15 +707,24 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType com
                 }
 
                 uint32_t table_score = 0;
+                int64_t input_bytes = 0;
+                int64_t version_count = 0;
                 {
                     std::shared_lock rdlock(tablet_ptr->get_header_lock());
                     if (compaction_type == CompactionType::BASE_COMPACTION) {
-                        table_score = tablet_ptr->calc_base_compaction_score();
+                        table_score = tablet_ptr->calc_base_compaction_score(&input_bytes);
                     } else if (compaction_type == CompactionType::CUMULATIVE_COMPACTION) {
-                        table_score = tablet_ptr->calc_cumulative_compaction_score();
+                        table_score = tablet_ptr->calc_cumulative_compaction_score(&input_bytes);
                     }
+                    version_count = tablet_ptr->version_count();
                 }
-                if (table_score > highest_score) {
+                if (urgent_only && !CompactionScheduler::is_urgent(version_count)) {
+                    continue;
+                }
+                double priority = CompactionScheduler::priority(table_score, input_bytes, version_count,
+                                                                tablet_ptr->recent_query_count());
+                if (priority > highest_priority) {
+                    highest_priority = priority;
                     highest_score = table_score;
                     best_tablet = tablet_ptr;
                 }
@@ -721,7 +735,7 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType com
     if (best_tablet != nullptr) {
         LOG(INFO) << "Found the best tablet to compact. "
                   << "compaction_type=" << compaction_type_str << " tablet_id=" << best_tablet->tablet_id()
-                  << " highest_score=" << highest_score;
+                  << " highest_score=" << highest_score << " priority=" << highest_priority;
         // TODO(lingbin): Remove 'max' from metric name, it would be misunderstood as the
         // biggest in history(like peak), but it is really just the value at current moment.
         if (compaction_type == CompactionType::BASE_COMPACTION) {
@@ -733,6 +747,17 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType com
     return best_tablet;
 }
 
+std::vector<TabletSharedPtr> TabletManager::get_all_tablets() {
+    std::vector<TabletSharedPtr> tablets;
+    for (const auto& tablets_shard : _tablets_shards) {
+        std::shared_lock rlock(*tablets_shard.lock);
+        for (const auto& tablet_map : tablets_shard.tablet_map) {
+            tablets.insert(tablets.end(), tablet_map.second.table_arr.begin(), tablet_map.second.table_arr.end());
+        }
+    }
+    return tablets;
+}
+
 TabletSharedPtr TabletManager::find_best_tablet_to_do_update_compaction(DataDir* data_dir) {
     int64_t highest_score = 0;
     TabletSharedPtr best_tablet;
@@ -789,7 +814,8 @@ TabletSharedPtr TabletManager::find_best_tablet_to_do_update_compaction(DataDir*
 Status TabletManager::load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_id, TSchemaHash schema_hash,
                                             const std::string& meta_binary, bool update_meta, bool force, bool restore,
                                             bool check_path) {
-    std::unique_lock wlock(_get_tablets_shard_lock(tablet_id));
+    // The meta is parsed and the tablet is initialized without the lock of the shard, which is only needed to add the
+    // tablet into the shard, so that the tablets of a shard can be loaded concurrently.
     TabletMetaSharedPtr tablet_meta(new TabletMeta(_mem_tracker));
     if (tablet_meta->deserialize(meta_binary) != OLAP_SUCCESS) {
         LOG(WARNING) << "Fail to load tablet because can not parse meta_binary string. "
@@ -860,6 +886,7 @@ Status TabletManager::load_tablet_from_meta(DataDir* data_dir, TTabletId tablet_
         // tablet state is invalid, drop tablet
         return Status::InternalError("tablet in running state but without delta");
     }
+    std::unique_lock wlock(_get_tablets_shard_lock(tablet_id));
     auto st = _add_tablet_unlocked(tablet_id, schema_hash, tablet, update_meta, force);
     LOG_IF(WARNING, !st.ok()) << "Fail to add tablet " << tablet->full_name();
     return st;
@@ -945,33 +972,44 @@ Status TabletManager::report_all_tablets_info(std::map<TTabletId, TTablet>* tabl
 
     StarRocksMetrics::instance()->report_all_tablets_requests_total.increment(1);
 
+    // The shard locks are held only to copy the tablets, instead of while taking the meta lock of every tablet to
+    // build its info, which stalled the creation and the drop of the tablets of the shard for the whole report.
+    std::vector<TabletSharedPtr> tablets;
     for (const auto& tablets_shard : _tablets_shards) {
         std::shared_lock rlock(*tablets_shard.lock);
         for (const auto& item : tablets_shard.tablet_map) {
-            if (item.second.table_arr.empty()) {
-                continue;
-            }
-
-            uint64_t tablet_id = item.first;
-            TTablet t_tablet;
-            for (const TabletSharedPtr& tablet_ptr : item.second.table_arr) {
-                TTabletInfo tablet_info;
-                tablet_ptr->build_tablet_report_info(&tablet_info);
-
-                // find expired transaction corresponding to this tablet
-                TabletInfo tinfo(tablet_id, tablet_ptr->schema_hash(), tablet_ptr->tablet_uid());
-                auto find = expire_txn_map.find(tinfo);
-                if (find != expire_txn_map.end()) {
-                    tablet_info.__set_transaction_ids(find->second);
-                    expire_txn_map.erase(find);
-                }
-                t_tablet.tablet_infos.push_back(tablet_info);
-            }
+            tablets.insert(tablets.end(), item.second.table_arr.begin(), item.second.table_arr.end());
+        }
+    }
 
-            if (!t_tablet.tablet_infos.empty()) {
-                tablets_info->emplace(tablet_id, t_tablet);
-            }
+    std::vector<TTabletInfo> infos(tablets.size());
+    size_t num_threads = std::min<size_t>(std::max(config::report_tablet_threads, 1), tablets.size() / 1024 + 1);
+    size_t slice = (tablets.size() + num_threads - 1) / num_threads;
+    auto build = [&](size_t begin) {
+        for (size_t i = begin; i < std::min(begin + slice, tablets.size()); i++) {
+            tablets[i]->build_tablet_report_info(&infos[i]);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < num_threads; t++) {
+        threads.emplace_back(build, t * slice);
+    }
+    build(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < tablets.size(); i++) {
+        const TabletSharedPtr& tablet = tablets[i];
+        TTabletInfo& tablet_info = infos[i];
+        // find expired transaction corresponding to this tablet
+        TabletInfo tinfo(tablet->tablet_id(), tablet->schema_hash(), tablet->tablet_uid());
+        auto find = expire_txn_map.find(tinfo);
+        if (find != expire_txn_map.end()) {
+            tablet_info.__set_transaction_ids(find->second);
+            expire_txn_map.erase(find);
         }
+        (*tablets_info)[tablet->tablet_id()].tablet_infos.push_back(std::move(tablet_info));
     }
     LOG(INFO) << "Reported all " << tablets_info->size() << " tablets info";
     return Status::OK();
@@ -1439,7 +1477,7 @@ void TabletManager::_remove_tablet_from_partition(const Tablet& tablet) {
     }
 }
 
-std::shared_mutex& TabletManager::_get_tablets_shard_lock(TTabletId tabletId) {
+ProfiledSharedMutex& TabletManager::_get_tablets_shard_lock(TTabletId tabletId) {
     return *_get_tablets_shard(tabletId).lock;
 }
 
@@ -39,6 +39,7 @@
 #include "storage/olap_meta.h"
 #include "storage/options.h"
 #include "storage/tablet.h"
+#include "util/lock_profiler.h"
 
 namespace starrocks {
 
@@ -66,10 +67,16 @@ public:
 
     Status drop_tablets_on_error_root_path(const std::vector<TabletInfo>& tablet_info_vec);
 
-    TabletSharedPtr find_best_tablet_to_compaction(CompactionType compaction_type, DataDir* data_dir);
+    // Find the tablet of |data_dir| of the highest priority of CompactionScheduler to compact, only among the urgent
+    // ones if |urgent_only|.
+    TabletSharedPtr find_best_tablet_to_compaction(CompactionType compaction_type, DataDir* data_dir,
+                                                   bool urgent_only = false);
 
     TabletSharedPtr find_best_tablet_to_do_update_compaction(DataDir* data_dir);
 
+    // All the tablets, including those of the schema changes.
+    std::vector<TabletSharedPtr> get_all_tablets();
+
     TabletSharedPtr get_tablet(TTabletId tablet_id, SchemaHash schema_hash, bool include_deleted = false,
                                std::string* err = nullptr);
 
@@ -168,7 +175,7 @@ private:
 
     void _remove_tablet_from_partition(const Tablet& tablet);
 
-    std::shared_mutex& _get_tablets_shard_lock(TTabletId tabletId);
+    ProfiledSharedMutex& _get_tablets_shard_lock(TTabletId tabletId);
 
     DISALLOW_COPY_AND_ASSIGN(TabletManager);
 
@@ -186,7 +193,7 @@ private:
 
     struct tablets_shard {
         // protect tablet_map, tablets_under_clone
-        std::unique_ptr<std::shared_mutex> lock;
+        std::unique_ptr<ProfiledSharedMutex> lock;
         tablet_map_t tablet_map;
         std::set<int64_t> tablets_under_clone;
     };
@@ -30,6 +30,7 @@
 #include "storage/olap_define.h"
 #include "storage/protobuf_file.h"
 #include "storage/tablet_meta_manager.h"
+#include "storage/tablet_schema_map.h"
 #include "storage/tablet_updates.h"
 #include "util/uid_util.h"
 #include "util/url_coding.h"
@@ -232,6 +233,10 @@ OLAPStatus TabletMeta::create(MemTracker* mem_tracker, const TCreateTabletReq& r
             mem_tracker, request.table_id, request.partition_id, request.tablet_id, request.tablet_schema.schema_hash,
             shard_id, request.tablet_schema, next_unique_id, col_ordinal_to_unique_id, tablet_uid,
             request.__isset.tablet_type ? request.tablet_type : TTabletType::TABLET_TYPE_DISK, rowset_type);
+    if (request.__isset.cumulative_compaction_policy &&
+        request.cumulative_compaction_policy == TCumulativeCompactionPolicy::SIZE_TIERED) {
+        (*tablet_meta)->set_cumulative_compaction_policy(SIZE_TIERED_CUMULATIVE_COMPACTION);
+    }
     return OLAP_SUCCESS;
 }
 
@@ -458,9 +463,7 @@ void TabletMeta::init_from_pb(TabletMetaPB* ptablet_meta_pb) {
     }
 
     // init _schema
-    _schema = std::make_shared<TabletSchema>();
-    _schema->init_from_pb(tablet_meta_pb.schema());
-    _mem_tracker->consume(_schema->mem_usage());
+    _schema = TabletSchemaMap::instance()->emplace(tablet_meta_pb.schema());
 
     // init _rs_metas
     for (auto& it : tablet_meta_pb.rs_metas()) {
@@ -493,6 +496,9 @@ void TabletMeta::init_from_pb(TabletMetaPB* ptablet_meta_pb) {
     if (tablet_meta_pb.has_preferred_rowset_type()) {
         _preferred_rowset_type = tablet_meta_pb.preferred_rowset_type();
     }
+    if (tablet_meta_pb.has_cumulative_compaction_policy()) {
+        _cumulative_compaction_policy = tablet_meta_pb.cumulative_compaction_policy();
+    }
     if (tablet_meta_pb.has_updates()) {
         _updatesPB.reset(tablet_meta_pb.release_updates());
     }
@@ -545,6 +551,9 @@ void TabletMeta::to_meta_pb(TabletMetaPB* tablet_meta_pb) {
     if (_preferred_rowset_type == BETA_ROWSET) {
         tablet_meta_pb->set_preferred_rowset_type(_preferred_rowset_type);
     }
+    if (_cumulative_compaction_policy != NUM_BASED_CUMULATIVE_COMPACTION) {
+        tablet_meta_pb->set_cumulative_compaction_policy(_cumulative_compaction_policy);
+    }
     if (_updates != nullptr) {
         _updates->to_updates_pb(tablet_meta_pb->mutable_updates());
     } else if (_updatesPB) {
@@ -861,6 +870,7 @@ bool operator==(const TabletMeta& a, const TabletMeta& b) {
     if (a._alter_task != b._alter_task) return false;
     if (a._in_restore_mode != b._in_restore_mode) return false;
     if (a._preferred_rowset_type != b._preferred_rowset_type) return false;
+    if (a._cumulative_compaction_policy != b._cumulative_compaction_policy) return false;
     return true;
 }
 
@@ -163,13 +163,8 @@ public:
 
     inline const TabletSchema& tablet_schema() const;
 
-    inline void set_tablet_schema(const std::shared_ptr<TabletSchema>& tablet_schema) {
-        if (_schema != nullptr) {
-            _mem_tracker->release(_schema->mem_usage());
-        }
-        _schema = tablet_schema;
-        _mem_tracker->consume(_schema->mem_usage());
-    }
+    // The memory of the schema is not charged to the TabletMeta, the schema being shared, see TabletSchemaMap.
+    inline void set_tablet_schema(const std::shared_ptr<TabletSchema>& tablet_schema) { _schema = tablet_schema; }
 
     inline std::shared_ptr<TabletSchema>& mutable_tablet_schema() { return _schema; }
 
@@ -208,6 +203,12 @@ public:
         _preferred_rowset_type = preferred_rowset_type;
     }
 
+    CumulativeCompactionPolicyPB cumulative_compaction_policy() const { return _cumulative_compaction_policy; }
+
+    void set_cumulative_compaction_policy(CumulativeCompactionPolicyPB policy) {
+        _cumulative_compaction_policy = policy;
+    }
+
     // used when create new tablet
     void create_inital_updates_meta();
     // _updates will become empty after release
@@ -246,6 +247,7 @@ private:
     TabletState _tablet_state = TABLET_NOTREADY;
     // Note: Segment store the pointer of TabletSchema,
     // so this point should never change
+    // Interned by TabletSchemaMap, and so shared by the tablets of the same schema: never modify it in place.
     std::shared_ptr<TabletSchema> _schema = nullptr;
 
     std::vector<RowsetMetaSharedPtr> _rs_metas;
@@ -259,6 +261,7 @@ private:
     AlterTabletTaskSharedPtr _alter_task;
     bool _in_restore_mode = false;
     RowsetTypePB _preferred_rowset_type = BETA_ROWSET;
+    CumulativeCompactionPolicyPB _cumulative_compaction_policy = NUM_BASED_CUMULATIVE_COMPACTION;
 
     // This meta is used for TabletUpdates' load process,
     // to save memory it will be passed to TabletUpdates for usage
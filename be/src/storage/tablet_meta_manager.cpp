@@ -742,7 +742,8 @@ Status TabletMetaManager::rowset_iterate(DataDir* store, TTabletId tablet_id, co
 
 Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_id, int64_t logid,
                                               const EditVersion& version,
-                                              vector<std::pair<uint32_t, DelVectorPtr>>& delvecs) {
+                                              vector<std::pair<uint32_t, DelVectorPtr>>& delvecs,
+                                              const RowsetMetaPB* rowset) {
     WriteBatch batch;
     auto handle = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
     TabletMetaLogPB log;
@@ -770,6 +771,13 @@ Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_i
             return to_status(st);
         }
     }
+    if (rowset != nullptr) {
+        st = batch.Put(handle, encode_meta_rowset_key(tablet_id, rowset->rowset_seg_id()), rowset->SerializeAsString());
+        if (!st.ok()) {
+            LOG(WARNING) << "rowset_commit failed, rocksdb.batch.put failed";
+            return to_status(st);
+        }
+    }
     return store->get_meta()->write_batch(&batch);
 }
 
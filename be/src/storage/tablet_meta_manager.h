@@ -135,8 +135,10 @@ public:
     static Status rowset_delete(DataDir* store, TTabletId tablet_id, uint32_t rowset_id, uint32_t segments);
 
     // update meta after state of a rowset commit is applied
+    // |rowset| is the new meta of the rowset rewritten by the apply, i.e. the filled partial update, if not null
     static Status apply_rowset_commit(DataDir* store, TTabletId tablet_id, int64_t logid, const EditVersion& version,
-                                      std::vector<std::pair<uint32_t, DelVectorPtr>>& delvecs);
+                                      std::vector<std::pair<uint32_t, DelVectorPtr>>& delvecs,
+                                      const RowsetMetaPB* rowset = nullptr);
 
     // traverse all the op logs for a tablet
     static Status traverse_meta_logs(DataDir* store, TTabletId tablet_id,
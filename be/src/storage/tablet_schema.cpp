@@ -347,6 +347,7 @@ bool TabletColumn::is_format_v2_column() const {
 }
 
 void TabletSchema::init_from_pb(const TabletSchemaPB& schema) {
+    std::atomic_store(&_format_v2_fields, std::shared_ptr<const FormatV2Fields>());
     _keys_type = schema.keys_type();
     _num_columns = 0;
     _num_key_columns = 0;
@@ -425,6 +426,18 @@ std::unique_ptr<TabletSchema> TabletSchema::convert_to_format(DataFormatVersion
     return schema;
 }
 
+std::unique_ptr<TabletSchema> TabletSchema::select_columns(const std::vector<uint32_t>& column_ids) const {
+    TabletSchemaPB schema_pb;
+    to_schema_pb(&schema_pb);
+    schema_pb.clear_column();
+    for (uint32_t cid : column_ids) {
+        column(cid).to_schema_pb(schema_pb.add_column());
+    }
+    auto schema = std::make_unique<TabletSchema>();
+    schema->init_from_pb(schema_pb);
+    return schema;
+}
+
 size_t TabletSchema::row_size() const {
     size_t size = 0;
     for (auto& column : _cols) {
@@ -24,6 +24,7 @@
 
 #include <gtest/gtest_prod.h>
 
+#include <memory>
 #include <vector>
 
 #include "gen_cpp/olap_file.pb.h"
@@ -39,6 +40,11 @@ class SegmentReaderWriterTest_estimate_segment_size_Test;
 class SegmentReaderWriterTest_TestStringDict_Test;
 } // namespace segment_v2
 
+namespace vectorized {
+class ChunkHelper;
+class Field;
+} // namespace vectorized
+
 class TabletColumn {
 public:
     TabletColumn();
@@ -153,6 +159,9 @@ public:
 
     std::unique_ptr<TabletSchema> convert_to_format(DataFormatVersion format) const;
 
+    // The schema of the columns |column_ids| only, in ascending order.
+    std::unique_ptr<TabletSchema> select_columns(const std::vector<uint32_t>& column_ids) const;
+
     std::string debug_string() const;
 
     int64_t mem_usage() const {
@@ -168,9 +177,12 @@ private:
     FRIEND_TEST(segment_v2::SegmentReaderWriterTest, estimate_segment_size);
     FRIEND_TEST(segment_v2::SegmentReaderWriterTest, TestStringDict);
 
+    friend class vectorized::ChunkHelper;
     friend bool operator==(const TabletSchema& a, const TabletSchema& b);
     friend bool operator!=(const TabletSchema& a, const TabletSchema& b);
 
+    using FormatV2Fields = std::vector<std::shared_ptr<vectorized::Field>>;
+
     KeysType _keys_type = DUP_KEYS;
     std::vector<TabletColumn> _cols;
     size_t _num_columns = 0;
@@ -184,6 +196,10 @@ private:
     bool _has_bf_fpp = false;
     double _bf_fpp = 0;
     bool _is_in_memory = false;
+
+    // The fields of format v2 of the columns, converted by ChunkHelper on the first use and shared by the
+    // vectorized::Schemas of this schema from then on. Accessed with std::atomic_load and std::atomic_store.
+    mutable std::shared_ptr<const FormatV2Fields> _format_v2_fields;
 };
 
 bool operator==(const TabletSchema& a, const TabletSchema& b);
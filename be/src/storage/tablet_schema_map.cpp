@@ -0,0 +1,53 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/tablet_schema_map.h"
+
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+#include "storage/tablet_schema.h"
+
+namespace starrocks {
+
+TabletSchemaMap* TabletSchemaMap::instance() {
+    static TabletSchemaMap s_instance;
+    return &s_instance;
+}
+
+std::shared_ptr<TabletSchema> TabletSchemaMap::emplace(const TabletSchemaPB& schema_pb) {
+    std::string key = schema_pb.SerializeAsString();
+    Shard& shard = _shards[std::hash<std::string>()(key) % kNumShards];
+    std::lock_guard l(shard.mutex);
+    auto& schema = shard.schemas[key];
+    if (schema == nullptr) {
+        schema = std::make_shared<TabletSchema>();
+        schema->init_from_pb(schema_pb);
+        int64_t mem_usage = schema->mem_usage() + key.size();
+        shard.mem_usage += mem_usage;
+        // Charged once per schema rather than to the TabletMeta of each tablet.
+        MemTracker* mem_tracker = ExecEnv::GetInstance()->tablet_meta_mem_tracker();
+        if (mem_tracker != nullptr) {
+            mem_tracker->consume(mem_usage);
+        }
+    }
+    return schema;
+}
+
+size_t TabletSchemaMap::size() const {
+    size_t size = 0;
+    for (const auto& shard : _shards) {
+        std::lock_guard l(shard.mutex);
+        size += shard.schemas.size();
+    }
+    return size;
+}
+
+int64_t TabletSchemaMap::mem_usage() const {
+    int64_t mem_usage = 0;
+    for (const auto& shard : _shards) {
+        std::lock_guard l(shard.mutex);
+        mem_usage += shard.mem_usage;
+    }
+    return mem_usage;
+}
+
+} // namespace starrocks
@@ -0,0 +1,47 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "gen_cpp/olap_file.pb.h"
+
+namespace starrocks {
+
+class TabletSchema;
+
+// TabletSchemaMap interns the schemas of the tablets, so that the tablets of identical schemas, the partitions and
+// the buckets of a table mostly, share a single TabletSchema rather than a copy each. The schemas are keyed by their
+// serialized TabletSchemaPB, so a schema is only shared by the tablets of the very same columns and properties.
+//
+// The interned schemas are immutable and kept for the lifetime of the process: the rowsets and the segments keep raw
+// pointers to the schema of their tablet, which must outlive them even after the tablet has changed its schema,
+// see TabletMeta::set_tablet_schema. There are as many of them as the distinct schemas created since the BE started.
+class TabletSchemaMap {
+public:
+    static TabletSchemaMap* instance();
+
+    // The interned schema of |schema_pb|.
+    std::shared_ptr<TabletSchema> emplace(const TabletSchemaPB& schema_pb);
+
+    size_t size() const;
+
+    // The memory used by the interned schemas.
+    int64_t mem_usage() const;
+
+private:
+    static const size_t kNumShards = 16;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<TabletSchema>> schemas;
+        int64_t mem_usage = 0;
+    };
+
+    Shard _shards[kNumShards];
+};
+
+} // namespace starrocks
@@ -7,6 +7,7 @@
 #include <algorithm>
 
 #include "common/status.h"
+#include "env/env.h"
 #include "gen_cpp/MasterService_types.h"
 #include "gen_cpp/olap_file.pb.h"
 #include "gutil/stl_util.h"
@@ -15,11 +16,16 @@
 #include "rocksdb/write_batch.h"
 #include "runtime/exec_env.h"
 #include "storage/del_vector.h"
+#include "storage/fs/fs_util.h"
+#include "storage/persistent_index.h"
 #include "storage/primary_key_encoder.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_meta_manager.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/rowset/rowset_writer_context.h"
+#include "storage/rowset/segment_v2/column_reader.h"
+#include "storage/rowset/segment_v2/segment.h"
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/rowset_update_state.h"
 #include "storage/snapshot_meta.h"
@@ -376,7 +382,7 @@ void TabletUpdates::_redo_edit_version_log(const EditVersionMetaPB& v) {
 }
 
 Status TabletUpdates::_get_apply_version_and_rowsets(int64_t* version, std::vector<RowsetSharedPtr>* rowsets,
-                                                     std::vector<uint32_t>* rowset_ids) {
+                                                     std::vector<uint32_t>* rowset_ids, EditVersion* full_version) {
     std::lock_guard rl(_lock);
     EditVersionInfo* v = nullptr;
     v = _versions[_apply_version_idx].get();
@@ -395,6 +401,9 @@ Status TabletUpdates::_get_apply_version_and_rowsets(int64_t* version, std::vect
     }
     rowset_ids->assign(v->rowsets.begin(), v->rowsets.end());
     *version = v->version.major();
+    if (full_version != nullptr) {
+        *full_version = v->version;
+    }
     return Status::OK();
 }
 
@@ -647,6 +656,7 @@ void TabletUpdates::do_apply() {
                 StarRocksMetrics::instance()->update_rowset_commit_apply_total.increment(1);
                 SCOPED_RAW_TIMER(&duration_ns);
                 // rowset commit
+                std::unique_lock ul(_index_lock);
                 _apply_rowset_commit(*version_info_apply);
             }
             StarRocksMetrics::instance()->update_rowset_commit_apply_duration_us.increment(duration_ns / 1000);
@@ -654,7 +664,10 @@ void TabletUpdates::do_apply() {
             // compaction
             // _compaction_running may be false after BE restart, reset it to true
             _compaction_running = true;
-            _apply_compaction_commit(*version_info_apply);
+            {
+                std::unique_lock ul(_index_lock);
+                _apply_compaction_commit(*version_info_apply);
+            }
             _compaction_running = false;
         } else {
             LOG(ERROR) << "bad EditVersionInfo tablet:" << _tablet.tablet_id();
@@ -716,6 +729,17 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
         _set_error();
         return;
     }
+    // the partial update is filled before its keys are upserted into the index, and replaces the rowset with the meta
+    RowsetSharedPtr filled_rowset;
+    if (rowset->rowset_meta()->is_partial_update()) {
+        st = _fill_partial_rowset(rowset_id, rowset, state, index, &filled_rowset);
+        if (!st.ok()) {
+            LOG(ERROR) << "_apply_rowset_commit error: fill partial update failed: " << st << " " << debug_string();
+            manager->update_state_cache().remove(state_entry);
+            _set_error();
+            return;
+        }
+    }
     int64_t t_load = MonotonicMillis();
 
     // 3. generate delvec
@@ -727,22 +751,24 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     size_t old_total_del = 0;
     size_t total_del = 0;
     size_t new_del = 0;
-    auto& upserts = state.upserts();
-    for (uint32_t i = 0; i < upserts.size(); i++) {
-        if (upserts[i] != nullptr) {
-            index.upsert(rowset_id + i, 0, *upserts[i], &new_deletes);
-            manager->index_cache().update_object_size(index_entry, index.memory_usage());
-            if (mem_tracker->limit_exceeded()) {
-                // TODO: handle this
-                LOG(WARNING) << "apply_rowset_commit memory limit exceeded tablet:" << _tablet.tablet_id()
-                             << " rowset:" << rowset_id << " seg:" << i << " index:" << index.memory_info()
-                             << " total:" << manager->memory_stats();
-            }
-        }
+    st = index.upsert_rowset(rowset_id, state.upserts(), state.deletes(), manager->apply_index_thread_pool(),
+                             &new_deletes);
+    manager->index_cache().update_object_size(index_entry, index.memory_usage());
+    if (mem_tracker->limit_exceeded()) {
+        // TODO: handle this
+        LOG(WARNING) << "apply_rowset_commit memory limit exceeded tablet:" << _tablet.tablet_id()
+                     << " rowset:" << rowset_id << " index:" << index.memory_info()
+                     << " total:" << manager->memory_stats();
     }
-    for (const auto& one_delete : state.deletes()) {
-        index.erase(*one_delete.get(), &new_deletes);
+    if (!st.ok()) {
+        LOG(ERROR) << "_apply_rowset_commit error: update primary index failed: " << st << " " << debug_string();
+        manager->update_state_cache().remove(state_entry);
+        manager->index_cache().remove(index_entry);
+        _set_error();
+        return;
     }
+    // the index is rebuilt by the next load if it fails to persist, so it's not an error of the apply
+    WARN_IF_ERROR(index.commit(version), "_apply_rowset_commit: commit primary index failed");
     manager->index_cache().update_object_size(index_entry, index.memory_usage());
     // release resource
     // update state only used once, so delete it
@@ -831,12 +857,29 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     {
         std::lock_guard wl(_lock);
         // 4. write meta
-        st = TabletMetaManager::apply_rowset_commit(_tablet.data_dir(), tablet_id, _next_log_id, version, new_del_vecs);
+        st = TabletMetaManager::apply_rowset_commit(
+                _tablet.data_dir(), tablet_id, _next_log_id, version, new_del_vecs,
+                filled_rowset != nullptr ? &filled_rowset->rowset_meta()->get_meta_pb() : nullptr);
         if (!st.ok()) {
             LOG(ERROR) << "_apply_rowset_commit error: write meta failed: " << st << " " << _debug_string(false);
             _set_error();
             return;
         }
+        if (filled_rowset != nullptr) {
+            {
+                std::lock_guard<std::mutex> lg(_rowsets_lock);
+                _rowsets[rowset_id] = filled_rowset;
+            }
+            {
+                std::lock_guard lg(_rowset_stats_lock);
+                auto iter = _rowset_stats.find(rowset_id);
+                if (iter != _rowset_stats.end()) {
+                    iter->second->byte_size = filled_rowset->data_disk_size();
+                }
+            }
+            // the files of the partial update are removed once it's not referenced
+            StorageEngine::instance()->add_unused_rowset(rowset);
+        }
         // put delvec in cache
         TabletSegmentId tsid;
         tsid.tablet_id = tablet_id;
@@ -965,6 +1008,7 @@ Status TabletUpdates::_do_compaction(std::unique_ptr<CompactionInfo>* pinfo, Mem
     }
     vectorized::MergeConfig cfg;
     cfg.chunk_size = config::vector_chunk_size;
+    cfg.max_columns_per_group = std::max(0, config::vertical_compaction_max_columns_per_group);
     RETURN_IF_ERROR(vectorized::compaction_merge_rowsets(_tablet, info->start_version.major(), input_rowsets,
                                                          rowset_writer.get(), cfg));
     auto output_rowset = rowset_writer->build();
@@ -1120,7 +1164,15 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
         uint32_t rssid = rowset_id + i;
         tmp_deletes.clear();
         // replace will not grow hashtable, so don't need to check memory limit
-        index.try_replace(rssid, 0, *sstate.pkeys, sstate.src_rssids, &tmp_deletes);
+        st = index.try_replace(rssid, 0, *sstate.pkeys, sstate.src_rssids, &tmp_deletes);
+        if (!st.ok()) {
+            LOG(ERROR) << "_apply_compaction_commit error: update primary index failed: " << st << " "
+                       << debug_string();
+            manager->index_cache().remove(index_entry);
+            _compaction_state.reset();
+            _set_error();
+            return;
+        }
         DelVectorPtr dv = std::make_shared<DelVector>();
         if (tmp_deletes.empty()) {
             dv->init(version.major(), nullptr, 0);
@@ -1135,6 +1187,7 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
     }
     // release memory
     _compaction_state.reset();
+    WARN_IF_ERROR(index.commit(version), "_apply_compaction_commit: commit primary index failed");
     // index may be used for later commits, so keep in cache
     manager->index_cache().release(index_entry);
     int64_t t_index_delvec = MonotonicMillis();
@@ -1691,6 +1744,275 @@ Status TabletUpdates::get_applied_rowsets(int64_t version, std::vector<RowsetSha
     return Status::NotFound(strings::Substitute("rowset version $0 not found", version));
 }
 
+// Read the columns of |schema| of the rows |rowids|, in ascending order, of |segment| into |chunk|.
+static Status read_segment_rows(segment_v2::Segment* segment, const std::vector<uint32_t>& rowids,
+                                const vectorized::Schema& schema, OlapReaderStatistics* stats,
+                                vectorized::Chunk* chunk) {
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    RETURN_IF_ERROR(fs::fs_util::block_manager()->open_block(segment->file_name(), &rblock));
+    for (size_t i = 0; i < schema.num_fields(); i++) {
+        segment_v2::ColumnIterator* raw_iter = nullptr;
+        RETURN_IF_ERROR(segment->new_column_iterator(schema.field(i)->id(), &raw_iter));
+        std::unique_ptr<segment_v2::ColumnIterator> iter(raw_iter);
+        segment_v2::ColumnIteratorOptions iter_opts;
+        iter_opts.stats = stats;
+        iter_opts.use_page_cache = !config::disable_storage_page_cache;
+        iter_opts.use_decoded_page_cache = iter_opts.use_page_cache;
+        iter_opts.rblock = rblock.get();
+        RETURN_IF_ERROR(iter->init(iter_opts));
+        RETURN_IF_ERROR(iter->fetch_values_by_rowid(rowids.data(), rowids.size(), chunk->get_column_by_index(i).get()));
+    }
+    return Status::OK();
+}
+
+// Read the columns of |schema| of the rows at |positions|, rssid in the high 32 bits and rowid in the low, of
+// |rowsets| by the rssid of their first segments, into |chunk| in the order of |positions|, and save the indexes of
+// the positions found, those not NullIndex, into |found|. The rows are read segment by segment.
+static Status read_rows_by_positions(const std::map<uint32_t, RowsetSharedPtr>& rowsets,
+                                     const vector<uint64_t>& positions, const vectorized::Schema& schema,
+                                     OlapReaderStatistics* stats, vectorized::Chunk* chunk, vector<uint32_t>* found) {
+    std::map<uint32_t, vector<std::pair<uint32_t, uint32_t>>> segment_rows;
+    for (uint32_t i = 0; i < positions.size(); i++) {
+        if (positions[i] != PrimaryIndex::NullIndex) {
+            segment_rows[(uint32_t)(positions[i] >> 32)].emplace_back((uint32_t)(positions[i] & 0xffffffff), i);
+        }
+    }
+    vector<vectorized::ChunkPtr> segment_chunks;
+    // the index of the chunk and the row in it of each position
+    vector<std::pair<uint32_t, uint32_t>> key_rows(positions.size(), {UINT32_MAX, 0});
+    vector<uint32_t> rowids;
+    for (auto& [rssid, rows] : segment_rows) {
+        auto itr = rowsets.upper_bound(rssid);
+        if (itr == rowsets.begin()) {
+            return Status::InternalError(Substitute("read_rows_by_positions rowset of segment:$0 not found", rssid));
+        }
+        --itr;
+        RowsetReleaseGuard guard(itr->second);
+        auto beta_rowset = down_cast<BetaRowset*>(itr->second.get());
+        RETURN_IF_ERROR(beta_rowset->load());
+        uint32_t segment_id = rssid - itr->first;
+        if (segment_id >= beta_rowset->segments().size()) {
+            return Status::InternalError(Substitute("read_rows_by_positions segment:$0 not found", rssid));
+        }
+        std::sort(rows.begin(), rows.end());
+        rowids.clear();
+        for (uint32_t j = 0; j < rows.size(); j++) {
+            rowids.push_back(rows[j].first);
+            key_rows[rows[j].second] = {segment_chunks.size(), j};
+        }
+        auto segment = beta_rowset->segments()[segment_id].get();
+        auto segment_chunk = vectorized::ChunkHelper::new_chunk(schema, rowids.size());
+        RETURN_IF_ERROR(read_segment_rows(segment, rowids, schema, stats, segment_chunk.get()));
+        segment_chunks.emplace_back(std::move(segment_chunk));
+    }
+    found->clear();
+    for (uint32_t i = 0; i < key_rows.size(); i++) {
+        if (key_rows[i].first != UINT32_MAX) {
+            chunk->append(*segment_chunks[key_rows[i].first], key_rows[i].second, 1);
+            found->push_back(i);
+        }
+    }
+    return Status::OK();
+}
+
+Status TabletUpdates::get_rows_by_keys(int64_t version, const vectorized::Chunk& keys, const vectorized::Schema& schema,
+                                       vectorized::Chunk* chunk, std::vector<uint32_t>* found) {
+    if (_error) {
+        return Status::InternalError(
+                Substitute("tablet updates in error state, get_rows_by_keys failed, tablet:$0", _tablet.tablet_id()));
+    }
+    RETURN_IF_ERROR(_wait_for_version(EditVersion(version, 0), 60000));
+
+    // 1. encode the keys
+    const TabletSchema& tablet_schema = _tablet.tablet_schema();
+    vector<ColumnId> pk_columns(tablet_schema.num_key_columns());
+    for (auto i = 0; i < tablet_schema.num_key_columns(); i++) {
+        pk_columns[i] = (ColumnId)i;
+    }
+    auto pkey_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema, pk_columns);
+    std::unique_ptr<vectorized::Column> pk_column;
+    const vectorized::Column* pkc = nullptr;
+    if (pk_columns.size() > 1) {
+        RETURN_IF_ERROR(PrimaryKeyEncoder::create_column(pkey_schema, &pk_column));
+        PrimaryKeyEncoder::encode(pkey_schema, keys, 0, keys.num_rows(), pk_column.get());
+        pkc = pk_column.get();
+    } else {
+        pkc = keys.get_column_by_index(0).get();
+    }
+
+    // 2. look up the positions of the keys in the index of the latest applied version
+    vector<uint64_t> positions;
+    // rowsets of the version, by the rssid of their first segments
+    std::map<uint32_t, RowsetSharedPtr> rowsets;
+    {
+        std::shared_lock il(_index_lock);
+        {
+            std::lock_guard rl(_lock);
+            const auto& v = _versions[_apply_version_idx];
+            if (v->version.major() != version) {
+                return Status::NotSupported(Substitute("get_rows_by_keys version:$0 is not the latest applied:$1",
+                                                       version, v->version.to_string()));
+            }
+            std::lock_guard<std::mutex> lg(_rowsets_lock);
+            for (uint32_t rsid : v->rowsets) {
+                auto itr = _rowsets.find(rsid);
+                if (itr == _rowsets.end()) {
+                    return Status::NotFound(Substitute("get_rows_by_keys rowset not found: version:$0 rowset:$1",
+                                                       version, rsid));
+                }
+                rowsets.emplace(rsid, itr->second);
+            }
+        }
+        auto manager = StorageEngine::instance()->update_manager();
+        auto index_entry = manager->index_cache().get_or_create(_tablet.tablet_id());
+        index_entry->update_expire_time(MonotonicMillis() + manager->get_cache_expire_ms());
+        auto& index = index_entry->value();
+        auto st = index.load(&_tablet);
+        manager->index_cache().update_object_size(index_entry, index.memory_usage());
+        if (st.ok()) {
+            st = index.get(*pkc, &positions);
+        }
+        manager->index_cache().release(index_entry);
+        RETURN_IF_ERROR(st);
+    }
+
+    // 3. read the rows
+    OlapReaderStatistics stats;
+    return read_rows_by_positions(rowsets, positions, schema, &stats, chunk, found);
+}
+
+Status TabletUpdates::_fill_partial_rowset(uint32_t rowset_id, const RowsetSharedPtr& rowset,
+                                           const RowsetUpdateState& state, const PrimaryIndex& index,
+                                           RowsetSharedPtr* filled) {
+    const TabletSchema& tablet_schema = _tablet.tablet_schema();
+    std::vector<uint32_t> column_ids = rowset->rowset_meta()->partial_update_column_ids();
+    std::vector<ColumnId> missing_column_ids;
+    for (uint32_t cid = 0, i = 0; cid < tablet_schema.num_columns(); cid++) {
+        if (i < column_ids.size() && column_ids[i] == cid) {
+            i++;
+        } else {
+            missing_column_ids.push_back(cid);
+        }
+    }
+    auto full_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    auto missing_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema, missing_column_ids);
+
+    // rowsets of the latest applied version, by the rssid of their first segments
+    std::map<uint32_t, RowsetSharedPtr> rowsets;
+    {
+        std::lock_guard rl(_lock);
+        std::lock_guard<std::mutex> lg(_rowsets_lock);
+        for (uint32_t rsid : _versions[_apply_version_idx]->rowsets) {
+            auto itr = _rowsets.find(rsid);
+            if (itr == _rowsets.end()) {
+                return Status::NotFound(Substitute("_fill_partial_rowset rowset not found: $0", rsid));
+            }
+            rowsets.emplace(rsid, itr->second);
+        }
+    }
+
+    RowsetWriterContext context(kDataFormatV2, config::storage_format_version);
+    context.rowset_id = StorageEngine::instance()->next_rowset_id();
+    context.tablet_uid = _tablet.tablet_uid();
+    context.tablet_id = _tablet.tablet_id();
+    context.partition_id = _tablet.partition_id();
+    context.tablet_schema_hash = _tablet.schema_hash();
+    context.rowset_type = BETA_ROWSET;
+    context.rowset_path_prefix = _tablet.tablet_path();
+    context.tablet_schema = &tablet_schema;
+    context.rowset_state = COMMITTED;
+    context.segments_overlap = NONOVERLAPPING;
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    OLAPStatus olap_status = RowsetFactory::create_rowset_writer(context, &rowset_writer);
+    if (olap_status != OLAPStatus::OLAP_SUCCESS) {
+        return Status::InternalError(Substitute("_fill_partial_rowset create rowset writer failed: $0", olap_status));
+    }
+
+    // the missing columns are read as their default values from the segments, and then replaced by the old values
+    RowsetReleaseGuard guard(rowset);
+    OlapReaderStatistics stats;
+    auto beta_rowset = down_cast<BetaRowset*>(rowset.get());
+    auto res = beta_rowset->get_segment_iterators2(full_schema, nullptr, 0, &stats);
+    if (!res.ok()) {
+        return res.status();
+    }
+    auto& itrs = res.value();
+    auto batch = vectorized::ChunkHelper::new_chunk(full_schema, config::vector_chunk_size);
+    std::vector<uint64_t> positions;
+    std::vector<uint32_t> found;
+    for (size_t i = 0; i < itrs.size(); i++) {
+        auto chunk = vectorized::ChunkHelper::new_chunk(full_schema, beta_rowset->segments()[i]->num_rows());
+        if (itrs[i] != nullptr) {
+            while (true) {
+                batch->reset();
+                auto st = itrs[i]->get_next(batch.get());
+                if (st.is_end_of_file()) {
+                    break;
+                }
+                RETURN_IF_ERROR(st);
+                chunk->append(*batch);
+            }
+            itrs[i]->close();
+        }
+        if (chunk->num_rows() > 0 && !missing_column_ids.empty()) {
+            positions.clear();
+            RETURN_IF_ERROR(index.get(*state.upserts()[i], &positions));
+            auto old_chunk = vectorized::ChunkHelper::new_chunk(missing_schema, positions.size());
+            RETURN_IF_ERROR(
+                    read_rows_by_positions(rowsets, positions, missing_schema, &stats, old_chunk.get(), &found));
+            for (size_t j = 0; !found.empty() && j < missing_column_ids.size(); j++) {
+                auto& column = chunk->get_column_by_index(missing_column_ids[j]);
+                const auto& old_column = *old_chunk->get_column_by_index(j);
+                auto filled_column = column->clone_empty();
+                filled_column->reserve(column->size());
+                size_t next = 0;
+                for (uint32_t k = 0; k < found.size(); k++) {
+                    filled_column->append(*column, next, found[k] - next);
+                    filled_column->append(old_column, k, 1);
+                    next = found[k] + 1;
+                }
+                filled_column->append(*column, next, column->size() - next);
+                column = std::move(filled_column);
+            }
+        }
+        // one segment of the same rows for every segment, to keep the rssids and rowids
+        if (rowset_writer->flush_chunk(*chunk) != OLAP_SUCCESS) {
+            return Status::InternalError(Substitute("_fill_partial_rowset write segment $0 failed", rowset_id + i));
+        }
+    }
+    auto output = rowset_writer->build();
+    if (output == nullptr) {
+        return Status::InternalError("_fill_partial_rowset build rowset failed");
+    }
+    // the delete files are kept as they are
+    for (int i = 0; i < rowset->num_delete_files(); i++) {
+        auto src = BetaRowset::segment_del_file_path(rowset->rowset_path(), rowset->rowset_id(),
+                                                     rowset->num_segments() - 1);
+        auto dst = BetaRowset::segment_del_file_path(output->rowset_path(), output->rowset_id(),
+                                                     rowset->num_segments() - 1);
+        RETURN_IF_ERROR(Env::Default()->link_file(src, dst));
+    }
+
+    // the meta of the rowset with the files of the output
+    auto rowset_meta = std::make_shared<RowsetMeta>();
+    rowset_meta->init_from_pb(rowset->rowset_meta()->get_meta_pb());
+    rowset_meta->set_rowset_id(output->rowset_id());
+    rowset_meta->set_total_row_size(output->rowset_meta()->total_row_size());
+    rowset_meta->set_total_disk_size(output->rowset_meta()->total_disk_size());
+    rowset_meta->set_data_disk_size(output->rowset_meta()->data_disk_size());
+    rowset_meta->set_index_disk_size(output->rowset_meta()->index_disk_size());
+    rowset_meta->set_partial_update_column_ids({});
+    auto ost = RowsetFactory::create_rowset(_tablet._mem_tracker, &tablet_schema, _tablet.tablet_path(), rowset_meta,
+                                            filled);
+    if (ost != OLAP_SUCCESS) {
+        return Status::InternalError(Substitute("_fill_partial_rowset create rowset failed: $0", ost));
+    }
+    LOG(INFO) << "fill partial update tablet:" << _tablet.tablet_id() << " rowset:" << rowset_id << " "
+              << rowset->rowset_id() << " -> " << output->rowset_id() << " #column:" << column_ids.size() << "/"
+              << tablet_schema.num_columns() << " #row:" << rowset->num_rows();
+    return Status::OK();
+}
+
 struct RowsetLoadInfo {
     uint32_t rowset_id = 0;
     uint32_t num_segments = 0;
@@ -1810,11 +2132,15 @@ Status TabletUpdates::load_from_base_tablet(int64_t request_version, Tablet* bas
         LOG(WARNING) << "_load_from_pb failed tablet_id:" << tablet_id << " " << st;
         return st;
     }
-    auto index_entry = update_manager->index_cache().get_or_create(tablet_id);
-    index_entry->update_expire_time(MonotonicMillis() + update_manager->get_cache_expire_ms());
-    auto& index = index_entry->value();
-    index.unload();
-    update_manager->index_cache().release(index_entry);
+    {
+        std::unique_lock ul(_index_lock);
+        auto index_entry = update_manager->index_cache().get_or_create(tablet_id);
+        index_entry->update_expire_time(MonotonicMillis() + update_manager->get_cache_expire_ms());
+        auto& index = index_entry->value();
+        index.unload();
+        update_manager->index_cache().release(index_entry);
+        WARN_IF_ERROR(PersistentIndex::remove_files(_tablet.tablet_path()), "remove persistent primary index failed");
+    }
     _tablet.set_tablet_state(TabletState::TABLET_RUNNING);
     LOG(INFO) << "load_from_base_tablet finish tablet:" << _tablet.tablet_id() << " version:" << this->max_version()
               << " #pending:" << _pending_commits.size();
@@ -1986,6 +2312,7 @@ Status TabletUpdates::load_snapshot(const SnapshotMeta& snapshot_meta) {
         TabletMetaPB new_tablet_meta_pb;
         _tablet.tablet_meta()->to_meta_pb(&new_tablet_meta_pb);
 
+        std::unique_lock l0(_index_lock);
         std::unique_lock l1(_lock);
         std::unique_lock l2(_rowsets_lock);
         std::unique_lock l3(_rowset_stats_lock);
@@ -2077,6 +2404,7 @@ Status TabletUpdates::load_snapshot(const SnapshotMeta& snapshot_meta) {
         index_entry->update_expire_time(MonotonicMillis() + manager->get_cache_expire_ms());
         index_entry->value().unload();
         index_cache.release(index_entry);
+        WARN_IF_ERROR(PersistentIndex::remove_files(_tablet.tablet_path()), "remove persistent primary index failed");
 
         _apply_version_changed.notify_all();
         return Status::OK();
@@ -2098,6 +2426,7 @@ void TabletUpdates::_clear_rowset_del_vec_cache(const Rowset& rowset) {
 }
 
 Status TabletUpdates::clear_meta() {
+    std::lock_guard l0(_index_lock);
     std::lock_guard l1(_lock);
     std::lock_guard l2(_rowsets_lock);
     std::lock_guard l3(_rowset_stats_lock);
@@ -2126,6 +2455,7 @@ Status TabletUpdates::clear_meta() {
     }
     // Clear cached primary index.
     StorageEngine::instance()->update_manager()->index_cache().remove_by_key(_tablet.tablet_id());
+    WARN_IF_ERROR(PersistentIndex::remove_files(_tablet.tablet_path()), "remove persistent primary index failed");
     STLClearObject(&_rowsets);
     STLClearObject(&_rowset_stats);
     STLClearObject(&_versions);
@@ -17,6 +17,7 @@ namespace starrocks {
 
 class PrimaryIndex;
 class Rowset;
+class RowsetUpdateState;
 using RowsetSharedPtr = std::shared_ptr<Rowset>;
 class DelVector;
 using DelVectorPtr = std::shared_ptr<DelVector>;
@@ -26,6 +27,7 @@ class Tablet;
 class TTabletInfo;
 
 namespace vectorized {
+class Chunk;
 class ChunkIterator;
 class CompactionState;
 class RowsetReadOptions;
@@ -149,6 +151,14 @@ public:
     Status get_applied_rowsets(int64_t version, std::vector<RowsetSharedPtr>* rowsets,
                                EditVersion* full_version = nullptr);
 
+    // Look up the rows of the primary keys |keys|, whose columns are the key columns of the tablet, at |version| by
+    // the primary index, and append the columns of |schema| of the rows found into |chunk| in the order of |keys|,
+    // without scanning the segments. The indexes of the keys found are saved into |found|.
+    // Return NotSupported if |version| is not the latest applied version, the only one the index tracks, in which
+    // case the rows should be read by a scan.
+    Status get_rows_by_keys(int64_t version, const vectorized::Chunk& keys, const vectorized::Schema& schema,
+                            vectorized::Chunk* chunk, std::vector<uint32_t>* found);
+
     void to_updates_pb(TabletUpdatesPB* updates_pb) const;
 
     // Used for schema change, migrate another tablet's version&rowsets to this tablet
@@ -195,7 +205,7 @@ private:
 
     // used for PrimaryIndex load
     Status _get_apply_version_and_rowsets(int64_t* version, std::vector<RowsetSharedPtr>* rowsets,
-                                          std::vector<uint32_t>* rowset_ids);
+                                          std::vector<uint32_t>* rowset_ids, EditVersion* full_version = nullptr);
 
     void _redo_edit_version_log(const EditVersionMetaPB& v);
 
@@ -213,6 +223,12 @@ private:
 
     void _apply_rowset_commit(const EditVersionInfo& version_info);
 
+    // Write the rows of the partial update |rowset| into the segments of a new rowset |*filled|, of the same rssid
+    // and rowids, with the columns it lacks read from the old rows of its keys, located by |index| before it is
+    // applied, or the default values of them for the new keys.
+    Status _fill_partial_rowset(uint32_t rowset_id, const RowsetSharedPtr& rowset, const RowsetUpdateState& state,
+                                const PrimaryIndex& index, RowsetSharedPtr* filled);
+
     void _apply_compaction_commit(const EditVersionInfo& version_info);
 
     RowsetSharedPtr _get_rowset(uint32_t rowset_id);
@@ -281,6 +297,10 @@ private:
     mutable std::mutex _rowsets_lock;
     std::unordered_map<uint32_t, RowsetSharedPtr> _rowsets;
 
+    // Held exclusively while the primary index is being changed, by the applies and the loads of the tablet, and
+    // shared by the lookups, so that they see the index of the latest applied version. Acquired before |_lock|.
+    std::shared_mutex _index_lock;
+
     // used for async apply, make sure at most 1 thread is doing applying
     mutable std::mutex _apply_running_lock;
     // apply process is running currently
@@ -21,12 +21,60 @@
 
 #include "storage/task/engine_checksum_task.h"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "column/chunk.h"
+#include "column/column.h"
+#include "common/config.h"
 #include "storage/reader.h"
 #include "storage/row.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/reader.h"
+#include "storage/vectorized/reader_params.h"
+#include "storage/vectorized/rowid_range_option.h"
 #include "util/defer_op.h"
 
 namespace starrocks {
 
+// XORs the hashes of the rows of |tablet| at |version| in |range|, or in the whole tablet if |range| is null, into
+// |checksum|.
+static Status checksum_rows(const TabletSharedPtr& tablet, int64_t version, const vectorized::Schema& schema,
+                            const vectorized::RowidRangeOptionPtr& range, uint32_t* checksum) {
+    vectorized::Reader reader(schema);
+    vectorized::ReaderParams params;
+    params.tablet = tablet;
+    params.reader_type = READER_CHECKSUM;
+    params.version = Version(0, version);
+    params.rowid_range_option = range;
+    params.chunk_size = config::vector_chunk_size;
+    Status st = reader.init(params);
+    if (st.is_end_of_file()) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(st);
+
+    auto chunk = vectorized::ChunkHelper::new_chunk(schema, params.chunk_size);
+    std::vector<uint32_t> hashes;
+    while (true) {
+        chunk->reset();
+        st = reader.get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(st);
+        const size_t num_rows = chunk->num_rows();
+        hashes.assign(num_rows, 0);
+        for (const auto& column : chunk->columns()) {
+            column->crc32_hash(hashes.data(), 0, num_rows);
+        }
+        for (uint32_t hash : hashes) {
+            *checksum ^= hash;
+        }
+    }
+}
+
 EngineChecksumTask::EngineChecksumTask(TTabletId tablet_id, TSchemaHash schema_hash, TVersion version,
                                        TVersionHash version_hash, uint32_t* checksum)
         : _tablet_id(tablet_id),
@@ -62,6 +110,20 @@ OLAPStatus EngineChecksumTask::_compute_checksum() {
         return OLAP_SUCCESS;
     }
 
+    if (config::enable_vectorized_checksum) {
+        uint32_t checksum = 0;
+        Status st = _compute_checksum_vectorized(tablet, &checksum);
+        if (st.ok()) {
+            LOG(INFO) << "success to finish compute checksum. checksum=" << checksum;
+            *_checksum = checksum;
+            return OLAP_SUCCESS;
+        }
+        if (!st.is_not_supported()) {
+            LOG(WARNING) << "fail to compute checksum. tablet=" << tablet->full_name() << ", err=" << st;
+            return OLAP_ERR_CHECKSUM_ERROR;
+        }
+    }
+
     Reader reader;
     ReaderParams reader_params;
     reader_params.tablet = tablet;
@@ -133,4 +195,74 @@ OLAPStatus EngineChecksumTask::_compute_checksum() {
     return OLAP_SUCCESS;
 }
 
+// Like the rows read by the row reader, the rows are merged and aggregated, and the deleted ones are filtered out,
+// so the checksum is the XOR of the hashes of the same rows whatever the rowsets and the segments they are in. The
+// rows of the duplicate keys tablets needn't be merged, so those are read by the rowid ranges of no more than
+// checksum_split_rows rows of the segments, by up to checksum_threads threads.
+//
+// The hashes differ from those of the row reader, so enable_vectorized_checksum must be the same on all the BEs,
+// or the replicas would be reported inconsistent.
+Status EngineChecksumTask::_compute_checksum_vectorized(const TabletSharedPtr& tablet, uint32_t* checksum) {
+    {
+        std::shared_lock rdlock(tablet->get_header_lock());
+        std::vector<RowsetSharedPtr> rowsets;
+        if (tablet->capture_consistent_rowsets(Version(0, _version), &rowsets) != OLAP_SUCCESS) {
+            return Status::InternalError("capture consistent rowsets failed");
+        }
+        for (const auto& rowset : rowsets) {
+            if (rowset->rowset_type() != BETA_ROWSET) {
+                return Status::NotSupported("alpha rowset");
+            }
+        }
+    }
+
+    const TabletSchema& tablet_schema = tablet->tablet_schema();
+    std::vector<ColumnId> cids;
+    for (ColumnId cid = 0; cid < tablet_schema.num_columns(); cid++) {
+        // The float and the double columns are ignored, as by hash_row.
+        FieldType type = tablet_schema.column(cid).type();
+        if (type != OLAP_FIELD_TYPE_FLOAT && type != OLAP_FIELD_TYPE_DOUBLE) {
+            cids.push_back(cid);
+        }
+    }
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema, cids);
+
+    std::vector<vectorized::RowidRangeOptionPtr> ranges;
+    if (!vectorized::split_tablet_by_rowid_ranges(tablet, _version, false, config::checksum_split_rows, &ranges)
+                 .ok()) {
+        ranges.assign(1, nullptr);
+    }
+
+    std::atomic<size_t> next_range{0};
+    std::atomic<uint32_t> result{0};
+    std::mutex mutex;
+    Status status;
+    auto run = [&]() {
+        for (size_t i = next_range++; i < ranges.size(); i = next_range++) {
+            uint32_t range_checksum = 0;
+            Status st = checksum_rows(tablet, _version, schema, ranges[i], &range_checksum);
+            if (!st.ok()) {
+                std::lock_guard l(mutex);
+                status = st;
+                // Let the other threads stop at their next range.
+                next_range = ranges.size();
+                return;
+            }
+            result.fetch_xor(range_checksum);
+        }
+    };
+    std::vector<std::thread> threads;
+    const size_t num_threads = std::min<size_t>(std::max(config::checksum_threads, 1), ranges.size());
+    for (size_t t = 1; t < num_threads; t++) {
+        threads.emplace_back(run);
+    }
+    run();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    RETURN_IF_ERROR(status);
+    *checksum = result;
+    return Status::OK();
+}
+
 } // namespace starrocks
@@ -23,7 +23,9 @@
 #define STARROCKS_BE_SRC_OLAP_TASK_ENGINE_CHECKSUM_TASK_H
 
 #include "gen_cpp/AgentService_types.h"
+#include "common/status.h"
 #include "storage/olap_define.h"
+#include "storage/tablet.h"
 #include "storage/task/engine_task.h"
 
 namespace starrocks {
@@ -43,6 +45,9 @@ public:
 private:
     OLAPStatus _compute_checksum();
 
+    // Computes the checksum of |tablet| through the vectorized reader, NotSupported if it has any alpha rowset.
+    Status _compute_checksum_vectorized(const TabletSharedPtr& tablet, uint32_t* checksum);
+
 private:
     TTabletId _tablet_id;
     TSchemaHash _schema_hash;
@@ -21,8 +21,10 @@
 
 #include "storage/task/engine_clone_task.h"
 
+#include <atomic>
 #include <filesystem>
 #include <set>
+#include <thread>
 
 #include "env/env.h"
 #include "gen_cpp/BackendService.h"
@@ -360,65 +362,126 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
         }
     }
 
-    // Get copy from remote
-    uint64_t total_file_size = 0;
+    // Get copy from remote, the files but the header file by up to config::clone_download_threads threads at a time,
+    // and then the header file.
+    std::atomic<uint64_t> total_file_size{0};
     MonotonicStopWatch watch;
     watch.start();
-    for (auto& file_name : file_name_list) {
-        auto remote_file_url = remote_url_prefix + file_name;
-
-        // get file length
-        uint64_t file_size = 0;
-        auto get_file_size_cb = [&remote_file_url, &file_size](HttpClient* client) {
-            RETURN_IF_ERROR(client->init(remote_file_url));
-            client->set_timeout_ms(GET_LENGTH_TIMEOUT * 1000);
-            RETURN_IF_ERROR(client->head());
-            file_size = client->get_content_length();
-            return Status::OK();
-        };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, get_file_size_cb));
-        // check disk capacity
-        if (data_dir->reach_capacity_limit(file_size)) {
-            return Status::InternalError("Disk reach capacity limit");
+    size_t num_files = file_name_list.size();
+    if (num_files > 0 && StringPiece(file_name_list.back()).ends_with(".hdr")) {
+        num_files--;
+    }
+    std::atomic<size_t> next_file{0};
+    std::atomic<bool> failed{false};
+    auto download = [&]() -> Status {
+        while (!failed.load()) {
+            size_t i = next_file.fetch_add(1);
+            if (i >= num_files) {
+                break;
+            }
+            Status st = _download_file(data_dir, remote_url_prefix, local_path, file_name_list[i], &total_file_size);
+            if (!st.ok()) {
+                failed.store(true);
+                return st;
+            }
         }
+        return Status::OK();
+    };
+    size_t num_threads = std::min<size_t>(std::max(1, config::clone_download_threads), num_files);
+    std::vector<Status> results(num_threads);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back([&results, &download, i] { results[i] = download(); });
+    }
+    if (num_threads > 0) {
+        results[0] = download();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const Status& st : results) {
+        RETURN_IF_ERROR(st);
+    }
+    for (size_t i = num_files; i < file_name_list.size(); ++i) {
+        RETURN_IF_ERROR(_download_file(data_dir, remote_url_prefix, local_path, file_name_list[i], &total_file_size));
+    }
 
-        total_file_size += file_size;
-        uint64_t estimate_timeout = file_size / config::download_low_speed_limit_kbps / 1024;
-        if (estimate_timeout < config::download_low_speed_time) {
-            estimate_timeout = config::download_low_speed_time;
-        }
+    uint64_t total_time_ms = watch.elapsed_time() / 1000 / 1000;
+    total_time_ms = total_time_ms > 0 ? total_time_ms : 0;
+    double copy_rate = 0.0;
+    if (total_time_ms > 0) {
+        copy_rate = total_file_size.load() / ((double)total_time_ms) / 1000;
+    }
+    LOG(INFO) << "Copied tablet " << _signature << ". bytes=" << total_file_size.load() << " cost=" << total_time_ms
+              << " ms rate=" << copy_rate << " MB/s";
+    return Status::OK();
+}
 
-        std::string local_file_path = local_path + file_name;
+Status EngineCloneTask::_download_file(DataDir* data_dir, const std::string& remote_url_prefix,
+                                       const std::string& local_path, const std::string& file_name,
+                                       std::atomic<uint64_t>* total_file_size) {
+    auto remote_file_url = remote_url_prefix + file_name;
+
+    // get file length
+    uint64_t file_size = 0;
+    auto get_file_size_cb = [&remote_file_url, &file_size](HttpClient* client) {
+        RETURN_IF_ERROR(client->init(remote_file_url));
+        client->set_timeout_ms(GET_LENGTH_TIMEOUT * 1000);
+        RETURN_IF_ERROR(client->head());
+        file_size = client->get_content_length();
+        return Status::OK();
+    };
+    RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, get_file_size_cb));
+    // check disk capacity
+    if (data_dir->reach_capacity_limit(file_size)) {
+        return Status::InternalError("Disk reach capacity limit");
+    }
 
-        LOG(INFO) << "Downloading " << remote_file_url << " to " << local_file_path << ". bytes=" << file_size
-                  << " timeout=" << estimate_timeout;
+    *total_file_size += file_size;
+    uint64_t estimate_timeout = file_size / config::download_low_speed_limit_kbps / 1024;
+    if (estimate_timeout < config::download_low_speed_time) {
+        estimate_timeout = config::download_low_speed_time;
+    }
 
-        auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path, file_size](HttpClient* client) {
-            RETURN_IF_ERROR(client->init(remote_file_url));
-            client->set_timeout_ms(estimate_timeout * 1000);
-            RETURN_IF_ERROR(client->download(local_file_path));
+    std::string local_file_path = local_path + file_name;
 
-            // Check file length
-            uint64_t local_file_size = std::filesystem::file_size(local_file_path);
-            if (local_file_size != file_size) {
-                LOG(WARNING) << "Fail to download " << remote_file_url << ". file_size=" << local_file_size << "/"
-                             << file_size;
-                return Status::InternalError("mismatched file size");
-            }
-            chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
-            return Status::OK();
-        };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb));
-    } // Clone files from remote backend
+    LOG(INFO) << "Downloading " << remote_file_url << " to " << local_file_path << ". bytes=" << file_size
+              << " timeout=" << estimate_timeout;
 
-    uint64_t total_time_ms = watch.elapsed_time() / 1000 / 1000;
-    total_time_ms = total_time_ms > 0 ? total_time_ms : 0;
-    double copy_rate = 0.0;
-    if (total_time_ms > 0) {
-        copy_rate = total_file_size / ((double)total_time_ms) / 1000;
+    auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path, file_size](HttpClient* client) {
+        RETURN_IF_ERROR(client->init(remote_file_url));
+        client->set_timeout_ms(estimate_timeout * 1000);
+        RETURN_IF_ERROR(client->download(local_file_path));
+
+        // Check file length
+        uint64_t local_file_size = std::filesystem::file_size(local_file_path);
+        if (local_file_size != file_size) {
+            LOG(WARNING) << "Fail to download " << remote_file_url << ". file_size=" << local_file_size << "/"
+                         << file_size;
+            return Status::InternalError("mismatched file size");
+        }
+        chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
+        return Status::OK();
+    };
+    RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb));
+
+    if (config::clone_verify_checksum) {
+        // The source backend replies the md5sum of a file instead of its content with the parameter checksum=md5.
+        std::string remote_md5sum;
+        auto checksum_cb = [&remote_file_url, &remote_md5sum](HttpClient* client) {
+            RETURN_IF_ERROR(client->init(remote_file_url + "&checksum=md5"));
+            client->set_timeout_ms(GET_LENGTH_TIMEOUT * 1000);
+            return client->execute(&remote_md5sum);
+        };
+        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, checksum_cb));
+        std::string local_md5sum;
+        RETURN_IF_ERROR(FileUtils::md5sum(local_file_path, &local_md5sum));
+        if (local_md5sum != remote_md5sum) {
+            LOG(WARNING) << "Fail to download " << remote_file_url << ". md5sum=" << local_md5sum << "/"
+                         << remote_md5sum;
+            return Status::InternalError("mismatched file checksum");
+        }
     }
-    LOG(INFO) << "Copied tablet " << _signature << ". bytes=" << total_file_size << " cost=" << total_time_ms << " ms"
-              << " rate=" << copy_rate << " MB/s";
     return Status::OK();
 }
 
@@ -22,6 +22,8 @@
 #ifndef STARROCKS_BE_SRC_OLAP_TASK_ENGINE_CLONE_TASK_H
 #define STARROCKS_BE_SRC_OLAP_TASK_ENGINE_CLONE_TASK_H
 
+#include <atomic>
+
 #include "agent/utils.h"
 #include "gen_cpp/AgentService_types.h"
 #include "gen_cpp/HeartbeatService.h"
@@ -61,6 +63,10 @@ private:
     // Download tablet files from
     Status _download_files(DataDir* data_dir, const std::string& remote_url_prefix, const std::string& local_path);
 
+    // Download the file |file_name| under |remote_url_prefix| into |local_path|, and add its size to |total_file_size|.
+    Status _download_file(DataDir* data_dir, const std::string& remote_url_prefix, const std::string& local_path,
+                          const std::string& file_name, std::atomic<uint64_t>* total_file_size);
+
     Status _make_snapshot(const std::string& ip, int port, TTableId tablet_id, TSchemaHash schema_hash, int timeout_s,
                           const std::vector<Version>* missed_versions, std::string* snapshot_path,
                           int32_t* snapshot_version);
@@ -60,8 +60,10 @@ OLAPStatus EnginePublishVersionTask::finish() {
         VersionHash version_hash = par_ver_info.version_hash;
 
         // each tablet
+        std::vector<TabletInfo> tablet_infos;
+        std::vector<TabletSharedPtr> tablets;
+        std::vector<RowsetSharedPtr> rowsets;
         for (auto& tablet_rs : tablet_related_rs) {
-            OLAPStatus publish_status = OLAP_SUCCESS;
             const TabletInfo& tablet_info = tablet_rs.first;
             const RowsetSharedPtr& rowset = tablet_rs.second;
             VLOG(1) << "begin to publish version on tablet. "
@@ -87,20 +89,24 @@ OLAPStatus EnginePublishVersionTask::finish() {
                 res = OLAP_ERR_PUSH_TABLE_NOT_EXIST;
                 continue;
             }
+            tablet_infos.push_back(tablet_info);
+            tablets.emplace_back(std::move(tablet));
+            rowsets.push_back(rowset);
+        }
 
-            if (tablet->keys_type() == KeysType::PRIMARY_KEYS) {
-                VLOG(1) << "UpdateManager::on_rowset_published tablet:" << tablet->tablet_id()
-                        << " rowset: " << rowset->rowset_id().to_string() << " version: " << version.second;
-                publish_status = StorageEngine::instance()->txn_manager()->publish_txn2(transaction_id, partition_id,
-                                                                                        tablet, version.second);
-            } else {
-                publish_status = StorageEngine::instance()->txn_manager()->publish_txn(
-                        partition_id, tablet, transaction_id, version, version_hash);
-            }
+        // The rowsets of the updatable tablets are applied by the apply threads of the UpdateManager in the
+        // background, the publish doesn't wait for them.
+        std::vector<OLAPStatus> publish_statuses;
+        StorageEngine::instance()->txn_manager()->publish_txns(transaction_id, partition_id, tablets, version,
+                                                              version_hash, &publish_statuses);
+        for (size_t i = 0; i < tablets.size(); i++) {
+            const TabletSharedPtr& tablet = tablets[i];
+            const RowsetSharedPtr& rowset = rowsets[i];
+            OLAPStatus publish_status = publish_statuses[i];
             if (publish_status != OLAP_SUCCESS) {
                 LOG(WARNING) << "failed to publish version. rowset_id=" << rowset->rowset_id()
-                             << ", tablet_id=" << tablet_info.tablet_id << ", txn_id=" << transaction_id;
-                _error_tablet_ids->push_back(tablet_info.tablet_id);
+                             << ", tablet_id=" << tablet->tablet_id() << ", txn_id=" << transaction_id;
+                _error_tablet_ids->push_back(tablet->tablet_id());
                 res = publish_status;
                 continue;
             }
@@ -110,14 +116,14 @@ OLAPStatus EnginePublishVersionTask::finish() {
                 publish_status = tablet->add_inc_rowset(rowset);
                 if (publish_status != OLAP_SUCCESS && publish_status != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
                     LOG(WARNING) << "fail to add visible rowset to tablet. rowset_id=" << rowset->rowset_id()
-                                 << ", tablet_id=" << tablet_info.tablet_id << ", txn_id=" << transaction_id
+                                 << ", tablet_id=" << tablet->tablet_id() << ", txn_id=" << transaction_id
                                  << ", res=" << publish_status;
-                    _error_tablet_ids->push_back(tablet_info.tablet_id);
+                    _error_tablet_ids->push_back(tablet->tablet_id());
                     res = publish_status;
                     continue;
                 }
             }
-            partition_related_tablet_infos.erase(tablet_info);
+            partition_related_tablet_infos.erase(tablet_infos[i]);
             VLOG(1) << "publish version successfully on tablet. tablet=" << tablet->full_name()
                     << ", transaction_id=" << transaction_id << ", version=" << version.first
                     << ", res=" << publish_status;
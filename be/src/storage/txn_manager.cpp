@@ -24,12 +24,15 @@
 #include <thrift/protocol/TDebugProtocol.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
+#include <functional>
 #include <new>
 #include <queue>
 #include <random>
 #include <set>
 
+#include "rocksdb/write_batch.h"
 #include "storage/data_dir.h"
 #include "storage/push_handler.h"
 #include "storage/reader.h"
@@ -289,6 +292,118 @@ OLAPStatus TxnManager::publish_txn(OlapMeta* meta, TPartitionId partition_id, TT
     }
 }
 
+void TxnManager::publish_txns(TTransactionId transaction_id, TPartitionId partition_id,
+                              const std::vector<TabletSharedPtr>& tablets, const Version& version,
+                              VersionHash version_hash, std::vector<OLAPStatus>* statuses) {
+    pair<int64_t, int64_t> key(partition_id, transaction_id);
+    statuses->assign(tablets.size(), OLAP_SUCCESS);
+    std::vector<RowsetSharedPtr> rowsets(tablets.size());
+    std::lock_guard txn_lock(_get_txn_lock(transaction_id));
+    {
+        std::shared_lock rlock(_get_txn_map_lock(transaction_id));
+        txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
+        auto it = txn_tablet_map.find(key);
+        for (size_t i = 0; i < tablets.size(); i++) {
+            if (it != txn_tablet_map.end()) {
+                auto load_itr = it->second.find(
+                        TabletInfo(tablets[i]->tablet_id(), tablets[i]->schema_hash(), tablets[i]->tablet_uid()));
+                if (load_itr != it->second.end()) {
+                    rowsets[i] = load_itr->second.rowset;
+                }
+            }
+            if (rowsets[i] == nullptr) {
+                (*statuses)[i] = OLAP_ERR_TRANSACTION_NOT_EXIST;
+            }
+        }
+    }
+
+    // save meta need access disk, it maybe very slow, so that it is not in global txn lock
+    // it is under a single txn lock
+    std::map<DataDir*, std::vector<size_t>> dir_tablets;
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i < tablets.size(); i++) {
+        if (rowsets[i] == nullptr) {
+            continue;
+        }
+        if (tablets[i]->keys_type() != KeysType::PRIMARY_KEYS) {
+            dir_tablets[tablets[i]->data_dir()].push_back(i);
+            continue;
+        }
+        tasks.emplace_back([&, i]() {
+            StarRocksMetrics::instance()->update_rowset_commit_request_total.increment(1);
+            auto st = tablets[i]->rowset_commit(version.second, rowsets[i]);
+            if (!st.ok()) {
+                StarRocksMetrics::instance()->update_rowset_commit_request_failed.increment(1);
+                (*statuses)[i] = OLAP_ERR_IO_ERROR;
+            }
+        });
+    }
+    for (const auto& it : dir_tablets) {
+        DataDir* data_dir = it.first;
+        const std::vector<size_t>* indexes = &it.second;
+        tasks.emplace_back([&, data_dir, indexes]() {
+            rocksdb::WriteBatch batch;
+            rocksdb::ColumnFamilyHandle* cf = data_dir->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
+            for (size_t i : *indexes) {
+                // TODO(ygl): rowset is already set version here, memory is changed, if save failed
+                // it maybe a fatal error
+                rowsets[i]->make_visible(version, version_hash);
+                std::string value;
+                if (!rowsets[i]->rowset_meta()->get_meta_pb().SerializeToString(&value)) {
+                    (*statuses)[i] = OLAP_ERR_ROWSET_SAVE_FAILED;
+                    continue;
+                }
+                batch.Put(cf, RowsetMetaManager::get_rowset_meta_key(tablets[i]->tablet_uid(), rowsets[i]->rowset_id()),
+                          value);
+            }
+            Status st = data_dir->get_meta()->write_batch(&batch);
+            if (!st.ok()) {
+                LOG(WARNING) << "save committed rowsets failed. when publish txn, data dir: " << data_dir->path()
+                             << ", txn id:" << transaction_id << ", rowsets: " << indexes->size() << ", " << st;
+                for (size_t i : *indexes) {
+                    (*statuses)[i] = OLAP_ERR_ROWSET_SAVE_FAILED;
+                }
+            }
+        });
+    }
+    std::atomic<size_t> next_task{0};
+    auto run = [&]() {
+        for (size_t t = next_task++; t < tasks.size(); t = next_task++) {
+            tasks[t]();
+        }
+    };
+    std::vector<std::thread> threads;
+    const size_t num_threads = std::min<size_t>(std::max(config::publish_version_threads, 1), tasks.size());
+    for (size_t t = 1; t < num_threads; t++) {
+        threads.emplace_back(run);
+    }
+    run();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    {
+        std::unique_lock wrlock(_get_txn_map_lock(transaction_id));
+        txn_tablet_map_t& txn_tablet_map = _get_txn_tablet_map(transaction_id);
+        auto it = txn_tablet_map.find(key);
+        size_t num_published = 0;
+        for (size_t i = 0; i < tablets.size() && it != txn_tablet_map.end(); i++) {
+            if ((*statuses)[i] == OLAP_SUCCESS) {
+                const TabletSharedPtr& tablet = tablets[i];
+                it->second.erase(TabletInfo(tablet->tablet_id(), tablet->schema_hash(), tablet->tablet_uid()));
+                num_published++;
+            }
+        }
+        LOG(INFO) << "publish txn successfully."
+                  << " partition_id: " << key.first << ", txn_id: " << key.second << ", tablets: " << num_published
+                  << "/" << tablets.size() << ", version: " << version.first << "," << version.second;
+        if (it != txn_tablet_map.end() && it->second.empty()) {
+            txn_tablet_map.erase(it);
+            _clear_txn_partition_map_unlocked(transaction_id, partition_id);
+        }
+    }
+}
+
 OLAPStatus TxnManager::publish_txn2(TTransactionId transaction_id, TPartitionId partition_id,
                                     const TabletSharedPtr& tablet, int64_t version) {
     pair<int64_t, int64_t> key(partition_id, transaction_id);
@@ -89,6 +89,14 @@ public:
     OLAPStatus publish_txn2(TTransactionId transaction_id, TPartitionId partition_id, const TabletSharedPtr& tablet,
                             int64_t version);
 
+    // Publish the txn on all the |tablets| of the partition at once, taking the txn lock once: the rowset metas of the
+    // tablets other than the updatable ones are saved in one write batch per data dir, and the data dirs and the
+    // updatable tablets are handled by up to publish_version_threads threads. (*statuses)[i] is set to the result of
+    // |tablets[i]|.
+    void publish_txns(TTransactionId transaction_id, TPartitionId partition_id,
+                      const std::vector<TabletSharedPtr>& tablets, const Version& version, VersionHash version_hash,
+                      std::vector<OLAPStatus>* statuses);
+
     // delete the txn from manager if it is not committed(not have a valid rowset)
     OLAPStatus rollback_txn(TPartitionId partition_id, const TabletSharedPtr& tablet, TTransactionId transaction_id);
 
@@ -2,8 +2,10 @@
 
 #include "storage/update_manager.h"
 
+#include <algorithm>
 #include <limits>
 
+#include "common/config.h"
 #include "gutil/endian.h"
 #include "storage/del_vector.h"
 #include "storage/olap_meta.h"
@@ -48,6 +50,12 @@ UpdateManager::~UpdateManager() {
 
 Status UpdateManager::init() {
     auto st = ThreadPoolBuilder("UpdateApplyThreadPool").build(&_apply_thread_pool);
+    if (st.ok() && config::update_apply_index_thread_num > 0) {
+        // a separate pool, the apply threads wait for the shards upserted by it
+        st = ThreadPoolBuilder("UpdateApplyIndexThreadPool")
+                     .set_max_threads(config::update_apply_index_thread_num)
+                     .build(&_apply_index_thread_pool);
+    }
     return st;
 }
 
@@ -61,35 +69,62 @@ Status UpdateManager::set_del_vec_in_meta(OlapMeta* meta, const TabletSegmentId&
     return TabletMetaManager::set_del_vector(meta, tsid.tablet_id, tsid.segment_id, delvec);
 }
 
+DelVectorPtr UpdateManager::_get_cached_del_vec_unlocked(DelVecCacheShard& shard, const TabletSegmentId& tsid) {
+    auto itr = shard.map.find(tsid);
+    if (itr == shard.map.end()) {
+        return nullptr;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, itr->second);
+    return itr->second->second;
+}
+
+void UpdateManager::_put_cached_del_vec_unlocked(DelVecCacheShard& shard, const TabletSegmentId& tsid,
+                                                 DelVectorPtr delvec) {
+    auto itr = shard.map.find(tsid);
+    if (itr != shard.map.end()) {
+        _erase_cached_del_vec_unlocked(shard, itr->second);
+    }
+    shard.memory_usage += delvec->memory_usage();
+    _del_vec_cache_mem_tracker->consume(delvec->memory_usage());
+    shard.lru.emplace_front(tsid, std::move(delvec));
+    shard.map.emplace(tsid, shard.lru.begin());
+    // the latest one is kept even if it is beyond the capacity alone
+    const size_t capacity = std::max<int64_t>(0, config::update_del_vector_cache_capacity) / kDelVecCacheShards;
+    while (shard.memory_usage > capacity && shard.lru.size() > 1) {
+        _erase_cached_del_vec_unlocked(shard, std::prev(shard.lru.end()));
+    }
+}
+
+void UpdateManager::_erase_cached_del_vec_unlocked(DelVecCacheShard& shard, DelVecLRUList::iterator itr) {
+    shard.memory_usage -= itr->second->memory_usage();
+    _del_vec_cache_mem_tracker->release(itr->second->memory_usage());
+    shard.map.erase(itr->first);
+    shard.lru.erase(itr);
+}
+
 Status UpdateManager::get_del_vec(OlapMeta* meta, const TabletSegmentId& tsid, int64_t version, DelVectorPtr* pdelvec) {
+    auto& shard = _del_vec_cache_shard(tsid);
     {
-        std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-        auto itr = _del_vec_cache.find(tsid);
-        if (itr != _del_vec_cache.end()) {
-            if (version >= itr->second->version()) {
-                VLOG(3) << strings::Substitute("get_del_vec cached tablet_segment=$0 version=$1 actual_version=$2",
-                                               tsid.to_string(), version, itr->second->version());
-                // cache valid
-                // TODO(cbl): add cache hit stats
-                *pdelvec = itr->second;
-                return Status::OK();
-            }
+        std::lock_guard<ProfiledMutex> lg(shard.lock);
+        auto cached = _get_cached_del_vec_unlocked(shard, tsid);
+        if (cached != nullptr && version >= cached->version()) {
+            VLOG(3) << strings::Substitute("get_del_vec cached tablet_segment=$0 version=$1 actual_version=$2",
+                                           tsid.to_string(), version, cached->version());
+            // cache valid
+            // TODO(cbl): add cache hit stats
+            *pdelvec = std::move(cached);
+            return Status::OK();
         }
     }
     (*pdelvec).reset(new DelVector());
     int64_t latest_version = 0;
     RETURN_IF_ERROR(get_del_vec_in_meta(meta, tsid, version, pdelvec->get(), &latest_version));
     if ((*pdelvec)->version() == latest_version) {
-        std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-        auto itr = _del_vec_cache.find(tsid);
-        if (itr == _del_vec_cache.end()) {
-            _del_vec_cache.emplace(tsid, *pdelvec);
-            _del_vec_cache_mem_tracker->consume((*pdelvec)->memory_usage());
-        } else if (latest_version > itr->second->version()) {
-            // should happen rarely
-            _del_vec_cache_mem_tracker->release(itr->second->memory_usage());
-            itr->second = (*pdelvec);
-            _del_vec_cache_mem_tracker->consume(itr->second->memory_usage());
+        std::lock_guard<ProfiledMutex> lg(shard.lock);
+        auto cached = _get_cached_del_vec_unlocked(shard, tsid);
+        // a newer one may be cached by the apply meanwhile
+        if (cached == nullptr || latest_version > cached->version()) {
+            _put_cached_del_vec_unlocked(shard, tsid, *pdelvec);
         }
     }
     return Status::OK();
@@ -106,24 +141,26 @@ void UpdateManager::clear_cache() {
     }
     StarRocksMetrics::instance()->update_primary_index_num.set_value(0);
     StarRocksMetrics::instance()->update_primary_index_bytes_total.set_value(0);
-    {
-        std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-        _del_vec_cache.clear();
-        if (_del_vec_cache_mem_tracker) {
-            _del_vec_cache_mem_tracker->release(_del_vec_cache_mem_tracker->consumption());
-        }
-        StarRocksMetrics::instance()->update_del_vector_num.set_value(0);
-        StarRocksMetrics::instance()->update_del_vector_bytes_total.set_value(0);
+    for (auto& shard : _del_vec_cache) {
+        std::lock_guard<ProfiledMutex> lg(shard.lock);
+        shard.lru.clear();
+        shard.map.clear();
+        shard.memory_usage = 0;
+    }
+    if (_del_vec_cache_mem_tracker) {
+        _del_vec_cache_mem_tracker->release(_del_vec_cache_mem_tracker->consumption());
     }
+    StarRocksMetrics::instance()->update_del_vector_num.set_value(0);
+    StarRocksMetrics::instance()->update_del_vector_bytes_total.set_value(0);
 }
 
 void UpdateManager::clear_cached_del_vec(const std::vector<TabletSegmentId>& tsids) {
-    std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
     for (const auto& tsid : tsids) {
-        auto itr = _del_vec_cache.find(tsid);
-        if (itr != _del_vec_cache.end()) {
-            _del_vec_cache_mem_tracker->release(itr->second->memory_usage());
-            _del_vec_cache.erase(itr);
+        auto& shard = _del_vec_cache_shard(tsid);
+        std::lock_guard<ProfiledMutex> lg(shard.lock);
+        auto itr = shard.map.find(tsid);
+        if (itr != shard.map.end()) {
+            _erase_cached_del_vec_unlocked(shard, itr->second);
         }
     }
 }
@@ -132,11 +169,15 @@ void UpdateManager::expire_cache() {
     StarRocksMetrics::instance()->update_primary_index_num.set_value(_index_cache.object_size());
     StarRocksMetrics::instance()->update_primary_index_bytes_total.set_value(_index_cache.size());
     {
-        std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-        StarRocksMetrics::instance()->update_del_vector_num.set_value(_del_vec_cache.size());
-        StarRocksMetrics::instance()->update_del_vector_bytes_total.set_value(std::accumulate(
-                _del_vec_cache.cbegin(), _del_vec_cache.cend(), 0,
-                [](const int& accumulated, const auto& p) { return accumulated + p.second->memory_usage(); }));
+        size_t num_del_vecs = 0;
+        size_t del_vecs_bytes = 0;
+        for (auto& shard : _del_vec_cache) {
+            std::lock_guard<ProfiledMutex> lg(shard.lock);
+            num_del_vecs += shard.map.size();
+            del_vecs_bytes += shard.memory_usage;
+        }
+        StarRocksMetrics::instance()->update_del_vector_num.set_value(num_del_vecs);
+        StarRocksMetrics::instance()->update_del_vector_bytes_total.set_value(del_vecs_bytes);
     }
     if (MonotonicMillis() - _last_clear_expired_cache_millis > _cache_expire_ms) {
         _update_state_cache.clear_expired();
@@ -165,18 +206,18 @@ string UpdateManager::memory_stats() {
 }
 
 Status UpdateManager::get_latest_del_vec(OlapMeta* meta, const TabletSegmentId& tsid, DelVectorPtr* pdelvec) {
-    std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-    auto itr = _del_vec_cache.find(tsid);
-    if (itr != _del_vec_cache.end()) {
-        *pdelvec = itr->second;
+    auto& shard = _del_vec_cache_shard(tsid);
+    std::lock_guard<ProfiledMutex> lg(shard.lock);
+    auto cached = _get_cached_del_vec_unlocked(shard, tsid);
+    if (cached != nullptr) {
+        *pdelvec = std::move(cached);
         return Status::OK();
     } else {
         // TODO(cbl): move get_del_vec_in_meta out of lock
         (*pdelvec).reset(new DelVector());
         int64_t latest_version = 0;
         RETURN_IF_ERROR(get_del_vec_in_meta(meta, tsid, INT64_MAX, pdelvec->get(), &latest_version));
-        _del_vec_cache.emplace(tsid, *pdelvec);
-        _del_vec_cache_mem_tracker->consume((*pdelvec)->memory_usage());
+        _put_cached_del_vec_unlocked(shard, tsid, *pdelvec);
     }
     return Status::OK();
 }
@@ -184,23 +225,16 @@ Status UpdateManager::get_latest_del_vec(OlapMeta* meta, const TabletSegmentId&
 Status UpdateManager::set_cached_del_vec(const TabletSegmentId& tsid, DelVectorPtr delvec) {
     VLOG(1) << "set_cached_del_vec tablet:" << tsid.tablet_id << " rss:" << tsid.segment_id
             << " version:" << delvec->version() << " #del:" << delvec->cardinality();
-    std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-    auto itr = _del_vec_cache.find(tsid);
-    if (itr != _del_vec_cache.end()) {
-        if (delvec->version() <= itr->second->version()) {
-            string msg = strings::Substitute("UpdateManager::set_cached_del_vec: new version($0) < old version($1)",
-                                             delvec->version(), itr->second->version());
-            LOG(ERROR) << msg;
-            return Status::InternalError(msg);
-        } else {
-            _del_vec_cache_mem_tracker->release(itr->second->memory_usage());
-            itr->second = delvec;
-            _del_vec_cache_mem_tracker->consume(itr->second->memory_usage());
-        }
-    } else {
-        _del_vec_cache.emplace(tsid, delvec);
-        _del_vec_cache_mem_tracker->consume(delvec->memory_usage());
+    auto& shard = _del_vec_cache_shard(tsid);
+    std::lock_guard<ProfiledMutex> lg(shard.lock);
+    auto cached = _get_cached_del_vec_unlocked(shard, tsid);
+    if (cached != nullptr && delvec->version() <= cached->version()) {
+        string msg = strings::Substitute("UpdateManager::set_cached_del_vec: new version($0) < old version($1)",
+                                         delvec->version(), cached->version());
+        LOG(ERROR) << msg;
+        return Status::InternalError(msg);
     }
+    _put_cached_del_vec_unlocked(shard, tsid, std::move(delvec));
     return Status::OK();
 }
 
@@ -2,12 +2,15 @@
 
 #pragma once
 
+#include <array>
+#include <list>
 #include <string>
 #include <unordered_map>
 
 #include "storage/olap_common.h"
 #include "storage/primary_index.h"
 #include "util/dynamic_cache.h"
+#include "util/lock_profiler.h"
 #include "util/threadpool.h"
 
 namespace starrocks {
@@ -55,6 +58,9 @@ public:
 
     ThreadPool* apply_thread_pool() { return _apply_thread_pool.get(); }
 
+    // The threads upserting the shards of the primary index of a rowset applied, nullptr if disabled.
+    ThreadPool* apply_index_thread_pool() { return _apply_index_thread_pool.get(); }
+
     DynamicCache<uint64_t, PrimaryIndex>& index_cache() { return _index_cache; }
 
     DynamicCache<string, RowsetUpdateState>& update_state_cache() { return _update_state_cache; }
@@ -88,11 +94,34 @@ private:
     std::atomic<int64_t> _last_clear_expired_cache_millis{0};
 
     // DelVector related states
-    std::mutex _del_vec_cache_lock;
-    std::unordered_map<TabletSegmentId, DelVectorPtr> _del_vec_cache;
+    // The latest DelVectors of the segments, in shards by TabletSegmentId so that the readers of different segments
+    // do not contend for one lock. Each shard evicts its least recently used ones once it is beyond its part of
+    // config::update_del_vector_cache_capacity.
+    using DelVecLRUList = std::list<std::pair<TabletSegmentId, DelVectorPtr>>;
+    struct DelVecCacheShard {
+        ProfiledMutex lock{LockSite::get("update_manager_del_vec_cache")};
+        // the most recently used at the front
+        DelVecLRUList lru;
+        std::unordered_map<TabletSegmentId, DelVecLRUList::iterator> map;
+        size_t memory_usage = 0;
+    };
+    static constexpr size_t kDelVecCacheShards = 16;
+
+    DelVecCacheShard& _del_vec_cache_shard(const TabletSegmentId& tsid) {
+        return _del_vec_cache[std::hash<TabletSegmentId>()(tsid) % kDelVecCacheShards];
+    }
+    // The DelVector of |tsid| in the locked |shard|, made the most recently used, or nullptr if it is not cached.
+    DelVectorPtr _get_cached_del_vec_unlocked(DelVecCacheShard& shard, const TabletSegmentId& tsid);
+    // Cache |delvec| in the locked |shard| in place of the old one if any, and evict the least recently used ones
+    // beyond the capacity of the shard.
+    void _put_cached_del_vec_unlocked(DelVecCacheShard& shard, const TabletSegmentId& tsid, DelVectorPtr delvec);
+    void _erase_cached_del_vec_unlocked(DelVecCacheShard& shard, DelVecLRUList::iterator itr);
+
+    std::array<DelVecCacheShard, kDelVecCacheShards> _del_vec_cache;
     std::unique_ptr<MemTracker> _del_vec_cache_mem_tracker;
 
     std::unique_ptr<ThreadPool> _apply_thread_pool;
+    std::unique_ptr<ThreadPool> _apply_index_thread_pool;
 
     DISALLOW_COPY_AND_ASSIGN(UpdateManager);
 };
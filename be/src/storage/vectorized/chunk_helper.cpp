@@ -64,21 +64,34 @@ starrocks::vectorized::Field ChunkHelper::convert_field_to_format_v2(ColumnId id
     return f;
 }
 
-starrocks::vectorized::Schema ChunkHelper::convert_schema_to_format_v2(const starrocks::TabletSchema& schema) {
-    starrocks::vectorized::Fields fields;
-    for (ColumnId cid = 0; cid < schema.num_columns(); ++cid) {
-        auto f = convert_field_to_format_v2(cid, schema.column(cid));
-        fields.emplace_back(std::make_shared<starrocks::vectorized::Field>(std::move(f)));
+// The fields are immutable once converted, so they are converted once per TabletSchema, which is mostly shared by
+// the tablets of the same schema, rather than once per scan.
+std::shared_ptr<const vectorized::Fields> ChunkHelper::_format_v2_fields(const starrocks::TabletSchema& schema) {
+    auto fields = std::atomic_load(&schema._format_v2_fields);
+    if (fields == nullptr) {
+        auto converted = std::make_shared<vectorized::Fields>();
+        converted->reserve(schema.num_columns());
+        for (ColumnId cid = 0; cid < schema.num_columns(); ++cid) {
+            auto f = convert_field_to_format_v2(cid, schema.column(cid));
+            converted->emplace_back(std::make_shared<starrocks::vectorized::Field>(std::move(f)));
+        }
+        fields = std::move(converted);
+        std::atomic_store(&schema._format_v2_fields, fields);
     }
-    return starrocks::vectorized::Schema(std::move(fields));
+    return fields;
+}
+
+starrocks::vectorized::Schema ChunkHelper::convert_schema_to_format_v2(const starrocks::TabletSchema& schema) {
+    return starrocks::vectorized::Schema(*_format_v2_fields(schema));
 }
 
 starrocks::vectorized::Schema ChunkHelper::convert_schema_to_format_v2(const starrocks::TabletSchema& schema,
                                                                        const std::vector<ColumnId>& cids) {
+    auto all_fields = _format_v2_fields(schema);
     starrocks::vectorized::Fields fields;
+    fields.reserve(cids.size());
     for (ColumnId cid : cids) {
-        auto f = convert_field_to_format_v2(cid, schema.column(cid));
-        fields.emplace_back(std::make_shared<starrocks::vectorized::Field>(std::move(f)));
+        fields.emplace_back((*all_fields)[cid]);
     }
     return starrocks::vectorized::Schema(std::move(fields));
 }
@@ -91,25 +104,6 @@ ColumnId ChunkHelper::max_column_id(const starrocks::vectorized::Schema& schema)
     return id;
 }
 
-template <typename T>
-struct ColumnDeleter {
-    void operator()(Column* ptr) const { return_column<T>(down_cast<T*>(ptr)); }
-};
-
-template <typename T, bool force>
-inline std::shared_ptr<T> get_column_ptr() {
-    if constexpr (std::negation_v<HasColumnPool<T>>) {
-        return std::make_shared<T>();
-    } else {
-        T* ptr = get_column<T, force>();
-        if (LIKELY(ptr != nullptr)) {
-            return std::shared_ptr<T>(ptr, ColumnDeleter<T>());
-        } else {
-            return std::make_shared<T>();
-        }
-    }
-}
-
 template <typename T, bool force>
 inline std::shared_ptr<DecimalColumnType<T>> get_decimal_column_ptr(int precision, int scale) {
     auto column = get_column_ptr<T, force>();
@@ -290,7 +284,7 @@ void ChunkHelper::padding_char_columns(const std::vector<size_t>& char_column_in
         vectorized::Offsets& new_offset = new_binary->get_offset();
         vectorized::Bytes& new_bytes = new_binary->get_bytes();
 
-        uint32_t len = tschema.column(field_index).length();
+        uint32_t len = tschema.column(schema.field(field_index)->id()).length();
 
         new_offset.resize(num_rows + 1);
         new_bytes.assign(num_rows * len, 0); // padding 0
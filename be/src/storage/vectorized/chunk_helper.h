@@ -77,6 +77,10 @@ public:
     // Padding char columns
     static void padding_char_columns(const std::vector<size_t>& char_column_indexes, const vectorized::Schema& schema,
                                      const starrocks::TabletSchema& tschema, vectorized::Chunk* chunk);
+
+private:
+    // The fields of format v2 of all the columns of |schema|, cached in the schema.
+    static std::shared_ptr<const vectorized::Fields> _format_v2_fields(const starrocks::TabletSchema& schema);
 };
 
 inline ChunkPtr ChunkHelper::new_chunk(const vectorized::Schema& schema, size_t n) {
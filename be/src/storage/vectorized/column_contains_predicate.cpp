@@ -0,0 +1,142 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <cstring>
+
+#include "column/binary_column.h"
+#include "column/column.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "storage/rowset/segment_v2/bloom_filter.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::vectorized {
+
+// ColumnContainsPredicate selects the string values containing all of its substrings, which is implied e.g. by
+// `LIKE '%foo%bar%'` with the substrings "foo" and "bar". Every n-gram of a substring must be in the n-gram bloom
+// filter of a data page holding a selected value.
+class ColumnContainsPredicate : public ColumnPredicate {
+public:
+    ColumnContainsPredicate(const TypeInfoPtr& type_info, ColumnId id, std::vector<std::string> substrings)
+            : ColumnPredicate(type_info, id), _substrings(std::move(substrings)) {}
+
+    void evaluate(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const override {
+        const auto* v = reinterpret_cast<const Slice*>(column->raw_data());
+        if (!column->has_null()) {
+            for (size_t i = from; i < to; i++) {
+                sel[i] = _contains(v[i]);
+            }
+        } else {
+            const uint8_t* is_null = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+            for (size_t i = from; i < to; i++) {
+                sel[i] = !is_null[i] && _contains(v[i]);
+            }
+        }
+    }
+
+    void evaluate_and(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const override {
+        const auto* v = reinterpret_cast<const Slice*>(column->raw_data());
+        if (!column->has_null()) {
+            for (size_t i = from; i < to; i++) {
+                sel[i] = sel[i] && _contains(v[i]);
+            }
+        } else {
+            const uint8_t* is_null = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+            for (size_t i = from; i < to; i++) {
+                sel[i] = sel[i] && !is_null[i] && _contains(v[i]);
+            }
+        }
+    }
+
+    void evaluate_or(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const override {
+        const auto* v = reinterpret_cast<const Slice*>(column->raw_data());
+        if (!column->has_null()) {
+            for (size_t i = from; i < to; i++) {
+                sel[i] = sel[i] || _contains(v[i]);
+            }
+        } else {
+            const uint8_t* is_null = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+            for (size_t i = from; i < to; i++) {
+                sel[i] = sel[i] || (!is_null[i] && _contains(v[i]));
+            }
+        }
+    }
+
+    uint16_t evaluate_branchless(const Column* column, uint16_t* sel, uint16_t sel_size) const override {
+        const BinaryColumn* binary_column;
+        if (column->is_nullable()) {
+            binary_column =
+                    down_cast<const BinaryColumn*>(down_cast<const NullableColumn*>(column)->data_column().get());
+        } else {
+            binary_column = down_cast<const BinaryColumn*>(column);
+        }
+
+        uint16_t new_size = 0;
+        if (!column->has_null()) {
+            for (uint16_t i = 0; i < sel_size; ++i) {
+                uint16_t data_idx = sel[i];
+                sel[new_size] = data_idx;
+                new_size += _contains(binary_column->get_slice(data_idx));
+            }
+        } else {
+            const uint8_t* is_null = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+            for (uint16_t i = 0; i < sel_size; ++i) {
+                uint16_t data_idx = sel[i];
+                sel[new_size] = data_idx;
+                new_size += !is_null[data_idx] && _contains(binary_column->get_slice(data_idx));
+            }
+        }
+        return new_size;
+    }
+
+    bool support_ngram_bloom_filter() const override { return true; }
+
+    bool ngram_bloom_filter(const segment_v2::BloomFilter* bf, size_t gram_size) const override {
+        for (const auto& substring : _substrings) {
+            for (size_t pos = 0; pos + gram_size <= substring.size(); ++pos) {
+                if (!bf->test_bytes(substring.data() + pos, gram_size)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    PredicateType type() const override { return PredicateType::kContains; }
+
+    bool can_vectorized() const override { return false; }
+
+    Status convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
+                      ObjectPool* obj_pool) const override {
+        *output = this;
+        return Status::OK();
+    }
+
+    std::string debug_string() const override {
+        std::stringstream ss;
+        ss << "(contains(" << _column_id << "):";
+        for (const auto& substring : _substrings) {
+            ss << " '" << substring << "'";
+        }
+        ss << ")";
+        return ss.str();
+    }
+
+private:
+    bool _contains(const Slice& value) const {
+        for (const auto& substring : _substrings) {
+            if (memmem(value.data, value.size, substring.data(), substring.size()) == nullptr) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::string> _substrings;
+};
+
+ColumnPredicate* new_column_contains_predicate(const TypeInfoPtr& type_info, ColumnId id,
+                                               const std::vector<std::string>& substrings) {
+    return new ColumnContainsPredicate(type_info, id, substrings);
+}
+
+} // namespace starrocks::vectorized
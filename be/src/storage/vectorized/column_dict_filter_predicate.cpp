@@ -0,0 +1,111 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/column.h"
+#include "column/nullable_column.h"
+#include "gutil/casts.h"
+#include "simd/simd.h"
+#include "storage/vectorized/column_predicate.h"
+
+namespace starrocks::vectorized {
+
+// ColumnDictFilterPredicate is applied to the dictionary codes of a column, on which the original predicates
+// have been evaluated once for every word of the dictionary: a code is selected iff |_dict_filter[code]| is 1.
+class ColumnDictFilterPredicate : public ColumnPredicate {
+public:
+    ColumnDictFilterPredicate(const TypeInfoPtr& type_info, ColumnId id, std::vector<uint8_t> dict_filter)
+            : ColumnPredicate(type_info, id), _dict_filter(std::move(dict_filter)) {}
+
+    void evaluate(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const override {
+        const auto* codes = reinterpret_cast<const int32_t*>(column->raw_data());
+        const uint8_t* filter = _dict_filter.data();
+        if (!column->has_null()) {
+            for (size_t i = from; i < to; i++) {
+                sel[i] = filter[codes[i]];
+            }
+        } else {
+            const uint8_t* null_data = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+            for (size_t i = from; i < to; i++) {
+                sel[i] = !null_data[i] && filter[codes[i]];
+            }
+        }
+    }
+
+    void evaluate_and(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const override {
+        const auto* codes = reinterpret_cast<const int32_t*>(column->raw_data());
+        const uint8_t* filter = _dict_filter.data();
+        if (!column->has_null()) {
+            for (size_t i = from; i < to; i++) {
+                sel[i] = sel[i] && filter[codes[i]];
+            }
+        } else {
+            const uint8_t* null_data = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+            for (size_t i = from; i < to; i++) {
+                sel[i] = sel[i] && !null_data[i] && filter[codes[i]];
+            }
+        }
+    }
+
+    void evaluate_or(const Column* column, uint8_t* sel, uint16_t from, uint16_t to) const override {
+        const auto* codes = reinterpret_cast<const int32_t*>(column->raw_data());
+        const uint8_t* filter = _dict_filter.data();
+        if (!column->has_null()) {
+            for (size_t i = from; i < to; i++) {
+                sel[i] = sel[i] || filter[codes[i]];
+            }
+        } else {
+            const uint8_t* null_data = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+            for (size_t i = from; i < to; i++) {
+                sel[i] = sel[i] || (!null_data[i] && filter[codes[i]]);
+            }
+        }
+    }
+
+    uint16_t evaluate_branchless(const Column* column, uint16_t* sel, uint16_t sel_size) const override {
+        const auto* codes = reinterpret_cast<const int32_t*>(column->raw_data());
+        const uint8_t* filter = _dict_filter.data();
+        uint16_t new_size = 0;
+        if (!column->has_null()) {
+            for (uint16_t i = 0; i < sel_size; ++i) {
+                uint16_t data_idx = sel[i];
+                sel[new_size] = data_idx;
+                new_size += filter[codes[data_idx]];
+            }
+        } else {
+            const uint8_t* null_data = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+            for (uint16_t i = 0; i < sel_size; ++i) {
+                uint16_t data_idx = sel[i];
+                sel[new_size] = data_idx;
+                new_size += !null_data[data_idx] && filter[codes[data_idx]];
+            }
+        }
+        return new_size;
+    }
+
+    // The codes are a set of values like an IN list.
+    PredicateType type() const override { return PredicateType::kInList; }
+
+    bool can_vectorized() const override { return true; }
+
+    Status convert_to(const ColumnPredicate** output, const TypeInfoPtr& target_type_info,
+                      ObjectPool* obj_pool) const override {
+        *output = this;
+        return Status::OK();
+    }
+
+    std::string debug_string() const override {
+        std::stringstream ss;
+        ss << "(dict_filter(" << _column_id << "): " << SIMD::count_nonzero(_dict_filter) << "/"
+           << _dict_filter.size() << ")";
+        return ss.str();
+    }
+
+private:
+    std::vector<uint8_t> _dict_filter;
+};
+
+ColumnPredicate* new_column_dict_filter_predicate(const TypeInfoPtr& type_info, ColumnId id,
+                                                  std::vector<uint8_t> dict_filter) {
+    return new ColumnDictFilterPredicate(type_info, id, std::move(dict_filter));
+}
+
+} // namespace starrocks::vectorized
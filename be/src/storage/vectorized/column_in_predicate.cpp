@@ -21,7 +21,11 @@ class ColumnInPredicate : public ColumnPredicate {
 
 public:
     ColumnInPredicate(const TypeInfoPtr& type_info, ColumnId id, ItemSet values)
-            : ColumnPredicate(type_info, id), _values(std::move(values)) {}
+            : ColumnPredicate(type_info, id), _values(std::move(values)) {
+        std::vector<ValueType> values_to_hash(_values.begin(), _values.end());
+        _bf_hashes.resize(values_to_hash.size());
+        segment_v2::BloomFilter::hash_values(values_to_hash.data(), values_to_hash.size(), _bf_hashes.data());
+    }
 
     ~ColumnInPredicate() override = default;
 
@@ -120,10 +124,7 @@ public:
         static_assert(field_type != OLAP_FIELD_TYPE_HLL, "TODO");
         static_assert(field_type != OLAP_FIELD_TYPE_OBJECT, "TODO");
         static_assert(field_type != OLAP_FIELD_TYPE_PERCENTILE, "TODO");
-        for (const ValueType& v : _values) {
-            RETURN_IF(bf->test_bytes(reinterpret_cast<const char*>(&v), sizeof(v)), true);
-        }
-        return false;
+        return bf->test_any_hash(_bf_hashes.data(), _bf_hashes.size());
     }
 
     PredicateType type() const override { return PredicateType::kInList; }
@@ -172,6 +173,8 @@ public:
 
 private:
     ItemSet _values;
+    // The hashes of |_values| in the bloom filters, computed once instead of for every page.
+    std::vector<uint64_t> _bf_hashes;
 };
 
 // Template specialization for binary column
@@ -183,6 +186,7 @@ public:
         for (const std::string& s : _zero_padded_strs) {
             _slices.emplace(Slice(s));
         }
+        _hash_values();
     }
 
     ~BinaryColumnInPredicate() override = default;
@@ -315,11 +319,7 @@ public:
     bool support_bloom_filter() const override { return true; }
 
     bool bloom_filter(const segment_v2::BloomFilter* bf) const override {
-        for (const auto& str : _zero_padded_strs) {
-            Slice v(str);
-            RETURN_IF(bf->test_bytes(v.data, v.size), true);
-        }
-        return false;
+        return bf->test_any_hash(_bf_hashes.data(), _bf_hashes.size());
     }
 
     bool can_vectorized() const override { return false; }
@@ -353,12 +353,25 @@ public:
             str.append(len > old_sz ? len - old_sz : 0, '\0');
             _slices.emplace(str.data(), old_sz);
         }
+        _hash_values();
         return true;
     }
 
 private:
+    void _hash_values() {
+        std::vector<Slice> values;
+        values.reserve(_zero_padded_strs.size());
+        for (const std::string& s : _zero_padded_strs) {
+            values.emplace_back(s);
+        }
+        _bf_hashes.resize(values.size());
+        segment_v2::BloomFilter::hash_values(values.data(), values.size(), _bf_hashes.data());
+    }
+
     std::vector<std::string> _zero_padded_strs;
     ItemHashSet<Slice> _slices;
+    // The hashes of |_zero_padded_strs| in the bloom filters, computed once instead of for every page.
+    std::vector<uint64_t> _bf_hashes;
 };
 
 template <template <typename, size_t...> typename Set, size_t... Args>
@@ -478,8 +491,13 @@ ColumnPredicate* new_column_in_predicate_generic(const TypeInfoPtr& type_info, C
 }
 ColumnPredicate* new_column_in_predicate_small(const TypeInfoPtr& type_info, ColumnId id,
                                                const std::vector<std::string>& strs) {
-    if (strs.size() == 3) {
-        return new_column_in_predicate_generic<ArraySet, 3>(type_info, id, strs);
+    // The unused slots of ArraySet are padded, so a list is put in the smallest one of its size or greater.
+    if (strs.size() > 8) {
+        return new_column_in_predicate_generic<ArraySet, 16>(type_info, id, strs);
+    } else if (strs.size() > 4) {
+        return new_column_in_predicate_generic<ArraySet, 8>(type_info, id, strs);
+    } else if (strs.size() > 2) {
+        return new_column_in_predicate_generic<ArraySet, 4>(type_info, id, strs);
     } else if (strs.size() == 2) {
         return new_column_in_predicate_generic<ArraySet, 2>(type_info, id, strs);
     } else if (strs.size() == 1) {
@@ -491,7 +509,7 @@ ColumnPredicate* new_column_in_predicate_small(const TypeInfoPtr& type_info, Col
 
 ColumnPredicate* new_column_in_predicate(const TypeInfoPtr& type_info, ColumnId id,
                                          const std::vector<std::string>& strs) {
-    if (strs.size() > 3) {
+    if (strs.size() > kMaxArraySetSize) {
         return new_column_in_predicate_generic<ItemHashSet>(type_info, id, strs);
     } else {
         return new_column_in_predicate_small(type_info, id, strs);
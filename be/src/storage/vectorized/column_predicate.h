@@ -45,6 +45,7 @@ enum class PredicateType {
     kNotNull = 9,
     kAnd = 10,
     kOr = 11,
+    kContains = 12,
 };
 
 template <typename T>
@@ -104,6 +105,11 @@ public:
     // Return false to filter out a data page.
     virtual bool bloom_filter(const segment_v2::BloomFilter* bf) const { return true; }
 
+    virtual bool support_ngram_bloom_filter() const { return false; }
+
+    // Return false to filter out a data page by its bloom filter of the n-grams of |gram_size| bytes.
+    virtual bool ngram_bloom_filter(const segment_v2::BloomFilter* bf, size_t gram_size) const { return true; }
+
     virtual Status seek_bitmap_dictionary(segment_v2::BitmapIndexIterator* iter, SparseRange* range) const {
         return Status::Cancelled("not implemented");
     }
@@ -270,6 +276,14 @@ ColumnPredicate* new_column_not_in_predicate(const TypeInfoPtr& type, ColumnId i
                                              const std::vector<std::string>& operands);
 ColumnPredicate* new_column_null_predicate(const TypeInfoPtr& type, ColumnId, bool is_null);
 
+// A predicate on the int32 dictionary codes of a column, which selects the code i iff dict_filter[i] is non-zero.
+ColumnPredicate* new_column_dict_filter_predicate(const TypeInfoPtr& type, ColumnId id,
+                                                  std::vector<uint8_t> dict_filter);
+
+// A predicate on a string column, which selects the values containing all of |substrings|.
+ColumnPredicate* new_column_contains_predicate(const TypeInfoPtr& type, ColumnId id,
+                                               const std::vector<std::string>& substrings);
+
 template <FieldType field_type, template <FieldType> typename Predicate, typename NewColumnPredicateFunc>
 Status predicate_convert_to(Predicate<field_type> const& input_predicate,
                             typename CppTypeTraits<field_type>::CppType const& value,
@@ -42,6 +42,9 @@ public:
 
     virtual Status compact() = 0;
 
+    // The bytes of the rowsets picked to compact.
+    int64_t input_rowsets_size() const { return _input_rowsets_size; }
+
     static Status init(int concurreny);
 
 protected:
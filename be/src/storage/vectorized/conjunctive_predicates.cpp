@@ -79,11 +79,11 @@ inline void ConjunctivePredicates::_evaluate_non_vec(const Chunk* chunk, uint8_t
             }
         }
 
-        for (size_t i = 0; selected_size > 0 && i < _non_vec_preds.size(); ++i) {
+        selected_size = _non_vec_order.evaluate(_non_vec_preds.size(), selected_size, [&](size_t i, size_t rows) {
             const ColumnPredicate* pred = _non_vec_preds[i];
             const ColumnPtr& c = chunk->get_column_by_id(pred->column_id());
-            selected_size = pred->evaluate_branchless(c.get(), _selected_idx.data(), selected_size);
-        }
+            return pred->evaluate_branchless(c.get(), _selected_idx.data(), rows);
+        });
 
         memset(&selection[from], 0, to - from);
         for (uint16_t i = 0; i < selected_size; ++i) {
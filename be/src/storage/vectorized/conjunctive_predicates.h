@@ -6,6 +6,7 @@
 
 #include "butil/containers/flat_map.h"
 #include "storage/vectorized/column_predicate.h"
+#include "util/adaptive_predicate_order.h"
 
 namespace starrocks::vectorized {
 
@@ -80,6 +81,8 @@ private:
     std::vector<const ColumnPredicate*> _vec_preds;
     std::vector<const ColumnPredicate*> _non_vec_preds;
     mutable std::vector<uint16_t> _selected_idx;
+    // The non-vectorized predicates are evaluated on the rows left by each other in this order.
+    mutable AdaptivePredicateOrder _non_vec_order;
 };
 
 inline ConjunctivePredicates::ConjunctivePredicates(const std::initializer_list<const ColumnPredicate*>& preds) {
@@ -2,6 +2,9 @@
 
 #include "storage/vectorized/cumulative_compaction.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "util/starrocks_metrics.h"
 #include "util/time.h"
 #include "util/trace.h"
@@ -45,8 +48,11 @@ Status CumulativeCompaction::compact() {
     // 4. set state to success
     _state = CompactionState::SUCCESS;
 
-    // 5. set cumulative point
-    _tablet->set_cumulative_layer_point(_input_rowsets.back()->end_version() + 1);
+    // 5. set cumulative point, the output of the size tiered policy staying in the cumulative layer to be merged
+    // into the higher tiers
+    if (!_is_size_tiered()) {
+        _tablet->set_cumulative_layer_point(_input_rowsets.back()->end_version() + 1);
+    }
 
     // 6. add metric to cumulative compaction
     StarRocksMetrics::instance()->cumulative_compaction_deltas_total.increment(_input_rowsets.size());
@@ -56,7 +62,116 @@ Status CumulativeCompaction::compact() {
     return Status::OK();
 }
 
+bool CumulativeCompaction::_is_size_tiered() const {
+    return _tablet->tablet_meta()->cumulative_compaction_policy() == SIZE_TIERED_CUMULATIVE_COMPACTION;
+}
+
+int CumulativeCompaction::size_tier(int64_t bytes) {
+    const int max_tier = config::size_tiered_compaction_max_write_amplification;
+    const int64_t multiple = std::max<int64_t>(2, config::size_tiered_compaction_tier_multiple);
+    int64_t tier_bytes = std::max<int64_t>(1, config::size_tiered_compaction_min_tier_bytes) * multiple;
+    int tier = 0;
+    while (tier < max_tier && bytes >= tier_bytes) {
+        tier++;
+        if (tier_bytes > std::numeric_limits<int64_t>::max() / multiple) {
+            break;
+        }
+        tier_bytes *= multiple;
+    }
+    return tier;
+}
+
+void CumulativeCompaction::pick_size_tiered_rowsets(const std::vector<SizeTieredRowset>& rowsets, bool sealed,
+                                                    size_t* num_skipped, size_t* begin, size_t* end) {
+    const int max_tier = config::size_tiered_compaction_max_write_amplification;
+    *num_skipped = 0;
+    *begin = 0;
+    *end = 0;
+    bool leading = true;
+    size_t i = 0;
+    while (i < rowsets.size()) {
+        int tier = size_tier(rowsets[i].bytes);
+        if (tier >= max_tier && !rowsets[i].overlapping) {
+            i++;
+            if (leading) {
+                *num_skipped = i;
+            }
+            continue;
+        }
+
+        size_t run_end = i;
+        int64_t score = 0;
+        while (run_end < rowsets.size() && size_tier(rowsets[run_end].bytes) == tier &&
+               score < config::max_cumulative_compaction_num_singleton_deltas) {
+            score += rowsets[run_end].compaction_score;
+            run_end++;
+            // The overlapping rowsets of the top tier are compacted alone.
+            if (tier >= max_tier) {
+                break;
+            }
+        }
+        bool run_sealed = run_end == rowsets.size() ? sealed : size_tier(rowsets[run_end].bytes) > tier;
+        if (score >= config::min_cumulative_compaction_num_singleton_deltas || (run_sealed && score > 1)) {
+            *begin = i;
+            *end = run_end;
+            return;
+        }
+        if (leading && run_sealed) {
+            *num_skipped = run_end;
+        } else {
+            leading = false;
+        }
+        i = run_end;
+    }
+}
+
+Status CumulativeCompaction::_pick_size_tiered_rowsets_to_compact() {
+    std::vector<RowsetSharedPtr> candidate_rowsets;
+    _tablet->pick_candicate_rowsets_to_cumulative_compaction(config::cumulative_compaction_skip_window_seconds,
+                                                             &candidate_rowsets);
+    if (candidate_rowsets.empty()) {
+        return Status::NotFound("cumulative compaction no suitable version error.");
+    }
+    std::sort(candidate_rowsets.begin(), candidate_rowsets.end(), Rowset::comparator);
+    RETURN_IF_ERROR(check_version_continuity(candidate_rowsets));
+
+    // The rowsets after a delete version are left to the next rounds, once the delete version is handed over to the
+    // base compaction.
+    const RowsetSharedPtr* delete_rowset = nullptr;
+    std::vector<SizeTieredRowset> rowsets;
+    for (const RowsetSharedPtr& rowset : candidate_rowsets) {
+        if (_tablet->version_for_delete_predicate(rowset->version())) {
+            delete_rowset = &rowset;
+            break;
+        }
+        SizeTieredRowset& tiered = rowsets.emplace_back();
+        tiered.bytes = rowset->data_disk_size();
+        tiered.compaction_score = rowset->rowset_meta()->get_compaction_score();
+        tiered.overlapping = rowset->rowset_meta()->is_segments_overlapping();
+    }
+
+    size_t num_skipped = 0;
+    size_t begin = 0;
+    size_t end = 0;
+    pick_size_tiered_rowsets(rowsets, delete_rowset != nullptr, &num_skipped, &begin, &end);
+    if (num_skipped == rowsets.size() && delete_rowset != nullptr) {
+        // plus 1 to skip the delete version.
+        _tablet->set_cumulative_layer_point((*delete_rowset)->end_version() + 1);
+    } else if (num_skipped > 0) {
+        _tablet->set_cumulative_layer_point(candidate_rowsets[num_skipped - 1]->end_version() + 1);
+    }
+    if (begin == end) {
+        return Status::NotFound("cumulative compaction no suitable version error.");
+    }
+    _input_rowsets.assign(candidate_rowsets.begin() + begin, candidate_rowsets.begin() + end);
+    return Status::OK();
+}
+
 Status CumulativeCompaction::pick_rowsets_to_compact() {
+    if (_is_size_tiered()) {
+        return _pick_size_tiered_rowsets_to_compact();
+    }
+
     std::vector<RowsetSharedPtr> candidate_rowsets;
     _tablet->pick_candicate_rowsets_to_cumulative_compaction(config::cumulative_compaction_skip_window_seconds,
                                                              &candidate_rowsets);
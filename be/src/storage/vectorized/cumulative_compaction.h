@@ -3,6 +3,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "storage/vectorized/compaction.h"
 
@@ -18,6 +19,30 @@ public:
 
     Status compact() override;
 
+    struct SizeTieredRowset {
+        int64_t bytes = 0;
+        int64_t compaction_score = 0;
+        bool overlapping = false;
+    };
+
+    // The size tier of a rowset of |bytes|, tier t holding the rowsets of
+    // [size_tiered_compaction_min_tier_bytes * multiple^t, size_tiered_compaction_min_tier_bytes * multiple^(t+1))
+    // bytes, multiple being size_tiered_compaction_tier_multiple, and up to
+    // size_tiered_compaction_max_write_amplification, the top tier.
+    static int size_tier(int64_t bytes);
+
+    // Pick the rowsets of a tablet of the size tiered policy to compact, among the cumulative |rowsets| sorted by
+    // version, |sealed| if no rowset may follow them, i.e. they are followed by a delete version.
+    //
+    // Only the adjacent rowsets of the same tier are merged, so that the output is of a higher tier and each byte is
+    // rewritten at most once per tier: the oldest run whose compaction score is at least
+    // min_cumulative_compaction_num_singleton_deltas, or more than 1 if no rowset can join it anymore, that is the
+    // next rowset is of a higher tier, is picked into [*begin, *end), empty if none. The non-overlapping rowsets of
+    // the top tier, and the single rowsets no rowset can join, are left to the base compaction: *num_skipped is the
+    // number of such rowsets leading |rowsets|, for the cumulative point to move past.
+    static void pick_size_tiered_rowsets(const std::vector<SizeTieredRowset>& rowsets, bool sealed,
+                                         size_t* num_skipped, size_t* begin, size_t* end);
+
 protected:
     Status pick_rowsets_to_compact() override;
 
@@ -26,6 +51,9 @@ protected:
     ReaderType compaction_type() const override { return ReaderType::READER_CUMULATIVE_COMPACTION; }
 
 private:
+    bool _is_size_tiered() const;
+    Status _pick_size_tiered_rowsets_to_compact();
+
     int64_t _cumulative_rowset_size_threshold;
 };
 
@@ -0,0 +1,193 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/vectorized/delete_bitmap_cache.h"
+
+#include <algorithm>
+#include <set>
+
+#include "column/chunk.h"
+#include "gutil/stl_util.h"
+#include "runtime/mem_tracker.h"
+#include "storage/rowset/beta_rowset.h"
+#include "storage/rowset/segment_v2/segment.h"
+#include "storage/rowset/vectorized/segment_options.h"
+#include "storage/tablet.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/delete_predicates.h"
+#include "util/defer_op.h"
+#include "util/threadpool.h"
+
+namespace starrocks::vectorized {
+
+DeleteBitmapCache* DeleteBitmapCache::_s_instance = nullptr;
+
+void DeleteBitmapCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
+    if (_s_instance == nullptr && capacity > 0) {
+        _s_instance = new DeleteBitmapCache(mem_tracker, capacity);
+    }
+}
+
+void DeleteBitmapCache::release_global_cache() {
+    if (_s_instance != nullptr) {
+        delete _s_instance;
+        _s_instance = nullptr;
+    }
+}
+
+DeleteBitmapCache::DeleteBitmapCache(MemTracker* mem_tracker, size_t capacity)
+        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {
+    // One thread is enough, since every rowset is materialized once.
+    Status st = ThreadPoolBuilder("delete_bitmap_materialize")
+                        .set_min_threads(0)
+                        .set_max_threads(1)
+                        .set_max_queue_size(1024)
+                        .build(&_materialize_pool);
+    LOG_IF(WARNING, !st.ok()) << "Fail to create the delete bitmap materialize pool: " << st.to_string();
+}
+
+DeleteBitmapCache::~DeleteBitmapCache() {
+    if (_materialize_pool != nullptr) {
+        _materialize_pool->shutdown();
+    }
+    _cache.reset();
+    _mem_tracker->release(_mem_tracker->consumption());
+}
+
+std::string DeleteBitmapCache::key(const RowsetId& rowset_id, uint32_t segment_id,
+                                   const std::vector<int32_t>& versions) {
+    std::string key = rowset_id.to_string();
+    key.append(":").append(std::to_string(segment_id));
+    for (int32_t version : versions) {
+        key.append(":").append(std::to_string(version));
+    }
+    return key;
+}
+
+DelVectorPtr DeleteBitmapCache::lookup(const std::string& key) {
+    auto* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    DelVectorPtr bitmap = *reinterpret_cast<DelVectorPtr*>(_cache->value(handle));
+    _cache->release(handle);
+    return bitmap;
+}
+
+void DeleteBitmapCache::insert(const std::string& key, const DelVectorPtr& bitmap) {
+    // The bitmap is kept alive by the segment iterators still using it after it has been evicted.
+    auto deleter = [](const CacheKey& key, void* value) { delete reinterpret_cast<DelVectorPtr*>(value); };
+    size_t charge = key.size() + sizeof(DelVector) + bitmap->memory_usage();
+    auto* handle = _cache->insert(CacheKey(key), new DelVectorPtr(bitmap), charge, deleter);
+    _cache->release(handle);
+    _mem_tracker->consume(static_cast<int64_t>(memory_usage()) - _mem_tracker->consumption());
+}
+
+void DeleteBitmapCache::materialize(std::shared_ptr<Tablet> tablet, std::shared_ptr<BetaRowset> rowset,
+                                    std::vector<int32_t> versions) {
+    if (_materialize_pool == nullptr) {
+        return;
+    }
+    std::string task_key = key(rowset->rowset_id(), 0, versions);
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (!_materializing.insert(task_key).second) {
+            return;
+        }
+    }
+    auto task = [this, tablet = std::move(tablet), rowset = std::move(rowset), versions = std::move(versions),
+                 task_key]() {
+        Status st = materialize_now(tablet.get(), rowset, versions);
+        LOG_IF(WARNING, !st.ok()) << "Fail to materialize the delete predicates of rowset "
+                                  << rowset->rowset_id().to_string() << ": " << st.to_string();
+        std::lock_guard<std::mutex> l(_mutex);
+        _materializing.erase(task_key);
+    };
+    Status st = _materialize_pool->submit_func(std::move(task));
+    if (!st.ok()) {
+        // The queue is full, the rowset will be submitted again by the next read.
+        std::lock_guard<std::mutex> l(_mutex);
+        _materializing.erase(task_key);
+    }
+}
+
+Status DeleteBitmapCache::materialize_now(Tablet* tablet, const std::shared_ptr<BetaRowset>& rowset,
+                                          const std::vector<int32_t>& versions) {
+    RowsetReleaseGuard guard(rowset);
+
+    std::vector<const ColumnPredicate*> owned;
+    DeferOp release_predicates([&owned] { STLDeleteElements(&owned); });
+    DeletePredicates delete_predicates;
+    Status st;
+    tablet->obtain_header_rdlock();
+    size_t num_found = 0;
+    for (const DeletePredicatePB& pred_pb : tablet->delete_predicates()) {
+        if (!std::binary_search(versions.begin(), versions.end(), pred_pb.version())) {
+            continue;
+        }
+        ConjunctivePredicates conjunctions;
+        st = parse_delete_predicate(*tablet, pred_pb, &conjunctions, &owned);
+        if (!st.ok()) {
+            break;
+        }
+        delete_predicates.add(pred_pb.version(), conjunctions);
+        num_found++;
+    }
+    tablet->release_header_lock();
+    RETURN_IF_ERROR(st);
+    if (num_found != versions.size()) {
+        return Status::NotFound("the delete predicates have been removed by compaction");
+    }
+
+    DisjunctivePredicates preds = delete_predicates.get_predicates(versions.front());
+    std::set<ColumnId> column_set;
+    preds.get_column_ids(&column_set);
+    if (column_set.empty()) {
+        return Status::NotSupported("no column in the delete predicates");
+    }
+    std::vector<ColumnId> columns(column_set.begin(), column_set.end());
+    Schema schema = ChunkHelper::convert_schema_to_format_v2(tablet->tablet_schema(), columns);
+
+    RETURN_IF_ERROR(rowset->load());
+    OlapReaderStatistics stats;
+    SegmentReadOptions seg_options;
+    seg_options.block_mgr = fs::fs_util::block_manager();
+    seg_options.stats = &stats;
+    seg_options.reader_type = READER_BASE_COMPACTION;
+    ChunkPtr chunk = ChunkHelper::new_chunk(schema, seg_options.chunk_size);
+    std::vector<uint8_t> selection(seg_options.chunk_size);
+    std::vector<uint32_t> rowids;
+    for (auto& segment : rowset->segments()) {
+        std::vector<uint32_t> deleted_rows;
+        if (segment->num_rows() > 0) {
+            auto res = segment->new_iterator(schema, seg_options);
+            if (!res.ok() && !res.status().is_end_of_file()) {
+                return res.status();
+            }
+            ChunkIteratorPtr iter = res.ok() ? std::move(res).value() : nullptr;
+            while (iter != nullptr) {
+                chunk->reset();
+                rowids.clear();
+                st = iter->get_next(chunk.get(), &rowids);
+                if (st.is_end_of_file()) {
+                    break;
+                }
+                RETURN_IF_ERROR(st);
+                preds.evaluate(chunk.get(), selection.data());
+                for (size_t i = 0; i < chunk->num_rows(); i++) {
+                    if (selection[i]) {
+                        deleted_rows.push_back(rowids[i]);
+                    }
+                }
+            }
+            if (iter != nullptr) {
+                iter->close();
+            }
+        }
+        auto bitmap = std::make_shared<DelVector>();
+        bitmap->init(versions.back(), deleted_rows.data(), deleted_rows.size());
+        insert(key(rowset->rowset_id(), segment->id(), versions), bitmap);
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
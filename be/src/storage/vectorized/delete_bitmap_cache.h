@@ -0,0 +1,82 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "common/status.h"
+#include "gutil/macros.h"
+#include "storage/del_vector.h"
+#include "storage/lru_cache.h"
+#include "storage/olap_common.h"
+
+namespace starrocks {
+
+class BetaRowset;
+class MemTracker;
+class Tablet;
+class ThreadPool;
+
+namespace vectorized {
+
+// DeleteBitmapCache keeps the bitmaps of the rows of the segments deleted by the delete predicates of the
+// (non primary keys) tablets, so that the reads of a segment with many delete predicates filter the rows by the
+// bitmap like the delete vector of the primary keys tablets instead of evaluating every predicate on every row,
+// and skip the segments not touched by any of them. A bitmap is keyed by the rowset id, which is never reused,
+// the segment id and the versions of the delete predicates, so it's never stale. The missing bitmaps of a rowset
+// are materialized by a background thread, evicted in LRU order once they are more than the capacity, and
+// accounted in |mem_tracker|.
+class DeleteBitmapCache {
+public:
+    // Create global instance of this class
+    static void create_global_cache(MemTracker* mem_tracker, size_t capacity);
+
+    static void release_global_cache();
+
+    // Return global instance, nullptr if the cache has not been created or is disabled.
+    static DeleteBitmapCache* instance() { return _s_instance; }
+
+    DeleteBitmapCache(MemTracker* mem_tracker, size_t capacity);
+    ~DeleteBitmapCache();
+
+    // The key of the bitmap of the segment |segment_id| of the rowset |rowset_id| deleted by the delete
+    // predicates of |versions|.
+    static std::string key(const RowsetId& rowset_id, uint32_t segment_id, const std::vector<int32_t>& versions);
+
+    // Return the bitmap of |key|, nullptr if it is not in the cache.
+    DelVectorPtr lookup(const std::string& key);
+
+    void insert(const std::string& key, const DelVectorPtr& bitmap);
+
+    // Evaluate the delete predicates of |versions| of |tablet| on all the segments of |rowset| in the background
+    // and insert their bitmaps, unless they're being materialized.
+    void materialize(std::shared_ptr<Tablet> tablet, std::shared_ptr<BetaRowset> rowset,
+                     std::vector<int32_t> versions);
+
+    // Evaluate the delete predicates of |versions| of |tablet| on all the segments of |rowset| and insert their
+    // bitmaps now.
+    Status materialize_now(Tablet* tablet, const std::shared_ptr<BetaRowset>& rowset,
+                           const std::vector<int32_t>& versions);
+
+    size_t memory_usage() const { return _cache->get_memory_usage(); }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(DeleteBitmapCache);
+
+    static DeleteBitmapCache* _s_instance;
+
+    MemTracker* _mem_tracker = nullptr;
+    std::unique_ptr<Cache> _cache;
+    std::unique_ptr<ThreadPool> _materialize_pool;
+
+    std::mutex _mutex;
+    // The rowsets and versions being materialized.
+    std::unordered_set<std::string> _materializing;
+};
+
+} // namespace vectorized
+} // namespace starrocks
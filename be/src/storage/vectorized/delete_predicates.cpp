@@ -5,6 +5,9 @@
 #include <algorithm>
 
 #include "column/chunk.h"
+#include "storage/delete_handler.h"
+#include "storage/tablet.h"
+#include "storage/vectorized/predicate_parser.h"
 
 namespace starrocks::vectorized {
 
@@ -34,4 +37,66 @@ DisjunctivePredicates DeletePredicates::get_predicates(int32_t min_version) cons
     return ret;
 }
 
+std::vector<int32_t> DeletePredicates::get_versions(int32_t min_version) const {
+    std::vector<int32_t> versions;
+    for (const auto& vp : _version_predicates) {
+        if (vp._version >= min_version) {
+            versions.push_back(vp._version);
+        }
+    }
+    return versions;
+}
+
+Status parse_delete_predicate(const Tablet& tablet, const DeletePredicatePB& pred_pb, ConjunctivePredicates* preds,
+                              std::vector<const ColumnPredicate*>* owned) {
+    PredicateParser pred_parser(tablet.tablet_schema());
+    for (int i = 0; i != pred_pb.sub_predicates_size(); ++i) {
+        TCondition cond;
+        if (!DeleteHandler::parse_condition(pred_pb.sub_predicates(i), &cond)) {
+            LOG(WARNING) << "invalid delete condition: " << pred_pb.sub_predicates(i) << "]";
+            return Status::InternalError("invalid delete condition string");
+        }
+        size_t idx = tablet.tablet_schema().field_index(cond.column_name);
+        if (idx >= tablet.num_key_columns() && tablet.keys_type() != DUP_KEYS) {
+            LOG(WARNING) << "ignore delete condition of non-key column: " << pred_pb.sub_predicates(i);
+            continue;
+        }
+        ColumnPredicate* pred = pred_parser.parse(cond);
+        if (pred == nullptr) {
+            LOG(WARNING) << "failed to parse delete condition.column_name[" << cond.column_name
+                         << "], condition_op[" << cond.condition_op << "], condition_values["
+                         << cond.condition_values[0] << "].";
+            continue;
+        }
+        preds->add(pred);
+        // save for memory release.
+        owned->emplace_back(pred);
+    }
+
+    for (int i = 0; i != pred_pb.in_predicates_size(); ++i) {
+        TCondition cond;
+        const InPredicatePB& in_predicate = pred_pb.in_predicates(i);
+        cond.__set_column_name(in_predicate.column_name());
+        if (in_predicate.is_not_in()) {
+            cond.__set_condition_op("!*=");
+        } else {
+            cond.__set_condition_op("*=");
+        }
+        for (const auto& value : in_predicate.values()) {
+            cond.condition_values.push_back(value);
+        }
+        ColumnPredicate* pred = pred_parser.parse(cond);
+        if (pred == nullptr) {
+            LOG(WARNING) << "failed to parse delete condition.column_name[" << cond.column_name
+                         << "], condition_op[" << cond.condition_op << "], condition_values["
+                         << cond.condition_values[0] << "].";
+            continue;
+        }
+        preds->add(pred);
+        // save for memory release.
+        owned->emplace_back(pred);
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks::vectorized
@@ -4,9 +4,15 @@
 
 #include <vector>
 
+#include "common/status.h"
 #include "storage/vectorized/conjunctive_predicates.h"
 #include "storage/vectorized/disjunctive_predicates.h"
 
+namespace starrocks {
+class DeletePredicatePB;
+class Tablet;
+} // namespace starrocks
+
 namespace starrocks::vectorized {
 
 // DeletePredicates is a set of delete predicates of different versions.
@@ -18,6 +24,9 @@ public:
     // Return all the predicates with version greater than or equal to |min_version|.
     DisjunctivePredicates get_predicates(int32_t min_version) const;
 
+    // Return the versions of the predicates returned by get_predicates(|min_version|) in ascending order.
+    std::vector<int32_t> get_versions(int32_t min_version) const;
+
 private:
     struct VersionAndPredicate {
         VersionAndPredicate(int32_t v, ConjunctivePredicates preds) : _version(v), _preds(std::move(preds)) {}
@@ -32,4 +41,10 @@ private:
     std::vector<VersionAndPredicate> _version_predicates;
 };
 
+// Parse the delete predicate |pred_pb| of |tablet| into |preds|. The parsed predicates are also appended to |owned|
+// and should be deleted by the caller. The conditions of the value columns are ignored unless the tablet has
+// duplicate keys.
+Status parse_delete_predicate(const Tablet& tablet, const DeletePredicatePB& pred_pb, ConjunctivePredicates* preds,
+                              std::vector<const ColumnPredicate*>* owned);
+
 } // namespace starrocks::vectorized
@@ -2,19 +2,27 @@
 
 #include "storage/vectorized/delta_writer.h"
 
+#include "env/env.h"
+#include "runtime/exec_env.h"
 #include "storage/data_dir.h"
 #include "storage/memtable_flush_executor.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_factory.h"
+#include "storage/rowset/rowset_meta.h"
 #include "storage/schema.h"
 #include "storage/schema_change.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet_updates.h"
 #include "storage/update_manager.h"
 #include "storage/vectorized/memtable.h"
+#include "util/runtime_profile.h"
+#include "util/time.h"
 
 namespace starrocks {
 namespace vectorized {
 
+static const std::string LOAD_OP_COLUMN = "__op";
+
 Status DeltaWriter::open(WriteRequest* req, MemTracker* mem_tracker, DeltaWriter** writer) {
     *writer = new DeltaWriter(req, mem_tracker, StorageEngine::instance());
     return Status::OK();
@@ -126,6 +134,12 @@ Status DeltaWriter::init() {
     writer_context.txn_id = _req.txn_id;
     writer_context.load_id = _req.load_id;
     writer_context.segments_overlap = OVERLAPPING;
+    if (_storage_engine->memtable_flush_executor() != nullptr) {
+        writer_context.encode_pool = _storage_engine->memtable_flush_executor()->encode_pool();
+    }
+    if (_tablet->keys_type() == KeysType::PRIMARY_KEYS) {
+        RETURN_IF_ERROR(_init_partial_update(&writer_context));
+    }
     OLAPStatus olap_status = RowsetFactory::create_rowset_writer(writer_context, &_rowset_writer);
     if (olap_status != OLAPStatus::OLAP_SUCCESS) {
         std::stringstream ss;
@@ -134,7 +148,7 @@ Status DeltaWriter::init() {
         return Status::InternalError(ss.str());
     }
 
-    _tablet_schema = &(_tablet->tablet_schema());
+    _tablet_schema = _partial_update_schema != nullptr ? _partial_update_schema.get() : &(_tablet->tablet_schema());
     _reset_mem_table();
 
     // create flush handler
@@ -150,6 +164,37 @@ Status DeltaWriter::init() {
     return Status::OK();
 }
 
+Status DeltaWriter::_init_partial_update(RowsetWriterContext* writer_context) {
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    size_t num_slots = _req.slots->size();
+    if (num_slots > 0 && _req.slots->back()->col_name() == LOAD_OP_COLUMN) {
+        num_slots--;
+    }
+    if (num_slots >= tablet_schema.num_columns()) {
+        return Status::OK();
+    }
+    // slots are in order of tablet's schema, and the keys are required to locate the old rows
+    std::vector<uint32_t> column_ids(num_slots);
+    for (size_t i = 0; i < num_slots; i++) {
+        const auto& name = (*_req.slots)[i]->col_name();
+        size_t cid = tablet_schema.field_index(name);
+        if (cid >= tablet_schema.num_columns() || (i > 0 && cid <= column_ids[i - 1])) {
+            return Status::InvalidArgument(Substitute("partial update column $0 of tablet $1 is not in order of schema",
+                                                      name, _tablet->tablet_id()));
+        }
+        column_ids[i] = cid;
+    }
+    size_t num_keys = tablet_schema.num_key_columns();
+    if (num_slots < num_keys || column_ids[num_keys - 1] != num_keys - 1) {
+        return Status::InvalidArgument(
+                Substitute("partial update of tablet $0 lacks primary key columns", _tablet->tablet_id()));
+    }
+    _partial_update_schema = tablet_schema.select_columns(column_ids);
+    writer_context->partial_update_tablet_schema = _partial_update_schema.get();
+    writer_context->partial_update_column_ids = std::move(column_ids);
+    return Status::OK();
+}
+
 Status DeltaWriter::write(Chunk* chunk, const uint32_t* indexes, uint32_t from, uint32_t size) {
     if (_is_cancelled) {
         return Status::OK();
@@ -158,7 +203,14 @@ Status DeltaWriter::write(Chunk* chunk, const uint32_t* indexes, uint32_t from,
         RETURN_IF_ERROR(init());
     }
 
-    bool flush = _mem_table->insert(chunk, indexes, from, size);
+    if (_memtable_first_write_ms == 0) {
+        _memtable_first_write_ms = MonotonicMillis();
+    }
+    bool flush;
+    {
+        SCOPED_RAW_TIMER(&_memtable_insert_ns);
+        flush = _mem_table->insert(chunk, indexes, from, size);
+    }
 
     if (flush || _mem_table->is_full()) {
         RETURN_IF_ERROR(_flush_memtable_async());
@@ -170,7 +222,10 @@ Status DeltaWriter::write(Chunk* chunk, const uint32_t* indexes, uint32_t from,
 }
 
 Status DeltaWriter::_flush_memtable_async() {
-    RETURN_IF_ERROR(_mem_table->finalize());
+    {
+        SCOPED_RAW_TIMER(&_memtable_sort_ns);
+        RETURN_IF_ERROR(_mem_table->finalize());
+    }
     return _flush_token->submit(_mem_table);
 }
 
@@ -207,9 +262,14 @@ Status DeltaWriter::wait_memtable_flushed() {
     return Status::OK();
 }
 
+int64_t DeltaWriter::flush_ns() const {
+    return _flush_token != nullptr ? _flush_token->get_stats().flush_time_ns : 0;
+}
+
 void DeltaWriter::_reset_mem_table() {
     _mem_table = std::make_shared<MemTable>(_tablet->tablet_id(), _tablet_schema, _req.slots, _rowset_writer.get(),
                                             _mem_tracker.get());
+    _memtable_first_write_ms = 0;
 }
 
 Status DeltaWriter::close() {
@@ -225,6 +285,11 @@ Status DeltaWriter::close() {
         RETURN_IF_ERROR(init());
     }
 
+    if (_req.is_secondary_replica) {
+        // the data is written by the primary replica
+        _mem_table.reset();
+        return Status::OK();
+    }
     RETURN_IF_ERROR(_flush_memtable_async());
     _mem_table.reset();
     return Status::OK();
@@ -242,10 +307,15 @@ Status DeltaWriter::close_wait(google::protobuf::RepeatedPtrField<PTabletInfo>*
     }
     DCHECK_EQ(_mem_tracker->consumption(), 0);
 
-    // use rowset meta manager to save meta
-    _cur_rowset = _rowset_writer->build();
-    if (_cur_rowset == nullptr) {
-        return Status::InternalError("Fail to build rowset");
+    if (_req.is_secondary_replica) {
+        RETURN_IF_ERROR(wait_segments());
+        _cur_rowset = _replica_rowset;
+    } else {
+        // use rowset meta manager to save meta
+        _cur_rowset = _rowset_writer->build();
+        if (_cur_rowset == nullptr) {
+            return Status::InternalError("Fail to build rowset");
+        }
     }
     OLAPStatus res = _storage_engine->txn_manager()->commit_txn(_req.partition_id, _tablet, _req.txn_id, _req.load_id,
                                                                 _cur_rowset, false);
@@ -270,6 +340,11 @@ Status DeltaWriter::close_wait(google::protobuf::RepeatedPtrField<PTabletInfo>*
 }
 
 Status DeltaWriter::cancel() {
+    {
+        std::lock_guard<std::mutex> l(_replica_lock);
+        _replica_cancelled = true;
+    }
+    _replica_cond.notify_all();
     if (_is_cancelled) {
         return Status::OK();
     }
@@ -286,6 +361,97 @@ Status DeltaWriter::cancel() {
     return Status::OK();
 }
 
+Status DeltaWriter::add_segment(const PTabletWriterAddSegmentRequest& request) {
+    std::lock_guard<std::mutex> l(_replica_lock);
+    if (!_is_init || !_req.is_secondary_replica) {
+        return Status::InternalError(
+                Substitute("tablet $0 is not a secondary replica to receive segments", _req.tablet_id));
+    }
+    if (_replica_done || _replica_cancelled) {
+        return Status::InternalError(Substitute("tablet $0 is no longer receiving segments", _req.tablet_id));
+    }
+    Status st;
+    if (request.primary_failed()) {
+        st = Status::InternalError(Substitute("primary replica of tablet $0 failed", _req.tablet_id));
+    } else {
+        st = _add_segment_file(request);
+        if (st.ok() && request.has_rowset_meta()) {
+            st = _build_replica_rowset(request.rowset_meta());
+        }
+    }
+    if (!st.ok() || request.primary_failed() || request.has_rowset_meta()) {
+        _replica_file.reset();
+        _replica_done = true;
+        _replica_status = st;
+        _replica_cond.notify_all();
+    }
+    return st;
+}
+
+Status DeltaWriter::_add_segment_file(const PTabletWriterAddSegmentRequest& request) {
+    if (!request.has_segment_id()) {
+        return Status::OK();
+    }
+    if (request.offset() != _replica_file_offset) {
+        return Status::InternalError(Substitute("unexpected offset $0 of segment $1 of tablet $2, expected $3",
+                                                request.offset(), request.segment_id(), _req.tablet_id,
+                                                _replica_file_offset));
+    }
+    if (_replica_file == nullptr) {
+        const RowsetId& rowset_id = _rowset_writer->rowset_id();
+        std::string path =
+                request.is_delete_file()
+                        ? BetaRowset::segment_del_file_path(_tablet->tablet_path(), rowset_id, request.segment_id())
+                        : BetaRowset::segment_file_path(_tablet->tablet_path(), rowset_id, request.segment_id());
+        RETURN_IF_ERROR(Env::Default()->new_writable_file(path, &_replica_file));
+    }
+    RETURN_IF_ERROR(_replica_file->append(request.data()));
+    _replica_file_offset += request.data().size();
+    if (request.file_eof()) {
+        RETURN_IF_ERROR(_replica_file->sync());
+        RETURN_IF_ERROR(_replica_file->close());
+        _replica_file.reset();
+        _replica_file_offset = 0;
+    }
+    return Status::OK();
+}
+
+Status DeltaWriter::_build_replica_rowset(const std::string& rowset_meta) {
+    if (_replica_file != nullptr) {
+        return Status::InternalError(Substitute("incomplete segment file of tablet $0", _req.tablet_id));
+    }
+    RowsetMetaPB meta_pb;
+    if (!meta_pb.ParseFromString(rowset_meta)) {
+        return Status::Corruption(Substitute("bad rowset meta of the primary replica of tablet $0", _req.tablet_id));
+    }
+    auto meta = std::make_shared<RowsetMeta>();
+    meta->init_from_pb(meta_pb);
+    // the files received are named after the rowset id of this replica
+    meta->set_rowset_id(_rowset_writer->rowset_id());
+    meta->set_tablet_uid(_tablet->tablet_uid());
+    OLAPStatus st = RowsetFactory::create_rowset(ExecEnv::GetInstance()->tablet_meta_mem_tracker(),
+                                                 &_tablet->tablet_schema(), _tablet->tablet_path(), meta,
+                                                 &_replica_rowset);
+    if (st != OLAP_SUCCESS) {
+        return Status::InternalError(Substitute("Fail to create rowset of tablet $0, err=$1", _req.tablet_id,
+                                                static_cast<int>(st)));
+    }
+    return Status::OK();
+}
+
+Status DeltaWriter::wait_segments() {
+    std::unique_lock<std::mutex> l(_replica_lock);
+    auto timeout = std::chrono::seconds(config::single_replica_load_wait_timeout_s);
+    if (!_replica_cond.wait_for(l, timeout, [this] { return _replica_done || _replica_cancelled; })) {
+        return Status::TimedOut(
+                Substitute("wait for the segments of tablet $0 from the primary replica timeout", _req.tablet_id));
+    }
+    if (!_replica_done) {
+        return Status::Cancelled("Cancelled");
+    }
+    return _replica_status;
+}
+
 int64_t DeltaWriter::mem_consumption() const {
     return _mem_tracker->consumption();
 }
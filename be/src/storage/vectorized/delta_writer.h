@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+
 #include "column/vectorized_fwd.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "storage/rowset/rowset_writer.h"
@@ -15,6 +18,7 @@ class Schema;
 class StorageEngine;
 class TupleDescriptor;
 class SlotDescriptor;
+class WritableFile;
 
 namespace vectorized {
 
@@ -32,6 +36,9 @@ struct WriteRequest {
     TupleDescriptor* tuple_desc;
     // slots are in order of tablet's schema
     const std::vector<SlotDescriptor*>* slots;
+    // in a single replica load, a secondary replica writes no data but receives the files of the rowset of the
+    // primary replica by add_segment(), and commits them when being closed.
+    bool is_secondary_replica = false;
 };
 
 // Writer for a particular (load, index, tablet).
@@ -66,6 +73,30 @@ public:
 
     int64_t mem_consumption() const;
 
+    // The time of the first write to the current memtable by MonotonicMillis(), 0 if it is empty.
+    int64_t memtable_first_write_ms() const { return _memtable_first_write_ms; }
+
+    bool is_secondary_replica() const { return _req.is_secondary_replica; }
+
+    // The rowset committed by close_wait().
+    const RowsetSharedPtr& committed_rowset() const { return _cur_rowset; }
+
+    // The time spent in inserting the rows into the memtables, and in sorting and aggregating the full ones.
+    int64_t memtable_insert_ns() const { return _memtable_insert_ns; }
+    int64_t memtable_sort_ns() const { return _memtable_sort_ns; }
+    // The time spent in flushing the memtables, complete after close_wait().
+    int64_t flush_ns() const;
+
+    // Write a part of the files of the rowset of the primary replica, which must have been initialized as a
+    // secondary replica. Thread-safe with wait_segments().
+    Status add_segment(const PTabletWriterAddSegmentRequest& request);
+
+    // Wait until the rowset of the primary replica is received, which close_wait() of a secondary replica commits,
+    // or the primary replica failed, or this writer is cancelled, or config::single_replica_load_wait_timeout_s
+    // passed. Thread-safe with add_segment() and cancel(), and to be called without external synchronization to
+    // leave them unblocked.
+    Status wait_segments();
+
 private:
     DeltaWriter(WriteRequest* req, MemTracker* parent, StorageEngine* storage_engine);
 
@@ -76,6 +107,13 @@ private:
 
     void _reset_mem_table();
 
+    // A load of a primary key tablet whose slots are a part of the columns of the tablet is a partial update, which
+    // writes the columns of the slots only, see RowsetWriterContext::partial_update_tablet_schema.
+    Status _init_partial_update(RowsetWriterContext* writer_context);
+
+    Status _add_segment_file(const PTabletWriterAddSegmentRequest& request);
+    Status _build_replica_rowset(const std::string& rowset_meta);
+
     bool _is_init = false;
     WriteRequest _req;
     TabletSharedPtr _tablet;
@@ -83,12 +121,28 @@ private:
     std::unique_ptr<RowsetWriter> _rowset_writer;
     std::shared_ptr<MemTable> _mem_table;
     const TabletSchema* _tablet_schema;
+    // the schema of the updated columns of a partial update
+    std::unique_ptr<TabletSchema> _partial_update_schema;
     bool _delta_written_success;
 
     StorageEngine* _storage_engine;
     std::unique_ptr<FlushToken> _flush_token;
     std::unique_ptr<MemTracker> _mem_tracker;
     bool _is_cancelled = false;
+    std::atomic<int64_t> _memtable_first_write_ms{0};
+    int64_t _memtable_insert_ns = 0;
+    int64_t _memtable_sort_ns = 0;
+
+    // the files of the primary replica received by a secondary replica, in the rowset id of _rowset_writer
+    std::mutex _replica_lock;
+    std::condition_variable _replica_cond;
+    std::unique_ptr<WritableFile> _replica_file;
+    int64_t _replica_file_offset = 0;
+    // set once all the files are received or the primary replica failed
+    bool _replica_done = false;
+    bool _replica_cancelled = false;
+    Status _replica_status;
+    RowsetSharedPtr _replica_rowset;
 };
 
 } // namespace vectorized
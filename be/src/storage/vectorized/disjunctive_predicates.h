@@ -34,6 +34,9 @@ public:
     void add(const ConjunctivePredicates& pred) { _preds.emplace_back(pred); }
     void add(ConjunctivePredicates&& pred) { _preds.emplace_back(std::move(pred)); }
 
+    // Remove the |idx|-th conjunction, e.g. whose rows have been filtered out otherwise.
+    void erase(size_t idx) { _preds.erase(_preds.begin() + idx); }
+
     size_t size() const { return _preds.size(); }
 
     bool empty() const { return _preds.empty(); }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "column/array_set.h"
 #include "column/hash_set.h"
 #include "storage/types.h"
 #include "util/string_parser.hpp"
@@ -13,29 +14,6 @@ struct ItemHashSet : public PhSet<T> {
     bool contains(const T& v) const { return PhSet<T>::contains(v); }
 };
 
-template <typename T, size_t N>
-struct ArraySet : public std::array<T, N> {
-    static_assert(N <= 4 && N >= 1);
-
-    bool contains(const T& v) const noexcept {
-        const T* const ptr = this->data();
-        if constexpr (N == 1) {
-            return v == ptr[0];
-        }
-        if constexpr (N == 2) {
-            return (v == ptr[0]) | (v == ptr[1]);
-        }
-        if constexpr (N == 3) {
-            return (v == ptr[0]) | (v == ptr[1]) | (v == ptr[2]);
-        }
-        if constexpr (N == 4) {
-            return (v == ptr[0]) | (v == ptr[1]) | (v == ptr[2]) | (v == ptr[3]);
-        }
-        CHECK(false) << "unreachable path";
-        return false;
-    }
-};
-
 namespace predicate_internal {
 
 template <typename T>
@@ -72,17 +50,6 @@ private:
         }
     };
 
-    template <size_t N>
-    struct convert_to_container<ArraySet<T, N>> {
-        ArraySet<T, N> operator()(const std::vector<T>& elems) {
-            ArraySet<T, N> c;
-            for (size_t i = 0; i < N; i++) {
-                c[i] = elems[i];
-            }
-            return c;
-        }
-    };
-
     std::vector<T> _elements;
 };
 
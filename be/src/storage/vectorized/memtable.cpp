@@ -2,10 +2,13 @@
 
 #include "storage/vectorized/memtable.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "column/nullable_column.h"
 #include "column/type_traits.h"
 #include "common/logging.h"
+#include "storage/key_coder.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/schema.h"
@@ -20,6 +23,9 @@ namespace starrocks::vectorized {
 static const string LOAD_OP_COLUMN = "__op";
 static const size_t kPrimaryKeyLimitSize = 128;
 
+std::atomic<int64_t> MemTable::_s_num_memtables{0};
+std::atomic<int64_t> MemTable::_s_load_mem_limit{-1};
+
 MemTable::MemTable(int64_t tablet_id, const TabletSchema* tablet_schema, const std::vector<SlotDescriptor*>* slot_descs,
                    RowsetWriter* rowset_writer, MemTracker* mem_tracker)
         : _tablet_id(tablet_id),
@@ -28,6 +34,7 @@ MemTable::MemTable(int64_t tablet_id, const TabletSchema* tablet_schema, const s
           _keys_type(tablet_schema->keys_type()),
           _rowset_writer(rowset_writer),
           _aggregator(nullptr) {
+    _s_num_memtables++;
     _mem_tracker = std::make_unique<MemTracker>(-1, "memtable", mem_tracker, true);
     _vectorized_schema = ChunkHelper::convert_schema_to_format_v2(*tablet_schema);
     if (_keys_type == KeysType::PRIMARY_KEYS && _slot_descs->back()->col_name() == LOAD_OP_COLUMN) {
@@ -49,6 +56,7 @@ MemTable::MemTable(int64_t tablet_id, const TabletSchema* tablet_schema, const s
 
 MemTable::~MemTable() {
     _mem_tracker->release(_mem_tracker->consumption());
+    _s_num_memtables--;
 }
 
 size_t MemTable::memory_usage() const {
@@ -77,7 +85,17 @@ size_t MemTable::write_buffer_size() const {
 }
 
 bool MemTable::is_full() const {
-    return write_buffer_size() >= config::write_buffer_size;
+    return write_buffer_size() >= max_write_buffer_size();
+}
+
+size_t MemTable::max_write_buffer_size() {
+    int64_t size = config::write_buffer_size;
+    int64_t limit = _s_load_mem_limit;
+    int64_t num_memtables = _s_num_memtables;
+    if (limit > 0 && num_memtables > 0 && limit / num_memtables < size) {
+        size = std::max(limit / num_memtables, std::min<int64_t>(config::min_write_buffer_size, size));
+    }
+    return size;
 }
 
 bool MemTable::insert(Chunk* chunk, const uint32_t* indexes, uint32_t from, uint32_t size) {
@@ -252,7 +270,9 @@ void MemTable::_sort(bool is_final) {
     for (uint32_t i = 0; i < _chunk->num_rows(); ++i) {
         _permutations[i] = {i, i};
     }
-    if (_tablet_schema->num_key_columns() <= 3) {
+    if (_sort_chunk_by_normalized_keys()) {
+        // sorted
+    } else if (_tablet_schema->num_key_columns() <= 3) {
         _sort_chunk_by_columns();
     } else {
         _sort_chunk_by_rows();
@@ -481,6 +501,109 @@ private:
         break;                                                                                                      \
     }
 
+// The bytes the values of |type| are encoded into by KeyCoder, 0 if the values are not of a fixed width of at most
+// 8 bytes.
+static size_t normalized_key_width(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_BOOL:
+    case OLAP_FIELD_TYPE_TINYINT:
+        return 1;
+    case OLAP_FIELD_TYPE_SMALLINT:
+        return 2;
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_DATE_V2:
+        return 4;
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_TIMESTAMP:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+// If the key columns are encoded by KeyCoder into no more than 8 bytes in all, which is the common case of the
+// integer and date keys, the encoded keys are concatenated into one uint64_t per row, in which the order of the
+// integers is the order of the rows, and the rows are sorted by the LSD radix sort of these integers, byte by byte.
+// The radix sort is stable, so the rows of the same keys stay in the order of insertion as the other sorts.
+bool MemTable::_sort_chunk_by_normalized_keys() {
+    const size_t num_key_columns = _tablet_schema->num_key_columns();
+    size_t key_width = 0;
+    for (size_t i = 0; i < num_key_columns; ++i) {
+        size_t width = normalized_key_width(_vectorized_schema.field(i)->type()->type());
+        if (width == 0) {
+            return false;
+        }
+        // one more byte for the null flag
+        key_width += width + _chunk->get_column_by_index(i)->is_nullable();
+    }
+    if (key_width > sizeof(uint64_t)) {
+        return false;
+    }
+
+    struct NormalizedKey {
+        uint64_t key;
+        uint32_t index_in_chunk;
+    };
+    const size_t num_rows = _chunk->num_rows();
+    std::vector<NormalizedKey> keys(num_rows);
+    for (uint32_t i = 0; i < num_rows; ++i) {
+        keys[i] = {0, i};
+    }
+    std::string buf;
+    for (size_t i = 0; i < num_key_columns; ++i) {
+        const FieldType type = _vectorized_schema.field(i)->type()->type();
+        const KeyCoder* coder = get_key_coder(type);
+        const size_t width = normalized_key_width(type);
+        const Column* column = _chunk->get_column_by_index(i).get();
+        const uint8_t* values = column->raw_data();
+        const uint8_t* nulls = nullptr;
+        if (column->is_nullable()) {
+            nulls = down_cast<const NullableColumn*>(column)->immutable_null_column_data().data();
+        }
+        for (size_t j = 0; j < num_rows; ++j) {
+            uint64_t key = keys[j].key;
+            if (nulls != nullptr) {
+                // null goes first, as NullableColumn::compare_at
+                key = (key << 8) | (nulls[j] ? 0 : 1);
+                if (nulls[j]) {
+                    keys[j].key = key << (8 * width);
+                    continue;
+                }
+            }
+            buf.clear();
+            coder->full_encode_ascending(values + j * width, &buf);
+            for (char c : buf) {
+                key = (key << 8) | static_cast<uint8_t>(c);
+            }
+            keys[j].key = key;
+        }
+    }
+
+    std::vector<NormalizedKey> sorted_keys(num_rows);
+    for (size_t byte = 0; byte < key_width && num_rows > 0; ++byte) {
+        const size_t shift = byte * 8;
+        uint32_t offsets[257] = {0};
+        for (const NormalizedKey& k : keys) {
+            offsets[((k.key >> shift) & 0xFF) + 1]++;
+        }
+        if (offsets[((keys[0].key >> shift) & 0xFF) + 1] == num_rows) {
+            // the same byte of all the rows
+            continue;
+        }
+        for (size_t b = 1; b < 257; ++b) {
+            offsets[b] += offsets[b - 1];
+        }
+        for (const NormalizedKey& k : keys) {
+            sorted_keys[offsets[(k.key >> shift) & 0xFF]++] = k;
+        }
+        keys.swap(sorted_keys);
+    }
+    for (uint32_t i = 0; i < num_rows; ++i) {
+        _permutations[i] = {keys[i].index_in_chunk, i};
+    }
+    return true;
+}
+
 void MemTable::_sort_chunk_by_columns() {
     for (int i = _tablet_schema->num_key_columns() - 1; i >= 0; --i) {
         Column* column = _chunk->get_column_by_index(i).get();
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <ostream>
 
 #include "column/chunk.h"
@@ -38,10 +39,20 @@ public:
 
     bool is_full() const;
 
+    // The write buffer size at which the memtables are full: config::write_buffer_size, or less once the memtables of
+    // all the tablets loaded concurrently would take more than the memory limit of the loads, but not less than
+    // config::min_write_buffer_size, so that a memtable is flushed into a segment of the size the loads can afford
+    // rather than of whatever it has when the limit is exceeded.
+    static size_t max_write_buffer_size();
+
+    // Set the memory limit shared by the memtables of all the loads, -1 if unlimited.
+    static void set_load_mem_limit(int64_t limit) { _s_load_mem_limit = limit; }
+
 private:
     void _merge();
 
     void _sort(bool is_final);
+    bool _sort_chunk_by_normalized_keys();
     void _sort_chunk_by_columns();
     void _sort_chunk_by_rows();
     void _append_to_sorted_chunk(Chunk* src, Chunk* dest);
@@ -91,6 +102,10 @@ private:
     size_t _chunk_bytes_usage = 0;
     size_t _aggregator_memory_usage = 0;
     size_t _aggregator_bytes_usage = 0;
+
+    // The memtables alive, one per tablet being loaded plus the ones being flushed.
+    static std::atomic<int64_t> _s_num_memtables;
+    static std::atomic<int64_t> _s_load_mem_limit;
 }; // class MemTable
 
 } // namespace vectorized
@@ -2,8 +2,8 @@
 
 #include "storage/vectorized/merge_iterator.h"
 
+#include <algorithm>
 #include <memory>
-#include <queue>
 #include <vector>
 
 #include "boost/heap/skew_heap.hpp"
@@ -33,19 +33,38 @@ public:
     explicit ComparableChunk(Chunk* chunk, size_t order, size_t key_columns)
             : _chunk(chunk), _order(order), _key_columns(key_columns) {}
 
-    bool operator>(const ComparableChunk& rhs) const {
-        DCHECK_EQ(_key_columns, rhs._key_columns);
-        int r = compare_chunk(_key_columns, *_chunk, _compared_row, *rhs._chunk, rhs._compared_row);
-        return (r > 0) | ((r == 0) & (_order > rhs._order));
-    }
+    bool operator<(const ComparableChunk& rhs) const { return _row_less(_compared_row, rhs); }
 
     // return true iff all rows in |this| chunk are less than those in |rhs|, i.e, if
     // last row in |this| chunk is less than the first row in |rhs|.
     // assume both |this| and |rhs| are not empty.
-    bool less_than_all(const ComparableChunk& rhs) {
-        size_t last_row = _chunk->num_rows() - 1;
-        int r = compare_chunk(_key_columns, *_chunk, last_row, *rhs._chunk, rhs._compared_row);
-        return (r < 0) | ((r == 0) & (_order < rhs._order));
+    bool less_than_all(const ComparableChunk& rhs) { return _row_less(_chunk->num_rows() - 1, rhs); }
+
+    // return the number of rows from the compared row, at most |max_rows|, which are less than the compared
+    // row of |rhs|. the rows are galloped and then binary searched, so that a long run costs O(log(run)).
+    // assume the compared row of |this| is less than that of |rhs|.
+    size_t rows_less_than(const ComparableChunk& rhs, size_t max_rows) const {
+        DCHECK(*this < rhs);
+        size_t lo = 1;
+        size_t hi = std::min(max_rows, remaining_rows());
+        // rows in [0, lo) are less than |rhs|, and so is not row |hi| if |hi| is a remaining row.
+        for (size_t step = 1; lo < hi; step <<= 1) {
+            size_t probe = std::min(lo + step - 1, hi - 1);
+            if (!_row_less(_compared_row + probe, rhs)) {
+                hi = probe;
+                break;
+            }
+            lo = probe + 1;
+        }
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (_row_less(_compared_row + mid, rhs)) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
     }
 
     size_t compared_row() const { return _compared_row; }
@@ -55,7 +74,13 @@ public:
     size_t remaining_rows() const { return _chunk->num_rows() - _compared_row; }
 
 private:
-    friend class HeapMergeIterator;
+    friend class LoserTreeMergeIterator;
+
+    bool _row_less(size_t row, const ComparableChunk& rhs) const {
+        DCHECK_EQ(_key_columns, rhs._key_columns);
+        int r = compare_chunk(_key_columns, *_chunk, row, *rhs._chunk, rhs._compared_row);
+        return (r < 0) | ((r == 0) & (_order < rhs._order));
+    }
 
     Chunk* _chunk;
     // used to determinate the order of two rows when their key columns are all equals.
@@ -64,9 +89,14 @@ private:
     uint16_t _compared_row = 0;
 };
 
-class HeapMergeIterator final : public ChunkIterator {
+// LoserTreeMergeIterator merges the children by a loser tree of their current chunks. The winner of the tree,
+// i.e, the chunk with the least compared row, is compared with the runner-up, which is the least one of the
+// losers on the path from the winner's leaf to the root. All the rows of the winner less than the compared row
+// of the runner-up are appended at once, and only then is the tree replayed from the winner's leaf. So the
+// merge costs O(log(children)) per run instead of per row when the children have few overlapping rows.
+class LoserTreeMergeIterator final : public ChunkIterator {
 public:
-    explicit HeapMergeIterator(std::vector<ChunkIteratorPtr> children)
+    explicit LoserTreeMergeIterator(std::vector<ChunkIteratorPtr> children)
             : ChunkIterator(children[0]->schema(), children[0]->chunk_size()),
               _children(std::move(children)),
               _chunk_pool(_children.size()) {
@@ -86,9 +116,13 @@ public:
             CHECK_LT(_schema.field(i)->id(), _schema.field(i + 1)->id());
         }
 #endif
+        _leaves.reserve(_children.size());
+        for (size_t i = 0; i < _children.size(); i++) {
+            _leaves.emplace_back(nullptr, i, _schema.num_key_fields());
+        }
     }
 
-    ~HeapMergeIterator() override { close(); }
+    ~LoserTreeMergeIterator() override { close(); }
 
     void close() override;
 
@@ -98,34 +132,86 @@ protected:
     Status do_get_next(Chunk* chunk) override;
 
 private:
-    template <typename T, typename Container = std::vector<T>>
-    using MinPriorityQueue = std::priority_queue<T, Container, std::greater<T>>;
-    using ChunkHeap = MinPriorityQueue<ComparableChunk>;
-
     Status _init();
-    Status _fill_heap(size_t child);
+    Status _fill_leaf(size_t child);
     void _close_child(size_t child);
 
+    // return true iff the leaf |lhs| comes before the leaf |rhs|, a leaf without chunk comes after all the others.
+    bool _leaf_less(size_t lhs, size_t rhs) const {
+        if (_leaves[lhs]._chunk == nullptr) {
+            return false;
+        }
+        return _leaves[rhs]._chunk == nullptr || _leaves[lhs] < _leaves[rhs];
+    }
+    // build the subtree of |node| and return the winner of it.
+    size_t _build_tree(size_t node);
+    // replay the matches on the path from the leaf |child| to the root after its compared row has changed.
+    void _replay(size_t child);
+    // return the least leaf except the winner, or _leaves.size() if there isn't any.
+    size_t _runner_up() const;
+
     std::vector<ChunkIteratorPtr> _children;
     std::vector<ChunkPtr> _chunk_pool;
-    ChunkHeap _heap;
+    // the current chunk of each child, whose |_chunk| is nullptr once the child is exhausted.
+    std::vector<ComparableChunk> _leaves;
+    // the leaf of the child |i| is the node |_leaves.size() + i|, and the node |i| in [1, _leaves.size())
+    // is an internal node whose children are the node |2i| and |2i+1|.
+    // |_losers[0]| is the winner of the whole tree, and |_losers[i]| is the loser of the match at the node |i|.
+    std::vector<size_t> _losers;
     size_t _merged_rows = 0;
     bool _inited = false;
 };
 
-inline Status HeapMergeIterator::_init() {
+inline Status LoserTreeMergeIterator::_init() {
     DCHECK(_chunk_size > 0);
     DCHECK_EQ(_children.size(), _chunk_pool.size());
     for (size_t i = 0; i < _children.size(); i++) {
         _chunk_pool[i] = ChunkHelper::new_chunk(_schema, _chunk_size);
         CurrentMemTracker::consume(_chunk_pool[i]->memory_usage());
-        RETURN_IF_ERROR(_fill_heap(i));
+        RETURN_IF_ERROR(_fill_leaf(i));
     }
+    _losers.resize(_leaves.size());
+    _losers[0] = _build_tree(1);
     _inited = true;
     return Status::OK();
 }
 
-inline Status HeapMergeIterator::do_get_next(Chunk* chunk) {
+inline size_t LoserTreeMergeIterator::_build_tree(size_t node) {
+    if (node >= _leaves.size()) {
+        return node - _leaves.size();
+    }
+    size_t left = _build_tree(2 * node);
+    size_t right = _build_tree(2 * node + 1);
+    if (_leaf_less(right, left)) {
+        _losers[node] = left;
+        return right;
+    }
+    _losers[node] = right;
+    return left;
+}
+
+inline void LoserTreeMergeIterator::_replay(size_t child) {
+    size_t winner = child;
+    for (size_t node = (_leaves.size() + child) / 2; node > 0; node /= 2) {
+        if (_leaf_less(_losers[node], winner)) {
+            std::swap(_losers[node], winner);
+        }
+    }
+    _losers[0] = winner;
+}
+
+inline size_t LoserTreeMergeIterator::_runner_up() const {
+    size_t runner_up = _leaves.size();
+    for (size_t node = (_leaves.size() + _losers[0]) / 2; node > 0; node /= 2) {
+        size_t loser = _losers[node];
+        if (_leaves[loser]._chunk != nullptr && (runner_up == _leaves.size() || _leaf_less(loser, runner_up))) {
+            runner_up = loser;
+        }
+    }
+    return runner_up;
+}
+
+inline Status LoserTreeMergeIterator::do_get_next(Chunk* chunk) {
     if (!_inited) {
         RETURN_IF_ERROR(_init());
     }
@@ -133,35 +219,44 @@ inline Status HeapMergeIterator::do_get_next(Chunk* chunk) {
     size_t prev_mem_usage = chunk->memory_usage();
     Status st;
 
-    while (!_heap.empty() && rows < _chunk_size) {
-        ComparableChunk min_chunk = _heap.top();
-        _heap.pop();
+    while (rows < _chunk_size) {
+        size_t winner = _losers[0];
+        ComparableChunk& min_chunk = _leaves[winner];
+        if (min_chunk._chunk == nullptr) {
+            // all the children are exhausted.
+            break;
+        }
         DCHECK_GT(min_chunk.remaining_rows(), 0);
 
+        size_t runner_up = _runner_up();
+        bool overlapping = runner_up < _leaves.size();
         size_t offset = min_chunk.compared_row();
         // check whether |min_chunk| has overlapping with others.
-        if (offset == 0 && (_heap.empty() || min_chunk.less_than_all(_heap.top()))) {
+        if (offset == 0 && (!overlapping || min_chunk.less_than_all(_leaves[runner_up]))) {
             if (rows == 0) {
                 chunk->swap_chunk(*min_chunk._chunk);
-                return _fill_heap(min_chunk._order);
+                RETURN_IF_ERROR(_fill_leaf(winner));
+                _replay(winner);
+                return Status::OK();
             } else {
                 // retrieve |min_chunk| next time to avoid memory copy.
-                _heap.push(min_chunk);
                 break;
             }
         }
 
-        chunk->append(*min_chunk._chunk, offset, 1);
-        min_chunk.advance(1);
-        rows += 1;
-        if (min_chunk.remaining_rows() > 0) {
-            _heap.push(min_chunk);
-        } else {
-            st = _fill_heap(min_chunk._order);
+        // append the run of |min_chunk| before the runner-up.
+        size_t run = overlapping ? min_chunk.rows_less_than(_leaves[runner_up], _chunk_size - rows)
+                                 : std::min(min_chunk.remaining_rows(), _chunk_size - rows);
+        chunk->append(*min_chunk._chunk, offset, run);
+        min_chunk.advance(run);
+        rows += run;
+        if (min_chunk.remaining_rows() == 0) {
+            st = _fill_leaf(winner);
             if (!st.ok()) {
                 break;
             }
         }
+        _replay(winner);
     }
     CurrentMemTracker::consume(static_cast<int64_t>(chunk->memory_usage()) - static_cast<int64_t>(prev_mem_usage));
     if (!st.ok()) {
@@ -173,7 +268,7 @@ inline Status HeapMergeIterator::do_get_next(Chunk* chunk) {
     }
 }
 
-inline Status HeapMergeIterator::_fill_heap(size_t child) {
+inline Status LoserTreeMergeIterator::_fill_leaf(size_t child) {
     Chunk* chunk = _chunk_pool[child].get();
 
     CurrentMemTracker::release(chunk->memory_usage());
@@ -183,7 +278,7 @@ inline Status HeapMergeIterator::_fill_heap(size_t child) {
     Status st = _children[child]->get_next(chunk);
     if (st.ok()) {
         DCHECK_GT(chunk->num_rows(), 0u);
-        _heap.push(ComparableChunk{chunk, child, _schema.num_key_fields()});
+        _leaves[child] = ComparableChunk{chunk, child, _schema.num_key_fields()};
     } else if (st.is_end_of_file()) {
         // ignore Status::EndOfFile.
         _close_child(child);
@@ -194,10 +289,11 @@ inline Status HeapMergeIterator::_fill_heap(size_t child) {
     return Status::OK();
 }
 
-inline void HeapMergeIterator::_close_child(size_t child) {
+inline void LoserTreeMergeIterator::_close_child(size_t child) {
     if (_chunk_pool[child] == nullptr) {
         return;
     }
+    _leaves[child]._chunk = nullptr;
     CurrentMemTracker::release(_chunk_pool[child]->memory_usage());
     _chunk_pool[child].reset();
     _merged_rows += _children[child]->merged_rows();
@@ -205,7 +301,7 @@ inline void HeapMergeIterator::_close_child(size_t child) {
     _children[child].reset();
 }
 
-inline void HeapMergeIterator::close() {
+inline void LoserTreeMergeIterator::close() {
     DCHECK_EQ(_children.size(), _chunk_pool.size());
     for (size_t i = 0; i < _children.size(); i++) {
         _close_child(i);
@@ -225,7 +321,7 @@ ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& childre
     const static size_t kMaxChildrenSize = std::numeric_limits<uint16_t>::max();
 
     if (children.size() <= kMaxChildrenSize) {
-        return std::make_shared<HeapMergeIterator>(children);
+        return std::make_shared<LoserTreeMergeIterator>(children);
     }
     std::vector<ChunkIteratorPtr> sub_merge_iterators;
     sub_merge_iterators.reserve((children.size() + kMaxChildrenSize - 1) / kMaxChildrenSize);
@@ -2,8 +2,11 @@
 
 #include "storage/vectorized/reader.h"
 
+#include <algorithm>
+
 #include <column/datum_convert.h>
 
+#include "common/config.h"
 #include "gutil/stl_util.h"
 #include "service/backend_options.h"
 #include "storage/vectorized/aggregate_iterator.h"
@@ -14,11 +17,38 @@
 #include "storage/vectorized/empty_iterator.h"
 #include "storage/vectorized/merge_iterator.h"
 #include "storage/vectorized/predicate_parser.h"
+#include "storage/vectorized/runtime_predicate.h"
 #include "storage/vectorized/seek_range.h"
 #include "storage/vectorized/union_iterator.h"
+#include "storage/tablet.h"
+#include "storage/tablet_updates.h"
 
 namespace starrocks::vectorized {
 
+// PointLookupIterator returns the rows read by the primary index.
+class PointLookupIterator final : public ChunkIterator {
+public:
+    PointLookupIterator(Schema schema, int chunk_size, ChunkPtr rows)
+            : ChunkIterator(std::move(schema), chunk_size), _rows(std::move(rows)) {}
+
+    void close() override { _rows.reset(); }
+
+protected:
+    Status do_get_next(Chunk* chunk) override {
+        if (_rows == nullptr || _offset >= _rows->num_rows()) {
+            return Status::EndOfFile("end of point lookup iterator");
+        }
+        size_t n = std::min<size_t>(_chunk_size, _rows->num_rows() - _offset);
+        chunk->append(*_rows, _offset, n);
+        _offset += n;
+        return Status::OK();
+    }
+
+private:
+    ChunkPtr _rows;
+    size_t _offset = 0;
+};
+
 Reader::Reader(Schema schema) : ChunkIterator(std::move(schema)), _mempool(&_memtracker) {}
 
 void Reader::close() {
@@ -31,9 +61,13 @@ void Reader::close() {
 
 Status Reader::init(const ReaderParams& read_params) {
     read_params.check_validation();
-    if (read_params.reader_type != ReaderType::READER_QUERY && !is_compaction(read_params.reader_type)) {
+    if (read_params.reader_type != ReaderType::READER_QUERY && read_params.reader_type != ReaderType::READER_CHECKSUM &&
+        !is_compaction(read_params.reader_type)) {
         return Status::NotSupported("reader type not supported now");
     }
+    if (read_params.reader_type == ReaderType::READER_QUERY) {
+        read_params.tablet->record_query();
+    }
     RETURN_IF_ERROR(_init_load_bf_columns(read_params));
 
     Status status = _init_collector(read_params);
@@ -53,6 +87,14 @@ Status Reader::_get_segment_iterators(const TabletSharedPtr& tablet, const Versi
                                       const RowsetReadOptions& options, std::vector<ChunkIteratorPtr>* iters) {
     SCOPED_RAW_TIMER(&_stats.capture_rowset_ns);
 
+    if (options.rowid_range_option != nullptr) {
+        // The rowset has been captured with |version| when the tablet is split.
+        if (options.reader_type == READER_QUERY) {
+            options.rowid_range_option->rowset->record_read();
+        }
+        return options.rowid_range_option->rowset->get_segment_iterators(schema(), options, iters);
+    }
+
     StatusOr<Tablet::IteratorList> res;
     res = tablet->capture_segment_iterators(version, schema(), options);
     if (!res.ok()) {
@@ -83,12 +125,39 @@ Status Reader::_init_collector(const ReaderParams& params) {
     rs_opts.profile = params.profile;
     rs_opts.use_page_cache = params.use_page_cache;
     rs_opts.tablet_schema = &(params.tablet->tablet_schema());
+    rs_opts.tablet = params.tablet;
+    rs_opts.rowid_range_option = params.rowid_range_option;
+    if (params.runtime_predicate != nullptr) {
+        // Like the pushed down predicates, only the key columns of the aggregate and unique keys tablets
+        // could prune the rows before they are merged.
+        const TabletSchema& schema = params.tablet->tablet_schema();
+        size_t index = schema.field_index(params.runtime_predicate->column_name());
+        if (index < schema.num_columns() &&
+            (keys_type == KeysType::PRIMARY_KEYS ||
+             schema.column(index).aggregation() == FieldAggregationMethod::OLAP_FIELD_AGGREGATION_NONE)) {
+            rs_opts.runtime_predicate = params.runtime_predicate;
+        }
+    }
+    if (params.metadata_scan && params.reader_type == READER_QUERY && params.predicates.empty() &&
+        (keys_type == KeysType::DUP_KEYS || keys_type == KeysType::PRIMARY_KEYS)) {
+        // The rows of the aggregate and unique keys tablets must be merged before they are counted.
+        rs_opts.metadata_scan = true;
+        rs_opts.metadata_min_max_columns = params.metadata_min_max_columns;
+    }
     if (keys_type == KeysType::PRIMARY_KEYS) {
         rs_opts.is_primary_keys = true;
         rs_opts.version = params.version.second;
         rs_opts.meta = params.tablet->data_dir()->get_meta();
     }
 
+    if (keys_type == KeysType::PRIMARY_KEYS && params.reader_type == READER_QUERY &&
+        params.rowid_range_option == nullptr && !rs_opts.metadata_scan) {
+        Status st = _init_point_lookup(params, rs_opts.ranges);
+        if (!st.is_not_supported()) {
+            return st;
+        }
+    }
+
     std::vector<ChunkIteratorPtr> seg_iters;
     RETURN_IF_ERROR(_get_segment_iterators(params.tablet, params.version, rs_opts, &seg_iters));
 
@@ -209,8 +278,6 @@ Status Reader::_init_load_bf_columns(const ReaderParams& read_params) {
 }
 
 Status Reader::_init_delete_predicates(const ReaderParams& params, DeletePredicates* dels) {
-    PredicateParser pred_parser(params.tablet->tablet_schema());
-
     Status st;
 
     params.tablet->obtain_header_rdlock();
@@ -221,59 +288,70 @@ Status Reader::_init_delete_predicates(const ReaderParams& params, DeletePredica
         }
 
         ConjunctivePredicates conjunctions;
-        for (int i = 0; i != pred_pb.sub_predicates_size(); ++i) {
-            TCondition cond;
-            if (!DeleteHandler::parse_condition(pred_pb.sub_predicates(i), &cond)) {
-                LOG(WARNING) << "invalid delete condition: " << pred_pb.sub_predicates(i) << "]";
-                st = Status::InternalError("invalid delete condition string");
-                break;
-            }
-            size_t idx = params.tablet->tablet_schema().field_index(cond.column_name);
-            if (idx >= params.tablet->num_key_columns() && params.tablet->keys_type() != DUP_KEYS) {
-                LOG(WARNING) << "ignore delete condition of non-key column: " << pred_pb.sub_predicates(i);
-                continue;
-            }
-            ColumnPredicate* pred = pred_parser.parse(cond);
-            if (pred == nullptr) {
-                LOG(WARNING) << "failed to parse delete condition.column_name[" << cond.column_name
-                             << "], condition_op[" << cond.condition_op << "], condition_values["
-                             << cond.condition_values[0] << "].";
-                continue;
-            }
-            conjunctions.add(pred);
-            // save for memory release.
-            _predicate_free_list.emplace_back(pred);
+        st = parse_delete_predicate(*params.tablet, pred_pb, &conjunctions, &_predicate_free_list);
+        if (!st.ok()) {
+            break;
         }
+        dels->add(pred_pb.version(), conjunctions);
+    }
 
-        for (int i = 0; i != pred_pb.in_predicates_size(); ++i) {
-            TCondition cond;
-            const InPredicatePB& in_predicate = pred_pb.in_predicates(i);
-            cond.__set_column_name(in_predicate.column_name());
-            if (in_predicate.is_not_in()) {
-                cond.__set_condition_op("!*=");
-            } else {
-                cond.__set_condition_op("*=");
-            }
-            for (const auto& value : in_predicate.values()) {
-                cond.condition_values.push_back(value);
+    params.tablet->release_header_lock();
+    return st;
+}
+
+// Read the rows of the primary keys tablet by the primary index, if |ranges| are all the equalities of the full keys.
+// Return NotSupported if they're not, or the index cannot serve them, and the rows should be read by a scan.
+Status Reader::_init_point_lookup(const ReaderParams& params, const std::vector<SeekRange>& ranges) {
+    const size_t num_keys = params.tablet->num_key_columns();
+    if (ranges.empty() || ranges.size() > config::primary_key_point_lookup_max_keys) {
+        return Status::NotSupported("not a point lookup");
+    }
+    for (const SeekRange& range : ranges) {
+        const SeekTuple& lower = range.lower();
+        const SeekTuple& upper = range.upper();
+        if (!range.inclusive_lower() || !range.inclusive_upper() || lower.columns() != num_keys ||
+            upper.columns() != num_keys) {
+            return Status::NotSupported("not a point lookup");
+        }
+        for (size_t i = 0; i < num_keys; i++) {
+            if (lower.get(i).is_null() || upper.get(i).is_null() ||
+                lower.schema().field(i)->type()->cmp(lower.get(i), upper.get(i)) != 0) {
+                return Status::NotSupported("not a point lookup");
             }
-            ColumnPredicate* pred = pred_parser.parse(cond);
-            if (pred == nullptr) {
-                LOG(WARNING) << "failed to parse delete condition.column_name[" << cond.column_name
-                             << "], condition_op[" << cond.condition_op << "], condition_values["
-                             << cond.condition_values[0] << "].";
-                continue;
+        }
+    }
+    // The rows are filtered by the predicates after they're read, so their columns must be read too.
+    ConjunctivePredicates preds;
+    for (const auto& [cid, pred_list] : _pushdown_predicates) {
+        const Fields& fields = _schema.fields();
+        if (std::none_of(fields.begin(), fields.end(), [cid = cid](const FieldPtr& f) { return f->id() == cid; })) {
+            return Status::NotSupported("predicate column not read");
+        }
+        for (const ColumnPredicate* pred : pred_list) {
+            if (!pred->is_index_filter_only()) {
+                preds.add(pred);
             }
-            conjunctions.add(pred);
-            // save for memory release.
-            _predicate_free_list.emplace_back(pred);
         }
-
-        dels->add(pred_pb.version(), conjunctions);
     }
 
-    params.tablet->release_header_lock();
-    return st;
+    ChunkPtr keys = ChunkHelper::new_chunk(ranges[0].lower().schema(), ranges.size());
+    for (const SeekRange& range : ranges) {
+        for (size_t i = 0; i < num_keys; i++) {
+            keys->get_column_by_index(i)->append_datum(range.lower().get(i));
+        }
+    }
+    ChunkPtr rows = ChunkHelper::new_chunk(_schema, ranges.size());
+    std::vector<uint32_t> found;
+    RETURN_IF_ERROR(params.tablet->updates()->get_rows_by_keys(params.version.second, *keys, _schema, rows.get(),
+                                                              &found));
+    _stats.raw_rows_read += rows->num_rows();
+    if (!preds.empty() && rows->num_rows() > 0) {
+        Buffer<uint8_t> selection(rows->num_rows());
+        preds.evaluate(rows.get(), selection.data());
+        rows->filter(selection);
+    }
+    _collect_iter = std::make_shared<PointLookupIterator>(_schema, params.chunk_size, std::move(rows));
+    return Status::OK();
 }
 
 // convert an OlapTuple to SeekTuple.
@@ -42,6 +42,7 @@ private:
     Status _init_load_bf_columns(const ReaderParams& read_params);
     Status _init_delete_predicates(const ReaderParams& read_params, DeletePredicates* dels);
     Status _init_collector(const ReaderParams& read_params);
+    Status _init_point_lookup(const ReaderParams& read_params, const std::vector<SeekRange>& ranges);
     Status _to_seek_tuple(const TabletSchema& tablet_schema, const OlapTuple& input, SeekTuple* tuple);
     Status _get_segment_iterators(const TabletSharedPtr& tablet, const Version& version,
                                   const RowsetReadOptions& options, std::vector<ChunkIteratorPtr>* iters);
@@ -9,6 +9,7 @@
 #include "storage/tablet.h"
 #include "storage/tuple.h"
 #include "storage/vectorized/chunk_iterator.h"
+#include "storage/vectorized/rowid_range_option.h"
 
 namespace starrocks {
 
@@ -18,6 +19,7 @@ class RuntimeState;
 namespace vectorized {
 
 class ColumnPredicate;
+class RuntimePredicate;
 
 // Params for reader
 struct ReaderParams {
@@ -48,6 +50,18 @@ struct ReaderParams {
 
     RuntimeProfile* profile = nullptr;
 
+    // If not null, only the rowid range of one segment is read instead of the whole tablet.
+    RowidRangeOptionPtr rowid_range_option = nullptr;
+
+    // If not null, the data pages are pruned by its conditions published while reading.
+    std::shared_ptr<RuntimePredicate> runtime_predicate = nullptr;
+
+    // If true, the rows of the segments without deleted rows are generated from their row counts and zone maps
+    // instead of the data pages, which is only valid for count(*), and min and max of |metadata_min_max_columns|
+    // on the duplicate and primary keys tablets without any predicate.
+    bool metadata_scan = false;
+    std::vector<ColumnId> metadata_min_max_columns;
+
     void check_validation() const;
     std::string to_string() const;
     int chunk_size = 1024;
@@ -0,0 +1,66 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/vectorized/rowid_range_option.h"
+
+#include <shared_mutex>
+
+#include "gutil/casts.h"
+#include "storage/rowset/beta_rowset.h"
+#include "storage/tablet.h"
+#include "storage/tablet_updates.h"
+
+namespace starrocks::vectorized {
+
+static Status capture_rowsets(const TabletSharedPtr& tablet, int64_t version, std::vector<RowsetSharedPtr>* rowsets) {
+    if (tablet->updates() != nullptr) {
+        return tablet->updates()->get_applied_rowsets(version, rowsets);
+    }
+    std::shared_lock rdlock(tablet->get_header_lock());
+    if (tablet->capture_consistent_rowsets(Version(0, version), rowsets) != OLAP_SUCCESS) {
+        return Status::InternalError("capture consistent rowsets failed");
+    }
+    return Status::OK();
+}
+
+Status split_tablet_by_rowid_ranges(const TabletSharedPtr& tablet, int64_t version, bool skip_aggregation,
+                                    int64_t split_rows, std::vector<RowidRangeOptionPtr>* ranges) {
+    KeysType keys_type = tablet->tablet_schema().keys_type();
+    if (keys_type != DUP_KEYS && keys_type != PRIMARY_KEYS && !skip_aggregation) {
+        return Status::NotSupported("the rows of the tablet must be merged");
+    }
+
+    std::vector<RowsetSharedPtr> rowsets;
+    RETURN_IF_ERROR(capture_rowsets(tablet, version, &rowsets));
+    int64_t num_rows = 0;
+    for (const auto& rowset : rowsets) {
+        num_rows += rowset->num_rows();
+    }
+    if (num_rows <= split_rows) {
+        return Status::NotSupported("the tablet is too small to split");
+    }
+
+    for (auto& rowset : rowsets) {
+        if (rowset->empty()) {
+            continue;
+        }
+        RETURN_IF_ERROR(rowset->load());
+        for (const auto& segment : down_cast<BetaRowset*>(rowset.get())->segments()) {
+            if (segment->num_rows() == 0) {
+                continue;
+            }
+            RETURN_IF_ERROR(segment->load_index());
+            const uint32_t num_rows_per_block = segment->num_rows_per_block();
+            const uint32_t num_blocks_per_range =
+                    std::max<uint32_t>(1, split_rows / std::max<uint32_t>(1, num_rows_per_block));
+            const uint32_t range_rows = num_blocks_per_range * std::max<uint32_t>(1, num_rows_per_block);
+            for (uint32_t begin = 0; begin < segment->num_rows(); begin += range_rows) {
+                uint32_t end = std::min<uint64_t>(static_cast<uint64_t>(begin) + range_rows, segment->num_rows());
+                ranges->emplace_back(
+                        std::make_shared<RowidRangeOption>(rowset, segment->id(), SparseRange(begin, end)));
+            }
+        }
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,40 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "storage/rowset/rowset.h"
+#include "storage/vectorized/range.h"
+
+namespace starrocks {
+class Tablet;
+using TabletSharedPtr = std::shared_ptr<Tablet>;
+} // namespace starrocks
+
+namespace starrocks::vectorized {
+
+// RowidRangeOption restricts the reader to the rows in |rowid_range| of the segment |segment_id|
+// of |rowset|, by which a tablet is split into multiple scan tasks of a proper size.
+// |rowset| is captured when the tablet is split, and is read instead of capturing the rowsets
+// of the tablet again, so that it would not be removed by compaction in between.
+struct RowidRangeOption {
+    RowidRangeOption(RowsetSharedPtr rowset, uint32_t segment_id, SparseRange rowid_range)
+            : rowset(std::move(rowset)), segment_id(segment_id), rowid_range(std::move(rowid_range)) {}
+
+    RowsetSharedPtr rowset;
+    uint32_t segment_id;
+    SparseRange rowid_range;
+};
+
+using RowidRangeOptionPtr = std::shared_ptr<RowidRangeOption>;
+
+// Split the rowsets of |tablet| at |version| into the rowid ranges of no more than |split_rows| rows in one
+// segment, the boundaries of which are aligned to the blocks of the short key index, so that a range doesn't
+// seek the blocks of its neighbours. Return NotSupported if the tablet has no more than |split_rows| rows, or its
+// rows must be merged across segments (AGG_KEYS and UNIQUE_KEYS without |skip_aggregation|).
+Status split_tablet_by_rowid_ranges(const TabletSharedPtr& tablet, int64_t version, bool skip_aggregation,
+                                    int64_t split_rows, std::vector<RowidRangeOptionPtr>* ranges);
+
+} // namespace starrocks::vectorized
@@ -2,6 +2,9 @@
 
 #include "storage/vectorized/rowset_merger.h"
 
+#include <limits>
+#include <numeric>
+
 #include "gutil/stl_util.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/beta_rowset_writer.h"
@@ -32,6 +35,8 @@ struct MergeEntry {
     const T* pk_start = nullptr;
     uint32_t cur_segment_idx = 0;
     uint32_t rowset_seg_id = 0;
+    // the index of the input rowset.
+    uint16_t order = 0;
     ColumnPtr chunk_pk_column;
     ChunkPtr chunk;
     vector<ChunkIteratorPtr> segment_itrs;
@@ -129,6 +134,53 @@ struct MergeEntry {
     }
 };
 
+// The rows of the columns of a group read from an input rowset, in the same order as its rows read by the keys.
+struct ColumnGroupEntry {
+    ChunkPtr chunk;
+    // the rows of |chunk| before |offset| have been merged.
+    size_t offset = 0;
+    uint32_t cur_segment_idx = 0;
+    vector<ChunkIteratorPtr> segment_itrs;
+
+    ~ColumnGroupEntry() { close(); }
+
+    void close() {
+        chunk.reset();
+        for (auto& itr : segment_itrs) {
+            if (itr) {
+                itr->close();
+                itr.reset();
+            }
+        }
+        STLClearObject(&segment_itrs);
+    }
+
+    // Make sure there are rows of |chunk| not merged, unless all rows have been read.
+    Status fill() {
+        while (offset >= chunk->num_rows()) {
+            if (cur_segment_idx >= segment_itrs.size()) {
+                return Status::EndOfFile("End of column group entry iterator");
+            }
+            auto& itr = segment_itrs[cur_segment_idx];
+            if (!itr) {
+                cur_segment_idx++;
+                continue;
+            }
+            chunk->reset();
+            offset = 0;
+            auto st = itr->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                itr->close();
+                itr.reset();
+                cur_segment_idx++;
+            } else if (!st.ok()) {
+                return st;
+            }
+        }
+        return Status::OK();
+    }
+};
+
 template <class T>
 struct MergeEntryCmp {
     bool operator()(const MergeEntry<T>* lhs, const MergeEntry<T>* rhs) const {
@@ -154,7 +206,9 @@ public:
         return Status::OK();
     }
 
-    Status get_next(Chunk* chunk, vector<uint32_t>* rssids) {
+    // Merge the next rows into |chunk|, and the rssids and the orders of the input rowsets of the rows into
+    // |rssids| and |sources| if it is not null.
+    Status get_next(Chunk* chunk, vector<uint32_t>* rssids, vector<uint16_t>* sources = nullptr) {
         size_t nrow = 0;
         while (!_heap.empty() && nrow < _chunk_size) {
             MergeEntry<T>& top = *_heap.top();
@@ -165,6 +219,9 @@ public:
                 if (nrow == 0 && top.at_start()) {
                     chunk->swap_chunk(*top.chunk);
                     rssids->insert(rssids->end(), chunk->num_rows(), top.rowset_seg_id);
+                    if (sources != nullptr) {
+                        sources->insert(sources->end(), chunk->num_rows(), top.order);
+                    }
                     top.pk_cur = top.pk_last + 1;
                     return _fill_heap(&top);
                 } else {
@@ -173,6 +230,9 @@ public:
                     auto start_offset = top.offset(top.pk_cur);
                     chunk->append(*top.chunk, start_offset, nappend);
                     rssids->insert(rssids->end(), nappend, top.rowset_seg_id);
+                    if (sources != nullptr) {
+                        sources->insert(sources->end(), nappend, top.order);
+                    }
                     top.pk_cur += nappend;
                     if (top.pk_cur > top.pk_last) {
                         //LOG(INFO) << "  append all " << nappend << "  get_next batch";
@@ -190,6 +250,9 @@ public:
                 nrow++;
                 top.pk_cur++;
                 rssids->push_back(top.rowset_seg_id);
+                if (sources != nullptr) {
+                    sources->push_back(top.order);
+                }
                 if (top.pk_cur > top.pk_last) {
                     auto start_offset = top.offset(start);
                     auto end_offset = top.offset(top.pk_cur);
@@ -220,27 +283,24 @@ public:
         return Status::EndOfFile("merge end");
     }
 
-    Status do_merge(Tablet& tablet, int64_t version, const Schema& schema, const vector<RowsetSharedPtr>& rowsets,
-                    RowsetWriter* writer, const MergeConfig& cfg) {
-        MonotonicStopWatch timer;
-        timer.start();
-        _chunk_size = cfg.chunk_size;
-        OlapReaderStatistics stats;
+    // Init the entries of |rowsets| reading the columns of |schema|, which starts with the key columns.
+    Status _init_entries(Tablet& tablet, int64_t version, const Schema& schema, const vector<RowsetSharedPtr>& rowsets,
+                         OlapReaderStatistics* stats, size_t* total_input_size) {
         std::unique_ptr<vectorized::Column> pk_column;
         if (schema.num_key_fields() > 1) {
             if (!PrimaryKeyEncoder::create_column(schema, &pk_column).ok()) {
                 LOG(FATAL) << "create column for primary key encoder failed";
             }
         }
-        size_t total_input_size = 0;
         for (int i = 0; i < rowsets.size(); i++) {
-            total_input_size += rowsets[i]->data_disk_size();
+            *total_input_size += rowsets[i]->data_disk_size();
             _entries.emplace_back(new MergeEntry<T>());
             MergeEntry<T>& entry = *_entries.back();
+            entry.order = i;
             entry.rowset_release_guard = std::make_unique<RowsetReleaseGuard>(rowsets[i]);
             auto rowset = rowsets[i].get();
             auto beta_rowset = down_cast<BetaRowset*>(rowset);
-            auto res = beta_rowset->get_segment_iterators2(schema, tablet.data_dir()->get_meta(), version, &stats);
+            auto res = beta_rowset->get_segment_iterators2(schema, tablet.data_dir()->get_meta(), version, stats);
             if (!res.ok()) {
                 return res.status();
             }
@@ -263,6 +323,22 @@ public:
                 _heap.push(&entry);
             }
         }
+        return Status::OK();
+    }
+
+    Status do_merge(Tablet& tablet, int64_t version, const Schema& schema, const vector<RowsetSharedPtr>& rowsets,
+                    RowsetWriter* writer, const MergeConfig& cfg) {
+        const size_t num_value_fields = schema.num_fields() - schema.num_key_fields();
+        if (cfg.max_columns_per_group > 0 && num_value_fields > cfg.max_columns_per_group &&
+            rowsets.size() <= std::numeric_limits<uint16_t>::max()) {
+            return _do_merge_vertically(tablet, version, schema, rowsets, writer, cfg);
+        }
+        MonotonicStopWatch timer;
+        timer.start();
+        _chunk_size = cfg.chunk_size;
+        OlapReaderStatistics stats;
+        size_t total_input_size = 0;
+        RETURN_IF_ERROR(_init_entries(tablet, version, schema, rowsets, &stats, &total_input_size));
 
         auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
 
@@ -322,6 +398,142 @@ public:
         return Status::OK();
     }
 
+    // Merge the key columns of |rowsets| first, recording the input rowset of each merged row, and then read each
+    // group of the value columns of all the rowsets and write them in the order of the merged rows, so that the
+    // memory of the merge doesn't grow with the number of the columns.
+    Status _do_merge_vertically(Tablet& tablet, int64_t version, const Schema& schema,
+                                const vector<RowsetSharedPtr>& rowsets, RowsetWriter* writer, const MergeConfig& cfg) {
+        MonotonicStopWatch timer;
+        timer.start();
+        _chunk_size = cfg.chunk_size;
+        const size_t num_key_fields = schema.num_key_fields();
+
+        // 1. merge the key columns.
+        Fields key_fields(schema.fields().begin(), schema.fields().begin() + num_key_fields);
+        Schema key_schema(key_fields);
+        std::vector<uint32_t> key_column_indexes(num_key_fields);
+        std::iota(key_column_indexes.begin(), key_column_indexes.end(), 0);
+        OlapReaderStatistics stats;
+        size_t total_input_size = 0;
+        RETURN_IF_ERROR(_init_entries(tablet, version, key_schema, rowsets, &stats, &total_input_size));
+
+        // the order of the input rowset of each merged row.
+        vector<uint16_t> row_sources;
+        auto char_field_indexes = ChunkHelper::get_char_field_indexes(key_schema);
+        size_t total_chunk = 0;
+        auto chunk = ChunkHelper::new_chunk(key_schema, _chunk_size);
+        vector<uint32_t> rssids;
+        rssids.reserve(_chunk_size);
+        while (true) {
+            chunk->reset();
+            rssids.clear();
+            Status status = get_next(chunk.get(), &rssids, &row_sources);
+            if (!status.ok()) {
+                if (status.is_end_of_file()) {
+                    break;
+                } else {
+                    return Status::InternalError("reader get_next error.");
+                }
+            }
+            ChunkHelper::padding_char_columns(char_field_indexes, key_schema, tablet.tablet_schema(), chunk.get());
+            total_chunk++;
+            if (writer->add_columns_with_rssid(*chunk, key_column_indexes, rssids) != OLAP_SUCCESS) {
+                return Status::InternalError("writer add_columns_with_rssid error.");
+            }
+        }
+        if (writer->flush_columns() != OLAP_SUCCESS) {
+            return Status::InternalError("writer flush_columns error.");
+        }
+        const size_t total_rows = row_sources.size();
+        const size_t num_entries = _entries.size();
+        _entries.clear();
+
+        // 2. merge the value columns by groups in the order of |row_sources|.
+        for (size_t start = num_key_fields; start < schema.num_fields(); start += cfg.max_columns_per_group) {
+            const size_t end = std::min(schema.num_fields(), start + cfg.max_columns_per_group);
+            Fields group_fields(schema.fields().begin() + start, schema.fields().begin() + end);
+            Schema group_schema(group_fields);
+            std::vector<uint32_t> column_indexes(end - start);
+            std::iota(column_indexes.begin(), column_indexes.end(), start);
+
+            OlapReaderStatistics group_stats;
+            vector<std::unique_ptr<ColumnGroupEntry>> entries;
+            for (const auto& rowset : rowsets) {
+                auto beta_rowset = down_cast<BetaRowset*>(rowset.get());
+                auto res = beta_rowset->get_segment_iterators2(group_schema, tablet.data_dir()->get_meta(), version,
+                                                               &group_stats);
+                if (!res.ok()) {
+                    return res.status();
+                }
+                entries.emplace_back(new ColumnGroupEntry());
+                entries.back()->segment_itrs.swap(res.value());
+                entries.back()->chunk = ChunkHelper::new_chunk(group_schema, _chunk_size);
+            }
+
+            char_field_indexes = ChunkHelper::get_char_field_indexes(group_schema);
+            chunk = ChunkHelper::new_chunk(group_schema, _chunk_size);
+            size_t pos = 0;
+            while (pos < total_rows) {
+                chunk->reset();
+                while (chunk->num_rows() < _chunk_size && pos < total_rows) {
+                    ColumnGroupEntry& entry = *entries[row_sources[pos]];
+                    Status st = entry.fill();
+                    if (st.is_end_of_file()) {
+                        return Status::InternalError("fewer rows of the value columns than the keys");
+                    }
+                    RETURN_IF_ERROR(st);
+                    // the next rows of the same rowset in the merged order are its next rows.
+                    size_t limit = std::min({_chunk_size - chunk->num_rows(), entry.chunk->num_rows() - entry.offset,
+                                             total_rows - pos});
+                    size_t n = 1;
+                    while (n < limit && row_sources[pos + n] == row_sources[pos]) {
+                        n++;
+                    }
+                    chunk->append(*entry.chunk, entry.offset, n);
+                    entry.offset += n;
+                    pos += n;
+                }
+                ChunkHelper::padding_char_columns(char_field_indexes, group_schema, tablet.tablet_schema(),
+                                                  chunk.get());
+                if (writer->add_columns(*chunk, column_indexes, false) != OLAP_SUCCESS) {
+                    return Status::InternalError("writer add_columns error.");
+                }
+            }
+            if (writer->flush_columns() != OLAP_SUCCESS) {
+                return Status::InternalError("writer flush_columns error.");
+            }
+            if (group_stats.raw_rows_read - group_stats.rows_del_vec_filtered != total_rows) {
+                return Status::InternalError(Substitute("update compaction rows of the value columns($0) != rows($1)",
+                                                        group_stats.raw_rows_read - group_stats.rows_del_vec_filtered,
+                                                        total_rows));
+            }
+        }
+        if (writer->final_flush() != OLAP_SUCCESS) {
+            LOG(WARNING) << "failed to flush rowset when merging rowsets of tablet " + tablet.full_name();
+            return Status::InternalError("failed to flush rowset when merging rowsets of tablet error.");
+        }
+        timer.stop();
+        if (stats.raw_rows_read - stats.rows_del_vec_filtered != total_rows) {
+            string msg = Substitute("update compaction rows read($0) != rows written($1)",
+                                    stats.raw_rows_read - stats.rows_del_vec_filtered, total_rows);
+            DCHECK(false) << msg;
+            LOG(WARNING) << msg;
+        }
+        StarRocksMetrics::instance()->update_compaction_deltas_total.increment(rowsets.size());
+        StarRocksMetrics::instance()->update_compaction_bytes_total.increment(total_input_size);
+        StarRocksMetrics::instance()->update_compaction_outputs_total.increment(1);
+        StarRocksMetrics::instance()->update_compaction_outputs_bytes_total.increment(writer->total_data_size());
+        LOG(INFO) << "vertical compaction merge finished. tablet:" << tablet.tablet_id() << " #key:" << num_key_fields
+                  << " #column:" << schema.num_fields() << " input("
+                  << "entry=" << num_entries << " rows=" << stats.raw_rows_read
+                  << " del=" << stats.rows_del_vec_filtered
+                  << " bytes=" << PrettyPrinter::print(total_input_size, TUnit::BYTES) << ") output(rows=" << total_rows
+                  << " chunk=" << total_chunk
+                  << " bytes=" << PrettyPrinter::print(writer->total_data_size(), TUnit::BYTES)
+                  << ") duration: " << timer.elapsed_time() / 1000000 << "ms";
+        return Status::OK();
+    }
+
 private:
     size_t _chunk_size = 0;
     std::vector<std::unique_ptr<MergeEntry<T>>> _entries;
@@ -11,6 +11,9 @@ namespace vectorized {
 
 struct MergeConfig {
     size_t chunk_size;
+    // if positive, the rowsets with more value columns than this are merged vertically: the key columns first,
+    // and then the value columns in the order of the merged rows, by the groups of up to this number of columns.
+    size_t max_columns_per_group = 0;
 };
 
 // heap based rowset merger used for updatable tablet's compaction
@@ -0,0 +1,61 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gen_cpp/InternalService_types.h"
+
+namespace starrocks::vectorized {
+
+// RuntimePredicate is a condition on one column published while the scan is running by the operator above
+// it, e.g. the boundary of the rows kept by a top-n. Every producer only replaces its own condition by a more
+// selective one, so a row not satisfying all the conditions could be skipped. The segment iterators check
+// the version before reading the next rows, and prune the data pages left by the zone maps again once it
+// has changed.
+class RuntimePredicate {
+public:
+    explicit RuntimePredicate(std::string column_name) : _column_name(std::move(column_name)) {}
+
+    const std::string& column_name() const { return _column_name; }
+
+    // Replace the condition published by |producer| with |condition|. Thread-safe.
+    void update(size_t producer, TCondition condition) {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_conditions.size() <= producer) {
+            _conditions.resize(producer + 1);
+        }
+        _conditions[producer] = std::move(condition);
+        _version.fetch_add(1, std::memory_order_release);
+    }
+
+    // Increased by every update, 0 if no condition has been published.
+    int64_t version() const { return _version.load(std::memory_order_acquire); }
+
+    // The conditions published so far. Thread-safe.
+    std::vector<TCondition> conditions() const {
+        std::lock_guard<std::mutex> l(_mutex);
+        std::vector<TCondition> conditions;
+        for (const auto& condition : _conditions) {
+            if (!condition.condition_values.empty()) {
+                conditions.emplace_back(condition);
+            }
+        }
+        return conditions;
+    }
+
+private:
+    const std::string _column_name;
+
+    mutable std::mutex _mutex;
+    std::vector<TCondition> _conditions;
+    std::atomic<int64_t> _version{0};
+};
+
+using RuntimePredicatePtr = std::shared_ptr<RuntimePredicate>;
+
+} // namespace starrocks::vectorized
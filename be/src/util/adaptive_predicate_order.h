@@ -0,0 +1,123 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "common/config.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+// AdaptivePredicateOrder orders the conjunctive predicates of a filter, whose every predicate only sees the rows
+// left by the previous ones, by their measured cost per eliminated row. The predicates of the first
+// |adaptive_predicate_order_sample_chunks| chunks are measured in the current order, then sorted by their ns per
+// input row divided by the fraction of the input rows they eliminate, and measured again after every
+// |adaptive_predicate_order_resample_chunks| chunks, in case the data has changed.
+// Not thread-safe.
+class AdaptivePredicateOrder {
+public:
+    // Reset to the plan order of |num_preds| predicates if they are not |num_preds| ones.
+    void init(size_t num_preds) {
+        if (_order.size() == num_preds) {
+            return;
+        }
+        _order.resize(num_preds);
+        std::iota(_order.begin(), _order.end(), 0);
+        _stats.assign(num_preds, Stats());
+        _num_chunks = 0;
+        _sampling = num_preds > 1 && config::adaptive_predicate_order_sample_chunks > 0;
+    }
+
+    size_t size() const { return _order.size(); }
+
+    // The index of the |i|-th predicate to be evaluated.
+    size_t operator[](size_t i) const { return _order[i]; }
+
+    // Whether the predicates of the current chunk should be measured by add_sample().
+    bool sampling() const { return _sampling; }
+
+    void add_sample(size_t pred, size_t input_rows, size_t output_rows, int64_t ns) {
+        Stats& stats = _stats[pred];
+        stats.input_rows += input_rows;
+        stats.eliminated_rows += input_rows - output_rows;
+        stats.ns += ns;
+    }
+
+    // Evaluate |num_preds| predicates on |num_rows| rows by |eval(pred, num_rows)|, which returns the number of
+    // the rows left by the |pred|-th predicate, until no row is left. Returns the number of the rows left.
+    template <typename Eval>
+    size_t evaluate(size_t num_preds, size_t num_rows, Eval&& eval) {
+        init(num_preds);
+        for (size_t i = 0; num_rows > 0 && i < num_preds; ++i) {
+            size_t pred = _order[i];
+            if (_sampling) {
+                int64_t start = MonotonicNanos();
+                size_t input_rows = num_rows;
+                num_rows = eval(pred, num_rows);
+                add_sample(pred, input_rows, num_rows, MonotonicNanos() - start);
+            } else {
+                num_rows = eval(pred, num_rows);
+            }
+        }
+        next_chunk();
+        return num_rows;
+    }
+
+    // Called once the predicates of a chunk have been evaluated.
+    void next_chunk() {
+        if (_order.size() <= 1) {
+            return;
+        }
+        ++_num_chunks;
+        if (_sampling) {
+            if (_num_chunks >= config::adaptive_predicate_order_sample_chunks) {
+                _reorder();
+                _sampling = false;
+                _num_chunks = 0;
+            }
+        } else if (config::adaptive_predicate_order_sample_chunks > 0 &&
+                   config::adaptive_predicate_order_resample_chunks > 0 &&
+                   _num_chunks >= config::adaptive_predicate_order_resample_chunks) {
+            _stats.assign(_stats.size(), Stats());
+            _sampling = true;
+            _num_chunks = 0;
+        }
+    }
+
+private:
+    struct Stats {
+        size_t input_rows = 0;
+        size_t eliminated_rows = 0;
+        int64_t ns = 0;
+    };
+
+    void _reorder() {
+        std::vector<double> ranks(_stats.size());
+        for (size_t i = 0; i < _stats.size(); ++i) {
+            const Stats& stats = _stats[i];
+            if (stats.input_rows == 0) {
+                // not evaluated since no row was left, keep it after the measured ones.
+                ranks[i] = std::numeric_limits<double>::max();
+                continue;
+            }
+            double ns_per_row = static_cast<double>(std::max<int64_t>(stats.ns, 1)) / stats.input_rows;
+            double eliminated_ratio = static_cast<double>(stats.eliminated_rows) / stats.input_rows;
+            ranks[i] = ns_per_row / std::max(eliminated_ratio, 0.001);
+        }
+        std::stable_sort(_order.begin(), _order.end(), [&ranks](size_t lhs, size_t rhs) {
+            return ranks[lhs] < ranks[rhs];
+        });
+    }
+
+    std::vector<size_t> _order;
+    std::vector<Stats> _stats;
+    int64_t _num_chunks = 0;
+    bool _sampling = false;
+};
+
+} // namespace starrocks
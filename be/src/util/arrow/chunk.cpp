@@ -0,0 +1,254 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/arrow/chunk.h"
+
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/type.h>
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/decimalv3_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/descriptors.h"
+#include "runtime/vectorized/time_types.h"
+#include "util/arrow/utils.h"
+
+namespace starrocks {
+
+using strings::Substitute;
+using vectorized::ColumnHelper;
+
+static Status convert_chunk_type_to_arrow(const TypeDescriptor& type, std::shared_ptr<arrow::DataType>* result) {
+    switch (type.type) {
+    case TYPE_BOOLEAN:
+        *result = arrow::boolean();
+        break;
+    case TYPE_TINYINT:
+        *result = arrow::int8();
+        break;
+    case TYPE_SMALLINT:
+        *result = arrow::int16();
+        break;
+    case TYPE_INT:
+        *result = arrow::int32();
+        break;
+    case TYPE_BIGINT:
+        *result = arrow::int64();
+        break;
+    case TYPE_FLOAT:
+        *result = arrow::float32();
+        break;
+    case TYPE_DOUBLE:
+    case TYPE_TIME:
+        *result = arrow::float64();
+        break;
+    case TYPE_VARCHAR:
+    case TYPE_CHAR:
+    case TYPE_LARGEINT:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+        *result = arrow::utf8();
+        break;
+    case TYPE_DECIMALV2:
+        *result = std::make_shared<arrow::Decimal128Type>(27, 9);
+        break;
+    case TYPE_DECIMAL32:
+    case TYPE_DECIMAL64:
+    case TYPE_DECIMAL128:
+        *result = std::make_shared<arrow::Decimal128Type>(type.precision, type.scale);
+        break;
+    default:
+        return Status::InvalidArgument(Substitute("Unknown primitive type($0)", type.type));
+    }
+    return Status::OK();
+}
+
+Status convert_to_arrow_schema(const RowDescriptor& row_desc, const std::vector<ExprContext*>& output_expr_ctxs,
+                               std::shared_ptr<arrow::Schema>* result) {
+    std::vector<SlotDescriptor*> slot_descs;
+    for (auto tuple_desc : row_desc.tuple_descriptors()) {
+        for (auto desc : tuple_desc->slots()) {
+            slot_descs.push_back(desc);
+        }
+    }
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    for (size_t i = 0; i < output_expr_ctxs.size(); ++i) {
+        std::shared_ptr<arrow::DataType> type;
+        RETURN_IF_ERROR(convert_chunk_type_to_arrow(output_expr_ctxs[i]->root()->type(), &type));
+        std::string name = slot_descs.size() == output_expr_ctxs.size() ? slot_descs[i]->col_name()
+                                                                         : Substitute("col$0", i);
+        fields.push_back(arrow::field(std::move(name), std::move(type), true));
+    }
+    *result = arrow::schema(std::move(fields));
+    return Status::OK();
+}
+
+// Append the cells of |column|, whose data column is of |ColumnType|, to |builder| by |append|, and nulls for the
+// cells not |valid|.
+template <typename ColumnType, typename Builder, typename Append>
+static arrow::Status append_cells(const vectorized::Column* column, const uint8_t* valid, size_t num_rows,
+                                  Builder* builder, Append append) {
+    const auto& data_column = *down_cast<const ColumnType*>(ColumnHelper::get_data_column(column));
+    ARROW_RETURN_NOT_OK(builder->Reserve(num_rows));
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (valid != nullptr && !valid[i]) {
+            ARROW_RETURN_NOT_OK(builder->AppendNull());
+        } else {
+            ARROW_RETURN_NOT_OK(append(builder, data_column, i));
+        }
+    }
+    return arrow::Status::OK();
+}
+
+template <PrimitiveType Type, typename ArrowType>
+static arrow::Status convert_numbers(const vectorized::Column* column, const uint8_t* valid, size_t num_rows,
+                                     arrow::MemoryPool* pool, std::shared_ptr<arrow::Array>* out) {
+    using ColumnType = vectorized::RunTimeColumnType<Type>;
+    const auto& data = down_cast<const ColumnType*>(ColumnHelper::get_data_column(column))->get_data();
+    typename arrow::TypeTraits<ArrowType>::BuilderType builder(pool);
+    ARROW_RETURN_NOT_OK(builder.AppendValues(data.data(), num_rows, valid));
+    return builder.Finish(out);
+}
+
+template <PrimitiveType Type>
+static arrow::Status convert_decimals(const vectorized::Column* column, const uint8_t* valid, size_t num_rows,
+                                      const std::shared_ptr<arrow::DataType>& type, arrow::MemoryPool* pool,
+                                      std::shared_ptr<arrow::Array>* out) {
+    using ColumnType = vectorized::RunTimeColumnType<Type>;
+    arrow::Decimal128Builder builder(type, pool);
+    ARROW_RETURN_NOT_OK(append_cells<ColumnType>(
+            column, valid, num_rows, &builder, [](arrow::Decimal128Builder* builder, const ColumnType& data, size_t i) {
+                int128_t value;
+                if constexpr (Type == TYPE_DECIMALV2) {
+                    value = data.get_data()[i].value();
+                } else {
+                    value = data.get_data()[i];
+                }
+                auto high = static_cast<int64_t>(value >> 64);
+                auto low = static_cast<uint64_t>(value);
+                return builder->Append(arrow::Decimal128(high, low));
+            }));
+    return builder.Finish(out);
+}
+
+static arrow::Status convert_column(PrimitiveType type, const vectorized::Column* column, size_t num_rows,
+                                    const std::shared_ptr<arrow::DataType>& arrow_type, arrow::MemoryPool* pool,
+                                    std::shared_ptr<arrow::Array>* out) {
+    using namespace vectorized;
+    std::vector<uint8_t> valid_bytes;
+    const uint8_t* valid = nullptr;
+    if (column->is_nullable() && column->has_null()) {
+        const auto& nulls = down_cast<const NullableColumn*>(column)->immutable_null_column_data();
+        valid_bytes.resize(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            valid_bytes[i] = !nulls[i];
+        }
+        valid = valid_bytes.data();
+    }
+    switch (type) {
+    case TYPE_BOOLEAN:
+        return convert_numbers<TYPE_BOOLEAN, arrow::BooleanType>(column, valid, num_rows, pool, out);
+    case TYPE_TINYINT:
+        return convert_numbers<TYPE_TINYINT, arrow::Int8Type>(column, valid, num_rows, pool, out);
+    case TYPE_SMALLINT:
+        return convert_numbers<TYPE_SMALLINT, arrow::Int16Type>(column, valid, num_rows, pool, out);
+    case TYPE_INT:
+        return convert_numbers<TYPE_INT, arrow::Int32Type>(column, valid, num_rows, pool, out);
+    case TYPE_BIGINT:
+        return convert_numbers<TYPE_BIGINT, arrow::Int64Type>(column, valid, num_rows, pool, out);
+    case TYPE_FLOAT:
+        return convert_numbers<TYPE_FLOAT, arrow::FloatType>(column, valid, num_rows, pool, out);
+    case TYPE_DOUBLE:
+    case TYPE_TIME:
+        return convert_numbers<TYPE_DOUBLE, arrow::DoubleType>(column, valid, num_rows, pool, out);
+    case TYPE_DECIMALV2:
+        return convert_decimals<TYPE_DECIMALV2>(column, valid, num_rows, arrow_type, pool, out);
+    case TYPE_DECIMAL32:
+        return convert_decimals<TYPE_DECIMAL32>(column, valid, num_rows, arrow_type, pool, out);
+    case TYPE_DECIMAL64:
+        return convert_decimals<TYPE_DECIMAL64>(column, valid, num_rows, arrow_type, pool, out);
+    case TYPE_DECIMAL128:
+        return convert_decimals<TYPE_DECIMAL128>(column, valid, num_rows, arrow_type, pool, out);
+    default:
+        break;
+    }
+
+    arrow::StringBuilder builder(pool);
+    switch (type) {
+    case TYPE_VARCHAR:
+    case TYPE_CHAR: {
+        const auto* binary_column = down_cast<const BinaryColumn*>(ColumnHelper::get_data_column(column));
+        ARROW_RETURN_NOT_OK(builder.ReserveData(binary_column->get_bytes().size()));
+        ARROW_RETURN_NOT_OK(append_cells<BinaryColumn>(
+                column, valid, num_rows, &builder,
+                [](arrow::StringBuilder* builder, const BinaryColumn& data, size_t i) {
+                    Slice s = data.get_slice(i);
+                    return builder->Append(s.data, s.size);
+                }));
+        break;
+    }
+    case TYPE_LARGEINT:
+        ARROW_RETURN_NOT_OK(append_cells<Int128Column>(
+                column, valid, num_rows, &builder,
+                [](arrow::StringBuilder* builder, const Int128Column& data, size_t i) {
+                    char s[48];
+                    char* end = fmt::format_to(s, FMT_COMPILE("{}"), data.get_data()[i]);
+                    return builder->Append(s, end - s);
+                }));
+        break;
+    case TYPE_DATE:
+        ARROW_RETURN_NOT_OK(append_cells<DateColumn>(
+                column, valid, num_rows, &builder, [](arrow::StringBuilder* builder, const DateColumn& data, size_t i) {
+                    int year, month, day;
+                    data.get_data()[i].to_date(&year, &month, &day);
+                    char s[10];
+                    date::to_string(year, month, day, s);
+                    return builder->Append(s, sizeof(s));
+                }));
+        break;
+    case TYPE_DATETIME:
+        ARROW_RETURN_NOT_OK(append_cells<TimestampColumn>(
+                column, valid, num_rows, &builder,
+                [](arrow::StringBuilder* builder, const TimestampColumn& data, size_t i) {
+                    char s[TimestampValue::max_string_length()];
+                    int len = data.get_data()[i].to_string(s, sizeof(s));
+                    return builder->Append(s, len);
+                }));
+        break;
+    default:
+        return arrow::Status::TypeError(Substitute("unsupported column type $0", type));
+    }
+    return builder.Finish(out);
+}
+
+Status convert_chunk_to_arrow_batch(vectorized::Chunk* chunk, const std::vector<ExprContext*>& output_expr_ctxs,
+                                    const std::shared_ptr<arrow::Schema>& schema, arrow::MemoryPool* pool,
+                                    std::shared_ptr<arrow::RecordBatch>* result) {
+    if (schema->num_fields() != output_expr_ctxs.size()) {
+        return Status::InvalidArgument("number fields not match");
+    }
+    size_t num_rows = chunk->num_rows();
+    std::vector<std::shared_ptr<arrow::Array>> arrays(output_expr_ctxs.size());
+    for (size_t i = 0; i < output_expr_ctxs.size(); ++i) {
+        const TypeDescriptor& type = output_expr_ctxs[i]->root()->type();
+        vectorized::ColumnPtr column = output_expr_ctxs[i]->evaluate(chunk);
+        column = ColumnHelper::unfold_const_column(type, num_rows, column);
+        RETURN_IF_ERROR(to_status(
+                convert_column(type.type, column.get(), num_rows, schema->field(i)->type(), pool, &arrays[i])));
+    }
+    *result = arrow::RecordBatch::Make(schema, num_rows, std::move(arrays));
+    return Status::OK();
+}
+
+} // namespace starrocks
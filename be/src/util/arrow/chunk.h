@@ -0,0 +1,37 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+
+// This file converts the chunks of the vectorized engine to Arrow's RecordBatch.
+
+namespace arrow {
+
+class MemoryPool;
+class RecordBatch;
+class Schema;
+
+} // namespace arrow
+
+namespace starrocks {
+
+class ExprContext;
+class RowDescriptor;
+
+// Convert the types of |output_expr_ctxs| to an Arrow Schema, of which the fields are named after the slots of
+// |row_desc| if there are as many of them, or "col<i>" otherwise.
+Status convert_to_arrow_schema(const RowDescriptor& row_desc, const std::vector<ExprContext*>& output_expr_ctxs,
+                               std::shared_ptr<arrow::Schema>* result);
+
+// Convert the columns of |output_expr_ctxs| evaluated on |chunk| to an Arrow RecordBatch of |schema|, which is
+// converted from |output_expr_ctxs|. Memory used by result RecordBatch will be allocated from |pool|.
+Status convert_chunk_to_arrow_batch(vectorized::Chunk* chunk, const std::vector<ExprContext*>& output_expr_ctxs,
+                                    const std::shared_ptr<arrow::Schema>& schema, arrow::MemoryPool* pool,
+                                    std::shared_ptr<arrow::RecordBatch>* result);
+
+} // namespace starrocks
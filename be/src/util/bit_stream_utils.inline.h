@@ -22,6 +22,8 @@
 #define IMPALA_UTIL_BIT_STREAM_UTILS_INLINE_H
 
 #include <algorithm>
+#include <tuple>
+#include <type_traits>
 
 #include "glog/logging.h"
 #include "util/alignment.h"
@@ -131,6 +133,36 @@ inline bool BitReader::GetValue(int num_bits, T* v) {
     return true;
 }
 
+template <typename T>
+inline int BitReader::GetBatch(int num_bits, T* v, int num_values) {
+    int i = 0;
+    if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t)) {
+        while (i < num_values && position() % 8 != 0) {
+            if (PREDICT_FALSE(!GetValue(num_bits, v + i))) {
+                return i;
+            }
+            ++i;
+        }
+        if (i < num_values) {
+            // bool is unpacked as the uint8_t 0 or 1.
+            using OutType = std::conditional_t<std::is_same_v<T, bool>, uint8_t, T>;
+            int start = position();
+            int64_t num_read;
+            std::tie(std::ignore, num_read) =
+                    BitPacking::UnpackValues(num_bits, buffer_ + start / 8, max_bytes_ - start / 8, num_values - i,
+                                             reinterpret_cast<OutType*>(v + i));
+            i += static_cast<int>(num_read);
+            SeekToBit(start + static_cast<int>(num_read) * num_bits);
+        }
+    }
+    for (; i < num_values; ++i) {
+        if (PREDICT_FALSE(!GetValue(num_bits, v + i))) {
+            return i;
+        }
+    }
+    return i;
+}
+
 inline void BitReader::Rewind(int num_bits) {
     bit_offset_ -= num_bits;
     if (bit_offset_ >= 0) {
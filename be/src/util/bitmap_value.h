@@ -33,6 +33,7 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/config.h"
 #include "common/logging.h"
@@ -782,10 +783,22 @@ public:
      * pointer).
      */
     static Roaring64Map fastunion(size_t n, const Roaring64Map** inputs) {
-        Roaring64Map ans;
-        // not particularly fast
+        // Group the 32-bit bitmaps by the high 32 bits, and union every group in one pass,
+        // which defers computing the cardinalities of the containers till the end.
+        std::map<uint32_t, std::vector<const Roaring*>> groups;
         for (size_t lcv = 0; lcv < n; ++lcv) {
-            ans |= *(inputs[lcv]);
+            for (const auto& map_entry : inputs[lcv]->roarings) {
+                groups[map_entry.first].push_back(&map_entry.second);
+            }
+        }
+        Roaring64Map ans;
+        for (auto& [key, group] : groups) {
+            if (group.size() == 1) {
+                ans.roarings[key] = *group[0];
+            } else {
+                ans.roarings[key] = Roaring::fastunion(group.size(), group.data());
+            }
+            ans.roarings[key].setCopyOnWrite(ans.copyOnWrite);
         }
         return ans;
     }
@@ -1120,6 +1133,55 @@ public:
         return *this;
     }
 
+    // Compute the union between the current bitmap and all the provided bitmaps, which unions the
+    // BITMAP ones in one pass, instead of one by one like operator|=.
+    BitmapValue& fastunion(const std::vector<const BitmapValue*>& values) {
+        std::vector<const detail::Roaring64Map*> bitmaps;
+        std::vector<uint64_t> others;
+        for (const BitmapValue* value : values) {
+            switch (value->_type) {
+            case EMPTY:
+                break;
+            case SINGLE:
+                others.push_back(value->_sv);
+                break;
+            case BITMAP:
+                bitmaps.push_back(value->_bitmap.get());
+                break;
+            case SET:
+                others.insert(others.end(), value->_set.begin(), value->_set.end());
+                break;
+            }
+        }
+
+        if (bitmaps.empty()) {
+            for (uint64_t x : others) {
+                add(x);
+            }
+            return *this;
+        }
+
+        if (_type == BITMAP) {
+            bitmaps.push_back(_bitmap.get());
+        }
+        auto bitmap = std::make_shared<detail::Roaring64Map>(
+                detail::Roaring64Map::fastunion(bitmaps.size(), bitmaps.data()));
+        if (!others.empty()) {
+            bitmap->addMany(others.size(), others.data());
+        }
+        if (_type == SINGLE) {
+            bitmap->add(_sv);
+        } else if (_type == SET) {
+            for (const auto& x : _set) {
+                bitmap->add(x);
+            }
+            _set.clear();
+        }
+        _bitmap = std::move(bitmap);
+        _type = BITMAP;
+        return *this;
+    }
+
     // Note: rhs BitmapValue is only readable after this method
     // Compute the intersection between the current bitmap and the provided bitmap.
     // Possible type transitions are:
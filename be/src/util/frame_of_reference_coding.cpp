@@ -23,7 +23,9 @@
 
 #include <algorithm>
 #include <cstring>
+#include <type_traits>
 
+#include "gutil/endian.h"
 #include "util/bit_util.h"
 #include "util/coding.h"
 
@@ -269,28 +271,51 @@ bool ForDecoder<T>::init() {
     return true;
 }
 
-// todo(kks): improve this method by SIMD instructions
 // The reverse of bit_pack method, get original integer data list from packed bits
 // param[in] input: the packed bits need to unpack
 // param[in] in_num: the integer number in packed bits
 // param[in] bit_width: how many bit we used to store each integer data
 // param[out] output: the original integer data list
+//
+// The bits are packed from the most significant one of every byte. A value of up to 57 bits is shifted out of
+// the 8 bytes starting at its first byte loaded as one big-endian word, which is a load, a byte swap and two
+// shifts per value. The last values, whose 8 bytes are out of the input, and wider values are assembled from
+// their bytes.
 template <typename T>
 void ForDecoder<T>::bit_unpack(const uint8_t* input, uint8_t in_num, int bit_width, T* output) {
-    unsigned char in_mask = 0x80;
-    int bit_index = 0;
-    while (in_num > 0) {
-        *output = 0;
-        for (int i = 0; i < bit_width; i++) {
-            if (bit_index > 7) {
-                input++;
-                bit_index = 0;
+    using Word = std::conditional_t<sizeof(T) == 16, uint128_t, uint64_t>;
+    if (bit_width == 0) {
+        for (uint32_t i = 0; i < in_num; i++) {
+            output[i] = Word(0);
+        }
+        return;
+    }
+
+    const size_t in_bytes = (static_cast<size_t>(in_num) * bit_width + 7) / 8;
+    uint32_t i = 0;
+    if (bit_width <= 57) {
+        const int right_shift = 64 - bit_width;
+        for (; i < in_num; i++) {
+            size_t bit_pos = static_cast<size_t>(i) * bit_width;
+            if (bit_pos / 8 + 8 > in_bytes) {
+                break;
             }
-            *output |= ((T)((*input & (in_mask >> bit_index)) >> (7 - bit_index))) << (bit_width - i - 1);
-            bit_index++;
+            uint64_t word = BigEndian::Load64(input + bit_pos / 8);
+            output[i] = Word((word << (bit_pos % 8)) >> right_shift);
         }
-        output++;
-        in_num--;
+    }
+    for (; i < in_num; i++) {
+        size_t bit_pos = static_cast<size_t>(i) * bit_width;
+        Word value = 0;
+        int remaining = bit_width;
+        while (remaining > 0) {
+            int bit_index = bit_pos % 8;
+            int n = std::min(8 - bit_index, remaining);
+            value = (value << n) | ((input[bit_pos / 8] >> (8 - bit_index - n)) & ((1u << n) - 1));
+            remaining -= n;
+            bit_pos += n;
+        }
+        output[i] = value;
     }
 }
 
@@ -319,23 +344,21 @@ void ForDecoder<T>::decode_current_frame(T* output) {
 
     uint8_t bit_width = _bit_widths[_current_decoded_frame];
 
+    // The deltas are unpacked into the output and added up in place.
+    bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, output);
     bool is_original_value = _storage_formats[_current_decoded_frame] == 2;
-    if (is_original_value) {
-        bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, output);
-    } else {
+    if (!is_original_value) {
         bool is_ascending = _storage_formats[_current_decoded_frame] == 1;
-        std::vector<T> delta_values(current_frame_size);
-        bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, delta_values.data());
         if (is_ascending) {
             T pre_value = min;
             for (uint8_t i = 0; i < current_frame_size; i++) {
-                T value = delta_values[i] + pre_value;
+                T value = output[i] + pre_value;
                 output[i] = value;
                 pre_value = value;
             }
         } else {
             for (uint8_t i = 0; i < current_frame_size; i++) {
-                output[i] = delta_values[i] + min;
+                output[i] = output[i] + min;
             }
         }
     }
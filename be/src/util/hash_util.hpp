@@ -48,6 +48,19 @@ public:
     static uint32_t zlib_crc_hash(const void* data, int32_t bytes, uint32_t hash) {
         return crc32(hash, (const unsigned char*)data, bytes);
     }
+
+    // The same as zlib_crc_hash() of |N| bytes, but inlined with the table of zlib, for the values of a few bytes
+    // hashed one by one, of which the call of crc32() costs more than the hashing.
+    template <int N>
+    ALWAYS_INLINE static uint32_t zlib_crc_hash_fixed(const void* data, uint32_t hash) {
+        static const auto* table = get_crc_table();
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+        hash = ~hash;
+        for (int i = 0; i < N; ++i) {
+            hash = table[(hash ^ p[i]) & 0xff] ^ (hash >> 8);
+        }
+        return ~hash;
+    }
 #ifdef __SSE4_2__
     // Compute the Crc32 hash for data using SSE4 instructions.  The input hash parameter is
     // the current hash/seed value.
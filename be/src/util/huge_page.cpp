@@ -0,0 +1,27 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/huge_page.h"
+
+#include <sys/mman.h>
+
+#include <cstdint>
+
+#include "common/config.h"
+#include "common/logging.h"
+
+namespace starrocks {
+
+static constexpr uintptr_t kHugePageSize = 2 * 1024 * 1024;
+
+void madvise_huge_pages(void* ptr, size_t size) {
+    if (!config::enable_huge_pages || ptr == nullptr || size < config::huge_page_min_bytes) {
+        return;
+    }
+    uintptr_t begin = (reinterpret_cast<uintptr_t>(ptr) + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    uintptr_t end = (reinterpret_cast<uintptr_t>(ptr) + size) & ~(kHugePageSize - 1);
+    if (begin < end && madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) != 0) {
+        VLOG(2) << "madvise huge pages failed, errno=" << errno;
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,46 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+namespace starrocks {
+
+// Advise the kernel to back the memory [ptr, ptr + size) by the transparent huge pages of 2MB, if
+// config::enable_huge_pages and |size| is at least config::huge_page_min_bytes, so that the random accesses into a
+// large hash table take much fewer TLB misses. Only the 2MB-aligned pages within the range are advised, and it must be
+// called before the memory is touched, otherwise the pages are only collapsed later by khugepaged.
+void madvise_huge_pages(void* ptr, size_t size);
+
+// HugePageAllocator is a std::allocator which calls madvise_huge_pages() for every allocation, used by the hash
+// tables whose buckets are allocated by their own, e.g. the phmap of the aggregations.
+template <typename T>
+class HugePageAllocator : public std::allocator<T> {
+public:
+    template <typename U>
+    struct rebind {
+        using other = HugePageAllocator<U>;
+    };
+
+    HugePageAllocator() = default;
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        T* ptr = std::allocator<T>::allocate(n);
+        madvise_huge_pages(ptr, n * sizeof(T));
+        return ptr;
+    }
+
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>&) const noexcept {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U>&) const noexcept {
+        return false;
+    }
+};
+
+} // namespace starrocks
@@ -0,0 +1,24 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/io_latency_histogram.h"
+
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+std::string IOLatencyHistogram::bucket_name(int bucket) {
+    if (bucket == NUM_BUCKETS - 1) {
+        return "IOLatency" + std::to_string(1LL << (bucket - 1)) + "usOrMore";
+    }
+    return "IOLatencyUnder" + std::to_string(1LL << bucket) + "us";
+}
+
+void IOLatencyHistogram::update_profile(RuntimeProfile* profile, const std::string& parent_counter_name) const {
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+        if (_counts[i] > 0) {
+            COUNTER_UPDATE(ADD_CHILD_COUNTER(profile, bucket_name(i), TUnit::UNIT, parent_counter_name), _counts[i]);
+        }
+    }
+}
+
+} // namespace starrocks
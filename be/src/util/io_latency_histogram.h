@@ -0,0 +1,73 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "util/stopwatch.hpp"
+
+namespace starrocks {
+
+class RuntimeProfile;
+
+// The counts of the io calls by their latencies, in the buckets [0, 1us), [1us, 2us), [2us, 4us) ... and the last
+// one of at least 2^(NUM_BUCKETS - 2)us, i.e. about 262ms.
+class IOLatencyHistogram {
+public:
+    static constexpr int NUM_BUCKETS = 20;
+
+    void add(int64_t latency_ns) { _counts[bucket_of(latency_ns)]++; }
+
+    void merge(const IOLatencyHistogram& other) {
+        for (int i = 0; i < NUM_BUCKETS; i++) {
+            _counts[i] += other._counts[i];
+        }
+    }
+
+    void clear() { _counts.fill(0); }
+
+    int64_t count(int bucket) const { return _counts[bucket]; }
+
+    static int bucket_of(int64_t latency_ns) {
+        auto us = static_cast<uint64_t>(std::max<int64_t>(latency_ns, 0)) / 1000;
+        return us == 0 ? 0 : std::min(NUM_BUCKETS - 1, 64 - __builtin_clzll(us));
+    }
+
+    // Such as "IOLatencyUnder4us", or "IOLatency262144usOrMore" of the last bucket.
+    static std::string bucket_name(int bucket);
+
+    // Add the counts of the buckets which are not empty to the child counters of |parent_counter_name| in |profile|,
+    // which are only created for the latencies that happened, so the profiles of the fast scans aren't lengthened by
+    // the buckets of the slow io.
+    void update_profile(RuntimeProfile* profile, const std::string& parent_counter_name) const;
+
+private:
+    std::array<int64_t, NUM_BUCKETS> _counts{};
+};
+
+// Add the time spent in the scope to |*io_ns| and to |histogram|, as one io call.
+class ScopedIOTimer {
+public:
+    ScopedIOTimer(int64_t* io_ns, IOLatencyHistogram* histogram) : _io_ns(io_ns), _histogram(histogram) {
+        _sw.start();
+    }
+
+    ~ScopedIOTimer() {
+        int64_t elapsed = _sw.elapsed_time();
+        *_io_ns += elapsed;
+        _histogram->add(elapsed);
+    }
+
+    ScopedIOTimer(const ScopedIOTimer&) = delete;
+    ScopedIOTimer& operator=(const ScopedIOTimer&) = delete;
+
+private:
+    MonotonicStopWatch _sw;
+    int64_t* _io_ns;
+    IOLatencyHistogram* _histogram;
+};
+
+} // namespace starrocks
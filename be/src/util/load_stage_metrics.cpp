@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/load_stage_metrics.h"
+
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "util/starrocks_metrics.h"
+#include "util/thread_pool_metrics.h"
+
+namespace starrocks {
+
+const char* LoadStageMetrics::name(Stage stage) {
+    switch (stage) {
+    case RECEIVE:
+        return "receive";
+    case PARSE:
+        return "parse";
+    case SINK_RPC:
+        return "sink_rpc";
+    case TABLETS_CHANNEL:
+        return "tablets_channel";
+    case MEMTABLE_INSERT:
+        return "memtable_insert";
+    case MEMTABLE_SORT:
+        return "memtable_sort";
+    case FLUSH:
+        return "flush";
+    case COMMIT_PUBLISH:
+        return "commit_publish";
+    default:
+        return "";
+    }
+}
+
+static LatencyHistogramMetric* stage_histograms() {
+    static LatencyHistogramMetric* s_histograms = [] {
+        auto* histograms = new LatencyHistogramMetric[LoadStageMetrics::NUM_STAGES];
+        auto* registry = StarRocksMetrics::instance()->metrics();
+        for (int i = 0; i < LoadStageMetrics::NUM_STAGES; i++) {
+            MetricLabels labels;
+            labels.add("stage", LoadStageMetrics::name(static_cast<LoadStageMetrics::Stage>(i)));
+            histograms[i].register_metrics(registry, "load_stage_latency_us", labels);
+        }
+        return histograms;
+    }();
+    return s_histograms;
+}
+
+void LoadStageMetrics::add(Stage stage, int64_t latency_ns) {
+    stage_histograms()[stage].add(latency_ns);
+}
+
+void LoadStageMetrics::set_kafka_partition_lag(const std::string& topic, int32_t partition, int64_t lag) {
+    static std::mutex s_lock;
+    // Never freed, since the registry keeps pointing to the gauges.
+    static std::map<std::pair<std::string, int32_t>, IntGauge*> s_lags;
+
+    std::lock_guard<std::mutex> l(s_lock);
+    auto [it, inserted] = s_lags.emplace(std::make_pair(topic, partition), nullptr);
+    if (inserted) {
+        it->second = new IntGauge(MetricUnit::NOUNIT);
+        MetricLabels labels;
+        labels.add("topic", topic).add("partition", std::to_string(partition));
+        StarRocksMetrics::instance()->metrics()->register_metric("routine_load_kafka_partition_lag", labels,
+                                                                 it->second);
+    }
+    it->second->set_value(lag);
+}
+
+} // namespace starrocks
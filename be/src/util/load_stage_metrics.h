@@ -0,0 +1,47 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace starrocks {
+
+// The time the loads spend in each stage of the load pipeline, reported by the histogram
+// load_stage_latency_us{stage="<stage>"} of StarRocksMetrics with one sample per load and stage on each BE. A stage
+// running on several threads or nodes in parallel counts the total time of all of them.
+//
+// Besides, the routine loads report the lag of each kafka partition they consume by the gauge
+// routine_load_kafka_partition_lag{topic="<topic>",partition="<partition>"}.
+class LoadStageMetrics {
+public:
+    enum Stage {
+        // The http body of a stream load being received.
+        RECEIVE = 0,
+        // The source data being read and parsed by the file scanners.
+        PARSE,
+        // The add chunk rpcs of OlapTableSink, from being sent to being responded.
+        SINK_RPC,
+        // The add chunk rpcs being processed by the tablets channels of the receivers.
+        TABLETS_CHANNEL,
+        // The rows being inserted into the memtables.
+        MEMTABLE_INSERT,
+        // The memtables being sorted and aggregated before being flushed.
+        MEMTABLE_SORT,
+        // The memtables being flushed into the segment files.
+        FLUSH,
+        // The transaction being committed and published.
+        COMMIT_PUBLISH,
+        NUM_STAGES,
+    };
+
+    static const char* name(Stage stage);
+
+    // One load spent |latency_ns| in |stage|.
+    static void add(Stage stage, int64_t latency_ns);
+
+    // The messages of |partition| of |topic| not consumed yet by the routine load.
+    static void set_kafka_partition_lag(const std::string& topic, int32_t partition, int64_t lag);
+};
+
+} // namespace starrocks
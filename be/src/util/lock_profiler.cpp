@@ -0,0 +1,50 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/lock_profiler.h"
+
+#include <map>
+
+#include "common/config.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks {
+
+static std::mutex s_sites_lock;
+
+static std::map<std::string, LockSite*>& sites() {
+    static std::map<std::string, LockSite*> s_sites;
+    return s_sites;
+}
+
+LockSite* LockSite::get(const std::string& name) {
+    std::lock_guard<std::mutex> l(s_sites_lock);
+    auto [it, inserted] = sites().emplace(name, nullptr);
+    if (inserted) {
+        it->second = new LockSite(name);
+        auto* metrics = StarRocksMetrics::instance()->metrics();
+        metrics->register_metric("lock_contentions_total", MetricLabels().add("lock", name), &it->second->_contentions);
+        metrics->register_metric("lock_wait_ns_total", MetricLabels().add("lock", name), &it->second->_wait_ns);
+    }
+    return it->second;
+}
+
+std::vector<LockSite*> LockSite::all() {
+    std::lock_guard<std::mutex> l(s_sites_lock);
+    std::vector<LockSite*> result;
+    result.reserve(sites().size());
+    for (auto& [name, site] : sites()) {
+        result.push_back(site);
+    }
+    return result;
+}
+
+int64_t LockSite::sample_period() {
+    static thread_local int64_t tls_num_contentions = 0;
+    int64_t period = config::lock_contention_sample_period;
+    if (period <= 0 || ++tls_num_contentions % period != 0) {
+        return 0;
+    }
+    return period;
+}
+
+} // namespace starrocks
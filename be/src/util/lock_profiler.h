@@ -0,0 +1,103 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "util/metrics.h"
+#include "util/time.h"
+
+namespace starrocks {
+
+// The contention of the locks of one named site, e.g. all the shard locks of the TabletManager, which are reported
+// by the metrics lock_contentions_total and lock_wait_ns_total with the label lock=<name>, and by the page /locks.
+//
+// Every contended acquisition is counted, while only one of every config::lock_contention_sample_period ones of a
+// thread is timed, so the wait time is an estimate.
+class LockSite {
+public:
+    // The site named |name|, created on the first call and never freed.
+    static LockSite* get(const std::string& name);
+    // All the sites, ordered by name.
+    static std::vector<LockSite*> all();
+
+    // The sample period if the next contended acquisition of the calling thread is to be timed, otherwise 0.
+    static int64_t sample_period();
+
+    const std::string& name() const { return _name; }
+
+    // A contended acquisition, which waited |wait_ns| if it was timed with |sample_period| > 0.
+    void add_contention(int64_t wait_ns, int64_t sample_period) {
+        _contentions.increment(1);
+        if (sample_period > 0) {
+            _wait_ns.increment(wait_ns * sample_period);
+            int64_t max_wait_ns = _max_wait_ns.load(std::memory_order_relaxed);
+            while (wait_ns > max_wait_ns &&
+                   !_max_wait_ns.compare_exchange_weak(max_wait_ns, wait_ns, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    int64_t contentions() const { return _contentions.value(); }
+    int64_t wait_ns() const { return _wait_ns.value(); }
+    // The longest wait of the timed acquisitions.
+    int64_t max_wait_ns() const { return _max_wait_ns.load(std::memory_order_relaxed); }
+
+private:
+    explicit LockSite(std::string name) : _name(std::move(name)) {}
+
+    const std::string _name;
+    IntCounter _contentions{MetricUnit::OPERATIONS};
+    IntCounter _wait_ns{MetricUnit::NANOSECONDS};
+    std::atomic<int64_t> _max_wait_ns{0};
+};
+
+// A drop-in replacement of |Mutex|, std::mutex or std::shared_mutex, which reports its contention to a LockSite.
+// An uncontended acquisition costs one try_lock() only.
+template <typename Mutex>
+class BasicProfiledMutex {
+public:
+    explicit BasicProfiledMutex(LockSite* site) : _site(site) {}
+
+    BasicProfiledMutex(const BasicProfiledMutex&) = delete;
+    BasicProfiledMutex& operator=(const BasicProfiledMutex&) = delete;
+
+    void lock() {
+        if (!_mutex.try_lock()) {
+            _lock_contended([this] { _mutex.lock(); });
+        }
+    }
+    bool try_lock() { return _mutex.try_lock(); }
+    void unlock() { _mutex.unlock(); }
+
+    // Only for std::shared_mutex.
+    void lock_shared() {
+        if (!_mutex.try_lock_shared()) {
+            _lock_contended([this] { _mutex.lock_shared(); });
+        }
+    }
+    bool try_lock_shared() { return _mutex.try_lock_shared(); }
+    void unlock_shared() { _mutex.unlock_shared(); }
+
+private:
+    template <typename LockFunc>
+    void _lock_contended(LockFunc&& lock_func) {
+        int64_t sample_period = LockSite::sample_period();
+        int64_t begin_ns = sample_period > 0 ? MonotonicNanos() : 0;
+        lock_func();
+        _site->add_contention(sample_period > 0 ? MonotonicNanos() - begin_ns : 0, sample_period);
+    }
+
+    Mutex _mutex;
+    LockSite* _site;
+};
+
+using ProfiledMutex = BasicProfiledMutex<std::mutex>;
+using ProfiledSharedMutex = BasicProfiledMutex<std::shared_mutex>;
+
+} // namespace starrocks
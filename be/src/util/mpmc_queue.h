@@ -0,0 +1,236 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "common/compiler_util.h"
+
+namespace starrocks {
+
+// EventCount lets the threads wait for a condition which is changed without a lock, e.g. a lock-free queue being
+// non-empty, with no cost on the notifying side while nobody waits. A waiter follows the pattern:
+//
+//     uint64_t key = ec.prepare_wait();
+//     if (condition()) {
+//         ec.cancel_wait();
+//     } else {
+//         ec.wait(key);
+//     }
+//
+// and a notifier makes the condition true before notify_one() or notify_all(). A notification between
+// prepare_wait() and wait() makes wait() return at once, so it's never lost.
+class EventCount {
+public:
+    uint64_t prepare_wait() {
+        _waiters.fetch_add(1, std::memory_order_seq_cst);
+        return _epoch.load(std::memory_order_acquire);
+    }
+
+    void cancel_wait() { _waiters.fetch_sub(1, std::memory_order_relaxed); }
+
+    void wait(uint64_t key) {
+        std::unique_lock<std::mutex> l(_mutex);
+        while (_epoch.load(std::memory_order_acquire) == key) {
+            _cv.wait(l);
+        }
+        _waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify_one() { _notify(false); }
+
+    void notify_all() { _notify(true); }
+
+private:
+    void _notify(bool all) {
+        // Orders the change of the condition before the load of _waiters, against prepare_wait().
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (LIKELY(_waiters.load(std::memory_order_relaxed) == 0)) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _epoch.fetch_add(1, std::memory_order_release);
+        }
+        if (all) {
+            _cv.notify_all();
+        } else {
+            _cv.notify_one();
+        }
+    }
+
+    std::atomic<uint64_t> _epoch{0};
+    std::atomic<int32_t> _waiters{0};
+    std::mutex _mutex;
+    std::condition_variable _cv;
+};
+
+// BoundedMPMCQueue is a lock-free bounded queue of multiple producers and consumers, on a ring of cells each with a
+// sequence number which tells whether it's ready to be written or read in the current lap, as described by
+// Dmitry Vyukov. A put or get takes a CAS on the tail or head, and the threads only block on the EventCounts when
+// the queue is full or empty, so it hands the items over without the context switches of a mutex under contention.
+//
+// The capacity is rounded up to the power of 2. The blocking operations have the same semantics as those of
+// BlockingQueue in util/blocking_queue.hpp, while the items put concurrently with shutdown() may be accepted.
+template <typename T>
+class BoundedMPMCQueue {
+public:
+    explicit BoundedMPMCQueue(size_t capacity = 1) { init(capacity); }
+
+    BoundedMPMCQueue(const BoundedMPMCQueue&) = delete;
+    BoundedMPMCQueue& operator=(const BoundedMPMCQueue&) = delete;
+
+    // Reallocate the ring of at least |capacity| cells, dropping the items in it. Must not be called concurrently
+    // with any other operation, e.g. before the queue is shared.
+    void init(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _cells = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; i++) {
+            _cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+        _mask = size - 1;
+        _head.store(0, std::memory_order_relaxed);
+        _tail.store(0, std::memory_order_relaxed);
+    }
+
+    // Return false iff the queue is full.
+    bool try_put(T&& value) {
+        size_t pos = _tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &_cells[pos & _mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        _not_empty.notify_one();
+        return true;
+    }
+
+    bool try_put(const T& value) {
+        T copy = value;
+        return try_put(std::move(copy));
+    }
+
+    // Return false iff the queue is empty.
+    bool try_get(T* out) {
+        size_t pos = _head.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &_cells[pos & _mask];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _head.load(std::memory_order_relaxed);
+            }
+        }
+        *out = std::move(cell->value);
+        cell->value = T();
+        cell->seq.store(pos + _mask + 1, std::memory_order_release);
+        _not_full.notify_one();
+        return true;
+    }
+
+    // Return false iff this queue has been shutdown.
+    bool blocking_put(T value) {
+        for (;;) {
+            if (_shutdown.load(std::memory_order_acquire)) {
+                return false;
+            }
+            if (try_put(std::move(value))) {
+                return true;
+            }
+            uint64_t key = _not_full.prepare_wait();
+            if (_shutdown.load(std::memory_order_acquire) || !full()) {
+                _not_full.cancel_wait();
+                continue;
+            }
+            _not_full.wait(key);
+        }
+    }
+
+    // Return false iff empty *AND* has been shutdown.
+    bool blocking_get(T* out) {
+        for (;;) {
+            if (try_get(out)) {
+                return true;
+            }
+            if (_shutdown.load(std::memory_order_acquire)) {
+                // The items put before shutdown() are visible since here.
+                return try_get(out);
+            }
+            uint64_t key = _not_empty.prepare_wait();
+            if (_shutdown.load(std::memory_order_acquire) || !empty()) {
+                _not_empty.cancel_wait();
+                continue;
+            }
+            _not_empty.wait(key);
+        }
+    }
+
+    // Shutdown the queue, this will wake up all waiting threads.
+    void shutdown() {
+        _shutdown.store(true, std::memory_order_release);
+        _not_empty.notify_all();
+        _not_full.notify_all();
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+    // Approximate while the queue is accessed concurrently.
+    size_t get_size() const {
+        size_t head = _head.load(std::memory_order_acquire);
+        size_t tail = _tail.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const {
+        size_t pos = _head.load(std::memory_order_acquire);
+        return _cells[pos & _mask].seq.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    bool full() const {
+        size_t pos = _tail.load(std::memory_order_acquire);
+        return _cells[pos & _mask].seq.load(std::memory_order_acquire) != pos;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t _mask = 0;
+    // The head and tail are on the different cache lines, not to be bounced between the producers and consumers.
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> _head{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> _shutdown{false};
+    EventCount _not_empty;
+    EventCount _not_full;
+};
+
+} // namespace starrocks
@@ -34,6 +34,45 @@ void murmur_hash3_x64_128(const void* key, int len, uint32_t seed, void* out);
 
 void murmur_hash3_x64_64(const void* key, int len, uint64_t seed, void* out);
 
+#include <cstring>
+
+// The same hash as murmur_hash3_x64_64 of a key of LEN bytes, which may be unaligned, inlined with the length known
+// at compile time, so that the loops over many keys of a fixed size unroll and vectorize.
+template <int LEN>
+inline uint64_t murmur_hash3_x64_64_fixed(const void* key, uint64_t seed) {
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+    auto rotl64 = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+    const auto* data = reinterpret_cast<const uint8_t*>(key);
+    uint64_t h1 = seed;
+    for (int i = 0; i < LEN / 8; i++) {
+        uint64_t k1;
+        memcpy(&k1, data + i * 8, sizeof(k1));
+        k1 *= c1;
+        k1 = rotl64(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+        h1 = rotl64(h1, 27);
+        h1 = h1 * 5 + 0x52dce729;
+    }
+    if constexpr ((LEN & 7) != 0) {
+        // The tail bytes in little endian.
+        uint64_t k1 = 0;
+        memcpy(&k1, data + LEN / 8 * 8, LEN & 7);
+        k1 *= c1;
+        k1 = rotl64(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+    }
+    h1 ^= LEN;
+    h1 ^= h1 >> 33;
+    h1 *= 0xff51afd7ed558ccdULL;
+    h1 ^= h1 >> 33;
+    h1 *= 0xc4ceb9fe1a85ec53ULL;
+    h1 ^= h1 >> 33;
+    return h1;
+}
+
 //-----------------------------------------------------------------------------
 
 #endif // STARROCKS_BE_SRC_UTIL_MURMUR_HASH3_H
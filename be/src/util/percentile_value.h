@@ -23,8 +23,27 @@ public:
 
     void add(float value) { _tdigest.add(value); }
 
+    void add(const float* values, size_t size) { _tdigest.add(values, size); }
+
     void merge(const PercentileValue* other) { _tdigest.merge(&other->_tdigest); }
 
+    // Merge many values at once, which merges their centroids in the order of size in batches.
+    void merge(const std::vector<const PercentileValue*>& others) {
+        std::vector<const TDigest*> digests;
+        digests.reserve(others.size());
+        for (const PercentileValue* other : others) {
+            digests.push_back(&other->_tdigest);
+        }
+        _tdigest.add(digests);
+    }
+
+    // Process the buffered values into the centroids, so that they are serialized compactly.
+    void compress() {
+        if (_tdigest.haveUnprocessed()) {
+            _tdigest.compress();
+        }
+    }
+
     uint64_t serialize_size() const {
         //_type 1 bytes
         return 1 + _tdigest.serialize_size();
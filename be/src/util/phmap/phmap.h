@@ -2584,6 +2584,10 @@ public:
         inner.set_.clear();
     }
 
+    // extension - the specified submap, so that the submaps could be iterated separately
+    // ----------------------------------------
+    EmbeddedSet& get_submap(std::size_t submap_index) { return sets_[submap_index].set_; }
+
     // This overload kicks in when the argument is an rvalue of insertable and
     // decomposable type other than init_type.
     //
@@ -24,8 +24,11 @@
 
 #include <boost/thread.hpp>
 #include <functional>
+#include <string>
 
 #include "util/blocking_priority_queue.hpp"
+#include "util/thread_pool_metrics.h"
+#include "util/time.h"
 
 namespace starrocks {
 
@@ -42,6 +45,11 @@ public:
     public:
         int priority = 0;
         WorkFunction work_function;
+        // The tasks of the same group, e.g. of a query, are taken round robin with the other groups by
+        // WorkStealingThreadPool. Not used by PriorityThreadPool.
+        uint64_t group_id = 0;
+        // MonotonicNanos() when the task is offered, for the wait time of ThreadPoolMetrics.
+        int64_t submit_time_ns = 0;
         bool operator<(const Task& o) const { return priority < o.priority; }
 
         Task& operator++() {
@@ -51,12 +59,14 @@ public:
     };
 
     // Creates a new thread pool and start num_threads threads.
+    //  -- name: the name of the pool in ThreadPoolMetrics
     //  -- num_threads: how many threads are part of this pool
     //  -- queue_size: the maximum size of the queue on which work items are offered. If the
     //     queue exceeds this size, subsequent calls to Offer will block until there is
     //     capacity available.
     //  -- work_function: the function to run every time an item is consumed from the queue
-    PriorityThreadPool(uint32_t num_threads, uint32_t queue_size) : _work_queue(queue_size), _shutdown(false) {
+    PriorityThreadPool(const std::string& name, uint32_t num_threads, uint32_t queue_size)
+            : _work_queue(queue_size), _shutdown(false), _metrics(ThreadPoolMetrics::get(name)) {
         for (int i = 0; i < num_threads; ++i) {
             _threads.create_thread(std::bind<void>(std::mem_fn(&PriorityThreadPool::work_thread), this, i));
         }
@@ -80,13 +90,13 @@ public:
     //
     // Returns true if the work item was successfully added to the queue, false otherwise
     // (which typically means that the thread pool has already been shut down).
-    bool offer(const Task& task) { return _work_queue.blocking_put(task); }
+    bool offer(const Task& task) { return _put(task, true); }
 
-    bool try_offer(const Task& task) { return _work_queue.try_put(task); }
+    bool try_offer(const Task& task) { return _put(task, false); }
 
     bool offer(WorkFunction func) {
         PriorityThreadPool::Task task = {0, std::move(func)};
-        return _work_queue.blocking_put(std::move(task));
+        return _put(std::move(task), true);
     }
 
     // Shuts the thread pool down, causing the work queue to cease accepting offered work
@@ -124,13 +134,29 @@ public:
     }
 
 private:
+    bool _put(Task task, bool blocking) {
+        task.submit_time_ns = MonotonicNanos();
+        // Counted before being taken by a worker.
+        _metrics->task_queued();
+        bool ok = blocking ? _work_queue.blocking_put(std::move(task)) : _work_queue.try_put(std::move(task));
+        if (!ok) {
+            _metrics->tasks_dropped(1);
+            _metrics->task_rejected();
+        }
+        return ok;
+    }
+
     // Driver method for each thread in the pool. Continues to read work from the queue
     // until the pool is shutdown.
     void work_thread(int thread_id) {
         while (!is_shutdown()) {
             Task task;
             if (_work_queue.blocking_get(&task)) {
+                int64_t start_time_ns = MonotonicNanos();
+                _metrics->task_dequeued(start_time_ns - task.submit_time_ns);
+                _metrics->task_started();
                 task.work_function();
+                _metrics->task_finished(MonotonicNanos() - start_time_ns);
             }
             if (_work_queue.get_size() == 0) {
                 _empty_cv.notify_all();
@@ -159,6 +185,8 @@ private:
 
     // Signalled when the queue becomes empty
     std::condition_variable _empty_cv;
+
+    ThreadPoolMetrics* _metrics;
 };
 
 } // namespace starrocks
@@ -40,6 +40,9 @@ public:
     // If unref() returns true, this object should be delete
     bool unref() { return _refs.fetch_sub(1) == 1; }
 
+    // The number of the references, the rpc referring to it is finished once only the others are left.
+    int count() const { return _refs.load(); }
+
     void Run() override {
         if (unref()) {
             delete this;
@@ -412,11 +412,9 @@ inline size_t RleDecoder<T>::GetBatch(T* vals, size_t batch_num) {
             read_num += read_this_time;
         } else if (literal_count_ > 0) {
             read_this_time = std::min((size_t)literal_count_, read_this_time);
-            for (int i = 0; i < read_this_time; ++i) {
-                bool result = bit_reader_.GetValue(bit_width_, vals);
-                DCHECK(result);
-                vals++;
-            }
+            [[maybe_unused]] int num_read = bit_reader_.GetBatch(bit_width_, vals, read_this_time);
+            DCHECK_EQ(num_read, read_this_time);
+            vals += read_this_time;
             literal_count_ -= read_this_time;
             read_num += read_this_time;
         } else {
@@ -0,0 +1,168 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/sampling_profiler.h"
+
+#include <execinfo.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+#include "common/config.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/current_thread.h"
+
+namespace starrocks {
+
+// Not SIGPROF, which is taken by the cpu profiler of gperftools behind /pprof/profile.
+static int profiler_signal() {
+    return SIGRTMIN + 4;
+}
+
+static int64_t monotonic_ms() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// The profiler started, read by the signal handler.
+static std::atomic<SamplingProfiler*> s_running_profiler{nullptr};
+
+SamplingProfiler* SamplingProfiler::instance() {
+    static SamplingProfiler s_profiler;
+    return &s_profiler;
+}
+
+SamplingProfiler::~SamplingProfiler() {
+    stop();
+}
+
+Status SamplingProfiler::start(int frequency) {
+    std::lock_guard<std::mutex> l(_lock);
+    if (_timer_created) {
+        return Status::OK();
+    }
+    if (frequency <= 0) {
+        return Status::InvalidArgument(strings::Substitute("invalid sampling frequency $0", frequency));
+    }
+    if (_samples == nullptr) {
+        _num_samples = std::max<int64_t>(config::sampling_profiler_max_samples, 1);
+        _samples.reset(new Sample[_num_samples]);
+    }
+    // backtrace() loads libgcc on the first call, which must not happen in the signal handler.
+    void* frames[1];
+    backtrace(frames, 1);
+
+    s_running_profiler = this;
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = _on_signal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(profiler_signal(), &action, nullptr) != 0) {
+        return Status::InternalError(strings::Substitute("sigaction failed: $0", strerror(errno)));
+    }
+
+    sigevent event;
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_SIGNAL;
+    event.sigev_signo = profiler_signal();
+    if (timer_create(CLOCK_PROCESS_CPUTIME_ID, &event, &_timer) != 0) {
+        return Status::InternalError(strings::Substitute("timer_create failed: $0", strerror(errno)));
+    }
+    const int64_t interval_ns = 1000000000L / frequency;
+    itimerspec spec;
+    spec.it_interval.tv_sec = interval_ns / 1000000000L;
+    spec.it_interval.tv_nsec = interval_ns % 1000000000L;
+    spec.it_value = spec.it_interval;
+    if (timer_settime(_timer, 0, &spec, nullptr) != 0) {
+        timer_delete(_timer);
+        return Status::InternalError(strings::Substitute("timer_settime failed: $0", strerror(errno)));
+    }
+    _timer_created = true;
+    return Status::OK();
+}
+
+void SamplingProfiler::stop() {
+    std::lock_guard<std::mutex> l(_lock);
+    if (!_timer_created) {
+        return;
+    }
+    timer_delete(_timer);
+    _timer_created = false;
+    // The signals still pending are ignored, the handler may still be running on the other threads though, so the
+    // samples are kept.
+    signal(profiler_signal(), SIG_IGN);
+    s_running_profiler = nullptr;
+}
+
+void SamplingProfiler::_on_signal(int signo, siginfo_t* info, void* context) {
+    int saved_errno = errno;
+    SamplingProfiler* profiler = s_running_profiler.load(std::memory_order_acquire);
+    if (profiler != nullptr) {
+        profiler->_take_sample();
+    }
+    errno = saved_errno;
+}
+
+// Run in the signal handler, so only async-signal-safe calls are allowed.
+void SamplingProfiler::_take_sample() {
+    Sample& sample = _samples[_next_sample.fetch_add(1, std::memory_order_relaxed) % _num_samples];
+    sample.version.fetch_add(1, std::memory_order_acq_rel);
+    sample.time_ms = monotonic_ms();
+    CurrentThread::get_sampling_tags(&sample.query_id_hi, &sample.query_id_lo, &sample.resource_group_id);
+    // Skip the frames of this function and of the signal handler.
+    void* frames[kMaxDepth + 2];
+    int depth = backtrace(frames, kMaxDepth + 2);
+    sample.depth = std::max(depth - 2, 0);
+    memcpy(sample.frames, frames + 2, sample.depth * sizeof(void*));
+    sample.version.fetch_add(1, std::memory_order_release);
+}
+
+std::vector<SamplingProfiler::Stack> SamplingProfiler::stacks(const Filter& filter) const {
+    std::vector<Stack> result;
+    if (_samples == nullptr) {
+        return result;
+    }
+    const int64_t begin_ms = monotonic_ms() - filter.seconds * 1000;
+    std::map<std::tuple<int64_t, int64_t, std::vector<void*>>, int64_t> counts;
+    for (size_t i = 0; i < _num_samples; i++) {
+        const Sample& sample = _samples[i];
+        uint32_t version = sample.version.load(std::memory_order_acquire);
+        if (version == 0 || (version & 1) != 0) {
+            continue;
+        }
+        int64_t time_ms = sample.time_ms;
+        int64_t query_id_hi = sample.query_id_hi;
+        int64_t query_id_lo = sample.query_id_lo;
+        int64_t resource_group_id = sample.resource_group_id;
+        std::vector<void*> frames(sample.frames, sample.frames + std::min(sample.depth, kMaxDepth));
+        // Overwritten by the handler while being copied.
+        if (sample.version.load(std::memory_order_acquire) != version) {
+            continue;
+        }
+        if (time_ms < begin_ms) {
+            continue;
+        }
+        if (filter.has_query_id && (query_id_hi != filter.query_id_hi || query_id_lo != filter.query_id_lo)) {
+            continue;
+        }
+        if (filter.resource_group_id >= 0 && resource_group_id != filter.resource_group_id) {
+            continue;
+        }
+        counts[std::make_tuple(query_id_hi, query_id_lo, std::move(frames))]++;
+    }
+    result.reserve(counts.size());
+    for (auto& [key, count] : counts) {
+        Stack& stack = result.emplace_back();
+        stack.query_id_hi = std::get<0>(key);
+        stack.query_id_lo = std::get<1>(key);
+        stack.frames = std::get<2>(key);
+        stack.count = count;
+    }
+    return result;
+}
+
+} // namespace starrocks
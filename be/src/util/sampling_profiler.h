@@ -0,0 +1,83 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <signal.h>
+#include <time.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/status.h"
+
+namespace starrocks {
+
+// SamplingProfiler samples the stacks of the threads burning the cpu all the time, |frequency| times per second of
+// the cpu time of the process, so that a busy core is sampled about |frequency| times per second and an idle one not
+// at all. Each sample is tagged with the query and the resource group the thread was working for, see
+// CurrentThread::set_sampling_tags, so the cpu of a query or of a time window can be broken down by code path.
+//
+// The samples are captured by the handler of a real-time signal, instead of the SIGPROF used by the gperftools cpu
+// profiler, into a ring buffer of the latest config::sampling_profiler_max_samples samples.
+class SamplingProfiler {
+public:
+    static constexpr int kMaxDepth = 32;
+
+    static SamplingProfiler* instance();
+
+    ~SamplingProfiler();
+
+    Status start(int frequency);
+    void stop();
+    bool is_running() const { return _timer_created; }
+
+    struct Filter {
+        // The samples of the last |seconds| seconds.
+        int64_t seconds = 60;
+        // The samples of any query if |has_query_id| is false.
+        bool has_query_id = false;
+        int64_t query_id_hi = 0;
+        int64_t query_id_lo = 0;
+        // The samples of any resource group if negative.
+        int64_t resource_group_id = -1;
+    };
+
+    struct Stack {
+        int64_t query_id_hi = 0;
+        int64_t query_id_lo = 0;
+        // The innermost frame first.
+        std::vector<void*> frames;
+        int64_t count = 0;
+    };
+
+    // The distinct stacks of the samples matching |filter|, with their counts.
+    std::vector<Stack> stacks(const Filter& filter) const;
+
+private:
+    struct Sample {
+        // Odd while the signal handler is writing the sample.
+        std::atomic<uint32_t> version{0};
+        int64_t time_ms = 0;
+        int64_t query_id_hi = 0;
+        int64_t query_id_lo = 0;
+        int64_t resource_group_id = -1;
+        int32_t depth = 0;
+        void* frames[kMaxDepth];
+    };
+
+    SamplingProfiler() = default;
+
+    static void _on_signal(int signo, siginfo_t* info, void* context);
+    void _take_sample();
+
+    std::mutex _lock;
+    bool _timer_created = false;
+    timer_t _timer;
+    size_t _num_samples = 0;
+    std::unique_ptr<Sample[]> _samples;
+    std::atomic<uint64_t> _next_sample{0};
+};
+
+} // namespace starrocks
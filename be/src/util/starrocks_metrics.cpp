@@ -39,10 +39,15 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
     // You can put StarRocksMetrics's metrics initial code here
     REGISTER_STARROCKS_METRIC(fragment_requests_total);
     REGISTER_STARROCKS_METRIC(fragment_request_duration_us);
+    REGISTER_STARROCKS_METRIC(fragment_admission_wait_duration_us);
+    REGISTER_STARROCKS_METRIC(fragment_admission_timeout_total);
     REGISTER_STARROCKS_METRIC(http_requests_total);
     REGISTER_STARROCKS_METRIC(http_request_send_bytes);
     REGISTER_STARROCKS_METRIC(query_scan_bytes);
     REGISTER_STARROCKS_METRIC(query_scan_rows);
+    REGISTER_STARROCKS_METRIC(query_scan_page_cache_bytes);
+    REGISTER_STARROCKS_METRIC(query_scan_remote_bytes);
+    REGISTER_STARROCKS_METRIC(query_scan_index_filtered_bytes);
 
     REGISTER_STARROCKS_METRIC(memtable_flush_total);
     REGISTER_STARROCKS_METRIC(memtable_flush_duration_us);
@@ -60,10 +60,16 @@ public:
     // counters
     METRIC_DEFINE_INT_COUNTER(fragment_requests_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(fragment_request_duration_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_INT_COUNTER(fragment_admission_wait_duration_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_INT_COUNTER(fragment_admission_timeout_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(http_requests_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(http_request_send_bytes, MetricUnit::BYTES);
     METRIC_DEFINE_INT_COUNTER(query_scan_bytes, MetricUnit::BYTES);
     METRIC_DEFINE_INT_COUNTER(query_scan_rows, MetricUnit::ROWS);
+    // The bytes scanned by the queries by where they were read from, the local disk ones are query_scan_bytes.
+    METRIC_DEFINE_INT_COUNTER(query_scan_page_cache_bytes, MetricUnit::BYTES);
+    METRIC_DEFINE_INT_COUNTER(query_scan_remote_bytes, MetricUnit::BYTES);
+    METRIC_DEFINE_INT_COUNTER(query_scan_index_filtered_bytes, MetricUnit::BYTES);
     METRIC_DEFINE_INT_COUNTER(push_requests_success_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(push_requests_fail_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(push_request_duration_us, MetricUnit::MICROSECONDS);
@@ -204,6 +210,7 @@ public:
     METRIC_DEFINE_UINT_GAUGE(fragment_endpoint_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(active_scan_context_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(plan_fragment_count, MetricUnit::NOUNIT);
+    METRIC_DEFINE_UINT_GAUGE(queued_plan_fragment_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(load_channel_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(result_buffer_block_count, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_GAUGE(result_block_queue_count, MetricUnit::NOUNIT);
@@ -420,6 +420,26 @@ public:
         return true;
     }
 
+    // add the values of a batch with weight 1, which are buffered as the unprocessed centroids and
+    // processed at once whenever the buffer is full.
+    void add(const Value* values, size_t size) {
+        while (size > 0) {
+            const size_t room = _unprocessed.size() < _max_unprocessed ? _max_unprocessed - _unprocessed.size() : 1;
+            const size_t n = std::min(size, room);
+            for (size_t i = 0; i < n; i++) {
+                if (!std::isnan(values[i])) {
+                    _unprocessed.emplace_back(values[i], 1);
+                    _unprocessed_weight += 1;
+                }
+            }
+            values += n;
+            size -= n;
+            if (_unprocessed.size() >= _max_unprocessed) {
+                process();
+            }
+        }
+    }
+
     inline void add(std::vector<Centroid>::const_iterator iter, std::vector<Centroid>::const_iterator end) {
         while (iter != end) {
             const size_t diff = std::distance(iter, end);
@@ -432,8 +452,9 @@ public:
         }
     }
 
+    // The sizes of the centroid lists are serialized as uint32_t.
     uint64_t serialize_size() const {
-        return sizeof(Value) * 5 + sizeof(Index) * 2 + sizeof(size_t) * 3 + _processed.size() * sizeof(Centroid) +
+        return sizeof(Value) * 5 + sizeof(Index) * 2 + sizeof(uint32_t) * 3 + _processed.size() * sizeof(Centroid) +
                _unprocessed.size() * sizeof(Centroid) + _cumulative.size() * sizeof(Weight);
     }
 
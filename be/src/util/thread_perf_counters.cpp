@@ -0,0 +1,119 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/thread_perf_counters.h"
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include "common/logging.h"
+
+namespace starrocks {
+
+static int perf_event_open(perf_event_attr* attr, int group_fd) {
+    attr->size = sizeof(*attr);
+    // The calling thread on any cpu.
+    return syscall(__NR_perf_event_open, attr, 0, -1, group_fd, 0);
+}
+
+static void init_event_attr(ThreadPerfCounters::Event event, perf_event_attr* attr) {
+    memset(attr, 0, sizeof(*attr));
+    attr->type = PERF_TYPE_HARDWARE;
+    switch (event) {
+    case ThreadPerfCounters::CPU_CYCLES:
+        attr->config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case ThreadPerfCounters::INSTRUCTIONS:
+        attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case ThreadPerfCounters::LLC_MISSES:
+        attr->type = PERF_TYPE_HW_CACHE;
+        attr->config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case ThreadPerfCounters::BRANCH_MISSES:
+        attr->config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    default:
+        DCHECK(false);
+    }
+    attr->exclude_kernel = 1;
+    attr->exclude_hv = 1;
+    attr->read_format = PERF_FORMAT_GROUP;
+}
+
+ThreadPerfCounters* ThreadPerfCounters::get() {
+    // Not opened again on the thread once failed.
+    static thread_local bool tls_opened = false;
+    static thread_local std::unique_ptr<ThreadPerfCounters> tls_counters;
+    if (!tls_opened) {
+        tls_opened = true;
+        std::unique_ptr<ThreadPerfCounters> counters(new ThreadPerfCounters());
+        if (counters->_open()) {
+            tls_counters = std::move(counters);
+        }
+    }
+    return tls_counters.get();
+}
+
+ThreadPerfCounters::~ThreadPerfCounters() {
+    _close();
+}
+
+bool ThreadPerfCounters::_open() {
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        perf_event_attr attr;
+        init_event_attr(static_cast<Event>(i), &attr);
+        _fds[i] = perf_event_open(&attr, _fds[0]);
+        if (_fds[i] < 0) {
+            LOG(WARNING) << "Failed to open the perf event " << name(static_cast<Event>(i))
+                         << ", errno=" << errno << ", " << strerror(errno);
+            _close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void ThreadPerfCounters::_close() {
+    for (int& fd : _fds) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+bool ThreadPerfCounters::read(Values* values) const {
+    // struct read_format { u64 nr; u64 values[nr]; } of PERF_FORMAT_GROUP.
+    uint64_t buffer[1 + NUM_EVENTS];
+    ssize_t n = ::read(_fds[0], buffer, sizeof(buffer));
+    if (n != sizeof(buffer) || buffer[0] != NUM_EVENTS) {
+        return false;
+    }
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        (*values)[i] = buffer[1 + i];
+    }
+    return true;
+}
+
+const char* ThreadPerfCounters::name(Event event) {
+    switch (event) {
+    case CPU_CYCLES:
+        return "HWCycles";
+    case INSTRUCTIONS:
+        return "HWInstructions";
+    case LLC_MISSES:
+        return "HWLLCMisses";
+    case BRANCH_MISSES:
+        return "HWBranchMisses";
+    default:
+        return "";
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,51 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace starrocks {
+
+// The hardware counters of the calling thread, opened as one perf_event group so that they are counted over the
+// same time and read together by one syscall. Unlike PerfCounters, which counts the process, they are cheap enough
+// to be read around each pull_chunk and push_chunk of the pipeline operators.
+//
+// Only counts the user space, so that it works with kernel.perf_event_paranoid up to 2.
+class ThreadPerfCounters {
+public:
+    enum Event {
+        CPU_CYCLES = 0,
+        INSTRUCTIONS,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        NUM_EVENTS,
+    };
+
+    using Values = std::array<int64_t, NUM_EVENTS>;
+
+    // The counters of the calling thread, opened by the first call on the thread and closed when it exits.
+    // Returns nullptr if they are not available, e.g. not permitted or not virtualized by the hypervisor.
+    static ThreadPerfCounters* get();
+
+    ~ThreadPerfCounters();
+
+    ThreadPerfCounters(const ThreadPerfCounters&) = delete;
+    void operator=(const ThreadPerfCounters&) = delete;
+
+    // The events counted since the counters were opened. Returns false if they failed to be read.
+    bool read(Values* values) const;
+
+    static const char* name(Event event);
+
+private:
+    ThreadPerfCounters() = default;
+
+    bool _open();
+    void _close();
+
+    // The first one is the group leader.
+    std::array<int, NUM_EVENTS> _fds{-1, -1, -1, -1};
+};
+
+} // namespace starrocks
@@ -0,0 +1,67 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/thread_pool_metrics.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+#include "util/starrocks_metrics.h"
+
+namespace starrocks {
+
+const int64_t LatencyHistogramMetric::BOUNDS_US[NUM_BOUNDS] = {50,     100,    500,     1000,    5000,    10000,
+                                                               50000,  100000, 500000,  1000000, 5000000, 10000000};
+
+LatencyHistogramMetric::LatencyHistogramMetric() {
+    for (int i = 0; i <= NUM_BOUNDS; i++) {
+        _buckets.emplace_back(std::make_unique<IntCounter>(MetricUnit::NOUNIT));
+    }
+}
+
+void LatencyHistogramMetric::add(int64_t latency_ns) {
+    int64_t latency_us = std::max<int64_t>(latency_ns, 0) / 1000;
+    _buckets[NUM_BOUNDS]->increment(1);
+    for (int i = NUM_BOUNDS - 1; i >= 0 && latency_us <= BOUNDS_US[i]; i--) {
+        _buckets[i]->increment(1);
+    }
+    _sum.increment(latency_us);
+    _count.increment(1);
+}
+
+void LatencyHistogramMetric::register_metrics(MetricRegistry* registry, const std::string& name,
+                                              const MetricLabels& labels) {
+    for (int i = 0; i < NUM_BOUNDS; i++) {
+        MetricLabels bucket_labels = labels;
+        bucket_labels.add("le", std::to_string(BOUNDS_US[i]));
+        registry->register_metric(name + "_bucket", bucket_labels, _buckets[i].get());
+    }
+    MetricLabels inf_labels = labels;
+    inf_labels.add("le", "+Inf");
+    registry->register_metric(name + "_bucket", inf_labels, _buckets[NUM_BOUNDS].get());
+    registry->register_metric(name + "_sum", labels, &_sum);
+    registry->register_metric(name + "_count", labels, &_count);
+}
+
+ThreadPoolMetrics* ThreadPoolMetrics::get(const std::string& pool_name) {
+    static std::mutex s_lock;
+    static std::map<std::string, ThreadPoolMetrics*> s_pools;
+
+    std::lock_guard<std::mutex> l(s_lock);
+    auto [it, inserted] = s_pools.emplace(pool_name, nullptr);
+    if (inserted) {
+        auto* pool = new ThreadPoolMetrics();
+        it->second = pool;
+        auto* registry = StarRocksMetrics::instance()->metrics();
+        MetricLabels labels;
+        labels.add("pool", pool_name);
+        registry->register_metric("thread_pool_queue_depth", labels, &pool->_queue_depth);
+        registry->register_metric("thread_pool_active_threads", labels, &pool->_active_threads);
+        registry->register_metric("thread_pool_rejected_tasks_total", labels, &pool->_rejected_tasks);
+        pool->_task_wait_time.register_metrics(registry, "thread_pool_task_wait_time_us", labels);
+        pool->_task_run_time.register_metrics(registry, "thread_pool_task_run_time_us", labels);
+    }
+    return it->second;
+}
+
+} // namespace starrocks
@@ -0,0 +1,92 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "util/metrics.h"
+
+namespace starrocks {
+
+// The cumulative buckets of the latencies, reported in microseconds like a Prometheus histogram: the counter
+// <name>_bucket{le="<bound>"} counts the latencies of at most <bound>us, and <name>_sum and <name>_count are their
+// total and their number.
+class LatencyHistogramMetric {
+public:
+    static constexpr int NUM_BOUNDS = 12;
+    // In microseconds, from 50us to 10s.
+    static const int64_t BOUNDS_US[NUM_BOUNDS];
+
+    LatencyHistogramMetric();
+
+    LatencyHistogramMetric(const LatencyHistogramMetric&) = delete;
+    LatencyHistogramMetric& operator=(const LatencyHistogramMetric&) = delete;
+
+    void add(int64_t latency_ns);
+
+    // Register the counters named after |name| with |labels| and the label le of the bounds.
+    void register_metrics(MetricRegistry* registry, const std::string& name, const MetricLabels& labels);
+
+    int64_t count() const { return _count.value(); }
+    // The number of the latencies of at most BOUNDS_US[i], or of all of them for the last bucket of +Inf.
+    int64_t bucket_count(int i) const { return _buckets[i]->value(); }
+
+private:
+    // A metric can't be registered twice, so the bucket of +Inf is not |_count|.
+    std::vector<std::unique_ptr<IntCounter>> _buckets;
+    IntCounter _sum{MetricUnit::MICROSECONDS};
+    IntCounter _count{MetricUnit::NOUNIT};
+};
+
+// The standardized metrics of the thread pools named |pool_name|, registered in StarRocksMetrics with the label
+// pool=<pool_name>:
+//   thread_pool_queue_depth: the tasks waiting for a worker.
+//   thread_pool_active_threads: the workers running a task.
+//   thread_pool_rejected_tasks_total: the tasks failed to be submitted, e.g. as the queue was full.
+//   thread_pool_task_wait_time_us: the histogram of the time the tasks waited in the queue.
+//   thread_pool_task_run_time_us: the histogram of the time the tasks ran.
+//
+// The pools of the same name, e.g. those created per writer, share the metrics.
+class ThreadPoolMetrics {
+public:
+    // The metrics of the pools named |pool_name|, created on the first call and never freed.
+    static ThreadPoolMetrics* get(const std::string& pool_name);
+
+    void task_queued() { _queue_depth.increment(1); }
+    // A queued task is taken by a worker after waiting |wait_ns|.
+    void task_dequeued(int64_t wait_ns) {
+        _queue_depth.increment(-1);
+        task_waited(wait_ns);
+    }
+    // Only the wait time, for the pools whose queue depth is set by themselves.
+    void task_waited(int64_t wait_ns) { _task_wait_time.add(wait_ns); }
+    // The queued tasks are dropped, e.g. by a shutdown.
+    void tasks_dropped(int64_t num_tasks) { _queue_depth.increment(-num_tasks); }
+    void task_rejected() { _rejected_tasks.increment(1); }
+
+    void task_started() { _active_threads.increment(1); }
+    void task_finished(int64_t run_ns) {
+        _active_threads.increment(-1);
+        _task_run_time.add(run_ns);
+    }
+
+    // For the pools which know their queue depth better, e.g. by a hook.
+    IntGauge* queue_depth() { return &_queue_depth; }
+    int64_t active_threads() const { return _active_threads.value(); }
+    int64_t rejected_tasks() const { return _rejected_tasks.value(); }
+    const LatencyHistogramMetric& task_wait_time() const { return _task_wait_time; }
+    const LatencyHistogramMetric& task_run_time() const { return _task_run_time; }
+
+private:
+    ThreadPoolMetrics() = default;
+
+    IntGauge _queue_depth{MetricUnit::NOUNIT};
+    IntGauge _active_threads{MetricUnit::NOUNIT};
+    IntCounter _rejected_tasks{MetricUnit::NOUNIT};
+    LatencyHistogramMetric _task_wait_time;
+    LatencyHistogramMetric _task_run_time;
+};
+
+} // namespace starrocks
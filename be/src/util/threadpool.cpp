@@ -32,6 +32,7 @@
 #include "gutil/sysinfo.h"
 #include "util/scoped_cleanup.h"
 #include "util/thread.h"
+#include "util/thread_pool_metrics.h"
 
 namespace starrocks {
 
@@ -109,6 +110,7 @@ void ThreadPoolToken::shutdown() {
     // also prevents lock inversions.
     std::deque<ThreadPool::Task> to_release = std::move(_entries);
     _pool->_total_queued_tasks -= to_release.size();
+    _pool->_metrics->tasks_dropped(to_release.size());
 
     switch (state()) {
     case State::IDLE:
@@ -235,6 +237,7 @@ ThreadPool::ThreadPool(const ThreadPoolBuilder& builder)
           _num_threads_pending_start(0),
           _active_threads(0),
           _total_queued_tasks(0),
+          _metrics(ThreadPoolMetrics::get(builder._name)),
           _tokenless(new_token(ExecutionMode::CONCURRENT)) {}
 
 ThreadPool::~ThreadPool() {
@@ -301,6 +304,7 @@ void ThreadPool::shutdown() {
     // The queues are empty. Wake any sleeping worker threads and wait for all
     // of them to exit. Some worker threads will exit immediately upon waking,
     // while others will exit after they finish executing an outstanding task.
+    _metrics->tasks_dropped(_total_queued_tasks);
     _total_queued_tasks = 0;
     while (!_idle_threads.empty()) {
         _idle_threads.front().not_empty.notify_one();
@@ -342,10 +346,12 @@ Status ThreadPool::do_submit(std::shared_ptr<Runnable> r, ThreadPoolToken* token
 
     std::unique_lock unique_lock(_lock);
     if (PREDICT_FALSE(!_pool_status.ok())) {
+        _metrics->task_rejected();
         return _pool_status;
     }
 
     if (PREDICT_FALSE(!token->may_submit_new_tasks())) {
+        _metrics->task_rejected();
         return Status::ServiceUnavailable("Thread pool token was shut down");
     }
 
@@ -353,6 +359,7 @@ Status ThreadPool::do_submit(std::shared_ptr<Runnable> r, ThreadPoolToken* token
     int64_t capacity_remaining = static_cast<int64_t>(_max_threads) - _active_threads +
                                  static_cast<int64_t>(_max_queue_size) - _total_queued_tasks;
     if (capacity_remaining < 1) {
+        _metrics->task_rejected();
         return Status::ServiceUnavailable(strings::Substitute(
                 "Thread pool is at capacity ($0/$1 tasks running, $2/$3 tasks queued)",
                 _num_threads + _num_threads_pending_start, _max_threads, _total_queued_tasks, _max_queue_size));
@@ -398,6 +405,7 @@ Status ThreadPool::do_submit(std::shared_ptr<Runnable> r, ThreadPoolToken* token
         }
     }
     _total_queued_tasks++;
+    _metrics->task_queued();
 
     // Wake up an idle thread for this task. Choosing the thread at the front of
     // the list ensures LIFO semantics as idling threads are also added to the front.
@@ -511,8 +519,12 @@ void ThreadPool::dispatch_thread() {
 
         l.unlock();
 
+        MonoTime start_time = MonoTime::Now();
+        _metrics->task_dequeued((start_time - task.submit_time).ToNanoseconds());
+        _metrics->task_started();
         // Execute the task
         task.runnable->run();
+        _metrics->task_finished((MonoTime::Now() - start_time).ToNanoseconds());
 
         // Destruct the task while we do not hold the lock.
         //
@@ -42,6 +42,7 @@ namespace starrocks {
 class Thread;
 class ThreadPool;
 class ThreadPoolToken;
+class ThreadPoolMetrics;
 
 class Runnable {
 public:
@@ -281,6 +282,9 @@ private:
     // Protected by _lock.
     int _total_queued_tasks;
 
+    // The standardized metrics of the pools of this name.
+    ThreadPoolMetrics* const _metrics;
+
     // All allocated tokens.
     //
     // Protected by _lock.
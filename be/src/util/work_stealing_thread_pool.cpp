@@ -0,0 +1,170 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/work_stealing_thread_pool.h"
+
+#include "common/logging.h"
+
+namespace starrocks {
+
+// The pool and the index of the worker running on this thread, to put the tasks it offers into its own queue.
+static thread_local const WorkStealingThreadPool* tls_pool = nullptr;
+static thread_local int tls_worker_index = -1;
+
+WorkStealingThreadPool::WorkStealingThreadPool(const std::string& name, uint32_t num_threads, uint32_t queue_size)
+        : _capacity(queue_size), _metrics(ThreadPoolMetrics::get(name)) {
+    num_threads = std::max<uint32_t>(num_threads, 1);
+    for (int i = 0; i < num_threads; i++) {
+        _workers.emplace_back(std::make_unique<Worker>());
+    }
+    for (int i = 0; i < num_threads; i++) {
+        _threads.emplace_back(&WorkStealingThreadPool::_work_thread, this, i);
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    shutdown();
+    join();
+}
+
+bool WorkStealingThreadPool::offer(const Task& task) {
+    for (;;) {
+        if (_try_push(task)) {
+            return true;
+        }
+        if (_shutdown.load(std::memory_order_acquire)) {
+            _metrics->task_rejected();
+            return false;
+        }
+        uint64_t key = _not_full.prepare_wait();
+        if (_shutdown.load(std::memory_order_acquire) || _num_queued.load() < static_cast<int64_t>(_capacity)) {
+            _not_full.cancel_wait();
+            continue;
+        }
+        _not_full.wait(key);
+    }
+}
+
+bool WorkStealingThreadPool::try_offer(const Task& task) {
+    if (!_try_push(task)) {
+        _metrics->task_rejected();
+        return false;
+    }
+    return true;
+}
+
+bool WorkStealingThreadPool::_try_push(const Task& task) {
+    if (_shutdown.load(std::memory_order_acquire)) {
+        return false;
+    }
+    if (_num_queued.fetch_add(1) >= static_cast<int64_t>(_capacity)) {
+        _num_queued.fetch_sub(1);
+        return false;
+    }
+    return _push(task);
+}
+
+void WorkStealingThreadPool::shutdown() {
+    _shutdown.store(true, std::memory_order_release);
+    _not_empty.notify_all();
+    _not_full.notify_all();
+}
+
+void WorkStealingThreadPool::join() {
+    for (auto& thread : _threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+int WorkStealingThreadPool::_lane_of(const Task& task) {
+    // The priorities of the scan tasks are in [0, 20], the highest for the tasks of the scans just started.
+    if (task.priority >= 14) {
+        return 0;
+    }
+    return task.priority >= 7 ? 1 : 2;
+}
+
+bool WorkStealingThreadPool::_push(const Task& task) {
+    int index = tls_pool == this ? tls_worker_index
+                                 : static_cast<int>(_next_worker.fetch_add(1, std::memory_order_relaxed) %
+                                                    _workers.size());
+    Worker* worker = _workers[index].get();
+    // Counted before being taken by a worker.
+    _metrics->task_queued();
+    {
+        std::lock_guard<std::mutex> l(worker->lock);
+        Lane& lane = worker->lanes[_lane_of(task)];
+        std::deque<Task>& tasks = lane.tasks[task.group_id];
+        if (tasks.empty()) {
+            lane.groups.push_back(task.group_id);
+        }
+        tasks.push_back(task);
+        tasks.back().submit_time_ns = MonotonicNanos();
+    }
+    _not_empty.notify_one();
+    return true;
+}
+
+bool WorkStealingThreadPool::_pop(int index, bool low_first, Task* task) {
+    Worker* worker = _workers[index].get();
+    std::lock_guard<std::mutex> l(worker->lock);
+    for (int i = 0; i < kNumLanes; i++) {
+        Lane& lane = worker->lanes[low_first ? kNumLanes - 1 - i : i];
+        if (lane.groups.empty()) {
+            continue;
+        }
+        uint64_t group_id = lane.groups.front();
+        lane.groups.pop_front();
+        auto iter = lane.tasks.find(group_id);
+        DCHECK(iter != lane.tasks.end());
+        *task = std::move(iter->second.front());
+        iter->second.pop_front();
+        if (iter->second.empty()) {
+            lane.tasks.erase(iter);
+        } else {
+            lane.groups.push_back(group_id);
+        }
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingThreadPool::_work_thread(int index) {
+    tls_pool = this;
+    tls_worker_index = index;
+    const int num_workers = _workers.size();
+    uint64_t num_tasks = 0;
+    while (!_shutdown.load(std::memory_order_acquire)) {
+        bool low_first = (++num_tasks % kLowLaneInterval) == 0;
+        Task task;
+        bool found = _pop(index, low_first, &task);
+        for (int i = 1; !found && i < num_workers; i++) {
+            found = _pop((index + i) % num_workers, low_first, &task);
+        }
+        if (found) {
+            _num_queued.fetch_sub(1);
+            _not_full.notify_one();
+            int64_t start_time_ns = MonotonicNanos();
+            _metrics->task_dequeued(start_time_ns - task.submit_time_ns);
+            _metrics->task_started();
+            task.work_function();
+            _metrics->task_finished(MonotonicNanos() - start_time_ns);
+            continue;
+        }
+        uint64_t key = _not_empty.prepare_wait();
+        // A task counted but not pushed yet is taken by the next round.
+        if (_shutdown.load(std::memory_order_acquire) || _num_queued.load() > 0) {
+            _not_empty.cancel_wait();
+            if (_num_queued.load() > 0) {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        _not_empty.wait(key);
+    }
+    tls_pool = nullptr;
+    tls_worker_index = -1;
+}
+
+} // namespace starrocks
@@ -0,0 +1,96 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "util/mpmc_queue.h"
+#include "util/priority_thread_pool.hpp"
+
+namespace starrocks {
+
+// WorkStealingThreadPool runs the tasks of PriorityThreadPool with the same interface, but without the global
+// priority queue and its lock. Every worker has its own queues, which the tasks offered by the worker itself are put
+// into, and the other tasks are spread over round robin. An idle worker steals from the others.
+//
+// The queue of a worker has kNumLanes lanes by the priority of the tasks, and the lane is taken from the highest
+// one, except for every kLowLaneInterval-th task taken from the lowest one, not to starve the low priority tasks. In
+// a lane the tasks are grouped by their group_id, e.g. of the query, and the groups are taken round robin, so that a
+// query offering many tasks only delays its own.
+class WorkStealingThreadPool {
+public:
+    using Task = PriorityThreadPool::Task;
+    using WorkFunction = PriorityThreadPool::WorkFunction;
+
+    // Starts |num_threads| workers. At most |queue_size| tasks are queued, and the subsequent offer() blocks.
+    // |name| is the name of the pool in ThreadPoolMetrics.
+    WorkStealingThreadPool(const std::string& name, uint32_t num_threads, uint32_t queue_size);
+
+    ~WorkStealingThreadPool();
+
+    // Blocks until there is capacity available. Returns false iff the pool has been shut down.
+    bool offer(const Task& task);
+
+    bool offer(WorkFunction func) { return offer(Task{0, std::move(func)}); }
+
+    // Returns false if the queue is full or the pool has been shut down.
+    bool try_offer(const Task& task);
+
+    // The workers terminate once they have processed their current tasks, and the queued tasks are dropped.
+    // Does not wait for the workers to terminate.
+    void shutdown();
+
+    // Blocks until all the workers are finished.
+    void join();
+
+    size_t get_queue_capacity() const { return _capacity; }
+
+    uint32_t get_queue_size() const { return std::max<int64_t>(0, _num_queued.load(std::memory_order_relaxed)); }
+
+private:
+    static constexpr int kNumLanes = 3;
+    static constexpr int kLowLaneInterval = 8;
+
+    struct Lane {
+        std::unordered_map<uint64_t, std::deque<Task>> tasks;
+        // The groups with queued tasks, in the order to be taken.
+        std::deque<uint64_t> groups;
+    };
+
+    struct Worker {
+        std::mutex lock;
+        Lane lanes[kNumLanes];
+    };
+
+    static int _lane_of(const Task& task);
+
+    // Returns false if the queue is full or the pool has been shut down.
+    bool _try_push(const Task& task);
+    bool _push(const Task& task);
+    // Take a task of the worker |index|, from the highest lane unless |low_first|.
+    bool _pop(int index, bool low_first, Task* task);
+    void _work_thread(int index);
+
+    const size_t _capacity;
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::thread> _threads;
+
+    // Including the tasks being pushed, which are counted first to reserve the capacity.
+    std::atomic<int64_t> _num_queued{0};
+    std::atomic<uint32_t> _next_worker{0};
+    std::atomic<bool> _shutdown{false};
+    EventCount _not_empty;
+    EventCount _not_full;
+    ThreadPoolMetrics* _metrics;
+};
+
+} // namespace starrocks
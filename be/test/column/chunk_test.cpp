@@ -23,8 +23,10 @@
 
 #include <gtest/gtest.h>
 
+#include "column/binary_column.h"
 #include "column/field.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
 
 namespace starrocks::vectorized {
 
@@ -173,6 +175,57 @@ TEST_F(ChunkTest, test_serde) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_serialize_encoded) {
+    // A small range, a large range, a few runs, low cardinality strings and unique strings.
+    auto small_range = FixedLengthColumn<int32_t>::create();
+    auto large_range = FixedLengthColumn<int64_t>::create();
+    auto runs = NullableColumn::create(FixedLengthColumn<int16_t>::create(), NullColumn::create());
+    auto low_cardinality = BinaryColumn::create();
+    auto unique = BinaryColumn::create();
+    for (int i = 0; i < 1000; i++) {
+        small_range->append(1000000 + i % 77);
+        large_range->append(static_cast<int64_t>(i) << 40);
+        if (i / 100 % 2 == 0) {
+            runs->append_nulls(1);
+        } else {
+            runs->append_datum(Datum(static_cast<int16_t>(i / 100)));
+        }
+        low_cardinality->append(make_string(i % 5));
+        unique->append(make_string(i));
+    }
+    Columns columns{small_range, large_range, runs, low_cardinality, unique};
+
+    Chunk chunk;
+    for (size_t i = 0; i < columns.size(); i++) {
+        chunk.append_column(columns[i], i);
+    }
+    std::string buffer;
+    buffer.resize(chunk.max_serialize_encoded_size());
+    buffer.resize(chunk.serialize_encoded((uint8_t*)buffer.data()));
+    ASSERT_LT(buffer.size(), chunk.serialize_size());
+
+    RuntimeChunkMeta meta;
+    meta.slot_id_to_index.init(columns.size());
+    for (size_t i = 0; i < columns.size(); i++) {
+        meta.slot_id_to_index.insert(i, i);
+    }
+    meta.is_nulls = {false, false, true, false, false};
+    meta.is_consts.resize(columns.size(), false);
+    meta.types = {TypeDescriptor(TYPE_INT), TypeDescriptor(TYPE_BIGINT), TypeDescriptor(TYPE_SMALLINT),
+                  TypeDescriptor::create_varchar_type(10), TypeDescriptor::create_varchar_type(10)};
+
+    Chunk new_chunk;
+    ASSERT_TRUE(new_chunk.deserialize((uint8_t*)buffer.data(), buffer.size(), meta).ok());
+    ASSERT_EQ(chunk.num_rows(), new_chunk.num_rows());
+    for (size_t i = 0; i < columns.size(); ++i) {
+        ASSERT_EQ(columns[i]->has_null(), new_chunk.get_column_by_index(i)->has_null());
+        for (size_t j = 0; j < chunk.num_rows(); ++j) {
+            ASSERT_EQ(columns[i]->debug_item(j), new_chunk.get_column_by_index(i)->debug_item(j));
+        }
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(ChunkTest, test_copy_one_row) {
     auto chunk = std::make_unique<Chunk>(make_columns(2), make_schema(2));
@@ -251,4 +304,24 @@ TEST_F(ChunkTest, test_append_chunk_safe) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_filter) {
+    Buffer<uint8_t> selection(100, 1);
+    auto chunk = std::make_unique<Chunk>(make_columns(2), make_schema(2));
+    ASSERT_EQ(100, chunk->filter(selection));
+    check_column(reinterpret_cast<FixedLengthColumn<int32_t>*>(chunk->get_column_by_index(1).get()), 1);
+
+    // None of the rows after the first 10 is selected.
+    std::fill(selection.begin(), selection.end(), 0);
+    ASSERT_EQ(10, chunk->filter_range(selection, 10, 100));
+    ASSERT_EQ(9, chunk->get_column_by_index(0)->get(9).get_int32());
+
+    selection.assign(10, 0);
+    selection[3] = 1;
+    selection[7] = 1;
+    ASSERT_EQ(2, chunk->filter(selection));
+    ASSERT_EQ(4, chunk->get_column_by_index(1)->get(0).get_int32());
+    ASSERT_EQ(8, chunk->get_column_by_index(1)->get(1).get_int32());
+}
+
 } // namespace starrocks::vectorized
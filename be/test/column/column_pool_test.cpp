@@ -21,7 +21,9 @@
 
 #include "column/column_pool.h"
 
+#include "column/column_helper.h"
 #include "gtest/gtest.h"
+#include "runtime/types.h"
 
 namespace starrocks::vectorized {
 
@@ -78,4 +80,29 @@ TEST_F(ColumnPoolTest, single_thread) {
     delete c4;
 }
 
+// NOLINTNEXTLINE
+TEST_F(ColumnPoolTest, pooled_column_of_type) {
+    const Column* data = nullptr;
+    {
+        ColumnPtr c1 = ColumnHelper::create_column_pooled(TypeDescriptor(TYPE_INT), true);
+        ASSERT_TRUE(c1->is_nullable());
+        c1->reserve(10);
+        c1->append_datum(Datum((int32_t)1));
+        data = down_cast<NullableColumn*>(c1.get())->data_column().get();
+    }
+
+    // The columns are given back to the pool with their capacity, once released.
+    ColumnPtr c2 = ColumnHelper::create_column_pooled(TypeDescriptor(TYPE_INT), false);
+    ASSERT_EQ(data, c2.get());
+    ASSERT_EQ(0, c2->size());
+    ASSERT_EQ(10, down_cast<Int32Column*>(c2.get())->get_data().capacity());
+
+    auto decimal_type = TypeDescriptor::create_decimalv3_type(TYPE_DECIMAL64, 18, 4);
+    ColumnPtr c3 = ColumnHelper::create_column_pooled(decimal_type, false);
+    ASSERT_EQ(4, down_cast<Decimal64Column*>(c3.get())->scale());
+
+    ColumnPtr c4 = ColumnHelper::create_column_pooled(TypeDescriptor(TYPE_HLL), true);
+    ASSERT_TRUE(c4->is_nullable());
+}
+
 } // namespace starrocks::vectorized
@@ -28,6 +28,7 @@
 
 #include "butil/time.h"
 #include "column/fixed_length_column.h"
+#include "common/config.h"
 #include "runtime/date_value.h"
 #include "runtime/timestamp_value.h"
 #include "runtime/vectorized/time_types.h"
@@ -267,5 +268,51 @@ TEST(DateValueTest, weekday) {
     ASSERT_EQ(0, dv.weekday()); // Sunday
 }
 
+TEST(DateValueTest, dateCache) {
+    // within and around the cached years, which test_main initializes
+    JulianDate start = date::from_date(config::date_cache_min_year - 1, 1, 1);
+    JulianDate end = date::from_date(config::date_cache_max_year + 2, 1, 1);
+    for (JulianDate julian = start; julian < end; ++julian) {
+        int year, month, day;
+        date::to_date(julian, &year, &month, &day);
+        int cached_year, cached_month, cached_day;
+        date::to_date_with_cache(julian, &cached_year, &cached_month, &cached_day);
+        ASSERT_EQ(year, cached_year);
+        ASSERT_EQ(month, cached_month);
+        ASSERT_EQ(day, cached_day);
+        ASSERT_EQ(julian - date::from_date(year, 1, 1) + 1, date::get_day_of_year(julian));
+        int weeks;
+        if (date::get_weeks_of_year_with_cache(julian, &weeks)) {
+            ASSERT_EQ(date::get_week_of_year(julian), weeks);
+        }
+    }
+}
+
+TEST(DateValueTest, truncate) {
+    DateValue dv = DateValue::create(2021, 6, 17);
+    dv.trunc_to_month();
+    ASSERT_EQ(DateValue::create(2021, 6, 1), dv);
+    dv = DateValue::create(2021, 6, 17);
+    dv.trunc_to_year();
+    ASSERT_EQ(DateValue::create(2021, 1, 1), dv);
+    dv = DateValue::create(2021, 6, 17);
+    dv.trunc_to_week();
+    ASSERT_EQ(DateValue::create(2021, 6, 14), dv); // Monday
+    // out of the cached years
+    dv = DateValue::create(1600, 3, 5);
+    dv.trunc_to_year();
+    ASSERT_EQ(DateValue::create(1600, 1, 1), dv);
+
+    TimestampValue tv = TimestampValue::create(2021, 6, 17, 12, 34, 56);
+    tv.trunc_to_month();
+    ASSERT_EQ(TimestampValue::create(2021, 6, 1, 0, 0, 0), tv);
+    tv = TimestampValue::create(2021, 6, 17, 12, 34, 56);
+    tv.trunc_to_year();
+    ASSERT_EQ(TimestampValue::create(2021, 1, 1, 0, 0, 0), tv);
+    tv = TimestampValue::create(2021, 6, 17, 12, 34, 56);
+    tv.trunc_to_week(-3);
+    ASSERT_EQ(TimestampValue::create(2021, 6, 14, 0, 0, 0), tv);
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -27,6 +27,7 @@
 #include "column/column_helper.h"
 #include "column/const_column.h"
 #include "column/nullable_column.h"
+#include "util/hash_util.hpp"
 
 namespace starrocks::vectorized {
 
@@ -582,4 +583,69 @@ TEST(FixedLengthColumnTest, test_swap_column) {
     ASSERT_EQ(3, c2->get_data()[2]);
 }
 
+// NOLINTNEXTLINE
+TEST(FixedLengthColumnTest, test_crc32_hash) {
+    // The hashes must be the same as RawValue::zlib_crc32, the values by their bytes, and the dates and datetimes by
+    // their strings.
+    auto c1 = FixedLengthColumn<int64_t>::create();
+    auto c2 = DateColumn::create();
+    auto c3 = TimestampColumn::create();
+    for (int i = 0; i < 10; i++) {
+        c1->append(i * 1000003);
+        c2->append(DateValue::create(2021, 1, i + 1));
+        c3->append(TimestampValue::create(2021, 1, i + 1, 12, 30, i));
+    }
+
+    std::vector<uint32_t> h1(10, 0);
+    std::vector<uint32_t> h2(10, 0);
+    std::vector<uint32_t> h3(10, 0);
+    c1->crc32_hash(h1.data(), 0, 10);
+    c2->crc32_hash(h2.data(), 0, 10);
+    c3->crc32_hash(h3.data(), 0, 10);
+    for (int i = 0; i < 10; i++) {
+        int64_t v = i * 1000003;
+        ASSERT_EQ(HashUtil::zlib_crc_hash(&v, sizeof(v), 0), h1[i]);
+        std::string s2 = c2->get_data()[i].to_string();
+        ASSERT_EQ(HashUtil::zlib_crc_hash(s2.data(), s2.size(), 0), h2[i]);
+        std::string s3 = c3->get_data()[i].to_string();
+        ASSERT_EQ(HashUtil::zlib_crc_hash(s3.data(), s3.size(), 0), h3[i]);
+    }
+}
+
+template <typename T>
+static void test_filter_range(const Column::Filter& filter, size_t from) {
+    auto column = FixedLengthColumn<T>::create();
+    for (size_t i = 0; i < filter.size(); i++) {
+        column->append(static_cast<T>(i * 7 + 1));
+    }
+    std::vector<T> expected;
+    for (size_t i = 0; i < filter.size(); i++) {
+        if (i < from || filter[i]) {
+            expected.push_back(static_cast<T>(i * 7 + 1));
+        }
+    }
+    ASSERT_EQ(expected.size(), column->filter_range(filter, from, filter.size()));
+    ASSERT_EQ(expected, std::vector<T>(column->get_data().begin(), column->get_data().end()));
+}
+
+// NOLINTNEXTLINE
+TEST(FixedLengthColumnTest, test_filter_range) {
+    // The sizes cross the batches of the simd paths, with the selections of none, some and all the rows of a batch.
+    for (size_t size : {0, 7, 63, 64, 65, 129, 1000}) {
+        for (int pattern = 0; pattern < 4; pattern++) {
+            Column::Filter filter(size);
+            for (size_t i = 0; i < size; i++) {
+                filter[i] = pattern == 0 ? 0 : pattern == 1 ? 1 : pattern == 2 ? (i % 3 == 0) : (i / 16 % 2);
+            }
+            for (size_t from : {size_t(0), size / 3}) {
+                test_filter_range<int8_t>(filter, from);
+                test_filter_range<int32_t>(filter, from);
+                test_filter_range<int64_t>(filter, from);
+                test_filter_range<float>(filter, from);
+                test_filter_range<double>(filter, from);
+            }
+        }
+    }
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "env/block_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "env/env_memory.h"
+
+namespace starrocks {
+
+class BlockCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        _cache = std::make_unique<BlockCache>("./ut_dir/block_cache_test", kNumShards * kBlockSize * 64, kBlockSize);
+        ASSERT_TRUE(_cache->init(1).ok());
+        for (int i = 0; i < kFileSize; i++) {
+            _data.push_back('a' + i % 26);
+        }
+        _file = std::make_shared<StringRandomAccessFile>(_data);
+    }
+
+    // wait for the blocks to be written
+    void wait_for_disk_usage(size_t usage) {
+        for (int i = 0; i < 1000 && _cache->disk_usage() < usage; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        ASSERT_EQ(usage, _cache->disk_usage());
+    }
+
+    static constexpr size_t kBlockSize = 1024;
+    static constexpr size_t kFileSize = 10 * 1024 + 100;
+
+    std::unique_ptr<BlockCache> _cache;
+    std::string _data;
+    std::shared_ptr<RandomAccessFile> _file;
+};
+
+// NOLINTNEXTLINE
+TEST_F(BlockCacheTest, test_read_through) {
+    BlockCachedRandomAccessFile file(_cache.get(), _file, kFileSize, 1);
+    std::string buf(3000, '\0');
+
+    // [1000, 4000) over the blocks 0 to 3
+    ASSERT_TRUE(file.read_at(1000, Slice(buf)).ok());
+    ASSERT_EQ(_data.substr(1000, 3000), buf);
+    auto stats = file.take_stats();
+    ASSERT_EQ(0, stats.bytes_read_from_cache);
+    ASSERT_EQ(4 * kBlockSize, stats.bytes_read_into_cache);
+    wait_for_disk_usage(4 * kBlockSize);
+
+    // [2000, 5000) of the blocks 1 to 4, of which 4 is not cached
+    ASSERT_TRUE(file.read_at(2000, Slice(buf)).ok());
+    ASSERT_EQ(_data.substr(2000, 3000), buf);
+    stats = file.take_stats();
+    ASSERT_EQ(4 * kBlockSize - 2000, stats.bytes_read_from_cache);
+    ASSERT_EQ(kBlockSize, stats.bytes_read_into_cache);
+    wait_for_disk_usage(5 * kBlockSize);
+
+    // the last block is partial
+    Slice tail(buf.data(), buf.size());
+    ASSERT_TRUE(file.read(kFileSize - 50, &tail).ok());
+    ASSERT_EQ(50, tail.size);
+    ASSERT_EQ(_data.substr(kFileSize - 50), tail.to_string());
+    ASSERT_FALSE(file.read_at(kFileSize - 50, Slice(buf)).ok());
+
+    // the file rewritten is not read from the blocks of its old version
+    BlockCachedRandomAccessFile new_file(_cache.get(), _file, kFileSize, 2);
+    ASSERT_TRUE(new_file.read_at(1000, Slice(buf)).ok());
+    ASSERT_EQ(_data.substr(1000, 3000), buf);
+    ASSERT_EQ(0, new_file.take_stats().bytes_read_from_cache);
+}
+
+} // namespace starrocks
@@ -88,4 +88,30 @@ TEST_F(CompressedSequentialFileTest, test_LZ4F) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompressedSequentialFileTest, test_read_ahead) {
+    const std::string data = random_string(10 * 1024 * 1024);
+    auto compressed = std::make_shared<CompressedSequentialFile>(LZ4F_compress_to_file(data), LZ4F_decompressor());
+    ReadAheadSequentialFile f(std::move(compressed), 2, 64 * 1024);
+
+    ASSERT_TRUE(f.skip(100).ok());
+    std::string read_data;
+    std::string own_buff(1000, '\0');
+    Slice buff(own_buff);
+    Status st = f.read(&buff);
+    while (st.ok() && buff.size > 0) {
+        read_data.append(buff.data, buff.size);
+        buff = Slice(own_buff);
+        st = f.read(&buff);
+    }
+    ASSERT_TRUE(st.ok()) << st.to_string();
+    ASSERT_EQ(data.substr(100), read_data);
+
+    // destroyed before the input file is read up
+    ReadAheadSequentialFile f2(LZ4F_compress_to_file(data), 1, 1024);
+    buff = Slice(own_buff);
+    ASSERT_TRUE(f2.read(&buff).ok());
+    ASSERT_EQ(1000, buff.size);
+}
+
 } // namespace starrocks
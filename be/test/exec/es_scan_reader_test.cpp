@@ -247,6 +247,27 @@ TEST_F(MockESServerTest, workflow) {
     auto cst = reader.close();
     ASSERT_TRUE(cst.ok());
 }
+
+TEST(ESScrollQueryBuilderTest, sliced_scroll) {
+    std::vector<std::string> fields = {"id", "value"};
+    std::map<std::string, std::string> props;
+    props[ESScanReader::KEY_BATCH_SIZE] = "1024";
+    props[ESScanReader::KEY_SLICE_ID] = "1";
+    props[ESScanReader::KEY_SLICE_MAX] = "4";
+    std::vector<EsPredicate*> predicates;
+    std::map<std::string, std::string> docvalue_context;
+    bool doc_value_mode = false;
+    rapidjson::Document query;
+    query.Parse(ESScrollQueryBuilder::build(props, fields, predicates, docvalue_context, &doc_value_mode).c_str());
+    ASSERT_TRUE(query.HasMember("slice"));
+    ASSERT_EQ(1, query["slice"]["id"].GetInt());
+    ASSERT_EQ(4, query["slice"]["max"].GetInt());
+
+    // A single search of the limit isn't sliced.
+    props[ESScanReader::KEY_TERMINATE_AFTER] = "10";
+    query.Parse(ESScrollQueryBuilder::build(props, fields, predicates, docvalue_context, &doc_value_mode).c_str());
+    ASSERT_FALSE(query.HasMember("slice"));
+}
 } // namespace starrocks
 
 int main(int argc, char* argv[]) {
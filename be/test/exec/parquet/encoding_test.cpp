@@ -71,6 +71,23 @@ struct DecoderChecker {
                 ASSERT_FALSE(st.ok());
             }
         }
+        {
+            // skip the first half of the values
+            auto column = starrocks::vectorized::FixedLengthColumn<T>::create();
+            size_t num_skip = values.size() / 2;
+
+            decoder->set_data(encoded_data);
+            auto st = decoder->skip(num_skip);
+            ASSERT_TRUE(st.ok());
+            st = decoder->next_batch(values.size() - num_skip, ColumnContentType::VALUE, column.get());
+            ASSERT_TRUE(st.ok());
+
+            const T* check = (const T*)column->raw_data();
+            for (size_t i = num_skip; i < values.size(); ++i) {
+                ASSERT_EQ(values[i], *check);
+                check++;
+            }
+        }
     }
 };
 
@@ -262,6 +279,50 @@ TEST_F(ParquetEncodingTest, String) {
     }
 }
 
+TEST_F(ParquetEncodingTest, AppendDictCodes) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 20; i++) {
+        values.push_back(std::to_string(i));
+    }
+    std::vector<Slice> slices(values.begin(), values.end());
+
+    const EncodingInfo* plain_encoding = nullptr;
+    EncodingInfo::get(tparquet::Type::BYTE_ARRAY, tparquet::Encoding::PLAIN, &plain_encoding);
+    ASSERT_TRUE(plain_encoding != nullptr);
+    const EncodingInfo* dict_encoding = nullptr;
+    EncodingInfo::get(tparquet::Type::BYTE_ARRAY, tparquet::Encoding::RLE_DICTIONARY, &dict_encoding);
+    ASSERT_TRUE(dict_encoding != nullptr);
+
+    std::unique_ptr<Encoder> dict_encoder;
+    ASSERT_TRUE(plain_encoding->create_encoder(&dict_encoder).ok());
+    ASSERT_TRUE(dict_encoder->append((uint8_t*)&slices[0], slices.size()).ok());
+    std::unique_ptr<Decoder> dict_decoder;
+    ASSERT_TRUE(plain_encoding->create_decoder(&dict_decoder).ok());
+    dict_decoder->set_data(dict_encoder->build());
+
+    std::unique_ptr<Decoder> decoder;
+    ASSERT_TRUE(dict_encoding->create_decoder(&decoder).ok());
+    ASSERT_TRUE(decoder->set_dict(slices.size(), dict_decoder.get()).ok());
+
+    // the values of a page falling back to the plain encoding, of which "25" and "30" are not in the dictionary
+    std::vector<std::string> plain_values = {"3", "25", "3", "30", "25"};
+    std::vector<Slice> plain_slices(plain_values.begin(), plain_values.end());
+    auto codes = vectorized::FixedLengthColumn<int32_t>::create();
+    ASSERT_TRUE(decoder->append_dict_codes(plain_slices, codes.get()).ok());
+    std::vector<int32_t> expected_codes = {3, 20, 3, 21, 20};
+    ASSERT_EQ(expected_codes.size(), codes->size());
+    for (size_t i = 0; i < expected_codes.size(); i++) {
+        ASSERT_EQ(expected_codes[i], codes->get_data()[i]);
+    }
+
+    auto dict_values = vectorized::BinaryColumn::create();
+    ASSERT_TRUE(decoder->get_dict_values(std::vector<int32_t>{20, 21, 5}, dict_values.get()).ok());
+    ASSERT_EQ(3, dict_values->size());
+    ASSERT_EQ("25", dict_values->get_slice(0).to_string());
+    ASSERT_EQ("30", dict_values->get_slice(1).to_string());
+    ASSERT_EQ("5", dict_values->get_slice(2).to_string());
+}
+
 TEST_F(ParquetEncodingTest, FixedString) {
     std::vector<std::string> values;
     for (int i = 100; i < 200; i++) {
@@ -411,4 +411,38 @@ TEST_F(GroupReaderTest, TestGetNext) {
     _check_chunk(param, chunk, 8, 4);
 }
 
+TEST_F(GroupReaderTest, TestGetNextWithRowRanges) {
+    auto* file = _create_file();
+    auto* param = _create_group_reader_param();
+    param->row_ranges = {{2, 5}, {9, 12}};
+
+    FileMetaData* file_meta;
+    Status status = _create_filemeta(&file_meta, param);
+    ASSERT_TRUE(status.ok());
+
+    auto* group_reader = _pool.add(new GroupReader(file, file_meta, 0));
+    status = group_reader->init(*param);
+    ASSERT_TRUE(status.is_end_of_file());
+
+    replace_column_readers(group_reader, param);
+    group_reader->_read_chunk = _create_chunk(param);
+    group_reader->_selection.resize(8);
+
+    // rows [0, 8) are read, of which [2, 5) are returned
+    auto chunk = _create_chunk(param);
+    size_t row_count = 8;
+    status = group_reader->get_next(&chunk, &row_count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(row_count, 3);
+    _check_chunk(param, chunk, 2, 3);
+
+    // rows [8, 12) are read, of which [9, 12) are returned
+    chunk = _create_chunk(param);
+    row_count = 8;
+    status = group_reader->get_next(&chunk, &row_count);
+    ASSERT_TRUE(status.is_end_of_file());
+    ASSERT_EQ(row_count, 3);
+    _check_chunk(param, chunk, 9, 3);
+}
+
 } // namespace starrocks::parquet
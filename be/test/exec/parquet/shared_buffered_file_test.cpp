@@ -0,0 +1,51 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/parquet/shared_buffered_file.h"
+
+#include <gtest/gtest.h>
+
+#include "env/env_memory.h"
+
+namespace starrocks::parquet {
+
+class SharedBufferedFileTest : public testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 10000; i++) {
+            _data.push_back(static_cast<char>(i % 127));
+        }
+        _file = std::make_unique<StringRandomAccessFile>(_data);
+    }
+
+    std::string _data;
+    std::unique_ptr<RandomAccessFile> _file;
+};
+
+TEST_F(SharedBufferedFileTest, test_read_ahead) {
+    SharedBufferedFile file(_file.get());
+    // [0, 100) and [150, 300) are merged, [1000, 1100) is too far, [2000, 7000) is too large
+    file.read_ahead({{1000, 100}, {150, 150}, {0, 100}, {2000, 5000}}, 100, 1000, 2);
+    ASSERT_EQ(2, file.num_buffers());
+
+    std::string buf(6000, '\0');
+    // buffered
+    ASSERT_TRUE(file.read_at(50, Slice(buf.data(), 200)).ok());
+    ASSERT_EQ(_data.substr(50, 200), buf.substr(0, 200));
+    Slice res(buf.data(), 100);
+    ASSERT_TRUE(file.read(1000, &res).ok());
+    ASSERT_EQ(100, res.size);
+    ASSERT_EQ(_data.substr(1000, 100), buf.substr(0, 100));
+    Slice slices[2] = {Slice(buf.data(), 10), Slice(buf.data() + 10, 20)};
+    ASSERT_TRUE(file.readv_at(200, slices, 2).ok());
+    ASSERT_EQ(_data.substr(200, 30), buf.substr(0, 30));
+
+    // not buffered
+    ASSERT_TRUE(file.read_at(2000, Slice(buf.data(), 5000)).ok());
+    ASSERT_EQ(_data.substr(2000, 5000), buf.substr(0, 5000));
+    res = Slice(buf.data(), 6000);
+    ASSERT_TRUE(file.read(9000, &res).ok());
+    ASSERT_EQ(1000, res.size);
+    ASSERT_FALSE(file.read_at(9900, Slice(buf.data(), 200)).ok());
+}
+
+} // namespace starrocks::parquet
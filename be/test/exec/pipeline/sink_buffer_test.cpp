@@ -0,0 +1,151 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/exchange/sink_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "runtime/runtime_state.h"
+
+namespace starrocks::pipeline {
+
+// The stub records the transmit chunk rpcs of every destination, which are completed by complete_random_rpc.
+class MockBackendServiceStub final : public PBackendService_Stub {
+public:
+    MockBackendServiceStub() : PBackendService_Stub(nullptr) {}
+
+    struct Rpc {
+        int32_t sender_id;
+        std::string data;
+        int64_t sequence;
+        bool eos;
+    };
+
+    void transmit_chunk(google::protobuf::RpcController* controller, const PTransmitChunkParams* request,
+                        PTransmitChunkResult* response, google::protobuf::Closure* done) override {
+        auto* cntl = static_cast<brpc::Controller*>(controller);
+        std::lock_guard<std::mutex> l(_lock);
+        int64_t dest = request->finst_id().lo();
+        if (_in_flight.count(dest) > 0) {
+            _num_concurrent_rpcs++;
+        }
+        _received[dest].push_back(
+                {request->sender_id(), cntl->request_attachment().to_string(), request->sequence(), request->eos()});
+        response->mutable_status()->set_status_code(0);
+        _in_flight[dest] = done;
+    }
+
+    // Completes the in-flight rpc of a random destination, returns false if there isn't any.
+    bool complete_random_rpc(std::mt19937* rand) {
+        google::protobuf::Closure* done = nullptr;
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            if (_in_flight.empty()) {
+                return false;
+            }
+            auto it = std::next(_in_flight.begin(), (*rand)() % _in_flight.size());
+            done = it->second;
+            _in_flight.erase(it);
+        }
+        // Run out of the lock, as the callback sends the next rpc of the destination.
+        done->Run();
+        return true;
+    }
+
+    std::map<int64_t, std::vector<Rpc>> received() {
+        std::lock_guard<std::mutex> l(_lock);
+        return _received;
+    }
+
+    int32_t num_concurrent_rpcs() {
+        std::lock_guard<std::mutex> l(_lock);
+        return _num_concurrent_rpcs;
+    }
+
+private:
+    std::mutex _lock;
+    std::map<int64_t, std::vector<Rpc>> _received;
+    std::map<int64_t, google::protobuf::Closure*> _in_flight;
+    // The rpcs sent while the destination has an in-flight rpc.
+    int32_t _num_concurrent_rpcs = 0;
+};
+
+// NOLINTNEXTLINE
+TEST(SinkBufferTest, test_requests_in_order) {
+    constexpr int32_t num_sinkers = 3;
+    constexpr int32_t num_destinations = 4;
+    constexpr int32_t num_requests = 200;
+
+    TQueryOptions query_options;
+    RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+    std::vector<TPlanFragmentDestination> destinations(num_destinations);
+    for (int32_t i = 0; i < num_destinations; i++) {
+        destinations[i].fragment_instance_id.__set_lo(i);
+    }
+    auto buffer = std::make_shared<SinkBuffer>(&state, destinations);
+    MockBackendServiceStub stub;
+    for (int32_t sinker = 0; sinker < num_sinkers; sinker++) {
+        for (const auto& destination : destinations) {
+            buffer->add_sinker(destination.fragment_instance_id);
+        }
+    }
+
+    // Every sinker sends its requests and then the eos to all the destinations, while the rpcs are completed in a
+    // random order of the destinations.
+    std::vector<std::thread> sinkers;
+    for (int32_t sinker = 0; sinker < num_sinkers; sinker++) {
+        sinkers.emplace_back([&, sinker]() {
+            for (int32_t i = 0; i <= num_requests; i++) {
+                for (int32_t dest = 0; dest < num_destinations; dest++) {
+                    TransmitChunkInfo request;
+                    request.params.mutable_finst_id()->set_hi(0);
+                    request.params.mutable_finst_id()->set_lo(dest);
+                    request.params.set_sender_id(sinker);
+                    request.params.set_eos(i == num_requests);
+                    request.brpc_stub = &stub;
+                    if (i < num_requests) {
+                        request.attachment.append(std::to_string(i));
+                    }
+                    buffer->add_request(std::move(request));
+                }
+            }
+        });
+    }
+    std::mt19937 rand(0);
+    for (auto& sinker : sinkers) {
+        while (sinker.joinable()) {
+            if (!stub.complete_random_rpc(&rand)) {
+                sinker.join();
+            }
+        }
+    }
+    while (stub.complete_random_rpc(&rand)) {
+    }
+    ASSERT_TRUE(buffer->is_finished());
+    ASSERT_FALSE(buffer->is_cancelled());
+    ASSERT_EQ(0, stub.num_concurrent_rpcs());
+
+    auto received = stub.received();
+    ASSERT_EQ(static_cast<size_t>(num_destinations), received.size());
+    for (const auto& [dest, rpcs] : received) {
+        // The requests of every sinker arrive in order, and the eos is sent once in the last rpc.
+        std::vector<int32_t> next_requests(num_sinkers, 0);
+        for (size_t i = 0; i < rpcs.size(); i++) {
+            ASSERT_EQ(static_cast<int64_t>(i), rpcs[i].sequence) << "destination " << dest;
+            ASSERT_EQ(i + 1 == rpcs.size(), rpcs[i].eos) << "destination " << dest;
+            if (!rpcs[i].data.empty()) {
+                ASSERT_EQ(std::to_string(next_requests[rpcs[i].sender_id]++), rpcs[i].data);
+            }
+        }
+        ASSERT_EQ(std::vector<int32_t>(num_sinkers, num_requests), next_requests) << "destination " << dest;
+    }
+}
+
+} // namespace starrocks::pipeline
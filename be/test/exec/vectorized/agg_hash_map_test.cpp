@@ -7,6 +7,9 @@
 #include <any>
 #include <variant>
 
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
 #include "exec/vectorized/aggregate/agg_hash_set.h"
 
 namespace starrocks {
@@ -203,5 +206,80 @@ TEST(HashMapTest, TwoLevelConvert) {
     }
 }
 
+// Packs the rows of |key_columns| into FixedSizeSliceKey<N> by |layout|, and unpacks them into the empty columns
+// like |key_columns|, which must be equal to |key_columns| after the round trip.
+template <size_t N>
+void fixed_size_keys_round_trip(const FixedSizeKeyLayout& layout, const Columns& key_columns,
+                                std::vector<FixedSizeSliceKey<N>>* keys) {
+    size_t num_rows = key_columns[0]->size();
+    pack_fixed_size_keys(layout, key_columns, num_rows, keys);
+    ASSERT_EQ(num_rows, keys->size());
+
+    Columns unpacked_columns;
+    for (const auto& column : key_columns) {
+        unpacked_columns.emplace_back(column->clone_empty());
+    }
+    unpack_fixed_size_keys(layout, *keys, unpacked_columns, num_rows);
+    for (size_t c = 0; c < key_columns.size(); c++) {
+        ASSERT_EQ(key_columns[c]->debug_string(), unpacked_columns[c]->debug_string());
+    }
+}
+
+TEST(HashMapTest, FixedSizeKeyRoundTrip) {
+    // INT at 0, nullable SMALLINT with its null flag at 4 and nullable BIGINT with its null flag at 7, in 16 bytes.
+    FixedSizeKeyLayout layout{{0, 4, false}, {4, 2, true}, {7, 8, true}};
+    auto c1 = Int32Column::create();
+    auto c2 = NullableColumn::create(Int16Column::create(), NullColumn::create());
+    auto c3 = NullableColumn::create(Int64Column::create(), NullColumn::create());
+    for (int i = 0; i < 100; i++) {
+        c1->append(i % 7 - 3);
+        if (i % 5 == 0) {
+            ASSERT_TRUE(c2->append_nulls(1));
+        } else {
+            c2->append_datum(Datum(static_cast<int16_t>(i * 100)));
+        }
+        if (i % 3 == 0) {
+            ASSERT_TRUE(c3->append_nulls(1));
+        } else {
+            c3->append_datum(Datum(static_cast<int64_t>(i) << 40));
+        }
+    }
+    Columns key_columns{c1, c2, c3};
+    std::vector<FixedSizeSliceKey<16>> keys;
+    fixed_size_keys_round_trip(layout, key_columns, &keys);
+
+    // The keys are equal if and only if all the columns of the rows are equal.
+    for (size_t i = 0; i < keys.size(); i++) {
+        for (size_t j = 0; j < keys.size(); j++) {
+            bool equal = c1->compare_at(i, j, *c1, -1) == 0 && c2->compare_at(i, j, *c2, -1) == 0 &&
+                         c3->compare_at(i, j, *c3, -1) == 0;
+            ASSERT_EQ(equal, keys[i] == keys[j]) << i << " " << j;
+        }
+    }
+}
+
+TEST(HashMapTest, FixedSizeKeyNulls) {
+    // The null rows of different values under the null flags, and the only null column, pack into the same keys.
+    FixedSizeKeyLayout layout{{0, 1, true}, {2, 4, true}};
+    auto data = Int32Column::create();
+    data->append(1);
+    data->append(2);
+    auto nulls = NullColumn::create(2, 1);
+    auto c1 = ColumnHelper::create_const_null_column(2);
+    auto c2 = NullableColumn::create(data, nulls);
+    std::vector<FixedSizeSliceKey<8>> keys;
+    pack_fixed_size_keys(layout, Columns{c1, c2}, 2, &keys);
+    ASSERT_EQ(2u, keys.size());
+    ASSERT_TRUE(keys[0] == keys[1]);
+    FixedSizeSliceKeyHash<8, PhmapSeed1> hash;
+    ASSERT_EQ(hash(keys[0]), hash(keys[1]));
+
+    auto unpacked_c1 = NullableColumn::create(Int8Column::create(), NullColumn::create());
+    auto unpacked_c2 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    unpack_fixed_size_keys(layout, keys, Columns{unpacked_c1, unpacked_c2}, 2);
+    ASSERT_EQ("[NULL, NULL]", unpacked_c1->debug_string());
+    ASSERT_EQ("[NULL, NULL]", unpacked_c2->debug_string());
+}
+
 } // namespace vectorized
 } // namespace starrocks
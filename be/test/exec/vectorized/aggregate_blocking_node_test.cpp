@@ -0,0 +1,451 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/aggregate/aggregate_blocking_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
+#include "exec/vectorized/mock_chunks_node.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "runtime/spill_test_env.h"
+#include "util/defer_op.h"
+
+namespace starrocks::vectorized {
+
+// The options of an aggregation of select k1[, k2], count(v), sum(v) group by k1[, k2].
+struct AggregationCase {
+    bool two_keys = false;
+    // The number of the input chunks of 1024 rows.
+    size_t num_chunks = 0;
+    // The random k1 in [0, max_k1) and k2 in [0, max_k2), of which 1/20 are null.
+    int32_t max_k1 = 0;
+    int32_t max_k2 = 0;
+    uint32_t seed = 0;
+    // The input rows are sorted by the keys, nulls first, and aggregated with agg_node.sorted_by_group_keys.
+    bool sorted = false;
+};
+
+class AggregateBlockingNodeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // The input tuple 0 of the slots 0 (k1 INT), 1 (k2 VARCHAR) and 2 (v INT). The intermediate tuple 1 and
+        // the output tuple 2 of the aggregation by k1 are of the slots 3-5 and 6-8 for k1, count(v) and sum(v),
+        // and those of the aggregation by k1 and k2, the tuples 3 and 4, are of the slots 9-12 and 13-16.
+        TDescriptorTableBuilder desc_tbl_builder;
+        TTupleDescriptorBuilder input_builder;
+        input_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("k1").nullable(true).build());
+        input_builder.add_slot(TSlotDescriptorBuilder().string_type(16).column_name("k2").nullable(true).build());
+        input_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("v").nullable(false).build());
+        input_builder.build(&desc_tbl_builder);
+        for (bool two_keys : {false, true}) {
+            for (int i = 0; i < 2; i++) {
+                TTupleDescriptorBuilder tuple_builder;
+                tuple_builder.add_slot(
+                        TSlotDescriptorBuilder().type(TYPE_INT).column_name("k1").nullable(true).build());
+                if (two_keys) {
+                    tuple_builder.add_slot(
+                            TSlotDescriptorBuilder().string_type(16).column_name("k2").nullable(true).build());
+                }
+                tuple_builder.add_slot(
+                        TSlotDescriptorBuilder().type(TYPE_BIGINT).column_name("count").nullable(false).build());
+                tuple_builder.add_slot(
+                        TSlotDescriptorBuilder().type(TYPE_BIGINT).column_name("sum").nullable(true).build());
+                tuple_builder.build(&desc_tbl_builder);
+            }
+        }
+        DescriptorTbl::create(&_pool, desc_tbl_builder.desc_tbl(), &_desc_tbl);
+
+        ASSERT_TRUE(_spill_env.init().ok());
+    }
+
+    static TExprNode slot_ref_node(SlotId slot_id, TPrimitiveType::type type, bool is_nullable) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::SLOT_REF);
+        node.__set_type(gen_type_desc(type));
+        node.__set_num_children(0);
+        TSlotRef t_slot_ref;
+        t_slot_ref.__set_slot_id(slot_id);
+        t_slot_ref.__set_tuple_id(0);
+        node.__set_slot_ref(t_slot_ref);
+        node.__set_use_vectorized(true);
+        node.__set_is_nullable(is_nullable);
+        return node;
+    }
+
+    // The aggregate function |name|(v) of the BIGINT result and intermediate.
+    static TExpr agg_expr(const std::string& name, bool is_nullable) {
+        TFunction fn;
+        fn.name.__set_function_name(name);
+        fn.__set_binary_type(TFunctionBinaryType::BUILTIN);
+        fn.__set_arg_types({gen_type_desc(TPrimitiveType::INT)});
+        fn.__set_ret_type(gen_type_desc(TPrimitiveType::BIGINT));
+        fn.__set_has_var_args(false);
+        TAggregateFunction aggregate_fn;
+        aggregate_fn.__set_intermediate_type(gen_type_desc(TPrimitiveType::BIGINT));
+        fn.__set_aggregate_fn(aggregate_fn);
+
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::AGG_EXPR);
+        node.__set_type(gen_type_desc(TPrimitiveType::BIGINT));
+        node.__set_num_children(1);
+        TAggregateExpr t_agg_expr;
+        t_agg_expr.__set_is_merge_agg(false);
+        node.__set_agg_expr(t_agg_expr);
+        node.__set_fn(fn);
+        node.__set_use_vectorized(true);
+        node.__set_is_nullable(is_nullable);
+        node.__set_has_nullable_child(false);
+        TExpr expr;
+        expr.nodes.emplace_back(node);
+        expr.nodes.emplace_back(slot_ref_node(2, TPrimitiveType::INT, false));
+        return expr;
+    }
+
+    static std::vector<ChunkPtr> random_chunks(const AggregationCase& agg_case) {
+        std::mt19937 rand(agg_case.seed);
+        // The null k1 and k2 are of -1 and the empty word, which are sorted first.
+        std::vector<std::tuple<int32_t, std::string, int32_t>> input_rows;
+        for (size_t i = 0; i < agg_case.num_chunks * 1024; i++) {
+            int32_t k1 = rand() % 20 == 0 ? -1 : static_cast<int32_t>(rand() % agg_case.max_k1);
+            std::string word = "w" + std::to_string(rand() % std::max(agg_case.max_k2, 1));
+            if (rand() % 20 == 0) {
+                word.clear();
+            }
+            input_rows.emplace_back(k1, std::move(word), static_cast<int32_t>(rand() % 1000));
+        }
+        if (agg_case.sorted) {
+            std::sort(input_rows.begin(), input_rows.end());
+        }
+
+        std::vector<ChunkPtr> chunks;
+        for (size_t i = 0; i < agg_case.num_chunks; i++) {
+            auto k1 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+            auto k2 = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+            auto v = Int32Column::create();
+            for (size_t j = i * 1024; j < (i + 1) * 1024; j++) {
+                const auto& [row_k1, row_k2, row_v] = input_rows[j];
+                if (row_k1 < 0) {
+                    EXPECT_TRUE(k1->append_nulls(1));
+                } else {
+                    k1->append_datum(Datum(row_k1));
+                }
+                if (row_k2.empty()) {
+                    EXPECT_TRUE(k2->append_nulls(1));
+                } else {
+                    k2->append_datum(Datum(Slice(row_k2)));
+                }
+                v->append(row_v);
+            }
+            auto chunk = std::make_shared<Chunk>();
+            chunk->append_column(std::move(k1), 0);
+            chunk->append_column(std::move(k2), 1);
+            chunk->append_column(std::move(v), 2);
+            chunks.emplace_back(std::move(chunk));
+        }
+        return chunks;
+    }
+
+    static std::string to_string(const Datum& datum, bool is_string) {
+        if (datum.is_null()) {
+            return "NULL";
+        }
+        return is_string ? datum.get_slice().to_string() : std::to_string(datum.get_int64());
+    }
+
+    static std::string key_to_string(const Datum& k1) { return k1.is_null() ? "NULL" : std::to_string(k1.get_int32()); }
+
+    // The sorted rows of the aggregation computed from the input rows directly.
+    static std::vector<std::string> expected_groups(const AggregationCase& agg_case) {
+        std::map<std::string, std::pair<int64_t, int64_t>> groups;
+        for (const auto& chunk : random_chunks(agg_case)) {
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                std::string key = key_to_string(chunk->get_column_by_slot_id(0)->get(i));
+                if (agg_case.two_keys) {
+                    key += "," + to_string(chunk->get_column_by_slot_id(1)->get(i), true);
+                }
+                auto& group = groups[key];
+                group.first++;
+                group.second += chunk->get_column_by_slot_id(2)->get(i).get_int32();
+            }
+        }
+        std::vector<std::string> rows;
+        for (const auto& [key, group] : groups) {
+            rows.emplace_back(key + "," + std::to_string(group.first) + "," + std::to_string(group.second));
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    static TPlanNode agg_tnode(const AggregationCase& agg_case) {
+        TupleId intermediate_tuple_id = agg_case.two_keys ? 3 : 1;
+        TupleId output_tuple_id = intermediate_tuple_id + 1;
+        TAggregationNode agg_node;
+        std::vector<TExpr> grouping_exprs(1);
+        grouping_exprs[0].nodes.emplace_back(slot_ref_node(0, TPrimitiveType::INT, true));
+        if (agg_case.two_keys) {
+            grouping_exprs.emplace_back();
+            grouping_exprs[1].nodes.emplace_back(slot_ref_node(1, TPrimitiveType::VARCHAR, true));
+        }
+        agg_node.__set_grouping_exprs(grouping_exprs);
+        agg_node.__set_aggregate_functions({agg_expr("count", false), agg_expr("sum", true)});
+        agg_node.__set_intermediate_tuple_id(intermediate_tuple_id);
+        agg_node.__set_output_tuple_id(output_tuple_id);
+        agg_node.__set_need_finalize(true);
+        agg_node.__set_sorted_by_group_keys(agg_case.sorted);
+
+        TPlanNode tnode;
+        tnode.__set_node_id(1);
+        tnode.__set_node_type(TPlanNodeType::AGGREGATION_NODE);
+        tnode.__set_num_children(1);
+        tnode.__set_limit(-1);
+        tnode.__set_row_tuples({output_tuple_id});
+        tnode.__set_nullable_tuples({false});
+        tnode.__set_use_vectorized(true);
+        tnode.__set_agg_node(agg_node);
+        return tnode;
+    }
+
+    // Appends the rows of an output |chunk| of the aggregation.
+    void append_rows(const AggregationCase& agg_case, const Chunk& chunk, std::vector<std::string>* rows) {
+        TupleId output_tuple_id = agg_case.two_keys ? 4 : 2;
+        const auto& slots = _desc_tbl->get_tuple_descriptor(output_tuple_id)->slots();
+        for (size_t i = 0; i < chunk.num_rows(); i++) {
+            std::string row = key_to_string(chunk.get_column_by_slot_id(slots[0]->id())->get(i));
+            for (size_t j = 1; j < slots.size(); j++) {
+                bool is_string = agg_case.two_keys && j == 1;
+                row += "," + to_string(chunk.get_column_by_slot_id(slots[j]->id())->get(i), is_string);
+            }
+            rows->emplace_back(std::move(row));
+        }
+    }
+
+    // The sorted rows of the aggregation by an AggregateBlockingNode under an instance memory limit of |mem_limit|
+    // bytes with the spilling enabled, or without any limit if |mem_limit| is -1. |num_spilled_partitions| is set to
+    // the number of the spilled partitions, and |map_type| to the type of the hash map of the first partition.
+    std::vector<std::string> aggregate(const AggregationCase& agg_case, int64_t mem_limit,
+                                       int64_t* num_spilled_partitions, HashMapVariant::Type* map_type) {
+        TQueryOptions query_options;
+        query_options.__set_enable_spilling(mem_limit > 0);
+        RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+        // Not registered with the thread mgr of the exec env, which is only for the spilled files.
+        state._exec_env = _spill_env.exec_env();
+        state._instance_mem_tracker = std::make_unique<MemTracker>(mem_limit);
+        state.set_desc_tbl(_desc_tbl);
+
+        TPlanNode tnode = agg_tnode(agg_case);
+        TPlanNode child_tnode;
+        child_tnode.__set_node_id(0);
+        child_tnode.__set_node_type(TPlanNodeType::EXCHANGE_NODE);
+        child_tnode.__set_num_children(0);
+        child_tnode.__set_limit(-1);
+        child_tnode.__set_row_tuples({0});
+        child_tnode.__set_nullable_tuples({false});
+        child_tnode.__set_use_vectorized(true);
+
+        AggregateBlockingNode node(&_pool, tnode, *_desc_tbl);
+        MockChunksNode child(&_pool, child_tnode, *_desc_tbl, random_chunks(agg_case));
+        node._children.push_back(&child);
+
+        std::vector<std::string> rows;
+        EXPECT_TRUE(node.init(tnode, &state).ok());
+        EXPECT_TRUE(node.prepare(&state).ok());
+        EXPECT_EQ(agg_case.sorted, node._sorted_by_group_keys);
+        Status status = node.open(&state);
+        EXPECT_TRUE(status.ok()) << status.to_string();
+        *map_type = node._aggregator->hash_map_variant().type;
+        bool eos = false;
+        while (status.ok() && !eos) {
+            ChunkPtr chunk;
+            status = node.get_next(&state, &chunk, &eos);
+            EXPECT_TRUE(status.ok()) << status.to_string();
+            if (!status.ok() || eos) {
+                break;
+            }
+            append_rows(agg_case, *chunk, &rows);
+        }
+        *num_spilled_partitions = node._spilled_partitions_counter->value();
+        EXPECT_TRUE(node.close(&state).ok());
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    // The sorted rows of the aggregation by the pipeline operators of |num_drivers| drivers, as decomposed from
+    // AggregateBlockingNode. The input is shuffled by k1 across the drivers, and every pair of the blocking sink and
+    // source operators shares the Aggregator of its driver.
+    std::vector<std::string> aggregate_by_operators(const AggregationCase& agg_case, int32_t num_drivers) {
+        RuntimeState state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+        state._instance_mem_tracker = std::make_unique<MemTracker>(-1);
+        state.set_desc_tbl(_desc_tbl);
+
+        auto aggregator_factory = std::make_shared<AggregatorFactory>(agg_tnode(agg_case));
+        pipeline::AggregateBlockingSinkOperatorFactory sink_factory(0, 1, AggrPhase2, aggregator_factory);
+        pipeline::AggregateBlockingSourceOperatorFactory source_factory(1, 1, aggregator_factory);
+        std::vector<pipeline::OperatorPtr> sinks;
+        std::vector<pipeline::OperatorPtr> sources;
+        for (int32_t i = 0; i < num_drivers; i++) {
+            sinks.emplace_back(sink_factory.create(num_drivers, i));
+            sources.emplace_back(source_factory.create(num_drivers, i));
+            EXPECT_TRUE(sinks.back()->prepare(&state).ok());
+            EXPECT_TRUE(sources.back()->prepare(&state).ok());
+        }
+
+        for (const auto& chunk : random_chunks(agg_case)) {
+            std::vector<std::vector<uint32_t>> driver_rows(num_drivers);
+            const Column& k1 = *chunk->get_column_by_slot_id(0);
+            for (uint32_t i = 0; i < chunk->num_rows(); i++) {
+                Datum datum = k1.get(i);
+                driver_rows[datum.is_null() ? 0 : datum.get_int32() % num_drivers].emplace_back(i);
+            }
+            for (int32_t i = 0; i < num_drivers; i++) {
+                ChunkPtr driver_chunk = chunk->clone_empty();
+                driver_chunk->append_selective(*chunk, driver_rows[i].data(), 0, driver_rows[i].size());
+                EXPECT_TRUE(sinks[i]->need_input());
+                EXPECT_TRUE(sinks[i]->push_chunk(&state, driver_chunk).ok());
+            }
+        }
+
+        std::vector<std::string> rows;
+        for (int32_t i = 0; i < num_drivers; i++) {
+            EXPECT_FALSE(sources[i]->has_output());
+            sinks[i]->finish(&state);
+            while (!sources[i]->is_finished()) {
+                EXPECT_TRUE(sources[i]->has_output());
+                auto chunk = sources[i]->pull_chunk(&state);
+                EXPECT_TRUE(chunk.ok()) << chunk.status().to_string();
+                if (!chunk.ok()) {
+                    break;
+                }
+                append_rows(agg_case, *chunk.value(), &rows);
+            }
+            EXPECT_TRUE(sinks[i]->close(&state).ok());
+            EXPECT_TRUE(sources[i]->close(&state).ok());
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    SpillTestEnv _spill_env{"aggregate_blocking_node_test"};
+};
+
+// NOLINTNEXTLINE
+TEST_F(AggregateBlockingNodeTest, test_spill_null_key_group) {
+    // Spill once 30% of the limit is used, so that the hash map and the agg states, about 2MB of 50000 groups,
+    // are spilled long before the growth of either could exceed the 2MB limit.
+    int32_t old_percent = config::agg_spill_mem_limit_percent;
+    config::agg_spill_mem_limit_percent = 30;
+    DeferOp restore_percent([&]() { config::agg_spill_mem_limit_percent = old_percent; });
+
+    AggregationCase agg_case;
+    agg_case.num_chunks = 128;
+    agg_case.max_k1 = 50000;
+    auto expected = expected_groups(agg_case);
+    // The null key group is merged from the rows of every spilled chunk.
+    ASSERT_EQ("NULL", expected.back().substr(0, 4));
+
+    int64_t num_spilled_partitions = 0;
+    HashMapVariant::Type map_type;
+    ASSERT_EQ(expected, aggregate(agg_case, -1, &num_spilled_partitions, &map_type));
+    ASSERT_EQ(0, num_spilled_partitions);
+    ASSERT_EQ(HashMapVariant::Type::phase2_null_int32, map_type);
+    ASSERT_EQ(expected, aggregate(agg_case, 2 * 1024 * 1024, &num_spilled_partitions, &map_type));
+    ASSERT_GT(num_spilled_partitions, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregateBlockingNodeTest, test_spill_two_level_hash_map) {
+    int32_t old_percent = config::agg_spill_mem_limit_percent;
+    config::agg_spill_mem_limit_percent = 30;
+    DeferOp restore_percent([&]() { config::agg_spill_mem_limit_percent = old_percent; });
+
+    // The serialized keys of k1 and k2, of which every partition is merged into a two level hash map.
+    AggregationCase agg_case;
+    agg_case.two_keys = true;
+    agg_case.num_chunks = 128;
+    agg_case.max_k1 = 500;
+    agg_case.max_k2 = 100;
+    agg_case.seed = 1;
+    auto expected = expected_groups(agg_case);
+
+    int64_t num_spilled_partitions = 0;
+    HashMapVariant::Type map_type;
+    ASSERT_EQ(expected, aggregate(agg_case, -1, &num_spilled_partitions, &map_type));
+    ASSERT_EQ(0, num_spilled_partitions);
+    ASSERT_EQ(expected, aggregate(agg_case, 2 * 1024 * 1024, &num_spilled_partitions, &map_type));
+    ASSERT_GT(num_spilled_partitions, 0);
+    ASSERT_EQ(HashMapVariant::Type::phase2_slice_two_level, map_type);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregateBlockingNodeTest, test_no_spill_under_limit) {
+    AggregationCase agg_case;
+    agg_case.num_chunks = 4;
+    agg_case.max_k1 = 100;
+    agg_case.seed = 2;
+    int64_t num_spilled_partitions = 0;
+    HashMapVariant::Type map_type;
+    ASSERT_EQ(expected_groups(agg_case), aggregate(agg_case, 64 * 1024 * 1024, &num_spilled_partitions, &map_type));
+    ASSERT_EQ(0, num_spilled_partitions);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregateBlockingNodeTest, test_sorted_by_group_keys) {
+    // Compares the aggregation of the sorted groups with the hash aggregation of the same input, for the groups of a
+    // few rows, some of which go on in the next chunk, and for the groups of many chunks.
+    int64_t num_spilled_partitions = 0;
+    HashMapVariant::Type map_type;
+    for (int32_t max_k1 : {3000, 3}) {
+        for (bool two_keys : {false, true}) {
+            AggregationCase agg_case;
+            agg_case.two_keys = two_keys;
+            agg_case.num_chunks = 16;
+            agg_case.max_k1 = max_k1;
+            agg_case.max_k2 = 2;
+            agg_case.seed = 3;
+            auto expected = aggregate(agg_case, -1, &num_spilled_partitions, &map_type);
+            ASSERT_EQ(expected_groups(agg_case), expected);
+            agg_case.sorted = true;
+            ASSERT_EQ(expected_groups(agg_case), expected);
+            ASSERT_EQ(expected, aggregate(agg_case, -1, &num_spilled_partitions, &map_type))
+                    << "max_k1 " << max_k1 << ", two_keys " << two_keys;
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregateBlockingNodeTest, test_pipeline_operators) {
+    // Compares the aggregation by the pipeline operators of one and more drivers with that of the node.
+    for (bool two_keys : {false, true}) {
+        AggregationCase agg_case;
+        agg_case.two_keys = two_keys;
+        agg_case.num_chunks = 8;
+        agg_case.max_k1 = 2000;
+        agg_case.max_k2 = 3;
+        agg_case.seed = 4;
+        int64_t num_spilled_partitions = 0;
+        HashMapVariant::Type map_type;
+        auto expected = aggregate(agg_case, -1, &num_spilled_partitions, &map_type);
+        ASSERT_EQ(expected_groups(agg_case), expected);
+        for (int32_t num_drivers : {1, 3}) {
+            ASSERT_EQ(expected, aggregate_by_operators(agg_case, num_drivers))
+                    << "num_drivers " << num_drivers << ", two_keys " << two_keys;
+        }
+    }
+}
+
+} // namespace starrocks::vectorized
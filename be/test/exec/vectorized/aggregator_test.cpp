@@ -0,0 +1,274 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/aggregator.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::vectorized {
+
+struct GroupByKey {
+    PrimitiveType type;
+    bool nullable;
+};
+
+// The aggregator of select k..., count(*) group by k... over the input tuple of the keys.
+class AggregatorTest : public ::testing::Test {
+public:
+    AggregatorTest() : _runtime_state(TQueryGlobals()) {}
+
+protected:
+    void SetUp() override { _runtime_state.init_instance_mem_tracker(); }
+
+    void TearDown() override {
+        if (_aggregator != nullptr) {
+            ASSERT_TRUE(_aggregator->close(&_runtime_state).ok());
+        }
+    }
+
+    // The input tuple 0 of a slot per key, the intermediate tuple 1 and the output tuple 2 of the keys and count(*).
+    void prepare_aggregator(const std::vector<GroupByKey>& keys) {
+        _keys = keys;
+        TDescriptorTableBuilder desc_tbl_builder;
+        for (int i = 0; i < 3; i++) {
+            TTupleDescriptorBuilder tuple_builder;
+            for (const auto& key : keys) {
+                tuple_builder.add_slot(TSlotDescriptorBuilder()
+                                               .type(TypeDescriptor::from_primtive_type(key.type))
+                                               .nullable(key.nullable)
+                                               .build());
+            }
+            if (i > 0) {
+                tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).nullable(false).build());
+            }
+            tuple_builder.build(&desc_tbl_builder);
+        }
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, desc_tbl_builder.desc_tbl(), &_desc_tbl).ok());
+        _runtime_state.set_desc_tbl(_desc_tbl);
+
+        TAggregationNode agg_node;
+        std::vector<TExpr> grouping_exprs;
+        for (size_t i = 0; i < keys.size(); i++) {
+            TExprNode node;
+            node.__set_node_type(TExprNodeType::SLOT_REF);
+            node.__set_type(TypeDescriptor::from_primtive_type(keys[i].type).to_thrift());
+            node.__set_num_children(0);
+            TSlotRef t_slot_ref;
+            t_slot_ref.__set_slot_id(i);
+            t_slot_ref.__set_tuple_id(0);
+            node.__set_slot_ref(t_slot_ref);
+            node.__set_use_vectorized(true);
+            node.__set_is_nullable(keys[i].nullable);
+            grouping_exprs.emplace_back();
+            grouping_exprs.back().nodes.emplace_back(node);
+        }
+        agg_node.__set_grouping_exprs(grouping_exprs);
+
+        TFunction fn;
+        fn.name.__set_function_name("count");
+        fn.__set_binary_type(TFunctionBinaryType::BUILTIN);
+        fn.__set_ret_type(gen_type_desc(TPrimitiveType::BIGINT));
+        fn.__set_has_var_args(false);
+        TExprNode count_node;
+        count_node.__set_node_type(TExprNodeType::AGG_EXPR);
+        count_node.__set_type(gen_type_desc(TPrimitiveType::BIGINT));
+        count_node.__set_num_children(0);
+        TAggregateExpr t_agg_expr;
+        t_agg_expr.__set_is_merge_agg(false);
+        count_node.__set_agg_expr(t_agg_expr);
+        count_node.__set_fn(fn);
+        count_node.__set_use_vectorized(true);
+        count_node.__set_is_nullable(false);
+        TExpr count_expr;
+        count_expr.nodes.emplace_back(count_node);
+        agg_node.__set_aggregate_functions({count_expr});
+        agg_node.__set_intermediate_tuple_id(1);
+        agg_node.__set_output_tuple_id(2);
+        agg_node.__set_need_finalize(true);
+
+        _tnode.__set_node_id(1);
+        _tnode.__set_node_type(TPlanNodeType::AGGREGATION_NODE);
+        _tnode.__set_num_children(1);
+        _tnode.__set_limit(-1);
+        _tnode.__set_row_tuples({2});
+        _tnode.__set_nullable_tuples({false});
+        _tnode.__set_use_vectorized(true);
+        _tnode.__set_agg_node(agg_node);
+
+        _aggregator = std::make_unique<Aggregator>(_tnode);
+        ASSERT_TRUE(_aggregator->prepare(&_runtime_state, &_pool, &_profile, &_mem_tracker).ok());
+        ASSERT_TRUE(_aggregator->open(&_runtime_state).ok());
+    }
+
+    // A chunk of random keys, each of which is one of four values spread over all the bytes of the type, or null.
+    ChunkPtr random_chunk(std::mt19937* rand, size_t num_rows) {
+        auto chunk = std::make_shared<Chunk>();
+        for (size_t i = 0; i < _keys.size(); i++) {
+            ColumnPtr column = ColumnHelper::create_column(TypeDescriptor::from_primtive_type(_keys[i].type),
+                                                           _keys[i].nullable);
+            for (size_t row = 0; row < num_rows; row++) {
+                if (_keys[i].nullable && (*rand)() % 10 == 0) {
+                    EXPECT_TRUE(column->append_nulls(1));
+                    continue;
+                }
+                int64_t value = static_cast<int64_t>((*rand)() % 4) - 1;
+                switch (_keys[i].type) {
+                case TYPE_TINYINT:
+                    column->append_datum(Datum(static_cast<int8_t>(value)));
+                    break;
+                case TYPE_SMALLINT:
+                    column->append_datum(Datum(static_cast<int16_t>(value * 1000)));
+                    break;
+                case TYPE_INT:
+                    column->append_datum(Datum(static_cast<int32_t>(value * 100000000)));
+                    break;
+                case TYPE_BIGINT:
+                    column->append_datum(Datum(value * (int64_t(1) << 40)));
+                    break;
+                case TYPE_LARGEINT:
+                    column->append_datum(Datum(static_cast<int128_t>(value) * (int128_t(1) << 100)));
+                    break;
+                default: {
+                    std::string word = "word" + std::to_string(value);
+                    column->append_datum(Datum(Slice(word)));
+                    break;
+                }
+                }
+            }
+            chunk->append_column(std::move(column), i);
+        }
+        return chunk;
+    }
+
+    std::string key_to_string(const Chunk& chunk, size_t row, const std::vector<SlotId>& slot_ids) {
+        std::string key;
+        for (SlotId slot_id : slot_ids) {
+            key += chunk.get_column_by_slot_id(slot_id)->debug_item(row) + ",";
+        }
+        return key;
+    }
+
+    // Aggregates |num_chunks| random chunks, and checks the groups and their counts against the input rows.
+    void check_round_trip(size_t num_chunks) {
+        std::mt19937 rand(0);
+        std::vector<SlotId> input_slot_ids;
+        std::vector<SlotId> output_slot_ids;
+        for (size_t i = 0; i < _keys.size(); i++) {
+            input_slot_ids.emplace_back(i);
+            output_slot_ids.emplace_back(_desc_tbl->get_tuple_descriptor(2)->slots()[i]->id());
+        }
+        SlotId count_slot_id = _desc_tbl->get_tuple_descriptor(2)->slots().back()->id();
+
+        std::map<std::string, int64_t> expected;
+        for (size_t i = 0; i < num_chunks; i++) {
+            ChunkPtr chunk = random_chunk(&rand, 4096);
+            for (size_t row = 0; row < chunk->num_rows(); row++) {
+                expected[key_to_string(*chunk, row, input_slot_ids)]++;
+            }
+            _aggregator->evaluate_exprs(chunk.get());
+            _aggregator->build_hash_map(chunk->num_rows());
+            _aggregator->compute_agg_states(chunk->num_rows());
+        }
+
+        std::map<std::string, int64_t> groups;
+        _aggregator->init_hash_map_iterator();
+        while (!_aggregator->is_ht_eos()) {
+            ChunkPtr chunk;
+            _aggregator->convert_hash_map_to_chunk(4096, &chunk);
+            for (size_t row = 0; row < chunk->num_rows(); row++) {
+                std::string key = key_to_string(*chunk, row, output_slot_ids);
+                ASSERT_EQ(0, groups.count(key)) << "duplicate group " << key;
+                groups[key] = chunk->get_column_by_slot_id(count_slot_id)->get(row).get_int64();
+            }
+        }
+        ASSERT_EQ(expected, groups);
+    }
+
+    void check_layout(const FixedSizeKeyLayout& expected, const FixedSizeKeyLayout& layout) {
+        ASSERT_EQ(expected.size(), layout.size());
+        for (size_t i = 0; i < expected.size(); i++) {
+            ASSERT_EQ(expected[i].offset, layout[i].offset) << i;
+            ASSERT_EQ(expected[i].value_size, layout[i].value_size) << i;
+            ASSERT_EQ(expected[i].nullable, layout[i].nullable) << i;
+        }
+    }
+
+    RuntimeState _runtime_state;
+    ObjectPool _pool;
+    RuntimeProfile _profile{"AggregatorTest"};
+    MemTracker _mem_tracker;
+    DescriptorTbl* _desc_tbl = nullptr;
+    TPlanNode _tnode;
+    std::vector<GroupByKey> _keys;
+    std::unique_ptr<Aggregator> _aggregator;
+};
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorTest, test_fixed_size_key_8) {
+    prepare_aggregator({{TYPE_INT, false}, {TYPE_SMALLINT, true}});
+    FixedSizeKeyLayout layout;
+    ASSERT_EQ(7u, _aggregator->_build_fixed_size_key_layout(&layout));
+    check_layout({{0, 4, false}, {4, 2, true}}, layout);
+    auto& variant = _aggregator->hash_map_variant();
+    ASSERT_EQ(HashMapVariant::Type::phase1_slice_fx8, variant.type);
+    check_layout(layout, variant.phase1_slice_fx8->layout);
+    check_round_trip(4);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorTest, test_fixed_size_key_16) {
+    prepare_aggregator({{TYPE_BIGINT, true}, {TYPE_INT, false}, {TYPE_TINYINT, true}});
+    FixedSizeKeyLayout layout;
+    ASSERT_EQ(15u, _aggregator->_build_fixed_size_key_layout(&layout));
+    check_layout({{0, 8, true}, {9, 4, false}, {13, 1, true}}, layout);
+    auto& variant = _aggregator->hash_map_variant();
+    ASSERT_EQ(HashMapVariant::Type::phase1_slice_fx16, variant.type);
+    check_layout(layout, variant.phase1_slice_fx16->layout);
+    check_round_trip(4);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorTest, test_fixed_size_key_32) {
+    prepare_aggregator({{TYPE_LARGEINT, false}, {TYPE_BIGINT, true}, {TYPE_INT, true}, {TYPE_SMALLINT, false}});
+    FixedSizeKeyLayout layout;
+    ASSERT_EQ(32u, _aggregator->_build_fixed_size_key_layout(&layout));
+    check_layout({{0, 16, false}, {16, 8, true}, {25, 4, true}, {30, 2, false}}, layout);
+    auto& variant = _aggregator->hash_map_variant();
+    ASSERT_EQ(HashMapVariant::Type::phase1_slice_fx32, variant.type);
+    check_layout(layout, variant.phase1_slice_fx32->layout);
+    check_round_trip(4);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorTest, test_fixed_size_key_too_large) {
+    // 34 bytes with the null flags, so the keys are serialized.
+    prepare_aggregator({{TYPE_LARGEINT, true}, {TYPE_LARGEINT, true}});
+    FixedSizeKeyLayout layout;
+    ASSERT_EQ(34u, _aggregator->_build_fixed_size_key_layout(&layout));
+    ASSERT_EQ(HashMapVariant::Type::phase1_slice, _aggregator->hash_map_variant().type);
+    check_round_trip(4);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorTest, test_fixed_size_key_variable_width) {
+    // A VARCHAR key is never packed, neither are the other keys.
+    prepare_aggregator({{TYPE_INT, false}, {TYPE_VARCHAR, true}});
+    FixedSizeKeyLayout layout;
+    ASSERT_EQ(0u, _aggregator->_build_fixed_size_key_layout(&layout));
+    ASSERT_TRUE(layout.empty());
+    ASSERT_EQ(HashMapVariant::Type::phase1_slice, _aggregator->hash_map_variant().type);
+    check_round_trip(4);
+}
+
+} // namespace starrocks::vectorized
@@ -174,6 +174,30 @@ TEST_F(ArrowConverterTest, test_nullable_assignable_converter_uint16) {
                                                                                         counter);
 }
 
+TEST_F(ArrowConverterTest, test_fill_null_column_and_filter) {
+    size_t counter = 0;
+    auto array = create_constant_array<arrow::Int32Type>(10, 1, counter);
+    auto nullable_array = create_constant_array<arrow::Int32Type, true>(10, 1, counter);
+
+    auto null_column = NullColumn::create();
+    ASSERT_EQ(0, fill_null_column(array.get(), 0, 10, null_column.get(), 0));
+    ASSERT_EQ(5, fill_null_column(nullable_array.get(), 0, 10, null_column.get(), 10));
+    ASSERT_EQ(20, null_column->size());
+    for (size_t i = 0; i < 20; ++i) {
+        ASSERT_EQ(i >= 10 && i % 2 == 0, null_column->get_data()[i]);
+    }
+
+    // the rows filtered out by a column are not kept by another one
+    Column::Filter filter(10, 1);
+    filter[1] = 0;
+    fill_filter(array.get(), 0, 10, &filter, 0);
+    ASSERT_EQ(0, filter[1]);
+    fill_filter(nullable_array.get(), 0, 10, &filter, 0);
+    for (size_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(i % 2 == 1 && i != 1, filter[i]);
+    }
+}
+
 template <typename ArrowType, bool is_nullable = false>
 static inline std::shared_ptr<arrow::Array> create_constant_binary_array(int64_t num_elements, const std::string& value,
                                                                          size_t& counter) {
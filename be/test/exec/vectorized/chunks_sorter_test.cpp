@@ -2,11 +2,22 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include "column/column_helper.h"
 #include "column/datum_tuple.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "exec/vectorized/chunks_sorter_external_sort.h"
 #include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exec/vectorized/chunks_sorter_partition_topn.h"
 #include "exec/vectorized/chunks_sorter_topn.h"
 #include "exprs/slot_ref.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "runtime/spill_test_env.h"
+#include "util/defer_op.h"
 
 namespace starrocks::vectorized {
 
@@ -216,6 +227,61 @@ TEST_F(ChunksSorterTest, full_sort_by_2_columns_null_last) {
     clear_sort_exprs(sort_exprs);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, full_sort_by_normalized_key) {
+    int64_t old_min_rows = config::full_sort_normalized_key_min_rows;
+    config::full_sort_normalized_key_min_rows = 0;
+    DeferOp restore_min_rows([old_min_rows] { config::full_sort_normalized_key_min_rows = old_min_rows; });
+
+    std::vector<bool> is_asc, is_null_first;
+    is_asc.push_back(true);  // nation
+    is_asc.push_back(false); // cust_key
+    is_null_first.push_back(true);
+    is_null_first.push_back(true);
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_nation.get()));
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+
+    ChunksSorterFullSort sorter(&sort_exprs, &is_asc, &is_null_first, 2);
+    sorter.update(nullptr, _chunk_1);
+    sorter.update(nullptr, _chunk_2);
+    sorter.update(nullptr, _chunk_3);
+    sorter.done(nullptr);
+
+    bool eos = false;
+    ChunkPtr page_1;
+    sorter.get_next(&page_1, &eos);
+    ASSERT_FALSE(eos);
+    ASSERT_TRUE(page_1 != nullptr);
+
+    ASSERT_EQ(16, page_1->num_rows());
+    const size_t Size = 16;
+    int32_t permutation[Size] = {71, 70, 69, 54, 4, 56, 55, 49, 41, 16, 52, 58, 24, 12, 2, 6};
+    for (size_t i = 0; i < Size; ++i) {
+        ASSERT_EQ(permutation[i], page_1->get(i).get(0).get_int32());
+    }
+    clear_sort_exprs(sort_exprs);
+
+    // sort by the int column only.
+    is_asc = {false};
+    is_null_first = {true};
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+    ChunksSorterFullSort int_sorter(&sort_exprs, &is_asc, &is_null_first, 2);
+    int_sorter.update(nullptr, _chunk_1);
+    int_sorter.update(nullptr, _chunk_2);
+    int_sorter.update(nullptr, _chunk_3);
+    int_sorter.done(nullptr);
+
+    ChunkPtr page;
+    int_sorter.get_next(&page, &eos);
+    ASSERT_TRUE(page != nullptr);
+    ASSERT_EQ(16, page->num_rows());
+    for (size_t i = 1; i < Size; ++i) {
+        ASSERT_GT(page->get(i - 1).get(0).get_int32(), page->get(i).get(0).get_int32());
+    }
+    clear_sort_exprs(sort_exprs);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ChunksSorterTest, full_sort_by_3_columns) {
     std::vector<bool> is_asc, is_null_first;
@@ -399,6 +465,85 @@ TEST_F(ChunksSorterTest, part_sort_by_3_columns_null_last) {
     clear_sort_exprs(sort_exprs);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, part_sort_with_runtime_predicate) {
+    std::vector<bool> is_asc, is_null_first;
+    is_asc.push_back(false); // cust_key
+    is_null_first.push_back(false);
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+
+    auto runtime_predicate = std::make_shared<RuntimePredicate>("cust_key");
+    ChunksSorterTopn sorter(&sort_exprs, &is_asc, &is_null_first, 1, 3, 2);
+    sorter.set_runtime_predicate(runtime_predicate, 1);
+    sorter.update(nullptr, _chunk_1);
+    sorter.update(nullptr, _chunk_2);
+    sorter.update(nullptr, _chunk_3);
+    sorter.done(nullptr);
+
+    // the top offset + limit rows are {71, 70, 69, 58}.
+    ASSERT_GT(runtime_predicate->version(), 0);
+    std::vector<TCondition> conditions = runtime_predicate->conditions();
+    ASSERT_EQ(1, conditions.size());
+    ASSERT_EQ("cust_key", conditions[0].column_name);
+    ASSERT_EQ(">=", conditions[0].condition_op);
+    ASSERT_EQ(1, conditions[0].condition_values.size());
+    ASSERT_EQ("58", conditions[0].condition_values[0]);
+    clear_sort_exprs(sort_exprs);
+
+    // the nulls ordered first can't be pruned.
+    is_asc = {true};
+    is_null_first = {true};
+    sort_exprs.push_back(new ExprContext(_expr_region.get()));
+    auto null_first_predicate = std::make_shared<RuntimePredicate>("region");
+    ChunksSorterTopn null_first_sorter(&sort_exprs, &is_asc, &is_null_first, 0, 3, 2);
+    null_first_sorter.set_runtime_predicate(null_first_predicate, 0);
+    null_first_sorter.update(nullptr, _chunk_1);
+    null_first_sorter.update(nullptr, _chunk_2);
+    null_first_sorter.update(nullptr, _chunk_3);
+    null_first_sorter.done(nullptr);
+    ASSERT_EQ(0, null_first_predicate->version());
+    clear_sort_exprs(sort_exprs);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, partition_topn) {
+    std::vector<bool> is_asc, is_null_first;
+    is_asc.push_back(false); // cust_key
+    is_null_first.push_back(true);
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+    std::vector<ExprContext*> partition_exprs;
+    partition_exprs.push_back(new ExprContext(_expr_nation.get()));
+
+    // keep the 2 largest cust_keys of every nation.
+    ChunksSorterPartitionTopn sorter(&sort_exprs, &is_asc, &is_null_first, &partition_exprs, 2);
+    sorter.update(nullptr, _chunk_1);
+    sorter.update(nullptr, _chunk_2);
+    sorter.update(nullptr, _chunk_3);
+    sorter.done(nullptr);
+
+    bool eos = false;
+    ChunkPtr page_1;
+    sorter.get_next(&page_1, &eos);
+    ASSERT_FALSE(eos);
+    ASSERT_TRUE(page_1 != nullptr);
+
+    const size_t Size = 10;
+    ASSERT_EQ(Size, page_1->num_rows());
+    int32_t permutation[Size] = {71, 70, 58, 56, 55, 54, 52, 24, 6, 4};
+    for (size_t i = 0; i < Size; ++i) {
+        ASSERT_EQ(permutation[i], page_1->get(i).get(0).get_int32());
+    }
+
+    ChunkPtr page_2;
+    sorter.get_next(&page_2, &eos);
+    ASSERT_TRUE(eos);
+
+    clear_sort_exprs(sort_exprs);
+    clear_sort_exprs(partition_exprs);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ChunksSorterTest, order_by_with_unequal_sized_chunks) {
     std::vector<bool> is_asc, is_null_first;
@@ -441,4 +586,124 @@ TEST_F(ChunksSorterTest, order_by_with_unequal_sized_chunks) {
     clear_sort_exprs(sort_exprs);
 }
 
+class ChunksSorterExternalSortTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // The tuple 0 of the slots 0 (nullable k) and 1 (v).
+        TDescriptorTableBuilder desc_tbl_builder;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(
+                TSlotDescriptorBuilder().type(TYPE_INT).column_name("k").column_pos(0).nullable(true).build());
+        tuple_builder.add_slot(
+                TSlotDescriptorBuilder().type(TYPE_INT).column_name("v").column_pos(1).nullable(false).build());
+        tuple_builder.build(&desc_tbl_builder);
+        DescriptorTbl::create(&_pool, desc_tbl_builder.desc_tbl(), &_desc_tbl);
+        _row_desc = std::make_unique<RowDescriptor>(*_desc_tbl, std::vector<TTupleId>{0}, std::vector<bool>{false});
+
+        ASSERT_TRUE(_spill_env.init().ok());
+    }
+
+    // |num_chunks| chunks of 1024 rows of the random k in [0, max_key) or null, and the distinct v.
+    static std::vector<ChunkPtr> random_chunks(size_t num_chunks, int32_t max_key, uint32_t seed) {
+        std::mt19937 rand(seed);
+        std::vector<ChunkPtr> chunks;
+        int32_t value = 0;
+        for (size_t i = 0; i < num_chunks; i++) {
+            auto keys = NullableColumn::create(Int32Column::create(), NullColumn::create());
+            auto values = Int32Column::create();
+            for (size_t j = 0; j < 1024; j++) {
+                if (rand() % 20 == 0) {
+                    EXPECT_TRUE(keys->append_nulls(1));
+                } else {
+                    keys->append_datum(Datum(static_cast<int32_t>(rand() % max_key)));
+                }
+                values->append(value++);
+            }
+            auto chunk = std::make_shared<Chunk>();
+            chunk->append_column(std::move(keys), 0);
+            chunk->append_column(std::move(values), 1);
+            chunks.emplace_back(std::move(chunk));
+        }
+        return chunks;
+    }
+
+    // The rows sorted by k asc nulls first and v desc, by the external sort with a memory tracker of |mem_limit|
+    // bytes, or by the full sort in memory if |mem_limit| is -1. |num_spilled_runs| is set to the spilled runs.
+    std::vector<std::string> sort(size_t num_chunks, int32_t max_key, uint32_t seed, int64_t mem_limit,
+                                  int64_t* num_spilled_runs) {
+        TQueryOptions query_options;
+        query_options.__set_enable_spilling(true);
+        RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+        state._exec_env = _spill_env.exec_env();
+        state._instance_mem_tracker = std::make_unique<MemTracker>(-1);
+        state.set_desc_tbl(_desc_tbl);
+        MemTracker mem_tracker(mem_limit);
+        RuntimeProfile profile("sort");
+
+        SlotRef key_expr(TypeDescriptor(TYPE_INT), 0, 0);
+        SlotRef value_expr(TypeDescriptor(TYPE_INT), 0, 1);
+        ExprContext key_ctx(&key_expr);
+        ExprContext value_ctx(&value_expr);
+        std::vector<ExprContext*> sort_exprs{&key_ctx, &value_ctx};
+        std::vector<bool> is_asc{true, false};
+        std::vector<bool> is_null_first{true, true};
+
+        std::unique_ptr<ChunksSorter> sorter;
+        if (mem_limit > 0) {
+            sorter = std::make_unique<ChunksSorterExternalSort>(&sort_exprs, &is_asc, &is_null_first, *_row_desc);
+        } else {
+            sorter = std::make_unique<ChunksSorterFullSort>(&sort_exprs, &is_asc, &is_null_first,
+                                                            ChunksSorter::SIZE_OF_CHUNK_FOR_FULL_SORT);
+        }
+        sorter->setup_runtime(&mem_tracker, &profile, "ChunksSorter");
+        for (const auto& chunk : random_chunks(num_chunks, max_key, seed)) {
+            EXPECT_TRUE(sorter->update(&state, chunk).ok());
+        }
+        EXPECT_TRUE(sorter->done(&state).ok());
+
+        std::vector<std::string> rows;
+        bool eos = false;
+        while (!eos) {
+            ChunkPtr chunk;
+            Status status = sorter->get_next(&chunk, &eos);
+            EXPECT_TRUE(status.ok()) << status.to_string();
+            if (!status.ok() || eos) {
+                break;
+            }
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                Datum key = chunk->get_column_by_slot_id(0)->get(i);
+                rows.emplace_back((key.is_null() ? "NULL" : std::to_string(key.get_int32())) + "," +
+                                  std::to_string(chunk->get_column_by_slot_id(1)->get(i).get_int32()));
+            }
+        }
+        auto* counter = profile.get_counter("SpilledRuns");
+        *num_spilled_runs = counter == nullptr ? 0 : counter->value();
+        return rows;
+    }
+
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    SpillTestEnv _spill_env{"chunks_sorter_test"};
+};
+
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterExternalSortTest, spilled_runs_merged_in_order) {
+    // The 64 chunks take about 576KB, so a run of about 52KB is spilled every time 80% of the 64KB limit is used.
+    int64_t num_spilled_runs = 0;
+    auto expected = sort(64, 1000, 0, -1, &num_spilled_runs);
+    ASSERT_EQ(64 * 1024, expected.size());
+    ASSERT_EQ(0, num_spilled_runs);
+    ASSERT_EQ(expected, sort(64, 1000, 0, 64 * 1024, &num_spilled_runs));
+    ASSERT_GT(num_spilled_runs, 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterExternalSortTest, no_spill_under_limit) {
+    int64_t num_spilled_runs = 0;
+    auto expected = sort(4, 10, 1, -1, &num_spilled_runs);
+    ASSERT_EQ(expected, sort(4, 10, 1, 64 * 1024 * 1024, &num_spilled_runs));
+    ASSERT_EQ(0, num_spilled_runs);
+}
+
 } // namespace starrocks::vectorized
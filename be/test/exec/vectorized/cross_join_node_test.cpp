@@ -0,0 +1,111 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/cross_join_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "exec/vectorized/mock_chunks_node.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+class CrossJoinNodeTest : public JoinNodeTest {
+protected:
+    // The conjunct probe.k == build.k.
+    static TExpr keys_equal() {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::BINARY_PRED);
+        node.__set_type(gen_type_desc(TPrimitiveType::BOOLEAN));
+        node.__set_opcode(TExprOpcode::EQ);
+        node.__set_child_type(TPrimitiveType::INT);
+        node.__set_num_children(2);
+        node.__set_use_vectorized(true);
+        node.__set_is_nullable(true);
+        TExpr expr;
+        expr.nodes.emplace_back(node);
+        expr.nodes.emplace_back(slot_ref_node(0, 0));
+        expr.nodes.emplace_back(slot_ref_node(2, 1));
+        return expr;
+    }
+
+    // Compares the cross join of the random chunks of |probe_sizes| and |build_sizes| rows on the conjunct
+    // probe.k == build.k with the nested loop join of them.
+    void check_cross_join(const std::vector<size_t>& probe_sizes, const std::vector<size_t>& build_sizes,
+                          int32_t max_key, uint32_t seed) {
+        std::mt19937 rand(seed);
+        auto probe_rows = random_rows(&rand, probe_sizes, max_key);
+        auto build_rows = random_rows(&rand, build_sizes, max_key);
+        auto expected = nested_loop_join(TJoinOp::INNER_JOIN, probe_rows, build_rows);
+        auto probe = make_chunks(probe_rows, 0, 1);
+        auto build = make_chunks(build_rows, 2, 3);
+
+        TQueryOptions query_options;
+        RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+        state.set_desc_tbl(_desc_tbl);
+
+        TPlanNode tnode;
+        tnode.__set_node_id(2);
+        tnode.__set_node_type(TPlanNodeType::CROSS_JOIN_NODE);
+        tnode.__set_num_children(2);
+        tnode.__set_limit(-1);
+        tnode.__set_row_tuples({0, 1});
+        tnode.__set_nullable_tuples({false, false});
+        tnode.__set_conjuncts({keys_equal()});
+        tnode.__set_use_vectorized(true);
+
+        CrossJoinNode node(&_pool, tnode, *_desc_tbl);
+        MockChunksNode probe_node(&_pool, child_tnode(0, 0), *_desc_tbl, probe);
+        MockChunksNode build_node(&_pool, child_tnode(1, 1), *_desc_tbl, build);
+        node._children.push_back(&probe_node);
+        node._children.push_back(&build_node);
+
+        ASSERT_TRUE(node.init(tnode, &state).ok());
+        ASSERT_TRUE(node.prepare(&state).ok());
+        ASSERT_TRUE(node._block_nested_loop);
+        ASSERT_TRUE(node.open(&state).ok());
+        std::vector<std::string> rows;
+        bool eos = false;
+        while (!eos) {
+            ChunkPtr chunk;
+            ASSERT_TRUE(node.get_next(&state, &chunk, &eos).ok());
+            if (eos) {
+                break;
+            }
+            ASSERT_LE(chunk->num_rows(), config::vector_chunk_size);
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                rows.emplace_back(to_string(*chunk, i, 0, 1) + "," + to_string(*chunk, i, 2, 3));
+            }
+        }
+        ASSERT_TRUE(node.close(&state).ok());
+        std::sort(rows.begin(), rows.end());
+        ASSERT_EQ(expected, rows);
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(CrossJoinNodeTest, test_one_build_block) {
+    // A tile holds the build block for several probe rows.
+    check_cross_join({100, 37, 250}, {300, 200}, 50, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CrossJoinNodeTest, test_build_blocks) {
+    // The build rows are divided into two blocks, of which the second is partial, and the matched rows of a probe
+    // chunk take more than one output chunk.
+    const size_t chunk_size = config::vector_chunk_size;
+    check_cross_join({64, 3, 100}, {chunk_size, chunk_size / 4 + 1}, 20, 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CrossJoinNodeTest, test_null_keys) {
+    // All the keys are null or 0, so the rows are matched unless either key is null.
+    check_cross_join({300, 200}, {700}, 1, 2);
+}
+
+} // namespace starrocks::vectorized
@@ -8,6 +8,7 @@
 #include <iostream>
 
 #include "column/datum_tuple.h"
+#include "common/config.h"
 #include "env/env_memory.h"
 #include "formats/csv/converter.h"
 #include "gen_cpp/Descriptors_types.h"
@@ -602,4 +603,39 @@ TEST_F(CSVScannerTest, test_empty) {
     run_test(TYPE_DATETIME);
 }
 
+// The records of csv_file14 span several refills of the buffer and several chunks.
+TEST_F(CSVScannerTest, test_many_records) {
+    std::vector<TypeDescriptor> types{TypeDescriptor(TYPE_INT), TypeDescriptor(TYPE_BIGINT),
+                                      TypeDescriptor(TYPE_VARCHAR)};
+    types[2].len = 20;
+
+    std::vector<TBrokerRangeDesc> ranges;
+    TBrokerRangeDesc range;
+    range.__set_path("./be/test/exec/test_data/csv_scanner/csv_file14");
+    range.__set_start_offset(0);
+    range.__set_num_of_columns_from_file(types.size());
+    ranges.push_back(range);
+
+    auto scanner = create_csv_scanner(types, ranges);
+    ASSERT_TRUE(scanner->open().ok());
+
+    int num_rows = 0;
+    while (true) {
+        auto res = scanner->get_next();
+        if (res.status().is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(res.ok()) << res.status().to_string();
+        auto chunk = res.value();
+        ASSERT_LE(chunk->num_rows(), config::vector_chunk_size);
+        for (int i = 0; i < chunk->num_rows(); i++, num_rows++) {
+            auto row = chunk->get(i);
+            ASSERT_EQ(num_rows, row[0].get_int32());
+            ASSERT_EQ(num_rows * 2, row[1].get_int64());
+            ASSERT_EQ(std::string(num_rows % 20, 'x'), row[2].get_slice().to_string());
+        }
+    }
+    ASSERT_EQ(20000, num_rows);
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,163 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/hash_join_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/config.h"
+#include "exec/vectorized/mock_chunks_node.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+#include "runtime/spill_test_env.h"
+
+namespace starrocks::vectorized {
+
+class HashJoinNodeTest : public JoinNodeTest {
+protected:
+    void SetUp() override {
+        JoinNodeTest::SetUp();
+
+        ASSERT_TRUE(_spill_env.init().ok());
+    }
+
+    static bool output_probe(TJoinOp::type join_op) {
+        return join_op != TJoinOp::RIGHT_SEMI_JOIN && join_op != TJoinOp::RIGHT_ANTI_JOIN;
+    }
+
+    static bool output_build(TJoinOp::type join_op) {
+        return join_op != TJoinOp::LEFT_SEMI_JOIN && join_op != TJoinOp::LEFT_ANTI_JOIN;
+    }
+
+    // The sorted rows of the hash join of |num_build_chunks| random build chunks and half as many probe chunks,
+    // which are generated from |seed| for each join, as the join may modify its input chunks. The join runs under
+    // an instance memory limit of |mem_limit| bytes with the spilling enabled, or without any limit if |mem_limit|
+    // is -1, and |spilled| is set to whether the build side is spilled.
+    std::vector<std::string> hash_join(TJoinOp::type join_op, uint32_t seed, size_t num_build_chunks, int32_t max_key,
+                                       int64_t mem_limit, bool* spilled) {
+        std::mt19937 rand(seed);
+        auto probe = make_chunks(random_rows(&rand, std::vector<size_t>(num_build_chunks / 2, 256), max_key), 0, 1);
+        auto build = make_chunks(random_rows(&rand, std::vector<size_t>(num_build_chunks, 256), max_key), 2, 3);
+
+        TQueryOptions query_options;
+        query_options.__set_enable_spilling(mem_limit > 0);
+        RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+        // Not registered with the thread mgr of the exec env, which is only for the spilled files.
+        state._exec_env = _spill_env.exec_env();
+        state._instance_mem_tracker = std::make_unique<MemTracker>(mem_limit);
+        state.set_desc_tbl(_desc_tbl);
+
+        TPlanNode tnode;
+        tnode.__set_node_id(2);
+        tnode.__set_node_type(TPlanNodeType::HASH_JOIN_NODE);
+        tnode.__set_num_children(2);
+        tnode.__set_limit(-1);
+        tnode.__set_use_vectorized(true);
+        std::vector<TTupleId> row_tuples;
+        std::vector<bool> nullable_tuples;
+        if (output_probe(join_op)) {
+            row_tuples.emplace_back(0);
+            nullable_tuples.emplace_back(join_op == TJoinOp::RIGHT_OUTER_JOIN || join_op == TJoinOp::FULL_OUTER_JOIN);
+        }
+        if (output_build(join_op)) {
+            row_tuples.emplace_back(1);
+            nullable_tuples.emplace_back(join_op == TJoinOp::LEFT_OUTER_JOIN || join_op == TJoinOp::FULL_OUTER_JOIN);
+        }
+        tnode.__set_row_tuples(row_tuples);
+        tnode.__set_nullable_tuples(nullable_tuples);
+        TEqJoinCondition eq_condition;
+        eq_condition.__set_left(slot_ref(0, 0));
+        eq_condition.__set_right(slot_ref(2, 1));
+        THashJoinNode hash_join_node;
+        hash_join_node.__set_join_op(join_op);
+        hash_join_node.__set_eq_join_conjuncts({eq_condition});
+        hash_join_node.__set_is_push_down(false);
+        tnode.__set_hash_join_node(hash_join_node);
+
+        HashJoinNode node(&_pool, tnode, *_desc_tbl);
+        MockChunksNode probe_node(&_pool, child_tnode(0, 0), *_desc_tbl, std::move(probe));
+        MockChunksNode build_node(&_pool, child_tnode(1, 1), *_desc_tbl, std::move(build));
+        node._children.push_back(&probe_node);
+        node._children.push_back(&build_node);
+
+        std::vector<std::string> rows;
+        EXPECT_TRUE(node.init(tnode, &state).ok());
+        EXPECT_TRUE(node.prepare(&state).ok());
+        Status status = node.open(&state);
+        EXPECT_TRUE(status.ok()) << status.to_string();
+        bool eos = false;
+        while (status.ok() && !eos) {
+            ChunkPtr chunk;
+            status = node.get_next(&state, &chunk, &eos);
+            EXPECT_TRUE(status.ok()) << status.to_string();
+            if (!status.ok() || eos) {
+                break;
+            }
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                std::string row;
+                if (output_probe(join_op)) {
+                    row += to_string(*chunk, i, 0, 1) + ",";
+                }
+                if (output_build(join_op)) {
+                    row += to_string(*chunk, i, 2, 3);
+                }
+                rows.emplace_back(std::move(row));
+            }
+        }
+        *spilled = node._is_spilled;
+        EXPECT_TRUE(node.close(&state).ok());
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    // Compares the join spilled under |mem_limit| with the join in memory.
+    void check_spilled_join(TJoinOp::type join_op, int64_t mem_limit, uint32_t seed) {
+        bool spilled = true;
+        auto expected = hash_join(join_op, seed, 64, 4000, -1, &spilled);
+        ASSERT_FALSE(spilled);
+        ASSERT_FALSE(expected.empty());
+        auto rows = hash_join(join_op, seed, 64, 4000, mem_limit, &spilled);
+        ASSERT_TRUE(spilled) << "join op " << join_op;
+        ASSERT_EQ(expected, rows) << "join op " << join_op;
+    }
+
+    SpillTestEnv _spill_env{"hash_join_node_test"};
+};
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinNodeTest, test_spill_inner_join) {
+    // The 64 build chunks take about 150KB, so the hash table is spilled at about 52KB of the 64KB limit, and each
+    // partition is joined in memory.
+    check_spilled_join(TJoinOp::INNER_JOIN, 64 * 1024, 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinNodeTest, test_spill_outer_joins) {
+    for (auto join_op : {TJoinOp::LEFT_OUTER_JOIN, TJoinOp::RIGHT_OUTER_JOIN, TJoinOp::FULL_OUTER_JOIN}) {
+        check_spilled_join(join_op, 64 * 1024, 1);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinNodeTest, test_spill_semi_and_anti_joins) {
+    for (auto join_op : {TJoinOp::LEFT_SEMI_JOIN, TJoinOp::LEFT_ANTI_JOIN, TJoinOp::RIGHT_SEMI_JOIN,
+                         TJoinOp::RIGHT_ANTI_JOIN}) {
+        check_spilled_join(join_op, 64 * 1024, 2);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(HashJoinNodeTest, test_no_spill_under_limit) {
+    // The spilling is enabled, but the build side fits in the limit.
+    bool spilled = true;
+    auto expected = hash_join(TJoinOp::INNER_JOIN, 3, 4, 100, -1, &spilled);
+    auto rows = hash_join(TJoinOp::INNER_JOIN, 3, 4, 100, 64 * 1024 * 1024, &spilled);
+    ASSERT_FALSE(spilled);
+    ASSERT_EQ(expected, rows);
+}
+
+} // namespace starrocks::vectorized
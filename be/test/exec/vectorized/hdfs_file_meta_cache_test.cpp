@@ -0,0 +1,48 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/hdfs_file_meta_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "exec/parquet/metadata.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks::vectorized {
+
+// NOLINTNEXTLINE
+TEST(HdfsFileMetaCacheTest, lookup_and_evict) {
+    MemTracker mem_tracker;
+    {
+        HdfsFileMetaCache cache(&mem_tracker, kNumShards * 4096);
+        int64_t hit_count = HdfsFileMetaCache::hit_count();
+        int64_t miss_count = HdfsFileMetaCache::miss_count();
+
+        ASSERT_EQ(nullptr, cache.lookup_parquet("/a.parquet", 100, 1));
+        auto meta = std::make_shared<parquet::FileMetaData>();
+        cache.insert_parquet("/a.parquet", 100, 1, meta, 10);
+        ASSERT_EQ(meta.get(), cache.lookup_parquet("/a.parquet", 100, 1).get());
+        ASSERT_EQ(hit_count + 1, HdfsFileMetaCache::hit_count());
+        ASSERT_EQ(miss_count + 1, HdfsFileMetaCache::miss_count());
+        // the file rewritten
+        ASSERT_EQ(nullptr, cache.lookup_parquet("/a.parquet", 100, 2));
+        ASSERT_EQ(nullptr, cache.lookup_parquet("/a.parquet", 101, 1));
+
+        std::string tail;
+        ASSERT_FALSE(cache.lookup_orc_tail("/b.orc", 100, 1, &tail));
+        cache.insert_orc_tail("/b.orc", 100, 1, "tail");
+        ASSERT_TRUE(cache.lookup_orc_tail("/b.orc", 100, 1, &tail));
+        ASSERT_EQ("tail", tail);
+        ASSERT_EQ(cache.memory_usage(), mem_tracker.consumption());
+
+        // insert too many tails to evict the others
+        for (int i = 0; i < 100 * kNumShards; ++i) {
+            cache.insert_orc_tail("/" + std::to_string(i) + ".orc", 100, 1, std::string(100, 'x'));
+        }
+        ASSERT_EQ(nullptr, cache.lookup_parquet("/a.parquet", 100, 1));
+        ASSERT_LE(cache.memory_usage(), kNumShards * 4096);
+        ASSERT_EQ(cache.memory_usage(), mem_tracker.consumption());
+    }
+    ASSERT_EQ(0, mem_tracker.consumption());
+}
+
+} // namespace starrocks::vectorized
@@ -410,4 +410,45 @@ TEST_F(HdfsScanNodeTest, TestBasic) {
         ASSERT_TRUE(status.ok());
     }
 }
+
+TEST_F(HdfsScanNodeTest, TestSplitScanRange) {
+    int64_t split_size = config::hdfs_scan_split_size;
+    config::hdfs_scan_split_size = 128;
+
+    auto tnode = _create_tplan_node();
+    auto* descs = _create_table_desc();
+    _runtime_state->set_desc_tbl(descs);
+    auto hdfs_scan_node = std::make_shared<HdfsScanNode>(_pool, *tnode, *descs);
+
+    Status status = hdfs_scan_node->init(*tnode, _runtime_state.get());
+    ASSERT_TRUE(status.ok());
+
+    // the range is split into 5 pieces, the only row group is read by the first one
+    auto scan_ranges = _create_scan_ranges();
+    scan_ranges[0].scan_range.hdfs_scan_range.__set_file_format(THdfsFileFormat::PARQUET);
+    status = hdfs_scan_node->set_scan_ranges(scan_ranges);
+    ASSERT_TRUE(status.ok());
+
+    status = hdfs_scan_node->prepare(_runtime_state.get());
+    ASSERT_TRUE(status.ok());
+
+    status = hdfs_scan_node->open(_runtime_state.get());
+    ASSERT_TRUE(status.ok());
+
+    size_t num_rows = 0;
+    bool eos = false;
+    while (!eos) {
+        auto chunk = _create_chunk();
+        status = hdfs_scan_node->get_next(_runtime_state.get(), &chunk, &eos);
+        ASSERT_TRUE(status.ok());
+        if (!eos) {
+            num_rows += chunk->num_rows();
+        }
+    }
+    ASSERT_EQ(num_rows, 4);
+
+    status = hdfs_scan_node->close(_runtime_state.get());
+    ASSERT_TRUE(status.ok());
+    config::hdfs_scan_split_size = split_size;
+}
 } // namespace starrocks::vectorized
@@ -3,9 +3,11 @@
 #include "exec/vectorized/join_hash_map.h"
 
 #include <gtest/gtest.h>
+#include <set>
 
 #include "runtime/descriptor_helper.h"
 #include "runtime/exec_env.h"
+#include "util/defer_op.h"
 
 namespace starrocks::vectorized {
 class JoinHashMapTest : public ::testing::Test {
@@ -495,7 +497,6 @@ void JoinHashMapTest::prepare_table_items(JoinHashTableItems* table_items, uint3
     table_items->row_count = row_count;
     table_items->next.resize(row_count + 1);
     table_items->build_pool = std::make_unique<MemPool>(_mem_tracker.get());
-    table_items->probe_pool = std::make_unique<MemPool>(_mem_tracker.get());
     table_items->mem_tracker = _mem_tracker.get();
     table_items->search_ht_timer = ADD_TIMER(_runtime_profile, "SearchHashTableTimer");
     table_items->output_build_column_timer = ADD_TIMER(_runtime_profile, "OutputBuildColumnTimer");
@@ -745,6 +746,42 @@ TEST_F(JoinHashMapTest, CalcBucketNums) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, LookupBucketHeads) {
+    auto old_prefetch_min_rows = config::join_probe_prefetch_min_rows;
+    config::join_probe_prefetch_min_rows = 0;
+    DeferOp restore_prefetch_min_rows(
+            [old_prefetch_min_rows] { config::join_probe_prefetch_min_rows = old_prefetch_min_rows; });
+
+    JoinHashTableItems table_items;
+    table_items.bucket_size = 8;
+    table_items.row_count = 8;
+    table_items.first = {0, 1, 2, 3, 4, 5, 6, 8};
+    Buffer<int32_t> build_data(9, 0);
+
+    // more rows than PREFETCH_DISTANCE, and every third row is null.
+    const uint32_t row_count = 40;
+    HashTableProbeState probe_state;
+    probe_state.probe_row_count = row_count;
+    probe_state.buckets.resize(row_count);
+    probe_state.next.resize(row_count);
+    Buffer<uint8_t> is_nulls(row_count, 0);
+    for (uint32_t i = 0; i < row_count; i++) {
+        probe_state.buckets[i] = i % 8;
+        is_nulls[i] = i % 3 == 0;
+    }
+
+    JoinHashMapHelper::lookup_bucket_heads<int32_t>(table_items, build_data, &probe_state, nullptr);
+    for (uint32_t i = 0; i < row_count; i++) {
+        ASSERT_EQ(probe_state.next[i], table_items.first[i % 8]);
+    }
+
+    JoinHashMapHelper::lookup_bucket_heads<int32_t>(table_items, build_data, &probe_state, is_nulls.data());
+    for (uint32_t i = 0; i < row_count; i++) {
+        ASSERT_EQ(probe_state.next[i], is_nulls[i] ? 0 : table_items.first[i % 8]);
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, PrepareMapIndex) {
     HashTableProbeState probe_state;
@@ -962,6 +999,145 @@ TEST_F(JoinHashMapTest, JoinBuildProbeFuncNullable) {
     table_items.mem_tracker->release(table_items.mem_tracker->consumption());
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, RadixJoinBuildProbeFunc) {
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+    auto runtime_state = create_runtime_state();
+    runtime_state->init_instance_mem_tracker();
+    auto old_partition_bytes = config::join_radix_partition_bytes;
+    config::join_radix_partition_bytes = 16;
+    DeferOp restore_partition_bytes(
+            [old_partition_bytes] { config::join_radix_partition_bytes = old_partition_bytes; });
+
+    auto type = TypeDescriptor::from_primtive_type(PrimitiveType::TYPE_INT);
+    auto build_column = ColumnHelper::create_column(type, false);
+    build_column->append_default();
+    build_column->append(*JoinHashMapTest::create_int32_column(10, 0), 0, 10);
+    auto probe_column = JoinHashMapTest::create_int32_column(10, 0);
+    table_items.build_chunk = std::make_shared<Chunk>();
+    table_items.build_chunk->append_column(build_column, 0);
+    table_items.first.resize(16, 0);
+    table_items.key_columns.emplace_back(build_column);
+    table_items.bucket_size = 16;
+    table_items.row_count = 10;
+    table_items.next.resize(11);
+    table_items.mem_tracker = runtime_state->instance_mem_tracker();
+    probe_state.probe_row_count = 10;
+    probe_state.buckets.resize(config::vector_chunk_size);
+    probe_state.next.resize(config::vector_chunk_size, 0);
+    Columns probe_columns{probe_column};
+    probe_state.key_columns = &probe_columns;
+
+    auto status = RadixJoinBuildFunc<TYPE_INT>::prepare(nullptr, &table_items, &probe_state);
+    ASSERT_TRUE(status.ok());
+    ASSERT_GT(table_items.radix_bits, 0);
+    ASSERT_EQ(table_items.radix_bits + table_items.radix_shift, 4);
+    RadixJoinBuildFunc<TYPE_INT>::construct_hash_table(&table_items, &probe_state);
+    RadixJoinProbeFunc<TYPE_INT>::prepare(&table_items, &probe_state);
+    RadixJoinProbeFunc<TYPE_INT>::lookup_init(table_items, &probe_state);
+
+    // the key column shared with the build chunk is reordered together with it.
+    ASSERT_EQ(table_items.key_columns[0].get(), table_items.build_chunk->get_column_by_slot_id(0).get());
+    auto data = ColumnHelper::as_raw_column<Int32Column>(table_items.key_columns[0])->get_data();
+    for (size_t b = 0; b < table_items.bucket_size; b++) {
+        // the rows of a bucket are adjacent.
+        for (size_t index = table_items.first[b]; index != 0; index = table_items.next[index]) {
+            ASSERT_EQ(JoinHashMapHelper::calc_bucket_num<int32_t>(data[index], table_items.bucket_size), b);
+            ASSERT_TRUE(table_items.next[index] == 0 || table_items.next[index] == index + 1);
+        }
+    }
+    for (size_t i = 0; i < 10; i++) {
+        size_t found_count = 0;
+        size_t probe_index = probe_state.next[i];
+        while (probe_index != 0) {
+            if (JoinKeyEqual<int32_t>()(i, data[probe_index])) {
+                found_count++;
+            }
+            probe_index = table_items.next[probe_index];
+        }
+        ASSERT_EQ(found_count, 1);
+    }
+    table_items.mem_tracker->release(table_items.mem_tracker->consumption());
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, DirectMappingJoinBuildProbeFunc) {
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+
+    // the build keys are 100, 101, ..., 109, and the probe keys are 95, 96, ..., 114.
+    auto type = TypeDescriptor::from_primtive_type(PrimitiveType::TYPE_INT);
+    auto build_column = ColumnHelper::create_column(type, false);
+    build_column->append_default();
+    build_column->append(*JoinHashMapTest::create_int32_column(10, 100), 0, 10);
+    auto probe_column = JoinHashMapTest::create_int32_column(20, 95);
+    table_items.key_columns.emplace_back(build_column);
+    table_items.direct_mapping_min = 100;
+    table_items.bucket_size = 10;
+    table_items.row_count = 10;
+    table_items.first.resize(10, 0);
+    table_items.next.resize(11, 0);
+    probe_state.probe_row_count = 20;
+    probe_state.next.resize(config::vector_chunk_size, 0);
+    Columns probe_columns{probe_column};
+    probe_state.key_columns = &probe_columns;
+
+    auto status = DirectMappingJoinBuildFunc<TYPE_INT>::construct_hash_table(&table_items, &probe_state);
+    ASSERT_TRUE(status.ok());
+    for (size_t b = 0; b < table_items.bucket_size; b++) {
+        ASSERT_EQ(table_items.first[b], b + 1);
+        ASSERT_EQ(table_items.next[b + 1], 0);
+    }
+
+    DirectMappingJoinProbeFunc<TYPE_INT>::prepare(&table_items, &probe_state);
+    status = DirectMappingJoinProbeFunc<TYPE_INT>::lookup_init(table_items, &probe_state);
+    ASSERT_TRUE(status.ok());
+    for (size_t i = 0; i < 20; i++) {
+        if (i < 5 || i >= 15) {
+            ASSERT_EQ(probe_state.next[i], 0);
+        } else {
+            ASSERT_EQ(probe_state.next[i], i - 4);
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, RemoveDuplicateBuildKeys) {
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+
+    // the build keys are 0, 1, ..., 9 twice.
+    auto type = TypeDescriptor::from_primtive_type(PrimitiveType::TYPE_INT);
+    auto build_column = ColumnHelper::create_column(type, false);
+    build_column->append_default();
+    build_column->append(*JoinHashMapTest::create_int32_column(10, 0), 0, 10);
+    build_column->append(*JoinHashMapTest::create_int32_column(10, 0), 0, 10);
+    table_items.key_columns.emplace_back(build_column);
+    table_items.bucket_size = 4;
+    table_items.row_count = 20;
+    table_items.first.resize(4, 0);
+    table_items.next.resize(21, 0);
+    table_items.build_keys_only = true;
+
+    auto status = JoinBuildFunc<TYPE_INT>::construct_hash_table(&table_items, &probe_state);
+    ASSERT_TRUE(status.ok());
+    auto join_hash_map = std::make_unique<JoinHashMapForOneKey(TYPE_INT)>(&table_items, &probe_state);
+    join_hash_map->_remove_duplicate_build_keys();
+
+    const auto& data = JoinBuildFunc<TYPE_INT>::get_key_data(table_items);
+    std::set<int32_t> keys;
+    size_t linked_rows = 0;
+    for (size_t b = 0; b < table_items.bucket_size; b++) {
+        for (uint32_t index = table_items.first[b]; index != 0; index = table_items.next[index]) {
+            ASSERT_TRUE(keys.insert(data[index]).second);
+            linked_rows++;
+        }
+    }
+    ASSERT_EQ(linked_rows, 10);
+    ASSERT_EQ(keys.size(), 10);
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, FixedSizeJoinBuildProbeFunc) {
     JoinHashTableItems table_items;
@@ -1114,7 +1290,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFunc) {
     table_items.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
     table_items.mem_tracker = runtime_state->instance_mem_tracker();
     table_items.build_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
-    table_items.probe_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
+    probe_state.probe_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
     probe_state.probe_row_count = 10;
     probe_state.buckets.resize(config::vector_chunk_size);
     probe_state.next.resize(config::vector_chunk_size, 0);
@@ -1143,7 +1319,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFunc) {
         ASSERT_EQ(found_count, 1);
     }
     table_items.build_pool.reset();
-    table_items.probe_pool.reset();
+    probe_state.probe_pool.reset();
     table_items.mem_tracker->release(table_items.mem_tracker->consumption());
 }
 
@@ -1177,7 +1353,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFuncNullable) {
     table_items.next.resize(11);
     table_items.mem_tracker = runtime_state->instance_mem_tracker();
     table_items.build_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
-    table_items.probe_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
+    probe_state.probe_pool = std::make_unique<MemPool>(runtime_state->instance_mem_tracker());
     probe_state.probe_row_count = 10;
     probe_state.buckets.resize(config::vector_chunk_size);
     probe_state.next.resize(config::vector_chunk_size, 0);
@@ -1216,7 +1392,7 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFuncNullable) {
         }
     }
     table_items.build_pool.reset();
-    table_items.probe_pool.reset();
+    probe_state.probe_pool.reset();
     table_items.mem_tracker->release(table_items.mem_tracker->consumption());
 }
 
@@ -1619,6 +1795,74 @@ TEST_F(JoinHashMapTest, OneKeyJoinHashTable) {
     hash_table.close();
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, CloneReadableJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    auto mem_tracker = create_mem_tracker(runtime_profile);
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.mem_tracker = mem_tracker.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+
+    auto build_chunk = create_int32_build_chunk(10, false);
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), build_chunk).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+    int64_t consumption = mem_tracker->consumption();
+
+    // the clones share the built table, and probe independently.
+    JoinHashTable clone_table1 = hash_table.clone_readable_table();
+    JoinHashTable clone_table2 = hash_table.clone_readable_table();
+    ASSERT_EQ(clone_table1.get_row_count(), 10);
+    ASSERT_EQ(clone_table1.get_bucket_size(), hash_table.get_bucket_size());
+    ASSERT_EQ(clone_table1.get_build_chunk().get(), hash_table.get_build_chunk().get());
+
+    for (auto* table : {&clone_table1, &clone_table2}) {
+        auto probe_chunk = create_int32_probe_chunk(5, 1, false);
+        Columns probe_key_columns;
+        probe_key_columns.emplace_back(probe_chunk->columns()[0]);
+
+        ChunkPtr result_chunk = std::make_shared<Chunk>();
+        bool eos = false;
+        ASSERT_TRUE(table->probe(probe_key_columns, &probe_chunk, &result_chunk, &eos).ok());
+
+        ASSERT_EQ(result_chunk->num_columns(), 6);
+        check_int32_column(result_chunk->get_column_by_slot_id(0), 5, 1);
+        check_int32_column(result_chunk->get_column_by_slot_id(3), 5, 1);
+    }
+
+    // closing the clones doesn't release the memory of the shared table.
+    clone_table1.close();
+    clone_table2.close();
+    ASSERT_EQ(mem_tracker->consumption(), consumption);
+    ASSERT_EQ(hash_table.get_row_count(), 10);
+
+    hash_table.close();
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, OneNullableKeyJoinHashTable) {
     auto runtime_profile = create_runtime_profile();
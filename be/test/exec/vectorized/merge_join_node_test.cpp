@@ -0,0 +1,187 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/merge_join_node.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "exec/vectorized/mock_chunks_node.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+class MergeJoinNodeTest : public JoinNodeTest {
+public:
+    MergeJoinNodeTest() : _runtime_state(TQueryGlobals()) {}
+
+protected:
+    void SetUp() override {
+        JoinNodeTest::SetUp();
+        _runtime_state.init_instance_mem_tracker();
+        _runtime_state.set_desc_tbl(_desc_tbl);
+    }
+
+    // The rows of the join of |left| and |right| by a MergeJoinNode outputting chunks of up to |batch_size| rows.
+    std::vector<std::string> merge_join(TJoinOp::type join_op, const JoinChunks& left, const JoinChunks& right,
+                                        int batch_size) {
+        TPlanNode tnode;
+        tnode.__set_node_id(2);
+        tnode.__set_node_type(TPlanNodeType::MERGE_JOIN_NODE);
+        tnode.__set_num_children(2);
+        tnode.__set_limit(-1);
+        tnode.__set_use_vectorized(true);
+        if (output_right(join_op)) {
+            tnode.__set_row_tuples({0, 1});
+            tnode.__set_nullable_tuples({false, join_op == TJoinOp::LEFT_OUTER_JOIN});
+        } else {
+            tnode.__set_row_tuples({0});
+            tnode.__set_nullable_tuples({false});
+        }
+        TEqJoinCondition eq_condition;
+        eq_condition.__set_left(slot_ref(0, 0));
+        eq_condition.__set_right(slot_ref(2, 1));
+        TMergeJoinNode merge_join_node;
+        merge_join_node.__set_cmp_conjuncts({eq_condition});
+        merge_join_node.__set_join_op(join_op);
+        tnode.__set_merge_join_node(merge_join_node);
+
+        MergeJoinNode node(&_pool, tnode, *_desc_tbl);
+        MockChunksNode left_node(&_pool, child_tnode(0, 0), *_desc_tbl, make_chunks(left, 0, 1));
+        MockChunksNode right_node(&_pool, child_tnode(1, 1), *_desc_tbl, make_chunks(right, 2, 3));
+        node._children.push_back(&left_node);
+        node._children.push_back(&right_node);
+
+        _runtime_state.set_batch_size(batch_size);
+        std::vector<std::string> rows;
+        EXPECT_TRUE(node.init(tnode, &_runtime_state).ok());
+        EXPECT_TRUE(node.prepare(&_runtime_state).ok());
+        EXPECT_TRUE(node.open(&_runtime_state).ok());
+        bool eos = false;
+        while (!eos) {
+            ChunkPtr chunk;
+            EXPECT_TRUE(node.get_next(&_runtime_state, &chunk, &eos).ok());
+            if (eos) {
+                break;
+            }
+            EXPECT_LE(chunk->num_rows(), static_cast<size_t>(batch_size));
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                std::string row = to_string(*chunk, i, 0, 1);
+                if (output_right(join_op)) {
+                    row += "," + to_string(*chunk, i, 2, 3);
+                }
+                rows.emplace_back(std::move(row));
+            }
+        }
+        EXPECT_TRUE(node.close(&_runtime_state).ok());
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    void check_all_joins(const JoinChunks& left, const JoinChunks& right, int batch_size) {
+        for (auto join_op :
+             {TJoinOp::INNER_JOIN, TJoinOp::LEFT_OUTER_JOIN, TJoinOp::LEFT_SEMI_JOIN, TJoinOp::LEFT_ANTI_JOIN}) {
+            ASSERT_EQ(nested_loop_join(join_op, left, right), merge_join(join_op, left, right, batch_size))
+                    << "join op " << join_op << ", batch size " << batch_size;
+        }
+    }
+
+    RuntimeState _runtime_state;
+};
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinNodeTest, test_inner_join) {
+    JoinChunks left{{{1, 10}, {2, 20}, {3, 30}}, {{5, 50}}};
+    JoinChunks right{{{0, 100}, {2, 200}, {3, 300}}, {{3, 301}, {4, 400}, {5, 500}}};
+    std::vector<std::string> expected{"2,20,2,200", "3,30,3,300", "3,30,3,301", "5,50,5,500"};
+    ASSERT_EQ(expected, merge_join(TJoinOp::INNER_JOIN, left, right, 4096));
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinNodeTest, test_left_outer_join) {
+    JoinChunks left{{{1, 10}, {2, 20}, {3, 30}}, {{6, 60}}};
+    JoinChunks right{{{2, 200}, {3, 300}}, {{4, 400}}};
+    std::vector<std::string> expected{"1,10,NULL,NULL", "2,20,2,200", "3,30,3,300", "6,60,NULL,NULL"};
+    ASSERT_EQ(expected, merge_join(TJoinOp::LEFT_OUTER_JOIN, left, right, 4096));
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinNodeTest, test_semi_and_anti_join) {
+    JoinChunks left{{{1, 10}, {2, 20}, {2, 21}}, {{3, 30}, {6, 60}}};
+    JoinChunks right{{{2, 200}, {2, 201}, {3, 300}}};
+    std::vector<std::string> semi{"2,20", "2,21", "3,30"};
+    std::vector<std::string> anti{"1,10", "6,60"};
+    ASSERT_EQ(semi, merge_join(TJoinOp::LEFT_SEMI_JOIN, left, right, 4096));
+    ASSERT_EQ(anti, merge_join(TJoinOp::LEFT_ANTI_JOIN, left, right, 4096));
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinNodeTest, test_runs_across_chunks) {
+    // The run of the key 2 spans three right chunks and two left chunks, and produces more rows than a batch.
+    JoinChunks left{{{1, 10}, {2, 20}, {2, 21}}, {{2, 22}, {2, 23}, {4, 40}}, {{7, 70}}};
+    JoinChunks right{{{0, 100}, {2, 200}, {2, 201}}, {{2, 202}}, {{2, 203}, {4, 400}, {4, 401}}, {{6, 600}, {7, 700}}};
+    for (int batch_size : {1, 3, 5, 4096}) {
+        check_all_joins(left, right, batch_size);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinNodeTest, test_null_keys) {
+    // The null keys match nothing, neither the null keys of the other side.
+    JoinChunks left{{{std::nullopt, 1}, {std::nullopt, 2}, {1, 10}}, {{2, 20}, {3, 30}}};
+    JoinChunks right{{{1, 100}, {2, 200}}, {{3, 300}, {std::nullopt, 400}, {std::nullopt, 401}}};
+    for (int batch_size : {1, 2, 4096}) {
+        check_all_joins(left, right, batch_size);
+    }
+    std::vector<std::string> outer{"1,10,1,100", "2,20,2,200", "3,30,3,300", "NULL,1,NULL,NULL", "NULL,2,NULL,NULL"};
+    ASSERT_EQ(outer, merge_join(TJoinOp::LEFT_OUTER_JOIN, left, right, 4096));
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinNodeTest, test_empty_inputs) {
+    JoinChunks rows{{{1, 10}, {2, 20}}};
+    JoinChunks empty_chunks{{}, {}};
+    for (const auto& empty : {JoinChunks{}, empty_chunks}) {
+        check_all_joins(empty, rows, 4096);
+        check_all_joins(rows, empty, 4096);
+        check_all_joins(empty, empty, 4096);
+    }
+    ASSERT_TRUE(merge_join(TJoinOp::INNER_JOIN, rows, JoinChunks{}, 4096).empty());
+    std::vector<std::string> outer{"1,10,NULL,NULL", "2,20,NULL,NULL"};
+    ASSERT_EQ(outer, merge_join(TJoinOp::LEFT_OUTER_JOIN, rows, JoinChunks{}, 4096));
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinNodeTest, test_random_inputs) {
+    std::mt19937 rand(0);
+    auto sorted_chunks = [&](size_t num_rows, int32_t max_key) {
+        std::vector<JoinRow> rows;
+        for (size_t i = 0; i < num_rows; i++) {
+            std::optional<int32_t> key;
+            if (rand() % 10 != 0) {
+                key = static_cast<int32_t>(rand() % max_key);
+            }
+            rows.push_back({key, static_cast<int32_t>(i)});
+        }
+        // Nulls first, as sorted by the children.
+        std::stable_sort(rows.begin(), rows.end(), [](const JoinRow& a, const JoinRow& b) { return a.key < b.key; });
+        JoinChunks chunks;
+        for (size_t begin = 0; begin < rows.size();) {
+            size_t end = std::min(rows.size(), begin + 1 + rand() % 16);
+            chunks.emplace_back(rows.begin() + begin, rows.begin() + end);
+            begin = end;
+        }
+        return chunks;
+    };
+    for (int i = 0; i < 10; i++) {
+        auto left = sorted_chunks(100, 20 + i * 10);
+        auto right = sorted_chunks(120, 20 + i * 10);
+        check_all_joins(left, right, 1 + rand() % 64);
+    }
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,204 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/object_pool.h"
+#include "exec/exec_node.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+
+namespace starrocks::vectorized {
+
+// MockChunksNode returns the given chunks one by one, as the child of the nodes under test.
+class MockChunksNode final : public ExecNode {
+public:
+    MockChunksNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs, std::vector<ChunkPtr> chunks)
+            : ExecNode(pool, tnode, descs), _chunks(std::move(chunks)) {}
+
+    Status init(const TPlanNode& tnode, RuntimeState* state) override { return Status::OK(); }
+    Status prepare(RuntimeState* state) override { return Status::OK(); }
+    Status open(RuntimeState* state) override { return Status::OK(); }
+
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override {
+        return Status::NotSupported("get_next for row_batch is not supported");
+    }
+
+    Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override {
+        *eos = _next >= _chunks.size();
+        if (!*eos) {
+            *chunk = _chunks[_next++];
+        }
+        return Status::OK();
+    }
+
+    Status close(RuntimeState* state) override { return Status::OK(); }
+
+private:
+    std::vector<ChunkPtr> _chunks;
+    size_t _next = 0;
+};
+
+// A row of a child of a join, of a nullable join key and a value.
+struct JoinRow {
+    std::optional<int32_t> key;
+    int32_t value;
+};
+
+using JoinChunks = std::vector<std::vector<JoinRow>>;
+
+// The fixture of the tests of the join nodes, whose children are the MockChunksNodes of the rows of the left tuple 0
+// of the slots 0 (key) and 1 (value), and of the right tuple 1 of the slots 2 and 3. The rows are printed as
+// "key,value" of each side, "NULL" for a null.
+class JoinNodeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        TDescriptorTableBuilder desc_tbl_builder;
+        for (int i = 0; i < 2; i++) {
+            TTupleDescriptorBuilder tuple_builder;
+            tuple_builder.add_slot(
+                    TSlotDescriptorBuilder().type(TYPE_INT).column_name("k").column_pos(0).nullable(true).build());
+            tuple_builder.add_slot(
+                    TSlotDescriptorBuilder().type(TYPE_INT).column_name("v").column_pos(1).nullable(false).build());
+            tuple_builder.build(&desc_tbl_builder);
+        }
+        DescriptorTbl::create(&_pool, desc_tbl_builder.desc_tbl(), &_desc_tbl);
+    }
+
+    static TExprNode slot_ref_node(SlotId slot_id, TupleId tuple_id) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::SLOT_REF);
+        node.__set_type(gen_type_desc(TPrimitiveType::INT));
+        node.__set_num_children(0);
+        TSlotRef t_slot_ref;
+        t_slot_ref.__set_slot_id(slot_id);
+        t_slot_ref.__set_tuple_id(tuple_id);
+        node.__set_slot_ref(t_slot_ref);
+        node.__set_use_vectorized(true);
+        node.__set_is_nullable(true);
+        return node;
+    }
+
+    static TExpr slot_ref(SlotId slot_id, TupleId tuple_id) {
+        TExpr expr;
+        expr.nodes.emplace_back(slot_ref_node(slot_id, tuple_id));
+        return expr;
+    }
+
+    static TPlanNode child_tnode(TPlanNodeId node_id, TupleId tuple_id) {
+        TPlanNode tnode;
+        tnode.__set_node_id(node_id);
+        tnode.__set_node_type(TPlanNodeType::EXCHANGE_NODE);
+        tnode.__set_num_children(0);
+        tnode.__set_limit(-1);
+        tnode.__set_row_tuples({tuple_id});
+        tnode.__set_nullable_tuples({false});
+        tnode.__set_use_vectorized(true);
+        return tnode;
+    }
+
+    // The chunks of |chunk_sizes| rows, of which the keys are random in [0, max_key) or null, and the values are
+    // the row numbers.
+    static JoinChunks random_rows(std::mt19937* rand, const std::vector<size_t>& chunk_sizes, int32_t max_key) {
+        JoinChunks chunks;
+        int32_t value = 0;
+        for (size_t chunk_size : chunk_sizes) {
+            auto& rows = chunks.emplace_back();
+            for (size_t j = 0; j < chunk_size; j++) {
+                std::optional<int32_t> key;
+                if ((*rand)() % 20 != 0) {
+                    key = static_cast<int32_t>((*rand)() % max_key);
+                }
+                rows.push_back({key, value++});
+            }
+        }
+        return chunks;
+    }
+
+    static std::vector<ChunkPtr> make_chunks(const JoinChunks& chunks, SlotId key_slot, SlotId value_slot) {
+        std::vector<ChunkPtr> result;
+        for (const auto& rows : chunks) {
+            auto keys = NullableColumn::create(Int32Column::create(), NullColumn::create());
+            auto values = Int32Column::create();
+            for (const auto& row : rows) {
+                if (row.key.has_value()) {
+                    keys->append_datum(Datum(*row.key));
+                } else {
+                    EXPECT_TRUE(keys->append_nulls(1));
+                }
+                values->append(row.value);
+            }
+            auto chunk = std::make_shared<Chunk>();
+            chunk->append_column(std::move(keys), key_slot);
+            chunk->append_column(std::move(values), value_slot);
+            result.emplace_back(std::move(chunk));
+        }
+        return result;
+    }
+
+    static std::string to_string(const std::optional<int32_t>& key) {
+        return key.has_value() ? std::to_string(*key) : "NULL";
+    }
+
+    static std::string to_string(const Datum& datum) {
+        return datum.is_null() ? "NULL" : std::to_string(datum.get_int32());
+    }
+
+    static std::string to_string(const Chunk& chunk, size_t row, SlotId key_slot, SlotId value_slot) {
+        return to_string(chunk.get_column_by_slot_id(key_slot)->get(row)) + "," +
+               to_string(chunk.get_column_by_slot_id(value_slot)->get(row));
+    }
+
+    // Whether the rows of the join of |join_op| have the columns of the right child.
+    static bool output_right(TJoinOp::type join_op) {
+        return join_op == TJoinOp::INNER_JOIN || join_op == TJoinOp::LEFT_OUTER_JOIN;
+    }
+
+    // The sorted rows of the inner, left outer, left semi or left anti join of |left| and |right| on equal keys, by
+    // a nested loop.
+    static std::vector<std::string> nested_loop_join(TJoinOp::type join_op, const JoinChunks& left,
+                                                     const JoinChunks& right) {
+        std::vector<std::string> rows;
+        for (const auto& left_rows : left) {
+            for (const auto& l : left_rows) {
+                std::string left_row = to_string(l.key) + "," + std::to_string(l.value);
+                bool matched = false;
+                for (const auto& right_rows : right) {
+                    for (const auto& r : right_rows) {
+                        if (!l.key.has_value() || l.key != r.key) {
+                            continue;
+                        }
+                        matched = true;
+                        if (output_right(join_op)) {
+                            rows.emplace_back(left_row + "," + to_string(r.key) + "," + std::to_string(r.value));
+                        }
+                    }
+                }
+                if (join_op == TJoinOp::LEFT_OUTER_JOIN && !matched) {
+                    rows.emplace_back(left_row + ",NULL,NULL");
+                } else if ((join_op == TJoinOp::LEFT_SEMI_JOIN && matched) ||
+                           (join_op == TJoinOp::LEFT_ANTI_JOIN && !matched)) {
+                    rows.emplace_back(left_row);
+                }
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+};
+
+} // namespace starrocks::vectorized
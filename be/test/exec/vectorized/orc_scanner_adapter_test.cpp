@@ -7,6 +7,7 @@
 #include <ctime>
 #include <filesystem>
 #include <map>
+#include <unordered_set>
 #include <vector>
 
 #include "common/object_pool.h"
@@ -412,6 +413,67 @@ TEST_F(OrcScannerAdapterTest, SkipRowGroups) {
     EXPECT_EQ(records, filter->expected_rows());
 }
 
+TEST_F(OrcScannerAdapterTest, LazyLoad) {
+    // lo_orderkey filters the rows, and the other columns are read lazily.
+    const SlotId filter_slot_id = 2;
+    std::unordered_set<SlotId> lazy_load_slot_ids;
+    for (const auto* slot : _src_slot_descs) {
+        if (slot->id() != filter_slot_id) {
+            lazy_load_slot_ids.insert(slot->id());
+        }
+    }
+    OrcScannerAdapter adapter(_src_slot_descs);
+    adapter.set_lazy_load_slot_ids(lazy_load_slot_ids);
+    ASSERT_TRUE(adapter.init(orc::readLocalFile(input_orc_file)).ok());
+    ASSERT_TRUE(adapter.has_lazy_load_columns());
+
+    OrcScannerAdapter expected_adapter(_src_slot_descs);
+    ASSERT_TRUE(expected_adapter.init(orc::readLocalFile(input_orc_file)).ok());
+
+    uint64_t records = 0;
+    for (;;) {
+        Status st = adapter.read_next();
+        if (st.is_end_of_file()) {
+            ASSERT_TRUE(expected_adapter.read_next().is_end_of_file());
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.get_error_msg();
+        ChunkPtr ckptr = adapter.create_chunk();
+        ASSERT_TRUE(adapter.fill_chunk(&ckptr).ok());
+        ChunkPtr result = adapter.cast_chunk(&ckptr);
+        ASSERT_EQ(1, result->num_columns());
+
+        // a short run of the rows, a long run filtered out, and then every other row.
+        const size_t num_rows = result->num_rows();
+        Column::Filter filter(num_rows, 0);
+        for (size_t i = 0; i < num_rows; i++) {
+            filter[i] = i < 10 || (i >= 110 && i % 2 == 0);
+        }
+        result->filter(filter);
+        adapter.select_lazy_load_rows(&filter);
+        ASSERT_TRUE(adapter.lazy_load_chunk(&result).ok());
+        ASSERT_EQ(adapter.num_columns(), result->num_columns());
+
+        ASSERT_TRUE(expected_adapter.read_next().ok());
+        ChunkPtr expected_ptr = expected_adapter.create_chunk();
+        ASSERT_TRUE(expected_adapter.fill_chunk(&expected_ptr).ok());
+        ChunkPtr expected = expected_adapter.cast_chunk(&expected_ptr);
+        ASSERT_EQ(num_rows, expected->num_rows());
+        expected->filter(filter);
+
+        ASSERT_EQ(expected->num_rows(), result->num_rows());
+        for (const auto* slot : _src_slot_descs) {
+            const auto& column = result->get_column_by_slot_id(slot->id());
+            const auto& expected_column = expected->get_column_by_slot_id(slot->id());
+            for (size_t i = 0; i < result->num_rows(); i++) {
+                ASSERT_EQ(expected_column->debug_item(i), column->debug_item(i));
+            }
+        }
+        records += result->num_rows();
+    }
+    EXPECT_GT(records, 0);
+}
+
 template <int ORC_PRECISION, int ORC_SCALE, typename ValueType>
 std::vector<DecimalV2Value> convert_orc_to_starrocks_decimalv2(ObjectPool* pool, const std::vector<ValueType>& values) {
     std::cout << "orc precision=" << ORC_PRECISION << " scale=" << ORC_SCALE << std::endl;
@@ -0,0 +1,88 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/parquet_writer.h"
+
+#include <gtest/gtest.h>
+#include <parquet/api/reader.h>
+
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "exec/local_file_writer.h"
+#include "util/file_utils.h"
+
+namespace starrocks::vectorized {
+
+class ParquetWriterTest : public ::testing::Test {
+public:
+    void SetUp() override { FileUtils::create_dir(_dir); }
+    void TearDown() override { FileUtils::remove_all(_dir); }
+
+protected:
+    const std::string _dir = "./ut_dir/parquet_writer_test";
+};
+
+TEST_F(ParquetWriterTest, WriteRowGroups) {
+    std::string path = _dir + "/test.parquet";
+    LocalFileWriter file_writer(path, 0);
+    ASSERT_TRUE(file_writer.open().ok());
+
+    std::vector<TypeDescriptor> types{TypeDescriptor(TYPE_INT), TypeDescriptor::create_varchar_type(10)};
+    ParquetWriterOptions options;
+    options.max_row_group_bytes = 1024;
+    options.column_names = {"c0", "c1"};
+    options.use_dict = {true, false};
+    options.num_encode_threads = 2;
+    ParquetChunkWriter writer(&file_writer, types, options);
+    ASSERT_TRUE(writer.init().ok());
+
+    // every 3rd row is null
+    constexpr int kNumChunks = 10;
+    constexpr int kChunkSize = 100;
+    for (int i = 0; i < kNumChunks; i++) {
+        auto c0 = ColumnHelper::create_column(types[0], true);
+        auto c1 = ColumnHelper::create_column(types[1], true);
+        for (int j = 0; j < kChunkSize; j++) {
+            int value = i * kChunkSize + j;
+            if (value % 3 == 0) {
+                ASSERT_TRUE(c0->append_nulls(1));
+                ASSERT_TRUE(c1->append_nulls(1));
+            } else {
+                c0->append_datum(Datum(value));
+                std::string str = std::to_string(value);
+                c1->append_datum(Datum(Slice(str)));
+            }
+        }
+        ASSERT_TRUE(writer.write({c0, c1}).ok());
+    }
+    ASSERT_TRUE(writer.close().ok());
+    ASSERT_GT(writer.written_bytes(), 0);
+
+    auto reader = ::parquet::ParquetFileReader::OpenFile(path);
+    auto metadata = reader->metadata();
+    ASSERT_EQ(kNumChunks * kChunkSize, metadata->num_rows());
+    ASSERT_EQ(2, metadata->num_columns());
+    ASSERT_GT(metadata->num_row_groups(), 1);
+    ASSERT_EQ("c0", metadata->schema()->Column(0)->name());
+
+    int value = 0;
+    for (int rg = 0; rg < metadata->num_row_groups(); rg++) {
+        auto column_reader = reader->RowGroup(rg)->Column(0);
+        auto* int_reader = static_cast<::parquet::Int32Reader*>(column_reader.get());
+        while (int_reader->HasNext()) {
+            int16_t def_level = 0;
+            int32_t v = 0;
+            int64_t values_read = 0;
+            int_reader->ReadBatch(1, &def_level, nullptr, &v, &values_read);
+            if (value % 3 == 0) {
+                ASSERT_EQ(0, def_level);
+            } else {
+                ASSERT_EQ(1, def_level);
+                ASSERT_EQ(value, v);
+            }
+            value++;
+        }
+    }
+    ASSERT_EQ(kNumChunks * kChunkSize, value);
+}
+
+} // namespace starrocks::vectorized
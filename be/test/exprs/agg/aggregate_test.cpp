@@ -666,6 +666,63 @@ TEST_F(AggregateTest, test_sum_nullable) {
     ASSERT_EQ(4950, result_data.get_data()[0]);
 }
 
+TEST_F(AggregateTest, test_remove_sliding_frame) {
+    using NullableSumInt64 = NullableAggregateFunctionState<SumAggregateState<int64_t>>;
+    const AggregateFunction* sum_null = get_aggregate_function("sum", TYPE_INT, TYPE_BIGINT, true);
+    std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(sum_null);
+
+    auto data_column = Int32Column::create();
+    auto null_column = NullColumn::create();
+    for (int i = 0; i < 10; i++) {
+        data_column->append(i);
+        null_column->append(i % 2 ? 1 : 0);
+    }
+    auto column = NullableColumn::create(std::move(data_column), std::move(null_column));
+    const Column* row_column = column.get();
+
+    // frame [0, 4) slides to [2, 6)
+    sum_null->update_batch_single_state(ctx, state->mutable_data(), &row_column, 0, 10, 0, 4);
+    ASSERT_TRUE(sum_null->remove_batch_single_state(ctx, state->mutable_data(), &row_column, 0, 2, 4));
+    sum_null->update_batch_single_state(ctx, state->mutable_data(), &row_column, 0, 10, 4, 6);
+    auto* null_state = (NullableSumInt64*)state->mutable_data();
+    ASSERT_FALSE(null_state->is_null);
+    ASSERT_EQ(6, *reinterpret_cast<const int64_t*>(null_state->nested_state()));
+
+    // frame [2, 6) slides to [5, 6), which is all null
+    ASSERT_TRUE(sum_null->remove_batch_single_state(ctx, state->mutable_data(), &row_column, 2, 5, 6));
+    ASSERT_TRUE(null_state->is_null);
+
+    const AggregateFunction* max = get_aggregate_function("max", TYPE_INT, TYPE_INT, false);
+    std::unique_ptr<ManagedAggregateState> max_state = ManagedAggregateState::Make(max);
+    const Column* max_column = down_cast<const NullableColumn*>(row_column)->data_column().get();
+    max->update_batch_single_state(ctx, max_state->mutable_data(), &max_column, 0, 10, 0, 4);
+    ASSERT_TRUE(max->remove_batch_single_state(ctx, max_state->mutable_data(), &max_column, 0, 2, 4));
+    // the maximum 3 is removed
+    ASSERT_FALSE(max->remove_batch_single_state(ctx, max_state->mutable_data(), &max_column, 2, 4, 4));
+}
+
+TEST_F(AggregateTest, test_remove_sliding_frame_of_doubles) {
+    // sliding the frame [0, 2) to [1, 3) by subtraction would get (1e20 + 1 + 1) - 1e20 = 0, rather than 2.
+    auto column = DoubleColumn::create();
+    for (double v : {1e20, 1.0, 1.0}) {
+        column->append(v);
+    }
+    const Column* row_column = column.get();
+    for (auto [name, expected] : {std::make_pair("sum", 2.0), std::make_pair("avg", 1.0)}) {
+        const AggregateFunction* func = get_aggregate_function(name, TYPE_DOUBLE, TYPE_DOUBLE, false);
+        std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(func);
+        func->update_batch_single_state(ctx, state->mutable_data(), &row_column, 0, 3, 0, 2);
+        ASSERT_FALSE(func->remove_batch_single_state(ctx, state->mutable_data(), &row_column, 0, 1, 2)) << name;
+
+        // the frame is computed from scratch instead
+        func->reset(ctx, {}, state->mutable_data());
+        func->update_batch_single_state(ctx, state->mutable_data(), &row_column, 0, 3, 1, 3);
+        auto result_column = DoubleColumn::create();
+        func->finalize_to_column(ctx, state->data(), result_column.get());
+        ASSERT_EQ(expected, result_column->get_data()[0]) << name;
+    }
+}
+
 TEST_F(AggregateTest, test_count_nullable) {
     const AggregateFunction* func = get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, true);
     std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(func);
@@ -738,6 +795,47 @@ TEST_F(AggregateTest, test_group_concat) {
     ASSERT_EQ("starrocks0, starrocks1, starrocks2, starrocks3, starrocks4, starrocks5", result_column->get_data()[0]);
 }
 
+TEST_F(AggregateTest, test_group_concat_chunks) {
+    const AggregateFunction* group_concat_function =
+            get_aggregate_function("group_concat", TYPE_VARCHAR, TYPE_VARCHAR, false);
+    std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(group_concat_function);
+
+    // the values span many chunks of the arena, and some of them are larger than a chunk.
+    auto data_column = BinaryColumn::create();
+    std::string expected;
+    for (int i = 0; i < 1000; i++) {
+        std::string val(i % 100 == 0 ? 100000 : i % 50, static_cast<char>('a' + i % 26));
+        val.append(std::to_string(i));
+        data_column->append(val);
+        expected.append(i == 0 ? "" : ", ").append(val);
+    }
+    const Column* row_column = data_column.get();
+    group_concat_function->update_batch_single_state(ctx, data_column->size(), &row_column, state->mutable_data());
+
+    auto result_column = BinaryColumn::create();
+    group_concat_function->finalize_to_column(ctx, state->data(), result_column.get());
+    ASSERT_EQ(expected, result_column->get_data()[0].to_string());
+
+    // serialize and merge into another state
+    auto serialized_column = BinaryColumn::create();
+    group_concat_function->serialize_to_column(ctx, state->data(), serialized_column.get());
+    std::unique_ptr<ManagedAggregateState> merged = ManagedAggregateState::Make(group_concat_function);
+    group_concat_function->merge(ctx, serialized_column.get(), merged->mutable_data(), 0);
+    group_concat_function->merge(ctx, serialized_column.get(), merged->mutable_data(), 0);
+    result_column = BinaryColumn::create();
+    group_concat_function->finalize_to_column(ctx, merged->data(), result_column.get());
+    ASSERT_EQ(expected + ", " + expected, result_column->get_data()[0].to_string());
+
+    // the chunks are reused after reset
+    group_concat_function->reset(ctx, {}, state->mutable_data());
+    group_concat_function->update_batch_single_state(ctx, 3, &row_column, state->mutable_data());
+    result_column = BinaryColumn::create();
+    group_concat_function->finalize_to_column(ctx, state->data(), result_column.get());
+    ASSERT_EQ(data_column->get_slice(0).to_string() + ", " + data_column->get_slice(1).to_string() + ", " +
+                      data_column->get_slice(2).to_string(),
+              result_column->get_data()[0].to_string());
+}
+
 TEST_F(AggregateTest, test_intersect_count) {
     const AggregateFunction* group_concat_function =
             get_aggregate_function("intersect_count", TYPE_INT, TYPE_BIGINT, false);
@@ -591,5 +591,44 @@ TEST_F(VectorizedArithmeticExprTest, constModN128Expr) {
     }
 }
 
+TEST_F(VectorizedArithmeticExprTest, inPlaceExpr) {
+    expr_node.opcode = TExprOpcode::ADD;
+    expr_node.type = gen_type_desc(TPrimitiveType::INT);
+    // The results are written into the temporary column of a child, and the null flags are unioned.
+    {
+        std::unique_ptr<Expr> expr(VectorizedArithmeticExprFactory::from_thrift(expr_node));
+        MockNullVectorizedExpr<TYPE_INT> col1(expr_node, 10, 10);
+        MockNullVectorizedExpr<TYPE_INT> col2(expr_node, 10, 2);
+        ++col2.flag;
+        expr->_children.push_back(&col1);
+        expr->_children.push_back(&col2);
+
+        ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+        ASSERT_TRUE(ptr->is_nullable());
+        ASSERT_EQ(10, ptr->size());
+        auto data = std::static_pointer_cast<NullableColumn>(ptr)->data_column();
+        for (int j = 0; j < ptr->size(); ++j) {
+            ASSERT_TRUE(ptr->is_null(j));
+            ASSERT_EQ(12, std::static_pointer_cast<Int32Column>(data)->get_data()[j]);
+        }
+    }
+    // The column referred to by others, like a column of the chunk, is not overwritten.
+    {
+        std::unique_ptr<Expr> expr(VectorizedArithmeticExprFactory::from_thrift(expr_node));
+        MockVectorizedExpr<TYPE_INT> col1(expr_node, 10, 1);
+        MockConstVectorizedExpr<TYPE_INT> col2(expr_node, 2);
+        col2.col = col1.evaluate(nullptr, nullptr);
+        expr->_children.push_back(&col2);
+        expr->_children.push_back(&col2);
+
+        ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+        ASSERT_NE(ptr.get(), col2.col.get());
+        for (int j = 0; j < ptr->size(); ++j) {
+            ASSERT_EQ(2, std::static_pointer_cast<Int32Column>(ptr)->get_data()[j]);
+            ASSERT_EQ(1, std::static_pointer_cast<Int32Column>(col2.col)->get_data()[j]);
+        }
+    }
+}
+
 } // namespace vectorized
 } // namespace starrocks
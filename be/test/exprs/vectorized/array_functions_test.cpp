@@ -433,6 +433,49 @@ TEST_F(ArrayFunctionsTest, array_contains_has_null_element) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ArrayFunctionsTest, array_contains_null_element_default_value) {
+    // The null elements must not match the target equal to the default value of their data.
+    // array_contains([NULL, 1], 0) : 0
+    // array_contains([NULL, 0], 0) : 1
+    // array_contains([], 0) : 0
+    {
+        auto array = ColumnHelper::create_column(TYPE_ARRAY_INT, false);
+        array->append_datum(DatumArray{Datum{}, (int32_t)1});
+        array->append_datum(DatumArray{Datum{}, (int32_t)0});
+        array->append_datum(Datum(DatumArray{}));
+
+        auto target = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false, true, 1);
+        target->append_datum(Datum{(int32_t)0});
+
+        auto result = ArrayFunctions::array_contains(nullptr, {array, target});
+        EXPECT_EQ(3, result->size());
+        EXPECT_EQ(0, result->get(0).get_int8());
+        EXPECT_EQ(1, result->get(1).get_int8());
+        EXPECT_EQ(0, result->get(2).get_int8());
+    }
+    // array_contains([NULL, "a"], "") : 0
+    // array_contains([NULL, "", "ab"], "") : 1
+    // array_contains(["ab", "abc"], "abc") : 1
+    {
+        auto array = ColumnHelper::create_column(TYPE_ARRAY_VARCHAR, false);
+        array->append_datum(DatumArray{Datum{}, "a"});
+        array->append_datum(DatumArray{Datum{}, "", "ab"});
+        array->append_datum(DatumArray{"ab", "abc"});
+
+        auto target = ColumnHelper::create_column(TypeDescriptor(TYPE_VARCHAR), false);
+        target->append_datum(Datum{""});
+        target->append_datum(Datum{""});
+        target->append_datum(Datum{"abc"});
+
+        auto result = ArrayFunctions::array_contains(nullptr, {array, target});
+        EXPECT_EQ(3, result->size());
+        EXPECT_EQ(0, result->get(0).get_int8());
+        EXPECT_EQ(1, result->get(1).get_int8());
+        EXPECT_EQ(1, result->get(2).get_int8());
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(ArrayFunctionsTest, array_contains_has_null_target) {
     // array_contains(["abc", "def"], NULL)
@@ -428,5 +428,58 @@ TEST_F(VectorizedCaseExprTest, NoCaseWhenNullReturnIntElse) {
     }
 }
 
+TEST_F(VectorizedCaseExprTest, NoCaseSkipUnchosenBranches) {
+    expr_node.child_type = TPrimitiveType::INT;
+    expr_node.type = gen_type_desc(TPrimitiveType::INT);
+    expr_node.case_expr.has_case_expr = false;
+    expr_node.case_expr.has_else_expr = true;
+
+    std::unique_ptr<Expr> expr(VectorizedCaseExprFactory::from_thrift(expr_node));
+
+    MockMultiVectorizedExpr<TYPE_BOOLEAN> when1(expr_node, 10, true, false);
+    MockVectorizedExpr<TYPE_INT> then1(expr_node, 10, 10);
+    MockMultiVectorizedExpr<TYPE_BOOLEAN> when2(expr_node, 10, true, false);
+    MockVectorizedExpr<TYPE_INT> then2(expr_node, 10, 20);
+    MockVectorizedExpr<TYPE_BOOLEAN> when3(expr_node, 10, true);
+    MockNullVectorizedExpr<TYPE_INT> then3(expr_node, 10, 30);
+    MockVectorizedExpr<TYPE_BOOLEAN> when4(expr_node, 10, true);
+    MockVectorizedExpr<TYPE_INT> then4(expr_node, 10, 40);
+    MockVectorizedExpr<TYPE_INT> else_expr(expr_node, 10, 50);
+
+    expr->_children.push_back(&when1);
+    expr->_children.push_back(&then1);
+    expr->_children.push_back(&when2);
+    expr->_children.push_back(&then2);
+    expr->_children.push_back(&when3);
+    expr->_children.push_back(&then3);
+    expr->_children.push_back(&when4);
+    expr->_children.push_back(&then4);
+    expr->_children.push_back(&else_expr);
+
+    {
+        Chunk chunk;
+        ColumnPtr ptr = expr->evaluate(nullptr, &chunk);
+        ASSERT_EQ(10, ptr->size());
+        ASSERT_TRUE(ptr->is_nullable());
+
+        // the even rows choose then1, and the odd ones choose then3, which is null in the odd rows.
+        auto v = ColumnHelper::cast_to_raw<TYPE_INT>(ColumnHelper::as_raw_column<NullableColumn>(ptr)->data_column());
+        for (int j = 0; j < ptr->size(); ++j) {
+            if (j % 2 == 0) {
+                ASSERT_FALSE(ptr->is_null(j));
+                ASSERT_EQ(10, v->get_data()[j]);
+            } else {
+                ASSERT_TRUE(ptr->is_null(j));
+            }
+        }
+
+        // the rows matching when2 have matched when1, and all the rows have matched before when4
+        ASSERT_EQ(0, then2.cost_ns());
+        ASSERT_EQ(0, when4.cost_ns());
+        ASSERT_EQ(0, then4.cost_ns());
+        ASSERT_EQ(0, else_expr.cost_ns());
+    }
+}
+
 } // namespace vectorized
 } // namespace starrocks
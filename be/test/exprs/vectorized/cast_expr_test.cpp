@@ -30,6 +30,24 @@ public:
     TExprNode expr_node;
 };
 
+// Evaluates to the string column of the values.
+class MockStringsExpr final : public MockCostExpr {
+public:
+    MockStringsExpr(const TExprNode& t, std::vector<std::string> values)
+            : MockCostExpr(t), _values(std::move(values)) {}
+
+    ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override {
+        auto col = BinaryColumn::create();
+        for (const auto& value : _values) {
+            col->append(value);
+        }
+        return col;
+    }
+
+private:
+    std::vector<std::string> _values;
+};
+
 TEST_F(VectorizedCastExprTest, IntCastToDate) {
     expr_node.child_type = TPrimitiveType::INT;
     expr_node.type = gen_type_desc(TPrimitiveType::DATE);
@@ -1337,5 +1355,95 @@ TEST_F(VectorizedCastExprTest, timeToVarchar) {
         ASSERT_EQ("02:22:01", d->get_data()[1]);
     }
 }
+
+TEST_F(VectorizedCastExprTest, stringCastBigIntInBatch) {
+    expr_node.child_type = TPrimitiveType::VARCHAR;
+    expr_node.type = gen_type_desc(TPrimitiveType::BIGINT);
+
+    std::unique_ptr<Expr> expr(VectorizedCastExprFactory::from_thrift(expr_node));
+
+    MockStringsExpr col1(expr_node, {"123456789012345678", "-9223372036854775808", "9223372036854775808", "+42",
+                                     " 42", "42 ", "-0", "12a", "", "-", "1234567"});
+    std::vector<std::pair<int64_t, bool>> expected{{123456789012345678, false},
+                                                   {std::numeric_limits<int64_t>::min(), false},
+                                                   {0, true},
+                                                   {42, false},
+                                                   {42, false},
+                                                   {42, false},
+                                                   {0, false},
+                                                   {0, true},
+                                                   {0, true},
+                                                   {0, true},
+                                                   {1234567, false}};
+
+    expr->_children.push_back(&col1);
+
+    ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+    ASSERT_TRUE(ptr->is_nullable());
+    ASSERT_EQ(expected.size(), ptr->size());
+
+    auto v = ColumnHelper::cast_to_raw<TYPE_BIGINT>(ColumnHelper::as_raw_column<NullableColumn>(ptr)->data_column());
+    for (int j = 0; j < expected.size(); ++j) {
+        ASSERT_EQ(expected[j].second, ptr->is_null(j));
+        if (!expected[j].second) {
+            ASSERT_EQ(expected[j].first, v->get_data()[j]);
+        }
+    }
+}
+
+TEST_F(VectorizedCastExprTest, stringCastDatetimeInBatch) {
+    expr_node.child_type = TPrimitiveType::VARCHAR;
+    expr_node.type = gen_type_desc(TPrimitiveType::DATETIME);
+
+    std::unique_ptr<Expr> expr(VectorizedCastExprFactory::from_thrift(expr_node));
+
+    MockStringsExpr col1(expr_node, {"2021-03-15 12:34:56", "2021-03-15", "2020-02-29 23:59:59", "2021-02-29 00:00:00",
+                                     "2021-03-15 24:00:00", " 2021-03-15 12:34:56 ", "2021-03-15T12:34:56"});
+    std::vector<std::pair<TimestampValue, bool>> expected{{TimestampValue::create(2021, 3, 15, 12, 34, 56), false},
+                                                          {TimestampValue::create(2021, 3, 15, 0, 0, 0), false},
+                                                          {TimestampValue::create(2020, 2, 29, 23, 59, 59), false},
+                                                          {TimestampValue(), true},
+                                                          {TimestampValue(), true},
+                                                          {TimestampValue::create(2021, 3, 15, 12, 34, 56), false},
+                                                          {TimestampValue::create(2021, 3, 15, 12, 34, 56), false}};
+
+    expr->_children.push_back(&col1);
+
+    ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+    ASSERT_TRUE(ptr->is_nullable());
+    ASSERT_EQ(expected.size(), ptr->size());
+
+    auto v = ColumnHelper::cast_to_raw<TYPE_DATETIME>(ColumnHelper::as_raw_column<NullableColumn>(ptr)->data_column());
+    for (int j = 0; j < expected.size(); ++j) {
+        ASSERT_EQ(expected[j].second, ptr->is_null(j));
+        if (!expected[j].second) {
+            ASSERT_EQ(expected[j].first, v->get_data()[j]);
+        }
+    }
+}
+
+TEST_F(VectorizedCastExprTest, stringCastDateInBatch) {
+    expr_node.child_type = TPrimitiveType::VARCHAR;
+    expr_node.type = gen_type_desc(TPrimitiveType::DATE);
+
+    std::unique_ptr<Expr> expr(VectorizedCastExprFactory::from_thrift(expr_node));
+
+    MockStringsExpr col1(expr_node, {"2020-02-29", "1999-12-31", "2021-13-01", "2021-00-10"});
+
+    expr->_children.push_back(&col1);
+
+    ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+    ASSERT_TRUE(ptr->is_nullable());
+    ASSERT_EQ(4, ptr->size());
+
+    auto v = ColumnHelper::cast_to_raw<TYPE_DATE>(ColumnHelper::as_raw_column<NullableColumn>(ptr)->data_column());
+    ASSERT_FALSE(ptr->is_null(0));
+    ASSERT_EQ(DateValue::create(2020, 2, 29), v->get_data()[0]);
+    ASSERT_FALSE(ptr->is_null(1));
+    ASSERT_EQ(DateValue::create(1999, 12, 31), v->get_data()[1]);
+    ASSERT_TRUE(ptr->is_null(2));
+    ASSERT_TRUE(ptr->is_null(3));
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -169,6 +169,28 @@ TEST_F(VectorizedCompoundPredicateTest, nullAndTrueExpr) {
     }
 }
 
+TEST_F(VectorizedCompoundPredicateTest, nullableWithoutNullAndExpr) {
+    expr_node.opcode = TExprOpcode::COMPOUND_AND;
+    std::unique_ptr<Expr> expr(VectorizedCompoundPredicateFactory::from_thrift(expr_node));
+
+    // the only row is not null
+    MockNullVectorizedExpr<TYPE_BOOLEAN> col1(expr_node, 1, 1);
+    MockNullVectorizedExpr<TYPE_BOOLEAN> col2(expr_node, 1, 1);
+
+    expr->_children.push_back(&col1);
+    expr->_children.push_back(&col2);
+
+    {
+        ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+        ASSERT_TRUE(col1.evaluate(nullptr, nullptr)->is_nullable());
+
+        // computed on the data columns only
+        ASSERT_FALSE(ptr->is_nullable());
+        ASSERT_EQ(1, ptr->size());
+        ASSERT_EQ(1, (int)std::static_pointer_cast<BooleanColumn>(ptr)->get_data()[0]);
+    }
+}
+
 TEST_F(VectorizedCompoundPredicateTest, constAndExpr) {
     expr_node.opcode = TExprOpcode::COMPOUND_AND;
     std::unique_ptr<Expr> expr(VectorizedCompoundPredicateFactory::from_thrift(expr_node));
@@ -241,6 +241,53 @@ TEST_F(VectorizedFunctionCallExprTest, mathNullGreatestExprTest) {
     exprContext.close(nullptr);
 }
 
+TEST_F(VectorizedFunctionCallExprTest, mathModConstExprTest) {
+    TFunction function;
+    TFunctionName functionName;
+    functionName.__set_db_name("db");
+    functionName.__set_function_name("mode");
+
+    function.__set_name(functionName);
+    function.__set_binary_type(TFunctionBinaryType::BUILTIN);
+
+    std::vector<TTypeDesc> vec;
+    function.__set_arg_types(vec);
+    function.__set_has_var_args(false);
+    function.__set_fid(10252);
+
+    expr_node.__set_fn(function);
+
+    VectorizedFunctionCallExpr expr(expr_node);
+
+    MockConstVectorizedExpr<TYPE_INT> col1(expr_node, 10);
+    MockConstVectorizedExpr<TYPE_INT> col2(expr_node, 3);
+    col1.col = ColumnHelper::create_const_column<TYPE_INT>(10, 5);
+    col2.col = ColumnHelper::create_const_column<TYPE_INT>(3, 5);
+
+    expr.add_child(&col1);
+    expr.add_child(&col2);
+
+    ExprContext exprContext(&expr);
+    exprContext._is_clone = true;
+    starrocks::RowDescriptor rd;
+
+    WARN_IF_ERROR(expr.prepare(nullptr, rd, &exprContext), "");
+    WARN_IF_ERROR(expr.open(nullptr, &exprContext, FunctionContext::FunctionStateScope::THREAD_LOCAL), "");
+
+    Chunk chunk;
+    auto column = Int32Column::create();
+    column->resize(5);
+    chunk.append_column(column, 0);
+
+    // evaluated on a row of the const arguments, and broadcast to the rows of the chunk.
+    ColumnPtr result = expr.evaluate(&exprContext, &chunk);
+    ASSERT_TRUE(result->is_constant());
+    ASSERT_EQ(5, result->size());
+    ASSERT_EQ(1, ColumnHelper::get_const_value<TYPE_INT>(result));
+
+    exprContext.close(nullptr);
+}
+
 TEST_F(VectorizedFunctionCallExprTest, prepareFaileCase) {
     TFunction function;
     TFunctionName functionName;
@@ -70,6 +70,29 @@ TEST_F(HashFunctionsTest, hashTest) {
     }
 }
 
+TEST_F(HashFunctionsTest, hashNullableAndConstColumns) {
+    auto tc1 = NullableColumn::create(BinaryColumn::create(), NullColumn::create());
+    tc1->append_datum(Datum(Slice("abc")));
+    tc1->append_nulls(1);
+    tc1->append_datum(Datum(Slice("")));
+    tc1->append_datum(Datum(Slice("test1234567")));
+    auto tc2 = ColumnHelper::create_const_column<TYPE_VARCHAR>(Slice("asdf213"), 4);
+
+    Columns columns{tc1, tc2};
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    ColumnPtr result = HashFunctions::murmur_hash3_32(ctx.get(), columns);
+    ASSERT_EQ(4, result->size());
+    ASSERT_TRUE(result->is_null(1));
+
+    for (size_t row : {0, 2, 3}) {
+        ASSERT_FALSE(result->is_null(row));
+        Slice value = tc1->get(row).get_slice();
+        uint32_t hash = HashUtil::murmur_hash3_32(value.data, value.size, HashUtil::MURMUR3_32_SEED);
+        hash = HashUtil::murmur_hash3_32("asdf213", 7, hash);
+        ASSERT_EQ(static_cast<int32_t>(hash), result->get(row).get_int32());
+    }
+}
+
 TEST_F(HashFunctionsTest, emptyTest) {
     uint32_t h3 = 123456;
 
@@ -233,5 +233,69 @@ TEST_F(VectorizedInPredicateTest, sliceNotInNull) {
     }
 }
 
+TEST_F(VectorizedInPredicateTest, bigintInSmallAndLargeList) {
+    expr_node.child_type = TPrimitiveType::BIGINT;
+    expr_node.opcode = TExprOpcode::FILTER_IN;
+    expr_node.type = gen_type_desc(TPrimitiveType::BIGINT);
+    expr_node.in_predicate.is_not_in = false;
+
+    // The lists of at most kMaxArraySetSize values are looked up in the ArraySet, the others in the hash set.
+    for (int64_t num_values : {1, 3, 16, 17, 40}) {
+        for (int64_t probe : {num_values, num_values + 1}) {
+            auto expr = std::unique_ptr<Expr>(VectorizedInPredicateFactory::from_thrift(expr_node));
+            MockVectorizedExpr<TYPE_BIGINT> col1(expr_node, 10, probe);
+            expr->_children.push_back(&col1);
+            std::vector<std::unique_ptr<MockConstVectorizedExpr<TYPE_BIGINT>>> values;
+            for (int64_t i = 1; i <= num_values; i++) {
+                values.emplace_back(std::make_unique<MockConstVectorizedExpr<TYPE_BIGINT>>(expr_node, i));
+                expr->_children.push_back(values.back().get());
+            }
+
+            starrocks::RowDescriptor rd;
+            ASSERT_TRUE(expr->prepare(nullptr, rd, nullptr).ok());
+            ASSERT_TRUE(expr->open(nullptr, nullptr, FunctionContext::FunctionStateScope::THREAD_LOCAL).ok());
+            ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+            ASSERT_EQ(10, ptr->size());
+
+            auto v = ColumnHelper::cast_to_raw<TYPE_BOOLEAN>(ptr);
+            for (int j = 0; j < ptr->size(); ++j) {
+                ASSERT_EQ(probe <= num_values, v->get_data()[j]);
+            }
+            expr->_children.clear();
+        }
+    }
+}
+
+TEST_F(VectorizedInPredicateTest, sliceInOutOfSizeRange) {
+    expr_node.child_type = TPrimitiveType::VARCHAR;
+    expr_node.opcode = TExprOpcode::FILTER_IN;
+    expr_node.type = gen_type_desc(TPrimitiveType::VARCHAR);
+    expr_node.in_predicate.is_not_in = true;
+
+    std::string v1("test1");
+    std::string v2("test22");
+    std::vector<std::string> probes{"t", "test1", "test33", "test333"};
+    for (const std::string& probe : probes) {
+        auto expr = std::unique_ptr<Expr>(VectorizedInPredicateFactory::from_thrift(expr_node));
+        MockVectorizedExpr<TYPE_VARCHAR> col1(expr_node, 10, Slice(probe));
+        MockConstVectorizedExpr<TYPE_VARCHAR> col2(expr_node, Slice(v1));
+        MockConstVectorizedExpr<TYPE_VARCHAR> col3(expr_node, Slice(v2));
+        expr->_children.push_back(&col1);
+        expr->_children.push_back(&col2);
+        expr->_children.push_back(&col3);
+
+        starrocks::RowDescriptor rd;
+        ASSERT_TRUE(expr->prepare(nullptr, rd, nullptr).ok());
+        ASSERT_TRUE(expr->open(nullptr, nullptr, FunctionContext::FunctionStateScope::THREAD_LOCAL).ok());
+        ColumnPtr ptr = expr->evaluate(nullptr, nullptr);
+
+        auto v = ColumnHelper::cast_to_raw<TYPE_BOOLEAN>(ptr);
+        for (int j = 0; j < ptr->size(); ++j) {
+            ASSERT_EQ(probe != "test1", v->get_data()[j]);
+        }
+        expr->_children.clear();
+    }
+}
+
 } // namespace vectorized
 } // namespace starrocks
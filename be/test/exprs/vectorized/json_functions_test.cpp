@@ -236,5 +236,47 @@ TEST_F(JsonFunctionsTest, get_json_emptyTest) {
     }
 }
 
+// The calls with the constant paths on the same json column share the parsed documents, which must not be changed
+// by matching the paths, e.g. by the values moved out of an array.
+TEST_F(JsonFunctionsTest, get_json_same_column_different_paths) {
+    auto json = BinaryColumn::create();
+    json->append("[{\"k1\":\"v1\", \"k2\":1}, {\"k1\":\"v2\", \"k2\":2}]");
+    json->append("{\"k1\":\"v3\", \"k2\":3}");
+    json->append("not a json");
+
+    auto call = [&](const std::string& path, auto fn) {
+        std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+        Columns columns{json, ColumnHelper::create_const_column<TYPE_VARCHAR>(Slice(path), json->size())};
+        ctx->impl()->set_constant_columns(columns);
+        EXPECT_TRUE(JsonFunctions::json_path_prepare(ctx.get(), FunctionContext::FRAGMENT_LOCAL).ok());
+        ColumnPtr result = fn(ctx.get(), columns);
+        EXPECT_TRUE(JsonFunctions::json_path_close(ctx.get(), FunctionContext::FRAGMENT_LOCAL).ok());
+        return result;
+    };
+
+    for (int i = 0; i < 2; ++i) {
+        ColumnPtr k1 = call("$.k1", JsonFunctions::get_json_string);
+        ASSERT_EQ(3, k1->size());
+        ASSERT_EQ("[\"v1\",\"v2\"]", k1->get(0).get_slice().to_string());
+        ASSERT_EQ("v3", k1->get(1).get_slice().to_string());
+        ASSERT_TRUE(k1->is_null(2));
+
+        ColumnPtr k2 = call("$.k2", JsonFunctions::get_json_string);
+        ASSERT_EQ("[1,2]", k2->get(0).get_slice().to_string());
+        ASSERT_EQ("3", k2->get(1).get_slice().to_string());
+        ASSERT_TRUE(k2->is_null(2));
+    }
+
+    // A new column of the same size mustn't be matched in the documents of the former one.
+    auto other = BinaryColumn::create();
+    other->append("{\"k1\":\"x1\"}");
+    other->append("{\"k1\":\"x2\"}");
+    other->append("{\"k1\":\"x3\"}");
+    json = other;
+    ColumnPtr k1 = call("$.k1", JsonFunctions::get_json_string);
+    ASSERT_EQ("x1", k1->get(0).get_slice().to_string());
+    ASSERT_EQ("x3", k1->get(2).get_slice().to_string());
+}
+
 } // namespace vectorized
 } // namespace starrocks
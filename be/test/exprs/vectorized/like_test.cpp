@@ -404,5 +404,116 @@ TEST_F(LikeTest, rowsPatternRegex) {
                         .ok());
 }
 
+TEST_F(LikeTest, prefilterConstPatternRegex) {
+    auto context = FunctionContext::create_test_context();
+    std::unique_ptr<FunctionContext> ctx(context);
+    Columns columns;
+
+    auto str = BinaryColumn::create();
+    auto pattern = ColumnHelper::create_const_column<TYPE_VARCHAR>("t1\\d", 1);
+
+    for (int j = 0; j < 20; ++j) {
+        str->append("test" + std::to_string(j));
+        str->append("abc" + std::to_string(j));
+    }
+
+    columns.push_back(str);
+    columns.push_back(pattern);
+
+    context->impl()->set_constant_columns(columns);
+
+    ASSERT_TRUE(LikePredicate::regex_prepare(context, FunctionContext::FunctionStateScope::THREAD_LOCAL).ok());
+
+    auto result = LikePredicate::regex(context, columns);
+
+    ASSERT_TRUE(result->is_numeric());
+
+    auto v = ColumnHelper::cast_to<TYPE_BOOLEAN>(result);
+
+    for (int l = 0; l < 20; ++l) {
+        ASSERT_EQ(l >= 10, v->get_data()[2 * l]);
+        ASSERT_FALSE(v->get_data()[2 * l + 1]);
+    }
+
+    ASSERT_TRUE(LikePredicate::regex_close(context, FunctionContext::FunctionContext::FunctionStateScope::THREAD_LOCAL)
+                        .ok());
+}
+
+TEST_F(LikeTest, prefilterConstPatternLike) {
+    auto context = FunctionContext::create_test_context();
+    std::unique_ptr<FunctionContext> ctx(context);
+    Columns columns;
+
+    auto str = BinaryColumn::create();
+    auto null = NullColumn::create();
+    auto pattern = ColumnHelper::create_const_column<TYPE_VARCHAR>("te%1_", 1);
+
+    for (int j = 0; j < 20; ++j) {
+        str->append("test" + std::to_string(j));
+        null->append(j == 15);
+        str->append("abc" + std::to_string(j));
+        null->append(0);
+    }
+
+    columns.push_back(NullableColumn::create(str, null));
+    columns.push_back(pattern);
+
+    context->impl()->set_constant_columns(columns);
+
+    ASSERT_TRUE(LikePredicate::like_prepare(context, FunctionContext::FunctionStateScope::THREAD_LOCAL).ok());
+
+    auto result = LikePredicate::like(context, columns);
+
+    ASSERT_TRUE(result->is_nullable());
+
+    auto v = ColumnHelper::as_column<NullableColumn>(result);
+    auto data = ColumnHelper::cast_to<TYPE_BOOLEAN>(v->data_column());
+
+    for (int l = 0; l < 20; ++l) {
+        ASSERT_EQ(l == 15, v->is_null(2 * l));
+        if (l != 15) {
+            ASSERT_EQ(l >= 10, data->get_data()[2 * l]);
+        }
+        ASSERT_FALSE(v->is_null(2 * l + 1));
+        ASSERT_FALSE(data->get_data()[2 * l + 1]);
+    }
+
+    ASSERT_TRUE(LikePredicate::like_close(context, FunctionContext::FunctionContext::FunctionStateScope::THREAD_LOCAL)
+                        .ok());
+}
+
+TEST_F(LikeTest, likePatternSet) {
+    std::unique_ptr<re2::RE2::Set> pattern_set;
+    ASSERT_TRUE(LikePredicate::compile_like_pattern_set({"%error%", "warn_ng", "%\\%done"}, &pattern_set).ok());
+
+    auto str = BinaryColumn::create();
+    auto null = NullColumn::create();
+    str->append("an error occurred");
+    null->append(0);
+    str->append("warning");
+    null->append(0);
+    str->append("warnings");
+    null->append(0);
+    str->append("50%done");
+    null->append(0);
+    str->append("50 done");
+    null->append(0);
+    str->append("");
+    null->append(1);
+
+    auto result = LikePredicate::match_like_pattern_set(*pattern_set, NullableColumn::create(str, null));
+    ASSERT_TRUE(result->is_nullable());
+    ASSERT_EQ(6, result->size());
+
+    auto v = ColumnHelper::as_column<NullableColumn>(result);
+    auto data = ColumnHelper::cast_to<TYPE_BOOLEAN>(v->data_column());
+    std::vector<uint8_t> expected{1, 1, 0, 1, 0};
+    for (int i = 0; i < expected.size(); ++i) {
+        ASSERT_FALSE(v->is_null(i));
+        ASSERT_EQ(expected[i], data->get_data()[i]);
+    }
+    ASSERT_TRUE(v->is_null(5));
+}
+
 } // namespace vectorized
 } // namespace starrocks
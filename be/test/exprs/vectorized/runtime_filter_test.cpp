@@ -31,6 +31,29 @@ TEST_F(RuntimeFilterTest, TestSimdBlockFilter) {
     }
 }
 
+TEST_F(RuntimeFilterTest, TestSimdBlockFilterTestHashes) {
+    SimdBlockFilter bf0;
+    bf0.init(1000);
+    std::vector<uint64_t> hashes;
+    for (uint64_t i = 1; i <= 3000; i++) {
+        uint64_t hash = i * 0x9e3779b97f4a7c15ULL;
+        if (i % 3 == 0) {
+            bf0.insert_hash(hash);
+        }
+        hashes.push_back(hash);
+    }
+    // odd to leave a hash after the pairs tested at once
+    hashes.pop_back();
+    std::vector<uint8_t> results(hashes.size(), 2);
+    bf0.test_hashes(hashes.data(), hashes.size(), results.data());
+    for (size_t i = 0; i < hashes.size(); i++) {
+        EXPECT_EQ(bf0.test_hash(hashes[i]), results[i]);
+        if ((i + 1) % 3 == 0) {
+            EXPECT_EQ(1, results[i]);
+        }
+    }
+}
+
 TEST_F(RuntimeFilterTest, TestSimdBlockFilterSerialize) {
     SimdBlockFilter bf0;
     bf0.init(100);
@@ -110,6 +133,40 @@ TEST_F(RuntimeFilterTest, TestJoinRuntimeFilter) {
     EXPECT_EQ(chunk.num_rows(), 12);
 }
 
+TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterTestRange) {
+    RuntimeBloomFilter<TYPE_INT> bf;
+    JoinRuntimeFilter* rf = &bf;
+    bf.init(100);
+    for (int i = 100; i <= 200; i += 10) {
+        bf.insert(&i);
+    }
+    auto range = [](int min, int max) {
+        TypeDescriptor type_desc(TYPE_INT);
+        ColumnPtr min_column = ColumnHelper::create_column(type_desc, true);
+        ColumnPtr max_column = ColumnHelper::create_column(type_desc, true);
+        min_column->append_datum(Datum(min));
+        max_column->append_datum(Datum(max));
+        return std::make_pair(min_column, max_column);
+    };
+    auto [min0, max0] = range(0, 99);
+    EXPECT_FALSE(rf->test_range(*min0, *max0));
+    auto [min1, max1] = range(201, 300);
+    EXPECT_FALSE(rf->test_range(*min1, *max1));
+    auto [min2, max2] = range(0, 100);
+    EXPECT_TRUE(rf->test_range(*min2, *max2));
+    auto [min3, max3] = range(150, 155);
+    EXPECT_TRUE(rf->test_range(*min3, *max3));
+
+    // Unknown for the other types.
+    ColumnPtr bigint_column = ColumnHelper::create_column(TypeDescriptor(TYPE_BIGINT), false);
+    bigint_column->append_datum(Datum(int64_t{0}));
+    EXPECT_TRUE(rf->test_range(*bigint_column, *bigint_column));
+
+    // The nulls pass the filter.
+    bf.insert(nullptr);
+    EXPECT_TRUE(rf->test_range(*min0, *max0));
+}
+
 TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterSlice) {
     RuntimeBloomFilter<TYPE_VARCHAR> bf;
     // JoinRuntimeFilter* rf = &bf;
@@ -1070,6 +1070,26 @@ PARALLEL_TEST(VecStringFunctionsTest, utf8LengthChineseTest) {
     }
 }
 
+PARALLEL_TEST(VecStringFunctionsTest, utf8LengthMixedTest) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    Columns columns;
+    auto str = BinaryColumn::create();
+    str->append("abc");
+    str->append("");
+    str->append("中文abc");
+    str->append("abcdefghijklmnopqrstuvwxyz");
+    columns.emplace_back(str);
+
+    ColumnPtr result = StringFunctions::utf8_length(ctx.get(), columns);
+    ASSERT_EQ(4, result->size());
+
+    auto v = ColumnHelper::cast_to<TYPE_INT>(result);
+    ASSERT_EQ(3, v->get_data()[0]);
+    ASSERT_EQ(0, v->get_data()[1]);
+    ASSERT_EQ(5, v->get_data()[2]);
+    ASSERT_EQ(26, v->get_data()[3]);
+}
+
 PARALLEL_TEST(VecStringFunctionsTest, upperTest) {
     std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
     Columns columns;
@@ -0,0 +1,41 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/current_mem_tracker.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks {
+
+TEST(CurrentMemTrackerTest, batch_consumption) {
+    MemTracker parent(-1, "parent");
+    MemTracker child(-1, "child", &parent);
+    MemTracker* prev = CurrentThread::set_mem_tracker(&child);
+
+    // The small consumptions are counted into the trackers once they add up to 1MB.
+    for (int i = 0; i < 1023; i++) {
+        CurrentMemTracker::consume(1024);
+    }
+    ASSERT_EQ(0, child.consumption());
+    CurrentMemTracker::consume(1024);
+    ASSERT_EQ(1024 * 1024, child.consumption());
+    ASSERT_EQ(1024 * 1024, parent.consumption());
+
+    CurrentMemTracker::release(1024);
+    ASSERT_EQ(1024 * 1024, child.consumption());
+    CurrentThread::mem_tracker_flush();
+    ASSERT_EQ(1023 * 1024, child.consumption());
+
+    // The delta is flushed into the old tracker once it is replaced.
+    CurrentMemTracker::release(1023 * 1024);
+    MemTracker other(-1, "other");
+    ASSERT_EQ(&child, CurrentThread::set_mem_tracker(&other));
+    ASSERT_EQ(0, child.consumption());
+    ASSERT_EQ(0, parent.consumption());
+
+    CurrentMemTracker::consume(100);
+    CurrentThread::set_mem_tracker(prev);
+    ASSERT_EQ(100, other.consumption());
+    other.release(100);
+}
+
+} // namespace starrocks
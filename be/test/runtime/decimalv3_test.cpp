@@ -452,6 +452,35 @@ TEST_F(TestDecimalV3, testDecimalMul) {
     test_decimal_arithmetics(int128_cases, DecimalV3Arithmetics<int128_t, true>::mul);
 }
 
+TEST_F(TestDecimalV3, testDecimalDivRound) {
+    // the rounded quotients of all the signs, of the divisors of 64 bits and 128 bits.
+    int128_t big = static_cast<int128_t>(1) << 100;
+    std::vector<std::tuple<int128_t, int128_t, int128_t>> cases = {
+            {7, 2, 4},
+            {-7, 2, -4},
+            {7, -2, -4},
+            {-7, -2, 4},
+            {5, 3, 2},
+            {4, 3, 1},
+            {-4, 3, -1},
+            {big + 1, 2, big / 2 + 1},
+            {big * 3, big, 3},
+            {big * 3 + big / 2, big, 4},
+            {-(big * 3 + big / 2 - 1), big, -3},
+            {0, big, 0},
+    };
+    for (auto& [a, b, expect] : cases) {
+        int128_t c = 0;
+        DecimalV3Arithmetics<int128_t, true>::div_round(a, b, &c);
+        ASSERT_TRUE(c == expect);
+        int64_t c64 = 0;
+        if (a == static_cast<int64_t>(a) && b == static_cast<int64_t>(b)) {
+            DecimalV3Arithmetics<int64_t, true>::div_round(a, b, &c64);
+            ASSERT_EQ(c64, static_cast<int64_t>(expect));
+        }
+    }
+}
+
 TEST_F(TestDecimalV3, testParseHighScaleDecimalString) {
     std::vector<std::tuple<std::string, std::string>> test_cases = {
             {"0.0000000000000000000000000", "0"},
@@ -0,0 +1,87 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/exchange_compression_policy.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks {
+
+class ExchangeCompressionPolicyTest : public testing::Test {
+protected:
+    // Sample LZ4 by compressing 1000 bytes into 500 bytes in 1ns per byte, and ZSTD into 300 bytes in 5ns per byte,
+    // and the network by |network_ns_per_byte|.
+    static void sample(ExchangeCompressionPolicy* policy, int64_t network_ns_per_byte) {
+        CompressionTypePB type;
+        ASSERT_NE(nullptr, policy->next_codec(&type));
+        ASSERT_EQ(CompressionTypePB::LZ4, type);
+        policy->update_compression(type, 1000, 500, 1000);
+        ASSERT_NE(nullptr, policy->next_codec(&type));
+        ASSERT_EQ(CompressionTypePB::ZSTD, type);
+        policy->update_compression(type, 1000, 300, 5000);
+        policy->update_network(1000, network_ns_per_byte);
+    }
+};
+
+TEST_F(ExchangeCompressionPolicyTest, not_adaptive) {
+    ExchangeCompressionPolicy policy(CompressionTypePB::LZ4, false, true);
+    ASSERT_TRUE(policy.init().ok());
+    for (int i = 0; i < ExchangeCompressionPolicy::kSampleInterval + 1; i++) {
+        CompressionTypePB type;
+        ASSERT_NE(nullptr, policy.next_codec(&type));
+        ASSERT_EQ(CompressionTypePB::LZ4, type);
+    }
+}
+
+TEST_F(ExchangeCompressionPolicyTest, local_destination) {
+    ExchangeCompressionPolicy policy(CompressionTypePB::LZ4, true, true);
+    ASSERT_TRUE(policy.init().ok());
+    CompressionTypePB type;
+    ASSERT_EQ(nullptr, policy.next_codec(&type));
+    ASSERT_EQ(CompressionTypePB::NO_COMPRESSION, type);
+}
+
+TEST_F(ExchangeCompressionPolicyTest, choose_by_cost) {
+    {
+        // The chunks are compressed by the default codec till the network is measured.
+        ExchangeCompressionPolicy policy(CompressionTypePB::LZ4, true, false);
+        ASSERT_TRUE(policy.init().ok());
+        CompressionTypePB type;
+        policy.next_codec(&type);
+        policy.next_codec(&type);
+        policy.next_codec(&type);
+        ASSERT_EQ(CompressionTypePB::LZ4, type);
+    }
+    {
+        // fast network, the compression costs more than it saves
+        ExchangeCompressionPolicy policy(CompressionTypePB::LZ4, true, false);
+        ASSERT_TRUE(policy.init().ok());
+        sample(&policy, 1);
+        ASSERT_EQ(CompressionTypePB::NO_COMPRESSION, policy.chosen_type());
+        CompressionTypePB type;
+        ASSERT_EQ(nullptr, policy.next_codec(&type));
+        ASSERT_EQ(CompressionTypePB::NO_COMPRESSION, type);
+    }
+    {
+        ExchangeCompressionPolicy policy(CompressionTypePB::LZ4, true, false);
+        ASSERT_TRUE(policy.init().ok());
+        sample(&policy, 10);
+        ASSERT_EQ(CompressionTypePB::LZ4, policy.chosen_type());
+    }
+    {
+        // slow network, the better compression saves more
+        ExchangeCompressionPolicy policy(CompressionTypePB::LZ4, true, false);
+        ASSERT_TRUE(policy.init().ok());
+        sample(&policy, 100);
+        ASSERT_EQ(CompressionTypePB::ZSTD, policy.chosen_type());
+        // the candidates are sampled again after kSampleInterval chunks
+        CompressionTypePB type;
+        for (int i = 2; i < ExchangeCompressionPolicy::kSampleInterval; i++) {
+            policy.next_codec(&type);
+            ASSERT_EQ(CompressionTypePB::ZSTD, type);
+        }
+        policy.next_codec(&type);
+        ASSERT_EQ(CompressionTypePB::LZ4, type);
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,123 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/exchange_spill_buffer.h"
+
+#include <butil/iobuf.h>
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "runtime/runtime_state.h"
+#include "runtime/spill_test_env.h"
+
+namespace starrocks {
+
+class ExchangeSpillBufferTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_TRUE(_spill_env.init().ok());
+    }
+
+    // A request of 1 to 3 random chunks serialized like DataStreamSender::serialize_chunk without compression, whose
+    // data are in |attachment|.
+    static PTransmitChunkParams random_request(std::mt19937* rand, int64_t sequence, butil::IOBuf* attachment) {
+        PTransmitChunkParams request;
+        request.set_sequence(sequence);
+        request.set_eos(false);
+        size_t num_chunks = 1 + (*rand)() % 3;
+        for (size_t i = 0; i < num_chunks; i++) {
+            auto keys = vectorized::NullableColumn::create(vectorized::Int32Column::create(),
+                                                           vectorized::NullColumn::create());
+            auto values = vectorized::Int64Column::create();
+            size_t num_rows = (*rand)() % 4096;
+            for (size_t j = 0; j < num_rows; j++) {
+                if ((*rand)() % 10 == 0) {
+                    EXPECT_TRUE(keys->append_nulls(1));
+                } else {
+                    keys->append_datum(vectorized::Datum(static_cast<int32_t>((*rand)())));
+                }
+                values->append(static_cast<int64_t>((*rand)()));
+            }
+            vectorized::Chunk chunk;
+            chunk.append_column(std::move(keys), 0);
+            chunk.append_column(std::move(values), 1);
+
+            ChunkPB* pchunk = request.add_chunks();
+            pchunk->set_compress_type(CompressionTypePB::NO_COMPRESSION);
+            if (i == 0) {
+                chunk.serialize_meta(pchunk);
+            }
+            std::string data(chunk.serialize_size(), '\0');
+            chunk.serialize(reinterpret_cast<uint8_t*>(data.data()));
+            pchunk->set_uncompressed_size(data.size());
+            pchunk->set_data_size(data.size());
+            attachment->append(data);
+        }
+        return request;
+    }
+
+    // Checks the request read from the buffer is the same as the one written, of which only the chunks are spilled.
+    static void check_read(ExchangeSpillBuffer* buffer, const PTransmitChunkParams& expected_request,
+                           const butil::IOBuf& expected_attachment) {
+        ASSERT_FALSE(buffer->empty());
+        PTransmitChunkParams request;
+        request.set_sequence(expected_request.sequence());
+        request.set_eos(false);
+        // The chunks of the request are replaced.
+        request.add_chunks()->set_data_size(1);
+        butil::IOBuf attachment;
+        attachment.append("stale");
+        ASSERT_TRUE(buffer->read(&request, &attachment).ok());
+        ASSERT_EQ(expected_request.SerializeAsString(), request.SerializeAsString());
+        ASSERT_EQ(expected_attachment.to_string(), attachment.to_string());
+    }
+
+    SpillTestEnv _spill_env{"exchange_spill_buffer_test"};
+};
+
+// NOLINTNEXTLINE
+TEST_F(ExchangeSpillBufferTest, test_replay_in_order) {
+    TQueryOptions query_options;
+    RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+    state._exec_env = _spill_env.exec_env();
+    ExchangeSpillBuffer buffer;
+    ASSERT_TRUE(buffer.init(&state, 0).ok());
+    ASSERT_TRUE(buffer.empty());
+
+    // Some of the spilled requests are replayed before the next ones are spilled, like the channel does once the
+    // receiver grants the credit, and all of them are read back at last.
+    std::mt19937 rand(0);
+    std::deque<std::pair<PTransmitChunkParams, butil::IOBuf>> spilled;
+    int64_t spilled_bytes = 0;
+    for (int64_t sequence = 0; sequence < 64; sequence++) {
+        butil::IOBuf attachment;
+        PTransmitChunkParams request = random_request(&rand, sequence, &attachment);
+        PTransmitChunkParams written = request;
+        spilled_bytes += attachment.size();
+        ASSERT_TRUE(buffer.write(&written, attachment).ok());
+        // The chunks are moved out of the request.
+        ASSERT_EQ(0, written.chunks_size());
+        ASSERT_EQ(sequence, written.sequence());
+        spilled.emplace_back(std::move(request), std::move(attachment));
+
+        for (size_t num_replayed = rand() % 3; num_replayed > 0 && !spilled.empty(); num_replayed--) {
+            check_read(&buffer, spilled.front().first, spilled.front().second);
+            spilled.pop_front();
+        }
+    }
+    while (!spilled.empty()) {
+        check_read(&buffer, spilled.front().first, spilled.front().second);
+        spilled.pop_front();
+    }
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_GT(buffer.spilled_bytes(), spilled_bytes);
+}
+
+} // namespace starrocks
@@ -0,0 +1,133 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/fragment_result_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+
+namespace starrocks {
+
+class FragmentResultCacheTest : public testing::Test {
+public:
+    void SetUp() override {
+        _request.params.__set_use_vectorized(true);
+        _request.fragment.__isset.output_sink = true;
+        _request.fragment.output_sink.type = TDataSinkType::DATA_STREAM_SINK;
+
+        TPlanNode agg;
+        agg.node_type = TPlanNodeType::AGGREGATION_NODE;
+        agg.num_children = 1;
+        agg.limit = -1;
+        agg.agg_node.__set_use_streaming_preaggregation(true);
+        agg.agg_node.need_finalize = false;
+        agg.agg_node.aggregate_functions.emplace_back(_function_call("sum"));
+        TPlanNode scan;
+        scan.node_type = TPlanNodeType::OLAP_SCAN_NODE;
+        scan.num_children = 0;
+        scan.limit = -1;
+        _request.fragment.plan.nodes = {agg, scan};
+        _request.fragment.__isset.plan = true;
+
+        for (int64_t tablet_id : {10001, 10002}) {
+            TScanRangeParams range;
+            range.scan_range.__isset.internal_scan_range = true;
+            range.scan_range.internal_scan_range.tablet_id = tablet_id;
+            range.scan_range.internal_scan_range.schema_hash = "1234";
+            range.scan_range.internal_scan_range.version = "5";
+            _scan_ranges.push_back(range);
+        }
+    }
+
+protected:
+    static TExpr _function_call(const std::string& name) {
+        TExprNode node;
+        node.__isset.fn = true;
+        node.fn.name.function_name = name;
+        TExpr expr;
+        expr.nodes.push_back(node);
+        return expr;
+    }
+
+    static FragmentResultCache::EntryPtr _entry(const FragmentResultCache::Probe& probe) {
+        auto entry = std::make_shared<FragmentResultCache::Entry>();
+        entry->tablet_versions = probe.tablet_versions;
+        entry->bytes = 100;
+        return entry;
+    }
+
+    TExecPlanFragmentParams _request;
+    std::vector<TScanRangeParams> _scan_ranges;
+};
+
+TEST_F(FragmentResultCacheTest, disabled) {
+    FragmentResultCache cache(0);
+    ASSERT_FALSE(cache.enabled());
+    auto scan_ranges = _scan_ranges;
+    ASSERT_TRUE(cache.probe(_request, &scan_ranges).key.empty());
+    ASSERT_EQ(2, scan_ranges.size());
+}
+
+TEST_F(FragmentResultCacheTest, not_cacheable) {
+    FragmentResultCache cache(1 << 20);
+    auto scan_ranges = _scan_ranges;
+
+    auto request = _request;
+    request.fragment.plan.nodes[1].limit = 10;
+    ASSERT_TRUE(cache.probe(request, &scan_ranges).key.empty());
+
+    request = _request;
+    request.fragment.plan.nodes[0].agg_node.need_finalize = true;
+    ASSERT_TRUE(cache.probe(request, &scan_ranges).key.empty());
+
+    request = _request;
+    request.fragment.plan.nodes[0].agg_node.aggregate_functions.emplace_back(_function_call("rand"));
+    ASSERT_TRUE(cache.probe(request, &scan_ranges).key.empty());
+
+    ASSERT_EQ(2, scan_ranges.size());
+}
+
+TEST_F(FragmentResultCacheTest, hit) {
+    FragmentResultCache cache(1 << 20);
+    auto scan_ranges = _scan_ranges;
+    auto probe = cache.probe(_request, &scan_ranges);
+    ASSERT_FALSE(probe.key.empty());
+    ASSERT_EQ(nullptr, probe.cached);
+    ASSERT_EQ(2, scan_ranges.size());
+    ASSERT_EQ(1, cache.misses());
+    cache.insert(probe.key, _entry(probe));
+
+    // The tablets are all up to date, so none is scanned.
+    auto hit = cache.probe(_request, &scan_ranges);
+    ASSERT_EQ(probe.key, hit.key);
+    ASSERT_NE(nullptr, hit.cached);
+    ASSERT_TRUE(hit.start_versions.empty());
+    ASSERT_TRUE(scan_ranges.empty());
+    ASSERT_EQ(1, cache.hits());
+
+    // Another time zone is another result.
+    scan_ranges = _scan_ranges;
+    auto request = _request;
+    request.query_globals.__set_time_zone("America/Los_Angeles");
+    ASSERT_EQ(nullptr, cache.probe(request, &scan_ranges).cached);
+    ASSERT_EQ(2, scan_ranges.size());
+}
+
+TEST_F(FragmentResultCacheTest, copy_chunk) {
+    auto column = vectorized::FixedLengthColumn<int32_t>::create();
+    column->append(1);
+    column->append(2);
+    vectorized::Chunk chunk;
+    chunk.append_column(column, 1);
+
+    auto copy = FragmentResultCache::copy_chunk(chunk);
+    ASSERT_EQ(2, copy->num_rows());
+    ASSERT_TRUE(copy->is_slot_exist(1));
+    // The copy doesn't share the columns of the chunk.
+    column->append(3);
+    ASSERT_EQ(2, copy->num_rows());
+    ASSERT_EQ(2, copy->get_column_by_slot_id(1)->get(1).get_int32());
+}
+
+} // namespace starrocks
@@ -0,0 +1,83 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/scan_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+class ScanSchedulerTest : public testing::Test {
+public:
+    void SetUp() override {
+        _max_scanners_per_disk = config::scan_scheduler_max_scanners_per_disk;
+        config::scan_scheduler_max_scanners_per_disk = 4;
+        _big_query.hi = 1;
+        _small_query.hi = 2;
+    }
+    void TearDown() override { config::scan_scheduler_max_scanners_per_disk = _max_scanners_per_disk; }
+
+protected:
+    const DataDir* _disk1 = reinterpret_cast<const DataDir*>(0x10);
+    const DataDir* _disk2 = reinterpret_cast<const DataDir*>(0x20);
+    TUniqueId _big_query;
+    TUniqueId _small_query;
+    int32_t _max_scanners_per_disk = 0;
+};
+
+TEST_F(ScanSchedulerTest, disk_limit) {
+    ScanScheduler scheduler(10);
+    scheduler.register_scan(_big_query);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(scheduler.try_acquire(_big_query, _disk1, false));
+    }
+    // The disk is saturated, but the other disk is not.
+    ASSERT_FALSE(scheduler.try_acquire(_big_query, _disk1, false));
+    ASSERT_TRUE(scheduler.try_acquire(_big_query, _disk2, false));
+    ASSERT_EQ(4, scheduler.num_disk_scanners(_disk1));
+    ASSERT_EQ(1, scheduler.num_disk_scanners(_disk2));
+
+    scheduler.release(_big_query, _disk1);
+    ASSERT_TRUE(scheduler.try_acquire(_big_query, _disk1, false));
+    // Always granted if forced.
+    ASSERT_TRUE(scheduler.try_acquire(_big_query, _disk1, true));
+    ASSERT_EQ(5, scheduler.num_disk_scanners(_disk1));
+    ASSERT_EQ(6, scheduler.num_scanners());
+
+    for (int i = 0; i < 5; i++) {
+        scheduler.release(_big_query, _disk1);
+    }
+    scheduler.release(_big_query, _disk2);
+    ASSERT_EQ(0, scheduler.num_scanners());
+    ASSERT_EQ(0, scheduler.num_disk_scanners(_disk1));
+    scheduler.unregister_scan(_big_query);
+}
+
+TEST_F(ScanSchedulerTest, fair_share) {
+    config::scan_scheduler_max_scanners_per_disk = 100;
+    ScanScheduler scheduler(8);
+    scheduler.register_scan(_big_query);
+    for (int i = 0; i < 8; i++) {
+        ASSERT_TRUE(scheduler.try_acquire(_big_query, _disk1, false));
+    }
+    ASSERT_FALSE(scheduler.try_acquire(_big_query, _disk1, false));
+
+    // The big query holds all the slots, the small one only gets its first slot by force.
+    scheduler.register_scan(_small_query);
+    ASSERT_FALSE(scheduler.try_acquire(_small_query, _disk1, false));
+    ASSERT_TRUE(scheduler.try_acquire(_small_query, _disk1, true));
+
+    // The big query gets no slot beyond its fair share of 4 once it releases them.
+    for (int i = 0; i < 4; i++) {
+        scheduler.release(_big_query, _disk1);
+    }
+    ASSERT_FALSE(scheduler.try_acquire(_big_query, _disk1, false));
+    ASSERT_TRUE(scheduler.try_acquire(_small_query, _disk1, false));
+    ASSERT_TRUE(scheduler.try_acquire(_small_query, _disk1, false));
+    ASSERT_TRUE(scheduler.try_acquire(_small_query, _disk1, false));
+    ASSERT_FALSE(scheduler.try_acquire(_small_query, _disk1, false));
+    ASSERT_EQ(8, scheduler.num_scanners());
+}
+
+} // namespace starrocks
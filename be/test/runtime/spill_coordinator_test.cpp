@@ -0,0 +1,42 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/spill_coordinator.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/mem_tracker.h"
+
+namespace starrocks {
+
+TEST(SpillCoordinatorTest, largest_spills_first) {
+    MemTracker query(1000, "query");
+    MemTracker join(-1, "join", &query);
+    MemTracker agg(-1, "agg", &query);
+    SpillCoordinator coordinator;
+
+    join.consume(600);
+    agg.consume(300);
+    ASSERT_TRUE(coordinator.should_spill(&join));
+    ASSERT_FALSE(coordinator.should_spill(&agg));
+    ASSERT_TRUE(coordinator.should_spill(&join));
+
+    // The join spills its hash table, then the aggregation is the largest one.
+    join.release(500);
+    ASSERT_TRUE(coordinator.should_spill(&agg));
+    ASSERT_FALSE(coordinator.should_spill(&join));
+
+    // The finished ones are no more considered.
+    agg.consume(300);
+    coordinator.finish(&agg);
+    ASSERT_TRUE(coordinator.should_spill(&join));
+
+    // Every operator spills once the limit is exceeded.
+    join.consume(400);
+    ASSERT_TRUE(coordinator.should_spill(&join));
+    ASSERT_TRUE(coordinator.should_spill(&agg));
+
+    join.release(500);
+    agg.release(600);
+}
+
+} // namespace starrocks
@@ -0,0 +1,40 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <string>
+
+#include "common/config.h"
+#include "common/status.h"
+#include "runtime/exec_env.h"
+#include "runtime/tmp_file_mgr.h"
+#include "util/metrics.h"
+
+namespace starrocks {
+
+// The exec env of a test of the spilling, of which the tmp file mgr spills into the scratch directory under the
+// storage root of the test. The other members of the exec env are left unset.
+class SpillTestEnv {
+public:
+    explicit SpillTestEnv(const std::string& name) : _metrics(name) {}
+
+    // Called once in the SetUp of the test.
+    Status init() {
+        RETURN_IF_ERROR(_tmp_file_mgr.init_custom({config::storage_root_path}, false, &_metrics));
+        if (_tmp_file_mgr.num_active_tmp_devices() == 0) {
+            return Status::InternalError("no active tmp device under " + config::storage_root_path);
+        }
+        _exec_env._tmp_file_mgr = &_tmp_file_mgr;
+        return Status::OK();
+    }
+
+    ExecEnv* exec_env() { return &_exec_env; }
+
+private:
+    // Declared before the tmp file mgr, which deregisters its metric once destroyed.
+    MetricRegistry _metrics;
+    TmpFileMgr _tmp_file_mgr;
+    ExecEnv _exec_env;
+};
+
+} // namespace starrocks
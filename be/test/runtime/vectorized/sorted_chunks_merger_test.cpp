@@ -4,10 +4,16 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "column/column_helper.h"
 #include "column/datum_tuple.h"
 #include "exprs/expr_context.h"
 #include "exprs/slot_ref.h"
+#include "util/threadpool.h"
 
 namespace starrocks::vectorized {
 
@@ -15,6 +21,7 @@ class SortedChunksMergerTest : public ::testing::Test {
 public:
     void SetUp() {
         config::vector_chunk_size = 1024;
+        ASSERT_TRUE(ThreadPoolBuilder("merge").set_max_threads(4).set_max_queue_size(0).build(&_thread_pool).ok());
 
         const auto& int_type_desc = TypeDescriptor(TYPE_INT);
         const auto& varchar_type_desc = TypeDescriptor::create_varchar_type(TypeDescriptor::MAX_VARCHAR_LENGTH);
@@ -119,6 +126,7 @@ public:
 
 protected:
     ChunkPtr _chunk_1, _chunk_2, _chunk_3;
+    std::unique_ptr<ThreadPool> _thread_pool;
     std::vector<Expr*> _exprs;
     std::vector<ExprContext*> _sort_exprs;
     std::vector<bool> _is_asc, _is_null_first;
@@ -270,4 +278,116 @@ TEST_F(SortedChunksMergerTest, three_suppliers) {
     }
 }
 
+TEST_F(SortedChunksMergerTest, parallel_three_suppliers) {
+    ChunkSuppliers suppliers;
+    std::vector<ChunkPtr> chunks = {_chunk_1, _chunk_2, _chunk_3};
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto supplier = [&chunks, i](Chunk** cnk) -> Status {
+            if (chunks[i] != nullptr) {
+                ChunkPtr& src_chunk = chunks[i];
+                size_t row_num = src_chunk->num_rows();
+                *cnk = src_chunk->clone_empty_with_slot(row_num).release();
+                for (size_t c = 0; c < src_chunk->num_columns(); ++c) {
+                    (*cnk)->get_column_by_index(c)->append(*(src_chunk->get_column_by_index(c)), 0, row_num);
+                }
+                chunks[i] = nullptr;
+            } else {
+                *cnk = nullptr;
+            }
+            return Status::OK();
+        };
+        suppliers.push_back(supplier);
+    }
+
+    // Two groups, of the 1st and 3rd suppliers and of the 2nd one.
+    ParallelSortedChunksMerger merger;
+    ASSERT_TRUE(merger.init(suppliers, &_sort_exprs, &_is_asc, &_is_null_first, 2, _thread_pool.get()).ok());
+
+    std::vector<int32_t> cust_keys;
+    bool eos = false;
+    while (!eos) {
+        ChunkPtr page;
+        ASSERT_TRUE(merger.get_next(&page, &eos).ok());
+        for (size_t i = 0; !eos && i < page->num_rows(); ++i) {
+            cust_keys.push_back(page->get(i).get(0).get_int32());
+        }
+    }
+
+    std::vector<int32_t> permutation = {71, 70, 69, 54, 4, 56, 55, 49, 41, 16, 52, 58, 24, 12, 2, 6};
+    ASSERT_EQ(permutation, cust_keys);
+}
+
+TEST_F(SortedChunksMergerTest, parallel_close_with_blocked_supplier) {
+    std::mutex lock;
+    std::condition_variable cv;
+    bool closed = false;
+    auto copy_chunk = [](const ChunkPtr& src_chunk) {
+        Chunk* cnk = src_chunk->clone_empty_with_slot(src_chunk->num_rows()).release();
+        cnk->append(*src_chunk);
+        return cnk;
+    };
+    // The 1st supplier keeps returning chunks, so that its group fills up its buffer and blocks.
+    auto endless_supplier = [&](Chunk** cnk) -> Status {
+        *cnk = copy_chunk(_chunk_3);
+        return Status::OK();
+    };
+    // The 2nd one returns a chunk and then blocks until its source is closed, like a sender queue.
+    size_t num_calls = 0;
+    auto blocked_supplier = [&](Chunk** cnk) -> Status {
+        if (num_calls++ == 0) {
+            *cnk = copy_chunk(_chunk_2);
+            return Status::OK();
+        }
+        std::unique_lock<std::mutex> l(lock);
+        cv.wait(l, [&] { return closed; });
+        *cnk = nullptr;
+        return Status::Cancelled("closed");
+    };
+    ChunkSuppliers suppliers = {endless_supplier, blocked_supplier};
+
+    auto merger = std::make_unique<ParallelSortedChunksMerger>();
+    ASSERT_TRUE(merger->init(suppliers, &_sort_exprs, &_is_asc, &_is_null_first, 1, _thread_pool.get()).ok());
+    // Let the groups get blocked.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    std::thread closer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::lock_guard<std::mutex> l(lock);
+        closed = true;
+        cv.notify_all();
+    });
+    // Waits for the blocked supplier to return.
+    merger.reset();
+    closer.join();
+    ASSERT_TRUE(closed);
+    ASSERT_EQ(2, num_calls);
+}
+
+TEST_F(SortedChunksMergerTest, parallel_thread_pool_at_capacity) {
+    std::unique_ptr<ThreadPool> thread_pool;
+    ASSERT_TRUE(ThreadPoolBuilder("merge").set_max_threads(1).set_max_queue_size(0).build(&thread_pool).ok());
+    std::mutex lock;
+    std::condition_variable cv;
+    bool released = false;
+    // The suppliers block until released, so that the task of the first group keeps the only thread of the pool.
+    auto blocked_supplier = [&](Chunk** cnk) -> Status {
+        std::unique_lock<std::mutex> l(lock);
+        cv.wait(l, [&] { return released; });
+        *cnk = nullptr;
+        return Status::OK();
+    };
+    ChunkSuppliers suppliers = {blocked_supplier, blocked_supplier, blocked_supplier};
+
+    // Three groups of one supplier, but the pool only has a thread for one of them.
+    auto merger = std::make_unique<ParallelSortedChunksMerger>();
+    ASSERT_FALSE(merger->init(suppliers, &_sort_exprs, &_is_asc, &_is_null_first, 1, thread_pool.get()).ok());
+    {
+        std::lock_guard<std::mutex> l(lock);
+        released = true;
+        cv.notify_all();
+    }
+    // Waits for the task of the first group only.
+    merger.reset();
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,41 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/compaction_scheduler.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(CompactionSchedulerTest, test_priority) {
+    const int64_t mb = 1024 * 1024;
+    int16_t max_versions = config::tablet_max_versions;
+    config::tablet_max_versions = 1000;
+
+    // Nothing to merge.
+    ASSERT_EQ(0, CompactionScheduler::priority(1, 100 * mb, 10, 100));
+    ASSERT_EQ(0, CompactionScheduler::priority(0, 0, 0, 0));
+
+    // More sorted runs merged per byte first.
+    ASSERT_GT(CompactionScheduler::priority(10, 10 * mb, 10, 0), CompactionScheduler::priority(10, 100 * mb, 10, 0));
+    ASSERT_GT(CompactionScheduler::priority(20, 10 * mb, 20, 0), CompactionScheduler::priority(10, 10 * mb, 10, 0));
+    // The tiny rowsets don't win by the size alone.
+    ASSERT_EQ(CompactionScheduler::priority(10, 1024, 10, 0), CompactionScheduler::priority(10, mb, 10, 0));
+
+    // The hot tablets before the cold ones of the same cost.
+    ASSERT_GT(CompactionScheduler::priority(10, 10 * mb, 10, 50), CompactionScheduler::priority(10, 10 * mb, 10, 0));
+
+    // The tablets about to reject loads before all the others, the nearer to the limit the sooner.
+    ASSERT_FALSE(CompactionScheduler::is_urgent(799));
+    ASSERT_TRUE(CompactionScheduler::is_urgent(800));
+    double urgent = CompactionScheduler::priority(2, 1024 * mb, 900, 0);
+    ASSERT_GT(urgent, CompactionScheduler::kUrgentPriority);
+    ASSERT_GT(urgent, CompactionScheduler::priority(100, mb, 100, 1000));
+    ASSERT_GT(CompactionScheduler::priority(2, mb, 950, 0), urgent);
+
+    config::tablet_max_versions = max_versions;
+}
+
+} // namespace starrocks
@@ -41,4 +41,24 @@ TEST(DelVector, testLoadSave) {
     ASSERT_EQ(dv2.cardinality(), dels.size());
 };
 
+// NOLINTNEXTLINE
+TEST(DelVector, testRunsCompressed) {
+    DelVector dv;
+    dv.set_empty();
+    std::vector<uint32_t> dels;
+    for (uint32_t i = 0; i < 10000; i++) {
+        dels.push_back(i + 100);
+    }
+    std::shared_ptr<DelVector> ndv;
+    dv.add_dels_as_new_version(dels, 2, &ndv);
+    ASSERT_EQ(dels.size(), ndv->cardinality());
+    // a run container instead of an array of 10000 uint16
+    ASSERT_LT(ndv->memory_usage(), 100);
+    std::string raw = ndv->save();
+    ASSERT_LT(raw.size(), 100);
+    DelVector dv2;
+    ASSERT_TRUE(dv2.load(2, raw.data(), raw.size()).ok());
+    ASSERT_EQ(dels.size(), dv2.cardinality());
+};
+
 } // namespace starrocks
@@ -208,4 +208,44 @@ TEST_F(TestHll, InvalidPtr) {
     }
 }
 
+TEST_F(TestHll, SparseMerge) {
+    uint8_t buf[HLL_REGISTERS_COUNT + 1];
+    HyperLogLog full_hll;
+    std::vector<uint64_t> hash_values;
+    for (int i = 0; i < 2048; ++i) {
+        full_hll.update(hash(i));
+        hash_values.push_back(hash(i));
+    }
+
+    // sparse [0, 1024) merges sparse [1024, 2048) and stays sparse
+    HyperLogLog sparse_hll;
+    for (int i = 0; i < 2; ++i) {
+        HyperLogLog hll;
+        for (int j = 0; j < 1024; ++j) {
+            hll.update(hash(i * 1024 + j));
+        }
+        int len = hll.serialize(buf);
+        sparse_hll.merge(HyperLogLog(Slice((char*)buf, len)));
+    }
+    ASSERT_EQ(full_hll.estimate_cardinality(), sparse_hll.estimate_cardinality());
+    size_t len = sparse_hll.serialize(buf);
+    ASSERT_EQ(HLL_DATA_SPRASE, buf[0]);
+    ASSERT_EQ(len, sparse_hll.max_serialized_size());
+    ASSERT_EQ(full_hll.estimate_cardinality(), HyperLogLog(Slice((char*)buf, len)).estimate_cardinality());
+
+    // merge explicit into sparse
+    HyperLogLog explicit_hll;
+    for (int i = 2048; i < 2148; ++i) {
+        explicit_hll.update(hash(i));
+        full_hll.update(hash(i));
+        hash_values.push_back(hash(i));
+    }
+    sparse_hll.merge(explicit_hll);
+    ASSERT_EQ(full_hll.estimate_cardinality(), sparse_hll.estimate_cardinality());
+
+    HyperLogLog batch_hll;
+    batch_hll.update_batch(hash_values.data(), hash_values.size());
+    ASSERT_EQ(full_hll.estimate_cardinality(), batch_hll.estimate_cardinality());
+}
+
 } // namespace starrocks
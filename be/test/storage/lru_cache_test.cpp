@@ -257,6 +257,67 @@ TEST_F(CacheTest, Usage) {
     ASSERT_EQ(950, cache.get_usage());
 }
 
+TEST_F(CacheTest, SlruScanResistant) {
+    LRUCache cache;
+    cache.set_capacity(1000);
+    cache.set_eviction_policy(CacheEvictionPolicy::SLRU);
+
+    CacheKey hot("hot");
+    uint32_t hash = hot.hash(hot.data(), hot.size(), 0);
+    insert_LRUCache(cache, hot, 100, CachePriority::NORMAL);
+    ASSERT_EQ(0, cache.get_protected_usage());
+    cache.release(cache.lookup(hot, hash));
+    ASSERT_EQ(100, cache.get_protected_usage());
+
+    // A scan of the entries read once only evicts the probationary entries.
+    std::vector<std::string> keys;
+    for (int i = 0; i < 100; i++) {
+        keys.push_back(std::to_string(i));
+        insert_LRUCache(cache, CacheKey(keys.back()), 100, CachePriority::NORMAL);
+    }
+    ASSERT_EQ(1000, cache.get_usage());
+    auto* handle = cache.lookup(hot, hash);
+    ASSERT_NE(nullptr, handle);
+    cache.release(handle);
+    CacheKey scanned(keys.front());
+    ASSERT_EQ(nullptr, cache.lookup(scanned, scanned.hash(scanned.data(), scanned.size(), 0)));
+}
+
+TEST_F(CacheTest, SlruProtectedCapacity) {
+    LRUCache cache;
+    cache.set_capacity(1000);
+    cache.set_eviction_policy(CacheEvictionPolicy::SLRU);
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < 9; i++) {
+        keys.push_back(std::to_string(i));
+        CacheKey key(keys.back());
+        insert_LRUCache(cache, key, 100, CachePriority::NORMAL);
+        cache.release(cache.lookup(key, key.hash(key.data(), key.size(), 0)));
+    }
+    // The oldest protected entry is moved back to the probationary segment, and evicted first.
+    ASSERT_EQ(kSlruProtectedPercent * 10, cache.get_protected_usage());
+    ASSERT_EQ(900, cache.get_usage());
+    insert_LRUCache(cache, CacheKey("more"), 200, CachePriority::NORMAL);
+    CacheKey oldest(keys.front());
+    ASSERT_EQ(nullptr, cache.lookup(oldest, oldest.hash(oldest.data(), oldest.size(), 0)));
+    ASSERT_EQ(1000, cache.get_usage());
+}
+
+TEST_F(CacheTest, NumShards) {
+    ASSERT_EQ(kNumShards, cache_num_shards_by_cores(kNumShards * kMinShardCapacity));
+    int num_shards = cache_num_shards_by_cores(kMaxNumShards * kMinShardCapacity);
+    ASSERT_GE(num_shards, kNumShards);
+    ASSERT_LE(num_shards, kMaxNumShards);
+    ASSERT_EQ(0, num_shards & (num_shards - 1));
+
+    std::unique_ptr<Cache> cache(new_lru_cache(64 * 100, CacheEvictionPolicy::SLRU, 64));
+    rapidjson::Document document;
+    document.SetArray();
+    cache->get_cache_status(&document);
+    ASSERT_EQ(64, document.Size());
+}
+
 TEST_F(CacheTest, HeavyEntries) {
     // Add a bunch of light and heavy entries and then count the combined
     // size of items still in the cache, which must be approximately the
@@ -23,9 +23,12 @@
 
 #include <gtest/gtest.h>
 
+#include "column/chunk.h"
 #include "storage/memory/mem_tablet_scan.h"
 #include "storage/memory/write_txn.h"
 #include "storage/tablet_meta.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/column_predicate.h"
 
 namespace starrocks {
 namespace memory {
@@ -37,13 +40,8 @@ struct TData {
     int8_t city;
 };
 
-TEST(MemTablet, writescan) {
-    const int num_insert = 20000;
-    const int insert_per_write = 5000;
-    const int num_update = 100;
-    const int update_time = 3;
-    scoped_refptr<Schema> sc;
-    ASSERT_TRUE(Schema::create("id int,uv int,pv int,city tinyint null", &sc).ok());
+static void create_tablet(const scoped_refptr<Schema>& sc, MemTracker* mem_tracker,
+                          std::shared_ptr<MemTablet>* tablet) {
     std::unordered_map<uint32_t, uint32_t> col_idx_to_unique_id;
     std::vector<TColumn> columns(sc->num_columns());
     for (size_t i = 0; i < sc->num_columns(); i++) {
@@ -70,12 +68,24 @@ TEST(MemTablet, writescan) {
     tschema.__set_columns(columns);
     tschema.__set_is_in_memory(false);
     tschema.__set_schema_hash(1);
-    std::unique_ptr<MemTracker> mem_tracker = std::make_unique<MemTracker>();
     TabletMetaSharedPtr tablet_meta(new TabletMeta(
-            mem_tracker.get(), 1, 1, 1, 1, 1, tschema, static_cast<uint32_t>(sc->cid_size()), col_idx_to_unique_id,
+            mem_tracker, 1, 1, 1, 1, 1, tschema, static_cast<uint32_t>(sc->cid_size()), col_idx_to_unique_id,
             TabletUid(1, 1), TTabletType::TABLET_TYPE_MEMORY, RowsetTypePB::BETA_ROWSET));
-    std::shared_ptr<MemTablet> tablet = MemTablet::create_tablet_from_meta(mem_tracker.get(), tablet_meta, nullptr);
-    ASSERT_TRUE(tablet->init().ok());
+    *tablet = MemTablet::create_tablet_from_meta(mem_tracker, tablet_meta, nullptr);
+    ASSERT_TRUE((*tablet)->init().ok());
+}
+
+TEST(MemTablet, writescan) {
+    const int num_insert = 20000;
+    const int insert_per_write = 5000;
+    const int num_update = 100;
+    const int update_time = 3;
+    scoped_refptr<Schema> sc;
+    ASSERT_TRUE(Schema::create("id int,uv int,pv int,city tinyint null", &sc).ok());
+    std::unique_ptr<MemTracker> mem_tracker = std::make_unique<MemTracker>();
+    std::shared_ptr<MemTablet> tablet;
+    create_tablet(sc, mem_tracker.get(), &tablet);
+    ASSERT_NE(nullptr, tablet);
 
     uint64_t cur_version = 0;
     std::vector<TData> alldata(num_insert);
@@ -187,5 +197,97 @@ TEST(MemTablet, writescan) {
     }
 }
 
+TEST(MemTablet, chunk_scan) {
+    const int block_size = Column::BLOCK_SIZE;
+    const int num_insert = 2 * block_size + 10000;
+    scoped_refptr<Schema> sc;
+    ASSERT_TRUE(Schema::create("id int,uv int,pv int,city tinyint null", &sc).ok());
+    std::unique_ptr<MemTracker> mem_tracker = std::make_unique<MemTracker>();
+    std::shared_ptr<MemTablet> tablet;
+    create_tablet(sc, mem_tracker.get(), &tablet);
+    ASSERT_NE(nullptr, tablet);
+
+    // pv increases with id, so that the blocks have disjoint ranges of pv.
+    std::unique_ptr<WriteTxn> wtx;
+    ASSERT_TRUE(tablet->create_write_txn(&wtx).ok());
+    PartialRowWriter writer(wtx->get_schema_ptr());
+    ASSERT_TRUE(writer.start_batch(num_insert + 1, num_insert * 32).ok());
+    for (int i = 0; i < num_insert; i++) {
+        ASSERT_TRUE(writer.start_row().ok());
+        int uv = 1;
+        int8_t city = i % 100;
+        ASSERT_TRUE(writer.set("id", &i).ok());
+        ASSERT_TRUE(writer.set("uv", &uv).ok());
+        ASSERT_TRUE(writer.set("pv", &i).ok());
+        ASSERT_TRUE(writer.set("city", i % 2 == 0 ? nullptr : &city).ok());
+        ASSERT_TRUE(writer.end_row().ok());
+    }
+    std::vector<uint8_t> wtxn_buff;
+    ASSERT_TRUE(writer.finish_batch(&wtxn_buff).ok());
+    ASSERT_TRUE(wtx->new_batch()->load(std::move(wtxn_buff)).ok());
+    ASSERT_TRUE(tablet->commit_write_txn(wtx.get(), 1).ok());
+
+    // full scan
+    {
+        std::unique_ptr<ScanSpec> scanspec(new ScanSpec({"id", "city"}));
+        std::unique_ptr<MemTabletScan> scan;
+        ASSERT_TRUE(tablet->scan(&scanspec, &scan).ok());
+        auto chunk = vectorized::ChunkHelper::new_chunk(scan->chunk_schema(), config::vector_chunk_size);
+        int num_rows = 0;
+        while (true) {
+            chunk->reset();
+            Status st = scan->next_chunk(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok());
+            ASSERT_LE(chunk->num_rows(), (size_t)config::vector_chunk_size);
+            for (size_t i = 0; i < chunk->num_rows(); i++, num_rows++) {
+                ASSERT_EQ(num_rows, chunk->get_column_by_index(0)->get(i).get_int32());
+                vectorized::Datum city = chunk->get_column_by_index(1)->get(i);
+                if (num_rows % 2 == 0) {
+                    ASSERT_TRUE(city.is_null());
+                } else {
+                    ASSERT_EQ(num_rows % 100, city.get_int8());
+                }
+            }
+        }
+        ASSERT_EQ(num_insert, num_rows);
+        ASSERT_EQ(0, scan->num_blocks_filtered());
+    }
+
+    // pv >= 2 * BLOCK_SIZE + 100 and city is not null
+    {
+        std::string operand = std::to_string(2 * block_size + 100);
+        std::unique_ptr<vectorized::ColumnPredicate> pv_ge(
+                vectorized::new_column_ge_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 1, operand));
+        std::unique_ptr<vectorized::ColumnPredicate> city_not_null(
+                vectorized::new_column_null_predicate(get_type_info(OLAP_FIELD_TYPE_TINYINT), 0, false));
+        std::unique_ptr<ScanSpec> scanspec(new ScanSpec({"city", "pv"}));
+        scanspec->add_predicate(pv_ge.get());
+        scanspec->add_predicate(city_not_null.get());
+        std::unique_ptr<MemTabletScan> scan;
+        ASSERT_TRUE(tablet->scan(&scanspec, &scan).ok());
+        auto chunk = vectorized::ChunkHelper::new_chunk(scan->chunk_schema(), config::vector_chunk_size);
+        int num_rows = 0;
+        while (true) {
+            chunk->reset();
+            Status st = scan->next_chunk(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok());
+            for (size_t i = 0; i < chunk->num_rows(); i++, num_rows++) {
+                int pv = chunk->get_column_by_index(1)->get(i).get_int32();
+                ASSERT_EQ(2 * block_size + 101 + 2 * num_rows, pv);
+                ASSERT_EQ(pv % 100, chunk->get_column_by_index(0)->get(i).get_int8());
+            }
+        }
+        ASSERT_EQ((10000 - 100) / 2, num_rows);
+        // The first two blocks are skipped by the max of pv.
+        ASSERT_EQ(2, scan->num_blocks_filtered());
+    }
+}
+
 } // namespace memory
 } // namespace starrocks
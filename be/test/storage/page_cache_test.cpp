@@ -23,6 +23,7 @@
 
 #include <gtest/gtest.h>
 
+#include "common/config.h"
 #include "runtime/mem_tracker.h"
 
 namespace starrocks {
@@ -38,10 +39,14 @@ private:
 
 // NOLINTNEXTLINE
 TEST_F(StoragePageCacheTest, normal) {
+    config::storage_cache_scan_resistant = false;
     StoragePageCache cache(_mem_tracker.get(), kNumShards * 2048);
+    config::storage_cache_scan_resistant = true;
 
-    StoragePageCache::CacheKey key("abc", 0);
-    StoragePageCache::CacheKey memory_key("mem", 0);
+    StoragePageCache::CacheKey key(1, 0);
+    StoragePageCache::CacheKey memory_key(2, 0);
+    int64_t hit_count = StoragePageCache::hit_count();
+    int64_t miss_count = StoragePageCache::miss_count();
 
     {
         // insert normal page
@@ -57,6 +62,13 @@ TEST_F(StoragePageCacheTest, normal) {
         ASSERT_EQ(buf, handle.data().data);
     }
 
+    {
+        // replace the normal page, which is not an eviction
+        PageCacheHandle handle;
+        cache.insert(key, Slice(new char[1024], 1024), &handle, false);
+        ASSERT_EQ(0, cache.evict_count());
+    }
+
     {
         // insert in_memory page
         char* buf = new char[1024];
@@ -72,7 +84,7 @@ TEST_F(StoragePageCacheTest, normal) {
 
     // put too many page to eliminate first page
     for (int i = 0; i < 10 * kNumShards; ++i) {
-        StoragePageCache::CacheKey key("bcd", i);
+        StoragePageCache::CacheKey key(3, i);
         PageCacheHandle handle;
         Slice data(new char[1024], 1024);
         cache.insert(key, data, &handle, false);
@@ -81,7 +93,7 @@ TEST_F(StoragePageCacheTest, normal) {
     // cache miss
     {
         PageCacheHandle handle;
-        StoragePageCache::CacheKey miss_key("abc", 1);
+        StoragePageCache::CacheKey miss_key(1, 1);
         auto found = cache.lookup(miss_key, &handle);
         ASSERT_FALSE(found);
     }
@@ -92,6 +104,48 @@ TEST_F(StoragePageCacheTest, normal) {
         auto found = cache.lookup(key, &handle);
         ASSERT_FALSE(found);
     }
+
+    ASSERT_EQ(hit_count + 2, StoragePageCache::hit_count());
+    ASSERT_EQ(miss_count + 2, StoragePageCache::miss_count());
+    ASSERT_LT(0, cache.evict_count());
+}
+
+// NOLINTNEXTLINE
+TEST_F(StoragePageCacheTest, scan_resistant) {
+    StoragePageCache cache(_mem_tracker.get(), kNumShards * 2048);
+
+    StoragePageCache::CacheKey key(1, 0);
+    {
+        PageCacheHandle handle;
+        cache.insert(key, Slice(new char[1024], 1024), &handle, false);
+        ASSERT_TRUE(cache.lookup(key, &handle));
+    }
+
+    // A scan of many pages read once.
+    for (int i = 0; i < 10 * kNumShards; ++i) {
+        StoragePageCache::CacheKey key(2, i);
+        PageCacheHandle handle;
+        cache.insert(key, Slice(new char[1024], 1024), &handle, false);
+    }
+
+    // The page read again is still cached, but not the first pages of the scan.
+    {
+        PageCacheHandle handle;
+        ASSERT_TRUE(cache.lookup(key, &handle));
+        ASSERT_FALSE(cache.lookup(StoragePageCache::CacheKey(2, 0), &handle));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(StoragePageCacheTest, cache_key) {
+    uint64_t file_id = StoragePageCache::new_file_id();
+    ASSERT_NE(file_id, StoragePageCache::new_file_id());
+
+    StoragePageCache::CacheKey key(file_id, 1);
+    ASSERT_EQ(sizeof(uint64_t) + sizeof(int64_t), key.encode().size());
+    ASSERT_EQ(key.encode(), StoragePageCache::CacheKey(file_id, 1).encode());
+    ASSERT_NE(key.encode(), StoragePageCache::CacheKey(file_id + 1, 1).encode());
+    ASSERT_NE(key.encode(), StoragePageCache::CacheKey(file_id, 2).encode());
 }
 
 } // namespace starrocks
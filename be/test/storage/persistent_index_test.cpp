@@ -0,0 +1,177 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/persistent_index.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "storage/tablet_updates.h"
+#include "util/defer_op.h"
+#include "util/file_utils.h"
+
+namespace starrocks {
+
+class PersistentIndexTest : public testing::Test {
+public:
+    void SetUp() override {
+        _dir = "./ut_dir/persistent_index_test";
+        FileUtils::remove_all(_dir);
+        FileUtils::create_dir(_dir);
+    }
+
+    void TearDown() override { FileUtils::remove_all(_dir); }
+
+protected:
+    static std::vector<Slice> key_slices(const std::vector<int64_t>& keys) {
+        std::vector<Slice> slices;
+        for (const int64_t& key : keys) {
+            slices.emplace_back(reinterpret_cast<const uint8_t*>(&key), sizeof(key));
+        }
+        return slices;
+    }
+
+    static std::vector<uint64_t> get(const PersistentIndex& index, const std::vector<int64_t>& keys) {
+        auto slices = key_slices(keys);
+        std::vector<uint64_t> values(keys.size());
+        EXPECT_TRUE(index.get(keys.size(), slices.data(), values.data()).ok());
+        return values;
+    }
+
+    std::string _dir;
+};
+
+TEST_F(PersistentIndexTest, test_commit_and_load) {
+    const int N = 1000;
+    std::vector<int64_t> keys(N);
+    std::vector<uint64_t> values(N);
+    for (int i = 0; i < N; i++) {
+        keys[i] = i;
+        values[i] = i;
+    }
+    auto slices = key_slices(keys);
+    {
+        PersistentIndex index(_dir);
+        ASSERT_TRUE(index.load(EditVersion(1, 0)).is_not_found());
+        ASSERT_TRUE(index.insert(N, slices.data(), values.data()).ok());
+        ASSERT_FALSE(index.insert(1, slices.data(), values.data()).ok());
+        ASSERT_TRUE(index.commit(EditVersion(1, 0)).ok());
+
+        // upsert the even keys into rssid 1, erase the keys in [900, 1000)
+        std::vector<int64_t> even_keys;
+        std::vector<uint64_t> even_values;
+        for (int i = 0; i < N; i += 2) {
+            even_keys.push_back(i);
+            even_values.push_back((1UL << 32) + i);
+        }
+        auto even_slices = key_slices(even_keys);
+        std::vector<uint64_t> old_values(even_keys.size());
+        ASSERT_TRUE(index.upsert(even_keys.size(), even_slices.data(), even_values.data(), old_values.data()).ok());
+        for (size_t i = 0; i < even_keys.size(); i++) {
+            ASSERT_EQ(even_keys[i], old_values[i]);
+        }
+        std::vector<uint64_t> erased(100);
+        ASSERT_TRUE(index.erase(100, slices.data() + 900, erased.data()).ok());
+        ASSERT_EQ(900, index.size());
+        ASSERT_TRUE(index.commit(EditVersion(2, 0)).ok());
+    }
+    PersistentIndex index(_dir);
+    ASSERT_TRUE(index.load(EditVersion(3, 0)).is_not_found());
+    ASSERT_TRUE(index.load(EditVersion(2, 0)).ok());
+    ASSERT_EQ(900, index.size());
+    auto got = get(index, keys);
+    for (int i = 0; i < N; i++) {
+        if (i >= 900) {
+            ASSERT_EQ(PersistentIndex::NullValue, got[i]);
+        } else if (i % 2 == 0) {
+            ASSERT_EQ((1UL << 32) + i, got[i]);
+        } else {
+            ASSERT_EQ(i, got[i]);
+        }
+    }
+}
+
+TEST_F(PersistentIndexTest, test_merge_into_l1) {
+    int64_t old_l0_max_mem_usage = config::persistent_index_l0_max_mem_usage;
+    DeferOp restore([&] { config::persistent_index_l0_max_mem_usage = old_l0_max_mem_usage; });
+    // every commit merges L0 into L1
+    config::persistent_index_l0_max_mem_usage = 0;
+
+    const int N = 20000;
+    std::vector<int64_t> keys(N);
+    std::vector<uint64_t> values(N);
+    for (int i = 0; i < N; i++) {
+        keys[i] = i * 3;
+        values[i] = i;
+    }
+    auto slices = key_slices(keys);
+    {
+        PersistentIndex index(_dir);
+        ASSERT_TRUE(index.insert(N, slices.data(), values.data()).ok());
+        ASSERT_TRUE(index.commit(EditVersion(1, 0)).ok());
+        ASSERT_LT(index.memory_usage(), N * sizeof(int64_t));
+
+        // compaction: replace the keys of rssid 0 into rssid 2, except the first 100 ones of a stale source rssid
+        std::vector<uint64_t> new_values(N);
+        std::vector<uint32_t> src_rssids(N, 0);
+        for (int i = 0; i < N; i++) {
+            new_values[i] = (2UL << 32) + i;
+            if (i < 100) {
+                src_rssids[i] = 1;
+            }
+        }
+        std::vector<uint32_t> failed;
+        ASSERT_TRUE(index.try_replace(N, slices.data(), new_values.data(), src_rssids.data(), &failed).ok());
+        ASSERT_EQ(100, failed.size());
+        ASSERT_EQ(99, failed.back());
+
+        // a key missing from L1 between two keys of it
+        int64_t missing = 1;
+        std::vector<uint64_t> got = get(index, {missing});
+        ASSERT_EQ(PersistentIndex::NullValue, got[0]);
+        std::vector<uint64_t> erased(N / 2);
+        ASSERT_TRUE(index.erase(N / 2, slices.data() + N / 2, erased.data()).ok());
+        ASSERT_EQ((2UL << 32) + N / 2, erased[0]);
+        ASSERT_TRUE(index.commit(EditVersion(1, 1)).ok());
+        ASSERT_EQ(N / 2, index.size());
+    }
+    PersistentIndex index(_dir);
+    ASSERT_TRUE(index.load(EditVersion(1, 1)).ok());
+    ASSERT_EQ(N / 2, index.size());
+    auto got = get(index, keys);
+    for (int i = 0; i < N; i++) {
+        if (i >= N / 2) {
+            ASSERT_EQ(PersistentIndex::NullValue, got[i]);
+        } else if (i < 100) {
+            ASSERT_EQ(i, got[i]);
+        } else {
+            ASSERT_EQ((2UL << 32) + i, got[i]);
+        }
+    }
+}
+
+TEST_F(PersistentIndexTest, test_load_drops_uncommitted_versions) {
+    std::vector<int64_t> keys{1, 2, 3};
+    std::vector<uint64_t> values{1, 2, 3};
+    std::vector<uint64_t> old_values(3);
+    auto slices = key_slices(keys);
+    {
+        PersistentIndex index(_dir);
+        ASSERT_TRUE(index.upsert(3, slices.data(), values.data(), old_values.data()).ok());
+        ASSERT_TRUE(index.commit(EditVersion(1, 0)).ok());
+        values = {11, 12, 13};
+        ASSERT_TRUE(index.upsert(3, slices.data(), values.data(), old_values.data()).ok());
+        ASSERT_TRUE(index.commit(EditVersion(2, 0)).ok());
+    }
+    {
+        // the meta of version 2 is not durable, the tablet is at version 1
+        PersistentIndex index(_dir);
+        ASSERT_TRUE(index.load(EditVersion(1, 0)).ok());
+        ASSERT_EQ(std::vector<uint64_t>({1, 2, 3}), get(index, keys));
+    }
+    PersistentIndex index(_dir);
+    ASSERT_TRUE(index.load(EditVersion(2, 0)).is_not_found());
+    ASSERT_TRUE(index.reset().ok());
+    ASSERT_TRUE(index.load(EditVersion(1, 0)).is_not_found());
+}
+
+} // namespace starrocks
@@ -4,12 +4,16 @@
 
 #include <gtest/gtest.h>
 
+#include <functional>
+
+#include "column/binary_column.h"
 #include "column/fixed_length_column.h"
 #include "column/schema.h"
 #include "gutil/strings/substitute.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "testutil/parallel_test.h"
+#include "util/threadpool.h"
 
 using namespace starrocks::vectorized;
 
@@ -246,6 +250,72 @@ PARALLEL_TEST(PrimaryIndexTest, test_composite_key) {
     ASSERT_EQ(deletes[1].size(), kSegmentSize);
 }
 
+// Upserts and erases the keys of a rowset by shards concurrently, which must be the same as by the apply thread alone.
+// make_keys(begin, end, step) returns the keys of the integers in [begin, end) by step.
+static void test_upsert_rowset_concurrently(
+        const vectorized::Schema& schema,
+        const std::function<std::unique_ptr<vectorized::Column>(int64_t, int64_t, int64_t)>& make_keys) {
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_TRUE(ThreadPoolBuilder("test_upsert_rowset").set_max_threads(4).build(&pool).ok());
+
+    // segment 1 upserts the keys upserted by segment 0 again, and the new ones
+    std::vector<std::unique_ptr<vectorized::Column>> upserts;
+    upserts.emplace_back(make_keys(0, 100000, 2));
+    upserts.emplace_back(make_keys(0, 150000, 4));
+    upserts[1]->append(*make_keys(100001, 150000, 4), 0, 12500);
+    std::vector<std::unique_ptr<vectorized::Column>> deletes;
+    deletes.emplace_back(make_keys(90000, 100000, 1));
+
+    PrimaryIndex::DeletesMap expected_deletes;
+    PrimaryIndex::DeletesMap actual_deletes;
+    auto expected = TEST_create_primary_index(schema);
+    auto actual = TEST_create_primary_index(schema);
+    for (auto& index : {expected.get(), actual.get()}) {
+        ASSERT_TRUE(index->insert(0, 0, *make_keys(0, 100000, 1)).ok());
+    }
+    ASSERT_TRUE(expected->upsert_rowset(1, upserts, deletes, nullptr, &expected_deletes).ok());
+    ASSERT_TRUE(actual->upsert_rowset(1, upserts, deletes, pool.get(), &actual_deletes).ok());
+    for (auto& [rssid, rowids] : expected_deletes) {
+        std::sort(rowids.begin(), rowids.end());
+    }
+    ASSERT_EQ(expected_deletes, actual_deletes);
+    ASSERT_EQ(expected->size(), actual->size());
+
+    auto all_keys = make_keys(0, 150000, 1);
+    std::vector<uint64_t> expected_rowids;
+    std::vector<uint64_t> actual_rowids;
+    ASSERT_TRUE(expected->get(*all_keys, &expected_rowids).ok());
+    ASSERT_TRUE(actual->get(*all_keys, &actual_rowids).ok());
+    ASSERT_EQ(expected_rowids, actual_rowids);
+}
+
+PARALLEL_TEST(PrimaryIndexTest, test_upsert_rowset_concurrently) {
+    auto f = std::make_shared<vectorized::Field>(0, "c0", OLAP_FIELD_TYPE_BIGINT, false);
+    f->set_is_key(true);
+    auto schema = std::make_shared<vectorized::Schema>(Fields{f});
+    test_upsert_rowset_concurrently(*schema, [](int64_t begin, int64_t end, int64_t step) {
+        auto col = Int64Column::create_mutable();
+        for (int64_t k = begin; k < end; k += step) {
+            col->append(k);
+        }
+        return std::unique_ptr<vectorized::Column>(std::move(col));
+    });
+}
+
+PARALLEL_TEST(PrimaryIndexTest, test_upsert_varchar_rowset_concurrently) {
+    auto f = std::make_shared<vectorized::Field>(0, "c0", OLAP_FIELD_TYPE_VARCHAR, false);
+    f->set_is_key(true);
+    auto schema = std::make_shared<vectorized::Schema>(Fields{f});
+    // longer than any fixed size slice key, so the keys are kept in the string map
+    test_upsert_rowset_concurrently(*schema, [](int64_t begin, int64_t end, int64_t step) {
+        auto col = BinaryColumn::create_mutable();
+        for (int64_t k = begin; k < end; k += step) {
+            col->append(strings::Substitute("long_varchar_primary_key_of_the_concurrent_upsert_$0", k));
+        }
+        return std::unique_ptr<vectorized::Column>(std::move(col));
+    });
+}
+
 // TODO: test composite primary key
 
 } // namespace starrocks
@@ -18,6 +18,8 @@
 // KIND, either express or implied.  See the License for the
 // specific language governing permissions and limitations
 // under the License.
+#include <array>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -29,6 +31,7 @@
 #include "runtime/mem_tracker.h"
 #include "storage/comparison_predicate.h"
 #include "storage/data_dir.h"
+#include "storage/del_vector.h"
 #include "storage/row_block.h"
 #include "storage/row_cursor.h"
 #include "storage/rowset/beta_rowset_reader.h"
@@ -42,8 +45,10 @@
 #include "storage/tablet_schema.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/column_predicate.h"
+#include "storage/vectorized/rowid_range_option.h"
 #include "util/defer_op.h"
 #include "util/file_utils.h"
+#include "util/threadpool.h"
 
 using std::string;
 
@@ -95,10 +100,11 @@ protected:
             ASSERT_TRUE(FileUtils::remove_all(config::storage_root_path).ok());
         }
         StoragePageCache::release_global_cache();
+        _segment_mem_tracker.release(_segment_mem_tracker.consumption());
     }
 
     // (k1 int, k2 varchar(20), k3 int) duplicated key (k1, k2)
-    void create_tablet_schema(TabletSchema* tablet_schema) {
+    void create_tablet_schema(TabletSchema* tablet_schema, bool k2_bitmap_index = false) {
         TabletSchemaPB tablet_schema_pb;
         tablet_schema_pb.set_keys_type(DUP_KEYS);
         tablet_schema_pb.set_num_short_key_columns(2);
@@ -126,6 +132,7 @@ protected:
         column_2->set_is_key(true);
         column_2->set_is_nullable(true);
         column_2->set_is_bf_column(false);
+        column_2->set_has_bitmap_index(k2_bitmap_index);
 
         ColumnPB* column_3 = tablet_schema_pb.add_column();
         column_3->set_unique_id(3);
@@ -206,7 +213,77 @@ protected:
         ASSERT_EQ(OLAP_SUCCESS, s);
     }
 
+    // The (k1, k2, v1) of a row given its row number.
+    using RowValues = std::function<std::array<int32_t, 3>(uint32_t)>;
+
+    static vectorized::ChunkPtr new_chunk(const TabletSchema& tablet_schema, uint32_t first_row, uint32_t num_rows,
+                                          const RowValues& row_values) {
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+        auto& cols = chunk->columns();
+        for (uint32_t i = first_row; i < first_row + num_rows; i++) {
+            auto values = row_values(i);
+            for (size_t j = 0; j < values.size(); j++) {
+                cols[j]->append_datum(vectorized::Datum(values[j]));
+            }
+        }
+        return chunk;
+    }
+
+    // Writes every chunk into a segment of its own.
+    void write_rowset(const TabletSchema& tablet_schema, const std::vector<vectorized::ChunkPtr>& chunks,
+                      RowsetSharedPtr* rowset) {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(writer_context, &rowset_writer));
+        for (const auto& chunk : chunks) {
+            rowset_writer->add_chunk(*chunk);
+            ASSERT_EQ(OLAP_SUCCESS, rowset_writer->flush());
+        }
+        *rowset = rowset_writer->build();
+        ASSERT_TRUE(*rowset != nullptr);
+        ASSERT_EQ(static_cast<int64_t>(chunks.size()), (*rowset)->rowset_meta()->num_segments());
+    }
+
+    // Writes the chunk into a rowset of one segment, which is opened to be read by the segment iterator.
+    void write_and_open_segment(const TabletSchema& tablet_schema, const vectorized::ChunkPtr& chunk,
+                                std::shared_ptr<segment_v2::Segment>* segment) {
+        RowsetSharedPtr rowset;
+        write_rowset(tablet_schema, {chunk}, &rowset);
+        ASSERT_TRUE(rowset != nullptr);
+        std::string segment_file = BetaRowset::segment_file_path(rowset->rowset_path(), rowset->rowset_id(), 0);
+        auto s = segment_v2::Segment::open(&_segment_mem_tracker, fs::fs_util::block_manager(), segment_file, 0,
+                                           &tablet_schema, segment);
+        ASSERT_TRUE(s.ok()) << s.to_string();
+    }
+
+    // Reads all the rows of the iterator, with their rowids if |rowids| is not null.
+    static void read_rows(vectorized::ChunkIterator* iter, std::vector<vectorized::DatumTuple>* rows,
+                          std::vector<uint32_t>* rowids = nullptr) {
+        auto chunk = vectorized::ChunkHelper::new_chunk(iter->schema(), 1000);
+        std::vector<uint32_t> chunk_rowids;
+        while (true) {
+            auto st = rowids != nullptr ? iter->get_next(chunk.get(), &chunk_rowids) : iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok()) << st.to_string();
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                rows->emplace_back(chunk->get(i));
+            }
+            if (rowids != nullptr) {
+                ASSERT_EQ(chunk->num_rows(), chunk_rowids.size());
+                rowids->insert(rowids->end(), chunk_rowids.begin(), chunk_rowids.end());
+                chunk_rowids.clear();
+            }
+            chunk->reset();
+        }
+    }
+
 private:
+    // The tracker of the segments opened by write_and_open_segment.
+    MemTracker _segment_mem_tracker;
     std::unique_ptr<MemTracker> _tablet_meta_mem_tracker = nullptr;
     std::unique_ptr<MemTracker> _schema_change_mem_tracker = nullptr;
     std::unique_ptr<MemTracker> _page_cache_mem_tracker = nullptr;
@@ -755,4 +832,274 @@ TEST_F(BetaRowsetTest, FinalMergeTest) {
     }
 }
 
+TEST_F(BetaRowsetTest, RowidRangeOptionTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    const uint32_t rows_per_segment = 4096;
+    // The rows of segment s are (key, key, s).
+    std::vector<vectorized::ChunkPtr> chunks;
+    for (uint32_t seg = 0; seg < 2; seg++) {
+        chunks.emplace_back(new_chunk(tablet_schema, seg * rows_per_segment, rows_per_segment, [](uint32_t row) {
+            auto key = static_cast<int32_t>(row);
+            return std::array<int32_t, 3>{key, key, static_cast<int32_t>(row / rows_per_segment)};
+        }));
+    }
+    RowsetSharedPtr rowset;
+    write_rowset(tablet_schema, chunks, &rowset);
+    ASSERT_TRUE(rowset != nullptr);
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.stats = &stats;
+    rs_opts.tablet_schema = &tablet_schema;
+    rs_opts.rowid_range_option =
+            std::make_shared<vectorized::RowidRangeOption>(rowset, 1, vectorized::SparseRange(1024, 2048));
+    auto res = rowset->new_iterator(schema, rs_opts);
+    ASSERT_TRUE(res.ok()) << res.status().to_string();
+
+    std::vector<vectorized::DatumTuple> rows;
+    read_rows(res.value().get(), &rows);
+    ASSERT_EQ(1024, rows.size());
+    for (size_t i = 0; i < rows.size(); i++) {
+        EXPECT_EQ(static_cast<int32_t>(rows_per_segment + 1024 + i), rows[i][0].get_int32());
+        EXPECT_EQ(1, rows[i][2].get_int32());
+    }
+}
+
+TEST_F(BetaRowsetTest, MetadataScanTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    const uint32_t num_segments = 2;
+    const uint32_t rows_per_segment = 4096;
+    std::vector<vectorized::ChunkPtr> chunks;
+    for (uint32_t seg = 0; seg < num_segments; seg++) {
+        chunks.emplace_back(new_chunk(tablet_schema, seg * rows_per_segment, rows_per_segment, [](uint32_t row) {
+            auto key = static_cast<int32_t>(row);
+            return std::array<int32_t, 3>{key, key, static_cast<int32_t>(row / rows_per_segment)};
+        }));
+    }
+    RowsetSharedPtr rowset;
+    write_rowset(tablet_schema, chunks, &rowset);
+    ASSERT_TRUE(rowset != nullptr);
+
+    // select count(*), min(k1), max(k1)
+    std::vector<uint32_t> read_columns{0};
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema, read_columns);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.stats = &stats;
+    rs_opts.tablet_schema = &tablet_schema;
+    rs_opts.metadata_scan = true;
+    rs_opts.metadata_min_max_columns = {0};
+    auto res = rowset->new_iterator(schema, rs_opts);
+    ASSERT_TRUE(res.ok()) << res.status().to_string();
+
+    // The rows of every segment are its min value but the last one, which is the max value.
+    std::vector<vectorized::DatumTuple> rows;
+    read_rows(res.value().get(), &rows);
+    ASSERT_EQ(num_segments * rows_per_segment, rows.size());
+    EXPECT_EQ(0, stats.raw_rows_read);
+    for (uint32_t seg = 0; seg < num_segments; seg++) {
+        auto offset = static_cast<int32_t>(seg * rows_per_segment);
+        EXPECT_EQ(offset, rows[offset][0].get_int32());
+        EXPECT_EQ(offset, rows[offset + rows_per_segment - 2][0].get_int32());
+        EXPECT_EQ(offset + rows_per_segment - 1, rows[offset + rows_per_segment - 1][0].get_int32());
+    }
+}
+
+TEST_F(BetaRowsetTest, DeleteBitmapOptionTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    const uint32_t rows_per_segment = 4096;
+    std::shared_ptr<segment_v2::Segment> segment;
+    write_and_open_segment(tablet_schema, new_chunk(tablet_schema, 0, rows_per_segment, [](uint32_t row) {
+                               auto key = static_cast<int32_t>(row);
+                               return std::array<int32_t, 3>{key, key, key};
+                           }),
+                           &segment);
+    ASSERT_TRUE(segment != nullptr);
+
+    // The rows of the delete bitmap, i.e. the even rows, are filtered out.
+    std::vector<uint32_t> deleted_rows;
+    for (uint32_t i = 0; i < rows_per_segment; i += 2) {
+        deleted_rows.push_back(i);
+    }
+    auto delete_bitmap = std::make_shared<DelVector>();
+    delete_bitmap->init(1, deleted_rows.data(), deleted_rows.size());
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    vectorized::SegmentReadOptions seg_options;
+    seg_options.block_mgr = fs::fs_util::block_manager();
+    seg_options.stats = &_stats;
+    seg_options.delete_bitmap = delete_bitmap;
+    auto res = segment->new_iterator(schema, seg_options);
+    ASSERT_TRUE(res.ok()) << res.status().to_string();
+
+    std::vector<vectorized::DatumTuple> rows;
+    read_rows(res.value().get(), &rows);
+    ASSERT_EQ(rows_per_segment / 2, rows.size());
+    for (size_t i = 0; i < rows.size(); i++) {
+        EXPECT_EQ(static_cast<int32_t>(2 * i + 1), rows[i][0].get_int32());
+    }
+
+    // All the rows are deleted.
+    deleted_rows.clear();
+    for (uint32_t i = 0; i < rows_per_segment; i++) {
+        deleted_rows.push_back(i);
+    }
+    delete_bitmap = std::make_shared<DelVector>();
+    delete_bitmap->init(1, deleted_rows.data(), deleted_rows.size());
+    seg_options.delete_bitmap = delete_bitmap;
+    ASSERT_TRUE(segment->new_iterator(schema, seg_options).status().is_end_of_file());
+}
+
+TEST_F(BetaRowsetTest, BitmapIndexDeletePredicateTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema, true);
+    const uint32_t rows_per_segment = 4096;
+    std::shared_ptr<segment_v2::Segment> segment;
+    write_and_open_segment(tablet_schema, new_chunk(tablet_schema, 0, rows_per_segment, [](uint32_t row) {
+                               auto key = static_cast<int32_t>(row);
+                               return std::array<int32_t, 3>{key, key % 10, key};
+                           }),
+                           &segment);
+    ASSERT_TRUE(segment != nullptr);
+
+    // delete from t where k2 = 3; delete from t where k2 = 7 and k1 < 2048;
+    std::unique_ptr<vectorized::ColumnPredicate> k2_eq_3(
+            vectorized::new_column_eq_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 1, "3"));
+    std::unique_ptr<vectorized::ColumnPredicate> k2_eq_7(
+            vectorized::new_column_eq_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 1, "7"));
+    std::unique_ptr<vectorized::ColumnPredicate> k1_lt_2048(
+            vectorized::new_column_lt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, "2048"));
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    for (bool with_k1 : {false, true}) {
+        OlapReaderStatistics stats;
+        vectorized::SegmentReadOptions seg_options;
+        seg_options.block_mgr = fs::fs_util::block_manager();
+        seg_options.stats = &stats;
+        seg_options.delete_predicates.add(vectorized::ConjunctivePredicates({k2_eq_3.get()}));
+        if (with_k1) {
+            // k1 has no bitmap index, so the second conjunction is evaluated on the rows.
+            seg_options.delete_predicates.add(vectorized::ConjunctivePredicates({k2_eq_7.get(), k1_lt_2048.get()}));
+        }
+        auto res = segment->new_iterator(schema, seg_options);
+        ASSERT_TRUE(res.ok()) << res.status().to_string();
+
+        std::vector<vectorized::DatumTuple> rows;
+        read_rows(res.value().get(), &rows);
+        for (const auto& row : rows) {
+            int32_t k1 = row[0].get_int32();
+            int32_t k2 = row[1].get_int32();
+            ASSERT_NE(3, k2);
+            ASSERT_FALSE(with_k1 && k2 == 7 && k1 < 2048);
+        }
+        size_t deleted = rows_per_segment / 10 + (rows_per_segment % 10 > 3);
+        ASSERT_EQ(deleted, stats.rows_bitmap_index_filtered);
+        if (with_k1) {
+            deleted += 2048 / 10 + (2048 % 10 > 7);
+        }
+        ASSERT_EQ(rows_per_segment - deleted, rows.size());
+    }
+}
+
+TEST_F(BetaRowsetTest, PredicateStagesTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    const uint32_t rows_per_segment = 4096;
+    std::shared_ptr<segment_v2::Segment> segment;
+    write_and_open_segment(tablet_schema, new_chunk(tablet_schema, 0, rows_per_segment, [](uint32_t row) {
+                               auto key = static_cast<int32_t>(row);
+                               return std::array<int32_t, 3>{key, key % 10, key};
+                           }),
+                           &segment);
+    ASSERT_TRUE(segment != nullptr);
+
+    // select k1, k2, v1 from t where k1 >= 1000 and k2 = 3, whose predicates are evaluated by stages or not.
+    std::unique_ptr<vectorized::ColumnPredicate> k1_ge_1000(
+            vectorized::new_column_ge_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, "1000"));
+    std::unique_ptr<vectorized::ColumnPredicate> k2_eq_3(
+            vectorized::new_column_eq_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 1, "3"));
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    const bool enable_stages = config::enable_segment_predicate_stages;
+    DeferOp config_restorer([enable_stages] { config::enable_segment_predicate_stages = enable_stages; });
+    for (bool stages : {false, true}) {
+        config::enable_segment_predicate_stages = stages;
+        OlapReaderStatistics stats;
+        vectorized::SegmentReadOptions seg_options;
+        seg_options.block_mgr = fs::fs_util::block_manager();
+        seg_options.stats = &stats;
+        seg_options.predicates[0].emplace_back(k1_ge_1000.get());
+        seg_options.predicates[1].emplace_back(k2_eq_3.get());
+        auto res = segment->new_iterator(schema, seg_options);
+        ASSERT_TRUE(res.ok()) << res.status().to_string();
+
+        std::vector<vectorized::DatumTuple> rows;
+        std::vector<uint32_t> rowids;
+        read_rows(res.value().get(), &rows, &rowids);
+        ASSERT_EQ((rows_per_segment - 1000) / 10 + ((rows_per_segment - 1000) % 10 > 3), rows.size());
+        ASSERT_EQ(rows.size(), rowids.size());
+        for (size_t i = 0; i < rows.size(); i++) {
+            int32_t k1 = rows[i][0].get_int32();
+            ASSERT_EQ(static_cast<int32_t>(1003 + 10 * i), k1);
+            ASSERT_EQ(3, rows[i][1].get_int32());
+            ASSERT_EQ(k1, rows[i][2].get_int32());
+            ASSERT_EQ(static_cast<uint32_t>(k1), rowids[i]);
+        }
+        ASSERT_EQ(rows_per_segment - rows.size(), stats.rows_stats_filtered + stats.rows_vec_cond_filtered);
+    }
+}
+
+TEST_F(BetaRowsetTest, ConcurrentFlushChunkTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    std::unique_ptr<ThreadPool> encode_pool;
+    ASSERT_TRUE(ThreadPoolBuilder("encode").set_max_threads(4).build(&encode_pool).ok());
+    int64_t split_rows = config::memtable_flush_segment_split_rows;
+    config::memtable_flush_segment_split_rows = 1000;
+    DeferOp reset_split_rows([&] { config::memtable_flush_segment_split_rows = split_rows; });
+
+    const uint32_t num_rows = 10500;
+    auto row_values = [](uint32_t row) {
+        auto i = static_cast<int32_t>(row);
+        return std::array<int32_t, 3>{i, i / 7, i * 3};
+    };
+    RowsetSharedPtr rowset;
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+        writer_context.encode_pool = encode_pool.get();
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(writer_context, &rowset_writer));
+        ASSERT_EQ(OLAP_SUCCESS, rowset_writer->flush_chunk(*new_chunk(tablet_schema, 0, num_rows, row_values)));
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+        ASSERT_EQ(11, rowset->rowset_meta()->num_segments());
+        ASSERT_EQ(num_rows, rowset->rowset_meta()->num_rows());
+    }
+
+    // The segments are in the order of the rows.
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.stats = &stats;
+    rs_opts.tablet_schema = &tablet_schema;
+    auto res = rowset->new_iterator(schema, rs_opts);
+    ASSERT_TRUE(res.ok()) << res.status().to_string();
+
+    std::vector<vectorized::DatumTuple> rows;
+    read_rows(res.value().get(), &rows);
+    ASSERT_EQ(num_rows, rows.size());
+    for (uint32_t i = 0; i < num_rows; i++) {
+        auto expected = row_values(i);
+        for (size_t j = 0; j < expected.size(); j++) {
+            ASSERT_EQ(expected[j], rows[i][j].get_int32());
+        }
+    }
+}
+
 } // namespace starrocks
@@ -123,6 +123,17 @@ public:
             ASSERT_TRUE(status.ok());
             ASSERT_EQ(1, size);
             ASSERT_EQ("StarRocks", column1->get_data()[0]);
+
+            // append to the strings read before
+            size = 2;
+            page_decoder.seek_to_position_in_page(0);
+            status = page_decoder.next_batch(&size, column1.get());
+            ASSERT_TRUE(status.ok());
+            ASSERT_EQ(2, size);
+            ASSERT_EQ(3, column1->size());
+            ASSERT_EQ("StarRocks", column1->get_data()[0]);
+            ASSERT_EQ("Hello", column1->get_data()[1]);
+            ASSERT_EQ(",", column1->get_data()[2]);
         }
     }
 };
@@ -29,6 +29,7 @@
 #include "storage/fs/file_block_manager.h"
 #include "storage/key_coder.h"
 #include "storage/olap_common.h"
+#include "storage/page_cache.h"
 #include "storage/rowset/segment_v2/bitmap_index_reader.h"
 #include "storage/rowset/segment_v2/bitmap_index_writer.h"
 #include "storage/types.h"
@@ -59,7 +60,8 @@ protected:
     void get_bitmap_reader_iter(std::string& file_name, const ColumnIndexMetaPB& meta, BitmapIndexReader** reader,
                                 BitmapIndexIterator** iter) {
         *reader = new BitmapIndexReader();
-        auto st = (*reader)->load(_block_mgr, file_name, &meta.bitmap_index(), true, false);
+        auto st = (*reader)->load(_block_mgr, file_name, StoragePageCache::new_file_id(), &meta.bitmap_index(), true,
+                                  false);
         ASSERT_TRUE(st.ok());
 
         st = (*reader)->new_iterator(iter);
@@ -178,5 +178,54 @@ TEST_F(BlockBloomFilterTest, slice) {
     ASSERT_FALSE(bf->test_bytes(s.data, s.size));
 }
 
+// Test for the batch apis
+TEST_F(BlockBloomFilterTest, batch) {
+    __int128 int128_value = 12345678901234567LL;
+    int128_value *= 1000003;
+    uint64_t expected = 0;
+    murmur_hash3_x64_64(&int128_value, sizeof(int128_value), BloomFilter::DEFAULT_SEED, &expected);
+    uint64_t hash = 0;
+    BloomFilter::hash_values(&int128_value, 1, &hash);
+    ASSERT_EQ(expected, hash);
+
+    const int num = 1000;
+    int16_t int16_values[num];
+    int32_t int32_values[num];
+    for (int i = 0; i < num; ++i) {
+        int16_values[i] = random();
+        int32_values[i] = random();
+    }
+    uint64_t hashes[num];
+    BloomFilter::hash_values(int16_values, num, hashes);
+    for (int i = 0; i < num; ++i) {
+        murmur_hash3_x64_64(&int16_values[i], sizeof(int16_t), BloomFilter::DEFAULT_SEED, &expected);
+        ASSERT_EQ(expected, hashes[i]);
+    }
+
+    std::unique_ptr<BloomFilter> bf;
+    std::unique_ptr<BloomFilter> batch_bf;
+    ASSERT_TRUE(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf).ok());
+    ASSERT_TRUE(BloomFilter::create(BLOCK_BLOOM_FILTER, &batch_bf).ok());
+    ASSERT_TRUE(bf->init(_expected_num, _fpp, HASH_MURMUR3_X64_64).ok());
+    ASSERT_TRUE(batch_bf->init(_expected_num, _fpp, HASH_MURMUR3_X64_64).ok());
+    for (int i = 0; i < num; ++i) {
+        bf->add_bytes((char*)&int32_values[i], sizeof(int32_t));
+    }
+    BloomFilter::hash_values(int32_values, num, hashes);
+    batch_bf->add_hashes(hashes, num);
+    ASSERT_EQ(0, memcmp(bf->data(), batch_bf->data(), bf->size()));
+    for (int i = 0; i < num; ++i) {
+        ASSERT_TRUE(batch_bf->test_any_hash(&hashes[i], 1));
+    }
+
+    std::string value_not_exist = "char_value_not_exist";
+    Slice slices[2] = {Slice(value_not_exist), Slice("another_value_not_exist")};
+    BloomFilter::hash_values(slices, 2, hashes);
+    ASSERT_EQ(batch_bf->test_hash(hashes[0]) || batch_bf->test_hash(hashes[1]), batch_bf->test_any_hash(hashes, 2));
+    ASSERT_FALSE(batch_bf->test_any_hash(hashes, 0));
+    BloomFilter::hash_values(int32_values, 1, hashes + 2);
+    ASSERT_TRUE(batch_bf->test_any_hash(hashes, 3));
+}
+
 } // namespace segment_v2
 } // namespace starrocks
@@ -26,10 +26,12 @@
 #include "storage/fs/file_block_manager.h"
 #include "storage/key_coder.h"
 #include "storage/olap_common.h"
+#include "storage/page_cache.h"
 #include "storage/rowset/segment_v2/bloom_filter.h"
 #include "storage/rowset/segment_v2/bloom_filter_index_reader.h"
 #include "storage/rowset/segment_v2/bloom_filter_index_writer.h"
 #include "storage/types.h"
+#include "storage/vectorized/column_predicate.h"
 #include "util/file_utils.h"
 
 namespace starrocks {
@@ -93,7 +95,8 @@ protected:
         std::string fname = kTestDir + "/" + file_name;
 
         *reader = new BloomFilterIndexReader();
-        auto st = (*reader)->load(_block_mgr, fname, &meta.bloom_filter_index(), true, false);
+        auto st = (*reader)->load(_block_mgr, fname, StoragePageCache::new_file_id(), &meta.bloom_filter_index(), true,
+                                  false);
         ASSERT_TRUE(st.ok());
 
         st = (*reader)->new_iterator(iter);
@@ -287,5 +290,62 @@ TEST_F(BloomFilterIndexReaderWriterTest, test_decimal) {
     delete[] val;
 }
 
+TEST_F(BloomFilterIndexReaderWriterTest, test_ngram) {
+    std::vector<std::string> values{"GET /index.html 200", "POST /login 302", "GET /favicon.ico 404"};
+    std::vector<Slice> slices(values.begin(), values.end());
+    std::string fname = kTestDir + "/bloom_filter_ngram";
+    ColumnIndexMetaPB meta;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        ASSERT_TRUE(_block_mgr->create_block(fs::CreateBlockOptions({fname}), &wblock).ok());
+        BloomFilterOptions bf_options;
+        bf_options.gram_size = 3;
+        std::unique_ptr<BloomFilterIndexWriter> writer;
+        ASSERT_TRUE(BloomFilterIndexWriter::create(bf_options, get_type_info(OLAP_FIELD_TYPE_VARCHAR), &writer).ok());
+        // one value of a page
+        for (const auto& slice : slices) {
+            writer->add_values(&slice, 1);
+            ASSERT_TRUE(writer->flush().ok());
+        }
+        ASSERT_TRUE(writer->finish(wblock.get(), &meta).ok());
+        ASSERT_TRUE(wblock->close().ok());
+        ASSERT_EQ(NGRAM_BLOOM_FILTER_INDEX, meta.type());
+        ASSERT_EQ(3, meta.bloom_filter_index().gram_size());
+    }
+
+    BloomFilterIndexReader reader;
+    ASSERT_TRUE(reader.load(_block_mgr, fname, StoragePageCache::new_file_id(), &meta.bloom_filter_index(), true, false)
+                        .ok());
+    std::unique_ptr<BloomFilterIndexIterator> iter;
+    ASSERT_TRUE(reader.new_iterator(&iter).ok());
+
+    auto type_info = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
+    std::unique_ptr<vectorized::ColumnPredicate> login(
+            vectorized::new_column_contains_predicate(type_info, 0, {"login"}));
+    std::unique_ptr<vectorized::ColumnPredicate> get_404(
+            vectorized::new_column_contains_predicate(type_info, 0, {"GET ", " 404"}));
+    std::unique_ptr<vectorized::ColumnPredicate> not_exist(
+            vectorized::new_column_contains_predicate(type_info, 0, {"qwertyuiop"}));
+    // shorter than a n-gram
+    std::unique_ptr<vectorized::ColumnPredicate> short_substring(
+            vectorized::new_column_contains_predicate(type_info, 0, {"xy"}));
+    std::vector<bool> login_pages{false, true, false};
+    std::vector<bool> get_404_pages{false, false, true};
+    for (int pid = 0; pid < 3; ++pid) {
+        std::unique_ptr<BloomFilter> bf;
+        ASSERT_TRUE(iter->read_bloom_filter(pid, &bf).ok());
+        ASSERT_TRUE(login->support_ngram_bloom_filter());
+        // the n-grams of the page are always in its bloom filter.
+        if (login_pages[pid]) {
+            ASSERT_TRUE(login->ngram_bloom_filter(bf.get(), 3));
+        }
+        if (get_404_pages[pid]) {
+            ASSERT_TRUE(get_404->ngram_bloom_filter(bf.get(), 3));
+        }
+        ASSERT_FALSE(not_exist->ngram_bloom_filter(bf.get(), 3));
+        ASSERT_TRUE(short_substring->ngram_bloom_filter(bf.get(), 3));
+    }
+}
+
 } // namespace segment_v2
 } // namespace starrocks
@@ -40,8 +40,10 @@
 #include "storage/field.h"
 #include "storage/fs/file_block_manager.h"
 #include "storage/olap_common.h"
+#include "storage/page_cache.h"
 #include "storage/rowset/segment_v2/column_reader.h"
 #include "storage/rowset/segment_v2/column_writer.h"
+#include "storage/rowset/segment_v2/decoded_page_cache.h"
 #include "storage/tablet_schema_helper.h"
 #include "storage/types.h"
 #include "storage/vectorized/chunk_helper.h"
@@ -64,7 +66,8 @@ protected:
 
     void TearDown() override { _tracker.release(_tracker.consumption()); }
 
-    template <FieldType type, EncodingTypePB encoding, uint32_t version, bool adaptive = true>
+    template <FieldType type, EncodingTypePB encoding, uint32_t version, bool adaptive = true,
+              bool adaptive_encoding = false, bool decoded_page_cache = false>
     void test_nullable_data(const vectorized::Column& src) {
         using Type = typename TypeTraits<type>::CppType;
         TypeInfoPtr type_info = get_type_info(type);
@@ -76,7 +79,8 @@ protected:
         ASSERT_TRUE(env->create_dir(TEST_DIR).ok());
 
         const std::string fname =
-                strings::Substitute("$0/test-$1-$2-$3-$4.data", TEST_DIR, type, encoding, version, adaptive);
+                strings::Substitute("$0/test-$1-$2-$3-$4-$5.data", TEST_DIR, type, encoding, version, adaptive,
+                                    adaptive_encoding);
         // write data
         {
             std::unique_ptr<fs::WritableBlock> wblock;
@@ -91,6 +95,7 @@ protected:
             writer_opts.meta->set_unique_id(0);
             writer_opts.meta->set_type(type);
             writer_opts.adaptive_page_format = adaptive;
+            writer_opts.adaptive_page_encoding = adaptive_encoding;
             if (type == OLAP_FIELD_TYPE_CHAR || type == OLAP_FIELD_TYPE_VARCHAR) {
                 writer_opts.meta->set_length(128);
             } else {
@@ -129,6 +134,7 @@ protected:
             ColumnReaderOptions reader_opts;
             reader_opts.storage_format_version = version;
             reader_opts.block_mgr = block_mgr.get();
+            reader_opts.file_id = StoragePageCache::new_file_id();
             std::unique_ptr<ColumnReader> reader;
             auto st = ColumnReader::create(&_tracker, reader_opts, meta, num_rows, fname, &reader);
             ASSERT_TRUE(st.ok());
@@ -145,10 +151,11 @@ protected:
             OlapReaderStatistics stats;
             iter_opts.stats = &stats;
             iter_opts.rblock = rblock.get();
+            iter_opts.use_decoded_page_cache = decoded_page_cache;
             st = iter->init(iter_opts);
             ASSERT_TRUE(st.ok());
-            // sequence read
-            {
+            // sequence read, twice to read the pages decoded by the first one from DecodedPageCache.
+            for (int pass = 0; pass < (decoded_page_cache ? 2 : 1); ++pass) {
                 st = iter->seek_to_first();
                 ASSERT_TRUE(st.ok()) << st.to_string();
 
@@ -391,6 +398,40 @@ TEST_F(ColumnReaderWriterTest, test_int) {
     test_numeric_types<OLAP_FIELD_TYPE_INT>();
 }
 
+// NOLINTNEXTLINE
+TEST_F(ColumnReaderWriterTest, test_int_adaptive_page_encoding) {
+    auto col = numeric_data<OLAP_FIELD_TYPE_INT>(4);
+    test_nullable_data<OLAP_FIELD_TYPE_INT, BIT_SHUFFLE, 1, true, true>(*col);
+    test_nullable_data<OLAP_FIELD_TYPE_INT, BIT_SHUFFLE, 2, true, true>(*col);
+
+    col = numeric_data<OLAP_FIELD_TYPE_INT>(10000);
+    test_nullable_data<OLAP_FIELD_TYPE_INT, BIT_SHUFFLE, 1, true, true>(*col);
+    test_nullable_data<OLAP_FIELD_TYPE_INT, BIT_SHUFFLE, 2, true, true>(*col);
+
+    col = numeric_data<OLAP_FIELD_TYPE_BIGINT>(4);
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, FOR_ENCODING, 2, true, true>(*col);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ColumnReaderWriterTest, test_decoded_page_cache) {
+    MemTracker mem_tracker;
+    DecodedPageCache::create_global_cache(&mem_tracker, 64 * 1024 * 1024);
+    int64_t hit_count = DecodedPageCache::hit_count();
+    int64_t miss_count = DecodedPageCache::miss_count();
+    auto col = numeric_data<OLAP_FIELD_TYPE_INT>(4);
+    test_nullable_data<OLAP_FIELD_TYPE_INT, BIT_SHUFFLE, 2, true, false, true>(*col);
+    ASSERT_LT(miss_count, DecodedPageCache::miss_count());
+    ASSERT_LT(hit_count, DecodedPageCache::hit_count());
+    ASSERT_EQ(DecodedPageCache::instance()->memory_usage(), mem_tracker.consumption());
+    DecodedPageCache::release_global_cache();
+
+    DecodedPageCache::create_global_cache(&mem_tracker, 64 * 1024 * 1024);
+    col = high_cardinality_strings(4);
+    test_nullable_data<OLAP_FIELD_TYPE_VARCHAR, DICT_ENCODING, 2, true, false, true>(*col);
+    DecodedPageCache::release_global_cache();
+    ASSERT_EQ(0, mem_tracker.consumption());
+}
+
 // NOLINTNEXTLINE
 TEST_F(ColumnReaderWriterTest, test_double) {
     test_numeric_types<OLAP_FIELD_TYPE_DOUBLE>();
@@ -556,6 +597,7 @@ TEST_F(ColumnReaderWriterTest, test_array_int) {
         ColumnReaderOptions reader_opts;
         reader_opts.block_mgr = block_mgr.get();
         reader_opts.storage_format_version = 2;
+        reader_opts.file_id = StoragePageCache::new_file_id();
         std::unique_ptr<ColumnReader> reader;
         auto st = ColumnReader::create(&_tracker, reader_opts, meta, num_rows, fname, &reader);
         ASSERT_TRUE(st.ok());
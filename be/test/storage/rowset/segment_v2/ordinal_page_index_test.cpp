@@ -84,7 +84,9 @@ TEST_F(OrdinalPageIndexTest, normal) {
     }
 
     OrdinalIndexReader index;
-    ASSERT_TRUE(index.load(_block_mgr, filename, &index_meta.ordinal_index(), 16 * 1024 * 4096 + 1, true, false).ok());
+    ASSERT_TRUE(index.load(_block_mgr, filename, StoragePageCache::new_file_id(), &index_meta.ordinal_index(),
+                           16 * 1024 * 4096 + 1, true, false)
+                        .ok());
     ASSERT_EQ(16 * 1024, index.num_data_pages());
     ASSERT_EQ(1, index.get_first_ordinal(0));
     ASSERT_EQ(4096, index.get_last_ordinal(0));
@@ -138,7 +140,9 @@ TEST_F(OrdinalPageIndexTest, one_data_page) {
     }
 
     OrdinalIndexReader index;
-    ASSERT_TRUE(index.load(_block_mgr, "", &index_meta.ordinal_index(), num_values, true, false).ok());
+    ASSERT_TRUE(index.load(_block_mgr, "", StoragePageCache::new_file_id(), &index_meta.ordinal_index(), num_values, true,
+                           false)
+                        .ok());
     ASSERT_EQ(1, index.num_data_pages());
     ASSERT_EQ(0, index.get_first_ordinal(0));
     ASSERT_EQ(num_values - 1, index.get_last_ordinal(0));
@@ -0,0 +1,50 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/segment_footer_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/mem_tracker.h"
+
+namespace starrocks::segment_v2 {
+
+static std::shared_ptr<const SegmentFooterPB> make_footer(uint32_t num_rows) {
+    auto footer = std::make_shared<SegmentFooterPB>();
+    footer->set_version(2);
+    footer->set_num_rows(num_rows);
+    return footer;
+}
+
+// NOLINTNEXTLINE
+TEST(SegmentFooterCacheTest, lookup_and_evict) {
+    MemTracker mem_tracker;
+    {
+        SegmentFooterCache cache(&mem_tracker, kNumShards * 1024);
+        int64_t hit_count = SegmentFooterCache::hit_count();
+        int64_t miss_count = SegmentFooterCache::miss_count();
+
+        ASSERT_EQ(nullptr, cache.lookup("0_0.dat"));
+        auto footer = make_footer(100);
+        cache.insert("0_0.dat", footer);
+        auto found = cache.lookup("0_0.dat");
+        ASSERT_EQ(footer.get(), found.get());
+        ASSERT_EQ(100, found->num_rows());
+        ASSERT_EQ(hit_count + 1, SegmentFooterCache::hit_count());
+        ASSERT_EQ(miss_count + 1, SegmentFooterCache::miss_count());
+        ASSERT_EQ(cache.memory_usage(), mem_tracker.consumption());
+
+        // insert too many footers to evict the first ones inserted, the first one read again is kept though, as the
+        // cache is scan resistant.
+        for (int i = 1; i <= 100 * kNumShards; ++i) {
+            cache.insert(std::to_string(i) + "_0.dat", make_footer(i));
+        }
+        ASSERT_EQ(nullptr, cache.lookup("1_0.dat"));
+        ASSERT_EQ(footer.get(), cache.lookup("0_0.dat").get());
+        ASSERT_EQ(100, found->num_rows());
+        ASSERT_LE(cache.memory_usage(), kNumShards * 1024);
+        ASSERT_EQ(cache.memory_usage(), mem_tracker.consumption());
+    }
+    ASSERT_EQ(0, mem_tracker.consumption());
+}
+
+} // namespace starrocks::segment_v2
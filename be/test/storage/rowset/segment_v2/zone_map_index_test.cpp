@@ -92,7 +92,8 @@ protected:
         }
 
         ZoneMapIndexReader column_zone_map;
-        ASSERT_OK(column_zone_map.load(_block_mgr, filename, &index_meta.zone_map_index(), true, false));
+        ASSERT_OK(column_zone_map.load(_block_mgr, filename, StoragePageCache::new_file_id(),
+                                       &index_meta.zone_map_index(), true, false));
         ASSERT_EQ(3, column_zone_map.num_pages());
         const std::vector<ZoneMapPB>& zone_maps = column_zone_map.page_zone_maps();
         ASSERT_EQ(3, zone_maps.size());
@@ -148,7 +149,8 @@ TEST_F(ColumnZoneMapTest, NormalTestIntPage) {
     }
 
     ZoneMapIndexReader column_zone_map;
-    ASSERT_OK(column_zone_map.load(_block_mgr, filename, &index_meta.zone_map_index(), true, false));
+    ASSERT_OK(column_zone_map.load(_block_mgr, filename, StoragePageCache::new_file_id(), &index_meta.zone_map_index(),
+                                   true, false));
     ASSERT_EQ(3, column_zone_map.num_pages());
     const std::vector<ZoneMapPB>& zone_maps = column_zone_map.page_zone_maps();
     ASSERT_EQ(3, zone_maps.size());
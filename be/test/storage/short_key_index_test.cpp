@@ -23,6 +23,8 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+
 #include "storage/row_cursor.h"
 #include "storage/tablet_schema_helper.h"
 #include "util/debug_util.h"
@@ -97,6 +99,45 @@ TEST_F(ShortKeyIndexTest, buider) {
     }
 }
 
+TEST_F(ShortKeyIndexTest, seek_keys_of_same_prefix) {
+    // Keys of the bytes 0x00, 'a' and 0xff, many of which have the same first 8 bytes or are the prefix of others.
+    const char alphabet[] = {'\x00', 'a', '\xff'};
+    auto random_key = [&]() {
+        std::string key(rand() % 13, 'a');
+        for (auto& c : key) {
+            c = alphabet[rand() % 3];
+        }
+        return key;
+    };
+    std::set<std::string> key_set;
+    for (int i = 0; i < 5000; i++) {
+        key_set.insert(random_key());
+    }
+    std::vector<std::string> keys(key_set.begin(), key_set.end());
+
+    ShortKeyIndexBuilder builder(0, 1024);
+    for (auto& key : keys) {
+        builder.add_item(key);
+    }
+    std::vector<Slice> slices;
+    segment_v2::PageFooterPB footer;
+    ASSERT_TRUE(builder.finalize(keys.size() * 1024, &slices, &footer).ok());
+    std::string buf;
+    for (auto& slice : slices) {
+        buf.append(slice.data, slice.size);
+    }
+    ShortKeyIndexDecoder decoder;
+    ASSERT_TRUE(decoder.parse(buf, footer.short_key_page_footer()).ok());
+
+    for (int i = 0; i < 5000; i++) {
+        std::string key = random_key();
+        auto lower = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+        auto upper = std::upper_bound(keys.begin(), keys.end(), key) - keys.begin();
+        ASSERT_EQ(lower, decoder.lower_bound(key).ordinal()) << hexdump(key.data(), key.size());
+        ASSERT_EQ(upper, decoder.upper_bound(key).ordinal()) << hexdump(key.data(), key.size());
+    }
+}
+
 TEST_F(ShortKeyIndexTest, enocde) {
     TabletSchema tablet_schema;
     tablet_schema._cols.push_back(create_int_key(0));
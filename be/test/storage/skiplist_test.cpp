@@ -397,7 +397,7 @@ static void run_concurrent(int run) {
     Random rnd(seed);
     const int N = 1000;
     const int kSize = 1000;
-    PriorityThreadPool thread_pool(10, 100);
+    PriorityThreadPool thread_pool("skiplist_test", 10, 100);
     for (int i = 0; i < N; i++) {
         if ((i % 100) == 0) {
             fprintf(stderr, "Run %d of %d\n", i, N);
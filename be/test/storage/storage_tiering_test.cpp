@@ -0,0 +1,44 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/storage_tiering.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks {
+
+static const int64_t kDay = 86400;
+static const int64_t kNow = 1000 * kDay;
+
+static StorageTiering::RowsetAccess rowset(bool loaded, int64_t creation_time, int64_t last_read_time) {
+    StorageTiering::RowsetAccess access;
+    access.loaded = loaded;
+    access.creation_time = creation_time;
+    access.last_read_time = last_read_time;
+    return access;
+}
+
+static StorageTiering::Temperature temperature(const std::vector<StorageTiering::RowsetAccess>& rowsets) {
+    return StorageTiering::temperature(rowsets, kNow, 0, kDay, 30 * kDay);
+}
+
+TEST(StorageTieringTest, loaded_recently) {
+    ASSERT_EQ(StorageTiering::HOT, temperature({rowset(false, kNow - 400 * kDay, 0), rowset(true, kNow - 3600, 0)}));
+    ASSERT_EQ(StorageTiering::WARM, temperature({rowset(true, kNow - 10 * kDay, 0)}));
+}
+
+TEST(StorageTieringTest, read_recently) {
+    ASSERT_EQ(StorageTiering::HOT, temperature({rowset(true, kNow - 400 * kDay, kNow - 60)}));
+    ASSERT_EQ(StorageTiering::WARM, temperature({rowset(true, kNow - 400 * kDay, kNow - 10 * kDay)}));
+}
+
+TEST(StorageTieringTest, cold) {
+    ASSERT_EQ(StorageTiering::COLD, temperature({rowset(true, kNow - 400 * kDay, 0)}));
+    // A compaction doesn't make the data new.
+    ASSERT_EQ(StorageTiering::COLD, temperature({rowset(false, kNow - 60, 0), rowset(true, kNow - 400 * kDay, 0)}));
+    ASSERT_EQ(StorageTiering::COLD, temperature({}));
+    // Not known to be cold before the reads are tracked for long enough.
+    ASSERT_EQ(StorageTiering::WARM,
+              StorageTiering::temperature({rowset(true, kNow - 400 * kDay, 0)}, kNow, kNow - kDay, kDay, 30 * kDay));
+}
+
+} // namespace starrocks
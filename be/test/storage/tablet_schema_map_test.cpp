@@ -0,0 +1,55 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/tablet_schema_map.h"
+
+#include <gtest/gtest.h>
+
+#include "column/schema.h"
+#include "storage/tablet_schema.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks {
+
+static TabletSchemaPB schema_pb(bool is_in_memory) {
+    TabletSchemaPB schema;
+    schema.set_keys_type(DUP_KEYS);
+    schema.set_num_short_key_columns(1);
+    schema.set_is_in_memory(is_in_memory);
+    for (int i = 0; i < 2; i++) {
+        ColumnPB* column = schema.add_column();
+        column->set_unique_id(i);
+        column->set_name("c" + std::to_string(i));
+        column->set_type("INT");
+        column->set_is_key(i == 0);
+        column->set_is_nullable(false);
+        column->set_length(4);
+        column->set_aggregation("NONE");
+    }
+    return schema;
+}
+
+TEST(TabletSchemaMapTest, emplace) {
+    auto* map = TabletSchemaMap::instance();
+    auto schema = map->emplace(schema_pb(false));
+    ASSERT_EQ(2, schema->num_columns());
+    size_t size = map->size();
+    ASSERT_EQ(schema, map->emplace(schema_pb(false)));
+    ASSERT_EQ(size, map->size());
+
+    auto in_memory = map->emplace(schema_pb(true));
+    ASSERT_NE(schema, in_memory);
+    ASSERT_TRUE(in_memory->is_in_memory());
+    ASSERT_EQ(size + 1, map->size());
+}
+
+TEST(TabletSchemaMapTest, shared_fields) {
+    auto schema = TabletSchemaMap::instance()->emplace(schema_pb(false));
+    auto all = vectorized::ChunkHelper::convert_schema_to_format_v2(*schema);
+    auto projection = vectorized::ChunkHelper::convert_schema_to_format_v2(*schema, {1});
+    ASSERT_EQ(2, all.num_fields());
+    ASSERT_EQ(1, projection.num_fields());
+    ASSERT_EQ(all.field(1), projection.field(0));
+    ASSERT_EQ(1, projection.field(0)->id());
+}
+
+} // namespace starrocks
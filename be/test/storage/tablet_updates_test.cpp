@@ -64,7 +64,36 @@ public:
         return writer->build();
     }
 
-    TabletSharedPtr create_tablet(int64_t tablet_id, int32_t schema_hash) {
+    // A partial update of the column v1 of |keys|, whose v1 is |keys[i] % 100 + 3|.
+    RowsetSharedPtr create_partial_rowset(const TabletSharedPtr& tablet, const vector<int64_t>& keys) {
+        std::vector<uint32_t> column_ids{0, 1};
+        auto partial_schema = tablet->tablet_schema().select_columns(column_ids);
+        RowsetWriterContext writer_context(kDataFormatV2, config::storage_format_version);
+        writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+        writer_context.tablet_id = tablet->tablet_id();
+        writer_context.tablet_schema_hash = tablet->schema_hash();
+        writer_context.partition_id = 0;
+        writer_context.rowset_type = BETA_ROWSET;
+        writer_context.rowset_path_prefix = tablet->tablet_path();
+        writer_context.rowset_state = COMMITTED;
+        writer_context.tablet_schema = &tablet->tablet_schema();
+        writer_context.partial_update_tablet_schema = partial_schema.get();
+        writer_context.partial_update_column_ids = column_ids;
+        writer_context.segments_overlap = NONOVERLAPPING;
+        std::unique_ptr<RowsetWriter> writer;
+        EXPECT_EQ(OLAP_SUCCESS, RowsetFactory::create_rowset_writer(writer_context, &writer));
+        auto schema = vectorized::ChunkHelper::convert_schema(*partial_schema);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, keys.size());
+        auto& cols = chunk->columns();
+        for (int64_t key : keys) {
+            cols[0]->append_datum(vectorized::Datum(key));
+            cols[1]->append_datum(vectorized::Datum((int16_t)(key % 100 + 3)));
+        }
+        EXPECT_EQ(OLAP_SUCCESS, writer->flush_chunk(*chunk));
+        return writer->build();
+    }
+
+    TabletSharedPtr create_tablet(int64_t tablet_id, int32_t schema_hash, const std::string& v2_default = "") {
         TCreateTabletReq request;
         request.tablet_id = tablet_id;
         request.__set_version(1);
@@ -90,6 +119,9 @@ public:
         k3.column_name = "v2";
         k3.__set_is_key(false);
         k3.column_type.type = TPrimitiveType::INT;
+        if (!v2_default.empty()) {
+            k3.__set_default_value(v2_default);
+        }
         request.tablet_schema.columns.push_back(k3);
         auto st = StorageEngine::instance()->create_tablet(request);
         CHECK(st.ok()) << st.to_string();
@@ -352,6 +384,97 @@ TEST_F(TabletUpdatesTest, writeread_with_delete) {
     ASSERT_EQ(N, read_tablet(_tablet, 4));
 }
 
+TEST_F(TabletUpdatesTest, get_rows_by_keys) {
+    _tablet = create_tablet(rand(), rand());
+    const int N = 8000;
+    std::vector<int64_t> keys;
+    for (int i = 0; i < N; i++) {
+        keys.push_back(i);
+    }
+    // Insert [0, 1, 2 ... N)
+    ASSERT_TRUE(_tablet->rowset_commit(2, create_rowset(_tablet, keys)).ok());
+    // Delete [0, 1, 2 ... N/2)
+    vectorized::Int64Column deletes;
+    deletes.append_numbers(keys.data(), sizeof(int64_t) * keys.size() / 2);
+    ASSERT_TRUE(_tablet->rowset_commit(3, create_rowset(_tablet, {}, &deletes)).ok());
+    ASSERT_EQ(3, _tablet->updates()->max_version());
+
+    // N/4 has been deleted and 2*N does not exist.
+    std::vector<int64_t> lookups{N - 1, N / 4, 2 * N, N / 2};
+    auto pk_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema(), {0});
+    auto lookup_keys = vectorized::ChunkHelper::new_chunk(pk_schema, lookups.size());
+    for (int64_t key : lookups) {
+        lookup_keys->get_column_by_index(0)->append_datum(vectorized::Datum(key));
+    }
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema());
+    auto rows = vectorized::ChunkHelper::new_chunk(schema, lookups.size());
+    std::vector<uint32_t> found;
+    ASSERT_TRUE(_tablet->updates()->get_rows_by_keys(3, *lookup_keys, schema, rows.get(), &found).ok());
+    ASSERT_EQ(std::vector<uint32_t>({0, 3}), found);
+    ASSERT_EQ(2, rows->num_rows());
+    for (size_t i = 0; i < found.size(); i++) {
+        int64_t key = lookups[found[i]];
+        auto row = rows->get(i);
+        EXPECT_EQ(key, row.get(0).get_int64());
+        EXPECT_EQ(key % 100 + 1, row.get(1).get_int16());
+        EXPECT_EQ(key % 1000 + 2, row.get(2).get_int32());
+    }
+
+    // The index only tracks the latest applied version.
+    rows->reset();
+    ASSERT_TRUE(_tablet->updates()->get_rows_by_keys(2, *lookup_keys, schema, rows.get(), &found).is_not_supported());
+}
+
+TEST_F(TabletUpdatesTest, partial_update) {
+    _tablet = create_tablet(rand(), rand(), "7");
+    const int N = 8000;
+    std::vector<int64_t> keys;
+    for (int i = 0; i < N; i++) {
+        keys.push_back(i);
+    }
+    // Insert [0, N), then update v1 of [N/2, N + N/2)
+    ASSERT_TRUE(_tablet->rowset_commit(2, create_rowset(_tablet, keys)).ok());
+    std::vector<int64_t> partial_keys;
+    for (int i = N / 2; i < N + N / 2; i++) {
+        partial_keys.push_back(i);
+    }
+    auto partial_rowset = create_partial_rowset(_tablet, partial_keys);
+    ASSERT_TRUE(partial_rowset->rowset_meta()->is_partial_update());
+    ASSERT_TRUE(_tablet->rowset_commit(3, partial_rowset).ok());
+    ASSERT_EQ(3, _tablet->updates()->max_version());
+    ASSERT_EQ(N + N / 2, read_tablet(_tablet, 3));
+
+    std::vector<RowsetSharedPtr> rowsets;
+    ASSERT_TRUE(_tablet->updates()->get_applied_rowsets(3, &rowsets).ok());
+    ASSERT_EQ(2, rowsets.size());
+    ASSERT_FALSE(rowsets[1]->rowset_meta()->is_partial_update());
+    ASSERT_NE(partial_rowset->rowset_id(), rowsets[1]->rowset_id());
+
+    std::vector<int64_t> lookups{0, N / 2, N - 1, N, N + N / 2 - 1};
+    auto pk_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema(), {0});
+    auto lookup_keys = vectorized::ChunkHelper::new_chunk(pk_schema, lookups.size());
+    for (int64_t key : lookups) {
+        lookup_keys->get_column_by_index(0)->append_datum(vectorized::Datum(key));
+    }
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema());
+    auto rows = vectorized::ChunkHelper::new_chunk(schema, lookups.size());
+    std::vector<uint32_t> found;
+    ASSERT_TRUE(_tablet->updates()->get_rows_by_keys(3, *lookup_keys, schema, rows.get(), &found).ok());
+    ASSERT_EQ(lookups.size(), found.size());
+    for (size_t i = 0; i < found.size(); i++) {
+        int64_t key = lookups[found[i]];
+        auto row = rows->get(i);
+        EXPECT_EQ(key, row.get(0).get_int64());
+        if (key < N / 2) {
+            EXPECT_EQ(key % 100 + 1, row.get(1).get_int16());
+        } else {
+            EXPECT_EQ(key % 100 + 3, row.get(1).get_int16());
+        }
+        // the new keys take the default value of the column not updated
+        EXPECT_EQ(key < N ? key % 1000 + 2 : 7, row.get(2).get_int32());
+    }
+}
+
 TEST_F(TabletUpdatesTest, noncontinous_commit) {
     _tablet = create_tablet(rand(), rand());
     const int N = 100;
@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 
+#include "common/config.h"
 #include "runtime/mem_tracker.h"
 #include "storage/del_vector.h"
 #include "storage/olap_define.h"
@@ -14,6 +15,7 @@
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/storage_engine.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "util/defer_op.h"
 #include "util/file_utils.h"
 
 using namespace std;
@@ -146,6 +148,41 @@ TEST_F(UpdateManagerTest, testDelVec) {
     ASSERT_EQ(5, tmp->version());
 }
 
+TEST_F(UpdateManagerTest, testDelVecCacheEvict) {
+    int64_t old_capacity = config::update_del_vector_cache_capacity;
+    DeferOp restore([&] { config::update_del_vector_cache_capacity = old_capacity; });
+    // every shard keeps its latest one only
+    config::update_del_vector_cache_capacity = 0;
+
+    const uint32_t N = 64;
+    DelVector empty;
+    size_t max_memory_usage = 0;
+    for (uint32_t i = 0; i < N; i++) {
+        TabletSegmentId rssid;
+        rssid.tablet_id = 0;
+        rssid.segment_id = i;
+        DelVectorPtr delvec;
+        empty.add_dels_as_new_version({i, i + 10, i * 1000}, i + 2, &delvec);
+        ASSERT_TRUE(_update_manager->set_del_vec_in_meta(_meta.get(), rssid, *delvec).ok());
+        ASSERT_TRUE(_update_manager->set_cached_del_vec(rssid, delvec).ok());
+        max_memory_usage = std::max(max_memory_usage, delvec->memory_usage());
+    }
+    ASSERT_LE(_root_mem_tracker->consumption(), 16 * max_memory_usage);
+    // the evicted ones are read from the meta
+    for (uint32_t i = 0; i < N; i++) {
+        TabletSegmentId rssid;
+        rssid.tablet_id = 0;
+        rssid.segment_id = i;
+        DelVectorPtr delvec;
+        ASSERT_TRUE(_update_manager->get_latest_del_vec(_meta.get(), rssid, &delvec).ok());
+        ASSERT_EQ(i + 2, delvec->version());
+        ASSERT_EQ(i == 0 ? 2 : 3, delvec->cardinality());
+    }
+    ASSERT_LE(_root_mem_tracker->consumption(), 16 * max_memory_usage);
+    _update_manager->clear_cache();
+    ASSERT_EQ(0, _root_mem_tracker->consumption());
+}
+
 TEST_F(UpdateManagerTest, testExpireEntry) {
     srand(time(NULL));
     create_tablet(rand(), rand());
@@ -2156,4 +2156,51 @@ TEST(ColumnPredicateTest, zone_map_filter_varchar) {
     EXPECT_TRUE(not_in_xx_yy->zone_map_filter(Datum("xy"), Datum("zz")));
 }
 
+// NOLINTNEXTLINE
+TEST(ColumnPredicateTest, test_dict_filter) {
+    // the dictionary codes 1 and 3 are selected.
+    std::vector<uint8_t> dict_filter{0, 1, 0, 1};
+    std::unique_ptr<ColumnPredicate> p(
+            new_column_dict_filter_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, dict_filter));
+    {
+        auto c = ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_INT, false);
+        c->append_datum(Datum(0));
+        c->append_datum(Datum(1));
+        c->append_datum(Datum(2));
+        c->append_datum(Datum(3));
+        c->append_datum(Datum(1));
+
+        std::vector<uint8_t> buff(5);
+        p->evaluate(c.get(), buff.data(), 0, 5);
+        ASSERT_EQ("0,1,0,1,1", to_string(buff));
+
+        buff.assign(5, 1);
+        buff[1] = 0;
+        p->evaluate_and(c.get(), buff.data(), 0, 5);
+        ASSERT_EQ("0,0,0,1,1", to_string(buff));
+
+        buff.assign(5, 0);
+        buff[0] = 1;
+        p->evaluate_or(c.get(), buff.data(), 0, 5);
+        ASSERT_EQ("1,1,0,1,1", to_string(buff));
+
+        std::vector<uint16_t> sel{0, 1, 2, 3, 4};
+        ASSERT_EQ(3, p->evaluate_branchless(c.get(), sel.data(), sel.size()));
+        ASSERT_EQ(1, sel[0]);
+        ASSERT_EQ(3, sel[1]);
+        ASSERT_EQ(4, sel[2]);
+    }
+    {
+        auto c = ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_INT, true);
+        c->append_datum(Datum(1));
+        (void)c->append_nulls(1);
+        c->append_datum(Datum(2));
+        c->append_datum(Datum(3));
+
+        std::vector<uint8_t> buff(4);
+        p->evaluate(c.get(), buff.data(), 0, 4);
+        ASSERT_EQ("1,0,0,1", to_string(buff));
+    }
+}
+
 } // namespace starrocks::vectorized
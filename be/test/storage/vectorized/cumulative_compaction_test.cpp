@@ -246,4 +246,43 @@ TEST_F(CumulativeCompactionTest, test_compact_succeed) {
     ASSERT_TRUE(cumulative_compaction.compact().ok());
 }
 
+TEST_F(CumulativeCompactionTest, test_pick_size_tiered_rowsets) {
+    config::size_tiered_compaction_min_tier_bytes = 1024;
+    config::size_tiered_compaction_tier_multiple = 4;
+    config::size_tiered_compaction_max_write_amplification = 3;
+    config::min_cumulative_compaction_num_singleton_deltas = 3;
+    ASSERT_EQ(0, CumulativeCompaction::size_tier(100));
+    ASSERT_EQ(1, CumulativeCompaction::size_tier(4096));
+    ASSERT_EQ(2, CumulativeCompaction::size_tier(16383 * 4));
+    ASSERT_EQ(3, CumulativeCompaction::size_tier(int64_t{1} << 40));
+
+    using SizeTieredRowset = CumulativeCompaction::SizeTieredRowset;
+    auto pick = [](const std::vector<SizeTieredRowset>& rowsets, bool sealed) {
+        size_t num_skipped = 0;
+        size_t begin = 0;
+        size_t end = 0;
+        CumulativeCompaction::pick_size_tiered_rowsets(rowsets, sealed, &num_skipped, &begin, &end);
+        return std::vector<size_t>{num_skipped, begin, end};
+    };
+    SizeTieredRowset top{1 << 20, 1, false};
+    SizeTieredRowset tier1{5000, 1, false};
+    SizeTieredRowset tier0{100, 1, false};
+    SizeTieredRowset overlapping{100, 4, true};
+
+    // The tier 1 run is not large enough, the tier 0 run is.
+    ASSERT_EQ((std::vector<size_t>{1, 3, 6}), pick({top, tier1, tier1, tier0, tier0, tier0}, false));
+    // Not until the further loads.
+    ASSERT_EQ((std::vector<size_t>{1, 0, 0}), pick({top, tier1, tier1, tier0, tier0}, false));
+    // Unless no rowset may join them.
+    ASSERT_EQ((std::vector<size_t>{1, 3, 5}), pick({top, tier1, tier1, tier0, tier0}, true));
+    ASSERT_EQ((std::vector<size_t>{0, 0, 2}), pick({tier0, tier0, tier1, tier0}, false));
+    // An overlapping rowset alone.
+    ASSERT_EQ((std::vector<size_t>{0, 1, 2}), pick({tier1, overlapping}, false));
+    // The single rowsets no rowset can join are left to the base compaction.
+    ASSERT_EQ((std::vector<size_t>{3, 0, 0}), pick({top, tier0, top, tier1}, false));
+    ASSERT_EQ((std::vector<size_t>{2, 0, 0}), pick({top, tier1}, true));
+
+    config::min_cumulative_compaction_num_singleton_deltas = 2;
+}
+
 } // namespace starrocks::vectorized
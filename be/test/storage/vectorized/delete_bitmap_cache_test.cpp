@@ -0,0 +1,57 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/vectorized/delete_bitmap_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/mem_tracker.h"
+
+namespace starrocks::vectorized {
+
+static DelVectorPtr make_bitmap(const std::vector<uint32_t>& rows) {
+    auto bitmap = std::make_shared<DelVector>();
+    bitmap->init(1, rows.data(), rows.size());
+    return bitmap;
+}
+
+// NOLINTNEXTLINE
+TEST(DeleteBitmapCacheTest, key) {
+    RowsetId rowset_id;
+    rowset_id.init(10000);
+    // The bitmaps of the different segments or delete predicates are different.
+    ASSERT_NE(DeleteBitmapCache::key(rowset_id, 0, {3, 5}), DeleteBitmapCache::key(rowset_id, 1, {3, 5}));
+    ASSERT_NE(DeleteBitmapCache::key(rowset_id, 0, {3, 5}), DeleteBitmapCache::key(rowset_id, 0, {3, 5, 7}));
+    ASSERT_NE(DeleteBitmapCache::key(rowset_id, 1, {3}), DeleteBitmapCache::key(rowset_id, 13, {}));
+    ASSERT_EQ(DeleteBitmapCache::key(rowset_id, 0, {3, 5}), DeleteBitmapCache::key(rowset_id, 0, {3, 5}));
+}
+
+// NOLINTNEXTLINE
+TEST(DeleteBitmapCacheTest, lookup_and_evict) {
+    MemTracker mem_tracker;
+    {
+        DeleteBitmapCache cache(&mem_tracker, kNumShards * 1024);
+        ASSERT_EQ(nullptr, cache.lookup("0:0:2"));
+        auto bitmap = make_bitmap({1, 3, 5});
+        cache.insert("0:0:2", bitmap);
+        auto found = cache.lookup("0:0:2");
+        ASSERT_EQ(bitmap.get(), found.get());
+        ASSERT_EQ(3, found->cardinality());
+        ASSERT_EQ(cache.memory_usage(), mem_tracker.consumption());
+
+        // An empty bitmap means no row of the segment has been deleted.
+        cache.insert("0:1:2", make_bitmap({}));
+        ASSERT_TRUE(cache.lookup("0:1:2")->empty());
+
+        // insert too many bitmaps to evict the first one, which is still valid for its users.
+        for (int i = 1; i <= 100 * kNumShards; ++i) {
+            cache.insert(std::to_string(i) + ":0:2", make_bitmap({static_cast<uint32_t>(i)}));
+        }
+        ASSERT_EQ(nullptr, cache.lookup("0:0:2"));
+        ASSERT_EQ(3, found->cardinality());
+        ASSERT_LE(cache.memory_usage(), kNumShards * 1024);
+        ASSERT_EQ(cache.memory_usage(), mem_tracker.consumption());
+    }
+    ASSERT_EQ(0, mem_tracker.consumption());
+}
+
+} // namespace starrocks::vectorized
@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <tuple>
 
 #include "gutil/strings/split.h"
 #include "runtime/descriptor_helper.h"
@@ -16,6 +17,7 @@
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/schema.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "util/defer_op.h"
 #include "util/file_utils.h"
 
 namespace starrocks::vectorized {
@@ -310,6 +312,102 @@ TEST_F(MemTableTest, testUniqKeysInsertFlushRead) {
     ASSERT_EQ(n, pkey_read);
 }
 
+TEST_F(MemTableTest, testDupKeysSortByNormalizedKeys) {
+    const string path = "./ut_dir/MemTableTest_testDupKeysSortByNormalizedKeys";
+    MySetUp("k1 smallint,k2 int null,v int", "k1 smallint,k2 int null,v int", 2, KeysType::DUP_KEYS, path);
+    const size_t n = 3000;
+    shared_ptr<Chunk> pchunk = ChunkHelper::new_chunk(*_slots, n);
+    for (int i = 0; i < n; i++) {
+        Datum v;
+        v.set_int16(rand() % 7 - 3);
+        pchunk->get_column_by_index(0)->append_datum(v);
+        if (i % 5 == 0) {
+            pchunk->get_column_by_index(1)->append_nulls(1);
+        } else {
+            v.set_int32(rand() % 2001 - 1000);
+            pchunk->get_column_by_index(1)->append_datum(v);
+        }
+        v.set_int32(i);
+        pchunk->get_column_by_index(2)->append_datum(v);
+    }
+    vector<uint32_t> indexes;
+    indexes.reserve(n);
+    for (int i = 0; i < n; i++) {
+        indexes.emplace_back(i);
+    }
+    std::random_shuffle(indexes.begin(), indexes.end());
+    // the position of every row inserted, by which the rows of the same keys are sorted
+    vector<uint32_t> positions(n);
+    for (int i = 0; i < n; i++) {
+        positions[indexes[i]] = i;
+    }
+    _mem_table->insert(pchunk.get(), indexes.data(), 0, indexes.size());
+    ASSERT_TRUE(_mem_table->finalize().ok());
+    ASSERT_EQ(OLAP_SUCCESS, _mem_table->flush());
+    RowsetSharedPtr rowset = _writer->build();
+    unique_ptr<Schema> read_schema = create_schema("k1 smallint,k2 int null,v int", 2);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto itr = rowset->new_iterator(*read_schema, rs_opts);
+    ASSERT_TRUE(itr.ok()) << itr.status().to_string();
+    std::shared_ptr<vectorized::Chunk> chunk = vectorized::ChunkHelper::new_chunk(*read_schema, 4096);
+    size_t rows_read = 0;
+    std::tuple<int16_t, bool, int32_t, uint32_t> last_row{INT16_MIN, false, 0, 0};
+    while (true) {
+        Status st = (*itr)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            Datum k2 = chunk->get_column_by_index(1)->get(i);
+            std::tuple<int16_t, bool, int32_t, uint32_t> row{
+                    chunk->get_column_by_index(0)->get(i).get_int16(), !k2.is_null(),
+                    k2.is_null() ? 0 : k2.get_int32(), positions[chunk->get_column_by_index(2)->get(i).get_int32()]};
+            ASSERT_LT(last_row, row);
+            last_row = row;
+        }
+        rows_read += chunk->num_rows();
+        chunk->reset();
+    }
+    ASSERT_EQ(n, rows_read);
+}
+
+TEST_F(MemTableTest, testMaxWriteBufferSize) {
+    const string path = "./ut_dir/MemTableTest_testMaxWriteBufferSize";
+    MySetUp("pk int,name varchar,pv int", "pk int,name varchar,pv int", 1, KeysType::DUP_KEYS, path);
+    int64_t min_write_buffer_size = config::min_write_buffer_size;
+    DeferOp reset([&] {
+        config::min_write_buffer_size = min_write_buffer_size;
+        MemTable::set_load_mem_limit(-1);
+    });
+    const int64_t write_buffer_size = config::write_buffer_size;
+
+    MemTable::set_load_mem_limit(-1);
+    ASSERT_EQ(write_buffer_size, MemTable::max_write_buffer_size());
+    MemTable::set_load_mem_limit(write_buffer_size * 100);
+    ASSERT_EQ(write_buffer_size, MemTable::max_write_buffer_size());
+
+    // 10 memtables share 5 write buffers.
+    std::vector<std::unique_ptr<MemTable>> mem_tables;
+    for (int i = 0; i < 9; i++) {
+        mem_tables.emplace_back(new MemTable(1, _schema.get(), _slots, _writer.get(), _mem_tracker.get()));
+    }
+    MemTable::set_load_mem_limit(write_buffer_size * 5);
+    config::min_write_buffer_size = 0;
+    ASSERT_EQ(write_buffer_size / 2, MemTable::max_write_buffer_size());
+    config::min_write_buffer_size = write_buffer_size * 3 / 4;
+    ASSERT_EQ(write_buffer_size * 3 / 4, MemTable::max_write_buffer_size());
+    config::min_write_buffer_size = write_buffer_size * 2;
+    ASSERT_EQ(write_buffer_size, MemTable::max_write_buffer_size());
+
+    mem_tables.clear();
+    ASSERT_EQ(write_buffer_size, MemTable::max_write_buffer_size());
+}
+
 TEST_F(MemTableTest, testPrimaryKeysWithDeletes) {
     const string path = "./ut_dir/MemTableTest_testPrimaryKeysWithDeletes";
     MySetUp("pk bigint,v1 int", "pk bigint,v1 int,__op tinyint", 1, KeysType::PRIMARY_KEYS, path);
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <random>
 #include <vector>
 
 #include "column/column_pool.h"
@@ -105,6 +106,49 @@ TEST_F(MergeIteratorTest, heap_merge_no_overlapping) {
     ASSERT_TRUE(iter->get_next(chunk.get()).is_end_of_file());
 }
 
+// NOLINTNEXTLINE
+TEST_F(MergeIteratorTest, merge_many_runs) {
+    auto k = std::make_shared<Field>(0, "c1", get_type_info(OLAP_FIELD_TYPE_INT), false);
+    auto v = std::make_shared<Field>(1, "c2", get_type_info(OLAP_FIELD_TYPE_INT), false);
+    k->set_is_key(true);
+    Schema schema(std::vector<FieldPtr>{k, v});
+
+    // the children have runs of different lengths and equal keys, and the rows of equal keys must be
+    // returned in the order of the children, which is saved in column c2.
+    std::mt19937 rand(42);
+    std::vector<std::pair<int32_t, int32_t>> expected;
+    std::vector<ChunkIteratorPtr> children;
+    for (int32_t i = 0; i < 11; i++) {
+        std::vector<int32_t> keys(rand() % 200);
+        for (auto& key : keys) {
+            key = rand() % (i % 2 == 0 ? 50 : 5000);
+        }
+        std::sort(keys.begin(), keys.end());
+        std::vector<int32_t> orders(keys.size(), i);
+        for (int32_t key : keys) {
+            expected.emplace_back(key, i);
+        }
+        auto child = std::make_shared<VectorChunkIterator>(schema, COL_INT(keys), COL_INT(orders));
+        child->chunk_size(1 + i * 3);
+        children.emplace_back(child);
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    auto iter = new_merge_iterator(children);
+    std::vector<std::pair<int32_t, int32_t>> real;
+    ChunkPtr chunk = ChunkHelper::new_chunk(iter->schema(), 100);
+    while (iter->get_next(chunk.get()).ok()) {
+        ASSERT_LE(chunk->num_rows(), config::vector_chunk_size);
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            real.emplace_back(chunk->get_column_by_index(0)->get(i).get_int32(),
+                              chunk->get_column_by_index(1)->get(i).get_int32());
+        }
+        chunk->reset();
+    }
+    ASSERT_EQ(expected, real);
+}
+
 // NOLINTNEXTLINE
 TEST_F(MergeIteratorTest, merge_one) {
     auto sub1 = std::make_shared<VectorChunkIterator>(_schema, COL_INT({1, 1, 2, 3, 4, 5}));
@@ -4,6 +4,8 @@
 
 #include <gtest/gtest.h>
 
+#include <map>
+
 #include "gutil/strings/substitute.h"
 #include "storage/olap_meta.h"
 #include "storage/primary_key_encoder.h"
@@ -65,8 +67,36 @@ public:
         return OLAP_SUCCESS;
     }
 
+    OLAPStatus add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                           bool is_key) override {
+        if (is_key) {
+            all_pks->append(*chunk.get_column_by_index(0), 0, chunk.num_rows());
+            return OLAP_SUCCESS;
+        }
+        for (size_t i = 0; i < column_indexes.size(); i++) {
+            auto& column = value_columns[column_indexes[i]];
+            if (column == nullptr) {
+                column = chunk.get_column_by_index(i)->clone_empty();
+            }
+            column->append(*chunk.get_column_by_index(i), 0, chunk.num_rows());
+        }
+        return OLAP_SUCCESS;
+    }
+
+    OLAPStatus add_columns_with_rssid(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                                      const vector<uint32_t>& rssid) override {
+        all_rssids.insert(all_rssids.end(), rssid.begin(), rssid.end());
+        return add_columns(chunk, column_indexes, true);
+    }
+
+    OLAPStatus flush_columns() override { return OLAP_SUCCESS; }
+
+    OLAPStatus final_flush() override { return OLAP_SUCCESS; }
+
     std::unique_ptr<Column> all_pks;
     vector<uint32_t> all_rssids;
+    // the value columns written by add_columns(), by the column indexes.
+    std::map<uint32_t, ColumnPtr> value_columns;
 };
 
 class RowsetMergerTest : public testing::Test {
@@ -265,4 +295,46 @@ TEST_F(RowsetMergerTest, merge_seq) {
     EXPECT_EQ(rssids, writer.all_rssids);
 }
 
+TEST_F(RowsetMergerTest, merge_vertically) {
+    srand(GetCurrentTimeMicros());
+    create_tablet(rand(), rand());
+    const int max_segments = 8;
+    const int num_segment = 1 + rand() % max_segments;
+    const int N = 100000 + rand() % 100000;
+    MergeConfig cfg;
+    cfg.chunk_size = 100 + rand() % 2000;
+    // the value columns v1 and v2 are merged by two groups.
+    cfg.max_columns_per_group = 1;
+    LOG(INFO) << "vertical merge test #rowset:" << num_segment << " #row:" << N << " chunk_size:" << cfg.chunk_size;
+    vector<uint32_t> rssids(N);
+    vector<vector<int64_t>> segments(num_segment);
+    for (int i = 0; i < N; i++) {
+        rssids[i] = rand() % num_segment;
+        segments[rssids[i]].push_back(i);
+    }
+    vector<RowsetSharedPtr> rowsets(num_segment);
+    for (int i = 0; i < num_segment; i++) {
+        auto rs = create_rowset(segments[i]);
+        ASSERT_TRUE(_tablet->rowset_commit(i + 2, rs).ok());
+        rowsets[i] = rs;
+    }
+    int64_t version = num_segment + 1;
+    EXPECT_EQ(N, read_tablet(_tablet, version));
+    TestRowsetWriter writer;
+    Schema schema = ChunkHelper::convert_schema(_tablet->tablet_schema());
+    ASSERT_TRUE(PrimaryKeyEncoder::create_column(schema, &writer.all_pks).ok());
+    ASSERT_TRUE(vectorized::compaction_merge_rowsets(*_tablet, version, rowsets, &writer, cfg).ok());
+    ASSERT_EQ(N, writer.all_pks->size());
+    ASSERT_EQ(2, writer.value_columns.size());
+    ASSERT_EQ(N, writer.value_columns[1]->size());
+    ASSERT_EQ(N, writer.value_columns[2]->size());
+    const int64_t* raw_pk_array = reinterpret_cast<const int64_t*>(writer.all_pks->raw_data());
+    for (int64_t i = 0; i < N; i++) {
+        ASSERT_EQ(i, raw_pk_array[i]);
+        ASSERT_EQ(i % 100 + 1, writer.value_columns[1]->get(i).get_int16());
+        ASSERT_EQ(i % 1000 + 2, writer.value_columns[2]->get(i).get_int32());
+    }
+    EXPECT_EQ(rssids, writer.all_rssids);
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,59 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/adaptive_predicate_order.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks {
+
+TEST(AdaptivePredicateOrderTest, reorder) {
+    AdaptivePredicateOrder order;
+    order.init(3);
+    ASSERT_TRUE(order.sampling());
+    for (int i = 0; i < config::adaptive_predicate_order_sample_chunks; ++i) {
+        ASSERT_TRUE(order.sampling());
+        // eliminates nothing.
+        order.add_sample(order[0], 1000, 1000, 1000);
+        // eliminates half of the rows by 2ns per row.
+        order.add_sample(order[1], 1000, 500, 2000);
+        // eliminates 90% of the rows by 3ns per row.
+        order.add_sample(order[2], 500, 50, 1500);
+        order.next_chunk();
+    }
+    ASSERT_FALSE(order.sampling());
+    ASSERT_EQ(2, order[0]);
+    ASSERT_EQ(1, order[1]);
+    ASSERT_EQ(0, order[2]);
+
+    for (int i = 0; i < config::adaptive_predicate_order_resample_chunks; ++i) {
+        ASSERT_FALSE(order.sampling());
+        order.next_chunk();
+    }
+    ASSERT_TRUE(order.sampling());
+    // the order is kept by init with the same number of predicates.
+    order.init(3);
+    ASSERT_EQ(2, order[0]);
+    order.init(2);
+    ASSERT_EQ(0, order[0]);
+    ASSERT_EQ(1, order[1]);
+}
+
+TEST(AdaptivePredicateOrderTest, evaluate) {
+    AdaptivePredicateOrder order;
+    std::vector<size_t> evaluated;
+    auto eval = [&](size_t pred, size_t rows) {
+        evaluated.push_back(pred);
+        return pred == 1 ? 0 : rows;
+    };
+    ASSERT_EQ(0, order.evaluate(3, 100, eval));
+    // no row is left for the last predicate.
+    ASSERT_EQ(std::vector<size_t>({0, 1}), evaluated);
+    for (int i = 1; i < config::adaptive_predicate_order_sample_chunks; ++i) {
+        order.evaluate(3, 100, eval);
+    }
+    evaluated.clear();
+    ASSERT_EQ(0, order.evaluate(3, 100, eval));
+    ASSERT_EQ(std::vector<size_t>({1}), evaluated);
+}
+
+} // namespace starrocks
@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/arrow/chunk.h"
+
+#include <arrow/array.h>
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+#include <arrow/type.h>
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "exprs/expr_context.h"
+#include "exprs/slot_ref.h"
+#include "runtime/descriptors.h"
+
+namespace starrocks {
+
+using namespace vectorized;
+
+class ArrowChunkTest : public testing::Test {};
+
+TEST_F(ArrowChunkTest, convert) {
+    ColumnPtr ints = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false);
+    ColumnPtr strings = ColumnHelper::create_column(TypeDescriptor::create_varchar_type(10), true);
+    ColumnPtr dates = ColumnHelper::create_column(TypeDescriptor(TYPE_DATE), true);
+    ints->append_datum(Datum(int32_t(1)));
+    ints->append_datum(Datum(int32_t(2)));
+    strings->append_datum(Datum(Slice("abc")));
+    strings->append_datum(Datum());
+    dates->append_datum(Datum());
+    dates->append_datum(Datum(DateValue::create(2021, 10, 1)));
+
+    butil::FlatMap<SlotId, size_t> map;
+    map.init(8);
+    for (int i = 0; i < 3; ++i) {
+        map[i] = i;
+    }
+    auto chunk = std::make_shared<Chunk>(Columns{ints, strings, dates}, map);
+
+    SlotRef int_ref(TypeDescriptor(TYPE_INT), 0, 0);
+    SlotRef string_ref(TypeDescriptor(TYPE_VARCHAR), 0, 1);
+    SlotRef date_ref(TypeDescriptor(TYPE_DATE), 0, 2);
+    ExprContext int_ctx(&int_ref);
+    ExprContext string_ctx(&string_ref);
+    ExprContext date_ctx(&date_ref);
+    std::vector<ExprContext*> exprs{&int_ctx, &string_ctx, &date_ctx};
+
+    RowDescriptor row_desc;
+    std::shared_ptr<arrow::Schema> schema;
+    ASSERT_TRUE(convert_to_arrow_schema(row_desc, exprs, &schema).ok());
+    ASSERT_EQ(3, schema->num_fields());
+    ASSERT_EQ("col0", schema->field(0)->name());
+    ASSERT_TRUE(schema->field(0)->type()->Equals(arrow::int32()));
+    ASSERT_TRUE(schema->field(1)->type()->Equals(arrow::utf8()));
+    ASSERT_TRUE(schema->field(2)->type()->Equals(arrow::utf8()));
+
+    std::shared_ptr<arrow::RecordBatch> batch;
+    ASSERT_TRUE(convert_chunk_to_arrow_batch(chunk.get(), exprs, schema, arrow::default_memory_pool(), &batch).ok());
+    ASSERT_EQ(2, batch->num_rows());
+
+    auto int_array = std::static_pointer_cast<arrow::Int32Array>(batch->column(0));
+    ASSERT_EQ(0, int_array->null_count());
+    ASSERT_EQ(1, int_array->Value(0));
+    ASSERT_EQ(2, int_array->Value(1));
+
+    auto string_array = std::static_pointer_cast<arrow::StringArray>(batch->column(1));
+    ASSERT_EQ("abc", string_array->GetString(0));
+    ASSERT_TRUE(string_array->IsNull(1));
+
+    auto date_array = std::static_pointer_cast<arrow::StringArray>(batch->column(2));
+    ASSERT_TRUE(date_array->IsNull(0));
+    ASSERT_EQ("2021-10-01", date_array->GetString(1));
+}
+
+} // namespace starrocks
@@ -66,6 +66,28 @@ TEST(BitmapValueTest, bitmap_union) {
     ASSERT_EQ(5, bitmap2.cardinality());
 }
 
+TEST(BitmapValueTest, bitmap_fastunion) {
+    BitmapValue empty;
+    BitmapValue single(1024);
+    BitmapValue bitmap({1024, 1025, 1026});
+    // the values in different 32-bit bitmaps
+    BitmapValue bitmap64({1, (1ull << 32) + 1, (1ull << 33) + 1});
+
+    BitmapValue result;
+    result.fastunion({&empty, &single});
+    ASSERT_EQ(1, result.cardinality());
+    result.fastunion({&bitmap, &bitmap64, &single});
+    ASSERT_EQ(6, result.cardinality());
+    ASSERT_EQ("1,1024,1025,1026,4294967297,8589934593", result.to_string());
+
+    BitmapValue single2(2048);
+    single2.fastunion({&bitmap, &bitmap64});
+    ASSERT_EQ(7, single2.cardinality());
+    ASSERT_TRUE(single2.contains(2048));
+    // the inputs stay unchanged
+    ASSERT_EQ(3, bitmap.cardinality());
+}
+
 TEST(BitmapValueTest, bitmap_intersect) {
     BitmapValue empty;
     BitmapValue single(1024);
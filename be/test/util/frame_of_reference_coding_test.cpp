@@ -23,6 +23,8 @@
 
 #include <gtest/gtest.h>
 
+#include <random>
+
 namespace starrocks {
 class TestForCoding : public testing::Test {
 public:
@@ -118,6 +120,37 @@ TEST_F(TestForCoding, TestInt64) {
     ASSERT_EQ(data, actual_result);
 }
 
+template <typename T>
+static void test_random_bit_widths() {
+    std::mt19937_64 rng(0);
+    for (int bits = 1; bits < sizeof(T) * 8; ++bits) {
+        faststring buffer(1);
+        ForEncoder<T> encoder(&buffer);
+        std::vector<T> data;
+        for (int i = 0; i < 300; ++i) {
+            // unsorted values of up to |bits| bits, except a sorted run in the middle.
+            T value = (i >= 128 && i < 256) ? static_cast<T>(i) : static_cast<T>(rng() & ((uint64_t(1) << bits) - 1));
+            data.push_back(value);
+        }
+        encoder.put_batch(data.data(), data.size());
+        encoder.flush();
+
+        ForDecoder<T> decoder(buffer.data(), buffer.length());
+        ASSERT_TRUE(decoder.init());
+        std::vector<T> actual_result(data.size());
+        ASSERT_TRUE(decoder.get_batch(actual_result.data(), data.size()));
+        ASSERT_EQ(data, actual_result) << "bits=" << bits;
+    }
+}
+
+TEST_F(TestForCoding, TestRandomBitWidths) {
+    test_random_bit_widths<uint8_t>();
+    test_random_bit_widths<int16_t>();
+    test_random_bit_widths<uint32_t>();
+    test_random_bit_widths<int64_t>();
+    test_random_bit_widths<uint64_t>();
+}
+
 TEST_F(TestForCoding, TestOneMinValue) {
     faststring buffer(1);
     ForEncoder<int32_t> encoder(&buffer);
@@ -0,0 +1,59 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/io_latency_histogram.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(IOLatencyHistogramTest, test_bucket_of) {
+    ASSERT_EQ(0, IOLatencyHistogram::bucket_of(-1));
+    ASSERT_EQ(0, IOLatencyHistogram::bucket_of(0));
+    ASSERT_EQ(0, IOLatencyHistogram::bucket_of(999));
+    ASSERT_EQ(1, IOLatencyHistogram::bucket_of(1000));
+    ASSERT_EQ(1, IOLatencyHistogram::bucket_of(1999));
+    ASSERT_EQ(2, IOLatencyHistogram::bucket_of(2000));
+    ASSERT_EQ(2, IOLatencyHistogram::bucket_of(3999));
+    ASSERT_EQ(11, IOLatencyHistogram::bucket_of(1024 * 1000));
+    ASSERT_EQ(IOLatencyHistogram::NUM_BUCKETS - 1, IOLatencyHistogram::bucket_of(int64_t(1) << 40));
+
+    ASSERT_EQ("IOLatencyUnder1us", IOLatencyHistogram::bucket_name(0));
+    ASSERT_EQ("IOLatencyUnder4us", IOLatencyHistogram::bucket_name(2));
+    ASSERT_EQ("IOLatency262144usOrMore", IOLatencyHistogram::bucket_name(IOLatencyHistogram::NUM_BUCKETS - 1));
+}
+
+// NOLINTNEXTLINE
+TEST(IOLatencyHistogramTest, test_add_and_merge) {
+    IOLatencyHistogram h1;
+    h1.add(500);
+    h1.add(1500);
+    h1.add(1800);
+    IOLatencyHistogram h2;
+    h2.add(100);
+    h2.add(int64_t(10) * 1000 * 1000 * 1000);
+    h1.merge(h2);
+    ASSERT_EQ(2, h1.count(0));
+    ASSERT_EQ(2, h1.count(1));
+    ASSERT_EQ(1, h1.count(IOLatencyHistogram::NUM_BUCKETS - 1));
+    h1.clear();
+    for (int i = 0; i < IOLatencyHistogram::NUM_BUCKETS; i++) {
+        ASSERT_EQ(0, h1.count(i));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(IOLatencyHistogramTest, test_scoped_io_timer) {
+    int64_t io_ns = 0;
+    IOLatencyHistogram histogram;
+    { ScopedIOTimer timer(&io_ns, &histogram); }
+    { ScopedIOTimer timer(&io_ns, &histogram); }
+    ASSERT_GE(io_ns, 0);
+    int64_t total = 0;
+    for (int i = 0; i < IOLatencyHistogram::NUM_BUCKETS; i++) {
+        total += histogram.count(i);
+    }
+    ASSERT_EQ(2, total);
+}
+
+} // namespace starrocks
@@ -0,0 +1,46 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/load_stage_metrics.h"
+
+#include <gtest/gtest.h>
+
+#include "util/starrocks_metrics.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(LoadStageMetricsTest, test_stage_latency) {
+    auto* registry = StarRocksMetrics::instance()->metrics();
+    LoadStageMetrics::add(LoadStageMetrics::FLUSH, 0);
+    auto* count = static_cast<IntCounter*>(
+            registry->get_metric("load_stage_latency_us_count", MetricLabels().add("stage", "flush")));
+    ASSERT_NE(nullptr, count);
+    int64_t num_flushes = count->value();
+    auto* sum = static_cast<IntCounter*>(
+            registry->get_metric("load_stage_latency_us_sum", MetricLabels().add("stage", "flush")));
+    ASSERT_NE(nullptr, sum);
+    int64_t flush_us = sum->value();
+
+    LoadStageMetrics::add(LoadStageMetrics::FLUSH, 3000 * 1000);
+    ASSERT_EQ(num_flushes + 1, count->value());
+    ASSERT_EQ(flush_us + 3000, sum->value());
+
+    for (int i = 0; i < LoadStageMetrics::NUM_STAGES; i++) {
+        auto stage = static_cast<LoadStageMetrics::Stage>(i);
+        ASSERT_NE(nullptr, registry->get_metric("load_stage_latency_us_count",
+                                                MetricLabels().add("stage", LoadStageMetrics::name(stage))));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(LoadStageMetricsTest, test_kafka_partition_lag) {
+    auto* registry = StarRocksMetrics::instance()->metrics();
+    LoadStageMetrics::set_kafka_partition_lag("lag_test_topic", 1, 10);
+    LoadStageMetrics::set_kafka_partition_lag("lag_test_topic", 1, 5);
+    auto* lag = static_cast<IntGauge*>(registry->get_metric(
+            "routine_load_kafka_partition_lag", MetricLabels().add("topic", "lag_test_topic").add("partition", "1")));
+    ASSERT_NE(nullptr, lag);
+    ASSERT_EQ(5, lag->value());
+}
+
+} // namespace starrocks
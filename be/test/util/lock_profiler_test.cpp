@@ -0,0 +1,77 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/lock_profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "common/config.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(LockProfilerTest, test_site) {
+    LockSite* site = LockSite::get("lock_profiler_test_site");
+    ASSERT_EQ(site, LockSite::get("lock_profiler_test_site"));
+    ASSERT_EQ("lock_profiler_test_site", site->name());
+
+    auto sites = LockSite::all();
+    ASSERT_NE(sites.end(), std::find(sites.begin(), sites.end(), site));
+
+    site->add_contention(0, 0);
+    site->add_contention(100, 16);
+    site->add_contention(50, 16);
+    ASSERT_EQ(3, site->contentions());
+    ASSERT_EQ(150 * 16, site->wait_ns());
+    ASSERT_EQ(100, site->max_wait_ns());
+
+    auto* metric = StarRocksMetrics::instance()->metrics()->get_metric(
+            "lock_contentions_total", MetricLabels().add("lock", "lock_profiler_test_site"));
+    ASSERT_NE(nullptr, metric);
+    ASSERT_EQ("3", metric->to_string());
+}
+
+// NOLINTNEXTLINE
+TEST(LockProfilerTest, test_contention) {
+    int64_t old_period = config::lock_contention_sample_period;
+    config::lock_contention_sample_period = 1;
+    LockSite* site = LockSite::get("lock_profiler_test_contention");
+    ProfiledMutex mutex(site);
+
+    mutex.lock();
+    ASSERT_FALSE(mutex.try_lock());
+    std::thread waiter([&] { std::lock_guard<ProfiledMutex> l(mutex); });
+    // The waiter is contended unless it's scheduled after the unlock.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    mutex.unlock();
+    waiter.join();
+    ASSERT_LE(site->contentions(), 1);
+    ASSERT_LE(site->max_wait_ns(), site->wait_ns());
+
+    {
+        std::lock_guard<ProfiledMutex> l(mutex);
+    }
+    ASSERT_LE(site->contentions(), 1);
+    config::lock_contention_sample_period = old_period;
+}
+
+// NOLINTNEXTLINE
+TEST(LockProfilerTest, test_shared_mutex) {
+    LockSite* site = LockSite::get("lock_profiler_test_shared_mutex");
+    ProfiledSharedMutex mutex(site);
+
+    mutex.lock_shared();
+    ASSERT_TRUE(mutex.try_lock_shared());
+    ASSERT_FALSE(mutex.try_lock());
+    mutex.unlock_shared();
+    mutex.unlock_shared();
+    {
+        std::unique_lock l(mutex);
+    }
+    ASSERT_EQ(0, site->contentions());
+}
+
+} // namespace starrocks
@@ -0,0 +1,92 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/mpmc_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(BoundedMPMCQueueTest, test_basic) {
+    BoundedMPMCQueue<int32_t> queue(3);
+    ASSERT_EQ(4, queue.capacity());
+    ASSERT_TRUE(queue.empty());
+    for (int32_t i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.try_put(i));
+    }
+    ASSERT_TRUE(queue.full());
+    ASSERT_FALSE(queue.try_put(4));
+    ASSERT_EQ(4, queue.get_size());
+
+    int32_t v = -1;
+    for (int32_t i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.try_get(&v));
+        ASSERT_EQ(i, v);
+    }
+    ASSERT_FALSE(queue.try_get(&v));
+    ASSERT_TRUE(queue.empty());
+}
+
+// NOLINTNEXTLINE
+TEST(BoundedMPMCQueueTest, test_get_from_shutdown_queue) {
+    BoundedMPMCQueue<int64_t> queue(2);
+    ASSERT_TRUE(queue.blocking_put(123));
+    queue.shutdown();
+    ASSERT_FALSE(queue.blocking_put(456));
+    int64_t v = 0;
+    ASSERT_TRUE(queue.blocking_get(&v));
+    ASSERT_EQ(123, v);
+    ASSERT_FALSE(queue.blocking_get(&v));
+}
+
+// NOLINTNEXTLINE
+TEST(BoundedMPMCQueueTest, test_shutdown_wakes_up_getter) {
+    BoundedMPMCQueue<int32_t> queue(2);
+    std::thread getter([&]() {
+        int32_t v = 0;
+        ASSERT_FALSE(queue.blocking_get(&v));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.shutdown();
+    getter.join();
+}
+
+// NOLINTNEXTLINE
+TEST(BoundedMPMCQueueTest, test_multi_thread) {
+    constexpr int kThreads = 4;
+    constexpr int kIterations = 20000;
+    // Smaller than the items to make the producers wait as well.
+    BoundedMPMCQueue<int64_t> queue(16);
+    std::atomic<int> producers{kThreads};
+    std::vector<int64_t> sums(kThreads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 1; i <= kIterations; i++) {
+                ASSERT_TRUE(queue.blocking_put(i));
+            }
+            if (producers.fetch_sub(1) == 1) {
+                queue.shutdown();
+            }
+        });
+        threads.emplace_back([&, t]() {
+            int64_t v = 0;
+            while (queue.blocking_get(&v)) {
+                sums[t] += v;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    int64_t total = 0;
+    for (int64_t sum : sums) {
+        total += sum;
+    }
+    ASSERT_EQ(int64_t(kThreads) * kIterations * (kIterations + 1) / 2, total);
+}
+
+} // namespace starrocks
@@ -25,6 +25,7 @@
 #include <cstring>
 #include <limits>
 #include <ostream>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -465,4 +466,31 @@ TEST_F(TestRle, TestBatch) {
     ASSERT_EQ(1024, n);
 }
 
+// NOLINTNEXTLINE
+TEST_F(TestRle, TestBatchOfRunsAndLiterals) {
+    faststring buffer;
+    RleEncoder<uint64_t> encoder(&buffer, 35);
+    std::vector<uint64_t> values;
+    std::mt19937_64 rng(0);
+    for (int i = 0; i < 4096; ++i) {
+        uint64_t value = (i / 500) % 2 == 0 ? rng() & ((uint64_t(1) << 35) - 1) : 7;
+        values.push_back(value);
+        encoder.Put(value);
+    }
+    encoder.Flush();
+
+    // The batches are not aligned with the runs and the literal groups of 8 values.
+    RleDecoder<uint64_t> decoder(buffer.data(), buffer.size(), 35);
+    std::vector<uint64_t> actual(values.size());
+    size_t num_read = 0;
+    for (size_t batch = 1; num_read < values.size(); batch = batch * 3 % 97 + 1) {
+        size_t n = std::min(batch, values.size() - num_read);
+        ASSERT_EQ(n, decoder.GetBatch(actual.data() + num_read, n));
+        num_read += n;
+    }
+    ASSERT_EQ(values, actual);
+    uint64_t value;
+    ASSERT_EQ(0, decoder.GetBatch(&value, 1));
+}
+
 } // namespace starrocks
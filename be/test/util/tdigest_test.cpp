@@ -239,4 +239,27 @@ TEST_F(TDigestTest, Montonicity) {
     }
 }
 
+TEST_F(TDigestTest, BatchAdd) {
+    TDigest digest(100);
+    TDigest batch_digest(100);
+    std::vector<float> values;
+    for (int i = 0; i < 100000; ++i) {
+        values.push_back(i);
+        digest.add(i);
+    }
+    values.push_back(std::nanf(""));
+    batch_digest.add(values.data(), values.size());
+
+    EXPECT_EQ(digest.totalWeight(), batch_digest.totalWeight());
+    for (auto q : {0.0, 0.01, 0.5, 0.95, 0.99, 1.0}) {
+        EXPECT_NEAR(digest.quantile(q), batch_digest.quantile(q), 100) << "q = " << q;
+    }
+
+    std::vector<uint8_t> buf(batch_digest.serialize_size());
+    EXPECT_EQ(buf.size(), batch_digest.serialize(buf.data()));
+    TDigest deserialized(100);
+    deserialized.deserialize(reinterpret_cast<const char*>(buf.data()));
+    EXPECT_EQ(batch_digest.quantile(0.99), deserialized.quantile(0.99));
+}
+
 } // namespace starrocks
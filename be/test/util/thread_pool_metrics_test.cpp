@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/thread_pool_metrics.h"
+
+#include <gtest/gtest.h>
+
+#include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(ThreadPoolMetricsTest, test_latency_histogram) {
+    LatencyHistogramMetric histogram;
+    histogram.add(10 * 1000);
+    histogram.add(100 * 1000);
+    histogram.add(200 * 1000);
+    histogram.add(int64_t(100) * 1000 * 1000 * 1000);
+
+    ASSERT_EQ(4, histogram.count());
+    // <= 50us
+    ASSERT_EQ(1, histogram.bucket_count(0));
+    // <= 100us
+    ASSERT_EQ(2, histogram.bucket_count(1));
+    // <= 500us
+    ASSERT_EQ(3, histogram.bucket_count(2));
+    // <= 10s
+    ASSERT_EQ(3, histogram.bucket_count(LatencyHistogramMetric::NUM_BOUNDS - 1));
+    // +Inf
+    ASSERT_EQ(4, histogram.bucket_count(LatencyHistogramMetric::NUM_BOUNDS));
+}
+
+// NOLINTNEXTLINE
+TEST(ThreadPoolMetricsTest, test_thread_pool) {
+    std::unique_ptr<ThreadPool> pool;
+    ASSERT_TRUE(ThreadPoolBuilder("metrics_test_pool").set_max_threads(1).set_max_queue_size(1).build(&pool).ok());
+    auto* metrics = ThreadPoolMetrics::get("metrics_test_pool");
+    ASSERT_EQ(metrics, ThreadPoolMetrics::get("metrics_test_pool"));
+
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(pool->submit_func([] {}).ok());
+        pool->wait();
+    }
+    ASSERT_EQ(3, metrics->task_wait_time().count());
+    ASSERT_EQ(3, metrics->task_run_time().count());
+    ASSERT_EQ(0, metrics->active_threads());
+    ASSERT_EQ(0, metrics->queue_depth()->value());
+
+    pool->shutdown();
+    ASSERT_FALSE(pool->submit_func([] {}).ok());
+    ASSERT_EQ(1, metrics->rejected_tasks());
+
+    auto* registry = StarRocksMetrics::instance()->metrics();
+    ASSERT_NE(nullptr, registry->get_metric("thread_pool_rejected_tasks_total",
+                                            MetricLabels().add("pool", "metrics_test_pool")));
+    ASSERT_NE(nullptr, registry->get_metric("thread_pool_task_run_time_us_bucket",
+                                            MetricLabels().add("pool", "metrics_test_pool").add("le", "+Inf")));
+}
+
+} // namespace starrocks
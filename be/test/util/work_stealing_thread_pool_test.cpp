@@ -0,0 +1,97 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/work_stealing_thread_pool.h"
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(WorkStealingThreadPoolTest, test_run_all) {
+    WorkStealingThreadPool pool("work_stealing_test", 4, 1024);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 1000; i++) {
+        PriorityThreadPool::Task task;
+        task.priority = i % 21;
+        task.group_id = i % 3;
+        task.work_function = [&count]() { count++; };
+        ASSERT_TRUE(pool.offer(task));
+    }
+    while (count.load() < 1000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(0, pool.get_queue_size());
+    pool.shutdown();
+    pool.join();
+    ASSERT_FALSE(pool.offer([]() {}));
+}
+
+// NOLINTNEXTLINE
+TEST(WorkStealingThreadPoolTest, test_queue_full) {
+    WorkStealingThreadPool pool("work_stealing_test", 1, 2);
+    std::mutex lock;
+    std::condition_variable cv;
+    bool started = false;
+    bool release = false;
+    ASSERT_TRUE(pool.offer([&]() {
+        std::unique_lock<std::mutex> l(lock);
+        started = true;
+        cv.notify_all();
+        cv.wait(l, [&]() { return release; });
+    }));
+    {
+        std::unique_lock<std::mutex> l(lock);
+        cv.wait(l, [&]() { return started; });
+    }
+    PriorityThreadPool::Task task{0, []() {}};
+    ASSERT_TRUE(pool.try_offer(task));
+    ASSERT_TRUE(pool.try_offer(task));
+    ASSERT_FALSE(pool.try_offer(task));
+    {
+        std::lock_guard<std::mutex> l(lock);
+        release = true;
+    }
+    cv.notify_all();
+    ASSERT_TRUE(pool.offer(task));
+}
+
+// The tasks of a group offered first don't delay those of the other group until they all finish.
+// NOLINTNEXTLINE
+TEST(WorkStealingThreadPoolTest, test_groups_round_robin) {
+    WorkStealingThreadPool pool("work_stealing_test", 1, 1024);
+    std::mutex lock;
+    std::condition_variable cv;
+    bool release = false;
+    std::vector<uint64_t> order;
+    ASSERT_TRUE(pool.offer([&]() {
+        std::unique_lock<std::mutex> l(lock);
+        cv.wait(l, [&]() { return release; });
+    }));
+    for (uint64_t group_id : {1, 1, 1, 1, 2, 2}) {
+        PriorityThreadPool::Task task;
+        task.group_id = group_id;
+        task.work_function = [&order, &lock, group_id]() {
+            std::lock_guard<std::mutex> l(lock);
+            order.push_back(group_id);
+        };
+        ASSERT_TRUE(pool.offer(task));
+    }
+    {
+        std::lock_guard<std::mutex> l(lock);
+        release = true;
+    }
+    cv.notify_all();
+    while (pool.get_queue_size() > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    pool.shutdown();
+    pool.join();
+    ASSERT_EQ(6, order.size());
+    ASSERT_EQ((std::vector<uint64_t>{1, 2, 1, 2, 1, 1}), order);
+}
+
+} // namespace starrocks
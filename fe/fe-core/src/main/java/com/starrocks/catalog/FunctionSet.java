@@ -81,6 +81,7 @@ public class FunctionSet {
     public static final String LAG = "LAG";
     public static final String FIRST_VALUE = "FIRST_VALUE";
     public static final String LAST_VALUE = "LAST_VALUE";
+    public static final String ROW_NUMBER = "ROW_NUMBER";
 
     // Scalar functions:
     public static final String HLL_HASH = "hll_hash";
@@ -8,13 +8,20 @@ public class HdfsFileDesc {
     private String fileName;
     private String compression;
     private long length;
+    private long modificationTime;
     private ImmutableList<HdfsFileBlockDesc> blockDescs;
 
     public HdfsFileDesc(String fileName, String compression, long length,
                         ImmutableList<HdfsFileBlockDesc> blockDescs) {
+        this(fileName, compression, length, 0, blockDescs);
+    }
+
+    public HdfsFileDesc(String fileName, String compression, long length, long modificationTime,
+                        ImmutableList<HdfsFileBlockDesc> blockDescs) {
         this.fileName = fileName;
         this.compression = compression;
         this.length = length;
+        this.modificationTime = modificationTime;
         this.blockDescs = blockDescs;
     }
 
@@ -30,6 +37,10 @@ public class HdfsFileDesc {
         return length;
     }
 
+    public long getModificationTime() {
+        return modificationTime;
+    }
+
     public ImmutableList<HdfsFileBlockDesc> getBlockDescs() {
         return blockDescs;
     }
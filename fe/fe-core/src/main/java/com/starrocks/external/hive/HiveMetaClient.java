@@ -454,7 +454,8 @@ public class HiveMetaClient {
             String fileName = Utils.getSuffixName(dirPath, fileStatus.getPath().toString());
             BlockLocation[] blockLocations = fileSystem.getFileBlockLocations(fileStatus, 0, fileStatus.getLen());
             List<HdfsFileBlockDesc> fileBlockDescs = getHdfsFileBlockDescs(blockLocations);
-            fileDescs.add(new HdfsFileDesc(fileName, "", fileStatus.getLen(), ImmutableList.copyOf(fileBlockDescs)));
+            fileDescs.add(new HdfsFileDesc(fileName, "", fileStatus.getLen(), fileStatus.getModificationTime(),
+                    ImmutableList.copyOf(fileBlockDescs)));
         }
         return fileDescs;
     }
@@ -374,6 +374,9 @@ public class HdfsScanNode extends ScanNode {
         hdfsScanRange.setLength(blockDesc.getLength());
         hdfsScanRange.setPartition_id(partitionId);
         hdfsScanRange.setFile_length(fileDesc.getLength());
+        if (fileDesc.getModificationTime() > 0) {
+            hdfsScanRange.setModification_time(fileDesc.getModificationTime());
+        }
         hdfsScanRange.setFile_format(fileFormat.toThrift());
         TScanRange scanRange = new TScanRange();
         scanRange.setHdfs_scan_range(hdfsScanRange);
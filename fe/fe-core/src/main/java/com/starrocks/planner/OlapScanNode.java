@@ -120,6 +120,9 @@ public class OlapScanNode extends ScanNode {
     private Collection<Long> selectedPartitionIds = Lists.newArrayList();
     private long totalBytes = 0;
     private long actualRows = 0;
+    // If not null, the rows are generated from the segment metadata where possible, which is only valid for
+    // count(*), and min and max of these columns.
+    private List<String> metadataMinMaxColumns = null;
 
     // List of tablets will be scanned by current olap_scan_node
     private ArrayList<Long> scanTabletIds = Lists.newArrayList();
@@ -150,6 +153,14 @@ public class OlapScanNode extends ScanNode {
         return isPreAggregation;
     }
 
+    public void setMetadataScan(List<String> minMaxColumns) {
+        this.metadataMinMaxColumns = minMaxColumns;
+    }
+
+    public boolean isMetadataScan() {
+        return metadataMinMaxColumns != null;
+    }
+
     public boolean getCanTurnOnPreAggr() {
         return canTurnOnPreAggr;
     }
@@ -681,6 +692,10 @@ public class OlapScanNode extends ScanNode {
         if (null != sortColumn) {
             msg.olap_scan_node.setSort_column(sortColumn);
         }
+        if (metadataMinMaxColumns != null) {
+            msg.olap_scan_node.setMetadata_scan(true);
+            msg.olap_scan_node.setMetadata_min_max_columns(metadataMinMaxColumns);
+        }
     }
 
     // export some tablets
@@ -43,6 +43,7 @@ import org.apache.logging.log4j.Logger;
 
 import java.util.Iterator;
 import java.util.List;
+import java.util.stream.Collectors;
 
 /**
  * Sorting.
@@ -54,6 +55,9 @@ public class SortNode extends PlanNode {
     private final boolean isDefaultLimit;
 
     private long offset;
+    // If not empty, only the first partitionLimit rows of every partition are output, without being sorted.
+    private List<Expr> partitionExprs = Lists.newArrayList();
+    private long partitionLimit = -1;
     // if true, the output of this node feeds an AnalyticNode
     private boolean isAnalyticSort;
 
@@ -102,6 +106,8 @@ public class SortNode extends PlanNode {
         this.isDefaultLimit = inputSortNode.isDefaultLimit;
         this.children.add(child);
         this.offset = inputSortNode.offset;
+        this.partitionExprs = inputSortNode.partitionExprs;
+        this.partitionLimit = inputSortNode.partitionLimit;
     }
 
     public long getOffset() {
@@ -116,6 +122,12 @@ public class SortNode extends PlanNode {
         return info;
     }
 
+    public void setPartitionTopN(List<Expr> partitionExprs, long partitionLimit) {
+        this.partitionExprs = partitionExprs;
+        this.partitionLimit = partitionLimit;
+        setPlanNodeName("PARTITION-TOP-N");
+    }
+
     @Override
     public void getMaterializedIds(Analyzer analyzer, List<SlotId> ids) {
         super.getMaterializedIds(analyzer, ids);
@@ -168,6 +180,10 @@ public class SortNode extends PlanNode {
             msg.sort_node.setSort_tuple_slot_exprs(Expr.treesToThrift(info.getSortTupleSlotExprs()));
         }
         msg.sort_node.setHas_outer_join_child(hasNullableGenerateChild);
+        if (!partitionExprs.isEmpty()) {
+            msg.sort_node.setPartition_exprs(Expr.treesToThrift(partitionExprs));
+            msg.sort_node.setPartition_limit(partitionLimit);
+        }
         // For profile printing `SortKeys`
         Iterator<Expr> expr = info.getOrderingExprs().iterator();
         Iterator<Boolean> direction = info.getIsAscOrder().iterator();
@@ -205,6 +221,14 @@ public class SortNode extends PlanNode {
             output.append(isAsc.next() ? "ASC" : "DESC");
         }
         output.append("\n");
+        if (!partitionExprs.isEmpty()) {
+            output.append(detailPrefix).append("partition by: ");
+            output.append(partitionExprs.stream()
+                    .map(e -> detailLevel.equals(TExplainLevel.NORMAL) ? e.toSql() : e.explain())
+                    .collect(Collectors.joining(", ")));
+            output.append("\n");
+            output.append(detailPrefix).append("partition limit: ").append(partitionLimit).append("\n");
+        }
         output.append(detailPrefix).append("offset: ").append(offset).append("\n");
         return output.toString();
     }
@@ -122,6 +122,8 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
 
     public static final String PIPELINE_SCAN_MODE = "pipeline_scan_mode";
 
+    public static final String RESOURCE_GROUP = "resource_group";
+
     // vectorized insert flag
     public static final String ENABLE_VECTORIZED_INSERT = "enable_vectorized_insert";
 
@@ -153,6 +155,9 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     public static final String ENABLE_NEW_PLANNER_PUSH_DOWN_JOIN_TO_AGG =
             "enable_new_planner_push_down_join_to_agg";
     public static final String NEW_PLANER_AGG_STAGE = "new_planner_agg_stage";
+    public static final String ENABLE_BITMAP_COUNT_DISTINCT = "enable_bitmap_count_distinct";
+    public static final String ENABLE_PARTITION_TOPN = "enable_partition_topn";
+    public static final String ENABLE_METADATA_SCAN = "enable_metadata_scan";
     public static final String BROADCAST_ROW_LIMIT = "broadcast_row_limit";
     public static final String NEW_PLANNER_OPTIMIZER_TIMEOUT = "new_planner_optimize_timeout";
     public static final String ENABLE_GROUPBY_USE_OUTPUT_ALIAS = "enable_groupby_use_output_alias";
@@ -298,7 +303,7 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     private boolean disableStreamPreaggregations = false;
 
     @VariableMgr.VarAttr(name = STREAMING_PREAGGREGATION_MODE)
-    private String streamingPreaggregationMode = "auto"; // auto, force_streaming, force_preaggregation
+    private String streamingPreaggregationMode = "auto"; // auto, force_streaming, force_preaggregation, adaptive
 
     @VariableMgr.VarAttr(name = DISABLE_COLOCATE_JOIN)
     private boolean disableColocateJoin = false;
@@ -320,6 +325,10 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     @VariableMgr.VarAttr(name = PIPELINE_SCAN_MODE)
     private int pipelineScanMode = 1;
 
+    // The resource group of the queries in the pipeline engine, empty means the default group.
+    @VariableMgr.VarAttr(name = RESOURCE_GROUP)
+    private String resourceGroup = "";
+
     @VariableMgr.VarAttr(name = ENABLE_INSERT_STRICT)
     private boolean enableInsertStrict = true;
 
@@ -409,6 +418,22 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     @VariableMgr.VarAttr(name = NEW_PLANER_AGG_STAGE)
     private int new_planner_agg_stage = 0;
 
+    // if true, count(distinct) of an integer column is computed by bitmap_union_int, whose intermediate
+    // state is a roaring bitmap rather than a hash set, so it's much smaller to shuffle and cheaper to merge
+    // if the distinct values are dense.
+    @VariableMgr.VarAttr(name = ENABLE_BITMAP_COUNT_DISTINCT)
+    private boolean enableBitmapCountDistinct = false;
+
+    // if true, the first K rows of every partition are kept by a partition top-n below the window of
+    // row_number() <= K, so that the other rows aren't shuffled and sorted by the window.
+    @VariableMgr.VarAttr(name = ENABLE_PARTITION_TOPN)
+    private boolean enablePartitionTopN = true;
+
+    // if true, count(*), min and max without group by on a duplicate or primary keys table without predicates
+    // are computed from the row counts and zone maps of the segments instead of their data pages.
+    @VariableMgr.VarAttr(name = ENABLE_METADATA_SCAN)
+    private boolean enableMetadataScan = true;
+
     @VariableMgr.VarAttr(name = TRANSMISSION_COMPRESSION_TYPE)
     private String transmission_compression_type = "LZ4";
 
@@ -703,6 +728,30 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
         this.new_planner_agg_stage = stage;
     }
 
+    public boolean isEnableBitmapCountDistinct() {
+        return enableBitmapCountDistinct;
+    }
+
+    public void setEnableBitmapCountDistinct(boolean enableBitmapCountDistinct) {
+        this.enableBitmapCountDistinct = enableBitmapCountDistinct;
+    }
+
+    public boolean isEnablePartitionTopN() {
+        return enablePartitionTopN;
+    }
+
+    public void setEnablePartitionTopN(boolean enablePartitionTopN) {
+        this.enablePartitionTopN = enablePartitionTopN;
+    }
+
+    public boolean isEnableMetadataScan() {
+        return enableMetadataScan;
+    }
+
+    public void setEnableMetadataScan(boolean enableMetadataScan) {
+        this.enableMetadataScan = enableMetadataScan;
+    }
+
     public void setMaxTransformReorderJoins(int maxReorderNodeUseExhaustive) {
         this.cboMaxReorderNodeUseExhaustive = maxReorderNodeUseExhaustive;
     }
@@ -779,6 +828,9 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
         tResult.setRuntime_filter_send_timeout_ms(global_runtime_filter_rpc_timeout);
         tResult.setQuery_threads(pipelineQueryThreads);
         tResult.setPipeline_scan_mode(pipelineScanMode);
+        if (resourceGroup != null && !resourceGroup.isEmpty()) {
+            tResult.setResource_group(resourceGroup);
+        }
         return tResult;
     }
 
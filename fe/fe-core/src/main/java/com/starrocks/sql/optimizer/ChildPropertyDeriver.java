@@ -590,6 +590,11 @@ public class ChildPropertyDeriver extends OperatorVisitor<Void, ExpressionContex
     @Override
     public Void visitPhysicalTopN(PhysicalTopNOperator topN, ExpressionContext context) {
         if (getRequiredLocalDesc().isPresent()) {
+            // The partition top-n below a colocate window keeps the distribution of its child
+            if (topN.isPartitionTopN()) {
+                outputInputProps.add(new Pair<>(distributeRequirements(),
+                        Lists.newArrayList(distributeRequirements())));
+            }
             return visitOperator(topN, context);
         }
 
@@ -9,7 +9,9 @@ import com.starrocks.sql.optimizer.base.Ordering;
 import com.starrocks.sql.optimizer.operator.OperatorType;
 import com.starrocks.sql.optimizer.operator.OperatorVisitor;
 import com.starrocks.sql.optimizer.operator.SortPhase;
+import com.starrocks.sql.optimizer.operator.scalar.ColumnRefOperator;
 
+import java.util.Collections;
 import java.util.List;
 import java.util.Objects;
 
@@ -20,12 +22,19 @@ public class LogicalTopNOperator extends LogicalOperator {
     private final SortPhase sortPhase;
     private boolean isSplit = false;
 
+    // If partitionByColumns is not empty, only the first partitionLimit rows of every partition are kept,
+    // and the output isn't sorted.
+    private final List<ColumnRefOperator> partitionByColumns;
+    private final long partitionLimit;
+
     public LogicalTopNOperator(List<Ordering> orderByElements) {
         super(OperatorType.LOGICAL_TOPN);
         this.orderByElements = orderByElements;
         this.limit = -1;
         this.offset = 0;
         this.sortPhase = SortPhase.FINAL;
+        this.partitionByColumns = Collections.emptyList();
+        this.partitionLimit = -1;
     }
 
     public LogicalTopNOperator(List<Ordering> orderByElements, long limit, long offset) {
@@ -34,6 +43,8 @@ public class LogicalTopNOperator extends LogicalOperator {
         this.limit = limit;
         this.offset = offset;
         this.sortPhase = SortPhase.FINAL;
+        this.partitionByColumns = Collections.emptyList();
+        this.partitionLimit = -1;
     }
 
     public LogicalTopNOperator(List<Ordering> orderByElements, long limit, long offset,
@@ -43,6 +54,20 @@ public class LogicalTopNOperator extends LogicalOperator {
         this.limit = limit;
         this.offset = offset;
         this.sortPhase = sortPhase;
+        this.partitionByColumns = Collections.emptyList();
+        this.partitionLimit = -1;
+    }
+
+    // The partition top-n computed below the window of row_number() <= partitionLimit
+    public LogicalTopNOperator(List<ColumnRefOperator> partitionByColumns, long partitionLimit,
+                               List<Ordering> orderByElements) {
+        super(OperatorType.LOGICAL_TOPN);
+        this.orderByElements = orderByElements;
+        this.limit = -1;
+        this.offset = 0;
+        this.sortPhase = SortPhase.PARTIAL;
+        this.partitionByColumns = partitionByColumns;
+        this.partitionLimit = partitionLimit;
     }
 
     public SortPhase getSortPhase() {
@@ -57,11 +82,26 @@ public class LogicalTopNOperator extends LogicalOperator {
         isSplit = true;
     }
 
+    public List<ColumnRefOperator> getPartitionByColumns() {
+        return partitionByColumns;
+    }
+
+    public long getPartitionLimit() {
+        return partitionLimit;
+    }
+
+    public boolean isPartitionTopN() {
+        return !partitionByColumns.isEmpty();
+    }
+
     public ColumnRefSet getRequiredChildInputColumns() {
         ColumnRefSet columns = new ColumnRefSet();
         for (Ordering ordering : orderByElements) {
             columns.union(ordering.getColumnRef());
         }
+        for (ColumnRefOperator partitionByColumn : partitionByColumns) {
+            columns.union(partitionByColumn);
+        }
         return columns;
     }
 
@@ -86,7 +126,7 @@ public class LogicalTopNOperator extends LogicalOperator {
 
     @Override
     public int hashCode() {
-        return Objects.hash(sortPhase, orderByElements, limit, offset);
+        return Objects.hash(sortPhase, orderByElements, limit, offset, partitionByColumns, partitionLimit);
     }
 
     @Override
@@ -102,8 +142,10 @@ public class LogicalTopNOperator extends LogicalOperator {
 
         return limit == rhs.limit &&
                 offset == rhs.offset &&
+                partitionLimit == rhs.partitionLimit &&
                 sortPhase.equals(rhs.sortPhase) &&
-                orderByElements.equals(rhs.orderByElements);
+                orderByElements.equals(rhs.orderByElements) &&
+                partitionByColumns.equals(rhs.partitionByColumns);
     }
 
     @Override
@@ -8,7 +8,10 @@ import com.starrocks.sql.optimizer.base.OrderSpec;
 import com.starrocks.sql.optimizer.operator.OperatorType;
 import com.starrocks.sql.optimizer.operator.OperatorVisitor;
 import com.starrocks.sql.optimizer.operator.SortPhase;
+import com.starrocks.sql.optimizer.operator.scalar.ColumnRefOperator;
 
+import java.util.Collections;
+import java.util.List;
 import java.util.Objects;
 
 public class PhysicalTopNOperator extends PhysicalOperator {
@@ -18,17 +21,31 @@ public class PhysicalTopNOperator extends PhysicalOperator {
 
     private boolean isEnforced;
 
+    private final List<ColumnRefOperator> partitionByColumns;
+    private final long partitionLimit;
+
     // If limit is -1, means global sort
     public PhysicalTopNOperator(OrderSpec spec, long limit, long offset,
                                 SortPhase sortPhase,
                                 boolean isSplit,
                                 boolean isEnforced) {
+        this(spec, limit, offset, sortPhase, isSplit, isEnforced, Collections.emptyList(), -1);
+    }
+
+    public PhysicalTopNOperator(OrderSpec spec, long limit, long offset,
+                                SortPhase sortPhase,
+                                boolean isSplit,
+                                boolean isEnforced,
+                                List<ColumnRefOperator> partitionByColumns,
+                                long partitionLimit) {
         super(OperatorType.PHYSICAL_TOPN, spec);
         this.limit = limit;
         this.offset = offset;
         this.sortPhase = sortPhase;
         this.isSplit = isSplit;
         this.isEnforced = isEnforced;
+        this.partitionByColumns = partitionByColumns;
+        this.partitionLimit = partitionLimit;
     }
 
     public SortPhase getSortPhase() {
@@ -47,9 +64,21 @@ public class PhysicalTopNOperator extends PhysicalOperator {
         return isEnforced;
     }
 
+    public List<ColumnRefOperator> getPartitionByColumns() {
+        return partitionByColumns;
+    }
+
+    public long getPartitionLimit() {
+        return partitionLimit;
+    }
+
+    public boolean isPartitionTopN() {
+        return !partitionByColumns.isEmpty();
+    }
+
     @Override
     public int hashCode() {
-        return Objects.hash(sortPhase, orderSpec);
+        return Objects.hash(sortPhase, orderSpec, partitionByColumns, partitionLimit);
     }
 
     @Override
@@ -63,8 +92,10 @@ public class PhysicalTopNOperator extends PhysicalOperator {
             return true;
         }
 
-        return sortPhase.equals(rhs.sortPhase) &&
-                orderSpec.equals(rhs.orderSpec);
+        return partitionLimit == rhs.partitionLimit &&
+                sortPhase.equals(rhs.sortPhase) &&
+                orderSpec.equals(rhs.orderSpec) &&
+                partitionByColumns.equals(rhs.partitionByColumns);
     }
 
     @Override
@@ -67,6 +67,7 @@ import com.starrocks.sql.optimizer.rule.transformation.PushDownJoinOnClauseRule;
 import com.starrocks.sql.optimizer.rule.transformation.PushDownLimitDirectRule;
 import com.starrocks.sql.optimizer.rule.transformation.PushDownLimitJoinRule;
 import com.starrocks.sql.optimizer.rule.transformation.PushDownLimitUnionRule;
+import com.starrocks.sql.optimizer.rule.transformation.PushDownPartitionTopNRule;
 import com.starrocks.sql.optimizer.rule.transformation.PushDownPredicateAggRule;
 import com.starrocks.sql.optimizer.rule.transformation.PushDownPredicateDirectRule;
 import com.starrocks.sql.optimizer.rule.transformation.PushDownPredicateExceptRule;
@@ -178,6 +179,7 @@ public class RuleSet {
                 PushDownPredicateScanRule.ES_SCAN,
                 new PushDownPredicateAggRule(),
                 new PushDownPredicateWindowRule(),
+                new PushDownPartitionTopNRule(),
                 new PushDownPredicateJoinRule(),
                 new PushDownJoinOnClauseRule(),
                 new PushDownPredicateProjectRule(),
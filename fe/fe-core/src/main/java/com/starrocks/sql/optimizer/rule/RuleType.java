@@ -35,6 +35,7 @@ public enum RuleType {
     TF_PUSH_DOWN_PREDICATE_INTERSECT,
     TF_PUSH_DOWN_PREDICATE_VALUES,
     TF_PUSH_DOWN_PREDICATE_TABLE_FUNCTION,
+    TF_PUSH_DOWN_PARTITION_TOPN,
     TF_MERGE_PREDICATE_SCAN,
     TF_MERGE_TWO_FILTERS,
     TF_CAST_TO_EMPTY,
@@ -30,7 +30,9 @@ public class TopNImplementationRule extends ImplementationRule {
                         logicalTopN.getOffset(),
                         logicalTopN.getSortPhase(),
                         logicalTopN.isSplit(),
-                        false);
+                        false,
+                        logicalTopN.getPartitionByColumns(),
+                        logicalTopN.getPartitionLimit());
         return Lists.newArrayList(OptExpression.create(physicalTopN, input.getInputs()));
     }
 }
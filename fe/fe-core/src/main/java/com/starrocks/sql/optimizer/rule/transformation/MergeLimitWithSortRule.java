@@ -21,7 +21,7 @@ public class MergeLimitWithSortRule extends TransformationRule {
 
     public boolean check(final OptExpression input, OptimizerContext context) {
         LogicalTopNOperator topN = (LogicalTopNOperator) input.getInputs().get(0).getOp();
-        return !topN.hasLimit();
+        return !topN.hasLimit() && !topN.isPartitionTopN();
     }
 
     @Override
@@ -0,0 +1,142 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+package com.starrocks.sql.optimizer.rule.transformation;
+
+import com.google.common.collect.Lists;
+import com.starrocks.catalog.FunctionSet;
+import com.starrocks.sql.optimizer.OptExpression;
+import com.starrocks.sql.optimizer.OptimizerContext;
+import com.starrocks.sql.optimizer.Utils;
+import com.starrocks.sql.optimizer.operator.OperatorType;
+import com.starrocks.sql.optimizer.operator.logical.LogicalFilterOperator;
+import com.starrocks.sql.optimizer.operator.logical.LogicalTopNOperator;
+import com.starrocks.sql.optimizer.operator.logical.LogicalWindowOperator;
+import com.starrocks.sql.optimizer.operator.pattern.Pattern;
+import com.starrocks.sql.optimizer.operator.scalar.BinaryPredicateOperator;
+import com.starrocks.sql.optimizer.operator.scalar.CallOperator;
+import com.starrocks.sql.optimizer.operator.scalar.ColumnRefOperator;
+import com.starrocks.sql.optimizer.operator.scalar.ConstantOperator;
+import com.starrocks.sql.optimizer.operator.scalar.ScalarOperator;
+import com.starrocks.sql.optimizer.rule.RuleType;
+
+import java.util.List;
+import java.util.stream.Collectors;
+
+/*
+ * For the filter row_number() <= K of a window partitioned by some columns, only the first K rows of
+ * every partition are needed by the window. So a partition top-n, which keeps the first K rows of every
+ * partition, is put below the window to discard the other rows before they are shuffled and sorted.
+ *
+ * Filter(rn <= K)                    Filter(rn <= K)
+ *       |                                  |
+ * Window(rn = row_number())   =>   Window(rn = row_number())
+ *       |                                  |
+ *     Child                        PartitionTopN(K)
+ *                                          |
+ *                                        Child
+ *
+ * The filter is kept, because the partition top-n is computed by every instance without shuffling.
+ */
+public class PushDownPartitionTopNRule extends TransformationRule {
+    public PushDownPartitionTopNRule() {
+        super(RuleType.TF_PUSH_DOWN_PARTITION_TOPN,
+                Pattern.create(OperatorType.LOGICAL_FILTER).
+                        addChildren(Pattern.create(OperatorType.LOGICAL_WINDOW, OperatorType.PATTERN_LEAF)));
+    }
+
+    @Override
+    public boolean check(final OptExpression input, OptimizerContext context) {
+        if (!context.getSessionVariable().isEnablePartitionTopN()) {
+            return false;
+        }
+
+        LogicalWindowOperator windowOperator = (LogicalWindowOperator) input.inputAt(0).getOp();
+        // Other window functions of the window need all the rows of the partitions
+        if (windowOperator.getWindowCall().size() != 1 || windowOperator.getPartitionExpressions().isEmpty() ||
+                windowOperator.getOrderByElements().isEmpty()) {
+            return false;
+        }
+        CallOperator windowCall = windowOperator.getWindowCall().values().iterator().next();
+        if (!windowCall.getFnName().equalsIgnoreCase(FunctionSet.ROW_NUMBER)) {
+            return false;
+        }
+
+        // Has been pushed down
+        OptExpression child = input.inputAt(0).inputAt(0);
+        if (child.getOp() instanceof LogicalTopNOperator && ((LogicalTopNOperator) child.getOp()).isPartitionTopN()) {
+            return false;
+        }
+        return getPartitionLimit(input) > 0;
+    }
+
+    @Override
+    public List<OptExpression> transform(OptExpression input, OptimizerContext context) {
+        OptExpression windowExpr = input.inputAt(0);
+        LogicalWindowOperator windowOperator = (LogicalWindowOperator) windowExpr.getOp();
+
+        List<ColumnRefOperator> partitionByColumns = windowOperator.getPartitionExpressions().stream()
+                .map(e -> (ColumnRefOperator) e).collect(Collectors.toList());
+        LogicalTopNOperator partitionTopN = new LogicalTopNOperator(partitionByColumns, getPartitionLimit(input),
+                windowOperator.getOrderByElements());
+
+        OptExpression partitionTopNExpr = OptExpression.create(partitionTopN, windowExpr.getInputs());
+        OptExpression newWindowExpr = OptExpression.create(windowOperator, partitionTopNExpr);
+        return Lists.newArrayList(OptExpression.create(input.getOp(), newWindowExpr));
+    }
+
+    // The min K of the predicates row_number() <, <= or = K, -1 if there isn't any
+    private static long getPartitionLimit(OptExpression input) {
+        LogicalFilterOperator filterOperator = (LogicalFilterOperator) input.getOp();
+        LogicalWindowOperator windowOperator = (LogicalWindowOperator) input.inputAt(0).getOp();
+        ColumnRefOperator rowNumber = windowOperator.getWindowCall().keySet().iterator().next();
+
+        long partitionLimit = -1;
+        for (ScalarOperator conjunct : Utils.extractConjuncts(filterOperator.getPredicate())) {
+            if (!(conjunct instanceof BinaryPredicateOperator)) {
+                continue;
+            }
+            BinaryPredicateOperator predicate = (BinaryPredicateOperator) conjunct;
+            if (predicate.getChild(1).equals(rowNumber)) {
+                predicate = predicate.negative();
+            }
+            if (!predicate.getChild(0).equals(rowNumber) || !(predicate.getChild(1) instanceof ConstantOperator)) {
+                continue;
+            }
+
+            ConstantOperator constant = (ConstantOperator) predicate.getChild(1);
+            if (constant.isNull() || !constant.getType().isIntegerType()) {
+                continue;
+            }
+            long value = getIntegerValue(constant);
+            long limit;
+            switch (predicate.getBinaryType()) {
+                case EQ:
+                case LE:
+                    limit = value;
+                    break;
+                case LT:
+                    limit = value - 1;
+                    break;
+                default:
+                    continue;
+            }
+            // row_number() <= 0 is left to the filter
+            if (limit > 0) {
+                partitionLimit = partitionLimit == -1 ? limit : Math.min(partitionLimit, limit);
+            }
+        }
+        return partitionLimit;
+    }
+
+    private static long getIntegerValue(ConstantOperator constant) {
+        switch (constant.getType().getPrimitiveType()) {
+            case TINYINT:
+                return constant.getTinyInt();
+            case SMALLINT:
+                return constant.getSmallint();
+            case INT:
+                return constant.getInt();
+            default:
+                return constant.getBigint();
+        }
+    }
+}
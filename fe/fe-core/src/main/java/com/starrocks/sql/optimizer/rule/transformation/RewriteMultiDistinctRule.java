@@ -143,13 +143,14 @@ public class RewriteMultiDistinctRule extends TransformationRule {
     }
 
     private CallOperator buildMultiCountDistinct(CallOperator oldFunctionCall) {
-        Function searchDesc = new Function(new FunctionName(FunctionSet.MULTI_DISTINCT_COUNT),
+        String fnName = SplitAggregateRule.useBitmapCountDistinct(oldFunctionCall) ?
+                FunctionSet.BITMAP_UNION_INT : FunctionSet.MULTI_DISTINCT_COUNT;
+        Function searchDesc = new Function(new FunctionName(fnName),
                 oldFunctionCall.getFunction().getArgs(), Type.INVALID, false);
         Function fn = Catalog.getCurrentCatalog().getFunction(searchDesc, IS_NONSTRICT_SUPERTYPE_OF);
 
         return (CallOperator) scalarRewriter.rewrite(
-                new CallOperator(FunctionSet.MULTI_DISTINCT_COUNT, fn.getReturnType(), oldFunctionCall.getChildren(),
-                        fn),
+                new CallOperator(fnName, fn.getReturnType(), oldFunctionCall.getChildren(), fn),
                 DEFAULT_TYPE_CAST_RULE);
     }
 
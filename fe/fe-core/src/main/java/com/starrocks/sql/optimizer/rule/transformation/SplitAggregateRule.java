@@ -207,9 +207,21 @@ public class SplitAggregateRule extends TransformationRule {
         return implementTwoStageAgg(input, operator);
     }
 
+    // count(distinct) of an integer column could be computed by bitmap_union_int, whose intermediate
+    // roaring bitmap is much smaller to shuffle than the hash set of multi_distinct_count.
+    static boolean useBitmapCountDistinct(CallOperator fnCall) {
+        return ConnectContext.get() != null &&
+                ConnectContext.get().getSessionVariable().isEnableBitmapCountDistinct() &&
+                fnCall.getChildren().size() == 1 && fnCall.getChild(0).getType().isIntegerType();
+    }
+
     private CallOperator rewriteDistinctAggFn(CallOperator fnCall) {
         final String functionName = fnCall.getFnName();
-        if (functionName.equalsIgnoreCase(FunctionSet.COUNT)) {
+        if (functionName.equalsIgnoreCase(FunctionSet.COUNT) && useBitmapCountDistinct(fnCall)) {
+            return new CallOperator(FunctionSet.BITMAP_UNION_INT, fnCall.getType(), fnCall.getChildren(),
+                    Expr.getBuiltinFunction(FunctionSet.BITMAP_UNION_INT, new Type[] {fnCall.getChild(0).getType()},
+                            IS_NONSTRICT_SUPERTYPE_OF), false);
+        } else if (functionName.equalsIgnoreCase(FunctionSet.COUNT)) {
             return new CallOperator("MULTI_DISTINCT_COUNT", fnCall.getType(), fnCall.getChildren(),
                     Expr.getBuiltinFunction("MULTI_DISTINCT_COUNT", new Type[] {fnCall.getChild(0).getType()},
                             IS_NONSTRICT_SUPERTYPE_OF), false);
@@ -914,21 +914,32 @@ public class StatisticsCalculator extends OperatorVisitor<Void, ExpressionContex
 
     @Override
     public Void visitLogicalTopN(LogicalTopNOperator node, ExpressionContext context) {
-        return computeTopNNode(context, node);
+        return computeTopNNode(context, node, node.getPartitionByColumns(), node.getPartitionLimit());
     }
 
     @Override
     public Void visitPhysicalTopN(PhysicalTopNOperator node, ExpressionContext context) {
-        return computeTopNNode(context, node);
+        return computeTopNNode(context, node, node.getPartitionByColumns(), node.getPartitionLimit());
     }
 
-    private Void computeTopNNode(ExpressionContext context, Operator node) {
+    private Void computeTopNNode(ExpressionContext context, Operator node,
+                                 List<ColumnRefOperator> partitionByColumns, long partitionLimit) {
         Preconditions.checkState(context.arity() == 1);
 
         Statistics.Builder builder = Statistics.builder();
         Statistics inputStatistics = context.getChildStatistics(0);
         builder.addColumnStatistics(inputStatistics.getColumnStatistics());
-        builder.setOutputRowCount(inputStatistics.getOutputRowCount());
+        double rowCount = inputStatistics.getOutputRowCount();
+        // The partition top-n outputs at most partitionLimit rows of every partition
+        if (!partitionByColumns.isEmpty() && partitionByColumns.stream()
+                .noneMatch(column -> inputStatistics.getColumnStatistic(column).isUnknown())) {
+            double partitions = 1;
+            for (ColumnRefOperator column : partitionByColumns) {
+                partitions *= inputStatistics.getColumnStatistic(column).getDistinctValuesCount();
+            }
+            rowCount = Math.min(rowCount, partitions * partitionLimit);
+        }
+        builder.setOutputRowCount(rowCount);
         return visitOperator(node, context, builder);
     }
 
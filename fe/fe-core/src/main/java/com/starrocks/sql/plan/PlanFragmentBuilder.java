@@ -21,6 +21,7 @@ import com.starrocks.catalog.Catalog;
 import com.starrocks.catalog.ColocateTableIndex;
 import com.starrocks.catalog.Column;
 import com.starrocks.catalog.FunctionSet;
+import com.starrocks.catalog.KeysType;
 import com.starrocks.catalog.MaterializedIndex;
 import com.starrocks.catalog.MysqlTable;
 import com.starrocks.catalog.OlapTable;
@@ -46,6 +47,7 @@ import com.starrocks.planner.IntersectNode;
 import com.starrocks.planner.MysqlScanNode;
 import com.starrocks.planner.OlapScanNode;
 import com.starrocks.planner.PlanFragment;
+import com.starrocks.planner.PlanNode;
 import com.starrocks.planner.PlannerContext;
 import com.starrocks.planner.ProjectNode;
 import com.starrocks.planner.RepeatNode;
@@ -787,6 +789,10 @@ public class PlanFragmentBuilder {
                 throw unsupportedException("Not support aggregate type : " + node.getType());
             }
 
+            if (node.getType().isLocal() ||
+                    (node.getType().isGlobal() && !node.hasSingleDistinct() && !node.isSplit())) {
+                setMetadataScan(node, aggregateExprList, aggregationNode.getChild(0), context);
+            }
             aggregationNode.setStreamingPreaggregationMode(context.getConnectContext().
                     getSessionVariable().getStreamingPreaggregationMode());
             aggregationNode.setHasNullableGenerateChild();
@@ -795,6 +801,46 @@ public class PlanFragmentBuilder {
             return inputFragment;
         }
 
+        // The first phase of count(*), min and max without group by, which is directly over the scan of a duplicate
+        // or primary keys table without predicates, could be computed from the rows generated by the scan from the
+        // row counts and zone maps of the segments.
+        private void setMetadataScan(PhysicalHashAggregateOperator node, List<FunctionCallExpr> aggregateExprList,
+                                     PlanNode child, ExecPlan context) {
+            if (!context.getConnectContext().getSessionVariable().isEnableMetadataScan() ||
+                    !node.getGroupBys().isEmpty() || !(child instanceof OlapScanNode)) {
+                return;
+            }
+            OlapScanNode scanNode = (OlapScanNode) child;
+            KeysType keysType = scanNode.getOlapTable().getKeysType();
+            if ((keysType != KeysType.DUP_KEYS && keysType != KeysType.PRIMARY_KEYS) ||
+                    !scanNode.getConjuncts().isEmpty() || scanNode.hasLimit()) {
+                return;
+            }
+
+            List<String> minMaxColumns = Lists.newArrayList();
+            for (FunctionCallExpr aggExpr : aggregateExprList) {
+                String fnName = aggExpr.getFnName().getFunction();
+                if (aggExpr.isDistinct()) {
+                    return;
+                }
+                if (fnName.equalsIgnoreCase(FunctionSet.COUNT) && aggExpr.getChildren().isEmpty()) {
+                    continue;
+                }
+                if (!fnName.equalsIgnoreCase(FunctionSet.MIN) && !fnName.equalsIgnoreCase(FunctionSet.MAX)) {
+                    return;
+                }
+                if (aggExpr.getChildren().size() != 1 || !(aggExpr.getChild(0) instanceof SlotRef)) {
+                    return;
+                }
+                SlotRef slotRef = (SlotRef) aggExpr.getChild(0);
+                if (slotRef.getDesc() == null || slotRef.getDesc().getColumn() == null) {
+                    return;
+                }
+                minMaxColumns.add(slotRef.getDesc().getColumn().getName());
+            }
+            scanNode.setMetadataScan(minMaxColumns);
+        }
+
         public void rewriteAggDistinctFirstStageFunction(Analyzer analyzer, List<FunctionCallExpr> aggregateExprList) {
             int singleDistinctCount = 0;
             int singleDistinctIndex = 0;
@@ -884,9 +930,17 @@ public class PlanFragmentBuilder {
             PlanFragment inputFragment = visit(optExpr.inputAt(0), context);
             PhysicalTopNOperator topN = (PhysicalTopNOperator) optExpr.getOp();
             if (!topN.isSplit()) {
-                return buildPartialTopNFragment(optExpr, context, topN.getOrderSpec(), topN.getLimit(),
-                        topN.getOffset(),
-                        inputFragment);
+                PlanFragment fragment = buildPartialTopNFragment(optExpr, context, topN.getOrderSpec(),
+                        topN.getLimit(), topN.getOffset(), inputFragment);
+                if (topN.isPartitionTopN()) {
+                    // The partition columns have been materialized in the sort tuple
+                    List<Expr> partitionExprs = topN.getPartitionByColumns().stream()
+                            .map(c -> ScalarOperatorToExpr.buildExecExpression(c,
+                                    new ScalarOperatorToExpr.FormatterContext(context.getColRefToExpr())))
+                            .collect(Collectors.toList());
+                    ((SortNode) fragment.getPlanRoot()).setPartitionTopN(partitionExprs, topN.getPartitionLimit());
+                }
+                return fragment;
             } else {
                 return buildFinalTopNFragment(context, topN.getLimit(), topN.getOffset(), inputFragment, optExpr);
             }
@@ -4115,6 +4115,98 @@ public class PlanFragmentTest extends PlanTestBase {
                 "The query contains multi count distinct or sum distinct, each can't have multi columns.");
     }
 
+    @Test
+    public void testBitmapCountDistinct() throws Exception {
+        connectContext.getSessionVariable().setEnableBitmapCountDistinct(true);
+        try {
+            String explainString = getFragmentPlan("select count(distinct k4) from baseall group by k3");
+            Assert.assertTrue(explainString.contains("bitmap_union_int(4: k4)"));
+            Assert.assertFalse(explainString.contains("multi_distinct_count"));
+
+            explainString = getFragmentPlan("select count(distinct k1), count(distinct k2) from baseall");
+            Assert.assertTrue(explainString.contains("bitmap_union_int(1: k1)"));
+            Assert.assertTrue(explainString.contains("bitmap_union_int(2: k2)"));
+
+            // not integer
+            explainString = getFragmentPlan("select count(distinct k7) from baseall group by k3");
+            Assert.assertTrue(explainString.contains("multi_distinct_count(9: k7)"));
+        } finally {
+            connectContext.getSessionVariable().setEnableBitmapCountDistinct(false);
+        }
+    }
+
+    @Test
+    public void testPartitionTopN() throws Exception {
+        String sql = "select * from (select v1, v2, row_number() over (partition by v1 order by v2 desc) as rn " +
+                "from t0) t where rn <= 3";
+        String plan = getFragmentPlan(sql);
+        Assert.assertTrue(plan.contains("PARTITION-TOP-N\n" +
+                "  |  order by: <slot 2> 2: v2 DESC\n" +
+                "  |  partition by: 1: v1\n" +
+                "  |  partition limit: 3"));
+
+        sql = "select * from (select v1, v2, row_number() over (partition by v1 order by v2) as rn " +
+                "from t0) t where rn < 3 and rn = 1";
+        plan = getFragmentPlan(sql);
+        Assert.assertTrue(plan.contains("partition limit: 1"));
+
+        // rank() keeps the ties
+        sql = "select * from (select v1, v2, rank() over (partition by v1 order by v2) as rn " +
+                "from t0) t where rn <= 3";
+        plan = getFragmentPlan(sql);
+        Assert.assertFalse(plan.contains("PARTITION-TOP-N"));
+
+        // other window functions need all the rows
+        sql = "select * from (select v1, v2, row_number() over (partition by v1 order by v2) as rn, " +
+                "sum(v3) over (partition by v1 order by v2) as s from t0) t where rn <= 3";
+        plan = getFragmentPlan(sql);
+        Assert.assertFalse(plan.contains("PARTITION-TOP-N"));
+
+        connectContext.getSessionVariable().setEnablePartitionTopN(false);
+        try {
+            sql = "select * from (select v1, v2, row_number() over (partition by v1 order by v2) as rn " +
+                    "from t0) t where rn <= 3";
+            plan = getFragmentPlan(sql);
+            Assert.assertFalse(plan.contains("PARTITION-TOP-N"));
+        } finally {
+            connectContext.getSessionVariable().setEnablePartitionTopN(true);
+        }
+    }
+
+    @Test
+    public void testMetadataScan() throws Exception {
+        String sql = "select count(*), max(v2) from t0";
+        String plan = getThriftPlan(sql);
+        Assert.assertTrue(plan.contains("metadata_scan:true"));
+        Assert.assertTrue(plan.contains("metadata_min_max_columns:[v2]"));
+
+        // the predicates filter the rows
+        sql = "select max(v2) from t0 where v1 > 1";
+        plan = getThriftPlan(sql);
+        Assert.assertFalse(plan.contains("metadata_scan:true"));
+
+        // count(v3) needs the null values, and sum needs all the values
+        sql = "select count(v3), max(v2) from t0";
+        plan = getThriftPlan(sql);
+        Assert.assertFalse(plan.contains("metadata_scan:true"));
+        sql = "select sum(v3) from t0";
+        plan = getThriftPlan(sql);
+        Assert.assertFalse(plan.contains("metadata_scan:true"));
+
+        sql = "select v1, max(v2) from t0 group by v1";
+        plan = getThriftPlan(sql);
+        Assert.assertFalse(plan.contains("metadata_scan:true"));
+
+        connectContext.getSessionVariable().setEnableMetadataScan(false);
+        try {
+            sql = "select count(*) from t0";
+            plan = getThriftPlan(sql);
+            Assert.assertFalse(plan.contains("metadata_scan:true"));
+        } finally {
+            connectContext.getSessionVariable().setEnableMetadataScan(true);
+        }
+    }
+
     @Test
     public void testMultiNotExistPredicatePushDown() throws Exception {
         connectContext.setDatabase("default_cluster:test");
@@ -54,6 +54,11 @@ enum TTabletType {
     TABLET_TYPE_MEMORY = 1
 }
 
+enum TCumulativeCompactionPolicy {
+    NUM_BASED = 0,
+    SIZE_TIERED = 1
+}
+
 struct TCreateTabletReq {
     1: required Types.TTabletId tablet_id
     2: required TTabletSchema tablet_schema
@@ -74,6 +79,7 @@ struct TCreateTabletReq {
     12: optional bool is_eco_mode
     13: optional TStorageFormat storage_format
     14: optional TTabletType tablet_type
+    15: optional TCumulativeCompactionPolicy cumulative_compaction_policy
 }
 
 struct TDropTabletReq {
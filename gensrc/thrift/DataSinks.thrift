@@ -52,6 +52,11 @@ struct TResultFileSinkOptions {
     5: optional i64 max_file_size_bytes
     6: optional list<Types.TNetworkAddress> broker_addresses; // only for remote file
     7: optional map<string, string> broker_properties // only for remote file
+    8: optional i64 parquet_max_row_group_bytes // only for parquet
+    // of the output columns, only for parquet
+    9: optional list<string> parquet_column_names
+    10: optional list<Types.TCompressionType> parquet_compression_types
+    11: optional list<bool> parquet_use_dict
 }
 
 struct TMemoryScratchSink {
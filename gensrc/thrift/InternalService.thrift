@@ -152,6 +152,8 @@ struct TQueryOptions {
   54: optional i32 query_threads;
   // For pipeline query engine
   55: optional i32 pipeline_scan_mode;
+  // The resource group of the query for pipeline query engine
+  56: optional string resource_group;
 }
 
 
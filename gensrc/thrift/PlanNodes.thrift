@@ -211,6 +211,9 @@ struct THdfsScanRange {
 
     // file format of hdfs file
     6: optional Descriptors.THdfsFileFormat file_format
+
+    // modification time of hdfs file, for caching the footer
+    7: optional i64 modification_time
 }
 
 // Specification of an individual data range which is held in its entirety
@@ -334,6 +337,10 @@ struct TOlapScanNode {
   // For profile attributes' printing: `Rollup` `Predicates`
   20: optional string rollup_name
   21: optional string sql_predicates
+  // If true, the rows of the segments are generated from their row counts and zone maps instead of the data
+  // pages when possible, which is only valid for count(*), and min and max of metadata_min_max_columns.
+  22: optional bool metadata_scan
+  23: optional list<string> metadata_min_max_columns
 }
 struct TEqJoinCondition {
   // left-hand side of "<a> = <b>"
@@ -347,7 +354,9 @@ struct TEqJoinCondition {
 enum TStreamingPreaggregationMode {
   AUTO,
   FORCE_STREAMING,
-  FORCE_PREAGGREGATION
+  FORCE_PREAGGREGATION,
+  // Decide by the reduction of the keys sampled from every window of the input
+  ADAPTIVE
 }
 
 enum TJoinOp {
@@ -404,6 +413,9 @@ struct TMergeJoinNode {
   // anything from the ON or USING clauses (but *not* the WHERE clause) that's not an
   // equi-join predicate
   2: optional list<Exprs.TExpr> other_join_conjuncts
+
+  // INNER_JOIN if not set, only used by the vectorized merge join
+  3: optional TJoinOp join_op
 }
 
 enum TAggregationOp {
@@ -467,6 +479,11 @@ struct TAggregationNode {
   // For profile attributes' printing: `Grouping Keys` `Aggregate Functions`
   22: optional string sql_grouping_keys
   23: optional string sql_aggregate_functions
+
+  // The input is sorted by the grouping exprs, so the groups are aggregated one after another
+  // without a hash table. The pipeline engine only uses it for the streaming pre-aggregation, whose
+  // input isn't shuffled.
+  24: optional bool sorted_by_group_keys
 }
 
 struct TRepeatNode {
@@ -521,6 +538,10 @@ struct TSortNode {
   20: optional bool has_outer_join_child
   // For profile attributes' printing: `Sort Keys`
   21: optional string sql_sort_keys
+  // If set, only the first partition_limit rows of every partition of partition_exprs are output,
+  // without being sorted. The partition exprs are evaluated on the materialized sort tuple.
+  22: optional list<Exprs.TExpr> partition_exprs
+  23: optional i64 partition_limit
 }
 
 enum TAnalyticWindowType {